@@ -1,6 +1,8 @@
 /*------------------------------------------------------------------------
   aprint.hpp 
 	JHT, Feburary 4, 2022 : created
+	JHT, October 14, 2026 : added Printring, per-thread messages
+	JHT, October 14, 2026 : Stringvec packs the strings
 
   .hpp file for Printbuffer and Stringvec
 
@@ -17,84 +19,459 @@ buf.print(2);                    //prints the n'th message, index from zero
 buf.clear();			 //clears an unstored buffer
 buf.reset();			 //reset buffer and stored messages
 
+//THREADS (see Printring)
+buf.tadd("thread %d did %ld\n",omp_get_thread_num(),n); //formatted now
+buf.tlog("block %ld took %f s\n",blk,dt);   //formatted at print_all
+
+  Printring keeps the messages of each OpenMP thread in a buffer of its
+  own, so tadd and tlog can be called from inside a parallel region with
+  no critical section or atomic. print_all (outside the parallel region)
+  prints them after the stored messages, by thread and then in the order
+  each thread added them.
+
+  tadd formats the message right away into the thread's buffer. tlog 
+  only records the format, a timestamp, and up to APRINT_TARGS numbers 
+  or pointers, and formats them at print_all, so it costs about as much
+  as a store. The format (and any %s strings) of tlog must still be 
+  there at print_all, e.g., string literals. "*" widths and %n are not 
+  supported by tlog. tlog messages are printed with "[seconds] " since 
+  the ring was made.
+
+  The threads are omp_get_thread_num() of the innermost team, of which
+  there can be APRINT_MAX_THREADS. Each thread makes its buffer the first
+  time it adds a message.
+
 -------------------------------------------------------------------------*/
+#ifndef APRINT_HPP
+#define APRINT_HPP
 #include <stdio.h>
 #include <vector>
 #include <string.h>
 #include <stdlib.h>
 #include <stdarg.h>
+#include <chrono>
+#include <type_traits>
 #include "libjdef.h"
 
+#if defined LIBJ_OMP
+  #include <omp.h>
+#endif
+
 #define APRINT_RES 10
 #define APRINT_LEN 1024 
+#define APRINT_TARGS 6		//arguments of a tlog message
+#define APRINT_MAX_THREADS 256	//threads of a Printring
 
 /* 
  *  Stringvec
- *  a lightweight implementation of std::vector for C-style strings
+ *  a lightweight implementation of std::vector for C-style strings. The
+ *  strings are packed one after the other (with their '\0') in buffer,
+ *  and offset[i] is where string i starts, so a short message takes its
+ *  own length and not APRINT_LEN. Both grow geometrically with realloc,
+ *  and a Stringvec can be moved, but not copied.
 */
 struct Stringvec
 {
   //data
-  int   size; 		//number of elements
-  int   capacity; 	//number of reserved elements
-  char* buffer; 	//buffer
-  
+  long  size; 		//number of elements
+  long  capacity; 	//number of reserved elements
+  long  chars;		//bytes used in buffer
+  long  ccap;		//bytes reserved in buffer
+  char* buffer; 	//packed strings
+  long* offset;		//start of each string, size+1 of them
+
   //Initializer
   Stringvec()
   {
-    buffer = (char*) malloc(sizeof(char)*APRINT_LEN*APRINT_RES); 
     size = 0;
-    capacity = APRINT_RES;
+    capacity = 0;
+    chars = 0;
+    ccap = 0;
+    buffer = NULL;
+    offset = NULL;
+    if (reserve(APRINT_RES,APRINT_RES*64) != 0) {exit(1);}
   }
 
   //destructor
   ~Stringvec()
   {
-    free(buffer);
+    release();
   }
 
-  //accessing vector elements
-  char* operator[] (const long elem) {return (buffer+APRINT_LEN*elem);}
-  const char* operator[] (const long elem) const {return (buffer+APRINT_LEN*elem);} 
+  //move
+  Stringvec(Stringvec&& other)
+  {
+    size = other.size; capacity = other.capacity;
+    chars = other.chars; ccap = other.ccap;
+    buffer = other.buffer; offset = other.offset;
+    other.size = 0; other.capacity = 0; other.chars = 0; other.ccap = 0;
+    other.buffer = NULL; other.offset = NULL;
+  }
+  Stringvec& operator= (Stringvec&& other)
+  {
+    if (this != &other)
+    {
+      release();
+      size = other.size; capacity = other.capacity;
+      chars = other.chars; ccap = other.ccap;
+      buffer = other.buffer; offset = other.offset;
+      other.size = 0; other.capacity = 0; other.chars = 0; other.ccap = 0;
+      other.buffer = NULL; other.offset = NULL;
+    }
+    return *this;
+  }
+
+  //accessing vector elements, without the '\0'
+  const char* operator[] (const long elem) const {return buffer+offset[elem];}
+  long len(const long elem) const {return offset[elem+1]-offset[elem]-1;}
 
-  //grow
-  void grow() 
+  //reserve room for num strings and bytes characters, returns 0 on success
+  int reserve(const long num, const long bytes)
   {
-    char* newbuf = (char*) malloc(sizeof(char)*capacity*2*APRINT_LEN);
-    memmove(newbuf,buffer,sizeof(char)*capacity*APRINT_LEN);
-    memset(newbuf+size*APRINT_LEN,(char)0,sizeof(char)*capacity*APRINT_LEN);
-    capacity *= 2;
-    free(buffer);
-    buffer = newbuf;
+    if (num+1 > capacity)
+    {
+      long* newoff = (long*) realloc(offset,sizeof(long)*(num+1));
+      if (newoff == NULL)
+      {
+        printf("\nERROR ERROR ERROR\n");
+        printf("Stringvec::reserve could not realloc %ld strings\n",num);
+        return 1;
+      }
+      if (offset == NULL) newoff[0] = 0;
+      offset = newoff;
+      capacity = num+1;
+    }
+    if (bytes > ccap)
+    {
+      char* newbuf = (char*) realloc(buffer,sizeof(char)*bytes);
+      if (newbuf == NULL)
+      {
+        printf("\nERROR ERROR ERROR\n");
+        printf("Stringvec::reserve could not realloc %ld bytes\n",bytes);
+        return 1;
+      }
+      buffer = newbuf;
+      ccap = bytes;
+    }
+    return 0;
   }
 
-  //push_back
-  void push_back(const char* string)
+  //push_back, len characters of string
+  void push_back(const char* string, const long len)
   {
-    if (size+1 > capacity) {grow();}
-    strcpy(buffer+size*APRINT_LEN,string);
+    long num = capacity;
+    long bytes = ccap;
+    while (size+2 > num) num *= 2;
+    while (chars+len+1 > bytes) bytes *= 2;
+    if (reserve(num,bytes) != 0) {exit(1);}
+    memcpy(buffer+chars,string,sizeof(char)*len);
+    buffer[chars+len] = (char) 0;
+    chars += len+1;
     size++;
+    offset[size] = chars;
   }
+  void push_back(const char* string) {push_back(string,(long) strlen(string));}
 
-  //clear
+  //clear, keeps the memory
   void clear()
   {
-    memset(buffer,(char)0,sizeof(char)*size*APRINT_LEN); 
     size = 0;
+    chars = 0;
   }
 
   //info
   void info() const
   {
-    printf("Stringvec has size %d and capacity %d\n",size,capacity);
+    printf("Stringvec has size %ld, capacity %ld, and %ld of %ld bytes\n",
+           size,capacity-1,chars,ccap);
   }
 
   //free the memory
   void release() 
   {
     free(buffer);
+    free(offset);
+    buffer = NULL;
+    offset = NULL;
+    size = 0; capacity = 0; chars = 0; ccap = 0;
+  }
+
+  private:
+  Stringvec(const Stringvec& other);
+  Stringvec& operator= (const Stringvec& other);
+};
+
+/*
+ * Printarg, Printmsg, Printthread
+ * an argument of a tlog message, a message, and the messages of a thread
+*/
+union Printarg
+{
+  long          l;
+  unsigned long u;
+  double        d;
+  const void*   p;
+};
+
+struct Printmsg
+{
+  const char* fmt;                  //tlog format, NULL if formatted
+  double      time;                 //seconds since the ring was made
+  long        text;                 //offset of a formatted message
+  int         len;                  //bytes of a formatted message
+  int         nargs;                //number of tlog arguments
+  char        type[APRINT_TARGS];   //'i', 'u', 'd', or 'p'
+  Printarg    arg[APRINT_TARGS];
+};
+
+struct Printthread
+{
+  std::vector<Printmsg> msg;
+  std::vector<char>     text;
+  char                  pad[64];    //keeps the threads off each other's lines
+};
+
+/*
+ * Printring
+ * per-thread message buffers, see the top of the file
+*/
+struct Printring
+{
+  Printthread* thr[APRINT_MAX_THREADS];   //made by each thread as needed
+  std::chrono::steady_clock::time_point t0;
+
+  Printring()
+  {
+    for (int i=0;i<APRINT_MAX_THREADS;i++) thr[i] = NULL;
+    t0 = std::chrono::steady_clock::now();
+  }
+  ~Printring()
+  {
+    for (int i=0;i<APRINT_MAX_THREADS;i++) delete thr[i];
+  }
+
+  //buffer of this thread, or NULL. Only this thread makes its buffer,
+  //so there is no race
+  Printthread* mine()
+  {
+    #if defined LIBJ_OMP
+    const int tid = omp_get_thread_num();
+    #else
+    const int tid = 0;
+    #endif
+    if (tid >= APRINT_MAX_THREADS)
+    {
+      printf("\nERROR ERROR ERROR\n");
+      printf("Printring thread %d is more than APRINT_MAX_THREADS\n",tid);
+      return NULL;
+    }
+    if (thr[tid] == NULL) thr[tid] = new Printthread;
+    return thr[tid];
+  }
+
+  double now() const
+  {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now()-t0).count();
+  }
+
+  //format a message now, into this thread's buffer
+  int vtadd(const char* fstring, va_list arg)
+  {
+    Printthread* t = mine();
+    if (t == NULL) return 1;
+    va_list copy;
+    va_copy(copy,arg);
+    const int len = vsnprintf(NULL,0,fstring,copy);
+    va_end(copy);
+    if (len < 0) return 1;
+    const long pos = (long) t->text.size();
+    t->text.resize(pos+len+1);
+    vsnprintf(t->text.data()+pos,len+1,fstring,arg);
+    t->text.resize(pos+len);
+    Printmsg m;
+    m.fmt = NULL;
+    m.time = 0.0;
+    m.text = pos;
+    m.len = len;
+    m.nargs = 0;
+    t->msg.push_back(m);
+    return 0;
+  }
+
+  int tadd(const char* fstring, ...)
+  {
+    va_list arg;
+    va_start(arg,fstring);
+    const int stat = vtadd(fstring,arg);
+    va_end(arg);
+    return stat;
+  }
+
+  //record a message, formatted at flush
+  template <class...Args>
+  int tlog(const char* fstring, const Args...args)
+  {
+    static_assert(sizeof...(Args) <= APRINT_TARGS,"Printring::tlog has too many arguments");
+    Printthread* t = mine();
+    if (t == NULL) return 1;
+    Printmsg m;
+    m.fmt = fstring;
+    m.time = now();
+    m.text = 0;
+    m.len = 0;
+    m.nargs = 0;
+    put(m,args...);
+    t->msg.push_back(m);
+    return 0;
+  }
+
+  //number of messages
+  long size() const
+  {
+    long num = 0;
+    for (int i=0;i<APRINT_MAX_THREADS;i++) {if (thr[i] != NULL) num += (long) thr[i]->msg.size();}
+    return num;
+  }
+
+  //drop all messages, keeps the memory
+  void clear()
+  {
+    for (int i=0;i<APRINT_MAX_THREADS;i++) 
+    {
+      if (thr[i] != NULL) {thr[i]->msg.clear(); thr[i]->text.clear();}
+    }
+  }
+
+  //append all messages to out, by thread and then in order
+  void flush(std::vector<char>& out) const
+  {
+    for (int i=0;i<APRINT_MAX_THREADS;i++)
+    {
+      if (thr[i] == NULL) continue;
+      const Printthread& t = *thr[i];
+      for (size_t j=0;j<t.msg.size();j++)
+      {
+        const Printmsg& m = t.msg[j];
+        if (m.fmt == NULL) 
+        {
+          out.insert(out.end(),t.text.begin()+m.text,t.text.begin()+m.text+m.len);
+        } else {
+          format(out,m);
+        }
+      }
+    }
+  }
+
+  //print all messages
+  void print_all() const
+  {
+    std::vector<char> out;
+    flush(out);
+    if (!out.empty()) fwrite(out.data(),sizeof(char),out.size(),stdout);
+  }
+
+  private:
+
+  //no copies, the buffers are owned
+  Printring(const Printring& other);
+  Printring& operator= (const Printring& other);
+
+  //tlog arguments, by kind
+  static void put(Printmsg&) {}
+  template <class T, class...Args>
+  static void put(Printmsg& m, const T first, const Args...rest)
+  {
+    put1(m.arg[m.nargs],m.type[m.nargs],first,
+         std::integral_constant<int,std::is_floating_point<T>::value ? 0 :
+                                    std::is_pointer<T>::value ? 1 :
+                                    std::is_signed<T>::value ? 2 : 3>());
+    m.nargs++;
+    put(m,rest...);
+  }
+  template <class T> static void put1(Printarg& a, char& c, const T x, std::integral_constant<int,0>)
+    {a.d = (double) x; c = 'd';}
+  template <class T> static void put1(Printarg& a, char& c, const T x, std::integral_constant<int,1>)
+    {a.p = (const void*) x; c = 'p';}
+  template <class T> static void put1(Printarg& a, char& c, const T x, std::integral_constant<int,2>)
+    {a.l = (long) x; c = 'i';}
+  template <class T> static void put1(Printarg& a, char& c, const T x, std::integral_constant<int,3>)
+    {a.u = (unsigned long) x; c = 'u';}
+
+  template <class T>
+  static void append(std::vector<char>& out, const char* spec, const T x)
+  {
+    const int len = snprintf(NULL,0,spec,x);
+    if (len <= 0) return;
+    const size_t pos = out.size();
+    out.resize(pos+len+1);
+    snprintf(out.data()+pos,len+1,spec,x);
+    out.resize(pos+len);
+  }
+
+  //format a tlog message, one conversion at a time
+  static void format(std::vector<char>& out, const Printmsg& m)
+  {
+    append(out,"[%.6f] ",m.time);
+    const char* f = m.fmt;
+    int next = 0;
+    while (*f != (char) 0)
+    {
+      if (*f != '%') {out.push_back(*f); f++; continue;}
+      if (f[1] == '%') {out.push_back('%'); f += 2; continue;}
+
+      //flags, width, and precision are kept, the length is dropped
+      char spec[32];
+      int n = 0;
+      const char* start = f;
+      const char* s = f+1;
+      spec[n++] = '%';
+      while (*s != (char) 0 && strchr("-+ #0123456789.",*s) != NULL && n < 24) {spec[n++] = *s; s++;}
+      char mod[3] = {0,0,0};
+      int nmod = 0;
+      while (*s != (char) 0 && strchr("hljztLq",*s) != NULL) {if (nmod < 2) mod[nmod++] = *s; s++;}
+      const char conv = *s;
+      if (conv == (char) 0 || strchr("diouxXeEfFgGaAcsp",conv) == NULL || next >= m.nargs)
+      {
+        f = (conv == (char) 0) ? s : s+1;
+        out.insert(out.end(),start,f);
+        continue;
+      }
+      const Printarg& a = m.arg[next];
+      const char t = m.type[next];
+      next++;
+      f = s+1;
+
+      const long   ival = (t == 'd') ? (long) a.d : a.l;
+      const double dval = (t == 'd') ? a.d : ((t == 'u') ? (double) a.u : (double) a.l);
+      if (strchr("di",conv) != NULL)
+      {
+        long x = ival;
+        if (nmod == 0)                       x = (int) x;
+        if (nmod == 1 && mod[0] == 'h')      x = (short) x;
+        if (nmod == 2 && mod[0] == 'h')      x = (signed char) x;
+        spec[n++] = 'l'; spec[n++] = conv; spec[n] = (char) 0;
+        append(out,spec,x);
+      } else if (strchr("ouxX",conv) != NULL) {
+        unsigned long x = (unsigned long) ival;
+        if (nmod == 0)                       x = (unsigned int) x;
+        if (nmod == 1 && mod[0] == 'h')      x = (unsigned short) x;
+        if (nmod == 2 && mod[0] == 'h')      x = (unsigned char) x;
+        spec[n++] = 'l'; spec[n++] = conv; spec[n] = (char) 0;
+        append(out,spec,x);
+      } else if (conv == 'c') {
+        spec[n++] = conv; spec[n] = (char) 0;
+        append(out,spec,(int) ival);
+      } else if (conv == 's' || conv == 'p') {
+        spec[n++] = conv; spec[n] = (char) 0;
+        if (t != 'p') {out.insert(out.end(),start,f); continue;}
+        if (conv == 's') append(out,spec,(const char*) a.p);
+        else             append(out,spec,a.p);
+      } else {
+        spec[n++] = conv; spec[n] = (char) 0;
+        append(out,spec,dval);
+      }
+    }
   }
-  
 };
 
 /*
@@ -107,6 +484,7 @@ struct Printbuffer
   char      stemp[APRINT_LEN];
   char      buffer[APRINT_LEN];
   Stringvec vec;
+  Printring ring;
 
   //Initializer
   Printbuffer()
@@ -194,7 +572,7 @@ struct Printbuffer
   {
     if (idx > 0)
     {
-      vec.push_back(buffer);
+      vec.push_back(buffer,idx);
       clear();
     }
   }
@@ -220,22 +598,37 @@ struct Printbuffer
   void reset()
   {
     vec.clear();
+    ring.clear();
     clear();
   }
 
-  //print buffer
+  //messages of threads, see Printring
+  int tadd(const char* fstring, ...)
+  {
+    va_list arg;
+    va_start(arg,fstring);
+    const int stat = ring.vtadd(fstring,arg);
+    va_end(arg);
+    return stat;
+  }
+  template <class...Args>
+  int tlog(const char* fstring, const Args...args) {return ring.tlog(fstring,args...);}
+
+  //print buffer, then the messages of the threads
   void print_all() const
   {
-    for (int i=0;i<vec.size;i++)
+    for (long i=0;i<vec.size;i++)
     {
-      printf("%s",vec[i]);
+      fwrite(vec[i],sizeof(char),vec.len(i),stdout);
     }
+    fflush(stdout);
+    ring.print_all();
   }
 
   //print info
   void info() const
   {
-    printf("\nPrintbuffer has %d entries\n",vec.size);
+    printf("\nPrintbuffer has %ld entries\n",vec.size);
     printf("Entry max size is %d\n",APRINT_LEN);
   }
 
@@ -245,6 +638,8 @@ struct Printbuffer
     printf("%s",vec[message]);
   }
 
-  int size() const {return vec.size;}
+  int size() const {return (int) vec.size;}
 
 };
+
+#endif
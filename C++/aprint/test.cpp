@@ -38,7 +38,7 @@ int main()
       //send
       if (task == mpi_task_id)
       {
-        MPI_Send(buf.vec[message],APRINT_LEN,MPI_CHAR,0,42,MPI_COMM_WORLD);
+        MPI_Send(buf.vec[message],buf.vec.len(message)+1,MPI_CHAR,0,42,MPI_COMM_WORLD);
       }
 
       //recieve
@@ -0,0 +1,170 @@
+/*-------------------------------------------------------
+  array_print.hpp
+	JHT, October 14, 2026 : created
+
+  array_print, the buffered text output behind the
+  print() of gemat, usymat, geten3, geten4, and of
+  linal_dgeprint. The numbers are formatted straight
+  into a buffer of ARRAY_PRINT_BYTES, which is written
+  with one fwrite when it is full, in place of one
+  printf (and a locked, maybe unbuffered, stdout) per
+  element, so a big matrix is a few large writes.
+
+  The output is the same as the printf it replaces:
+  num(double) is %18.15E, num(float) %10.7E, and the
+  integers %ld. With C++17 (and <charconv> that has
+  the floating point std::to_chars, GCC 11, Clang 14)
+  the numbers are written by std::to_chars, which is
+  several times faster than snprintf, otherwise by
+  snprintf into the buffer.
+
+  USAGE
+    array_print out;		//stdout, or array_print out(fp)
+    out.idx(i,j);		//"[i,j]    "
+    out.num(x);			//x as above
+    out.put(" \n");		//a string, or a char
+    out.flush();		//also done by the destructor
+
+  For a copy of a matrix that is to be read back, see
+  linal_dgedump (linal_geprint.hpp), which saves it as
+  a libj::tensor_file.
+--------------------------------------------------------*/
+#ifndef ARRAY_PRINT_HPP
+#define ARRAY_PRINT_HPP
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#if __cplusplus >= 201703L && defined (__has_include)
+  #if __has_include(<charconv>)
+    #include <charconv>
+  #endif
+#endif
+#if defined (__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+  #define ARRAY_PRINT_TO_CHARS 1
+#endif
+
+//bytes of text kept before a write
+#if !defined (ARRAY_PRINT_BYTES)
+  #define ARRAY_PRINT_BYTES (1L << 22)
+#endif
+
+#define ARRAY_PRINT_NUM 64	//bytes kept free for one number
+
+class array_print
+{
+  private:
+  FILE*             m_fp;	//stream written to
+  std::vector<char> m_buf;	//text not yet written
+  size_t            m_len;	//bytes of m_buf used
+
+  //room for n more bytes
+  inline char* m_room(const size_t n)
+  {
+    if (m_len + n > m_buf.size()) write();
+    if (n > m_buf.size()) m_buf.resize(n);
+    return m_buf.data() + m_len;
+  }
+
+  //%.PREC E of x at p, returns the bytes written
+  inline size_t m_sci(char* p, const double x, const int PREC)
+  {
+#if defined (ARRAY_PRINT_TO_CHARS)
+    const std::to_chars_result r = std::to_chars(p,p+ARRAY_PRINT_NUM,x,
+                                                 std::chars_format::scientific,PREC);
+    const size_t n = (size_t) (r.ptr - p);
+    for (size_t i=0;i<n;i++) {if (p[i] >= 'a' && p[i] <= 'z') p[i] += 'A' - 'a';}
+    return n;
+#else
+    return (size_t) snprintf(p,ARRAY_PRINT_NUM,"%.*E",PREC,x);
+#endif
+  }
+
+  //x right aligned in WIDTH, as %WIDTH.PREC E
+  inline void m_num(const double x, const int WIDTH, const int PREC)
+  {
+    char* p = m_room(ARRAY_PRINT_NUM);
+    const size_t n = m_sci(p,x,PREC);
+    if (n < (size_t) WIDTH)
+    {
+      const size_t pad = WIDTH - n;
+      memmove(p+pad,p,n);
+      memset(p,' ',pad);
+      m_len += WIDTH;
+    } else {
+      m_len += n;
+    }
+  }
+
+  array_print(const array_print&);
+  array_print& operator=(const array_print&);
+
+  public:
+  explicit array_print(FILE* fp = stdout) : m_fp(fp), m_buf(ARRAY_PRINT_BYTES), m_len(0) {}
+  ~array_print() {flush();}
+
+  //the buffer to the stream
+  inline void write()
+  {
+    if (m_len > 0) fwrite(m_buf.data(),1,m_len,m_fp);
+    m_len = 0;
+  }
+  inline void flush()
+  {
+    write();
+    fflush(m_fp);
+  }
+
+  inline void put(const char c)
+  {
+    *m_room(1) = c;
+    m_len++;
+  }
+  inline void put(const char* s)
+  {
+    const size_t n = strlen(s);
+    memcpy(m_room(n),s,n);
+    m_len += n;
+  }
+
+  inline void num(const double x) {m_num(x,18,15);}
+  inline void num(const float x) {m_num((double) x,10,7);}
+  inline void num(const long x)
+  {
+    char  tmp[24];
+    char* q = tmp + sizeof(tmp);
+    unsigned long u = (x < 0) ? 0UL - (unsigned long) x : (unsigned long) x;
+    do {*--q = (char) ('0' + u%10); u /= 10;} while (u > 0);
+    if (x < 0) *--q = '-';
+    const size_t n = (size_t) (tmp + sizeof(tmp) - q);
+    memcpy(m_room(n),q,n);
+    m_len += n;
+  }
+  inline void num(const int x) {num((long) x);}
+  inline void num(const void* x)
+  {
+    char* p = m_room(ARRAY_PRINT_NUM);
+    m_len += (size_t) snprintf(p,ARRAY_PRINT_NUM,"%p",x);
+  }
+
+  //the "[i,j,...]    " before an element
+  inline void idx(const long i)
+  {
+    put('['); num(i); put("]    ");
+  }
+  inline void idx(const long i, const long j)
+  {
+    put('['); num(i); put(','); num(j); put("]    ");
+  }
+  inline void idx(const long i, const long j, const long k)
+  {
+    put('['); num(i); put(','); num(j); put(','); num(k); put("]    ");
+  }
+  inline void idx(const long i, const long j, const long k, const long l)
+  {
+    put('['); num(i); put(','); num(j); put(','); num(k); put(','); num(l); put("]    ");
+  }
+};
+
+#endif
@@ -0,0 +1,191 @@
+/*-------------------------------------------------------
+  array_simd.hpp
+	JHT, October 14, 2026 : created
+
+  The simd_* calls behind the bulk operations of gemat,
+  usymat, and vec (zero, set, scale, axpy, dot, copy).
+  Each takes the alignment (BYTES) common to its arrays,
+  as from get_alignment(), and calls
+
+    simd_par_opr<T>         if N >= libj::simd_par_min_n()
+    simd_opr<T,ALIGNMENT>   for the largest ALIGNMENT
+                            (128 to sizeof(T)) dividing it
+    simd_opr<T>             otherwise
+
+  so the containers get the aligned (AVX2, AVX-512) and
+  threaded kernels without the caller choosing. The
+  threaded ones fall back to the serial ones inside a
+  parallel region.
+
+  Types with no simd kernels (the gemat<double*> of 
+  pointers) zero, set and copy with a plain loop, and exit
+  on the arithmetic.
+
+  array_simd_align(a,b) is the alignment common to two
+  arrays aligned to a and b BYTES, array_simd_ptr_align(p)
+  that of a pointer (up to 128), for the columns of views.
+--------------------------------------------------------*/
+#ifndef ARRAY_SIMD_HPP
+#define ARRAY_SIMD_HPP
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <type_traits>
+#include "simd.hpp"
+
+//true for the types the simd_* are instantiated for
+template <typename T> struct array_simd_has : std::false_type {};
+template <> struct array_simd_has<double> : std::true_type {};
+template <> struct array_simd_has<float>  : std::true_type {};
+template <> struct array_simd_has<long>   : std::true_type {};
+template <> struct array_simd_has<int>    : std::true_type {};
+
+//exits, for arithmetic on a type with no simd kernels
+inline void array_simd_none(const char* opr)
+{
+  printf("Attempted to %s an array of a type with no simd kernels \n",opr);
+  exit(1);
+}
+
+//alignment common to two arrays, powers of two
+inline int array_simd_align(const int a, const int b)
+{
+  return (a < b) ? a : b;
+}
+
+//alignment of p in BYTES, up to 128, as calc_alignment()
+inline int array_simd_ptr_align(const void* p)
+{
+  int align = 1;
+  for (long m=2;m<=128;m*=2)
+  {
+    if ((long)p%m != 0) {return align;}
+    align *= 2;
+  }
+  return align;
+}
+
+//CALL(ALIGNMENT) for the largest instantiated ALIGNMENT of T
+//that align allows, UCALL if there is none
+#define ARRAY_SIMD_SWITCH(T,align,CALL,UCALL) \
+  if      ((align) >= 128) {CALL(128);} \
+  else if ((align) >= 64)  {CALL(64);} \
+  else if ((align) >= 32)  {CALL(32);} \
+  else if ((align) >= 16)  {CALL(16);} \
+  else if ((align) >= 8 && sizeof(T) <= 8) {CALL(8);} \
+  else if ((align) >= 4 && sizeof(T) <= 4) {CALL(4);} \
+  else {UCALL;}
+
+//X = 0
+template <typename T>
+inline void array_simd_zero(const long N, T* X, const int align, std::true_type)
+{
+  if (N >= libj::simd_par_min_n()) {simd_par_zero<T>(N,X); return;}
+  #define ARRAY_SIMD_CALL(AL) simd_zero<T,(AL < (int) sizeof(T) ? (int) sizeof(T) : AL)>(N,X)
+  ARRAY_SIMD_SWITCH(T,align,ARRAY_SIMD_CALL,simd_zero<T>(N,X))
+  #undef ARRAY_SIMD_CALL
+}
+template <typename T>
+inline void array_simd_zero(const long N, T* X, const int align, std::false_type)
+{
+  for (long i=0;i<N;i++) {X[i] = (T) 0;}
+}
+template <typename T>
+inline void array_simd_zero(const long N, T* X, const int align)
+{
+  if (N > 0) array_simd_zero<T>(N,X,align,array_simd_has<T>());
+}
+
+//X = A
+template <typename T>
+inline void array_simd_set(const long N, const T A, T* X, const int align, std::true_type)
+{
+  if (N >= libj::simd_par_min_n()) {simd_par_scal_set<T>(N,A,X); return;}
+  #define ARRAY_SIMD_CALL(AL) simd_scal_set<T,(AL < (int) sizeof(T) ? (int) sizeof(T) : AL)>(N,A,X)
+  ARRAY_SIMD_SWITCH(T,align,ARRAY_SIMD_CALL,simd_scal_set<T>(N,A,X))
+  #undef ARRAY_SIMD_CALL
+}
+template <typename T>
+inline void array_simd_set(const long N, const T A, T* X, const int align, std::false_type)
+{
+  for (long i=0;i<N;i++) {X[i] = A;}
+}
+template <typename T>
+inline void array_simd_set(const long N, const T A, T* X, const int align)
+{
+  if (N > 0) array_simd_set<T>(N,A,X,align,array_simd_has<T>());
+}
+
+//Y = X
+template <typename T>
+inline void array_simd_copy(const long N, const T* X, T* Y, const int align, std::true_type)
+{
+  if (N >= libj::simd_par_min_n()) {simd_par_copy<T>(N,X,Y); return;}
+  #define ARRAY_SIMD_CALL(AL) simd_copy<T,(AL < (int) sizeof(T) ? (int) sizeof(T) : AL)>(N,X,Y)
+  ARRAY_SIMD_SWITCH(T,align,ARRAY_SIMD_CALL,simd_copy<T>(N,X,Y))
+  #undef ARRAY_SIMD_CALL
+}
+template <typename T>
+inline void array_simd_copy(const long N, const T* X, T* Y, const int align, std::false_type)
+{
+  for (long i=0;i<N;i++) {Y[i] = X[i];}
+}
+template <typename T>
+inline void array_simd_copy(const long N, const T* X, T* Y, const int align)
+{
+  if (N > 0) array_simd_copy<T>(N,X,Y,align,array_simd_has<T>());
+}
+
+//X = A*X
+template <typename T>
+inline void array_simd_scale(const long N, const T A, T* X, const int align, std::true_type)
+{
+  if (N >= libj::simd_par_min_n()) {simd_par_scal_mul<T>(N,A,X); return;}
+  #define ARRAY_SIMD_CALL(AL) simd_scal_mul<T,(AL < (int) sizeof(T) ? (int) sizeof(T) : AL)>(N,A,X)
+  ARRAY_SIMD_SWITCH(T,align,ARRAY_SIMD_CALL,simd_scal_mul<T>(N,A,X))
+  #undef ARRAY_SIMD_CALL
+}
+template <typename T>
+inline void array_simd_scale(const long N, const T A, T* X, const int align, std::false_type)
+{
+  array_simd_none("scale");
+}
+template <typename T>
+inline void array_simd_scale(const long N, const T A, T* X, const int align)
+{
+  if (N > 0) array_simd_scale<T>(N,A,X,align,array_simd_has<T>());
+}
+
+//Y = Y + A*X
+template <typename T>
+inline void array_simd_axpy(const long N, const T A, const T* X, T* Y, const int align, std::true_type)
+{
+  if (N >= libj::simd_par_min_n()) {simd_par_axpy<T>(N,A,X,Y); return;}
+  #define ARRAY_SIMD_CALL(AL) simd_axpy<T,(AL < (int) sizeof(T) ? (int) sizeof(T) : AL)>(N,A,X,Y)
+  ARRAY_SIMD_SWITCH(T,align,ARRAY_SIMD_CALL,simd_axpy<T>(N,A,X,Y))
+  #undef ARRAY_SIMD_CALL
+}
+template <typename T>
+inline void array_simd_axpy(const long N, const T A, const T* X, T* Y, const int align, std::false_type)
+{
+  array_simd_none("axpy");
+}
+template <typename T>
+inline void array_simd_axpy(const long N, const T A, const T* X, T* Y, const int align)
+{
+  if (N > 0) array_simd_axpy<T>(N,A,X,Y,align,array_simd_has<T>());
+}
+
+//X.Y, only of the simd types
+template <typename T>
+inline T array_simd_dot(const long N, const T* X, const T* Y, const int align)
+{
+  if (N <= 0) return (T) 0;
+  if (N >= libj::simd_par_min_n()) {return simd_par_dot<T>(N,X,Y);}
+  #define ARRAY_SIMD_CALL(AL) return simd_dot<T,(AL < (int) sizeof(T) ? (int) sizeof(T) : AL)>(N,X,Y)
+  ARRAY_SIMD_SWITCH(T,align,ARRAY_SIMD_CALL,return simd_dot<T>(N,X,Y))
+  #undef ARRAY_SIMD_CALL
+  return (T) 0;
+}
+
+#endif
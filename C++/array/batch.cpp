@@ -0,0 +1,248 @@
+/*-------------------------------------------------------
+  batch.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for libj::batch, see batch.hpp
+-------------------------------------------------------*/
+#include <utility> //for std::move
+#include "batch.hpp"
+#include "mem_registry.hpp"
+#include "array_simd.hpp"
+
+namespace libj
+{
+
+/*-------------------------------------------------------
+  Constructors
+-------------------------------------------------------*/
+template <typename M>
+batch<M>::batch()
+{
+  m_buf = NULL;
+  m_ptr = NULL;
+  m_nb = 0;
+  m_nrow = 0;
+  m_ncol = 0;
+  m_elem = 0;
+  m_layout = BATCH_SOA;
+}
+
+template <typename M>
+batch<M>::batch(const long nb, const long n, const batch_layout layout) : batch()
+{
+  allocate(nb,n,n,layout);
+}
+
+template <typename M>
+batch<M>::batch(const long nb, const long n, const long m, const batch_layout layout) : batch()
+{
+  allocate(nb,n,m,layout);
+}
+
+template <typename M>
+batch<M>::~batch()
+{
+  free();
+}
+
+/*-------------------------------------------------------
+  move : takes the slab, other is left unset
+-------------------------------------------------------*/
+template <typename M>
+batch<M>::batch(batch<M>&& other) : batch()
+{
+  *this = std::move(other);
+}
+
+template <typename M>
+batch<M>& batch<M>::operator= (batch<M>&& other)
+{
+  if (this == &other) {return *this;}
+  free();
+  m_buf    = other.m_buf;
+  m_ptr    = other.m_ptr;
+  m_nb     = other.m_nb;
+  m_nrow   = other.m_nrow;
+  m_ncol   = other.m_ncol;
+  m_elem   = other.m_elem;
+  m_layout = other.m_layout;
+  other.m_buf  = NULL;
+  other.m_ptr  = NULL;
+  other.m_nb   = 0;
+  other.m_nrow = 0;
+  other.m_ncol = 0;
+  other.m_elem = 0;
+  return *this;
+}
+
+/*-------------------------------------------------------
+  allocate
+	- one malloc of nb matrices of n x m, aligned to
+          LIBJ_BATCH_ALIGN bytes
+-------------------------------------------------------*/
+template <typename M>
+void batch<M>::allocate(const long nb, const long n, const long m, const batch_layout layout)
+{
+  if (m_ptr != NULL)
+  {
+    printf("Attempted to allocate an already allocated batch \n");
+    exit(1);
+  }
+  if (nb < 0 || n < 0 || m < 0)
+  {
+    printf("Attempted to allocate batch of %ld matrices of %ld x %ld \n",nb,n,m);
+    exit(1);
+  }
+  const long elem = batch_traits<M>::elems(n,m);
+  const size_t bytes = LIBJ_BATCH_ALIGN + (size_t) (nb*elem)*sizeof(T);
+  m_ptr = (T*) malloc(bytes);
+  if (m_ptr == NULL)
+  {
+    printf("malloc failed for batch of %ld matrices of %ld elements \n",nb,elem);
+    exit(1);
+  }
+  libj::mem_track(m_ptr,bytes);
+  const long off = (long) m_ptr%LIBJ_BATCH_ALIGN;
+  m_buf = (off == 0) ? m_ptr : (T*) ((char*) m_ptr + (LIBJ_BATCH_ALIGN - off));
+  m_nb = nb;
+  m_nrow = n;
+  m_ncol = m;
+  m_elem = elem;
+  m_layout = layout;
+}
+
+/*-------------------------------------------------------
+  free
+-------------------------------------------------------*/
+template <typename M>
+void batch<M>::free()
+{
+  if (m_ptr != NULL)
+  {
+    libj::mem_untrack(m_ptr);
+    std::free(m_ptr);
+  }
+  m_buf = NULL;
+  m_ptr = NULL;
+  m_nb = 0;
+  m_nrow = 0;
+  m_ncol = 0;
+  m_elem = 0;
+}
+
+/*-------------------------------------------------------
+  zero
+	- zeros every matrix, in one pass over the slab
+-------------------------------------------------------*/
+template <typename M>
+void batch<M>::zero()
+{
+  array_simd_zero<T>(m_nb*m_elem,m_buf,LIBJ_BATCH_ALIGN);
+}
+
+/*-------------------------------------------------------
+  check_shape
+	- exits if X is not the shape of the matrices
+-------------------------------------------------------*/
+template <typename M>
+void batch<M>::check_shape(const M& X, const char* opr) const
+{
+  if (X.rows() != m_nrow || X.cols() != m_ncol)
+  {
+    printf("Attempted to %s batch of %ld x %ld with matrix of %ld x %ld \n",
+           opr,m_nrow,m_ncol,X.rows(),X.cols());
+    exit(1);
+  }
+}
+
+/*-------------------------------------------------------
+  view
+	- matrix b, assigned to its place in the slab.
+          Only AOS, where each matrix is contiguous
+-------------------------------------------------------*/
+template <typename M>
+M batch<M>::view(const long b)
+{
+  if (m_layout != BATCH_AOS || b < 0 || b >= m_nb)
+  {
+    printf("Attempted to view matrix %ld of batch of %ld, which needs BATCH_AOS \n",
+           b,m_nb);
+    exit(1);
+  }
+  M X;
+  X.assign(m_nrow,m_ncol,m_buf + b*m_elem);
+  return X;
+}
+
+/*-------------------------------------------------------
+  get
+	- X = matrix b, either layout
+-------------------------------------------------------*/
+template <typename M>
+void batch<M>::get(const long b, M& X) const
+{
+  check_shape(X,"get from");
+  for (long k=0;k<m_elem;k++) {batch_traits<M>::at(X,k,m_nrow) = elem(b,k);}
+}
+
+/*-------------------------------------------------------
+  set
+	- matrix b = X, either layout
+-------------------------------------------------------*/
+template <typename M>
+void batch<M>::set(const long b, const M& X)
+{
+  check_shape(X,"set into");
+  for (long k=0;k<m_elem;k++) {elem(b,k) = batch_traits<M>::at(X,k,m_nrow);}
+}
+
+/*-------------------------------------------------------
+  transpose
+	- change the layout, through a second slab. The
+          reads go in order of the old layout
+-------------------------------------------------------*/
+template <typename M>
+void batch<M>::transpose(const batch_layout layout)
+{
+  if (layout == m_layout) return;
+  batch<M> other(m_nb,m_nrow,m_ncol,layout);
+  const long nb = m_nb, ne = m_elem;
+  T* dst = other.m_buf;
+  const T* src = m_buf;
+  if (layout == BATCH_SOA)
+  {
+    for (long b=0;b<nb;b++)
+    {
+      for (long k=0;k<ne;k++) {dst[k*nb + b] = src[b*ne + k];}
+    }
+  } else {
+    for (long k=0;k<ne;k++)
+    {
+      for (long b=0;b<nb;b++) {dst[b*ne + k] = src[k*nb + b];}
+    }
+  }
+  *this = std::move(other);
+}
+
+template <typename M>
+void batch<M>::to_soa()
+{
+  transpose(BATCH_SOA);
+}
+
+template <typename M>
+void batch<M>::to_aos()
+{
+  transpose(BATCH_AOS);
+}
+
+template class batch<usymat<double>>;
+template class batch<usymat<float>>;
+template class batch<usymat<long>>;
+template class batch<usymat<int>>;
+template class batch<gemat<double>>;
+template class batch<gemat<float>>;
+template class batch<gemat<long>>;
+template class batch<gemat<int>>;
+
+}//end of namespace
@@ -0,0 +1,164 @@
+/*-------------------------------------------------------
+  batch.hpp
+	JHT, October 14, 2026 : created
+
+  libj::batch<M> : NB matrices of one shape, M = usymat<T>
+  or gemat<T>, in one aligned slab, instead of one malloc
+  (and class) each.
+
+  Layouts
+  --------------------------
+  libj::BATCH_AOS : matrix major, element k of matrix b
+                    is at X[b*elems() + k], so each matrix
+                    is its usymat/gemat buffer, see view()
+  libj::BATCH_SOA : element major, element k of matrix b
+                    is at X[k*NB + b], as the linal_*_batch
+                    routines take them (linal_batch.hpp),
+                    so simd goes across the batch
+
+  The element numbering k within each matrix is that of M:
+  j*(j+1)/2 + i (i <= j) for usymat, i + n*j for gemat.
+
+  NOTE : There is NO BOUNDS CHECKING in this class, unless
+         libj is built with -DLIBJ_CHECKED (see debug.hpp)
+
+  NOTE : A batch can be moved, but not copied
+
+  INITIALIZATION OPTIONS
+  --------------------------
+  libj::batch<usymat<double>> B;	//nothing else
+  libj::batch<usymat<double>> B(NB,3);	//NB 3x3 usymat, SOA
+  libj::batch<gemat<double>> B(NB,3,4,libj::BATCH_AOS);	//NB 3x4 gemat, AOS
+  B.allocate(NB,3,3,libj::BATCH_SOA);	//one aligned malloc
+
+  ACCESSING OPTIONS
+  --------------------------
+  B(b,i,j)		//element i,j of matrix b
+  B.elem(b,k)		//element k of matrix b
+  B.data()		//the slab, for linal_*_batch
+  usymat<double> M = B.view(b);	//matrix b in place, AOS only
+
+  FUNCTIONS
+  --------------------------
+  B.size();		//number of matrices, NB
+  B.rows(); B.cols();	//shape of each matrix
+  B.elems();		//elements per matrix
+  B.layout();		//libj::BATCH_AOS or libj::BATCH_SOA
+  B.get(b,M);		//M = matrix b, M of the same shape
+  B.set(b,M);		//matrix b = M
+  B.to_soa(); B.to_aos();	//change the layout, one copy
+  B.zero();		//zeros all matrices
+  B.free();		//frees the slab
+
+  USAGE WITH linal_batch
+  --------------------------
+  libj::batch<usymat<double>> B(NB,3);
+  linal_usym3_invrt_batch<double>(B.size(),B.data());
+--------------------------------------------------------*/
+#ifndef LIBJ_BATCH_HPP
+#define LIBJ_BATCH_HPP
+
+#include <cstdlib>
+#include <stdio.h>
+#include "gemat.hpp"
+#include "usymat.hpp"
+#include "debug.hpp"
+
+//alignment of the slab, in BYTES
+#define LIBJ_BATCH_ALIGN 64
+
+namespace libj
+{
+
+//layout of the slab, see above
+enum batch_layout {BATCH_AOS, BATCH_SOA};
+
+//element numbering of each matrix type
+template <typename M> struct batch_traits;
+
+template <typename T>
+struct batch_traits<usymat<T>>
+{
+  typedef T value_type;
+  static long elems(const long n, const long m) {return n*(n+1)/2;}
+  static long index(const long i, const long j, const long n) {return j*(j+1)/2 + i;}
+  static T& at(usymat<T>& X, const long k, const long n) {return X[k];}
+  static const T& at(const usymat<T>& X, const long k, const long n) {return X[k];}
+};
+
+template <typename T>
+struct batch_traits<gemat<T>>
+{
+  typedef T value_type;
+  static long elems(const long n, const long m) {return n*m;}
+  static long index(const long i, const long j, const long n) {return i + n*j;}
+  static T& at(gemat<T>& X, const long k, const long n) {return X(k%n,k/n);}
+  static const T& at(const gemat<T>& X, const long k, const long n) {return X(k%n,k/n);}
+};
+
+template <typename M>
+class batch
+{
+  public:
+  typedef typename batch_traits<M>::value_type T;
+
+  private:
+  T*    m_buf;		//aligned start of the slab
+  T*    m_ptr;		//pointer to free
+  long  m_nb;		//number of matrices
+  long  m_nrow;		//rows of each
+  long  m_ncol;		//cols of each
+  long  m_elem;		//elements of each
+  batch_layout m_layout;	//BATCH_AOS or BATCH_SOA
+
+  public:
+  batch();
+  batch(const long nb, const long n, const batch_layout layout=BATCH_SOA);	//n x n
+  batch(const long nb, const long n, const long m, const batch_layout layout=BATCH_SOA);
+ ~batch();
+
+  batch(batch<M>&& other);
+  batch<M>& operator= (batch<M>&& other);
+  batch(const batch<M>& other) = delete;
+  batch<M>& operator= (const batch<M>& other) = delete;
+
+  //element access : inlined
+  inline T& elem(const long b, const long k)	//element k of matrix b
+    {LIBJ_CHECK_BOUNDS(b,m_nb); LIBJ_CHECK_BOUNDS(k,m_elem);
+     return (m_layout == BATCH_SOA) ? m_buf[k*m_nb + b] : m_buf[b*m_elem + k];}
+  inline const T& elem(const long b, const long k) const
+    {LIBJ_CHECK_BOUNDS(b,m_nb); LIBJ_CHECK_BOUNDS(k,m_elem);
+     return (m_layout == BATCH_SOA) ? m_buf[k*m_nb + b] : m_buf[b*m_elem + k];}
+  inline T& operator() (const long b, const long i, const long j)	//element i,j of matrix b
+    {return elem(b,batch_traits<M>::index(i,j,m_nrow));}
+  inline const T& operator() (const long b, const long i, const long j) const
+    {return elem(b,batch_traits<M>::index(i,j,m_nrow));}
+
+  //dimension information : inlined
+  inline long size() const {return m_nb;}
+  inline long rows() const {return m_nrow;}
+  inline long cols() const {return m_ncol;}
+  inline long elems() const {return m_elem;}
+  inline batch_layout layout() const {return m_layout;}
+  inline T* data() {return m_buf;}
+  inline const T* data() const {return m_buf;}
+  inline bool is_allocated() const {return m_ptr != NULL;}
+
+  void allocate(const long nb, const long n, const long m, const batch_layout layout=BATCH_SOA);
+  void free();
+  void zero();
+
+  M view(const long b);			//matrix b in place, AOS only
+  void get(const long b, M& X) const;	//X = matrix b
+  void set(const long b, const M& X);	//matrix b = X
+  void to_soa();			//change layout to SOA
+  void to_aos();			//change layout to AOS
+
+  private:
+  void check_shape(const M& X, const char* opr) const;
+  void transpose(const batch_layout layout);
+};
+
+}//end of namespace
+
+#endif
@@ -3,7 +3,11 @@
   .cpp file for gemat class, desinged to deal with 
   general matrices. See .hpp file for usage details 
 -------------------------------------------------------*/
+#include <utility> //for std::move
+#include <math.h>  //for sqrt
 #include "gemat.hpp"
+#include "array_simd.hpp"
+#include "array_print.hpp"
 
 /*-------------------------------------------------------
   Constructors
@@ -16,8 +20,10 @@ gemat<T>::gemat()
   m_len = 0;
   m_nrow = 0;
   m_ncol = 0;
+  m_ld = 0;
   m_alignment = 0;
   m_assigned = false;
+  m_alloc = NULL;
   m_allocated = false;
 }
 template gemat<double>::gemat();
@@ -31,6 +37,7 @@ gemat<T>::gemat(const long n, const long m)
 {
   m_allocated = false;
   m_assigned = false;
+  m_alloc = NULL;
   allocate(n,m);
 }
 template gemat<double>::gemat(const long n, const long m);
@@ -44,6 +51,7 @@ gemat<T>::gemat(const long n, const long m, T* ptr)
 {
   m_allocated = false;
   m_assigned = false;
+  m_alloc = NULL;
   assign(n,m,ptr);
 }
 template gemat<double>::gemat(const long n, const long m, double* ptr);
@@ -65,6 +73,122 @@ template gemat<float>::~gemat();
 template gemat<long>::~gemat();
 template gemat<int>::~gemat();
 template gemat<double*>::~gemat();
+
+/*-------------------------------------------------------
+   move constructor and assignment
+	- takes the buffer (and allocator) of other, which is 
+	  left unset, so it frees nothing
+-------------------------------------------------------*/
+template <typename T>
+gemat<T>::gemat(gemat<T>&& other)
+{
+  m_buf = NULL;
+  m_ptr = NULL;
+  m_len = 0;
+  m_nrow = 0;
+  m_ncol = 0;
+  m_ld = 0;
+  m_alignment = 0;
+  m_allocated = false;
+  m_assigned = false;
+  m_alloc = NULL;
+  *this = std::move(other);
+}
+template gemat<double>::gemat(gemat<double>&& other);
+template gemat<float>::gemat(gemat<float>&& other);
+template gemat<long>::gemat(gemat<long>&& other);
+template gemat<int>::gemat(gemat<int>&& other);
+template gemat<double*>::gemat(gemat<double*>&& other);
+
+template <typename T>
+gemat<T>& gemat<T>::operator= (gemat<T>&& other)
+{
+  if (this == &other) {return *this;}
+  free();
+  m_buf       = other.m_buf;
+  m_ptr       = other.m_ptr;
+  m_len       = other.m_len;
+  m_nrow      = other.m_nrow;
+  m_ncol      = other.m_ncol;
+  m_ld        = other.m_ld;
+  m_alignment = other.m_alignment;
+  m_allocated = other.m_allocated;
+  m_assigned  = other.m_assigned;
+  m_alloc     = other.m_alloc;
+  other.m_buf       = NULL;
+  other.m_ptr       = NULL;
+  other.m_len       = 0;
+  other.m_nrow      = 0;
+  other.m_ncol      = 0;
+  other.m_ld        = 0;
+  other.m_alignment = 0;
+  other.m_allocated = false;
+  other.m_assigned  = false;
+  other.m_alloc     = NULL;
+  return *this;
+}
+template gemat<double>& gemat<double>::operator= (gemat<double>&& other);
+template gemat<float>& gemat<float>::operator= (gemat<float>&& other);
+template gemat<long>& gemat<long>::operator= (gemat<long>&& other);
+template gemat<int>& gemat<int>::operator= (gemat<int>&& other);
+template gemat<double*>& gemat<double*>::operator= (gemat<double*>&& other);
+
+/*-------------------------------------------------------
+   clone
+	- deep copy, allocated via malloc. The copy of
+	  a view is contiguous (ld == rows)
+-------------------------------------------------------*/
+template <typename T>
+gemat<T> gemat<T>::clone() const
+{
+  gemat<T> X;
+  if (m_allocated || m_assigned)
+  {
+    X.allocate(m_nrow,m_ncol);
+    for (long j=0;j<m_ncol;j++)
+    {
+      for (long i=0;i<m_nrow;i++) {X.m_buf[i+m_nrow*j] = m_buf[i+m_ld*j];}
+    }
+  }
+  return X;
+}
+template gemat<double> gemat<double>::clone() const;
+template gemat<float> gemat<float>::clone() const;
+template gemat<long> gemat<long>::clone() const;
+template gemat<int> gemat<int>::clone() const;
+template gemat<double*> gemat<double*>::clone() const;
+
+/*-------------------------------------------------------
+   zeros
+	- factory, allocated via malloc and zeroed
+-------------------------------------------------------*/
+template <typename T>
+gemat<T> gemat<T>::zeros(const long n, const long m)
+{
+  gemat<T> X(n,m);
+  if (X.size() > 0) {X.zero();}
+  return X;
+}
+template gemat<double> gemat<double>::zeros(const long n, const long m);
+template gemat<float> gemat<float>::zeros(const long n, const long m);
+template gemat<long> gemat<long>::zeros(const long n, const long m);
+template gemat<int> gemat<int>::zeros(const long n, const long m);
+
+/*-------------------------------------------------------
+   identity
+	- factory, n x n identity allocated via malloc
+-------------------------------------------------------*/
+template <typename T>
+gemat<T> gemat<T>::identity(const long n)
+{
+  gemat<T> X(n,n);
+  if (X.size() > 0) {X.I();}
+  return X;
+}
+template gemat<double> gemat<double>::identity(const long n);
+template gemat<float> gemat<float>::identity(const long n);
+template gemat<long> gemat<long>::identity(const long n);
+template gemat<int> gemat<int>::identity(const long n);
 /*-------------------------------------------------------
  * calc_alignment()
  * calculates the alignment of m_buf
@@ -98,7 +222,9 @@ void gemat<T>::aligned_allocate(const int ALIGN, const long n, const long m)
   if (!(m_allocated || m_assigned) && ll >= 0 && ll <= mm) 
 //  if (!(m_allocated || m_assigned) && ll >= 1 && ll <= mm) 
   {
-    m_ptr = (T*) malloc(ALIGN+ll*sizeof(T));
+    m_ptr = (m_alloc != NULL) ? m_alloc->allocate((size_t) ALIGN,(size_t) ll)
+                              : (T*) malloc(ALIGN+ll*sizeof(T));
+    if (m_alloc == NULL) {libj::mem_track(m_ptr,ALIGN+ll*sizeof(T));}
 //  } else if (ll < 1) {
 //    printf("Attempted to allocate gemat of < 1 element \n");
   } else if (ll < 0) {
@@ -133,6 +259,7 @@ void gemat<T>::aligned_allocate(const int ALIGN, const long n, const long m)
     m_len = ll;
     m_nrow = n;
     m_ncol = m;
+    m_ld = n;
     m_allocated = true;
     m_assigned = false;
     calc_alignment();
@@ -160,7 +287,9 @@ void gemat<T>::allocate(const long n, const long m)
 //  if (!(m_allocated || m_assigned) && ll >= 1 && ll <= mm) 
   if (!(m_allocated || m_assigned) && ll >= 0 && ll <= mm) 
   {
-    m_ptr = (T*) malloc(ll*sizeof(T));
+    m_ptr = (m_alloc != NULL) ? m_alloc->allocate(sizeof(T),(size_t) ll)
+                              : (T*) malloc(ll*sizeof(T));
+    if (m_alloc == NULL) {libj::mem_track(m_ptr,ll*sizeof(T));}
 //  } else if (ll < 1) {
 //    printf("Attempted to allocate gemat of < 1 element \n");
   } else if (ll < 0) {
@@ -180,6 +309,7 @@ void gemat<T>::allocate(const long n, const long m)
     m_len = ll;
     m_nrow = n;
     m_ncol = m;
+    m_ld = n;
     m_allocated = true; 
     m_assigned = false;
     calc_alignment();
@@ -212,6 +342,7 @@ void gemat<T>::assign(const long n, const long m, T* pntr)
     m_len = ll;
     m_nrow = n;
     m_ncol = m;
+    m_ld = n;
     m_assigned = true;
     m_allocated = false;
   } else if (m_allocated || m_assigned) {
@@ -258,6 +389,7 @@ void gemat<T>::reassign(const long n, const long m, T* pntr)
     m_len = ll;
     m_nrow = n;
     m_ncol = m;
+    m_ld = n;
     m_assigned = true;
     m_allocated = false;
   } else if (!m_assigned) {
@@ -286,6 +418,55 @@ template void gemat<long>::reassign(const long n, const long m, long* pntr);
 template void gemat<int>::reassign(const long n, const long m, int* pntr);
 template void gemat<double*>::reassign(const long n, const long m, double** pntr);
 
+/*-------------------------------------------------------
+   assign with a leading dimension
+     - n x m matrix at pntr, with column j starting at
+       pntr + ld*j (ld >= n), as the LDA of BLAS
+-------------------------------------------------------*/
+template <typename T>
+void gemat<T>::assign(const long n, const long m, const long ld, T* pntr)
+{
+  if (ld < n || ld < 1)
+  {
+    printf("Attempted to assign gemat with ld %ld < rows %ld \n",ld,n);
+    exit(1);
+  }
+  assign(n,m,pntr);
+  m_ld = ld;
+}
+template void gemat<double>::assign(const long n, const long m, const long ld, double* pntr);
+template void gemat<float>::assign(const long n, const long m, const long ld, float* pntr);
+template void gemat<long>::assign(const long n, const long m, const long ld, long* pntr);
+template void gemat<int>::assign(const long n, const long m, const long ld, int* pntr);
+template void gemat<double*>::assign(const long n, const long m, const long ld, double** pntr);
+
+/*-------------------------------------------------------
+   view
+     - the nr x nc sub-matrix at row i0, col j0, 
+       assigned to this buffer with this ld, so it  
+       works in place. It is only valid while this
+       buffer is
+-------------------------------------------------------*/
+template <typename T>
+gemat<T> gemat<T>::view(const long i0, const long j0, const long nr, const long nc)
+{
+  if (!(m_allocated || m_assigned) || i0 < 0 || j0 < 0 || nr < 0 || nc < 0 
+      || i0+nr > m_nrow || j0+nc > m_ncol)
+  {
+    printf("Attempted view [%ld:%ld,%ld:%ld] of %ld x %ld gemat \n",
+           i0,i0+nr,j0,j0+nc,m_nrow,m_ncol);
+    exit(1);
+  }
+  gemat<T> V;
+  V.assign(nr,nc,m_ld,m_buf+i0+m_ld*j0);
+  return V;
+}
+template gemat<double> gemat<double>::view(const long i0, const long j0, const long nr, const long nc);
+template gemat<float> gemat<float>::view(const long i0, const long j0, const long nr, const long nc);
+template gemat<long> gemat<long>::view(const long i0, const long j0, const long nr, const long nc);
+template gemat<int> gemat<int>::view(const long i0, const long j0, const long nr, const long nc);
+template gemat<double*> gemat<double*>::view(const long i0, const long j0, const long nr, const long nc);
+
 /*-------------------------------------------------------
    Deallocate
 -------------------------------------------------------*/
@@ -295,10 +476,12 @@ void gemat<T>::deallocate()
   if (m_allocated)  
   { 
     m_buf = NULL;
-    std::free(m_ptr); 
+    if (m_alloc != NULL) {m_alloc->deallocate(m_ptr,(size_t) m_len);}
+    else                 {libj::mem_untrack(m_ptr); std::free(m_ptr);}
     m_len = 0;
     m_nrow = 0;
     m_ncol = 0;
+    m_ld = 0;
     m_alignment = 0;
     m_allocated = false;
   } else {
@@ -321,6 +504,7 @@ void gemat<T>::unassign()
     m_len = 0;
     m_nrow = 0;
     m_ncol = 0;
+    m_ld = 0;
     m_buf = NULL;
     m_ptr = NULL;
     m_assigned = false;
@@ -352,6 +536,7 @@ void gemat<T>::free()
     m_len = 0;
     m_nrow = 0;
     m_ncol = 0;
+    m_ld = 0;
     m_alignment = 0;
     m_allocated = false;
     m_assigned = false;
@@ -375,6 +560,7 @@ void gemat<T>::info() const
     printf("gemat has %ld elements \n",m_len);
     printf("gemat has %ld rows \n",m_nrow);
     printf("gemat has %ld cols \n",m_ncol);
+    printf("gemat has leading dimension %ld \n",m_ld);
     printf("gemat is aligned to %d bytes \n",m_alignment);
     printf("gemat points to  %p \n",(void *) m_ptr);
     printf("gemat buffer starts at  %p \n",(void *) m_buf);
@@ -392,19 +578,21 @@ template void gemat<int>::info() const;
 template void gemat<double*>::info() const;
 /*-------------------------------------------------------
   zero()
-	- zeros the matrix 
+	- zeros the matrix, see array_simd.hpp 
 -------------------------------------------------------*/
 template <typename T>
 void gemat<T>::zero()
 {
   assert(m_allocated||m_assigned);
-  const long ll=m_len-1;
-  long i=0;
-  while (true)
+  if (is_contiguous() || m_ncol == 1)
   {
-    *(m_buf+i) = 0;
-    if (i >= ll) break;
-    i++;
+    array_simd_zero<T>(m_nrow*m_ncol,m_buf,m_alignment);
+    return;
+  }
+  for (long j=0;j<m_ncol;j++)
+  {
+    T* col = m_buf + m_ld*j;
+    array_simd_zero<T>(m_nrow,col,array_simd_ptr_align(col));
   }
 }
 template void gemat<double>::zero();
@@ -414,9 +602,8 @@ template void gemat<int>::zero();
 /*-------------------------------------------------------
   I() 
 	- makes the main diagonal of the matrix = 1 
-        - one could do this in two setps, but 
-            here we only make one pass through the 
-            m_buffer
+        - zeros, then sets the diagonal, which also 
+            works for views (ld > rows)
 
    example
    1 0 0      1 0 0 0      1 0 0
@@ -429,42 +616,9 @@ template <typename T>
 void gemat<T>::I()
 {
   assert(m_allocated||m_assigned);
-
-  //find number of iterations to traverse
-  const long nitr=(m_nrow <= m_ncol) ? m_nrow : m_ncol; 
-  const long nr=m_nrow+1;
-  const long l1=m_len-1;
-  const long l2=nitr-1;
-
-  long i=0;
-  long itr=0;
-  while(true)
-  {
-    *(m_buf+i) = (T) 1; //diagonal element
-
-    //fast forward to next diagonal
-    if (itr >= l2) break;
-    i++;
-    itr++;
-    
-    //here we want the extra i++
-    //fill in zeros up to next diagonal
-    while(i<nr*itr)
-    {
-      *(m_buf+i) = (T) 0;
-      i++;
-    }
-  }
-
-  //cleanup at end
-  //i starts on final diagonal
-  while(true)
-  {
-    if (i>=l1) break;
-    i++;
-    *(m_buf+i) = (T) 0;
-  }
-
+  zero();
+  const long nd = (m_nrow < m_ncol) ? m_nrow : m_ncol;
+  for (long j=0;j<nd;j++) {*(m_buf+m_ld*j+j) = (T) 1;}
 }
 template void gemat<double>::I();
 template void gemat<float>::I();
@@ -478,19 +632,197 @@ template <typename T>
 void gemat<T>::operator= (const T a)
 {
   assert (m_allocated||m_assigned);
-  long i=0;
-  const long ll=m_len-1;
-  while (true)
+  if (is_contiguous() || m_ncol == 1)
   {
-    *(m_buf+i) = a;
-    if (i >= ll) break;
-    i++;
+    array_simd_set<T>(m_nrow*m_ncol,a,m_buf,m_alignment);
+    return;
+  }
+  for (long j=0;j<m_ncol;j++)
+  {
+    T* col = m_buf + m_ld*j;
+    array_simd_set<T>(m_nrow,a,col,array_simd_ptr_align(col));
   }
 }
 template void gemat<double>::operator= (const double a);
 template void gemat<float>::operator= (const float a);
 template void gemat<long>::operator= (const long a);
 template void gemat<int>::operator= (const int a);
+/*-------------------------------------------------------
+  scale
+	- M = a*M 
+-------------------------------------------------------*/
+template <typename T>
+void gemat<T>::scale(const T a)
+{
+  assert(m_allocated||m_assigned);
+  if (is_contiguous() || m_ncol == 1)
+  {
+    array_simd_scale<T>(m_nrow*m_ncol,a,m_buf,m_alignment);
+    return;
+  }
+  for (long j=0;j<m_ncol;j++)
+  {
+    T* col = m_buf + m_ld*j;
+    array_simd_scale<T>(m_nrow,a,col,array_simd_ptr_align(col));
+  }
+}
+template void gemat<double>::scale(const double a);
+template void gemat<float>::scale(const float a);
+template void gemat<long>::scale(const long a);
+template void gemat<int>::scale(const int a);
+/*-------------------------------------------------------
+  check_shape
+	- exits if X is not the shape of this matrix 
+-------------------------------------------------------*/
+template <typename T>
+void gemat<T>::check_shape(const gemat<T>& X, const char* opr) const
+{
+  if (m_nrow != X.m_nrow || m_ncol != X.m_ncol)
+  {
+    printf("Attempted to %s gemat of %ld x %ld with gemat of %ld x %ld \n",
+           opr,m_nrow,m_ncol,X.m_nrow,X.m_ncol);
+    exit(1);
+  }
+}
+template void gemat<double>::check_shape(const gemat<double>& X, const char* opr) const;
+template void gemat<float>::check_shape(const gemat<float>& X, const char* opr) const;
+template void gemat<long>::check_shape(const gemat<long>& X, const char* opr) const;
+template void gemat<int>::check_shape(const gemat<int>& X, const char* opr) const;
+/*-------------------------------------------------------
+  axpy
+	- M = M + a*X 
+-------------------------------------------------------*/
+template <typename T>
+void gemat<T>::axpy(const T a, const gemat<T>& X)
+{
+  assert(m_allocated||m_assigned);
+  check_shape(X,"axpy");
+  if ((is_contiguous() && X.is_contiguous()) || m_ncol == 1)
+  {
+    array_simd_axpy<T>(m_nrow*m_ncol,a,X.m_buf,m_buf,
+                       array_simd_align(m_alignment,X.m_alignment));
+    return;
+  }
+  for (long j=0;j<m_ncol;j++)
+  {
+    T* col = m_buf + m_ld*j;
+    const T* xcol = X.m_buf + X.m_ld*j;
+    array_simd_axpy<T>(m_nrow,a,xcol,col,
+                       array_simd_align(array_simd_ptr_align(col),array_simd_ptr_align(xcol)));
+  }
+}
+template void gemat<double>::axpy(const double a, const gemat<double>& X);
+template void gemat<float>::axpy(const float a, const gemat<float>& X);
+template void gemat<long>::axpy(const long a, const gemat<long>& X);
+template void gemat<int>::axpy(const int a, const gemat<int>& X);
+/*-------------------------------------------------------
+  copy_from
+	- M = X, of the same shape 
+-------------------------------------------------------*/
+template <typename T>
+void gemat<T>::copy_from(const gemat<T>& X)
+{
+  assert(m_allocated||m_assigned);
+  check_shape(X,"copy_from");
+  if ((is_contiguous() && X.is_contiguous()) || m_ncol == 1)
+  {
+    array_simd_copy<T>(m_nrow*m_ncol,X.m_buf,m_buf,
+                       array_simd_align(m_alignment,X.m_alignment));
+    return;
+  }
+  for (long j=0;j<m_ncol;j++)
+  {
+    T* col = m_buf + m_ld*j;
+    const T* xcol = X.m_buf + X.m_ld*j;
+    array_simd_copy<T>(m_nrow,xcol,col,
+                       array_simd_align(array_simd_ptr_align(col),array_simd_ptr_align(xcol)));
+  }
+}
+template void gemat<double>::copy_from(const gemat<double>& X);
+template void gemat<float>::copy_from(const gemat<float>& X);
+template void gemat<long>::copy_from(const gemat<long>& X);
+template void gemat<int>::copy_from(const gemat<int>& X);
+/*-------------------------------------------------------
+  gemat_dot
+	- sum_ij A(i,j)*X(i,j), of nr x nc matrices with
+          leading dimensions lda and ldx
+-------------------------------------------------------*/
+template <typename T>
+static T gemat_dot(const long nr, const long nc, 
+                   const T* A, const long lda, const int aligna,
+                   const T* X, const long ldx, const int alignx)
+{
+  if ((lda == nr && ldx == nr) || nc == 1)
+  {
+    return array_simd_dot<T>(nr*nc,A,X,array_simd_align(aligna,alignx));
+  }
+  T sum = (T) 0;
+  for (long j=0;j<nc;j++)
+  {
+    const T* acol = A + lda*j;
+    const T* xcol = X + ldx*j;
+    sum += array_simd_dot<T>(nr,acol,xcol,
+                             array_simd_align(array_simd_ptr_align(acol),array_simd_ptr_align(xcol)));
+  }
+  return sum;
+}
+/*-------------------------------------------------------
+  dot
+	- sum_ij M(i,j)*X(i,j) 
+        - specialized, as gemat<double*> has no product
+-------------------------------------------------------*/
+template <>
+double gemat<double>::dot(const gemat<double>& X) const
+{
+  assert(m_allocated||m_assigned);
+  check_shape(X,"dot");
+  return gemat_dot<double>(m_nrow,m_ncol,m_buf,m_ld,m_alignment,X.m_buf,X.m_ld,X.m_alignment);
+}
+template <>
+float gemat<float>::dot(const gemat<float>& X) const
+{
+  assert(m_allocated||m_assigned);
+  check_shape(X,"dot");
+  return gemat_dot<float>(m_nrow,m_ncol,m_buf,m_ld,m_alignment,X.m_buf,X.m_ld,X.m_alignment);
+}
+template <>
+long gemat<long>::dot(const gemat<long>& X) const
+{
+  assert(m_allocated||m_assigned);
+  check_shape(X,"dot");
+  return gemat_dot<long>(m_nrow,m_ncol,m_buf,m_ld,m_alignment,X.m_buf,X.m_ld,X.m_alignment);
+}
+template <>
+int gemat<int>::dot(const gemat<int>& X) const
+{
+  assert(m_allocated||m_assigned);
+  check_shape(X,"dot");
+  return gemat_dot<int>(m_nrow,m_ncol,m_buf,m_ld,m_alignment,X.m_buf,X.m_ld,X.m_alignment);
+}
+/*-------------------------------------------------------
+  norm
+	- Frobenius norm, sqrt(M.dot(M)) 
+-------------------------------------------------------*/
+template <>
+double gemat<double>::norm() const
+{
+  return sqrt((double) dot(*this));
+}
+template <>
+double gemat<float>::norm() const
+{
+  return sqrt((double) dot(*this));
+}
+template <>
+double gemat<long>::norm() const
+{
+  return sqrt((double) dot(*this));
+}
+template <>
+double gemat<int>::norm() const
+{
+  return sqrt((double) dot(*this));
+}
 /*-------------------------------------------------------
   print
 	- prints elements of vector
@@ -499,13 +831,15 @@ template <>
 void gemat<double>::print() const
 {
   assert(m_allocated||m_assigned);
-  long xx=0;
+  array_print out;
   for (long j=0;j<m_ncol;j++)
   {
     for (long i=0;i<m_nrow;i++)
     {
-      printf("[%ld,%ld]    %18.15E \n",i,j,*(m_buf+xx));
-      xx++;
+      const long xx = i+m_ld*j;
+      out.idx(i,j);
+      out.num(*(m_buf+xx));
+      out.put(" \n");
     }
   }
 }
@@ -514,13 +848,15 @@ template <>
 void gemat<float>::print() const
 {
   assert(m_allocated||m_assigned);
-  long xx=0;
+  array_print out;
   for (long j=0;j<m_ncol;j++)
   {
     for (long i=0;i<m_nrow;i++)
     {
-      printf("[%ld,%ld]    %10.7E \n",i,j,*(m_buf+xx));
-      xx++;
+      const long xx = i+m_ld*j;
+      out.idx(i,j);
+      out.num(*(m_buf+xx));
+      out.put(" \n");
     }
   }
 }
@@ -529,13 +865,15 @@ template <>
 void gemat<long>::print() const
 {
   assert(m_allocated||m_assigned);
-  long xx=0;
+  array_print out;
   for (long j=0;j<m_ncol;j++)
   {
     for (long i=0;i<m_nrow;i++)
     {
-      printf("[%ld,%ld]    %ld \n",i,j,*(m_buf+xx));
-      xx++;
+      const long xx = i+m_ld*j;
+      out.idx(i,j);
+      out.num(*(m_buf+xx));
+      out.put(" \n");
     }
   }
 }
@@ -544,13 +882,15 @@ template <>
 void gemat<int>::print() const
 {
   assert(m_allocated||m_assigned);
-  long xx=0;
+  array_print out;
   for (long j=0;j<m_ncol;j++)
   {
     for (long i=0;i<m_nrow;i++)
     {
-      printf("[%ld,%ld]    %d \n",i,j,*(m_buf+xx));
-      xx++;
+      const long xx = i+m_ld*j;
+      out.idx(i,j);
+      out.num(*(m_buf+xx));
+      out.put(" \n");
     }
   }
 }
@@ -559,13 +899,15 @@ template <>
 void gemat<double*>::print() const
 {
   assert(m_allocated||m_assigned);
-  long xx=0;
+  array_print out;
   for (long j=0;j<m_ncol;j++)
   {
     for (long i=0;i<m_nrow;i++)
     {
-      printf("[%ld,%ld]    %p \n",i,j,(void*) *(m_buf+xx));
-      xx++;
+      const long xx = i+m_ld*j;
+      out.idx(i,j);
+      out.num((const void*) *(m_buf+xx));
+      out.put(" \n");
     }
   }
 }
@@ -1,6 +1,9 @@
 /*-------------------------------------------------------
   gemat.hpp
 	JHT, October 28, 2021 : created 
+	JHT, October 14, 2026 : added move semantics, clone, and the factories
+	JHT, October 14, 2026 : added the leading dimension and views
+	JHT, October 14, 2026 : added the simd bulk operations
   
   (GE)neral (MAT)rix : COL-MAJOR, general matrix, 
   which can be assigned to or allocated with memory, 
@@ -9,13 +12,22 @@
   NOTE : this matrix is accessed in COLUMN-MAJOR order, 
          which this author believes to be superior. 
 
-  NOTE : There is NO BOUNDS CHECKING in this class
+  NOTE : There is NO BOUNDS CHECKING in this class, unless
+         libj is built with -DLIBJ_CHECKED (see debug.hpp)
+
+  NOTE : A gemat can be moved (returned from a function, 
+         held in a std::vector), but not copied, see clone()
+
+  NOTE : Column j starts ld() elements after column j-1. 
+         ld() == rows() unless the matrix is a view (or 
+         assigned with an ld), whose M[i] is then the i'th
+         element of the buffer, not of the view
 
   NOTE : Indexing begins at zero
 
   ACCESSING OPTIONS
   --------------------------
-  M(i,j)		//access in COL-MAJOR order 
+  M(i,j)		//access in COL-MAJOR order, at M[i+M.ld()*j]
   M[i]			//access i'th element in buffer
 
   INITIALIZATION OPTIONS
@@ -25,6 +37,14 @@
   gemat<double> M(2,3,pntr);	//generates and assign location
   M.allocate(2,3);	            //allocates via malloc 
   M.assign(2,3,pntr);	        //assigns buffer to address
+  M.set_allocator(&arena);       //allocate from a libj::allocator, see core_arena.hpp
+  M.assign(2,3,ld,pntr);	//assigns with leading dimension ld >= 2
+  gemat<double> S = M.view(i0,j0,nr,nc);	//nr x nc sub-matrix at i0,j0, in place
+  gemat<double> M = gemat<double>::zeros(2,3);	//allocated and zeroed
+  gemat<double> M = gemat<double>::identity(3);	//allocated identity
+  gemat<double> X = M.clone();		//deep copy, allocated via malloc
+  gemat<double> X(std::move(M));		//takes the buffer, M is unset
+  gemat<double> X = f();			//returned by move, no copy
 
   DEALLOCATION OPTIONS
   --------------------------
@@ -38,11 +58,25 @@
   M.size();		//returns number of elem (long)
   M.rows();		//returns number of rows (long)
   M.cols();		//returns number of cols (long)
+  M.ld();		//returns the leading dimension (long)
+  M.data();		//returns pointer to M(0,0), for linal_* with LDA
   M.zero();		//zeros the whole matrix
   M.I();		//makes matrix the identity
+  M = a;		//sets all elements to a
+  M.scale(a);		//M = a*M
+  M.axpy(a,X);		//M = M + a*X, X of the same shape
+  M.copy_from(X);	//M = X, X of the same shape
+  M.dot(X);		//sum of M(i,j)*X(i,j)
+  M.norm();		//Frobenius norm (double)
   M.is_allocated();	//returns true if matrix is allocated
   M.is_assigned();	//returns true if matrix is assigned
 
+  The bulk operations (zero, I, =, scale, axpy, copy_from,
+  dot) call the aligned simd_*<T,ALIGNMENT> for the 
+  alignment of the buffer(s), and the threaded simd_par_*
+  for libj::simd_par_min_n() or more elements, see 
+  array_simd.hpp. Views go a column at a time.
+
 --------------------------------------------------------*/
 #ifndef GEMAT_HPP
 #define GEMAT_HPP
@@ -52,6 +86,9 @@
 #include <stdio.h> //for printf
 #include <limits>  //for numeric_limits::max()
 #include <assert.h>//for assert
+#include "allocator.hpp"
+#include "mem_registry.hpp"
+#include "debug.hpp"
 
 template <typename T>
 class gemat
@@ -62,9 +99,11 @@ class gemat
   long             m_len;	//number of elements
   long            m_nrow;	//number of rows
   long            m_ncol;	//number of cols
+  long              m_ld;	//leading dimension, elements between cols
   int        m_alignment;	//alignment in BYTES
   bool       m_allocated;	//is allocated
   bool        m_assigned;	//is assigned
+  libj::allocator<T>* m_alloc;	//allocator, NULL for malloc
 
   public:
   //initialization/destructors
@@ -73,15 +112,27 @@ class gemat
   gemat(const long n, const long m, T* ptr);	//assign with row,col
  ~gemat();					//destructor 
 
+  //move : takes the buffer, other is left unset. Copies are deleted, as
+  //  both would free the one buffer, use clone() for a deep copy
+  gemat(gemat<T>&& other);
+  gemat<T>& operator= (gemat<T>&& other);
+  gemat(const gemat<T>& other) = delete;
+  gemat<T>& operator= (const gemat<T>& other) = delete;
+
+  //factories, allocated via malloc
+  static gemat<T> zeros(const long n, const long m);	//zeroed
+  static gemat<T> identity(const long n);	//n x n identity
+  gemat<T> clone() const;	//deep copy
+
   //Operator overloading : inlined
   inline T& operator() (const long i, const long j)	//ref elm i,j
-    {return(*(m_buf+m_nrow*j+i));}
+    {LIBJ_CHECK_BOUNDS(i,m_nrow); LIBJ_CHECK_BOUNDS(j,m_ncol); return(*(m_buf+m_ld*j+i));}
   inline const T& operator() (const long i, const long j) const	//const elm i,j
-    {return(*(m_buf+m_nrow*j+i));}
+    {LIBJ_CHECK_BOUNDS(i,m_nrow); LIBJ_CHECK_BOUNDS(j,m_ncol); return(*(m_buf+m_ld*j+i));}
   inline T& operator[] (const long i)	//ref i'th element
-    {return(*(m_buf + i));}
+    {LIBJ_CHECK_BOUNDS(i,m_len); return(*(m_buf + i));}
   inline const T& operator[] (const long i) const	//const i'th element
-    {return(*(m_buf+i));}
+    {LIBJ_CHECK_BOUNDS(i,m_len); return(*(m_buf+i));}
 
   //Dimension information : inlined
   inline long size() const	//return length
@@ -90,12 +141,29 @@ class gemat
     {return(m_nrow);}
   inline long cols() const	//return ncol 
     {return(m_ncol);}
+  inline long ld() const	//return leading dimension
+    {return(m_ld);}
+  inline bool is_contiguous() const	//true if ld == rows
+    {return(m_ld == m_nrow);}
+  inline T* data()		//pointer to element 0,0
+    {return(m_buf);}
+  inline const T* data() const	//const pointer to element 0,0
+    {return(m_buf);}
 
   //allocated/assigned : inlined
   inline bool is_allocated()
     {return m_allocated;}
   inline bool is_assigned()
     {return m_assigned;}
+  inline void set_allocator(libj::allocator<T>* alloc)	//allocate from alloc, before allocate
+  {
+    if (m_allocated && alloc != m_alloc)
+    {
+      printf("Attempted to change the allocator of an allocated gemat \n");
+      exit(1);
+    }
+    m_alloc = alloc;
+  }
   inline int get_alignment()
     {return m_alignment;}
 
@@ -106,15 +174,26 @@ class gemat
   void deallocate();	//deallocate memory
   void unassign();	//unassign to memory
   void assign(const long n, const long m, T* ptr);	//assign to memory
+  void assign(const long n, const long m, const long ld, T* ptr);	//with leading dim.
+  gemat<T> view(const long i0, const long j0, 
+                const long nr, const long nc);	//sub-matrix, in place
   void reassign(const long n, const long m, T* ptr);	//reassign to memory
 
   void info() const;	//print info
   void zero();	//makes matrix zero
   void I();	//makes matrix identity
   void operator= (const T a);	//makes matrix constant
+  void scale(const T a);	//M = a*M
+  void axpy(const T a, const gemat<T>& X);	//M = M + a*X
+  void copy_from(const gemat<T>& X);	//M = X
+  T dot(const gemat<T>& X) const;	//sum of M(i,j)*X(i,j)
+  double norm() const;	//Frobenius norm
   void print() const;	//prints matrix
   void calc_alignment();
 
+  private:
+  void check_shape(const gemat<T>& X, const char* opr) const;	//exits on mismatch
+
 };
 template class gemat<double>;
 template class gemat<float>;
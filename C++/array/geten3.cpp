@@ -3,7 +3,9 @@
   .cpp file for geten3 class, desinged to deal with 
   general, 3 dimension tensors 
 -------------------------------------------------------*/
+#include <utility> //for std::move
 #include "geten3.hpp"
+#include "array_print.hpp"
 
 /*-------------------------------------------------------
   Constructors
@@ -19,6 +21,7 @@ geten3<T>::geten3()
   m_nd3 = 0;
   m_alignment = 0;
   m_assigned = false;
+  m_alloc = NULL;
   m_allocated = false;
 }
 template geten3<double>::geten3();
@@ -31,6 +34,7 @@ geten3<T>::geten3(const long n, const long m, const long l)
 {
   m_allocated = false;
   m_assigned = false;
+  m_alloc = NULL;
   allocate(n,m,l);
 }
 template geten3<double>::geten3(const long n, const long m, const long l);
@@ -43,6 +47,7 @@ geten3<T>::geten3(const long n, const long m, const long l, T* ptr)
 {
   m_allocated = false;
   m_assigned = false;
+  m_alloc = NULL;
   assign(n,m,l,ptr);
 }
 template geten3<double>::geten3(const long n, const long m, const long l, double* ptr);
@@ -63,6 +68,99 @@ template geten3<float>::~geten3();
 template geten3<long>::~geten3();
 template geten3<int>::~geten3();
 
+/*-------------------------------------------------------
+   move constructor and assignment
+	- takes the buffer (and allocator) of other, which is 
+	  left unset, so it frees nothing
+-------------------------------------------------------*/
+template <typename T>
+geten3<T>::geten3(geten3<T>&& other)
+{
+  m_buf = NULL;
+  m_ptr = NULL;
+  m_len = 0;
+  m_nd1 = 0;
+  m_nd2 = 0;
+  m_nd3 = 0;
+  m_alignment = 0;
+  m_allocated = false;
+  m_assigned = false;
+  m_alloc = NULL;
+  *this = std::move(other);
+}
+template geten3<double>::geten3(geten3<double>&& other);
+template geten3<float>::geten3(geten3<float>&& other);
+template geten3<long>::geten3(geten3<long>&& other);
+template geten3<int>::geten3(geten3<int>&& other);
+
+template <typename T>
+geten3<T>& geten3<T>::operator= (geten3<T>&& other)
+{
+  if (this == &other) {return *this;}
+  free();
+  m_buf       = other.m_buf;
+  m_ptr       = other.m_ptr;
+  m_len       = other.m_len;
+  m_nd1       = other.m_nd1;
+  m_nd2       = other.m_nd2;
+  m_nd3       = other.m_nd3;
+  m_alignment = other.m_alignment;
+  m_allocated = other.m_allocated;
+  m_assigned  = other.m_assigned;
+  m_alloc     = other.m_alloc;
+  other.m_buf       = NULL;
+  other.m_ptr       = NULL;
+  other.m_len       = 0;
+  other.m_nd1       = 0;
+  other.m_nd2       = 0;
+  other.m_nd3       = 0;
+  other.m_alignment = 0;
+  other.m_allocated = false;
+  other.m_assigned  = false;
+  other.m_alloc     = NULL;
+  return *this;
+}
+template geten3<double>& geten3<double>::operator= (geten3<double>&& other);
+template geten3<float>& geten3<float>::operator= (geten3<float>&& other);
+template geten3<long>& geten3<long>::operator= (geten3<long>&& other);
+template geten3<int>& geten3<int>::operator= (geten3<int>&& other);
+
+/*-------------------------------------------------------
+   clone
+	- deep copy, allocated via malloc
+-------------------------------------------------------*/
+template <typename T>
+geten3<T> geten3<T>::clone() const
+{
+  geten3<T> X;
+  if (m_allocated || m_assigned)
+  {
+    X.allocate(m_nd1,m_nd2,m_nd3);
+    for (long i=0;i<m_len;i++) {X.m_buf[i] = m_buf[i];}
+  }
+  return X;
+}
+template geten3<double> geten3<double>::clone() const;
+template geten3<float> geten3<float>::clone() const;
+template geten3<long> geten3<long>::clone() const;
+template geten3<int> geten3<int>::clone() const;
+
+/*-------------------------------------------------------
+   zeros
+	- factory, allocated via malloc and zeroed
+-------------------------------------------------------*/
+template <typename T>
+geten3<T> geten3<T>::zeros(const long n, const long m, const long l)
+{
+  geten3<T> X(n,m,l);
+  if (X.size() > 0) {X.zero();}
+  return X;
+}
+template geten3<double> geten3<double>::zeros(const long n, const long m, const long l);
+template geten3<float> geten3<float>::zeros(const long n, const long m, const long l);
+template geten3<long> geten3<long>::zeros(const long n, const long m, const long l);
+template geten3<int> geten3<int>::zeros(const long n, const long m, const long l);
+
 /*-------------------------------------------------------
  * calc_alignment()
  * calculates the alignment of m_buf
@@ -95,7 +193,9 @@ void geten3<T>::aligned_allocate(const int ALIGN, const long n, const long m, co
 //  if (!(m_allocated || m_assigned) && ll >= 1 && ll <= mm) 
   if (!(m_allocated || m_assigned) && ll >= 0 && ll <= mm) 
   {
-    m_ptr = (T*) malloc(ALIGN+ll*sizeof(T));
+    m_ptr = (m_alloc != NULL) ? m_alloc->allocate((size_t) ALIGN,(size_t) ll)
+                              : (T*) malloc(ALIGN+ll*sizeof(T));
+    if (m_alloc == NULL) {libj::mem_track(m_ptr,ALIGN+ll*sizeof(T));}
 //  } else if (ll < 1) {
 //    printf("Attempted to allocate geten3 of < 1 element \n");
   } else if (ll < 0) {
@@ -157,7 +257,9 @@ void geten3<T>::allocate(const long n, const long m, const long l)
 //  if (!(m_allocated || m_assigned) && ll >= 1 && ll <= mm) 
   if (!(m_allocated || m_assigned) && ll >= 0 && ll <= mm) 
   {
-    m_ptr = (T*) malloc(ll*sizeof(T));
+    m_ptr = (m_alloc != NULL) ? m_alloc->allocate(sizeof(T),(size_t) ll)
+                              : (T*) malloc(ll*sizeof(T));
+    if (m_alloc == NULL) {libj::mem_track(m_ptr,ll*sizeof(T));}
 //  } else if (ll < 1) {
 //    printf("Attempted to allocate geten3 of < 1 element \n");
   } else if (ll < 0) {
@@ -292,7 +394,8 @@ void geten3<T>::deallocate()
   if (m_allocated)  
   { 
     m_buf = NULL;
-    std::free(m_ptr); 
+    if (m_alloc != NULL) {m_alloc->deallocate(m_ptr,(size_t) m_len);}
+    else                 {libj::mem_untrack(m_ptr); std::free(m_ptr);}
     m_len = 0;
     m_nd1 = 0;
     m_nd2 = 0;
@@ -438,6 +541,7 @@ template <>
 void geten3<double>::print() const
 {
   assert(m_allocated||m_assigned);
+  array_print out;
   long xx=0;
   for (long k=0;k<m_nd3;k++)
   {
@@ -445,7 +549,9 @@ void geten3<double>::print() const
     {
       for (long i=0;i<m_nd1;i++)
       {
-        printf("[%ld,%ld,%ld]    %18.15E \n",i,j,k,*(m_buf+xx));
+        out.idx(i,j,k);
+        out.num(*(m_buf+xx));
+        out.put(" \n");
         xx++;
       }
     }
@@ -456,6 +562,7 @@ template <>
 void geten3<float>::print() const
 {
   assert(m_allocated||m_assigned);
+  array_print out;
   long xx=0;
   for (long k=0;k<m_nd3;k++)
   {
@@ -463,7 +570,9 @@ void geten3<float>::print() const
     {
       for (long i=0;i<m_nd1;i++)
       {
-        printf("[%ld,%ld,%ld]    %10.7E \n",i,j,k,*(m_buf+xx));
+        out.idx(i,j,k);
+        out.num(*(m_buf+xx));
+        out.put(" \n");
         xx++;
       }
     }
@@ -474,6 +583,7 @@ template <>
 void geten3<long>::print() const
 {
   assert(m_allocated||m_assigned);
+  array_print out;
   long xx=0;
   for (long k=0;k<m_nd3;k++)
   {
@@ -481,7 +591,9 @@ void geten3<long>::print() const
     {
       for (long i=0;i<m_nd1;i++)
       {
-        printf("[%ld,%ld,%ld]    %ld \n",i,j,k,*(m_buf+xx));
+        out.idx(i,j,k);
+        out.num(*(m_buf+xx));
+        out.put(" \n");
         xx++;
       }
     }
@@ -492,6 +604,7 @@ template <>
 void geten3<int>::print() const
 {
   assert(m_allocated||m_assigned);
+  array_print out;
   long xx=0;
   for (long k=0;k<m_nd3;k++)
   {
@@ -499,7 +612,9 @@ void geten3<int>::print() const
     {
       for (long i=0;i<m_nd1;i++)
       {
-        printf("[%ld,%ld,%ld]    %d \n",i,j,k,*(m_buf+xx));
+        out.idx(i,j,k);
+        out.num(*(m_buf+xx));
+        out.put(" \n");
         xx++;
       }
     }
@@ -1,6 +1,8 @@
 /*-------------------------------------------------------
   geten3.hpp
 	JHT, December 13, 2021 : created 
+	JHT, October 14, 2026 : added move semantics, clone, and the factories
+	JHT, October 14, 2026 : added as_tensor views
   
   (GE)neral (TEN)sor dimension (3) : a general tensor
   with three dimensions. 
@@ -12,7 +14,11 @@
 	 That is, the loops run from the rightmost to the 
          leftmost index (as in Fortran). 
 
-  NOTE : There is NO BOUNDS CHECKING in this class
+  NOTE : There is NO BOUNDS CHECKING in this class, unless
+         libj is built with -DLIBJ_CHECKED (see debug.hpp)
+
+  NOTE : A geten3 can be moved (returned from a function, 
+         held in a std::vector), but not copied, see clone()
 
   NOTE : Indexing begins at zero
 
@@ -28,6 +34,11 @@
   geten3<double> M(2,3,8,pntr);	//generates and assign location
   M.allocate(2,3,8);	        //allocates via malloc 
   M.assign(2,3,8,pntr);	        //assigns buffer to address
+  M.set_allocator(&arena);       //allocate from a libj::allocator, see core_arena.hpp
+  geten3<double> M = geten3<double>::zeros(2,3,8);	//allocated and zeroed
+  geten3<double> X = M.clone();		//deep copy, allocated via malloc
+  geten3<double> X(std::move(M));		//takes the buffer, M is unset
+  geten3<double> X = f();			//returned by move, no copy
 
   DEALLOCATION OPTIONS
   --------------------------
@@ -43,6 +54,9 @@
   M.size_d2();		//returns number of dimension 2 (long)
   M.size_d3();		//returns number of dimension 3 (long)
   M.zero();		//zeros the whole tensor
+  M.data();		//pointer to the buffer
+  M.as_tensor();	//libj::tensor view of M, for slice, reshape,
+			//  permuted, as_matrix and jblis (tensor.hpp)
   M.is_allocated();	//returns true if tensor is allocated
   M.is_assigned();	//returns true if tensor is assigned
   M = a;		//make the matrix equal to a scalar
@@ -56,6 +70,10 @@
 #include <stdio.h> //for printf
 #include <limits>  //for numeric_limits::max()
 #include <assert.h>//for assert
+#include "allocator.hpp"
+#include "mem_registry.hpp"
+#include "debug.hpp"
+#include "tensor.hpp"
 
 template <typename T>
 class geten3
@@ -70,6 +88,7 @@ class geten3
   int        m_alignment; 	//alignment in BYTES
   bool       m_allocated;	//is allocated
   bool        m_assigned;	//is assigned
+  libj::allocator<T>* m_alloc;	//allocator, NULL for malloc
 
   public:
   //initialization/destructors
@@ -78,19 +97,32 @@ class geten3
   geten3(const long n, const long m, const long l, T* ptr);	//assign with row,col
  ~geten3();							//destructor 
 
+  //move : takes the buffer, other is left unset. Copies are deleted, as
+  //  both would free the one buffer, use clone() for a deep copy
+  geten3(geten3<T>&& other);
+  geten3<T>& operator= (geten3<T>&& other);
+  geten3(const geten3<T>& other) = delete;
+  geten3<T>& operator= (const geten3<T>& other) = delete;
+
+  //factories, allocated via malloc
+  static geten3<T> zeros(const long n, const long m, const long l);	//zeroed
+  geten3<T> clone() const;	//deep copy
+
   //Operator overloading : inlined
   //reference to element i,j,k
   inline T& operator() (const long i, const long j, const long k)
-    {return(*(m_buf + m_nd2*m_nd1*k + m_nd1*j + i));}
+    {LIBJ_CHECK_BOUNDS(i,m_nd1); LIBJ_CHECK_BOUNDS(j,m_nd2); LIBJ_CHECK_BOUNDS(k,m_nd3);
+     return(*(m_buf + m_nd2*m_nd1*k + m_nd1*j + i));}
   //const reference to element i,j,k
   inline const T& operator() (const long i, const long j, const long k) const 
-    {return(*(m_buf + m_nd2*m_nd1*k + m_nd1*j + i));}
+    {LIBJ_CHECK_BOUNDS(i,m_nd1); LIBJ_CHECK_BOUNDS(j,m_nd2); LIBJ_CHECK_BOUNDS(k,m_nd3);
+     return(*(m_buf + m_nd2*m_nd1*k + m_nd1*j + i));}
   //reference i'th element
   inline T& operator[] (const long i)			
-    {return(*(m_buf + i));}
+    {LIBJ_CHECK_BOUNDS(i,m_len); return(*(m_buf + i));}
   //const reference i'th element
   inline const T& operator[] (const long i) const
-    {return(*(m_buf+i));}
+    {LIBJ_CHECK_BOUNDS(i,m_len); return(*(m_buf+i));}
 
   //Dimension information : inlined
   inline long size() const	//return length
@@ -102,11 +134,30 @@ class geten3
   inline long size_d3() const
     {return(m_nd3);}
 
+  //buffer, and a libj::tensor view of it : inlined
+  inline T* data()
+    {return m_buf;}
+  inline const T* data() const
+    {return m_buf;}
+  inline libj::tensor<T> as_tensor()
+    {libj::tensor<T> V; V.assign(m_buf,(size_t) m_nd1,(size_t) m_nd2,(size_t) m_nd3); return V;}
+  inline libj::tensor<T> as_tensor() const	//shares the memory, as slice() const
+    {libj::tensor<T> V; V.assign(const_cast<T*>(m_buf),(size_t) m_nd1,(size_t) m_nd2,(size_t) m_nd3); return V;}
+
   //allocated/assigned : inlined
   inline bool is_allocated()
     {return m_allocated;}
   inline bool is_assigned()
     {return m_assigned;}
+  inline void set_allocator(libj::allocator<T>* alloc)	//allocate from alloc, before allocate
+  {
+    if (m_allocated && alloc != m_alloc)
+    {
+      printf("Attempted to change the allocator of an allocated geten3 \n");
+      exit(1);
+    }
+    m_alloc = alloc;
+  }
   inline int get_alignment()
     {return m_alignment;}
 
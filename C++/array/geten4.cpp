@@ -3,7 +3,9 @@
   .cpp file for geten4 class, desinged to deal with 
   general, 3 dimension tensors 
 -------------------------------------------------------*/
+#include <utility> //for std::move
 #include "geten4.hpp"
+#include "array_print.hpp"
 
 /*-------------------------------------------------------
   Constructors
@@ -20,6 +22,7 @@ geten4<T>::geten4()
   m_nd4 = 0;
   m_alignment = 0;
   m_assigned = false;
+  m_alloc = NULL;
   m_allocated = false;
 }
 template geten4<double>::geten4();
@@ -32,6 +35,7 @@ geten4<T>::geten4(const long n, const long m, const long l, const long k)
 {
   m_allocated = false;
   m_assigned = false;
+  m_alloc = NULL;
   allocate(n,m,l,k);
 }
 template geten4<double>::geten4(const long n, const long m, const long l, const long k);
@@ -44,6 +48,7 @@ geten4<T>::geten4(const long n, const long m, const long l, const long k, T* ptr
 {
   m_allocated = false;
   m_assigned = false;
+  m_alloc = NULL;
   assign(n,m,l,k,ptr);
 }
 template geten4<double>::geten4(const long n, const long m, const long l, const long k, double* ptr);
@@ -64,6 +69,102 @@ template geten4<float>::~geten4();
 template geten4<long>::~geten4();
 template geten4<int>::~geten4();
 
+/*-------------------------------------------------------
+   move constructor and assignment
+	- takes the buffer (and allocator) of other, which is 
+	  left unset, so it frees nothing
+-------------------------------------------------------*/
+template <typename T>
+geten4<T>::geten4(geten4<T>&& other)
+{
+  m_buf = NULL;
+  m_ptr = NULL;
+  m_len = 0;
+  m_nd1 = 0;
+  m_nd2 = 0;
+  m_nd3 = 0;
+  m_nd4 = 0;
+  m_alignment = 0;
+  m_allocated = false;
+  m_assigned = false;
+  m_alloc = NULL;
+  *this = std::move(other);
+}
+template geten4<double>::geten4(geten4<double>&& other);
+template geten4<float>::geten4(geten4<float>&& other);
+template geten4<long>::geten4(geten4<long>&& other);
+template geten4<int>::geten4(geten4<int>&& other);
+
+template <typename T>
+geten4<T>& geten4<T>::operator= (geten4<T>&& other)
+{
+  if (this == &other) {return *this;}
+  free();
+  m_buf       = other.m_buf;
+  m_ptr       = other.m_ptr;
+  m_len       = other.m_len;
+  m_nd1       = other.m_nd1;
+  m_nd2       = other.m_nd2;
+  m_nd3       = other.m_nd3;
+  m_nd4       = other.m_nd4;
+  m_alignment = other.m_alignment;
+  m_allocated = other.m_allocated;
+  m_assigned  = other.m_assigned;
+  m_alloc     = other.m_alloc;
+  other.m_buf       = NULL;
+  other.m_ptr       = NULL;
+  other.m_len       = 0;
+  other.m_nd1       = 0;
+  other.m_nd2       = 0;
+  other.m_nd3       = 0;
+  other.m_nd4       = 0;
+  other.m_alignment = 0;
+  other.m_allocated = false;
+  other.m_assigned  = false;
+  other.m_alloc     = NULL;
+  return *this;
+}
+template geten4<double>& geten4<double>::operator= (geten4<double>&& other);
+template geten4<float>& geten4<float>::operator= (geten4<float>&& other);
+template geten4<long>& geten4<long>::operator= (geten4<long>&& other);
+template geten4<int>& geten4<int>::operator= (geten4<int>&& other);
+
+/*-------------------------------------------------------
+   clone
+	- deep copy, allocated via malloc
+-------------------------------------------------------*/
+template <typename T>
+geten4<T> geten4<T>::clone() const
+{
+  geten4<T> X;
+  if (m_allocated || m_assigned)
+  {
+    X.allocate(m_nd1,m_nd2,m_nd3,m_nd4);
+    for (long i=0;i<m_len;i++) {X.m_buf[i] = m_buf[i];}
+  }
+  return X;
+}
+template geten4<double> geten4<double>::clone() const;
+template geten4<float> geten4<float>::clone() const;
+template geten4<long> geten4<long>::clone() const;
+template geten4<int> geten4<int>::clone() const;
+
+/*-------------------------------------------------------
+   zeros
+	- factory, allocated via malloc and zeroed
+-------------------------------------------------------*/
+template <typename T>
+geten4<T> geten4<T>::zeros(const long n, const long m, const long l, const long k)
+{
+  geten4<T> X(n,m,l,k);
+  if (X.size() > 0) {X.zero();}
+  return X;
+}
+template geten4<double> geten4<double>::zeros(const long n, const long m, const long l, const long k);
+template geten4<float> geten4<float>::zeros(const long n, const long m, const long l, const long k);
+template geten4<long> geten4<long>::zeros(const long n, const long m, const long l, const long k);
+template geten4<int> geten4<int>::zeros(const long n, const long m, const long l, const long k);
+
 /*-------------------------------------------------------
  * calc_alignment()
  * calculates the alignment of m_buf
@@ -96,7 +197,9 @@ void geten4<T>::aligned_allocate(const int ALIGN, const long n, const long m, co
 //  if (!(m_allocated || m_assigned) && ll >= 1 && ll <= mm) 
   if (!(m_allocated || m_assigned) && ll >= 0 && ll <= mm) 
   {
-    m_ptr = (T*) malloc(ALIGN+ll*sizeof(T));
+    m_ptr = (m_alloc != NULL) ? m_alloc->allocate((size_t) ALIGN,(size_t) ll)
+                              : (T*) malloc(ALIGN+ll*sizeof(T));
+    if (m_alloc == NULL) {libj::mem_track(m_ptr,ALIGN+ll*sizeof(T));}
 //  } else if (ll < 1) {
 //    printf("Attempted to allocate geten4 of < 1 element \n");
   } else if (ll < 0) {
@@ -159,7 +262,9 @@ void geten4<T>::allocate(const long n, const long m, const long l, const long k)
 //  if (!(m_allocated || m_assigned) && ll >= 1 && ll <= mm) 
   if (!(m_allocated || m_assigned) && ll >= 0 && ll <= mm) 
   {
-    m_ptr = (T*) malloc(ll*sizeof(T));
+    m_ptr = (m_alloc != NULL) ? m_alloc->allocate(sizeof(T),(size_t) ll)
+                              : (T*) malloc(ll*sizeof(T));
+    if (m_alloc == NULL) {libj::mem_track(m_ptr,ll*sizeof(T));}
 //  } else if (ll < 1) {
 //    printf("Attempted to allocate geten4 of < 1 element \n");
   } else if (ll < 0) {
@@ -297,7 +402,8 @@ void geten4<T>::deallocate()
   if (m_allocated)  
   { 
     m_buf = NULL;
-    std::free(m_ptr); 
+    if (m_alloc != NULL) {m_alloc->deallocate(m_ptr,(size_t) m_len);}
+    else                 {libj::mem_untrack(m_ptr); std::free(m_ptr);}
     m_len = 0;
     m_nd1 = 0;
     m_nd2 = 0;
@@ -448,6 +554,7 @@ template <>
 void geten4<double>::print() const
 {
   assert(m_allocated||m_assigned);
+  array_print out;
   long xx=0;
   for (long l=0;l<m_nd4;l++)
   {
@@ -457,7 +564,9 @@ void geten4<double>::print() const
       {
         for (long i=0;i<m_nd1;i++)
         {
-          printf("[%ld,%ld,%ld,%ld]    %18.15E \n",i,j,k,l,*(m_buf+xx));
+          out.idx(i,j,k,l);
+          out.num(*(m_buf+xx));
+          out.put(" \n");
           xx++;
         }
       }
@@ -469,6 +578,7 @@ template <>
 void geten4<float>::print() const
 {
   assert(m_allocated||m_assigned);
+  array_print out;
   long xx=0;
   for (long l=0;l<m_nd4;l++)
   {
@@ -478,7 +588,9 @@ void geten4<float>::print() const
       {
         for (long i=0;i<m_nd1;i++)
         {
-          printf("[%ld,%ld,%ld,%ld]    %10.7E \n",i,j,k,l,*(m_buf+xx));
+          out.idx(i,j,k,l);
+          out.num(*(m_buf+xx));
+          out.put(" \n");
           xx++;
         }
       }
@@ -490,6 +602,7 @@ template <>
 void geten4<long>::print() const
 {
   assert(m_allocated||m_assigned);
+  array_print out;
   long xx=0;
   for (long l=0;l<m_nd4;l++)
   {
@@ -499,7 +612,9 @@ void geten4<long>::print() const
       {
         for (long i=0;i<m_nd1;i++)
         {
-          printf("[%ld,%ld,%ld,%ld]    %ld \n",i,j,k,l,*(m_buf+xx));
+          out.idx(i,j,k,l);
+          out.num(*(m_buf+xx));
+          out.put(" \n");
           xx++;
         }
       }
@@ -511,6 +626,7 @@ template <>
 void geten4<int>::print() const
 {
   assert(m_allocated||m_assigned);
+  array_print out;
   long xx=0;
   for (long l=0;l<m_nd4;l++)
   {
@@ -520,7 +636,9 @@ void geten4<int>::print() const
       {
         for (long i=0;i<m_nd1;i++)
         {
-          printf("[%ld,%ld,%ld,%ld]    %d \n",i,j,k,l,*(m_buf+xx));
+          out.idx(i,j,k,l);
+          out.num(*(m_buf+xx));
+          out.put(" \n");
           xx++;
         }
       }
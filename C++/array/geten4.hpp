@@ -1,6 +1,8 @@
 /*-------------------------------------------------------
   geten4.hpp
 	JHT, December 15, 2021 : created 
+	JHT, October 14, 2026 : added move semantics, clone, and the factories
+	JHT, October 14, 2026 : added as_tensor views
   
   (GE)neral (TEN)sor dimension (4) : a general tensor
   with four dimensions, which can be assigned to or allocated with memory, 
@@ -11,7 +13,11 @@
 	 That is, the loops run from the rightmost to the 
          leftmost index (as in Fortran). 
 
-  NOTE : There is NO BOUNDS CHECKING in this class
+  NOTE : There is NO BOUNDS CHECKING in this class, unless
+         libj is built with -DLIBJ_CHECKED (see debug.hpp)
+
+  NOTE : A geten4 can be moved (returned from a function, 
+         held in a std::vector), but not copied, see clone()
 
   NOTE : Indexing begins at zero
 
@@ -27,6 +33,11 @@
   geten4<double> M(2,3,8,1,pntr);	//generates and assign location
   M.allocate(2,3,8,1);	        	//allocates via malloc 
   M.assign(2,3,8,1,pntr);	        //assigns buffer to address
+  M.set_allocator(&arena);       //allocate from a libj::allocator, see core_arena.hpp
+  geten4<double> M = geten4<double>::zeros(2,3,8,1);	//allocated and zeroed
+  geten4<double> X = M.clone();		//deep copy, allocated via malloc
+  geten4<double> X(std::move(M));		//takes the buffer, M is unset
+  geten4<double> X = f();			//returned by move, no copy
 
   DEALLOCATION OPTIONS
   --------------------------
@@ -43,6 +54,9 @@
   M.size_d3();		//returns number of dimension 3 (long)
   M.size_d4();		//returns number of dimension 4 (long)
   M.zero();		//zeros the whole tensor
+  M.data();		//pointer to the buffer
+  M.as_tensor();	//libj::tensor view of M, for slice, reshape,
+			//  permuted, as_matrix and jblis (tensor.hpp)
   M.is_allocated();	//returns true if tensor is allocated
   M.is_assigned();	//returns true if tensor is assigned
   M = a;		//make the matrix equal to a scalar
@@ -56,6 +70,10 @@
 #include <stdio.h> //for printf
 #include <limits>  //for numeric_limits::max()
 #include <assert.h>//for assert
+#include "allocator.hpp"
+#include "mem_registry.hpp"
+#include "debug.hpp"
+#include "tensor.hpp"
 
 template <typename T>
 class geten4
@@ -71,6 +89,7 @@ class geten4
   int        m_alignment; 	//alignment in BYTES
   bool       m_allocated;	//is allocated
   bool        m_assigned;	//is assigned
+  libj::allocator<T>* m_alloc;	//allocator, NULL for malloc
 
   public:
   //initialization/destructors
@@ -79,19 +98,32 @@ class geten4
   geten4(const long n, const long m, const long l, const long k, T* ptr);	//assign 
  ~geten4();							//destructor 
 
+  //move : takes the buffer, other is left unset. Copies are deleted, as
+  //  both would free the one buffer, use clone() for a deep copy
+  geten4(geten4<T>&& other);
+  geten4<T>& operator= (geten4<T>&& other);
+  geten4(const geten4<T>& other) = delete;
+  geten4<T>& operator= (const geten4<T>& other) = delete;
+
+  //factories, allocated via malloc
+  static geten4<T> zeros(const long n, const long m, const long l, const long k);	//zeroed
+  geten4<T> clone() const;	//deep copy
+
   //Operator overloading : inlined
   //reference to element i,j,k
   inline T& operator() (const long i, const long j, const long k, const long l)
-    {return(*(m_buf + m_nd3*m_nd2*m_nd1*l + m_nd2*m_nd1*k + m_nd1*j + i));}
+    {LIBJ_CHECK_BOUNDS(i,m_nd1); LIBJ_CHECK_BOUNDS(j,m_nd2); LIBJ_CHECK_BOUNDS(k,m_nd3);
+     LIBJ_CHECK_BOUNDS(l,m_nd4); return(*(m_buf + m_nd3*m_nd2*m_nd1*l + m_nd2*m_nd1*k + m_nd1*j + i));}
   //const reference to element i,j,k
   inline const T& operator() (const long i, const long j, const long k, const long l) const 
-    {return(*(m_buf + m_nd3*m_nd2*m_nd1*l + m_nd2*m_nd1*k + m_nd1*j + i));}
+    {LIBJ_CHECK_BOUNDS(i,m_nd1); LIBJ_CHECK_BOUNDS(j,m_nd2); LIBJ_CHECK_BOUNDS(k,m_nd3);
+     LIBJ_CHECK_BOUNDS(l,m_nd4); return(*(m_buf + m_nd3*m_nd2*m_nd1*l + m_nd2*m_nd1*k + m_nd1*j + i));}
   //reference i'th element
   inline T& operator[] (const long i)			
-    {return(*(m_buf + i));}
+    {LIBJ_CHECK_BOUNDS(i,m_len); return(*(m_buf + i));}
   //const reference i'th element
   inline const T& operator[] (const long i) const
-    {return(*(m_buf+i));}
+    {LIBJ_CHECK_BOUNDS(i,m_len); return(*(m_buf+i));}
 
   //Dimension information : inlined
   inline long size() const	//return length
@@ -106,11 +138,30 @@ class geten4
     {return(m_nd4);}
 
 
+  //buffer, and a libj::tensor view of it : inlined
+  inline T* data()
+    {return m_buf;}
+  inline const T* data() const
+    {return m_buf;}
+  inline libj::tensor<T> as_tensor()
+    {libj::tensor<T> V; V.assign(m_buf,(size_t) m_nd1,(size_t) m_nd2,(size_t) m_nd3,(size_t) m_nd4); return V;}
+  inline libj::tensor<T> as_tensor() const	//shares the memory, as slice() const
+    {libj::tensor<T> V; V.assign(const_cast<T*>(m_buf),(size_t) m_nd1,(size_t) m_nd2,(size_t) m_nd3,(size_t) m_nd4); return V;}
+
   //allocated/assigned : inlined
   inline bool is_allocated()
     {return m_allocated;}
   inline bool is_assigned()
     {return m_assigned;}
+  inline void set_allocator(libj::allocator<T>* alloc)	//allocate from alloc, before allocate
+  {
+    if (m_allocated && alloc != m_alloc)
+    {
+      printf("Attempted to change the allocator of an allocated geten4 \n");
+      exit(1);
+    }
+    m_alloc = alloc;
+  }
   inline int get_alignment()
     {return m_alignment;}
 
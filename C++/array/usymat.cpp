@@ -5,7 +5,19 @@
 
   usaged described in usymat.hpp
 -------------------------------------------------------*/
+#include <utility> //for std::move
+#include <math.h>  //for sqrt
 #include "usymat.hpp"
+#include "gemat.hpp"
+#include "array_simd.hpp"
+#include "array_print.hpp"
+
+#if defined (_OPENMP)
+  #include <omp.h>
+#endif
+
+//tile of unpack_to and pack_from, in elements per side
+#define USYMAT_TILE 32
 
 /*-------------------------------------------------------
   Constructors
@@ -19,6 +31,7 @@ usymat<T>::usymat()
   m_ncol = 0;
   m_alignment = 0;
   m_assigned = false;
+  m_alloc = NULL;
   m_allocated = false;
 }
 template usymat<double>::usymat();
@@ -31,6 +44,7 @@ usymat<T>::usymat(const long n, const long m)
 {
   m_allocated = false;
   m_assigned = false;
+  m_alloc = NULL;
   allocate(n,m);
 }
 template usymat<double>::usymat(const long n, const long m);
@@ -43,6 +57,7 @@ usymat<T>::usymat(const long n, const long m, T* ptr)
 {
   m_allocated = false;
   m_assigned = false;
+  m_alloc = NULL;
   assign(n,m,ptr);
 }
 template usymat<double>::usymat(const long n, const long m, double* ptr);
@@ -61,7 +76,8 @@ usymat<T>::~usymat()
     m_buf = NULL;
     m_ptr = NULL; 
   } else if (m_allocated) {
-    std::free(m_ptr);
+    if (m_alloc != NULL) {m_alloc->deallocate(m_ptr,(size_t) m_len);}
+    else                 {libj::mem_untrack(m_ptr); std::free(m_ptr);}
     m_buf = NULL; 
   }
 }
@@ -70,6 +86,109 @@ template usymat<float>::~usymat();
 template usymat<long>::~usymat();
 template usymat<int>::~usymat();
 
+/*-------------------------------------------------------
+   move constructor and assignment
+	- takes the buffer (and allocator) of other, which is 
+	  left unset, so it frees nothing
+-------------------------------------------------------*/
+template <typename T>
+usymat<T>::usymat(usymat<T>&& other)
+{
+  m_buf = NULL;
+  m_ptr = NULL;
+  m_len = 0;
+  m_ncol = 0;
+  m_alignment = 0;
+  m_allocated = false;
+  m_assigned = false;
+  m_alloc = NULL;
+  *this = std::move(other);
+}
+template usymat<double>::usymat(usymat<double>&& other);
+template usymat<float>::usymat(usymat<float>&& other);
+template usymat<long>::usymat(usymat<long>&& other);
+template usymat<int>::usymat(usymat<int>&& other);
+
+template <typename T>
+usymat<T>& usymat<T>::operator= (usymat<T>&& other)
+{
+  if (this == &other) {return *this;}
+  free();
+  m_buf       = other.m_buf;
+  m_ptr       = other.m_ptr;
+  m_len       = other.m_len;
+  m_ncol      = other.m_ncol;
+  m_alignment = other.m_alignment;
+  m_allocated = other.m_allocated;
+  m_assigned  = other.m_assigned;
+  m_alloc     = other.m_alloc;
+  other.m_buf       = NULL;
+  other.m_ptr       = NULL;
+  other.m_len       = 0;
+  other.m_ncol      = 0;
+  other.m_alignment = 0;
+  other.m_allocated = false;
+  other.m_assigned  = false;
+  other.m_alloc     = NULL;
+  return *this;
+}
+template usymat<double>& usymat<double>::operator= (usymat<double>&& other);
+template usymat<float>& usymat<float>::operator= (usymat<float>&& other);
+template usymat<long>& usymat<long>::operator= (usymat<long>&& other);
+template usymat<int>& usymat<int>::operator= (usymat<int>&& other);
+
+/*-------------------------------------------------------
+   clone
+	- deep copy, allocated via malloc
+-------------------------------------------------------*/
+template <typename T>
+usymat<T> usymat<T>::clone() const
+{
+  usymat<T> X;
+  if (m_allocated || m_assigned)
+  {
+    X.allocate(m_ncol,m_ncol);
+    for (long i=0;i<m_len;i++) {X.m_buf[i] = m_buf[i];}
+  }
+  return X;
+}
+template usymat<double> usymat<double>::clone() const;
+template usymat<float> usymat<float>::clone() const;
+template usymat<long> usymat<long>::clone() const;
+template usymat<int> usymat<int>::clone() const;
+
+/*-------------------------------------------------------
+   zeros
+	- factory, allocated via malloc and zeroed
+-------------------------------------------------------*/
+template <typename T>
+usymat<T> usymat<T>::zeros(const long n)
+{
+  usymat<T> X(n,n);
+  if (X.size() > 0) {X.zero();}
+  return X;
+}
+template usymat<double> usymat<double>::zeros(const long n);
+template usymat<float> usymat<float>::zeros(const long n);
+template usymat<long> usymat<long>::zeros(const long n);
+template usymat<int> usymat<int>::zeros(const long n);
+
+/*-------------------------------------------------------
+   identity
+	- factory, n x n identity allocated via malloc
+-------------------------------------------------------*/
+template <typename T>
+usymat<T> usymat<T>::identity(const long n)
+{
+  usymat<T> X(n,n);
+  if (X.size() > 0) {X.I();}
+  return X;
+}
+template usymat<double> usymat<double>::identity(const long n);
+template usymat<float> usymat<float>::identity(const long n);
+template usymat<long> usymat<long>::identity(const long n);
+template usymat<int> usymat<int>::identity(const long n);
+
 /*-------------------------------------------------------
  * calc_alignment()
  * calculates the alignment of m_buf
@@ -102,7 +221,9 @@ void usymat<T>::aligned_allocate(const int ALIGN, const long n, const long m)
 //  if (!(m_allocated || m_assigned) && ll >= 1 && ll <= mm && n == m) 
   if (!(m_allocated || m_assigned) && ll >= 0 && ll <= mm && n == m) 
   {
-    m_ptr = (T*) malloc(ALIGN+ll*sizeof(T));
+    m_ptr = (m_alloc != NULL) ? m_alloc->allocate((size_t) ALIGN,(size_t) ll)
+                              : (T*) malloc(ALIGN+ll*sizeof(T));
+    if (m_alloc == NULL) {libj::mem_track(m_ptr,ALIGN+ll*sizeof(T));}
   } else if (n != m) {
     printf("Attempted to allocate usymat where nrow != m_ncol \n");
     exit(1);
@@ -161,7 +282,9 @@ void usymat<T>::allocate(const long n, const long m)
   const long mm=std::numeric_limits<long>::max(); //gives largest long 
   if (!(m_allocated || m_assigned) && ll >= 0 && ll <= mm && n == m) 
   {
-    m_ptr = (T*) malloc(ll*sizeof(T));
+    m_ptr = (m_alloc != NULL) ? m_alloc->allocate(sizeof(T),(size_t) ll)
+                              : (T*) malloc(ll*sizeof(T));
+    if (m_alloc == NULL) {libj::mem_track(m_ptr,ll*sizeof(T));}
   } else if (n != m) {
     printf("Attempted to allocate usymat where nrow != m_ncol \n");
     exit(1);
@@ -300,7 +423,8 @@ void usymat<T>::deallocate()
   if (m_allocated)  
   { 
     m_buf = NULL;
-    std::free(m_ptr); 
+    if (m_alloc != NULL) {m_alloc->deallocate(m_ptr,(size_t) m_len);}
+    else                 {libj::mem_untrack(m_ptr); std::free(m_ptr);}
     m_len = 0;
     m_ncol = 0;
     m_allocated = false;
@@ -387,20 +511,13 @@ template void usymat<long>::info() const;
 template void usymat<int>::info() const;
 /*-------------------------------------------------------
   zero()
-	- zeros the matrix 
+	- zeros the matrix, see array_simd.hpp 
 -------------------------------------------------------*/
 template <typename T>
 void usymat<T>::zero()
 {
   assert(m_allocated||m_assigned);
-  const long ll=m_len-1;
-  long i=0;
-  while (true)
-  {
-    *(m_buf+i) = (T) 0;
-    if (i >= ll) break;
-    i++;
-  }
+  array_simd_zero<T>(m_len,m_buf,m_alignment);
 }
 template void usymat<double>::zero();
 template void usymat<float>::zero();
@@ -409,38 +526,16 @@ template void usymat<int>::zero();
 /*-------------------------------------------------------
   I() 
 	- makes the main diagonal of the matrix = 1 
-        - one could do this in two setps, but 
-            here we only make one pass through the 
-            m_buffer
+        - zeros, then sets the diagonal, which is
+            at j*(j+1)/2 + j in the buffer
 
 -------------------------------------------------------*/
 template <typename T>
 void usymat<T>::I()
 {
   assert(m_allocated||m_assigned);
-
-  //find number of iterations to traverse
-  const long nitr=m_ncol-1;
-  long tmp;
-  long i=0;
-  long col=0;
-  while(true)
-  {
-    *(m_buf+i) = (T) 1; //diagonal element
-    
-    //zero up to next diagonal
-    if (col >= nitr) break;
-    col++;
-    
-    tmp = i+col;
-    while(i<=tmp)
-    {
-      i++;
-      *(m_buf+i) = (T) 0;
-    }
-    
-  }
-
+  zero();
+  for (long j=0;j<m_ncol;j++) {*(m_buf+j*(j+1)/2+j) = (T) 1;}
 }
 template void usymat<double>::I();
 template void usymat<float>::I();
@@ -454,19 +549,234 @@ template <typename T>
 void usymat<T>::operator= (const T a)
 {
   assert (m_allocated||m_assigned);
-  long i=0;
-  const long ll=m_len-1;
-  while (true)
-  {
-    *(m_buf+i) = a;
-    if (i >= ll) break;
-    i++;
-  }
+  array_simd_set<T>(m_len,a,m_buf,m_alignment);
 }
 template void usymat<double>::operator= (const double a);
 template void usymat<float>::operator= (const float a);
 template void usymat<long>::operator= (const long a);
 template void usymat<int>::operator= (const int a);
+/*-------------------------------------------------------
+  scale
+	- M = a*M 
+-------------------------------------------------------*/
+template <typename T>
+void usymat<T>::scale(const T a)
+{
+  assert(m_allocated||m_assigned);
+  array_simd_scale<T>(m_len,a,m_buf,m_alignment);
+}
+template void usymat<double>::scale(const double a);
+template void usymat<float>::scale(const float a);
+template void usymat<long>::scale(const long a);
+template void usymat<int>::scale(const int a);
+/*-------------------------------------------------------
+  check_shape
+	- exits if X is not the shape of this matrix 
+-------------------------------------------------------*/
+template <typename T>
+void usymat<T>::check_shape(const usymat<T>& X, const char* opr) const
+{
+  if (m_ncol != X.m_ncol)
+  {
+    printf("Attempted to %s usymat of %ld x %ld with usymat of %ld x %ld \n",
+           opr,m_ncol,m_ncol,X.m_ncol,X.m_ncol);
+    exit(1);
+  }
+}
+template void usymat<double>::check_shape(const usymat<double>& X, const char* opr) const;
+template void usymat<float>::check_shape(const usymat<float>& X, const char* opr) const;
+template void usymat<long>::check_shape(const usymat<long>& X, const char* opr) const;
+template void usymat<int>::check_shape(const usymat<int>& X, const char* opr) const;
+/*-------------------------------------------------------
+  axpy
+	- M = M + a*X, over the packed buffer 
+-------------------------------------------------------*/
+template <typename T>
+void usymat<T>::axpy(const T a, const usymat<T>& X)
+{
+  assert(m_allocated||m_assigned);
+  check_shape(X,"axpy");
+  array_simd_axpy<T>(m_len,a,X.m_buf,m_buf,array_simd_align(m_alignment,X.m_alignment));
+}
+template void usymat<double>::axpy(const double a, const usymat<double>& X);
+template void usymat<float>::axpy(const float a, const usymat<float>& X);
+template void usymat<long>::axpy(const long a, const usymat<long>& X);
+template void usymat<int>::axpy(const int a, const usymat<int>& X);
+/*-------------------------------------------------------
+  copy_from
+	- M = X, of the same shape 
+-------------------------------------------------------*/
+template <typename T>
+void usymat<T>::copy_from(const usymat<T>& X)
+{
+  assert(m_allocated||m_assigned);
+  check_shape(X,"copy_from");
+  array_simd_copy<T>(m_len,X.m_buf,m_buf,array_simd_align(m_alignment,X.m_alignment));
+}
+template void usymat<double>::copy_from(const usymat<double>& X);
+template void usymat<float>::copy_from(const usymat<float>& X);
+template void usymat<long>::copy_from(const usymat<long>& X);
+template void usymat<int>::copy_from(const usymat<int>& X);
+/*-------------------------------------------------------
+  dot
+	- sum_ij M(i,j)*X(i,j), over the full matrix
+        - each off diagonal element is stored once
+            but appears twice, so this is twice the
+            dot of the buffers less the diagonal
+-------------------------------------------------------*/
+template <typename T>
+T usymat<T>::dot(const usymat<T>& X) const
+{
+  assert(m_allocated||m_assigned);
+  check_shape(X,"dot");
+  const T packed = array_simd_dot<T>(m_len,m_buf,X.m_buf,
+                                     array_simd_align(m_alignment,X.m_alignment));
+  T diag = (T) 0;
+  for (long j=0;j<m_ncol;j++)
+  {
+    const long jj = j*(j+1)/2+j;
+    diag += *(m_buf+jj) * *(X.m_buf+jj);
+  }
+  return (T) 2*packed - diag;
+}
+template double usymat<double>::dot(const usymat<double>& X) const;
+template float usymat<float>::dot(const usymat<float>& X) const;
+template long usymat<long>::dot(const usymat<long>& X) const;
+template int usymat<int>::dot(const usymat<int>& X) const;
+/*-------------------------------------------------------
+  norm
+	- Frobenius norm of the full matrix, sqrt(M.dot(M)) 
+-------------------------------------------------------*/
+template <typename T>
+double usymat<T>::norm() const
+{
+  return sqrt((double) dot(*this));
+}
+template double usymat<double>::norm() const;
+template double usymat<float>::norm() const;
+template double usymat<long>::norm() const;
+template double usymat<int>::norm() const;
+/*-------------------------------------------------------
+  check_square
+	- exits if A is not n x n, of this n 
+-------------------------------------------------------*/
+template <typename T>
+void usymat<T>::check_square(const gemat<T>& A, const char* opr) const
+{
+  if (A.rows() != m_ncol || A.cols() != m_ncol)
+  {
+    printf("Attempted to %s usymat of %ld x %ld with gemat of %ld x %ld \n",
+           opr,m_ncol,m_ncol,A.rows(),A.cols());
+    exit(1);
+  }
+}
+template void usymat<double>::check_square(const gemat<double>& A, const char* opr) const;
+template void usymat<float>::check_square(const gemat<float>& A, const char* opr) const;
+template void usymat<long>::check_square(const gemat<long>& A, const char* opr) const;
+template void usymat<int>::check_square(const gemat<int>& A, const char* opr) const;
+/*-------------------------------------------------------
+  unpack_to
+	- A = M, the full n x n matrix, of any ld 
+        - the upper triangle is a copy of each packed
+            column. If fill_lower, the lower is 
+            A(i,j) = M(j,i), i > j, which is row i of 
+            the packed buffer. This goes by tiles
+            of USYMAT_TILE : rows of the buffer are 
+            read into a local tile (in L1) and written
+            out as columns of A, so that both sides 
+            are read and written in order
+        - threaded over the block columns of A with
+            OpenMP, past libj::simd_par_min_n() elements
+-------------------------------------------------------*/
+template <typename T>
+void usymat<T>::unpack_to(gemat<T>& A, const bool fill_lower) const
+{
+  assert(m_allocated||m_assigned);
+  check_square(A,"unpack_to");
+  const long n  = m_ncol;
+  const long ld = A.ld();
+  const long nb = (n + USYMAT_TILE - 1)/USYMAT_TILE;
+  const T* P = m_buf;
+  T* a = A.data();
+  #if defined (_OPENMP)
+  const bool par = omp_get_max_threads() > 1 && !omp_in_parallel() 
+                && n*n >= libj::simd_par_min_n();
+  #pragma omp parallel for schedule(dynamic) if (par)
+  #endif
+  for (long jb=0;jb<nb;jb++)
+  {
+    const long j0 = jb*USYMAT_TILE;
+    const long j1 = (j0 + USYMAT_TILE < n) ? j0 + USYMAT_TILE : n;
+
+    //upper triangle, rows 0..j of column j
+    for (long j=j0;j<j1;j++)
+    {
+      const T* pc = P + j*(j+1)/2;
+      T* ac = a + ld*j;
+      array_simd_copy<T>(j+1,pc,ac,
+                         array_simd_align(array_simd_ptr_align(pc),array_simd_ptr_align(ac)));
+    }
+    if (!fill_lower) continue;
+
+    //lower triangle, tiles at or below the diagonal
+    T tile[USYMAT_TILE*USYMAT_TILE];
+    for (long ib=jb;ib<nb;ib++)
+    {
+      const long i0 = ib*USYMAT_TILE;
+      const long i1 = (i0 + USYMAT_TILE < n) ? i0 + USYMAT_TILE : n;
+      for (long i=i0;i<i1;i++)
+      {
+        const T* pc = P + i*(i+1)/2;
+        const long je = (i < j1) ? i : j1;
+        for (long j=j0;j<je;j++) {tile[(j-j0)*USYMAT_TILE + (i-i0)] = pc[j];}
+      }
+      for (long j=j0;j<j1;j++)
+      {
+        const long is = (j+1 > i0) ? j+1 : i0;
+        const T* tc = tile + (j-j0)*USYMAT_TILE;
+        T* ac = a + ld*j;
+        for (long i=is;i<i1;i++) {ac[i] = tc[i-i0];}
+      }
+    }
+  }
+}
+template void usymat<double>::unpack_to(gemat<double>& A, const bool fill_lower) const;
+template void usymat<float>::unpack_to(gemat<float>& A, const bool fill_lower) const;
+template void usymat<long>::unpack_to(gemat<long>& A, const bool fill_lower) const;
+template void usymat<int>::unpack_to(gemat<int>& A, const bool fill_lower) const;
+/*-------------------------------------------------------
+  pack_from
+	- M = the upper triangle of A, n x n of any ld
+        - the lower triangle of A is not read 
+        - threaded over the columns with OpenMP, past
+            libj::simd_par_min_n() elements
+-------------------------------------------------------*/
+template <typename T>
+void usymat<T>::pack_from(const gemat<T>& A)
+{
+  assert(m_allocated||m_assigned);
+  check_square(A,"pack_from");
+  const long n  = m_ncol;
+  const long ld = A.ld();
+  const T* a = A.data();
+  T* P = m_buf;
+  #if defined (_OPENMP)
+  const bool par = omp_get_max_threads() > 1 && !omp_in_parallel() 
+                && m_len >= libj::simd_par_min_n();
+  #pragma omp parallel for schedule(dynamic,USYMAT_TILE) if (par)
+  #endif
+  for (long j=0;j<n;j++)
+  {
+    const T* ac = a + ld*j;
+    T* pc = P + j*(j+1)/2;
+    array_simd_copy<T>(j+1,ac,pc,
+                       array_simd_align(array_simd_ptr_align(pc),array_simd_ptr_align(ac)));
+  }
+}
+template void usymat<double>::pack_from(const gemat<double>& A);
+template void usymat<float>::pack_from(const gemat<float>& A);
+template void usymat<long>::pack_from(const gemat<long>& A);
+template void usymat<int>::pack_from(const gemat<int>& A);
 /*-------------------------------------------------------
   print
 	- prints elements of vector
@@ -475,12 +785,15 @@ template <>
 void usymat<double>::print() const
 {
   assert(m_allocated||m_assigned);
+  array_print out;
   long xx=0;
   for (long j=0;j<m_ncol;j++)
   {
     for (long i=0;i<=j;i++)
     {
-      printf("[%ld,%ld]    %18.15E \n",i,j,*(m_buf+xx));
+      out.idx(i,j);
+      out.num(*(m_buf+xx));
+      out.put(" \n");
       xx++;
     }
   }
@@ -490,12 +803,15 @@ template <>
 void usymat<float>::print() const
 {
   assert(m_allocated||m_assigned);
+  array_print out;
   long xx=0;
   for (long j=0;j<m_ncol;j++)
   {
     for (long i=0;i<=j;i++)
     {
-      printf("[%ld,%ld]    %10.7E \n",i,j,*(m_buf+xx));
+      out.idx(i,j);
+      out.num(*(m_buf+xx));
+      out.put(" \n");
       xx++;
     }
   }
@@ -506,12 +822,15 @@ template <>
 void usymat<long>::print() const
 {
   assert(m_allocated||m_assigned);
+  array_print out;
   long xx=0;
   for (long j=0;j<m_ncol;j++)
   {
     for (long i=0;i<=j;i++)
     {
-      printf("[%ld,%ld]    %ld \n",i,j,*(m_buf+xx));
+      out.idx(i,j);
+      out.num(*(m_buf+xx));
+      out.put(" \n");
       xx++;
     }
   }
@@ -521,12 +840,15 @@ template <>
 void usymat<int>::print() const
 {
   assert(m_allocated||m_assigned);
+  array_print out;
   long xx=0;
   for (long j=0;j<m_ncol;j++)
   {
     for (long i=0;i<=j;i++)
     {
-      printf("[%ld,%ld]    %d \n",i,j,*(m_buf+xx));
+      out.idx(i,j);
+      out.num(*(m_buf+xx));
+      out.put(" \n");
       xx++;
     }
   }
@@ -1,6 +1,9 @@
 /*-------------------------------------------------------
   usymat.hpp
     JHT, October 28, 2021 : created 
+    JHT, October 14, 2026 : added move semantics, clone, and the factories
+    JHT, October 14, 2026 : added the simd bulk operations
+    JHT, October 14, 2026 : added unpack_to and pack_from
 
   (U)pper (SY)mmetric (MAT)rix : 
 
@@ -12,7 +15,11 @@
   NOTE : Accessing the lower triangular elements is 
          undefined behavior
 
-  NOTE : There is NO BOUNDS CHECKING in this class
+  NOTE : There is NO BOUNDS CHECKING in this class, unless
+         libj is built with -DLIBJ_CHECKED (see debug.hpp)
+
+  NOTE : A usymat can be moved (returned from a function, 
+         held in a std::vector), but not copied, see clone()
 
   NOTE : Indexing begins at zero
 
@@ -28,7 +35,13 @@
   usymat<dobule> M(3,3,pntr);	//generates and assign location
   M.allocate(3,3);	            //allocates via malloc 
   M.assign(3,3,pntr);	        //assigns m_buffer to address
+  M.set_allocator(&arena);       //allocate from a libj::allocator, see core_arena.hpp
   M.aligned_allocate(32,N,N);   //alocates NxN matrix aligned to 32 bytes
+  usymat<double> M = usymat<double>::zeros(3);	//allocated and zeroed
+  usymat<double> M = usymat<double>::identity(3);	//allocated identity
+  usymat<double> X = M.clone();		//deep copy, allocated via malloc
+  usymat<double> X(std::move(M));		//takes the buffer, M is unset
+  usymat<double> X = f();			//returned by move, no copy
 
   DEALLOCATION OPTIONS
   --------------------------
@@ -44,9 +57,22 @@
   M.cols();		//returns number of cols (uint64_t)
   M.zero();		//zeros the whole matrix
   M.I();		//makes matrix the identity
+  M = a;		//sets all stored elements to a
+  M.scale(a);		//M = a*M
+  M.axpy(a,X);		//M = M + a*X, X of the same shape
+  M.copy_from(X);	//M = X, X of the same shape
+  M.dot(X);		//sum of M(i,j)*X(i,j) over the full matrix
+  M.norm();		//Frobenius norm of the full matrix (double)
+  M.unpack_to(A);	//gemat A (n x n, any ld) = M, both triangles
+  M.unpack_to(A,false);	//only the upper triangle of A
+  M.pack_from(A);	//M = upper triangle of gemat A (n x n)
   M.is_allocated();	//returns true if matrix is m_allocated
   M.is_assigned();	//returns true if matrix is m_assigned
 
+  The bulk operations go over the packed buffer with the
+  aligned simd_*<T,ALIGNMENT> and threaded simd_par_*, 
+  see array_simd.hpp.
+
 --------------------------------------------------------*/
 #ifndef USYMAT_HPP
 #define USYMAT_HPP
@@ -55,6 +81,11 @@
 #include <stdio.h> //for printf
 #include <limits>  //for numeric_limits::max()
 #include <assert.h>//for assert
+#include "allocator.hpp"
+#include "mem_registry.hpp"
+#include "debug.hpp"
+
+template <typename T> class gemat;
 
 template <typename T>
 class usymat
@@ -67,6 +98,7 @@ class usymat
   int    m_alignment;               //alignment in bytes
   bool   m_allocated;                //is m_allocated
   bool    m_assigned;                //is m_assigned
+  libj::allocator<T>* m_alloc;	//allocator, NULL for malloc
 
   public:
   //initialization/destructors
@@ -75,15 +107,27 @@ class usymat
   usymat(const long n, const long m, T* ptr);	//assign with row,col
  ~usymat();	//destructor 
 
+  //move : takes the buffer, other is left unset. Copies are deleted, as
+  //  both would free the one buffer, use clone() for a deep copy
+  usymat(usymat<T>&& other);
+  usymat<T>& operator= (usymat<T>&& other);
+  usymat(const usymat<T>& other) = delete;
+  usymat<T>& operator= (const usymat<T>& other) = delete;
+
+  //factories, allocated via malloc
+  static usymat<T> zeros(const long n);	//zeroed
+  static usymat<T> identity(const long n);	//n x n identity
+  usymat<T> clone() const;	//deep copy
+
   //Operator overloading : inlined
   inline T& operator() (const long i, const long j)	//ref elm i,j
-    {return(*(m_buf+ j*(j+1)/2 + i));}
+    {LIBJ_CHECK_BOUNDS(j,m_ncol); LIBJ_CHECK_BOUNDS(i,j+1); return(*(m_buf+ j*(j+1)/2 + i));}
   inline const T& operator() (const long i, const long j) const 	//const elm i,j
-    {return(*(m_buf+ j*(j+1)/2 + i));}
+    {LIBJ_CHECK_BOUNDS(j,m_ncol); LIBJ_CHECK_BOUNDS(i,j+1); return(*(m_buf+ j*(j+1)/2 + i));}
   inline T& operator[] (const long i)			//ref i'th element
-    {return(*(m_buf + i));}
+    {LIBJ_CHECK_BOUNDS(i,m_len); return(*(m_buf + i));}
   inline const T& operator[] (const long i) const		//const i'th element
-    {return(*(m_buf+i));}
+    {LIBJ_CHECK_BOUNDS(i,m_len); return(*(m_buf+i));}
 
   //Dimension information : inlined
   inline long size() const					//return m_length
@@ -98,6 +142,15 @@ class usymat
     {return m_allocated;}
   inline bool is_assigned()
     {return m_assigned;}
+  inline void set_allocator(libj::allocator<T>* alloc)	//allocate from alloc, before allocate
+  {
+    if (m_allocated && alloc != m_alloc)
+    {
+      printf("Attempted to change the allocator of an allocated usymat \n");
+      exit(1);
+    }
+    m_alloc = alloc;
+  }
   inline int get_alignment()
     {return m_alignment;}
 
@@ -114,9 +167,20 @@ class usymat
   void zero();			//makes matrix zero
   void I();			//makes matrix identity
   void operator= (const T a);	//makes matrix constant
+  void scale(const T a);	//M = a*M
+  void axpy(const T a, const usymat<T>& X);	//M = M + a*X
+  void copy_from(const usymat<T>& X);	//M = X
+  T dot(const usymat<T>& X) const;	//sum of M(i,j)*X(i,j)
+  double norm() const;		//Frobenius norm
+  void unpack_to(gemat<T>& A, const bool fill_lower=true) const;	//A = M
+  void pack_from(const gemat<T>& A);	//M = upper of A
   void print() const;		//prints matrix
   void calc_alignment();	//determine alignment 
 
+  private:
+  void check_shape(const usymat<T>& X, const char* opr) const;	//exits on mismatch
+  void check_square(const gemat<T>& A, const char* opr) const;	//exits if not n x n
+
 };
 
 template class usymat<double>;
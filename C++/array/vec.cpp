@@ -5,7 +5,10 @@
   .cpp file for vector templates
 
 -------------------------------------------------------*/
+#include <utility> //for std::move
+#include <math.h>  //for sqrt
 #include "vec.hpp"
+#include "array_simd.hpp"
 
 /*-------------------------------------------------------
   Constructors
@@ -61,6 +64,87 @@ template vec<float>::~vec();
 template vec<long>::~vec();
 template vec<int>::~vec();
 
+/*-------------------------------------------------------
+   move constructor and assignment
+	- takes the buffer (and allocator) of other, which is 
+	  left unset, so it frees nothing
+-------------------------------------------------------*/
+template <typename T>
+vec<T>::vec(vec<T>&& other)
+{
+  m_buf = NULL;
+  m_ptr = NULL;
+  m_len = 0;
+  m_allocated = false;
+  m_assigned = false;
+  m_alignment = 0;
+  *this = std::move(other);
+}
+template vec<double>::vec(vec<double>&& other);
+template vec<float>::vec(vec<float>&& other);
+template vec<long>::vec(vec<long>&& other);
+template vec<int>::vec(vec<int>&& other);
+
+template <typename T>
+vec<T>& vec<T>::operator= (vec<T>&& other)
+{
+  if (this == &other) {return *this;}
+  free();
+  m_buf       = other.m_buf;
+  m_ptr       = other.m_ptr;
+  m_len       = other.m_len;
+  m_allocated = other.m_allocated;
+  m_assigned  = other.m_assigned;
+  m_alignment = other.m_alignment;
+  other.m_buf       = NULL;
+  other.m_ptr       = NULL;
+  other.m_len       = 0;
+  other.m_allocated = false;
+  other.m_assigned  = false;
+  other.m_alignment = 0;
+  return *this;
+}
+template vec<double>& vec<double>::operator= (vec<double>&& other);
+template vec<float>& vec<float>::operator= (vec<float>&& other);
+template vec<long>& vec<long>::operator= (vec<long>&& other);
+template vec<int>& vec<int>::operator= (vec<int>&& other);
+
+/*-------------------------------------------------------
+   clone
+	- deep copy, allocated via malloc
+-------------------------------------------------------*/
+template <typename T>
+vec<T> vec<T>::clone() const
+{
+  vec<T> X;
+  if (m_allocated || m_assigned)
+  {
+    X.allocate(m_len);
+    for (long i=0;i<m_len;i++) {X.m_buf[i] = m_buf[i];}
+  }
+  return X;
+}
+template vec<double> vec<double>::clone() const;
+template vec<float> vec<float>::clone() const;
+template vec<long> vec<long>::clone() const;
+template vec<int> vec<int>::clone() const;
+
+/*-------------------------------------------------------
+   zeros
+	- factory, allocated via malloc and zeroed
+-------------------------------------------------------*/
+template <typename T>
+vec<T> vec<T>::zeros(const long n)
+{
+  vec<T> X(n);
+  if (X.size() > 0) {X.zero();}
+  return X;
+}
+template vec<double> vec<double>::zeros(const long n);
+template vec<float> vec<float>::zeros(const long n);
+template vec<long> vec<long>::zeros(const long n);
+template vec<int> vec<int>::zeros(const long n);
+
 /*-------------------------------------------------------
  * int calc_alignment()
  * calculates the alignment of m_buf
@@ -95,6 +179,7 @@ void vec<T>::allocate(const long n)
   if (!(m_allocated || m_assigned) && n >= 0 && n <= mm) 
   {
     m_ptr = (T*) malloc(n*sizeof(T));
+    libj::mem_track(m_ptr,n*sizeof(T));
   } else if (n < 0) {
     printf("Attempted to allocate vec of < 0 element \n");
     exit(1);
@@ -138,6 +223,7 @@ void vec<T>::aligned_allocate(const int ALIGN, const long N)
   if (!(m_allocated || m_assigned) && N >= 0 && N <= mm) 
   {
     m_ptr = (T*) malloc(ALIGN+N*sizeof(T));
+    libj::mem_track(m_ptr,ALIGN+N*sizeof(T));
 //  } else if (N < 1) {
 //    printf("Attempted to aligned allocate vec of < 1 element \n");
   } else if (N < 0) {
@@ -300,6 +386,7 @@ void vec<T>::deallocate()
   if (m_allocated)  
   { 
     m_len = 0;
+    libj::mem_untrack(m_ptr);
     std::free(m_ptr); 
     m_buf = NULL;
     m_allocated = false;
@@ -361,21 +448,13 @@ template void vec<int>::info() const;
 
 /*-------------------------------------------------------
    zero 
-	- zeros the vector. Uses a fancy inf. loop to 
-	  do one less action per iteration
+	- zeros the vector, see array_simd.hpp
 -------------------------------------------------------*/
 template <typename T>
 void vec<T>::zero()
 {
   assert (m_allocated||m_assigned);
-  long i=0;
-  const long ll=m_len-1;
-  while (true)
-  {
-    *(m_buf+i) = (T) 0;
-    if (i >= ll) break;
-    i++;
-  }
+  array_simd_zero<T>(m_len,m_buf,m_alignment);
 }
 template void vec<double>::zero();
 template void vec<float>::zero();
@@ -391,20 +470,104 @@ template <typename T>
 void vec<T>::operator= (const T a)
 {
   assert (m_allocated||m_assigned);
-  long i=0;
-  const long ll=m_len-1;
-  while (true)
-  {
-    *(m_buf+i) = a;
-    if (i >= ll) break;
-    i++;
-  }
+  array_simd_set<T>(m_len,a,m_buf,m_alignment);
 }
 template void vec<double>::operator=(const double a);
 template void vec<float>::operator=(const float a);
 template void vec<long>::operator=(const long a);
 template void vec<int>::operator=(const int a);
 
+/*-------------------------------------------------------
+  scale
+	- X = a*X 
+-------------------------------------------------------*/
+template <typename T>
+void vec<T>::scale(const T a)
+{
+  assert(m_allocated||m_assigned);
+  array_simd_scale<T>(m_len,a,m_buf,m_alignment);
+}
+template void vec<double>::scale(const double a);
+template void vec<float>::scale(const float a);
+template void vec<long>::scale(const long a);
+template void vec<int>::scale(const int a);
+/*-------------------------------------------------------
+  check_shape
+	- exits if X is not the shape of this vec 
+-------------------------------------------------------*/
+template <typename T>
+void vec<T>::check_shape(const vec<T>& X, const char* opr) const
+{
+  if (m_len != X.m_len)
+  {
+    printf("Attempted to %s vec of %ld with vec of %ld \n",
+           opr,m_len,X.m_len);
+    exit(1);
+  }
+}
+template void vec<double>::check_shape(const vec<double>& X, const char* opr) const;
+template void vec<float>::check_shape(const vec<float>& X, const char* opr) const;
+template void vec<long>::check_shape(const vec<long>& X, const char* opr) const;
+template void vec<int>::check_shape(const vec<int>& X, const char* opr) const;
+/*-------------------------------------------------------
+  axpy
+	- this = this + a*X 
+-------------------------------------------------------*/
+template <typename T>
+void vec<T>::axpy(const T a, const vec<T>& X)
+{
+  assert(m_allocated||m_assigned);
+  check_shape(X,"axpy");
+  array_simd_axpy<T>(m_len,a,X.m_buf,m_buf,array_simd_align(m_alignment,X.m_alignment));
+}
+template void vec<double>::axpy(const double a, const vec<double>& X);
+template void vec<float>::axpy(const float a, const vec<float>& X);
+template void vec<long>::axpy(const long a, const vec<long>& X);
+template void vec<int>::axpy(const int a, const vec<int>& X);
+/*-------------------------------------------------------
+  copy_from
+	- this = X, of the same shape 
+-------------------------------------------------------*/
+template <typename T>
+void vec<T>::copy_from(const vec<T>& X)
+{
+  assert(m_allocated||m_assigned);
+  check_shape(X,"copy_from");
+  array_simd_copy<T>(m_len,X.m_buf,m_buf,array_simd_align(m_alignment,X.m_alignment));
+}
+template void vec<double>::copy_from(const vec<double>& X);
+template void vec<float>::copy_from(const vec<float>& X);
+template void vec<long>::copy_from(const vec<long>& X);
+template void vec<int>::copy_from(const vec<int>& X);
+/*-------------------------------------------------------
+  dot
+	- sum_i v(i)*X(i) 
+-------------------------------------------------------*/
+template <typename T>
+T vec<T>::dot(const vec<T>& X) const
+{
+  assert(m_allocated||m_assigned);
+  check_shape(X,"dot");
+  return array_simd_dot<T>(m_len,m_buf,X.m_buf,array_simd_align(m_alignment,X.m_alignment));
+}
+template double vec<double>::dot(const vec<double>& X) const;
+template float vec<float>::dot(const vec<float>& X) const;
+template long vec<long>::dot(const vec<long>& X) const;
+template int vec<int>::dot(const vec<int>& X) const;
+/*-------------------------------------------------------
+  norm
+	- 2-norm, sqrt(v.dot(v)) 
+-------------------------------------------------------*/
+template <typename T>
+double vec<T>::norm() const
+{
+  return sqrt((double) dot(*this));
+}
+template double vec<double>::norm() const;
+template double vec<float>::norm() const;
+template double vec<long>::norm() const;
+template double vec<int>::norm() const;
+
 /*-------------------------------------------------------
    print
 	- prints elements of vector 
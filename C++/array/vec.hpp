@@ -5,7 +5,11 @@
   allows for assignement to existing memory, as well as
   allocation (aligned or otherwise) via malloc
 
-  NOTE : There is NO BOUNDS CHECKING in this class
+  NOTE : There is NO BOUNDS CHECKING in this class, unless
+         libj is built with -DLIBJ_CHECKED (see debug.hpp)
+
+  NOTE : A vec can be moved (returned from a function, 
+         held in a std::vector), but not copied, see clone()
 
   NOTE : Indexing begins at zero, and all elements
          are stored continuously in memory. 
@@ -23,6 +27,10 @@
   v.allocate(5);	            //allocates vector via malloc 
   v.assign(5,pntr);	            //assigns buffer to address
   v.alligned_allocate(BYTE,5)   //alligned allocation via malloc to BYTE 
+  vec<double> v = vec<double>::zeros(5);	//allocated and zeroed
+  vec<double> X = v.clone();		//deep copy, allocated via malloc
+  vec<double> X(std::move(v));		//takes the buffer, v is unset
+  vec<double> X = f();			//returned by move, no copy
 
   DEALLOCATION OPTIONS
   --------------------------
@@ -34,11 +42,22 @@
   --------------------------
   v.info();		    //prints info about matrix
   v.zero();		    //zeros the whole matrix
+  v = a;		    //sets all elements to a
+  v.scale(a);		    //v = a*v
+  v.axpy(a,x);		    //v = v + a*x, x of the same size
+  v.copy_from(x);	    //v = x, x of the same size
+  v.dot(x);		    //sum of v(i)*x(i)
+  v.norm();		    //2-norm (double)
   v.size();		    //returns number of elem (long)
   v.is_allocated();	//returns true if vector is allocated
   v.is_assigned();	//returns true if vector is assigned
   v.alignment();    //returns alignment in BYTES
 
+  The bulk operations call the aligned simd_*<T,ALIGNMENT>
+  for the alignment of the buffer(s), and the threaded 
+  simd_par_* for libj::simd_par_min_n() or more elements,
+  see array_simd.hpp.
+
 --------------------------------------------------------*/
 #ifndef VEC_HPP
 #define VEC_HPP
@@ -48,6 +67,8 @@
 #include <stdio.h> //for printf
 #include <limits>  //for numeric_limits::max()
 #include <assert.h>  //for assert
+#include "mem_registry.hpp"
+#include "debug.hpp"
 
 template <typename T>
 class vec
@@ -65,18 +86,29 @@ class vec
   vec();					        //empty constructor
  ~vec();					        //destructor 
 
+  //move : takes the buffer, other is left unset. Copies are deleted, as
+  //  both would free the one buffer, use clone() for a deep copy
+  vec(vec<T>&& other);
+  vec<T>& operator= (vec<T>&& other);
+  vec(const vec<T>& other) = delete;
+  vec<T>& operator= (const vec<T>& other) = delete;
+
+  //factories, allocated via malloc
+  static vec<T> zeros(const long n);	//zeroed
+  vec<T> clone() const;	//deep copy
+
   vec(const long n);				//construct with n elements
   vec(const long n, T* ptr);	    //construct with n elements at ptr
 
   //Operator overloading : inlined
   inline T& operator() (const long i)	 //ref elm i
-    {return(*(m_buf+i));} 
+    {LIBJ_CHECK_BOUNDS(i,m_len); return(*(m_buf+i));} 
   inline const T& operator() (const long i) const //const elm i
-    {return(*(m_buf+i));} 
+    {LIBJ_CHECK_BOUNDS(i,m_len); return(*(m_buf+i));} 
   inline T& operator[] (const long i)	 //ref elm i
-    {return(*(m_buf+i));} 
+    {LIBJ_CHECK_BOUNDS(i,m_len); return(*(m_buf+i));} 
   inline const T& operator[] (const long i) const	//const elm i
-    {return(*(m_buf+i));} 				
+    {LIBJ_CHECK_BOUNDS(i,m_len); return(*(m_buf+i));} 				
 
   //Size function : inlined
   inline long size() const 			//return length
@@ -104,11 +136,19 @@ class vec
   void info() const;				//print info
   void zero();					//zeros the vector
   void operator= (const T a);			//makes vector equal constant
+  void scale(const T a);			//v = a*v
+  void axpy(const T a, const vec<T>& X);	//v = v + a*X
+  void copy_from(const vec<T>& X);		//v = X
+  T dot(const vec<T>& X) const;			//sum of v(i)*X(i)
+  double norm() const;				//2-norm
   void print() const;				//prints the elements of the vector
   void print(const long lo,		//prints elements of vector between 
              const long hi) const;         	//  lo and hi
   void calc_alignment(); 			//determine the alignment
 
+  private:
+  void check_shape(const vec<T>& X, const char* opr) const;	//exits on mismatch
+
 };
 
 template class vec<double>;
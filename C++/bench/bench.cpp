@@ -0,0 +1,322 @@
+/*--------------------------------------------------------------------------
+  bench.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for the libj benchmark harness, see bench.hpp
+--------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "libjdef.h"
+#include "cache_info.hpp"
+#include "timer.hpp"
+#include "bench.hpp"
+
+#if defined (__AVX512F__) || defined (__FMA__)
+  #include <immintrin.h>
+#endif
+
+#if defined (_OPENMP)
+  #include <omp.h>
+#endif
+
+//independent FMA chains of the peak measurement, enough to cover the
+//latency of two FMA ports without running out of registers
+#if defined (__AVX512F__)
+  #define BENCH_CHAINS 24
+  #define BENCH_VLEN   8
+#elif defined (__FMA__)
+  #define BENCH_CHAINS 12
+  #define BENCH_VLEN   4
+#else
+  #define BENCH_CHAINS 12
+  #define BENCH_VLEN   1
+#endif
+
+//smallest DRAM working set, in bytes
+#define BENCH_DRAM_MIN (64L*1024L*1024L)
+
+//repeats of the FMA chains per call of the peak measurement
+#define BENCH_FMA_REPS 100000L
+
+namespace libj
+{
+
+//--------------------------------------------------------------------------
+// bench_fma
+//	reps of BENCH_CHAINS independent FMAs of BENCH_VLEN doubles, returns
+//	a value of the chains so they are not removed
+//--------------------------------------------------------------------------
+static double bench_fma(const long reps)
+{
+  const double mul = 0.9999999, add = 1.0e-7;
+  double out[BENCH_VLEN];
+#if defined (__AVX512F__)
+  const __m512d m = _mm512_set1_pd(mul), a = _mm512_set1_pd(add);
+  __m512d acc[BENCH_CHAINS];
+  for (int c=0;c<BENCH_CHAINS;c++) {acc[c] = _mm512_set1_pd((double) c);}
+  for (long r=0;r<reps;r++)
+  {
+    for (int c=0;c<BENCH_CHAINS;c++) {acc[c] = _mm512_fmadd_pd(acc[c],m,a);}
+  }
+  for (int c=1;c<BENCH_CHAINS;c++) {acc[0] = _mm512_add_pd(acc[0],acc[c]);}
+  _mm512_storeu_pd(out,acc[0]);
+#elif defined (__FMA__)
+  const __m256d m = _mm256_set1_pd(mul), a = _mm256_set1_pd(add);
+  __m256d acc[BENCH_CHAINS];
+  for (int c=0;c<BENCH_CHAINS;c++) {acc[c] = _mm256_set1_pd((double) c);}
+  for (long r=0;r<reps;r++)
+  {
+    for (int c=0;c<BENCH_CHAINS;c++) {acc[c] = _mm256_fmadd_pd(acc[c],m,a);}
+  }
+  for (int c=1;c<BENCH_CHAINS;c++) {acc[0] = _mm256_add_pd(acc[0],acc[c]);}
+  _mm256_storeu_pd(out,acc[0]);
+#else
+  double acc[BENCH_CHAINS];
+  for (int c=0;c<BENCH_CHAINS;c++) {acc[c] = (double) c;}
+  for (long r=0;r<reps;r++)
+  {
+    for (int c=0;c<BENCH_CHAINS;c++) {acc[c] = acc[c]*mul + add;}
+  }
+  for (int c=1;c<BENCH_CHAINS;c++) {acc[0] += acc[c];}
+  out[0] = acc[0];
+#endif
+  double sum = 0.0;
+  for (int v=0;v<BENCH_VLEN;v++) {sum += out[v];}
+  return sum;
+}
+
+//--------------------------------------------------------------------------
+// constructor
+//--------------------------------------------------------------------------
+BENCH::BENCH(int argc, char** argv)
+{
+  m_json     = false;
+  m_levels   = "L1,L2,LLC,DRAM";
+  m_min_time = 0.1;
+  m_sink     = 0.0;
+
+  for (int i=1;i<argc;i++)
+  {
+    const bool more = (i+1 < argc);
+    if (strcmp(argv[i],"--json") == 0) {m_json = true;}
+    else if (strcmp(argv[i],"--out") == 0 && more) {m_out = argv[++i];}
+    else if (strcmp(argv[i],"--only") == 0 && more) {m_only = argv[++i];}
+    else if (strcmp(argv[i],"--levels") == 0 && more) {m_levels = argv[++i];}
+    else if (strcmp(argv[i],"--time") == 0 && more) {m_min_time = atof(argv[++i]);}
+    else
+    {
+      printf("ERROR libj::BENCH unknown option %s\n",argv[i]);
+      printf("usage : bench.exe [--json] [--out file] [--only text] "
+             "[--levels L1,L2,LLC,DRAM] [--time seconds]\n");
+      exit(1);
+    }
+  }
+  if (m_min_time <= 0.0)
+  {
+    printf("ERROR libj::BENCH --time must be positive\n");
+    exit(1);
+  }
+
+  //half of each cache, so the working set stays resident, and well
+  //past the largest cache for DRAM
+  const libj::CacheInfo& info = libj::CacheInfo::get();
+  m_fp[BENCH_L1]  = info.L1_bytes/2;
+  m_fp[BENCH_L2]  = info.L2_bytes/2;
+  m_fp[BENCH_LLC] = info.L3_bytes/2;
+  const size_t top = (info.L3_bytes > 0) ? info.L3_bytes : info.L2_bytes;
+  m_fp[BENCH_DRAM] = (4*top > (size_t) BENCH_DRAM_MIN) ? 4*top : (size_t) BENCH_DRAM_MIN;
+  for (int l=0;l<BENCH_NLEVEL;l++)
+  {
+    if (strstr(m_levels.c_str(),level_name(l)) == NULL) {m_fp[l] = 0;}
+  }
+
+  m_roofline();
+}
+
+//--------------------------------------------------------------------------
+// m_roofline
+//	STREAM triad at each working set, and peak FMA, on one and all
+//	threads. The triad reads two arrays for each one written, so kernels
+//	that only read can be over 100% of it in cache
+//--------------------------------------------------------------------------
+void BENCH::m_roofline()
+{
+  int nthr = 1;
+#if defined (_OPENMP)
+  nthr = omp_get_max_threads();
+#endif
+
+  for (int l=0;l<BENCH_NLEVEL;l++)
+  {
+    m_bw[0][l] = m_bw[1][l] = 0.0;
+    const long n = (long) (m_fp[l]/(3*sizeof(double)));
+    if (n <= 0) continue;
+    std::vector<double> a(n,0.0), b(n,1.0), c(n,2.0);
+    double* pa = a.data();
+    const double* pb = b.data();
+    const double* pc = c.data();
+    const double s = 0.5;
+    const double bytes = 3.0*sizeof(double)*n;
+
+    const double t1 = time(m_min_time,[&]
+    {
+      for (long i=0;i<n;i++) {pa[i] = pb[i] + s*pc[i];}
+    });
+    const double tp = time(m_min_time,[&]
+    {
+      #pragma omp parallel for schedule(static)
+      for (long i=0;i<n;i++) {pa[i] = pb[i] + s*pc[i];}
+    });
+    //the threaded kernels run small sizes on one thread, so the threaded
+    //roof is at least the one thread roof
+    m_bw[0][l] = bytes/t1;
+    m_bw[1][l] = (tp < t1) ? bytes/tp : bytes/t1;
+    m_sink += pa[n-1];
+
+    bench_result r = {"roof","stream_triad",l,n,bytes,t1,1.0e-9*bytes/t1,1.0e-9*2*n/t1,100.0};
+    results.push_back(r);
+    bench_result rp = {"roof","stream_triad_par",l,n,bytes,tp,1.0e-9*bytes/tp,1.0e-9*2*n/tp,100.0};
+    results.push_back(rp);
+  }
+
+  //reps is volatile, so the calls are not hoisted out of the timing
+  volatile long reps = BENCH_FMA_REPS;
+  const double flops = 2.0*BENCH_VLEN*BENCH_CHAINS*BENCH_FMA_REPS;
+  const double t1 = time(m_min_time,[&] {m_sink += bench_fma(reps);});
+  std::vector<double> sink(nthr,0.0);
+  const double tp = time(m_min_time,[&]
+  {
+    #pragma omp parallel
+    {
+      int tid = 0;
+#if defined (_OPENMP)
+      tid = omp_get_thread_num();
+#endif
+      sink[tid] += bench_fma(reps);
+    }
+  });
+  for (int t=0;t<nthr;t++) {m_sink += sink[t];}
+  m_peak[0] = flops/t1;
+  m_peak[1] = (nthr*flops/tp > m_peak[0]) ? nthr*flops/tp : m_peak[0];
+
+  bench_result r = {"roof","peak_fma",BENCH_CORE,BENCH_VLEN*BENCH_CHAINS,0.0,t1,0.0,1.0e-9*m_peak[0],100.0};
+  results.push_back(r);
+  bench_result rp = {"roof","peak_fma_par",BENCH_CORE,nthr*BENCH_VLEN*BENCH_CHAINS,0.0,tp,0.0,1.0e-9*m_peak[1],100.0};
+  results.push_back(rp);
+}
+
+//--------------------------------------------------------------------------
+// m_add
+//--------------------------------------------------------------------------
+void BENCH::m_add(const char* suite, const char* kernel, const int level,
+                  const long n, const double bytes, const double flops,
+                  const bool par, const double seconds)
+{
+  const int p = par ? 1 : 0;
+  double troof = 0.0;
+  if (m_peak[p] > 0.0) {troof = flops/m_peak[p];}
+  if (m_bw[p][level] > 0.0 && bytes/m_bw[p][level] > troof) {troof = bytes/m_bw[p][level];}
+
+  bench_result r;
+  r.suite   = suite;
+  r.kernel  = kernel;
+  r.level   = level;
+  r.n       = n;
+  r.bytes   = bytes;
+  r.seconds = seconds;
+  r.gbs     = (seconds > 0.0) ? 1.0e-9*bytes/seconds : 0.0;
+  r.gflops  = (seconds > 0.0) ? 1.0e-9*flops/seconds : 0.0;
+  r.roof    = (seconds > 0.0) ? 100.0*troof/seconds : 0.0;
+  results.push_back(r);
+  fprintf(stderr,"%s/%s %s n = %ld : %.3e s, %.2f GB/s, %.2f GFLOP/s, %.1f%% of roof\n",
+          suite,kernel,level_name(level),n,seconds,r.gbs,r.gflops,r.roof);
+}
+
+//--------------------------------------------------------------------------
+// footprint
+//--------------------------------------------------------------------------
+size_t BENCH::footprint(const int level) const
+{
+  return (level >= 0 && level < BENCH_NLEVEL) ? m_fp[level] : 0;
+}
+
+//--------------------------------------------------------------------------
+// level_name
+//--------------------------------------------------------------------------
+const char* BENCH::level_name(const int level)
+{
+  static const char* names[BENCH_NLEVEL+1] = {"L1","L2","LLC","DRAM","core"};
+  return (level >= 0 && level <= BENCH_NLEVEL) ? names[level] : "none";
+}
+
+//--------------------------------------------------------------------------
+// wants
+//--------------------------------------------------------------------------
+bool BENCH::wants(const char* suite, const char* kernel) const
+{
+  if (m_only.empty()) return true;
+  const std::string name = std::string(suite) + "/" + kernel;
+  return name.find(m_only) != std::string::npos;
+}
+
+//--------------------------------------------------------------------------
+// write
+//--------------------------------------------------------------------------
+int BENCH::write() const
+{
+  FILE* fp = stdout;
+  if (!m_out.empty())
+  {
+    fp = fopen(m_out.c_str(),"w");
+    if (fp == NULL)
+    {
+      printf("ERROR libj::BENCH::write could not open %s\n",m_out.c_str());
+      return 1;
+    }
+  }
+
+  if (m_json) {fprintf(fp,"[\n");}
+  else {fprintf(fp,"suite,kernel,level,n,bytes,seconds,GBps,GFLOPs,roof_pct,ns_per_elm\n");}
+  for (size_t i=0;i<results.size();i++)
+  {
+    const bench_result& r = results[i];
+    const double nspe = (r.n > 0) ? 1.0e9*r.seconds/r.n : 0.0;
+    if (m_json)
+    {
+      fprintf(fp,"  {\"suite\": \"%s\", \"kernel\": \"%s\", \"level\": \"%s\", "
+                 "\"n\": %ld, \"bytes\": %.0f, \"seconds\": %.6e, \"GBps\": %.4f, "
+                 "\"GFLOPs\": %.4f, \"roof_pct\": %.2f, \"ns_per_elm\": %.4f}%s\n",
+              r.suite.c_str(),r.kernel.c_str(),level_name(r.level),r.n,r.bytes,
+              r.seconds,r.gbs,r.gflops,r.roof,nspe,(i+1 < results.size()) ? "," : "");
+    }
+    else
+    {
+      fprintf(fp,"%s,%s,%s,%ld,%.0f,%.6e,%.4f,%.4f,%.2f,%.4f\n",
+              r.suite.c_str(),r.kernel.c_str(),level_name(r.level),r.n,r.bytes,
+              r.seconds,r.gbs,r.gflops,r.roof,nspe);
+    }
+  }
+  if (m_json) {fprintf(fp,"]\n");}
+
+  if (fp != stdout) {fclose(fp);}
+  fprintf(stderr,"libj::BENCH checksum %.6e\n",m_sink);
+  return 0;
+}
+
+}//end libj namespace
+
+//--------------------------------------------------------------------------
+// main
+//--------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  libj::BENCH B(argc,argv);
+  libj::bench_simd(B);
+  libj::bench_linal(B);
+  libj::bench_jblis(B);
+  libj::bench_tensor(B);
+  return B.write();
+}
@@ -0,0 +1,183 @@
+/*--------------------------------------------------------------------------
+  bench.hpp
+	JHT, October 14, 2026 : created
+	JHT, October 14, 2026 : added the tensor suite
+
+  .hpp file for the libj benchmark harness, bench.exe, which sweeps the
+  problem size of the simd_* kernels, the linal_* routines, the jblis
+  level-1 operations, and the tensor element access paths over working
+  sets resident in L1, L2, the last level cache, and DRAM (from
+  libj::CacheInfo), and reports for each
+
+    time per call, GB/s, GFLOP/s, % of the roofline, and ns per element
+
+  as CSV (default) or JSON. The roofline is measured at the start, as the
+  STREAM triad bandwidth at each working set size and the peak rate of
+  independent FMA chains, both for one thread and for all OpenMP threads.
+  The threaded roof, which is never below the one thread roof, is used 
+  for the simd_par_*, linal_par_*, and jblis (which run on all threads) 
+  entries.
+
+  Bytes are the compulsory traffic of one call (each array read once, and
+  written once if it is an output), and flops are those of the plain
+  operation, so the Kahan and pairwise sums count what simd_dot counts.
+  The % of roof is the time the roofline allows for those bytes and
+  flops, max(flops/peak, bytes/bandwidth), over the measured time.
+
+  Each entry is called once to warm up (and size the repeats), then timed
+  in up to BENCH_SAMPLES samples of about min_time/BENCH_SAMPLES seconds,
+  and the fastest sample is reported.
+
+  Usage
+  -------------------
+  bench.exe [--json] [--out file] [--only text] [--levels L1,L2,LLC,DRAM]
+            [--time seconds]
+
+    --json    JSON instead of CSV
+    --out     write to file instead of stdout
+    --only    entries whose "suite/kernel" contains text, e.g. simd_dot
+              or linal/
+    --levels  residency levels to sweep
+    --time    seconds to spend timing each entry, 0.1 by default
+--------------------------------------------------------------------------*/
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "timer.hpp"
+
+#define BENCH_SAMPLES 5
+
+namespace libj
+{
+
+//residency of the working set, BENCH_CORE (registers) is only used by
+//the peak FMA entry of the roofline
+enum bench_level {BENCH_L1=0, BENCH_L2, BENCH_LLC, BENCH_DRAM, BENCH_NLEVEL,
+                  BENCH_CORE=BENCH_NLEVEL};
+
+struct bench_result
+{
+  std::string suite;     //simd, linal, jblis, or roof
+  std::string kernel;
+  int         level;
+  long        n;         //problem size, elements or matrix dimension
+  double      bytes;     //per call
+  double      seconds;   //per call
+  double      gbs;
+  double      gflops;
+  double      roof;      //% of roofline
+};
+
+class BENCH
+{
+  private:
+  bool        m_json;
+  std::string m_out;
+  std::string m_only;
+  std::string m_levels;
+  double      m_min_time;
+  size_t      m_fp[BENCH_NLEVEL];     //bytes of the working set of each level
+  double      m_bw[2][BENCH_NLEVEL];  //triad bytes/s, one and all threads
+  double      m_peak[2];              //flop/s, one and all threads
+  double      m_sink;                 //results of the kernels, so none are elided
+
+  void m_roofline();
+  void m_add(const char* suite, const char* kernel, const int level,
+             const long n, const double bytes, const double flops,
+             const bool par, const double seconds);
+
+  public:
+  std::vector<bench_result> results;
+
+  BENCH(int argc, char** argv);
+
+  //bytes of the working set resident in level, 0 if the level is not swept
+  size_t footprint(const int level) const;
+
+  static const char* level_name(const int level);
+
+  //true if suite/kernel is to be run
+  bool wants(const char* suite, const char* kernel) const;
+
+  //keep a result of a kernel
+  void keep(const double val) {m_sink += val;}
+
+  //time call, which does one call of kernel on n elements, moving bytes
+  //and doing flops. par if it runs on all threads
+  template <class F>
+  void run(const char* suite, const char* kernel, const int level,
+           const long n, const double bytes, const double flops,
+           const bool par, F call);
+
+  //write the results, returns 0 on success
+  int write() const;
+
+  //seconds per call of the fastest sample
+  template <class F>
+  static double time(const double min_time, F call);
+};
+
+//n elements of T in buf, from element off (of T), set to one
+template <typename T>
+inline T* bench_vec(std::vector<double>& buf, const long off, const long n)
+{
+  T* ptr = reinterpret_cast<T*>(buf.data()) + off;
+  for (long i=0;i<n;i++) {ptr[i] = (T) 1;}
+  return ptr;
+}
+
+//the suites, in bench_simd.cpp, bench_linal.cpp, bench_jblis.cpp, and
+//bench_tensor.cpp
+void bench_simd(libj::BENCH& B);
+void bench_linal(libj::BENCH& B);
+void bench_jblis(libj::BENCH& B);
+void bench_tensor(libj::BENCH& B);
+
+//--------------------------------------------------------------------------
+// run
+//--------------------------------------------------------------------------
+template <class F>
+void BENCH::run(const char* suite, const char* kernel, const int level,
+                const long n, const double bytes, const double flops,
+                const bool par, F call)
+{
+  if (n <= 0 || !wants(suite,kernel)) return;
+  m_add(suite,kernel,level,n,bytes,flops,par,time(m_min_time,call));
+}
+
+//--------------------------------------------------------------------------
+// time
+//	the first call sizes the repeats of the samples, which are resized 
+//	from each sample, and is the result if it alone takes more than 
+//	2*min_time
+//--------------------------------------------------------------------------
+template <class F>
+double BENCH::time(const double min_time, F call)
+{
+  Timer timer;
+  call();
+  const double first = timer.elapsed();
+
+  const double target = min_time/BENCH_SAMPLES;
+  long reps = (first > 0.0) ? (long) (target/first) : 1;
+  if (reps < 1) reps = 1;
+
+  double best = -1.0;
+  double total = first;
+  for (int s=0;s<BENCH_SAMPLES && total < 2.0*min_time;s++)
+  {
+    timer.reset();
+    for (long r=0;r<reps;r++) {call();}
+    const double t = timer.elapsed();
+    total += t;
+    if (best < 0.0 || t/reps < best) {best = t/reps;}
+    if (t > 0.0 && t < 0.5*target) {reps = (long) (reps*target/t);}
+  }
+  return (best < 0.0) ? first : best;
+}
+
+}//end libj namespace
+#endif
@@ -0,0 +1,76 @@
+/*--------------------------------------------------------------------------
+  bench_jblis.cpp
+	JHT, October 14, 2026 : created
+
+  The jblis suite of bench.exe : the level-1 tensor operations of
+  jblis_level1.hpp, on double tensors assigned to one buffer of the
+  working set of the level. The 2D tensors are n x n, and the 4D ones
+  q x q x q x q. jblis threads these, so the threaded roof is used.
+--------------------------------------------------------------------------*/
+#include <math.h>
+#include <vector>
+#include "tensor.hpp"
+#include "jblis.hpp"
+#include "bench.hpp"
+
+namespace libj
+{
+
+//--------------------------------------------------------------------------
+// bench_jblis
+//--------------------------------------------------------------------------
+void bench_jblis(libj::BENCH& B)
+{
+  const char* S = "jblis";
+  const double a = 1.0e-8, b = 0.5;
+
+  for (int l=0;l<BENCH_NLEVEL;l++)
+  {
+    const long fp = (long) B.footprint(l);
+    if (fp == 0) continue;
+    std::vector<double> buf(fp/sizeof(double) + 8);
+
+    //one n x n tensor
+    long n  = (long) sqrt(fp/8.0);
+    long n2 = n*n;
+    {
+      libj::tensor<double> A(bench_vec<double>(buf,0,n2),n,n);
+      B.run(S,"zero",l,n2,8.0*n2,0,true,[&]{libj::zero<double>(A);});
+      B.run(S,"set",l,n2,8.0*n2,0,true,[&]{libj::set<double>(b,A);});
+      bench_vec<double>(buf,0,n2);
+      B.run(S,"scal",l,n2,16.0*n2,n2,true,[&]{libj::scal<double>(1.0-a,A);});
+      B.run(S,"norm2",l,n2,8.0*n2,2.0*n2,true,[&]{B.keep(libj::norm2<double>(A));});
+      B.run(S,"reduce_max",l,n2,8.0*n2,0,true,[&]{B.keep(libj::reduce_max<double>(A));});
+    }
+
+    //two n x n tensors
+    n  = (long) sqrt(fp/16.0);
+    n2 = n*n;
+    {
+      libj::tensor<double> X(bench_vec<double>(buf,0,n2),n,n);
+      libj::tensor<double> Y(bench_vec<double>(buf,n2,n2),n,n);
+      B.run(S,"copy",l,n2,16.0*n2,0,true,[&]{libj::copy<double>(X,Y);});
+      B.run(S,"scopy",l,n2,16.0*n2,n2,true,[&]{libj::scopy<double>(b,X,Y);});
+      B.run(S,"dot",l,n2,16.0*n2,2.0*n2,true,[&]{B.keep(libj::dot<double>(X,"ab",Y,"ab"));});
+      B.run(S,"dot_ab_ba",l,n2,16.0*n2,2.0*n2,true,[&]{B.keep(libj::dot<double>(X,"ab",Y,"ba"));});
+      B.run(S,"permute_ab_ba",l,n2,16.0*n2,0,true,[&]{libj::permute<double>(X,"ab",Y,"ba");});
+      B.run(S,"axpby_ab_ba",l,n2,24.0*n2,3.0*n2,true,[&]{libj::axpby<double>(a,X,"ab",b,Y,"ba");});
+    }
+
+    //two q x q x q x q tensors
+    const long q  = (long) pow(fp/16.0,0.25);
+    const long q4 = q*q*q*q;
+    {
+      libj::tensor<double> X(bench_vec<double>(buf,0,q4),q,q,q,q);
+      libj::tensor<double> Y(bench_vec<double>(buf,q4,q4),q,q,q,q);
+      B.run(S,"permute_abcd_acbd",l,q4,16.0*q4,0,true,[&]{libj::permute<double>(X,"abcd",Y,"acbd");});
+      B.run(S,"permute_abcd_dcba",l,q4,16.0*q4,0,true,[&]{libj::permute<double>(X,"abcd",Y,"dcba");});
+      B.run(S,"axpby_abcd_badc",l,q4,24.0*q4,3.0*q4,true,
+            [&]{libj::axpby<double>(a,X,"abcd",b,Y,"badc");});
+      B.run(S,"dot_abcd_dcba",l,q4,16.0*q4,2.0*q4,true,
+            [&]{B.keep(libj::dot<double>(X,"abcd",Y,"dcba"));});
+    }
+  }
+}
+
+}//end libj namespace
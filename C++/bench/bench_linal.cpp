@@ -0,0 +1,247 @@
+/*--------------------------------------------------------------------------
+  bench_linal.cpp
+	JHT, October 14, 2026 : created
+	JHT, October 14, 2026 : linal_strassen, and its error bound
+
+  The linal suite of bench.exe : the level-2 and level-3 linal_* routines
+  of linal.hpp, the batched 3x3 routines of linal_batch.hpp (NB matrices
+  per call), and the element wise small routines, on doubles.
+
+  The matrices are square, n x n, with n set so that all the operands of
+  the routine fill the working set of the level. Upper symmetric matrices
+  are packed, n(n+1)/2. The flops are the usual counts of the operation
+  (2n^3 for a product, half of that when only the upper triangle is
+  made), not counting the scaling by alpha and beta. The n of the n^3
+  routines is at most BENCH_LINAL_MAX_DIM, so on machines with a large
+  last level cache their DRAM entries may be cache resident.
+
+  linal_strassen is timed with BENCH_LINAL_STRASSEN_MIN, so the larger n
+  do one or more levels, and its flops are those of the plain product, so
+  its GFLOP/s is the rate of linal_gemm that would take as long. At each
+  n its error is checked against linal_gemm on random matrices, which is
+  written to stderr, with an ERROR if it is above the bound of
+  linal_strassen_bound.
+
+  The LAPACK backed routines (linal_decomp, linal_solve, linal_svd, and
+  linal_ATDAeU/Y) are not part of the sweep, as they time LAPACK.
+--------------------------------------------------------------------------*/
+#include <math.h>
+#include <vector>
+#include <algorithm>
+#include "linal.hpp"
+#include "bench.hpp"
+
+//largest n of the n^3 routines, so a DRAM sized working set on a large
+//last level cache does not take minutes a call
+#define BENCH_LINAL_MAX_DIM 2048
+
+//smallest n of a level of linal_strassen
+#define BENCH_LINAL_STRASSEN_MIN 512
+
+namespace libj
+{
+
+//--------------------------------------------------------------------------
+// bench_dim
+//	n of the n x n operands, when c of them fill bytes, and at most max
+//--------------------------------------------------------------------------
+static long bench_dim(const long bytes, const double c, const long max=0)
+{
+  const long n = (long) sqrt(bytes/(c*sizeof(double)));
+  return (max > 0 && n > max) ? max : n;
+}
+
+//--------------------------------------------------------------------------
+// bench_strassen_error
+//	max|C - fl(C)| of linal_strassen, against linal_gemm, for an n x n
+//	product of random A and B in [-1,1), and its bound
+//--------------------------------------------------------------------------
+static void bench_strassen_error(libj::BENCH& B, const int n)
+{
+  const int  L  = linal_strassen_depth(n,n,n,BENCH_LINAL_STRASSEN_MIN,LINAL_STRASSEN_LEVELS);
+  const long n2 = (long) n*n;
+  std::vector<double> A(n2), X(n2), C(n2), R(n2);
+  unsigned long seed = 12345;
+  for (long i=0;i<n2;i++)
+  {
+    seed = seed*6364136223846793005UL + 1442695040888963407UL;
+    A[i] = (double) (seed >> 11)/9007199254740992.0*2.0 - 1.0;
+    seed = seed*6364136223846793005UL + 1442695040888963407UL;
+    X[i] = (double) (seed >> 11)/9007199254740992.0*2.0 - 1.0;
+  }
+  linal_gemm<double>(false,n,n,n,1.0,A.data(),X.data(),0.0,R.data());
+  linal_strassen<double>(n,n,n,1.0,A.data(),n,X.data(),n,0.0,C.data(),n,BENCH_LINAL_STRASSEN_MIN);
+
+  double err = 0, amax = 0, xmax = 0;
+  for (long i=0;i<n2;i++)
+  {
+    err  = std::max(err,fabs(C[i] - R[i]));
+    amax = std::max(amax,fabs(A[i]));
+    xmax = std::max(xmax,fabs(X[i]));
+  }
+  //the bound, and that of the reference
+  const double u     = 1.1102230246251565e-16;
+  const double bound = (linal_strassen_bound(n,L) + (double) n2)*u*amax*xmax;
+  fprintf(stderr,"linal/linal_strassen n = %d, %d levels : error %.3e, bound %.3e\n",n,L,err,bound);
+  if (err > bound)
+  {
+    fprintf(stderr,"ERROR libj::bench_linal linal_strassen error %.3e is above the bound %.3e\n",err,bound);
+  }
+  B.keep(err);
+}
+
+//--------------------------------------------------------------------------
+// bench_linal
+//--------------------------------------------------------------------------
+void bench_linal(libj::BENCH& B)
+{
+  const char* S = "linal";
+  const double a = 1.0e-8, b = 0.5;
+
+  for (int l=0;l<BENCH_NLEVEL;l++)
+  {
+    const long fp = (long) B.footprint(l);
+    if (fp == 0) continue;
+    //room for a few vectors past the matrices
+    std::vector<double> buf(fp/sizeof(double) + 4*bench_dim(fp,1.0) + 8);
+    long n, n2, nu;
+    double *A, *U, *D, *X, *C;
+
+    //three full matrices
+    n  = bench_dim(fp,3.0,BENCH_LINAL_MAX_DIM);
+    n2 = n*n;
+    A  = bench_vec<double>(buf,0,n2);
+    X  = bench_vec<double>(buf,n2,n2);
+    C  = bench_vec<double>(buf,2*n2,n2);
+    const int m = (int) n;
+    const double f3 = 2.0*n*n2;
+    B.run(S,"linal_ABpC",l,n,32.0*n2,f3,false,[&]{linal_ABpC<double>(m,m,m,a,A,X,b,C);});
+    B.run(S,"linal_ATBpC",l,n,32.0*n2,f3,false,[&]{linal_ATBpC<double>(m,m,m,a,A,X,b,C);});
+    B.run(S,"linal_gemm",l,n,32.0*n2,f3,false,[&]{linal_gemm<double>(false,m,m,m,a,A,X,b,C);});
+    B.run(S,"linal_gemm_T",l,n,32.0*n2,f3,false,[&]{linal_gemm<double>(true,m,m,m,a,A,X,b,C);});
+    if (B.wants(S,"linal_strassen"))
+    {
+      const long nw = linal_strassen_work<double>(m,m,m,BENCH_LINAL_STRASSEN_MIN,LINAL_STRASSEN_LEVELS);
+      libj::core_arena<double> W(std::max(nw,1L));
+      B.run(S,"linal_strassen",l,n,32.0*n2,f3,false,
+            [&]{linal_strassen<double>(m,m,m,a,A,m,X,m,b,C,m,W,BENCH_LINAL_STRASSEN_MIN);});
+      bench_strassen_error(B,m);
+    }
+    B.run(S,"linal_par_ABpC",l,n,32.0*n2,f3,true,[&]{linal_par_ABpC<double>(m,m,m,a,A,X,b,C);});
+    B.run(S,"linal_par_ATBpC",l,n,32.0*n2,f3,true,[&]{linal_par_ATBpC<double>(m,m,m,a,A,X,b,C);});
+    B.run(S,"linal_ATBpU",l,n,24.0*n2,0.5*f3,false,[&]{linal_ATBpU<double>(m,m,m,a,A,X,b,C);});
+
+    //three full matrices and a diagonal
+    n  = bench_dim(fp,3.0,BENCH_LINAL_MAX_DIM);
+    n2 = n*n;
+    A  = bench_vec<double>(buf,0,n2);
+    X  = bench_vec<double>(buf,n2,n2);
+    D  = bench_vec<double>(buf,2*n2,n);
+    C  = bench_vec<double>(buf,2*n2+n,n2);
+    B.run(S,"linal_gemm_diag",l,n,32.0*n2,f3,false,
+          [&]{linal_gemm_diag<double>(false,(int) n,(int) n,(int) n,a,A,D,X,b,C);});
+
+    //an upper symmetric and two full matrices
+    n  = bench_dim(fp,2.5,BENCH_LINAL_MAX_DIM);
+    n2 = n*n;
+    nu = (n*(n+1))/2;
+    U  = bench_vec<double>(buf,0,nu);
+    A  = bench_vec<double>(buf,nu,n2);
+    C  = bench_vec<double>(buf,nu+n2,n2);
+    const double f2 = 2.0*n*n2;
+    B.run(S,"linal_UApB",l,n,8.0*(nu+3*n2),f2,false,[&]{linal_UApB<double>(n,n,a,U,A,b,C);});
+    B.run(S,"linal_ATUpB",l,n,8.0*(nu+3*n2),f2,false,[&]{linal_ATUpB<double>(n,n,a,A,U,b,C);});
+    B.run(S,"linal_gemm_usym",l,n,8.0*(nu+3*n2),f2,false,[&]{linal_gemm_usym<double>(n,n,a,U,A,b,C);});
+
+    //A.U.B, with C full, D diagonal, or Y upper
+    n  = bench_dim(fp,3.5,BENCH_LINAL_MAX_DIM);
+    n2 = n*n;
+    nu = (n*(n+1))/2;
+    A  = bench_vec<double>(buf,0,n2);
+    U  = bench_vec<double>(buf,n2,nu);
+    X  = bench_vec<double>(buf,n2+nu,n2);
+    C  = bench_vec<double>(buf,2*n2+nu,n2);
+    const double fu = 2.0*n*n2;
+    B.run(S,"linal_AUBpC",l,n,8.0*(nu+4*n2),2.0*fu,false,[&]{linal_AUBpC<double>(n,n,n,a,A,U,X,b,C);});
+    B.run(S,"linal_AUBpY",l,n,8.0*(3*nu+2*n2),1.5*fu,false,[&]{linal_AUBpY<double>(n,n,a,A,U,X,b,C);});
+    B.run(S,"linal_AUBpD",l,n,8.0*(nu+2*n2+2*n),fu,false,[&]{linal_AUBpD<double>(n,n,a,A,U,X,b,C);});
+
+    //A^T.A and A^T.D.A into an upper symmetric U
+    n  = bench_dim(fp,1.5,BENCH_LINAL_MAX_DIM);
+    n2 = n*n;
+    nu = (n*(n+1))/2;
+    A  = bench_vec<double>(buf,0,n2);
+    D  = bench_vec<double>(buf,n2,n);
+    U  = bench_vec<double>(buf,n2+n,nu);
+    const double fs = 1.0*n*n2;
+    B.run(S,"linal_ATApU",l,n,8.0*(n2+2*nu),fs,false,[&]{linal_ATApU<double>(n,n,a,A,b,U);});
+    B.run(S,"linal_par_ATApU",l,n,8.0*(n2+2*nu),fs,true,[&]{linal_par_ATApU<double>(n,n,a,A,b,U);});
+    B.run(S,"linal_ATDApU",l,n,8.0*(n2+n+2*nu),fs,false,[&]{linal_ATDApU<double>(n,n,A,a,D,b,U);});
+    B.run(S,"linal_par_ATDApU",l,n,8.0*(n2+n+2*nu),fs,true,[&]{linal_par_ATDApU<double>(n,n,A,a,D,b,U);});
+
+    //two full matrices, and a diagonal
+    n  = bench_dim(fp,2.0);
+    n2 = n*n;
+    A  = bench_vec<double>(buf,0,n2);
+    C  = bench_vec<double>(buf,n2,n2);
+    D  = bench_vec<double>(buf,2*n2,n);
+    B.run(S,"linal_ATpB",l,n,24.0*n2,2.0*n2,false,[&]{linal_ATpB<double>(n,n,a,A,b,C);});
+    B.run(S,"linal_DApB",l,n,8.0*(3*n2+n),2.0*n2,false,[&]{linal_DApB<double>(n,n,a,D,A,b,C);});
+    B.run(S,"linal_par_DApB",l,n,8.0*(3*n2+n),2.0*n2,true,[&]{linal_par_DApB<double>(n,n,a,D,A,b,C);});
+    B.run(S,"linal_DATpB",l,n,8.0*(3*n2+n),2.0*n2,false,[&]{linal_DATpB<double>(n,n,a,D,A,b,C);});
+    B.run(S,"linal_par_DATpB",l,n,8.0*(3*n2+n),2.0*n2,true,[&]{linal_par_DATpB<double>(n,n,a,D,A,b,C);});
+    B.run(S,"linal_diag_ABpC",l,n,8.0*(2*n2+2*n),2.0*n2,false,[&]{linal_diag_ABpC<double>(n,n,a,A,C,b,D);});
+
+    //matrix vector, through an upper symmetric U
+    n  = bench_dim(fp,1.5);
+    n2 = n*n;
+    nu = (n*(n+1))/2;
+    A  = bench_vec<double>(buf,0,n2);
+    U  = bench_vec<double>(buf,n2,nu);
+    X  = bench_vec<double>(buf,n2+nu,n);
+    C  = bench_vec<double>(buf,n2+nu+n,n);
+    B.run(S,"linal_AUxpy",l,n,8.0*(n2+nu+3*n),4.0*n2,false,[&]{linal_AUxpy<double>(n,n,a,A,U,X,b,C);});
+    B.run(S,"linal_ATUxpy",l,n,8.0*(n2+nu+3*n),4.0*n2,false,[&]{linal_ATUxpy<double>(n,n,a,A,U,X,b,C);});
+    B.run(S,"linal_usym2v",l,n,8.0*(n2+nu),0,false,[&]{linal_usym2v<double>(n,U,A);});
+    n  = bench_dim(fp,0.5);
+    nu = (n*(n+1))/2;
+    U  = bench_vec<double>(buf,0,nu);
+    X  = bench_vec<double>(buf,nu,n);
+    C  = bench_vec<double>(buf,nu+n,n);
+    B.run(S,"linal_Uxpy",l,n,8.0*(nu+3*n),2.0*n*n,false,[&]{linal_Uxpy<double>(n,a,U,X,b,C);});
+
+    //element wise
+    n = fp/24;
+    A = bench_vec<double>(buf,0,n);
+    X = bench_vec<double>(buf,n,n);
+    C = bench_vec<double>(buf,2*n,n);
+    B.run(S,"linal_vxv_small",l,n,24.0*n,n,false,[&]{linal_vxv_small<double>((int) n,A,X,C);});
+    n = fp/8;
+    A = bench_vec<double>(buf,0,n);
+    B.run(S,"linal_scal_small",l,n,16.0*n,n,false,[&]{linal_scal_small<double>((int) n,A,1.0-a);});
+
+    //batches of 3x3, the inverse is well conditioned
+    long nb = fp/(6*sizeof(double));
+    A = bench_vec<double>(buf,0,6*nb);
+    for (long i=0;i<nb;i++) {A[nb+i] = A[3*nb+i] = A[4*nb+i] = 0.1;}
+    B.run(S,"linal_usym3_invrt_batch",l,nb,96.0*nb,30.0*nb,false,[&]{linal_usym3_invrt_batch<double>(nb,A);});
+    nb = fp/(21*sizeof(double));
+    A = bench_vec<double>(buf,0,6*nb);
+    X = bench_vec<double>(buf,6*nb,9*nb);
+    C = bench_vec<double>(buf,15*nb,6*nb);
+    B.run(S,"linal_usym3_sqm3_MM_UP_batch",l,nb,168.0*nb,30.0*nb,false,
+          [&]{linal_usym3_sqm3_MM_UP_batch<double>(nb,A,X,C);});
+    X = bench_vec<double>(buf,6*nb,6*nb);
+    C = bench_vec<double>(buf,12*nb,9*nb);
+    B.run(S,"linal_usym3_usym3_MM_batch",l,nb,168.0*nb,45.0*nb,false,
+          [&]{linal_usym3_usym3_MM_batch<double>(nb,A,X,C);});
+    nb = fp/(24*sizeof(double));
+    A = bench_vec<double>(buf,0,9*nb);
+    X = bench_vec<double>(buf,9*nb,9*nb);
+    C = bench_vec<double>(buf,18*nb,6*nb);
+    B.run(S,"linal_MTM_UP_batch",l,nb,240.0*nb,36.0*nb,false,
+          [&]{linal_MTM_UP_batch<double>(nb,3,3,3,a,A,X,b,C);});
+  }
+}
+
+}//end libj namespace
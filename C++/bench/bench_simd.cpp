@@ -0,0 +1,182 @@
+/*--------------------------------------------------------------------------
+  bench_simd.cpp
+	JHT, October 14, 2026 : created
+
+  The simd suite of bench.exe : the unaligned simd_* kernels of simd.hpp,
+  on doubles, plus the mixed precision (float data, double accumulation),
+  complex<double>, and runtime dispatched versions.
+
+  The vectors of each entry are cut from one buffer of the working set of
+  the level, and are set to one before each entry so the repeated calls
+  neither overflow nor go denormal. Strided entries use a stride of 2, and
+  count the whole lines they touch. The gather and scatter entries use a
+  random permutation, so every access is to a different line.
+--------------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <algorithm>
+#include <complex>
+#include <vector>
+#include "simd.hpp"
+#include "simd_dispatch.hpp"
+#include "bench.hpp"
+
+namespace libj
+{
+
+//--------------------------------------------------------------------------
+// bench_simd
+//--------------------------------------------------------------------------
+void bench_simd(libj::BENCH& B)
+{
+  typedef std::complex<double> zdouble;
+  const char* S = "simd";
+  const double a = 1.0e-8, b = 0.5;
+  const zdouble za(1.0e-8,1.0e-8);
+
+  for (int l=0;l<BENCH_NLEVEL;l++)
+  {
+    const long fp = (long) B.footprint(l);
+    if (fp == 0) continue;
+    std::vector<double> buf(fp/sizeof(double) + 8);
+    long n;
+    double *w, *x, *y, *z;
+
+    //one vector read
+    n = fp/8;
+    x = bench_vec<double>(buf,0,n);
+    B.run(S,"simd_reduction_add",l,n,8.0*n,n,false,[&]{B.keep(simd_reduction_add<double>(n,x));});
+    B.run(S,"simd_reduction_sub",l,n,8.0*n,n,false,[&]{B.keep(simd_reduction_sub<double>(n,x));});
+    B.run(S,"simd_reduction_add_pairwise",l,n,8.0*n,n,false,[&]{B.keep(simd_reduction_add_pairwise<double>(n,x));});
+    B.run(S,"simd_reduction_add_kahan",l,n,8.0*n,n,false,[&]{B.keep(simd_reduction_add_kahan<double>(n,x));});
+    B.run(S,"simd_par_reduction_add",l,n,8.0*n,n,true,[&]{B.keep(simd_par_reduction_add<double>(n,x));});
+    B.run(S,"simd_dispatch_reduction_add",l,n,8.0*n,n,false,[&]{B.keep(simd_dispatch_reduction_add<double>(n,x));});
+    B.run(S,"simd_loc",l,n,8.0*n,0,false,[&]{B.keep(simd_loc<double>(n,-1.0,x));});
+    B.run(S,"simd_iamax",l,n,8.0*n,0,false,[&]{B.keep(simd_iamax<double>(n,x));});
+    B.run(S,"simd_iamin",l,n,8.0*n,0,false,[&]{B.keep(simd_iamin<double>(n,x));});
+
+    //one vector written
+    B.run(S,"simd_zero",l,n,8.0*n,0,false,[&]{simd_zero<double>(n,x);});
+    B.run(S,"simd_zero_stream",l,n,8.0*n,0,false,[&]{simd_zero_stream<double>(n,x);});
+    B.run(S,"simd_par_zero",l,n,8.0*n,0,true,[&]{simd_par_zero<double>(n,x);});
+    B.run(S,"simd_dispatch_zero",l,n,8.0*n,0,false,[&]{simd_dispatch_zero<double>(n,x);});
+    B.run(S,"simd_scal_set",l,n,8.0*n,0,false,[&]{simd_scal_set<double>(n,b,x);});
+    B.run(S,"simd_scal_set_stream",l,n,8.0*n,0,false,[&]{simd_scal_set_stream<double>(n,b,x);});
+    B.run(S,"simd_par_scal_set",l,n,8.0*n,0,true,[&]{simd_par_scal_set<double>(n,b,x);});
+
+    //one vector read and written
+    x = bench_vec<double>(buf,0,n);
+    B.run(S,"simd_scal_add",l,n,16.0*n,n,false,[&]{simd_scal_add<double>(n,a,x);});
+    x = bench_vec<double>(buf,0,n);
+    B.run(S,"simd_scal_mul",l,n,16.0*n,n,false,[&]{simd_scal_mul<double>(n,1.0-a,x);});
+    x = bench_vec<double>(buf,0,n);
+    B.run(S,"simd_par_scal_mul",l,n,16.0*n,n,true,[&]{simd_par_scal_mul<double>(n,1.0-a,x);});
+    x = bench_vec<double>(buf,0,n);
+    B.run(S,"simd_dispatch_scal_mul",l,n,16.0*n,n,false,[&]{simd_dispatch_scal_mul<double>(n,1.0-a,x);});
+
+    //two vectors read
+    n = fp/16;
+    x = bench_vec<double>(buf,0,n);
+    y = bench_vec<double>(buf,n,n);
+    B.run(S,"simd_dot",l,n,16.0*n,2.0*n,false,[&]{B.keep(simd_dot<double>(n,x,y));});
+    B.run(S,"simd_dot_pairwise",l,n,16.0*n,2.0*n,false,[&]{B.keep(simd_dot_pairwise<double>(n,x,y));});
+    B.run(S,"simd_dot_kahan",l,n,16.0*n,2.0*n,false,[&]{B.keep(simd_dot_kahan<double>(n,x,y));});
+    B.run(S,"simd_par_dot",l,n,16.0*n,2.0*n,true,[&]{B.keep(simd_par_dot<double>(n,x,y));});
+    B.run(S,"simd_dispatch_dot",l,n,16.0*n,2.0*n,false,[&]{B.keep(simd_dispatch_dot<double>(n,x,y));});
+
+    //one vector read, one written
+    B.run(S,"simd_copy",l,n,16.0*n,0,false,[&]{simd_copy<double>(n,x,y);});
+    B.run(S,"simd_copy_stream",l,n,16.0*n,0,false,[&]{simd_copy_stream<double>(n,x,y);});
+    B.run(S,"simd_par_copy",l,n,16.0*n,0,true,[&]{simd_par_copy<double>(n,x,y);});
+    B.run(S,"simd_dispatch_copy",l,n,16.0*n,0,false,[&]{simd_dispatch_copy<double>(n,x,y);});
+    B.run(S,"simd_scal_copy",l,n,16.0*n,n,false,[&]{simd_scal_copy<double>(n,b,x,y);});
+
+    //one vector read, one read and written
+    y = bench_vec<double>(buf,n,n);
+    B.run(S,"simd_axpy",l,n,24.0*n,2.0*n,false,[&]{simd_axpy<double>(n,a,x,y);});
+    B.run(S,"simd_par_axpy",l,n,24.0*n,2.0*n,true,[&]{simd_par_axpy<double>(n,a,x,y);});
+    B.run(S,"simd_dispatch_axpy",l,n,24.0*n,2.0*n,false,[&]{simd_dispatch_axpy<double>(n,a,x,y);});
+    B.run(S,"simd_axpby",l,n,24.0*n,3.0*n,false,[&]{simd_axpby<double>(n,a,x,b,y);});
+    B.run(S,"simd_par_axpby",l,n,24.0*n,3.0*n,true,[&]{simd_par_axpby<double>(n,a,x,b,y);});
+    y = bench_vec<double>(buf,n,n);
+    B.run(S,"simd_raxmy",l,n,24.0*n,2.0*n,false,[&]{simd_raxmy<double>(n,1.0,x,y);});
+
+    //three vectors
+    n = fp/24;
+    w = bench_vec<double>(buf,0,n);
+    x = bench_vec<double>(buf,n,n);
+    y = bench_vec<double>(buf,2*n,n);
+    B.run(S,"simd_elemwise_add",l,n,24.0*n,n,false,[&]{simd_elemwise_add<double>(n,w,x,y);});
+    B.run(S,"simd_elemwise_mul",l,n,24.0*n,n,false,[&]{simd_elemwise_mul<double>(n,w,x,y);});
+    B.run(S,"simd_elemwise_mul_reduce",l,n,24.0*n,2.0*n,false,[&]{B.keep(simd_elemwise_mul_reduce<double>(n,w,x,y));});
+    y = bench_vec<double>(buf,2*n,n);
+    B.run(S,"simd_dotwxy",l,n,24.0*n,3.0*n,false,[&]{B.keep(simd_dotwxy<double>(n,w,x,y));});
+    B.run(S,"simd_awxpy",l,n,32.0*n,3.0*n,false,[&]{simd_awxpy<double>(n,a,w,x,y);});
+    B.run(S,"simd_axpy_dot",l,n,32.0*n,4.0*n,false,[&]{B.keep(simd_axpy_dot<double>(n,a,w,y,x));});
+
+    //four vectors
+    n = fp/32;
+    w = bench_vec<double>(buf,0,n);
+    x = bench_vec<double>(buf,n,n);
+    y = bench_vec<double>(buf,2*n,n);
+    z = bench_vec<double>(buf,3*n,n);
+    B.run(S,"simd_wxy_mul",l,n,32.0*n,2.0*n,false,[&]{simd_wxy_mul<double>(n,w,x,y,z);});
+
+    //stride 2, whole lines are moved
+    n = fp/32;
+    x = bench_vec<double>(buf,0,2*n);
+    y = bench_vec<double>(buf,2*n,2*n);
+    B.run(S,"simd_dot_strided",l,n,32.0*n,2.0*n,false,[&]{B.keep(simd_dot_strided<double>(n,x,2,y,2));});
+    B.run(S,"simd_copy_strided",l,n,32.0*n,0,false,[&]{simd_copy_strided<double>(n,x,2,y,2);});
+    B.run(S,"simd_axpy_strided",l,n,48.0*n,2.0*n,false,[&]{simd_axpy_strided<double>(n,a,x,2,y,2);});
+    n = fp/16;
+    x = bench_vec<double>(buf,0,2*n);
+    B.run(S,"simd_scal_mul_strided",l,n,32.0*n,n,false,[&]{simd_scal_mul_strided<double>(n,1.0-a,x,2);});
+    B.run(S,"simd_zero_strided",l,n,16.0*n,0,false,[&]{simd_zero_strided<double>(n,x,2);});
+
+    //gather and scatter through a random permutation
+    n = fp/24;
+    x = bench_vec<double>(buf,0,n);
+    y = bench_vec<double>(buf,n,n);
+    std::vector<long> idx(n);
+    for (long i=0;i<n;i++) {idx[i] = i;}
+    srand(7);
+    for (long i=n-1;i>0;i--) {std::swap(idx[i],idx[rand() % (i+1)]);}
+    const long* pidx = idx.data();
+    B.run(S,"simd_gather_dot",l,n,24.0*n,2.0*n,false,[&]{B.keep(simd_gather_dot<double>(n,x,pidx,y));});
+    B.run(S,"simd_gather_copy",l,n,24.0*n,0,false,[&]{simd_gather_copy<double>(n,x,pidx,y);});
+    B.run(S,"simd_scatter_copy",l,n,24.0*n,0,false,[&]{simd_scatter_copy<double>(n,x,y,pidx);});
+    B.run(S,"simd_gather_axpy",l,n,32.0*n,2.0*n,false,[&]{simd_gather_axpy<double>(n,a,x,pidx,y);});
+    B.run(S,"simd_scatter_axpy",l,n,32.0*n,2.0*n,false,[&]{simd_scatter_axpy<double>(n,a,x,y,pidx);});
+    idx.clear();
+
+    //mixed precision
+    n = fp/4;
+    float* fx = bench_vec<float>(buf,0,n);
+    B.run(S,"simd_reduction_add_acc",l,n,4.0*n,n,false,[&]{B.keep(simd_reduction_add_acc<float,double>(n,fx));});
+    n = fp/8;
+    fx = bench_vec<float>(buf,0,n);
+    float* fy = bench_vec<float>(buf,n,n);
+    B.run(S,"simd_dot_acc",l,n,8.0*n,2.0*n,false,[&]{B.keep(simd_dot_acc<float,double>(n,fx,fy));});
+    B.run(S,"simd_axpy_acc",l,n,12.0*n,2.0*n,false,[&]{simd_axpy_acc<float,double>(n,a,fx,fy);});
+    n = fp/12;
+    x = bench_vec<double>(buf,0,n);
+    fy = reinterpret_cast<float*>(x + n);
+    B.run(S,"simd_convert_double_float",l,n,12.0*n,0,false,[&]{simd_convert<double,float>(n,x,fy);});
+    B.run(S,"simd_convert_float_double",l,n,12.0*n,0,false,[&]{simd_convert<float,double>(n,fy,x);});
+
+    //complex, 8 flops per multiply add, 6 per multiply
+    n = fp/32;
+    zdouble* zx = bench_vec<zdouble>(buf,0,n);
+    zdouble* zy = bench_vec<zdouble>(buf,n,n);
+    B.run(S,"simd_dot_complex",l,n,32.0*n,8.0*n,false,[&]{B.keep(simd_dot<zdouble>(n,zx,zy).real());});
+    B.run(S,"simd_dotc_complex",l,n,32.0*n,8.0*n,false,[&]{B.keep(simd_dotc<zdouble>(n,zx,zy).real());});
+    B.run(S,"simd_copy_complex",l,n,32.0*n,0,false,[&]{simd_copy<zdouble>(n,zx,zy);});
+    B.run(S,"simd_axpy_complex",l,n,48.0*n,8.0*n,false,[&]{simd_axpy<zdouble>(n,za,zx,zy);});
+    n = fp/16;
+    zx = bench_vec<zdouble>(buf,0,n);
+    B.run(S,"simd_scal_mul_complex",l,n,32.0*n,6.0*n,false,[&]{simd_scal_mul<zdouble>(n,zdouble(1.0-a,0.0),zx);});
+    B.run(S,"simd_zero_complex",l,n,16.0*n,0,false,[&]{simd_zero<zdouble>(n,zx);});
+  }
+}
+
+}//end libj namespace
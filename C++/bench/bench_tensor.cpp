@@ -0,0 +1,262 @@
+/*--------------------------------------------------------------------------
+  bench_tensor.cpp
+	JHT, October 14, 2026 : created
+
+  The tensor suite of bench.exe : the element access paths of the
+  tensors, for ranks 2 to 6, so the cost of each is known (see the
+  ns_per_elm column) before it is optimized. Each entry sums every
+  element of a q x q x ... x q double tensor of the working set of the
+  level through one path, in storage order
+
+    linear          A[i], the floor for all of them
+    op_r<R>         A(i,j,k,...), the variadic operator()
+    vec_r<R>        A(idx), with idx a std::vector<size_t>
+    offset_r<R>     A[A.offset(idx)]
+    tmat_r<R>       tensor_matrix2 M(I,J), the first R/2 (rounded up)
+                    dimensions as rows, the others as columns
+    tmat_tab_r<R>   the same, after M.make_tables()
+    bsm_r<R>        block_scatter_matrix2 S(I,J), 8x8 blocks
+
+  The vec and offset entries count up idx as an odometer, which is what
+  a caller of those paths has to do. The sizes of a block_scatter_matrix2
+  are template parameters, so the bsm entries are of 32 x 32 matrices
+  (1024 elements, e.g. 2x4x4 x 4x8 for rank 5), and only run at L1.
+--------------------------------------------------------------------------*/
+#include <math.h>
+#include <vector>
+#include "tensor.hpp"
+#include "tensor_matrix2.hpp"
+#include "block_scatter_matrix2.hpp"
+#include "bench.hpp"
+
+#define BENCH_BSM_N 32
+#define BENCH_BSM_BL 8
+
+namespace libj
+{
+
+//--------------------------------------------------------------------------
+// operator() of each rank, first index fastest
+//--------------------------------------------------------------------------
+static double bench_op2(const libj::tensor<double>& A)
+{
+  const size_t n0 = A.size(0), n1 = A.size(1);
+  double sum = 0.0;
+  for (size_t i1=0;i1<n1;i1++)
+    for (size_t i0=0;i0<n0;i0++) sum += A(i0,i1);
+  return sum;
+}
+
+static double bench_op3(const libj::tensor<double>& A)
+{
+  const size_t n0 = A.size(0), n1 = A.size(1), n2 = A.size(2);
+  double sum = 0.0;
+  for (size_t i2=0;i2<n2;i2++)
+    for (size_t i1=0;i1<n1;i1++)
+      for (size_t i0=0;i0<n0;i0++) sum += A(i0,i1,i2);
+  return sum;
+}
+
+static double bench_op4(const libj::tensor<double>& A)
+{
+  const size_t n0 = A.size(0), n1 = A.size(1), n2 = A.size(2), n3 = A.size(3);
+  double sum = 0.0;
+  for (size_t i3=0;i3<n3;i3++)
+    for (size_t i2=0;i2<n2;i2++)
+      for (size_t i1=0;i1<n1;i1++)
+        for (size_t i0=0;i0<n0;i0++) sum += A(i0,i1,i2,i3);
+  return sum;
+}
+
+static double bench_op5(const libj::tensor<double>& A)
+{
+  const size_t n0 = A.size(0), n1 = A.size(1), n2 = A.size(2), n3 = A.size(3);
+  const size_t n4 = A.size(4);
+  double sum = 0.0;
+  for (size_t i4=0;i4<n4;i4++)
+    for (size_t i3=0;i3<n3;i3++)
+      for (size_t i2=0;i2<n2;i2++)
+        for (size_t i1=0;i1<n1;i1++)
+          for (size_t i0=0;i0<n0;i0++) sum += A(i0,i1,i2,i3,i4);
+  return sum;
+}
+
+static double bench_op6(const libj::tensor<double>& A)
+{
+  const size_t n0 = A.size(0), n1 = A.size(1), n2 = A.size(2), n3 = A.size(3);
+  const size_t n4 = A.size(4), n5 = A.size(5);
+  double sum = 0.0;
+  for (size_t i5=0;i5<n5;i5++)
+    for (size_t i4=0;i4<n4;i4++)
+      for (size_t i3=0;i3<n3;i3++)
+        for (size_t i2=0;i2<n2;i2++)
+          for (size_t i1=0;i1<n1;i1++)
+            for (size_t i0=0;i0<n0;i0++) sum += A(i0,i1,i2,i3,i4,i5);
+  return sum;
+}
+
+static double bench_op(const libj::tensor<double>& A)
+{
+  switch (A.dim())
+  {
+    case 2: return bench_op2(A);
+    case 3: return bench_op3(A);
+    case 4: return bench_op4(A);
+    case 5: return bench_op5(A);
+    case 6: return bench_op6(A);
+  }
+  return 0.0;
+}
+
+//--------------------------------------------------------------------------
+// bench_next
+//	count idx up as an odometer over the lengths of A, false at the end
+//--------------------------------------------------------------------------
+static inline bool bench_next(const libj::tensor<double>& A, std::vector<size_t>& idx)
+{
+  for (size_t d=0;d<idx.size();d++)
+  {
+    if (++idx[d] < A.size(d)) return true;
+    idx[d] = 0;
+  }
+  return false;
+}
+
+//--------------------------------------------------------------------------
+// bench_tmat
+//	the tmat and tmat_tab entries of A, or its bsm entry
+//--------------------------------------------------------------------------
+template <size_t NLHS, size_t NRHS>
+static void bench_tmat(libj::BENCH& B, const int level, libj::tensor<double>& A,
+                       const std::string& lhs, const std::string& rhs, const bool bsm)
+{
+  const char* S = "tensor";
+  const long n = (long) A.size();
+  const int r = (int) A.dim();
+  char name[32];
+
+  libj::tensor_matrix2<double,NLHS,NRHS> M;
+  M.assign(A,lhs,rhs);
+  const size_t nI = M.size(0), nJ = M.size(1);
+  auto sum_tmat = [&]
+  {
+    double sum = 0.0;
+    for (size_t J=0;J<nJ;J++)
+      for (size_t I=0;I<nI;I++) sum += M(I,J);
+    B.keep(sum);
+  };
+
+  if (bsm)
+  {
+    libj::block_scatter_matrix2<double,BENCH_BSM_N,BENCH_BSM_N,BENCH_BSM_BL,BENCH_BSM_BL> SM(M);
+    snprintf(name,sizeof(name),"bsm_r%d",r);
+    B.run(S,name,level,n,8.0*n,n,false,[&]
+    {
+      double sum = 0.0;
+      for (size_t J=0;J<BENCH_BSM_N;J++)
+        for (size_t I=0;I<BENCH_BSM_N;I++) sum += SM(I,J);
+      B.keep(sum);
+    });
+    return;
+  }
+
+  snprintf(name,sizeof(name),"tmat_r%d",r);
+  B.run(S,name,level,n,8.0*n,n,false,sum_tmat);
+
+  M.make_tables();
+  snprintf(name,sizeof(name),"tmat_tab_r%d",r);
+  B.run(S,name,level,n,8.0*n,n,false,sum_tmat);
+}
+
+//--------------------------------------------------------------------------
+// bench_matrices
+//	bench_tmat of A, split into rows and cols in the middle
+//--------------------------------------------------------------------------
+static void bench_matrices(libj::BENCH& B, const int level, libj::tensor<double>& A,
+                           const bool bsm)
+{
+  switch (A.dim())
+  {
+    case 2: bench_tmat<1,1>(B,level,A,"a","b",bsm); break;
+    case 3: bench_tmat<2,1>(B,level,A,"ab","c",bsm); break;
+    case 4: bench_tmat<2,2>(B,level,A,"ab","cd",bsm); break;
+    case 5: bench_tmat<3,2>(B,level,A,"abc","de",bsm); break;
+    case 6: bench_tmat<3,3>(B,level,A,"abc","def",bsm); break;
+  }
+}
+
+//--------------------------------------------------------------------------
+// bench_tensor
+//--------------------------------------------------------------------------
+void bench_tensor(libj::BENCH& B)
+{
+  const char* S = "tensor";
+  char name[32];
+
+  for (int l=0;l<BENCH_NLEVEL;l++)
+  {
+    const long fp = (long) B.footprint(l);
+    if (fp == 0) continue;
+    std::vector<double> buf(fp/sizeof(double) + 8);
+
+    const long nl = fp/8;
+    double* ptr = bench_vec<double>(buf,0,nl);
+    B.run(S,"linear",l,nl,8.0*nl,nl,false,[&]
+    {
+      double sum = 0.0;
+      for (long i=0;i<nl;i++) sum += ptr[i];
+      B.keep(sum);
+    });
+
+    for (int r=2;r<=6;r++)
+    {
+      size_t q = (size_t) pow(fp/8.0,1.0/r);
+      if (q < 2) q = 2;
+      std::vector<size_t> lengths(r,q);
+      size_t n = 1;
+      for (int d=0;d<r;d++) n *= q;
+      if ((long) n > nl) continue;
+
+      libj::tensor<double> A;
+      A.assign(bench_vec<double>(buf,0,n),lengths);
+
+      snprintf(name,sizeof(name),"op_r%d",r);
+      B.run(S,name,l,n,8.0*n,n,false,[&]{B.keep(bench_op(A));});
+
+      snprintf(name,sizeof(name),"vec_r%d",r);
+      B.run(S,name,l,n,8.0*n,n,false,[&]
+      {
+        std::vector<size_t> idx(r,0);
+        double sum = 0.0;
+        do {sum += A(idx);} while (bench_next(A,idx));
+        B.keep(sum);
+      });
+
+      snprintf(name,sizeof(name),"offset_r%d",r);
+      B.run(S,name,l,n,8.0*n,n,false,[&]
+      {
+        std::vector<size_t> idx(r,0);
+        double sum = 0.0;
+        do {sum += A[A.offset(idx)];} while (bench_next(A,idx));
+        B.keep(sum);
+      });
+
+      bench_matrices(B,l,A,false);
+    }
+
+    //32 x 32 tensors for block_scatter_matrix2, in L1
+    if (l != BENCH_L1) continue;
+    const size_t shapes[5][6] = {{32,32},{4,8,32},{4,8,4,8},{2,4,4,4,8},{2,4,4,2,4,4}};
+    for (int r=2;r<=6;r++)
+    {
+      std::vector<size_t> lengths(shapes[r-2],shapes[r-2]+r);
+      const long n = BENCH_BSM_N*BENCH_BSM_N;
+      if (n > nl) break;
+      libj::tensor<double> A;
+      A.assign(bench_vec<double>(buf,0,n),lengths);
+      bench_matrices(B,l,A,true);
+    }
+  }
+}
+
+}//end libj namespace
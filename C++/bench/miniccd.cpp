@@ -0,0 +1,369 @@
+/*--------------------------------------------------------------------------
+  miniccd.cpp
+	JHT, October 14, 2026 : created
+
+  miniccd.exe, a mini-app of the shape of a CCD iteration (make miniccd),
+  so that an upgrade of libj is seen on the mix of io, communication, and
+  compute of the real codes, which the kernel timings of bench.exe and
+  perftest.exe do not show. The numbers are not a CCD : the integrals are
+  random (from a hash of their position, so they do not depend on the
+  number of tasks), and only the shape of the equations is kept,
+
+    R(a,b,i,j) = V(a,b,j,i)
+               + 1/2 sum_cd  Vvvvv(a,b,c,d) T(c,d,j,i)   particle ladder
+               + sum_ck      T(a,c,k,i) Wovvo(c,k,b,j)  ring
+               + 1/2 sum_kl  T(a,b,l,k) Woooo(l,j,k,i)  hole ladder
+    T(a,b,j,i) = P(ab) R(a,b,j,i) / (e_i + e_j - e_a - e_b)
+
+  with P(ab) the average over a <-> b. The scales of the integrals are
+  picked so that it converges.
+
+  Data
+  -------------------
+  T2 (and the next T2) are Pdata lists with one index per occupied i,
+  T_i(a,b,j), distributed over the tasks (distribute, make_window). The
+  Vvvvv integrals are the out-of-core part, a Pdata list with one index
+  per d, Vd(a,b,c), in a Pfile file of each task, read through the block
+  cache (pin, with a prefetch of the next d). The cache is --cache MB of
+  each task, a quarter of Vvvvv by default, so most of it is read from
+  the file for each i. V, Wovvo, and Woooo are in the memory of each task.
+
+  Iteration
+  -------------------
+  A Para::task_loop over i, each Jacobi step reads the T2 list and puts
+  into the next one, which are swapped after the loop. The phases timed
+  in each task are
+
+    get            Pdata::get of T_i and the T_k of the hole ladder
+    permute        T_i(c,d,j) -> (c,j,d), and P(ab) (permute_sum)
+    io             Pdata::pin of the Vd, the wait for the file
+    contract_pp    particle ladder, one contract per d
+    contract_ring  ring, one contract
+    contract_hh    hole ladder, one contract per k
+    denom          the denominator (denom), the energy and the residual
+    put            Pdata::put of the new T_i
+    sync           the rest of the iteration, the wait for the other
+                   tasks at the end of task_loop and the allreduce
+
+  The time of each iteration is that of the master (the tasks are in step
+  after the allreduce), and the phases are the totals over the iterations,
+  with the min, average, and max over the tasks.
+
+  Every task does its own io (io aggregator), so the Vvvvv file is written
+  once by each task, (nv^4 doubles), in the working directory or --scratch.
+  It is erased at the end.
+
+  Usage
+  -------------------
+  mpirun -np ranks miniccd.exe [--no n] [--nv n] [--iter n] [--cache MB]
+                               [--scratch dir]
+
+    --no       occupied orbitals, 8 by default
+    --nv       virtual orbitals, 48 by default
+    --iter     iterations, 5 by default
+    --cache    MB of the block cache of each task, a quarter of Vvvvv
+               (and at least two Vd) by default
+    --scratch  directory of the Vvvvv files
+--------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <omp.h>
+#include "tensor.hpp"
+#include "jblis.hpp"
+#include "para.hpp"
+#include "timer.hpp"
+
+#define MINICCD_NO          8
+#define MINICCD_NV          48
+#define MINICCD_ITER        5
+#define MINICCD_IO_PER_NODE (1 << 20)	//capped at the tasks of the node
+#define MINICCD_TAG_T2      1
+#define MINICCD_TAG_VVVV    3
+
+namespace libj
+{
+
+enum miniccd_phase
+{
+  MINICCD_GET,
+  MINICCD_PERMUTE,
+  MINICCD_IO,
+  MINICCD_PP,
+  MINICCD_RING,
+  MINICCD_HH,
+  MINICCD_DENOM,
+  MINICCD_PUT,
+  MINICCD_SYNC,
+  MINICCD_NPHASE
+};
+
+static const char* miniccd_names[MINICCD_NPHASE] =
+{
+  "get","permute","io","contract_pp","contract_ring","contract_hh","denom",
+  "put","sync"
+};
+
+//--------------------------------------------------------------------------
+// miniccd_fill
+//	A[n] = scale * u, u in [-1,1) from a hash (splitmix64) of seed and
+//	offset + n, the position of the element in the whole tensor
+//--------------------------------------------------------------------------
+static void miniccd_fill(libj::tensor<double>& A, const uint64_t seed,
+                         const size_t offset, const double scale)
+{
+  double* AP = A.data();
+  const long N = (long) A.size();
+  #pragma omp parallel for schedule(static)
+  for (long n=0;n<N;n++)
+  {
+    uint64_t z = seed*0x9E3779B97F4A7C15ULL + (uint64_t) (offset + n);
+    z = (z ^ (z >> 30))*0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27))*0x94D049BB133111EBULL;
+    z = z ^ (z >> 31);
+    AP[n] = scale*((double) (z >> 11)*(2.0/9007199254740992.0) - 1.0);
+  }
+}
+
+}//end libj namespace
+
+//--------------------------------------------------------------------------
+// main
+//--------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  size_t no = MINICCD_NO;
+  size_t nv = MINICCD_NV;
+  int    niter = MINICCD_ITER;
+  double cache_mb = -1.0;
+  std::string scratch;
+  for (int i=1;i<argc;i++)
+  {
+    const bool more = (i+1 < argc);
+    if (strcmp(argv[i],"--no") == 0 && more) {no = (size_t) atol(argv[++i]);}
+    else if (strcmp(argv[i],"--nv") == 0 && more) {nv = (size_t) atol(argv[++i]);}
+    else if (strcmp(argv[i],"--iter") == 0 && more) {niter = atoi(argv[++i]);}
+    else if (strcmp(argv[i],"--cache") == 0 && more) {cache_mb = atof(argv[++i]);}
+    else if (strcmp(argv[i],"--scratch") == 0 && more) {scratch = argv[++i];}
+    else
+    {
+      printf("ERROR libj::miniccd unknown option %s\n",argv[i]);
+      printf("usage : miniccd.exe [--no n] [--nv n] [--iter n] [--cache MB] "
+             "[--scratch dir]\n");
+      return 1;
+    }
+  }
+  if (no == 0 || nv == 0 || niter <= 0)
+  {
+    printf("ERROR libj::miniccd --no, --nv, and --iter must be positive\n");
+    return 1;
+  }
+
+  Para para;
+  if (para.init(PWORLD_THREAD_FUNNELED,MINICCD_IO_PER_NODE) != 0) {return 1;}
+  Pworld& pworld = para.pworld;
+  Pdata&  pdata  = para.pdata;
+  Pfile&  pfile  = para.pfile;
+  const bool master = pworld.mpi_world_ismaster;
+  if (!pworld.mpi_doesIO)
+  {
+    printf("ERROR libj::miniccd task %d does not do its own io\n",pworld.mpi_world_task_id);
+    para.error(1);
+  }
+
+  Timer tsetup;
+  const size_t nt2  = nv*nv*no;			//T_i(a,b,j)
+  const size_t nvd  = nv*nv*nv;			//Vd(a,b,c)
+  const long   vd_bytes = (long) (nvd*sizeof(double));
+  const long   vvvv_bytes = vd_bytes*(long) nv;
+  long cache_bytes = (cache_mb > 0.0) ? (long) (cache_mb*1048576.0) : vvvv_bytes/4;
+  cache_bytes = std::max(cache_bytes,2*vd_bytes);
+
+  //orbital energies
+  std::vector<double> eo(no), ev(nv);
+  for (size_t i=0;i<no;i++) {eo[i] = -3.0 + (double) i/(double) no;}
+  for (size_t a=0;a<nv;a++) {ev[a] = 1.0 + (double) a/(double) nv;}
+
+  //in core integrals
+  libj::tensor<double> V(nv,nv,no,no), Wr(nv,no,nv,no), W(no,no,no,no);
+  libj::miniccd_fill(V,1,0,1.0);
+  libj::miniccd_fill(Wr,2,0,1.0/sqrt((double) (no*nv)));
+  libj::miniccd_fill(W,3,0,1.0/(double) no);
+
+  //out of core Vvvvv, a file of each task
+  if (!scratch.empty() && para.file_add_scratch(scratch.c_str()) != 0) {para.error(1);}
+  const int fid = para.file_add("miniccd_vvvv",vvvv_bytes);
+  if (fid < 0 || para.file_open(fid,"w+b") != 0)
+  {
+    printf("ERROR libj::miniccd could not open the Vvvvv file\n");
+    para.error(1);
+  }
+  const long list_v = pdata.add_list(MINICCD_TAG_VVVV,fid,sizeof(double));
+  for (size_t d=0;d<nv;d++)
+  {
+    pdata.add_index(list_v,pworld.mpi_world_task_id,(long) d*vd_bytes,(long) nvd);
+  }
+  {
+    libj::tensor<double> Vd(nv,nv,nv);
+    for (size_t d=0;d<nv;d++)
+    {
+      libj::miniccd_fill(Vd,4,d*nvd,1.0/(double) nv);
+      if (pdata.write_index(pfile,list_v,(long) d,Vd.data()) != 0) {para.error(1);}
+    }
+  }
+  pfile.flush(pworld,fid);
+  pdata.cache_init(pworld,cache_bytes,true);
+
+  //distributed T2, this iteration and the next
+  long list_t[2];
+  for (int l=0;l<2;l++)
+  {
+    list_t[l] = pdata.add_list(MINICCD_TAG_T2+l,fid,sizeof(double));
+    for (size_t i=0;i<no;i++) {pdata.add_index(list_t[l],0,0,(long) nt2);}
+    if (pdata.distribute(pworld,list_t[l]) != 0 || pdata.make_window(pworld,list_t[l]) != 0)
+    {
+      para.error(1);
+    }
+  }
+
+  //MP2 guess
+  for (size_t i=0;i<no;i++)
+  {
+    double* TP = (double*) pdata.local(pworld,list_t[0],(long) i);
+    if (TP == NULL) continue;
+    libj::tensor<double> Vi(V.data()+i*nt2,nv,nv,no), Ti(TP,nv,nv,no);
+    libj::copy<double>(Vi,Ti);
+    libj::denom<double>(Ti,{ev.data(),ev.data(),eo.data()},{-1.0,-1.0,1.0},true,eo[i]);
+  }
+  #if defined LIBJ_MPI
+    MPI_Barrier(pworld.comm_world);
+  #endif
+  const double setup_time = tsetup.elapsed();
+
+  if (master)
+  {
+    printf("miniccd no %zu nv %zu, %d tasks of %d threads\n",no,nv,
+           pworld.mpi_world_num_tasks,omp_get_max_threads());
+    printf("  T2 %.1f MB, Vvvvv %.1f MB of each task, cache %.1f MB\n",
+           2.0*(double) (nt2*no*sizeof(double))/1048576.0,(double) vvvv_bytes/1048576.0,
+           (double) cache_bytes/1048576.0);
+    printf("  setup %.3f s\n\n",setup_time);
+    printf("  iter     seconds            energy        residual\n");
+  }
+
+  //iterations
+  std::vector<double> phase(libj::MINICCD_NPHASE,0.0);
+  std::vector<double> iter_time;
+  libj::tensor<double> Ti(nv,nv,no), Tp(nv,no,nv), Tk(nv,nv,no), R(nv,nv,no), S(nv,nv,no);
+  libj::tensor<double> Vd, Td, Wki;
+  int cur = 0;
+  for (int iter=0;iter<niter;iter++)
+  {
+    Timer titer, tick;
+    double work = 0.0;
+    auto lap = [&](const int p) {const double t = tick.elapsed(); phase[p] += t; work += t; tick.reset();};
+    libj::tensor<double> sums(2);
+    libj::zero<double>(sums);
+
+    para.task_loop(list_t[cur],[&](const long index)
+    {
+      const size_t i = (size_t) index;
+      tick.reset();
+      if (pdata.get(list_t[cur],index,Ti.data()) != 0) {para.error(1);}
+      lap(libj::MINICCD_GET);
+
+      libj::permute<double>(Ti,"cdj",Tp,"cjd");
+      libj::tensor<double> Vi(V.data()+i*nt2,nv,nv,no);
+      libj::copy<double>(Vi,R);
+      lap(libj::MINICCD_PERMUTE);
+
+      //particle ladder, out of core
+      for (size_t d=0;d<nv;d++)
+      {
+        const long next = (long) ((d+1)%nv);
+        pdata.prefetch(pfile,list_v,&next,1);
+        double* VP = (double*) pdata.pin(pfile,list_v,(long) d);
+        if (VP == NULL) {para.error(1);}
+        lap(libj::MINICCD_IO);
+        Vd.assign(VP,nv,nv,nv);
+        Td.assign(Tp.data()+d*nv*no,nv,no);
+        libj::contract<double>(0.5,Vd,"abc",Td,"cj",1.0,R,"abj");
+        pdata.unpin(pfile,list_v,(long) d);
+        lap(libj::MINICCD_PP);
+      }
+
+      libj::contract<double>(1.0,Ti,"ack",Wr,"ckbj",1.0,R,"abj");
+      lap(libj::MINICCD_RING);
+
+      //hole ladder, with the T_k of the other tasks
+      for (size_t k=0;k<no;k++)
+      {
+        const libj::tensor<double>& T = (k == i) ? Ti : Tk;
+        if (k != i && pdata.get(list_t[cur],(long) k,Tk.data()) != 0) {para.error(1);}
+        lap(libj::MINICCD_GET);
+        Wki.assign(W.data()+(k+i*no)*no*no,no,no);
+        libj::contract<double>(0.5,T,"abl",Wki,"lj",1.0,R,"abj");
+        lap(libj::MINICCD_HH);
+      }
+
+      libj::permute_sum<double>(R,{"abj","baj"},{0.5,0.5},S,"abj",0.0);
+      lap(libj::MINICCD_PERMUTE);
+
+      libj::denom<double>(S,{ev.data(),ev.data(),eo.data()},{-1.0,-1.0,1.0},true,eo[i]);
+      sums[0] += libj::dot<double>(Vi,"abj",S,"abj");
+      libj::axpby<double>(1.0,S,"abj",-1.0,Ti,"abj");
+      sums[1] += libj::dot<double>(Ti,"abj",Ti,"abj");
+      lap(libj::MINICCD_DENOM);
+
+      if (pdata.put(list_t[1-cur],index,S.data()) != 0) {para.error(1);}
+      lap(libj::MINICCD_PUT);
+    });
+    para.allreduce(sums,PCOLL_SUM);
+    const double t = titer.elapsed();
+    phase[libj::MINICCD_SYNC] += t - work;
+    iter_time.push_back(t);
+    cur = 1-cur;
+
+    if (master) printf("  %4d  %10.4f  %16.10f  %14.6e\n",iter+1,t,sums[0],sqrt(sums[1]));
+  }
+
+  //phases over the tasks
+  libj::tensor<double> pmin(libj::MINICCD_NPHASE), pmax(libj::MINICCD_NPHASE), psum(libj::MINICCD_NPHASE);
+  for (int p=0;p<libj::MINICCD_NPHASE;p++) {pmin[p] = pmax[p] = psum[p] = phase[p];}
+  para.allreduce(pmin,PCOLL_MIN);
+  para.allreduce(pmax,PCOLL_MAX);
+  para.allreduce(psum,PCOLL_SUM);
+
+  if (master)
+  {
+    double total = 0.0;
+    for (size_t n=0;n<iter_time.size();n++) {total += iter_time[n];}
+    const double mean = (iter_time.size() > 1) ? (total - iter_time[0])/(double) (iter_time.size()-1)
+                                               : total;
+    printf("\n  time to first iteration %.4f s (with setup %.4f s)\n",iter_time[0],setup_time+iter_time[0]);
+    printf("  time per iteration      %.4f s (after the first)\n\n",mean);
+    printf("  phase              min (s)     avg (s)     max (s)   %% of avg\n");
+    double avg_total = 0.0;
+    for (int p=0;p<libj::MINICCD_NPHASE;p++) {avg_total += psum[p]/(double) pworld.mpi_world_num_tasks;}
+    for (int p=0;p<libj::MINICCD_NPHASE;p++)
+    {
+      const double avg = psum[p]/(double) pworld.mpi_world_num_tasks;
+      printf("  %-14s  %10.4f  %10.4f  %10.4f  %8.1f\n",libj::miniccd_names[p],pmin[p],avg,pmax[p],
+             (avg_total > 0.0) ? 100.0*avg/avg_total : 0.0);
+    }
+  }
+
+  //clean up
+  Vd.unassign(); Td.unassign(); Wki.unassign();
+  pdata.clear_cache(pfile);
+  for (int l=0;l<2;l++) {pdata.free_window(pworld,list_t[l]);}
+  para.file_close(fid);
+  pfile.erase(pworld,fid);
+  para.destroy();
+  return 0;
+}
@@ -0,0 +1,308 @@
+/*--------------------------------------------------------------------------
+  perftest.cpp
+	JHT, October 14, 2026 : created
+
+  perftest.exe, the performance regression test of libj (make perftest).
+  It times a fixed set of kernels, on fixed sizes, and compares them with
+  the times of a stored baseline, failing (exit 1) if any is more than
+  --tol percent slower. Unlike bench.exe, which sweeps sizes to see how
+  close each kernel is to the roofline, this is meant to be run after
+  each upgrade of libj, so that lost performance is noticed.
+
+    jblis_zero        libj::zero of a 10^6 tensor, as test/test4.cpp
+    linal_ABpC        linal_ABpC, M = N = K = 1000
+    jblis_permute     libj::permute abcd -> dcba, 48^4
+    pfile_write       Pfile write of 1 GB, in 64 MB blocks, then flush
+    pfile_read        Pfile read of the same 1 GB
+
+  The pfile entries go through the page cache, so they time the library
+  and the kernel rather than the disk, which is what is to be tracked.
+  They write PERFTEST_PFILE_BYTES to the working directory (the file is
+  erased after).
+
+  Each entry is timed with BENCH::time, the fastest of BENCH_SAMPLES.
+
+  Baseline
+  -------------------
+  A JSON file of the host it was measured on and the seconds of each
+  entry. If it does not exist it is written from this run (and the test
+  passes), and --update rewrites it. A baseline is only meaningful on the
+  host it was made on, so there is a warning if the host differs. Entries
+  that are faster than the baseline by more than tol are reported, so the
+  baseline can be updated.
+
+  Usage
+  -------------------
+  perftest.exe [--baseline file] [--tol percent] [--update] [--only text]
+               [--time seconds]
+
+    --baseline  the baseline, perftest_baseline.json by default
+    --tol       allowed slowdown in percent, LIBJ_PERFTEST_TOL or 10
+    --update    write the baseline from this run, and do not fail
+    --only      entries whose name contains text
+    --time      seconds to spend timing each entry, 1 by default
+--------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+#include <functional>
+#include "tensor.hpp"
+#include "jblis.hpp"
+#include "linal.hpp"
+#include "para.hpp"
+#include "bench.hpp"
+
+#define PERFTEST_NAME_LEN    64
+#define PERFTEST_ZERO_N      1000000L
+#define PERFTEST_GEMM_N      1000
+#define PERFTEST_PERMUTE_Q   48
+#define PERFTEST_PFILE_BYTES (1L<<30)
+#define PERFTEST_PFILE_BLOCK (64L<<20)
+
+namespace libj
+{
+
+struct perftest_entry
+{
+  char   name[PERFTEST_NAME_LEN];
+  double seconds;
+};
+
+//--------------------------------------------------------------------------
+// perftest_host
+//--------------------------------------------------------------------------
+static void perftest_host(char* host, const size_t len)
+{
+  if (gethostname(host,len) != 0) {strncpy(host,"unknown",len);}
+  host[len-1] = '\0';
+  for (char* c=host;*c!='\0';c++) {if (*c == ' ' || *c == '"') *c = '_';}
+}
+
+//--------------------------------------------------------------------------
+// perftest_read
+//	read the baseline at path into host and entries, returns 0 on
+//	success. One entry per line, as perftest_write writes them
+//--------------------------------------------------------------------------
+static int perftest_read(const char* path, char* host,
+                         std::vector<perftest_entry>& entries)
+{
+  FILE* fp = fopen(path,"r");
+  if (fp == NULL) return 1;
+  entries.clear();
+  host[0] = '\0';
+  char line[256];
+  while (fgets(line,sizeof(line),fp) != NULL)
+  {
+    perftest_entry e;
+    if (sscanf(line," \"host\" : \"%63[^\"]\"",host) == 1) continue;
+    if (sscanf(line," {\"name\" : \"%63[^\"]\", \"seconds\" : %lf}",e.name,&e.seconds) == 2)
+    {
+      entries.push_back(e);
+    }
+  }
+  fclose(fp);
+  return 0;
+}
+
+//--------------------------------------------------------------------------
+// perftest_write
+//	write the baseline to path, returns 0 on success
+//--------------------------------------------------------------------------
+static int perftest_write(const char* path, const char* host,
+                          const std::vector<perftest_entry>& entries)
+{
+  FILE* fp = fopen(path,"w");
+  if (fp == NULL)
+  {
+    printf("ERROR libj::perftest could not write %s\n",path);
+    return 1;
+  }
+  fprintf(fp,"{\n  \"host\" : \"%s\",\n  \"entries\" : [\n",host);
+  for (size_t i=0;i<entries.size();i++)
+  {
+    fprintf(fp,"    {\"name\" : \"%s\", \"seconds\" : %.6e}%s\n",entries[i].name,
+            entries[i].seconds,(i+1 < entries.size()) ? "," : "");
+  }
+  fprintf(fp,"  ]\n}\n");
+  fclose(fp);
+  return 0;
+}
+
+//--------------------------------------------------------------------------
+// perftest_find
+//	baseline seconds of name, negative if it has none
+//--------------------------------------------------------------------------
+static double perftest_find(const std::vector<perftest_entry>& entries, const char* name)
+{
+  for (size_t i=0;i<entries.size();i++)
+  {
+    if (strcmp(entries[i].name,name) == 0) return entries[i].seconds;
+  }
+  return -1.0;
+}
+
+}//end libj namespace
+
+//--------------------------------------------------------------------------
+// main
+//--------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  std::string baseline = "perftest_baseline.json";
+  std::string only;
+  const char* env = getenv("LIBJ_PERFTEST_TOL");
+  double tol = (env != NULL) ? atof(env) : 10.0;
+  double min_time = 1.0;
+  bool update = false;
+  for (int i=1;i<argc;i++)
+  {
+    const bool more = (i+1 < argc);
+    if (strcmp(argv[i],"--baseline") == 0 && more) {baseline = argv[++i];}
+    else if (strcmp(argv[i],"--tol") == 0 && more) {tol = atof(argv[++i]);}
+    else if (strcmp(argv[i],"--update") == 0) {update = true;}
+    else if (strcmp(argv[i],"--only") == 0 && more) {only = argv[++i];}
+    else if (strcmp(argv[i],"--time") == 0 && more) {min_time = atof(argv[++i]);}
+    else
+    {
+      printf("ERROR libj::perftest unknown option %s\n",argv[i]);
+      printf("usage : perftest.exe [--baseline file] [--tol percent] [--update] "
+             "[--only text] [--time seconds]\n");
+      return 1;
+    }
+  }
+  if (tol <= 0.0 || min_time <= 0.0)
+  {
+    printf("ERROR libj::perftest --tol and --time must be positive\n");
+    return 1;
+  }
+
+  Pworld pworld;
+  pworld.init();
+
+  std::vector<libj::perftest_entry> now;
+  volatile double sink = 0.0;
+  auto run = [&](const char* name, std::function<void()> call)
+  {
+    if (!only.empty() && strstr(name,only.c_str()) == NULL) return;
+    libj::perftest_entry e;
+    strncpy(e.name,name,PERFTEST_NAME_LEN);
+    e.name[PERFTEST_NAME_LEN-1] = '\0';
+    e.seconds = libj::BENCH::time(min_time,call);
+    now.push_back(e);
+  };
+
+  //jblis zero
+  {
+    libj::tensor<double> A(PERFTEST_ZERO_N);
+    run("jblis_zero",[&]{libj::zero<double>(A); sink += A[0];});
+  }
+
+  //linal_ABpC
+  {
+    const int n = PERFTEST_GEMM_N;
+    std::vector<double> A((size_t) n*n,1.0), B((size_t) n*n,1.0), C((size_t) n*n,0.0);
+    run("linal_ABpC",[&]
+    {
+      linal_ABpC<double>(n,n,n,1.0e-3,A.data(),B.data(),0.0,C.data());
+      sink += C[0];
+    });
+  }
+
+  //jblis permute
+  {
+    const size_t q = PERFTEST_PERMUTE_Q;
+    libj::tensor<double> X(q,q,q,q), Y(q,q,q,q);
+    libj::set<double>(1.0,X);
+    run("jblis_permute",[&]{libj::permute<double>(X,"abcd",Y,"dcba"); sink += Y[0];});
+  }
+
+  //pfile, on the io tasks only
+  if (pworld.mpi_doesIO && (only.empty() || strstr("pfile_write pfile_read",only.c_str()) != NULL))
+  {
+    Pfile pfile;
+    pfile.init(pworld);
+    const int fid = pfile.sadd(pworld,"perftest",PERFTEST_PFILE_BYTES);
+    if (fid < 0 || pfile.open(pworld,fid,"w+b") != 0)
+    {
+      printf("ERROR libj::perftest could not open the pfile test file\n");
+      pworld.destroy();
+      return 1;
+    }
+    std::vector<char> buf(PERFTEST_PFILE_BLOCK,1);
+    run("pfile_write",[&]
+    {
+      for (long pos=0;pos<PERFTEST_PFILE_BYTES;pos+=PERFTEST_PFILE_BLOCK)
+      {
+        pfile.write(fid,pos,buf.data(),1,PERFTEST_PFILE_BLOCK);
+      }
+      pfile.flush(pworld,fid);
+    });
+    run("pfile_read",[&]
+    {
+      for (long pos=0;pos<PERFTEST_PFILE_BYTES;pos+=PERFTEST_PFILE_BLOCK)
+      {
+        pfile.read(fid,pos,buf.data(),1,PERFTEST_PFILE_BLOCK);
+      }
+      sink += buf[0];
+    });
+    pfile.erase(pworld,fid);
+  }
+
+  //compare, on world task 0
+  int stat = 0;
+  if (pworld.mpi_world_task_id == 0)
+  {
+    char host[PERFTEST_NAME_LEN];
+    libj::perftest_host(host,sizeof(host));
+    char base_host[PERFTEST_NAME_LEN];
+    std::vector<libj::perftest_entry> base;
+    const bool have = (libj::perftest_read(baseline.c_str(),base_host,base) == 0);
+    if (have && strcmp(host,base_host) != 0)
+    {
+      printf("WARNING libj::perftest the baseline is of host %s, this is %s\n",base_host,host);
+    }
+
+    printf("%-16s %12s %12s %9s  %s\n","entry","baseline s","now s","change","");
+    int nfail = 0;
+    for (size_t i=0;i<now.size();i++)
+    {
+      const double b = have ? libj::perftest_find(base,now[i].name) : -1.0;
+      if (b <= 0.0)
+      {
+        printf("%-16s %12s %12.4e %9s  new\n",now[i].name,"-",now[i].seconds,"-");
+        continue;
+      }
+      const double change = 100.0*(now[i].seconds - b)/b;
+      const char* verdict = "ok";
+      if (change > tol) {verdict = "SLOWER"; nfail++;}
+      else if (change < -tol) {verdict = "faster, consider --update";}
+      printf("%-16s %12.4e %12.4e %+8.1f%%  %s\n",now[i].name,b,now[i].seconds,change,verdict);
+    }
+
+    if (!have || update)
+    {
+      //keep the baseline entries that were not run (e.g., with --only)
+      std::vector<libj::perftest_entry> out = now;
+      for (size_t i=0;have && i<base.size();i++)
+      {
+        if (libj::perftest_find(now,base[i].name) < 0.0) out.push_back(base[i]);
+      }
+      if (libj::perftest_write(baseline.c_str(),host,out) == 0)
+      {
+        printf("wrote the baseline %s\n",baseline.c_str());
+      }
+    }
+
+    if (nfail > 0 && !update)
+    {
+      printf("FAILED %d entries are more than %.1f%% slower than %s\n",nfail,tol,baseline.c_str());
+      stat = 1;
+    }
+  }
+
+  pworld.destroy();
+  return stat;
+}
@@ -12,8 +12,8 @@
  *
  *  USAGE
  *  ------------------
- *  //Initialization
- *  libj::Cache cache;
+ *  //Initialization, one per thread from the heap (see cache_pool.hpp)
+ *  libj::Cache& cache = libj::CachePool::local();
  *
  *  //Retrieve a pointer to different cache levels
  *  double* x = cache.L1_pointer<double>(); 
@@ -21,9 +21,18 @@
  *
  *  //Determine the number of elements of a given type in cache
  *  num_double = cache.L1_elements<double>();
+ *
+ *  The _elements functions are the compile time sizes of the buffers
+ *  (LIBJ_L1_BYTES etc.). The caches of the machine, found at run time,
+ *  are given by the _runtime_elements functions (see cache_info.hpp)
+ *  num_double = libj::Cache::L2_runtime_elements<double>();
 -----------------------------------------------------------------------------*/
+#ifndef LIBJ_CACHE_HPP
+#define LIBJ_CACHE_HPP
+
 #include <stdlib.h>
 #include "libjdef.h"
+#include "cache_info.hpp"
 
 namespace libj
 {
@@ -83,6 +92,18 @@ struct Cache
       return LIBJ_LINE_BYTES / sizeof(T);
   } 
 
+  //functions to get numbers of elements in the caches of this machine
+  template<typename T>
+  static size_t L1_runtime_elements() {return libj::CacheInfo::get().L1_elements<T>();}
+
+  template<typename T>
+  static size_t L2_runtime_elements() {return libj::CacheInfo::get().L2_elements<T>();}
+
+  template<typename T>
+  static size_t LINE_runtime_elements() {return libj::CacheInfo::get().LINE_elements<T>();}
+
 }; //cache struct 
 
 }//end namespace
+
+#endif
@@ -0,0 +1,210 @@
+/*-----------------------------------------------------------------------------
+ * cache_info.hpp
+ *  JHT, October 14, 2026 : created
+ *
+ *  .hpp file for the CacheInfo struct, which holds the cache sizes of the
+ *  machine we are running on, found once at run time. The blocking in
+ *  jblis and linal asks this instead of using LIBJ_L1_BYTES etc. directly,
+ *  which are now only the fallback and the size of the libj::Cache buffers.
+ *
+ *  The sizes are found from, in order
+ *    1) the environment variables LIBJ_L1_BYTES, LIBJ_L2_BYTES,
+ *       LIBJ_L3_BYTES and LIBJ_LINE_BYTES, if set
+ *    2) /sys/devices/system/cpu/cpu0/cache (linux)
+ *    3) cpuid leaf 4 (intel) or 0x8000001D (amd)
+ *    4) the compile time constants in libjdef.h
+ *
+ *  USAGE
+ *  ------------------
+ *  const libj::CacheInfo& info = libj::CacheInfo::get();
+ *  info.L2_bytes;		//bytes of L2 (per core)
+ *  info.L2_elements<double>();	//doubles in L2
+ *  info.source;		//where the sizes came from
+ *
+ *  libj::cache_buffer<double> buf(n); //n doubles, aligned to a cache line
+-----------------------------------------------------------------------------*/
+#ifndef LIBJ_CACHE_INFO_HPP
+#define LIBJ_CACHE_INFO_HPP
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "libjdef.h"
+#include "mem_registry.hpp"
+
+#if (defined (__x86_64__) || defined (__i386__)) && defined (__GNUC__)
+  #include <cpuid.h>
+  #define LIBJ_HAVE_CPUID 1
+#endif
+
+namespace libj
+{
+
+struct CacheInfo
+{
+  size_t      L1_bytes;		//L1 data cache
+  size_t      L2_bytes;		//L2 cache
+  size_t      L3_bytes;		//L3 cache, 0 if none
+  size_t      line_bytes;	//cache line
+  const char* source;		//"env", "sysfs", "cpuid", or "default"
+
+  template<typename T> size_t L1_elements() const {return L1_bytes/sizeof(T);}
+  template<typename T> size_t L2_elements() const {return L2_bytes/sizeof(T);}
+  template<typename T> size_t L3_elements() const {return L3_bytes/sizeof(T);}
+  template<typename T> size_t LINE_elements() const
+  {
+    return (line_bytes >= sizeof(T)) ? line_bytes/sizeof(T) : 1;
+  }
+
+  //the sizes, found on the first call
+  static const CacheInfo& get()
+  {
+    static const CacheInfo info = detect();
+    return info;
+  }
+
+  //find the sizes of this machine
+  static CacheInfo detect()
+  {
+    CacheInfo info;
+    info.L1_bytes   = LIBJ_L1_BYTES;
+    info.L2_bytes   = LIBJ_L2_BYTES;
+    info.L3_bytes   = 0;
+    info.line_bytes = LIBJ_LINE_BYTES;
+    info.source     = "default";
+    if (!m_sysfs(info)) m_cpuid(info);
+    m_env(info);
+    return info;
+  }
+
+  void print() const
+  {
+    printf("libj::CacheInfo (%s) : L1 = %zu, L2 = %zu, L3 = %zu, line = %zu bytes \n",
+           source,L1_bytes,L2_bytes,L3_bytes,line_bytes);
+  }
+
+  private:
+  //size in bytes from strings like "48K" or "2048K"
+  static size_t m_parse(const char* s)
+  {
+    char* end;
+    size_t n = (size_t) strtoul(s,&end,10);
+    if (*end == 'K' || *end == 'k') n *= 1024;
+    else if (*end == 'M' || *end == 'm') n *= 1024*1024;
+    return n;
+  }
+
+  static bool m_read(const char* path, char* buf, const size_t len)
+  {
+    FILE* fp = fopen(path,"r");
+    if (fp == NULL) return false;
+    const bool ok = (fgets(buf,(int) len,fp) != NULL);
+    fclose(fp);
+    return ok;
+  }
+
+  static bool m_sysfs(CacheInfo& info)
+  {
+    bool found = false;
+    char path[128], buf[64];
+    for (int i=0;i<16;i++)
+    {
+      const char* dir = "/sys/devices/system/cpu/cpu0/cache/index";
+      snprintf(path,sizeof(path),"%s%d/level",dir,i);
+      if (!m_read(path,buf,sizeof(buf))) break;
+      const int level = atoi(buf);
+      snprintf(path,sizeof(path),"%s%d/type",dir,i);
+      if (!m_read(path,buf,sizeof(buf)) || buf[0] == 'I') continue; //instruction
+      snprintf(path,sizeof(path),"%s%d/size",dir,i);
+      if (!m_read(path,buf,sizeof(buf))) continue;
+      const size_t size = m_parse(buf);
+      if (size == 0) continue;
+      if (level == 1) info.L1_bytes = size;
+      if (level == 2) info.L2_bytes = size;
+      if (level == 3) info.L3_bytes = size;
+      snprintf(path,sizeof(path),"%s%d/coherency_line_size",dir,i);
+      if (level == 1 && m_read(path,buf,sizeof(buf)) && atoi(buf) > 0) info.line_bytes = (size_t) atoi(buf);
+      found = true;
+    }
+    if (found) info.source = "sysfs";
+    return found;
+  }
+
+  static bool m_cpuid(CacheInfo& info)
+  {
+#if defined (LIBJ_HAVE_CPUID)
+    unsigned leaf = 0;
+    if (__get_cpuid_max(0,NULL) >= 4) leaf = 4;
+    else if (__get_cpuid_max(0x80000000,NULL) >= 0x8000001D) leaf = 0x8000001D;
+    if (leaf == 0) return false;
+
+    bool found = false;
+    for (unsigned sub=0;sub<16;sub++)
+    {
+      unsigned a,b,c,d;
+      __cpuid_count(leaf,sub,a,b,c,d);
+      const unsigned type = a & 0x1f;
+      if (type == 0) break;
+      if (type == 2) continue; //instruction
+      const unsigned level = (a >> 5) & 0x7;
+      const size_t ways  = ((b >> 22) & 0x3ff) + 1;
+      const size_t parts = ((b >> 12) & 0x3ff) + 1;
+      const size_t line  = (b & 0xfff) + 1;
+      const size_t sets  = (size_t) c + 1;
+      const size_t size  = ways*parts*line*sets;
+      if (level == 1) {info.L1_bytes = size; info.line_bytes = line;}
+      if (level == 2) info.L2_bytes = size;
+      if (level == 3) info.L3_bytes = size;
+      found = true;
+    }
+    if (found) info.source = "cpuid";
+    return found;
+#else
+    return false;
+#endif
+  }
+
+  static void m_env(CacheInfo& info)
+  {
+    const char* s;
+    if ((s = getenv("LIBJ_L1_BYTES"))   != NULL && m_parse(s) > 0) {info.L1_bytes = m_parse(s); info.source = "env";}
+    if ((s = getenv("LIBJ_L2_BYTES"))   != NULL && m_parse(s) > 0) {info.L2_bytes = m_parse(s); info.source = "env";}
+    if ((s = getenv("LIBJ_L3_BYTES"))   != NULL && m_parse(s) > 0) {info.L3_bytes = m_parse(s); info.source = "env";}
+    if ((s = getenv("LIBJ_LINE_BYTES")) != NULL && m_parse(s) > 0) {info.line_bytes = m_parse(s); info.source = "env";}
+  }
+};
+
+/*-----------------------------------------------------------------------------
+ * cache_buffer
+ *  scratch buffer of n elements aligned to a cache line, for blocks sized
+ *  from CacheInfo that may not fit in the libj::Cache buffers
+-----------------------------------------------------------------------------*/
+template <typename T>
+struct cache_buffer
+{
+  T* ptr;
+
+  cache_buffer(const size_t n)
+  {
+    void* p = NULL;
+    const size_t align = (LIBJ_LINE_BYTES >= sizeof(void*)) ? LIBJ_LINE_BYTES : sizeof(void*);
+    if (posix_memalign(&p,align,(n > 0 ? n : 1)*sizeof(T)) != 0 || p == NULL)
+    {
+      printf("ERROR libj::cache_buffer \n");
+      printf("could not allocate %zu elements \n",n);
+      exit(1);
+    }
+    libj::mem_track(p,(n > 0 ? n : 1)*sizeof(T));
+    ptr = (T*) p;
+  }
+  ~cache_buffer() {libj::mem_untrack(ptr); free(ptr);}
+
+  T* data() {return ptr;}
+
+  private:
+  cache_buffer(const cache_buffer<T>& other);
+  cache_buffer<T>& operator= (const cache_buffer<T>& other);
+};
+
+}//end namespace
+
+#endif
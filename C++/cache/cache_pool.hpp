@@ -0,0 +1,128 @@
+/*-----------------------------------------------------------------------------
+ * cache_pool.hpp
+ *  JHT, October 14, 2026 : created
+ *
+ *  .hpp file for the CachePool, which gives each thread its own libj::Cache
+ *  on the heap. A Cache is LIBJ_L1_BYTES + LIBJ_L2_BYTES and a few lines,
+ *  which is too large to put on the stack of every OpenMP thread, and can
+ *  not be shared by threads that pack into it.
+ *
+ *  The Cache of a thread is made the first time that thread calls local(),
+ *  and freed when the thread exits. It is page aligned and takes whole
+ *  pages, so the Caches of two threads never share a line. As in
+ *  core_pool, the NUMA mode (set_numa) decides where the pages go
+ *    CORE_NUMA_NONE  : wherever they are first touched
+ *    CORE_NUMA_TOUCH : the owning thread touches every page (default)
+ *    CORE_NUMA_BIND  : as TOUCH, and bound to the node of the thread
+ *
+ *  The Caches are kept per thread (thread_local), rather than per
+ *  omp_get_thread_num(), so nested parallel regions do not share them.
+ *
+ *  USAGE
+ *  ------------------
+ *  #pragma omp parallel
+ *  {
+ *    libj::Cache& cache = libj::CachePool::local();
+ *    double* buf = cache.L1_pointer<double>();
+ *  }
+ *
+ *  FUNCTIONS
+ *  ------------------
+ *  libj::CachePool::local();		//Cache of this thread, made if needed
+ *  libj::CachePool::is_made();		//true if this thread has a Cache
+ *  libj::CachePool::set_numa(mode);	//NUMA mode of the Caches made after
+-----------------------------------------------------------------------------*/
+#ifndef LIBJ_CACHE_POOL_HPP
+#define LIBJ_CACHE_POOL_HPP
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <new>
+#include "cache.hpp"
+#include "core_pool.hpp"
+#include "mem_registry.hpp"
+
+#if defined (__linux__)
+  #include <unistd.h>
+#endif
+
+namespace libj
+{
+
+class CachePool
+{
+  private:
+
+  //the Cache of one thread, freed at thread exit
+  struct slot
+  {
+    Cache* cache;
+    slot() : cache(NULL) {}
+    ~slot()
+    {
+      if (cache != NULL)
+      {
+        cache->~Cache();
+        libj::mem_untrack(cache);
+        free(cache);
+      }
+    }
+  };
+
+  static slot& m_slot()
+  {
+    static thread_local slot s;
+    return s;
+  }
+
+  static core_numa& m_numa()
+  {
+    static core_numa numa = CORE_NUMA_TOUCH;
+    return numa;
+  }
+
+  static Cache* m_make()
+  {
+  #if defined (__linux__)
+    const long ps = sysconf(_SC_PAGESIZE);
+    const size_t page = (ps > 0) ? (size_t) ps : 4096;
+  #else
+    const size_t page = 4096;
+  #endif
+    const size_t bytes = ((sizeof(Cache) + page - 1)/page)*page;
+    void* mem = NULL;
+    if (posix_memalign(&mem,page,bytes) != 0 || mem == NULL)
+    {
+      printf("ERROR libj::CachePool::local \n");
+      printf("could not allocate %zu bytes for a Cache \n",bytes);
+      exit(1);
+    }
+    const core_numa numa = m_numa();
+    if (numa == CORE_NUMA_BIND) numa_bind_local(mem,bytes);
+    if (numa != CORE_NUMA_NONE)
+    {
+      char* c = (char*) mem;
+      for (size_t b=0;b<bytes;b+=page) c[b] = 0;
+    }
+    libj::mem_track(mem,bytes);
+    return new (mem) Cache;
+  }
+
+  public:
+
+  //Cache of the calling thread
+  static Cache& local()
+  {
+    slot& s = m_slot();
+    if (s.cache == NULL) s.cache = m_make();
+    return *s.cache;
+  }
+
+  static bool is_made() {return m_slot().cache != NULL;}
+
+  static void set_numa(const core_numa numa) {m_numa() = numa;}
+};
+
+}//end namespace
+
+#endif
@@ -0,0 +1,42 @@
+/*-------------------------------------------------------
+  allocator.hpp
+	JHT, October 14, 2026 : created 
+
+  Allocator handle for the tensor, gemat, usymat, and
+  geten classes. These use malloc/free unless they are
+  given a handle with set_allocator(), in which case the
+  memory of allocate() and aligned_allocate() comes from
+  the handle, and deallocate() gives it back. The handle
+  is set before allocating, changing it on an allocated
+  object is an error, as the memory would be given back
+  to the wrong allocator.
+
+  The handle must outlive every object allocated from it.
+  See core_arena.hpp for the Core backed arena.
+
+  FUNCTIONS
+  --------------------------
+  A.allocate(ALIGN,n);	   //n elements, aligned to ALIGN bytes
+  A.deallocate(ptr,n);	   //return n elements at ptr
+
+--------------------------------------------------------*/
+#ifndef ALLOCATOR_HPP
+#define ALLOCATOR_HPP
+
+#include <cstddef>
+
+namespace libj
+{
+
+template <typename T>
+class allocator
+{
+  public:
+  virtual ~allocator() {}
+  virtual T* allocate(const size_t ALIGN, const size_t n) = 0;
+  virtual void deallocate(T* ptr, const size_t n) = 0;
+};
+
+}//end of namespace
+
+#endif
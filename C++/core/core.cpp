@@ -11,7 +11,7 @@
   const long	: n, number of elements to allocate 
 -------------------------------------------------------*/
 template<typename T>
-Core<T>::Core() : len{0}, allocated{false}, assigned{false} 
+Core<T>::Core() : len{0}, allocated{false}, assigned{false}, kind{libj::LIBJ_PAGES_NONE}, huge{false}, hwm{0} 
 {
 }
 template Core<double>::Core();
@@ -25,6 +25,9 @@ Core<T>::Core(const long n)
 {
   allocated = false;
   assigned = false;
+  kind = libj::LIBJ_PAGES_NONE;
+  huge = false;
+  hwm = 0;
   allocate(n);
 }
 template Core<double>::Core(const long n);
@@ -38,6 +41,9 @@ Core<T>::Core(const long n, T* ptr)
 {
   allocated = false;
   assigned = false;
+  kind = libj::LIBJ_PAGES_NONE;
+  huge = false;
+  hwm = 0;
   assign(n,ptr);
 }
 template Core<double>::Core(const long n, double* ptr);
@@ -68,21 +74,52 @@ template Core<double*>::~Core();
 
 /*-------------------------------------------------------
   Allocator  
-    - allocates the buffer
+    - allocates the buffer, with the global huge page
+      mode
 
   const long	: n, number of elements to allocate 
 -------------------------------------------------------*/
 template<typename T>
 void Core<T>::allocate(const long n)
+{
+  allocate(n,libj::huge_pages());
+}
+template void Core<double>::allocate(const long n);
+template void Core<float>::allocate(const long n);
+template void Core<long>::allocate(const long n);
+template void Core<int>::allocate(const long n);
+template void Core<double*>::allocate(const long n);
+
+/*-------------------------------------------------------
+  Allocator  
+    - allocates the buffer on the largest pages up to
+      mode that are available (see huge_pages.hpp)
+
+  const long	       : n, number of elements to allocate 
+  const huge_page_mode : mode, pages to use
+-------------------------------------------------------*/
+template<typename T>
+void Core<T>::allocate(const long n, const libj::huge_page_mode mode)
 {
   const long mm=std::numeric_limits<long>::max();
   if (!(allocated||assigned) && n >= 1 && n <= mm) 
   {
-    buf = (T*) malloc(n*sizeof(T));
+    if (mode == libj::LIBJ_PAGES_NONE)
+    {
+      buf = (T*) malloc(n*sizeof(T));
+      libj::mem_track(buf,n*sizeof(T));
+      kind = libj::LIBJ_PAGES_NONE;
+      huge = false;
+    } else {
+      buf = (T*) libj::huge_alloc(n*sizeof(T),sizeof(T),mode);
+      kind = (buf != NULL) ? libj::huge_kind(buf) : libj::LIBJ_PAGES_NONE;
+      huge = (buf != NULL);
+    }
     next = buf;
     len = n;
     navbl = n;
     ntake = 0;
+    hwm = 0;
     allocated = true;
     assigned = false;
   } else if (allocated) {
@@ -106,11 +143,11 @@ void Core<T>::allocate(const long n)
     exit(1);
   }
 }
-template void Core<double>::allocate(const long n);
-template void Core<float>::allocate(const long n);
-template void Core<long>::allocate(const long n);
-template void Core<int>::allocate(const long n);
-template void Core<double*>::allocate(const long n);
+template void Core<double>::allocate(const long n, const libj::huge_page_mode mode);
+template void Core<float>::allocate(const long n, const libj::huge_page_mode mode);
+template void Core<long>::allocate(const long n, const libj::huge_page_mode mode);
+template void Core<int>::allocate(const long n, const libj::huge_page_mode mode);
+template void Core<double*>::allocate(const long n, const libj::huge_page_mode mode);
 
 /*-------------------------------------------------------
   Deallocator
@@ -121,8 +158,12 @@ void Core<T>::deallocate()
 {
   if (allocated)
   {
+    m_drop_regions(0);
     next = NULL;
-    free(buf);
+    if (huge) {libj::huge_free(buf);}
+    else      {libj::mem_untrack(buf); free(buf);}
+    kind = libj::LIBJ_PAGES_NONE;
+    huge = false;
     allocated = false;
   } else {
     printf("Attempted to deallocated an unallocated Core\n");
@@ -151,6 +192,7 @@ void Core<T>::assign(const long n, T* pntr)
     len = n;
     navbl = n;
     ntake = 0;
+    hwm = 0;
     allocated = false;
     assigned = true;
   } else if (allocated || assigned) {
@@ -185,6 +227,7 @@ void Core<T>::unassign()
 {
   if (assigned)
   {
+    m_drop_regions(0);
     buf = NULL;
     next = NULL;
     len = 0;
@@ -213,8 +256,16 @@ void Core<T>::info() const
     printf("%ld elements \n",len);
     printf("%ld free elements \n",navbl);
     printf("%ld taken elements \n",ntake);
+    printf("%ld elements at the high water mark \n",hwm);
+    for (size_t r=0;r<regions.size();r++)
+    {
+      printf("region %s : %ld elements at offset %ld \n",
+             regions[r].name.c_str(),regions[r].core->size(),regions[r].start);
+    }
     printf("buffer begins at %p \n",(void*)buf);
     printf("next element  at %p \n",(void*)next);
+    const libj::mem_stats S = libj::mem_total();
+    printf("libj has %lld bytes live, %lld bytes at the peak \n",S.live,S.peak);
   } else {
     printf("Core is not allocated or assigned \n");
   }
@@ -243,6 +294,7 @@ T* Core<T>::checkout(const long n)
       T* ptr = next;
       navbl -= n;
       next += n;
+      m_high_water();
       return ptr;
     } else {
       printf("Attempted to checkout more elements than Core has\n");
@@ -276,6 +328,7 @@ T* Core<T>::aligned_checkout(const long ALIGN, const long n)
         T* ptr = next;
         navbl -= (n+nextra);
         next += (n+nextra);
+        m_high_water();
 
         long M = (long)ptr%(long)ALIGN; //number of BYTES we are off
         if (M != 0)
@@ -329,10 +382,12 @@ int Core<T>::remove(const long n)
     if (navbl <= len )
     { 
       next -= n;
+      m_drop_regions((long)(next-buf));
       return 0;
     } else {
       navbl = len;
       next = buf;
+      m_drop_regions(0);
       return 0;
     }
   } else {
@@ -360,6 +415,7 @@ int Core<T>::take_free(const long n)
   {
     navbl -= n;
     ntake += n;
+    m_high_water();
     return 0;
   } else {
     printf("Core::take_free attempted to take more free memory than available \n");
@@ -393,3 +449,155 @@ template int Core<int>::return_free(const long n);
 template int Core<double*>::return_free(const long n);
 
 
+
+/*-------------------------------------------------------
+  rewind(const long m)
+    - gives back every element checked out since mark m,
+      and removes the regions made since then 
+
+  const long		: m, mark from Core::mark()
+-------------------------------------------------------*/
+template<typename T>
+void Core<T>::rewind(const long m)
+{
+  if (allocated||assigned)
+  {
+    const long pos = (long)(next-buf);
+    if (m >= 0 && m <= pos)
+    {
+      m_drop_regions(m);
+      navbl += pos - m;
+      next = buf + m;
+    } else {
+      printf("Attempted to rewind Core to mark %ld, past the end at %ld \n",m,pos);
+      exit(1);
+    }
+  } else {
+    printf("Attempted to rewind unallocated or unassigned Core \n");
+    exit(1);
+  }
+}
+template void Core<double>::rewind(const long m);
+template void Core<float>::rewind(const long m);
+template void Core<long>::rewind(const long m);
+template void Core<int>::rewind(const long m);
+template void Core<double*>::rewind(const long m);
+
+/*-------------------------------------------------------
+  m_drop_regions(const long m)
+    - deletes the sub Cores of regions that end past
+      offset m 
+-------------------------------------------------------*/
+template<typename T>
+void Core<T>::m_drop_regions(const long m)
+{
+  while (!regions.empty() && regions.back().start + regions.back().core->size() > m)
+  {
+    delete regions.back().core;
+    regions.pop_back();
+  }
+}
+template void Core<double>::m_drop_regions(const long m);
+template void Core<float>::m_drop_regions(const long m);
+template void Core<long>::m_drop_regions(const long m);
+template void Core<int>::m_drop_regions(const long m);
+template void Core<double*>::m_drop_regions(const long m);
+
+/*-------------------------------------------------------
+  region(name,n)
+    - checks out n elements as a new region, and returns
+      a sub Core assigned to them. Checkouts from the sub
+      Core do not touch this one
+
+  const std::string&	: name, of the region
+  const long		: n, number of elements 
+-------------------------------------------------------*/
+template<typename T>
+Core<T>& Core<T>::region(const std::string& name, const long n)
+{
+  if (has_region(name))
+  {
+    printf("Attempted to make Core region %s, which already exists \n",name.c_str());
+    exit(1);
+  }
+  region_t r;
+  r.name  = name;
+  r.start = mark();
+  T* ptr  = checkout(n);
+  r.core  = new Core<T>(n,ptr);
+  regions.push_back(r);
+  return *r.core;
+}
+template Core<double>& Core<double>::region(const std::string& name, const long n);
+template Core<float>& Core<float>::region(const std::string& name, const long n);
+template Core<long>& Core<long>::region(const std::string& name, const long n);
+template Core<int>& Core<int>::region(const std::string& name, const long n);
+template Core<double*>& Core<double*>::region(const std::string& name, const long n);
+
+/*-------------------------------------------------------
+  region(name)
+    - returns the sub Core of an existing region 
+-------------------------------------------------------*/
+template<typename T>
+Core<T>& Core<T>::region(const std::string& name)
+{
+  for (size_t r=0;r<regions.size();r++)
+  {
+    if (regions[r].name == name) return *regions[r].core;
+  }
+  printf("Attempted to access Core region %s, which does not exist \n",name.c_str());
+  exit(1);
+  return *this;
+}
+template Core<double>& Core<double>::region(const std::string& name);
+template Core<float>& Core<float>::region(const std::string& name);
+template Core<long>& Core<long>::region(const std::string& name);
+template Core<int>& Core<int>::region(const std::string& name);
+template Core<double*>& Core<double*>::region(const std::string& name);
+
+/*-------------------------------------------------------
+  has_region(name)
+    - true if the region exists 
+-------------------------------------------------------*/
+template<typename T>
+bool Core<T>::has_region(const std::string& name) const
+{
+  for (size_t r=0;r<regions.size();r++)
+  {
+    if (regions[r].name == name) return true;
+  }
+  return false;
+}
+template bool Core<double>::has_region(const std::string& name) const;
+template bool Core<float>::has_region(const std::string& name) const;
+template bool Core<long>::has_region(const std::string& name) const;
+template bool Core<int>::has_region(const std::string& name) const;
+template bool Core<double*>::has_region(const std::string& name) const;
+
+/*-------------------------------------------------------
+  remove_region(name)
+    - gives a region back to the Core. Like remove, this
+      must be the last thing checked out
+-------------------------------------------------------*/
+template<typename T>
+void Core<T>::remove_region(const std::string& name)
+{
+  for (size_t r=0;r<regions.size();r++)
+  {
+    if (regions[r].name != name) continue;
+    if (regions[r].start + regions[r].core->size() != mark())
+    {
+      printf("Attempted to remove Core region %s, which is not on top \n",name.c_str());
+      exit(1);
+    }
+    rewind(regions[r].start);
+    return;
+  }
+  printf("Attempted to remove Core region %s, which does not exist \n",name.c_str());
+  exit(1);
+}
+template void Core<double>::remove_region(const std::string& name);
+template void Core<float>::remove_region(const std::string& name);
+template void Core<long>::remove_region(const std::string& name);
+template void Core<int>::remove_region(const std::string& name);
+template void Core<double*>::remove_region(const std::string& name);
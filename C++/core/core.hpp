@@ -14,16 +14,21 @@
   ALLOCATION/DEALLOCATTION
   --------------------------
   buf.allocate(n);	//allocates n elements via malloc for Core
+  buf.allocate(n,libj::LIBJ_PAGES_2M); //allocates n elements on huge pages
   buf.deallocate();    //frees buffer for Core
   buf.assign(n,ptr);   //assigns buffer to preallocated memory
   buf.unassign();      //unassigns buffer 
 
+  allocate(n) uses the global huge page mode of
+  libj::set_huge_pages(), which is malloc unless set
+
   INFORMATION
   --------------------------
   buf.size();		//returns long number of elements
   buf.nfree();		//returns long number of free elements
   buf.info();		//prints information about Core
   buf.is_allocated();	//returns true if allocated
+  buf.pages();		//pages the buffer really got (see huge_pages.hpp)
 
   RESERVING DATA
   --------------------------
@@ -31,10 +36,32 @@
   buf.checkout(n);	//returns a pointer to start of a reserved section 
   buf.remove(n);	//returns n-elements at the end of the buffer  
 
+  MARKS AND SCOPES
+  --------------------------
+  long m = buf.mark();	//current end of the checked out data
+  buf.rewind(m);	//gives back everything checked out since m
+  {
+    core_scope<double> S(buf); //rewinds to here when S goes out of scope
+    double* X = buf.checkout(n);
+  }
+  buf.high_water();	//most elements ever in use at once
+  buf.reset_high_water(); //restart the high water mark from now
+
+  NAMED REGIONS
+  --------------------------
+  Core<double>& R = buf.region("amps",n); //checks out n elements as a sub Core
+  buf.region("amps");	//the region named "amps"
+  buf.has_region("amps"); //true if it exists
+  buf.remove_region("amps"); //gives it back, it must be on top 
+  a rewind or remove to before the end of a region also removes it
+
   TAKING AWAY DATA
   -------------------------
   buf.take_free(n);	//removes some free data from the Core
   buf.return_free(n);	//returns some free data to the Core
+
+  For one slab for several types, see core_bytes.hpp,
+  which also gives out Cores assigned to parts of it
   
 --------------------------------------------------------*/
 #ifndef CORE_HPP
@@ -44,6 +71,9 @@
 #include <cstdint> //for long
 #include <stdio.h> //for printf
 #include <limits>  //for numeric_limits::max()
+#include <string>
+#include <vector>
+#include "huge_pages.hpp"
 
 template <typename T>
 class Core
@@ -56,6 +86,21 @@ private:
   long            ntake;			//number of taken elements
   bool        allocated;			//bool for if class is allocated
   bool         assigned;
+  libj::huge_page_mode kind;			//pages of buf, if allocated
+  bool             huge;			//buf is from libj::huge_alloc
+  long              hwm;			//high water mark of used elements
+
+  struct region_t
+  {
+    std::string   name;
+    long         start;			//offset of the region in buf
+    Core<T>*      core;			//sub Core assigned to the region
+  };
+  std::vector<region_t> regions;		//named regions, oldest first
+
+  void m_high_water()				//updates hwm
+    {const long used = (long)(next-buf) + ntake; if (used > hwm) hwm = used;}
+  void m_drop_regions(const long m);		//deletes regions ending past m
 
 public:
   //initialization/destructors
@@ -83,9 +128,18 @@ public:
     {return allocated;}
   inline bool is_assigned() const		//return if allocated
     {return assigned;}
+  inline libj::huge_page_mode pages() const	//pages of the buffer
+    {return kind;}
+  inline long mark() const			//offset of next free elm
+    {return (allocated||assigned) ? (long)(next-buf) : 0;}
+  inline long high_water() const		//most elm used at once
+    {return hwm;}
+  inline void reset_high_water()		//restart hwm from now
+    {hwm = (allocated||assigned) ? (long)(next-buf) + ntake : 0;}
   
   //Class functions
   void allocate(const long n);
+  void allocate(const long n, const libj::huge_page_mode mode);
   void deallocate();
   void assign(const long n, T* ptr);
   void unassign();
@@ -96,9 +150,36 @@ public:
   int take_free(const long n);
   int return_free(const long n);
   T* aligned_checkout(const long ALIGN, const long n); //checks out memory aligned by ALIGN bytes 
+  void rewind(const long m);			//gives back all past mark m
+  Core<T>& region(const std::string& name, const long n); //new named region
+  Core<T>& region(const std::string& name);	//existing named region
+  bool has_region(const std::string& name) const;
+  void remove_region(const std::string& name);
   
 };
 
+/*-------------------------------------------------------
+  core_scope
+    - rewinds a Core to where it was when the scope was
+      made, so nested algorithms can checkout without
+      matching every checkout with a remove
+-------------------------------------------------------*/
+template <typename T>
+class core_scope
+{
+private:
+  Core<T>&  m_core;
+  long      m_mark;
+
+  core_scope(const core_scope<T>& other);
+  core_scope<T>& operator= (const core_scope<T>& other);
+
+public:
+  core_scope(Core<T>& core) : m_core(core), m_mark(core.mark()) {}
+ ~core_scope() {m_core.rewind(m_mark);}
+  long mark() const {return m_mark;}
+};
+
 template class Core<double>;
 template class Core<float>;
 template class Core<long>;
@@ -0,0 +1,111 @@
+/*-------------------------------------------------------
+  core_arena.hpp
+	JHT, October 14, 2026 : created 
+
+  (CORE) (ARENA) : a libj::allocator that hands out 
+  memory from a Core with a bump pointer, via 
+  aligned_checkout, so that temporaries need no malloc.
+
+  Memory is given back to the Core in LIFO order with
+  remove. A block that is freed while newer blocks are 
+  still in use is only marked, and is given back once
+  everything above it is freed, so the usual scoped
+  temporaries in a loop never grow the arena.
+
+  INITIALIZATION
+  --------------------------
+  libj::core_arena<double> A(n);	//arena of n elements, via malloc
+  libj::core_arena<double> A(n,ptr);	//arena in existing memory
+
+  USAGE
+  --------------------------
+  libj::tensor<double> T;
+  T.set_allocator(&A);
+  T.aligned_allocate(64,10,20);	//from the arena
+  T.deallocate();		//back to the arena
+
+  INFORMATION
+  --------------------------
+  A.size();		//elements in the arena
+  A.nfree();		//free elements
+  A.nblocks();		//blocks checked out (or waiting to be freed)
+
+--------------------------------------------------------*/
+#ifndef CORE_ARENA_HPP
+#define CORE_ARENA_HPP
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include "core.hpp"
+#include "allocator.hpp"
+
+namespace libj
+{
+
+template <typename T>
+class core_arena : public libj::allocator<T>
+{
+  private:
+  struct block
+  {
+    T*   ptr;		//pointer given out
+    long nelm;		//elements taken from the Core
+    bool freed;		//freed, but not yet removed
+  };
+
+  Core<T>             m_core;
+  std::vector<block>  m_blocks;
+
+  //no copies, the blocks point into m_core
+  core_arena(const core_arena<T>& other);
+  core_arena<T>& operator= (const core_arena<T>& other);
+
+  public:
+  core_arena(const long n) : m_core(n) {}
+  core_arena(const long n, T* ptr) : m_core(n,ptr) {}
+
+  long size() const {return m_core.size();}
+  long nfree() const {return m_core.nfree();}
+  size_t nblocks() const {return m_blocks.size();}
+
+  T* allocate(const size_t ALIGN, const size_t n)
+  {
+    block b;
+    b.freed = false;
+    if (ALIGN > sizeof(T))
+    {
+      b.ptr  = m_core.aligned_checkout((long) ALIGN,(long) n);
+      b.nelm = (long) (n + ALIGN/sizeof(T));
+    } else {
+      b.ptr  = m_core.checkout((long) n);
+      b.nelm = (long) n;
+    }
+    m_blocks.push_back(b);
+    return b.ptr;
+  }
+
+  void deallocate(T* ptr, const size_t n)
+  {
+    size_t i = m_blocks.size();
+    while (i > 0 && (m_blocks[i-1].ptr != ptr || m_blocks[i-1].freed)) i--;
+    if (i == 0)
+    {
+      printf("ERROR libj::core_arena::deallocate \n");
+      printf("pointer %p was not allocated from this arena \n",(void*) ptr);
+      exit(1);
+    }
+    m_blocks[i-1].freed = true;
+
+    //give back everything freed at the top
+    while (!m_blocks.empty() && m_blocks.back().freed)
+    {
+      m_core.remove(m_blocks.back().nelm);
+      m_blocks.pop_back();
+    }
+  }
+};
+
+}//end of namespace
+
+#endif
@@ -0,0 +1,235 @@
+/*-------------------------------------------------------
+  core_bytes.hpp
+	JHT, October 14, 2026 : created
+
+  (CORE) (BYTES) : a linear memory manager over bytes, which
+  hands out any type from one slab with a bump pointer. A code
+  path that needs double tensors and int index arrays sizes
+  one slab for both, and the slack of one is free for the
+  other.
+
+  Code that takes a Core<T> gets one with typed<T>(n), which is
+  a Core assigned to a part of the slab, as Core::region.
+
+  INITIALIZATION
+  --------------------------
+  libj::core_bytes B;			//empty
+  libj::core_bytes B(bytes);		//allocate, global huge page mode
+  libj::core_bytes B(bytes,ptr);	//assign to existing memory
+  B.allocate(bytes);
+  B.allocate(bytes,libj::LIBJ_PAGES_2M);
+  B.deallocate();
+  B.assign(bytes,ptr);
+  B.unassign();
+
+  SIZING
+  --------------------------
+  size_t n = libj::core_bytes::bytes<double>(nd,64)	//most bytes a
+           + libj::core_bytes::bytes<int>(ni);		//  checkout takes
+
+  RESERVING DATA
+  --------------------------
+  double* X = B.checkout<double>(n,64);	//n doubles, 64 byte aligned
+  int*    I = B.checkout<int>(m);	//m ints, aligned to int
+  Core<double>& C = B.typed<double>(n);	//n doubles as a Core
+
+  size_t m = B.mark();			//current end of the checkouts
+  B.rewind(m);				//gives back everything since m
+  {
+    libj::core_bytes_scope S(B);	//rewinds when S goes out of scope
+  }
+
+  INFORMATION
+  --------------------------
+  B.size();		//bytes in the slab
+  B.nfree();		//free bytes
+  B.high_water();	//most bytes in use at once
+  B.is_set();		//true if allocated or assigned
+
+--------------------------------------------------------*/
+#ifndef CORE_BYTES_HPP
+#define CORE_BYTES_HPP
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <vector>
+#include "core.hpp"
+#include "huge_pages.hpp"
+
+namespace libj
+{
+
+class core_bytes
+{
+  private:
+  char*                 m_buf;		//start of the slab
+  size_t                m_len;		//bytes in the slab
+  size_t                m_next;		//offset of the next free byte
+  size_t                m_hwm;		//high water mark
+  bool                  m_allocated;
+  bool                  m_assigned;
+
+  //the typed Cores, which are deleted when rewound past
+  struct typed_t
+  {
+    size_t start;			//mark before the Core
+    void*  core;			//the Core<T>
+    void   (*destroy)(void*);		//deletes the Core<T>
+  };
+  std::vector<typed_t> m_typed;
+
+  template <typename T>
+  static void m_destroy(void* core) {delete (Core<T>*) core;}
+
+  //no copies, the checkouts point into m_buf
+  core_bytes(const core_bytes& other);
+  core_bytes& operator= (const core_bytes& other);
+
+  void m_set(char* buf, const size_t bytes)
+  {
+    m_buf  = buf;
+    m_len  = bytes;
+    m_next = 0;
+    m_hwm  = 0;
+  }
+
+  void m_error(const char* name, const char* msg) const
+  {
+    printf("ERROR libj::core_bytes::%s \n",name);
+    printf("%s \n",msg);
+    exit(1);
+  }
+
+  public:
+  core_bytes() : m_buf(NULL), m_len(0), m_next(0), m_hwm(0),
+                 m_allocated(false), m_assigned(false) {}
+  core_bytes(const size_t bytes) : m_buf(NULL), m_len(0), m_next(0), m_hwm(0),
+                                   m_allocated(false), m_assigned(false)
+    {allocate(bytes);}
+  core_bytes(const size_t bytes, void* ptr) : m_buf(NULL), m_len(0), m_next(0), m_hwm(0),
+                                              m_allocated(false), m_assigned(false)
+    {assign(bytes,ptr);}
+  ~core_bytes()
+  {
+    if (m_allocated) {deallocate();}
+    else if (m_assigned) {unassign();}
+  }
+
+  //most bytes a checkout of n elements aligned to ALIGN can take
+  template <typename T>
+  static size_t bytes(const size_t n, const size_t ALIGN=alignof(T))
+  {
+    return n*sizeof(T) + ((ALIGN > 1) ? ALIGN - 1 : 0);
+  }
+
+  size_t size() const {return m_len;}
+  size_t nfree() const {return m_len - m_next;}
+  size_t mark() const {return m_next;}
+  size_t high_water() const {return m_hwm;}
+  bool   is_set() const {return m_allocated || m_assigned;}
+
+  void allocate(const size_t bytes) {allocate(bytes,libj::huge_pages());}
+  void allocate(const size_t bytes, const libj::huge_page_mode mode)
+  {
+    if (is_set() || bytes == 0) m_error("allocate","already set, or zero bytes");
+    char* buf = (char*) libj::huge_alloc(bytes,64,mode);
+    if (buf == NULL) m_error("allocate","could not allocate the slab");
+    m_set(buf,bytes);
+    m_allocated = true;
+  }
+
+  void assign(const size_t bytes, void* ptr)
+  {
+    if (is_set() || ptr == NULL) m_error("assign","already set, or NULL memory");
+    m_set((char*) ptr,bytes);
+    m_assigned = true;
+  }
+
+  void deallocate()
+  {
+    if (!m_allocated) m_error("deallocate","not allocated");
+    rewind(0);
+    libj::huge_free(m_buf);
+    m_set(NULL,0);
+    m_allocated = false;
+  }
+
+  void unassign()
+  {
+    if (!m_assigned) m_error("unassign","not assigned");
+    rewind(0);
+    m_set(NULL,0);
+    m_assigned = false;
+  }
+
+  //n elements of T, aligned to ALIGN bytes
+  template <typename T>
+  T* checkout(const size_t n, const size_t ALIGN=alignof(T))
+  {
+    if (!is_set()) m_error("checkout","unallocated or unassigned");
+    const size_t align = (ALIGN > 0) ? ALIGN : 1;
+    const size_t off   = ((uintptr_t) (m_buf + m_next))%align;
+    const size_t start = m_next + ((off != 0) ? align - off : 0);
+    if (start > m_len || n*sizeof(T) > m_len - start)
+    {
+      printf("ERROR libj::core_bytes::checkout \n");
+      printf("%zu bytes do not fit, %zu of %zu are used \n",n*sizeof(T),m_next,m_len);
+      exit(1);
+    }
+    m_next = start + n*sizeof(T);
+    if (m_next > m_hwm) m_hwm = m_next;
+    return (T*) (m_buf + start);
+  }
+
+  //n elements of T as a Core, kept until rewound past
+  template <typename T>
+  Core<T>& typed(const long n, const size_t ALIGN=64)
+  {
+    typed_t t;
+    t.start   = mark();
+    T* ptr    = checkout<T>((size_t) n,ALIGN);
+    t.core    = (void*) new Core<T>(n,ptr);
+    t.destroy = &m_destroy<T>;
+    m_typed.push_back(t);
+    return *(Core<T>*) t.core;
+  }
+
+  //gives back everything checked out since mark m
+  void rewind(const size_t m)
+  {
+    if (m > m_next) m_error("rewind","mark is past the end of the checkouts");
+    while (!m_typed.empty() && m_typed.back().start >= m)
+    {
+      m_typed.back().destroy(m_typed.back().core);
+      m_typed.pop_back();
+    }
+    m_next = m;
+  }
+
+  void reset_high_water() {m_hwm = m_next;}
+};
+
+/*-------------------------------------------------------
+  core_bytes_scope
+    - rewinds a core_bytes to where it was when the
+      scope was made
+-------------------------------------------------------*/
+class core_bytes_scope
+{
+  private:
+  core_bytes& m_core;
+  size_t      m_mark;
+
+  core_bytes_scope(const core_bytes_scope& other);
+  core_bytes_scope& operator= (const core_bytes_scope& other);
+
+  public:
+  core_bytes_scope(core_bytes& core) : m_core(core), m_mark(core.mark()) {}
+ ~core_bytes_scope() {m_core.rewind(m_mark);}
+  size_t mark() const {return m_mark;}
+};
+
+}//end of namespace
+
+#endif
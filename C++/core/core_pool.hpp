@@ -0,0 +1,205 @@
+/*-------------------------------------------------------
+  core_pool.hpp
+	JHT, October 14, 2026 : created
+
+  (CORE) (POOL) : one core_arena per OpenMP thread, so
+  that threads can take scratch memory without any
+  synchronization. The arena of a thread is created the
+  first time that thread calls local(), so it is only
+  made for the threads that need one.
+
+  The NUMA mode decides where the pages of each arena go
+    CORE_NUMA_NONE   : malloc, pages go wherever they are
+                       first touched
+    CORE_NUMA_TOUCH  : the owning thread touches every
+                       page when the arena is made, so on
+                       first-touch systems it is local
+    CORE_NUMA_BIND   : as TOUCH, but the pages are also
+                       bound to the node of the owning
+                       thread with mbind (linux only,
+                       falls back to TOUCH elsewhere)
+
+  For one arena shared by all threads, see
+  core_shared_arena.hpp.
+
+  numa_first_touch() does the same for a large buffer that
+  is shared by all threads, zeroing it with a static
+  OpenMP loop so each thread's chunk is on its socket.
+
+  INITIALIZATION
+  --------------------------
+  libj::core_pool<double> P(n);			//n elements per thread
+  libj::core_pool<double> P(n,libj::CORE_NUMA_BIND);
+
+  USAGE
+  --------------------------
+  #pragma omp parallel
+  {
+    libj::tensor<double> T;
+    T.set_allocator(&P.local());
+    T.aligned_allocate(64,100,100);
+  }
+
+  FUNCTIONS
+  --------------------------
+  P.local();		//arena of this thread, made if needed
+  P.nthreads();		//number of arenas
+  P.is_made(t);		//true if the arena of thread t exists
+
+--------------------------------------------------------*/
+#ifndef CORE_POOL_HPP
+#define CORE_POOL_HPP
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "core_arena.hpp"
+#include "mem_registry.hpp"
+
+#if defined (_OPENMP)
+  #include <omp.h>
+#endif
+
+#if defined (__linux__)
+  #include <unistd.h>
+  #include <sys/syscall.h>
+#endif
+
+namespace libj
+{
+
+enum core_numa {CORE_NUMA_NONE = 0, CORE_NUMA_TOUCH = 1, CORE_NUMA_BIND = 2};
+
+/*-------------------------------------------------------
+  numa_bind_local
+	binds the pages of [ptr,ptr+bytes) to the NUMA node
+	of the calling thread. ptr must be page aligned.
+	Returns false if this is not supported
+-------------------------------------------------------*/
+inline bool numa_bind_local(void* ptr, const size_t bytes)
+{
+#if defined (__linux__) && defined (SYS_mbind) && defined (SYS_getcpu)
+  unsigned cpu = 0, node = 0;
+  if (syscall(SYS_getcpu,&cpu,&node,NULL) != 0) return false;
+  const unsigned long NBITS = 8*sizeof(unsigned long);
+  if (node >= 16*NBITS) return false;
+  unsigned long mask[16] = {0};
+  mask[node/NBITS] = 1UL << (node%NBITS);
+  const int MPOL_BIND_ = 2;
+  return syscall(SYS_mbind,ptr,bytes,MPOL_BIND_,mask,16*NBITS,0) == 0;
+#else
+  return false;
+#endif
+}
+
+/*-------------------------------------------------------
+  numa_first_touch
+	zero n elements of a shared buffer in parallel, with
+	the static schedule used by the jblis loops
+-------------------------------------------------------*/
+template <typename T>
+void numa_first_touch(T* ptr, const size_t n)
+{
+  const long N = (long) n;
+  #pragma omp parallel for schedule(static)
+  for (long i=0;i<N;i++) ptr[i] = (T) 0;
+}
+
+template <typename T>
+class core_pool
+{
+  private:
+  long                          m_nelm;	//elements per arena
+  core_numa                     m_numa;	//NUMA mode
+  size_t                        m_page;	//page size in bytes
+  std::vector<core_arena<T>*>   m_arenas;	//arena of each thread
+  std::vector<void*>            m_mem;	//memory of each arena
+
+  //no copies
+  core_pool(const core_pool<T>& other);
+  core_pool<T>& operator= (const core_pool<T>& other);
+
+  //make the arena of thread t, from that thread
+  void m_make(const size_t t)
+  {
+    const size_t bytes = ((m_nelm*sizeof(T) + m_page - 1)/m_page)*m_page;
+    void* mem = NULL;
+    if (posix_memalign(&mem,m_page,bytes) != 0 || mem == NULL)
+    {
+      printf("ERROR libj::core_pool::local \n");
+      printf("could not allocate %zu bytes for thread %zu \n",bytes,t);
+      exit(1);
+    }
+    if (m_numa == CORE_NUMA_BIND) numa_bind_local(mem,bytes);
+    if (m_numa != CORE_NUMA_NONE)
+    {
+      //one write per page is enough to place it
+      char* c = (char*) mem;
+      for (size_t b=0;b<bytes;b+=m_page) c[b] = 0;
+    }
+    libj::mem_track(mem,bytes);
+    m_mem[t]    = mem;
+    m_arenas[t] = new core_arena<T>(m_nelm,(T*) mem);
+  }
+
+  public:
+  core_pool(const long n, const core_numa numa = CORE_NUMA_TOUCH)
+  {
+    if (n < 1)
+    {
+      printf("ERROR libj::core_pool \n");
+      printf("arenas must have at least one element, n = %ld \n",n);
+      exit(1);
+    }
+    m_nelm = n;
+    m_numa = numa;
+  #if defined (__linux__)
+    const long page = sysconf(_SC_PAGESIZE);
+    m_page = (page > 0) ? (size_t) page : 4096;
+  #else
+    m_page = 4096;
+  #endif
+  #if defined (_OPENMP)
+    const size_t NT = (size_t) omp_get_max_threads();
+  #else
+    const size_t NT = 1;
+  #endif
+    m_arenas.assign(NT,NULL);
+    m_mem.assign(NT,NULL);
+  }
+
+  ~core_pool()
+  {
+    for (size_t t=0;t<m_arenas.size();t++)
+    {
+      if (m_arenas[t] != NULL) delete m_arenas[t];
+      if (m_mem[t] != NULL) {libj::mem_untrack(m_mem[t]); free(m_mem[t]);}
+    }
+  }
+
+  size_t nthreads() const {return m_arenas.size();}
+  bool is_made(const size_t t) const {return m_arenas[t] != NULL;}
+
+  //arena of the calling thread. Each thread only touches its own slot
+  core_arena<T>& local()
+  {
+  #if defined (_OPENMP)
+    const size_t t = (size_t) omp_get_thread_num();
+  #else
+    const size_t t = 0;
+  #endif
+    if (t >= m_arenas.size())
+    {
+      printf("ERROR libj::core_pool::local \n");
+      printf("thread %zu is past the %zu arenas of the pool \n",t,m_arenas.size());
+      exit(1);
+    }
+    if (m_arenas[t] == NULL) m_make(t);
+    return *m_arenas[t];
+  }
+};
+
+}//end of namespace
+
+#endif
@@ -0,0 +1,155 @@
+/*-------------------------------------------------------
+  core_shared_arena.hpp
+	JHT, October 14, 2026 : created
+
+  (CORE) (SHARED) (ARENA) : a libj::allocator over one
+  Core that any number of threads can take memory from
+  at once, without a mutex. The bump pointer is an
+  atomic offset, moved past each aligned block with a
+  compare and swap, so a checkout is a few atomic ops
+  and no thread is bound to a part of the Core.
+
+  Blocks are not given back one by one. deallocate only
+  counts them, and the whole arena is given back with
+  reset(), which must be called by one thread while no
+  other thread uses the arena, e.g. between barriers.
+  This is for one large slab shared by irregular tasks,
+  where a core_pool would hold the largest task's
+  scratch in every thread.
+
+  INITIALIZATION
+  --------------------------
+  libj::core_shared_arena<double> A(n);	    //n elements, via Core
+  libj::core_shared_arena<double> A(n,ptr); //in existing memory
+
+  USAGE
+  --------------------------
+  #pragma omp parallel
+  {
+    #pragma omp for schedule(dynamic)
+    for (long t=0;t<ntask;t++)
+    {
+      double* X = A.allocate(64,task_size(t));
+      ...
+    }
+    #pragma omp barrier
+    #pragma omp single
+    A.reset();
+  }
+
+  FUNCTIONS
+  --------------------------
+  A.allocate(ALIGN,n);	  //n elements aligned to ALIGN, exits if full
+  A.try_allocate(ALIGN,n); //the same, but NULL if full
+  A.reset();		  //gives back every block
+  A.size();		  //elements in the arena
+  A.used();		  //elements checked out since the reset
+  A.nlive();		  //blocks not yet deallocated
+  A.high_water();	  //most elements used before a reset
+
+--------------------------------------------------------*/
+#ifndef CORE_SHARED_ARENA_HPP
+#define CORE_SHARED_ARENA_HPP
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <atomic>
+#include "core.hpp"
+#include "allocator.hpp"
+
+namespace libj
+{
+
+template <typename T>
+class core_shared_arena : public libj::allocator<T>
+{
+  private:
+  Core<T>             m_core;
+  T*                  m_base;
+  long                m_size;
+  alignas(64) std::atomic<long> m_next;	//offset of the next free element
+  alignas(64) std::atomic<long> m_live;	//blocks not yet deallocated
+  alignas(64) std::atomic<long> m_hwm;	//high water mark
+
+  //no copies, the blocks point into m_core
+  core_shared_arena(const core_shared_arena<T>& other);
+  core_shared_arena<T>& operator= (const core_shared_arena<T>& other);
+
+  void m_init()
+  {
+    m_base = &m_core[0];
+    m_size = m_core.size();
+    m_next.store(0);
+    m_live.store(0);
+    m_hwm.store(0);
+  }
+
+  public:
+  core_shared_arena(const long n) : m_core(n) {m_init();}
+  core_shared_arena(const long n, T* ptr) : m_core(n,ptr) {m_init();}
+
+  long size() const {return m_size;}
+  long used() const {return m_next.load(std::memory_order_relaxed);}
+  long nlive() const {return m_live.load(std::memory_order_relaxed);}
+  long high_water() const {return m_hwm.load(std::memory_order_relaxed);}
+
+  //n elements aligned to ALIGN bytes, or NULL if they do not fit
+  T* try_allocate(const size_t ALIGN, const size_t n)
+  {
+    if (ALIGN > sizeof(T) && ALIGN%sizeof(T) != 0)
+    {
+      printf("ERROR libj::core_shared_arena::allocate \n");
+      printf("alignment of %zu bytes is not a multiple of the %zu byte elements \n",
+             ALIGN,sizeof(T));
+      exit(1);
+    }
+    long cur = m_next.load(std::memory_order_relaxed);
+    long start, end;
+    do
+    {
+      start = cur;
+      if (ALIGN > sizeof(T))
+      {
+        const size_t off = ((uintptr_t) (m_base+cur))%ALIGN;
+        if (off != 0) start += (long) ((ALIGN - off)/sizeof(T));
+      }
+      end = start + (long) n;
+      if (end > m_size) return NULL;
+    } while (!m_next.compare_exchange_weak(cur,end,std::memory_order_relaxed));
+
+    m_live.fetch_add(1,std::memory_order_relaxed);
+    long hwm = m_hwm.load(std::memory_order_relaxed);
+    while (end > hwm && !m_hwm.compare_exchange_weak(hwm,end,std::memory_order_relaxed)) {}
+    return m_base + start;
+  }
+
+  T* allocate(const size_t ALIGN, const size_t n)
+  {
+    T* ptr = try_allocate(ALIGN,n);
+    if (ptr == NULL)
+    {
+      printf("ERROR libj::core_shared_arena::allocate \n");
+      printf("%zu elements do not fit, %ld of %ld are used \n",n,used(),m_size);
+      exit(1);
+    }
+    return ptr;
+  }
+
+  //the memory is only given back by reset
+  void deallocate(T* ptr, const size_t n)
+  {
+    m_live.fetch_sub(1,std::memory_order_relaxed);
+  }
+
+  //gives back every block. No other thread may use the arena
+  void reset()
+  {
+    m_next.store(0,std::memory_order_relaxed);
+    m_live.store(0,std::memory_order_relaxed);
+  }
+};
+
+}//end of namespace
+
+#endif
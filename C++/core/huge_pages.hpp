@@ -0,0 +1,235 @@
+/*-------------------------------------------------------
+  huge_pages.hpp
+	JHT, October 14, 2026 : created
+
+  Huge page backed allocation. Large tensors and Cores
+  on 4 KB pages spend a lot of time in TLB misses; with
+  2 MB or 1 GB pages a few TLB entries cover the whole
+  buffer. The page modes are
+    LIBJ_PAGES_NONE : malloc, the usual 4 KB pages
+    LIBJ_PAGES_THP  : mmap + madvise(MADV_HUGEPAGE), the
+                      kernel backs it with transparent
+                      huge pages when it can
+    LIBJ_PAGES_2M   : mmap(MAP_HUGETLB) with 2 MB pages
+    LIBJ_PAGES_1G   : mmap(MAP_HUGETLB) with 1 GB pages
+
+  Each mode falls back to the next smaller one if the
+  pages are not there (no hugetlbfs pages reserved, not
+  linux, ...), ending with malloc, so asking for huge
+  pages never fails where malloc would not. Allocations
+  below LIBJ_HUGE_PAGE_MIN bytes always use malloc.
+
+  The mode can be chosen per allocation, with a
+  huge_allocator handle, or globally for every Core and
+  tensor allocated after it is set. The global mode
+  starts from the environment variable LIBJ_HUGE_PAGES
+  ("none", "thp", "2M", or "1G"), and is none otherwise.
+
+  USAGE
+  --------------------------
+  libj::set_huge_pages(libj::LIBJ_PAGES_2M);	//global
+  libj::huge_pages();				//global mode
+
+  libj::huge_allocator<double> H(libj::LIBJ_PAGES_1G);
+  libj::tensor<double> T;
+  T.set_allocator(&H);			//this tensor only
+  T.aligned_allocate(64,n,n,n,n);
+
+  void* p = libj::huge_alloc(bytes,64,libj::LIBJ_PAGES_2M);
+  libj::huge_kind(p);			//pages p really got
+  libj::huge_free(p);
+
+  The mappings are counted in mem_registry.hpp.
+
+--------------------------------------------------------*/
+#ifndef HUGE_PAGES_HPP
+#define HUGE_PAGES_HPP
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <cstddef>
+#include "allocator.hpp"
+#include "mem_registry.hpp"
+
+#if defined (__linux__)
+  #include <sys/mman.h>
+  #if !defined (MAP_HUGE_SHIFT)
+    #define MAP_HUGE_SHIFT 26
+  #endif
+#endif
+
+//smallest allocation, in bytes, that is put on huge pages
+#if !defined (LIBJ_HUGE_PAGE_MIN)
+  #define LIBJ_HUGE_PAGE_MIN (2*1024*1024)
+#endif
+
+namespace libj
+{
+
+enum huge_page_mode {LIBJ_PAGES_NONE = 0, LIBJ_PAGES_THP = 1,
+                     LIBJ_PAGES_2M = 2, LIBJ_PAGES_1G = 3};
+
+//kept just before the pointer we give out
+struct huge_header
+{
+  void*          base;	//start of the malloc or mmap
+  size_t         bytes;	//length of the mapping
+  huge_page_mode kind;	//pages it really got
+};
+
+/*-------------------------------------------------------
+  global mode
+-------------------------------------------------------*/
+inline huge_page_mode huge_pages_from_env()
+{
+  const char* s = getenv("LIBJ_HUGE_PAGES");
+  if (s == NULL) return LIBJ_PAGES_NONE;
+  if (strcmp(s,"thp") == 0 || strcmp(s,"THP") == 0) return LIBJ_PAGES_THP;
+  if (strcmp(s,"2M")  == 0 || strcmp(s,"2m")  == 0) return LIBJ_PAGES_2M;
+  if (strcmp(s,"1G")  == 0 || strcmp(s,"1g")  == 0) return LIBJ_PAGES_1G;
+  return LIBJ_PAGES_NONE;
+}
+
+inline huge_page_mode& huge_pages_ref()
+{
+  static huge_page_mode mode = huge_pages_from_env();
+  return mode;
+}
+
+inline huge_page_mode huge_pages() {return huge_pages_ref();}
+inline void set_huge_pages(const huge_page_mode mode) {huge_pages_ref() = mode;}
+
+/*-------------------------------------------------------
+  huge_alloc
+	bytes of memory aligned to ALIGN bytes, on the
+	largest pages up to mode that we can get
+-------------------------------------------------------*/
+#if defined (__linux__) && defined (MAP_ANONYMOUS)
+inline void* huge_mmap(const size_t bytes, const int flags)
+{
+  void* p = mmap(NULL,bytes,PROT_READ|PROT_WRITE,MAP_PRIVATE|MAP_ANONYMOUS|flags,-1,0);
+  return (p == MAP_FAILED) ? NULL : p;
+}
+#endif
+
+inline void* huge_alloc(const size_t bytes, const size_t ALIGN, const huge_page_mode mode)
+{
+  const size_t align = (ALIGN > sizeof(void*)) ? ALIGN : sizeof(void*);
+  const size_t hdr   = ((sizeof(huge_header) + align - 1)/align)*align;
+  const size_t total = bytes + hdr;
+
+  void*          base = NULL;
+  size_t         len  = total;
+  huge_page_mode kind = LIBJ_PAGES_NONE;
+
+#if defined (__linux__) && defined (MAP_ANONYMOUS)
+  const size_t MB2 = (size_t) 2*1024*1024;
+  const size_t GB1 = (size_t) 1024*1024*1024;
+  if (total >= LIBJ_HUGE_PAGE_MIN)
+  {
+  #if defined (MAP_HUGETLB)
+    if (base == NULL && mode >= LIBJ_PAGES_1G)
+    {
+      len  = ((total + GB1 - 1)/GB1)*GB1;
+      base = huge_mmap(len,MAP_HUGETLB | (30 << MAP_HUGE_SHIFT));
+      kind = LIBJ_PAGES_1G;
+    }
+    if (base == NULL && mode >= LIBJ_PAGES_2M)
+    {
+      len  = ((total + MB2 - 1)/MB2)*MB2;
+      base = huge_mmap(len,MAP_HUGETLB | (21 << MAP_HUGE_SHIFT));
+      kind = LIBJ_PAGES_2M;
+    }
+  #endif
+    if (base == NULL && mode >= LIBJ_PAGES_THP)
+    {
+      //over allocate so the start is on a 2 MB boundary
+      len  = ((total + MB2 - 1)/MB2)*MB2 + MB2;
+      base = huge_mmap(len,0);
+      kind = LIBJ_PAGES_THP;
+      if (base != NULL)
+      {
+        const size_t off = (MB2 - (size_t) base%MB2)%MB2;
+        if (off > 0) munmap(base,off);
+        base = (void*) ((char*) base + off);
+        len -= off;
+      #if defined (MADV_HUGEPAGE)
+        madvise(base,len,MADV_HUGEPAGE);
+      #endif
+      }
+    }
+  }
+#endif
+
+  if (base == NULL)
+  {
+    len  = total;
+    kind = LIBJ_PAGES_NONE;
+    if (posix_memalign(&base,align,total) != 0) base = NULL;
+    if (base == NULL) return NULL;
+  }
+
+  char* ptr = (char*) base + hdr;
+  huge_header* h = (huge_header*) (ptr - sizeof(huge_header));
+  h->base  = base;
+  h->bytes = len;
+  h->kind  = kind;
+  libj::mem_track(ptr,len);
+  return (void*) ptr;
+}
+
+//pages a pointer from huge_alloc really got
+inline huge_page_mode huge_kind(const void* ptr)
+{
+  return ((const huge_header*) ((const char*) ptr - sizeof(huge_header)))->kind;
+}
+
+inline void huge_free(void* ptr)
+{
+  if (ptr == NULL) return;
+  libj::mem_untrack(ptr);
+  const huge_header h = *((huge_header*) ((char*) ptr - sizeof(huge_header)));
+  if (h.kind == LIBJ_PAGES_NONE) {free(h.base); return;}
+#if defined (__linux__) && defined (MAP_ANONYMOUS)
+  munmap(h.base,h.bytes);
+#endif
+}
+
+/*-------------------------------------------------------
+  huge_allocator
+	libj::allocator handle for set_allocator().
+	shared(mode) is the one the tensors use for the
+	global mode
+-------------------------------------------------------*/
+template <typename T>
+class huge_allocator : public libj::allocator<T>
+{
+  private:
+  huge_page_mode m_mode;
+
+  public:
+  huge_allocator(const huge_page_mode mode = LIBJ_PAGES_2M) : m_mode(mode) {}
+
+  huge_page_mode mode() const {return m_mode;}
+
+  T* allocate(const size_t ALIGN, const size_t n)
+  {
+    return (T*) huge_alloc(n*sizeof(T),ALIGN,m_mode);
+  }
+
+  void deallocate(T* ptr, const size_t n) {huge_free((void*) ptr);}
+
+  static huge_allocator<T>& shared(const huge_page_mode mode)
+  {
+    static huge_allocator<T> A[4] = {huge_allocator<T>(LIBJ_PAGES_NONE),
+                                     huge_allocator<T>(LIBJ_PAGES_THP),
+                                     huge_allocator<T>(LIBJ_PAGES_2M),
+                                     huge_allocator<T>(LIBJ_PAGES_1G)};
+    return A[(int) mode];
+  }
+};
+
+}//end of namespace
+
+#endif
@@ -0,0 +1,228 @@
+/*-------------------------------------------------------
+  mem_registry.hpp
+	JHT, October 14, 2026 : created
+
+  Global accounting of the memory libj allocates. The
+  tensors, gemat, usymat, geten3/4, vec, Core, core_pool,
+  cache buffers, and huge_alloc report each allocation
+  and free here, so the live bytes, the peak (high-water
+  mark), and the number of allocations are known for the
+  whole process, and for each tag.
+
+  The tag of an allocation is the innermost mem_tag of
+  the thread that made it ("untagged" if none), and it
+  is kept until the memory is freed, whichever thread
+  frees it. Memory a libj::allocator hands out (e.g. a
+  core_arena) is counted once, where the allocator got
+  it from.
+
+  Each allocation and free is a lock and a hash lookup,
+  which is nothing next to the malloc of a tensor. The
+  registry is never destroyed, so objects freed at exit
+  are fine.
+
+  USAGE
+  --------------------------
+  {
+    libj::mem_tag tag("T2");	//until the end of scope
+    libj::tensor<double> T2(no,no,nv,nv);
+  }
+  libj::mem_stats S = libj::mem_total();
+  S.live; S.peak; S.nalloc; S.nfree;	//bytes, counts
+  libj::mem_tag_stats("T2");		//one tag
+  libj::mem_tags();			//all tags
+  libj::mem_reset_peak();		//peaks = live
+  libj::mem_print(stdout);
+
+  libj::mem_track(ptr,bytes);	//new allocators
+  libj::mem_untrack(ptr);
+
+  Over the MPI tasks, see para/pmem.hpp.
+--------------------------------------------------------*/
+#ifndef MEM_REGISTRY_HPP
+#define MEM_REGISTRY_HPP
+
+#include <stdio.h>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace libj
+{
+
+struct mem_stats
+{
+  long long live;	//bytes
+  long long peak;	//bytes
+  long long nalloc;
+  long long nfree;
+};
+
+struct mem_tag_entry
+{
+  std::string tag;
+  mem_stats   stats;
+};
+
+/*-------------------------------------------------------
+  mem_registry
+-------------------------------------------------------*/
+class mem_registry
+{
+  private:
+  struct live_entry {size_t bytes; int tag;};
+
+  std::mutex                                  m_mutex;
+  std::unordered_map<const void*,live_entry>  m_live;
+  std::map<std::string,int>                   m_index;
+  std::vector<std::string>                    m_names;
+  std::vector<mem_stats>                      m_tags;
+  mem_stats                                   m_total;
+
+  mem_registry() {m_total = mem_stats{0,0,0,0};}
+
+  static void m_add(mem_stats& S, const long long bytes)
+  {
+    S.live += bytes;
+    S.nalloc++;
+    if (S.live > S.peak) S.peak = S.live;
+  }
+
+  public:
+  //the registry, never destroyed
+  static mem_registry& get()
+  {
+    static mem_registry* reg = new mem_registry();
+    return *reg;
+  }
+
+  //the tag of this thread, NULL if none
+  static const char*& current_tag()
+  {
+    static thread_local const char* tag = NULL;
+    return tag;
+  }
+
+  void track(const void* ptr, const size_t bytes)
+  {
+    if (ptr == NULL) return;
+    const char* name = current_tag();
+    const std::string tag = (name != NULL) ? name : "untagged";
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::map<std::string,int>::iterator it = m_index.find(tag);
+    int t;
+    if (it == m_index.end())
+    {
+      t = (int) m_names.size();
+      m_index[tag] = t;
+      m_names.push_back(tag);
+      m_tags.push_back(mem_stats{0,0,0,0});
+    } else {
+      t = it->second;
+    }
+    m_live[ptr] = live_entry{bytes,t};
+    m_add(m_total,(long long) bytes);
+    m_add(m_tags[t],(long long) bytes);
+  }
+
+  //pointers that were never tracked are ignored
+  void untrack(const void* ptr)
+  {
+    if (ptr == NULL) return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unordered_map<const void*,live_entry>::iterator it = m_live.find(ptr);
+    if (it == m_live.end()) return;
+    const long long bytes = (long long) it->second.bytes;
+    mem_stats& T = m_tags[it->second.tag];
+    m_live.erase(it);
+    m_total.live -= bytes;
+    m_total.nfree++;
+    T.live -= bytes;
+    T.nfree++;
+  }
+
+  mem_stats total()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_total;
+  }
+
+  mem_stats tag(const char* name)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::map<std::string,int>::const_iterator it = m_index.find(name);
+    return (it == m_index.end()) ? mem_stats{0,0,0,0} : m_tags[it->second];
+  }
+
+  //by name
+  std::vector<mem_tag_entry> tags()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<mem_tag_entry> all;
+    for (std::map<std::string,int>::const_iterator it=m_index.begin();it!=m_index.end();it++)
+    {
+      all.push_back(mem_tag_entry{it->first,m_tags[it->second]});
+    }
+    return all;
+  }
+
+  void reset_peak()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_total.peak = m_total.live;
+    for (size_t t=0;t<m_tags.size();t++) {m_tags[t].peak = m_tags[t].live;}
+  }
+};
+
+/*-------------------------------------------------------
+  mem_tag
+	sets the tag of this thread until destroyed
+-------------------------------------------------------*/
+class mem_tag
+{
+  private:
+  const char* m_prev;
+
+  public:
+  explicit mem_tag(const char* name)
+  {
+    m_prev = mem_registry::current_tag();
+    mem_registry::current_tag() = name;
+  }
+  ~mem_tag() {mem_registry::current_tag() = m_prev;}
+
+  mem_tag(const mem_tag&) = delete;
+  mem_tag& operator=(const mem_tag&) = delete;
+};
+
+/*-------------------------------------------------------
+  functions
+-------------------------------------------------------*/
+inline void mem_track(const void* ptr, const size_t bytes) {mem_registry::get().track(ptr,bytes);}
+inline void mem_untrack(const void* ptr) {mem_registry::get().untrack(ptr);}
+inline mem_stats mem_total() {return mem_registry::get().total();}
+inline mem_stats mem_tag_stats(const char* name) {return mem_registry::get().tag(name);}
+inline std::vector<mem_tag_entry> mem_tags() {return mem_registry::get().tags();}
+inline void mem_reset_peak() {mem_registry::get().reset_peak();}
+
+inline void mem_print(FILE* fp)
+{
+  const double GB = 1.0/(1024.0*1024.0*1024.0);
+  const mem_stats S = mem_total();
+  const std::vector<mem_tag_entry> T = mem_tags();
+  fprintf(fp,"\nlibj::mem : live %.4f GB, peak %.4f GB, %lld allocations, %lld frees\n",
+          GB*S.live,GB*S.peak,S.nalloc,S.nfree);
+  fprintf(fp,"%-24s %12s %12s %10s %10s\n","tag","live GB","peak GB","nalloc","nfree");
+  for (size_t t=0;t<T.size();t++)
+  {
+    fprintf(fp,"%-24s %12.4f %12.4f %10lld %10lld\n",T[t].tag.c_str(),GB*T[t].stats.live,
+            GB*T[t].stats.peak,T[t].stats.nalloc,T[t].stats.nfree);
+  }
+}
+
+}//end of namespace
+
+#endif
@@ -0,0 +1,173 @@
+/*-------------------------------------------------------
+  task_graph.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for the task_graph, see task_graph.hpp
+--------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include "task_graph.hpp"
+
+namespace libj
+{
+
+/*-------------------------------------------------------
+  m_edge
+	b after a. Nodes are added in order, so a < b
+-------------------------------------------------------*/
+void task_graph::m_edge(const long a, const long b)
+{
+  if (a < 0 || a == b) return;
+  std::vector<long>& next = m_node[a].next;
+  if (!next.empty() && next.back() == b) return;
+  next.push_back(b);
+  m_node[b].nprev++;
+}
+
+/*-------------------------------------------------------
+  add
+-------------------------------------------------------*/
+long task_graph::add(std::function<void()> fn, const std::vector<const void*>& reads,
+                     const std::vector<const void*>& writes, const double cost)
+{
+  const long id = (long) m_node.size();
+  node n;
+  n.fn    = std::move(fn);
+  n.cost  = cost;
+  n.path  = cost;
+  n.nprev = 0;
+  m_node.push_back(std::move(n));
+
+  for (size_t k=0;k<reads.size();k++)
+  {
+    std::map<const void*,buffer>::iterator it = m_buffer.find(reads[k]);
+    if (it == m_buffer.end())
+    {
+      buffer b;
+      b.writer = -1;
+      it = m_buffer.insert(std::make_pair(reads[k],b)).first;
+    }
+    m_edge(it->second.writer,id);
+    it->second.readers.push_back(id);
+  }
+  for (size_t k=0;k<writes.size();k++)
+  {
+    std::map<const void*,buffer>::iterator it = m_buffer.find(writes[k]);
+    if (it == m_buffer.end())
+    {
+      buffer b;
+      b.writer = -1;
+      it = m_buffer.insert(std::make_pair(writes[k],b)).first;
+    }
+    buffer& b = it->second;
+    m_edge(b.writer,id);
+    for (size_t r=0;r<b.readers.size();r++) m_edge(b.readers[r],id);
+    b.readers.clear();
+    b.writer = id;
+  }
+  return id;
+}
+
+/*-------------------------------------------------------
+  depend
+-------------------------------------------------------*/
+void task_graph::depend(const long a, const long b)
+{
+  const long n = size();
+  if (a < 0 || b < 0 || a >= n || b >= n || a >= b)
+  {
+    printf("ERROR libj::task_graph::depend \n");
+    printf("node %ld cannot be after node %ld of %ld, nodes go after earlier nodes only \n",b,a,n);
+    exit(1);
+  }
+  m_edge(a,b);
+}
+
+/*-------------------------------------------------------
+  run
+	the ready nodes are a heap on the critical path.
+	The caller is one of the runners
+-------------------------------------------------------*/
+void task_graph::run(task_pool& pool)
+{
+  const long N = size();
+  if (N == 0) return;
+
+  //critical paths, edges only go to later nodes
+  for (long i=N-1;i>=0;i--)
+  {
+    double p = 0;
+    for (size_t k=0;k<m_node[i].next.size();k++) p = std::max(p,m_node[m_node[i].next[k]].path);
+    m_node[i].path = m_node[i].cost + p;
+  }
+
+  std::vector<std::atomic<long> > nprev(N);
+  std::vector<long> ready;
+  for (long i=0;i<N;i++)
+  {
+    nprev[i].store(m_node[i].nprev,std::memory_order_relaxed);
+    if (m_node[i].nprev == 0) ready.push_back(i);
+  }
+  const std::vector<node>& NODE = m_node;
+  auto lower = [&NODE](const long a, const long b)
+  {
+    return NODE[a].path < NODE[b].path || (NODE[a].path == NODE[b].path && a > b);
+  };
+  std::make_heap(ready.begin(),ready.end(),lower);
+  std::mutex mutex;
+  std::atomic<long> left(N);
+
+  auto runner = [&]()
+  {
+    long idle = 0;
+    while (left.load(std::memory_order_acquire) > 0)
+    {
+      long i = -1;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!ready.empty())
+        {
+          std::pop_heap(ready.begin(),ready.end(),lower);
+          i = ready.back();
+          ready.pop_back();
+        }
+      }
+      if (i < 0)
+      {
+        if (pool.run_one()) {idle = 0; continue;}
+        if (++idle % 64 == 0) std::this_thread::yield();
+        continue;
+      }
+
+      m_node[i].fn();
+      const std::vector<long>& next = m_node[i].next;
+      std::vector<long> now;
+      for (size_t k=0;k<next.size();k++)
+      {
+        if (nprev[next[k]].fetch_sub(1,std::memory_order_acq_rel) == 1) now.push_back(next[k]);
+      }
+      if (!now.empty())
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t k=0;k<now.size();k++)
+        {
+          ready.push_back(now[k]);
+          std::push_heap(ready.begin(),ready.end(),lower);
+        }
+      }
+      left.fetch_sub(1,std::memory_order_acq_rel);
+      idle = 0;
+    }
+  };
+
+  task_group G(pool);
+  const long nrun = std::min((long) pool.nthreads(),N);
+  for (long r=1;r<nrun;r++) G.spawn(runner);
+  runner();
+  G.sync();
+}
+
+}//end of namespace
@@ -0,0 +1,103 @@
+/*-------------------------------------------------------
+  task_graph.hpp
+	JHT, October 14, 2026 : created
+
+  (TASK) (GRAPH) : a DAG of operations (jblis contracts,
+  permutes, linal calls, Pfile reads, ...) that is run on
+  a task_pool (see task_pool.hpp), so that independent
+  steps of e.g. a CC iteration run at the same time, in
+  place of one after the other, each under-using the
+  machine.
+
+  Each node is a function, the buffers it reads and
+  writes, and its cost (e.g., the FLOPS of a contract).
+  The edges come from the buffers, in the order the nodes
+  are added, as if they had been run serially
+    read after write   : after the last writer
+    write after read   : after the readers since then
+    write after write  : after the last writer
+  and more can be added with depend(). Buffers are
+  identified by their address, e.g. T.data() of a tensor,
+  so views of one buffer at different addresses are
+  different buffers, and must be ordered by hand.
+
+  run() gives each node its critical path, its cost plus
+  the largest critical path of the nodes after it, and
+  always starts the ready node with the longest, so that
+  the long chains start first and the small independent
+  nodes fill in around them. It takes nthreads() runners
+  of the pool, and returns when every node is done. A
+  runner with nothing ready helps with the pool's other
+  tasks, so nodes may use parallel_for and task_group
+  themselves. The graph is kept, and can be run again.
+
+  USAGE
+  --------------------------
+  libj::task_graph G;
+  G.add([&]{contract(1.0,A,"ijab",B,"abkl",0.0,C,"ijkl");},
+        {A.data(),B.data()},{C.data()},flops_C);
+  G.add([&]{contract(1.0,D,"ijab",B,"abkl",0.0,E,"ijkl");},
+        {D.data(),B.data()},{E.data()},flops_E);	//with the first
+  G.add([&]{pdata.read(...,C.data());},{},{C.data()});	//after the first
+  G.run();					//on task_pool::global()
+
+  FUNCTIONS
+  --------------------------
+  G.add(fn,reads,writes,cost);	//returns the node id
+  G.depend(a,b);		//node b after node a
+  G.run(pool);			//runs the graph on pool
+  G.size();			//number of nodes
+  G.critical_path(a);		//of node a, after run()
+  G.clear();			//removes all nodes
+--------------------------------------------------------*/
+#ifndef TASK_GRAPH_HPP
+#define TASK_GRAPH_HPP
+
+#include <functional>
+#include <map>
+#include <vector>
+#include "task_pool.hpp"
+
+namespace libj
+{
+
+class task_graph
+{
+  private:
+  struct node
+  {
+    std::function<void()> fn;
+    double                cost;
+    double                path;	//critical path
+    std::vector<long>     next;	//nodes after this one
+    long                  nprev;	//nodes before this one
+  };
+  struct buffer
+  {
+    long              writer;	//last writer, -1 if none
+    std::vector<long> readers;	//readers since then
+  };
+
+  std::vector<node>            m_node;
+  std::map<const void*,buffer> m_buffer;
+
+  void m_edge(const long a, const long b);
+
+  public:
+  task_graph() {}
+  task_graph(const task_graph& other) = delete;
+  task_graph& operator= (const task_graph& other) = delete;
+
+  long add(std::function<void()> fn, const std::vector<const void*>& reads,
+           const std::vector<const void*>& writes, const double cost = 1.0);
+  void depend(const long a, const long b);
+  void run(task_pool& pool = task_pool::global());
+
+  long size() const {return (long) m_node.size();}
+  double critical_path(const long a) const {return m_node[a].path;}
+  void clear() {m_node.clear(); m_buffer.clear();}
+};
+
+}//end of namespace
+
+#endif
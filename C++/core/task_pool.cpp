@@ -0,0 +1,388 @@
+/*-------------------------------------------------------
+  task_pool.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for the work stealing task_pool, see
+  task_pool.hpp
+--------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include "task_pool.hpp"
+
+#if defined (_OPENMP)
+  #include <omp.h>
+#endif
+
+#if defined (__linux__)
+  #include <sched.h>
+  #include <pthread.h>
+#endif
+
+namespace libj
+{
+
+//the pool and worker of this thread
+static thread_local task_pool* tl_pool   = NULL;
+static thread_local int        tl_worker = -1;
+static thread_local unsigned   tl_seed   = 0;
+
+//one OpenMP thread for the caller while it runs tasks
+struct pool_omp_serial
+{
+  int nomp;
+  pool_omp_serial() : nomp(1)
+  {
+    #if defined (_OPENMP)
+      nomp = omp_get_max_threads();
+      if (nomp != 1) omp_set_num_threads(1);
+    #endif
+  }
+ ~pool_omp_serial()
+  {
+    #if defined (_OPENMP)
+      if (nomp != 1) omp_set_num_threads(nomp);
+    #endif
+  }
+};
+
+/*-------------------------------------------------------
+  ws_deque
+-------------------------------------------------------*/
+ws_deque::ws_deque() : m_top(0), m_bottom(0)
+{
+  m_array.store(new ws_array(LIBJ_POOL_DEQUE),std::memory_order_relaxed);
+}
+
+ws_deque::~ws_deque()
+{
+  delete m_array.load(std::memory_order_relaxed);
+  for (size_t i=0;i<m_old.size();i++) delete m_old[i];
+}
+
+void ws_deque::push(pool_task* t)
+{
+  const long b = m_bottom.load(std::memory_order_relaxed);
+  const long f = m_top.load(std::memory_order_acquire);
+  ws_array* a  = m_array.load(std::memory_order_relaxed);
+  if (b - f > a->cap - 1)
+  {
+    ws_array* g = new ws_array(2*a->cap);
+    for (long i=f;i<b;i++) g->put(i,a->get(i));
+    m_old.push_back(a);
+    m_array.store(g,std::memory_order_release);
+    a = g;
+  }
+  a->put(b,t);
+  std::atomic_thread_fence(std::memory_order_release);
+  m_bottom.store(b+1,std::memory_order_relaxed);
+}
+
+pool_task* ws_deque::take()
+{
+  const long b = m_bottom.load(std::memory_order_relaxed) - 1;
+  ws_array* a  = m_array.load(std::memory_order_relaxed);
+  m_bottom.store(b,std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  long f = m_top.load(std::memory_order_relaxed);
+  pool_task* t = NULL;
+  if (f <= b)
+  {
+    t = a->get(b);
+    if (f == b)
+    {
+      //the last one, race the thieves for it
+      if (!m_top.compare_exchange_strong(f,f+1,std::memory_order_seq_cst,
+                                         std::memory_order_relaxed)) t = NULL;
+      m_bottom.store(b+1,std::memory_order_relaxed);
+    }
+  } else {
+    m_bottom.store(b+1,std::memory_order_relaxed);
+  }
+  return t;
+}
+
+pool_task* ws_deque::steal()
+{
+  long f = m_top.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  const long b = m_bottom.load(std::memory_order_acquire);
+  if (f >= b) return NULL;
+  ws_array* a  = m_array.load(std::memory_order_acquire);
+  pool_task* t = a->get(f);
+  if (!m_top.compare_exchange_strong(f,f+1,std::memory_order_seq_cst,
+                                     std::memory_order_relaxed)) return NULL;
+  return t;
+}
+
+/*-------------------------------------------------------
+  constructor
+	nthreads <= 0 : LIBJ_POOL_THREADS, else the OpenMP
+	threads, else the hardware threads
+-------------------------------------------------------*/
+task_pool::task_pool(const int nthreads, const bool pin)
+  : m_nwork(0), m_pin(pin), m_nshared(0), m_queued(0), m_asleep(0), m_stop(false)
+{
+  int n = nthreads;
+  if (n <= 0)
+  {
+    const char* s = getenv("LIBJ_POOL_THREADS");
+    if (s != NULL) n = atoi(s);
+  }
+  if (n <= 0)
+  {
+    #if defined (_OPENMP)
+      n = omp_get_max_threads();
+    #else
+      n = (int) std::thread::hardware_concurrency();
+    #endif
+  }
+  if (n < 1) n = 1;
+  m_nwork = n - 1;
+
+  for (int w=0;w<m_nwork;w++) m_deque.push_back(new ws_deque());
+  for (int w=0;w<m_nwork;w++) m_thread.push_back(std::thread(&task_pool::m_worker,this,w));
+}
+
+/*-------------------------------------------------------
+  destructor
+-------------------------------------------------------*/
+task_pool::~task_pool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop.store(true);
+  }
+  m_wake.notify_all();
+  for (size_t w=0;w<m_thread.size();w++) m_thread[w].join();
+  for (size_t w=0;w<m_deque.size();w++)
+  {
+    pool_task* t;
+    while ((t = m_deque[w]->take()) != NULL) delete t;
+    delete m_deque[w];
+  }
+  for (size_t i=0;i<m_shared.size();i++) delete m_shared[i];
+}
+
+/*-------------------------------------------------------
+  global
+	the pool of libj, on first use. LIBJ_POOL_PIN=0
+	leaves the workers unpinned
+-------------------------------------------------------*/
+task_pool& task_pool::global()
+{
+  static task_pool pool(0,getenv("LIBJ_POOL_PIN") == NULL || atoi(getenv("LIBJ_POOL_PIN")) != 0);
+  return pool;
+}
+
+int task_pool::worker_id() const
+{
+  return (tl_pool == this) ? tl_worker : -1;
+}
+
+bool task_pool::run_inline() const
+{
+  if (m_nwork == 0) return true;
+  #if defined (_OPENMP)
+    if (omp_in_parallel()) return true;
+  #endif
+  return false;
+}
+
+/*-------------------------------------------------------
+  m_worker
+	worker w, pinned to the (w+1)th core the process
+	may use, leaving the first to the caller
+-------------------------------------------------------*/
+void task_pool::m_worker(const int w)
+{
+  tl_pool   = this;
+  tl_worker = w;
+  tl_seed   = 2654435761u*(unsigned) (w+1);
+
+  #if defined (_OPENMP)
+    omp_set_num_threads(1);
+  #endif
+
+  #if defined (__linux__) && defined (CPU_SET)
+  if (m_pin)
+  {
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (sched_getaffinity(0,sizeof(mask),&mask) == 0)
+    {
+      std::vector<int> cpus;
+      for (int c=0;c<CPU_SETSIZE;c++) {if (CPU_ISSET(c,&mask)) cpus.push_back(c);}
+      if (cpus.size() > 1)
+      {
+        cpu_set_t one;
+        CPU_ZERO(&one);
+        CPU_SET(cpus[(w+1) % cpus.size()],&one);
+        pthread_setaffinity_np(pthread_self(),sizeof(one),&one);
+      }
+    }
+  }
+  #endif
+
+  long idle = 0;
+  while (!m_stop.load(std::memory_order_acquire))
+  {
+    pool_task* t = m_find(w,tl_seed);
+    if (t != NULL)
+    {
+      m_run(t);
+      idle = 0;
+      continue;
+    }
+    if (++idle < LIBJ_POOL_SPIN)
+    {
+      if (idle % 64 == 0) std::this_thread::yield();
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_asleep.fetch_add(1);
+    while (!m_stop.load() && m_queued.load() <= 0) m_wake.wait(lock);
+    m_asleep.fetch_sub(1);
+    idle = 0;
+  }
+}
+
+/*-------------------------------------------------------
+  m_find
+	own deque, then the shared queue, then steal from
+	random workers
+-------------------------------------------------------*/
+pool_task* task_pool::m_find(const int w, unsigned& seed)
+{
+  pool_task* t = NULL;
+  if (w >= 0) t = m_deque[w]->take();
+  if (t == NULL && m_nshared.load(std::memory_order_acquire) > 0)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_shared.empty())
+    {
+      t = m_shared.front();
+      m_shared.pop_front();
+      m_nshared.fetch_sub(1);
+    }
+  }
+  for (int k=0;t == NULL && k<2*m_nwork;k++)
+  {
+    seed = seed*1664525u + 1013904223u;
+    const int v = (int) ((seed >> 8) % (unsigned) m_nwork);
+    if (v != w) t = m_deque[v]->steal();
+  }
+  if (t != NULL) m_queued.fetch_sub(1);
+  return t;
+}
+
+void task_pool::m_run(pool_task* t)
+{
+  t->fn();
+  t->pending->fetch_sub(1,std::memory_order_release);
+  delete t;
+}
+
+/*-------------------------------------------------------
+  push
+	onto the deque of this worker, or the shared queue,
+	and wake a worker if any sleep
+-------------------------------------------------------*/
+void task_pool::push(std::function<void()> fn, std::atomic<long>* pending)
+{
+  pool_task* t = new pool_task;
+  t->fn      = std::move(fn);
+  t->pending = pending;
+  pending->fetch_add(1,std::memory_order_relaxed);
+
+  const int w = worker_id();
+  if (w >= 0)
+  {
+    m_deque[w]->push(t);
+  } else {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_shared.push_back(t);
+    m_nshared.fetch_add(1);
+  }
+  m_queued.fetch_add(1);
+  if (m_asleep.load() > 0)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_wake.notify_one();
+  }
+}
+
+bool task_pool::run_one()
+{
+  pool_task* t = m_find(worker_id(),tl_seed);
+  if (t == NULL) return false;
+  m_run(t);
+  return true;
+}
+
+/*-------------------------------------------------------
+  wait
+	run tasks until pending is zero. A caller that is
+	not a worker runs them with one OpenMP thread too
+-------------------------------------------------------*/
+void task_pool::wait(const std::atomic<long>& pending)
+{
+  pool_omp_serial serial;
+  long idle = 0;
+  while (pending.load(std::memory_order_acquire) > 0)
+  {
+    if (run_one()) {idle = 0; continue;}
+    if (++idle % 64 == 0) std::this_thread::yield();
+  }
+}
+
+/*-------------------------------------------------------
+  parallel_for
+	the range is halved, and the upper half spawned,
+	down to the grain, so that thieves take the large
+	pieces
+-------------------------------------------------------*/
+static void pool_split(task_group& G, long lo, long hi, const long grain,
+                       const std::function<void(const long lo, const long hi)>& f)
+{
+  while (hi - lo > grain)
+  {
+    const long mid = lo + (hi - lo)/2;
+    const long top = hi;
+    G.spawn([&G,mid,top,grain,&f]() {pool_split(G,mid,top,grain,f);});
+    hi = mid;
+  }
+  f(lo,hi);
+}
+
+void task_pool::parallel_for(const long begin, const long end, const long grain,
+                             const std::function<void(const long lo, const long hi)>& f)
+{
+  if (end <= begin) return;
+  const long g = (grain > 0) ? grain
+               : std::max(1L,(end - begin)/(8L*nthreads()));
+  if (run_inline() || end - begin <= g)
+  {
+    f(begin,end);
+    return;
+  }
+  pool_omp_serial serial;
+  task_group G(*this);
+  pool_split(G,begin,end,g,f);
+  G.sync();
+}
+
+/*-------------------------------------------------------
+  task_group
+-------------------------------------------------------*/
+void task_group::spawn(std::function<void()> fn)
+{
+  if (m_pool->run_inline())
+  {
+    fn();
+    return;
+  }
+  m_pool->push(std::move(fn),&m_pending);
+}
+
+}//end of namespace
@@ -0,0 +1,181 @@
+/*-------------------------------------------------------
+  task_pool.hpp
+	JHT, October 14, 2026 : created
+
+  (TASK) (POOL) : a persistent pool of worker threads
+  with work stealing, for the nested and irregular
+  parallelism that OpenMP regions handle badly (e.g., a
+  Pdata task loop whose tasks call threaded linal).
+
+  Each worker owns a Chase-Lev deque (Le et al., PPoPP
+  2013, for the C++11 atomics). A worker pushes and takes
+  the tasks it spawns at the bottom of its own deque, so
+  they stay hot in its cache, and when it is empty steals
+  the oldest (largest) task from the top of another's.
+  Threads that are not workers put their tasks on a
+  shared queue. A thread waiting in sync() runs tasks
+  until its own are done, so nesting does not deadlock
+  and the caller counts as one of the threads.
+
+  Workers that find nothing spin for LIBJ_POOL_SPIN tries
+  and then sleep, so they do not take cores from OpenMP
+  regions between uses of the pool. To cooperate with
+  OpenMP, so that neither oversubscribes the cores
+    - the pool has omp_get_max_threads() threads, the
+      caller included, unless LIBJ_POOL_THREADS is set
+    - each worker sets omp_set_num_threads(1), as does the
+      caller while it runs tasks, so any threaded
+      simd/linal/jblis inside a task is serial
+    - spawn(), sync() and parallel_for() called inside
+      an OpenMP parallel region run the work inline
+  Workers are pinned to the cores the process may use
+  (linux), the caller's left free, unless LIBJ_POOL_PIN=0.
+  Link with -pthread.
+
+  USAGE
+  --------------------------
+  libj::task_pool& P = libj::task_pool::global();	//made on first use
+  libj::task_pool P(8);				//own pool of 8 threads
+
+  P.parallel_for(0,N,0,[&](const long lo, const long hi)
+  {
+    for (long i=lo;i<hi;i++) work(i);
+  });						//grain 0 : chosen
+
+  libj::task_group G;				//on the global pool
+  G.spawn([&]{left();});
+  G.spawn([&]{right();});
+  G.sync();					//also in ~task_group
+
+  FUNCTIONS
+  --------------------------
+  P.nthreads();		//workers + the caller
+  P.worker_id();	//worker of the calling thread, -1 if none
+  P.run_one();		//runs a ready task, false if none
+--------------------------------------------------------*/
+#ifndef TASK_POOL_HPP
+#define TASK_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//failed tries before an idle worker sleeps
+#if !defined (LIBJ_POOL_SPIN)
+  #define LIBJ_POOL_SPIN 4096
+#endif
+
+//initial tasks per deque, it grows as needed
+#if !defined (LIBJ_POOL_DEQUE)
+  #define LIBJ_POOL_DEQUE 256
+#endif
+
+namespace libj
+{
+
+struct pool_task
+{
+  std::function<void()> fn;
+  std::atomic<long>*    pending;	//of the task_group
+};
+
+/*-------------------------------------------------------
+  ws_deque
+	Chase-Lev deque, push and take by the owner, steal
+	by anyone. Old arrays are kept until destruction,
+	as a thief may still read them
+-------------------------------------------------------*/
+class ws_deque
+{
+  private:
+  struct ws_array
+  {
+    long                     cap;
+    std::atomic<pool_task*>* buf;
+    explicit ws_array(const long c) : cap(c), buf(new std::atomic<pool_task*>[c]) {}
+    ~ws_array() {delete[] buf;}
+    pool_task* get(const long i) const {return buf[i & (cap-1)].load(std::memory_order_relaxed);}
+    void put(const long i, pool_task* t) {buf[i & (cap-1)].store(t,std::memory_order_relaxed);}
+  };
+
+  //top and bottom on their own cache lines, thieves only write top
+  std::atomic<long>      m_top;
+  char                   m_pad0[64];
+  std::atomic<long>      m_bottom;
+  char                   m_pad1[64];
+  std::atomic<ws_array*> m_array;
+  std::vector<ws_array*> m_old;
+
+  public:
+  ws_deque();
+ ~ws_deque();
+  ws_deque(const ws_deque& other) = delete;
+  ws_deque& operator= (const ws_deque& other) = delete;
+
+  void push(pool_task* t);	//owner
+  pool_task* take();		//owner, NULL if empty
+  pool_task* steal();		//anyone, NULL if empty or lost
+};
+
+class task_pool
+{
+  private:
+  int                      m_nwork;	//worker threads
+  bool                     m_pin;	//pin the workers
+  std::vector<ws_deque*>   m_deque;	//deque of each worker
+  std::vector<std::thread> m_thread;	//the workers
+  std::mutex               m_mutex;	//shared queue and sleep
+  std::condition_variable  m_wake;	//sleeping workers
+  std::deque<pool_task*>   m_shared;	//tasks of other threads
+  std::atomic<long>        m_nshared;	//size of m_shared
+  std::atomic<long>        m_queued;	//tasks not yet started
+  std::atomic<int>         m_asleep;	//sleeping workers
+  std::atomic<bool>        m_stop;	//destructor called
+
+  void m_worker(const int w);
+  pool_task* m_find(const int w, unsigned& seed);
+  void m_run(pool_task* t);
+
+  public:
+  explicit task_pool(const int nthreads = 0, const bool pin = true);
+ ~task_pool();
+  task_pool(const task_pool& other) = delete;
+  task_pool& operator= (const task_pool& other) = delete;
+
+  static task_pool& global();
+
+  int nthreads() const {return m_nwork + 1;}
+  int worker_id() const;
+  bool run_inline() const;	//no workers, or in OpenMP
+
+  void push(std::function<void()> fn, std::atomic<long>* pending);
+  bool run_one();
+  void wait(const std::atomic<long>& pending);
+
+  void parallel_for(const long begin, const long end, const long grain,
+                    const std::function<void(const long lo, const long hi)>& f);
+};
+
+class task_group
+{
+  private:
+  task_pool*        m_pool;
+  std::atomic<long> m_pending;
+
+  public:
+  explicit task_group(task_pool& pool = task_pool::global()) : m_pool(&pool), m_pending(0) {}
+ ~task_group() {sync();}
+  task_group(const task_group& other) = delete;
+  task_group& operator= (const task_group& other) = delete;
+
+  void spawn(std::function<void()> fn);
+  void sync() {m_pool->wait(m_pending);}
+};
+
+}//end of namespace
+
+#endif
@@ -1,32 +1,164 @@
 /*----------------------------------------------------------------------
  * debug.hpp
  *  JHT, May 8, 2022 : created
+ *  JHT, October 14, 2026 : added the LIBJ_CHECKED checks, breakpoint
+ *                          no longer waits for input
  *
  * .hpp file containing routines useful for debugging
+ *
+ * Checked builds
+ * --------------------------
+ * With -DLIBJ_CHECKED (see make.config), libj checks
+ *   the indices of the tensor and array operator()   LIBJ_CHECK_BOUNDS
+ *   that the inputs and outputs of the simd and
+ *     linal_gemm kernels do not overlap              LIBJ_CHECK_NOALIAS
+ *   the alignment of the aligned simd kernels        LIBJ_CHECK_ALIGNED
+ *   that linal_gemm writes no NaN or Inf             LIBJ_CHECK_FINITE
+ * and a failed check prints where it failed and aborts, so a debugger
+ * or core file has the stack. Without LIBJ_CHECKED the macros are
+ * empty, and cost nothing in the kernels.
+ *
+ * LIBJ_CHECK(cond,fmt,...)           printf style message
+ * LIBJ_CHECK_BOUNDS(i,n)             0 <= i < n
+ * LIBJ_CHECK_NOALIAS(X,nx,Y,ny)      nx elements of X, ny of Y, disjoint
+ * LIBJ_CHECK_INPLACE(X,nx,Y,ny)      disjoint, or X == Y
+ * LIBJ_CHECK_ALIGNED(X,bytes)
+ * LIBJ_CHECK_FINITE(X,n)             floating point types only
 ----------------------------------------------------------------------*/
 #ifndef LIBJ_DEBUG_HPP
 #define LIBJ_DEBUG_HPP
 
 #include <string>
 #include <stdio.h>
+#include <stdlib.h>
+#include <cmath>
+#include <stdarg.h>
+#include <cstddef>
+#include <complex>
+
+#if defined (LIBJ_CHECKED)
+  #define LIBJ_CHECK(cond,...) \
+    do { if (!(cond)) libj::check_fail(__FILE__,__LINE__,#cond,__VA_ARGS__); } while (0)
+  #define LIBJ_CHECK_BOUNDS(i,n) \
+    LIBJ_CHECK((size_t) (i) < (size_t) (n),"index %s = %ld is not in [0,%ld)",#i,(long) (i),(long) (n))
+  #define LIBJ_CHECK_NOALIAS(X,nx,Y,ny) \
+    libj::check_noalias(X,(size_t) (nx),Y,(size_t) (ny),false,#X,#Y,__FILE__,__LINE__)
+  #define LIBJ_CHECK_INPLACE(X,nx,Y,ny) \
+    libj::check_noalias(X,(size_t) (nx),Y,(size_t) (ny),true,#X,#Y,__FILE__,__LINE__)
+  #define LIBJ_CHECK_ALIGNED(X,bytes) \
+    LIBJ_CHECK(((size_t) (X)) % (size_t) (bytes) == 0,"%s = %p is not aligned to %d bytes", \
+               #X,(const void*) (X),(int) (bytes))
+  #define LIBJ_CHECK_FINITE(X,n) \
+    libj::check_finite(X,(long) (n),#X,__FILE__,__LINE__)
+#else
+  #define LIBJ_CHECK(cond,...) do {} while (0)
+  #define LIBJ_CHECK_BOUNDS(i,n) do {} while (0)
+  #define LIBJ_CHECK_NOALIAS(X,nx,Y,ny) do {} while (0)
+  #define LIBJ_CHECK_INPLACE(X,nx,Y,ny) do {} while (0)
+  #define LIBJ_CHECK_ALIGNED(X,bytes) do {} while (0)
+  #define LIBJ_CHECK_FINITE(X,n) do {} while (0)
+#endif
 
 namespace libj
 {
 
-void breakpoint(const std::string& message)
+/*----------------------------------------------------------------------
+ * check_fail
+ *  print the failed check and abort
+----------------------------------------------------------------------*/
+#if defined (__GNUC__)
+__attribute__((format(printf,4,5)))
+#endif
+inline void check_fail(const char* file, const int line, const char* cond, const char* fmt, ...);
+
+inline void check_fail(const char* file, const int line, const char* cond, const char* fmt, ...)
+{
+  va_list args;
+  va_start(args,fmt);
+  fprintf(stderr,"\nERROR libj check failed at %s:%d\n",file,line);
+  fprintf(stderr,"  %s : ",cond);
+  vfprintf(stderr,fmt,args);
+  fprintf(stderr,"\n");
+  va_end(args);
+  fflush(stderr);
+  abort();
+}
+
+/*----------------------------------------------------------------------
+ * check_noalias
+ *  the nx elements of X and ny elements of Y must not overlap, unless
+ *  inplace is true and X == Y
+----------------------------------------------------------------------*/
+template <typename TX, typename TY>
+inline void check_noalias(const TX* X, const size_t nx, const TY* Y, const size_t ny,
+                          const bool inplace, const char* xname, const char* yname,
+                          const char* file, const int line)
+{
+  if (nx == 0 || ny == 0) return;
+  if (inplace && (const void*) X == (const void*) Y) return;
+  const char* xb = (const char*) X;
+  const char* yb = (const char*) Y;
+  const char* xe = xb + nx*sizeof(TX);
+  const char* ye = yb + ny*sizeof(TY);
+  if (xb < ye && yb < xe)
+  {
+    check_fail(file,line,"no alias","%s = [%p,%p) overlaps %s = [%p,%p)",
+               xname,(const void*) xb,(const void*) xe,yname,(const void*) yb,(const void*) ye);
+  }
+}
+
+/*----------------------------------------------------------------------
+ * check_finite
+ *  every element of X must be finite
+----------------------------------------------------------------------*/
+template <typename T>
+inline bool check_isfinite(const T& x) {return std::isfinite(x);}
+
+template <typename T>
+inline bool check_isfinite(const std::complex<T>& x)
+{
+  return std::isfinite(x.real()) && std::isfinite(x.imag());
+}
+
+template <typename T>
+inline void check_finite(const T* X, const long n, const char* name,
+                         const char* file, const int line)
+{
+  for (long i=0;i<n;i++)
+  {
+    if (!check_isfinite(X[i]))
+    {
+      check_fail(file,line,"finite","%s[%ld] is NaN or Inf",name,i);
+    }
+  }
+}
+
+/*----------------------------------------------------------------------
+ * breakpoint
+ *  in checked builds, print the message. With LIBJ_BREAKPOINT=1 in the
+ *  environment, also wait for a 'c' on stdin, as this used to always
+ *  do. Without LIBJ_CHECKED it does nothing
+----------------------------------------------------------------------*/
+inline void breakpoint(const std::string& message)
 {
+  #if defined (LIBJ_CHECKED)
   static int number=0;
-  printf("breakpoint #%d ",number);
-  printf(": %s ",message.c_str());
-  printf("\n continue ? (c) ");
-  char tf='f';
-  while (true) {
-    scanf("%c",&tf);
-    if (tf == 'c') {break;}
+  fprintf(stderr,"breakpoint #%d : %s\n",number,message.c_str());
+  const char* wait = getenv("LIBJ_BREAKPOINT");
+  if (wait != NULL && atoi(wait) != 0)
+  {
+    fprintf(stderr," continue ? (c) ");
+    int tf;
+    while ((tf = getchar()) != EOF) {
+      if (tf == 'c') {break;}
+    }
   }
   number++;
+  #else
+  (void) message;
+  #endif
 }
 
-} //end of namespace 
+} //end of namespace
 
 #endif
@@ -0,0 +1,202 @@
+/*-------------------------------------------------------
+  fbind.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for the C entry points of fbind.hpp
+-------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include <string>
+#include "fbind.hpp"
+#include "simd.hpp"
+#include "linal.hpp"
+#include "jblis.hpp"
+#include "core.hpp"
+
+//-------------------------------------------------------
+// fbind_assign
+//	assigns T to the N dimensions of lengths L of X
+//-------------------------------------------------------
+static void fbind_assign(libj::tensor<double>& T, const int N, const long* L, 
+                         const double* X, const char* opr)
+{
+  if (N <= 0 || L == NULL || X == NULL)
+  {
+    printf("ERROR libj::%s tensor of %d dimensions \n",opr,N);
+    exit(1);
+  }
+  std::vector<size_t> lengths(N);
+  for (int d=0;d<N;d++)
+  {
+    if (L[d] <= 0)
+    {
+      printf("ERROR libj::%s dimension %d has length %ld \n",opr,d,L[d]);
+      exit(1);
+    }
+    lengths[d] = (size_t) L[d];
+  }
+  T.assign((double*) X,lengths);
+}
+
+//-------------------------------------------------------
+// fbind_core
+//	the Core of a handle from libj_core_dcreate
+//-------------------------------------------------------
+static Core<double>& fbind_core(void* core, const char* opr)
+{
+  if (core == NULL)
+  {
+    printf("ERROR libj::%s of a NULL Core \n",opr);
+    exit(1);
+  }
+  return *(Core<double>*) core;
+}
+
+extern "C" {
+
+//-------------------------------------------------------
+// simd
+//-------------------------------------------------------
+double libj_simd_ddot(const long N, const double* X, const double* Y)
+{
+  return simd_par_dot<double>(N,X,Y);
+}
+
+void libj_simd_daxpy(const long N, const double A, const double* X, double* Y)
+{
+  simd_par_axpy<double>(N,A,X,Y);
+}
+
+void libj_simd_dscal(const long N, const double A, double* X)
+{
+  simd_par_scal_mul<double>(N,A,X);
+}
+
+void libj_simd_dcopy(const long N, const double* X, double* Y)
+{
+  simd_par_copy<double>(N,X,Y);
+}
+
+void libj_simd_dzero(const long N, double* X)
+{
+  simd_par_zero<double>(N,X);
+}
+
+float libj_simd_sdot(const long N, const float* X, const float* Y)
+{
+  return simd_par_dot<float>(N,X,Y);
+}
+
+void libj_simd_saxpy(const long N, const float A, const float* X, float* Y)
+{
+  simd_par_axpy<float>(N,A,X,Y);
+}
+
+void libj_simd_sscal(const long N, const float A, float* X)
+{
+  simd_par_scal_mul<float>(N,A,X);
+}
+
+void libj_simd_scopy(const long N, const float* X, float* Y)
+{
+  simd_par_copy<float>(N,X,Y);
+}
+
+void libj_simd_szero(const long N, float* X)
+{
+  simd_par_zero<float>(N,X);
+}
+
+//-------------------------------------------------------
+// linal
+//-------------------------------------------------------
+void libj_linal_dABpC(const int M, const int N, const int K, const double ALPHA, 
+                      double* A, const int LDA, double* B, const int LDB, 
+                      const double BETA, double* C, const int LDC)
+{
+  linal_ABpC<double>(M,N,K,ALPHA,A,LDA,B,LDB,BETA,C,LDC);
+}
+
+void libj_linal_dATBpC(const int M, const int N, const int K, const double ALPHA, 
+                       double* A, const int LDA, double* B, const int LDB, 
+                       const double BETA, double* C, const int LDC)
+{
+  linal_ATBpC<double>(M,N,K,ALPHA,A,LDA,B,LDB,BETA,C,LDC);
+}
+
+void libj_linal_sABpC(const int M, const int N, const int K, const float ALPHA, 
+                      float* A, const int LDA, float* B, const int LDB, 
+                      const float BETA, float* C, const int LDC)
+{
+  linal_ABpC<float>(M,N,K,ALPHA,A,LDA,B,LDB,BETA,C,LDC);
+}
+
+void libj_linal_sATBpC(const int M, const int N, const int K, const float ALPHA, 
+                       float* A, const int LDA, float* B, const int LDB, 
+                       const float BETA, float* C, const int LDC)
+{
+  linal_ATBpC<float>(M,N,K,ALPHA,A,LDA,B,LDB,BETA,C,LDC);
+}
+
+//-------------------------------------------------------
+// jblis
+//-------------------------------------------------------
+void libj_jblis_dcontract(const double alpha, 
+                          const int NA, const long* LA, const double* A, const char* idxA,
+                          const int NB, const long* LB, const double* B, const char* idxB,
+                          const double beta, 
+                          const int NC, const long* LC, double* C, const char* idxC)
+{
+  libj::tensor<double> TA, TB, TC;
+  fbind_assign(TA,NA,LA,A,"jblis_dcontract");
+  fbind_assign(TB,NB,LB,B,"jblis_dcontract");
+  fbind_assign(TC,NC,LC,C,"jblis_dcontract");
+  libj::contract<double>(alpha,TA,std::string(idxA),TB,std::string(idxB),
+                         beta,TC,std::string(idxC));
+}
+
+void libj_jblis_dpermute(const int NA, const long* LA, const double* A, const char* idxA,
+                         const int NB, const long* LB, double* B, const char* idxB,
+                         const double alpha, const double beta)
+{
+  libj::tensor<double> TA, TB;
+  fbind_assign(TA,NA,LA,A,"jblis_dpermute");
+  fbind_assign(TB,NB,LB,B,"jblis_dpermute");
+  libj::permute<double>(TA,std::string(idxA),TB,std::string(idxB),alpha,beta);
+}
+
+//-------------------------------------------------------
+// core arena
+//-------------------------------------------------------
+void* libj_core_dcreate(const long n)
+{
+  return (void*) new Core<double>(n);
+}
+
+void libj_core_ddestroy(void* core)
+{
+  delete (Core<double>*) core;
+}
+
+double* libj_core_dcheckout(void* core, const long n)
+{
+  return fbind_core(core,"core_dcheckout").aligned_checkout(64,n);
+}
+
+long libj_core_dmark(void* core)
+{
+  return fbind_core(core,"core_dmark").mark();
+}
+
+void libj_core_drewind(void* core, const long m)
+{
+  fbind_core(core,"core_drewind").rewind(m);
+}
+
+long libj_core_dnfree(void* core)
+{
+  return fbind_core(core,"core_dnfree").nfree();
+}
+
+}//end extern "C"
@@ -0,0 +1,100 @@
+/*-------------------------------------------------------
+  fbind.hpp
+	JHT, October 14, 2026 : created
+
+  C entry points to the simd, linal and jblis kernels and
+  the Core arena, so that Fortran (through the cbind module 
+  of the fortran tree, which has their ISO_C_BINDING 
+  interfaces) and C can call them. Scalars are by value,
+  arrays by pointer, and everything is column major as 
+  in Fortran, so a section of a dmem DBUF, or any array, 
+  is passed with no copy.
+
+  SIMD (d for double, s for float)
+  --------------------------
+  libj_simd_ddot(N,X,Y);		//X.Y
+  libj_simd_daxpy(N,A,X,Y);		//Y = Y + A*X
+  libj_simd_dscal(N,A,X);		//X = A*X
+  libj_simd_dcopy(N,X,Y);		//Y = X
+  libj_simd_dzero(N,X);			//X = 0
+  These are the simd_par_* kernels, which are threaded 
+  for N >= libj::simd_par_min_n(), serial otherwise
+
+  LINAL (d for double, s for float)
+  --------------------------
+  libj_linal_dABpC(M,N,K,ALPHA,A,LDA,B,LDB,BETA,C,LDC);	//C = ALPHA*A.B + BETA*C
+  libj_linal_dATBpC(M,N,K,ALPHA,A,LDA,B,LDB,BETA,C,LDC);	//C = ALPHA*A^T.B + BETA*C
+
+  JBLIS (double)
+  --------------------------
+  Each tensor is its number of dimensions, its lengths
+  (first fastest, as a Fortran array), its data, and a
+  NULL terminated string of its index labels
+  libj_jblis_dcontract(alpha,NA,LA,A,"abcd",NB,LB,B,"cdef",beta,NC,LC,C,"abef");
+  libj_jblis_dpermute(NA,LA,A,"abcd",NB,LB,B,"dcba",alpha,beta);	//B = alpha*A + beta*B
+
+  CORE ARENA (double)
+  --------------------------
+  void* core = libj_core_dcreate(n);	//a Core<double> of n elements
+  double* X = libj_core_dcheckout(core,n);	//n elements, 64 byte aligned
+  long m = libj_core_dmark(core);	//current end of the checkouts
+  libj_core_drewind(core,m);		//gives back all since m
+  libj_core_dnfree(core);		//free elements
+  libj_core_ddestroy(core);		//frees the Core
+--------------------------------------------------------*/
+#ifndef LIBJ_FBIND_HPP
+#define LIBJ_FBIND_HPP
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//simd
+double libj_simd_ddot(const long N, const double* X, const double* Y);
+void libj_simd_daxpy(const long N, const double A, const double* X, double* Y);
+void libj_simd_dscal(const long N, const double A, double* X);
+void libj_simd_dcopy(const long N, const double* X, double* Y);
+void libj_simd_dzero(const long N, double* X);
+float libj_simd_sdot(const long N, const float* X, const float* Y);
+void libj_simd_saxpy(const long N, const float A, const float* X, float* Y);
+void libj_simd_sscal(const long N, const float A, float* X);
+void libj_simd_scopy(const long N, const float* X, float* Y);
+void libj_simd_szero(const long N, float* X);
+
+//linal
+void libj_linal_dABpC(const int M, const int N, const int K, const double ALPHA, 
+                      double* A, const int LDA, double* B, const int LDB, 
+                      const double BETA, double* C, const int LDC);
+void libj_linal_dATBpC(const int M, const int N, const int K, const double ALPHA, 
+                       double* A, const int LDA, double* B, const int LDB, 
+                       const double BETA, double* C, const int LDC);
+void libj_linal_sABpC(const int M, const int N, const int K, const float ALPHA, 
+                      float* A, const int LDA, float* B, const int LDB, 
+                      const float BETA, float* C, const int LDC);
+void libj_linal_sATBpC(const int M, const int N, const int K, const float ALPHA, 
+                       float* A, const int LDA, float* B, const int LDB, 
+                       const float BETA, float* C, const int LDC);
+
+//jblis
+void libj_jblis_dcontract(const double alpha, 
+                          const int NA, const long* LA, const double* A, const char* idxA,
+                          const int NB, const long* LB, const double* B, const char* idxB,
+                          const double beta, 
+                          const int NC, const long* LC, double* C, const char* idxC);
+void libj_jblis_dpermute(const int NA, const long* LA, const double* A, const char* idxA,
+                         const int NB, const long* LB, double* B, const char* idxB,
+                         const double alpha, const double beta);
+
+//core arena
+void* libj_core_dcreate(const long n);
+void libj_core_ddestroy(void* core);
+double* libj_core_dcheckout(void* core, const long n);
+long libj_core_dmark(void* core);
+void libj_core_drewind(void* core, const long m);
+long libj_core_dnfree(void* core);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -2,7 +2,16 @@
   fsys.cpp
 	JHT, July 2, 2021
 	- implements the functions in fsys.hpp
+	JHT, October 14, 2026 : added the buffering, O_DIRECT, and advice policy
+	JHT, October 14, 2026 : added append, with write combining and a record index
+	JHT, October 14, 2026 : next is seeded from the file size on open
 -------------------------------------------------------*/
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <stdint.h>
+#include <sys/stat.h>
 #include "fsys.hpp"
 
 //-------------------------------------------------------
@@ -16,12 +25,20 @@ fsys::fsys()
   fname.reserve(nres);
   fmode.reserve(nres);
   isopen.reserve(nres);
+  fbuf.reserve(nres);
+  fbufsz.reserve(nres);
+  fdirect.reserve(nres);
+  fadvice.reserve(nres);
+  fcomb.reserve(nres);
+  fcombsz.reserve(nres);
+  frec.reserve(nres);
   nfiles=0;
   nfree=next.capacity();
 }
 
 fsys::~fsys()
 {
+  close_all();
 } 
 
 
@@ -30,36 +47,25 @@ fsys::~fsys()
 //---------------------------------------------------------
 long fsys::add(const std::string fn)
 {
-  //If there are no free files, push new file
-  if (nfree == 0) 
-  {
-    //defaults, since not specified
-    next.push_back(0);
-    fptr.push_back(NULL); 
-    fname.push_back(fn);
-    fmode.push_back("r+b"); 
-    isopen.push_back(false);
-
-    nfiles++;
-    return nfiles;
-  } else 
-  //there are free files, find them
-  {
-    //fid is now file id.  
-    long id=nfiles;
-    next[id] = 0;
-    fptr[id] = NULL; 
-    fname[id] = fn;
-    fmode[id] = "r+b";
-    isopen[id] = false;
-    
-    nfiles++;
-    nfree--;
-   
-    return id;
-  }
- 
+  //defaults, since not specified
+  next.push_back(0);
+  fptr.push_back(NULL); 
+  fname.push_back(fn);
+  fmode.push_back("r+b"); 
+  isopen.push_back(false);
+  fbuf.push_back(NULL);
+  fbufsz.push_back(FSYS_BUFFER_SIZE);
+  fdirect.push_back(false);
+  fadvice.push_back(FSYS_ADVICE_NORMAL);
+  fcomb.push_back(std::vector<char>());
+  fcombsz.push_back(FSYS_COMBINE_SIZE);
+  frec.push_back(std::vector<long>());
+
+  if (nfree > 0) nfree--;
+  nfiles++;
+  return nfiles-1;
 }
+
 //-------------------------------------------------------
 //  print() 
 //    prints the filesystem
@@ -79,6 +85,10 @@ void fsys::print() const
       printf("%s", isopen[id] ? "true \n" : "false \n");
       printf("File pointer      : %p \n",fptr[id]);
       printf("Next offset     : %ld \n",next[id]);
+      printf("Buffer bytes    : %zu \n",fbufsz[id]);
+      printf("Records         : %zu \n",frec[id].size());
+      printf("File is direct  : ");
+      printf("%s", fdirect[id] ? "true \n" : "false \n");
   }
 
   printf("\n");
@@ -97,7 +107,7 @@ void fsys::print() const
 long fsys::get_fid(const std::string fn) const
 {
   long id=0;
-  while (true)
+  while (id < nfiles)
   {
     if (fn == fname[id]) break;
     id++;
@@ -132,6 +142,121 @@ void fsys::set_mode(const std::string fn, const std::string fm)
   fmode[fid] = fm;
 }
 
+//-------------------------------------------------------
+// set_buffer(fn,bytes)
+//	sets the stdio buffer of file fn to bytes, 
+//	aligned to FSYS_ALIGN, from the next open. 
+//	0 keeps the default buffer of stdio
+//-------------------------------------------------------
+void fsys::set_buffer(const std::string fn, const size_t bytes)
+{
+  const long fid=get_fid(fn);
+  fbufsz[fid] = bytes;
+}
+
+//-------------------------------------------------------
+// set_direct(fn,direct)
+//	opens file fn with O_DIRECT, from the next open
+//-------------------------------------------------------
+void fsys::set_direct(const std::string fn, const bool direct)
+{
+  const long fid=get_fid(fn);
+  fdirect[fid] = direct;
+}
+
+//-------------------------------------------------------
+// set_advice(fn,advice)
+//	sets the access advice of file fn, one of 
+//	FSYS_ADVICE_*, given to posix_fadvise on open
+//-------------------------------------------------------
+void fsys::set_advice(const std::string fn, const int advice)
+{
+  const long fid=get_fid(fn);
+  if (advice != FSYS_ADVICE_NORMAL && advice != FSYS_ADVICE_SEQUENTIAL && 
+      advice != FSYS_ADVICE_RANDOM)
+  {
+    printf("fsys : unknown advice %d for file %s \n",advice,fn.c_str());
+    exit(1);
+  }
+  fadvice[fid] = advice;
+}
+
+//-------------------------------------------------------
+// fsys_fopen(fn,fm,direct)
+//	fopen, or with O_DIRECT the open(2) of the same
+//	flags and fdopen. Without O_DIRECT, fopen
+//-------------------------------------------------------
+static FILE* fsys_fopen(const std::string& fn, const std::string& fm, 
+                        const bool direct)
+{
+#if defined (O_DIRECT)
+  if (direct)
+  {
+    int flags;
+    const bool plus = (fm.find('+') != std::string::npos);
+    switch (fm[0])
+    {
+      case 'w': flags = (plus ? O_RDWR : O_WRONLY) | O_CREAT | O_TRUNC; break;
+      case 'a': flags = (plus ? O_RDWR : O_WRONLY) | O_CREAT | O_APPEND; break;
+      default : flags = plus ? O_RDWR : O_RDONLY; break;
+    }
+    const int fd = ::open(fn.c_str(),flags | O_DIRECT,0644);
+    if (fd < 0) return NULL;
+    FILE* fp = fdopen(fd,fm.c_str());
+    if (fp == NULL) ::close(fd);
+    return fp;
+  }
+#endif
+  return fopen(fn.c_str(),fm.c_str());
+}
+
+//-------------------------------------------------------
+// set_policy(id)
+//	applies the buffer and advice of file id, just 
+//	after it is opened. Direct files have no stdio
+//	buffer, as it would only add a copy
+//-------------------------------------------------------
+void fsys::set_policy(const long id)
+{
+  if (fdirect[id])
+  {
+    setvbuf(fptr[id],NULL,_IONBF,0);
+  } else if (fbufsz[id] > 0) {
+    void* buf = NULL;
+    if (posix_memalign(&buf,FSYS_ALIGN,fbufsz[id]) != 0)
+    {
+      printf("fsys could not allocate %zu byte buffer for file %s \n",
+             fbufsz[id],fname[id].c_str());
+      exit(1);
+    }
+    setvbuf(fptr[id],(char*) buf,_IOFBF,fbufsz[id]);
+    fbuf[id] = buf;
+  }
+#if defined (POSIX_FADV_SEQUENTIAL)
+  if (fadvice[id] != FSYS_ADVICE_NORMAL)
+  {
+    const int adv = (fadvice[id] == FSYS_ADVICE_SEQUENTIAL) ? 
+                    POSIX_FADV_SEQUENTIAL : POSIX_FADV_RANDOM;
+    posix_fadvise(fileno(fptr[id]),0,0,adv);
+  }
+#endif
+}
+
+//-------------------------------------------------------
+// release(id)
+//	closes file id, then frees its buffer, which 
+//	fclose may still flush from
+//-------------------------------------------------------
+void fsys::release(const long id)
+{
+  combine_flush(id);
+  fclose(fptr[id]);
+  free(fbuf[id]);
+  fbuf[id] = NULL;
+  isopen[id] = false;
+  fptr[id] = NULL;
+}
+
 //-------------------------------------------------------
 // open(fn,fm)
 //	Opens a file in the filesystem with name fn (string)
@@ -144,11 +269,13 @@ void fsys::open(const std::string fn, const std::string fm)
   //Check that file is not already open
   if (!isopen[id])
   {
-    fptr[id] = fopen(fn.c_str(),fm.c_str());
+    fptr[id] = fsys_fopen(fn,fm,fdirect[id]);
     if (fptr[id] != NULL) 
     {
       isopen[id] = true; 
       fmode[id] = fm;
+      set_policy(id);
+      seed_next(id,fm[0] == 'w');
     } else {
       printf("File %s could not be oppened \n",fn.c_str());
       exit(1); 
@@ -166,12 +293,7 @@ void fsys::close(const std::string fn)
   long id=get_fid(fn);
 
   //Check that file open 
-  if (isopen[id])
-  {
-    fclose(fptr[id]);
-    isopen[id] = false;
-    fptr[id] = NULL;
-  }
+  if (isopen[id]) release(id);
 }
 
 //-------------------------------------------------------
@@ -182,12 +304,7 @@ void fsys::close_all()
 {
   for (long fid=0;fid<nfiles;fid++)
   {
-    if (isopen[fid]) 
-    {
-      fclose(fptr[fid]);
-      isopen[fid] = false;
-      fptr[fid] = NULL;
-    }
+    if (isopen[fid]) release(fid);
   }
 }
 
@@ -201,10 +318,12 @@ void fsys::open_all()
   {
     if (!isopen[fid])
     {
-      fptr[fid] = fopen(fname[fid].c_str(),fmode[fid].c_str());
+      fptr[fid] = fsys_fopen(fname[fid],fmode[fid],fdirect[fid]);
       if (fptr[fid] != NULL) 
       {
         isopen[fid] = true;
+        set_policy(fid);
+        seed_next(fid,fmode[fid][0] == 'w');
       } else {
         printf("Could not open file %s \n",fname[fid].c_str());
         exit(1);
@@ -214,102 +333,453 @@ void fsys::open_all()
 }
 
 //-------------------------------------------------------
-// save()
-//	save the filesystem data to fsys
-//
-//	NOTE : we don't save the file pointers, this is
-//	       probably incorrect anyways
+// check_open(id,opr)
+//	exits if file id is not open
+//-------------------------------------------------------
+void fsys::check_open(const long id, const char* opr) const
+{
+  if (!isopen[id])
+  {
+    printf("fsys : file %s is not open for %s \n",fname[id].c_str(),opr);
+    exit(1);
+  }
+}
+
+//-------------------------------------------------------
+// check_positional(id,opr)
+//	exits if file id is in an "a" mode, where pwrite 
+//	(on Linux) writes at the end, whatever the offset
+//-------------------------------------------------------
+void fsys::check_positional(const long id, const char* opr) const
+{
+  if (fmode[id][0] == 'a')
+  {
+    printf("fsys : file %s is open in mode %s, %s needs w, r+ or w+ \n",
+           fname[id].c_str(),fmode[id].c_str(),opr);
+    exit(1);
+  }
+}
+
+//-------------------------------------------------------
+// seed_next(id,trunc)
+//	next of file id, just opened, is the size of the 
+//	file, so appends go after what it holds. If the 
+//	open truncated it ("w"), its records are gone too
+//-------------------------------------------------------
+void fsys::seed_next(const long id, const bool trunc)
+{
+  struct stat st;
+  next[id] = (fstat(fileno(fptr[id]),&st) == 0) ? (long) st.st_size : 0;
+  if (trunc) frec[id].clear();
+}
+
+//-------------------------------------------------------
+// pio(id,pos,ptr,bytes,isread)
+//	pread or pwrite of bytes at pos of file id, until
+//	all bytes are done. A direct file drops O_DIRECT 
+//	for a transfer that is not aligned to FSYS_ALIGN, 
+//	as the kernel would refuse it
+//-------------------------------------------------------
+long fsys::pio(const long id, const long pos, void* ptr, 
+               const size_t bytes, const bool isread)
+{
+  const int fd = fileno(fptr[id]);
+
+#if defined (O_DIRECT)
+  const bool unaligned = fdirect[id] && 
+    ((long) ptr%FSYS_ALIGN != 0 || pos%FSYS_ALIGN != 0 || bytes%FSYS_ALIGN != 0);
+  const int flags = unaligned ? fcntl(fd,F_GETFL) : 0;
+  if (unaligned) fcntl(fd,F_SETFL,flags & ~O_DIRECT);
+#endif
+
+  size_t done = 0;
+  while (done < bytes)
+  {
+    char* p = (char*) ptr + done;
+    const ssize_t n = isread ? pread(fd,p,bytes-done,pos+done) :
+                               pwrite(fd,p,bytes-done,pos+done);
+    if (n <= 0) break;
+    done += (size_t) n;
+  }
+
+#if defined (O_DIRECT)
+  if (unaligned) fcntl(fd,F_SETFL,flags);
+#endif
+
+  return (long) done;
+}
+
+//-------------------------------------------------------
+// combine_flush(id)
+//	writes the combined records of file id, which end
+//	at next
 //-------------------------------------------------------
-void fsys::save() const
+void fsys::combine_flush(const long id)
 {
-  FILE* fp;
-  fp = fopen("fsys.save","w+b"); //"w" will delete old file for us
-  if (fp != NULL) 
+  std::vector<char>& comb = fcomb[id];
+  if (comb.empty()) return;
+  const long bytes = (long) comb.size();
+  fflush(fptr[id]);
+  if (pio(id,next[id]-bytes,comb.data(),comb.size(),false) != bytes)
   {
-    bool btmp; //annoyingly needed for vector with bools...
-    fwrite(&nfiles,sizeof(nfiles),1,fp); 
-    for (long fid=0;fid<nfiles;fid++)
+    printf("fsys : could not write %ld appended bytes to file %s \n",bytes,
+           fname[id].c_str());
+    exit(1);
+  }
+  comb.clear();
+}
+
+//-------------------------------------------------------
+// transfer(id,pos,ptr,bytes,isread)
+//	positional io of file id. The combined appends and 
+//	the stdio buffer are flushed first, so all views 
+//	agree
+//-------------------------------------------------------
+long fsys::transfer(const long id, const long pos, void* ptr, 
+                    const size_t bytes, const bool isread)
+{
+  check_open(id,isread ? "read" : "write");
+  if (!isread) check_positional(id,"write");
+  combine_flush(id);
+  fflush(fptr[id]);
+  const long done = pio(id,pos,ptr,bytes,isread);
+  if (!isread && pos + done > next[id]) next[id] = pos + done;
+  return done;
+}
+
+//-------------------------------------------------------
+// write(fn,pos,ptr,bytes)
+//	writes bytes from ptr at byte pos of file fn,
+//	without moving its position. Returns the bytes 
+//	written
+//-------------------------------------------------------
+long fsys::write(const std::string fn, const long pos, const void* ptr, 
+                 const size_t bytes)
+{
+  return transfer(get_fid(fn),pos,(void*) ptr,bytes,false);
+}
+
+//-------------------------------------------------------
+// read(fn,pos,ptr,bytes)
+//	reads bytes at byte pos of file fn into ptr,
+//	without moving its position. Returns the bytes 
+//	read
+//-------------------------------------------------------
+long fsys::read(const std::string fn, const long pos, void* ptr, 
+                const size_t bytes)
+{
+  return transfer(get_fid(fn),pos,ptr,bytes,true);
+}
+
+//-------------------------------------------------------
+// append(fid,ptr,bytes)
+//	appends a record of bytes from ptr at next of file
+//	fid, and returns its offset. The record is copied 
+//	into the combine buffer, which is written when it
+//	would overflow. Records as large as the buffer are 
+//	written directly, after the buffer
+//-------------------------------------------------------
+long fsys::append(const long fid, const void* ptr, const size_t bytes)
+{
+  if (fid < 0 || fid >= nfiles)
+  {
+    printf("fsys : no file of id %ld to append to \n",fid);
+    exit(1);
+  }
+  check_open(fid,"append");
+  check_positional(fid,"append");
+  const long off = next[fid];
+  std::vector<char>& comb = fcomb[fid];
+  if (comb.size() + bytes > fcombsz[fid]) combine_flush(fid);
+  if (bytes >= fcombsz[fid])
+  {
+    fflush(fptr[fid]);
+    if (pio(fid,off,(void*) ptr,bytes,false) != (long) bytes)
     {
-      btmp = isopen[fid];
-      fwrite(&next[fid],sizeof(next[fid]),1,fp);
-      fwrite(&fname[fid],sizeof(fname[fid]),1,fp);
-      fwrite(&fmode[fid],sizeof(fmode[fid]),1,fp);
-      fwrite(&btmp,sizeof(bool),1,fp);
+      printf("fsys : could not append %zu bytes to file %s \n",bytes,fname[fid].c_str());
+      exit(1);
     }
   } else {
-    printf("Could not open fsys.save \n");
+    if (comb.capacity() < fcombsz[fid]) comb.reserve(fcombsz[fid]);
+    comb.insert(comb.end(),(const char*) ptr,(const char*) ptr + bytes);
+  }
+  next[fid] = off + (long) bytes;
+  frec[fid].push_back(off);
+  return off;
+}
+
+long fsys::append(const std::string fn, const void* ptr, const size_t bytes)
+{
+  return append(get_fid(fn),ptr,bytes);
+}
+
+//-------------------------------------------------------
+// set_combine(fn,bytes)
+//	sets the combine buffer of append for file fn, 0 
+//	for none. The records already combined are written
+//-------------------------------------------------------
+void fsys::set_combine(const std::string fn, const size_t bytes)
+{
+  const long fid=get_fid(fn);
+  if (isopen[fid]) combine_flush(fid);
+  fcombsz[fid] = bytes;
+  std::vector<char>().swap(fcomb[fid]);
+}
+
+//-------------------------------------------------------
+// flush(fn)
+//	writes the combined records of file fn, and the
+//	stdio buffer
+//-------------------------------------------------------
+void fsys::flush(const std::string fn)
+{
+  const long fid=get_fid(fn);
+  if (!isopen[fid]) return;
+  combine_flush(fid);
+  fflush(fptr[fid]);
+}
+
+//-------------------------------------------------------
+// check_record(id,r)
+//	exits if file id has no record r
+//-------------------------------------------------------
+void fsys::check_record(const long id, const long r) const
+{
+  if (r < 0 || r >= (long) frec[id].size())
+  {
+    printf("fsys : file %s has no record %ld of %zu \n",fname[id].c_str(),r,
+           frec[id].size());
     exit(1);
   }
-  fclose(fp);
 }
 
 //-------------------------------------------------------
-// recover()
-//	recovers the filesystem
+// records(fn), record_offset(fn,r), record_bytes(fn,r)
+//	the index of appended records of file fn
+//-------------------------------------------------------
+long fsys::records(const std::string fn) const
+{
+  return (long) frec[get_fid(fn)].size();
+}
+
+long fsys::record_offset(const std::string fn, const long r) const
+{
+  const long fid=get_fid(fn);
+  check_record(fid,r);
+  return frec[fid][r];
+}
+
+long fsys::record_bytes(const std::string fn, const long r) const
+{
+  const long fid=get_fid(fn);
+  check_record(fid,r);
+  const long end = (r+1 < (long) frec[fid].size()) ? frec[fid][r+1] : next[fid];
+  return end - frec[fid][r];
+}
+
+//-------------------------------------------------------
+// read_record(fn,r,ptr)
+//	reads record r of file fn into ptr, which must 
+//	hold record_bytes(fn,r). Returns the bytes read
+//-------------------------------------------------------
+long fsys::read_record(const std::string fn, const long r, void* ptr)
+{
+  const long fid=get_fid(fn);
+  const long bytes=record_bytes(fn,r);
+  return transfer(fid,frec[fid][r],ptr,(size_t) bytes,true);
+}
+
+//-------------------------------------------------------
+// fsys_put(buf,x) and fsys_get(ptr,end,x)
+//	append x to, or take it from, a save() image
+//-------------------------------------------------------
+template <typename X>
+static void fsys_put(std::string& buf, const X x)
+{
+  buf.append((const char*) &x,sizeof(X));
+}
+
+static void fsys_put(std::string& buf, const std::string& str)
+{
+  fsys_put<int32_t>(buf,(int32_t) str.size());
+  buf.append(str);
+}
+
+template <typename X>
+static bool fsys_get(const char*& ptr, const char* end, X& x)
+{
+  if (end - ptr < (long) sizeof(X)) return false;
+  memcpy(&x,ptr,sizeof(X));
+  ptr += sizeof(X);
+  return true;
+}
+
+static bool fsys_get(const char*& ptr, const char* end, std::string& str)
+{
+  int32_t len;
+  if (!fsys_get<int32_t>(ptr,end,len) || len < 0 || end - ptr < len) return false;
+  str.assign(ptr,len);
+  ptr += len;
+  return true;
+}
+
+//-------------------------------------------------------
+// save(path)
+//	save the filesystem data to path, fsys.save by 
+//	default, in the format of fsys.hpp, after writing
+//	the combined appends. The image is 
+//	built in memory, written to path.tmp in one write,
+//	synced, and renamed over path
 //
-//	This will reopen all files marked as open
+//	NOTE : we don't save the file pointers, this is
+//	       probably incorrect anyways
 //-------------------------------------------------------
-void fsys::recover()
+void fsys::save(const std::string path)
 {
-  FILE* fp;
-  fp = fopen("fsys.save","rb");
-  if (fp != NULL) 
+  for (long fid=0;fid<nfiles;fid++)
   {
-    //get number of files
-    fread(&nfiles,sizeof(nfiles),1,fp);
-   
-    //reserve space if it isn't enough
-    const long cap=next.capacity();
-    const long nt2=2*nfiles;
-    if (cap < nt2 ) 
-    {
-      next.reserve(nt2);
-      fptr.reserve(nt2);
-      fname.reserve(nt2);
-      fmode.reserve(nt2);
-      isopen.reserve(nt2);
-    }
-    //allocate needed memory
-    next.resize(nfiles);
-    fptr.resize(nfiles);
-    fname.resize(nfiles);
-    fmode.resize(nfiles);
-    isopen.reserve(nfiles);
-    
-    //temp variables for vector read/write
-    long                 ltmp;
-    std::string   stmp1,stmp2;
-    bool                 btmp;
-    for (long fid=0;fid<nfiles;fid++)
+    if (isopen[fid]) combine_flush(fid);
+  }
+  std::string buf;
+  buf.append("FSYS",4);
+  fsys_put<int32_t>(buf,FSYS_SAVE_VERSION);
+  fsys_put<int64_t>(buf,nfiles);
+  for (long fid=0;fid<nfiles;fid++)
+  {
+    fsys_put<int64_t>(buf,next[fid]);
+    fsys_put<int64_t>(buf,(int64_t) fbufsz[fid]);
+    fsys_put<int32_t>(buf,fadvice[fid]);
+    fsys_put<int8_t>(buf,fdirect[fid] ? 1 : 0);
+    fsys_put<int8_t>(buf,isopen[fid] ? 1 : 0);
+    fsys_put(buf,fname[fid]);
+    fsys_put(buf,fmode[fid]);
+    fsys_put<int64_t>(buf,(int64_t) frec[fid].size());
+    for (size_t r=0;r<frec[fid].size();r++) {fsys_put<int64_t>(buf,frec[fid][r]);}
+  }
+
+  const std::string tmp = path + ".tmp";
+  FILE* fp = fopen(tmp.c_str(),"wb");
+  if (fp == NULL) 
+  {
+    printf("Could not open %s \n",tmp.c_str());
+    exit(1);
+  }
+  const bool ok = (fwrite(buf.data(),1,buf.size(),fp) == buf.size()) && 
+                  (fflush(fp) == 0) && (fsync(fileno(fp)) == 0);
+  if (fclose(fp) != 0 || !ok || rename(tmp.c_str(),path.c_str()) != 0)
+  {
+    printf("Could not write %s \n",path.c_str());
+    remove(tmp.c_str());
+    exit(1);
+  }
+}
+
+//-------------------------------------------------------
+// recover(path)
+//	recovers the filesystem from path, fsys.save by 
+//	default, read in one read
+//
+//	This will reopen all files marked as open, with 
+//	"w" modes as "r+", so that they keep their data
+//-------------------------------------------------------
+void fsys::recover(const std::string path)
+{
+  FILE* fp = fopen(path.c_str(),"rb");
+  if (fp == NULL) 
+  {
+    printf("Could not recover filesystem from %s \n",path.c_str());
+    exit(1);
+  }
+  fseek(fp,0,SEEK_END);
+  const long bytes = ftell(fp);
+  fseek(fp,0,SEEK_SET);
+  std::string buf(bytes > 0 ? bytes : 0,'\0');
+  const bool read_ok = (bytes > 0) && (fread(&buf[0],1,bytes,fp) == (size_t) bytes);
+  fclose(fp);
+
+  const char* ptr = buf.data();
+  const char* end = ptr + buf.size();
+  int32_t version = 0;
+  int64_t nf = 0;
+  bool ok = read_ok && buf.compare(0,4,"FSYS") == 0;
+  if (ok) ptr += 4;
+  ok = ok && fsys_get(ptr,end,version) && version == FSYS_SAVE_VERSION && 
+       fsys_get(ptr,end,nf) && nf >= 0;
+
+  //close what is open now, the recovered files replace them
+  close_all();
+  std::vector<long> rnext;
+  std::vector<std::string> rname, rmode;
+  std::vector<bool> ropen, rdirect;
+  std::vector<size_t> rbufsz;
+  std::vector<int> radvice;
+  std::vector<std::vector<long> > rrec;
+  for (int64_t fid=0;ok && fid<nf;fid++)
+  {
+    int64_t nx, bsz;
+    int32_t adv;
+    int8_t dir, opn;
+    std::string fn, fm;
+    ok = fsys_get(ptr,end,nx) && fsys_get(ptr,end,bsz) && fsys_get(ptr,end,adv) &&
+         fsys_get(ptr,end,dir) && fsys_get(ptr,end,opn) && fsys_get(ptr,end,fn) &&
+         fsys_get(ptr,end,fm) && !fm.empty();
+    int64_t nrec = 0;
+    ok = ok && fsys_get(ptr,end,nrec) && nrec >= 0 && (end - ptr)/8 >= nrec;
+    if (!ok) break;
+    std::vector<long> rec(nrec);
+    for (int64_t r=0;ok && r<nrec;r++)
     {
-      fread(&ltmp,sizeof(ltmp),1,fp);
-      fread(&stmp1,sizeof(stmp1),1,fp);
-      fread(&stmp2,sizeof(stmp2),1,fp);
-      fread(&btmp,sizeof(btmp),1,fp);
-
-      next[fid] = ltmp;
-      fname[fid] = stmp1;
-      fmode[fid] = stmp2;
-      isopen[fid] = btmp;
+      int64_t x = 0;
+      ok = fsys_get(ptr,end,x);
+      rec[r] = x;
     }
+    if (!ok) break;
+    rrec.push_back(rec);
+    rnext.push_back(nx);
+    rbufsz.push_back((size_t) bsz);
+    radvice.push_back(adv);
+    rdirect.push_back(dir != 0);
+    ropen.push_back(opn != 0);
+    rname.push_back(fn);
+    rmode.push_back(fm);
+  }
+  if (!ok)
+  {
+    printf("Could not recover filesystem from %s, it is not a version %d fsys save \n",
+           path.c_str(),FSYS_SAVE_VERSION);
+    exit(1);
+  }
 
-    //go through and open files that were marked as open
-    for (long fid=0;fid<nfiles;fid++)
-    {
-      if (!isopen[fid]) continue; 
+  nfiles = nf;
+  next.swap(rnext);
+  fname.swap(rname);
+  fmode.swap(rmode);
+  fbufsz.swap(rbufsz);
+  fadvice.swap(radvice);
+  fdirect.swap(rdirect);
+  frec.swap(rrec);
+  fcomb.assign(nfiles,std::vector<char>());
+  fcombsz.assign(nfiles,FSYS_COMBINE_SIZE);
+  isopen.assign(nfiles,false);
+  fptr.assign(nfiles,NULL);
+  fbuf.assign(nfiles,NULL);
+  nfree = 0;
 
-      fptr[fid] = fopen(fname[fid].c_str(),fmode[fid].c_str());
-      if (fptr[fid] == NULL) 
-      {
-        printf("Could not open file %s during recovery \n",fname[fid].c_str());
-        exit(1);
-      }
+  //go through and open files that were marked as open
+  for (long fid=0;fid<nfiles;fid++)
+  {
+    if (!ropen[fid]) continue; 
+
+    std::string fm = fmode[fid];
+    if (fm[0] == 'w') fm = "r" + fm.substr(1) + (fm.find('+') == std::string::npos ? "+" : "");
+    fptr[fid] = fsys_fopen(fname[fid],fm,fdirect[fid]);
+    if (fptr[fid] == NULL) 
+    {
+      printf("Could not open file %s during recovery \n",fname[fid].c_str());
+      exit(1);
     }
-    
-  //Could not open the fsys.save file 
-  } else {
-    printf("Could not recover filesystem from fsys.save \n");
-    exit(1);
+    isopen[fid] = true;
+    set_policy(fid);
+    seed_next(fid,false);
   }
-  fclose(fp);
 }
@@ -1,6 +1,9 @@
 /*-------------------------------------------------------
   fsys.hpp
 	JHT, July 2, 2021
+	JHT, October 14, 2026 : added the buffering, O_DIRECT, and advice policy
+	JHT, October 14, 2026 : save and recover in a portable, atomic format
+	JHT, October 14, 2026 : added append, with write combining and a record index
 
   (F)ile(SYS)tem
     - initializes the filestystem class, which tracks
@@ -30,8 +33,21 @@
 
   SAVE or RECOVER FSYS
   --------------------------
-  fs.save();				//saves current states of fsys to fsys.save
+  fs.save();				//flushes appends, saves current states of fsys to fsys.save
   fs.recover();				//recovers fsys (including openning of files) from fsys.save
+  fs.save("path"); fs.recover("path");	//the same, to and from path
+
+  The snapshot is written to path.tmp and renamed over path, so a 
+  crash leaves either the old or the new one, and is read back in 
+  one read. Files that were open are reopened with their mode, 
+  except that "w" modes are reopened as "r+" so they are not 
+  truncated. The format (little endian on the usual hosts, all 
+  fixed width) is
+
+    "FSYS" version(int32) nfiles(int64)
+    per file : next(int64) buffer(int64) advice(int32) direct(int8)
+               isopen(int8) len(int32) name len(int32) mode
+               nrecords(int64) offsets(int64 x nrecords)
 
   SET INFO
   --------------------------
@@ -42,6 +58,50 @@
   fs.get_fptr("file_name");		//returns FILE* pointer
   fs.get_fid("file_name");		//returns file id (long)
 
+  IO POLICY (set before open, kept over close and open)
+  --------------------------
+  fs.set_buffer("file_name",bytes);	//stdio buffer of bytes, FSYS_BUFFER_SIZE
+					//  by default, aligned to FSYS_ALIGN. 
+					//  0 for the (4-8 KB) default of stdio
+  fs.set_direct("file_name",true);	//O_DIRECT, no page cache or stdio buffer
+  fs.set_advice("file_name",FSYS_ADVICE_SEQUENTIAL);	//or _RANDOM, _NORMAL,
+					//  as posix_fadvise on open
+
+  POSITIONAL IO
+  --------------------------
+  fs.write("file_name",pos,ptr,bytes);	//pwrite at byte pos, returns bytes 
+  fs.read("file_name",pos,ptr,bytes);	//pread at byte pos, returns bytes
+
+  O_DIRECT needs the pointer, position, and bytes to be multiples of 
+  FSYS_ALIGN, which posix_memalign(&ptr,FSYS_ALIGN,bytes) gives. read and 
+  write do the transfers that are not through the page cache, so they 
+  always work, but use them rather than fread/fwrite on a direct file. 
+  On systems without O_DIRECT or posix_fadvise these do nothing.
+
+  APPEND (log structured)
+  --------------------------
+  off = fs.append("file_name",ptr,bytes);	//or fid, writes the record at 
+					//  next, returns its offset
+  fs.set_combine("file_name",bytes);	//write combining buffer, 
+					//  FSYS_COMBINE_SIZE by default
+  fs.flush("file_name");		//write the combined records
+  fs.records("file_name");		//number of records appended
+  fs.record_offset("file_name",r);	//offset of record r
+  fs.record_bytes("file_name",r);	//bytes of record r
+  fs.read_record("file_name",r,ptr);	//read record r, returns bytes
+
+  Appended records are copied into the combine buffer of the file, 
+  which is written in one pwrite when it is full (records larger than 
+  the buffer are written as they are), so many small records make a 
+  few large sequential writes. Each record's offset is kept in the 
+  index, so they can be read back in any order. Reads, positional 
+  writes, close and save write the combined records first. The bytes 
+  of the last record run to next, so positional writes past next 
+  grow it. Opening a file sets next to its size, so appends to a file
+  that already has data go after it ("w" also drops the index, as the
+  file is emptied). append and write need a "w", "r+" or "w+" mode: on
+  an O_APPEND ("a") file pwrite ignores the offset, so they exit.
+
 -------------------------------------------------------*/
 #ifndef FSYS_HPP
 #define FSYS_HPP
@@ -51,6 +111,23 @@
 #include <vector>   //for vector 
 #include <string>   //for string
 
+//default stdio buffer of a file, in bytes
+#define FSYS_BUFFER_SIZE (1L<<20)
+
+//version of the save() format
+#define FSYS_SAVE_VERSION 2
+
+//default write combining buffer of append, in bytes
+#define FSYS_COMBINE_SIZE (4L<<20)
+
+//alignment of the buffers, and of O_DIRECT transfers, in bytes
+#define FSYS_ALIGN 4096
+
+//access advice, as posix_fadvise
+#define FSYS_ADVICE_NORMAL     0
+#define FSYS_ADVICE_SEQUENTIAL 1
+#define FSYS_ADVICE_RANDOM     2
+
 class fsys
 {
 private:
@@ -59,9 +136,28 @@ private:
   std::vector <std::string> fname;  //file names
   std::vector <std::string> fmode;  //file modes
   std::vector <bool>       isopen;  //file open bool 
+  std::vector <void*>        fbuf;  //stdio buffer of an open file
+  std::vector <size_t>    fbufsz;  //bytes of the stdio buffer, 0 for stdio's
+  std::vector <bool>      fdirect;  //open with O_DIRECT
+  std::vector <int>       fadvice;  //FSYS_ADVICE_*
+  std::vector <std::vector<char> > fcomb;	//appended, unwritten records
+  std::vector <size_t>    fcombsz;  //bytes of the combine buffer
+  std::vector <std::vector<long> > frec;	//offsets of appended records
   long	                   nfiles;  //number of files
   long                      nfree;  //number of free files
 
+  void set_policy(const long id);	  //apply the io policy after fopen
+  void release(const long id);		  //fclose, and free the buffer
+  long transfer(const long id, const long pos, void* ptr,
+                const size_t bytes, const bool isread);
+  long pio(const long id, const long pos, void* ptr,
+           const size_t bytes, const bool isread);	  //pread or pwrite
+  void combine_flush(const long id);	  //write the combine buffer
+  void check_open(const long id, const char* opr) const;
+  void check_positional(const long id, const char* opr) const;
+  void seed_next(const long id, const bool trunc);	  //next from the size of the file
+  void check_record(const long id, const long r) const;
+
 public:
   //Initialization and destruction
   fsys();
@@ -77,6 +173,9 @@ public:
   long get_fid(const std::string fname) const;
   FILE* get_fptr(const std::string fname) const;
   void set_mode(const std::string fname, const std::string fmode); 
+  void set_buffer(const std::string fname, const size_t bytes);
+  void set_direct(const std::string fname, const bool direct);
+  void set_advice(const std::string fname, const int advice);
 
   //File open and closing
   void open(const std::string fname, const std::string fmode); 		//open based on file name
@@ -84,9 +183,23 @@ public:
   void close_all();							//closes all files
   void open_all();							//opens all files
 
+  //Positional io, which does not move the file position
+  long write(const std::string fname, const long pos, const void* ptr, const size_t bytes);
+  long read(const std::string fname, const long pos, void* ptr, const size_t bytes);
+
+  //Appending records, and reading them back
+  long append(const long fid, const void* ptr, const size_t bytes);
+  long append(const std::string fname, const void* ptr, const size_t bytes);
+  void set_combine(const std::string fname, const size_t bytes);
+  void flush(const std::string fname);
+  long records(const std::string fname) const;
+  long record_offset(const std::string fname, const long r) const;
+  long record_bytes(const std::string fname, const long r) const;
+  long read_record(const std::string fname, const long r, void* ptr);
+
   //File system saving and recovering
-  void save() const;							//saves the filesystem
-  void recover();							//recovers the filesystem
+  void save(const std::string path="fsys.save");				//saves the filesystem
+  void recover(const std::string path="fsys.save");			//recovers the filesystem
    
 };
 #endif
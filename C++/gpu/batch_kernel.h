@@ -0,0 +1,115 @@
+/*--------------------------------------------------------------------------
+  batch_kernel.h
+	JHT, October 14, 2026 : created
+
+  OpenCL source of the batched gemm of GPU_HANDLER::gemm_batch,
+
+    C_p = alpha*op(A_p).B_p + beta*C_p,   p = first, ..., first+count-1
+
+  for many small products (up to a few BT) of matrices anywhere in three
+  buffers. Each product has its M, N, K, lda, ldb, ldc in dims[6p...] and
+  the element offsets of A_p, B_p, C_p in offs[3p...], so one launch does
+  the whole batch instead of one launch per product.
+
+  A work group is BT x BT work items, split into (BT/ST)^2 sub groups of
+  ST x ST, each of which does one product, so a group does 1 (ST = BT),
+  4 or 16 products at once. A sub group walks over the ST x ST tiles of
+  its C, through tiles of A and B in its own part of local memory. The
+  barriers are for the whole group, so the host puts products with the
+  same tile counts (tm, tn, tk) and ST in one launch, and the sub groups
+  only differ in the bounds checks. C is not read if beta is zero, and
+  the C_p of one batch must not overlap. REAL and BT are set in the build
+  options, see load_batch
+--------------------------------------------------------------------------*/
+#ifndef BATCH_KERNEL_H
+#define BATCH_KERNEL_H
+
+//work items of a group in each dimension, and the smallest sub group
+#define GPU_BATCH_TILE 16
+#define GPU_BATCH_MIN  4
+
+const char* gpu_batch_source = R"CLC(
+#if defined(REAL_IS_DOUBLE)
+  #pragma OPENCL EXTENSION cl_khr_fp64 : enable
+#endif
+#ifndef REAL
+  #define REAL double
+#endif
+#ifndef BT
+  #define BT 16
+#endif
+
+__kernel void gemm_batch(const int count, const int first, const int ST,
+                         const int tm, const int tn, const int tk,
+                         const int transA, const __global int* dims,
+                         const __global long* offs, const REAL ALPHA,
+                         const REAL BETA, const __global REAL* A,
+                         const __global REAL* B, __global REAL* C)
+{
+  __local REAL As[BT*BT];
+  __local REAL Bs[BT*BT];
+
+  //sub group, and the place in it
+  const int lx  = get_local_id(0);
+  const int ly  = get_local_id(1);
+  const int sub = BT/ST;
+  const int sx  = (lx/ST)*ST;
+  const int sy  = (ly/ST)*ST;
+  const int r   = lx - sx;
+  const int c   = ly - sy;
+  const int p   = get_group_id(0)*sub*sub + (ly/ST)*sub + lx/ST;
+
+  //a sub group past the end still takes part in the barriers
+  int  M = 0, N = 0, K = 0, lda = 1, ldb = 1, ldc = 1;
+  long oa = 0, ob = 0, oc = 0;
+  if (p < count)
+  {
+    const int e = first + p;
+    M   = dims[6*e];
+    N   = dims[6*e+1];
+    K   = dims[6*e+2];
+    lda = dims[6*e+3];
+    ldb = dims[6*e+4];
+    ldc = dims[6*e+5];
+    oa  = offs[3*e];
+    ob  = offs[3*e+1];
+    oc  = offs[3*e+2];
+  }
+
+  for (int ti=0;ti<tm;ti++)
+  {
+    for (int tj=0;tj<tn;tj++)
+    {
+      const int i = ti*ST + r;
+      const int j = tj*ST + c;
+      REAL acc = (REAL) 0;
+      for (int t=0;t<tk;t++)
+      {
+        //A(i,ka) and B(kb,j), coalesced on r
+        const int ka = t*ST + c;
+        const int kb = t*ST + r;
+        REAL a = (REAL) 0;
+        REAL b = (REAL) 0;
+        if (i < M && ka < K) {a = transA ? A[oa + ka + (long) i*lda] : A[oa + i + (long) ka*lda];}
+        if (kb < K && j < N) {b = B[ob + kb + (long) j*ldb];}
+        As[(sy+c)*BT + sx + r] = a;
+        Bs[(sy+c)*BT + sx + r] = b;
+        barrier(CLK_LOCAL_MEM_FENCE);
+
+        for (int kk=0;kk<ST;kk++)
+        {
+          acc += As[(sy+kk)*BT + sx + r]*Bs[(sy+c)*BT + sx + kk];
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+      }
+      if (i < M && j < N)
+      {
+        const long ic = oc + i + (long) j*ldc;
+        C[ic] = (BETA == (REAL) 0) ? ALPHA*acc : ALPHA*acc + BETA*C[ic];
+      }
+    }
+  }
+}
+)CLC";
+
+#endif
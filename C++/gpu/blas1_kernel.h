@@ -0,0 +1,147 @@
+/*--------------------------------------------------------------------------
+  blas1_kernel.h
+	JHT, October 14, 2026 : created
+	JHT, October 14, 2026 : the simd_* set, and the two stage reductions
+	JHT, October 14, 2026 : tuned number of groups
+
+  OpenCL source of the level-1 kernels of GPU_HANDLER, which mirror the
+  simd_* functions of simd.hpp. REAL is set in the build options, see
+  load_blas1
+
+    axpy          Y = A*X + Y
+    axpby         Y = A*X + B*Y
+    scal_mul      X = A*X
+    scal_add      X = A + X
+    elemwise_add  Z = X + Y
+    elemwise_mul  Z = X * Y
+    dot_part      part[group] = sum of X*Y over the group
+    sum_part      part[group] = sum of X over the group
+    reduce_part   out[0] = sum of part
+
+  copy, zero, and scal_set are clEnqueueCopyBuffer/FillBuffer.
+
+  The reductions are two stages. The work groups (GPU_REDUCE_GROUPS, or
+  as tuned for the GPU, up to GPU_REDUCE_MAX_GROUPS) of GPU_REDUCE_LOCAL
+  work items of dot_part (or sum_part) stride over the vectors, each 
+  keeping its own partial sum, and then sum them in a tree in local 
+  memory. One work group of reduce_part then sums the partial sums the 
+  same way. Each stage adds in a fixed order, so the result only depends
+  on N and the number of groups, which is fixed for a GPU once tuned.
+--------------------------------------------------------------------------*/
+#ifndef BLAS1_KERNEL_H
+#define BLAS1_KERNEL_H
+
+//work items per group, a power of two, and groups of the reductions
+#define GPU_REDUCE_LOCAL  256
+#define GPU_REDUCE_GROUPS 256
+#define GPU_REDUCE_MAX_GROUPS 1024
+
+const char* gpu_blas1_source = R"CLC(
+#if defined(REAL_IS_DOUBLE)
+  #pragma OPENCL EXTENSION cl_khr_fp64 : enable
+#endif
+#ifndef REAL
+  #define REAL double
+#endif
+#ifndef RLOCAL
+  #define RLOCAL 256
+#endif
+
+//Y = A*X + Y
+__kernel void axpy(const long N, const REAL A, const __global REAL* X,
+                   __global REAL* Y)
+{
+  const long i = get_global_id(0);
+  if (i < N) {Y[i] += A*X[i];}
+}
+
+//Y = A*X + B*Y
+__kernel void axpby(const long N, const REAL A, const __global REAL* X,
+                    const REAL B, __global REAL* Y)
+{
+  const long i = get_global_id(0);
+  if (i < N) {Y[i] = A*X[i] + B*Y[i];}
+}
+
+//X = A*X
+__kernel void scal_mul(const long N, const REAL A, __global REAL* X)
+{
+  const long i = get_global_id(0);
+  if (i < N) {X[i] *= A;}
+}
+
+//X = A + X
+__kernel void scal_add(const long N, const REAL A, __global REAL* X)
+{
+  const long i = get_global_id(0);
+  if (i < N) {X[i] += A;}
+}
+
+//Z = X + Y
+__kernel void elemwise_add(const long N, const __global REAL* X,
+                           const __global REAL* Y, __global REAL* Z)
+{
+  const long i = get_global_id(0);
+  if (i < N) {Z[i] = X[i] + Y[i];}
+}
+
+//Z = X * Y
+__kernel void elemwise_mul(const long N, const __global REAL* X,
+                           const __global REAL* Y, __global REAL* Z)
+{
+  const long i = get_global_id(0);
+  if (i < N) {Z[i] = X[i]*Y[i];}
+}
+
+//tree sum of the RLOCAL values of the group, left in sum[0]
+inline void reduce_local(__local REAL* sum)
+{
+  const int lid = get_local_id(0);
+  for (int half=RLOCAL/2;half>0;half/=2)
+  {
+    barrier(CLK_LOCAL_MEM_FENCE);
+    if (lid < half) {sum[lid] += sum[lid + half];}
+  }
+  barrier(CLK_LOCAL_MEM_FENCE);
+}
+
+__kernel __attribute__((reqd_work_group_size(RLOCAL,1,1)))
+void dot_part(const long N, const __global REAL* X, const __global REAL* Y,
+              __global REAL* part)
+{
+  __local REAL sum[RLOCAL];
+  const int lid = get_local_id(0);
+  REAL acc = (REAL) 0;
+  for (long i=get_global_id(0);i<N;i+=get_global_size(0)) {acc += X[i]*Y[i];}
+  sum[lid] = acc;
+  reduce_local(sum);
+  if (lid == 0) {part[get_group_id(0)] = sum[0];}
+}
+
+__kernel __attribute__((reqd_work_group_size(RLOCAL,1,1)))
+void sum_part(const long N, const __global REAL* X, __global REAL* part)
+{
+  __local REAL sum[RLOCAL];
+  const int lid = get_local_id(0);
+  REAL acc = (REAL) 0;
+  for (long i=get_global_id(0);i<N;i+=get_global_size(0)) {acc += X[i];}
+  sum[lid] = acc;
+  reduce_local(sum);
+  if (lid == 0) {part[get_group_id(0)] = sum[0];}
+}
+
+//one work group
+__kernel __attribute__((reqd_work_group_size(RLOCAL,1,1)))
+void reduce_part(const int NPART, const __global REAL* part, __global REAL* out)
+{
+  __local REAL sum[RLOCAL];
+  const int lid = get_local_id(0);
+  REAL acc = (REAL) 0;
+  for (int i=lid;i<NPART;i+=RLOCAL) {acc += part[i];}
+  sum[lid] = acc;
+  reduce_local(sum);
+  if (lid == 0) {out[0] = sum[0];}
+}
+)CLC";
+
+#endif
@@ -0,0 +1,510 @@
+/*--------------------------------------------------------------------------
+  device_tensor.hpp
+	JHT, October 14, 2026 : created
+	JHT, October 14, 2026 : pinned and zero copy host tensors
+	JHT, October 14, 2026 : level-1 functions
+	JHT, October 14, 2026 : fused element-wise expressions
+	JHT, October 14, 2026 : the copies are profiled
+
+  .hpp file for libj::device_tensor, a libj::tensor with a mirror in a
+  buffer on one GPU, so that the data can stay on the GPU between steps
+
+  The host tensor has the metadata (lengths, strides) and the host memory,
+  and must be sequential. The device buffer has the same dense column
+  major layout. Each side has a valid bit, and the data is only copied
+  when a side that is not valid is asked for:
+
+    host()         : host for read and write, the device copy is dropped
+    host_read()    : host for read, both stay valid
+    buffer()       : device for read and write, the host copy is dropped
+    buffer_read()  : device for read, both stay valid
+    buffer_write() : device for write only, nothing is copied, and the
+                     host copy is dropped
+
+  so consecutive GPU ops on device_tensors never go over the bus. Keep
+  the reference of host() or the cl_mem of buffer() only until the other
+  side is asked for. Copies are blocking.
+
+  If the host tensor is from a libj::pinned_allocator on the same GPU
+  (pinned_allocator.hpp), the copies go straight from the pinned memory,
+  and on unified memory GPUs its buffer is used as the device buffer, so
+  a "copy" is only the unmap (to the device) or map (to the host) of the
+  buffer, and just one side is valid at a time.
+
+  Usage
+  -------------------
+  libj::device_tensor<double> A(GPU,M,K), B(GPU,K,N), C(GPU,M,N);
+  fill(A.host()); fill(B.host());         //host is valid
+  libj::device_ABpC(1.0,A,B,0.0,C);       //A, B go up, C is only on the GPU
+  libj::device_ATBpC(1.0,A,C,0.0,D);      //nothing is copied
+  print(D.host_read());                   //D comes down
+
+  libj::device_tensor<double> T(GPU,H);   //mirror the host tensor H
+
+  The level-1 functions of simd.hpp run on the GPU of the output, with 
+  the elements as one vector, and only dot and reduction_add come back
+
+  libj::device_axpby(A,X,B,Y);            //Y = A*X + B*Y
+  double r = libj::device_dot(X,Y);
+  libj::device_elemwise_mul(X,Y,Z);       //Z = X*Y
+  libj::device_scal_mul(A,X); libj::device_scal_add(A,X);
+  libj::device_scal_set(A,X); libj::device_zero(X); libj::device_copy(X,Y);
+
+  A chain of them is one kernel with device_fuse, see gpu_fuse.hpp
+
+  libj::device_fuse(a*x + b*y*w,{&X,&Y,&W},{A,B},Z); //Z = A*X + B*Y*W
+--------------------------------------------------------------------------*/
+#ifndef DEVICE_TENSOR_HPP
+#define DEVICE_TENSOR_HPP
+
+#include <stdio.h>
+#include <stdlib.h>
+#ifdef __APPLE__
+  #include <OpenCL/opencl.h>
+#else
+  #include <CL/cl.h>
+#endif
+
+#include "tensor.hpp"
+#include "gpu_handler.hpp"
+#include "pinned_allocator.hpp"
+
+namespace libj
+{
+
+template <typename T>
+class device_tensor
+{
+  private:
+  libj::GPU_HANDLER* M_GPU;        //handler of the GPU
+  int                M_DEV;        //GPU number
+  libj::tensor<T>    M_HOST;       //host tensor, or a view of the mirrored one
+  cl_mem             M_BUFFER;     //device buffer
+  size_t             M_BYTES;      //bytes of the buffer
+  bool               M_HOST_VALID; //host has the data
+  bool               M_DEV_VALID;  //device has the data
+  libj::pinned_allocator<T>* M_PINNED; //zero copy allocator, or NULL
+
+  void m_set_default();
+  void m_make_buffer();
+  void m_copy(const bool to_device);
+
+  device_tensor(const device_tensor<T>& other);
+  device_tensor<T>& operator= (const device_tensor<T>& other);
+
+  public:
+  device_tensor() {m_set_default();}
+  template<class...Rest> device_tensor(libj::GPU_HANDLER& gpu, const size_t first,
+                                       const Rest...rest);
+  device_tensor(libj::GPU_HANDLER& gpu, libj::tensor<T>& host, const int dev = 0);
+  ~device_tensor() {deallocate();}
+
+  //allocate host and device memory, the host is valid (and not set)
+  template<class...Rest> void allocate(libj::GPU_HANDLER& gpu, const size_t first,
+                                       const Rest...rest);
+
+  //mirror the memory of a host tensor, which is valid
+  void assign(libj::GPU_HANDLER& gpu, libj::tensor<T>& host, const int dev = 0);
+
+  //free the device buffer and the host memory (if allocated here)
+  void deallocate();
+
+  //metadata
+  size_t size() const {return M_HOST.size();}
+  size_t size(const size_t dim) const {return M_HOST.size(dim);}
+  size_t dim() const {return M_HOST.dim();}
+  size_t stride(const size_t dim) const {return M_HOST.stride(dim);}
+  int    device() const {return M_DEV;}
+  bool   host_valid() const {return M_HOST_VALID;}
+  bool   device_valid() const {return M_DEV_VALID;}
+
+  //host side
+  libj::tensor<T>& host();
+  const libj::tensor<T>& host_read();
+
+  //device side
+  cl_mem buffer();
+  cl_mem buffer_read();
+  cl_mem buffer_write();
+
+  //copy now, without changing the other side
+  void to_host() {if (!M_HOST_VALID) m_copy(false);}
+  void to_device() {if (!M_DEV_VALID) m_copy(true);}
+
+  libj::GPU_HANDLER& gpu() {return *M_GPU;}
+};
+
+//--------------------------------------------------------------------------
+// m_set_default
+//--------------------------------------------------------------------------
+template <typename T>
+void device_tensor<T>::m_set_default()
+{
+  M_GPU = NULL;
+  M_DEV = 0;
+  M_BUFFER = NULL;
+  M_BYTES = 0;
+  M_HOST_VALID = true;
+  M_DEV_VALID = false;
+  M_PINNED = NULL;
+}
+
+//--------------------------------------------------------------------------
+// constructors
+//--------------------------------------------------------------------------
+template <typename T>
+template<class...Rest>
+device_tensor<T>::device_tensor(libj::GPU_HANDLER& gpu, const size_t first,
+                                const Rest...rest)
+{
+  m_set_default();
+  allocate(gpu,first,rest...);
+}
+
+template <typename T>
+device_tensor<T>::device_tensor(libj::GPU_HANDLER& gpu, libj::tensor<T>& host,
+                                const int dev)
+{
+  m_set_default();
+  assign(gpu,host,dev);
+}
+
+//--------------------------------------------------------------------------
+// allocate
+//	on GPU 0
+//--------------------------------------------------------------------------
+template <typename T>
+template<class...Rest>
+void device_tensor<T>::allocate(libj::GPU_HANDLER& gpu, const size_t first,
+                                const Rest...rest)
+{
+  deallocate();
+  M_GPU = &gpu;
+  M_DEV = 0;
+  M_HOST.allocate(first,rest...);
+  m_make_buffer();
+}
+
+//--------------------------------------------------------------------------
+// assign
+//	M_HOST is a view of host, which must outlive this
+//--------------------------------------------------------------------------
+template <typename T>
+void device_tensor<T>::assign(libj::GPU_HANDLER& gpu, libj::tensor<T>& host,
+                              const int dev)
+{
+  if (!host.is_set() || !host.is_sequential())
+  {
+    printf("ERROR libj::device_tensor::assign the host tensor is not set or not sequential\n");
+    exit(1);
+  }
+  deallocate();
+  M_GPU = &gpu;
+  M_DEV = dev;
+  M_HOST = host;
+  m_make_buffer();
+}
+
+//--------------------------------------------------------------------------
+// m_make_buffer
+//--------------------------------------------------------------------------
+template <typename T>
+void device_tensor<T>::m_make_buffer()
+{
+  M_BYTES = sizeof(T)*std::max(M_HOST.size(),(size_t) 1);
+  M_HOST_VALID = true;
+  M_DEV_VALID = false;
+
+  //the buffer of a zero copy host tensor, which must start its allocation
+  libj::pinned_allocator<T>* pinned = 
+    dynamic_cast<libj::pinned_allocator<T>*>(M_HOST.get_allocator());
+  if (pinned != NULL && pinned->zero_copy() && &pinned->gpu() == M_GPU &&
+      pinned->device() == M_DEV && pinned->buffer(M_HOST.data()) != NULL)
+  {
+    M_PINNED = pinned;
+    M_BUFFER = pinned->buffer(M_HOST.data());
+    clRetainMemObject(M_BUFFER);
+    return;
+  }
+
+  M_GPU->init();
+  cl_int err;
+  M_BUFFER = clCreateBuffer(M_GPU->platform.context,CL_MEM_READ_WRITE,M_BYTES,NULL,&err);
+  if (err != CL_SUCCESS)
+  {
+    printf("ERROR libj::device_tensor could not make a buffer of %lu bytes, code %d \n",
+           (unsigned long) M_BYTES,err);
+    exit(1);
+  }
+}
+
+//--------------------------------------------------------------------------
+// deallocate
+//--------------------------------------------------------------------------
+template <typename T>
+void device_tensor<T>::deallocate()
+{
+  if (M_PINNED != NULL) {M_PINNED->map(M_HOST.data());}
+  if (M_BUFFER != NULL) {clReleaseMemObject(M_BUFFER);}
+  if (M_HOST.is_allocated()) {M_HOST.deallocate();}
+  else if (M_HOST.is_assigned()) {M_HOST.unassign();}
+  m_set_default();
+}
+
+//--------------------------------------------------------------------------
+// m_copy
+//	blocking copy of the whole tensor, and marks both valid. A zero copy
+//	buffer is unmapped or mapped, and only that side is valid
+//--------------------------------------------------------------------------
+template <typename T>
+void device_tensor<T>::m_copy(const bool to_device)
+{
+  if (M_PINNED != NULL)
+  {
+    if (to_device) {M_PINNED->unmap(M_HOST.data());}
+    else {M_PINNED->map(M_HOST.data());}
+    M_HOST_VALID = !to_device;
+    M_DEV_VALID = to_device;
+    return;
+  }
+  if (M_HOST.size() == 0) {M_HOST_VALID = true; M_DEV_VALID = true; return;}
+  cl_command_queue queue = M_GPU->gpus[M_DEV].commands;
+  const size_t bytes = sizeof(T)*M_HOST.size();
+  const libj::GPU& gpu = M_GPU->gpus[M_DEV];
+  cl_event event;
+  cl_int err = to_device
+    ? clEnqueueWriteBuffer(queue,M_BUFFER,CL_TRUE,0,bytes,M_HOST.data(),0,NULL,gpu.prof_event(&event))
+    : clEnqueueReadBuffer(queue,M_BUFFER,CL_TRUE,0,bytes,M_HOST.data(),0,NULL,gpu.prof_event(&event));
+  gpu.prof_record(err,event,queue,"device_tensor",to_device ? "h2d" : "d2h",(double) bytes);
+  if (err != CL_SUCCESS)
+  {
+    printf("ERROR libj::device_tensor could not copy to the %s, code %d \n",
+           to_device ? "device" : "host",err);
+    exit(1);
+  }
+  M_HOST_VALID = true;
+  M_DEV_VALID = true;
+}
+
+//--------------------------------------------------------------------------
+// host access
+//--------------------------------------------------------------------------
+template <typename T>
+libj::tensor<T>& device_tensor<T>::host()
+{
+  to_host();
+  M_DEV_VALID = false;
+  return M_HOST;
+}
+
+template <typename T>
+const libj::tensor<T>& device_tensor<T>::host_read()
+{
+  to_host();
+  return M_HOST;
+}
+
+//--------------------------------------------------------------------------
+// device access
+//--------------------------------------------------------------------------
+template <typename T>
+cl_mem device_tensor<T>::buffer()
+{
+  to_device();
+  M_HOST_VALID = false;
+  return M_BUFFER;
+}
+
+template <typename T>
+cl_mem device_tensor<T>::buffer_read()
+{
+  to_device();
+  return M_BUFFER;
+}
+
+template <typename T>
+cl_mem device_tensor<T>::buffer_write()
+{
+  if (M_PINNED != NULL) {to_device();}
+  M_DEV_VALID = true;
+  M_HOST_VALID = false;
+  return M_BUFFER;
+}
+
+//--------------------------------------------------------------------------
+// device_gemm
+//	C = ALPHA*op(A).B + BETA*C on the GPU of C, with C as a matrix of
+//	size(0) rows, B of K rows, and A the rest. C is not copied up if
+//	BETA is zero
+//--------------------------------------------------------------------------
+template <typename T>
+void device_gemm(const bool transA, const T ALPHA, device_tensor<T>& A,
+                 device_tensor<T>& B, const T BETA, device_tensor<T>& C)
+{
+  const int M = (C.dim() > 0) ? (int) C.size(0) : 0;
+  const int N = (M > 0) ? (int) (C.size()/M) : 0;
+  const int K = (N > 0) ? (int) (B.size()/N) : 0;
+  if (M == 0 || N == 0) return;
+  if ((size_t) M*N != C.size() || (size_t) K*N != B.size() || (size_t) M*K != A.size())
+  {
+    printf("ERROR libj::device_gemm the sizes of A, B, and C do not match\n");
+    exit(1);
+  }
+  const cl_mem a = A.buffer_read();
+  const cl_mem b = B.buffer_read();
+  cl_mem c = (BETA == (T) 0) ? C.buffer_write() : C.buffer();
+  C.gpu().template gemm<T>(transA,M,N,K,ALPHA,a,b,BETA,c,C.device());
+}
+
+//C = ALPHA*A.B + BETA*C
+template <typename T>
+void device_ABpC(const T ALPHA, device_tensor<T>& A, device_tensor<T>& B,
+                 const T BETA, device_tensor<T>& C)
+{
+  device_gemm<T>(false,ALPHA,A,B,BETA,C);
+}
+
+//C = ALPHA*A^T.B + BETA*C
+template <typename T>
+void device_ATBpC(const T ALPHA, device_tensor<T>& A, device_tensor<T>& B,
+                  const T BETA, device_tensor<T>& C)
+{
+  device_gemm<T>(true,ALPHA,A,B,BETA,C);
+}
+
+//--------------------------------------------------------------------------
+// level-1 functions
+//	as simd.hpp, outputs that are only written are not copied up
+//--------------------------------------------------------------------------
+template <typename T>
+void device_check(const char* name, const device_tensor<T>& X, const device_tensor<T>& Y)
+{
+  if (X.size() != Y.size() || X.device() != Y.device())
+  {
+    printf("ERROR libj::%s the tensors differ in size or GPU\n",name);
+    exit(1);
+  }
+}
+
+//Y = A*X + Y
+template <typename T>
+void device_axpy(const T A, device_tensor<T>& X, device_tensor<T>& Y)
+{
+  device_check("device_axpy",X,Y);
+  const cl_mem x = X.buffer_read();
+  Y.gpu().template axpy<T>((long) Y.size(),A,x,Y.buffer(),Y.device());
+}
+
+//Y = A*X + B*Y
+template <typename T>
+void device_axpby(const T A, device_tensor<T>& X, const T B, device_tensor<T>& Y)
+{
+  device_check("device_axpby",X,Y);
+  const cl_mem x = X.buffer_read();
+  cl_mem y = (B == (T) 0) ? Y.buffer_write() : Y.buffer();
+  if (B == (T) 0) {Y.gpu().template zero<T>((long) Y.size(),y,Y.device());}
+  Y.gpu().template axpby<T>((long) Y.size(),A,x,B,y,Y.device());
+}
+
+//X = A*X
+template <typename T>
+void device_scal_mul(const T A, device_tensor<T>& X)
+{
+  X.gpu().template scal_mul<T>((long) X.size(),A,X.buffer(),X.device());
+}
+
+//X = A + X
+template <typename T>
+void device_scal_add(const T A, device_tensor<T>& X)
+{
+  X.gpu().template scal_add<T>((long) X.size(),A,X.buffer(),X.device());
+}
+
+//X = A
+template <typename T>
+void device_scal_set(const T A, device_tensor<T>& X)
+{
+  X.gpu().template scal_set<T>((long) X.size(),A,X.buffer_write(),X.device());
+}
+
+//X = 0
+template <typename T>
+void device_zero(device_tensor<T>& X)
+{
+  X.gpu().template zero<T>((long) X.size(),X.buffer_write(),X.device());
+}
+
+//Y = X
+template <typename T>
+void device_copy(device_tensor<T>& X, device_tensor<T>& Y)
+{
+  device_check("device_copy",X,Y);
+  const cl_mem x = X.buffer_read();
+  Y.gpu().template copy<T>((long) Y.size(),x,Y.buffer_write(),Y.device());
+}
+
+//Z = X + Y
+template <typename T>
+void device_elemwise_add(device_tensor<T>& X, device_tensor<T>& Y, device_tensor<T>& Z)
+{
+  device_check("device_elemwise_add",X,Z);
+  device_check("device_elemwise_add",Y,Z);
+  const cl_mem x = X.buffer_read();
+  const cl_mem y = Y.buffer_read();
+  Z.gpu().template elemwise_add<T>((long) Z.size(),x,y,Z.buffer_write(),Z.device());
+}
+
+//Z = X * Y
+template <typename T>
+void device_elemwise_mul(device_tensor<T>& X, device_tensor<T>& Y, device_tensor<T>& Z)
+{
+  device_check("device_elemwise_mul",X,Z);
+  device_check("device_elemwise_mul",Y,Z);
+  const cl_mem x = X.buffer_read();
+  const cl_mem y = Y.buffer_read();
+  Z.gpu().template elemwise_mul<T>((long) Z.size(),x,y,Z.buffer_write(),Z.device());
+}
+
+//X.Y
+template <typename T>
+T device_dot(device_tensor<T>& X, device_tensor<T>& Y)
+{
+  device_check("device_dot",X,Y);
+  const cl_mem x = X.buffer_read();
+  return X.gpu().template dot<T>((long) X.size(),x,Y.buffer_read(),X.device());
+}
+
+//sum of X
+template <typename T>
+T device_reduction_add(device_tensor<T>& X)
+{
+  return X.gpu().template reduction_add<T>((long) X.size(),X.buffer_read(),X.device());
+}
+
+//Z = expr, with in(i) the tensor X[i], in one kernel. Z is only copied
+//up if it is also an input
+template <typename T>
+void device_fuse(const gpu_expr& expr, const std::vector<device_tensor<T>*>& X,
+                 const std::vector<T>& scalars, device_tensor<T>& Z)
+{
+  std::vector<cl_mem> in(X.size());
+  bool inplace = false;
+  for (size_t i=0;i<X.size();i++)
+  {
+    device_check("device_fuse",*X[i],Z);
+    inplace = inplace || X[i] == &Z;
+  }
+  for (size_t i=0;i<X.size();i++) 
+  {
+    if (X[i] != &Z) {in[i] = X[i]->buffer_read();}
+  }
+  cl_mem z = inplace ? Z.buffer() : Z.buffer_write();
+  for (size_t i=0;i<X.size();i++) 
+  {
+    if (X[i] == &Z) {in[i] = z;}
+  }
+  Z.gpu().template fuse<T>((long) Z.size(),expr,in,scalars,z,Z.device());
+}
+
+}//end libj namespace
+#endif
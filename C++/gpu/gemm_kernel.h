@@ -0,0 +1,200 @@
+/*--------------------------------------------------------------------------
+  gemm_kernel.h
+	JHT, October 14, 2026 : created
+	JHT, October 14, 2026 : tuned tiles
+	JHT, October 14, 2026 : half storage
+
+  OpenCL source of the tiled matrix-multiply kernels used by
+  GPU_HANDLER::gemm, column major like linal
+
+    gemm_nn : C = alpha*A.B   + beta*C, A is M x K
+    gemm_tn : C = alpha*A^T.B + beta*C, A is K x M
+
+  Each work group makes a TSM x TSN tile of C from TSM x TSK and
+  TSK x TSN tiles of A and B in local memory, loaded as REAL4 vectors.
+  Each work item keeps a WPTM x WPTN block of C in registers, at a
+  stride of TSM/WPTM and TSN/WPTN, so that neighbouring work items
+  read neighbouring local memory.
+
+  There are no bounds checks, so M, N, and K must be multiples of TSM,
+  TSN, and TSK (the leading dimensions), which GPU_HANDLER::gemm does
+  by zero padding. REAL and the tile sizes are set in the build
+  options, see load_gemm
+
+  With REAL_IS_HALF, A and B are stored as halfs, read with vload_half4
+  (core OpenCL, so cl_khr_fp16 is not needed), and the tiles, the 
+  accumulation, and C are REAL (float). See GPU_HANDLER::gemm_mixed
+--------------------------------------------------------------------------*/
+#ifndef GEMM_KERNEL_H
+#define GEMM_KERNEL_H
+
+//default tile sizes, GPU_HANDLER::load_gemm tunes them per type
+#define GPU_GEMM_TSM 64
+#define GPU_GEMM_TSN 64
+#define GPU_GEMM_TSK 16
+#define GPU_GEMM_WPTM 4
+#define GPU_GEMM_WPTN 4
+
+const char* gpu_gemm_source = R"CLC(
+#if defined(REAL_IS_DOUBLE)
+  #pragma OPENCL EXTENSION cl_khr_fp64 : enable
+#endif
+#ifndef REAL
+  #define REAL double
+  #define REAL4 double4
+#endif
+#if defined(REAL_IS_HALF)
+  #define GIN half
+  #define LOAD4(X,i) vload_half4((i),(X))
+#else
+  #define GIN REAL4
+  #define LOAD4(X,i) (X)[(i)]
+#endif
+#ifndef TSM
+  #define TSM 64
+#endif
+#ifndef TSN
+  #define TSN 64
+#endif
+#ifndef TSK
+  #define TSK 16
+#endif
+#ifndef WPTM
+  #define WPTM 4
+#endif
+#ifndef WPTN
+  #define WPTN 4
+#endif
+#define RTSM (TSM/WPTM)
+#define RTSN (TSN/WPTN)
+#define NTHR (RTSM*RTSN)
+#define LPTA ((TSK*TSM)/(4*NTHR))
+#define LPTB ((TSK*TSN)/(4*NTHR))
+#if (LPTA < 1) || (LPTB < 1) || (LPTA*4*NTHR != TSK*TSM) || (LPTB*4*NTHR != TSK*TSN)
+  #error "gemm tiles do not split evenly over the work group"
+#endif
+
+//acc += Asub^T.Bsub, with Asub[k][m] and Bsub[k][n]
+inline void gemm_tile(__local const REAL* Asub, __local const REAL* Bsub,
+                      const int tidm, const int tidn, REAL* acc)
+{
+  #pragma unroll
+  for (int k=0;k<TSK;k++)
+  {
+    REAL breg[WPTN];
+    #pragma unroll
+    for (int wn=0;wn<WPTN;wn++) {breg[wn] = Bsub[k*TSN + tidn + wn*RTSN];}
+    #pragma unroll
+    for (int wm=0;wm<WPTM;wm++)
+    {
+      const REAL areg = Asub[k*TSM + tidm + wm*RTSM];
+      #pragma unroll
+      for (int wn=0;wn<WPTN;wn++) {acc[wm*WPTN + wn] += areg*breg[wn];}
+    }
+  }
+}
+
+//K x L panel (column major, leading dimension K) into sub[k][l]
+inline void gemm_load_kmajor(const __global GIN* X, const int K4, const int t,
+                             const int start, const int tid, const int lpt,
+                             const int tsl, __local REAL* sub)
+{
+  for (int l=0;l<lpt;l++)
+  {
+    const int id = tid + l*NTHR;
+    const int k4 = id % (TSK/4);
+    const int c  = id / (TSK/4);
+    const REAL4 v = LOAD4(X,(t/4 + k4) + (long) (start + c)*K4);
+    sub[(4*k4    )*tsl + c] = v.x;
+    sub[(4*k4 + 1)*tsl + c] = v.y;
+    sub[(4*k4 + 2)*tsl + c] = v.z;
+    sub[(4*k4 + 3)*tsl + c] = v.w;
+  }
+}
+
+//C = alpha*acc + beta*C, C is not read if beta is zero
+inline void gemm_store(const int M, const REAL alpha, const REAL beta,
+                       const int row, const int col, const int tidm,
+                       const int tidn, const REAL* acc, __global REAL* C)
+{
+  #pragma unroll
+  for (int wn=0;wn<WPTN;wn++)
+  {
+    const long n = col + tidn + wn*RTSN;
+    #pragma unroll
+    for (int wm=0;wm<WPTM;wm++)
+    {
+      const long idx = (row + tidm + wm*RTSM) + n*M;
+      const REAL val = alpha*acc[wm*WPTN + wn];
+      C[idx] = (beta == (REAL) 0) ? val : val + beta*C[idx];
+    }
+  }
+}
+
+__kernel __attribute__((reqd_work_group_size(RTSM,RTSN,1)))
+void gemm_nn(const int M, const int N, const int K, const REAL alpha,
+             const __global GIN* A, const __global GIN* B,
+             const REAL beta, __global REAL* C)
+{
+  const int tidm = get_local_id(0);
+  const int tidn = get_local_id(1);
+  const int tid  = tidm + tidn*RTSM;
+  const int row  = get_group_id(0)*TSM;
+  const int col  = get_group_id(1)*TSN;
+  const int M4   = M/4;
+  const int K4   = K/4;
+
+  __local REAL Asub[TSK*TSM];
+  __local REAL Bsub[TSK*TSN];
+  REAL acc[WPTM*WPTN];
+  for (int i=0;i<WPTM*WPTN;i++) {acc[i] = (REAL) 0;}
+
+  for (int t=0;t<K;t+=TSK)
+  {
+    //A is M x K, TSM/4 vectors down each of the TSK columns
+    for (int l=0;l<LPTA;l++)
+    {
+      const int id = tid + l*NTHR;
+      const int m4 = id % (TSM/4);
+      const int k  = id / (TSM/4);
+      vstore4(LOAD4(A,(row/4 + m4) + (long) (t + k)*M4),0,Asub + k*TSM + 4*m4);
+    }
+    gemm_load_kmajor(B,K4,t,col,tid,LPTB,TSN,Bsub);
+    barrier(CLK_LOCAL_MEM_FENCE);
+    gemm_tile(Asub,Bsub,tidm,tidn,acc);
+    barrier(CLK_LOCAL_MEM_FENCE);
+  }
+  gemm_store(M,alpha,beta,row,col,tidm,tidn,acc,C);
+}
+
+__kernel __attribute__((reqd_work_group_size(RTSM,RTSN,1)))
+void gemm_tn(const int M, const int N, const int K, const REAL alpha,
+             const __global GIN* A, const __global GIN* B,
+             const REAL beta, __global REAL* C)
+{
+  const int tidm = get_local_id(0);
+  const int tidn = get_local_id(1);
+  const int tid  = tidm + tidn*RTSM;
+  const int row  = get_group_id(0)*TSM;
+  const int col  = get_group_id(1)*TSN;
+  const int K4   = K/4;
+
+  __local REAL Asub[TSK*TSM];
+  __local REAL Bsub[TSK*TSN];
+  REAL acc[WPTM*WPTN];
+  for (int i=0;i<WPTM*WPTN;i++) {acc[i] = (REAL) 0;}
+
+  for (int t=0;t<K;t+=TSK)
+  {
+    //A is K x M, so both panels run down k
+    gemm_load_kmajor(A,K4,t,row,tid,LPTA,TSM,Asub);
+    gemm_load_kmajor(B,K4,t,col,tid,LPTB,TSN,Bsub);
+    barrier(CLK_LOCAL_MEM_FENCE);
+    gemm_tile(Asub,Bsub,tidm,tidn,acc);
+    barrier(CLK_LOCAL_MEM_FENCE);
+  }
+  gemm_store(M,alpha,beta,row,col,tidm,tidn,acc,C);
+}
+)CLC";
+
+#endif
@@ -1,6 +1,9 @@
 /*--------------------------------------------------------------------------
   gpu.hpp
 	JHT, April 14, 2022 : created
+	JHT, October 14, 2026 : added the extra command queues
+	JHT, October 14, 2026 : added host_unified_memory
+	JHT, October 14, 2026 : added the profiling of the commands
 
   .hpp file for the GPU struct, which manages data invoved with 
   various gpus
@@ -21,6 +24,7 @@
 #include "gpu_include.h"
 #include "gpu_platform.hpp"
 #include "gpu_kernel.hpp"
+#include "gpu_prof.hpp"
 
 
 namespace libj
@@ -51,6 +55,9 @@ Max size in bytes of a constant buffer allocation. The minimum value is 64 KB.
 CL_DEVICE_MAX_MEM_ALLOC_SIZE (cl_ulong)
 Max size of memory object allocation in bytes. The minimum value is max (1/4th of CL_DEVICE_GLOBAL_MEM_SIZE, 128*1024*1024)
 
+CL_DEVICE_HOST_UNIFIED_MEMORY (cl_bool)
+Is CL_TRUE if the device and the host have a unified memory subsystem (integrated GPUs), so that a buffer made over host memory needs no copies.
+
 ---- compute parameters ----
 CL_DEVICE_MAX_COMPUTE_UNITS (cl_uint)
 The number of parallel compute cores on the OpenCL device. The minimum value is 1.
@@ -88,6 +95,9 @@ struct GPU
   //true if this device supports doubles
   bool            supports_double;
 
+  //true if the device shares the memory of the host
+  bool            host_unified_memory;
+
   //Compute parameters
   cl_uint             max_compute_units;
   size_t              max_work_group_size;
@@ -96,7 +106,11 @@ struct GPU
   
   //OpenCL objects
 //  cl_platform_id      platform;
-  cl_command_queue      commands;
+  cl_command_queue      commands;	//queue 0
+  std::vector<cl_command_queue> queues;	//queues 1,2,..., see add_queues
+
+  //device timing of the commands, NULL if off (see gpu_prof.hpp)
+  libj::GPU_PROF*       prof;
 
   //Function to print info
   void print_info() const; 
@@ -115,12 +129,29 @@ struct GPU
   void set_max_work_item_dim();
   void set_max_work_item_sizes();
   void set_supports_double();
+  void set_host_unified_memory();
 //  void set_platform_id();
   unsigned long safe_set(const cl_device_info);
 
   //create context, program, kernel, etc
   void create_command_queue(const GPU_PLATFORM& platform);
 
+  //extra queues, in order or out of order, for overlapping work
+  void add_queues(const GPU_PLATFORM& platform, const int num, 
+                  const bool out_of_order = false);
+  int num_queues() const {return 1 + (int) queues.size();}
+  cl_command_queue queue(const int q) const {return (q == 0) ? commands : queues[q-1];}
+  int queue_index(const cl_command_queue q) const;
+
+  //the event to give a command, NULL if it is not profiled, and keeping
+  //it after the command is queued on queue q
+  cl_event* prof_event(cl_event* event) const {*event = NULL; return (prof != NULL) ? event : NULL;}
+  void prof_record(const cl_int err, const cl_event event, const cl_command_queue q,
+                   const char* name, const char* kind, const double bytes) const
+  {
+    if (prof != NULL) {prof->record(err,event,dev_num,queue_index(q),name,kind,bytes);}
+  }
+
   //queue a command
   void queue_command(const GPU_KERNEL& kernel,const size_t work_dim,
                      const size_t* global_work_size_array, 
@@ -158,6 +189,7 @@ void GPU::print_info() const
   printf("Local Memory size     (bytes)  %lu \n",local_mem_size);
   printf("Max Const buffer size (bytes)  %lu \n",constant_max_size);
   printf("Max allocatable size  (bytes)  %lu \n",max_alloc_size);
+  printf("Host unified memory            %s \n",host_unified_memory ? "yes" : "no");
   printf("\n");
   printf("GPU Group Parameters\n");
   printf("Max compute units     (int)    %u \n",max_compute_units); 
@@ -178,6 +210,7 @@ void GPU::set_device(const cl_device_id dev, const int num)
 {
   device = dev;
   dev_num = num;
+  prof = NULL;
 }
 
 //-----------------------------------------------------------------------
@@ -197,6 +230,7 @@ void GPU::set_data()
   set_max_work_item_dim();
   set_max_work_item_sizes();
   set_supports_double();
+  set_host_unified_memory();
 }
 
 
@@ -321,6 +355,15 @@ void GPU::set_supports_double()
   cl_uint width = safe_set(CL_DEVICE_PREFERRED_VECTOR_WIDTH_DOUBLE);
   supports_double = true ? width != 0 : false;
 }
+
+//-----------------------------------------------------------------------
+//  set_host_unified_memory
+//	determines if the GPU shares memory with the host
+//-----------------------------------------------------------------------
+void GPU::set_host_unified_memory()
+{
+  host_unified_memory = safe_set(CL_DEVICE_HOST_UNIFIED_MEMORY) != 0;
+}
  
 
 /*
@@ -420,12 +463,14 @@ void GPU::set_max_work_item_sizes()
 //-----------------------------------------------------------------------
 // create_command_queue
 //   create the command queue
-//	this takes the default options for now
+//	this takes the default options, and profiling if prof is set
 //-----------------------------------------------------------------------
 void GPU::create_command_queue(const GPU_PLATFORM& platform)
 {
   cl_int err;
-  commands = clCreateCommandQueue(platform.context,device,0,&err);
+  const cl_command_queue_properties props = 
+    (prof != NULL) ? CL_QUEUE_PROFILING_ENABLE : 0;
+  commands = clCreateCommandQueue(platform.context,device,props,&err);
   if (err != CL_SUCCESS)
   {
     printf("ERROR libj::GPU::create_command_queue failed on GPU #%d\n",dev_num);
@@ -433,6 +478,41 @@ void GPU::create_command_queue(const GPU_PLATFORM& platform)
   } 
 }
 
+//-----------------------------------------------------------------------
+// add_queues
+//   num more command queues on this device. Out of order queues may run
+//   their commands at once, so the order must be given by events (see 
+//   gpu_graph.hpp)
+//-----------------------------------------------------------------------
+void GPU::add_queues(const GPU_PLATFORM& platform, const int num, 
+                     const bool out_of_order)
+{
+  const cl_command_queue_properties props = 
+    (out_of_order ? CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE : 0) |
+    ((prof != NULL) ? CL_QUEUE_PROFILING_ENABLE : 0);
+  for (int q=0;q<num;q++)
+  {
+    cl_int err;
+    cl_command_queue queue = clCreateCommandQueue(platform.context,device,props,&err);
+    if (err != CL_SUCCESS)
+    {
+      printf("ERROR libj::GPU::add_queues failed on GPU #%d with code %d\n",dev_num,err);
+      exit(1);
+    } 
+    queues.push_back(queue);
+  }
+}
+
+//-----------------------------------------------------------------------
+// queue_index
+//	q of queue(q), 0 if it is not a queue of this GPU
+//-----------------------------------------------------------------------
+int GPU::queue_index(const cl_command_queue q) const
+{
+  for (size_t i=0;i<queues.size();i++) {if (queues[i] == q) return (int) i + 1;}
+  return 0;
+}
+
 //-----------------------------------------------------------------------
 // queue the command for right-away execution
 //-----------------------------------------------------------------------
@@ -440,10 +520,12 @@ void GPU::queue_command(const GPU_KERNEL& kernel,const size_t work_dim,
                         const size_t* global_work_size_array, 
                         const size_t* local_work_size_array)
 {
+  cl_event event;
   cl_int err = clEnqueueNDRangeKernel(commands,kernel.kernel,work_dim,
                                       NULL,global_work_size_array,
                                       local_work_size_array,
-                                      0,NULL,NULL);
+                                      0,NULL,prof_event(&event));
+  prof_record(err,event,commands,kernel.name.c_str(),"kernel",0);
   if (err != CL_SUCCESS)
   {
     printf("ERROR libj::GPU::queue_command failed with error %d \n",err);
@@ -458,8 +540,10 @@ void GPU::queue_command(const GPU_KERNEL& kernel,const size_t work_dim,
 void GPU::read_to_host(const cl_mem buffer, const size_t offset, const size_t bytes, 
                        void* pointer)
 {
+  cl_event event;
   cl_int err = clEnqueueReadBuffer(commands,buffer,CL_TRUE,offset,bytes,
-                                   pointer,0,NULL,NULL);
+                                   pointer,0,NULL,prof_event(&event));
+  prof_record(err,event,commands,"read_to_host","d2h",(double) bytes);
   if (err != CL_SUCCESS)
   {
     printf("ERROR libj::GPU::read_to_host failed with status %d \n",err);
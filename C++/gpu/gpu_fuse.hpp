@@ -0,0 +1,169 @@
+/*--------------------------------------------------------------------------
+  gpu_fuse.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for libj::gpu_expr, an element-wise expression of device
+  vectors and scalars, which GPU_HANDLER::fuse turns into the source of
+  one OpenCL kernel, so that a chain of level-1 ops is one pass over
+  global memory instead of one per op
+
+  The leaves are
+    gpu_expr::in(i)     : element of the i'th buffer
+    gpu_expr::scalar(j) : the j'th scalar, a kernel argument
+    a double            : a constant, written into the source
+
+  and the nodes are + - * / (and unary -), and gpu_sqrt, gpu_exp, 
+  gpu_log, gpu_fabs, gpu_fmin, gpu_fmax (the OpenCL functions). The 
+  expression is only text, so the same expression always gives the same
+  source, and GPU_HANDLER::fuse keeps the kernel of each by the hash of
+  its source (and the binary is kept on disk by GPU_PROGRAM). A constant
+  is part of the source, so a value that changes between calls should be
+  a scalar, or each value is a new program.
+
+  Usage
+  -------------------
+  const libj::gpu_expr x = libj::gpu_expr::in(0), y = libj::gpu_expr::in(1);
+  const libj::gpu_expr w = libj::gpu_expr::in(2);
+  const libj::gpu_expr a = libj::gpu_expr::scalar(0), b = libj::gpu_expr::scalar(1);
+
+  //Z = A*X + B*Y*W, one pass, Z may be one of the inputs
+  GPU.fuse<double>(N,a*x + b*y*w,{dX,dY,dW},{A,B},dZ);
+
+  libj::device_fuse(a*x + b*y*w,{&X,&Y,&W},{A,B},Z); //device_tensor.hpp
+--------------------------------------------------------------------------*/
+#ifndef GPU_FUSE_HPP
+#define GPU_FUSE_HPP
+
+#include <stdio.h>
+#include <string>
+#include <algorithm>
+
+namespace libj
+{
+
+/*--------------------------------------------------------------------------
+  gpu_expr
+	m_text		the expression, in v<i> (the element of in(i)) and
+			s<j> (scalar j)
+	m_num_in	inputs, one more than the largest i
+	m_num_scalar	scalars, one more than the largest j
+--------------------------------------------------------------------------*/
+class gpu_expr
+{
+  private:
+  std::string m_text;
+  int         m_num_in;
+  int         m_num_scalar;
+
+  public:
+  gpu_expr(const double value);
+  static gpu_expr in(const int i);
+  static gpu_expr scalar(const int j);
+  static gpu_expr binary(const char* op, const gpu_expr& a, const gpu_expr& b);
+  static gpu_expr call(const char* fn, const gpu_expr& a);
+  static gpu_expr call(const char* fn, const gpu_expr& a, const gpu_expr& b);
+
+  const std::string& text() const {return m_text;}
+  int num_in() const {return m_num_in;}
+  int num_scalar() const {return m_num_scalar;}
+
+  //source of the kernel name(N, x0..., s0..., Z), with Z[i] = expression
+  std::string source(const char* name) const;
+};
+
+//--------------------------------------------------------------------------
+// leaves
+//--------------------------------------------------------------------------
+gpu_expr::gpu_expr(const double value)
+{
+  char str[64];
+  snprintf(str,64,"((REAL) %.17g)",value);
+  m_text = str;
+  m_num_in = 0;
+  m_num_scalar = 0;
+}
+
+gpu_expr gpu_expr::in(const int i)
+{
+  gpu_expr e(0.0);
+  e.m_text = "v" + std::to_string(i);
+  e.m_num_in = i + 1;
+  return e;
+}
+
+gpu_expr gpu_expr::scalar(const int j)
+{
+  gpu_expr e(0.0);
+  e.m_text = "s" + std::to_string(j);
+  e.m_num_scalar = j + 1;
+  return e;
+}
+
+//--------------------------------------------------------------------------
+// nodes
+//--------------------------------------------------------------------------
+gpu_expr gpu_expr::binary(const char* op, const gpu_expr& a, const gpu_expr& b)
+{
+  gpu_expr e(0.0);
+  e.m_text = "(" + a.m_text + op + b.m_text + ")";
+  e.m_num_in = std::max(a.m_num_in,b.m_num_in);
+  e.m_num_scalar = std::max(a.m_num_scalar,b.m_num_scalar);
+  return e;
+}
+
+gpu_expr gpu_expr::call(const char* fn, const gpu_expr& a)
+{
+  gpu_expr e(a);
+  e.m_text = std::string(fn) + "(" + a.m_text + ")";
+  return e;
+}
+
+gpu_expr gpu_expr::call(const char* fn, const gpu_expr& a, const gpu_expr& b)
+{
+  gpu_expr e = binary(",",a,b);
+  e.m_text = std::string(fn) + e.m_text;
+  return e;
+}
+
+gpu_expr operator+(const gpu_expr& a, const gpu_expr& b) {return gpu_expr::binary("+",a,b);}
+gpu_expr operator-(const gpu_expr& a, const gpu_expr& b) {return gpu_expr::binary("-",a,b);}
+gpu_expr operator*(const gpu_expr& a, const gpu_expr& b) {return gpu_expr::binary("*",a,b);}
+gpu_expr operator/(const gpu_expr& a, const gpu_expr& b) {return gpu_expr::binary("/",a,b);}
+gpu_expr operator-(const gpu_expr& a) {return gpu_expr::call("-",a);}
+
+//named gpu_*, so they do not hide the math functions in libj
+gpu_expr gpu_sqrt(const gpu_expr& a) {return gpu_expr::call("sqrt",a);}
+gpu_expr gpu_exp(const gpu_expr& a)  {return gpu_expr::call("exp",a);}
+gpu_expr gpu_log(const gpu_expr& a)  {return gpu_expr::call("log",a);}
+gpu_expr gpu_fabs(const gpu_expr& a) {return gpu_expr::call("fabs",a);}
+gpu_expr gpu_fmin(const gpu_expr& a, const gpu_expr& b) {return gpu_expr::call("fmin",a,b);}
+gpu_expr gpu_fmax(const gpu_expr& a, const gpu_expr& b) {return gpu_expr::call("fmax",a,b);}
+
+//--------------------------------------------------------------------------
+// source
+//	REAL is set in the build options, as the level-1 kernels. Each
+//	input is read once, into v<i>
+//--------------------------------------------------------------------------
+std::string gpu_expr::source(const char* name) const
+{
+  std::string src = "#if defined(REAL_IS_DOUBLE)\n"
+                    "  #pragma OPENCL EXTENSION cl_khr_fp64 : enable\n"
+                    "#endif\n";
+  src += "__kernel void " + std::string(name) + "(const long N";
+  for (int i=0;i<m_num_in;i++) {src += ", const __global REAL* x" + std::to_string(i);}
+  for (int j=0;j<m_num_scalar;j++) {src += ", const REAL s" + std::to_string(j);}
+  src += ", __global REAL* Z)\n{\n";
+  src += "  const long i = get_global_id(0);\n";
+  src += "  if (i >= N) return;\n";
+  for (int i=0;i<m_num_in;i++)
+  {
+    const std::string n = std::to_string(i);
+    src += "  const REAL v" + n + " = x" + n + "[i];\n";
+  }
+  src += "  Z[i] = " + m_text + ";\n}\n";
+  return src;
+}
+
+}//end libj namespace
+
+#endif
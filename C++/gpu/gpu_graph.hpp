@@ -0,0 +1,282 @@
+/*--------------------------------------------------------------------------
+  gpu_graph.hpp
+	JHT, October 14, 2026 : created
+	JHT, October 14, 2026 : the nodes are profiled with their GPU
+
+  .hpp file for GPU_GRAPH, a small DAG of non-blocking OpenCL commands
+  on the queues of one GPU. Each command is a node, which waits on the
+  events of the nodes it depends on, and returns its own node id. So a
+  write -> kernel -> read chain can be spread over several queues (see
+  GPU::add_queues), and the transfers of one block overlap the kernel
+  of another.
+
+  Nothing is blocking, so the host memory of a write or read must not be
+  touched until that node is waited on. The events are released by clear
+  or the destructor. If the GPU is profiled (gpu_prof.hpp), the event of
+  each command is also kept by the GPU_PROF, tagged by the kernel name,
+  or graph_write, graph_read, graph_copy.
+
+  Usage, double buffered streaming of blocks through kernel K, with
+  queue 1 for the transfers and queue 0 for the kernels
+  ---------------------------
+  GPU.add_queues(1);
+  libj::GPU_GRAPH graph(GPU.gpus[0]);
+  int run[2] = {-1,-1}, out[2] = {-1,-1};
+  for (int blk=0;blk<nblk;blk++)
+  {
+    const int b = blk % 2;  //buffer of this block
+    const int up = graph.write(1,buf[b],0,bytes,host_in[blk],{out[b]});
+    K.set_arg(0,sizeof(cl_mem),&buf[b]);
+    run[b] = graph.kernel(0,K,1,&n,NULL,{up});
+    out[b] = graph.read(1,buf[b],0,bytes,host_out[blk],{run[b]});
+  }
+  graph.wait_all();
+  graph.clear();
+--------------------------------------------------------------------------*/
+#ifndef GPU_GRAPH_HPP
+#define GPU_GRAPH_HPP
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include <algorithm>
+#ifdef __APPLE__
+  #include <OpenCL/opencl.h>
+#else
+  #include <CL/cl.h>
+#endif
+
+#include "gpu.hpp"
+#include "gpu_kernel.hpp"
+
+namespace libj
+{
+
+/*--------------------------------------------------------------------------
+  GPU_GRAPH
+--------------------------------------------------------------------------*/
+class GPU_GRAPH
+{
+  private:
+  const libj::GPU*              m_gpu;
+  std::vector<cl_event>         m_events;  //event of each node
+  std::vector<cl_command_queue> m_used;    //queues with commands
+
+  //wait list of the dependencies, -1 is no dependency
+  void m_wait_list(const std::vector<int>& deps, std::vector<cl_event>& list) const;
+  int  m_add(const cl_int err, const cl_event event, const int q, const char* name,
+             const char* tag, const char* kind, const size_t bytes);
+
+  GPU_GRAPH(const GPU_GRAPH& other);
+  GPU_GRAPH& operator= (const GPU_GRAPH& other);
+
+  public:
+  GPU_GRAPH(const libj::GPU& gpu) {m_gpu = &gpu;}
+  ~GPU_GRAPH() {clear();}
+
+  //commands, each returns its node id
+  int write(const int q, cl_mem buffer, const size_t offset, const size_t bytes,
+            const void* host, const std::vector<int>& deps = std::vector<int>());
+  int read(const int q, cl_mem buffer, const size_t offset, const size_t bytes,
+           void* host, const std::vector<int>& deps = std::vector<int>());
+  int copy(const int q, cl_mem src, cl_mem dst, const size_t src_offset,
+           const size_t dst_offset, const size_t bytes,
+           const std::vector<int>& deps = std::vector<int>());
+  int kernel(const int q, const libj::GPU_KERNEL& kernel, const size_t work_dim,
+             const size_t* global, const size_t* local,
+             const std::vector<int>& deps = std::vector<int>());
+
+  //a node that is done when all of deps are
+  int join(const int q, const std::vector<int>& deps);
+
+  //start the queued commands, wait for a node or all of them
+  void flush();
+  void wait(const int node);
+  void wait_all();
+
+  //wait for all nodes and release the events
+  void clear();
+
+  int num_nodes() const {return (int) m_events.size();}
+  cl_event event(const int node) const {return m_events[node];}
+};
+
+//--------------------------------------------------------------------------
+// m_wait_list
+//--------------------------------------------------------------------------
+void GPU_GRAPH::m_wait_list(const std::vector<int>& deps,
+                            std::vector<cl_event>& list) const
+{
+  list.clear();
+  for (size_t d=0;d<deps.size();d++)
+  {
+    if (deps[d] < 0) continue;
+    if (deps[d] >= (int) m_events.size())
+    {
+      printf("ERROR libj::GPU_GRAPH node %d does not exist\n",deps[d]);
+      exit(1);
+    }
+    list.push_back(m_events[deps[d]]);
+  }
+}
+
+//--------------------------------------------------------------------------
+// m_add
+//	adds the event of a command as a node, and gives the profiler its 
+//	own reference, kind is NULL for the joins
+//--------------------------------------------------------------------------
+int GPU_GRAPH::m_add(const cl_int err, const cl_event event, const int q,
+                     const char* name, const char* tag, const char* kind,
+                     const size_t bytes)
+{
+  if (err != CL_SUCCESS)
+  {
+    printf("ERROR libj::GPU_GRAPH::%s failed on queue %d with code %d\n",name,q,err);
+    exit(1);
+  }
+  if (m_gpu->prof != NULL && kind != NULL)
+  {
+    clRetainEvent(event);
+    m_gpu->prof_record(err,event,m_gpu->queue(q),tag,kind,(double) bytes);
+  }
+  const cl_command_queue queue = m_gpu->queue(q);
+  if (std::find(m_used.begin(),m_used.end(),queue) == m_used.end())
+  {
+    m_used.push_back(queue);
+  }
+  m_events.push_back(event);
+  return (int) m_events.size() - 1;
+}
+
+//--------------------------------------------------------------------------
+// write
+//--------------------------------------------------------------------------
+int GPU_GRAPH::write(const int q, cl_mem buffer, const size_t offset,
+                     const size_t bytes, const void* host,
+                     const std::vector<int>& deps)
+{
+  std::vector<cl_event> list;
+  m_wait_list(deps,list);
+  cl_event event;
+  cl_int err = clEnqueueWriteBuffer(m_gpu->queue(q),buffer,CL_FALSE,offset,bytes,host,
+                                    (cl_uint) list.size(),list.empty() ? NULL : list.data(),
+                                    &event);
+  return m_add(err,event,q,"write","graph_write","h2d",bytes);
+}
+
+//--------------------------------------------------------------------------
+// read
+//--------------------------------------------------------------------------
+int GPU_GRAPH::read(const int q, cl_mem buffer, const size_t offset,
+                    const size_t bytes, void* host, const std::vector<int>& deps)
+{
+  std::vector<cl_event> list;
+  m_wait_list(deps,list);
+  cl_event event;
+  cl_int err = clEnqueueReadBuffer(m_gpu->queue(q),buffer,CL_FALSE,offset,bytes,host,
+                                   (cl_uint) list.size(),list.empty() ? NULL : list.data(),
+                                   &event);
+  return m_add(err,event,q,"read","graph_read","d2h",bytes);
+}
+
+//--------------------------------------------------------------------------
+// copy
+//	device to device
+//--------------------------------------------------------------------------
+int GPU_GRAPH::copy(const int q, cl_mem src, cl_mem dst, const size_t src_offset,
+                    const size_t dst_offset, const size_t bytes,
+                    const std::vector<int>& deps)
+{
+  std::vector<cl_event> list;
+  m_wait_list(deps,list);
+  cl_event event;
+  cl_int err = clEnqueueCopyBuffer(m_gpu->queue(q),src,dst,src_offset,dst_offset,bytes,
+                                   (cl_uint) list.size(),list.empty() ? NULL : list.data(),
+                                   &event);
+  return m_add(err,event,q,"copy","graph_copy","d2d",bytes);
+}
+
+//--------------------------------------------------------------------------
+// kernel
+//	the arguments of the kernel are read when it is queued, so they can
+//	be set again for the next node
+//--------------------------------------------------------------------------
+int GPU_GRAPH::kernel(const int q, const libj::GPU_KERNEL& kernel,
+                      const size_t work_dim, const size_t* global,
+                      const size_t* local, const std::vector<int>& deps)
+{
+  std::vector<cl_event> list;
+  m_wait_list(deps,list);
+  cl_event event;
+  cl_int err = clEnqueueNDRangeKernel(m_gpu->queue(q),kernel.kernel,(cl_uint) work_dim,
+                                      NULL,global,local,(cl_uint) list.size(),
+                                      list.empty() ? NULL : list.data(),&event);
+  return m_add(err,event,q,"kernel",kernel.name.c_str(),"kernel",0);
+}
+
+//--------------------------------------------------------------------------
+// join
+//--------------------------------------------------------------------------
+int GPU_GRAPH::join(const int q, const std::vector<int>& deps)
+{
+  std::vector<cl_event> list;
+  m_wait_list(deps,list);
+  cl_event event;
+  cl_int err = clEnqueueMarkerWithWaitList(m_gpu->queue(q),(cl_uint) list.size(),
+                                           list.empty() ? NULL : list.data(),&event);
+  return m_add(err,event,q,"join",NULL,NULL,0);
+}
+
+//--------------------------------------------------------------------------
+// flush
+//	send the commands of every used queue to the device
+//--------------------------------------------------------------------------
+void GPU_GRAPH::flush()
+{
+  for (size_t q=0;q<m_used.size();q++) {clFlush(m_used[q]);}
+}
+
+//--------------------------------------------------------------------------
+// wait
+//--------------------------------------------------------------------------
+void GPU_GRAPH::wait(const int node)
+{
+  if (node < 0 || node >= (int) m_events.size()) return;
+  flush();
+  cl_int err = clWaitForEvents(1,&m_events[node]);
+  if (err != CL_SUCCESS)
+  {
+    printf("ERROR libj::GPU_GRAPH::wait node %d failed with code %d\n",node,err);
+    exit(1);
+  }
+}
+
+//--------------------------------------------------------------------------
+// wait_all
+//--------------------------------------------------------------------------
+void GPU_GRAPH::wait_all()
+{
+  if (m_events.empty()) return;
+  flush();
+  cl_int err = clWaitForEvents((cl_uint) m_events.size(),m_events.data());
+  if (err != CL_SUCCESS)
+  {
+    printf("ERROR libj::GPU_GRAPH::wait_all failed with code %d\n",err);
+    exit(1);
+  }
+}
+
+//--------------------------------------------------------------------------
+// clear
+//--------------------------------------------------------------------------
+void GPU_GRAPH::clear()
+{
+  wait_all();
+  for (size_t node=0;node<m_events.size();node++) {clReleaseEvent(m_events[node]);}
+  m_events.clear();
+  m_used.clear();
+}
+
+}//end libj namespace
+
+#endif
@@ -1,6 +1,20 @@
 /*--------------------------------------------------------------------------
   gpu_handler.hpp
 	JHT, April 14, 2022 : created
+	JHT, October 14, 2026 : added gemm, enqueue_write, and enqueue_read
+	JHT, October 14, 2026 : gemm of device buffers
+	JHT, October 14, 2026 : added add_queues
+	JHT, October 14, 2026 : work split over all GPUs, axpy and scal
+	JHT, October 14, 2026 : level-1 functions of device buffers
+	JHT, October 14, 2026 : permute of device buffers
+	JHT, October 14, 2026 : tuned tiles and work groups
+	JHT, October 14, 2026 : half storage and mixed precision gemm
+	JHT, October 14, 2026 : fused element-wise kernels
+	JHT, October 14, 2026 : gemm on the GPUs and the host at once
+	JHT, October 14, 2026 : batched small gemm
+	JHT, October 14, 2026 : out of core gemm
+	JHT, October 14, 2026 : lazy initialization, devices of the local rank
+	JHT, October 14, 2026 : device timing of the commands
 
   .hpp file for the GPU handler
 
@@ -10,11 +24,157 @@
   This is currently coded only to work with the platform with the largest
   number of GPUs on it. 
 
+  Nothing is asked of OpenCL when the handler is made. The platforms, 
+  devices, context, and queues are set up by init(), which every function
+  of the handler calls first, so a process that never uses the GPUs never
+  starts the driver. init_async() starts it in a background thread, to
+  overlap it with the setup of the caller. Code that uses the members 
+  (gpus, platform) directly must call init() first. 
+
+  Only the devices of the local rank are used (see local_devices): those
+  of LIBJ_GPU_DEVICES (e.g., "0,2") if set, or else the GPUs of the node
+  dealt out round robin to the local ranks given by the MPI launcher
+
+  libj::GPU_HANDLER GPU;	//nothing done yet
+  GPU.init_async();		//start the driver in the background
+  ...
+  GPU.init();			//waits for it, as the first use would
+
   Program and kernel are currently stored in this GPU_HANDLER, but could 
   probably be moved to the specific plaform...?
 
   Buffers are created on the GPU_HANDLER object, which returns an 
-  int to identify the buffer for the calling program
+  int to identify the buffer for the calling program. For tensors that
+  stay on the GPU between steps, and are only copied when needed, use 
+  libj::device_tensor (device_tensor.hpp). Each add_buffer is a new 
+  clCreateBuffer, so intermediates that come and go every iteration 
+  should be checked out of a GPU_POOL (gpu_pool.hpp) instead
+
+  Each GPU has the queue gpus[i].commands (queue 0), and add_queues makes
+  more on every GPU, so that transfers and kernels can overlap. The order
+  between them is given by the events of a GPU_GRAPH (gpu_graph.hpp)
+
+  gemm does C = ALPHA*op(A).B + BETA*C on one GPU for host matrices (column
+  major, as linal), with the tiled kernels of gemm_kernel.h. The programs
+  are built on the first call for each type (double or float), and the
+  matrices are copied into zero padded device buffers, which are kept 
+  and grown for the next call. See linal_gpu.hpp for the linal versions.
+
+  GPU.gemm<double>(false,M,N,K,1.0,A,B,0.0,C);   //C = A.B
+  GPU.gemm<double>(true,M,N,K,1.0,A,B,1.0,C);    //C += A^T.B
+  GPU.gemm<double>(false,M,N,K,1.0,dA,dB,0.0,dC); //cl_mem, stays on the GPU
+
+  With gpu = GPU_ALL, the host gemm, axpy, and scal split their work over
+  all GPUs of the platform (each with its own queue and buffers), in
+  proportion to max_compute_units. gemm splits the columns of B and C in
+  tiles of TSN, so every GPU gets all of A. The parts are queued
+  on every GPU before any is waited on, so the GPUs run at once.
+
+  GPU.gemm<double>(false,M,N,K,1.0,A,B,0.0,C,GPU_ALL);
+  GPU.axpy<double>(N,2.0,X,Y,GPU_ALL);                //Y = 2X + Y
+
+  gemm_hybrid splits the columns of B and C in tiles of GPU_HYBRID_TILE
+  (a multiple of TSN), and hands them out as they are asked for to a 
+  thread for each GPU and to the caller, which does its tiles with the 
+  given host gemm (e.g., linal_ABpC, see linal_gpu.hpp), so the cores are
+  not idle while the GPUs work. Each worker takes a part of what is left
+  in proportion to its flops/s, which are measured on every call and
+  kept for the next, and a worker that would finish one tile after the
+  others could do all that is left stops taking them.
+
+  GPU.gemm_hybrid<double>(false,M,N,K,1.0,A,B,0.0,C,host);
+
+  The level-1 functions of simd.hpp also work on device buffers (cl_mem,
+  e.g., of a device_tensor, see the device_* functions there), on the 
+  queue of one GPU, so iterative solvers can keep their vectors on the 
+  GPU. Only the results of dot and reduction_add come back
+
+  double d = GPU.dot<double>(N,dX,dY);     
+  GPU.axpby<double>(N,A,dX,B,dY);           //dY = A*dX + B*dY
+
+  fuse does Z = expr for an element-wise gpu_expr (gpu_fuse.hpp) of 
+  device buffers and scalars, in one kernel made from the expression.
+  The kernels are kept by the hash of their source and type, so each
+  expression is built once (and loaded from the binary cache after the 
+  first run), and is launched as the level-1 kernels
+
+  GPU.fuse<double>(N,a*x + b*y*w,{dX,dY,dW},{A,B},dZ);
+
+  permute does B = ALPHA*A + BETA*B for any order of the dimensions of a
+  strided device tensor A, with the kernels of permute_kernel.h. The 
+  strides of B are given for each dimension of A. See jblis_gpu.hpp for 
+  the jblis permute and contract on the GPU
+
+  //B(j,i,k) = A(i,j,k), A is n0 x n1 x n2
+  const size_t len[3] = {n0,n1,n2};
+  const long   sA[3]  = {1,n0,n0*n1};
+  const long   sB[3]  = {n1,1,n0*n1};
+  GPU.permute<double>(3,len,sA,dA,sB,dB,1.0,0.0);
+
+  gemm_ooc does the host gemm for matrices of any size, through a fixed
+  working set on one GPU (budget bytes, or GPU_OOC_FRACTION of its global
+  memory), in tiles of C (mt x nt) and chunks of K (kt), each buffer under
+  max_alloc_size. The panels of A and B of each step are packed (zero
+  padded) by the host into one of three pinned staging buffers, written
+  on queue 1 into one of three device panels, multiplied on queue 0 into
+  one of two C tiles, and C is read on queue 2, all ordered by the events
+  of a GPU_GRAPH, so that the packing of step s+2, the writes of s+1, the 
+  kernel of s, and the read of the last tile all run at once. A step is
+  2*mt*nt*kt flops for (mt+nt)*kt elements over the bus, so with tiles of
+  a few thousand it is bound by the kernel, not the bus
+
+  GPU.gemm_ooc<double>(false,M,N,K,1.0,A,B,0.0,C);          //A, B, C host
+
+  gemm_batch does many small products (e.g., the blocks of a symmetry 
+  blocked tensor) of matrices at offsets into three device buffers in a
+  few launches, with the kernel of batch_kernel.h. Each gpu_batch_entry
+  is one C = ALPHA*op(A).B + BETA*C. The host sorts the batch by the 
+  tiles of each product and launches each class once, and a work group
+  does one product of up to 16 x 16 at a time, or four of up to 8 x 8, 
+  or sixteen of up to 4 x 4
+
+  std::vector<libj::gpu_batch_entry> batch;
+  const libj::gpu_batch_entry e = {M,N,K,offA,offB,offC,0,0,0}; //dense
+  batch.push_back(e);
+  GPU.gemm_batch<double>(false,batch,1.0,dA,dB,0.0,dC);
+
+  gemm_mixed does the double gemm with A and B stored in lower precision
+  on the GPU (float, or gpu_half: halfs accumulated in floats), and C 
+  read back as floats. With refine, the residuals Ar = A - low(A) and 
+  Br = B - low(B) are also sent, scaled by gpu_real<S>::scale() so the
+  halfs do not underflow, and the host adds
+
+    C = ALPHA*(Ah.Bh + ([s*Ar Ah].[Bh ; s*Br])/s) + BETA*C
+
+  in double, the second product in one gemm with 2K. This gets most of 
+  the digits lost in the storage back (Markidis et al., 2018) for about
+  three times the flops of one product. Halfs need |A|, |B| < 65504
+
+  GPU.gemm_mixed<gpu_half>(false,M,N,K,1.0,A,B,0.0,C,true); //A, B double
+
+  With LIBJ_CL_PROFILE=1 (or GPU.prof.enable() before init), the queues
+  are made with profiling, and the kernels, transfers, copies, and fills
+  of the handler are timed on the device by the GPU_PROF of the handler,
+  tagged by the kernel name, or the name of the buffer (that given to
+  add_buffer, or that of the internal buffers: "gemm A", "axpy X", ...).
+  The times go into the profiler and the trace (see gpu_prof.hpp)
+
+  GPU.prof.report(stdout);	//device time of each command, idle time
+
+  The first load of each program is tuned by the GPU_TUNER (gpu_tuner.hpp)
+  of the handler, which times the candidates and keeps the winners on 
+  disk next to the program binaries:
+
+    gemm      : the tiles (TSM,TSN,TSK,WPTM,WPTN) of each type (and of
+                the half storage)
+    permute   : the rows of each work group (PROWS) of each type
+    level-1   : the work group size, and the number of groups of the
+                reductions, of each GPU
+
+  The programs are built for all GPUs of the platform at once, so the
+  tiles of gemm and permute are tuned on GPU 0. The defaults of 
+  gemm_kernel.h, permute_kernel.h, and blas1_kernel.h are always tried,
+  and are all that is used with LIBJ_CL_TUNE=0.
 
 --------------------------------------------------------------------------*/
 #ifndef GPU_HANDLER_HPP
@@ -22,8 +182,18 @@
 #include <stdio.h>
 #include <vector>
 #include <assert.h>
+#include <cstdlib>
 #include <string>
 #include <algorithm>
+#include <map>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <stdint.h>
+#include <cmath>
 #ifdef __APPLE__
   #include <OpenCL/opencl.h>
 #else
@@ -35,9 +205,155 @@
 #include "gpu.hpp"
 #include "gpu_program.hpp"
 #include "gpu_kernel.hpp"
+#include "gpu_graph.hpp"
+#include "gemm_kernel.h"
+#include "blas1_kernel.h"
+#include "permute_kernel.h"
+#include "batch_kernel.h"
+#include "gpu_fuse.hpp"
+#include "gpu_tuner.hpp"
+
+//sizes of the problems the tuner times
+#if !defined (GPU_TUNE_GEMM_N)
+  #define GPU_TUNE_GEMM_N 1024
+#endif
+#if !defined (GPU_TUNE_BLAS1_N)
+  #define GPU_TUNE_BLAS1_N (1 << 22)
+#endif
+#if !defined (GPU_TUNE_PERMUTE_N)
+  #define GPU_TUNE_PERMUTE_N 2048
+#endif
+
+//part of the global memory of the GPU that gemm_ooc uses by default
+#if !defined (GPU_OOC_FRACTION)
+  #define GPU_OOC_FRACTION 0.5
+#endif
+
+//columns of the tiles of gemm_hybrid
+#if !defined (GPU_HYBRID_TILE)
+  #define GPU_HYBRID_TILE 256
+#endif
 
 namespace libj
 {
+/*------------------------------------------------------------------------
+ gpu_half_from, gpu_half_to
+    float to the bits of a half (rounded to nearest even), and back
+------------------------------------------------------------------------*/
+inline cl_half gpu_half_from(const float f)
+{
+  uint32_t x;
+  memcpy(&x,&f,sizeof(x));
+  const uint32_t sign = (x >> 16) & 0x8000;
+  const int      fexp = (int) ((x >> 23) & 0xff);
+  const int      exp  = fexp - 127 + 15;
+  uint32_t       man  = x & 0x7fffff;
+  if (fexp == 0xff) return (cl_half) (sign | 0x7c00 | (man ? 0x200 : 0));
+  if (exp >= 31)    return (cl_half) (sign | 0x7c00);
+  if (exp < -10)    return (cl_half) sign;
+  int shift = 13;
+  uint32_t h;
+  if (exp <= 0) 
+  {
+    man  |= 0x800000;
+    shift = 14 - exp;
+    h     = man >> shift;
+  }
+  else
+  {
+    h = ((uint32_t) exp << 10) | (man >> shift);
+  }
+  const uint32_t rem  = man & ((1u << shift) - 1);
+  const uint32_t half = 1u << (shift - 1);
+  if (rem > half || (rem == half && (h & 1))) {h++;} //may carry into exp
+  return (cl_half) (sign | h);
+}
+
+inline float gpu_half_to(const cl_half h)
+{
+  const int      exp = (h >> 10) & 0x1f;
+  const uint32_t man = h & 0x3ff;
+  if (exp == 0) 
+  {
+    const float f = (float) man*5.9604644775390625e-8f; //2^-24
+    return (h & 0x8000) ? -f : f;
+  }
+  const uint32_t x = ((uint32_t) (h & 0x8000) << 16) | 
+                     ((exp == 31) ? 0x7f800000 : (uint32_t) (exp + 112) << 23) | 
+                     (man << 13);
+  float f;
+  memcpy(&f,&x,sizeof(f));
+  return f;
+}
+
+/*------------------------------------------------------------------------
+ gpu_real
+    index and build options of the gemm program of each type, the
+    types of A and B (store) and of the scalars and C (real) in the 
+    kernel, the conversions of a double to and from store, and the scale 
+    of the residuals of gemm_mixed. gpu_half is a tag, A and B are halfs
+    and the rest floats
+------------------------------------------------------------------------*/
+struct gpu_half {};
+
+template <typename T> struct gpu_real {};
+template <> struct gpu_real<double> 
+{
+  typedef double store;
+  typedef double real;
+  static int id() {return 0;}
+  static const char* options() {return "-DREAL_IS_DOUBLE -DREAL=double -DREAL4=double4";}
+};
+template <> struct gpu_real<float>  
+{
+  typedef float store;
+  typedef float real;
+  static int id() {return 1;}
+  static const char* options() {return "-DREAL=float -DREAL4=float4";}
+  static store to(const double x) {return (float) x;}
+  static double from(const store x) {return (double) x;}
+  static double scale() {return 1.0;}
+};
+template <> struct gpu_real<gpu_half>  
+{
+  typedef cl_half store;
+  typedef float   real;
+  static int id() {return 2;}
+  static const char* options() {return "-DREAL_IS_HALF -DREAL=float -DREAL4=float4";}
+  static store to(const double x) {return gpu_half_from((float) x);}
+  static double from(const store x) {return (double) gpu_half_to(x);}
+  static double scale() {return 2048.0;}
+};
+
+/*------------------------------------------------------------------------
+ gpu_gemm_tile
+    tiles of a gemm program, see gemm_kernel.h
+------------------------------------------------------------------------*/
+struct gpu_gemm_tile
+{
+  int tsm, tsn, tsk, wptm, wptn;
+};
+
+/*------------------------------------------------------------------------
+ gpu_batch_entry
+    one product of gemm_batch, the offsets (in elements) of A, B, and C 
+    in their buffers, and the leading dimensions, 0 for dense
+------------------------------------------------------------------------*/
+struct gpu_batch_entry
+{
+  int  M, N, K;
+  long a, b, c;
+  int  lda, ldb, ldc;
+};
+
+//kernels of the level-1 program, in the order of gpu_blas1_names
+enum gpu_blas1_op {GPU_AXPY = 0, GPU_AXPBY, GPU_SCAL_MUL, GPU_SCAL_ADD, 
+                   GPU_ELEMWISE_ADD, GPU_ELEMWISE_MUL, GPU_DOT_PART, 
+                   GPU_SUM_PART, GPU_REDUCE_PART, GPU_BLAS1_NUM};
+static const char* gpu_blas1_names[GPU_BLAS1_NUM] = 
+  {"axpy","axpby","scal_mul","scal_add","elemwise_add","elemwise_mul",
+   "dot_part","sum_part","reduce_part"};
+
 /*------------------------------------------------------------------------
  GPU_HANDLER
     handles the interface with OpenCL
@@ -48,6 +364,58 @@ class GPU_HANDLER
     void init_platforms();
     void init_gpus();
     void init_context();
+    void local_devices(const int ndev, std::vector<int>& keep) const;
+    void reserve(cl_mem& buffer, size_t& have, const size_t bytes, const char* name);
+    void load_type(const int type, const char* source, libj::GPU_PROGRAM& program,
+                   const char* extra);
+    void build_gemm(const int type);
+    void build_permute(const int type);
+    template <typename T>
+    double time_gemm();
+    template <typename T>
+    double time_permute();
+    template <typename T>
+    void tune_blas1(const int gpu);
+    template <typename T>
+    void gemm_setup(const bool transA, const int M, const int N, const int K,
+                    size_t* rows, size_t* cols, size_t* prow, size_t* pad, 
+                    const int gpu);
+    template <typename T>
+    libj::GPU_KERNEL& gemm_args(const bool transA, const size_t* pad, 
+                                const typename gpu_real<T>::real ALPHA, 
+                                const cl_mem A, const cl_mem B,
+                                const typename gpu_real<T>::real BETA, const cl_mem C,
+                                size_t* global, size_t* local);
+    template <typename T>
+    void gemm_run(const bool transA, const size_t* pad, 
+                  const typename gpu_real<T>::real ALPHA, 
+                  const typename gpu_real<T>::real BETA, const int gpu);
+    template <typename T>
+    void gemm_enqueue(const bool transA, const int M, const int N, const int K,
+                      const typename gpu_real<T>::real ALPHA, 
+                      const typename gpu_real<T>::store* A, 
+                      const typename gpu_real<T>::store* B, 
+                      const typename gpu_real<T>::real BETA, 
+                      typename gpu_real<T>::real* C, const int gpu);
+    template <typename T>
+    void blas1(const int op, const long N, const T ALPHA, const T* X, T* Y, 
+               const int gpu);
+    template <typename T>
+    libj::GPU_KERNEL& blas1_get(const int op);
+    void blas1_launch(libj::GPU_KERNEL& kernel, const long N, const int gpu);
+    template <typename T>
+    T blas1_reduce(const int op, const long N, const cl_mem X, const cl_mem Y, 
+                   const int gpu);
+    void finish(const int gpu);
+
+    //lazy initialization, see init
+    std::mutex        m_init_lock;
+    std::thread       m_init_thread;
+    std::atomic<bool> m_ready;
+
+    //no copies, the background init holds this
+    GPU_HANDLER(const GPU_HANDLER& other);
+    GPU_HANDLER& operator= (const GPU_HANDLER& other);
 
   public:
   //Platform data
@@ -65,43 +433,198 @@ class GPU_HANDLER
   //Kernel Data
   libj::GPU_KERNEL kernel;
 
-  //Buffers
+  //Buffers, and their names for the profiling (NULL if none)
   std::vector<cl_mem> buffers;
+  std::vector<const char*> buffer_names;
+
+  //GEMM programs and kernels of each type (and the half storage), and the 
+  //padded A, B, C buffers of each GPU, at [3*gpu + buf]
+  libj::GPU_PROGRAM   gemm_program[3];
+  libj::GPU_KERNEL    gemm_kernel[3][2]; //[type][nn,tn]
+  bool                gemm_loaded[3];
+  gpu_gemm_tile       gemm_tile[3];
+  std::vector<cl_mem> gemm_buffer;
+  std::vector<size_t> gemm_bytes;
+
+  //level-1 programs and kernels of each type, the X, Y buffers of each 
+  //GPU, at [2*gpu + buf], and the partial sums of each GPU
+  libj::GPU_PROGRAM   blas1_program[2];
+  libj::GPU_KERNEL    blas1_kernel[2][GPU_BLAS1_NUM]; //[type][gpu_blas1_op]
+  bool                blas1_loaded[2];
+  std::vector<cl_mem> blas1_buffer;
+  std::vector<size_t> blas1_bytes;
+  std::vector<cl_mem> blas1_part;
+  std::vector<size_t> blas1_part_bytes;
+  std::vector<size_t> blas1_local;    //work group of each GPU, 0 if not tuned
+  std::vector<size_t> reduce_groups;  //groups of the reductions of each GPU
+
+  //permute programs and kernels of each type
+  libj::GPU_PROGRAM   perm_program[2];
+  libj::GPU_KERNEL    perm_kernel[2][2]; //[type][tiled,copy]
+  bool                perm_loaded[2];
+  int                 perm_rows[2];
+
+  //batched gemm programs and kernels of each type, and the dims and 
+  //offsets buffers of each GPU, at [2*gpu + buf]
+  libj::GPU_PROGRAM   batch_program[2];
+  libj::GPU_KERNEL    batch_kernel[2];
+  bool                batch_loaded[2];
+  std::vector<cl_mem> batch_buffer;
+  std::vector<size_t> batch_bytes;
+
+  //measured flops/s of gemm_hybrid on the host [0], and each GPU [1+gpu], 
+  //of each type, 0 until measured
+  std::vector<double> hybrid_rate[2];
+
+  //fused kernels, at fuse_index[hash of the source and type]
+  std::map<unsigned long long,size_t> fuse_index;
+  std::vector<libj::GPU_PROGRAM>      fuse_program;
+  std::vector<libj::GPU_KERNEL>       fuse_kernel;
+
+  //tuned parameters of the programs
+  libj::GPU_TUNER     tuner;
+
+  //device timing of the commands, if enabled before init
+  libj::GPU_PROF      prof;
   
-  //Initialization 
+  //Initialization, nothing is done until init (or the first use)
    GPU_HANDLER();
-//  ~GPU_HANDLER();
+  ~GPU_HANDLER();
+  void init();
+  void init_async();
+  bool is_init() const {return m_ready.load(std::memory_order_acquire);}
 
-  //GPU data functions
-  int get_num_gpu() const {return (int) gpus.size();}
+  //GPU data functions, which init the handler on first use
+  int get_num_gpu() const {const_cast<GPU_HANDLER*>(this)->init(); return (int) gpus.size();}
   void print_gpu_info() const; 
 
+  //split n into parts for each GPU, in multiples of block, by compute units
+  void split(const size_t n, const size_t block, std::vector<size_t>& offsets) const;
+
+  //Queue functions
+  void add_queues(const int num, const bool out_of_order = false);
+
   //Program functions
   void load_program(const char* source);
 
   //Buffer functions
   int add_buffer(const cl_mem_flags flags, const size_t bytes,
-                 void* pointer);
+                 void* pointer, const char* name = NULL);
 
-  /*
   void enqueue_write(const int buffer_id, const cl_bool blocking, 
-                     const size_t offset, const size_t size, const void* host_pointer)
-  {
-    err = clEnqueueWriteBuffer(commands,buffers[buffer_id],blocking,offset,size,host_pointer,
-                               0,NULL,NULL);
-    assert(err == CL_SUCCESS); 
-  }
-  */
+                     const size_t offset, const size_t size, 
+                     const void* host_pointer, const int gpu = 0);
+  void enqueue_read(const int buffer_id, const cl_bool blocking, 
+                    const size_t offset, const size_t size, 
+                    void* host_pointer, const int gpu = 0);
+
+  //GEMM functions
+  void load_gemm(const int type);
+  template <typename T>
+  void gemm(const bool transA, const int M, const int N, const int K,
+            const T ALPHA, const T* A, const T* B, const T BETA, T* C,
+            const int gpu = 0);
+  template <typename T>
+  void gemm(const bool transA, const int M, const int N, const int K,
+            const T ALPHA, const cl_mem A, const cl_mem B, const T BETA, cl_mem C,
+            const int gpu = 0);
+  template <typename T>
+  void gemm_ooc(const bool transA, const int M, const int N, const int K,
+                const T ALPHA, const T* A, const T* B, const T BETA, T* C,
+                const size_t budget = 0, const int gpu = 0);
+  template <typename T>
+  void gemm_hybrid(const bool transA, const int M, const int N, const int K,
+                   const T ALPHA, const T* A, const T* B, const T BETA, T* C,
+                   const std::function<void(const int NN, const T* Bj, T* Cj)>& host);
+  void load_batch(const int type);
+  template <typename T>
+  void gemm_batch(const bool transA, const std::vector<gpu_batch_entry>& batch,
+                  const T ALPHA, const cl_mem A, const cl_mem B, const T BETA,
+                  cl_mem C, const int gpu = 0);
+  template <typename S>
+  void gemm_mixed(const bool transA, const int M, const int N, const int K,
+                  const double ALPHA, const double* A, const double* B, 
+                  const double BETA, double* C, const bool refine = false,
+                  const int gpu = 0);
+
+  //level-1 functions
+  void load_blas1(const int type);
+  template <typename T>
+  void axpy(const long N, const T ALPHA, const T* X, T* Y, const int gpu = 0);
+  template <typename T>
+  void scal(const long N, const T ALPHA, T* X, const int gpu = 0);
+
+  //level-1 functions of device buffers, as simd.hpp
+  template <typename T>
+  void axpy(const long N, const T A, const cl_mem X, cl_mem Y, const int gpu = 0);
+  template <typename T>
+  void axpby(const long N, const T A, const cl_mem X, const T B, cl_mem Y, 
+             const int gpu = 0);
+  template <typename T>
+  void scal_mul(const long N, const T A, cl_mem X, const int gpu = 0);
+  template <typename T>
+  void scal_add(const long N, const T A, cl_mem X, const int gpu = 0);
+  template <typename T>
+  void scal_set(const long N, const T A, cl_mem X, const int gpu = 0);
+  template <typename T>
+  void zero(const long N, cl_mem X, const int gpu = 0) {scal_set<T>(N,(T) 0,X,gpu);}
+  template <typename T>
+  void copy(const long N, const cl_mem X, cl_mem Y, const int gpu = 0);
+  template <typename T>
+  void elemwise_add(const long N, const cl_mem X, const cl_mem Y, cl_mem Z, 
+                    const int gpu = 0);
+  template <typename T>
+  void elemwise_mul(const long N, const cl_mem X, const cl_mem Y, cl_mem Z, 
+                    const int gpu = 0);
+  template <typename T>
+  T dot(const long N, const cl_mem X, const cl_mem Y, const int gpu = 0);
+  template <typename T>
+  T reduction_add(const long N, const cl_mem X, const int gpu = 0);
+
+  //fused element-wise kernel of device buffers, Z = expr
+  template <typename T>
+  void fuse(const long N, const gpu_expr& expr, const std::vector<cl_mem>& in,
+            const std::vector<T>& scalars, cl_mem Z, const int gpu = 0);
+
+  //permute of device buffers, B = ALPHA*A + BETA*B 
+  void load_permute(const int type);
+  template <typename T>
+  void permute(const int ndim, const size_t* len, const long* strideA, 
+               const cl_mem A, const long* strideB, cl_mem B, const T ALPHA,
+               const T BETA, const int gpu = 0);
 
 };
 
 
 //--------------------------------------------------------------------------
 // Constructor
-//      Initializes the GPU information
+//      nothing is asked of OpenCL until init
+//--------------------------------------------------------------------------
+GPU_HANDLER::GPU_HANDLER() : m_ready(false), num_platforms(0), num_gpu(0)
+{
+}
+
+//--------------------------------------------------------------------------
+// Destructor
+//	waits for init_async, the OpenCL objects are kept as before
 //--------------------------------------------------------------------------
-GPU_HANDLER::GPU_HANDLER()
+GPU_HANDLER::~GPU_HANDLER()
 {
+  if (m_init_thread.joinable()) {m_init_thread.join();}
+}
+
+//--------------------------------------------------------------------------
+// init
+//	discovers the GPUs of the local rank and makes the context and 
+//	queues, once. Every function of the handler calls this first, and
+//	it waits for an init_async that is running
+//--------------------------------------------------------------------------
+void GPU_HANDLER::init()
+{
+  if (m_ready.load(std::memory_order_acquire)) {return;}
+  std::lock_guard<std::mutex> lock(m_init_lock);
+  if (m_ready.load(std::memory_order_relaxed)) {return;}
+
   printf("Initializing OpenCL enviroment\n");
   
   //get the plaform vector
@@ -113,6 +636,46 @@ GPU_HANDLER::GPU_HANDLER()
   //set the context
   init_context();
 
+  //the gemm programs are built on first use
+  for (int type=0;type<3;type++) 
+  {
+    gemm_loaded[type] = false; 
+    const gpu_gemm_tile tile = {GPU_GEMM_TSM,GPU_GEMM_TSN,GPU_GEMM_TSK,
+                                GPU_GEMM_WPTM,GPU_GEMM_WPTN};
+    gemm_tile[type] = tile;
+  }
+  for (int type=0;type<2;type++) 
+  {
+    blas1_loaded[type] = false;
+    perm_loaded[type] = false;
+    batch_loaded[type] = false;
+    perm_rows[type] = GPU_PERMUTE_ROWS;
+    hybrid_rate[type].assign(1+num_gpu,0.0);
+  }
+  gemm_buffer.assign(3*num_gpu,(cl_mem) NULL);
+  gemm_bytes.assign(3*num_gpu,0);
+  batch_buffer.assign(2*num_gpu,(cl_mem) NULL);
+  batch_bytes.assign(2*num_gpu,0);
+  blas1_buffer.assign(2*num_gpu,(cl_mem) NULL);
+  blas1_bytes.assign(2*num_gpu,0);
+  blas1_part.assign(num_gpu,(cl_mem) NULL);
+  blas1_part_bytes.assign(num_gpu,0);
+  blas1_local.assign(num_gpu,0);
+  reduce_groups.assign(num_gpu,GPU_REDUCE_GROUPS);
+
+  m_ready.store(true,std::memory_order_release);
+}
+
+//--------------------------------------------------------------------------
+// init_async
+//	starts init in a background thread, so the driver starts up while
+//	the caller does other work. Call it at most once
+//--------------------------------------------------------------------------
+void GPU_HANDLER::init_async()
+{
+  std::lock_guard<std::mutex> lock(m_init_lock);
+  if (m_ready.load(std::memory_order_relaxed) || m_init_thread.joinable()) {return;}
+  m_init_thread = std::thread([this]{init();});
 }
 
 //--------------------------------------------------------------------------
@@ -142,6 +705,60 @@ void GPU_HANDLER::init_platforms()
 
 }
 
+//--------------------------------------------------------------------------
+// local_devices
+//	the devices (of ndev) this process uses. LIBJ_GPU_DEVICES is a 
+//	comma separated list of them, e.g., "0,2". Otherwise, with the local
+//	rank and number of ranks on the node from the launcher (Open MPI, 
+//	MPICH, or Slurm), the devices are dealt out round robin, and ranks
+//	share a device if there are more of them. Without either, all
+//--------------------------------------------------------------------------
+void GPU_HANDLER::local_devices(const int ndev, std::vector<int>& keep) const
+{
+  keep.clear();
+  const char* env = getenv("LIBJ_GPU_DEVICES");
+  if (env != NULL)
+  {
+    const char* c = env;
+    while (*c != '\0')
+    {
+      char* end;
+      const long dev = strtol(c,&end,10);
+      if (end == c) {c++; continue;}
+      if (dev >= 0 && dev < ndev && 
+          std::find(keep.begin(),keep.end(),(int) dev) == keep.end()) {keep.push_back((int) dev);}
+      c = end;
+    }
+    if (keep.empty())
+    {
+      printf("ERROR libj::GPU_HANDLER LIBJ_GPU_DEVICES=%s has none of the %d GPUs\n",env,ndev);
+      exit(1);
+    }
+    return;
+  }
+
+  const char* ranks[] = {"OMPI_COMM_WORLD_LOCAL_RANK","MPI_LOCALRANKID","SLURM_LOCALID"};
+  const char* sizes[] = {"OMPI_COMM_WORLD_LOCAL_SIZE","MPI_LOCALNRANKS","SLURM_NTASKS_PER_NODE"};
+  int rank = -1, size = 0;
+  for (int i=0;i<3 && rank < 0;i++)
+  {
+    if (getenv(ranks[i]) != NULL && getenv(sizes[i]) != NULL)
+    {
+      rank = atoi(getenv(ranks[i]));
+      size = atoi(getenv(sizes[i]));
+    }
+  }
+
+  if (rank < 0 || size <= 1 || ndev <= 0)
+  {
+    for (int dev=0;dev<ndev;dev++) {keep.push_back(dev);}
+  } else if (ndev >= size) {
+    for (int dev=rank%size;dev<ndev;dev+=size) {keep.push_back(dev);}
+  } else {
+    keep.push_back(rank%ndev);
+  }
+}
+
 //--------------------------------------------------------------------------
 // init_gpus
 //	initialize the vector of GPU datastructures
@@ -163,6 +780,17 @@ void GPU_HANDLER::init_gpus()
   //set platform to the one with the largest number of GPU
   platform = platforms[best]; 
 
+  //keep only the devices of the local rank, so the context is not made
+  //on the GPUs of the other ranks of the node
+  std::vector<int> keep;
+  local_devices(num_gpu,keep);
+  for (size_t dev=0;dev<keep.size();dev++) 
+  {
+    platform.devices[dev] = platforms[best].devices[keep[dev]];
+  }
+  platform.num_gpu = (cl_uint) keep.size();
+  num_gpu = platform.num_gpu;
+
   //reserve the GPU Data 
   gpus.reserve(num_gpu);
 
@@ -173,6 +801,7 @@ void GPU_HANDLER::init_gpus()
     libj::GPU gpu;
     gpu.set_device(platform.devices[dev],dev);
     gpu.platform_num = best; 
+    if (prof.enabled()) {gpu.prof = &prof;}
 
     //initialize GPU data
     gpu.set_data();
@@ -195,6 +824,42 @@ void GPU_HANDLER::print_gpu_info() const
   }
 }
 
+//--------------------------------------------------------------------------
+// split
+//	offsets[gpu] to offsets[gpu+1] is the part of n for each GPU, in 
+//	proportion to max_compute_units and in multiples of block (but for 
+//	the last part). GPUs may get nothing if n is small
+//--------------------------------------------------------------------------
+void GPU_HANDLER::split(const size_t n, const size_t block, 
+                        std::vector<size_t>& offsets) const
+{
+  const int ngpu = get_num_gpu();
+  size_t units = 0;
+  for (int gpu=0;gpu<ngpu;gpu++) {units += std::max(gpus[gpu].max_compute_units,(cl_uint) 1);}
+
+  const size_t nblock = (n + block - 1)/block;
+  offsets.assign(ngpu+1,0);
+  size_t sum = 0;
+  for (int gpu=0;gpu<ngpu;gpu++)
+  {
+    sum += std::max(gpus[gpu].max_compute_units,(cl_uint) 1);
+    offsets[gpu+1] = std::min(n,block*((nblock*sum + units/2)/units));
+  }
+  offsets[ngpu] = n;
+}
+
+//--------------------------------------------------------------------------
+// finish
+//	wait for the queue of gpu, or of all GPUs
+//--------------------------------------------------------------------------
+void GPU_HANDLER::finish(const int gpu)
+{
+  for (int dev=0;dev<get_num_gpu();dev++)
+  {
+    if (gpu == GPU_ALL || gpu == dev) {clFinish(gpus[dev].commands);}
+  }
+}
+
 //--------------------------------------------------------------------------
 // init_context 
 //	creates context for the best platform
@@ -211,6 +876,19 @@ void GPU_HANDLER::init_context()
 
 }
 
+//--------------------------------------------------------------------------
+// add_queues
+//	num more queues on every GPU
+//--------------------------------------------------------------------------
+void GPU_HANDLER::add_queues(const int num, const bool out_of_order)
+{
+  init();
+  for (int dev=0;dev<num_gpu;dev++)
+  {
+    gpus[dev].add_queues(platform,num,out_of_order);
+  }
+}
+
 //--------------------------------------------------------------------------
 // load_program
 //	loads a program from a string, creates the program with default
@@ -218,6 +896,7 @@ void GPU_HANDLER::init_context()
 //--------------------------------------------------------------------------
 void GPU_HANDLER::load_program(const char* source)
 {
+  init();
   //load the program
   program.load(platform,source);
 
@@ -227,11 +906,13 @@ void GPU_HANDLER::load_program(const char* source)
 
 //--------------------------------------------------------------------------
 // Add buffer on GPU
-//	add a buffer for a context 
+//	add a buffer for a context, name (which must live as long as the
+//	handler) tags its transfers when profiling
 //--------------------------------------------------------------------------
 int GPU_HANDLER::add_buffer(const cl_mem_flags flags, 
-                            const size_t bytes, void* pointer)
+                            const size_t bytes, void* pointer, const char* name)
 {
+  init();
   cl_int err;
   cl_mem buf = clCreateBuffer(platform.context,flags,bytes,pointer,&err);
   if (err != CL_SUCCESS)
@@ -240,8 +921,1506 @@ int GPU_HANDLER::add_buffer(const cl_mem_flags flags,
     exit(1);
   }
   buffers.push_back(buf);
+  buffer_names.push_back(name);
   return (int) buffers.size(); 
 }
 
+//--------------------------------------------------------------------------
+// enqueue_write
+//	write host memory into a buffer, on the queue of gpu. Note that 
+//	add_buffer returns the number of buffers, so buffer_id is that-1
+//--------------------------------------------------------------------------
+void GPU_HANDLER::enqueue_write(const int buffer_id, const cl_bool blocking, 
+                                const size_t offset, const size_t size, 
+                                const void* host_pointer, const int gpu)
+{
+  init();
+  cl_event event;
+  cl_int err = clEnqueueWriteBuffer(gpus[gpu].commands,buffers[buffer_id],blocking,
+                                    offset,size,host_pointer,0,NULL,gpus[gpu].prof_event(&event));
+  gpus[gpu].prof_record(err,event,gpus[gpu].commands,buffer_names[buffer_id],"h2d",(double) size);
+  if (err != CL_SUCCESS)
+  {
+    printf("ERROR libj::GPU_HANDLER::enqueue_write failed with code %d \n",err);
+    exit(1);
+  }
+}
+
+//--------------------------------------------------------------------------
+// enqueue_read
+//	read a buffer into host memory, on the queue of gpu
+//--------------------------------------------------------------------------
+void GPU_HANDLER::enqueue_read(const int buffer_id, const cl_bool blocking, 
+                               const size_t offset, const size_t size, 
+                               void* host_pointer, const int gpu)
+{
+  init();
+  cl_event event;
+  cl_int err = clEnqueueReadBuffer(gpus[gpu].commands,buffers[buffer_id],blocking,
+                                   offset,size,host_pointer,0,NULL,gpus[gpu].prof_event(&event));
+  gpus[gpu].prof_record(err,event,gpus[gpu].commands,buffer_names[buffer_id],"d2h",(double) size);
+  if (err != CL_SUCCESS)
+  {
+    printf("ERROR libj::GPU_HANDLER::enqueue_read failed with code %d \n",err);
+    exit(1);
+  }
+}
+
+//--------------------------------------------------------------------------
+// load_gemm
+//	builds the gemm program for a type (0 double, 1 float, 2 half), with the 
+//	tiles of the tuner. The candidates are the default of gemm_kernel.h 
+//	and the others that split evenly over a work group (as the checks of
+//	the kernel), and fit in the work group and local memory of every GPU.
+//	Each is built and timed on a GPU_TUNE_GEMM_N cube on GPU 0
+//--------------------------------------------------------------------------
+void GPU_HANDLER::load_gemm(const int type)
+{
+  init();
+  static const int tiles[][5] = {{GPU_GEMM_TSM,GPU_GEMM_TSN,GPU_GEMM_TSK,GPU_GEMM_WPTM,GPU_GEMM_WPTN},
+                                 {32,32,16,4,4},{64,64,16,8,8},{64,64,32,4,4},
+                                 {128,64,16,8,4},{64,128,16,4,8},{128,128,16,8,8}};
+  const size_t real = (type == 0) ? sizeof(double) : sizeof(float); //of the tiles
+  std::vector<std::vector<int> > cand;
+  for (size_t c=0;c<sizeof(tiles)/sizeof(tiles[0]);c++)
+  {
+    const int* t = tiles[c];
+    const int nthr = (t[0]/t[3])*(t[1]/t[4]);
+    bool ok = (t[2] % 4 == 0 && (t[2]*t[0]) % (4*nthr) == 0 && (t[2]*t[1]) % (4*nthr) == 0 &&
+               t[2]*t[0] >= 4*nthr && t[2]*t[1] >= 4*nthr);
+    for (int gpu=0;gpu<get_num_gpu() && ok;gpu++)
+    {
+      ok = ((size_t) nthr <= gpus[gpu].max_work_group_size &&
+            real*t[2]*(t[0] + t[1]) <= gpus[gpu].local_mem_size);
+    }
+    if (ok || c == 0) {cand.push_back(std::vector<int>(t,t+5));}
+  }
+
+  const std::vector<int> best = tuner.tune(
+    libj::GPU_TUNER::key((type == 0) ? "gemm.double" : (type == 1) ? "gemm.float" : "gemm.half",
+                         gpus[0]),cand,
+    [&](const std::vector<int>& t) -> double
+    {
+      const gpu_gemm_tile tile = {t[0],t[1],t[2],t[3],t[4]};
+      gemm_tile[type] = tile;
+      build_gemm(type);
+      return (type == 0) ? time_gemm<double>() : 
+             (type == 1) ? time_gemm<float>() : time_gemm<gpu_half>();
+    });
+  const gpu_gemm_tile tile = {best[0],best[1],best[2],best[3],best[4]};
+  const bool same = gemm_loaded[type] && tile.tsm == gemm_tile[type].tsm && 
+                    tile.tsn == gemm_tile[type].tsn && tile.tsk == gemm_tile[type].tsk &&
+                    tile.wptm == gemm_tile[type].wptm && tile.wptn == gemm_tile[type].wptn;
+  gemm_tile[type] = tile;
+  if (!same) {build_gemm(type);}
+}
+
+//--------------------------------------------------------------------------
+// build_gemm
+//	builds the gemm program of a type with gemm_tile, and releases the 
+//	one before
+//--------------------------------------------------------------------------
+void GPU_HANDLER::build_gemm(const int type)
+{
+  if (gemm_loaded[type])
+  {
+    clReleaseKernel(gemm_kernel[type][0].kernel);
+    clReleaseKernel(gemm_kernel[type][1].kernel);
+    clReleaseProgram(gemm_program[type].program);
+  }
+  const gpu_gemm_tile& t = gemm_tile[type];
+  char extra[128];
+  snprintf(extra,128,"-DTSM=%d -DTSN=%d -DTSK=%d -DWPTM=%d -DWPTN=%d",
+           t.tsm,t.tsn,t.tsk,t.wptm,t.wptn);
+  load_type(type,gpu_gemm_source,gemm_program[type],extra);
+  gemm_kernel[type][0].create(gemm_program[type],"gemm_nn");
+  gemm_kernel[type][1].create(gemm_program[type],"gemm_tn");
+  gemm_loaded[type] = true;
+}
+
+//--------------------------------------------------------------------------
+// time_gemm
+//	seconds of the gemm_nn kernel on the padded buffers of GPU 0
+//--------------------------------------------------------------------------
+template <typename T>
+double GPU_HANDLER::time_gemm()
+{
+  const int n = GPU_TUNE_GEMM_N;
+  size_t rows[3], cols[3], prow[3], pad[3];
+  gemm_setup<T>(false,n,n,n,rows,cols,prow,pad,0);
+  return libj::GPU_TUNER::time(gpus[0].commands,[&]
+  {
+    gemm_run<T>(false,pad,(typename gpu_real<T>::real) 1,(typename gpu_real<T>::real) 0,0);
+  });
+}
+
+//--------------------------------------------------------------------------
+// load_blas1
+//	builds the level-1 program for a type (0 double, 1 float)
+//--------------------------------------------------------------------------
+void GPU_HANDLER::load_blas1(const int type)
+{
+  init();
+  char extra[64];
+  snprintf(extra,64,"-DRLOCAL=%d",GPU_REDUCE_LOCAL);
+  load_type(type,gpu_blas1_source,blas1_program[type],extra);
+  for (int op=0;op<GPU_BLAS1_NUM;op++)
+  {
+    blas1_kernel[type][op].create(blas1_program[type],gpu_blas1_names[op]);
+  }
+  blas1_loaded[type] = true;
+  for (int gpu=0;gpu<get_num_gpu();gpu++)
+  {
+    if (blas1_local[gpu] != 0) continue;
+    if (type == 0) {tune_blas1<double>(gpu);}
+    else           {tune_blas1<float>(gpu);}
+  }
+}
+
+//--------------------------------------------------------------------------
+// tune_blas1
+//	the work group of the element wise kernels, timed with elemwise_add,
+//	and the groups of the reductions, timed with dot, on GPU_TUNE_BLAS1_N
+//	elements. The global sizes are multiples of GPU_REDUCE_LOCAL, so
+//	the work groups are its divisors
+//--------------------------------------------------------------------------
+template <typename T>
+void GPU_HANDLER::tune_blas1(const int gpu)
+{
+  const long n = GPU_TUNE_BLAS1_N;
+  const size_t bytes = sizeof(T)*n;
+  cl_mem& x = blas1_buffer[2*gpu];
+  cl_mem& y = blas1_buffer[2*gpu+1];
+  reserve(x,blas1_bytes[2*gpu],bytes,"tune");
+  reserve(y,blas1_bytes[2*gpu+1],bytes,"tune");
+  const T zero = (T) 0;
+  cl_int err = clEnqueueFillBuffer(gpus[gpu].commands,x,&zero,sizeof(T),0,bytes,0,NULL,NULL);
+  if (err == CL_SUCCESS)
+  {
+    err = clEnqueueFillBuffer(gpus[gpu].commands,y,&zero,sizeof(T),0,bytes,0,NULL,NULL);
+  }
+  if (err != CL_SUCCESS)
+  {
+    printf("ERROR libj::GPU_HANDLER::tune_blas1 could not zero the buffers, code %d \n",err);
+    exit(1);
+  }
+
+  std::vector<std::vector<int> > cand;
+  for (int local=GPU_REDUCE_LOCAL;local>=32;local/=2)
+  {
+    if ((size_t) local <= gpus[gpu].max_work_group_size) {cand.push_back(std::vector<int>(1,local));}
+  }
+  if (cand.empty()) {cand.push_back(std::vector<int>(1,GPU_REDUCE_LOCAL));}
+  libj::GPU_KERNEL& add = blas1_get<T>(GPU_ELEMWISE_ADD);
+  blas1_local[gpu] = (size_t) tuner.tune(libj::GPU_TUNER::key("blas1.local",gpus[gpu]),cand,
+    [&](const std::vector<int>& c) -> double
+    {
+      blas1_local[gpu] = (size_t) c[0];
+      return libj::GPU_TUNER::time(gpus[gpu].commands,[&]
+      {
+        const cl_long nn = (cl_long) n;
+        add.set_arg(0,sizeof(cl_long),&nn);
+        add.set_arg(1,sizeof(cl_mem),&x);
+        add.set_arg(2,sizeof(cl_mem),&y);
+        add.set_arg(3,sizeof(cl_mem),&y);
+        blas1_launch(add,n,gpu);
+      });
+    })[0];
+
+  cand.clear();
+  for (int groups=GPU_REDUCE_GROUPS;groups<=GPU_REDUCE_MAX_GROUPS;groups*=2)
+  {
+    cand.push_back(std::vector<int>(1,groups));
+  }
+  for (int groups=GPU_REDUCE_GROUPS/2;groups>=32;groups/=2) 
+  {
+    cand.push_back(std::vector<int>(1,groups));
+  }
+  reduce_groups[gpu] = (size_t) tuner.tune(libj::GPU_TUNER::key("blas1.groups",gpus[gpu]),cand,
+    [&](const std::vector<int>& c) -> double
+    {
+      reduce_groups[gpu] = (size_t) c[0];
+      return libj::GPU_TUNER::time(gpus[gpu].commands,[&]
+      {
+        blas1_reduce<T>(GPU_DOT_PART,n,x,y,gpu);
+      });
+    })[0];
+}
+
+//--------------------------------------------------------------------------
+// fuse
+//	Z = expr of the device buffers in (in(i) is in[i]) and scalars, on
+//	the queue of one GPU. The kernel is built on the first call with 
+//	its source and type
+//--------------------------------------------------------------------------
+template <typename T>
+void GPU_HANDLER::fuse(const long N, const gpu_expr& expr, const std::vector<cl_mem>& in,
+                       const std::vector<T>& scalars, cl_mem Z, const int gpu)
+{
+  init();
+  if ((int) in.size() < expr.num_in() || (int) scalars.size() < expr.num_scalar())
+  {
+    printf("ERROR libj::GPU_HANDLER::fuse the expression needs %d buffers and %d scalars\n",
+           expr.num_in(),expr.num_scalar());
+    exit(1);
+  }
+  if (N <= 0) return;
+
+  const int type = gpu_real<T>::id();
+  const std::string source = expr.source("fused");
+  const unsigned long long key = GPU_PROGRAM::hash(source + gpu_real<T>::options());
+  std::map<unsigned long long,size_t>::const_iterator it = fuse_index.find(key);
+  size_t id;
+  if (it != fuse_index.end()) {id = it->second;}
+  else
+  {
+    id = fuse_program.size();
+    fuse_program.push_back(libj::GPU_PROGRAM());
+    fuse_kernel.push_back(libj::GPU_KERNEL());
+    load_type(type,source.c_str(),fuse_program[id],"");
+    fuse_kernel[id].create(fuse_program[id],"fused");
+    fuse_index[key] = id;
+  }
+
+  libj::GPU_KERNEL& kernel = fuse_kernel[id];
+  int arg = 0;
+  kernel.set_arg(arg++,sizeof(long),&N);
+  for (int i=0;i<expr.num_in();i++) {kernel.set_arg(arg++,sizeof(cl_mem),&in[i]);}
+  for (int j=0;j<expr.num_scalar();j++) {kernel.set_arg(arg++,sizeof(T),&scalars[j]);}
+  kernel.set_arg(arg++,sizeof(cl_mem),&Z);
+  blas1_launch(kernel,N,gpu);
+}
+
+//--------------------------------------------------------------------------
+// load_permute
+//	builds the permute program for a type (0 double, 1 float)
+//--------------------------------------------------------------------------
+void GPU_HANDLER::load_permute(const int type)
+{
+  init();
+  std::vector<std::vector<int> > cand;
+  cand.push_back(std::vector<int>(1,GPU_PERMUTE_ROWS));
+  for (int rows=4;rows<=GPU_PERMUTE_TILE;rows*=2)
+  {
+    bool ok = (rows != GPU_PERMUTE_ROWS);
+    for (int gpu=0;gpu<get_num_gpu() && ok;gpu++) 
+    {
+      ok = ((size_t) (rows*GPU_PERMUTE_TILE) <= gpus[gpu].max_work_group_size);
+    }
+    if (ok) {cand.push_back(std::vector<int>(1,rows));}
+  }
+  const int best = tuner.tune(
+    libj::GPU_TUNER::key((type == 0) ? "permute.double" : "permute.float",gpus[0]),cand,
+    [&](const std::vector<int>& c) -> double
+    {
+      perm_rows[type] = c[0];
+      build_permute(type);
+      return (type == 0) ? time_permute<double>() : time_permute<float>();
+    })[0];
+  if (!perm_loaded[type] || best != perm_rows[type])
+  {
+    perm_rows[type] = best;
+    build_permute(type);
+  }
+}
+
+//--------------------------------------------------------------------------
+// build_permute
+//	builds the permute program of a type with perm_rows, and releases the
+//	one before
+//--------------------------------------------------------------------------
+void GPU_HANDLER::build_permute(const int type)
+{
+  if (perm_loaded[type])
+  {
+    clReleaseKernel(perm_kernel[type][0].kernel);
+    clReleaseKernel(perm_kernel[type][1].kernel);
+    clReleaseProgram(perm_program[type].program);
+  }
+  char extra[128];
+  snprintf(extra,128,"-DMAXD=%d -DPTILE=%d -DPROWS=%d",GPU_PERMUTE_MAX_DIM,
+           GPU_PERMUTE_TILE,perm_rows[type]);
+  load_type(type,gpu_permute_source,perm_program[type],extra);
+  perm_kernel[type][0].create(perm_program[type],"permute_tiled");
+  perm_kernel[type][1].create(perm_program[type],"permute_copy");
+  perm_loaded[type] = true;
+}
+
+//--------------------------------------------------------------------------
+// time_permute
+//	seconds of the transpose of a GPU_TUNE_PERMUTE_N square on GPU 0
+//--------------------------------------------------------------------------
+template <typename T>
+double GPU_HANDLER::time_permute()
+{
+  const size_t n = GPU_TUNE_PERMUTE_N;
+  cl_int err;
+  cl_mem A = clCreateBuffer(platform.context,CL_MEM_READ_WRITE,sizeof(T)*n*n,NULL,&err);
+  cl_mem B = (err == CL_SUCCESS) ? 
+             clCreateBuffer(platform.context,CL_MEM_READ_WRITE,sizeof(T)*n*n,NULL,&err) : NULL;
+  if (err != CL_SUCCESS)
+  {
+    printf("ERROR libj::GPU_HANDLER::time_permute could not make the buffers, code %d \n",err);
+    exit(1);
+  }
+  const T zero = (T) 0;
+  clEnqueueFillBuffer(gpus[0].commands,A,&zero,sizeof(T),0,sizeof(T)*n*n,0,NULL,NULL);
+  const size_t len[2] = {n,n};
+  const long   sA[2]  = {1,(long) n};
+  const long   sB[2]  = {(long) n,1};
+  const double t = libj::GPU_TUNER::time(gpus[0].commands,[&]
+  {
+    permute<T>(2,len,sA,A,sB,B,(T) 1,(T) 0,0);
+  });
+  clReleaseMemObject(A);
+  clReleaseMemObject(B);
+  return t;
+}
+
+//--------------------------------------------------------------------------
+// load_type
+//	builds a program for all GPUs with the options of a type, and the 
+//	extra options of the program
+//--------------------------------------------------------------------------
+void GPU_HANDLER::load_type(const int type, const char* source, 
+                            libj::GPU_PROGRAM& program, const char* extra)
+{
+  for (int gpu=0;gpu<get_num_gpu() && type == 0;gpu++)
+  {
+    if (!gpus[gpu].supports_double)
+    {
+      printf("ERROR libj::GPU_HANDLER::load_type GPU #%d does not support doubles\n",gpu);
+      exit(1);
+    }
+  }
+  char options[256];
+  snprintf(options,256,"%s %s",
+           (type == 0) ? gpu_real<double>::options() : 
+           (type == 1) ? gpu_real<float>::options() : gpu_real<gpu_half>::options(),extra);
+  program.load(platform,source);
+  program.build(platform,options);
+}
+
+//--------------------------------------------------------------------------
+// reserve
+//	grow a buffer to at least bytes
+//--------------------------------------------------------------------------
+void GPU_HANDLER::reserve(cl_mem& buffer, size_t& have, const size_t bytes, 
+                          const char* name)
+{
+  if (bytes <= have) return;
+  if (buffer != NULL) {clReleaseMemObject(buffer);}
+  cl_int err;
+  buffer = clCreateBuffer(platform.context,CL_MEM_READ_WRITE,bytes,NULL,&err);
+  if (err != CL_SUCCESS)
+  {
+    printf("ERROR libj::GPU_HANDLER::%s could not make a buffer of %lu bytes, code %d \n",
+           name,(unsigned long) bytes,err);
+    exit(1);
+  }
+  have = bytes;
+}
+
+//--------------------------------------------------------------------------
+// gemm_setup
+//	padded sizes, grows the buffers, and zeros the padded A and B, so the
+//	padding adds nothing. The pieces (A, B, C) are rows x cols, padded
+//	to prow x cols, A and B of gpu_real<T>::store, and C of real
+//--------------------------------------------------------------------------
+template <typename T>
+void GPU_HANDLER::gemm_setup(const bool transA, const int M, const int N, const int K,
+                             size_t* rows, size_t* cols, size_t* prow, size_t* pad,
+                             const int gpu)
+{
+  const int type = gpu_real<T>::id();
+  if (!gemm_loaded[type]) {load_gemm(type);}
+
+  const gpu_gemm_tile& t = gemm_tile[type];
+  pad[0] = ((M + t.tsm - 1)/t.tsm)*t.tsm;
+  pad[1] = ((N + t.tsn - 1)/t.tsn)*t.tsn;
+  pad[2] = ((K + t.tsk - 1)/t.tsk)*t.tsk;
+  const size_t Mp = pad[0], Np = pad[1], Kp = pad[2];
+  rows[0] = (size_t) (transA ? K : M); cols[0] = (size_t) (transA ? M : K);
+  rows[1] = (size_t) K;                cols[1] = (size_t) N;
+  rows[2] = (size_t) M;                cols[2] = (size_t) N;
+  prow[0] = transA ? Kp : Mp; prow[1] = Kp; prow[2] = Mp;
+
+  typedef typename gpu_real<T>::store store;
+  const size_t bytes[3] = {sizeof(store)*std::max(Mp*Kp,(size_t) 4),
+                           sizeof(store)*std::max(Kp*Np,(size_t) 4),
+                           sizeof(typename gpu_real<T>::real)*Mp*Np};
+  for (int buf=0;buf<3;buf++) 
+  {
+    reserve(gemm_buffer[3*gpu+buf],gemm_bytes[3*gpu+buf],bytes[buf],"gemm");
+  }
+
+  const store zero = (store) 0; //also the bits of a zero half
+  static const char* names[3] = {"gemm A","gemm B","gemm C"};
+  for (int buf=0;buf<2;buf++)
+  {
+    cl_event event;
+    cl_int err = clEnqueueFillBuffer(gpus[gpu].commands,gemm_buffer[3*gpu+buf],&zero,sizeof(store),
+                                     0,bytes[buf],0,NULL,gpus[gpu].prof_event(&event));
+    gpus[gpu].prof_record(err,event,gpus[gpu].commands,names[buf],"fill",(double) bytes[buf]);
+    if (err != CL_SUCCESS)
+    {
+      printf("ERROR libj::GPU_HANDLER::gemm could not zero the buffers, code %d \n",err);
+      exit(1);
+    }
+  }
+}
+
+//--------------------------------------------------------------------------
+// gemm_args
+//	sets the args of the kernel for padded buffers, and its work sizes
+//--------------------------------------------------------------------------
+template <typename T>
+libj::GPU_KERNEL& GPU_HANDLER::gemm_args(const bool transA, const size_t* pad, 
+                                         const typename gpu_real<T>::real ALPHA,
+                                         const cl_mem A, const cl_mem B,
+                                         const typename gpu_real<T>::real BETA, 
+                                         const cl_mem C, size_t* global, size_t* local)
+{
+  typedef typename gpu_real<T>::real real;
+  const int type = gpu_real<T>::id();
+  libj::GPU_KERNEL& kernel = gemm_kernel[type][transA ? 1 : 0];
+  const gpu_gemm_tile& t = gemm_tile[type];
+  const int Mi = (int) pad[0], Ni = (int) pad[1], Ki = (int) pad[2];
+  kernel.set_arg(0,sizeof(int),&Mi);
+  kernel.set_arg(1,sizeof(int),&Ni);
+  kernel.set_arg(2,sizeof(int),&Ki);
+  kernel.set_arg(3,sizeof(real),&ALPHA);
+  kernel.set_arg(4,sizeof(cl_mem),&A);
+  kernel.set_arg(5,sizeof(cl_mem),&B);
+  kernel.set_arg(6,sizeof(real),&BETA);
+  kernel.set_arg(7,sizeof(cl_mem),&C);
+
+  global[0] = pad[0]/t.wptm; 
+  global[1] = pad[1]/t.wptn;
+  local[0]  = (size_t) (t.tsm/t.wptm);
+  local[1]  = (size_t) (t.tsn/t.wptn);
+  return kernel;
+}
+
+//--------------------------------------------------------------------------
+// gemm_run
+//	runs the kernel on the padded buffers
+//--------------------------------------------------------------------------
+template <typename T>
+void GPU_HANDLER::gemm_run(const bool transA, const size_t* pad, 
+                           const typename gpu_real<T>::real ALPHA,
+                           const typename gpu_real<T>::real BETA, const int gpu)
+{
+  size_t global[2], local[2];
+  libj::GPU_KERNEL& kernel = gemm_args<T>(transA,pad,ALPHA,gemm_buffer[3*gpu],
+                                          gemm_buffer[3*gpu+1],BETA,gemm_buffer[3*gpu+2],
+                                          global,local);
+  gpus[gpu].queue_command(kernel,2,global,local);
+}
+
+//--------------------------------------------------------------------------
+// gemm
+//	C = ALPHA*A.B + BETA*C, or ALPHA*A^T.B + BETA*C if transA, for host 
+//	memory, on one GPU or split over the columns of B and C on GPU_ALL. 
+//	The kernel args are read when it is queued, so the kernel of a type 
+//	is shared by the GPUs
+//--------------------------------------------------------------------------
+template <typename T>
+void GPU_HANDLER::gemm(const bool transA, const int M, const int N, const int K,
+                       const T ALPHA, const T* A, const T* B, const T BETA, T* C,
+                       const int gpu)
+{
+  init();
+  if (M <= 0 || N <= 0) return;
+  if (gpu != GPU_ALL || get_num_gpu() == 1)
+  {
+    const int dev = (gpu == GPU_ALL) ? 0 : gpu;
+    gemm_enqueue<T>(transA,M,N,K,ALPHA,A,B,BETA,C,dev);
+    finish(dev);
+    return;
+  }
+
+  const int type = gpu_real<T>::id();
+  if (!gemm_loaded[type]) {load_gemm(type);}
+  std::vector<size_t> offsets;
+  split((size_t) N,gemm_tile[type].tsn,offsets);
+  for (int dev=0;dev<get_num_gpu();dev++)
+  {
+    const size_t n0 = offsets[dev];
+    const int    nn = (int) (offsets[dev+1] - n0);
+    if (nn == 0) continue;
+    gemm_enqueue<T>(transA,M,nn,K,ALPHA,A,B + n0*K,BETA,C + n0*M,dev);
+  }
+  finish(GPU_ALL);
+}
+
+//--------------------------------------------------------------------------
+// gemm_enqueue
+//	queues the host gemm on one GPU, without waiting. A, B, and C are 
+//	written into the padded buffers, and C is only written if BETA is not 
+//	zero
+//--------------------------------------------------------------------------
+template <typename T>
+void GPU_HANDLER::gemm_enqueue(const bool transA, const int M, const int N, 
+                               const int K, const typename gpu_real<T>::real ALPHA, 
+                               const typename gpu_real<T>::store* A, 
+                               const typename gpu_real<T>::store* B, 
+                               const typename gpu_real<T>::real BETA, 
+                               typename gpu_real<T>::real* C, const int gpu)
+{
+  typedef typename gpu_real<T>::real real;
+  size_t rows[3], cols[3], prow[3], pad[3];
+  gemm_setup<T>(transA,M,N,K,rows,cols,prow,pad,gpu);
+
+  const void* host[3] = {A,B,C};
+  const size_t elem[3] = {sizeof(*A),sizeof(*B),sizeof(real)};
+  const int nbuf = (BETA == (real) 0) ? 2 : 3;
+  const size_t origin[3] = {0,0,0};
+  static const char* names[3] = {"gemm A","gemm B","gemm C"};
+  for (int buf=0;buf<nbuf;buf++)
+  {
+    if (rows[buf] == 0) continue;
+    const size_t region[3] = {elem[buf]*rows[buf],cols[buf],1};
+    cl_event event;
+    cl_int err = clEnqueueWriteBufferRect(gpus[gpu].commands,gemm_buffer[3*gpu+buf],
+                                          CL_FALSE,origin,origin,region,
+                                          elem[buf]*prow[buf],0,elem[buf]*rows[buf],0,
+                                          host[buf],0,NULL,gpus[gpu].prof_event(&event));
+    gpus[gpu].prof_record(err,event,gpus[gpu].commands,names[buf],"h2d",
+                          (double) (region[0]*region[1]));
+    if (err != CL_SUCCESS)
+    {
+      printf("ERROR libj::GPU_HANDLER::gemm could not write the matrices, code %d \n",err);
+      exit(1);
+    }
+  }
+
+  gemm_run<T>(transA,pad,ALPHA,BETA,gpu);
+
+  //read the M x N part of C back
+  const size_t region[3] = {sizeof(real)*rows[2],cols[2],1};
+  cl_event event;
+  cl_int err = clEnqueueReadBufferRect(gpus[gpu].commands,gemm_buffer[3*gpu+2],CL_FALSE,
+                                       origin,origin,region,sizeof(real)*prow[2],0,
+                                       sizeof(real)*rows[2],0,C,0,NULL,gpus[gpu].prof_event(&event));
+  gpus[gpu].prof_record(err,event,gpus[gpu].commands,names[2],"d2h",(double) (region[0]*region[1]));
+  if (err != CL_SUCCESS)
+  {
+    printf("ERROR libj::GPU_HANDLER::gemm could not read C, code %d \n",err);
+    exit(1);
+  }
+}
+
+//--------------------------------------------------------------------------
+// gemm
+//	as above, for dense column major device buffers (e.g., of a 
+//	device_tensor). The padding is done by copies on the device, so 
+//	nothing goes over the bus
+//--------------------------------------------------------------------------
+template <typename T>
+void GPU_HANDLER::gemm(const bool transA, const int M, const int N, const int K,
+                       const T ALPHA, const cl_mem A, const cl_mem B, const T BETA, 
+                       cl_mem C, const int gpu)
+{
+  init();
+  if (M <= 0 || N <= 0) return;
+  size_t rows[3], cols[3], prow[3], pad[3];
+  gemm_setup<T>(transA,M,N,K,rows,cols,prow,pad,gpu);
+
+  const cl_mem dev[3] = {A,B,C};
+  const int nbuf = (BETA == (T) 0) ? 2 : 3;
+  const size_t origin[3] = {0,0,0};
+  static const char* names[3] = {"gemm A","gemm B","gemm C"};
+  cl_int err = CL_SUCCESS;
+  cl_event event;
+  for (int buf=0;buf<nbuf && err == CL_SUCCESS;buf++)
+  {
+    if (rows[buf] == 0) continue;
+    const size_t region[3] = {sizeof(T)*rows[buf],cols[buf],1};
+    err = clEnqueueCopyBufferRect(gpus[gpu].commands,dev[buf],gemm_buffer[3*gpu+buf],origin,
+                                  origin,region,sizeof(T)*rows[buf],0,sizeof(T)*prow[buf],
+                                  0,0,NULL,gpus[gpu].prof_event(&event));
+    gpus[gpu].prof_record(err,event,gpus[gpu].commands,names[buf],"d2d",
+                          (double) (region[0]*region[1]));
+  }
+
+  if (err == CL_SUCCESS) 
+  {
+    gemm_run<T>(transA,pad,ALPHA,BETA,gpu);
+    const size_t region[3] = {sizeof(T)*rows[2],cols[2],1};
+    err = clEnqueueCopyBufferRect(gpus[gpu].commands,gemm_buffer[3*gpu+2],C,origin,origin,
+                                  region,sizeof(T)*prow[2],0,sizeof(T)*rows[2],0,
+                                  0,NULL,gpus[gpu].prof_event(&event));
+    gpus[gpu].prof_record(err,event,gpus[gpu].commands,names[2],"d2d",
+                          (double) (region[0]*region[1]));
+  }
+  if (err != CL_SUCCESS)
+  {
+    printf("ERROR libj::GPU_HANDLER::gemm could not copy the device matrices, code %d \n",err);
+    exit(1);
+  }
+}
+
+//--------------------------------------------------------------------------
+// gemm_ooc
+//	C = ALPHA*op(A).B + BETA*C of host memory that need not fit on the 
+//	GPU. The tiles of C go down the columns, each over the chunks of K,
+//	the first chunk with BETA (C is written first if it is not zero) and
+//	the rest with 1. The staging and device buffers are made for the call.
+//	A slot is only reused when the command that used it last is done,
+//	the host waits for the write of a staging slot before packing into 
+//	it again, and for the read of a C tile before unpacking it
+//--------------------------------------------------------------------------
+template <typename T>
+void GPU_HANDLER::gemm_ooc(const bool transA, const int M, const int N, const int K,
+                           const T ALPHA, const T* A, const T* B, const T BETA, T* C,
+                           const size_t budget, const int gpu)
+{
+  init();
+  if (M <= 0 || N <= 0) return;
+  if (K <= 0)
+  {
+    for (long i=0;i<(long) M*N;i++) {C[i] = (BETA == (T) 0) ? (T) 0 : BETA*C[i];}
+    return;
+  }
+  const int type = gpu_real<T>::id();
+  if (!gemm_loaded[type]) {load_gemm(type);}
+  if (gpus[gpu].num_queues() < 3) {add_queues(3 - gpus[gpu].num_queues());}
+  const gpu_gemm_tile& t = gemm_tile[type];
+
+  //b x b tiles, b a multiple of all the tiles of the kernel, so that three 
+  //panels of A and B and two tiles of C are in the working set
+  size_t step = 1;
+  const size_t tiles[3] = {(size_t) t.tsm,(size_t) t.tsn,(size_t) t.tsk};
+  for (int d=0;d<3;d++)
+  {
+    size_t a = step, b = tiles[d];
+    while (b != 0) {const size_t r = a % b; a = b; b = r;}
+    step = step/a*tiles[d];
+  }
+  const double work = (budget > 0) ? (double) budget : 
+                      GPU_OOC_FRACTION*(double) gpus[gpu].global_mem_size;
+  size_t b = (size_t) std::sqrt(work/(8.0*sizeof(T)));
+  b = std::min(b,(size_t) std::sqrt((double) gpus[gpu].max_alloc_size/sizeof(T)));
+  b = std::max(step,b/step*step);
+  const size_t mt = std::min(b,(M + t.tsm - 1)/t.tsm*(size_t) t.tsm);
+  const size_t nt = std::min(b,(N + t.tsn - 1)/t.tsn*(size_t) t.tsn);
+  const size_t kt = std::min(b,(K + t.tsk - 1)/t.tsk*(size_t) t.tsk);
+  const size_t nmt = (M + mt - 1)/mt, nnt = (N + nt - 1)/nt, nkt = (K + kt - 1)/kt;
+
+  //pinned staging, mapped for the host, and the device slots
+  const size_t bytes[3] = {sizeof(T)*mt*kt,sizeof(T)*kt*nt,sizeof(T)*mt*nt};
+  const int    count[3] = {3,3,2};
+  cl_mem stage[3][3], dev[3][3];
+  T*     host[3][3];
+  for (int buf=0;buf<3;buf++)
+  {
+    for (int slot=0;slot<count[buf];slot++)
+    {
+      cl_int err;
+      stage[buf][slot] = clCreateBuffer(platform.context,CL_MEM_ALLOC_HOST_PTR,bytes[buf],
+                                        NULL,&err);
+      if (err == CL_SUCCESS)
+      {
+        dev[buf][slot] = clCreateBuffer(platform.context,CL_MEM_READ_WRITE,bytes[buf],
+                                        NULL,&err);
+      }
+      if (err == CL_SUCCESS)
+      {
+        host[buf][slot] = (T*) clEnqueueMapBuffer(gpus[gpu].commands,stage[buf][slot],
+                                                  CL_TRUE,CL_MAP_READ | CL_MAP_WRITE,0,
+                                                  bytes[buf],0,NULL,NULL,&err);
+      }
+      if (err != CL_SUCCESS)
+      {
+        printf("ERROR libj::GPU_HANDLER::gemm_ooc could not make a buffer of %lu bytes, code %d \n",
+               (unsigned long) bytes[buf],err);
+        exit(1);
+      }
+    }
+  }
+
+  //the read of each C slot, and where its tile goes
+  struct tile_out
+  {
+    int    node;
+    size_t i0, j0, mm, nn, mp;
+  };
+  tile_out out[2] = {{-1,0,0,0,0,0},{-1,0,0,0,0,0}};
+  libj::GPU_GRAPH graph(gpus[gpu]);
+  auto unpack = [&](const int cs)
+  {
+    if (out[cs].node < 0) return;
+    graph.wait(out[cs].node);
+    const tile_out& o = out[cs];
+    for (size_t j=0;j<o.nn;j++)
+    {
+      memcpy(C + o.i0 + (o.j0 + j)*M,host[2][cs] + j*o.mp,sizeof(T)*o.mm);
+    }
+    out[cs].node = -1;
+  };
+
+  int  kern[3] = {-1,-1,-1}, up[3] = {-1,-1,-1};
+  long s = 0, tile = 0;
+  for (size_t tj=0;tj<nnt;tj++)
+  {
+    for (size_t ti=0;ti<nmt;ti++,tile++)
+    {
+      const int    cs = (int) (tile % 2);
+      const size_t i0 = ti*mt, mm = std::min(mt,M - i0), mp = (mm + t.tsm - 1)/t.tsm*t.tsm;
+      const size_t j0 = tj*nt, nn = std::min(nt,N - j0), np = (nn + t.tsn - 1)/t.tsn*t.tsn;
+      unpack(cs);
+
+      int cup = -1;
+      if (BETA != (T) 0)
+      {
+        T* h = host[2][cs];
+        memset(h,0,sizeof(T)*mp*np);
+        for (size_t j=0;j<nn;j++) {memcpy(h + j*mp,C + i0 + (j0 + j)*M,sizeof(T)*mm);}
+        cup = graph.write(1,dev[2][cs],0,sizeof(T)*mp*np,h);
+      }
+
+      int last = -1;
+      for (size_t tk=0;tk<nkt;tk++,s++)
+      {
+        const int    sl = (int) (s % 3);
+        const size_t k0 = tk*kt, kk = std::min(kt,K - k0), kp = (kk + t.tsk - 1)/t.tsk*t.tsk;
+        if (up[sl] >= 0) {graph.wait(up[sl]);}
+
+        //op(A) panel, mp x kp (or kp x mp if transA), and B panel, kp x np
+        T* ha = host[0][sl];
+        T* hb = host[1][sl];
+        memset(ha,0,sizeof(T)*mp*kp);
+        memset(hb,0,sizeof(T)*kp*np);
+        if (transA)
+        {
+          for (size_t i=0;i<mm;i++) {memcpy(ha + i*kp,A + k0 + (i0 + i)*K,sizeof(T)*kk);}
+        }
+        else
+        {
+          for (size_t k=0;k<kk;k++) {memcpy(ha + k*mp,A + i0 + (k0 + k)*M,sizeof(T)*mm);}
+        }
+        for (size_t j=0;j<nn;j++) {memcpy(hb + j*kp,B + k0 + (j0 + j)*K,sizeof(T)*kk);}
+
+        const std::vector<int> prev(1,kern[sl]);
+        graph.write(1,dev[0][sl],0,sizeof(T)*mp*kp,ha,prev);
+        up[sl] = graph.write(1,dev[1][sl],0,sizeof(T)*kp*np,hb,prev);
+
+        const size_t pad[3] = {mp,np,kp};
+        const T beta = (tk == 0) ? BETA : (T) 1;
+        size_t global[2], local[2];
+        libj::GPU_KERNEL& kernel = gemm_args<T>(transA,pad,ALPHA,dev[0][sl],dev[1][sl],
+                                                beta,dev[2][cs],global,local);
+        std::vector<int> deps(1,up[sl]);
+        if (tk == 0) {deps.push_back(cup);}
+        kern[sl] = graph.kernel(0,kernel,2,global,local,deps);
+        last = kern[sl];
+        graph.flush();
+      }
+
+      out[cs].node = graph.read(2,dev[2][cs],0,sizeof(T)*mp*np,host[2][cs],
+                                std::vector<int>(1,last));
+      out[cs].i0 = i0; out[cs].j0 = j0; out[cs].mm = mm; out[cs].nn = nn; out[cs].mp = mp;
+      graph.flush();
+    }
+  }
+  unpack((int) (tile % 2));
+  unpack((int) ((tile + 1) % 2));
+  graph.clear();
+
+  for (int buf=0;buf<3;buf++)
+  {
+    for (int slot=0;slot<count[buf];slot++)
+    {
+      clEnqueueUnmapMemObject(gpus[gpu].commands,stage[buf][slot],host[buf][slot],0,NULL,NULL);
+      clReleaseMemObject(dev[buf][slot]);
+    }
+  }
+  finish(gpu);
+  for (int buf=0;buf<3;buf++)
+  {
+    for (int slot=0;slot<count[buf];slot++) {clReleaseMemObject(stage[buf][slot]);}
+  }
+}
+
+//--------------------------------------------------------------------------
+// gemm_hybrid
+//	C = ALPHA*op(A).B + BETA*C of host memory, on every GPU (a thread 
+//	each) and on the caller with host(NN,Bj,Cj), which must do the same
+//	for the NN columns of B and C at Bj and Cj (with A, ALPHA, and BETA).
+//	lock guards the tiles left, and the kernel args of the GPU threads
+//--------------------------------------------------------------------------
+template <typename T>
+void GPU_HANDLER::gemm_hybrid(const bool transA, const int M, const int N, 
+                              const int K, const T ALPHA, const T* A, 
+                              const T* B, const T BETA, T* C,
+                              const std::function<void(const int NN, const T* Bj, T* Cj)>& host)
+{
+  init();
+  if (M <= 0 || N <= 0) return;
+  const int type = gpu_real<T>::id();
+  if (!gemm_loaded[type]) {load_gemm(type);}
+  const int  nwork = 1 + get_num_gpu();
+  const long tsn   = gemm_tile[type].tsn;
+  const long tile  = std::max(tsn,(GPU_HYBRID_TILE/tsn)*tsn);
+  const long ntile = (N + tile - 1)/tile;
+
+  //the rates of the last call, or equal until all are measured
+  std::vector<double> rate = hybrid_rate[type];
+  bool measured = true;
+  for (int w=0;w<nwork;w++) {measured = measured && rate[w] > 0;}
+  if (!measured) {rate.assign(nwork,1.0);}
+  const int fastest = (int) (std::max_element(rate.begin(),rate.end()) - rate.begin());
+  double total = 0;
+  for (int w=0;w<nwork;w++) {total += rate[w];}
+
+  std::mutex lock;
+  long next = 0;
+  std::vector<double> flops(nwork,0.0), busy(nwork,0.0);
+  auto work = [&](const int w)
+  {
+    for (;;)
+    {
+      long t0, nt;
+      {
+        std::lock_guard<std::mutex> hold(lock);
+        const long left = ntile - next;
+        if (left <= 0 || (w != fastest && rate[w]*(left + 1) < total)) break;
+        nt = std::max(1L,(long) (left*rate[w]/(2.0*total)));
+        t0 = next;
+        next += nt;
+      }
+      const int n0 = (int) (t0*tile);
+      const int nn = (int) (std::min((long) N,(t0 + nt)*tile) - n0);
+      const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      if (w == 0) {host(nn,B + (size_t) n0*K,C + (size_t) n0*M);}
+      else
+      {
+        {
+          std::lock_guard<std::mutex> hold(lock);
+          gemm_enqueue<T>(transA,M,nn,K,ALPHA,A,B + (size_t) n0*K,BETA,C + (size_t) n0*M,w-1);
+        }
+        finish(w-1);
+      }
+      busy[w] += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      flops[w] += 2.0*M*nn*std::max(K,1);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int w=1;w<nwork;w++) {threads.push_back(std::thread(work,w));}
+  work(0);
+  for (size_t t=0;t<threads.size();t++) {threads[t].join();}
+
+  for (int w=0;w<nwork;w++)
+  {
+    if (busy[w] > 0) {hybrid_rate[type][w] = flops[w]/busy[w];}
+  }
+}
+
+//--------------------------------------------------------------------------
+// gemm_mixed
+//	C = ALPHA*op(A).B + BETA*C of double host matrices, with A and B 
+//	stored as S (float or gpu_half) on one GPU, and with refine the
+//	products of the residuals, added on the host in double. The refine
+//	product is queued first, as it has the larger K, so the padded 
+//	buffers are made once
+//--------------------------------------------------------------------------
+template <typename S>
+void GPU_HANDLER::gemm_mixed(const bool transA, const int M, const int N, 
+                             const int K, const double ALPHA, const double* A, 
+                             const double* B, const double BETA, double* C, 
+                             const bool refine, const int gpu)
+{
+  init();
+  if (M <= 0 || N <= 0) return;
+  typedef typename gpu_real<S>::store store;
+  typedef typename gpu_real<S>::real  real;
+  const int    dev = (gpu == GPU_ALL) ? 0 : gpu;
+  const double s   = gpu_real<S>::scale();
+  const size_t MN  = (size_t) M*N;
+  const size_t MK  = (size_t) M*K;
+  const size_t KN  = (size_t) K*N;
+
+  std::vector<store> Al(MK), Bl(KN);
+  for (size_t i=0;i<MK;i++) {Al[i] = gpu_real<S>::to(A[i]);}
+  for (size_t i=0;i<KN;i++) {Bl[i] = gpu_real<S>::to(B[i]);}
+
+  //[s*Ar Ah] is op(A) of M x 2K, and [Bh ; s*Br] is 2K x N
+  std::vector<store> A2, B2;
+  std::vector<real>  R;
+  if (refine && K > 0)
+  {
+    A2.resize(2*MK);
+    B2.resize(2*KN);
+    R.resize(MN);
+    for (size_t i=0;i<MK;i++)
+    {
+      //op(A)(m,k) is at k + m*K if transA, m + k*M if not
+      const size_t m = transA ? i / K : i % M;
+      const size_t k = transA ? i % K : i / M;
+      const store  r = gpu_real<S>::to(s*(A[i] - gpu_real<S>::from(Al[i])));
+      A2[transA ? k + m*2*K : m + k*M]          = r;
+      A2[transA ? K + k + m*2*K : MK + m + k*M] = Al[i];
+    }
+    for (size_t n=0;n<(size_t) N;n++)
+    {
+      for (size_t k=0;k<(size_t) K;k++)
+      {
+        const size_t i = k + n*K;
+        B2[k + n*2*K]     = Bl[i];
+        B2[K + k + n*2*K] = gpu_real<S>::to(s*(B[i] - gpu_real<S>::from(Bl[i])));
+      }
+    }
+    gemm_enqueue<S>(transA,M,N,2*K,(real) 1,A2.data(),B2.data(),(real) 0,R.data(),dev);
+  }
+
+  std::vector<real> P(MN);
+  gemm_enqueue<S>(transA,M,N,K,(real) 1,Al.data(),Bl.data(),(real) 0,P.data(),dev);
+  finish(dev);
+
+  for (size_t i=0;i<MN;i++)
+  {
+    const double ab = (double) P[i] + (R.empty() ? 0.0 : (double) R[i]/s);
+    C[i] = (BETA == 0.0) ? ALPHA*ab : ALPHA*ab + BETA*C[i];
+  }
+}
+
+//--------------------------------------------------------------------------
+// axpy
+//	Y = ALPHA*X + Y for host memory, on one GPU or split over GPU_ALL
+//--------------------------------------------------------------------------
+template <typename T>
+void GPU_HANDLER::axpy(const long N, const T ALPHA, const T* X, T* Y, const int gpu)
+{
+  init();
+  blas1<T>(GPU_AXPY,N,ALPHA,X,Y,gpu);
+}
+
+//--------------------------------------------------------------------------
+// scal
+//	X = ALPHA*X for host memory, on one GPU or split over GPU_ALL
+//--------------------------------------------------------------------------
+template <typename T>
+void GPU_HANDLER::scal(const long N, const T ALPHA, T* X, const int gpu)
+{
+  init();
+  blas1<T>(GPU_SCAL_MUL,N,ALPHA,NULL,X,gpu);
+}
+
+//--------------------------------------------------------------------------
+// blas1
+//	op is GPU_AXPY or GPU_SCAL_MUL (which has no X). The parts of X and Y go to
+//	the buffers of each GPU, and are queued on all before any is read 
+//	back. These are bound by the bus, so they only pay when the data is 
+//	used again on the GPU, or with many GPUs
+//--------------------------------------------------------------------------
+template <typename T>
+void GPU_HANDLER::blas1(const int op, const long N, const T ALPHA, const T* X, 
+                        T* Y, const int gpu)
+{
+  if (N <= 0) return;
+  libj::GPU_KERNEL& kernel = blas1_get<T>(op);
+
+  const size_t block = GPU_REDUCE_LOCAL;
+  std::vector<size_t> offsets;
+  if (gpu == GPU_ALL) {split((size_t) N,block,offsets);}
+  else 
+  {
+    offsets.assign(get_num_gpu()+1,0);
+    for (int dev=gpu+1;dev<=get_num_gpu();dev++) {offsets[dev] = (size_t) N;}
+  }
+
+  for (int dev=0;dev<get_num_gpu();dev++)
+  {
+    const size_t n0 = offsets[dev];
+    const size_t nn = offsets[dev+1] - n0;
+    if (nn == 0) continue;
+    const size_t bytes = sizeof(T)*nn;
+    cl_command_queue queue = gpus[dev].commands;
+    cl_mem& x = blas1_buffer[2*dev];
+    cl_mem& y = blas1_buffer[2*dev+1];
+    const char* yname = (op == GPU_AXPY) ? "axpy Y" : "scal X";
+    cl_int err = CL_SUCCESS;
+    cl_event event;
+    if (op == GPU_AXPY)
+    {
+      reserve(x,blas1_bytes[2*dev],bytes,"axpy");
+      err = clEnqueueWriteBuffer(queue,x,CL_FALSE,0,bytes,X + n0,0,NULL,gpus[dev].prof_event(&event));
+      gpus[dev].prof_record(err,event,queue,"axpy X","h2d",(double) bytes);
+    }
+    reserve(y,blas1_bytes[2*dev+1],bytes,(op == GPU_AXPY) ? "axpy" : "scal");
+    if (err == CL_SUCCESS) 
+    {
+      err = clEnqueueWriteBuffer(queue,y,CL_FALSE,0,bytes,Y + n0,0,NULL,gpus[dev].prof_event(&event));
+      gpus[dev].prof_record(err,event,queue,yname,"h2d",(double) bytes);
+    }
+    if (err != CL_SUCCESS)
+    {
+      printf("ERROR libj::GPU_HANDLER::blas1 could not write the vectors, code %d \n",err);
+      exit(1);
+    }
+
+    const cl_long n = (cl_long) nn;
+    int arg = 0;
+    kernel.set_arg(arg++,sizeof(cl_long),&n);
+    kernel.set_arg(arg++,sizeof(T),&ALPHA);
+    if (op == GPU_AXPY) {kernel.set_arg(arg++,sizeof(cl_mem),&x);}
+    kernel.set_arg(arg++,sizeof(cl_mem),&y);
+    blas1_launch(kernel,(long) nn,dev);
+
+    err = clEnqueueReadBuffer(queue,y,CL_FALSE,0,bytes,Y + n0,0,NULL,gpus[dev].prof_event(&event));
+    gpus[dev].prof_record(err,event,queue,yname,"d2h",(double) bytes);
+    if (err != CL_SUCCESS)
+    {
+      printf("ERROR libj::GPU_HANDLER::blas1 could not read the vector, code %d \n",err);
+      exit(1);
+    }
+  }
+  finish(gpu);
+}
+
+//--------------------------------------------------------------------------
+// blas1_get
+//	kernel op of type T, the program is built on first use
+//--------------------------------------------------------------------------
+template <typename T>
+libj::GPU_KERNEL& GPU_HANDLER::blas1_get(const int op)
+{
+  const int type = gpu_real<T>::id();
+  if (!blas1_loaded[type]) {load_blas1(type);}
+  return blas1_kernel[type][op];
+}
+
+//--------------------------------------------------------------------------
+// blas1_launch
+//	one work item per element, with the args already set, in groups of
+//	the tuned size
+//--------------------------------------------------------------------------
+void GPU_HANDLER::blas1_launch(libj::GPU_KERNEL& kernel, const long N, const int gpu)
+{
+  const size_t block = GPU_REDUCE_LOCAL;
+  const size_t global = (((size_t) N + block - 1)/block)*block;
+  const size_t local = blas1_local[gpu];
+  gpus[gpu].queue_command(kernel,1,&global,(local != 0) ? &local : NULL);
+}
+
+//--------------------------------------------------------------------------
+// device buffer level-1 functions
+//--------------------------------------------------------------------------
+template <typename T>
+void GPU_HANDLER::axpy(const long N, const T A, const cl_mem X, cl_mem Y, const int gpu)
+{
+  init();
+  if (N <= 0) return;
+  libj::GPU_KERNEL& kernel = blas1_get<T>(GPU_AXPY);
+  const cl_long n = (cl_long) N;
+  kernel.set_arg(0,sizeof(cl_long),&n);
+  kernel.set_arg(1,sizeof(T),&A);
+  kernel.set_arg(2,sizeof(cl_mem),&X);
+  kernel.set_arg(3,sizeof(cl_mem),&Y);
+  blas1_launch(kernel,N,gpu);
+}
+
+template <typename T>
+void GPU_HANDLER::axpby(const long N, const T A, const cl_mem X, const T B, cl_mem Y,
+                        const int gpu)
+{
+  init();
+  if (N <= 0) return;
+  libj::GPU_KERNEL& kernel = blas1_get<T>(GPU_AXPBY);
+  const cl_long n = (cl_long) N;
+  kernel.set_arg(0,sizeof(cl_long),&n);
+  kernel.set_arg(1,sizeof(T),&A);
+  kernel.set_arg(2,sizeof(cl_mem),&X);
+  kernel.set_arg(3,sizeof(T),&B);
+  kernel.set_arg(4,sizeof(cl_mem),&Y);
+  blas1_launch(kernel,N,gpu);
+}
+
+template <typename T>
+void GPU_HANDLER::scal_mul(const long N, const T A, cl_mem X, const int gpu)
+{
+  init();
+  if (N <= 0) return;
+  libj::GPU_KERNEL& kernel = blas1_get<T>(GPU_SCAL_MUL);
+  const cl_long n = (cl_long) N;
+  kernel.set_arg(0,sizeof(cl_long),&n);
+  kernel.set_arg(1,sizeof(T),&A);
+  kernel.set_arg(2,sizeof(cl_mem),&X);
+  blas1_launch(kernel,N,gpu);
+}
+
+template <typename T>
+void GPU_HANDLER::scal_add(const long N, const T A, cl_mem X, const int gpu)
+{
+  init();
+  if (N <= 0) return;
+  libj::GPU_KERNEL& kernel = blas1_get<T>(GPU_SCAL_ADD);
+  const cl_long n = (cl_long) N;
+  kernel.set_arg(0,sizeof(cl_long),&n);
+  kernel.set_arg(1,sizeof(T),&A);
+  kernel.set_arg(2,sizeof(cl_mem),&X);
+  blas1_launch(kernel,N,gpu);
+}
+
+template <typename T>
+void GPU_HANDLER::scal_set(const long N, const T A, cl_mem X, const int gpu)
+{
+  init();
+  if (N <= 0) return;
+  cl_event event;
+  cl_int err = clEnqueueFillBuffer(gpus[gpu].commands,X,&A,sizeof(T),0,sizeof(T)*N,
+                                   0,NULL,gpus[gpu].prof_event(&event));
+  gpus[gpu].prof_record(err,event,gpus[gpu].commands,"scal_set X","fill",(double) (sizeof(T)*N));
+  if (err != CL_SUCCESS)
+  {
+    printf("ERROR libj::GPU_HANDLER::scal_set failed with code %d \n",err);
+    exit(1);
+  }
+}
+
+template <typename T>
+void GPU_HANDLER::copy(const long N, const cl_mem X, cl_mem Y, const int gpu)
+{
+  init();
+  if (N <= 0) return;
+  cl_event event;
+  cl_int err = clEnqueueCopyBuffer(gpus[gpu].commands,X,Y,0,0,sizeof(T)*N,0,NULL,
+                                   gpus[gpu].prof_event(&event));
+  gpus[gpu].prof_record(err,event,gpus[gpu].commands,"copy Y","d2d",(double) (sizeof(T)*N));
+  if (err != CL_SUCCESS)
+  {
+    printf("ERROR libj::GPU_HANDLER::copy failed with code %d \n",err);
+    exit(1);
+  }
+}
+
+template <typename T>
+void GPU_HANDLER::elemwise_add(const long N, const cl_mem X, const cl_mem Y, cl_mem Z,
+                               const int gpu)
+{
+  init();
+  if (N <= 0) return;
+  libj::GPU_KERNEL& kernel = blas1_get<T>(GPU_ELEMWISE_ADD);
+  const cl_long n = (cl_long) N;
+  kernel.set_arg(0,sizeof(cl_long),&n);
+  kernel.set_arg(1,sizeof(cl_mem),&X);
+  kernel.set_arg(2,sizeof(cl_mem),&Y);
+  kernel.set_arg(3,sizeof(cl_mem),&Z);
+  blas1_launch(kernel,N,gpu);
+}
+
+template <typename T>
+void GPU_HANDLER::elemwise_mul(const long N, const cl_mem X, const cl_mem Y, cl_mem Z,
+                               const int gpu)
+{
+  init();
+  if (N <= 0) return;
+  libj::GPU_KERNEL& kernel = blas1_get<T>(GPU_ELEMWISE_MUL);
+  const cl_long n = (cl_long) N;
+  kernel.set_arg(0,sizeof(cl_long),&n);
+  kernel.set_arg(1,sizeof(cl_mem),&X);
+  kernel.set_arg(2,sizeof(cl_mem),&Y);
+  kernel.set_arg(3,sizeof(cl_mem),&Z);
+  blas1_launch(kernel,N,gpu);
+}
+
+template <typename T>
+T GPU_HANDLER::dot(const long N, const cl_mem X, const cl_mem Y, const int gpu)
+{
+  init();
+  return blas1_reduce<T>(GPU_DOT_PART,N,X,Y,gpu);
+}
+
+template <typename T>
+T GPU_HANDLER::reduction_add(const long N, const cl_mem X, const int gpu)
+{
+  init();
+  return blas1_reduce<T>(GPU_SUM_PART,N,X,NULL,gpu);
+}
+
+//--------------------------------------------------------------------------
+// blas1_reduce
+//	the two stage reduction of dot_part or sum_part (which has no Y). The
+//	partial sums of at most reduce_groups[gpu] groups go into the part 
+//	buffer of the GPU, reduce_part sums them into part[0], and only that
+//	sum is read back
+//--------------------------------------------------------------------------
+template <typename T>
+T GPU_HANDLER::blas1_reduce(const int op, const long N, const cl_mem X, 
+                            const cl_mem Y, const int gpu)
+{
+  if (N <= 0) return (T) 0;
+  const size_t block = GPU_REDUCE_LOCAL;
+  const size_t ngroup = std::min(((size_t) N + block - 1)/block,reduce_groups[gpu]);
+  reserve(blas1_part[gpu],blas1_part_bytes[gpu],sizeof(T)*ngroup,"reduce");
+  cl_mem part = blas1_part[gpu];
+
+  libj::GPU_KERNEL& stage1 = blas1_get<T>(op);
+  const cl_long n = (cl_long) N;
+  int arg = 0;
+  stage1.set_arg(arg++,sizeof(cl_long),&n);
+  stage1.set_arg(arg++,sizeof(cl_mem),&X);
+  if (op == GPU_DOT_PART) {stage1.set_arg(arg++,sizeof(cl_mem),&Y);}
+  stage1.set_arg(arg++,sizeof(cl_mem),&part);
+  const size_t global1 = ngroup*block;
+  gpus[gpu].queue_command(stage1,1,&global1,&block);
+
+  //one group, which reads all partial sums before it writes part[0]
+  libj::GPU_KERNEL& stage2 = blas1_get<T>(GPU_REDUCE_PART);
+  const int npart = (int) ngroup;
+  stage2.set_arg(0,sizeof(int),&npart);
+  stage2.set_arg(1,sizeof(cl_mem),&part);
+  stage2.set_arg(2,sizeof(cl_mem),&part);
+  const size_t global2 = block;
+  gpus[gpu].queue_command(stage2,1,&global2,&block);
+
+  T result = (T) 0;
+  cl_event event;
+  cl_int err = clEnqueueReadBuffer(gpus[gpu].commands,part,CL_TRUE,0,sizeof(T),&result,
+                                   0,NULL,gpus[gpu].prof_event(&event));
+  gpus[gpu].prof_record(err,event,gpus[gpu].commands,"reduce sum","d2h",(double) sizeof(T));
+  if (err != CL_SUCCESS)
+  {
+    printf("ERROR libj::GPU_HANDLER::blas1_reduce could not read the sum, code %d \n",err);
+    exit(1);
+  }
+  return result;
+}
+
+//--------------------------------------------------------------------------
+// permute
+//	B = ALPHA*A + BETA*B, where element (i0,i1,...) of A is at 
+//	sum i_d*strideA[d], and goes to sum i_d*strideB[d] of B. Dims of 
+//	length one are dropped, and the fastest dim of A is moved to 0. If 
+//	the fastest dim of B is another one, the two are transposed through 
+//	local memory by permute_tiled, else permute_copy does an element per
+//	work item
+//--------------------------------------------------------------------------
+template <typename T>
+void GPU_HANDLER::permute(const int ndim, const size_t* len, const long* strideA,
+                          const cl_mem A, const long* strideB, cl_mem B, 
+                          const T ALPHA, const T BETA, const int gpu)
+{
+  init();
+  if (ndim > GPU_PERMUTE_MAX_DIM)
+  {
+    printf("ERROR libj::GPU_HANDLER::permute %d dims is more than the %d of the kernels\n",
+           ndim,GPU_PERMUTE_MAX_DIM);
+    exit(1);
+  }
+  gpu_permute_info info;
+  int nd = 0;
+  cl_long N = 1;
+  for (int d=0;d<ndim;d++)
+  {
+    if (len[d] == 0) return;
+    N *= (cl_long) len[d];
+    if (len[d] == 1) continue;
+    info.len[nd] = (cl_long) len[d];
+    info.sa[nd]  = (cl_long) strideA[d];
+    info.sb[nd]  = (cl_long) strideB[d];
+    nd++;
+  }
+  for (int d=nd;d<GPU_PERMUTE_MAX_DIM;d++) {info.len[d] = 1; info.sa[d] = 0; info.sb[d] = 0;}
+
+  //fastest dims of A and B
+  int da = 0, db = 0;
+  for (int d=1;d<nd;d++)
+  {
+    if (std::abs(info.sa[d]) < std::abs(info.sa[da])) da = d;
+    if (std::abs(info.sb[d]) < std::abs(info.sb[db])) db = d;
+  }
+  if (da != 0)
+  {
+    std::swap(info.len[0],info.len[da]);
+    std::swap(info.sa[0],info.sa[da]);
+    std::swap(info.sb[0],info.sb[da]);
+    if (db == 0) {db = da;} else if (db == da) {db = 0;}
+  }
+
+  const int type = gpu_real<T>::id();
+  if (!perm_loaded[type]) {load_permute(type);}
+  if (db != 0)
+  {
+    libj::GPU_KERNEL& kernel = perm_kernel[type][0];
+    const size_t tile = GPU_PERMUTE_TILE;
+    const size_t rows = (size_t) perm_rows[type];
+    size_t global[3];
+    global[0] = ((size_t) info.len[0] + tile - 1)/tile*tile;
+    global[1] = ((size_t) info.len[db] + tile - 1)/tile*rows;
+    global[2] = (size_t) (N/(info.len[0]*info.len[db]));
+    const size_t local[3] = {tile,rows,1};
+    kernel.set_arg(0,sizeof(int),&nd);
+    kernel.set_arg(1,sizeof(int),&db);
+    kernel.set_arg(2,sizeof(gpu_permute_info),&info);
+    kernel.set_arg(3,sizeof(T),&ALPHA);
+    kernel.set_arg(4,sizeof(T),&BETA);
+    kernel.set_arg(5,sizeof(cl_mem),&A);
+    kernel.set_arg(6,sizeof(cl_mem),&B);
+    gpus[gpu].queue_command(kernel,3,global,local);
+  }
+  else
+  {
+    libj::GPU_KERNEL& kernel = perm_kernel[type][1];
+    kernel.set_arg(0,sizeof(int),&nd);
+    kernel.set_arg(1,sizeof(cl_long),&N);
+    kernel.set_arg(2,sizeof(gpu_permute_info),&info);
+    kernel.set_arg(3,sizeof(T),&ALPHA);
+    kernel.set_arg(4,sizeof(T),&BETA);
+    kernel.set_arg(5,sizeof(cl_mem),&A);
+    kernel.set_arg(6,sizeof(cl_mem),&B);
+    blas1_launch(kernel,(long) N,gpu);
+  }
+}
+
+//--------------------------------------------------------------------------
+// load_batch
+//	builds the batched gemm program for a type (0 double, 1 float)
+//--------------------------------------------------------------------------
+void GPU_HANDLER::load_batch(const int type)
+{
+  init();
+  for (int gpu=0;gpu<get_num_gpu();gpu++)
+  {
+    if (gpus[gpu].max_work_group_size < (size_t) (GPU_BATCH_TILE*GPU_BATCH_TILE))
+    {
+      printf("ERROR libj::GPU_HANDLER::load_batch GPU #%d has work groups of %lu < %d\n",
+             gpu,(unsigned long) gpus[gpu].max_work_group_size,GPU_BATCH_TILE*GPU_BATCH_TILE);
+      exit(1);
+    }
+  }
+  char extra[64];
+  snprintf(extra,64,"-DBT=%d",GPU_BATCH_TILE);
+  load_type(type,gpu_batch_source,batch_program[type],extra);
+  batch_kernel[type].create(batch_program[type],"gemm_batch");
+  batch_loaded[type] = true;
+}
+
+//--------------------------------------------------------------------------
+// gemm_batch
+//	C_p = ALPHA*op(A_p).B_p + BETA*C_p for each entry of the batch, on the
+//	queue of one GPU. The sub group of each product is the smallest of 
+//	GPU_BATCH_MIN,..,GPU_BATCH_TILE that holds max(M,N), and the entries 
+//	are sorted by it and their tile counts, so that each class is one
+//	launch. The dims and offsets are written (blocking) to buffers of
+//	the GPU, which are kept and grown for the next call
+//--------------------------------------------------------------------------
+template <typename T>
+void GPU_HANDLER::gemm_batch(const bool transA, const std::vector<gpu_batch_entry>& batch,
+                             const T ALPHA, const cl_mem A, const cl_mem B, const T BETA,
+                             cl_mem C, const int gpu)
+{
+  init();
+  //class of each entry, (ST,tm,tn,tk)
+  std::vector<std::vector<int> > key;
+  std::vector<size_t> order;
+  key.reserve(batch.size());
+  order.reserve(batch.size());
+  for (size_t e=0;e<batch.size();e++)
+  {
+    const gpu_batch_entry& b = batch[e];
+    if (b.M <= 0 || b.N <= 0) continue;
+    if (b.K < 0 || b.a < 0 || b.b < 0 || b.c < 0)
+    {
+      printf("ERROR libj::GPU_HANDLER::gemm_batch entry %lu has K %d, offsets %ld %ld %ld\n",
+             (unsigned long) e,b.K,b.a,b.b,b.c);
+      exit(1);
+    }
+    int st = GPU_BATCH_MIN;
+    while (st < GPU_BATCH_TILE && st < std::max(b.M,b.N)) {st *= 2;}
+    std::vector<int> k(4);
+    k[0] = st;
+    k[1] = (b.M + st - 1)/st;
+    k[2] = (b.N + st - 1)/st;
+    k[3] = (b.K + st - 1)/st;
+    order.push_back(e);
+    key.push_back(k);
+  }
+  if (order.empty()) return;
+  std::vector<size_t> idx(order.size());
+  for (size_t i=0;i<idx.size();i++) {idx[i] = i;}
+  std::stable_sort(idx.begin(),idx.end(),
+                   [&](const size_t x, const size_t y) {return key[x] < key[y];});
+
+  //dims and offsets in the sorted order
+  const size_t num = idx.size();
+  std::vector<cl_int>  dims(6*num);
+  std::vector<cl_long> offs(3*num);
+  for (size_t i=0;i<num;i++)
+  {
+    const gpu_batch_entry& b = batch[order[idx[i]]];
+    dims[6*i]   = b.M;
+    dims[6*i+1] = b.N;
+    dims[6*i+2] = b.K;
+    dims[6*i+3] = (b.lda > 0) ? b.lda : std::max(1,transA ? b.K : b.M);
+    dims[6*i+4] = (b.ldb > 0) ? b.ldb : std::max(1,b.K);
+    dims[6*i+5] = (b.ldc > 0) ? b.ldc : b.M;
+    offs[3*i]   = b.a;
+    offs[3*i+1] = b.b;
+    offs[3*i+2] = b.c;
+  }
+  cl_mem& dbuf = batch_buffer[2*gpu];
+  cl_mem& obuf = batch_buffer[2*gpu+1];
+  reserve(dbuf,batch_bytes[2*gpu],sizeof(cl_int)*dims.size(),"gemm_batch");
+  reserve(obuf,batch_bytes[2*gpu+1],sizeof(cl_long)*offs.size(),"gemm_batch");
+  cl_event event;
+  cl_int err = clEnqueueWriteBuffer(gpus[gpu].commands,dbuf,CL_TRUE,0,
+                                    sizeof(cl_int)*dims.size(),dims.data(),0,NULL,
+                                    gpus[gpu].prof_event(&event));
+  gpus[gpu].prof_record(err,event,gpus[gpu].commands,"gemm_batch dims","h2d",
+                        (double) (sizeof(cl_int)*dims.size()));
+  if (err == CL_SUCCESS)
+  {
+    err = clEnqueueWriteBuffer(gpus[gpu].commands,obuf,CL_TRUE,0,
+                               sizeof(cl_long)*offs.size(),offs.data(),0,NULL,
+                               gpus[gpu].prof_event(&event));
+    gpus[gpu].prof_record(err,event,gpus[gpu].commands,"gemm_batch offsets","h2d",
+                          (double) (sizeof(cl_long)*offs.size()));
+  }
+  if (err != CL_SUCCESS)
+  {
+    printf("ERROR libj::GPU_HANDLER::gemm_batch could not write the batch, code %d \n",err);
+    exit(1);
+  }
+
+  const int type = gpu_real<T>::id();
+  if (!batch_loaded[type]) {load_batch(type);}
+  libj::GPU_KERNEL& kernel = batch_kernel[type];
+  const cl_int trans = transA ? 1 : 0;
+  kernel.set_arg(6,sizeof(cl_int),&trans);
+  kernel.set_arg(7,sizeof(cl_mem),&dbuf);
+  kernel.set_arg(8,sizeof(cl_mem),&obuf);
+  kernel.set_arg(9,sizeof(T),&ALPHA);
+  kernel.set_arg(10,sizeof(T),&BETA);
+  kernel.set_arg(11,sizeof(cl_mem),&A);
+  kernel.set_arg(12,sizeof(cl_mem),&B);
+  kernel.set_arg(13,sizeof(cl_mem),&C);
+
+  //one launch for each class
+  size_t i0 = 0;
+  while (i0 < num)
+  {
+    const std::vector<int>& k = key[idx[i0]];
+    size_t i1 = i0 + 1;
+    while (i1 < num && key[idx[i1]] == k) {i1++;}
+    const cl_int count = (cl_int) (i1 - i0);
+    const cl_int first = (cl_int) i0;
+    const int    sub   = GPU_BATCH_TILE/k[0];
+    const size_t groups = (size_t) ((count + sub*sub - 1)/(sub*sub));
+    kernel.set_arg(0,sizeof(cl_int),&count);
+    kernel.set_arg(1,sizeof(cl_int),&first);
+    kernel.set_arg(2,sizeof(cl_int),&k[0]);
+    kernel.set_arg(3,sizeof(cl_int),&k[1]);
+    kernel.set_arg(4,sizeof(cl_int),&k[2]);
+    kernel.set_arg(5,sizeof(cl_int),&k[3]);
+    const size_t global[2] = {groups*GPU_BATCH_TILE,GPU_BATCH_TILE};
+    const size_t local[2]  = {GPU_BATCH_TILE,GPU_BATCH_TILE};
+    gpus[gpu].queue_command(kernel,2,global,local);
+    i0 = i1;
+  }
+}
+
 }//end libj namespace
 #endif
@@ -1,2 +1,3 @@
 #define MAX_NUM_GPU 16
 #define MAX_NUM_PLATFORMS 4
+#define GPU_ALL -1   //split the work over all GPUs
@@ -1,6 +1,7 @@
 /*--------------------------------------------------------------------------
   gpu_kernel.hpp
 	JHT, April 17, 2022 : created
+	JHT, October 14, 2026 : the kernel keeps its name
 
   .hpp file for GPU_KERNEL
 --------------------------------------------------------------------------*/
@@ -32,6 +33,7 @@ class GPU_KERNEL
   public:
   //Data
   cl_kernel kernel;
+  std::string name;	//function in the program, for the profiling
 
   void create(const GPU_PROGRAM& program, const char* name);
   void set_arg(const int arg_num, const size_t bytes, const void* value);
@@ -46,6 +48,7 @@ void GPU_KERNEL::create(const GPU_PROGRAM& program, const char* name)
 {
   cl_int err;
   kernel = clCreateKernel(program.program,name,&err);
+  this->name = name;
   if (err != CL_SUCCESS)
   {
     printf("ERROR libj::GPU_KERNEL::create failed with code %d\n",err);
@@ -0,0 +1,329 @@
+/*--------------------------------------------------------------------------
+  gpu_pool.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for GPU_POOL, a device memory arena on one GPU, so that the
+  intermediates of each iteration need no clCreateBuffer. One slab is
+  made up front, and blocks are handed out as sub-buffers of it, like the
+  checkout/remove of a Core:
+
+    checkout(bytes) : a block from the free list of its size class, or
+                      else from the top of the slab (bump pointer)
+    remove(block)   : the block at the top goes back to the slab, along
+                      with any free blocks under it. Other blocks go on
+                      the free list of their size class, and keep their
+                      sub-buffer, so the next checkout of that class
+                      costs nothing
+    mark/rewind     : give back everything checked out since a mark
+
+  Sizes are rounded up to size classes, four per power of two, so at
+  most 25% (or the base alignment) is lost to rounding. Blocks start at
+  multiples of CL_DEVICE_MEM_BASE_ADDR_ALIGN, as sub-buffers must.
+
+  Usage
+  -------------------
+  libj::GPU_POOL P(GPU,1<<30);           //1 GB on GPU 0
+  cl_mem X = P.checkout(sizeof(double)*n);
+  kernel.set_arg(0,sizeof(cl_mem),&X);
+  P.remove(X);
+
+  const size_t m = P.mark();
+  ...checkouts...
+  P.rewind(m);
+
+  P.high_water();  P.used();  P.nfree();  P.reuses();  P.info();
+--------------------------------------------------------------------------*/
+#ifndef GPU_POOL_HPP
+#define GPU_POOL_HPP
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#ifdef __APPLE__
+  #include <OpenCL/opencl.h>
+#else
+  #include <CL/cl.h>
+#endif
+
+#include "gpu_handler.hpp"
+
+namespace libj
+{
+
+class GPU_POOL
+{
+  private:
+  struct block
+  {
+    cl_mem buffer;  //sub-buffer of the slab
+    size_t offset;  //bytes from the start of the slab
+    size_t bytes;   //bytes of its size class
+    int    size_class;
+    bool   freed;   //on a free list
+  };
+
+  libj::GPU_HANDLER*   m_gpu;
+  int                  m_dev;
+  cl_mem               m_slab;
+  size_t               m_size;     //bytes of the slab
+  size_t               m_align;    //base alignment of sub-buffers
+  size_t               m_top;      //end of the last block
+  size_t               m_used;     //bytes of blocks checked out
+  size_t               m_hwm;      //most bytes checked out at once
+  size_t               m_reuses;   //checkouts from a free list
+  std::vector<block>   m_blocks;   //by offset
+  std::vector<std::vector<int> > m_free; //free blocks of each class, by offset
+
+  static int    m_class(const size_t bytes);
+  static size_t m_class_bytes(const int size_class);
+  int  m_find(const cl_mem buffer) const;
+  void m_pop_top();
+
+  GPU_POOL(const GPU_POOL& other);
+  GPU_POOL& operator= (const GPU_POOL& other);
+
+  public:
+  GPU_POOL(libj::GPU_HANDLER& gpu, const size_t bytes, const int dev = 0);
+  ~GPU_POOL();
+
+  cl_mem checkout(const size_t bytes);
+  void   remove(const cl_mem buffer);
+
+  //offset of the next block from the top, and give back all above it
+  size_t mark() const {return m_top;}
+  void   rewind(const size_t mark);
+
+  //the whole slab, and the offset of a block in it
+  cl_mem slab() const {return m_slab;}
+  size_t offset(const cl_mem buffer) const;
+
+  //information, in bytes
+  size_t size() const {return m_size;}
+  size_t used() const {return m_used;}
+  size_t nfree() const {return m_size - m_top;}
+  size_t high_water() const {return m_hwm;}
+  void   reset_high_water() {m_hwm = m_used;}
+  size_t reuses() const {return m_reuses;}
+  size_t num_blocks() const {return m_blocks.size();}
+  void   info() const;
+};
+
+//--------------------------------------------------------------------------
+// constructor
+//--------------------------------------------------------------------------
+GPU_POOL::GPU_POOL(libj::GPU_HANDLER& gpu, const size_t bytes, const int dev)
+{
+  m_gpu = &gpu;
+  m_dev = dev;
+  m_size = bytes;
+  m_top = 0;
+  m_used = 0;
+  m_hwm = 0;
+  m_reuses = 0;
+
+  gpu.init();
+  cl_uint bits = 0;
+  if (clGetDeviceInfo(gpu.gpus[dev].device,CL_DEVICE_MEM_BASE_ADDR_ALIGN,sizeof(bits),
+                      &bits,NULL) != CL_SUCCESS || bits < 8) {bits = 1024;}
+  m_align = bits/8;
+
+  cl_int err;
+  m_slab = clCreateBuffer(gpu.platform.context,CL_MEM_READ_WRITE,
+                          (bytes > 0) ? bytes : 1,NULL,&err);
+  if (err != CL_SUCCESS)
+  {
+    printf("ERROR libj::GPU_POOL could not make a slab of %lu bytes, code %d \n",
+           (unsigned long) bytes,err);
+    exit(1);
+  }
+}
+
+//--------------------------------------------------------------------------
+// destructor
+//--------------------------------------------------------------------------
+GPU_POOL::~GPU_POOL()
+{
+  for (size_t blk=0;blk<m_blocks.size();blk++) {clReleaseMemObject(m_blocks[blk].buffer);}
+  clReleaseMemObject(m_slab);
+}
+
+//--------------------------------------------------------------------------
+// m_class
+//	size class of bytes, 4 per power of two : 4*2^k, 5*2^k, 6*2^k, 7*2^k
+//--------------------------------------------------------------------------
+int GPU_POOL::m_class(const size_t bytes)
+{
+  if (bytes <= 4) return 0;
+  int k = 0;
+  while (((size_t) 8 << k) <= bytes - 1) {k++;}
+  //bytes is in (4*2^k, 8*2^k]
+  const size_t step = (size_t) 1 << k;
+  const int sub = (int) ((bytes - 1)/step) - 3;  //1..4
+  return 4*k + sub;
+}
+
+size_t GPU_POOL::m_class_bytes(const int size_class)
+{
+  if (size_class == 0) return 4;
+  const int k = (size_class - 1)/4;
+  const int sub = (size_class - 1)%4 + 1;
+  return ((size_t) (4 + sub)) << k;
+}
+
+//--------------------------------------------------------------------------
+// m_find
+//--------------------------------------------------------------------------
+int GPU_POOL::m_find(const cl_mem buffer) const
+{
+  for (int blk=(int) m_blocks.size()-1;blk>=0;blk--)
+  {
+    if (m_blocks[blk].buffer == buffer) return blk;
+  }
+  return -1;
+}
+
+//--------------------------------------------------------------------------
+// checkout
+//--------------------------------------------------------------------------
+cl_mem GPU_POOL::checkout(const size_t bytes)
+{
+  const int    size_class = m_class((bytes > 0) ? bytes : 1);
+  const size_t class_bytes = m_class_bytes(size_class);
+
+  //a free block of this class
+  if (size_class < (int) m_free.size() && !m_free[size_class].empty())
+  {
+    const int blk = m_free[size_class].back();
+    m_free[size_class].pop_back();
+    m_blocks[blk].freed = false;
+    m_used += class_bytes;
+    if (m_used > m_hwm) m_hwm = m_used;
+    m_reuses++;
+    return m_blocks[blk].buffer;
+  }
+
+  //a new block at the top
+  const size_t offset = ((m_top + m_align - 1)/m_align)*m_align;
+  if (offset + class_bytes > m_size)
+  {
+    printf("ERROR libj::GPU_POOL::checkout %lu bytes does not fit, %lu of %lu are free \n",
+           (unsigned long) bytes,(unsigned long) nfree(),(unsigned long) m_size);
+    exit(1);
+  }
+  cl_buffer_region region;
+  region.origin = offset;
+  region.size = class_bytes;
+  cl_int err;
+  cl_mem buffer = clCreateSubBuffer(m_slab,CL_MEM_READ_WRITE,CL_BUFFER_CREATE_TYPE_REGION,
+                                    &region,&err);
+  if (err != CL_SUCCESS)
+  {
+    printf("ERROR libj::GPU_POOL::checkout could not make a sub-buffer, code %d \n",err);
+    exit(1);
+  }
+
+  block b;
+  b.buffer = buffer;
+  b.offset = offset;
+  b.bytes = class_bytes;
+  b.size_class = size_class;
+  b.freed = false;
+  m_blocks.push_back(b);
+  m_top = offset + class_bytes;
+  m_used += class_bytes;
+  if (m_used > m_hwm) m_hwm = m_used;
+  return buffer;
+}
+
+//--------------------------------------------------------------------------
+// m_pop_top
+//	gives the free blocks at the top back to the slab
+//--------------------------------------------------------------------------
+void GPU_POOL::m_pop_top()
+{
+  while (!m_blocks.empty() && m_blocks.back().freed)
+  {
+    const block& b = m_blocks.back();
+    const int blk = (int) m_blocks.size() - 1;
+    std::vector<int>& list = m_free[b.size_class];
+    for (size_t i=0;i<list.size();i++)
+    {
+      if (list[i] == blk) {list.erase(list.begin() + i); break;}
+    }
+    clReleaseMemObject(b.buffer);
+    m_blocks.pop_back();
+  }
+  m_top = m_blocks.empty() ? 0 : m_blocks.back().offset + m_blocks.back().bytes;
+}
+
+//--------------------------------------------------------------------------
+// remove
+//--------------------------------------------------------------------------
+void GPU_POOL::remove(const cl_mem buffer)
+{
+  const int blk = m_find(buffer);
+  if (blk < 0 || m_blocks[blk].freed)
+  {
+    printf("ERROR libj::GPU_POOL::remove the buffer is not checked out from this pool\n");
+    exit(1);
+  }
+  block& b = m_blocks[blk];
+  b.freed = true;
+  m_used -= b.bytes;
+  if (b.size_class >= (int) m_free.size()) {m_free.resize(b.size_class+1);}
+  m_free[b.size_class].push_back(blk);
+  m_pop_top();
+}
+
+//--------------------------------------------------------------------------
+// rewind
+//	every block at or past mark is given back
+//--------------------------------------------------------------------------
+void GPU_POOL::rewind(const size_t mark)
+{
+  for (int blk=(int) m_blocks.size()-1;blk>=0 && m_blocks[blk].offset >= mark;blk--)
+  {
+    block& b = m_blocks[blk];
+    if (b.freed) continue;
+    b.freed = true;
+    m_used -= b.bytes;
+    if (b.size_class >= (int) m_free.size()) {m_free.resize(b.size_class+1);}
+    m_free[b.size_class].push_back(blk);
+  }
+  m_pop_top();
+}
+
+//--------------------------------------------------------------------------
+// offset
+//--------------------------------------------------------------------------
+size_t GPU_POOL::offset(const cl_mem buffer) const
+{
+  const int blk = m_find(buffer);
+  if (blk < 0)
+  {
+    printf("ERROR libj::GPU_POOL::offset the buffer is not from this pool\n");
+    exit(1);
+  }
+  return m_blocks[blk].offset;
+}
+
+//--------------------------------------------------------------------------
+// info
+//--------------------------------------------------------------------------
+void GPU_POOL::info() const
+{
+  size_t nfree_blocks = 0;
+  for (size_t c=0;c<m_free.size();c++) {nfree_blocks += m_free[c].size();}
+  printf("GPU_POOL on GPU #%d has \n",m_dev);
+  printf("%lu bytes \n",(unsigned long) m_size);
+  printf("%lu bytes checked out \n",(unsigned long) m_used);
+  printf("%lu bytes free at the top \n",(unsigned long) nfree());
+  printf("%lu bytes at the high water mark \n",(unsigned long) m_hwm);
+  printf("%lu blocks, %lu of them on free lists \n",(unsigned long) m_blocks.size(),
+         (unsigned long) nfree_blocks);
+  printf("%lu checkouts from the free lists \n",(unsigned long) m_reuses);
+  printf("\n");
+}
+
+}//end libj namespace
+#endif
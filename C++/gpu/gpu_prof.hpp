@@ -0,0 +1,347 @@
+/*--------------------------------------------------------------------------
+  gpu_prof.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for GPU_PROF, the device side timing of the commands of the
+  GPU_HANDLER queues, from the OpenCL profiling events
+
+  Profiling is off unless LIBJ_CL_PROFILE=1, or GPU.prof.enable() is
+  called before the handler is initialized, since the queues must be
+  made with CL_QUEUE_PROFILING_ENABLE. Then every kernel, write, read,
+  copy, and fill of the handler (and of GPU_GRAPH and device_tensor)
+  keeps its event, tagged by the kernel or buffer name and the kind of
+  command (kernel, h2d, d2h, d2d, fill).
+
+  flush waits for the kept events, and reads CL_PROFILING_COMMAND_START
+  and END of each. The device clock is put on the host steady clock by
+  the smallest (host time just after the enqueue - COMMAND_QUEUED) seen
+  on each GPU, so the device times line up with the host scopes to
+  about the time of an enqueue. Each command then adds
+
+    - its device time to the calls, time, and bytes of the command on
+      that GPU, which report prints, with the busy and idle time of
+      each GPU (from the first start to the last end, if any queue of
+      it is running a command it is busy)
+    - with -DLIBJ_PROFILE, a region gpu<n>/<kind>:<name> of profile.hpp,
+      on the thread that calls flush
+    - with -DLIBJ_TRACE, an event on the track "gpu <n> queue <q>" of
+      trace.hpp, so the trace shows where each queue is idle next to
+      the host threads
+
+  Usage
+  ---------------------------
+  setenv LIBJ_CL_PROFILE 1
+  libj::GPU_HANDLER GPU;
+  ...
+  GPU.prof.report(stdout);   //flush, and print the device times
+  GPU.prof.flush();          //before Ptrace::write, or profile_report
+
+  At most GPU_PROF_PENDING events are kept, after which the oldest half
+  are flushed, so a long run does not keep all of its events. Profiling
+  adds an event, and a lock, to each command.
+--------------------------------------------------------------------------*/
+#ifndef GPU_PROF_HPP
+#define GPU_PROF_HPP
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include <string>
+#include <map>
+#include <set>
+#include <mutex>
+#include <chrono>
+#include <algorithm>
+#ifdef __APPLE__
+  #include <OpenCL/opencl.h>
+#else
+  #include <CL/cl.h>
+#endif
+
+#if defined (LIBJ_PROFILE)
+  #include "profile.hpp"
+#endif
+#if defined (LIBJ_TRACE)
+  #include "trace.hpp"
+#endif
+
+#if !defined (GPU_PROF_PENDING)
+  #define GPU_PROF_PENDING 4096
+#endif
+
+namespace libj
+{
+
+//a command that has been queued, but not read yet
+struct gpu_prof_pending
+{
+  cl_event    event;
+  int         gpu;
+  int         queue;
+  const char* name;       //kernel or buffer
+  const char* kind;       //kernel, h2d, d2h, d2d, fill
+  double      bytes;
+  long long   host_ns;    //just after the enqueue
+};
+
+//the commands of one name and kind on one GPU
+struct gpu_prof_stat
+{
+  long      calls;
+  long long ns;
+  double    bytes;
+};
+
+/*--------------------------------------------------------------------------
+  GPU_PROF
+--------------------------------------------------------------------------*/
+class GPU_PROF
+{
+  private:
+  bool                              m_enabled;
+  bool                              m_env;      //LIBJ_CL_PROFILE was read
+  std::mutex                        m_lock;
+  std::vector<gpu_prof_pending>     m_pending;
+  std::set<std::string>             m_names;    //every name, kept for the profiler and tracer
+  std::map<std::string,gpu_prof_stat> m_stats;  //by "gpu<n>/<kind>:<name>"
+  std::vector<long long>            m_offset;   //host - device ns of each GPU
+  std::vector<bool>                 m_synced;   //m_offset is set
+  std::vector<long long>            m_first;    //first start of each GPU, host ns
+  std::vector<long long>            m_last;     //last end of each GPU, host ns
+  std::vector<long long>            m_busy;     //busy ns of each GPU
+  #if defined (LIBJ_TRACE)
+  std::map<std::pair<int,int>,libj::trace_buffer*> m_tracks;
+  #endif
+
+  const char* m_intern(const std::string& name);
+  void        m_grow(const int gpu);
+  void        m_read(const size_t num);
+
+  GPU_PROF(const GPU_PROF& other);
+  GPU_PROF& operator= (const GPU_PROF& other);
+
+  public:
+  GPU_PROF() : m_enabled(false), m_env(false) {}
+
+  //on if enable was called, or LIBJ_CL_PROFILE=1
+  bool enabled();
+  void enable() {m_enabled = true;}
+
+  //keep the event of a command on queue q of gpu, which is released by
+  //flush. Does nothing (the event is NULL) if err is not CL_SUCCESS
+  void record(const cl_int err, const cl_event event, const int gpu, const int q,
+              const char* name, const char* kind, const double bytes);
+
+  //wait for the kept events, and add their device times
+  void flush();
+
+  //flush, and print the device time of each command of each GPU
+  void report(FILE* fp);
+
+  //flush, and forget the device times
+  void reset();
+};
+
+//--------------------------------------------------------------------------
+// gpu_prof_now
+//	ns of the host steady clock, as trace_now
+//--------------------------------------------------------------------------
+inline long long gpu_prof_now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//--------------------------------------------------------------------------
+// enabled
+//--------------------------------------------------------------------------
+bool GPU_PROF::enabled()
+{
+  if (!m_env)
+  {
+    const char* env = getenv("LIBJ_CL_PROFILE");
+    if (env != NULL && atoi(env) != 0) {m_enabled = true;}
+    m_env = true;
+  }
+  return m_enabled;
+}
+
+//--------------------------------------------------------------------------
+// m_intern
+//	a copy of name that lives as long as the GPU_PROF
+//--------------------------------------------------------------------------
+const char* GPU_PROF::m_intern(const std::string& name)
+{
+  return m_names.insert(name).first->c_str();
+}
+
+//--------------------------------------------------------------------------
+// m_grow
+//--------------------------------------------------------------------------
+void GPU_PROF::m_grow(const int gpu)
+{
+  if (gpu < (int) m_offset.size()) return;
+  m_offset.resize(gpu+1,0);
+  m_synced.resize(gpu+1,false);
+  m_first.resize(gpu+1,-1);
+  m_last.resize(gpu+1,-1);
+  m_busy.resize(gpu+1,0);
+}
+
+//--------------------------------------------------------------------------
+// record
+//--------------------------------------------------------------------------
+void GPU_PROF::record(const cl_int err, const cl_event event, const int gpu, const int q,
+                      const char* name, const char* kind, const double bytes)
+{
+  if (err != CL_SUCCESS || event == NULL) return;
+  const long long now = gpu_prof_now();
+  std::lock_guard<std::mutex> lock(m_lock);
+  const gpu_prof_pending add = {event,gpu,q,m_intern((name != NULL) ? name : kind),
+                                m_intern(kind),bytes,now};
+  m_pending.push_back(add);
+  if (m_pending.size() >= GPU_PROF_PENDING) {m_read(m_pending.size()/2);}
+}
+
+//--------------------------------------------------------------------------
+// m_read
+//	waits for the oldest num events, with the lock held. The offset of
+//	each GPU is the smallest seen, including those of these events. The
+//	busy time is the union of the commands in start order, which is
+//	exact within a batch, and counts nothing twice over batches
+//--------------------------------------------------------------------------
+void GPU_PROF::m_read(const size_t num)
+{
+  if (num == 0) return;
+  std::vector<cl_event> events(num);
+  for (size_t e=0;e<num;e++) {events[e] = m_pending[e].event;}
+  cl_int err = clWaitForEvents((cl_uint) num,events.data());
+  if (err != CL_SUCCESS)
+  {
+    printf("ERROR libj::GPU_PROF::flush could not wait for the events, code %d \n",err);
+    exit(1);
+  }
+
+  std::vector<cl_ulong> times(3*num);
+  for (size_t e=0;e<num;e++)
+  {
+    const gpu_prof_pending& P = m_pending[e];
+    const cl_profiling_info info[3] = {CL_PROFILING_COMMAND_QUEUED,CL_PROFILING_COMMAND_START,
+                                       CL_PROFILING_COMMAND_END};
+    for (int i=0;i<3 && err == CL_SUCCESS;i++)
+    {
+      err = clGetEventProfilingInfo(P.event,info[i],sizeof(cl_ulong),&times[3*e+i],NULL);
+    }
+    if (err != CL_SUCCESS)
+    {
+      printf("ERROR libj::GPU_PROF::flush could not read the times of %s, code %d \n",P.name,err);
+      exit(1);
+    }
+    m_grow(P.gpu);
+    const long long offset = P.host_ns - (long long) times[3*e];
+    if (!m_synced[P.gpu] || offset < m_offset[P.gpu]) {m_offset[P.gpu] = offset;}
+    m_synced[P.gpu] = true;
+  }
+
+  std::vector<std::pair<long long,size_t> > order(num);
+  for (size_t e=0;e<num;e++)
+  {
+    const gpu_prof_pending& P = m_pending[e];
+    order[e] = std::make_pair((long long) times[3*e+1] + m_offset[P.gpu],e);
+  }
+  std::sort(order.begin(),order.end());
+
+  for (size_t o=0;o<num;o++)
+  {
+    const size_t e = order[o].second;
+    const gpu_prof_pending& P = m_pending[e];
+    const long long beg = order[o].first;
+    const long long end = (long long) times[3*e+2] + m_offset[P.gpu];
+    const long long ns = end - beg;
+
+    const std::string key = "gpu" + std::to_string(P.gpu) + "/" + P.kind + ":" + P.name;
+    gpu_prof_stat& S = m_stats[key];
+    S.calls++;
+    S.ns += ns;
+    S.bytes += P.bytes;
+
+    if (m_first[P.gpu] < 0 || beg < m_first[P.gpu]) {m_first[P.gpu] = beg;}
+    const long long from = std::max(beg,m_last[P.gpu]);
+    if (end > from) {m_busy[P.gpu] += end - from;}
+    m_last[P.gpu] = std::max(m_last[P.gpu],end);
+
+    #if defined (LIBJ_PROFILE)
+    const std::string group = "gpu" + std::to_string(P.gpu);
+    const std::string region = std::string(P.kind) + ":" + P.name;
+    libj::profile_add(m_intern(group),m_intern(region),1,ns,P.bytes);
+    #endif
+    #if defined (LIBJ_TRACE)
+    libj::trace_buffer*& track = m_tracks[std::make_pair(P.gpu,P.queue)];
+    if (track == NULL)
+    {
+      const std::string label = "gpu " + std::to_string(P.gpu) + " queue " + std::to_string(P.queue);
+      track = &libj::trace_track(m_intern(label));
+    }
+    track->add(P.name,P.kind,beg,end,(long long) P.bytes);
+    #endif
+    clReleaseEvent(P.event);
+  }
+  m_pending.erase(m_pending.begin(),m_pending.begin() + num);
+}
+
+//--------------------------------------------------------------------------
+// flush
+//--------------------------------------------------------------------------
+void GPU_PROF::flush()
+{
+  std::lock_guard<std::mutex> lock(m_lock);
+  m_read(m_pending.size());
+}
+
+//--------------------------------------------------------------------------
+// report
+//	the commands are in key order, so by GPU, and by kind in a GPU
+//--------------------------------------------------------------------------
+void GPU_PROF::report(FILE* fp)
+{
+  std::lock_guard<std::mutex> lock(m_lock);
+  m_read(m_pending.size());
+  fprintf(fp,"\nGPU device times\n");
+  fprintf(fp,"%-40s %10s %12s %12s %12s\n","command","calls","time (s)","avg (us)","GB/s");
+  for (std::map<std::string,gpu_prof_stat>::const_iterator it = m_stats.begin();
+       it != m_stats.end();it++)
+  {
+    const gpu_prof_stat& S = it->second;
+    const double sec = 1.0e-9*S.ns;
+    fprintf(fp,"%-40s %10ld %12.6f %12.3f %12.3f\n",it->first.c_str(),S.calls,sec,
+            (S.calls > 0) ? 1.0e6*sec/S.calls : 0.0,(sec > 0.0) ? 1.0e-9*S.bytes/sec : 0.0);
+  }
+  for (size_t gpu=0;gpu<m_offset.size();gpu++)
+  {
+    if (m_first[gpu] < 0) continue;
+    const double span = 1.0e-9*(m_last[gpu] - m_first[gpu]);
+    const double busy = 1.0e-9*m_busy[gpu];
+    fprintf(fp,"gpu%zu : %.6f s from the first command to the last, %.6f s busy, %.6f s idle (%.1f%%)\n",
+            gpu,span,busy,span - busy,(span > 0.0) ? 100.0*(span - busy)/span : 0.0);
+  }
+}
+
+//--------------------------------------------------------------------------
+// reset
+//	the names and tracks are kept, the profiler and tracer point to them
+//--------------------------------------------------------------------------
+void GPU_PROF::reset()
+{
+  std::lock_guard<std::mutex> lock(m_lock);
+  m_read(m_pending.size());
+  m_stats.clear();
+  m_offset.clear();
+  m_synced.clear();
+  m_first.clear();
+  m_last.clear();
+  m_busy.clear();
+}
+
+}//end libj namespace
+
+#endif
@@ -1,16 +1,34 @@
 /*------------------------------------------------------------------------------
   gpu_program.hpp
 	JHt, April 17, 2022 : created
+	JHT, October 14, 2026 : on disk cache of the program binaries
+	JHT, October 14, 2026 : hash
 
   .hpp file for a gpu_program, which manges OpenCL program and kernel 
   objects, so that they don't need to be re-compiled every run-through
+
+  build keeps the binaries of each program on disk, in one file named by
+  a hash of the source, the build options, and the name, version, and
+  driver version of every device. The next build of the same program
+  loads them with clCreateProgramWithBinary instead of compiling, and 
+  falls back to the source if the file is missing or not valid (so a 
+  new driver just makes a new file). Files are written to a temporary 
+  name and renamed, so jobs can share the cache.
+
+  The cache directory is LIBJ_CL_CACHE if set, or $HOME/.libj_cl_cache,
+  and the cache is off if LIBJ_CL_CACHE is "none" or the directory 
+  cannot be made.
 ------------------------------------------------------------------------------*/
 #ifndef GPU_PROGRAM_HPP
 #define GPU_PROGRAM_HPP
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <vector>
 #include <string>
+#include <unistd.h>
+#include <sys/stat.h>
 
 #ifdef __APPLE__
   #include <OpenCL/opencl.h>
@@ -31,6 +49,12 @@ namespace libj
 class GPU_PROGRAM
 {
   private:
+    std::string m_source; //source of load, for the cache key
+
+    std::string m_cache_file(const GPU_PLATFORM& platform, const char* options) const;
+    bool m_load_binary(const GPU_PLATFORM& platform, const char* options,
+                       const std::string& file);
+    void m_save_binary(const GPU_PLATFORM& platform, const std::string& file) const;
 
   public:
     cl_program               program;
@@ -41,6 +65,12 @@ class GPU_PROGRAM
     void load(const GPU_PLATFORM& platform, const char* source); 
     void build(const GPU_PLATFORM& platform, const char* options);
     void create_kernel(const char* name);
+
+    //directory of the binary cache, made if needed, empty if off
+    static std::string cache_dir();
+
+    //64 bit FNV-1a hash of a string
+    static unsigned long long hash(const std::string& key);
 };
 
 /*------------------------------------------------------------------------------
@@ -49,6 +79,7 @@ class GPU_PROGRAM
 ------------------------------------------------------------------------------*/
 void GPU_PROGRAM::load(const GPU_PLATFORM& platform, const char* source)
 {
+  m_source = source;
   cl_int err;
   program = clCreateProgramWithSource(platform.context,1,
                                       (const char**) &source,NULL,&err);
@@ -66,6 +97,10 @@ void GPU_PROGRAM::load(const GPU_PLATFORM& platform, const char* source)
 ------------------------------------------------------------------------------*/
 void GPU_PROGRAM::build(const GPU_PLATFORM& platform, const char* options)
 {
+  //try the binaries of an earlier build
+  const std::string file = m_cache_file(platform,options);
+  if (!file.empty() && m_load_binary(platform,options,file)) return;
+
   cl_int err;
   err = clBuildProgram(program,platform.num_gpu,platform.devices,
                        options,NULL,NULL);
@@ -82,6 +117,154 @@ void GPU_PROGRAM::build(const GPU_PLATFORM& platform, const char* options)
     exit(1);
   }
 
+  if (!file.empty()) {m_save_binary(platform,file);}
+}
+
+/*------------------------------------------------------------------------------
+  cache_dir
+	directory of the binary cache, made if needed, empty if off
+------------------------------------------------------------------------------*/
+std::string GPU_PROGRAM::cache_dir()
+{
+  std::string dir;
+  const char* env = getenv("LIBJ_CL_CACHE");
+  if (env != NULL) {dir = env;}
+  else if (getenv("HOME") != NULL) {dir = std::string(getenv("HOME")) + "/.libj_cl_cache";}
+  if (dir.empty() || dir == "none") return std::string();
+
+  mkdir(dir.c_str(),0755); 
+  if (access(dir.c_str(),W_OK) != 0) return std::string();
+  return dir;
+}
+
+/*------------------------------------------------------------------------------
+  hash
+	64 bit FNV-1a hash of a string
+------------------------------------------------------------------------------*/
+unsigned long long GPU_PROGRAM::hash(const std::string& key)
+{
+  unsigned long long h = 14695981039346656037ULL;
+  for (size_t c=0;c<key.size();c++)
+  {
+    h ^= (unsigned char) key[c];
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+/*------------------------------------------------------------------------------
+  m_cache_file
+	file of the binaries, from a 64 bit FNV-1a hash of the source, the
+	options, and the devices
+------------------------------------------------------------------------------*/
+std::string GPU_PROGRAM::m_cache_file(const GPU_PLATFORM& platform, 
+                                      const char* options) const
+{
+  const std::string dir = cache_dir();
+  if (dir.empty()) return dir;
+
+  std::string key = m_source;
+  key += '\0';
+  if (options != NULL) {key += options;}
+  const cl_device_info info[3] = {CL_DEVICE_NAME,CL_DEVICE_VERSION,CL_DRIVER_VERSION};
+  for (int dev=0;dev<(int) platform.num_gpu;dev++)
+  {
+    for (int i=0;i<3;i++)
+    {
+      char str[256] = {0};
+      clGetDeviceInfo(platform.devices[dev],info[i],sizeof(str)-1,str,NULL);
+      key += '\0';
+      key += str;
+    }
+  }
+  char name[64];
+  snprintf(name,64,"/%016llx.clbin",hash(key));
+  return dir + name;
+}
+
+/*------------------------------------------------------------------------------
+  m_load_binary
+	the file is the number of devices, and the size and binary of each. 
+	Returns false, and leaves the source program, if it cannot be used
+------------------------------------------------------------------------------*/
+bool GPU_PROGRAM::m_load_binary(const GPU_PLATFORM& platform, const char* options,
+                                const std::string& file)
+{
+  FILE* fp = fopen(file.c_str(),"rb");
+  if (fp == NULL) return false;
+
+  const cl_uint ndev = platform.num_gpu;
+  cl_uint nfile = 0;
+  std::vector<size_t> sizes(ndev,0);
+  std::vector<std::vector<unsigned char> > bins(ndev);
+  bool ok = fread(&nfile,sizeof(nfile),1,fp) == 1 && nfile == ndev;
+  for (cl_uint dev=0;dev<ndev && ok;dev++)
+  {
+    ok = fread(&sizes[dev],sizeof(size_t),1,fp) == 1 && sizes[dev] > 0;
+    if (ok) 
+    {
+      bins[dev].resize(sizes[dev]);
+      ok = fread(bins[dev].data(),1,sizes[dev],fp) == sizes[dev];
+    }
+  }
+  fclose(fp);
+  if (!ok) return false;
+
+  std::vector<const unsigned char*> ptrs(ndev);
+  for (cl_uint dev=0;dev<ndev;dev++) {ptrs[dev] = bins[dev].data();}
+  cl_int err, status;
+  cl_program binary = clCreateProgramWithBinary(platform.context,ndev,platform.devices,
+                                                sizes.data(),ptrs.data(),&status,&err);
+  if (err != CL_SUCCESS || status != CL_SUCCESS) 
+  {
+    if (err == CL_SUCCESS) {clReleaseProgram(binary);}
+    return false;
+  }
+  if (clBuildProgram(binary,ndev,platform.devices,options,NULL,NULL) != CL_SUCCESS)
+  {
+    clReleaseProgram(binary);
+    return false;
+  }
+  clReleaseProgram(program);
+  program = binary;
+  return true;
+}
+
+/*------------------------------------------------------------------------------
+  m_save_binary
+	writes the binaries of the built program, failures are ignored
+------------------------------------------------------------------------------*/
+void GPU_PROGRAM::m_save_binary(const GPU_PLATFORM& platform, 
+                                const std::string& file) const
+{
+  const cl_uint ndev = platform.num_gpu;
+  std::vector<size_t> sizes(ndev,0);
+  if (clGetProgramInfo(program,CL_PROGRAM_BINARY_SIZES,sizeof(size_t)*ndev,
+                       sizes.data(),NULL) != CL_SUCCESS) return;
+  std::vector<std::vector<unsigned char> > bins(ndev);
+  std::vector<unsigned char*> ptrs(ndev);
+  for (cl_uint dev=0;dev<ndev;dev++) 
+  {
+    if (sizes[dev] == 0) return;
+    bins[dev].resize(sizes[dev]);
+    ptrs[dev] = bins[dev].data();
+  }
+  if (clGetProgramInfo(program,CL_PROGRAM_BINARIES,sizeof(unsigned char*)*ndev,
+                       ptrs.data(),NULL) != CL_SUCCESS) return;
+
+  char tmp[64];
+  snprintf(tmp,64,".%ld.tmp",(long) getpid());
+  const std::string part = file + tmp;
+  FILE* fp = fopen(part.c_str(),"wb");
+  if (fp == NULL) return;
+  bool ok = fwrite(&ndev,sizeof(ndev),1,fp) == 1;
+  for (cl_uint dev=0;dev<ndev && ok;dev++)
+  {
+    ok = fwrite(&sizes[dev],sizeof(size_t),1,fp) == 1 &&
+         fwrite(ptrs[dev],1,sizes[dev],fp) == sizes[dev];
+  }
+  ok = (fclose(fp) == 0) && ok;
+  if (!ok || rename(part.c_str(),file.c_str()) != 0) {remove(part.c_str());}
 }
 
 /*------------------------------------------------------------------------------
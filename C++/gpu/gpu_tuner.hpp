@@ -0,0 +1,289 @@
+/*--------------------------------------------------------------------------
+  gpu_tuner.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for GPU_TUNER, which picks the launch or build parameters of
+  a kernel on a device by timing each candidate on first use, and keeps
+  the winners in tune.txt in the binary cache directory (see
+  gpu_program.hpp), so later runs on the same device and driver do no
+  timing at all.
+
+  The key of each entry is the name of what is tuned, and a hash of the
+  name, version, and driver version of the device, so a new GPU or driver
+  is tuned again. Each line of the file is a key and its values. The file
+  is read again before each save, and written to a temporary name and
+  renamed, so jobs can share it.
+
+  LIBJ_CL_TUNE sets the mode
+
+    unset, or 1 : tune what is not in the file
+    0           : no tuning, the first candidate (the default) is used
+    force       : tune again, and replace what is in the file
+
+  Usage
+  -------------------
+  //candidates are vectors of ints, the first is the default
+  std::vector<std::vector<int> > cand = {{256},{64},{128}};
+  std::vector<int> best = tuner.tune(libj::GPU_TUNER::key("axpy",GPU.gpus[0]),cand,
+    [&](const std::vector<int>& c) -> double
+    {
+      //queue the kernel with c, < 0 if c cannot run here
+      return libj::GPU_TUNER::time(GPU.gpus[0].commands,[&]{...});
+    });
+--------------------------------------------------------------------------*/
+#ifndef GPU_TUNER_HPP
+#define GPU_TUNER_HPP
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include <sys/time.h>
+#ifdef __APPLE__
+  #include <OpenCL/opencl.h>
+#else
+  #include <CL/cl.h>
+#endif
+
+#include "gpu.hpp"
+#include "gpu_program.hpp"
+
+//runs of each candidate that are timed, after one to warm up
+#define GPU_TUNE_REPS 3
+
+namespace libj
+{
+
+class GPU_TUNER
+{
+  private:
+  std::string                    m_file;   //empty if there is no cache dir
+  int                            m_mode;   //0 off, 1 on, 2 force
+  std::vector<std::string>       m_keys;
+  std::vector<std::vector<int> > m_values;
+
+  void m_read();
+  void m_write() const;
+  int  m_find(const std::string& key) const;
+
+  public:
+  GPU_TUNER();
+
+  bool enabled() const {return m_mode != 0;}
+
+  //values of a key in the file, false if none (or forced)
+  bool find(const std::string& key, std::vector<int>& values) const;
+
+  //set a key, and write the file
+  void save(const std::string& key, const std::vector<int>& values);
+
+  //the best candidate, from the file, or by timing each with run, which
+  //returns seconds, or < 0 if the candidate cannot run
+  template <class F>
+  std::vector<int> tune(const std::string& key,
+                        const std::vector<std::vector<int> >& candidates, F run);
+
+  //key of what on a device
+  static std::string key(const char* what, const libj::GPU& gpu);
+
+  //seconds per run of queue, after a warm up run
+  template <class F>
+  static double time(cl_command_queue queue, F queue_run);
+};
+
+//--------------------------------------------------------------------------
+// constructor
+//--------------------------------------------------------------------------
+GPU_TUNER::GPU_TUNER()
+{
+  m_mode = 1;
+  const char* env = getenv("LIBJ_CL_TUNE");
+  if (env != NULL && strcmp(env,"0") == 0) {m_mode = 0;}
+  if (env != NULL && strcmp(env,"force") == 0) {m_mode = 2;}
+
+  const std::string dir = libj::GPU_PROGRAM::cache_dir();
+  if (!dir.empty()) {m_file = dir + "/tune.txt";}
+  m_read();
+}
+
+//--------------------------------------------------------------------------
+// m_read
+//	lines of a key and its values, lines that do not parse are skipped
+//--------------------------------------------------------------------------
+void GPU_TUNER::m_read()
+{
+  m_keys.clear();
+  m_values.clear();
+  if (m_file.empty()) return;
+  FILE* fp = fopen(m_file.c_str(),"r");
+  if (fp == NULL) return;
+  char line[1024];
+  while (fgets(line,sizeof(line),fp) != NULL)
+  {
+    char* save = NULL;
+    const char* tok = strtok_r(line," \t\n",&save);
+    if (tok == NULL) continue;
+    const std::string key = tok;
+    std::vector<int> values;
+    bool ok = true;
+    while ((tok = strtok_r(NULL," \t\n",&save)) != NULL && ok)
+    {
+      char* end;
+      const long v = strtol(tok,&end,10);
+      ok = (*end == '\0');
+      values.push_back((int) v);
+    }
+    if (!ok || values.empty()) continue;
+    const int pos = m_find(key);
+    if (pos < 0) {m_keys.push_back(key); m_values.push_back(values);}
+    else {m_values[pos] = values;}
+  }
+  fclose(fp);
+}
+
+//--------------------------------------------------------------------------
+// m_write
+//	failures are ignored, the tuning is just done again next time
+//--------------------------------------------------------------------------
+void GPU_TUNER::m_write() const
+{
+  if (m_file.empty()) return;
+  char tmp[64];
+  snprintf(tmp,64,".%ld.tmp",(long) getpid());
+  const std::string part = m_file + tmp;
+  FILE* fp = fopen(part.c_str(),"w");
+  if (fp == NULL) return;
+  bool ok = true;
+  for (size_t k=0;k<m_keys.size() && ok;k++)
+  {
+    ok = fprintf(fp,"%s",m_keys[k].c_str()) > 0;
+    for (size_t v=0;v<m_values[k].size() && ok;v++) {ok = fprintf(fp," %d",m_values[k][v]) > 0;}
+    ok = ok && fprintf(fp,"\n") > 0;
+  }
+  ok = (fclose(fp) == 0) && ok;
+  if (!ok || rename(part.c_str(),m_file.c_str()) != 0) {remove(part.c_str());}
+}
+
+//--------------------------------------------------------------------------
+// m_find
+//--------------------------------------------------------------------------
+int GPU_TUNER::m_find(const std::string& key) const
+{
+  for (size_t k=0;k<m_keys.size();k++) {if (m_keys[k] == key) return (int) k;}
+  return -1;
+}
+
+//--------------------------------------------------------------------------
+// find
+//--------------------------------------------------------------------------
+bool GPU_TUNER::find(const std::string& key, std::vector<int>& values) const
+{
+  const int pos = m_find(key);
+  if (pos < 0 || m_mode == 2) return false;
+  values = m_values[pos];
+  return true;
+}
+
+//--------------------------------------------------------------------------
+// save
+//	merged with what other jobs wrote since the file was read
+//--------------------------------------------------------------------------
+void GPU_TUNER::save(const std::string& key, const std::vector<int>& values)
+{
+  m_read();
+  const int pos = m_find(key);
+  if (pos < 0) {m_keys.push_back(key); m_values.push_back(values);}
+  else {m_values[pos] = values;}
+  m_write();
+}
+
+//--------------------------------------------------------------------------
+// tune
+//	a value from the file is only used if it is one of the candidates,
+//	so a changed candidate list is tuned again
+//--------------------------------------------------------------------------
+template <class F>
+std::vector<int> GPU_TUNER::tune(const std::string& key,
+                                 const std::vector<std::vector<int> >& candidates, F run)
+{
+  if (candidates.empty())
+  {
+    printf("ERROR libj::GPU_TUNER::tune %s has no candidates\n",key.c_str());
+    exit(1);
+  }
+  if (!enabled() || candidates.size() == 1) return candidates[0];
+
+  std::vector<int> values;
+  if (find(key,values))
+  {
+    for (size_t c=0;c<candidates.size();c++) {if (candidates[c] == values) return values;}
+  }
+
+  int best = -1;
+  double best_time = 0.0;
+  for (size_t c=0;c<candidates.size();c++)
+  {
+    const double t = run(candidates[c]);
+    if (t < 0.0) continue;
+    if (best < 0 || t < best_time) {best = (int) c; best_time = t;}
+  }
+  if (best < 0)
+  {
+    printf("ERROR libj::GPU_TUNER::tune no candidate of %s can run\n",key.c_str());
+    exit(1);
+  }
+  printf("libj::GPU_TUNER %s :",key.c_str());
+  for (size_t v=0;v<candidates[best].size();v++) {printf(" %d",candidates[best][v]);}
+  printf(" (%.3e s)\n",best_time);
+  save(key,candidates[best]);
+  return candidates[best];
+}
+
+//--------------------------------------------------------------------------
+// key
+//	what, and a 64 bit FNV-1a hash of the device name, version, and
+//	driver version
+//--------------------------------------------------------------------------
+std::string GPU_TUNER::key(const char* what, const libj::GPU& gpu)
+{
+  std::string id;
+  const cl_device_info info[3] = {CL_DEVICE_NAME,CL_DEVICE_VERSION,CL_DRIVER_VERSION};
+  for (int i=0;i<3;i++)
+  {
+    char str[256] = {0};
+    clGetDeviceInfo(gpu.device,info[i],sizeof(str)-1,str,NULL);
+    id += str;
+    id += '\0';
+  }
+  unsigned long long hash = 14695981039346656037ULL;
+  for (size_t c=0;c<id.size();c++)
+  {
+    hash ^= (unsigned char) id[c];
+    hash *= 1099511628211ULL;
+  }
+  char name[32];
+  snprintf(name,32,".%016llx",hash);
+  return std::string(what) + name;
+}
+
+//--------------------------------------------------------------------------
+// time
+//	wall time, so queues need no profiling
+//--------------------------------------------------------------------------
+template <class F>
+double GPU_TUNER::time(cl_command_queue queue, F queue_run)
+{
+  queue_run();
+  clFinish(queue);
+  struct timeval t0, t1;
+  gettimeofday(&t0,NULL);
+  for (int rep=0;rep<GPU_TUNE_REPS;rep++) {queue_run();}
+  clFinish(queue);
+  gettimeofday(&t1,NULL);
+  return ((t1.tv_sec - t0.tv_sec) + 1.0e-6*(t1.tv_usec - t0.tv_usec))/GPU_TUNE_REPS;
+}
+
+}//end libj namespace
+#endif
@@ -0,0 +1,925 @@
+/*--------------------------------------------------------------------------
+  gpu_vendor.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for the CUDA (LIBJ_CUDA) and HIP (LIBJ_HIP) backends, with the
+  interfaces of the OpenCL GPU, GPU_PROGRAM, GPU_KERNEL, and GPU_HANDLER,
+  in namespace libj::vendor. OpenCL stops at 1.2 on NVIDIA and is on its
+  way out of ROCm, and neither has the vendor BLAS, so here the gemm and
+  level-1 functions go to cuBLAS or rocBLAS.
+
+    OpenCL              CUDA / HIP
+    cl_mem              vgpu_mem, a device pointer on one GPU
+    command queue       stream (queue 0 is commands, add_queues for more)
+    program, kernel     NVRTC / hiprtc module and function of every GPU
+    tiled gemm kernel   cublas<t>gemm / rocblas_<t>gemm
+
+  The kernel sources of load_program are CUDA C (HIP takes the same), with
+  extern "C" __global__ kernels so the names are not mangled; the OpenCL C
+  sources of the other headers are not used here. set_arg and
+  queue_command are as OpenCL: each arg is a pointer to its value (for a
+  buffer, &mem.ptr), and the global sizes are work items, so the grid is
+  global/local (local is 256 if not given).
+
+  The two runtimes differ only in names, so each call below is a vgpu*
+  macro of one or the other. Build with -DLIBJ_CUDA and -lcudart -lcuda
+  -lnvrtc -lcublas, or with -DLIBJ_HIP and hipcc (-lhiprtc -lrocblas).
+  linal_gpu.hpp uses this handler when either is defined.
+
+  Usage
+  -------------------
+  libj::vendor::GPU_HANDLER GPU;
+  GPU.gemm<double>(false,M,N,K,1.0,A,B,0.0,C);           //host, one GPU
+  GPU.gemm<double>(false,M,N,K,1.0,A,B,0.0,C,GPU_ALL);   //split over all
+
+  libj::vendor::vgpu_mem dX = GPU.alloc(sizeof(double)*N), dY = ...;
+  GPU.axpy<double>(N,2.0,dX,dY);                         //on the device
+  double d = GPU.dot<double>(N,dX,dY);
+  GPU.release(dX);
+--------------------------------------------------------------------------*/
+#ifndef GPU_VENDOR_HPP
+#define GPU_VENDOR_HPP
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "gpu_include.h"
+
+#if defined (LIBJ_HIP)
+  #include <hip/hip_runtime.h>
+  #include <hip/hiprtc.h>
+  #include <rocblas/rocblas.h>
+
+  typedef hipError_t      vgpu_error;
+  typedef hipError_t      vgpu_drv_error;
+  typedef hipStream_t     vgpu_stream;
+  typedef hipModule_t     vgpu_module;
+  typedef hipFunction_t   vgpu_function;
+  typedef hipDeviceProp_t vgpu_prop;
+  typedef hiprtcProgram   vgpu_rtc;
+  typedef hiprtcResult    vgpu_rtc_error;
+  typedef rocblas_handle  vgpu_blas;
+  typedef rocblas_status  vgpu_blas_error;
+
+  #define vgpuSuccess               hipSuccess
+  #define vgpuDrvSuccess            hipSuccess
+  #define vgpuRtcSuccess            HIPRTC_SUCCESS
+  #define vgpuBlasSuccess           rocblas_status_success
+  #define vgpuMemcpyHostToDevice    hipMemcpyHostToDevice
+  #define vgpuMemcpyDeviceToHost    hipMemcpyDeviceToHost
+  #define vgpuMemcpyDeviceToDevice  hipMemcpyDeviceToDevice
+  #define vgpuInit                  hipInit
+  #define vgpuGetDeviceCount        hipGetDeviceCount
+  #define vgpuGetDeviceProperties   hipGetDeviceProperties
+  #define vgpuSetDevice             hipSetDevice
+  #define vgpuMalloc                hipMalloc
+  #define vgpuFree                  hipFree
+  #define vgpuMemcpyAsync           hipMemcpyAsync
+  #define vgpuMemcpy2DAsync         hipMemcpy2DAsync
+  #define vgpuMemsetAsync           hipMemsetAsync
+  #define vgpuStreamCreate          hipStreamCreate
+  #define vgpuStreamDestroy         hipStreamDestroy
+  #define vgpuStreamSynchronize     hipStreamSynchronize
+  #define vgpuGetErrorString        hipGetErrorString
+  #define vgpuModuleLoadData        hipModuleLoadData
+  #define vgpuModuleUnload          hipModuleUnload
+  #define vgpuModuleGetFunction     hipModuleGetFunction
+  #define vgpuLaunchKernel          hipModuleLaunchKernel
+  #define vgpuRtcCreateProgram      hiprtcCreateProgram
+  #define vgpuRtcCompileProgram     hiprtcCompileProgram
+  #define vgpuRtcGetProgramLogSize  hiprtcGetProgramLogSize
+  #define vgpuRtcGetProgramLog      hiprtcGetProgramLog
+  #define vgpuRtcGetCodeSize        hiprtcGetCodeSize
+  #define vgpuRtcGetCode            hiprtcGetCode
+  #define vgpuRtcDestroyProgram     hiprtcDestroyProgram
+  #define vgpuBlasCreate            rocblas_create_handle
+  #define vgpuBlasDestroy           rocblas_destroy_handle
+  #define vgpuBlasSetStream         rocblas_set_stream
+  #define vgpuBlasOpN               rocblas_operation_none
+  #define vgpuBlasOpT               rocblas_operation_transpose
+  #define vgpuBlasDgemm             rocblas_dgemm
+  #define vgpuBlasSgemm             rocblas_sgemm
+  #define vgpuBlasDaxpy             rocblas_daxpy
+  #define vgpuBlasSaxpy             rocblas_saxpy
+  #define vgpuBlasDscal             rocblas_dscal
+  #define vgpuBlasSscal             rocblas_sscal
+  #define vgpuBlasDcopy             rocblas_dcopy
+  #define vgpuBlasScopy             rocblas_scopy
+  #define vgpuBlasDdot              rocblas_ddot
+  #define vgpuBlasSdot              rocblas_sdot
+#else
+  #include <cuda.h>
+  #include <cuda_runtime.h>
+  #include <nvrtc.h>
+  #include <cublas_v2.h>
+
+  typedef cudaError_t     vgpu_error;
+  typedef CUresult        vgpu_drv_error;
+  typedef cudaStream_t    vgpu_stream;
+  typedef CUmodule        vgpu_module;
+  typedef CUfunction      vgpu_function;
+  typedef cudaDeviceProp  vgpu_prop;
+  typedef nvrtcProgram    vgpu_rtc;
+  typedef nvrtcResult     vgpu_rtc_error;
+  typedef cublasHandle_t  vgpu_blas;
+  typedef cublasStatus_t  vgpu_blas_error;
+
+  #define vgpuSuccess               cudaSuccess
+  #define vgpuDrvSuccess            CUDA_SUCCESS
+  #define vgpuRtcSuccess            NVRTC_SUCCESS
+  #define vgpuBlasSuccess           CUBLAS_STATUS_SUCCESS
+  #define vgpuMemcpyHostToDevice    cudaMemcpyHostToDevice
+  #define vgpuMemcpyDeviceToHost    cudaMemcpyDeviceToHost
+  #define vgpuMemcpyDeviceToDevice  cudaMemcpyDeviceToDevice
+  #define vgpuInit                  cuInit
+  #define vgpuGetDeviceCount        cudaGetDeviceCount
+  #define vgpuGetDeviceProperties   cudaGetDeviceProperties
+  #define vgpuSetDevice             cudaSetDevice
+  #define vgpuMalloc                cudaMalloc
+  #define vgpuFree                  cudaFree
+  #define vgpuMemcpyAsync           cudaMemcpyAsync
+  #define vgpuMemcpy2DAsync         cudaMemcpy2DAsync
+  #define vgpuMemsetAsync           cudaMemsetAsync
+  #define vgpuStreamCreate          cudaStreamCreate
+  #define vgpuStreamDestroy         cudaStreamDestroy
+  #define vgpuStreamSynchronize     cudaStreamSynchronize
+  #define vgpuGetErrorString        cudaGetErrorString
+  #define vgpuModuleLoadData        cuModuleLoadData
+  #define vgpuModuleUnload          cuModuleUnload
+  #define vgpuModuleGetFunction     cuModuleGetFunction
+  #define vgpuLaunchKernel          cuLaunchKernel
+  #define vgpuRtcCreateProgram      nvrtcCreateProgram
+  #define vgpuRtcCompileProgram     nvrtcCompileProgram
+  #define vgpuRtcGetProgramLogSize  nvrtcGetProgramLogSize
+  #define vgpuRtcGetProgramLog      nvrtcGetProgramLog
+  #define vgpuRtcGetCodeSize        nvrtcGetPTXSize
+  #define vgpuRtcGetCode            nvrtcGetPTX
+  #define vgpuRtcDestroyProgram     nvrtcDestroyProgram
+  #define vgpuBlasCreate            cublasCreate
+  #define vgpuBlasDestroy           cublasDestroy
+  #define vgpuBlasSetStream         cublasSetStream
+  #define vgpuBlasOpN               CUBLAS_OP_N
+  #define vgpuBlasOpT               CUBLAS_OP_T
+  #define vgpuBlasDgemm             cublasDgemm
+  #define vgpuBlasSgemm             cublasSgemm
+  #define vgpuBlasDaxpy             cublasDaxpy
+  #define vgpuBlasSaxpy             cublasSaxpy
+  #define vgpuBlasDscal             cublasDscal
+  #define vgpuBlasSscal             cublasSscal
+  #define vgpuBlasDcopy             cublasDcopy
+  #define vgpuBlasScopy             cublasScopy
+  #define vgpuBlasDdot              cublasDdot
+  #define vgpuBlasSdot              cublasSdot
+#endif
+
+namespace libj
+{
+namespace vendor
+{
+
+//a device buffer, the pointer is on one GPU
+struct vgpu_mem
+{
+  void* ptr;
+};
+
+//--------------------------------------------------------------------------
+// vgpu_check
+//	prints the error of a runtime, driver, rtc, or BLAS call and exits
+//--------------------------------------------------------------------------
+inline void vgpu_check(const vgpu_error err, const char* where)
+{
+  if (err == vgpuSuccess) return;
+  printf("ERROR libj::vendor::%s failed with %s\n",where,vgpuGetErrorString(err));
+  exit(1);
+}
+
+#if !defined (LIBJ_HIP)
+inline void vgpu_check(const vgpu_drv_error err, const char* where)
+{
+  if (err == vgpuDrvSuccess) return;
+  printf("ERROR libj::vendor::%s failed with driver code %d\n",where,(int) err);
+  exit(1);
+}
+#endif
+
+inline void vgpu_check(const vgpu_rtc_error err, const char* where)
+{
+  if (err == vgpuRtcSuccess) return;
+  printf("ERROR libj::vendor::%s failed with rtc code %d\n",where,(int) err);
+  exit(1);
+}
+
+inline void vgpu_check(const vgpu_blas_error err, const char* where)
+{
+  if (err == vgpuBlasSuccess) return;
+  printf("ERROR libj::vendor::%s failed with BLAS code %d\n",where,(int) err);
+  exit(1);
+}
+
+/*------------------------------------------------------------------------
+ vgpu_blas_t
+    the vendor BLAS of each type, column major, pointers on the device
+------------------------------------------------------------------------*/
+template <typename T> struct vgpu_blas_t {};
+template <> struct vgpu_blas_t<double>
+{
+  static vgpu_blas_error gemm(vgpu_blas h, const bool transA, const int M, const int N,
+                              const int K, const double* alpha, const double* A,
+                              const int lda, const double* B, const int ldb,
+                              const double* beta, double* C, const int ldc)
+  {
+    return vgpuBlasDgemm(h,transA ? vgpuBlasOpT : vgpuBlasOpN,vgpuBlasOpN,M,N,K,
+                         alpha,A,lda,B,ldb,beta,C,ldc);
+  }
+  static vgpu_blas_error axpy(vgpu_blas h, const int N, const double* A, const double* X, double* Y)
+  {
+    return vgpuBlasDaxpy(h,N,A,X,1,Y,1);
+  }
+  static vgpu_blas_error scal(vgpu_blas h, const int N, const double* A, double* X)
+  {
+    return vgpuBlasDscal(h,N,A,X,1);
+  }
+  static vgpu_blas_error copy(vgpu_blas h, const int N, const double* X, double* Y)
+  {
+    return vgpuBlasDcopy(h,N,X,1,Y,1);
+  }
+  static vgpu_blas_error dot(vgpu_blas h, const int N, const double* X, const double* Y, double* r)
+  {
+    return vgpuBlasDdot(h,N,X,1,Y,1,r);
+  }
+};
+template <> struct vgpu_blas_t<float>
+{
+  static vgpu_blas_error gemm(vgpu_blas h, const bool transA, const int M, const int N,
+                              const int K, const float* alpha, const float* A,
+                              const int lda, const float* B, const int ldb,
+                              const float* beta, float* C, const int ldc)
+  {
+    return vgpuBlasSgemm(h,transA ? vgpuBlasOpT : vgpuBlasOpN,vgpuBlasOpN,M,N,K,
+                         alpha,A,lda,B,ldb,beta,C,ldc);
+  }
+  static vgpu_blas_error axpy(vgpu_blas h, const int N, const float* A, const float* X, float* Y)
+  {
+    return vgpuBlasSaxpy(h,N,A,X,1,Y,1);
+  }
+  static vgpu_blas_error scal(vgpu_blas h, const int N, const float* A, float* X)
+  {
+    return vgpuBlasSscal(h,N,A,X,1);
+  }
+  static vgpu_blas_error copy(vgpu_blas h, const int N, const float* X, float* Y)
+  {
+    return vgpuBlasScopy(h,N,X,1,Y,1);
+  }
+  static vgpu_blas_error dot(vgpu_blas h, const int N, const float* X, const float* Y, float* r)
+  {
+    return vgpuBlasSdot(h,N,X,1,Y,1,r);
+  }
+};
+
+/*------------------------------------------------------------------------
+ GPU_PLATFORM
+    the devices of the runtime, all of them are used
+------------------------------------------------------------------------*/
+struct GPU_PLATFORM
+{
+  int num_gpu;
+  std::vector<int> devices;
+};
+
+class GPU_PROGRAM;
+class GPU_KERNEL;
+
+/*------------------------------------------------------------------------
+ GPU
+    one device, with its streams and BLAS handle
+------------------------------------------------------------------------*/
+struct GPU
+{
+  int           dev_num;
+  std::string   name;
+  unsigned long global_mem_size;
+  unsigned long local_mem_size;
+  int           max_compute_units;
+  size_t        max_work_group_size;
+  bool          supports_double;
+  bool          host_unified_memory;
+  std::string   arch;			//target of the rtc builds
+
+  vgpu_stream              commands;	//queue 0
+  std::vector<vgpu_stream> queues;	//queues 1,2,..., see add_queues
+  vgpu_blas                blas;	//on commands
+
+  void set_device(const int num);
+  void print_info() const;
+  void add_queues(const GPU_PLATFORM& platform, const int num);
+  vgpu_stream queue(const int q) const {return (q == 0) ? commands : queues[q-1];}
+  void queue_command(const GPU_KERNEL& kernel, const size_t work_dim,
+                     const size_t* global, const size_t* local, const int q = 0);
+};
+
+/*------------------------------------------------------------------------
+ GPU_PROGRAM
+    a CUDA C source, built into a module on every GPU
+------------------------------------------------------------------------*/
+class GPU_PROGRAM
+{
+  private:
+  std::string m_source;
+
+  public:
+  std::vector<vgpu_module> modules;	//of each GPU
+
+  void load(const GPU_PLATFORM& platform, const char* source);
+  void build(const GPU_PLATFORM& platform, const char* options);
+};
+
+/*------------------------------------------------------------------------
+ GPU_KERNEL
+    a function of a program on every GPU, and the values of its args
+------------------------------------------------------------------------*/
+class GPU_KERNEL
+{
+  public:
+  std::vector<vgpu_function>     functions;	//of each GPU
+  std::vector<std::vector<char> > args;
+
+  void create(const GPU_PROGRAM& program, const char* name);
+  void set_arg(const int arg_num, const size_t bytes, const void* value);
+};
+
+/*------------------------------------------------------------------------
+ GPU_HANDLER
+------------------------------------------------------------------------*/
+class GPU_HANDLER
+{
+  private:
+  void reserve(const int gpu, const int buf, const size_t bytes);
+  template <typename T>
+  void gemm_enqueue(const bool transA, const int M, const int N, const int K,
+                    const T ALPHA, const T* A, const T* B, const T BETA, T* C,
+                    const int gpu);
+
+  public:
+  GPU_PLATFORM        platform;
+  int                 num_gpu;
+  std::vector<GPU>    gpus;
+  GPU_PROGRAM         program;
+  std::vector<vgpu_mem> buffers;	//of add_buffer, with the GPU of each
+  std::vector<int>      buffer_gpu;
+
+  //the A, B, C buffers of the host gemm of each GPU, at [3*gpu + buf]
+  std::vector<vgpu_mem> gemm_buffer;
+  std::vector<size_t>   gemm_bytes;
+
+  GPU_HANDLER();
+  ~GPU_HANDLER();
+
+  int get_num_gpu() const {return (int) gpus.size();}
+  void print_gpu_info() const;
+  void split(const size_t n, const size_t block, std::vector<size_t>& offsets) const;
+  void add_queues(const int num, const bool out_of_order = false);
+  void finish(const int gpu);
+
+  //Program functions
+  void load_program(const char* source);
+
+  //Buffer functions, flags are not used (the pointer is copied if given)
+  int add_buffer(const unsigned long flags, const size_t bytes, void* pointer,
+                 const int gpu = 0);
+  void enqueue_write(const int buffer_id, const bool blocking, const size_t offset,
+                     const size_t size, const void* host_pointer, const int gpu = 0);
+  void enqueue_read(const int buffer_id, const bool blocking, const size_t offset,
+                    const size_t size, void* host_pointer, const int gpu = 0);
+  vgpu_mem alloc(const size_t bytes, const int gpu = 0);
+  void release(vgpu_mem& mem);
+
+  //GEMM functions, of host memory or device buffers
+  template <typename T>
+  void gemm(const bool transA, const int M, const int N, const int K,
+            const T ALPHA, const T* A, const T* B, const T BETA, T* C,
+            const int gpu = 0);
+  template <typename T>
+  void gemm(const bool transA, const int M, const int N, const int K,
+            const T ALPHA, const vgpu_mem A, const vgpu_mem B, const T BETA,
+            vgpu_mem C, const int gpu = 0);
+
+  //level-1 functions of device buffers, as simd.hpp
+  template <typename T>
+  void axpy(const long N, const T A, const vgpu_mem X, vgpu_mem Y, const int gpu = 0);
+  template <typename T>
+  void scal_mul(const long N, const T A, vgpu_mem X, const int gpu = 0);
+  template <typename T>
+  void zero(const long N, vgpu_mem X, const int gpu = 0);
+  template <typename T>
+  void copy(const long N, const vgpu_mem X, vgpu_mem Y, const int gpu = 0);
+  template <typename T>
+  T dot(const long N, const vgpu_mem X, const vgpu_mem Y, const int gpu = 0);
+};
+
+//--------------------------------------------------------------------------
+// GPU::set_device
+//	properties, stream 0, and the BLAS handle on it
+//--------------------------------------------------------------------------
+void GPU::set_device(const int num)
+{
+  dev_num = num;
+  vgpu_check(vgpuSetDevice(num),"GPU::set_device");
+  vgpu_prop prop;
+  vgpu_check(vgpuGetDeviceProperties(&prop,num),"GPU::set_device");
+  name                = prop.name;
+  global_mem_size     = (unsigned long) prop.totalGlobalMem;
+  local_mem_size      = (unsigned long) prop.sharedMemPerBlock;
+  max_compute_units   = prop.multiProcessorCount;
+  max_work_group_size = (size_t) prop.maxThreadsPerBlock;
+  supports_double     = true;
+  host_unified_memory = prop.integrated != 0;
+  #if defined (LIBJ_HIP)
+    arch = std::string("--offload-arch=") + prop.gcnArchName;
+  #else
+    arch = "--gpu-architecture=compute_" + std::to_string(prop.major) + std::to_string(prop.minor);
+  #endif
+
+  vgpu_check(vgpuStreamCreate(&commands),"GPU::set_device");
+  vgpu_check(vgpuBlasCreate(&blas),"GPU::set_device");
+  vgpu_check(vgpuBlasSetStream(blas,commands),"GPU::set_device");
+}
+
+//--------------------------------------------------------------------------
+// GPU::print_info
+//--------------------------------------------------------------------------
+void GPU::print_info() const
+{
+  printf("GPU #%d : %s\n",dev_num,name.c_str());
+  printf("  global memory      %lu bytes\n",global_mem_size);
+  printf("  shared memory      %lu bytes per block\n",local_mem_size);
+  printf("  compute units      %d\n",max_compute_units);
+  printf("  max threads        %lu per block\n",(unsigned long) max_work_group_size);
+  printf("  unified memory     %s\n",host_unified_memory ? "yes" : "no");
+}
+
+//--------------------------------------------------------------------------
+// GPU::add_queues
+//	num more streams
+//--------------------------------------------------------------------------
+void GPU::add_queues(const GPU_PLATFORM& platform, const int num)
+{
+  vgpu_check(vgpuSetDevice(dev_num),"GPU::add_queues");
+  for (int q=0;q<num;q++)
+  {
+    vgpu_stream s;
+    vgpu_check(vgpuStreamCreate(&s),"GPU::add_queues");
+    queues.push_back(s);
+  }
+}
+
+//--------------------------------------------------------------------------
+// GPU::queue_command
+//	launches the function of this GPU on stream q, with global work items
+//	in blocks of local (256 in x if not given)
+//--------------------------------------------------------------------------
+void GPU::queue_command(const GPU_KERNEL& kernel, const size_t work_dim,
+                        const size_t* global, const size_t* local, const int q)
+{
+  unsigned int grid[3] = {1,1,1}, block[3] = {1,1,1};
+  for (size_t d=0;d<work_dim && d<3;d++)
+  {
+    block[d] = (unsigned int) ((local != NULL) ? local[d] : ((d == 0) ? 256 : 1));
+    grid[d]  = (unsigned int) ((global[d] + block[d] - 1)/block[d]);
+  }
+  std::vector<void*> params(kernel.args.size());
+  for (size_t a=0;a<params.size();a++) {params[a] = (void*) kernel.args[a].data();}
+
+  vgpu_check(vgpuSetDevice(dev_num),"GPU::queue_command");
+  vgpu_check(vgpuLaunchKernel(kernel.functions[dev_num],grid[0],grid[1],grid[2],
+                              block[0],block[1],block[2],0,queue(q),
+                              params.data(),NULL),"GPU::queue_command");
+}
+
+//--------------------------------------------------------------------------
+// GPU_PROGRAM::load
+//--------------------------------------------------------------------------
+void GPU_PROGRAM::load(const GPU_PLATFORM& platform, const char* source)
+{
+  m_source = source;
+}
+
+//--------------------------------------------------------------------------
+// GPU_PROGRAM::build
+//	compiles the source for the arch of each GPU, with the options
+//	(split at spaces), and loads the module. The compile log is printed
+//	if it fails
+//--------------------------------------------------------------------------
+void GPU_PROGRAM::build(const GPU_PLATFORM& platform, const char* options)
+{
+  std::vector<std::string> opts;
+  if (options != NULL)
+  {
+    std::string word;
+    for (const char* c=options;;c++)
+    {
+      if (*c == ' ' || *c == '\0')
+      {
+        if (!word.empty()) {opts.push_back(word);}
+        word.clear();
+        if (*c == '\0') break;
+      }
+      else {word += *c;}
+    }
+  }
+
+  modules.assign(platform.num_gpu,(vgpu_module) 0);
+  for (int gpu=0;gpu<platform.num_gpu;gpu++)
+  {
+    vgpu_prop prop;
+    vgpu_check(vgpuGetDeviceProperties(&prop,platform.devices[gpu]),"GPU_PROGRAM::build");
+    #if defined (LIBJ_HIP)
+      const std::string arch = std::string("--offload-arch=") + prop.gcnArchName;
+    #else
+      const std::string arch = "--gpu-architecture=compute_" + std::to_string(prop.major) +
+                               std::to_string(prop.minor);
+    #endif
+    std::vector<const char*> argv(1,arch.c_str());
+    for (size_t o=0;o<opts.size();o++) {argv.push_back(opts[o].c_str());}
+
+    vgpu_rtc rtc;
+    vgpu_check(vgpuRtcCreateProgram(&rtc,m_source.c_str(),"libj",0,NULL,NULL),
+               "GPU_PROGRAM::build");
+    if (vgpuRtcCompileProgram(rtc,(int) argv.size(),argv.data()) != vgpuRtcSuccess)
+    {
+      size_t len = 0;
+      vgpuRtcGetProgramLogSize(rtc,&len);
+      std::vector<char> log(len + 1,'\0');
+      vgpuRtcGetProgramLog(rtc,log.data());
+      printf("Error libj::vendor::GPU_PROGRAM::build Failed to build program executable!\n");
+      printf("%s\n",log.data());
+      exit(1);
+    }
+    size_t bytes = 0;
+    vgpu_check(vgpuRtcGetCodeSize(rtc,&bytes),"GPU_PROGRAM::build");
+    std::vector<char> code(bytes);
+    vgpu_check(vgpuRtcGetCode(rtc,code.data()),"GPU_PROGRAM::build");
+    vgpuRtcDestroyProgram(&rtc);
+
+    vgpu_check(vgpuSetDevice(platform.devices[gpu]),"GPU_PROGRAM::build");
+    vgpu_check(vgpuModuleLoadData(&modules[gpu],code.data()),"GPU_PROGRAM::build");
+  }
+}
+
+//--------------------------------------------------------------------------
+// GPU_KERNEL::create
+//--------------------------------------------------------------------------
+void GPU_KERNEL::create(const GPU_PROGRAM& program, const char* name)
+{
+  functions.assign(program.modules.size(),(vgpu_function) 0);
+  for (size_t gpu=0;gpu<program.modules.size();gpu++)
+  {
+    vgpu_check(vgpuModuleGetFunction(&functions[gpu],program.modules[gpu],name),
+               "GPU_KERNEL::create");
+  }
+}
+
+//--------------------------------------------------------------------------
+// GPU_KERNEL::set_arg
+//	keeps a copy of the value, as clSetKernelArg
+//--------------------------------------------------------------------------
+void GPU_KERNEL::set_arg(const int arg_num, const size_t bytes, const void* value)
+{
+  if (arg_num < 0)
+  {
+    printf("ERROR libj::vendor::GPU_KERNEL::set_arg failed for arg #%d\n",arg_num);
+    exit(1);
+  }
+  if ((size_t) arg_num >= args.size()) {args.resize(arg_num + 1);}
+  args[arg_num].assign((const char*) value,(const char*) value + bytes);
+}
+
+//--------------------------------------------------------------------------
+// Constructor
+//	every device of the runtime, with stream 0 and a BLAS handle
+//--------------------------------------------------------------------------
+GPU_HANDLER::GPU_HANDLER()
+{
+  printf("Initializing %s enviroment\n",
+  #if defined (LIBJ_HIP)
+         "HIP");
+  #else
+         "CUDA");
+  #endif
+  vgpu_check(vgpuInit(0),"GPU_HANDLER");
+  int count = 0;
+  vgpu_check(vgpuGetDeviceCount(&count),"GPU_HANDLER");
+  if (count < 1)
+  {
+    printf("ERROR libj::vendor::GPU_HANDLER there are no GPUs\n");
+    exit(1);
+  }
+  count = std::min(count,MAX_NUM_GPU);
+  num_gpu = count;
+  platform.num_gpu = count;
+  gpus.resize(count);
+  for (int gpu=0;gpu<count;gpu++)
+  {
+    platform.devices.push_back(gpu);
+    gpus[gpu].set_device(gpu);
+  }
+  vgpu_mem none = {NULL};
+  gemm_buffer.assign(3*count,none);
+  gemm_bytes.assign(3*count,0);
+}
+
+//--------------------------------------------------------------------------
+// Destructor
+//--------------------------------------------------------------------------
+GPU_HANDLER::~GPU_HANDLER()
+{
+  for (size_t b=0;b<gemm_buffer.size();b++) {release(gemm_buffer[b]);}
+  for (size_t b=0;b<buffers.size();b++) {release(buffers[b]);}
+  for (int gpu=0;gpu<get_num_gpu();gpu++)
+  {
+    vgpuSetDevice(gpu);
+    vgpuBlasDestroy(gpus[gpu].blas);
+    vgpuStreamDestroy(gpus[gpu].commands);
+    for (size_t q=0;q<gpus[gpu].queues.size();q++) {vgpuStreamDestroy(gpus[gpu].queues[q]);}
+  }
+}
+
+//--------------------------------------------------------------------------
+// print_gpu_info
+//--------------------------------------------------------------------------
+void GPU_HANDLER::print_gpu_info() const
+{
+  printf("Printing information about GPU(s)\n");
+  printf("There are %d gpus \n",get_num_gpu());
+  for (int gpu=0;gpu<get_num_gpu();gpu++) {gpus[gpu].print_info();}
+}
+
+//--------------------------------------------------------------------------
+// split
+//	as the OpenCL GPU_HANDLER, by compute units
+//--------------------------------------------------------------------------
+void GPU_HANDLER::split(const size_t n, const size_t block,
+                        std::vector<size_t>& offsets) const
+{
+  const int ngpu = get_num_gpu();
+  double units = 0;
+  for (int gpu=0;gpu<ngpu;gpu++) {units += gpus[gpu].max_compute_units;}
+  const size_t nblock = (n + block - 1)/block;
+  offsets.assign(ngpu+1,0);
+  double sum = 0;
+  for (int gpu=0;gpu<ngpu-1;gpu++)
+  {
+    sum += gpus[gpu].max_compute_units;
+    offsets[gpu+1] = std::min(n,block*(size_t) ((nblock*sum + units/2)/units));
+  }
+  offsets[ngpu] = n;
+}
+
+//--------------------------------------------------------------------------
+// add_queues
+//	num more streams on every GPU, streams are always out of order with
+//	each other
+//--------------------------------------------------------------------------
+void GPU_HANDLER::add_queues(const int num, const bool out_of_order)
+{
+  for (int gpu=0;gpu<get_num_gpu();gpu++) {gpus[gpu].add_queues(platform,num);}
+}
+
+//--------------------------------------------------------------------------
+// finish
+//	waits for the streams of one GPU, or all of them
+//--------------------------------------------------------------------------
+void GPU_HANDLER::finish(const int gpu)
+{
+  for (int dev=0;dev<get_num_gpu();dev++)
+  {
+    if (gpu != GPU_ALL && gpu != dev) continue;
+    vgpu_check(vgpuSetDevice(dev),"GPU_HANDLER::finish");
+    vgpu_check(vgpuStreamSynchronize(gpus[dev].commands),"GPU_HANDLER::finish");
+    for (size_t q=0;q<gpus[dev].queues.size();q++)
+    {
+      vgpu_check(vgpuStreamSynchronize(gpus[dev].queues[q]),"GPU_HANDLER::finish");
+    }
+  }
+}
+
+//--------------------------------------------------------------------------
+// load_program
+//--------------------------------------------------------------------------
+void GPU_HANDLER::load_program(const char* source)
+{
+  program.load(platform,source);
+  program.build(platform,NULL);
+}
+
+//--------------------------------------------------------------------------
+// alloc, release
+//--------------------------------------------------------------------------
+vgpu_mem GPU_HANDLER::alloc(const size_t bytes, const int gpu)
+{
+  vgpu_mem mem = {NULL};
+  vgpu_check(vgpuSetDevice(gpu),"GPU_HANDLER::alloc");
+  vgpu_check(vgpuMalloc(&mem.ptr,std::max(bytes,(size_t) 1)),"GPU_HANDLER::alloc");
+  return mem;
+}
+
+void GPU_HANDLER::release(vgpu_mem& mem)
+{
+  if (mem.ptr != NULL) {vgpuFree(mem.ptr);}
+  mem.ptr = NULL;
+}
+
+//--------------------------------------------------------------------------
+// add_buffer
+//	returns the number of buffers, so buffer_id is that-1, as OpenCL
+//--------------------------------------------------------------------------
+int GPU_HANDLER::add_buffer(const unsigned long flags, const size_t bytes,
+                            void* pointer, const int gpu)
+{
+  const vgpu_mem mem = alloc(bytes,gpu);
+  if (pointer != NULL)
+  {
+    vgpu_check(vgpuMemcpyAsync(mem.ptr,pointer,bytes,vgpuMemcpyHostToDevice,
+                               gpus[gpu].commands),"GPU_HANDLER::add_buffer");
+    finish(gpu);
+  }
+  buffers.push_back(mem);
+  buffer_gpu.push_back(gpu);
+  return (int) buffers.size();
+}
+
+//--------------------------------------------------------------------------
+// enqueue_write, enqueue_read
+//	on stream 0 of gpu, which must be the GPU of the buffer
+//--------------------------------------------------------------------------
+void GPU_HANDLER::enqueue_write(const int buffer_id, const bool blocking,
+                                const size_t offset, const size_t size,
+                                const void* host_pointer, const int gpu)
+{
+  vgpu_check(vgpuSetDevice(buffer_gpu[buffer_id]),"GPU_HANDLER::enqueue_write");
+  vgpu_check(vgpuMemcpyAsync((char*) buffers[buffer_id].ptr + offset,host_pointer,size,
+                             vgpuMemcpyHostToDevice,gpus[gpu].commands),
+             "GPU_HANDLER::enqueue_write");
+  if (blocking) {finish(gpu);}
+}
+
+void GPU_HANDLER::enqueue_read(const int buffer_id, const bool blocking,
+                               const size_t offset, const size_t size,
+                               void* host_pointer, const int gpu)
+{
+  vgpu_check(vgpuSetDevice(buffer_gpu[buffer_id]),"GPU_HANDLER::enqueue_read");
+  vgpu_check(vgpuMemcpyAsync(host_pointer,(const char*) buffers[buffer_id].ptr + offset,size,
+                             vgpuMemcpyDeviceToHost,gpus[gpu].commands),
+             "GPU_HANDLER::enqueue_read");
+  if (blocking) {finish(gpu);}
+}
+
+//--------------------------------------------------------------------------
+// reserve
+//	grow a gemm buffer of a GPU to at least bytes
+//--------------------------------------------------------------------------
+void GPU_HANDLER::reserve(const int gpu, const int buf, const size_t bytes)
+{
+  const int id = 3*gpu + buf;
+  if (bytes <= gemm_bytes[id]) return;
+  finish(gpu);
+  release(gemm_buffer[id]);
+  gemm_buffer[id] = alloc(bytes,gpu);
+  gemm_bytes[id] = bytes;
+}
+
+//--------------------------------------------------------------------------
+// gemm
+//	C = ALPHA*op(A).B + BETA*C for host memory, on one GPU or split over
+//	the columns of B and C on GPU_ALL. Every GPU is queued before any is
+//	waited on
+//--------------------------------------------------------------------------
+template <typename T>
+void GPU_HANDLER::gemm(const bool transA, const int M, const int N, const int K,
+                       const T ALPHA, const T* A, const T* B, const T BETA, T* C,
+                       const int gpu)
+{
+  if (M <= 0 || N <= 0) return;
+  if (gpu != GPU_ALL || get_num_gpu() == 1)
+  {
+    const int dev = (gpu == GPU_ALL) ? 0 : gpu;
+    gemm_enqueue<T>(transA,M,N,K,ALPHA,A,B,BETA,C,dev);
+    finish(dev);
+    return;
+  }
+  std::vector<size_t> offsets;
+  split((size_t) N,64,offsets);
+  for (int dev=0;dev<get_num_gpu();dev++)
+  {
+    const size_t n0 = offsets[dev];
+    const int    nn = (int) (offsets[dev+1] - n0);
+    if (nn == 0) continue;
+    gemm_enqueue<T>(transA,M,nn,K,ALPHA,A,B + n0*K,BETA,C + n0*M,dev);
+  }
+  finish(GPU_ALL);
+}
+
+//--------------------------------------------------------------------------
+// gemm_enqueue
+//	copies A, B (and C if BETA is not zero) up, queues the vendor gemm,
+//	and C back, on stream 0 of a GPU, without waiting
+//--------------------------------------------------------------------------
+template <typename T>
+void GPU_HANDLER::gemm_enqueue(const bool transA, const int M, const int N,
+                               const int K, const T ALPHA, const T* A,
+                               const T* B, const T BETA, T* C, const int gpu)
+{
+  const size_t bytes[3] = {sizeof(T)*M*K,sizeof(T)*K*N,sizeof(T)*M*N};
+  const void* host[3] = {A,B,C};
+  const int nbuf = (BETA == (T) 0) ? 2 : 3;
+  for (int buf=0;buf<3;buf++) {reserve(gpu,buf,bytes[buf]);}
+  vgpu_check(vgpuSetDevice(gpu),"GPU_HANDLER::gemm");
+  for (int buf=0;buf<nbuf;buf++)
+  {
+    if (bytes[buf] == 0) continue;
+    vgpu_check(vgpuMemcpyAsync(gemm_buffer[3*gpu+buf].ptr,host[buf],bytes[buf],
+                               vgpuMemcpyHostToDevice,gpus[gpu].commands),"GPU_HANDLER::gemm");
+  }
+  const int lda = std::max(1,transA ? K : M);
+  vgpu_check(vgpu_blas_t<T>::gemm(gpus[gpu].blas,transA,M,N,K,&ALPHA,
+                                  (const T*) gemm_buffer[3*gpu].ptr,lda,
+                                  (const T*) gemm_buffer[3*gpu+1].ptr,std::max(1,K),&BETA,
+                                  (T*) gemm_buffer[3*gpu+2].ptr,M),"GPU_HANDLER::gemm");
+  vgpu_check(vgpuMemcpyAsync(C,gemm_buffer[3*gpu+2].ptr,bytes[2],vgpuMemcpyDeviceToHost,
+                             gpus[gpu].commands),"GPU_HANDLER::gemm");
+}
+
+//--------------------------------------------------------------------------
+// gemm
+//	as above, for dense column major device buffers on gpu, queued on
+//	its stream 0
+//--------------------------------------------------------------------------
+template <typename T>
+void GPU_HANDLER::gemm(const bool transA, const int M, const int N, const int K,
+                       const T ALPHA, const vgpu_mem A, const vgpu_mem B, const T BETA,
+                       vgpu_mem C, const int gpu)
+{
+  if (M <= 0 || N <= 0) return;
+  vgpu_check(vgpuSetDevice(gpu),"GPU_HANDLER::gemm");
+  vgpu_check(vgpu_blas_t<T>::gemm(gpus[gpu].blas,transA,M,N,K,&ALPHA,(const T*) A.ptr,
+                                  std::max(1,transA ? K : M),(const T*) B.ptr,std::max(1,K),
+                                  &BETA,(T*) C.ptr,M),"GPU_HANDLER::gemm");
+}
+
+//--------------------------------------------------------------------------
+// level-1 functions
+//	vendor BLAS on stream 0 of gpu, dot waits for the result
+//--------------------------------------------------------------------------
+template <typename T>
+void GPU_HANDLER::axpy(const long N, const T A, const vgpu_mem X, vgpu_mem Y, const int gpu)
+{
+  if (N <= 0) return;
+  vgpu_check(vgpuSetDevice(gpu),"GPU_HANDLER::axpy");
+  vgpu_check(vgpu_blas_t<T>::axpy(gpus[gpu].blas,(int) N,&A,(const T*) X.ptr,(T*) Y.ptr),
+             "GPU_HANDLER::axpy");
+}
+
+template <typename T>
+void GPU_HANDLER::scal_mul(const long N, const T A, vgpu_mem X, const int gpu)
+{
+  if (N <= 0) return;
+  vgpu_check(vgpuSetDevice(gpu),"GPU_HANDLER::scal_mul");
+  vgpu_check(vgpu_blas_t<T>::scal(gpus[gpu].blas,(int) N,&A,(T*) X.ptr),"GPU_HANDLER::scal_mul");
+}
+
+template <typename T>
+void GPU_HANDLER::zero(const long N, vgpu_mem X, const int gpu)
+{
+  if (N <= 0) return;
+  vgpu_check(vgpuSetDevice(gpu),"GPU_HANDLER::zero");
+  vgpu_check(vgpuMemsetAsync(X.ptr,0,sizeof(T)*N,gpus[gpu].commands),"GPU_HANDLER::zero");
+}
+
+template <typename T>
+void GPU_HANDLER::copy(const long N, const vgpu_mem X, vgpu_mem Y, const int gpu)
+{
+  if (N <= 0) return;
+  vgpu_check(vgpuSetDevice(gpu),"GPU_HANDLER::copy");
+  vgpu_check(vgpuMemcpyAsync(Y.ptr,X.ptr,sizeof(T)*N,vgpuMemcpyDeviceToDevice,
+                             gpus[gpu].commands),"GPU_HANDLER::copy");
+}
+
+template <typename T>
+T GPU_HANDLER::dot(const long N, const vgpu_mem X, const vgpu_mem Y, const int gpu)
+{
+  T r = (T) 0;
+  if (N <= 0) return r;
+  vgpu_check(vgpuSetDevice(gpu),"GPU_HANDLER::dot");
+  vgpu_check(vgpu_blas_t<T>::dot(gpus[gpu].blas,(int) N,(const T*) X.ptr,(const T*) Y.ptr,&r),
+             "GPU_HANDLER::dot");
+  finish(gpu);
+  return r;
+}
+
+}//end vendor namespace
+}//end libj namespace
+
+#endif
@@ -0,0 +1,454 @@
+/*--------------------------------------------------------------------------
+  jblis_gpu.hpp
+	JHT, October 14, 2026 : created
+	JHT, October 14, 2026 : hybrid contract
+
+  .hpp file of the GPU versions of the jblis permute and contract, with
+  the same index labels (see jblis_level1.hpp and jblis_level3.hpp). jblis
+  itself has no OpenCL, this is where the two meet.
+
+    gpu_permute      : B(idxB) = alpha*A(idxA) + beta*B(idxB)
+    gpu_contract     : C = alpha*A.B + beta*C
+    gpu_contract_hybrid : contract on the GPUs and the host at once
+    contract_offload : contract on the host or the GPU, see below
+
+  The contraction is done as a TTGT on the GPU: A is permuted into an M x K
+  matrix, B into K x N, and C into M x N (only if beta is not zero), with
+  the tiled transpose of GPU_HANDLER::permute, the gemm kernel does the
+  product, and C is permuted back. A tensor that is already in that order
+  is not permuted. The bundles M, N, and K are as in the host contract,
+  labels in A and C, B and C, and A and B, with M and N in the order of
+  C, and K in the order of A.
+
+  For device_tensors, everything stays on the GPU of C. The host tensor
+  versions must be sequential, and copy A, B (and C if beta is not zero)
+  up, and C down, so they only pay for products that are large compared
+  to the tensors. Temporaries are made for every call.
+
+  gpu_contract_hybrid does the TTGT on the host, and the gemm with
+  GPU_HANDLER::gemm_hybrid, so tiles of C go to every GPU and to the host
+  gemm (linal_ABpC) at once, balanced by their measured flops/s. It is
+  for products large enough that the host would otherwise sit idle in 
+  clFinish.
+
+  contract_offload picks the side with where:
+
+    JBLIS_HOST : libj::contract
+    JBLIS_GPU  : gpu_contract
+    JBLIS_AUTO : the GPU if the tensors are sequential, there are at
+                 least JBLIS_GPU_MIN_FLOPS, and at least 
+                 JBLIS_GPU_MIN_INTENSITY flops per byte copied, else the
+                 host
+    JBLIS_HYBRID : gpu_contract_hybrid
+
+  Only double and float have GPU kernels.
+
+  Usage
+  -------------------
+  libj::device_tensor<double> A(GPU,o,o,v,v), B(GPU,v,v,v,v), C(GPU,o,o,v,v);
+  libj::gpu_contract(1.0,A,"ijab",B,"abcd",0.0,C,"ijcd");
+  libj::gpu_permute(C,"ijcd",A,"jidc");
+
+  libj::contract_offload(GPU,libj::JBLIS_AUTO,1.0,hA,"ijab",hB,"abcd",0.0,hC,"ijcd");
+--------------------------------------------------------------------------*/
+#ifndef JBLIS_GPU_HPP
+#define JBLIS_GPU_HPP
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#ifdef __APPLE__
+  #include <OpenCL/opencl.h>
+#else
+  #include <CL/cl.h>
+#endif
+
+#include "tensor.hpp"
+#include "gpu_handler.hpp"
+#include "device_tensor.hpp"
+#include "jblis_level3.hpp"
+#include "jblis_level1.hpp"
+#include "linal_ABpC.hpp"
+
+//smallest contraction (2*M*N*K) that JBLIS_AUTO sends to the GPU
+#if !defined (JBLIS_GPU_MIN_FLOPS)
+  #define JBLIS_GPU_MIN_FLOPS 1.0e9
+#endif
+
+//smallest flops per byte copied over the bus for JBLIS_AUTO
+#if !defined (JBLIS_GPU_MIN_INTENSITY)
+  #define JBLIS_GPU_MIN_INTENSITY 16.0
+#endif
+
+namespace libj
+{
+
+//where contract_offload runs
+enum jblis_offload {JBLIS_HOST = 0, JBLIS_GPU, JBLIS_AUTO, JBLIS_HYBRID};
+
+/*------------------------------------------------------------------------
+ jblis_gpu_bundles
+    the M, N, and K bundles of a contraction, and their sizes
+------------------------------------------------------------------------*/
+struct jblis_gpu_bundles
+{
+  std::string M, N, K;
+  size_t m, n, k;
+};
+
+//--------------------------------------------------------------------------
+// jblis_gpu_length
+//	length of label c in a tensor with labels idx and lengths len, 0 if
+//	the label is not there
+//--------------------------------------------------------------------------
+inline size_t jblis_gpu_length(const char c, const std::string& idx,
+                               const std::vector<size_t>& len)
+{
+  const size_t pos = idx.find(c);
+  return (pos == std::string::npos) ? 0 : len[pos];
+}
+
+//--------------------------------------------------------------------------
+// jblis_gpu_split
+//	finds the bundles, and checks the labels and lengths, as the host
+//	contract
+//--------------------------------------------------------------------------
+inline void jblis_gpu_split(const std::string& idxA, const std::vector<size_t>& lenA,
+                            const std::string& idxB, const std::vector<size_t>& lenB,
+                            const std::string& idxC, const std::vector<size_t>& lenC,
+                            jblis_gpu_bundles& bun)
+{
+  if (idxA.size() != lenA.size() || idxB.size() != lenB.size() || idxC.size() != lenC.size())
+  {
+    printf("ERROR libj::gpu_contract the number of labels and dimensions differ\n");
+    exit(1);
+  }
+  bun.M.clear(); bun.N.clear(); bun.K.clear();
+  bun.m = 1; bun.n = 1; bun.k = 1;
+  for (size_t d=0;d<idxC.size();d++)
+  {
+    const char c = idxC[d];
+    const bool inA = (idxA.find(c) != std::string::npos);
+    const bool inB = (idxB.find(c) != std::string::npos);
+    if (inA == inB || idxC.find(c) != d ||
+        (inA ? jblis_gpu_length(c,idxA,lenA) : jblis_gpu_length(c,idxB,lenB)) != lenC[d])
+    {
+      printf("ERROR libj::gpu_contract label %c of C must be in one of A or B, once, "
+             "with the same length\n",c);
+      exit(1);
+    }
+    if (inA) {bun.M += c; bun.m *= lenC[d];}
+    else     {bun.N += c; bun.n *= lenC[d];}
+  }
+  for (size_t d=0;d<idxA.size();d++)
+  {
+    const char c = idxA[d];
+    if (idxA.find(c) != d)
+    {
+      printf("ERROR libj::gpu_contract label %c is repeated in A\n",c);
+      exit(1);
+    }
+    if (idxC.find(c) != std::string::npos) continue;
+    if (idxB.find(c) == std::string::npos || jblis_gpu_length(c,idxB,lenB) != lenA[d])
+    {
+      printf("ERROR libj::gpu_contract label %c of A must be in B or C, "
+             "with the same length\n",c);
+      exit(1);
+    }
+    bun.K += c; bun.k *= lenA[d];
+  }
+  for (size_t d=0;d<idxB.size();d++)
+  {
+    const char c = idxB[d];
+    if (idxB.find(c) != d || (idxA.find(c) == std::string::npos &&
+                              idxC.find(c) == std::string::npos))
+    {
+      printf("ERROR libj::gpu_contract label %c of B is repeated, or not in A or C\n",c);
+      exit(1);
+    }
+  }
+}
+
+//--------------------------------------------------------------------------
+// jblis_gpu_reorder
+//	B = alpha*A + beta*B on the GPU, where A is dense with labels idxA and
+//	lengths lenA, and B is dense with the same labels in the order idxB
+//--------------------------------------------------------------------------
+template <typename T>
+void jblis_gpu_reorder(libj::GPU_HANDLER& gpu, const cl_mem A, const std::string& idxA,
+                       const std::vector<size_t>& lenA, cl_mem B,
+                       const std::string& idxB, const T alpha, const T beta,
+                       const int dev)
+{
+  const int nd = (int) idxA.size();
+  std::vector<long> strA(nd), strB(nd), denseB(nd);
+  long str = 1;
+  for (int d=0;d<nd;d++) {strA[d] = str; str *= (long) lenA[d];}
+  str = 1;
+  for (int d=0;d<nd;d++)
+  {
+    denseB[d] = str;
+    str *= (long) jblis_gpu_length(idxB[d],idxA,lenA);
+  }
+  for (int d=0;d<nd;d++) {strB[d] = denseB[idxB.find(idxA[d])];}
+  gpu.template permute<T>(nd,lenA.data(),strA.data(),A,strB.data(),B,alpha,beta,dev);
+}
+
+//--------------------------------------------------------------------------
+// jblis_gpu_temp
+//	a device buffer of n elements, released by the caller
+//--------------------------------------------------------------------------
+template <typename T>
+cl_mem jblis_gpu_temp(libj::GPU_HANDLER& gpu, const size_t n)
+{
+  gpu.init();
+  cl_int err;
+  cl_mem buf = clCreateBuffer(gpu.platform.context,CL_MEM_READ_WRITE,
+                              sizeof(T)*std::max(n,(size_t) 1),NULL,&err);
+  if (err != CL_SUCCESS)
+  {
+    printf("ERROR libj::gpu_contract could not make a buffer of %lu bytes, code %d \n",
+           (unsigned long) (sizeof(T)*n),err);
+    exit(1);
+  }
+  return buf;
+}
+
+//--------------------------------------------------------------------------
+// gpu_contract
+//	C = alpha*A.B + beta*C for dense column major device buffers, with
+//	the lengths of each tensor, on GPU dev. C is not read if beta is zero
+//--------------------------------------------------------------------------
+template <typename T>
+void gpu_contract(libj::GPU_HANDLER& gpu, const T alpha,
+                  const cl_mem A, const std::string& idxA, const std::vector<size_t>& lenA,
+                  const cl_mem B, const std::string& idxB, const std::vector<size_t>& lenB,
+                  const T beta,
+                  cl_mem C, const std::string& idxC, const std::vector<size_t>& lenC,
+                  const int dev = 0)
+{
+  jblis_gpu_bundles bun;
+  jblis_gpu_split(idxA,lenA,idxB,lenB,idxC,lenC,bun);
+  if (bun.m*bun.n == 0) return;
+
+  const std::string orderA = bun.M + bun.K;
+  const std::string orderB = bun.K + bun.N;
+  const std::string orderC = bun.M + bun.N;
+  cl_mem a = A, b = B, c = C;
+  if (idxA != orderA && bun.m*bun.k > 0)
+  {
+    a = jblis_gpu_temp<T>(gpu,bun.m*bun.k);
+    jblis_gpu_reorder<T>(gpu,A,idxA,lenA,a,orderA,(T) 1,(T) 0,dev);
+  }
+  if (idxB != orderB && bun.k*bun.n > 0)
+  {
+    b = jblis_gpu_temp<T>(gpu,bun.k*bun.n);
+    jblis_gpu_reorder<T>(gpu,B,idxB,lenB,b,orderB,(T) 1,(T) 0,dev);
+  }
+  if (idxC != orderC)
+  {
+    c = jblis_gpu_temp<T>(gpu,bun.m*bun.n);
+    if (beta != (T) 0) {jblis_gpu_reorder<T>(gpu,C,idxC,lenC,c,orderC,(T) 1,(T) 0,dev);}
+  }
+
+  if (bun.k == 0 && beta == (T) 0) {gpu.template zero<T>((long) (bun.m*bun.n),c,dev);}
+  else if (bun.k == 0) {gpu.template scal_mul<T>((long) (bun.m*bun.n),beta,c,dev);}
+  else
+  {
+    gpu.template gemm<T>(false,(int) bun.m,(int) bun.n,(int) bun.k,alpha,a,b,beta,c,dev);
+  }
+
+  if (c != C)
+  {
+    std::vector<size_t> lenMN;
+    for (size_t d=0;d<orderC.size();d++) {lenMN.push_back(jblis_gpu_length(orderC[d],idxC,lenC));}
+    jblis_gpu_reorder<T>(gpu,c,orderC,lenMN,C,idxC,(T) 1,(T) 0,dev);
+  }
+
+  //the commands that use them are queued, so OpenCL frees them after
+  if (a != A) {clReleaseMemObject(a);}
+  if (b != B) {clReleaseMemObject(b);}
+  if (c != C) {clReleaseMemObject(c);}
+}
+
+//--------------------------------------------------------------------------
+// jblis_gpu_lengths
+//--------------------------------------------------------------------------
+template <class Tensor>
+std::vector<size_t> jblis_gpu_lengths(const Tensor& A)
+{
+  std::vector<size_t> len(A.dim());
+  for (size_t d=0;d<A.dim();d++) {len[d] = A.size(d);}
+  return len;
+}
+
+//--------------------------------------------------------------------------
+// gpu_contract
+//	for device_tensors, on the GPU of C. Only C is written, and it is not
+//	copied up if beta is zero
+//--------------------------------------------------------------------------
+template <typename T>
+void gpu_contract(const T alpha, libj::device_tensor<T>& A, const std::string& idxA,
+                  libj::device_tensor<T>& B, const std::string& idxB,
+                  const T beta, libj::device_tensor<T>& C, const std::string& idxC)
+{
+  if (A.device() != C.device() || B.device() != C.device())
+  {
+    printf("ERROR libj::gpu_contract the tensors are on different GPUs\n");
+    exit(1);
+  }
+  const cl_mem a = A.buffer_read();
+  const cl_mem b = B.buffer_read();
+  cl_mem c = (beta == (T) 0) ? C.buffer_write() : C.buffer();
+  gpu_contract<T>(C.gpu(),alpha,a,idxA,jblis_gpu_lengths(A),b,idxB,jblis_gpu_lengths(B),
+                  beta,c,idxC,jblis_gpu_lengths(C),C.device());
+}
+
+//--------------------------------------------------------------------------
+// gpu_contract
+//	for sequential host tensors, on GPU dev. A and B are only read, the
+//	const_cast is for the mirrors
+//--------------------------------------------------------------------------
+template <typename T>
+void gpu_contract(libj::GPU_HANDLER& gpu, const T alpha,
+                  const libj::tensor<T>& A, const std::string& idxA,
+                  const libj::tensor<T>& B, const std::string& idxB,
+                  const T beta, libj::tensor<T>& C, const std::string& idxC,
+                  const int dev = 0)
+{
+  libj::device_tensor<T> dA(gpu,const_cast<libj::tensor<T>&>(A),dev);
+  libj::device_tensor<T> dB(gpu,const_cast<libj::tensor<T>&>(B),dev);
+  libj::device_tensor<T> dC(gpu,C,dev);
+  gpu_contract<T>(alpha,dA,idxA,dB,idxB,beta,dC,idxC);
+  dC.to_host();
+}
+
+//--------------------------------------------------------------------------
+// gpu_permute
+//	B(idxB) = alpha*A(idxA) + beta*B(idxB) for device_tensors, on the GPU
+//	of B. B is not copied up if beta is zero
+//--------------------------------------------------------------------------
+template <typename T>
+void gpu_permute(libj::device_tensor<T>& A, const std::string& idxA,
+                 libj::device_tensor<T>& B, const std::string& idxB,
+                 const T alpha = (T) 1, const T beta = (T) 0)
+{
+  const std::vector<size_t> lenA = jblis_gpu_lengths(A);
+  const std::vector<size_t> lenB = jblis_gpu_lengths(B);
+  bool ok = (A.device() == B.device() && idxA.size() == lenA.size() &&
+             idxB.size() == lenB.size() && idxA.size() == idxB.size());
+  for (size_t d=0;d<idxA.size() && ok;d++)
+  {
+    ok = (idxA.find(idxA[d]) == d && jblis_gpu_length(idxA[d],idxB,lenB) == lenA[d]);
+  }
+  if (!ok)
+  {
+    printf("ERROR libj::gpu_permute the labels or lengths of A and B do not match\n");
+    exit(1);
+  }
+  const cl_mem a = A.buffer_read();
+  cl_mem b = (beta == (T) 0) ? B.buffer_write() : B.buffer();
+  jblis_gpu_reorder<T>(B.gpu(),a,idxA,lenA,b,idxB,alpha,beta,B.device());
+}
+
+//--------------------------------------------------------------------------
+// gpu_permute
+//	for sequential host tensors, on GPU dev
+//--------------------------------------------------------------------------
+template <typename T>
+void gpu_permute(libj::GPU_HANDLER& gpu, const libj::tensor<T>& A, const std::string& idxA,
+                 libj::tensor<T>& B, const std::string& idxB,
+                 const T alpha = (T) 1, const T beta = (T) 0, const int dev = 0)
+{
+  libj::device_tensor<T> dA(gpu,const_cast<libj::tensor<T>&>(A),dev);
+  libj::device_tensor<T> dB(gpu,B,dev);
+  gpu_permute<T>(dA,idxA,dB,idxB,alpha,beta);
+  dB.to_host();
+}
+
+//--------------------------------------------------------------------------
+// gpu_contract_hybrid
+//	for host tensors (any strides), with A, B, and C permuted on the 
+//	host into M x K, K x N, and M x N matrices unless they already are
+//	dense in that order
+//--------------------------------------------------------------------------
+template <typename T>
+void gpu_contract_hybrid(libj::GPU_HANDLER& gpu, const T alpha,
+                         const libj::tensor<T>& A, const std::string& idxA,
+                         const libj::tensor<T>& B, const std::string& idxB,
+                         const T beta, libj::tensor<T>& C, const std::string& idxC)
+{
+  jblis_gpu_bundles bun;
+  jblis_gpu_split(idxA,jblis_gpu_lengths(A),idxB,jblis_gpu_lengths(B),
+                  idxC,jblis_gpu_lengths(C),bun);
+  if (bun.m*bun.n == 0) return;
+  if (bun.k == 0) {libj::contract<T>(alpha,A,idxA,B,idxB,beta,C,idxC); return;}
+
+  const std::string order[3] = {bun.M + bun.K,bun.K + bun.N,bun.M + bun.N};
+  const libj::tensor<T>* X[3] = {&A,&B,&C};
+  const std::string* idx[3] = {&idxA,&idxB,&idxC};
+  std::vector<T> buf[3];
+  libj::tensor<T> mat[3];
+  T* ptr[3];
+  for (int t=0;t<3;t++)
+  {
+    if (*idx[t] == order[t] && X[t]->is_sequential()) 
+    {
+      ptr[t] = const_cast<T*>(X[t]->data());
+      continue;
+    }
+    std::vector<size_t> len;
+    for (size_t d=0;d<order[t].size();d++)
+    {
+      len.push_back(jblis_gpu_length(order[t][d],*idx[t],jblis_gpu_lengths(*X[t])));
+    }
+    buf[t].resize(std::max(X[t]->size(),(size_t) 1));
+    ptr[t] = buf[t].data();
+    mat[t].assign(ptr[t],len);
+    if (t < 2 || beta != (T) 0) {libj::permute<T>(*X[t],*idx[t],mat[t],order[t]);}
+  }
+
+  const int m = (int) bun.m, n = (int) bun.n, k = (int) bun.k;
+  gpu.template gemm_hybrid<T>(false,m,n,k,alpha,ptr[0],ptr[1],beta,ptr[2],
+    [&](const int NN, const T* Bj, T* Cj)
+    {
+      linal_ABpC<T>(m,NN,k,alpha,ptr[0],const_cast<T*>(Bj),beta,Cj);
+    });
+
+  if (!buf[2].empty()) {libj::permute<T>(mat[2],order[2],C,idxC);}
+}
+
+//--------------------------------------------------------------------------
+// contract_offload
+//	the host or GPU contract, as where (see the top of this file)
+//--------------------------------------------------------------------------
+template <typename T>
+void contract_offload(libj::GPU_HANDLER& gpu, const int where, const T alpha,
+                      const libj::tensor<T>& A, const std::string& idxA,
+                      const libj::tensor<T>& B, const std::string& idxB,
+                      const T beta, libj::tensor<T>& C, const std::string& idxC,
+                      const int dev = 0)
+{
+  if (where == JBLIS_HYBRID) 
+  {
+    gpu_contract_hybrid<T>(gpu,alpha,A,idxA,B,idxB,beta,C,idxC);
+    return;
+  }
+  bool on_gpu = (where == JBLIS_GPU);
+  if (where == JBLIS_AUTO && A.is_sequential() && B.is_sequential() && C.is_sequential())
+  {
+    jblis_gpu_bundles bun;
+    jblis_gpu_split(idxA,jblis_gpu_lengths(A),idxB,jblis_gpu_lengths(B),
+                    idxC,jblis_gpu_lengths(C),bun);
+    const double flops = 2.0*bun.m*bun.n*bun.k;
+    const double bytes = sizeof(T)*((double) A.size() + B.size() +
+                                    ((beta == (T) 0) ? 1.0 : 2.0)*C.size());
+    on_gpu = (flops >= JBLIS_GPU_MIN_FLOPS && flops >= JBLIS_GPU_MIN_INTENSITY*bytes);
+  }
+  if (on_gpu) {gpu_contract<T>(gpu,alpha,A,idxA,B,idxB,beta,C,idxC,dev);}
+  else        {libj::contract<T>(alpha,A,idxA,B,idxB,beta,C,idxC);}
+}
+
+}//end libj namespace
+#endif
@@ -0,0 +1,128 @@
+/*------------------------------------------------
+  linal_gpu.hpp
+        JHT, October 14, 2026 : created
+        JHT, October 14, 2026 : hybrid versions
+        JHT, October 14, 2026 : CUDA/HIP handler
+        JHT, October 14, 2026 : Newton-Schulz U^-1/2
+
+    GPU versions of linal products, with the same
+    signatures as the CPU versions
+
+    linal_ABpC_gpu  : C = ALPHA*A.B + BETA*C
+    linal_ATBpC_gpu : C = ALPHA*A^T.B + BETA*C
+
+    It is assumed that C,A,and B are all
+    continous in memory and coloumn major.
+    Logical dimension == physical dimension
+
+    They run on all GPUs of libj::gpu_handler(),
+    which is made on the first call, split by
+    the columns of C (see GPU_HANDLER::gemm). Only
+    double and float are instantiated. The
+    matrices are copied to the GPU and C is
+    copied back, so this only pays for large
+    products
+
+    linal_usym_invsqrt_ns_gpu : U = U^-1/2
+    linal_usym_sqrt_ns_gpu    : U = U^1/2
+                         the Newton-Schulz iteration
+                         of linal_usym_pow.hpp, with
+                         the products on the GPUs
+
+    linal_ABpC_hybrid  : as linal_ABpC_gpu, with
+    linal_ATBpC_hybrid   the host (linal_ABpC)
+                         taking tiles of C as well,
+                         see GPU_HANDLER::gemm_hybrid
+
+    With LIBJ_CUDA or LIBJ_HIP the handler is
+    libj::vendor::GPU_HANDLER (gpu_vendor.hpp),
+    and the gemm is cuBLAS or rocBLAS. The hybrid
+    versions are OpenCL only
+------------------------------------------------*/
+#ifndef LINAL_GPU_HPP
+#define LINAL_GPU_HPP
+
+#if defined (LIBJ_CUDA) || defined (LIBJ_HIP)
+  #include "gpu_vendor.hpp"
+#else
+  #include "gpu_handler.hpp"
+#endif
+#include "linal_ABpC.hpp"
+#include "linal_ATBpC.hpp"
+#include "linal_usym_pow.hpp"
+
+namespace libj
+{
+#if defined (LIBJ_CUDA) || defined (LIBJ_HIP)
+  typedef vendor::GPU_HANDLER gpu_handler_t;
+#else
+  typedef GPU_HANDLER gpu_handler_t;
+#endif
+
+//the GPU_HANDLER of the linal_*_gpu functions
+gpu_handler_t& gpu_handler()
+{
+  static gpu_handler_t handler;
+  return handler;
+}
+}//end libj namespace
+
+template <typename T>
+void linal_ABpC_gpu(const int M, const int N, const int K,
+                    const T ALPHA, T* A,
+                    T* B,  const T BETA,
+                    T* C )
+{
+  libj::gpu_handler().gemm<T>(false,M,N,K,ALPHA,A,B,BETA,C,GPU_ALL);
+}
+
+template <typename T>
+void linal_ATBpC_gpu(const int M, const int N, const int K,
+                     const T ALPHA, T* A, T* B, const T BETA,
+                     T* C)
+{
+  libj::gpu_handler().gemm<T>(true,M,N,K,ALPHA,A,B,BETA,C,GPU_ALL);
+}
+
+template <typename T>
+int linal_usym_invsqrt_ns_gpu(usymat<T>& U, Core<T>& CORE, const T TOL=0,
+                              const int MAXIT=LINAL_USYM_NS_MAXIT)
+{
+  return linal_usym_invsqrt_ns<T>(U,CORE,TOL,MAXIT,&linal_ABpC_gpu<T>);
+}
+
+template <typename T>
+int linal_usym_sqrt_ns_gpu(usymat<T>& U, Core<T>& CORE, const T TOL=0,
+                           const int MAXIT=LINAL_USYM_NS_MAXIT)
+{
+  return linal_usym_sqrt_ns<T>(U,CORE,TOL,MAXIT,&linal_ABpC_gpu<T>);
+}
+
+#if !defined (LIBJ_CUDA) && !defined (LIBJ_HIP)
+template <typename T>
+void linal_ABpC_hybrid(const int M, const int N, const int K,
+                       const T ALPHA, T* A, T* B, const T BETA,
+                       T* C)
+{
+  libj::gpu_handler().gemm_hybrid<T>(false,M,N,K,ALPHA,A,B,BETA,C,
+    [&](const int NN, const T* Bj, T* Cj)
+    {
+      linal_ABpC<T>(M,NN,K,ALPHA,A,const_cast<T*>(Bj),BETA,Cj);
+    });
+}
+
+template <typename T>
+void linal_ATBpC_hybrid(const int M, const int N, const int K,
+                        const T ALPHA, T* A, T* B, const T BETA,
+                        T* C)
+{
+  libj::gpu_handler().gemm_hybrid<T>(true,M,N,K,ALPHA,A,B,BETA,C,
+    [&](const int NN, const T* Bj, T* Cj)
+    {
+      linal_ATBpC<T>(M,NN,K,ALPHA,A,const_cast<T*>(Bj),BETA,Cj);
+    });
+}
+
+#endif
+
+#endif
@@ -0,0 +1,138 @@
+/*--------------------------------------------------------------------------
+  permute_kernel.h
+	JHT, October 14, 2026 : created
+	JHT, October 14, 2026 : tuned rows
+
+  OpenCL source of the tensor permutation kernels used by
+  GPU_HANDLER::permute,
+
+    B(perm) = alpha*A + beta*B
+
+  for any order of up to GPU_PERMUTE_MAX_DIM dimensions. The lengths of
+  A, and the strides of A and B for each dimension of A, are passed by
+  value in a gpu_permute_info, so there is no buffer to write first.
+  Dimension 0 is the fastest of A (stride 1 for dense A).
+
+    permute_tiled : the fastest dimension of B (db) is not 0, so dims 0
+                    and db are transposed through a PTILE x PTILE tile
+                    in local memory (padded by one against bank
+                    conflicts), so both the reads of A and the writes
+                    of B are coalesced. Groups of PTILE x PROWS work
+                    items do PTILE/PROWS rows each, and the third
+                    dimension of the groups runs over the other dims
+    permute_copy  : dim 0 is also the fastest of B, so each work item
+                    does one element, coalesced on both sides
+
+  B is not read if beta is zero. REAL and the sizes are set in the build
+  options, see load_permute, which tunes PROWS (GPU_PERMUTE_ROWS is the
+  default)
+--------------------------------------------------------------------------*/
+#ifndef PERMUTE_KERNEL_H
+#define PERMUTE_KERNEL_H
+
+#define GPU_PERMUTE_MAX_DIM 8
+#define GPU_PERMUTE_TILE    32
+#define GPU_PERMUTE_ROWS    8
+
+//the layout of perm_info in the kernels
+struct gpu_permute_info
+{
+  cl_long len[GPU_PERMUTE_MAX_DIM];  //lengths of A
+  cl_long sa[GPU_PERMUTE_MAX_DIM];   //strides of A
+  cl_long sb[GPU_PERMUTE_MAX_DIM];   //strides of B, for each dim of A
+};
+
+const char* gpu_permute_source = R"CLC(
+#if defined(REAL_IS_DOUBLE)
+  #pragma OPENCL EXTENSION cl_khr_fp64 : enable
+#endif
+#ifndef REAL
+  #define REAL double
+#endif
+#ifndef MAXD
+  #define MAXD 8
+#endif
+#ifndef PTILE
+  #define PTILE 32
+#endif
+#ifndef PROWS
+  #define PROWS 8
+#endif
+
+typedef struct
+{
+  long len[MAXD];
+  long sa[MAXD];
+  long sb[MAXD];
+} perm_info;
+
+inline REAL permute_val(const REAL alpha, const REAL beta, const REAL a,
+                        const __global REAL* B, const long ib)
+{
+  return (beta == (REAL) 0) ? alpha*a : alpha*a + beta*B[ib];
+}
+
+__kernel __attribute__((reqd_work_group_size(PTILE,PROWS,1)))
+void permute_tiled(const int ndim, const int db, const perm_info info,
+                   const REAL alpha, const REAL beta,
+                   const __global REAL* A, __global REAL* B)
+{
+  __local REAL tile[PTILE][PTILE+1];
+  const int lx = get_local_id(0);
+  const int ly = get_local_id(1);
+  const long n0 = info.len[0];
+  const long nb = info.len[db];
+
+  //offsets of the other dimensions, from the third group index
+  long rest = get_group_id(2);
+  long offA = 0, offB = 0;
+  for (int d=1;d<ndim;d++)
+  {
+    if (d == db) continue;
+    const long i = rest % info.len[d];
+    rest /= info.len[d];
+    offA += i*info.sa[d];
+    offB += i*info.sb[d];
+  }
+
+  //read along dim 0 of A
+  const long i0 = get_group_id(0)*PTILE + lx;
+  for (int r=ly;r<PTILE;r+=PROWS)
+  {
+    const long ib = get_group_id(1)*PTILE + r;
+    if (i0 < n0 && ib < nb) {tile[r][lx] = A[offA + i0*info.sa[0] + ib*info.sa[db]];}
+  }
+  barrier(CLK_LOCAL_MEM_FENCE);
+
+  //write along dim db of B
+  const long jb = get_group_id(1)*PTILE + lx;
+  for (int r=ly;r<PTILE;r+=PROWS)
+  {
+    const long j0 = get_group_id(0)*PTILE + r;
+    if (j0 < n0 && jb < nb)
+    {
+      const long idx = offB + j0*info.sb[0] + jb*info.sb[db];
+      B[idx] = permute_val(alpha,beta,tile[lx][r],B,idx);
+    }
+  }
+}
+
+__kernel void permute_copy(const int ndim, const long N, const perm_info info,
+                           const REAL alpha, const REAL beta,
+                           const __global REAL* A, __global REAL* B)
+{
+  long rest = get_global_id(0);
+  if (rest >= N) return;
+  long offA = 0, offB = 0;
+  for (int d=0;d<ndim;d++)
+  {
+    const long i = rest % info.len[d];
+    rest /= info.len[d];
+    offA += i*info.sa[d];
+    offB += i*info.sb[d];
+  }
+  B[offB] = permute_val(alpha,beta,A[offA],B,offB);
+}
+)CLC";
+
+#endif
@@ -0,0 +1,276 @@
+/*--------------------------------------------------------------------------
+  pinned_allocator.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for libj::pinned_allocator, a libj::allocator (see
+  allocator.hpp) of host memory that the driver can DMA from directly.
+  Copies from malloc'd memory are first bounced through a pinned pool of
+  the driver, which roughly halves the bandwidth.
+
+  Each allocation is an OpenCL buffer, mapped into host memory:
+
+    discrete GPUs : CL_MEM_ALLOC_HOST_PTR, so the driver pins the memory,
+                    and clEnqueueWrite/ReadBuffer from it go straight
+                    over the bus
+    unified GPUs  : CL_MEM_USE_HOST_PTR over page aligned host memory,
+                    when CL_DEVICE_HOST_UNIFIED_MEMORY is set. The buffer
+                    is the same memory, so nothing needs to be copied at
+                    all, the host just unmaps it before the GPU uses it
+                    and maps it again after (zero_copy() is true)
+
+  The memory is mapped for the host while it is allocated, but for the
+  unmap/map of a zero copy hand off, which libj::device_tensor does by
+  itself for tensors from this allocator. Memory must be given back with
+  deallocate (or by the tensor) before the allocator goes away.
+
+  Usage
+  -------------------
+  libj::pinned_allocator<double> P(GPU);    //on GPU 0 of the handler
+  libj::tensor<double> T;
+  T.set_allocator(&P);
+  T.aligned_allocate(64,n,n);            //pinned
+  libj::device_tensor<double> D(GPU,T);  //copies from pinned, or none
+
+  double* ptr = P.allocate(64,n);        //for a Core
+  Core<double> buf(n,ptr);
+  buf.unassign(); P.deallocate(ptr,n);
+--------------------------------------------------------------------------*/
+#ifndef PINNED_ALLOCATOR_HPP
+#define PINNED_ALLOCATOR_HPP
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#ifdef __APPLE__
+  #include <OpenCL/opencl.h>
+#else
+  #include <CL/cl.h>
+#endif
+
+#include "allocator.hpp"
+#include "gpu_handler.hpp"
+
+namespace libj
+{
+
+template <typename T>
+class pinned_allocator : public libj::allocator<T>
+{
+  private:
+  struct block
+  {
+    T*     ptr;     //pointer given out
+    void*  base;    //mapped (or host) pointer of the buffer
+    void*  host;    //host memory of a zero copy buffer, NULL otherwise
+    cl_mem buffer;
+    size_t bytes;   //bytes of the buffer
+    bool   mapped;  //mapped for the host
+  };
+
+  libj::GPU_HANDLER* m_gpu;
+  int                m_dev;
+  bool               m_zero_copy;
+  std::vector<block> m_blocks;
+
+  int  m_find(const T* ptr) const;
+  void m_map(block& b);
+
+  pinned_allocator(const pinned_allocator<T>& other);
+  pinned_allocator<T>& operator= (const pinned_allocator<T>& other);
+
+  public:
+  pinned_allocator(libj::GPU_HANDLER& gpu, const int dev = 0);
+  ~pinned_allocator();
+
+  T* allocate(const size_t ALIGN, const size_t n);
+  void deallocate(T* ptr, const size_t n);
+
+  //the GPU shares the memory, so buffers need no copies
+  bool zero_copy() const {return m_zero_copy;}
+  int  device() const {return m_dev;}
+  libj::GPU_HANDLER& gpu() {return *m_gpu;}
+
+  //buffer of an allocation that starts at ptr, NULL if not from here
+  cl_mem buffer(const T* ptr) const;
+
+  //zero copy hand off of the allocation at ptr, unmap before the GPU
+  //uses the buffer, and map before the host touches it again
+  void unmap(const T* ptr);
+  void map(const T* ptr);
+};
+
+//--------------------------------------------------------------------------
+// constructor
+//--------------------------------------------------------------------------
+template <typename T>
+pinned_allocator<T>::pinned_allocator(libj::GPU_HANDLER& gpu, const int dev)
+{
+  m_gpu = &gpu;
+  m_dev = dev;
+  gpu.init();
+  m_zero_copy = gpu.gpus[dev].host_unified_memory;
+}
+
+//--------------------------------------------------------------------------
+// destructor
+//	frees what is left, which the tensors must not use anymore
+//--------------------------------------------------------------------------
+template <typename T>
+pinned_allocator<T>::~pinned_allocator()
+{
+  while (!m_blocks.empty()) {deallocate(m_blocks.back().ptr,0);}
+}
+
+//--------------------------------------------------------------------------
+// m_find
+//--------------------------------------------------------------------------
+template <typename T>
+int pinned_allocator<T>::m_find(const T* ptr) const
+{
+  for (int blk=(int) m_blocks.size()-1;blk>=0;blk--)
+  {
+    if (m_blocks[blk].ptr == ptr) return blk;
+  }
+  return -1;
+}
+
+//--------------------------------------------------------------------------
+// m_map
+//	blocking map of the whole buffer for the host. The pointer of a
+//	CL_MEM_USE_HOST_PTR buffer is the host memory, for the other it is
+//	only the same for the first map, which is checked
+//--------------------------------------------------------------------------
+template <typename T>
+void pinned_allocator<T>::m_map(block& b)
+{
+  cl_int err;
+  void* ptr = clEnqueueMapBuffer(m_gpu->gpus[m_dev].commands,b.buffer,CL_TRUE,
+                                 CL_MAP_READ | CL_MAP_WRITE,0,b.bytes,0,NULL,NULL,&err);
+  if (err != CL_SUCCESS || (b.base != NULL && ptr != b.base))
+  {
+    printf("ERROR libj::pinned_allocator could not map %lu bytes, code %d \n",
+           (unsigned long) b.bytes,err);
+    exit(1);
+  }
+  b.base = ptr;
+  b.mapped = true;
+}
+
+//--------------------------------------------------------------------------
+// allocate
+//	n elements aligned to ALIGN bytes
+//--------------------------------------------------------------------------
+template <typename T>
+T* pinned_allocator<T>::allocate(const size_t ALIGN, const size_t n)
+{
+  const size_t align = (ALIGN > sizeof(T)) ? ALIGN : sizeof(T);
+  block b;
+  b.base = NULL;
+  b.host = NULL;
+  b.mapped = false;
+
+  cl_int err;
+  if (m_zero_copy)
+  {
+    //page aligned, and a whole number of cache lines, for USE_HOST_PTR
+    const size_t page = (align > 4096) ? align : 4096;
+    b.bytes = ((sizeof(T)*(n > 0 ? n : 1) + 63)/64)*64;
+    if (posix_memalign(&b.host,page,b.bytes) != 0)
+    {
+      printf("ERROR libj::pinned_allocator could not allocate %lu bytes \n",
+             (unsigned long) b.bytes);
+      exit(1);
+    }
+    b.buffer = clCreateBuffer(m_gpu->platform.context,CL_MEM_READ_WRITE | CL_MEM_USE_HOST_PTR,
+                              b.bytes,b.host,&err);
+  }
+  else
+  {
+    b.bytes = sizeof(T)*(n > 0 ? n : 1) + align;
+    b.buffer = clCreateBuffer(m_gpu->platform.context,CL_MEM_READ_WRITE | CL_MEM_ALLOC_HOST_PTR,
+                              b.bytes,NULL,&err);
+  }
+  if (err != CL_SUCCESS)
+  {
+    printf("ERROR libj::pinned_allocator could not make a buffer of %lu bytes, code %d \n",
+           (unsigned long) b.bytes,err);
+    exit(1);
+  }
+
+  m_map(b);
+  const size_t addr = (size_t) b.base;
+  b.ptr = (T*) ((addr + align - 1)/align*align);
+  if (m_zero_copy && (void*) b.ptr != b.base)
+  {
+    printf("ERROR libj::pinned_allocator the zero copy buffer is not at the host memory\n");
+    exit(1);
+  }
+  m_blocks.push_back(b);
+  return b.ptr;
+}
+
+//--------------------------------------------------------------------------
+// deallocate
+//--------------------------------------------------------------------------
+template <typename T>
+void pinned_allocator<T>::deallocate(T* ptr, const size_t n)
+{
+  const int blk = m_find(ptr);
+  if (blk < 0)
+  {
+    printf("ERROR libj::pinned_allocator::deallocate the pointer is not from here\n");
+    exit(1);
+  }
+  block& b = m_blocks[blk];
+  if (b.mapped)
+  {
+    clEnqueueUnmapMemObject(m_gpu->gpus[m_dev].commands,b.buffer,b.base,0,NULL,NULL);
+    clFinish(m_gpu->gpus[m_dev].commands);
+  }
+  clReleaseMemObject(b.buffer);
+  if (b.host != NULL) {free(b.host);}
+  m_blocks.erase(m_blocks.begin() + blk);
+}
+
+//--------------------------------------------------------------------------
+// buffer
+//--------------------------------------------------------------------------
+template <typename T>
+cl_mem pinned_allocator<T>::buffer(const T* ptr) const
+{
+  const int blk = m_find(ptr);
+  return (blk < 0) ? NULL : m_blocks[blk].buffer;
+}
+
+//--------------------------------------------------------------------------
+// unmap
+//--------------------------------------------------------------------------
+template <typename T>
+void pinned_allocator<T>::unmap(const T* ptr)
+{
+  const int blk = m_find(ptr);
+  if (blk < 0 || !m_blocks[blk].mapped) return;
+  block& b = m_blocks[blk];
+  cl_int err = clEnqueueUnmapMemObject(m_gpu->gpus[m_dev].commands,b.buffer,b.base,
+                                       0,NULL,NULL);
+  if (err != CL_SUCCESS)
+  {
+    printf("ERROR libj::pinned_allocator::unmap failed with code %d \n",err);
+    exit(1);
+  }
+  b.mapped = false;
+}
+
+//--------------------------------------------------------------------------
+// map
+//--------------------------------------------------------------------------
+template <typename T>
+void pinned_allocator<T>::map(const T* ptr)
+{
+  const int blk = m_find(ptr);
+  if (blk < 0 || m_blocks[blk].mapped) return;
+  m_map(m_blocks[blk]);
+}
+
+}//end libj namespace
+#endif
@@ -1,18 +1,26 @@
 //Global program string
-#ifdef cl_khr_fp64
-#pragma OPENCL EXTENSION cl_khr_fp64 : enable
-#elif defined(cl_amd_fp64)
-#pragma OPENCL EXTENSION cl_amd_fp64 : enable
-#else
-#error "Double precision floating point not supported by OpenCL implementation."
-#endif
+//  fset and hset need nothing of the device, hset stores halfs with
+//  vstore_half, which is core OpenCL (cl_khr_fp16 is only needed for
+//  arithmetic on halfs). dset needs doubles, so check 
+//  GPU::supports_double before building it
 const char* fset = "\n"
-"__kernel void dset(__global float* x)\n"
+"__kernel void fset(__global float* x)\n"
 "{\n"
 "  x[get_global_id(0)] = 42;\n"
 "}\n";
 
+const char* hset = "\n"
+"__kernel void hset(__global half* x)\n"
+"{\n"
+"  vstore_half(42.0f,get_global_id(0),x);\n"
+"}\n";
+
 const char* dset = "\n"
+"#if defined(cl_khr_fp64)\n"
+"  #pragma OPENCL EXTENSION cl_khr_fp64 : enable\n"
+"#elif defined(cl_amd_fp64)\n"
+"  #pragma OPENCL EXTENSION cl_amd_fp64 : enable\n"
+"#endif\n"
 "__kernel void dset(__global double* x)\n"
 "{\n"
 "  x[get_global_id(0)] = 33;\n"
@@ -19,5 +19,6 @@
 #include "timer.hpp"
 #include "linal.hpp"
 #include "simd.hpp"
+#include "simd_dispatch.hpp"
 
 #endif
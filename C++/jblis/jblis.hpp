@@ -1 +1,3 @@
 #include "jblis_level1.hpp"
+#include "jblis_level2.hpp"
+#include "jblis_level3.hpp"
@@ -0,0 +1,106 @@
+/*----------------------------------------------------------------------
+  broadcast.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for the broadcast_add function, which adds a vector along
+  one dimension of A,
+
+    A(i,j,a,b) += alpha * V(a)
+
+  The dimensions of length 1 are dropped, and neighbours other than
+  the axis are fused. The dimension with the smallest stride is the
+  inner one: if it is the axis, each line is an axpy of V, otherwise
+  each line gets the one value of V at its axis index (simd_scal_add).
+  The lines are flattened into one parallel OpenMP loop
+
+----------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include "jblis_level1.hpp"
+#include "dim_vector.hpp"
+#include "simd.hpp"
+
+namespace libj
+{
+
+/*----------------------------------------------------------------------
+  broadcast_add
+----------------------------------------------------------------------*/
+template <typename T>
+void broadcast_add(const T* V, libj::tensor<T>& A, const size_t axis, const T alpha)
+{
+  if (axis >= A.dim())
+  {
+    printf("ERROR libj::broadcast_add \n");
+    printf("axis %zu of a tensor of %zu dimensions \n",axis,A.dim());
+    exit(1);
+  }
+
+  //dimensions, X is the axis, NONE if it has length 1
+  const size_t NONE = (size_t) -1;
+  libj::dim_vector LEN, S;
+  size_t X = NONE;
+  for (size_t d=0;d<A.dim();d++)
+  {
+    if (A.size(d) == 1) continue;
+    const size_t n = LEN.size();
+    if (d != axis && n > 0 && n-1 != X && S[n-1]*LEN[n-1] == A.stride(d))
+    {
+      LEN[n-1] *= A.size(d);
+    } else {
+      if (d == axis) X = n;
+      LEN.push_back(A.size(d));
+      S.push_back(A.stride(d));
+    }
+  }
+  if (LEN.size() == 0)
+  {
+    LEN.push_back(1);
+    S.push_back(0);
+  }
+
+  size_t inner = 0;
+  for (size_t d=1;d<LEN.size();d++) {if (S[d] < S[inner]) inner = d;}
+  libj::dim_vector OUTER;
+  size_t NOUT = 1;
+  for (size_t d=0;d<LEN.size();d++) {if (d != inner) {OUTER.push_back(d); NOUT *= LEN[d];}}
+
+  T*           AP = A.data();
+  const long   N  = (long) LEN[inner];
+  const size_t SI = S[inner];
+
+  #pragma omp parallel for schedule(static)
+  for (long o=0;o<(long) NOUT;o++)
+  {
+    size_t oa = 0, ix = 0, I = (size_t) o;
+    for (size_t d=0;d<OUTER.size();d++)
+    {
+      const size_t idx = I%LEN[OUTER[d]];
+      I /= LEN[OUTER[d]];
+      oa += idx*S[OUTER[d]];
+      if (OUTER[d] == X) ix = idx;
+    }
+    T* aa = AP+oa;
+
+    if (inner == X)
+    {
+      if (SI == 1) {simd_auto_axpy<T>(N,alpha,V,aa);}
+      else {for (long i=0;i<N;i++) aa[i*SI] += alpha*V[i];}
+    } else {
+      const T c = alpha*V[ix];
+      if (SI == 1) {simd_scal_add<T>(N,c,aa);}
+      else {for (long i=0;i<N;i++) aa[i*SI] += c;}
+    }
+  }
+}
+template void libj::broadcast_add<double>(const double* V, libj::tensor<double>& A,
+                                          const size_t axis, const double alpha);
+template void libj::broadcast_add<float>(const float* V, libj::tensor<float>& A,
+                                         const size_t axis, const float alpha);
+template void libj::broadcast_add<long>(const long* V, libj::tensor<long>& A,
+                                        const size_t axis, const long alpha);
+template void libj::broadcast_add<int>(const int* V, libj::tensor<int>& A,
+                                       const size_t axis, const int alpha);
+
+}//end of namespace
@@ -0,0 +1,93 @@
+/*----------------------------------------------------------------------
+  convert.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for the convert function,
+
+    Y = (TY) X
+
+  between tensors of the same lengths and different types, e.g. a
+  libj::tensor<libj::bf16> store of amplitudes and a tensor<double>
+  work copy of them. Either may be a strided view.
+
+  General flow is as follows
+
+  1) the dimensions are fused as in permute (libj::strided_dims),
+     so two sequential tensors are one line
+
+  2) the first dimension is cut into chunks of half of L1 (of TY),
+     and the chunks of all the lines are one parallel OpenMP loop
+
+  3) a chunk with stride 1 in both is simd_convert, which converts
+     the 16 bit types a register at a time (simd_half.cpp), others
+     are done element by element
+
+----------------------------------------------------------------------*/
+#include <stdio.h>
+#include <algorithm>
+#include "jblis_level1.hpp"
+#include "jblis_strided.hpp"
+#include "simd.hpp"
+
+namespace libj
+{
+
+template <typename TX, typename TY>
+void convert(const libj::tensor<TX>& X, libj::tensor<TY>& Y)
+{
+  const std::string idx(X.dim(),'.');
+  if (!X.is_set() || !Y.is_set() || X.dim() != Y.dim())
+  {
+    strided_error("libj::convert",idx,idx,"X or Y is not set, or their dimensions do not match");
+  }
+  libj::strided_dims dims;
+  for (size_t d=0;d<Y.dim();d++)
+  {
+    if (X.size(d) != Y.size(d)) {strided_error("libj::convert",idx,idx,"Lengths of X and Y do not match");}
+    dims.push(Y.size(d),X.stride(d),Y.stride(d));
+  }
+  if (dims.LEN.size() == 0)
+  {
+    if (Y.size() > 0) Y.data()[0] = (TY) X.data()[0];
+    return;
+  }
+
+  libj::dim_vector OUTER;
+  size_t NOUT;
+  dims.outer(0,OUTER,NOUT);
+
+  const TX*    XP  = X.data();
+  TY*          YP  = Y.data();
+  const size_t N   = dims.LEN[0];
+  const size_t SX  = dims.SA[0];
+  const size_t SY  = dims.SB[0];
+  const size_t NC  = std::max((size_t) 1,libj::CacheInfo::get().L1_elements<TY>()/2);
+  const size_t NCH = (N + NC - 1)/NC;
+
+  #pragma omp parallel for schedule(static)
+  for (long t=0;t<(long) (NOUT*NCH);t++)
+  {
+    const size_t c  = (size_t) t%NCH;
+    const size_t o  = (size_t) t/NCH;
+    const size_t i0 = c*NC;
+    const long   n  = (long) std::min(NC,N-i0);
+    size_t ox,oy;
+    dims.offsets(o,OUTER,ox,oy);
+    const TX* xx = XP+ox+i0*SX;
+    TY*       yy = YP+oy+i0*SY;
+    if (SX == 1 && SY == 1) {simd_convert<TX,TY>(n,xx,yy);}
+    else {for (long i=0;i<n;i++) yy[i*SY] = (TY) xx[i*SX];}
+  }
+}
+template void libj::convert<double,float>(const libj::tensor<double>& X, libj::tensor<float>& Y);
+template void libj::convert<float,double>(const libj::tensor<float>& X, libj::tensor<double>& Y);
+template void libj::convert<double,libj::fp16>(const libj::tensor<double>& X, libj::tensor<libj::fp16>& Y);
+template void libj::convert<libj::fp16,double>(const libj::tensor<libj::fp16>& X, libj::tensor<double>& Y);
+template void libj::convert<double,libj::bf16>(const libj::tensor<double>& X, libj::tensor<libj::bf16>& Y);
+template void libj::convert<libj::bf16,double>(const libj::tensor<libj::bf16>& X, libj::tensor<double>& Y);
+template void libj::convert<float,libj::fp16>(const libj::tensor<float>& X, libj::tensor<libj::fp16>& Y);
+template void libj::convert<libj::fp16,float>(const libj::tensor<libj::fp16>& X, libj::tensor<float>& Y);
+template void libj::convert<float,libj::bf16>(const libj::tensor<float>& X, libj::tensor<libj::bf16>& Y);
+template void libj::convert<libj::bf16,float>(const libj::tensor<libj::bf16>& X, libj::tensor<float>& Y);
+
+}//end of namespace
@@ -0,0 +1,117 @@
+/*----------------------------------------------------------------------
+  copy.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for the copy and scopy functions,
+
+    Y = a * X
+
+  where X and Y have the same lengths, but may have different strides
+
+  General flow is as follows
+
+  1) a == 0 is a zero of Y, and a == 1 is a copy
+
+  2) if both are sequential, they are done as one vector with
+     simd_par_copy, or simd_scal_copy in parallel chunks
+
+  3) if the fused fastest dimension of both (tensor_runs) is long,
+     each line is done with simd_auto_copy, simd_scal_copy, or
+     simd_copy_strided, in parallel over the lines
+
+  4) otherwise, both are col-vector tensor_matrix2s. A parallel
+     loop goes through panels sized to fit in L2, and each panel
+     in packs of block_scatter_matrix2 row blocks. A pack of X that
+     is not contiguous is gathered into the thread's libj::Cache L1
+     buffer first, see jblis_blocked.hpp. Nothing is allocated. 
+     Use permute for copies between different index orders.
+
+----------------------------------------------------------------------*/
+#include <stdio.h>
+#include "jblis_level1.hpp"
+#include "jblis_blocked.hpp"
+#include "simd.hpp"
+
+namespace libj
+{
+
+/*----------------------------------------------------------------------
+  ops for the blocked driver
+----------------------------------------------------------------------*/
+template <typename T>
+struct copy_op
+{
+  inline void operator() (const T& x, T& y) const {y = x;}
+  inline void line(const size_t N, const T* X, const size_t INCX,
+                   T* Y, const size_t INCY) const
+  {
+    if (INCX == 1 && INCY == 1) {simd_auto_copy<T>((long) N,X,Y);}
+    else {simd_copy_strided<T>((long) N,X,(long) INCX,Y,(long) INCY);}
+  }
+};
+
+template <typename T>
+struct scopy_op
+{
+  const T a;
+  scopy_op(const T val) : a(val) {}
+  inline void operator() (const T& x, T& y) const {y = a*x;}
+  inline void line(const size_t N, const T* X, const size_t INCX,
+                   T* Y, const size_t INCY) const
+  {
+    if (INCX == 1 && INCY == 1) {simd_scal_copy<T>((long) N,a,X,Y);}
+    else {for (size_t i=0;i<N;i++) Y[i*INCY] = a*X[i*INCX];}
+  }
+};
+
+/*----------------------------------------------------------------------
+  copy
+----------------------------------------------------------------------*/
+template <typename T>
+void copy(const libj::tensor<T>& X, libj::tensor<T>& Y)
+{
+  libj::blocked_same_shape("libj::copy",X,Y);
+  if (Y.size() == 0) return;
+  if (X.is_sequential() && Y.is_sequential()) {
+    simd_par_copy<T>((long) Y.size(),X.data(),Y.data());
+  } else {
+    libj::blocked_dispatch2("libj::copy",X,Y,copy_op<T>());
+  }
+}
+template void libj::copy<double>(const libj::tensor<double>& X, libj::tensor<double>& Y);
+template void libj::copy<float>(const libj::tensor<float>& X, libj::tensor<float>& Y);
+template void libj::copy<long>(const libj::tensor<long>& X, libj::tensor<long>& Y);
+template void libj::copy<int>(const libj::tensor<int>& X, libj::tensor<int>& Y);
+
+/*----------------------------------------------------------------------
+  scopy
+----------------------------------------------------------------------*/
+template <typename T>
+void scopy(const T a, const libj::tensor<T>& X, libj::tensor<T>& Y)
+{
+  libj::blocked_same_shape("libj::scopy",X,Y);
+  if (Y.size() == 0) return;
+  if (a == (T) 0) {libj::zero(Y); return;}
+  if (a == (T) 1) {libj::copy(X,Y); return;}
+  if (X.is_sequential() && Y.is_sequential()) {
+    const long N     = (long) Y.size();
+    const long CHUNK = (long) libj::Cache::L2_runtime_elements<T>();
+    const long nchunk = (N + CHUNK - 1)/CHUNK;
+    const T* x = X.data();
+    T* y = Y.data();
+    #pragma omp parallel for schedule(static)
+    for (long chunk = 0; chunk < nchunk; chunk++)
+    {
+      const long start = chunk*CHUNK;
+      simd_scal_copy<T>(std::min(N-start,CHUNK),a,x+start,y+start);
+    }
+  } else {
+    libj::blocked_dispatch2("libj::scopy",X,Y,scopy_op<T>(a));
+  }
+}
+template void libj::scopy<double>(const double a, const libj::tensor<double>& X, libj::tensor<double>& Y);
+template void libj::scopy<float>(const float a, const libj::tensor<float>& X, libj::tensor<float>& Y);
+template void libj::scopy<long>(const long a, const libj::tensor<long>& X, libj::tensor<long>& Y);
+template void libj::scopy<int>(const int a, const libj::tensor<int>& X, libj::tensor<int>& Y);
+
+}//end of namespace
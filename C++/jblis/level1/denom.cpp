@@ -0,0 +1,167 @@
+/*----------------------------------------------------------------------
+  denom.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for the denom function, which applies a denominator made
+  of one vector per dimension of A,
+
+    D(i,j,a,b) = shift + S0*E0(i) + S1*E1(j) + S2*E2(a) + S3*E3(b)
+    A(i,j,a,b) = A(i,j,a,b) / D(i,j,a,b)     (or * D)
+
+  e.g. the e_i + e_j - e_a - e_b of an amplitude update, without
+  making D. The sum over the outer dimensions is a constant of each
+  line along dimension 0, so a line costs one fma and one div (or
+  mul) per element. Lines of stride 1 are done with AVX, and the
+  lines are flattened into one parallel OpenMP loop. The
+  dimensions are not fused, as each has its own vector
+
+  The div is _mm256_div_pd/_ps rather than a reciprocal with a
+  Newton step, so each element is correctly rounded, and the pass
+  is limited by the reads and writes of A in any case
+
+----------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include "jblis_level1.hpp"
+
+namespace libj
+{
+
+/*----------------------------------------------------------------------
+  denom_plain
+	A(i*SA) = A(i*SA) op (c + s*E(i)), i = 0, ..., N-1
+----------------------------------------------------------------------*/
+template <typename T>
+inline void denom_plain(const long N, const T c, const T s, const T* E,
+                        T* A, const size_t SA, const bool divide)
+{
+  if (divide)
+  {
+    for (long i=0;i<N;i++) A[i*SA] /= (c + s*E[i]);
+  } else {
+    for (long i=0;i<N;i++) A[i*SA] *= (c + s*E[i]);
+  }
+}
+
+/*----------------------------------------------------------------------
+  denom_line
+	denom_plain, with AVX for lines of stride 1
+----------------------------------------------------------------------*/
+template <typename T>
+struct denom_line
+{
+  static inline void run(const long N, const T c, const T s, const T* E,
+                         T* A, const size_t SA, const bool divide)
+  {
+    denom_plain<T>(N,c,s,E,A,SA,divide);
+  }
+};
+
+#if defined LIBJ_AVX
+template <>
+struct denom_line<double>
+{
+  static inline void run(const long N, const double c, const double s, const double* E,
+                         double* A, const size_t SA, const bool divide)
+  {
+    long i = 0;
+    if (SA == 1)
+    {
+      const __m256d vc = _mm256_set1_pd(c);
+      const __m256d vs = _mm256_set1_pd(s);
+      for (;i+4<=N;i+=4)
+      {
+        #if defined LIBJ_FMA
+          const __m256d d = _mm256_fmadd_pd(vs,_mm256_loadu_pd(E+i),vc);
+        #else
+          const __m256d d = _mm256_add_pd(vc,_mm256_mul_pd(vs,_mm256_loadu_pd(E+i)));
+        #endif
+        const __m256d a = _mm256_loadu_pd(A+i);
+        _mm256_storeu_pd(A+i,divide ? _mm256_div_pd(a,d) : _mm256_mul_pd(a,d));
+      }
+    }
+    denom_plain<double>(N-i,c,s,E+i,A+i*SA,SA,divide);
+  }
+};
+
+template <>
+struct denom_line<float>
+{
+  static inline void run(const long N, const float c, const float s, const float* E,
+                         float* A, const size_t SA, const bool divide)
+  {
+    long i = 0;
+    if (SA == 1)
+    {
+      const __m256 vc = _mm256_set1_ps(c);
+      const __m256 vs = _mm256_set1_ps(s);
+      for (;i+8<=N;i+=8)
+      {
+        #if defined LIBJ_FMA
+          const __m256 d = _mm256_fmadd_ps(vs,_mm256_loadu_ps(E+i),vc);
+        #else
+          const __m256 d = _mm256_add_ps(vc,_mm256_mul_ps(vs,_mm256_loadu_ps(E+i)));
+        #endif
+        const __m256 a = _mm256_loadu_ps(A+i);
+        _mm256_storeu_ps(A+i,divide ? _mm256_div_ps(a,d) : _mm256_mul_ps(a,d));
+      }
+    }
+    denom_plain<float>(N-i,c,s,E+i,A+i*SA,SA,divide);
+  }
+};
+#endif
+
+/*----------------------------------------------------------------------
+  denom
+----------------------------------------------------------------------*/
+template <typename T>
+void denom(libj::tensor<T>& A, const std::vector<const T*>& E,
+           const std::vector<T>& S, const bool divide, const T shift)
+{
+  const size_t nd = A.dim();
+  if (E.size() != nd || S.size() != nd)
+  {
+    printf("ERROR libj::denom \n");
+    printf("%zu vectors and %zu signs for a tensor of %zu dimensions \n",E.size(),S.size(),nd);
+    exit(1);
+  }
+  if (A.size() == 0) return;
+
+  T* AP = A.data();
+  if (nd == 0)
+  {
+    AP[0] = divide ? AP[0]/shift : AP[0]*shift;
+    return;
+  }
+
+  //outer dimensions, flattened
+  size_t NOUT = 1;
+  for (size_t d=1;d<nd;d++) NOUT *= A.size(d);
+  const long   N  = (long) A.size(0);
+  const size_t SA = A.stride(0);
+  const T*     E0 = E[0];
+  const T      S0 = S[0];
+
+  #pragma omp parallel for schedule(static)
+  for (long o=0;o<(long) NOUT;o++)
+  {
+    size_t I = (size_t) o;
+    size_t off = 0;
+    T c = shift;
+    for (size_t d=1;d<nd;d++)
+    {
+      const size_t idx = I%A.size(d);
+      I /= A.size(d);
+      off += idx*A.stride(d);
+      c += S[d]*E[d][idx];
+    }
+    denom_line<T>::run(N,c,S0,E0,AP+off,SA,divide);
+  }
+}
+template void libj::denom<double>(libj::tensor<double>& A, const std::vector<const double*>& E,
+                                  const std::vector<double>& S, const bool divide, const double shift);
+template void libj::denom<float>(libj::tensor<float>& A, const std::vector<const float*>& E,
+                                 const std::vector<float>& S, const bool divide, const float shift);
+
+}//end of namespace
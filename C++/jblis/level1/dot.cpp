@@ -0,0 +1,139 @@
+/*----------------------------------------------------------------------
+  dot.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for the dot function, which performs
+
+    sum = A(idxA) . B(idxB)
+
+  over all indices, where the labels of B are a permutation of
+  those of A. This follows the same flow as permute.cpp
+
+  1) put the dimensions in the order of B, drop those of length 1,
+     and fuse neighbours (libj::strided_dims). A trivial
+     permutation is done with simd_par_dot
+
+  2) if A and B have the same fastest dimension, loop through
+     the other dimensions and do a simd_auto_dot of each line
+
+  3) otherwise, B's fastest dimension (i) and A's fastest
+     dimension (j) are done in square tiles of permute sized
+     blocks, so that the strided lines of A stay in L1 between
+     the columns of the tile
+
+  The lines (or tiles) of all the other dimensions are flattened
+  into one parallel OpenMP loop, with a reduction over the sum
+
+----------------------------------------------------------------------*/
+#include <stdio.h>
+#include <vector>
+#include <string>
+#include "jblis_level1.hpp"
+#include "jblis_strided.hpp"
+#include "simd.hpp"
+
+namespace libj
+{
+
+/*----------------------------------------------------------------------
+  dot_block
+	edge of the square tiles, as in permute
+----------------------------------------------------------------------*/
+template <typename T>
+inline size_t dot_block()
+{
+  size_t bs = 8;
+  const size_t L1 = libj::CacheInfo::get().L1_bytes;
+  while (2*(bs+8)*(bs+8)*sizeof(T) <= L1) bs += 8;
+  return bs;
+}
+
+/*----------------------------------------------------------------------
+  dot_line
+	dot of N elements, with strides SA and SB
+----------------------------------------------------------------------*/
+template <typename T>
+inline T dot_line(const size_t N, const T* A, const size_t SA, const T* B, const size_t SB)
+{
+  if (SA == 1 && SB == 1) return simd_auto_dot<T>((long) N,A,B);
+  return simd_dot_strided<T>((long) N,A,(long) SA,B,(long) SB);
+}
+
+/*----------------------------------------------------------------------
+  General code
+----------------------------------------------------------------------*/
+template <typename T>
+T dot(const libj::tensor<T>& A, const std::string& idxA,
+      const libj::tensor<T>& B, const std::string& idxB)
+{
+  libj::strided_dims dims;
+  dims.make("libj::dot",A,idxA,B,idxB);
+
+  //trivial permutation
+  if (dims.trivial()) return simd_par_dot<T>((long) B.size(),A.data(),B.data());
+
+  const T* AP = A.data();
+  const T* BP = B.data();
+  const size_t j1 = dims.stride_A();
+  libj::dim_vector OUTER;
+  size_t NOUT;
+  dims.outer(j1,OUTER,NOUT);
+
+  T sum = (T) 0;
+  if (j1 == 0)
+  {
+    //same fastest dimension, lines
+    const size_t N  = dims.LEN[0];
+    const size_t SA = dims.SA[0];
+    const size_t SB = dims.SB[0];
+
+    #pragma omp parallel for schedule(static) reduction(+:sum)
+    for (long o=0;o<(long) NOUT;o++)
+    {
+      size_t oa,ob;
+      dims.offsets((size_t) o,OUTER,oa,ob);
+      sum += dot_line<T>(N,AP+oa,SA,BP+ob,SB);
+    }
+
+  } else {
+    //tiles of dimensions 0 (fastest in B) and j1 (fastest in A)
+    const size_t BS  = dot_block<T>();
+    const size_t NI  = dims.LEN[0];
+    const size_t NJ  = dims.LEN[j1];
+    const size_t NBI = (NI + BS - 1)/BS;
+    const size_t NBJ = (NJ + BS - 1)/BS;
+    const size_t SAI = dims.SA[0];
+    const size_t SAJ = dims.SA[j1];
+    const size_t SBI = dims.SB[0];
+    const size_t SBJ = dims.SB[j1];
+
+    #pragma omp parallel for schedule(static) reduction(+:sum)
+    for (long t=0;t<(long) (NOUT*NBI*NBJ);t++)
+    {
+      const size_t bi = (size_t) t%NBI;
+      const size_t bj = ((size_t) t/NBI)%NBJ;
+      const size_t o  = (size_t) t/(NBI*NBJ);
+      size_t oa,ob;
+      dims.offsets(o,OUTER,oa,ob);
+
+      const size_t i0 = bi*BS;
+      const size_t j0 = bj*BS;
+      const size_t ni = std::min(BS,NI-i0);
+      const size_t nj = std::min(BS,NJ-j0);
+      const T* aa = AP+oa+i0*SAI+j0*SAJ;
+      const T* bb = BP+ob+i0*SBI+j0*SBJ;
+      for (size_t j=0;j<nj;j++) sum += dot_line<T>(ni,aa+j*SAJ,SAI,bb+j*SBJ,SBI);
+    }
+  }
+  return sum;
+}
+template double libj::dot<double>(const libj::tensor<double>& A, const std::string& idxA,
+                                  const libj::tensor<double>& B, const std::string& idxB);
+template float libj::dot<float>(const libj::tensor<float>& A, const std::string& idxA,
+                                const libj::tensor<float>& B, const std::string& idxB);
+template long libj::dot<long>(const libj::tensor<long>& A, const std::string& idxA,
+                              const libj::tensor<long>& B, const std::string& idxB);
+template int libj::dot<int>(const libj::tensor<int>& A, const std::string& idxA,
+                            const libj::tensor<int>& B, const std::string& idxB);
+
+}//end of namespace
@@ -0,0 +1,449 @@
+/*----------------------------------------------------------------------
+  jblis_blocked.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for the blocked drivers of the element-wise level-1
+  routines (zero, set, scal, copy, scopy). They are built on
+  tensor_runs and the std::array tensor_matrix2 and
+  block_scatter_matrix2, so nothing is allocated for any tensor,
+  strided or not.
+
+  General flow is as follows
+
+  0) the dimensions are fused (tensor_runs). If the fused fastest
+     dimension is at least BLOCKED_ROWS long, each fused line is
+     handed to the op's simd kernel, and the lines are split evenly
+     over the threads (blocked_lines). Otherwise,
+
+  1) the tensor is taken as a col-vector tensor_matrix2<T,NDIM,0>,
+     where NDIM is found from A.dim() at run time (blocked_rank)
+
+  2) parallel loop through panels of the col-vector, sized to fit
+     in L2 (libj::CacheInfo), which is assumed not to be shared.
+     Small tensors (< libj::simd_par_min_n(), see simd_machine.hpp) are
+     done by one thread
+
+  3) loop through the packs of each panel. A pack is a
+     block_scatter_matrix2 of blocked_pack_rows<T>() rows, in row
+     blocks of BLOCKED_ROWS, which is a quarter of L1
+
+  4) a pack that is one contiguous line is done as such. Otherwise,
+     a row block with a constant stride is done as one strided
+     line, and scattered row blocks (stride 0) element by element
+
+  For two tensors, a pack of X that is not contiguous is first
+  gathered into the L1 buffer of the thread's libj::Cache (from the
+  heap, libj::CachePool), so that
+  the op is driven by the layout of Y alone.
+
+  Sequential tensors never get here, the routines hand them to the
+  simd_par kernels as one vector.
+
+  The ops are structs with
+    op(A[i])                    for blocked_apply
+    op.line(N,A,INC)            for blocked_lines
+    op(X[i],Y[i])               for blocked_apply2
+    op.line(N,X,INCX,Y,INCY)    for blocked_lines2
+
+  Usage
+  ------------------------
+  libj::blocked_dispatch("libj::zero",A,op);
+  libj::blocked_dispatch2("libj::copy",X,Y,op);
+
+----------------------------------------------------------------------*/
+#ifndef JBLIS_BLOCKED_HPP
+#define JBLIS_BLOCKED_HPP
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include "tensor.hpp"
+#include "tensor_matrix2.hpp"
+#include "block_scatter_matrix2.hpp"
+#include "tensor_runs.hpp"
+#include "cache.hpp"
+#include "cache_pool.hpp"
+#include "simd.hpp"
+
+#if defined (_OPENMP)
+  #include <omp.h>
+#endif
+
+//Elements in a row block
+#define BLOCKED_ROWS 16
+
+namespace libj
+{
+
+/*----------------------------------------------------------------------
+  blocked_pack_rows
+	rows of a pack, a quarter of L1 in a multiple of BLOCKED_ROWS,
+	so that a pack, its scatter vector, and the L1 buffer fit
+----------------------------------------------------------------------*/
+template <typename T>
+constexpr size_t blocked_pack_rows()
+{
+  return (libj::Cache::L1_elements<T>()/4/BLOCKED_ROWS > 0) ?
+         (libj::Cache::L1_elements<T>()/4/BLOCKED_ROWS)*BLOCKED_ROWS : BLOCKED_ROWS;
+}
+
+template <typename T>
+struct blocked_matrix
+{
+  typedef libj::block_scatter_matrix2<T,blocked_pack_rows<T>(),1,BLOCKED_ROWS,1> type;
+};
+
+/*----------------------------------------------------------------------
+  blocked_panel_rows
+	rows of a panel, the L2 of this machine in a multiple of the
+	pack rows
+----------------------------------------------------------------------*/
+template <typename T>
+inline size_t blocked_panel_rows()
+{
+  const size_t pack  = blocked_pack_rows<T>();
+  const size_t panel = (libj::Cache::L2_runtime_elements<T>()/pack)*pack;
+  return (panel > 0) ? panel : pack;
+}
+
+/*----------------------------------------------------------------------
+  blocked_contiguous
+	true if the first LEN rows of a pack are one stride 1 line
+----------------------------------------------------------------------*/
+template <typename T, size_t NROW, size_t RBL>
+inline bool blocked_contiguous(const size_t LEN,
+  const libj::block_scatter_matrix2<T,NROW,1,RBL,1>& A)
+{
+  for (size_t row = 0; row+1 < LEN; row += RBL)
+  {
+    if (A.block_stride(0,row/RBL) != 1) return false;
+    if (row+RBL < LEN && (size_t) (&A(row+RBL,0) - &A(row,0)) != RBL) return false;
+  }
+  return true;
+}
+
+/*----------------------------------------------------------------------
+  blocked_pack
+	op(A[i]) on the first LEN rows of a pack of one tensor
+----------------------------------------------------------------------*/
+template <typename T, size_t NROW, size_t RBL, class OP>
+inline void blocked_pack(const size_t LEN,
+  libj::block_scatter_matrix2<T,NROW,1,RBL,1>& A, const OP& op)
+{
+  const size_t nfull = LEN/RBL;
+  for (size_t block = 0; block < nfull; block++)
+  {
+    const size_t row    = block*RBL;
+    const size_t stride = A.block_stride(0,block);
+    if (stride == 1) {
+      T* a = &A(row,0);
+      for (size_t i = 0; i < RBL; i++) op(a[i]);
+    } else if (stride > 0) {
+      T* a = &A(row,0);
+      for (size_t i = 0; i < RBL; i++) op(a[i*stride]);
+    } else {
+      for (size_t i = row; i < row + RBL; i++) op(A(i,0));
+    }
+  }
+
+  //cleanup the last row block
+  for (size_t i = nfull*RBL; i < LEN; i++) op(A(i,0));
+}
+
+/*----------------------------------------------------------------------
+  blocked_pack2
+	op(X[i],Y[i]) on the first LEN rows of a pack of Y, where X
+	is a contiguous line (the L1 buffer, or X itself)
+----------------------------------------------------------------------*/
+template <typename T, size_t NROW, size_t RBL, class OP>
+inline void blocked_pack2(const size_t LEN, const T* X,
+  libj::block_scatter_matrix2<T,NROW,1,RBL,1>& Y, const OP& op)
+{
+  const size_t nfull = LEN/RBL;
+  for (size_t block = 0; block < nfull; block++)
+  {
+    const size_t row    = block*RBL;
+    const size_t stride = Y.block_stride(0,block);
+    const T* x = X + row;
+    if (stride == 1) {
+      T* y = &Y(row,0);
+      for (size_t i = 0; i < RBL; i++) op(x[i],y[i]);
+    } else if (stride > 0) {
+      T* y = &Y(row,0);
+      for (size_t i = 0; i < RBL; i++) op(x[i],y[i*stride]);
+    } else {
+      for (size_t i = 0; i < RBL; i++) op(x[i],Y(row+i,0));
+    }
+  }
+
+  //cleanup the last row block
+  for (size_t i = nfull*RBL; i < LEN; i++) op(X[i],Y(i,0));
+}
+
+/*----------------------------------------------------------------------
+  blocked_gather
+	copies the first LEN rows of a pack into the buffer BUF
+----------------------------------------------------------------------*/
+template <typename T, size_t NROW, size_t RBL>
+inline void blocked_gather(const size_t LEN,
+  const libj::block_scatter_matrix2<T,NROW,1,RBL,1>& X, T* BUF)
+{
+  const size_t nfull = LEN/RBL;
+  for (size_t block = 0; block < nfull; block++)
+  {
+    const size_t row    = block*RBL;
+    const size_t stride = X.block_stride(0,block);
+    if (stride > 0) {
+      const T* x = &X(row,0);
+      for (size_t i = 0; i < RBL; i++) BUF[row+i] = x[i*stride];
+    } else {
+      for (size_t i = row; i < row + RBL; i++) BUF[i] = X(i,0);
+    }
+  }
+  for (size_t i = nfull*RBL; i < LEN; i++) BUF[i] = X(i,0);
+}
+
+/*----------------------------------------------------------------------
+  blocked_apply
+	op(A[i]) for every element of a tensor of NDIM dimensions
+----------------------------------------------------------------------*/
+template <typename T, size_t NDIM, class OP>
+void blocked_apply(libj::tensor<T>& A, const OP& op)
+{
+  const libj::tensor_matrix2<T,NDIM,0> A_MATRIX(A,"","");
+  constexpr size_t PACK_SIZE = blocked_pack_rows<T>();
+  const size_t PANEL_SIZE = blocked_panel_rows<T>();
+
+  const size_t end    = A_MATRIX.size();
+  const size_t npanel = (end + PANEL_SIZE - 1)/PANEL_SIZE;
+
+  #pragma omp parallel if (end >= libj::simd_par_min_n() && npanel > 1)
+  {
+    typename blocked_matrix<T>::type A_BLOCKED;
+
+    #pragma omp for schedule(static)
+    for (size_t panel = 0; panel < npanel; panel++)
+    {
+      const size_t panel_start = panel*PANEL_SIZE;
+      const size_t panel_end   = std::min(end,panel_start+PANEL_SIZE);
+
+      //loop over the L1 packs of the panel
+      for (size_t pack_start = panel_start; pack_start < panel_end;
+           pack_start += PACK_SIZE)
+      {
+        const size_t pack_len = std::min(panel_end-pack_start,PACK_SIZE);
+        A_BLOCKED.assign_to_block(A_MATRIX,pack_start,0);
+        if (blocked_contiguous(pack_len,A_BLOCKED)) {
+          T* a = A_BLOCKED.data();
+          for (size_t i = 0; i < pack_len; i++) op(a[i]);
+        } else {
+          blocked_pack(pack_len,A_BLOCKED,op);
+        }
+      }
+    }
+  }
+}
+
+/*----------------------------------------------------------------------
+  blocked_apply2
+	op(X[i],Y[i]) for every element of two tensors of the same
+	shape and NDIM dimensions
+----------------------------------------------------------------------*/
+template <typename T, size_t NDIM, class OP>
+void blocked_apply2(const libj::tensor<T>& X, libj::tensor<T>& Y, const OP& op)
+{
+  const libj::tensor_matrix2<T,NDIM,0> X_MATRIX(X,"","");
+  const libj::tensor_matrix2<T,NDIM,0> Y_MATRIX(Y,"","");
+  constexpr size_t PACK_SIZE = blocked_pack_rows<T>();
+  const size_t PANEL_SIZE = blocked_panel_rows<T>();
+
+  const size_t end    = Y_MATRIX.size();
+  const size_t npanel = (end + PANEL_SIZE - 1)/PANEL_SIZE;
+
+  #pragma omp parallel if (end >= libj::simd_par_min_n() && npanel > 1)
+  {
+    typename blocked_matrix<T>::type X_BLOCKED;
+    typename blocked_matrix<T>::type Y_BLOCKED;
+    T* BUF = libj::CachePool::local().L1_pointer<T>();
+
+    #pragma omp for schedule(static)
+    for (size_t panel = 0; panel < npanel; panel++)
+    {
+      const size_t panel_start = panel*PANEL_SIZE;
+      const size_t panel_end   = std::min(end,panel_start+PANEL_SIZE);
+
+      //loop over the L1 packs of the panel
+      for (size_t pack_start = panel_start; pack_start < panel_end;
+           pack_start += PACK_SIZE)
+      {
+        const size_t pack_len = std::min(panel_end-pack_start,PACK_SIZE);
+        X_BLOCKED.assign_to_block(X_MATRIX,pack_start,0);
+        Y_BLOCKED.assign_to_block(Y_MATRIX,pack_start,0);
+
+        //pack X into L1, unless it is already a line
+        const T* x = X_BLOCKED.data();
+        if (!blocked_contiguous(pack_len,X_BLOCKED))
+        {
+          blocked_gather(pack_len,X_BLOCKED,BUF);
+          x = BUF;
+        }
+
+        if (blocked_contiguous(pack_len,Y_BLOCKED)) {
+          T* y = Y_BLOCKED.data();
+          for (size_t i = 0; i < pack_len; i++) op(x[i],y[i]);
+        } else {
+          blocked_pack2(pack_len,x,Y_BLOCKED,op);
+        }
+      }
+    }
+  }
+}
+
+/*----------------------------------------------------------------------
+  blocked_rank
+	calls blocked_apply with the NDIM of the tensor, which is a
+	template parameter, for 1 up to LIBJ_TENSOR_MAX_DIM
+----------------------------------------------------------------------*/
+template <typename T, size_t NDIM = 1>
+struct blocked_rank
+{
+  template <class OP>
+  static void apply(const char* NAME, libj::tensor<T>& A, const OP& op)
+  {
+    if (A.dim() == NDIM) {blocked_apply<T,NDIM>(A,op);}
+    else {blocked_rank<T,NDIM+1>::apply(NAME,A,op);}
+  }
+
+  template <class OP>
+  static void apply2(const char* NAME, const libj::tensor<T>& X,
+                     libj::tensor<T>& Y, const OP& op)
+  {
+    if (Y.dim() == NDIM) {blocked_apply2<T,NDIM>(X,Y,op);}
+    else {blocked_rank<T,NDIM+1>::apply2(NAME,X,Y,op);}
+  }
+};
+
+template <typename T>
+struct blocked_rank<T,LIBJ_TENSOR_MAX_DIM+1>
+{
+  static void error(const char* NAME, const size_t ndim)
+  {
+    printf("ERROR %s \n",NAME);
+    printf("tensor has %zu dimensions, more than LIBJ_TENSOR_MAX_DIM = %d \n",
+           ndim,LIBJ_TENSOR_MAX_DIM);
+    exit(1);
+  }
+
+  template <class OP>
+  static void apply(const char* NAME, libj::tensor<T>& A, const OP& op)
+  {
+    error(NAME,A.dim());
+  }
+
+  template <class OP>
+  static void apply2(const char* NAME, const libj::tensor<T>& X,
+                     libj::tensor<T>& Y, const OP& op)
+  {
+    error(NAME,Y.dim());
+  }
+};
+
+/*----------------------------------------------------------------------
+  blocked_range
+	the runs [r0,r1) of this thread, an even split of NRUN
+----------------------------------------------------------------------*/
+inline void blocked_range(const size_t NRUN, size_t& r0, size_t& r1)
+{
+  r0 = 0;
+  r1 = NRUN;
+#if defined (_OPENMP)
+  const size_t nt = (size_t) omp_get_num_threads();
+  const size_t id = (size_t) omp_get_thread_num();
+  r0 = (NRUN*id)/nt;
+  r1 = (NRUN*(id+1))/nt;
+#endif
+}
+
+/*----------------------------------------------------------------------
+  blocked_lines
+	op.line on each fused line of A
+----------------------------------------------------------------------*/
+template <typename T, class OP>
+void blocked_lines(const libj::tensor_runs& R, T* A, const OP& op)
+{
+  const size_t N = R.num()*R.run();
+  #pragma omp parallel if (N >= libj::simd_par_min_n() && R.num() > 1)
+  {
+    size_t r0, r1;
+    blocked_range(R.num(),r0,r1);
+    R.walk(r0,r1,[&](const size_t oa, const size_t ob)
+    {
+      op.line(R.run(),A+oa,R.inc(0));
+    });
+  }
+}
+
+/*----------------------------------------------------------------------
+  blocked_lines2
+	op.line on each fused line of X and Y
+----------------------------------------------------------------------*/
+template <typename T, class OP>
+void blocked_lines2(const libj::tensor_runs& R, const T* X, T* Y, const OP& op)
+{
+  const size_t N = R.num()*R.run();
+  #pragma omp parallel if (N >= libj::simd_par_min_n() && R.num() > 1)
+  {
+    size_t r0, r1;
+    blocked_range(R.num(),r0,r1);
+    R.walk(r0,r1,[&](const size_t ox, const size_t oy)
+    {
+      op.line(R.run(),X+ox,R.inc(0),Y+oy,R.inc(1));
+    });
+  }
+}
+
+/*----------------------------------------------------------------------
+  blocked_dispatch
+	long fused lines to blocked_lines, the rest to the block
+	scatter matrices
+----------------------------------------------------------------------*/
+template <typename T, class OP>
+void blocked_dispatch(const char* NAME, libj::tensor<T>& A, const OP& op)
+{
+  const libj::tensor_runs R(A);
+  if (R.num() == 0) return;
+  if (R.run() >= BLOCKED_ROWS) {blocked_lines(R,A.data(),op);}
+  else {blocked_rank<T>::apply(NAME,A,op);}
+}
+
+template <typename T, class OP>
+void blocked_dispatch2(const char* NAME, const libj::tensor<T>& X,
+                       libj::tensor<T>& Y, const OP& op)
+{
+  const libj::tensor_runs R(X,Y);
+  if (R.num() == 0) return;
+  if (R.run() >= BLOCKED_ROWS) {blocked_lines2(R,X.data(),Y.data(),op);}
+  else {blocked_rank<T>::apply2(NAME,X,Y,op);}
+}
+
+/*----------------------------------------------------------------------
+  blocked_same_shape
+	exits if X and Y do not have the same lengths
+----------------------------------------------------------------------*/
+template <typename T>
+inline void blocked_same_shape(const char* NAME, const libj::tensor<T>& X,
+                               const libj::tensor<T>& Y)
+{
+  bool same = (X.dim() == Y.dim());
+  for (size_t d = 0; same && d < X.dim(); d++) same = (X.size(d) == Y.size(d));
+  if (!same)
+  {
+    printf("ERROR %s \n",NAME);
+    printf("X and Y do not have the same lengths \n");
+    exit(1);
+  }
+}
+
+}//end namespace
+
+#endif
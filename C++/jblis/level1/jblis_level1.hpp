@@ -10,18 +10,33 @@
     set
     scale
     copy
+    convert
+    permute
+    permute_inplace
+    permute_sum
+    diagonal
+    trace
+    axpby
+    dot
+    norm2
+    reduce_max
+    reduce
+    broadcast_add
+    denom
 
 ----------------------------------------------------------------------------------*/
 #ifndef JBLIS_L1_HPP
 #define JBLIS_L1_HPP
 
 #include <algorithm>
+#include <string>
+#include <vector>
 #include "tensor.hpp"
-#include "tensor_matrix.hpp"
-#include "scatter_matrix.hpp"
-#include "block_scatter_matrix.hpp"
+#include "tensor_matrix2.hpp"
+#include "block_scatter_matrix2.hpp"
 #include "libjdef.h"
 #include "cache.hpp"
+#include "simd_half.hpp"
 
 #if defined (__AVX512F__)
   #include <immintrin.h>
@@ -54,6 +69,12 @@ namespace libj
  * zero
  * 
  *  Set tensor to zero
+ *
+ *  zero, set, scal, copy and scopy take any tensor, 
+ *  including strided views. Sequential tensors are done 
+ *  with the simd_par kernels, others in blocks of a 
+ *  block_scatter_matrix2 (jblis_blocked.hpp), with no 
+ *  allocation either way
  * 
  * A 	-> tensor to zero  
 ---------------------------------------------------------*/
@@ -85,8 +106,8 @@ void scal(const T s, libj::tensor<T>& A);
 /*---------------------------------------------------------
  * Copy functions 
  *
- * Copy a scaled tensor X to tensor Y. Special cases of 
- * a == 1 and a == 0 are coded 
+ * Copy a scaled tensor X to tensor Y, which have the same
+ * lengths. Special cases of a == 1 and a == 0 are coded 
  *
  * a	-> scalar for X
  * X	-> tensor to copy from
@@ -97,5 +118,263 @@ void scopy(const T a, const libj::tensor<T>& X, libj::tensor<T>& Y);
 template <typename T>
 void copy(const libj::tensor<T>& X, libj::tensor<T>& Y);
 
+/*---------------------------------------------------------
+ * convert
+ *
+ * Copy X to Y of another type, with the same lengths,
+ *
+ *   Y = (TY) X
+ *
+ * e.g. a libj::tensor<libj::bf16> (or fp16, simd_half.hpp)
+ * store of amplitudes to and from a tensor<double> work
+ * copy, at a quarter of the memory. Lines with stride 1
+ * are simd_convert, which converts the 16 bit types a
+ * register at a time. Either may be a strided view.
+ *
+ * <TX,TY> -> any two of double, float, fp16, bf16, with
+ *            one of them double or float
+ *
+ * X	-> tensor to convert from
+ * Y	-> tensor to convert to
+---------------------------------------------------------*/
+template <typename TX, typename TY>
+void convert(const libj::tensor<TX>& X, libj::tensor<TY>& Y);
+
+/*---------------------------------------------------------
+ * permute
+ *
+ * Permute the indices of A into B, 
+ *
+ *   B(idxB) = alpha * A(idxA) + beta * B(idxB)
+ *
+ * where the labels of B are a permutation of those of A,
+ * e.g. libj::permute(A,"abcd",B,"acbd") is
+ * B(a,c,b,d) = A(a,b,c,d). A and B may be strided views.
+ * The fastest dimensions of A and B are transposed in
+ * tiles sized for L1, and a
+ * permutation that leaves the tensor in order is done with
+ * simd_copy. With beta == 0, B is not read.
+ *
+ * A     -> tensor to permute
+ * idxA  -> index labels of A
+ * B     -> result tensor
+ * idxB  -> index labels of B
+ * alpha -> scalar for A
+ * beta  -> scalar for B
+---------------------------------------------------------*/
+template <typename T>
+void permute(const libj::tensor<T>& A, const std::string& idxA,
+             libj::tensor<T>& B, const std::string& idxB,
+             const T alpha=(T) 1, const T beta=(T) 0);
+
+/*---------------------------------------------------------
+ * permute_inplace
+ *
+ * Permute the indices of A in its own memory,
+ *
+ *   A(idxB) = alpha * A(idxA)
+ *
+ * for when there is no room for a second tensor. A must be
+ * sequential, and is given the lengths of idxB (relength).
+ * The elements are moved around the cycles of the
+ * permutation, in parallel over the cycles, with one bit
+ * per element (or line) to mark those moved. When A and B
+ * have the same fastest dimension, runs of it are moved
+ * instead of single elements. This is a few times slower
+ * than permute, which should be used when memory allows.
+ *
+ * A     -> tensor to permute
+ * idxA  -> index labels of A
+ * idxB  -> index labels of A on return
+ * alpha -> scalar for A
+---------------------------------------------------------*/
+template <typename T>
+void permute_inplace(libj::tensor<T>& A, const std::string& idxA,
+                     const std::string& idxB, const T alpha=(T) 1);
+
+/*---------------------------------------------------------
+ * permute_sum
+ *
+ * Sum of permutations of A into B,
+ *
+ *   B(idxB) = beta * B(idxB) + sum_t alpha[t] * A(idxA[t])
+ *
+ * in one pass over B, e.g. the antisymmetrizer
+ * R(ijab) += X(ijab) - X(jiab) - X(ijba) + X(jiba) is
+ *
+ *   libj::permute_sum(X,{"ijab","jiab","ijba","jiba"},
+ *                     {1.,-1.,-1.,1.},R,"ijab");
+ *
+ * B is done in the tiles of permute, and each term is
+ * added to a tile while it is in L1, so there are no
+ * temporaries and B is read and written once. A and B
+ * may be strided views, but must not alias. With
+ * beta == 0, B is not read.
+ *
+ * A     -> tensor to permute
+ * idxA  -> index labels of A in each term
+ * alpha -> scalar of each term
+ * B     -> result tensor
+ * idxB  -> index labels of B
+ * beta  -> scalar for B
+---------------------------------------------------------*/
+template <typename T>
+void permute_sum(const libj::tensor<T>& A, const std::vector<std::string>& idxA,
+                 const std::vector<T>& alpha, libj::tensor<T>& B,
+                 const std::string& idxB, const T beta=(T) 1);
+
+/*---------------------------------------------------------
+ * diagonal, trace
+ *
+ * Diagonal of A, where the labels repeated in A are one
+ * index, and the partial trace, which also sums over the
+ * labels of A that are not in B,
+ *
+ *   B(idxB) = alpha * A(idxA) + beta * B(idxB)
+ *
+ * e.g. libj::diagonal(A,"iiab",B,"iab") is B(i,a,b) = 
+ * A(i,i,a,b), and libj::trace(A,"iiab",B,"ab") is B(a,b) =
+ * sum_i A(i,i,a,b). Each label of B is a label of A, once.
+ * The repeated labels are done as one dimension with the
+ * sum of their strides, so a diagonal is a permute of a
+ * strided view of A. The full trace, e.g. 
+ * libj::trace(A,"iijj"), sums over all the labels. A and B
+ * may be strided views. With beta == 0, B is not read.
+ *
+ * A     -> tensor
+ * idxA  -> index labels of A, with repeats
+ * B     -> result tensor
+ * idxB  -> index labels of B
+ * alpha -> scalar for A
+ * beta  -> scalar for B
+---------------------------------------------------------*/
+template <typename T>
+void diagonal(const libj::tensor<T>& A, const std::string& idxA,
+              libj::tensor<T>& B, const std::string& idxB,
+              const T alpha=(T) 1, const T beta=(T) 0);
+template <typename T>
+void trace(const libj::tensor<T>& A, const std::string& idxA,
+           libj::tensor<T>& B, const std::string& idxB,
+           const T alpha=(T) 1, const T beta=(T) 0);
+template <typename T>
+T trace(const libj::tensor<T>& A, const std::string& idxA);
+
+/*---------------------------------------------------------
+ * axpby
+ *
+ *   B(idxB) = alpha * A(idxA) + beta * B(idxB)
+ *
+ * the same as permute, with the BLAS argument order
+---------------------------------------------------------*/
+template <typename T>
+void axpby(const T alpha, const libj::tensor<T>& A, const std::string& idxA,
+           const T beta, libj::tensor<T>& B, const std::string& idxB);
+
+/*---------------------------------------------------------
+ * dot
+ *
+ * Full contraction of A and B,
+ *
+ *   sum = A(idxA) . B(idxB)
+ *
+ * where the labels of B are a permutation of those of A,
+ * e.g. libj::dot(A,"abcd",B,"badc"). A and B may be
+ * strided views, and are traversed as in permute.
+ *
+ * A     -> first tensor
+ * idxA  -> index labels of A
+ * B     -> second tensor
+ * idxB  -> index labels of B
+---------------------------------------------------------*/
+template <typename T>
+T dot(const libj::tensor<T>& A, const std::string& idxA,
+      const libj::tensor<T>& B, const std::string& idxB);
+
+/*---------------------------------------------------------
+ * norm2, reduce_max
+ *
+ * norm2      -> sqrt(sum A^2)
+ * reduce_max -> largest value in A, the lowest value of
+ *               the type if A is empty
+ *
+ * A     -> tensor, may be a strided view
+---------------------------------------------------------*/
+template <typename T>
+T norm2(const libj::tensor<T>& A);
+template <typename T>
+T reduce_max(const libj::tensor<T>& A);
+
+/*---------------------------------------------------------
+ * reduce
+ *
+ * Reduction of A over the labels that are not in B,
+ *
+ *   B(idxB) = op over the other labels of A(idxA)
+ *
+ * e.g. libj::reduce(T,"ijab",S,"a") is S(a) = sum_ijb 
+ * T(i,j,a,b), and with REDUCE_MAX, max_ijb T(i,j,a,b).
+ * Each label of B is a label of A, once. The stride 1
+ * dimension of A is kept innermost, and when B is too
+ * small to split over the threads, each thread reduces
+ * onto its own copy of B. A and B may be strided views.
+ * B is overwritten.
+ *
+ * A    -> tensor to reduce
+ * idxA -> index labels of A
+ * B    -> result tensor
+ * idxB -> index labels of B
+ * op   -> REDUCE_SUM, REDUCE_MAX or REDUCE_MIN
+---------------------------------------------------------*/
+enum reduce_op {REDUCE_SUM = 0, REDUCE_MAX, REDUCE_MIN};
+
+template <typename T>
+void reduce(const libj::tensor<T>& A, const std::string& idxA,
+            libj::tensor<T>& B, const std::string& idxB,
+            const int op=REDUCE_SUM);
+
+/*---------------------------------------------------------
+ * broadcast_add
+ *
+ * Add a vector along one dimension of A,
+ *
+ *   A(i,j,a,b) += alpha * V(a)		(axis 2)
+ *
+ * e.g. an orbital energy shift. Lines of stride 1 are done
+ * with the simd_ routines, and the lines are flattened
+ * into one parallel OpenMP loop. A may be a strided view.
+ *
+ * V     -> vector, of A.size(axis)
+ * A     -> tensor
+ * axis  -> dimension of A that V is along
+ * alpha -> scalar for V
+---------------------------------------------------------*/
+template <typename T>
+void broadcast_add(const T* V, libj::tensor<T>& A, const size_t axis,
+                   const T alpha=(T) 1);
+
+/*---------------------------------------------------------
+ * denom
+ *
+ * Apply a denominator made of one vector per dimension,
+ *
+ *   D(i,j,a,b) = shift + S[0]*E[0][i] + S[1]*E[1][j] + ...
+ *   A(i,j,a,b) = A(i,j,a,b) / D(i,j,a,b)  (divide)
+ *   A(i,j,a,b) = A(i,j,a,b) * D(i,j,a,b)  (otherwise)
+ *
+ * in one pass, without making D, e.g. the MP2 denominator
+ * libj::denom(T2,{eo,eo,ev,ev},{1.,1.,-1.,-1.}). A may be a
+ * strided view.
+ *
+ * A      -> tensor
+ * E      -> vector of each dimension, of A.size(d)
+ * S      -> factor (sign) of each vector
+ * divide -> divide by D, or multiply
+ * shift  -> constant of D, e.g. a level shift
+---------------------------------------------------------*/
+template <typename T>
+void denom(libj::tensor<T>& A, const std::vector<const T*>& E,
+           const std::vector<T>& S, const bool divide=true,
+           const T shift=(T) 0);
+
 }//end libj 
 #endif
@@ -0,0 +1,148 @@
+/*----------------------------------------------------------------------
+  jblis_strided.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for the strided_dims struct, which is used by the
+  level-1 routines that act on one or two strided tensors
+
+  The dimensions are taken in the order of the second tensor (B),
+  and matched to those of the first (A) by their labels. The
+  dimensions of length 1 are dropped, and neighbouring dimensions
+  which are also neighbours in A are fused, so that
+
+    - a permutation that leaves the tensors in order fuses down
+      to one dimension of stride 1 in both (trivial())
+    - otherwise, dimension 0 is the first (usually stride 1)
+      dimension of B, and stride_A() is the dimension with the
+      smallest stride in A
+
+  The other dimensions are then flattened into one outer index
+  (outer()), and offsets() gives the offsets in A and B. The
+  dimension lists are libj::dim_vector's, kept in the object, so a
+  strided_dims is made without touching the heap.
+
+  Usage
+  ------------------------
+  libj::strided_dims dims;
+  dims.make("libj::permute",A,"abcd",B,"acbd");
+  dims.make(A);		//one tensor, SB == SA
+
+----------------------------------------------------------------------*/
+#ifndef JBLIS_STRIDED_HPP
+#define JBLIS_STRIDED_HPP
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include "tensor.hpp"
+#include "dim_vector.hpp"
+
+namespace libj
+{
+
+/*----------------------------------------------------------------------
+  strided_error
+----------------------------------------------------------------------*/
+inline void strided_error(const char* NAME, const std::string& idxA,
+                          const std::string& idxB, const char* msg)
+{
+  printf("ERROR %s \n",NAME);
+  printf("%s \n",msg);
+  printf("A = %s, B = %s \n",idxA.c_str(),idxB.c_str());
+  exit(1);
+}
+
+struct strided_dims
+{
+  libj::dim_vector LEN;	//lengths of the fused dimensions
+  libj::dim_vector SA;		//strides in A
+  libj::dim_vector SB;		//strides in B
+
+  //add a dimension, fused with the last one if possible
+  void push(const size_t len, const size_t sa, const size_t sb)
+  {
+    if (len == 1) return;
+    const size_t n = LEN.size();
+    if (n > 0 && SA[n-1]*LEN[n-1] == sa && SB[n-1]*LEN[n-1] == sb)
+    {
+      LEN[n-1] *= len;
+    } else {
+      LEN.push_back(len);
+      SA.push_back(sa);
+      SB.push_back(sb);
+    }
+  }
+
+  //dimensions of B, matched to A by the labels
+  template <typename T>
+  void make(const char* NAME, const libj::tensor<T>& A, const std::string& idxA,
+            const libj::tensor<T>& B, const std::string& idxB)
+  {
+    if (idxA.length() != A.dim() || idxB.length() != B.dim() || A.dim() != B.dim())
+    {
+      strided_error(NAME,idxA,idxB,"The number of labels does not match the tensor dimensions");
+    }
+    LEN.clear(); SA.clear(); SB.clear();
+    for (size_t b=0;b<idxB.length();b++)
+    {
+      const size_t a = idxA.find(idxB[b]);
+      if (idxB.find(idxB[b]) != b) {strided_error(NAME,idxA,idxB,"Repeated label in B");}
+      if (a == std::string::npos)  {strided_error(NAME,idxA,idxB,"Label of B is not in A");}
+      if (A.size(a) != B.size(b))  {strided_error(NAME,idxA,idxB,"Lengths of A and B do not match");}
+      push(B.size(b),A.stride(a),B.stride(b));
+    }
+  }
+
+  //dimensions of one tensor
+  template <typename T>
+  void make(const libj::tensor<T>& A)
+  {
+    LEN.clear(); SA.clear(); SB.clear();
+    for (size_t d=0;d<A.dim();d++) push(A.size(d),A.stride(d),A.stride(d));
+  }
+
+  //one continuous dimension in both
+  bool trivial() const
+  {
+    return LEN.size() == 0 || (LEN.size() == 1 && SA[0] == 1 && SB[0] == 1);
+  }
+
+  //dimension with the smallest stride in A
+  size_t stride_A() const
+  {
+    size_t j = 0;
+    for (size_t d=1;d<LEN.size();d++) {if (SA[d] < SA[j]) j = d;}
+    return j;
+  }
+
+  //flattened outer index, over all but dimensions 0 and J
+  void outer(const size_t J, libj::dim_vector& DIMS, size_t& NOUT) const
+  {
+    DIMS.clear();
+    NOUT = 1;
+    for (size_t d=1;d<LEN.size();d++)
+    {
+      if (d != J) {DIMS.push_back(d); NOUT *= LEN[d];}
+    }
+  }
+
+  //offsets in A and B of the outer index I
+  void offsets(size_t I, const libj::dim_vector& DIMS, size_t& OA, size_t& OB) const
+  {
+    OA = 0;
+    OB = 0;
+    for (size_t d=0;d<DIMS.size();d++)
+    {
+      const size_t dim = DIMS[d];
+      const size_t idx = I%LEN[dim];
+      I /= LEN[dim];
+      OA += idx*SA[dim];
+      OB += idx*SB[dim];
+    }
+  }
+};
+
+}//end of namespace
+
+#endif
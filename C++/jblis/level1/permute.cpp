@@ -0,0 +1,592 @@
+/*----------------------------------------------------------------------
+  permute.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for the permute function, which performs
+
+    B(idxB) = alpha * A(idxA) + beta * B(idxB)
+
+  for a permutation of the indices of A
+
+  General flow is as follows
+
+  1) put the dimensions in the order of B, drop those of length 1,
+     and fuse neighbouring dimensions which are also neighbours
+     in A (libj::strided_dims). A trivial permutation fuses down
+     to one dimension, and is done with simd_par_copy (or axpby,
+     scal_mul)
+
+  2) if A and B have the same fastest dimension, loop through
+     the other dimensions and do each line
+
+  3) otherwise, B's fastest dimension (i) and A's fastest
+     dimension (j) are transposed in square tiles of
+     permute_block<T>() elements, which are sized so that the
+     tile of A and B both fit in L1. With AVX, the tiles are
+     done in 4x4 (double) or 8x8 (float) in-register transposes
+
+  The tiles (or lines) of all the other dimensions are flattened
+  into one parallel OpenMP loop.
+
+  permute_sum does the same tiles over B (dimension 0 and the
+  fastest dimension in A of the first term), with the dimensions
+  fused only where they fuse in every term, and adds each term to
+  the tile in turn.
+
+  permute_inplace moves the elements of one sequential tensor
+  around the cycles of the permutation. Unit u of the result (an
+  element, or a run of the shared fastest dimension of at most L1
+  bytes) is taken from unit permute_inplace_src(u) of A. Each
+  cycle is done by the thread that finds its smallest unit, so
+  the cycles are independent in the OpenMP loop, and a bitmap of
+  the moved units stops the other threads from walking them.
+
+----------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdint.h>
+#include <vector>
+#include <string>
+#include "jblis_level1.hpp"
+#include "jblis_strided.hpp"
+#include "simd.hpp"
+
+namespace libj
+{
+
+/*----------------------------------------------------------------------
+  permute_block
+	edge of the square tiles, the largest multiple of 8 such that
+	a tile of A and of B fit in the L1 (libj::CacheInfo)
+----------------------------------------------------------------------*/
+template <typename T>
+inline size_t permute_block()
+{
+  size_t bs = 8;
+  const size_t L1 = libj::CacheInfo::get().L1_bytes;
+  while (2*(bs+8)*(bs+8)*sizeof(T) <= L1) bs += 8;
+  return bs;
+}
+
+/*----------------------------------------------------------------------
+  permute_micro
+	in-register transpose of a WxW tile,
+	  B(i,j) = alpha*A(j,i) + beta*B(i,j)
+	where A has a col stride of SA and B of SB. W == 0 means
+	there is no microkernel for this type
+----------------------------------------------------------------------*/
+template <typename T>
+struct permute_micro
+{
+  static const size_t W = 0;
+  static inline void run(const T alpha, const T* A, const size_t SA,
+                         const T beta, T* B, const size_t SB) {}
+};
+
+#if defined LIBJ_AVX
+template <>
+struct permute_micro<double>
+{
+  static const size_t W = 4;
+  static inline void store(const double alpha, const __m256d c, const double beta, double* B)
+  {
+    __m256d v = _mm256_mul_pd(_mm256_set1_pd(alpha),c);
+    if (beta != 0) v = _mm256_add_pd(v,_mm256_mul_pd(_mm256_set1_pd(beta),_mm256_loadu_pd(B)));
+    _mm256_storeu_pd(B,v);
+  }
+  static inline void run(const double alpha, const double* A, const size_t SA,
+                         const double beta, double* B, const size_t SB)
+  {
+    const __m256d r0 = _mm256_loadu_pd(A+0*SA);
+    const __m256d r1 = _mm256_loadu_pd(A+1*SA);
+    const __m256d r2 = _mm256_loadu_pd(A+2*SA);
+    const __m256d r3 = _mm256_loadu_pd(A+3*SA);
+
+    const __m256d t0 = _mm256_unpacklo_pd(r0,r1);
+    const __m256d t1 = _mm256_unpackhi_pd(r0,r1);
+    const __m256d t2 = _mm256_unpacklo_pd(r2,r3);
+    const __m256d t3 = _mm256_unpackhi_pd(r2,r3);
+
+    store(alpha,_mm256_permute2f128_pd(t0,t2,0x20),beta,B+0*SB);
+    store(alpha,_mm256_permute2f128_pd(t1,t3,0x20),beta,B+1*SB);
+    store(alpha,_mm256_permute2f128_pd(t0,t2,0x31),beta,B+2*SB);
+    store(alpha,_mm256_permute2f128_pd(t1,t3,0x31),beta,B+3*SB);
+  }
+};
+
+template <>
+struct permute_micro<float>
+{
+  static const size_t W = 8;
+  static inline void store(const float alpha, const __m256 c, const float beta, float* B)
+  {
+    __m256 v = _mm256_mul_ps(_mm256_set1_ps(alpha),c);
+    if (beta != 0) v = _mm256_add_ps(v,_mm256_mul_ps(_mm256_set1_ps(beta),_mm256_loadu_ps(B)));
+    _mm256_storeu_ps(B,v);
+  }
+  static inline void run(const float alpha, const float* A, const size_t SA,
+                         const float beta, float* B, const size_t SB)
+  {
+    const __m256 r0 = _mm256_loadu_ps(A+0*SA);
+    const __m256 r1 = _mm256_loadu_ps(A+1*SA);
+    const __m256 r2 = _mm256_loadu_ps(A+2*SA);
+    const __m256 r3 = _mm256_loadu_ps(A+3*SA);
+    const __m256 r4 = _mm256_loadu_ps(A+4*SA);
+    const __m256 r5 = _mm256_loadu_ps(A+5*SA);
+    const __m256 r6 = _mm256_loadu_ps(A+6*SA);
+    const __m256 r7 = _mm256_loadu_ps(A+7*SA);
+
+    const __m256 t0 = _mm256_unpacklo_ps(r0,r1);
+    const __m256 t1 = _mm256_unpackhi_ps(r0,r1);
+    const __m256 t2 = _mm256_unpacklo_ps(r2,r3);
+    const __m256 t3 = _mm256_unpackhi_ps(r2,r3);
+    const __m256 t4 = _mm256_unpacklo_ps(r4,r5);
+    const __m256 t5 = _mm256_unpackhi_ps(r4,r5);
+    const __m256 t6 = _mm256_unpacklo_ps(r6,r7);
+    const __m256 t7 = _mm256_unpackhi_ps(r6,r7);
+
+    const __m256 u0 = _mm256_shuffle_ps(t0,t2,_MM_SHUFFLE(1,0,1,0));
+    const __m256 u1 = _mm256_shuffle_ps(t0,t2,_MM_SHUFFLE(3,2,3,2));
+    const __m256 u2 = _mm256_shuffle_ps(t1,t3,_MM_SHUFFLE(1,0,1,0));
+    const __m256 u3 = _mm256_shuffle_ps(t1,t3,_MM_SHUFFLE(3,2,3,2));
+    const __m256 u4 = _mm256_shuffle_ps(t4,t6,_MM_SHUFFLE(1,0,1,0));
+    const __m256 u5 = _mm256_shuffle_ps(t4,t6,_MM_SHUFFLE(3,2,3,2));
+    const __m256 u6 = _mm256_shuffle_ps(t5,t7,_MM_SHUFFLE(1,0,1,0));
+    const __m256 u7 = _mm256_shuffle_ps(t5,t7,_MM_SHUFFLE(3,2,3,2));
+
+    store(alpha,_mm256_permute2f128_ps(u0,u4,0x20),beta,B+0*SB);
+    store(alpha,_mm256_permute2f128_ps(u1,u5,0x20),beta,B+1*SB);
+    store(alpha,_mm256_permute2f128_ps(u2,u6,0x20),beta,B+2*SB);
+    store(alpha,_mm256_permute2f128_ps(u3,u7,0x20),beta,B+3*SB);
+    store(alpha,_mm256_permute2f128_ps(u0,u4,0x31),beta,B+4*SB);
+    store(alpha,_mm256_permute2f128_ps(u1,u5,0x31),beta,B+5*SB);
+    store(alpha,_mm256_permute2f128_ps(u2,u6,0x31),beta,B+6*SB);
+    store(alpha,_mm256_permute2f128_ps(u3,u7,0x31),beta,B+7*SB);
+  }
+};
+#endif
+
+/*----------------------------------------------------------------------
+  permute_tile
+	B(i,j) = alpha*A(j,i) + beta*B(i,j), for an NI x NJ tile,
+	where B(i,j) is at B[i*SBI+j*SBJ] and A(j,i) is at
+	A[j*SAJ+i*SAI]. The microkernels need SBI == SAJ == 1
+----------------------------------------------------------------------*/
+template <typename T>
+inline void permute_tile(const size_t NI, const size_t NJ, const T alpha, const T* A,
+                         const size_t SAI, const size_t SAJ, const T beta, T* B,
+                         const size_t SBI, const size_t SBJ)
+{
+  const size_t W  = (SAJ == 1 && SBI == 1) ? permute_micro<T>::W : 0;
+  const size_t WW = (W > 0) ? W : 1;
+  const size_t MI = (W > 0) ? NI - NI%WW : 0;
+  const size_t MJ = (W > 0) ? NJ - NJ%WW : 0;
+
+  //microkernels
+  for (size_t j=0;j<MJ;j+=W)
+  {
+    for (size_t i=0;i<MI;i+=W)
+    {
+      permute_micro<T>::run(alpha,A+j+i*SAI,SAI,beta,B+i+j*SBJ,SBJ);
+    }
+  }
+
+  //cleanup the edges
+  for (size_t j=0;j<NJ;j++)
+  {
+    const size_t i0 = (j < MJ) ? MI : 0;
+    const T* aa = A+j*SAJ;
+    T* bb = B+j*SBJ;
+    if (beta == (T) 0)
+    {
+      for (size_t i=i0;i<NI;i++) bb[i*SBI] = alpha*aa[i*SAI];
+    } else {
+      for (size_t i=i0;i<NI;i++) bb[i*SBI] = alpha*aa[i*SAI] + beta*bb[i*SBI];
+    }
+  }
+}
+
+/*----------------------------------------------------------------------
+  permute_line
+	B = alpha*A + beta*B for N elements, with strides SA and SB
+----------------------------------------------------------------------*/
+template <typename T>
+inline void permute_line(const size_t N, const T alpha, const T* A, const size_t SA,
+                         const T beta, T* B, const size_t SB)
+{
+  if (SA == 1 && SB == 1)
+  {
+    if (beta == (T) 0)
+    {
+      if (alpha == (T) 1) {simd_auto_copy<T>(N,A,B);}
+      else {for (size_t i=0;i<N;i++) B[i] = alpha*A[i];}
+    } else {
+      simd_auto_axpby<T>(N,alpha,A,beta,B);
+    }
+  } else if (beta == (T) 0) {
+    for (size_t i=0;i<N;i++) B[i*SB] = alpha*A[i*SA];
+  } else {
+    for (size_t i=0;i<N;i++) B[i*SB] = alpha*A[i*SA] + beta*B[i*SB];
+  }
+}
+
+/*----------------------------------------------------------------------
+  General code
+----------------------------------------------------------------------*/
+template <typename T>
+void permute(const libj::tensor<T>& A, const std::string& idxA,
+             libj::tensor<T>& B, const std::string& idxB,
+             const T alpha, const T beta)
+{
+  libj::strided_dims dims;
+  dims.make("libj::permute",A,idxA,B,idxB);
+
+  //trivial permutation
+  if (dims.trivial())
+  {
+    const long N = (long) B.size();
+    if (beta == (T) 0)
+    {
+      simd_par_copy<T>(N,A.data(),B.data());
+      if (alpha != (T) 1) simd_par_scal_mul<T>(N,alpha,B.data());
+    } else {
+      simd_par_axpby<T>(N,alpha,A.data(),beta,B.data());
+    }
+    return;
+  }
+
+  const T* AP = A.data();
+  T*       BP = B.data();
+  const size_t j1 = dims.stride_A();
+  libj::dim_vector OUTER;
+  size_t NOUT;
+  dims.outer(j1,OUTER,NOUT);
+
+  if (j1 == 0)
+  {
+    //same fastest dimension, lines
+    const size_t N  = dims.LEN[0];
+    const size_t SA = dims.SA[0];
+    const size_t SB = dims.SB[0];
+
+    #pragma omp parallel for schedule(static)
+    for (long o=0;o<(long) NOUT;o++)
+    {
+      size_t oa,ob;
+      dims.offsets((size_t) o,OUTER,oa,ob);
+      permute_line<T>(N,alpha,AP+oa,SA,beta,BP+ob,SB);
+    }
+
+  } else {
+    //transpose of dimensions 0 (fastest in B) and j1 (fastest in A)
+    const size_t BS  = permute_block<T>();
+    const size_t NI  = dims.LEN[0];
+    const size_t NJ  = dims.LEN[j1];
+    const size_t NBI = (NI + BS - 1)/BS;
+    const size_t NBJ = (NJ + BS - 1)/BS;
+    const size_t SAI = dims.SA[0];
+    const size_t SAJ = dims.SA[j1];
+    const size_t SBI = dims.SB[0];
+    const size_t SBJ = dims.SB[j1];
+
+    #pragma omp parallel for schedule(static)
+    for (long t=0;t<(long) (NOUT*NBI*NBJ);t++)
+    {
+      const size_t bi = (size_t) t%NBI;
+      const size_t bj = ((size_t) t/NBI)%NBJ;
+      const size_t o  = (size_t) t/(NBI*NBJ);
+      size_t oa,ob;
+      dims.offsets(o,OUTER,oa,ob);
+
+      const size_t i0 = bi*BS;
+      const size_t j0 = bj*BS;
+      permute_tile<T>(std::min(BS,NI-i0),std::min(BS,NJ-j0),alpha,
+                      AP+oa+j0*SAJ+i0*SAI,SAI,SAJ,beta,BP+ob+i0*SBI+j0*SBJ,SBI,SBJ);
+    }
+  }
+}
+template void libj::permute<double>(const libj::tensor<double>& A, const std::string& idxA,
+                                    libj::tensor<double>& B, const std::string& idxB,
+                                    const double alpha, const double beta);
+template void libj::permute<float>(const libj::tensor<float>& A, const std::string& idxA,
+                                   libj::tensor<float>& B, const std::string& idxB,
+                                   const float alpha, const float beta);
+template void libj::permute<long>(const libj::tensor<long>& A, const std::string& idxA,
+                                  libj::tensor<long>& B, const std::string& idxB,
+                                  const long alpha, const long beta);
+template void libj::permute<int>(const libj::tensor<int>& A, const std::string& idxA,
+                                 libj::tensor<int>& B, const std::string& idxB,
+                                 const int alpha, const int beta);
+
+/*----------------------------------------------------------------------
+  permute_sum
+----------------------------------------------------------------------*/
+template <typename T>
+void permute_sum(const libj::tensor<T>& A, const std::vector<std::string>& idxA,
+                 const std::vector<T>& alpha, libj::tensor<T>& B,
+                 const std::string& idxB, const T beta)
+{
+  const size_t NT = idxA.size();
+  if (NT == 0 || alpha.size() != NT)
+  {
+    strided_error("libj::permute_sum",NT ? idxA[0] : std::string(),idxB,
+                  "There must be one alpha for each of one or more terms");
+  }
+  if (can_alias(A,B))
+  {
+    strided_error("libj::permute_sum",idxA[0],idxB,"A and B can alias");
+  }
+
+  //dimensions of B, fused where they fuse in every term, SA[t][d] 
+  std::vector<std::vector<size_t> > DA(NT);
+  for (size_t t=0;t<NT;t++)
+  {
+    libj::strided_dims check;
+    check.make("libj::permute_sum",A,idxA[t],B,idxB);
+    for (size_t b=0;b<idxB.length();b++) DA[t].push_back(A.stride(idxA[t].find(idxB[b])));
+  }
+  std::vector<size_t> LEN, SB;
+  std::vector<std::vector<size_t> > SA(NT);
+  for (size_t b=0;b<idxB.length();b++)
+  {
+    if (B.size(b) == 1) continue;
+    const size_t n = LEN.size();
+    bool fuse = (n > 0 && SB[n-1]*LEN[n-1] == B.stride(b));
+    for (size_t t=0;fuse && t<NT;t++) fuse = (SA[t][n-1]*LEN[n-1] == DA[t][b]);
+    if (fuse)
+    {
+      LEN[n-1] *= B.size(b);
+    } else {
+      LEN.push_back(B.size(b));
+      SB.push_back(B.stride(b));
+      for (size_t t=0;t<NT;t++) SA[t].push_back(DA[t][b]);
+    }
+  }
+  if (LEN.size() == 0)
+  {
+    LEN.push_back(1);
+    SB.push_back(0);
+    for (size_t t=0;t<NT;t++) SA[t].push_back(0);
+  }
+
+  //tiles of dimension 0 and J, the fastest of the others in A of term 0
+  size_t J = 0;
+  for (size_t d=1;d<LEN.size();d++) {if (J == 0 || SA[0][d] < SA[0][J]) J = d;}
+  libj::dim_vector OUTER;
+  size_t NOUT = 1;
+  for (size_t d=1;d<LEN.size();d++) {if (d != J) {OUTER.push_back(d); NOUT *= LEN[d];}}
+
+  const T*     AP  = A.data();
+  T*           BP  = B.data();
+  const size_t BS  = permute_block<T>();
+  const size_t NI  = LEN[0];
+  const size_t NJ  = (J > 0) ? LEN[J] : 1;
+  const size_t NBI = (NI + BS - 1)/BS;
+  const size_t NBJ = (NJ + BS - 1)/BS;
+  const size_t SBI = SB[0];
+  const size_t SBJ = (J > 0) ? SB[J] : 0;
+
+  #pragma omp parallel
+  {
+    std::vector<size_t> OA(NT);
+
+    #pragma omp for schedule(static)
+    for (long tile=0;tile<(long) (NOUT*NBI*NBJ);tile++)
+    {
+      const size_t bi = (size_t) tile%NBI;
+      const size_t bj = ((size_t) tile/NBI)%NBJ;
+      size_t       o  = (size_t) tile/(NBI*NBJ);
+      size_t       ob = 0;
+      for (size_t t=0;t<NT;t++) OA[t] = 0;
+      for (size_t d=0;d<OUTER.size();d++)
+      {
+        const size_t idx = o%LEN[OUTER[d]];
+        o /= LEN[OUTER[d]];
+        ob += idx*SB[OUTER[d]];
+        for (size_t t=0;t<NT;t++) OA[t] += idx*SA[t][OUTER[d]];
+      }
+
+      const size_t i0 = bi*BS;
+      const size_t j0 = bj*BS;
+      const size_t ni = std::min(BS,NI-i0);
+      const size_t nj = std::min(BS,NJ-j0);
+      T* bb = BP+ob+i0*SBI+j0*SBJ;
+      for (size_t t=0;t<NT;t++)
+      {
+        const size_t SAI = SA[t][0];
+        const size_t SAJ = (J > 0) ? SA[t][J] : 0;
+        permute_tile<T>(ni,nj,alpha[t],AP+OA[t]+j0*SAJ+i0*SAI,SAI,SAJ,
+                        (t == 0) ? beta : (T) 1,bb,SBI,SBJ);
+      }
+    }
+  }
+}
+template void libj::permute_sum<double>(const libj::tensor<double>& A, const std::vector<std::string>& idxA,
+                                        const std::vector<double>& alpha, libj::tensor<double>& B,
+                                        const std::string& idxB, const double beta);
+template void libj::permute_sum<float>(const libj::tensor<float>& A, const std::vector<std::string>& idxA,
+                                       const std::vector<float>& alpha, libj::tensor<float>& B,
+                                       const std::string& idxB, const float beta);
+template void libj::permute_sum<long>(const libj::tensor<long>& A, const std::vector<std::string>& idxA,
+                                      const std::vector<long>& alpha, libj::tensor<long>& B,
+                                      const std::string& idxB, const long beta);
+template void libj::permute_sum<int>(const libj::tensor<int>& A, const std::vector<std::string>& idxA,
+                                     const std::vector<int>& alpha, libj::tensor<int>& B,
+                                     const std::string& idxB, const int beta);
+
+/*----------------------------------------------------------------------
+  permute_inplace_src
+	unit of A that goes to unit u of the result, where the units
+	of the result are sequential over LEN, and have strides S in A
+----------------------------------------------------------------------*/
+inline size_t permute_inplace_src(size_t u, const libj::dim_vector& LEN,
+                                  const libj::dim_vector& S)
+{
+  size_t src = 0;
+  for (size_t d=0;d<LEN.size();d++)
+  {
+    src += (u%LEN[d])*S[d];
+    u /= LEN[d];
+  }
+  return src;
+}
+
+/*----------------------------------------------------------------------
+  permute_inplace_moved
+	bit of unit u in the bitmap, which is shared by the threads
+----------------------------------------------------------------------*/
+inline bool permute_inplace_moved(const uint64_t* MOVED, const size_t u)
+{
+  uint64_t word;
+  #pragma omp atomic read
+  word = MOVED[u/64];
+  return (word >> (u%64)) & 1;
+}
+
+inline void permute_inplace_mark(uint64_t* MOVED, const size_t u)
+{
+  const uint64_t bit = ((uint64_t) 1) << (u%64);
+  #pragma omp atomic update
+  MOVED[u/64] |= bit;
+}
+
+/*----------------------------------------------------------------------
+  permute_inplace
+----------------------------------------------------------------------*/
+template <typename T>
+void permute_inplace(libj::tensor<T>& A, const std::string& idxA,
+                     const std::string& idxB, const T alpha)
+{
+  if (!A.is_set() || !A.is_sequential())
+  {
+    strided_error("libj::permute_inplace",idxA,idxB,"A is not set, or not sequential");
+  }
+  if (idxA.length() != A.dim() || idxB.length() != A.dim())
+  {
+    strided_error("libj::permute_inplace",idxA,idxB,"The number of labels does not match the tensor dimensions");
+  }
+
+  //the result, over the memory of A
+  std::vector<size_t> LB(idxB.length());
+  for (size_t b=0;b<idxB.length();b++)
+  {
+    const size_t a = idxA.find(idxB[b]);
+    if (a == std::string::npos) {strided_error("libj::permute_inplace",idxA,idxB,"Label of B is not in A");}
+    LB[b] = A.size(a);
+  }
+  libj::tensor<T> B;
+  B.assign(A.data(),LB);
+  libj::strided_dims dims;
+  dims.make("libj::permute_inplace",A,idxA,B,idxB);
+  T* AP = A.data();
+
+  if (!dims.trivial())
+  {
+    //units of L0 elements, a divisor of the shared fastest dimension
+    size_t L0 = 1;
+    if (dims.SA[0] == 1)
+    {
+      const size_t cap = std::max((size_t) 1,libj::CacheInfo::get().L1_elements<T>());
+      for (L0 = std::min(cap,dims.LEN[0]); dims.LEN[0]%L0 != 0; L0--) {}
+    }
+    libj::dim_vector LEN, S;
+    if (dims.LEN[0]/L0 > 1) {LEN.push_back(dims.LEN[0]/L0); S.push_back(dims.SA[0]);}
+    for (size_t d=1;d<dims.LEN.size();d++) {LEN.push_back(dims.LEN[d]); S.push_back(dims.SA[d]/L0);}
+    const size_t NU = A.size()/L0;
+
+    std::vector<uint64_t> MOVED((NU+63)/64,0);
+    uint64_t* MP = MOVED.data();
+
+    #pragma omp parallel
+    {
+      std::vector<T> tmp(L0);
+
+      #pragma omp for schedule(dynamic,1024)
+      for (long us=0;us<(long) NU;us++)
+      {
+        const size_t s = (size_t) us;
+        if (permute_inplace_moved(MP,s)) continue;
+
+        //only the smallest unit of a cycle moves it
+        bool lead = true;
+        size_t q = permute_inplace_src(s,LEN,S);
+        while (q != s)
+        {
+          if (q < s || permute_inplace_moved(MP,q)) {lead = false; break;}
+          q = permute_inplace_src(q,LEN,S);
+        }
+        if (!lead) continue;
+
+        size_t p = s;
+        q = permute_inplace_src(s,LEN,S);
+        if (q != s)
+        {
+          if (L0 == 1) {tmp[0] = AP[s];}
+          else {simd_auto_copy<T>((long) L0,AP+s*L0,tmp.data());}
+          while (q != s)
+          {
+            if (L0 == 1) {AP[p] = AP[q];}
+            else {simd_auto_copy<T>((long) L0,AP+q*L0,AP+p*L0);}
+            permute_inplace_mark(MP,p);
+            p = q;
+            q = permute_inplace_src(p,LEN,S);
+          }
+          if (L0 == 1) {AP[p] = tmp[0];}
+          else {simd_auto_copy<T>((long) L0,tmp.data(),AP+p*L0);}
+        }
+        permute_inplace_mark(MP,p);
+      }
+    }
+  }
+
+  if (alpha != (T) 1) simd_par_scal_mul<T>((long) A.size(),alpha,AP);
+  A.relength(LB);
+}
+template void libj::permute_inplace<double>(libj::tensor<double>& A, const std::string& idxA,
+                                            const std::string& idxB, const double alpha);
+template void libj::permute_inplace<float>(libj::tensor<float>& A, const std::string& idxA,
+                                           const std::string& idxB, const float alpha);
+template void libj::permute_inplace<long>(libj::tensor<long>& A, const std::string& idxA,
+                                          const std::string& idxB, const long alpha);
+template void libj::permute_inplace<int>(libj::tensor<int>& A, const std::string& idxA,
+                                         const std::string& idxB, const int alpha);
+
+/*----------------------------------------------------------------------
+  axpby
+	B(idxB) = alpha * A(idxA) + beta * B(idxB), which is permute
+----------------------------------------------------------------------*/
+template <typename T>
+void axpby(const T alpha, const libj::tensor<T>& A, const std::string& idxA,
+           const T beta, libj::tensor<T>& B, const std::string& idxB)
+{
+  libj::permute<T>(A,idxA,B,idxB,alpha,beta);
+}
+template void libj::axpby<double>(const double alpha, const libj::tensor<double>& A, const std::string& idxA,
+                                  const double beta, libj::tensor<double>& B, const std::string& idxB);
+template void libj::axpby<float>(const float alpha, const libj::tensor<float>& A, const std::string& idxA,
+                                 const float beta, libj::tensor<float>& B, const std::string& idxB);
+template void libj::axpby<long>(const long alpha, const libj::tensor<long>& A, const std::string& idxA,
+                                const long beta, libj::tensor<long>& B, const std::string& idxB);
+template void libj::axpby<int>(const int alpha, const libj::tensor<int>& A, const std::string& idxA,
+                               const int beta, libj::tensor<int>& B, const std::string& idxB);
+
+}//end of namespace
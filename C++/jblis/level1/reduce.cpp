@@ -0,0 +1,364 @@
+/*----------------------------------------------------------------------
+  reduce.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for the reductions of a single tensor
+
+    norm2      : sqrt(sum A(i)^2)
+    reduce_max : largest value of A
+    reduce     : sum, max or min over some of the labels of A
+
+  The dimensions of length 1 are dropped and neighbours are fused
+  (libj::strided_dims), so a dense tensor is one line and is done
+  with the simd_par_ routines. Otherwise, the lines along the first
+  dimension are flattened into one parallel OpenMP loop
+
+  reduce keeps the dimension of A with the smallest stride (usually
+  stride 1) innermost, fused with its neighbours in A where B allows.
+  If it is a label of B, lines of A are reduced onto lines of B,
+  which are cut into chunks of half of L1, otherwise each line of A
+  is reduced to one value. The chunks (or elements) of B are done
+  by one thread each, looping over the other summed dimensions, so
+  the threads never write the same element. When there are too few
+  of them for the threads, e.g. S(a) = sum_ijb T(ijab) for a short
+  a, each thread reduces all of its part of A onto a dense copy of
+  B, and the copies are combined at the end
+
+----------------------------------------------------------------------*/
+#include <stdio.h>
+#include <math.h>
+#include <limits>
+#include <string>
+#include <vector>
+#include "jblis_level1.hpp"
+#include "jblis_strided.hpp"
+#include "simd.hpp"
+
+namespace libj
+{
+
+/*----------------------------------------------------------------------
+  norm2
+----------------------------------------------------------------------*/
+template <typename T>
+T norm2(const libj::tensor<T>& A)
+{
+  libj::strided_dims dims;
+  dims.make(A);
+
+  const T* AP = A.data();
+  if (dims.trivial())
+  {
+    return (T) sqrt((double) simd_par_dot<T>((long) A.size(),AP,AP));
+  }
+
+  libj::dim_vector OUTER;
+  size_t NOUT;
+  dims.outer(0,OUTER,NOUT);
+  const long N  = (long) dims.LEN[0];
+  const long SA = (long) dims.SA[0];
+
+  T sum = (T) 0;
+  #pragma omp parallel for schedule(static) reduction(+:sum)
+  for (long o=0;o<(long) NOUT;o++)
+  {
+    size_t oa,ob;
+    dims.offsets((size_t) o,OUTER,oa,ob);
+    sum += (SA == 1) ? simd_auto_dot<T>(N,AP+oa,AP+oa) : simd_dot_strided<T>(N,AP+oa,SA,AP+oa,SA);
+  }
+  return (T) sqrt((double) sum);
+}
+template double libj::norm2<double>(const libj::tensor<double>& A);
+template float libj::norm2<float>(const libj::tensor<float>& A);
+template long libj::norm2<long>(const libj::tensor<long>& A);
+template int libj::norm2<int>(const libj::tensor<int>& A);
+
+/*----------------------------------------------------------------------
+  reduce_max
+----------------------------------------------------------------------*/
+template <typename T>
+T reduce_max(const libj::tensor<T>& A)
+{
+  libj::strided_dims dims;
+  dims.make(A);
+
+  const T* AP = A.data();
+  T val = std::numeric_limits<T>::lowest();
+  if (dims.LEN.size() == 0) return (A.size() > 0) ? AP[0] : val;
+
+  libj::dim_vector OUTER;
+  size_t NOUT;
+  dims.outer(0,OUTER,NOUT);
+  const size_t N  = dims.LEN[0];
+  const size_t SA = dims.SA[0];
+
+  //a dense tensor is one line, so it is split over the threads
+  if (NOUT == 1 && SA == 1)
+  {
+    #pragma omp parallel for schedule(static) reduction(max:val)
+    for (long i=0;i<(long) N;i++) val = std::max(val,AP[i]);
+    return val;
+  }
+
+  #pragma omp parallel for schedule(static) reduction(max:val)
+  for (long o=0;o<(long) NOUT;o++)
+  {
+    size_t oa,ob;
+    dims.offsets((size_t) o,OUTER,oa,ob);
+    const T* aa = AP+oa;
+    for (size_t i=0;i<N;i++) val = std::max(val,aa[i*SA]);
+  }
+  return val;
+}
+template double libj::reduce_max<double>(const libj::tensor<double>& A);
+template float libj::reduce_max<float>(const libj::tensor<float>& A);
+template long libj::reduce_max<long>(const libj::tensor<long>& A);
+template int libj::reduce_max<int>(const libj::tensor<int>& A);
+
+/*----------------------------------------------------------------------
+  reduce_identity, reduce_one
+	the value to start from, and one step of the op
+----------------------------------------------------------------------*/
+template <typename T>
+inline T reduce_identity(const int op)
+{
+  if (op == REDUCE_MAX) return std::numeric_limits<T>::lowest();
+  if (op == REDUCE_MIN) return std::numeric_limits<T>::max();
+  return (T) 0;
+}
+
+template <typename T>
+inline T reduce_one(const int op, const T x, const T y)
+{
+  if (op == REDUCE_MAX) return std::max(x,y);
+  if (op == REDUCE_MIN) return std::min(x,y);
+  return x + y;
+}
+
+/*----------------------------------------------------------------------
+  reduce_onto
+	B(i*SB) = op(B(i*SB),A(i*SA)), i = 0, ..., N-1
+----------------------------------------------------------------------*/
+template <typename T>
+inline void reduce_onto(const int op, const long N, const T* A, const size_t SA,
+                        T* B, const size_t SB)
+{
+  if (op == REDUCE_SUM)
+  {
+    if (SA == 1 && SB == 1) {simd_auto_axpy<T>(N,(T) 1,A,B);}
+    else {for (long i=0;i<N;i++) B[i*SB] += A[i*SA];}
+  } else if (op == REDUCE_MAX) {
+    for (long i=0;i<N;i++) B[i*SB] = std::max(B[i*SB],A[i*SA]);
+  } else {
+    for (long i=0;i<N;i++) B[i*SB] = std::min(B[i*SB],A[i*SA]);
+  }
+}
+
+/*----------------------------------------------------------------------
+  reduce_line
+	op over A(i*SA), i = 0, ..., N-1, from val
+----------------------------------------------------------------------*/
+template <typename T>
+inline T reduce_line(const int op, const long N, const T* A, const size_t SA, T val)
+{
+  if (op == REDUCE_SUM)
+  {
+    if (SA == 1) {return val + simd_auto_reduction_add<T>(N,A);}
+    for (long i=0;i<N;i++) val += A[i*SA];
+  } else if (op == REDUCE_MAX) {
+    for (long i=0;i<N;i++) val = std::max(val,A[i*SA]);
+  } else {
+    for (long i=0;i<N;i++) val = std::min(val,A[i*SA]);
+  }
+  return val;
+}
+
+/*----------------------------------------------------------------------
+  reduce_dims
+	the dimensions of A in its order, with their strides in A, in
+	B (SB, 0 if summed), and in a dense copy of B (SD)
+----------------------------------------------------------------------*/
+struct reduce_dims
+{
+  libj::dim_vector LEN, SA, SB, SD;
+  libj::dim_vector KEPT;	//1 if the dimension is in B
+
+  void push(const size_t len, const size_t sa, const size_t sb, const size_t sd,
+            const bool kept)
+  {
+    if (len == 1) return;
+    const size_t n = LEN.size();
+    if (n > 0 && (KEPT[n-1] != 0) == kept && SA[n-1]*LEN[n-1] == sa &&
+        SB[n-1]*LEN[n-1] == sb && SD[n-1]*LEN[n-1] == sd)
+    {
+      LEN[n-1] *= len;
+    } else {
+      LEN.push_back(len);
+      SA.push_back(sa);
+      SB.push_back(sb);
+      SD.push_back(sd);
+      KEPT.push_back(kept ? 1 : 0);
+    }
+  }
+
+  //offsets of index I over the dimensions DIMS
+  void offsets(size_t I, const libj::dim_vector& DIMS, size_t& OA, size_t& OB,
+               size_t& OD) const
+  {
+    OA = 0; OB = 0; OD = 0;
+    for (size_t d=0;d<DIMS.size();d++)
+    {
+      const size_t dim = DIMS[d];
+      const size_t idx = I%LEN[dim];
+      I /= LEN[dim];
+      OA += idx*SA[dim];
+      OB += idx*SB[dim];
+      OD += idx*SD[dim];
+    }
+  }
+};
+
+/*----------------------------------------------------------------------
+  reduce
+----------------------------------------------------------------------*/
+template <typename T>
+void reduce(const libj::tensor<T>& A, const std::string& idxA,
+            libj::tensor<T>& B, const std::string& idxB, const int op)
+{
+  if (idxA.length() != A.dim() || idxB.length() != B.dim())
+  {
+    strided_error("libj::reduce",idxA,idxB,"The number of labels does not match the tensor dimensions");
+  }
+  for (size_t b=0;b<idxB.length();b++)
+  {
+    const size_t a = idxA.find(idxB[b]);
+    if (idxB.find(idxB[b]) != b) {strided_error("libj::reduce",idxA,idxB,"Repeated label in B");}
+    if (a == std::string::npos)  {strided_error("libj::reduce",idxA,idxB,"Label of B is not in A");}
+    if (A.size(a) != B.size(b))  {strided_error("libj::reduce",idxA,idxB,"Lengths of A and B do not match");}
+  }
+
+  //dense strides of B, and the dimensions of A
+  libj::dim_vector DB(idxB.length(),0);
+  size_t NB = 1;
+  for (size_t b=0;b<idxB.length();b++) {DB[b] = NB; NB *= B.size(b);}
+  reduce_dims dims;
+  for (size_t a=0;a<idxA.length();a++)
+  {
+    if (idxA.find(idxA[a]) != a) {strided_error("libj::reduce",idxA,idxB,"Repeated label in A, see libj::trace");}
+    const size_t b = idxB.find(idxA[a]);
+    if (b == std::string::npos) {dims.push(A.size(a),A.stride(a),0,0,false);}
+    else {dims.push(A.size(a),A.stride(a),B.stride(b),DB[b],true);}
+  }
+  if (dims.LEN.size() == 0)
+  {
+    dims.LEN.push_back(1);
+    dims.SA.push_back(0);
+    dims.SB.push_back(0);
+    dims.SD.push_back(0);
+    dims.KEPT.push_back(0);
+  }
+
+  //the inner dimension, and the kept (K) and summed (S) outer ones
+  size_t inner = 0;
+  for (size_t d=1;d<dims.LEN.size();d++) {if (dims.SA[d] < dims.SA[inner]) inner = d;}
+  libj::dim_vector K, S, KS;
+  size_t NK = 1, NS = 1;
+  for (size_t d=0;d<dims.LEN.size();d++)
+  {
+    if (d == inner) continue;
+    if (dims.KEPT[d]) {K.push_back(d); NK *= dims.LEN[d];}
+    else {S.push_back(d); NS *= dims.LEN[d];}
+  }
+  for (size_t d=0;d<K.size();d++) KS.push_back(K[d]);
+  for (size_t d=0;d<S.size();d++) KS.push_back(S[d]);
+
+  const T*     AP   = A.data();
+  T*           BP   = B.data();
+  const bool   kept = dims.KEPT[inner] != 0;
+  const size_t N    = dims.LEN[inner];
+  const size_t SA   = dims.SA[inner];
+  const size_t NC   = kept ? std::max((size_t) 1,libj::CacheInfo::get().L1_elements<T>()/2) : N;
+  const size_t NCH  = (N + NC - 1)/NC;
+  const T      id   = reduce_identity<T>(op);
+
+  int nthr = 1;
+  #if defined (_OPENMP)
+  if (!omp_in_parallel()) nthr = omp_get_max_threads();
+  #endif
+
+  if (nthr > 1 && NS > 1 && NK*NCH < 4*(size_t) nthr)
+  {
+    //a dense copy of B for each thread
+    std::vector<T> part((size_t) nthr*NB,id);
+    #pragma omp parallel num_threads(nthr)
+    {
+      int tid = 0;
+      #if defined (_OPENMP)
+      tid = omp_get_thread_num();
+      #endif
+      T* pp = part.data() + (size_t) tid*NB;
+
+      #pragma omp for schedule(static)
+      for (long t=0;t<(long) (NK*NS);t++)
+      {
+        size_t oa,ob,od;
+        dims.offsets((size_t) t,KS,oa,ob,od);
+        if (kept) {reduce_onto<T>(op,(long) N,AP+oa,SA,pp+od,dims.SD[inner]);}
+        else {pp[od] = reduce_line<T>(op,(long) N,AP+oa,SA,pp[od]);}
+      }
+    }
+
+    //combine the copies into B
+    for (size_t i=0;i<NB;i++)
+    {
+      T val = part[i];
+      for (int tid=1;tid<nthr;tid++) val = reduce_one<T>(op,val,part[(size_t) tid*NB+i]);
+      size_t ob = 0, ii = i;
+      for (size_t b=0;b<idxB.length();b++) {ob += (ii%B.size(b))*B.stride(b); ii /= B.size(b);}
+      BP[ob] = val;
+    }
+    return;
+  }
+
+  //each chunk (or element) of B by one thread
+  #pragma omp parallel for schedule(static)
+  for (long t=0;t<(long) (NK*NCH);t++)
+  {
+    const size_t c  = (size_t) t%NCH;
+    const size_t i0 = c*NC;
+    const long   n  = (long) std::min(NC,N-i0);
+    size_t oa,ob,od;
+    dims.offsets((size_t) t/NCH,K,oa,ob,od);
+    if (kept)
+    {
+      const size_t SB = dims.SB[inner];
+      T* bb = BP+ob+i0*SB;
+      for (long i=0;i<n;i++) bb[i*SB] = id;
+      for (size_t s=0;s<NS;s++)
+      {
+        size_t sa,sb,sd;
+        dims.offsets(s,S,sa,sb,sd);
+        reduce_onto<T>(op,n,AP+oa+sa+i0*SA,SA,bb,SB);
+      }
+    } else {
+      T val = id;
+      for (size_t s=0;s<NS;s++)
+      {
+        size_t sa,sb,sd;
+        dims.offsets(s,S,sa,sb,sd);
+        val = reduce_line<T>(op,n,AP+oa+sa,SA,val);
+      }
+      BP[ob] = val;
+    }
+  }
+}
+template void libj::reduce<double>(const libj::tensor<double>& A, const std::string& idxA,
+                                   libj::tensor<double>& B, const std::string& idxB, const int op);
+template void libj::reduce<float>(const libj::tensor<float>& A, const std::string& idxA,
+                                  libj::tensor<float>& B, const std::string& idxB, const int op);
+template void libj::reduce<long>(const libj::tensor<long>& A, const std::string& idxA,
+                                 libj::tensor<long>& B, const std::string& idxB, const int op);
+template void libj::reduce<int>(const libj::tensor<int>& A, const std::string& idxA,
+                                libj::tensor<int>& B, const std::string& idxB, const int op);
+
+}//end of namespace
@@ -0,0 +1,248 @@
+/*----------------------------------------------------------------------
+  trace.cpp
+	JHT, October 14, 2026 : created
+	JHT, October 14, 2026 : summed labels of length 1 are kept
+
+  .cpp file for the diagonals and traces of a tensor
+
+    diagonal : B(idxB) = alpha * A(idxA) + beta * B(idxB)
+    trace    : the same, summed over the labels of A not in B
+    trace    : sum of A over all of its labels
+
+  where the labels repeated in A are the same index, e.g.
+  A(i,i,a,b). General flow is as follows
+
+  1) the repeated labels of A are made into one dimension, whose
+     stride is the sum of their strides (trace_view), so D(i,a,b)
+     is a strided view of A(i,i,a,b), without a copy
+
+  2) a diagonal is then permute(D,B), which is tiled and threaded
+
+  3) for a trace, the dimensions of D in B are fused as in
+     permute (libj::strided_dims), and B is done in lines of its
+     first dimension, cut into chunks of half of L1. Every summed
+     index adds one strided line of D to a chunk of B while it is
+     in L1. The chunks of all the other dimensions of B are
+     flattened into one parallel OpenMP loop
+
+  4) a full trace is a reduction over D, as in norm2
+
+----------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "jblis_level1.hpp"
+#include "jblis_strided.hpp"
+#include "simd.hpp"
+
+namespace libj
+{
+
+/*----------------------------------------------------------------------
+  trace_view
+	view D of A, with one dimension for each label of idxA, taken
+	in the order they first appear (labels). The stride of a
+	repeated label is the sum of its strides in A
+----------------------------------------------------------------------*/
+template <typename T>
+inline libj::tensor<T> trace_view(const char* NAME, const libj::tensor<T>& A,
+                                  const std::string& idxA, const std::string& idxB,
+                                  std::string& labels)
+{
+  if (!A.is_set() || idxA.length() != A.dim())
+  {
+    strided_error(NAME,idxA,idxB,"A is not set, or the number of labels does not match its dimensions");
+  }
+  labels.clear();
+  std::vector<size_t> LEN, STR;
+  for (size_t a=0;a<idxA.length();a++)
+  {
+    const size_t d = labels.find(idxA[a]);
+    if (d == std::string::npos)
+    {
+      labels.push_back(idxA[a]);
+      LEN.push_back(A.size(a));
+      STR.push_back(A.stride(a));
+    } else {
+      if (LEN[d] != A.size(a)) {strided_error(NAME,idxA,idxB,"Lengths of a repeated label do not match");}
+      STR[d] += A.stride(a);
+    }
+  }
+  libj::tensor<T> D;
+  if (LEN.size() > 0) D.assign(const_cast<T*>(A.data()),LEN,STR);
+  return D;
+}
+
+/*----------------------------------------------------------------------
+  diagonal
+----------------------------------------------------------------------*/
+template <typename T>
+void diagonal(const libj::tensor<T>& A, const std::string& idxA,
+              libj::tensor<T>& B, const std::string& idxB,
+              const T alpha, const T beta)
+{
+  std::string labels;
+  const libj::tensor<T> D = trace_view("libj::diagonal",A,idxA,idxB,labels);
+  libj::permute<T>(D,labels,B,idxB,alpha,beta);
+}
+template void libj::diagonal<double>(const libj::tensor<double>& A, const std::string& idxA,
+                                     libj::tensor<double>& B, const std::string& idxB,
+                                     const double alpha, const double beta);
+template void libj::diagonal<float>(const libj::tensor<float>& A, const std::string& idxA,
+                                    libj::tensor<float>& B, const std::string& idxB,
+                                    const float alpha, const float beta);
+template void libj::diagonal<long>(const libj::tensor<long>& A, const std::string& idxA,
+                                   libj::tensor<long>& B, const std::string& idxB,
+                                   const long alpha, const long beta);
+template void libj::diagonal<int>(const libj::tensor<int>& A, const std::string& idxA,
+                                  libj::tensor<int>& B, const std::string& idxB,
+                                  const int alpha, const int beta);
+
+/*----------------------------------------------------------------------
+  trace (partial)
+----------------------------------------------------------------------*/
+template <typename T>
+void trace(const libj::tensor<T>& A, const std::string& idxA,
+           libj::tensor<T>& B, const std::string& idxB,
+           const T alpha, const T beta)
+{
+  std::string labels;
+  const libj::tensor<T> D = trace_view("libj::trace",A,idxA,idxB,labels);
+
+  //split D into the dimensions of B (V) and those summed (LS,SS).
+  //  A summed dimension of length 1 is kept, so LS is empty only
+  //  when every label of D is in B, and this is a diagonal
+  std::string         idxV;
+  std::vector<size_t> LV, SV, LS, SS;
+  for (size_t d=0;d<labels.length();d++)
+  {
+    if (idxB.find(labels[d]) != std::string::npos)
+    {
+      idxV.push_back(labels[d]);
+      LV.push_back(D.size(d));
+      SV.push_back(D.stride(d));
+    } else {
+      LS.push_back(D.size(d));
+      SS.push_back(D.stride(d));
+    }
+  }
+  if (LS.size() == 0)
+  {
+    libj::diagonal<T>(A,idxA,B,idxB,alpha,beta);
+    return;
+  }
+
+  libj::tensor<T> V;
+  if (LV.size() > 0) V.assign(const_cast<T*>(A.data()),LV,SV);
+  libj::strided_dims dims;
+  dims.make("libj::trace",V,idxV,B,idxB);
+  if (dims.LEN.size() == 0)
+  {
+    dims.LEN.push_back(1);
+    dims.SA.push_back(0);
+    dims.SB.push_back(0);
+  }
+
+  libj::dim_vector OUTER;
+  size_t NOUT;
+  dims.outer(0,OUTER,NOUT);
+  size_t NSUM = 1;
+  for (size_t d=0;d<LS.size();d++) NSUM *= LS[d];
+
+  const T*     AP  = A.data();
+  T*           BP  = B.data();
+  const size_t N   = dims.LEN[0];
+  const size_t SA  = dims.SA[0];
+  const size_t SB  = dims.SB[0];
+  const size_t NC  = std::max((size_t) 1,libj::CacheInfo::get().L1_elements<T>()/2);
+  const size_t NCH = (N + NC - 1)/NC;
+
+  #pragma omp parallel for schedule(static)
+  for (long t=0;t<(long) (NOUT*NCH);t++)
+  {
+    const size_t c  = (size_t) t%NCH;
+    const size_t o  = (size_t) t/NCH;
+    const size_t i0 = c*NC;
+    const long   n  = (long) std::min(NC,N-i0);
+    size_t oa,ob;
+    dims.offsets(o,OUTER,oa,ob);
+    T* bb = BP+ob+i0*SB;
+
+    //beta * B
+    if (beta == (T) 0)
+    {
+      if (SB == 1) {simd_auto_zero<T>(n,bb);}
+      else {for (long i=0;i<n;i++) bb[i*SB] = (T) 0;}
+    } else if (beta != (T) 1) {
+      if (SB == 1) {simd_auto_scal_mul<T>(n,beta,bb);}
+      else {for (long i=0;i<n;i++) bb[i*SB] *= beta;}
+    }
+
+    //one line of D for each summed index
+    for (size_t k=0;k<NSUM;k++)
+    {
+      size_t ok = 0;
+      size_t kk = k;
+      for (size_t d=0;d<LS.size();d++)
+      {
+        ok += (kk%LS[d])*SS[d];
+        kk /= LS[d];
+      }
+      const T* aa = AP+oa+ok+i0*SA;
+      if (SA == 1 && SB == 1) {simd_auto_axpy<T>(n,alpha,aa,bb);}
+      else {for (long i=0;i<n;i++) bb[i*SB] += alpha*aa[i*SA];}
+    }
+  }
+}
+template void libj::trace<double>(const libj::tensor<double>& A, const std::string& idxA,
+                                  libj::tensor<double>& B, const std::string& idxB,
+                                  const double alpha, const double beta);
+template void libj::trace<float>(const libj::tensor<float>& A, const std::string& idxA,
+                                 libj::tensor<float>& B, const std::string& idxB,
+                                 const float alpha, const float beta);
+template void libj::trace<long>(const libj::tensor<long>& A, const std::string& idxA,
+                                libj::tensor<long>& B, const std::string& idxB,
+                                const long alpha, const long beta);
+template void libj::trace<int>(const libj::tensor<int>& A, const std::string& idxA,
+                               libj::tensor<int>& B, const std::string& idxB,
+                               const int alpha, const int beta);
+
+/*----------------------------------------------------------------------
+  trace (full)
+----------------------------------------------------------------------*/
+template <typename T>
+T trace(const libj::tensor<T>& A, const std::string& idxA)
+{
+  std::string labels;
+  const libj::tensor<T> D = trace_view("libj::trace",A,idxA,std::string(),labels);
+  if (D.dim() == 0) return (A.size() > 0) ? A.data()[0] : (T) 0;
+
+  libj::strided_dims dims;
+  dims.make(D);
+  const T* AP = D.data();
+  if (dims.trivial()) return simd_par_reduction_add<T>((long) D.size(),AP);
+
+  libj::dim_vector OUTER;
+  size_t NOUT;
+  dims.outer(0,OUTER,NOUT);
+  const long N  = (long) dims.LEN[0];
+  const long SA = (long) dims.SA[0];
+
+  T sum = (T) 0;
+  #pragma omp parallel for schedule(static) reduction(+:sum)
+  for (long o=0;o<(long) NOUT;o++)
+  {
+    size_t oa,ob;
+    dims.offsets((size_t) o,OUTER,oa,ob);
+    const T* aa = AP+oa;
+    if (SA == 1) {sum += simd_auto_reduction_add<T>(N,aa);}
+    else {for (long i=0;i<N;i++) sum += aa[i*SA];}
+  }
+  return sum;
+}
+template double libj::trace<double>(const libj::tensor<double>& A, const std::string& idxA);
+template float libj::trace<float>(const libj::tensor<float>& A, const std::string& idxA);
+template long libj::trace<long>(const libj::tensor<long>& A, const std::string& idxA);
+template int libj::trace<int>(const libj::tensor<int>& A, const std::string& idxA);
+
+}//end of namespace
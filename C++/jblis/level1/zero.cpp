@@ -1,213 +1,133 @@
 /*----------------------------------------------------------------------
   zero.cpp
 	JHT, April 11, 2022 : created
+	JHT, October 14, 2026 : moved to tensor_matrix2, added set and scal
 
-  .cpp file for the zero function, which sets a tensor to zero. This
-  is coded to work best on larger tensors
+  .cpp file for the zero, set, and scal functions, which set or scale
+  every element of a tensor
 
   General flow is as follows
 
-  1) convert tensor to col-vector tensor_matrix. Zero out a "packed"
-     vector
-   
-  2) parallel loop through pannels of vector, sized to fit in L2
-     cache (which is assumed not to be shared)
+  1) a sequential tensor is one vector, done with simd_par_zero,
+     simd_par_scal_set, or simd_par_scal_mul, which split it
+     evenly over the OpenMP threads
 
-  3) loop through packs of L1 size and   
+  2) a strided tensor whose fused fastest dimension (tensor_runs)
+     is long is done a line at a time with the simd_auto_ kernels,
+     which peel each line to a vector boundary (or the _strided
+     versions), in parallel over the lines
+
+  3) otherwise, the tensor is a col-vector tensor_matrix2. A
+     parallel loop goes through panels of it sized to fit in L2
+     (which is assumed not to be shared)
+
+  4) each panel is done in packs of 1/4 of L1, which are
+     block_scatter_matrix2s with row blocks of 16, see
+     jblis_blocked.hpp. Nothing is allocated.
 
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include "jblis_level1.hpp"
-
-//Note that the block size is the same as the microkernel size, here
-#define ROW_BLOCK_SIZE 16
-#define COL_BLOCK_SIZE 1
+#include "jblis_blocked.hpp"
+#include "simd.hpp"
 
 namespace libj
 {
 
 /*----------------------------------------------------------------------
-  zero_microkernel_stride1
-	special code for if the row stride of the current block is zero
+  ops for the blocked driver
 ----------------------------------------------------------------------*/
 template <typename T>
-inline void zero_microkernel_stride1(T* A)
+struct zero_op
 {
-  A[0] = (T) 0;   
-  A[1] = (T) 0;   
-  A[2] = (T) 0;   
-  A[3] = (T) 0;   
-  A[4] = (T) 0;   
-  A[5] = (T) 0;   
-  A[6] = (T) 0;   
-  A[7] = (T) 0;   
-
-  A[8] = (T) 0;   
-  A[9] = (T) 0;   
-  A[10] = (T) 0;   
-  A[11] = (T) 0;   
-  A[12] = (T) 0;   
-  A[13] = (T) 0;   
-  A[14] = (T) 0;   
-  A[15] = (T) 0;   
+  inline void operator() (T& a) const {a = (T) 0;}
+  inline void line(const size_t N, T* A, const size_t INC) const
+  {
+    if (INC == 1) {simd_auto_zero<T>((long) N,A);}
+    else {simd_zero_strided<T>((long) N,A,(long) INC);}
+  }
+};
 
-}
-template inline void zero_microkernel_stride1(int* A);
-template inline void zero_microkernel_stride1(long* A);
-template inline void zero_microkernel_stride1(float* A);
-#if not defined LIBJ_AVX
-template inline void zero_microkernel_stride1(double* A);
-#endif
+template <typename T>
+struct set_op
+{
+  const T s;
+  set_op(const T val) : s(val) {}
+  inline void operator() (T& a) const {a = s;}
+  inline void line(const size_t N, T* A, const size_t INC) const
+  {
+    if (INC == 1) {simd_auto_scal_set<T>((long) N,s,A);}
+    else {for (size_t i=0;i<N;i++) A[i*INC] = s;}
+  }
+};
 
-/*----------------------------------------------------------------------
-  zero_microkernel_stride1
-	special code for doubles with stride 1
-----------------------------------------------------------------------*/
-#if defined LIBJ_AVX
-template<>
-void inline zero_microkernel_stride1(double* A)
+template <typename T>
+struct scal_op
 {
-  const __m256d a_0_3   = _mm256_setzero_pd(); 
-  const __m256d a_4_7   = _mm256_setzero_pd(); 
-  const __m256d a_8_11  = _mm256_setzero_pd(); 
-  const __m256d a_12_15 = _mm256_setzero_pd(); 
-  _mm256_storeu_pd(A+0,a_0_3);
-  _mm256_storeu_pd(A+4,a_4_7);
-  _mm256_storeu_pd(A+8,a_8_11);
-  _mm256_storeu_pd(A+12,a_12_15);
-}
-#endif
+  const T s;
+  scal_op(const T val) : s(val) {}
+  inline void operator() (T& a) const {a *= s;}
+  inline void line(const size_t N, T* A, const size_t INC) const
+  {
+    if (INC == 1) {simd_auto_scal_mul<T>((long) N,s,A);}
+    else {simd_scal_mul_strided<T>((long) N,s,A,(long) INC);}
+  }
+};
+
 /*----------------------------------------------------------------------
-  zero_microkernel_strideg
-	special code for constant stride blocks 	
+  zero
 ----------------------------------------------------------------------*/
 template <typename T>
-inline void zero_microkernel_strideg(T* A, const size_t stride)
+void zero(libj::tensor<T>& A)
 {
-  A[0*stride] = (T) 0;   
-  A[1*stride] = (T) 0;   
-  A[2*stride] = (T) 0;   
-  A[3*stride] = (T) 0;   
-  A[4*stride] = (T) 0;   
-  A[5*stride] = (T) 0;   
-  A[6*stride] = (T) 0;   
-  A[7*stride] = (T) 0;   
-  A[8*stride] = (T) 0;   
-  A[9*stride] = (T) 0;   
-  A[10*stride] = (T) 0;   
-  A[11*stride] = (T) 0;   
-  A[12*stride] = (T) 0;   
-  A[13*stride] = (T) 0;   
-  A[14*stride] = (T) 0;   
-  A[15*stride] = (T) 0;   
+  if (A.size() == 0) return;
+  if (A.is_sequential()) {
+    simd_par_zero<T>((long) A.size(),A.data());
+  } else {
+    libj::blocked_dispatch("libj::zero",A,zero_op<T>());
+  }
 }
-template inline void zero_microkernel_strideg(int* A, const size_t stride);
-template inline void zero_microkernel_strideg(long* A, const size_t stride);
-template inline void zero_microkernel_strideg(float* A, const size_t stride);
-template inline void zero_microkernel_strideg(double* A, const size_t stride);
+template void libj::zero<double>(libj::tensor<double>& A);
+template void libj::zero<float>(libj::tensor<float>& A);
+template void libj::zero<long>(libj::tensor<long>& A);
+template void libj::zero<int>(libj::tensor<int>& A);
 
 /*----------------------------------------------------------------------
-  zero_inner_kernel 
-	takes in block scatter matrix, loops through cols and row
-        blocks, sets the values to zero via microkernel calls 
+  set
 ----------------------------------------------------------------------*/
 template <typename T>
-inline void zero_inner_kernel(const size_t START, const size_t LEN, 
-                             libj::block_scatter_matrix<T>& BLOCK) 
+void set(const T scal, libj::tensor<T>& A)
 {
-  const size_t block_size = BLOCK.block_size(0);
-
-  //cleanup the first row block
-  size_t row = START;
-  for (; row < std::min(BLOCK.next_block_index(0,START),START+LEN-1); row++)
-  {
-    BLOCK(row,0) = (T) 0;
-  } 
-
-  //general row blocks in between
-  const size_t start_row_block = BLOCK.block_id(0,START);
-  const size_t   end_row_block = BLOCK.block_id(0,START+LEN);
-  for (size_t row_block = start_row_block+1; row_block < end_row_block; row_block++)
-  {
-    const size_t  block_stride = BLOCK.block_stride(0,row_block);
-    if (block_stride == 1)     {zero_microkernel_stride1<T>(&BLOCK(row,0));} 
-    else if (block_stride > 0) {zero_microkernel_strideg<T>(&BLOCK(row,0),
-                                                            block_stride);} 
-    else {
-      for (size_t sub_row = row; sub_row < row + BLOCK.block_size(0); sub_row++) {
-        BLOCK(sub_row,0) = (T) 0;
-      }
-    }                     
-    row += block_size;  
-  } 
-
-  //cleanup the last row block 
-  for (; row < START+LEN ; row++)
-  {
-    BLOCK(row,0) = (T) 0;
-  } 
-  
-inline void zero_inner_kernel(const size_t START, const size_t LEN, 
-                              libj::block_scatter_matrix<int>& BLOCK); 
-inline void zero_inner_kernel(const size_t START, const size_t LEN, 
-                              libj::block_scatter_matrix<long>& BLOCK); 
-inline void zero_inner_kernel(const size_t START, const size_t LEN, 
-                              libj::block_scatter_matrix<float>& BLOCK); 
-inline void zero_inner_kernel(const size_t START, const size_t LEN, 
-                              libj::block_scatter_matrix<double>& BLOCK); 
+  if (A.size() == 0) return;
+  if (A.is_sequential()) {
+    simd_par_scal_set<T>((long) A.size(),scal,A.data());
+  } else {
+    libj::blocked_dispatch("libj::set",A,set_op<T>(scal));
+  }
 }
+template void libj::set<double>(const double scal, libj::tensor<double>& A);
+template void libj::set<float>(const float scal, libj::tensor<float>& A);
+template void libj::set<long>(const long scal, libj::tensor<long>& A);
+template void libj::set<int>(const int scal, libj::tensor<int>& A);
 
 /*----------------------------------------------------------------------
-  General code
+  scal
+	s == 0 is a zero, so that NaNs in A are not kept
 ----------------------------------------------------------------------*/
 template <typename T>
-void zero(libj::tensor<T>& A)
+void scal(const T s, libj::tensor<T>& A)
 {
-  //set column vector tensor matrix
-  libj::tensor_matrix<T> A_MATRIX(A,"","");
-
-  //Get parameters
-  libj::Cache cache;
-  const size_t PANEL_SIZE = cache.L2_elements<T>();
-//  const size_t PACK_SIZE  = cache.L1_elements<T>(); 
-//  const size_t PACK_SIZE  = 2*cache.LINE_elements<T>(); 
-  const size_t PACK_SIZE  = cache.L2_elements<T>()/2;
-  const size_t LINE_SIZE  = cache.LINE_elements<T>(); 
-
-  //initialize block scatter matrix
-  libj::block_scatter_matrix<T> A_BLOCKED;
-
-  //Loops
-  const size_t start = 0;
-  const size_t end   = A_MATRIX.size(); 
-  #pragma omp parallel for shared(A_MATRIX) private(A_BLOCKED) schedule(static) 
-  for (size_t panel_start = start; panel_start < end; panel_start += PANEL_SIZE)
-  {
-    const size_t panel_len = std::min(end-panel_start,PANEL_SIZE);
-    const size_t panel_end = panel_start + panel_len;
-    
-    //loop over L1 packs of BA
-    for (size_t pack_start = panel_start; pack_start < panel_end; 
-         pack_start += PACK_SIZE)
-    {
-      const size_t pack_len = std::min(panel_end-pack_start,PACK_SIZE);
-     
-      //construct blocked scatter matrix for this pannel
-//      A_BLOCKED.assign(A_MATRIX.block(pack_start,0,
-//                                      pack_len,1),
-//                       ROW_BLOCK_SIZE,COL_BLOCK_SIZE);
-      A_BLOCKED.assign_to_block(A_MATRIX,pack_start,0,pack_len,1,
-                                ROW_BLOCK_SIZE,COL_BLOCK_SIZE);
-
-      //call inner kernel on pannel
-      zero_inner_kernel<T>(0,pack_len,A_BLOCKED);
-
-    }
+  if (A.size() == 0 || s == (T) 1) return;
+  if (s == (T) 0) {zero(A); return;}
+  if (A.is_sequential()) {
+    simd_par_scal_mul<T>((long) A.size(),s,A.data());
+  } else {
+    libj::blocked_dispatch("libj::scal",A,scal_op<T>(s));
   }
 }
-template void libj::zero<double>(libj::tensor<double>& A);
-template void libj::zero<float>(libj::tensor<float>& A);
-template void libj::zero<long>(libj::tensor<long>& A);
-template void libj::zero<int>(libj::tensor<int>& A);
+template void libj::scal<double>(const double s, libj::tensor<double>& A);
+template void libj::scal<float>(const float s, libj::tensor<float>& A);
+template void libj::scal<long>(const long s, libj::tensor<long>& A);
+template void libj::scal<int>(const int s, libj::tensor<int>& A);
 
 }//end of namespace
@@ -0,0 +1,176 @@
+/*----------------------------------------------------------------------
+  ger.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for the outer product update of tensors
+
+    C(idxC) = alpha * X(idxX) Y(idxY) + beta * C(idxC)
+
+  General flow is as follows
+
+  1) the labels of C are split into those of X and those of Y,
+     each a libj::strided_dims with the strides of the tensor and
+     of C, fused as in permute
+
+  2) the tensor (P) with the first dimension of C is the inner
+     line, cut into chunks of half of L1, and each chunk of C is
+     written once, as beta * C + (alpha * Q) * P, with Q the one
+     element of the other tensor
+
+  3) the chunks, the other dimensions of P and all of Q are
+     flattened into one parallel OpenMP loop
+
+----------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "jblis_level2.hpp"
+#include "jblis_strided.hpp"
+#include "cache.hpp"
+#include "simd.hpp"
+
+namespace libj
+{
+
+/*----------------------------------------------------------------------
+  ger_dims
+	dimensions of C that are labels of X, in the order of C
+----------------------------------------------------------------------*/
+template <typename T>
+inline void ger_dims(const libj::tensor<T>& X, const std::string& idxX,
+                     const libj::tensor<T>& C, const std::string& idxC,
+                     libj::strided_dims& DIMS)
+{
+  DIMS.LEN.clear(); DIMS.SA.clear(); DIMS.SB.clear();
+  for (size_t c=0;c<idxC.length();c++)
+  {
+    const size_t x = idxX.find(idxC[c]);
+    if (x == std::string::npos) continue;
+    if (X.size(x) != C.size(c)) {strided_error("libj::ger",idxX,idxC,"Lengths of X (or Y) and C do not match");}
+    DIMS.push(C.size(c),X.stride(x),C.stride(c));
+  }
+  if (DIMS.LEN.size() == 0)
+  {
+    DIMS.LEN.push_back(1);
+    DIMS.SA.push_back(0);
+    DIMS.SB.push_back(0);
+  }
+}
+
+/*----------------------------------------------------------------------
+  ger
+----------------------------------------------------------------------*/
+template <typename T>
+void ger(const libj::tensor<T>& X, const std::string& idxX,
+         const libj::tensor<T>& Y, const std::string& idxY,
+         libj::tensor<T>& C, const std::string& idxC,
+         const T alpha, const T beta)
+{
+  const char* NAME = "libj::ger";
+  if (!X.is_set() || !Y.is_set() || !C.is_set())
+  {
+    strided_error(NAME,idxX,idxY,"X, Y or C is not set");
+  }
+  if (idxX.length() != X.dim() || idxY.length() != Y.dim() || idxC.length() != C.dim())
+  {
+    strided_error(NAME,idxX,idxY,"The number of labels does not match the tensor dimensions");
+  }
+  if (idxX.length() + idxY.length() != idxC.length())
+  {
+    strided_error(NAME,idxX,idxY,"The labels of C are not those of X and Y");
+  }
+
+  //each label of C in X or in Y, once, and P the one of the first
+  bool X_first = true;
+  bool found   = false;
+  for (size_t c=0;c<idxC.length();c++)
+  {
+    const size_t x = idxX.find(idxC[c]);
+    const size_t y = idxY.find(idxC[c]);
+    if (idxC.find(idxC[c]) != c) {strided_error(NAME,idxX,idxY,"Repeated label in C");}
+    if ((x == std::string::npos) == (y == std::string::npos))
+    {
+      strided_error(NAME,idxX,idxY,"Label of C must be in one of X and Y");
+    }
+    if (!found && C.size(c) > 1)
+    {
+      X_first = (x != std::string::npos);
+      found   = true;
+    }
+  }
+  const libj::tensor<T>& P    = X_first ? X : Y;
+  const libj::tensor<T>& Q    = X_first ? Y : X;
+  const std::string&     idxP = X_first ? idxX : idxY;
+  const std::string&     idxQ = X_first ? idxY : idxX;
+
+  libj::strided_dims dims, other;
+  ger_dims(P,idxP,C,idxC,dims);
+  ger_dims(Q,idxQ,C,idxC,other);
+
+  libj::dim_vector OUTER, QDIMS;
+  size_t NOUT, NQ;
+  dims.outer(0,OUTER,NOUT);
+  QDIMS.clear();
+  NQ = 1;
+  for (size_t d=0;d<other.LEN.size();d++) {QDIMS.push_back(d); NQ *= other.LEN[d];}
+
+  const T*     PP  = P.data();
+  const T*     QP  = Q.data();
+  T*           CP  = C.data();
+  const size_t N   = dims.LEN[0];
+  const size_t SP  = dims.SA[0];
+  const size_t SC  = dims.SB[0];
+  const size_t NC  = std::max((size_t) 1,libj::CacheInfo::get().L1_elements<T>()/2);
+  const size_t NCH = (N + NC - 1)/NC;
+
+  #pragma omp parallel for schedule(static)
+  for (long t=0;t<(long) (NQ*NOUT*NCH);t++)
+  {
+    const size_t c  = (size_t) t%NCH;
+    const size_t o  = ((size_t) t/NCH)%NOUT;
+    const size_t q  = ((size_t) t/NCH)/NOUT;
+    const size_t i0 = c*NC;
+    const long   n  = (long) std::min(NC,N-i0);
+    size_t op,oc,oq,ocq;
+    dims.offsets(o,OUTER,op,oc);
+    other.offsets(q,QDIMS,oq,ocq);
+    const T  w  = alpha*QP[oq];
+    const T* pp = PP+op+i0*SP;
+    T*       cc = CP+oc+ocq+i0*SC;
+
+    if (SP == 1 && SC == 1)
+    {
+      if (beta == (T) 0)
+      {
+        simd_auto_copy<T>(n,pp,cc);
+        simd_auto_scal_mul<T>(n,w,cc);
+      } else if (beta == (T) 1) {
+        simd_auto_axpy<T>(n,w,pp,cc);
+      } else {
+        simd_auto_axpby<T>(n,w,pp,beta,cc);
+      }
+    } else {
+      if (beta == (T) 0) {for (long i=0;i<n;i++) cc[i*SC] = w*pp[i*SP];}
+      else {for (long i=0;i<n;i++) cc[i*SC] = w*pp[i*SP] + beta*cc[i*SC];}
+    }
+  }
+}
+template void libj::ger<double>(const libj::tensor<double>& X, const std::string& idxX,
+                                const libj::tensor<double>& Y, const std::string& idxY,
+                                libj::tensor<double>& C, const std::string& idxC,
+                                const double alpha, const double beta);
+template void libj::ger<float>(const libj::tensor<float>& X, const std::string& idxX,
+                               const libj::tensor<float>& Y, const std::string& idxY,
+                               libj::tensor<float>& C, const std::string& idxC,
+                               const float alpha, const float beta);
+template void libj::ger<long>(const libj::tensor<long>& X, const std::string& idxX,
+                              const libj::tensor<long>& Y, const std::string& idxY,
+                              libj::tensor<long>& C, const std::string& idxC,
+                              const long alpha, const long beta);
+template void libj::ger<int>(const libj::tensor<int>& X, const std::string& idxX,
+                             const libj::tensor<int>& Y, const std::string& idxY,
+                             libj::tensor<int>& C, const std::string& idxC,
+                             const int alpha, const int beta);
+
+}//end of namespace
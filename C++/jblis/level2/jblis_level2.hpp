@@ -0,0 +1,93 @@
+/*----------------------------------------------------------------------------------
+  jblis_level2.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for the level-2 routines of jblis, between the level-1 routines on
+  one or two tensors and the contractions of level 3. These are the bandwidth
+  bound products of a tensor with a vector (or a matrix), and the outer product
+  updates, which would otherwise be contractions with indices of length 1
+
+    ttv
+    ger
+
+----------------------------------------------------------------------------------*/
+#ifndef JBLIS_L2_HPP
+#define JBLIS_L2_HPP
+
+#include <string>
+#include "tensor.hpp"
+#include "libjdef.h"
+
+namespace libj
+{
+
+/*---------------------------------------------------------
+ * ttv
+ *
+ * Tensor times a vector (or a tensor V of summed labels),
+ *
+ *   C(idxC) = alpha * sum A(idxA) V(idxV) + beta * C(idxC)
+ *
+ * summed over the labels of A that are not in C, which
+ * must all be labels of V, e.g. libj::ttv(A,"ijl",v,"l",
+ * C,"ij") is C(i,j) = sum_l A(i,j,l) v(l). The labels of
+ * V that are not in A are labels of C, which makes this a
+ * tensor times a matrix, e.g. libj::ttv(A,"ijl",M,"lm",
+ * C,"ijm"). Each label is once in each tensor.
+ *
+ * The loop nest keeps the first dimension of C innermost
+ * when it is the smallest stride of A, and adds one
+ * scaled line of A (simd axpy) per summed index, to a
+ * chunk of C of half of L1. Otherwise (A(l,i,j) v(l)) the
+ * summed stride 1 dimension of A is innermost, as dots.
+ * The other dimensions of C are one parallel loop. With
+ * beta == 0, C is not read. All may be strided views.
+ *
+ * A     -> tensor
+ * idxA  -> index labels of A
+ * V     -> vector, matrix or tensor
+ * idxV  -> index labels of V
+ * C     -> result tensor
+ * idxC  -> index labels of C
+ * alpha -> scalar for the product
+ * beta  -> scalar for C
+---------------------------------------------------------*/
+template <typename T>
+void ttv(const libj::tensor<T>& A, const std::string& idxA,
+         const libj::tensor<T>& V, const std::string& idxV,
+         libj::tensor<T>& C, const std::string& idxC,
+         const T alpha=(T) 1, const T beta=(T) 0);
+
+/*---------------------------------------------------------
+ * ger
+ *
+ * Outer product update, as the BLAS dger,
+ *
+ *   C(idxC) = alpha * X(idxX) Y(idxY) + beta * C(idxC)
+ *
+ * where each label of C is a label of X or of Y, e.g.
+ * libj::ger(x,"ij",y,"ab",C,"ijab"). The tensor with the
+ * first dimension of C gives the inner line, which is a
+ * simd axpy (axpby) of it, scaled by one element of the
+ * other, in chunks of half of L1, so the lines of C are
+ * written once, in order. The other dimensions of both
+ * are one parallel loop. With beta == 0, C is not read.
+ * All may be strided views.
+ *
+ * X     -> first tensor
+ * idxX  -> index labels of X
+ * Y     -> second tensor
+ * idxY  -> index labels of Y
+ * C     -> result tensor
+ * idxC  -> index labels of C
+ * alpha -> scalar for the product
+ * beta  -> scalar for C
+---------------------------------------------------------*/
+template <typename T>
+void ger(const libj::tensor<T>& X, const std::string& idxX,
+         const libj::tensor<T>& Y, const std::string& idxY,
+         libj::tensor<T>& C, const std::string& idxC,
+         const T alpha=(T) 1, const T beta=(T) 1);
+
+}//end libj
+#endif
@@ -0,0 +1,233 @@
+/*----------------------------------------------------------------------
+  ttv.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for the tensor times vector (and matrix)
+
+    C(idxC) = alpha * sum A(idxA) V(idxV) + beta * C(idxC)
+
+  General flow is as follows
+
+  1) the labels of C are split into those of A (kept) and those of
+     V (free), and the labels of A not in C are summed. Each group
+     is a libj::strided_dims, with the strides of A and C (kept),
+     A and V (summed), and V and C (free), fused as in permute
+
+  2) when the first dimension of C is the smallest stride of A,
+     C is done in lines of its first dimension, cut into chunks of
+     half of L1, as in trace. Every summed index adds one line of
+     A, scaled by alpha * V, to a chunk of C while it is in L1
+
+  3) otherwise, the summed dimension of A with the smallest stride
+     is innermost, and each element of C is a sum of dots of A
+     and V along it
+
+  The chunks of the other dimensions of C, kept and free, are
+  flattened into one parallel OpenMP loop
+
+----------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "jblis_level2.hpp"
+#include "jblis_strided.hpp"
+#include "cache.hpp"
+#include "simd.hpp"
+
+namespace libj
+{
+
+/*----------------------------------------------------------------------
+  ttv_all
+	every dimension of DIMS but J, for strided_dims::offsets
+----------------------------------------------------------------------*/
+static inline void ttv_all(const libj::strided_dims& DIMS, const size_t J,
+                           libj::dim_vector& ALL, size_t& NALL)
+{
+  ALL.clear();
+  NALL = 1;
+  for (size_t d=0;d<DIMS.LEN.size();d++)
+  {
+    if (d != J) {ALL.push_back(d); NALL *= DIMS.LEN[d];}
+  }
+}
+
+/*----------------------------------------------------------------------
+  ttv
+----------------------------------------------------------------------*/
+template <typename T>
+void ttv(const libj::tensor<T>& A, const std::string& idxA,
+         const libj::tensor<T>& V, const std::string& idxV,
+         libj::tensor<T>& C, const std::string& idxC,
+         const T alpha, const T beta)
+{
+  const char* NAME = "libj::ttv";
+  if (!A.is_set() || !V.is_set() || !C.is_set())
+  {
+    strided_error(NAME,idxA,idxC,"A, V or C is not set");
+  }
+  if (idxA.length() != A.dim() || idxV.length() != V.dim() || idxC.length() != C.dim())
+  {
+    strided_error(NAME,idxA,idxC,"The number of labels does not match the tensor dimensions");
+  }
+
+  //kept (A,C) and free (V,C) dimensions, in the order of C
+  libj::strided_dims dims, free;
+  for (size_t c=0;c<idxC.length();c++)
+  {
+    const size_t a = idxA.find(idxC[c]);
+    const size_t v = idxV.find(idxC[c]);
+    if (idxC.find(idxC[c]) != c) {strided_error(NAME,idxA,idxC,"Repeated label in C");}
+    if (a != std::string::npos && v != std::string::npos)
+    {
+      strided_error(NAME,idxA,idxC,"Label of C is in both A and V");
+    }
+    if (a != std::string::npos)
+    {
+      if (A.size(a) != C.size(c)) {strided_error(NAME,idxA,idxC,"Lengths of A and C do not match");}
+      dims.push(C.size(c),A.stride(a),C.stride(c));
+    } else if (v != std::string::npos) {
+      if (V.size(v) != C.size(c)) {strided_error(NAME,idxV,idxC,"Lengths of V and C do not match");}
+      free.push(C.size(c),V.stride(v),C.stride(c));
+    } else {
+      strided_error(NAME,idxA,idxC,"Label of C is not in A or V");
+    }
+  }
+
+  //summed (A,V) dimensions, in the order of A
+  libj::strided_dims sums;
+  for (size_t a=0;a<idxA.length();a++)
+  {
+    if (idxA.find(idxA[a]) != a) {strided_error(NAME,idxA,idxV,"Repeated label in A, see libj::trace");}
+    if (idxC.find(idxA[a]) != std::string::npos) continue;
+    const size_t v = idxV.find(idxA[a]);
+    if (v == std::string::npos) {strided_error(NAME,idxA,idxV,"Summed label of A is not in V");}
+    if (A.size(a) != V.size(v)) {strided_error(NAME,idxA,idxV,"Lengths of A and V do not match");}
+    sums.push(A.size(a),A.stride(a),V.stride(v));
+  }
+  for (size_t v=0;v<idxV.length();v++)
+  {
+    if (idxV.find(idxV[v]) != v) {strided_error(NAME,idxA,idxV,"Repeated label in V");}
+    if (idxA.find(idxV[v]) == std::string::npos && idxC.find(idxV[v]) == std::string::npos)
+    {
+      strided_error(NAME,idxA,idxV,"Label of V is not in A or C");
+    }
+  }
+  if (dims.LEN.size() == 0)
+  {
+    dims.LEN.push_back(1);
+    dims.SA.push_back(0);
+    dims.SB.push_back(0);
+  }
+
+  libj::dim_vector OUTER, FREE, SUM;
+  size_t NOUT, NFREE, NSUM;
+  dims.outer(0,OUTER,NOUT);
+  ttv_all(free,free.LEN.size(),FREE,NFREE);
+
+  const T*     AP  = A.data();
+  const T*     VP  = V.data();
+  T*           CP  = C.data();
+  const size_t N   = dims.LEN[0];
+  const size_t SA  = dims.SA[0];
+  const size_t SC  = dims.SB[0];
+  const size_t NC  = std::max((size_t) 1,libj::CacheInfo::get().L1_elements<T>()/2);
+  const size_t NCH = (N + NC - 1)/NC;
+  const size_t J   = sums.stride_A();
+  const bool   AXPY = sums.LEN.size() == 0 || (N > 1 && SA <= sums.SA[J]);
+
+  if (AXPY)
+  {
+    //lines of A along the first dimension of C
+    ttv_all(sums,sums.LEN.size(),SUM,NSUM);
+
+    #pragma omp parallel for schedule(static)
+    for (long t=0;t<(long) (NFREE*NOUT*NCH);t++)
+    {
+      const size_t c  = (size_t) t%NCH;
+      const size_t o  = ((size_t) t/NCH)%NOUT;
+      const size_t f  = ((size_t) t/NCH)/NOUT;
+      const size_t i0 = c*NC;
+      const long   n  = (long) std::min(NC,N-i0);
+      size_t oa,oc,ov,of;
+      dims.offsets(o,OUTER,oa,oc);
+      free.offsets(f,FREE,ov,of);
+      T* cc = CP+oc+of+i0*SC;
+
+      //beta * C
+      if (beta == (T) 0)
+      {
+        if (SC == 1) {simd_auto_zero<T>(n,cc);}
+        else {for (long i=0;i<n;i++) cc[i*SC] = (T) 0;}
+      } else if (beta != (T) 1) {
+        if (SC == 1) {simd_auto_scal_mul<T>(n,beta,cc);}
+        else {for (long i=0;i<n;i++) cc[i*SC] *= beta;}
+      }
+
+      //one line of A for each summed index
+      for (size_t k=0;k<NSUM;k++)
+      {
+        size_t ok,okv;
+        sums.offsets(k,SUM,ok,okv);
+        const T  w  = alpha*VP[ov+okv];
+        const T* aa = AP+oa+ok+i0*SA;
+        if (SA == 1 && SC == 1) {simd_auto_axpy<T>(n,w,aa,cc);}
+        else {for (long i=0;i<n;i++) cc[i*SC] += w*aa[i*SA];}
+      }
+    }
+  } else {
+    //dots along the summed dimension J
+    ttv_all(sums,J,SUM,NSUM);
+    const long NJ  = (long) sums.LEN[J];
+    const long SAJ = (long) sums.SA[J];
+    const long SVJ = (long) sums.SB[J];
+
+    #pragma omp parallel for schedule(static)
+    for (long t=0;t<(long) (NFREE*NOUT*NCH);t++)
+    {
+      const size_t c  = (size_t) t%NCH;
+      const size_t o  = ((size_t) t/NCH)%NOUT;
+      const size_t f  = ((size_t) t/NCH)/NOUT;
+      const size_t i0 = c*NC;
+      const size_t n  = std::min(NC,N-i0);
+      size_t oa,oc,ov,of;
+      dims.offsets(o,OUTER,oa,oc);
+      free.offsets(f,FREE,ov,of);
+
+      for (size_t i=i0;i<i0+n;i++)
+      {
+        T sum = (T) 0;
+        for (size_t k=0;k<NSUM;k++)
+        {
+          size_t ok,okv;
+          sums.offsets(k,SUM,ok,okv);
+          const T* aa = AP+oa+ok+i*SA;
+          const T* vv = VP+ov+okv;
+          if (SAJ == 1 && SVJ == 1) {sum += simd_auto_dot<T>(NJ,aa,vv);}
+          else {for (long j=0;j<NJ;j++) sum += aa[j*SAJ]*vv[j*SVJ];}
+        }
+        T& cc = CP[oc+of+i*SC];
+        cc = (beta == (T) 0) ? alpha*sum : alpha*sum + beta*cc;
+      }
+    }
+  }
+}
+template void libj::ttv<double>(const libj::tensor<double>& A, const std::string& idxA,
+                                const libj::tensor<double>& V, const std::string& idxV,
+                                libj::tensor<double>& C, const std::string& idxC,
+                                const double alpha, const double beta);
+template void libj::ttv<float>(const libj::tensor<float>& A, const std::string& idxA,
+                               const libj::tensor<float>& V, const std::string& idxV,
+                               libj::tensor<float>& C, const std::string& idxC,
+                               const float alpha, const float beta);
+template void libj::ttv<long>(const libj::tensor<long>& A, const std::string& idxA,
+                              const libj::tensor<long>& V, const std::string& idxV,
+                              libj::tensor<long>& C, const std::string& idxC,
+                              const long alpha, const long beta);
+template void libj::ttv<int>(const libj::tensor<int>& A, const std::string& idxA,
+                             const libj::tensor<int>& V, const std::string& idxV,
+                             libj::tensor<int>& C, const std::string& idxC,
+                             const int alpha, const int beta);
+
+}//end of namespace
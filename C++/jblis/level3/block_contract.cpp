@@ -0,0 +1,163 @@
+/*----------------------------------------------------------------------
+  block_contract.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for the contract function of block_tensors, which
+  performs the tensor contraction
+
+    C = alpha * A . B + beta * C
+
+  block by block. For each stored block of C, the irreps of the M
+  and N labels are fixed by C, and every set of irreps of the K
+  labels gives one block of A and one of B. Pairs where either
+  block is zero by symmetry (or empty) are skipped, and the others
+  are done with the dense libj::contract, with beta on the first
+  and 1 afterwards. Blocks of C with no pairs are only scaled by
+  beta.
+
+----------------------------------------------------------------------*/
+#include <stdio.h>
+#include <vector>
+#include <string>
+#include "jblis_level3.hpp"
+
+namespace libj
+{
+
+/*----------------------------------------------------------------------
+  block_contract_error
+----------------------------------------------------------------------*/
+inline void block_contract_error(const std::string& idxA, const std::string& idxB,
+                                 const std::string& idxC, const char* msg)
+{
+  printf("ERROR libj::contract (block_tensor) \n");
+  printf("%s \n",msg);
+  printf("A = %s, B = %s, C = %s \n",idxA.c_str(),idxB.c_str(),idxC.c_str());
+  exit(1);
+}
+
+/*----------------------------------------------------------------------
+  General code
+----------------------------------------------------------------------*/
+template <typename T>
+void contract(const T alpha, const libj::block_tensor<T>& A, const std::string& idxA,
+              const libj::block_tensor<T>& B, const std::string& idxB,
+              const T beta, libj::block_tensor<T>& C, const std::string& idxC)
+{
+  if (idxA.length() != A.dim() || idxB.length() != B.dim() || idxC.length() != C.dim())
+  {
+    block_contract_error(idxA,idxB,idxC,"The number of labels does not match the tensor dimensions");
+  }
+  const size_t NIRREP = C.nirrep();
+  if (A.nirrep() != NIRREP || B.nirrep() != NIRREP)
+  {
+    block_contract_error(idxA,idxB,idxC,"The tensors have different numbers of irreps");
+  }
+  if ((A.sym() ^ B.sym()) != C.sym())
+  {
+    block_contract_error(idxA,idxB,idxC,"The irrep of C is not the product of those of A and B");
+  }
+
+  //where each label of A and B comes from, C (c) or the K labels (k)
+  std::vector<long> AC(A.dim(),-1), AK(A.dim(),-1), BC(B.dim(),-1), BK(B.dim(),-1);
+  size_t NK = 0;
+  for (size_t a=0;a<idxA.length();a++)
+  {
+    const size_t c = idxC.find(idxA[a]);
+    const size_t b = idxB.find(idxA[a]);
+    if (c != std::string::npos) 
+    {
+      AC[a] = (long) c;
+    } else if (b != std::string::npos) {
+      AK[a] = (long) NK;
+      BK[b] = (long) NK;
+      NK++;
+    }
+  }
+  for (size_t b=0;b<idxB.length();b++)
+  {
+    const size_t c = idxC.find(idxB[b]);
+    if (c != std::string::npos) BC[b] = (long) c;
+  }
+
+  //the irrep lengths of shared labels must match
+  for (size_t a=0;a<A.dim();a++)
+  {
+    for (size_t h=0;h<NIRREP;h++)
+    {
+      if (AC[a] >= 0 && A.size(a,h) != C.size((size_t) AC[a],h))
+      {
+        block_contract_error(idxA,idxB,idxC,"Irrep lengths of A and C do not match");
+      }
+      const size_t b = idxB.find(idxA[a]);
+      if (AK[a] >= 0 && A.size(a,h) != B.size(b,h))
+      {
+        block_contract_error(idxA,idxB,idxC,"Irrep lengths of A and B do not match");
+      }
+    }
+  }
+  for (size_t b=0;b<B.dim();b++)
+  {
+    for (size_t h=0;h<NIRREP;h++)
+    {
+      if (BC[b] >= 0 && B.size(b,h) != C.size((size_t) BC[b],h))
+      {
+        block_contract_error(idxA,idxB,idxC,"Irrep lengths of B and C do not match");
+      }
+    }
+  }
+
+  size_t NKEY = 1;
+  for (size_t k=0;k<NK;k++) NKEY *= NIRREP;
+
+  std::vector<size_t> hA(A.dim()), hB(B.dim()), hK(NK);
+  for (size_t c=0;c<C.num_blocks();c++)
+  {
+    const std::vector<size_t>& hC = C.irreps(c);
+    libj::tensor<T>& CB = C.block(c);
+    bool first = true;
+
+    for (size_t key=0;key<NKEY;key++)
+    {
+      size_t r = key;
+      for (size_t k=0;k<NK;k++) {hK[k] = r%NIRREP; r /= NIRREP;}
+      for (size_t a=0;a<A.dim();a++) hA[a] = (AC[a] >= 0) ? hC[AC[a]] : hK[AK[a]];
+      for (size_t b=0;b<B.dim();b++) hB[b] = (BC[b] >= 0) ? hC[BC[b]] : hK[BK[b]];
+
+      const long ia = A.block_index(hA);
+      const long ib = B.block_index(hB);
+      if (ia < 0 || ib < 0) continue;
+
+      libj::contract<T>(alpha,A.block((size_t) ia),idxA,B.block((size_t) ib),idxB,
+                        first ? beta : (T) 1,CB,idxC);
+      first = false;
+    }
+
+    //no pairs, C = beta*C
+    if (first)
+    {
+      T* cp = CB.data();
+      const long N = (long) CB.size();
+      if (beta == (T) 0) {for (long i=0;i<N;i++) cp[i] = (T) 0;}
+      else if (beta != (T) 1) {for (long i=0;i<N;i++) cp[i] *= beta;}
+    }
+  }
+}
+template void libj::contract<double>(const double alpha, const libj::block_tensor<double>& A,
+                                     const std::string& idxA, const libj::block_tensor<double>& B,
+                                     const std::string& idxB, const double beta,
+                                     libj::block_tensor<double>& C, const std::string& idxC);
+template void libj::contract<float>(const float alpha, const libj::block_tensor<float>& A,
+                                    const std::string& idxA, const libj::block_tensor<float>& B,
+                                    const std::string& idxB, const float beta,
+                                    libj::block_tensor<float>& C, const std::string& idxC);
+template void libj::contract<long>(const long alpha, const libj::block_tensor<long>& A,
+                                   const std::string& idxA, const libj::block_tensor<long>& B,
+                                   const std::string& idxB, const long beta,
+                                   libj::block_tensor<long>& C, const std::string& idxC);
+template void libj::contract<int>(const int alpha, const libj::block_tensor<int>& A,
+                                  const std::string& idxA, const libj::block_tensor<int>& B,
+                                  const std::string& idxB, const int beta,
+                                  libj::block_tensor<int>& C, const std::string& idxC);
+
+}//end of namespace
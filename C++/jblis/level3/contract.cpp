@@ -0,0 +1,1138 @@
+/*----------------------------------------------------------------------
+  contract.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for the contract function, which performs the tensor
+  contraction
+
+    C = alpha * A . B + beta * C
+
+  General flow is as follows
+
+  1) sort the index labels into the M (A and C), N (B and C)
+     and K (A and B) bundles, and view A, B, and C as the
+     tensor_matrix2's A(M,K), B(K,N), and C(M,N). The number of
+     indices in each bundle is a template parameter of
+     tensor_matrix2, so the driver is picked from the
+     instantiations with jblis_contract_switch
+
+  2) loop through KC blocks of K and MC blocks of M, where MC is
+     set from the L2 found at run time (libj::CacheInfo). Each
+     block of A is assigned to block_scatter_matrix2's of BLK::MC
+     rows, and packed into micro-panels of MR rows in a buffer
+     of MC*KC elements. Row blocks of A of stride 1 are copied
+     as lines, those with a constant stride are packed with that
+     stride, and the others through the scatter vectors
+     (block_scatter_matrix2::pack_rows, pack_cols for B)
+
+  3) parallel loop through the NR cols of C. The KCxNR panel of
+     B is packed the same way in contract_macrokernel, and each
+     MRxNR tile of C is done in the microkernel and scattered
+     back into C
+
+  The microkernel, block sizes and zero padding follow linal_gemm.
+
+  A contract_plan runs the same blocking on tensor_matrix2's made
+  once, with their offset tables, the driver and MC picked once,
+  and the buffer of A kept. Each execute checks the shapes and
+  points the matrices at the new data (tensor_matrix2::rebind).
+
+  When A or B is a packed_tensor, contract_packed_drv does the same
+  blocking with run-time bundles, and the elements are unpacked
+  with their signs as the panels are packed.
+
+----------------------------------------------------------------------*/
+#include <stdio.h>
+#include <algorithm>
+#include "jblis_level3.hpp"
+
+#if defined (__AVX2__)
+  #include <immintrin.h>
+#endif
+
+namespace libj
+{
+
+/*----------------------------------------------------------------------
+  block sizes
+    MR x NR      tile of C in registers
+    KC*(MR+NR)   micro-panels of A and B, in L1
+    MC*KC        packed block of A, in L2
+----------------------------------------------------------------------*/
+template <typename T>
+struct jblis_contract_blk {static const size_t MR=4, NR=4, KC=256, MC=96;};
+
+#if defined (__AVX512F__)
+template <> struct jblis_contract_blk<double> {static const size_t MR=16, NR=8, KC=128, MC=192;};
+template <> struct jblis_contract_blk<float>  {static const size_t MR=32, NR=8, KC=128, MC=384;};
+#elif defined (__AVX2__)
+template <> struct jblis_contract_blk<double> {static const size_t MR=8,  NR=6, KC=192, MC=128;};
+template <> struct jblis_contract_blk<float>  {static const size_t MR=16, NR=6, KC=256, MC=192;};
+#else
+template <> struct jblis_contract_blk<float>  {static const size_t MR=8,  NR=4, KC=256, MC=192;};
+#endif
+
+/*----------------------------------------------------------------------
+  register wrappers for the microkernel
+----------------------------------------------------------------------*/
+#if defined (__AVX2__)
+template <typename T>
+struct jblis_contract_vec;
+
+#if defined (__AVX512F__)
+template <>
+struct jblis_contract_vec<double>
+{
+  typedef __m512d V;
+  static const size_t W = 8;
+  static inline V zero() {return _mm512_setzero_pd();}
+  static inline V loadu(const double* p) {return _mm512_loadu_pd(p);}
+  static inline void storeu(double* p, const V a) {_mm512_storeu_pd(p,a);}
+  static inline V set1(const double* p) {return _mm512_set1_pd(*p);}
+  static inline V fmadd(const V a, const V b, const V c) {return _mm512_fmadd_pd(a,b,c);}
+};
+
+template <>
+struct jblis_contract_vec<float>
+{
+  typedef __m512 V;
+  static const size_t W = 16;
+  static inline V zero() {return _mm512_setzero_ps();}
+  static inline V loadu(const float* p) {return _mm512_loadu_ps(p);}
+  static inline void storeu(float* p, const V a) {_mm512_storeu_ps(p,a);}
+  static inline V set1(const float* p) {return _mm512_set1_ps(*p);}
+  static inline V fmadd(const V a, const V b, const V c) {return _mm512_fmadd_ps(a,b,c);}
+};
+#else
+template <>
+struct jblis_contract_vec<double>
+{
+  typedef __m256d V;
+  static const size_t W = 4;
+  static inline V zero() {return _mm256_setzero_pd();}
+  static inline V loadu(const double* p) {return _mm256_loadu_pd(p);}
+  static inline void storeu(double* p, const V a) {_mm256_storeu_pd(p,a);}
+  static inline V set1(const double* p) {return _mm256_broadcast_sd(p);}
+  static inline V fmadd(const V a, const V b, const V c)
+  {
+    #if defined (__FMA__)
+      return _mm256_fmadd_pd(a,b,c);
+    #else
+      return _mm256_add_pd(_mm256_mul_pd(a,b),c);
+    #endif
+  }
+};
+
+template <>
+struct jblis_contract_vec<float>
+{
+  typedef __m256 V;
+  static const size_t W = 8;
+  static inline V zero() {return _mm256_setzero_ps();}
+  static inline V loadu(const float* p) {return _mm256_loadu_ps(p);}
+  static inline void storeu(float* p, const V a) {_mm256_storeu_ps(p,a);}
+  static inline V set1(const float* p) {return _mm256_broadcast_ss(p);}
+  static inline V fmadd(const V a, const V b, const V c)
+  {
+    #if defined (__FMA__)
+      return _mm256_fmadd_ps(a,b,c);
+    #else
+      return _mm256_add_ps(_mm256_mul_ps(a,b),c);
+    #endif
+  }
+};
+#endif
+#endif
+
+/*----------------------------------------------------------------------
+  contract_microkernel
+	AB(MRxNR) = Ap(MRxKB).Bp(KBxNR), generic code
+----------------------------------------------------------------------*/
+template <typename T>
+inline void contract_microkernel(const size_t KB, const T* Ap, const T* Bp, T* AB)
+{
+  typedef jblis_contract_blk<T> BLK;
+  for (size_t j=0;j<BLK::MR*BLK::NR;j++) AB[j] = (T) 0;
+
+  for (size_t k=0;k<KB;k++)
+  {
+    for (size_t j=0;j<BLK::NR;j++)
+    {
+      const T b = Bp[j];
+      for (size_t r=0;r<BLK::MR;r++) AB[r+BLK::MR*j] += Ap[r] * b;
+    }
+    Ap += BLK::MR;
+    Bp += BLK::NR;
+  }
+}
+
+/*----------------------------------------------------------------------
+  contract_microkernel
+	special code for doubles and floats, the MRxNR tile of C is
+	kept in registers
+----------------------------------------------------------------------*/
+#if defined (__AVX2__)
+template <typename T>
+inline void contract_microkernel_vec(const size_t KB, const T* Ap, const T* Bp, T* AB)
+{
+  typedef jblis_contract_blk<T> BLK;
+  typedef jblis_contract_vec<T> S;
+  const size_t MV = BLK::MR/S::W;
+  typename S::V c[MV*BLK::NR];
+  typename S::V a[MV];
+
+  for (size_t j=0;j<MV*BLK::NR;j++) c[j] = S::zero();
+
+  for (size_t k=0;k<KB;k++)
+  {
+    for (size_t v=0;v<MV;v++) a[v] = S::loadu(Ap+v*S::W);
+    for (size_t j=0;j<BLK::NR;j++)
+    {
+      const typename S::V b = S::set1(Bp+j);
+      for (size_t v=0;v<MV;v++) c[v+MV*j] = S::fmadd(a[v],b,c[v+MV*j]);
+    }
+    Ap += BLK::MR;
+    Bp += BLK::NR;
+  }
+
+  for (size_t j=0;j<BLK::NR;j++)
+  {
+    for (size_t v=0;v<MV;v++) S::storeu(AB+v*S::W+BLK::MR*j,c[v+MV*j]);
+  }
+}
+
+template<>
+inline void contract_microkernel(const size_t KB, const double* Ap, const double* Bp, double* AB)
+{
+  contract_microkernel_vec<double>(KB,Ap,Bp,AB);
+}
+
+template<>
+inline void contract_microkernel(const size_t KB, const float* Ap, const float* Bp, float* AB)
+{
+  contract_microkernel_vec<float>(KB,Ap,Bp,AB);
+}
+#endif
+
+/*----------------------------------------------------------------------
+  contract_packA
+	packs rows 0:MB and cols 0:KB of the block of A into
+	micro-panels of MR rows, Ap[k*MR+r], zero padded past MB.
+	Each row block is packed by block_scatter_matrix2::pack_rows,
+	as lines, strided, or gathered
+----------------------------------------------------------------------*/
+template <typename T, typename BSM>
+inline void contract_packA(const size_t MB, const size_t KB, const BSM& BA, T* Ap)
+{
+  const size_t MR = jblis_contract_blk<T>::MR;
+  for (size_t ir=0;ir<MB;ir+=MR)
+  {
+    BA.pack_rows(ir/MR,std::min(MR,MB-ir),KB,Ap);
+    Ap += MR*KB;
+  }
+}
+
+/*----------------------------------------------------------------------
+  contract_packB
+	packs rows 0:KB and cols 0:NB of the panel of B into one
+	micro-panel of NR cols, Bp[k*NR+c], zero padded past NB,
+	with block_scatter_matrix2::pack_cols
+----------------------------------------------------------------------*/
+template <typename T, typename BSM>
+inline void contract_packB(const size_t KB, const size_t NB, const BSM& BB, T* Bp)
+{
+  BB.pack_cols(0,KB,NB,Bp);
+}
+
+/*----------------------------------------------------------------------
+  contract_update
+	C(ir:ir+MR,0:NR) = alpha*AB + beta*C, trimmed to MB,NB
+----------------------------------------------------------------------*/
+template <typename T, typename BSM>
+inline void contract_update(const size_t ir, const size_t mr, const size_t nr,
+                            const T alpha, const T* AB, const T beta, BSM& BC)
+{
+  const size_t MR     = jblis_contract_blk<T>::MR;
+  const size_t stride = BC.block_stride(0,ir/MR);
+  for (size_t c=0;c<nr;c++)
+  {
+    const T* ab = AB + MR*c;
+    if (stride > 0)
+    {
+      T* cc = &BC(ir,c);
+      if (beta == (T) 0)
+      {
+        for (size_t r=0;r<mr;r++) cc[r*stride] = alpha*ab[r];
+      } else {
+        for (size_t r=0;r<mr;r++) cc[r*stride] = alpha*ab[r] + beta*cc[r*stride];
+      }
+    } else {
+      if (beta == (T) 0)
+      {
+        for (size_t r=0;r<mr;r++) BC(ir+r,c) = alpha*ab[r];
+      } else {
+        for (size_t r=0;r<mr;r++) BC(ir+r,c) = alpha*ab[r] + beta*BC(ir+r,c);
+      }
+    }
+  }
+}
+
+/*----------------------------------------------------------------------
+  contract_args
+	the parsed contraction. The bundle strings use 'a' for the
+	first dimension of that tensor, 'b' for the second, etc,
+	as in tensor_matrix2
+----------------------------------------------------------------------*/
+template <typename T>
+struct contract_args
+{
+  T                      alpha;
+  T                      beta;
+  const libj::tensor<T>* A;
+  const libj::tensor<T>* B;
+  libj::tensor<T>*       C;
+  std::string            AM,AK;
+  std::string            BK,BN;
+  std::string            CM,CN;
+};
+
+/*----------------------------------------------------------------------
+  block scatter matrices of the packed blocks of A, B, and C
+----------------------------------------------------------------------*/
+template <typename T>
+struct contract_bsm
+{
+  typedef jblis_contract_blk<T> BLK;
+  typedef libj::block_scatter_matrix2<T,BLK::MC,BLK::KC,BLK::MR,BLK::KC> A;
+  typedef libj::block_scatter_matrix2<T,BLK::KC,BLK::NR,BLK::KC,BLK::NR> B;
+  typedef libj::block_scatter_matrix2<T,BLK::MC,BLK::NR,BLK::MR,BLK::NR> C;
+};
+
+/*----------------------------------------------------------------------
+  jblis_contract_mc
+	rows of the packed block of A, from the L2 of this machine
+	(libj::CacheInfo), so that the block takes about 3/4 of it,
+	as BLK::MC does for a 256 KB L2. The block is packed and
+	scattered in pieces of BLK::MC rows, so the scatter matrices
+	keep their compile time sizes
+----------------------------------------------------------------------*/
+template <typename T>
+inline size_t jblis_contract_mc()
+{
+  typedef jblis_contract_blk<T> BLK;
+  const size_t L2 = libj::CacheInfo::get().L2_elements<T>();
+  const size_t mc = (((3*L2/4)/BLK::KC)/BLK::MR)*BLK::MR;
+  return std::max(mc,(size_t) BLK::MR);
+}
+
+/*----------------------------------------------------------------------
+  contract_macrokernel
+	C(0:MB,0:NR) = alpha*Ap.Bp + beta*C(0:MB,0:NR)
+	for one packed block of A, of MB <= BLK::MC rows, and one
+	packed panel of B. This does not depend on the bundles, so
+	it is not instantiated for each of them
+----------------------------------------------------------------------*/
+template <typename T>
+void contract_macrokernel(const size_t MB, const size_t KB, const size_t NB,
+                          const T alpha, const T* Ap, const T* Bp,
+                          const T beta, typename contract_bsm<T>::C& C_BLOCKED)
+{
+  typedef jblis_contract_blk<T> BLK;
+  const size_t MR = BLK::MR;
+  alignas(LIBJ_MAX_ALIGN) T AB[BLK::MR*BLK::NR];
+
+  for (size_t ir=0;ir<MB;ir+=MR)
+  {
+    const size_t mr = std::min(MR,MB-ir);
+    contract_microkernel<T>(KB,Ap+ir*KB,Bp,AB);
+    contract_update<T>(ir,mr,NB,alpha,AB,beta,C_BLOCKED);
+  }
+}
+
+/*----------------------------------------------------------------------
+  contract_blocked
+	C = alpha*A.B + beta*C over the tensor_matrix2's of the three
+	tensors, with their tables made, in MC x KC blocks of A packed
+	into Ap (MC*KC elements)
+----------------------------------------------------------------------*/
+template <typename T, size_t NM, size_t NK, size_t NN>
+void contract_blocked(const T alpha, const libj::tensor_matrix2<T,NM,NK>& A_MATRIX,
+                      const libj::tensor_matrix2<T,NK,NN>& B_MATRIX, const T beta_in,
+                      libj::tensor_matrix2<T,NM,NN>& C_MATRIX, const size_t MC, T* Ap)
+{
+  typedef jblis_contract_blk<T> BLK;
+  static_assert(BLK::MC%BLK::MR == 0,"libj::contract : MC must be a multiple of MR");
+
+  const size_t NR = BLK::NR;
+  const size_t KC = BLK::KC;
+  const size_t MS = BLK::MC;
+
+  const size_t M  = A_MATRIX.size(0);
+  const size_t K  = A_MATRIX.size(1);
+  const size_t N  = B_MATRIX.size(1);
+  const long   NJ = (long) ((N + NR - 1)/NR);
+
+  typename contract_bsm<T>::A A_BLOCKED;
+
+  for (size_t pc=0;pc<K;pc+=KC)
+  {
+    const size_t kb   = std::min(KC,K-pc);
+    const T      beta = (pc == 0) ? beta_in : (T) 1;
+
+    for (size_t ic=0;ic<M;ic+=MC)
+    {
+      const size_t mb = std::min(MC,M-ic);
+      for (size_t is=0;is<mb;is+=MS)
+      {
+        A_BLOCKED.assign_to_block(A_MATRIX,ic+is,pc);
+        contract_packA<T>(std::min(MS,mb-is),kb,A_BLOCKED,Ap+is*kb);
+      }
+
+      #pragma omp parallel for schedule(static)
+      for (long jb=0;jb<NJ;jb++)
+      {
+        const size_t jr = NR*(size_t) jb;
+        const size_t nb = std::min(NR,N-jr);
+        alignas(LIBJ_MAX_ALIGN) T Bp[BLK::KC*BLK::NR];
+        typename contract_bsm<T>::B B_BLOCKED;
+        typename contract_bsm<T>::C C_BLOCKED;
+        B_BLOCKED.assign_to_block(B_MATRIX,pc,jr);
+        contract_packB<T>(kb,nb,B_BLOCKED,Bp);
+        for (size_t is=0;is<mb;is+=MS)
+        {
+          C_BLOCKED.assign_to_block(C_MATRIX,ic+is,jr);
+          contract_macrokernel<T>(std::min(MS,mb-is),kb,nb,alpha,Ap+is*kb,Bp,beta,C_BLOCKED);
+        }
+      } //loop over jr
+    } //loop over ic
+  } //loop over pc
+}
+
+/*----------------------------------------------------------------------
+  contract_drv
+	contraction for NM, NK, and NN indices in the M, K, and N
+	bundles
+----------------------------------------------------------------------*/
+template <typename T, size_t NM, size_t NK, size_t NN>
+void contract_drv(const contract_args<T>& X)
+{
+  const size_t MC = jblis_contract_mc<T>();
+
+  //the bundle offsets are cached, so each block scatter is a set of lookups
+  libj::tensor_matrix2<T,NM,NK> A_MATRIX(*X.A,X.AM,X.AK);
+  libj::tensor_matrix2<T,NK,NN> B_MATRIX(*X.B,X.BK,X.BN);
+  libj::tensor_matrix2<T,NM,NN> C_MATRIX(*X.C,X.CM,X.CN);
+  A_MATRIX.make_tables();
+  B_MATRIX.make_tables();
+  C_MATRIX.make_tables();
+
+  libj::cache_buffer<T> A_BUFFER(MC*jblis_contract_blk<T>::KC);
+  contract_blocked<T,NM,NK,NN>(X.alpha,A_MATRIX,B_MATRIX,X.beta,C_MATRIX,MC,A_BUFFER.data());
+}
+
+/*----------------------------------------------------------------------
+  contract_plan_drv
+	contract_drv with the tensor_matrix2's, their tables, MC and the
+	buffer of A kept, so that each run only points the matrices at
+	the new tensors
+----------------------------------------------------------------------*/
+template <typename T>
+struct contract_plan_base
+{
+  virtual ~contract_plan_base() {}
+  virtual void run(const T alpha, const libj::tensor<T>& A, const libj::tensor<T>& B,
+                   const T beta, libj::tensor<T>& C) = 0;
+};
+
+template <typename T, size_t NM, size_t NK, size_t NN>
+struct contract_plan_drv : public contract_plan_base<T>
+{
+  size_t                        MC;
+  libj::tensor_matrix2<T,NM,NK> A_MATRIX;
+  libj::tensor_matrix2<T,NK,NN> B_MATRIX;
+  libj::tensor_matrix2<T,NM,NN> C_MATRIX;
+  libj::cache_buffer<T>         A_BUFFER;
+
+  contract_plan_drv(const contract_args<T>& X)
+    : MC(jblis_contract_mc<T>()),
+      A_MATRIX(*X.A,X.AM,X.AK), B_MATRIX(*X.B,X.BK,X.BN), C_MATRIX(*X.C,X.CM,X.CN),
+      A_BUFFER(MC*jblis_contract_blk<T>::KC)
+  {
+    A_MATRIX.make_tables();
+    B_MATRIX.make_tables();
+    C_MATRIX.make_tables();
+  }
+
+  void run(const T alpha, const libj::tensor<T>& A, const libj::tensor<T>& B,
+           const T beta, libj::tensor<T>& C)
+  {
+    A_MATRIX.rebind(A);
+    B_MATRIX.rebind(B);
+    C_MATRIX.rebind(C);
+    contract_blocked<T,NM,NK,NN>(alpha,A_MATRIX,B_MATRIX,beta,C_MATRIX,MC,A_BUFFER.data());
+  }
+};
+
+/*----------------------------------------------------------------------
+  jblis_contract_switch
+	picks contract_drv<T,NM,NK,NN> from the run-time bundle sizes,
+	with ID = NM + NB*(NK + NB*NN). Only the bundles that give
+	tensors of 1 to JBLIS_CONTRACT_MAX_DIM dimensions are
+	instantiated
+----------------------------------------------------------------------*/
+template <typename T, size_t NM, size_t NK, size_t NN,
+          bool OK = (NM+NK >= 1 && NM+NK <= JBLIS_CONTRACT_MAX_DIM &&
+                     NK+NN >= 1 && NK+NN <= JBLIS_CONTRACT_MAX_DIM &&
+                     NM+NN >= 1 && NM+NN <= JBLIS_CONTRACT_MAX_DIM)>
+struct jblis_contract_call
+{
+  static void run(const contract_args<T>& X) {contract_drv<T,NM,NK,NN>(X);}
+  static contract_plan_base<T>* plan(const contract_args<T>& X)
+  {
+    return new contract_plan_drv<T,NM,NK,NN>(X);
+  }
+};
+
+template <typename T, size_t NM, size_t NK, size_t NN>
+struct jblis_contract_call<T,NM,NK,NN,false>
+{
+  static void run(const contract_args<T>& X) {}
+  static contract_plan_base<T>* plan(const contract_args<T>& X) {return NULL;}
+};
+
+template <typename T, size_t ID>
+struct jblis_contract_switch
+{
+  static const size_t NB = JBLIS_CONTRACT_MAX_DIM+1;
+  static void run(const size_t id, const contract_args<T>& X)
+  {
+    if (id == ID) {jblis_contract_call<T,ID%NB,(ID/NB)%NB,ID/(NB*NB)>::run(X);}
+    else          {jblis_contract_switch<T,ID+1>::run(id,X);}
+  }
+  static contract_plan_base<T>* plan(const size_t id, const contract_args<T>& X)
+  {
+    if (id == ID) {return jblis_contract_call<T,ID%NB,(ID/NB)%NB,ID/(NB*NB)>::plan(X);}
+    else          {return jblis_contract_switch<T,ID+1>::plan(id,X);}
+  }
+};
+
+template <typename T>
+struct jblis_contract_switch<T,(JBLIS_CONTRACT_MAX_DIM+1)*(JBLIS_CONTRACT_MAX_DIM+1)*
+                               (JBLIS_CONTRACT_MAX_DIM+1)>
+{
+  static void run(const size_t id, const contract_args<T>& X) {}
+  static contract_plan_base<T>* plan(const size_t id, const contract_args<T>& X) {return NULL;}
+};
+
+/*----------------------------------------------------------------------
+  contract_error
+----------------------------------------------------------------------*/
+inline void contract_error(const std::string& idxA, const std::string& idxB,
+                           const std::string& idxC, const char* msg)
+{
+  printf("ERROR libj::contract \n");
+  printf("%s \n",msg);
+  printf("A = %s, B = %s, C = %s \n",idxA.c_str(),idxB.c_str(),idxC.c_str());
+  exit(1);
+}
+
+/*----------------------------------------------------------------------
+  contract_labels
+	sorts the labels into the M, K, and N bundles, as bundle strings
+	of each tensor. This only needs dim() and size(d), so it is shared
+	by the dense and packed tensors
+----------------------------------------------------------------------*/
+template <typename TA, typename TB, typename TC>
+void contract_labels(const TA& A, const std::string& idxA, const TB& B, const std::string& idxB,
+                     const TC& C, const std::string& idxC,
+                     std::string& AM, std::string& AK, std::string& BK,
+                     std::string& BN, std::string& CM, std::string& CN)
+{
+  //M and N bundles, in the order of C
+  for (size_t c=0;c<idxC.length();c++)
+  {
+    const size_t a = idxA.find(idxC[c]);
+    const size_t b = idxB.find(idxC[c]);
+    if (idxC.find(idxC[c]) != c) {contract_error(idxA,idxB,idxC,"Repeated label in C");}
+    if (a != std::string::npos && b != std::string::npos)
+    {
+      contract_error(idxA,idxB,idxC,"Labels in A, B, and C are not supported");
+    } else if (a != std::string::npos) {
+      if (A.size(a) != C.size(c)) {contract_error(idxA,idxB,idxC,"Lengths of A and C do not match");}
+      AM.push_back((char)((int) 'a' + (int) a));
+      CM.push_back((char)((int) 'a' + (int) c));
+    } else if (b != std::string::npos) {
+      if (B.size(b) != C.size(c)) {contract_error(idxA,idxB,idxC,"Lengths of B and C do not match");}
+      BN.push_back((char)((int) 'a' + (int) b));
+      CN.push_back((char)((int) 'a' + (int) c));
+    } else {
+      contract_error(idxA,idxB,idxC,"Label of C is not in A or B");
+    }
+  }
+
+  //K bundle, in the order of A
+  for (size_t a=0;a<idxA.length();a++)
+  {
+    if (idxA.find(idxA[a]) != a) {contract_error(idxA,idxB,idxC,"Repeated label in A");}
+    if (idxC.find(idxA[a]) != std::string::npos) continue;
+    const size_t b = idxB.find(idxA[a]);
+    if (b == std::string::npos) {contract_error(idxA,idxB,idxC,"Label of A is not in B or C");}
+    if (A.size(a) != B.size(b)) {contract_error(idxA,idxB,idxC,"Lengths of A and B do not match");}
+    AK.push_back((char)((int) 'a' + (int) a));
+    BK.push_back((char)((int) 'a' + (int) b));
+  }
+  for (size_t b=0;b<idxB.length();b++)
+  {
+    if (idxB.find(idxB[b]) != b) {contract_error(idxA,idxB,idxC,"Repeated label in B");}
+    if (idxA.find(idxB[b]) == std::string::npos && idxC.find(idxB[b]) == std::string::npos)
+    {
+      contract_error(idxA,idxB,idxC,"Label of B is not in A or C");
+    }
+  }
+}
+
+/*----------------------------------------------------------------------
+  contract_parse
+	checks the labels and fills the bundles of X, returns the ID of
+	the driver for jblis_contract_switch
+----------------------------------------------------------------------*/
+template <typename T>
+size_t contract_parse(const libj::tensor<T>& A, const std::string& idxA,
+                      const libj::tensor<T>& B, const std::string& idxB,
+                      libj::tensor<T>& C, const std::string& idxC, contract_args<T>& X)
+{
+  if (idxA.length() != A.dim() || idxB.length() != B.dim() || idxC.length() != C.dim())
+  {
+    contract_error(idxA,idxB,idxC,"The number of labels does not match the tensor dimensions");
+  }
+  if (std::max(A.dim(),std::max(B.dim(),C.dim())) > JBLIS_CONTRACT_MAX_DIM)
+  {
+    contract_error(idxA,idxB,idxC,"Too many dimensions, see JBLIS_CONTRACT_MAX_DIM");
+  }
+
+  X.A = &A;
+  X.B = &B;
+  X.C = &C;
+  contract_labels(A,idxA,B,idxB,C,idxC,X.AM,X.AK,X.BK,X.BN,X.CM,X.CN);
+
+  const size_t NM = X.CM.length();
+  const size_t NK = X.AK.length();
+  const size_t NN = X.CN.length();
+  const size_t NB = JBLIS_CONTRACT_MAX_DIM+1;
+  return NM + NB*(NK + NB*NN);
+}
+
+/*----------------------------------------------------------------------
+  General code
+----------------------------------------------------------------------*/
+template <typename T>
+void contract(const T alpha, const libj::tensor<T>& A, const std::string& idxA,
+              const libj::tensor<T>& B, const std::string& idxB,
+              const T beta, libj::tensor<T>& C, const std::string& idxC)
+{
+  contract_args<T> X;
+  X.alpha = alpha;
+  X.beta  = beta;
+  const size_t id = contract_parse(A,idxA,B,idxB,C,idxC,X);
+  jblis_contract_switch<T,0>::run(id,X);
+}
+template void libj::contract<double>(const double alpha, const libj::tensor<double>& A,
+                                     const std::string& idxA, const libj::tensor<double>& B,
+                                     const std::string& idxB, const double beta,
+                                     libj::tensor<double>& C, const std::string& idxC);
+template void libj::contract<float>(const float alpha, const libj::tensor<float>& A,
+                                    const std::string& idxA, const libj::tensor<float>& B,
+                                    const std::string& idxB, const float beta,
+                                    libj::tensor<float>& C, const std::string& idxC);
+template void libj::contract<long>(const long alpha, const libj::tensor<long>& A,
+                                   const std::string& idxA, const libj::tensor<long>& B,
+                                   const std::string& idxB, const long beta,
+                                   libj::tensor<long>& C, const std::string& idxC);
+template void libj::contract<int>(const int alpha, const libj::tensor<int>& A,
+                                  const std::string& idxA, const libj::tensor<int>& B,
+                                  const std::string& idxB, const int beta,
+                                  libj::tensor<int>& C, const std::string& idxC);
+
+/*----------------------------------------------------------------------
+  contract_bundled
+	the contraction with the bundles made at compile time (libj::idx),
+	only the ranks and the lengths are checked
+----------------------------------------------------------------------*/
+template <typename T>
+void contract_bundled(const T alpha, const libj::tensor<T>& A, const libj::tensor<T>& B,
+                      const T beta, libj::tensor<T>& C, const char* const BUN[6],
+                      const char* const IDX[3])
+{
+  const std::string idxA(IDX[0]), idxB(IDX[1]), idxC(IDX[2]);
+  if (idxA.length() != A.dim() || idxB.length() != B.dim() || idxC.length() != C.dim())
+  {
+    contract_error(idxA,idxB,idxC,"The number of labels does not match the tensor dimensions");
+  }
+
+  contract_args<T> X;
+  X.alpha = alpha;
+  X.beta  = beta;
+  X.A     = &A;
+  X.B     = &B;
+  X.C     = &C;
+  X.AM = BUN[0]; X.AK = BUN[1];
+  X.BK = BUN[2]; X.BN = BUN[3];
+  X.CM = BUN[4]; X.CN = BUN[5];
+  for (size_t k=0;k<X.CM.length();k++)
+  {
+    if (A.size(X.AM[k]-'a') != C.size(X.CM[k]-'a')) {contract_error(idxA,idxB,idxC,"Lengths of A and C do not match");}
+  }
+  for (size_t k=0;k<X.CN.length();k++)
+  {
+    if (B.size(X.BN[k]-'a') != C.size(X.CN[k]-'a')) {contract_error(idxA,idxB,idxC,"Lengths of B and C do not match");}
+  }
+  for (size_t k=0;k<X.AK.length();k++)
+  {
+    if (A.size(X.AK[k]-'a') != B.size(X.BK[k]-'a')) {contract_error(idxA,idxB,idxC,"Lengths of A and B do not match");}
+  }
+
+  const size_t NB = JBLIS_CONTRACT_MAX_DIM+1;
+  const size_t id = X.CM.length() + NB*(X.AK.length() + NB*X.CN.length());
+  jblis_contract_switch<T,0>::run(id,X);
+}
+template void libj::contract_bundled<double>(const double alpha, const libj::tensor<double>& A,
+                                             const libj::tensor<double>& B, const double beta,
+                                             libj::tensor<double>& C, const char* const BUN[6],
+                                             const char* const IDX[3]);
+template void libj::contract_bundled<float>(const float alpha, const libj::tensor<float>& A,
+                                            const libj::tensor<float>& B, const float beta,
+                                            libj::tensor<float>& C, const char* const BUN[6],
+                                            const char* const IDX[3]);
+template void libj::contract_bundled<long>(const long alpha, const libj::tensor<long>& A,
+                                           const libj::tensor<long>& B, const long beta,
+                                           libj::tensor<long>& C, const char* const BUN[6],
+                                           const char* const IDX[3]);
+template void libj::contract_bundled<int>(const int alpha, const libj::tensor<int>& A,
+                                          const libj::tensor<int>& B, const int beta,
+                                          libj::tensor<int>& C, const char* const BUN[6],
+                                          const char* const IDX[3]);
+
+/*----------------------------------------------------------------------
+  contract_plan
+----------------------------------------------------------------------*/
+template <typename T>
+contract_plan<T>::contract_plan(const libj::tensor<T>& A, const std::string& idxA,
+                                const libj::tensor<T>& B, const std::string& idxB,
+                                libj::tensor<T>& C, const std::string& idxC)
+{
+  contract_args<T> X;
+  X.alpha = (T) 1;
+  X.beta  = (T) 0;
+  const size_t id = contract_parse(A,idxA,B,idxB,C,idxC,X);
+
+  M_IDXA = idxA;
+  M_IDXB = idxB;
+  M_IDXC = idxC;
+  const libj::tensor<T>* TENS[3] = {&A,&B,&C};
+  for (size_t t=0;t<3;t++)
+  {
+    M_NDIM[t] = TENS[t]->dim();
+    for (size_t d=0;d<M_NDIM[t];d++)
+    {
+      M_LENGTHS[t][d] = TENS[t]->size(d);
+      M_STRIDES[t][d] = TENS[t]->stride(d);
+    }
+  }
+  M_DRV.reset(jblis_contract_switch<T,0>::plan(id,X));
+}
+
+//the tensor must have the lengths and strides it was planned with
+template <typename T>
+void contract_plan<T>::m_check(const size_t t, const libj::tensor<T>& X) const
+{
+  bool good = (X.dim() == M_NDIM[t]);
+  for (size_t d=0;good && d<M_NDIM[t];d++)
+  {
+    good = (X.size(d) == M_LENGTHS[t][d] && X.stride(d) == M_STRIDES[t][d]);
+  }
+  if (!good)
+  {
+    const char NAME[3] = {'A','B','C'};
+    printf("ERROR libj::contract_plan::execute \n");
+    printf("%c does not have the lengths and strides of the plan \n",NAME[t]);
+    printf("A = %s, B = %s, C = %s \n",M_IDXA.c_str(),M_IDXB.c_str(),M_IDXC.c_str());
+    exit(1);
+  }
+}
+
+template <typename T>
+void contract_plan<T>::execute(const T alpha, const libj::tensor<T>& A, const libj::tensor<T>& B,
+                               const T beta, libj::tensor<T>& C)
+{
+  if (!M_DRV)
+  {
+    printf("ERROR libj::contract_plan::execute \n");
+    printf("the plan is not set \n");
+    exit(1);
+  }
+  m_check(0,A);
+  m_check(1,B);
+  m_check(2,C);
+  M_DRV->run(alpha,A,B,beta,C);
+}
+template class libj::contract_plan<double>;
+template class libj::contract_plan<float>;
+template class libj::contract_plan<long>;
+template class libj::contract_plan<int>;
+
+template <typename T>
+contract_plan<T> plan_contract(const libj::tensor<T>& A, const std::string& idxA,
+                               const libj::tensor<T>& B, const std::string& idxB,
+                               libj::tensor<T>& C, const std::string& idxC)
+{
+  return contract_plan<T>(A,idxA,B,idxB,C,idxC);
+}
+template libj::contract_plan<double> libj::plan_contract<double>(const libj::tensor<double>& A,
+  const std::string& idxA, const libj::tensor<double>& B, const std::string& idxB,
+  libj::tensor<double>& C, const std::string& idxC);
+template libj::contract_plan<float> libj::plan_contract<float>(const libj::tensor<float>& A,
+  const std::string& idxA, const libj::tensor<float>& B, const std::string& idxB,
+  libj::tensor<float>& C, const std::string& idxC);
+template libj::contract_plan<long> libj::plan_contract<long>(const libj::tensor<long>& A,
+  const std::string& idxA, const libj::tensor<long>& B, const std::string& idxB,
+  libj::tensor<long>& C, const std::string& idxC);
+template libj::contract_plan<int> libj::plan_contract<int>(const libj::tensor<int>& A,
+  const std::string& idxA, const libj::tensor<int>& B, const std::string& idxB,
+  libj::tensor<int>& C, const std::string& idxC);
+
+/*----------------------------------------------------------------------
+  contract_packed_bundle
+	the rows or cols of a packed_tensor viewed as a matrix, for the
+	dimensions in the bundle string BUN ('a' for dimension 0, etc).
+	The groups with all of their dimensions in this bundle give an
+	offset and sign for each index, and the groups split between the
+	rows and cols give a part of the group's full index, which is
+	added to that of the other bundle and looked up in the code table
+----------------------------------------------------------------------*/
+struct contract_packed_bundle
+{
+  size_t              NELM;  //number of indices
+  std::vector<long>   OFF;   //offset of the whole groups
+  std::vector<int>    SGN;   //sign of the whole groups, 0 if zero
+  std::vector<size_t> PART;  //partial full index of each split group
+
+  template <typename T>
+  void make(const libj::packed_tensor<T>& X, const std::string& BUN,
+            const std::vector<bool>& split, const std::vector<size_t>& SPLIT)
+  {
+    std::vector<size_t> dims(BUN.length());
+    NELM = 1;
+    for (size_t i=0;i<BUN.length();i++)
+    {
+      dims[i] = (size_t) (BUN[i] - 'a');
+      NELM *= X.size(dims[i]);
+    }
+    OFF.assign(NELM,0);
+    SGN.assign(NELM,1);
+    PART.assign(NELM*SPLIT.size(),0);
+
+    std::vector<size_t> full(X.num_groups());
+    std::vector<bool>   here(X.num_groups(),false);
+    for (size_t i=0;i<dims.size();i++) here[X.group(dims[i])] = true;
+    for (size_t I=0;I<NELM;I++)
+    {
+      std::fill(full.begin(),full.end(),0);
+      size_t r = I;
+      for (size_t i=0;i<dims.size();i++)
+      {
+        const size_t d = dims[i];
+        full[X.group(d)] += (r%X.size(d))*X.group_stride(d);
+        r /= X.size(d);
+      }
+      for (size_t g=0;g<full.size();g++)
+      {
+        if (!here[g] || split[g]) continue;
+        const libj::packed_group& G = X.group_info(g);
+        const long code = G.CODE[full[g]];
+        if (code == 0) {SGN[I] = 0; continue;}
+        if (code < 0) SGN[I] = -SGN[I];
+        OFF[I] += ((code > 0 ? code : -code)-1)*(long) G.STRIDE;
+      }
+      for (size_t k=0;k<SPLIT.size();k++) PART[I*SPLIT.size()+k] = full[SPLIT[k]];
+    }
+  }
+};
+
+/*----------------------------------------------------------------------
+  contract_packed_matrix
+	a packed_tensor as the matrix X(ROW,COL). Elements are unpacked
+	with their sign as they are read
+----------------------------------------------------------------------*/
+template <typename T>
+struct contract_packed_matrix
+{
+  const T*                                P;
+  std::vector<const libj::packed_group*>  GRP;  //split groups
+  contract_packed_bundle                  ROW;
+  contract_packed_bundle                  COL;
+
+  void make(const libj::packed_tensor<T>& X, const std::string& R, const std::string& C)
+  {
+    P = X.data();
+    std::vector<bool> inR(X.num_groups(),false), inC(X.num_groups(),false), split(X.num_groups());
+    for (size_t i=0;i<R.length();i++) inR[X.group((size_t) (R[i]-'a'))] = true;
+    for (size_t i=0;i<C.length();i++) inC[X.group((size_t) (C[i]-'a'))] = true;
+    std::vector<size_t> SPLIT;
+    GRP.clear();
+    for (size_t g=0;g<X.num_groups();g++)
+    {
+      split[g] = inR[g] && inC[g];
+      if (split[g]) {SPLIT.push_back(g); GRP.push_back(&X.group_info(g));}
+    }
+    ROW.make(X,R,split,SPLIT);
+    COL.make(X,C,split,SPLIT);
+  }
+
+  size_t size(const size_t dim) const {return dim == 0 ? ROW.NELM : COL.NELM;}
+
+  T operator() (const size_t I, const size_t J) const
+  {
+    int  sign = ROW.SGN[I]*COL.SGN[J];
+    if (sign == 0) return (T) 0;
+    long off  = ROW.OFF[I] + COL.OFF[J];
+    const size_t NS = GRP.size();
+    for (size_t k=0;k<NS;k++)
+    {
+      long code = GRP[k]->CODE[ROW.PART[I*NS+k] + COL.PART[J*NS+k]];
+      if (code == 0) return (T) 0;
+      if (code < 0) {sign = -sign; code = -code;}
+      off += (code-1)*(long) GRP[k]->STRIDE;
+    }
+    return (sign > 0) ? P[off] : -P[off];
+  }
+};
+
+/*----------------------------------------------------------------------
+  contract_dense_block
+	block of the dense C at row and col offsets R and C, with the
+	row strides RS of each MR block (0 if not constant), for
+	contract_update
+----------------------------------------------------------------------*/
+template <typename T>
+struct contract_dense_block
+{
+  T*            P;
+  const size_t* R;
+  const size_t* C;
+  const size_t* RS;
+
+  size_t block_stride(const size_t dim, const size_t block) const {return RS[block];}
+  T& operator() (const size_t I, const size_t J) {return P[R[I]+C[J]];}
+};
+
+/*----------------------------------------------------------------------
+  contract_dense_offsets
+	offsets in the dense tensor X of each index of bundle BUN
+----------------------------------------------------------------------*/
+template <typename T>
+void contract_dense_offsets(const libj::tensor<T>& X, const std::string& BUN,
+                            std::vector<size_t>& OFF)
+{
+  size_t N = 1;
+  for (size_t i=0;i<BUN.length();i++) N *= X.size((size_t) (BUN[i]-'a'));
+  OFF.assign(N,0);
+  for (size_t I=0;I<N;I++)
+  {
+    size_t r = I;
+    for (size_t i=0;i<BUN.length();i++)
+    {
+      const size_t d = (size_t) (BUN[i]-'a');
+      OFF[I] += (r%X.size(d))*X.stride(d);
+      r /= X.size(d);
+    }
+  }
+}
+
+/*----------------------------------------------------------------------
+  contract_packed_drv
+	the same blocking as contract_drv, but the panels of A and B are
+	unpacked from the packed tensors as they are packed. The bundles
+	are only known at run time here, so there is one driver
+----------------------------------------------------------------------*/
+template <typename T>
+void contract_packed_drv(const T alpha, const contract_packed_matrix<T>& A_MATRIX,
+                         const contract_packed_matrix<T>& B_MATRIX, const T beta,
+                         libj::tensor<T>& C, const std::string& CM, const std::string& CN)
+{
+  typedef jblis_contract_blk<T> BLK;
+  const size_t MR = BLK::MR;
+  const size_t NR = BLK::NR;
+  const size_t KC = BLK::KC;
+  const size_t MC = jblis_contract_mc<T>();
+
+  std::vector<size_t> CR, CC;
+  contract_dense_offsets(C,CM,CR);
+  contract_dense_offsets(C,CN,CC);
+
+  const size_t M  = A_MATRIX.size(0);
+  const size_t K  = A_MATRIX.size(1);
+  const size_t N  = B_MATRIX.size(1);
+  const long   NJ = (long) ((N + NR - 1)/NR);
+
+  //row strides of each MR block of C
+  std::vector<size_t> CRS((M + MR - 1)/MR,0);
+  for (size_t b=0;b<CRS.size();b++)
+  {
+    const size_t ir = b*MR;
+    if (ir + MR > M) continue;
+    const size_t s = CR[ir+1] - CR[ir];
+    bool ok = s > 0;
+    for (size_t r=1;r<MR && ok;r++) ok = (CR[ir+r] == CR[ir] + r*s);
+    if (ok) CRS[b] = s;
+  }
+
+  libj::cache_buffer<T> A_BUFFER(MC*KC);
+  T* Ap = A_BUFFER.data();
+
+  for (size_t pc=0;pc<K;pc+=KC)
+  {
+    const size_t kb = std::min(KC,K-pc);
+    const T      bb = (pc == 0) ? beta : (T) 1;
+
+    for (size_t ic=0;ic<M;ic+=MC)
+    {
+      const size_t mb = std::min(MC,M-ic);
+
+      //unpack the block of A into micro-panels of MR rows
+      T* ap = Ap;
+      for (size_t ir=0;ir<mb;ir+=MR)
+      {
+        const size_t mr = std::min(MR,mb-ir);
+        for (size_t k=0;k<kb;k++)
+        {
+          for (size_t r=0;r<mr;r++) ap[k*MR+r] = A_MATRIX(ic+ir+r,pc+k);
+          for (size_t r=mr;r<MR;r++) ap[k*MR+r] = (T) 0;
+        }
+        ap += MR*kb;
+      }
+
+      #pragma omp parallel for schedule(static)
+      for (long jb=0;jb<NJ;jb++)
+      {
+        const size_t jr = NR*(size_t) jb;
+        const size_t nb = std::min(NR,N-jr);
+        alignas(LIBJ_MAX_ALIGN) T Bp[BLK::KC*BLK::NR];
+        alignas(LIBJ_MAX_ALIGN) T AB[BLK::MR*BLK::NR];
+
+        //unpack the panel of B into one micro-panel of NR cols
+        for (size_t c=0;c<nb;c++)
+        {
+          for (size_t k=0;k<kb;k++) Bp[k*NR+c] = B_MATRIX(pc+k,jr+c);
+        }
+        for (size_t c=nb;c<NR;c++)
+        {
+          for (size_t k=0;k<kb;k++) Bp[k*NR+c] = (T) 0;
+        }
+
+        contract_dense_block<T> C_BLOCKED;
+        C_BLOCKED.P  = C.data();
+        C_BLOCKED.R  = CR.data() + ic;
+        C_BLOCKED.C  = CC.data() + jr;
+        C_BLOCKED.RS = CRS.data() + ic/MR;
+        for (size_t ir=0;ir<mb;ir+=MR)
+        {
+          const size_t mr = std::min(MR,mb-ir);
+          contract_microkernel<T>(kb,Ap+ir*kb,Bp,AB);
+          contract_update<T>(ir,mr,nb,alpha,AB,bb,C_BLOCKED);
+        }
+      } //loop over jr
+    } //loop over ic
+  } //loop over pc
+}
+
+/*----------------------------------------------------------------------
+  Packed code
+----------------------------------------------------------------------*/
+template <typename T>
+void contract(const T alpha, const libj::packed_tensor<T>& A, const std::string& idxA,
+              const libj::packed_tensor<T>& B, const std::string& idxB,
+              const T beta, libj::tensor<T>& C, const std::string& idxC)
+{
+  if (idxA.length() != A.dim() || idxB.length() != B.dim() || idxC.length() != C.dim())
+  {
+    contract_error(idxA,idxB,idxC,"The number of labels does not match the tensor dimensions");
+  }
+
+  std::string AM,AK,BK,BN,CM,CN;
+  contract_labels(A,idxA,B,idxB,C,idxC,AM,AK,BK,BN,CM,CN);
+
+  contract_packed_matrix<T> A_MATRIX, B_MATRIX;
+  A_MATRIX.make(A,AM,AK);
+  B_MATRIX.make(B,BK,BN);
+  contract_packed_drv<T>(alpha,A_MATRIX,B_MATRIX,beta,C,CM,CN);
+}
+template void libj::contract<double>(const double alpha, const libj::packed_tensor<double>& A,
+                                     const std::string& idxA, const libj::packed_tensor<double>& B,
+                                     const std::string& idxB, const double beta,
+                                     libj::tensor<double>& C, const std::string& idxC);
+template void libj::contract<float>(const float alpha, const libj::packed_tensor<float>& A,
+                                    const std::string& idxA, const libj::packed_tensor<float>& B,
+                                    const std::string& idxB, const float beta,
+                                    libj::tensor<float>& C, const std::string& idxC);
+template void libj::contract<long>(const long alpha, const libj::packed_tensor<long>& A,
+                                   const std::string& idxA, const libj::packed_tensor<long>& B,
+                                   const std::string& idxB, const long beta,
+                                   libj::tensor<long>& C, const std::string& idxC);
+template void libj::contract<int>(const int alpha, const libj::packed_tensor<int>& A,
+                                  const std::string& idxA, const libj::packed_tensor<int>& B,
+                                  const std::string& idxB, const int beta,
+                                  libj::tensor<int>& C, const std::string& idxC);
+
+template <typename T>
+void contract(const T alpha, const libj::packed_tensor<T>& A, const std::string& idxA,
+              const libj::tensor<T>& B, const std::string& idxB,
+              const T beta, libj::tensor<T>& C, const std::string& idxC)
+{
+  libj::packed_tensor<T> BP;
+  BP.assign(B);
+  libj::contract<T>(alpha,A,idxA,BP,idxB,beta,C,idxC);
+}
+template void libj::contract<double>(const double alpha, const libj::packed_tensor<double>& A,
+                                     const std::string& idxA, const libj::tensor<double>& B,
+                                     const std::string& idxB, const double beta,
+                                     libj::tensor<double>& C, const std::string& idxC);
+template void libj::contract<float>(const float alpha, const libj::packed_tensor<float>& A,
+                                    const std::string& idxA, const libj::tensor<float>& B,
+                                    const std::string& idxB, const float beta,
+                                    libj::tensor<float>& C, const std::string& idxC);
+template void libj::contract<long>(const long alpha, const libj::packed_tensor<long>& A,
+                                   const std::string& idxA, const libj::tensor<long>& B,
+                                   const std::string& idxB, const long beta,
+                                   libj::tensor<long>& C, const std::string& idxC);
+template void libj::contract<int>(const int alpha, const libj::packed_tensor<int>& A,
+                                  const std::string& idxA, const libj::tensor<int>& B,
+                                  const std::string& idxB, const int beta,
+                                  libj::tensor<int>& C, const std::string& idxC);
+
+template <typename T>
+void contract(const T alpha, const libj::tensor<T>& A, const std::string& idxA,
+              const libj::packed_tensor<T>& B, const std::string& idxB,
+              const T beta, libj::tensor<T>& C, const std::string& idxC)
+{
+  libj::packed_tensor<T> AP;
+  AP.assign(A);
+  libj::contract<T>(alpha,AP,idxA,B,idxB,beta,C,idxC);
+}
+template void libj::contract<double>(const double alpha, const libj::tensor<double>& A,
+                                     const std::string& idxA, const libj::packed_tensor<double>& B,
+                                     const std::string& idxB, const double beta,
+                                     libj::tensor<double>& C, const std::string& idxC);
+template void libj::contract<float>(const float alpha, const libj::tensor<float>& A,
+                                    const std::string& idxA, const libj::packed_tensor<float>& B,
+                                    const std::string& idxB, const float beta,
+                                    libj::tensor<float>& C, const std::string& idxC);
+template void libj::contract<long>(const long alpha, const libj::tensor<long>& A,
+                                   const std::string& idxA, const libj::packed_tensor<long>& B,
+                                   const std::string& idxB, const long beta,
+                                   libj::tensor<long>& C, const std::string& idxC);
+template void libj::contract<int>(const int alpha, const libj::tensor<int>& A,
+                                  const std::string& idxA, const libj::packed_tensor<int>& B,
+                                  const std::string& idxB, const int beta,
+                                  libj::tensor<int>& C, const std::string& idxC);
+
+}//end of namespace
@@ -0,0 +1,537 @@
+/*----------------------------------------------------------------------
+  einsum.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for einsum, the contraction of several tensors,
+
+    libj::einsum("ijab,ijmn,mnef->abef",{&T,&V,&T},W);
+
+  done as a sequence of pairwise libj::contract's, in an order that
+  is chosen by einsum_optimize.
+
+  The order is a tree of pairs. For each set of inputs, the
+  intermediate keeps the labels of the set that are also in the
+  other inputs or in the output, so the cost of a pair is
+  2*prod(lengths of all its labels) flops. Up to EINSUM_OPTIMAL_MAX
+  inputs, every tree is searched (over the subsets of the inputs,
+  smallest first), beyond that the cheapest pair is taken one at a
+  time (greedy). The trees are compared by
+
+    EINSUM_FLOPS  : the flops, then the peak memory
+    EINSUM_MEMORY : the peak memory, then the flops
+
+  where the peak is the largest number of elements of intermediates
+  alive at once, with the subtree of the larger peak done first.
+  Trees with a larger peak than max_elements (if not 0) are not
+  taken, nor are pairs with tensors of more than
+  JBLIS_CONTRACT_MAX_DIM dimensions.
+
+  The intermediates are checked out of a core_arena, either the
+  caller's or one sized for the path (einsum_arena, which follows
+  the LIFO order of the arena). Only the last pair has alpha and
+  beta, and writes to C.
+
+----------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include "jblis_level3.hpp"
+#include "jblis_level1.hpp"
+
+//largest number of inputs for the search over all trees
+#define EINSUM_OPTIMAL_MAX 8
+
+//alignment of the intermediates, in BYTES
+#define EINSUM_ALIGN 64
+
+namespace libj
+{
+
+/*----------------------------------------------------------------------
+  einsum_error
+----------------------------------------------------------------------*/
+inline void einsum_error(const std::string& expr, const char* msg)
+{
+  printf("ERROR libj::einsum \n");
+  printf("%s \n",msg);
+  printf("expression = %s \n",expr.c_str());
+  exit(1);
+}
+
+/*----------------------------------------------------------------------
+  einsum_net
+	the inputs and output of an expression, and the length of
+	each label
+----------------------------------------------------------------------*/
+struct einsum_net
+{
+  std::vector<std::string> in;   //labels of each input
+  std::string              out;  //labels of the output
+  std::string              chars;//every label, once
+  std::vector<size_t>      len;  //length of each label in chars
+
+  size_t length(const char c) const {return len[chars.find(c)];}
+
+  //labels of a set of inputs that are also outside of it
+  std::string labels(const unsigned long mask) const
+  {
+    const unsigned long all = (1UL << in.size()) - 1;
+    if (mask == all) return out;
+    std::string lab;
+    for (size_t t=0;t<in.size();t++)
+    {
+      if (!(mask & (1UL << t))) continue;
+      for (size_t i=0;i<in[t].length();i++)
+      {
+        const char c = in[t][i];
+        if (lab.find(c) != std::string::npos) continue;
+        bool outside = out.find(c) != std::string::npos;
+        for (size_t u=0;u<in.size() && !outside;u++)
+        {
+          if (!(mask & (1UL << u)) && in[u].find(c) != std::string::npos) outside = true;
+        }
+        if (outside) lab.push_back(c);
+      }
+    }
+    return lab;
+  }
+
+  double elements(const std::string& lab) const
+  {
+    double n = 1;
+    for (size_t i=0;i<lab.length();i++) n *= (double) length(lab[i]);
+    return n;
+  }
+};
+
+/*----------------------------------------------------------------------
+  einsum_parse
+	splits the expression, and checks that each label is in
+	exactly two of the inputs and the output
+----------------------------------------------------------------------*/
+inline void einsum_parse(const std::string& expr, einsum_net& net)
+{
+  const size_t arrow = expr.find("->");
+  if (arrow == std::string::npos) einsum_error(expr,"The expression needs an output, as in ij,jk->ik");
+  net.in.clear();
+  net.out = expr.substr(arrow+2);
+  std::string cur;
+  for (size_t i=0;i<arrow;i++)
+  {
+    const char c = expr[i];
+    if (c == ',') {net.in.push_back(cur); cur.clear();}
+    else if (c != ' ') cur.push_back(c);
+  }
+  net.in.push_back(cur);
+  std::string o;
+  for (size_t i=0;i<net.out.length();i++) {if (net.out[i] != ' ') o.push_back(net.out[i]);}
+  net.out = o;
+  if (net.out.length() == 0) einsum_error(expr,"The output has no labels, a full contraction is libj::dot");
+  if (net.in.size() > 8*sizeof(unsigned long)-1) einsum_error(expr,"Too many inputs");
+
+  net.chars.clear();
+  for (size_t t=0;t<=net.in.size();t++)
+  {
+    const std::string& s = (t < net.in.size()) ? net.in[t] : net.out;
+    for (size_t i=0;i<s.length();i++)
+    {
+      if (s.find(s[i]) != i) einsum_error(expr,"Repeated label in one tensor");
+      if (net.chars.find(s[i]) == std::string::npos) net.chars.push_back(s[i]);
+    }
+  }
+  for (size_t i=0;i<net.chars.length();i++)
+  {
+    size_t n = (net.out.find(net.chars[i]) != std::string::npos) ? 1 : 0;
+    for (size_t t=0;t<net.in.size();t++) n += (net.in[t].find(net.chars[i]) != std::string::npos) ? 1 : 0;
+    if (n != 2 && net.in.size() > 1)
+    {
+      einsum_error(expr,"Each label must be in exactly two of the inputs and the output");
+    }
+  }
+  net.len.assign(net.chars.length(),0);
+}
+
+//set the lengths of the labels from the lengths of the inputs
+inline void einsum_lengths(const std::string& expr, einsum_net& net,
+                           const std::vector<std::vector<size_t> >& lengths)
+{
+  if (lengths.size() != net.in.size()) einsum_error(expr,"The number of tensors does not match the expression");
+  net.len.assign(net.chars.length(),0);
+  for (size_t t=0;t<net.in.size();t++)
+  {
+    if (lengths[t].size() != net.in[t].length()) einsum_error(expr,"The number of labels does not match the tensor dimensions");
+    for (size_t i=0;i<net.in[t].length();i++)
+    {
+      size_t& l = net.len[net.chars.find(net.in[t][i])];
+      if (l != 0 && l != lengths[t][i]) einsum_error(expr,"Lengths of a label do not match");
+      l = lengths[t][i];
+    }
+  }
+}
+
+/*----------------------------------------------------------------------
+  einsum_tree
+	best tree of a set of inputs
+----------------------------------------------------------------------*/
+struct einsum_tree
+{
+  bool          ok;
+  double        flops;
+  double        peak;
+  unsigned long first;   //set of the subtree done first
+  unsigned long second;  //and second
+};
+
+//a pair is allowed if its tensors fit in the contraction
+inline bool einsum_fits(const std::string& lab)
+{
+  return lab.length() >= 1 && lab.length() <= JBLIS_CONTRACT_MAX_DIM;
+}
+
+inline bool einsum_better(const einsum_cost cost, const double f1, const double p1,
+                          const double f2, const double p2)
+{
+  if (cost == EINSUM_MEMORY)
+  {
+    if (p1 != p2) return p1 < p2;
+    return f1 < f2;
+  }
+  if (f1 != f2) return f1 < f2;
+  return p1 < p2;
+}
+
+//the steps of the tree of mask, in the order they are done
+inline size_t einsum_emit(const einsum_net& net, const std::vector<einsum_tree>& best,
+                          const unsigned long mask, einsum_path& path)
+{
+  if (__builtin_popcountl(mask) == 1) return (size_t) __builtin_ctzl(mask);
+  const size_t a = einsum_emit(net,best,best[mask].first,path);
+  const size_t b = einsum_emit(net,best,best[mask].second,path);
+  path.left.push_back(a);
+  path.right.push_back(b);
+  path.labels.push_back(net.labels(mask));
+  return path.labels.size()-1;
+}
+
+/*----------------------------------------------------------------------
+  einsum_finish
+	flops and peak of the steps
+----------------------------------------------------------------------*/
+inline void einsum_finish(const einsum_net& net, einsum_path& path)
+{
+  const size_t NIN = net.in.size();
+  const size_t NS  = path.left.size();
+  std::vector<double> size(path.labels.size(),0);
+  for (size_t s=0;s+1<NS;s++) size[NIN+s] = net.elements(path.labels[NIN+s]);
+
+  path.flops = 0;
+  double live = 0, peak = 0;
+  for (size_t s=0;s<NS;s++)
+  {
+    const size_t a = path.left[s], b = path.right[s];
+    std::string all = path.labels[a];
+    for (size_t i=0;i<path.labels[b].length();i++)
+    {
+      if (all.find(path.labels[b][i]) == std::string::npos) all.push_back(path.labels[b][i]);
+    }
+    path.flops += 2.0*net.elements(all);
+    live += size[NIN+s];
+    if (live > peak) peak = live;
+    live -= size[a] + size[b];
+  }
+  path.peak = (size_t) peak;
+}
+
+/*----------------------------------------------------------------------
+  einsum_optimize
+----------------------------------------------------------------------*/
+einsum_path einsum_optimize(const std::string& expr, const std::vector<std::vector<size_t> >& lengths,
+                            const einsum_cost cost, const size_t max_elements)
+{
+  einsum_net net;
+  einsum_parse(expr,net);
+  einsum_lengths(expr,net,lengths);
+
+  einsum_path path;
+  path.expr  = expr;
+  path.chars = net.chars;
+  path.len   = net.len;
+  path.labels = net.in;
+  path.flops = 0;
+  path.peak  = 0;
+  const size_t NIN = net.in.size();
+  if (NIN == 1) return path;
+
+  const unsigned long all = (1UL << NIN) - 1;
+  const double LIM = (max_elements > 0) ? (double) max_elements : -1;
+
+  if (NIN <= EINSUM_OPTIMAL_MAX)
+  {
+    std::vector<einsum_tree> best(all+1);
+    std::vector<double> size(all+1,0);
+    std::vector<std::string> lab(all+1);
+    for (unsigned long m=1;m<=all;m++)
+    {
+      lab[m] = net.labels(m);
+      size[m] = (__builtin_popcountl(m) == 1 || m == all) ? 0 : net.elements(lab[m]);
+      best[m].ok = (__builtin_popcountl(m) == 1);
+      best[m].flops = 0;
+      best[m].peak = 0;
+      best[m].first = best[m].second = 0;
+    }
+
+    //sets in order of their size, so the subsets are done first
+    for (int n=2;n<=(int) NIN;n++)
+    {
+      for (unsigned long m=1;m<=all;m++)
+      {
+        if (__builtin_popcountl(m) != n) continue;
+        if (!einsum_fits(lab[m])) continue;
+        for (unsigned long s1=(m-1)&m;s1>0;s1=(s1-1)&m)
+        {
+          const unsigned long s2 = m ^ s1;
+          if (s1 < s2) continue;
+          if (!best[s1].ok || !best[s2].ok) continue;
+          if (!einsum_fits(lab[s1]) || !einsum_fits(lab[s2])) continue;
+
+          std::string how = lab[s1];
+          for (size_t i=0;i<lab[s2].length();i++) {if (how.find(lab[s2][i]) == std::string::npos) how.push_back(lab[s2][i]);}
+          const double fl = best[s1].flops + best[s2].flops + 2.0*net.elements(how);
+
+          //the subtree with the larger peak first
+          const double top = size[s1] + size[s2] + size[m];
+          const double p12 = std::max(std::max(best[s1].peak,size[s1]+best[s2].peak),top);
+          const double p21 = std::max(std::max(best[s2].peak,size[s2]+best[s1].peak),top);
+          const double pk  = std::min(p12,p21);
+          if (LIM >= 0 && pk > LIM) continue;
+
+          if (!best[m].ok || einsum_better(cost,fl,pk,best[m].flops,best[m].peak))
+          {
+            best[m].ok = true;
+            best[m].flops = fl;
+            best[m].peak = pk;
+            best[m].first  = (p12 <= p21) ? s1 : s2;
+            best[m].second = (p12 <= p21) ? s2 : s1;
+          }
+        }
+      }
+    }
+    if (!best[all].ok) einsum_error(expr,"No order of the pairs fits, see JBLIS_CONTRACT_MAX_DIM and max_elements");
+    einsum_emit(net,best,all,path);
+
+  } else {
+    //greedy, over the tensors that are left
+    std::vector<unsigned long> cur(NIN);
+    std::vector<size_t> id(NIN);
+    for (size_t t=0;t<NIN;t++) {cur[t] = 1UL << t; id[t] = t;}
+    while (cur.size() > 1)
+    {
+      size_t bi = 0, bj = 0;
+      bool found = false, shared = false;
+      double bf = 0, bp = 0;
+      for (size_t i=0;i<cur.size();i++)
+      {
+        for (size_t j=i+1;j<cur.size();j++)
+        {
+          const unsigned long m = cur[i] | cur[j];
+          const std::string la = net.labels(cur[i]), lb = net.labels(cur[j]), lm = net.labels(m);
+          if (!einsum_fits(lm) || !einsum_fits(la) || !einsum_fits(lb)) continue;
+          std::string how = la;
+          bool sh = false;
+          for (size_t k=0;k<lb.length();k++)
+          {
+            if (how.find(lb[k]) == std::string::npos) how.push_back(lb[k]);
+            else sh = true;
+          }
+          const double fl = 2.0*net.elements(how);
+          const double sz = (m == all) ? 0 : net.elements(lm);
+          if (LIM >= 0 && sz > LIM) continue;
+          //pairs that share a label before outer products
+          const bool take = !found || (sh && !shared) ||
+                            (sh == shared && einsum_better(cost,fl,sz,bf,bp));
+          if (take) {found = true; shared = sh; bi = i; bj = j; bf = fl; bp = sz;}
+        }
+      }
+      if (!found) einsum_error(expr,"No order of the pairs fits, see JBLIS_CONTRACT_MAX_DIM and max_elements");
+      path.left.push_back(id[bi]);
+      path.right.push_back(id[bj]);
+      path.labels.push_back(net.labels(cur[bi] | cur[bj]));
+      cur[bi] |= cur[bj];
+      id[bi] = path.labels.size()-1;
+      cur.erase(cur.begin()+bj);
+      id.erase(id.begin()+bj);
+    }
+  }
+
+  einsum_finish(net,path);
+  return path;
+}
+
+/*----------------------------------------------------------------------
+  einsum_path::print
+----------------------------------------------------------------------*/
+void einsum_path::print() const
+{
+  const size_t NIN = labels.size() - left.size();
+  printf("libj::einsum %s \n",expr.c_str());
+  for (size_t s=0;s<left.size();s++)
+  {
+    printf("  %s,%s -> %s \n",labels[left[s]].c_str(),labels[right[s]].c_str(),labels[NIN+s].c_str());
+  }
+  printf("  flops = %.3e, peak = %zu elements \n",flops,peak);
+}
+
+/*----------------------------------------------------------------------
+  einsum_arena
+	elements of a core_arena for the intermediates of the path,
+	given back in the LIFO order of the arena
+----------------------------------------------------------------------*/
+size_t einsum_arena(const einsum_path& path, const size_t type_size)
+{
+  const size_t NIN = path.labels.size() - path.left.size();
+  const size_t PAD = (EINSUM_ALIGN > type_size) ? EINSUM_ALIGN/type_size : 0;
+  std::vector<size_t> nelm(path.labels.size(),0);
+  std::vector<size_t> stack;
+  std::vector<bool>   freed;
+  size_t top = 0, most = 0;
+  for (size_t s=0;s+1<path.left.size();s++)
+  {
+    size_t n = 1;
+    for (size_t i=0;i<path.labels[NIN+s].length();i++) n *= path.len[path.chars.find(path.labels[NIN+s][i])];
+    nelm[NIN+s] = n + PAD;
+    stack.push_back(NIN+s);
+    freed.push_back(false);
+    top += nelm[NIN+s];
+    if (top > most) most = top;
+    for (size_t k=0;k<stack.size();k++)
+    {
+      if (stack[k] == path.left[s] || stack[k] == path.right[s]) freed[k] = true;
+    }
+    while (!stack.empty() && freed.back())
+    {
+      top -= nelm[stack.back()];
+      stack.pop_back();
+      freed.pop_back();
+    }
+  }
+  return most;
+}
+
+/*----------------------------------------------------------------------
+  einsum, with a path
+----------------------------------------------------------------------*/
+template <typename T>
+void einsum(const einsum_path& path, const std::vector<const libj::tensor<T>*>& X,
+            libj::tensor<T>& C, const T alpha, const T beta, libj::core_arena<T>* arena)
+{
+  const std::string& expr = path.expr;
+  const size_t NS  = path.left.size();
+  const size_t NIN = path.labels.size() - NS;
+  if (X.size() != NIN) einsum_error(expr,"The number of tensors does not match the path");
+  for (size_t t=0;t<NIN;t++)
+  {
+    if (X[t]->dim() != path.labels[t].length()) einsum_error(expr,"The number of labels does not match the tensor dimensions");
+    for (size_t d=0;d<X[t]->dim();d++)
+    {
+      if (X[t]->size(d) != path.len[path.chars.find(path.labels[t][d])]) einsum_error(expr,"The tensors do not match the path");
+    }
+  }
+  const std::string out = expr.substr(expr.find("->")+2);
+  std::string idxC;
+  for (size_t i=0;i<out.length();i++) {if (out[i] != ' ') idxC.push_back(out[i]);}
+  if (C.dim() != idxC.length()) einsum_error(expr,"The number of labels of C does not match its dimensions");
+  for (size_t d=0;d<C.dim();d++)
+  {
+    if (C.size(d) != path.len[path.chars.find(idxC[d])]) einsum_error(expr,"Lengths of C do not match");
+  }
+
+  if (NIN == 1)
+  {
+    libj::permute<T>(*X[0],path.labels[0],C,idxC,alpha,beta);
+    return;
+  }
+
+  //an arena for this path, if none is given
+  libj::core_arena<T>* mem = arena;
+  libj::core_arena<T>* own = NULL;
+  if (mem == NULL && NS > 1)
+  {
+    own = new libj::core_arena<T>((long) einsum_arena(path,sizeof(T)));
+    mem = own;
+  }
+
+  std::vector<libj::tensor<T> > tmp(NS);
+  std::vector<T*>     ptr(NS,NULL);
+  std::vector<size_t> nelm(NS,0);
+  std::vector<const libj::tensor<T>*> ten(NIN+NS,NULL);
+  for (size_t t=0;t<NIN;t++) ten[t] = X[t];
+
+  for (size_t s=0;s<NS;s++)
+  {
+    const size_t a = path.left[s], b = path.right[s];
+    if (s+1 == NS)
+    {
+      libj::contract<T>(alpha,*ten[a],path.labels[a],*ten[b],path.labels[b],beta,C,idxC);
+    } else {
+      const std::string& lab = path.labels[NIN+s];
+      std::vector<size_t> lengths(lab.length());
+      nelm[s] = 1;
+      for (size_t i=0;i<lab.length();i++)
+      {
+        lengths[i] = path.len[path.chars.find(lab[i])];
+        nelm[s] *= lengths[i];
+      }
+      ptr[s] = mem->allocate(EINSUM_ALIGN,nelm[s]);
+      tmp[s].assign(ptr[s],lengths);
+      ten[NIN+s] = &tmp[s];
+      libj::contract<T>((T) 1,*ten[a],path.labels[a],*ten[b],path.labels[b],(T) 0,tmp[s],lab);
+    }
+
+    //the intermediates that were used go back to the arena
+    const size_t used[2] = {a,b};
+    for (size_t u=0;u<2;u++)
+    {
+      if (used[u] < NIN) continue;
+      const size_t k = used[u] - NIN;
+      tmp[k].unassign();
+      mem->deallocate(ptr[k],nelm[k]);
+    }
+  }
+  if (own != NULL) delete own;
+}
+
+/*----------------------------------------------------------------------
+  einsum, with the path from einsum_optimize
+----------------------------------------------------------------------*/
+template <typename T>
+einsum_path einsum(const std::string& expr, const std::vector<const libj::tensor<T>*>& X,
+                   libj::tensor<T>& C, const T alpha, const T beta,
+                   libj::core_arena<T>* arena, const einsum_cost cost)
+{
+  std::vector<std::vector<size_t> > lengths(X.size());
+  for (size_t t=0;t<X.size();t++)
+  {
+    lengths[t].resize(X[t]->dim());
+    for (size_t d=0;d<X[t]->dim();d++) lengths[t][d] = X[t]->size(d);
+  }
+  const einsum_path path = einsum_optimize(expr,lengths,cost,0);
+  einsum<T>(path,X,C,alpha,beta,arena);
+  return path;
+}
+
+template void libj::einsum<double>(const einsum_path& path, const std::vector<const libj::tensor<double>*>& X,
+                                   libj::tensor<double>& C, const double alpha, const double beta,
+                                   libj::core_arena<double>* arena);
+template void libj::einsum<float>(const einsum_path& path, const std::vector<const libj::tensor<float>*>& X,
+                                  libj::tensor<float>& C, const float alpha, const float beta,
+                                  libj::core_arena<float>* arena);
+template einsum_path libj::einsum<double>(const std::string& expr, const std::vector<const libj::tensor<double>*>& X,
+                                          libj::tensor<double>& C, const double alpha, const double beta,
+                                          libj::core_arena<double>* arena, const einsum_cost cost);
+template einsum_path libj::einsum<float>(const std::string& expr, const std::vector<const libj::tensor<float>*>& X,
+                                         libj::tensor<float>& C, const float alpha, const float beta,
+                                         libj::core_arena<float>* arena, const einsum_cost cost);
+
+}//end of namespace
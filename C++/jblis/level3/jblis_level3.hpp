@@ -0,0 +1,391 @@
+/*----------------------------------------------------------------------------------
+  jblis_level3.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for the C++ interface with jblis, my (bad) implementation of tblis
+
+  L3 defines the level-3 implementations, which includes the following routines:
+
+    contract
+    contract (compile time labels)
+    plan_contract
+    contract (block_tensor)
+    contract (packed_tensor)
+    contract (sparse_tensor)
+    contract (screened, with tensor_norms)
+    einsum
+    tucker_compress
+    tucker_expand
+    tucker_contract
+
+----------------------------------------------------------------------------------*/
+#ifndef JBLIS_L3_HPP
+#define JBLIS_L3_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include "tensor.hpp"
+#include "tensor_matrix2.hpp"
+#include "index_labels.hpp"
+#include "block_scatter_matrix2.hpp"
+#include "block_tensor.hpp"
+#include "packed_tensor.hpp"
+#include "sparse_tensor.hpp"
+#include "tensor_norms.hpp"
+#include "tucker.hpp"
+#include "core_arena.hpp"
+#include "libjdef.h"
+#include "cache.hpp"
+
+#if defined (LIBJ_OMP)
+  #include <omp.h>
+#endif
+
+//largest number of dimensions of a tensor in a contraction. Each
+//  set of bundle sizes is its own instantiation, so this is kept
+//  small. Use 6 for the triples
+#if !defined (JBLIS_CONTRACT_MAX_DIM)
+  #define JBLIS_CONTRACT_MAX_DIM 4
+#endif
+
+namespace libj
+{
+
+/*---------------------------------------------------------
+ * contract
+ *
+ *  Tensor contraction,
+ *
+ *    C = alpha * A . B + beta * C
+ *
+ *  where the indices of each tensor are labeled by a
+ *  string with one character per dimension, and repeated
+ *  labels are summed over (einstein notation), e.g.
+ *
+ *    libj::contract(1.0,A,"abcd",B,"cdef",0.0,C,"abef");
+ *
+ *  is C(a,b,e,f) = sum_cd A(a,b,c,d) * B(c,d,e,f). The
+ *  labels that A shares with C form the M bundle,
+ *  B with C the N bundle, and A with B the K bundle.
+ *  The tensors are viewed as tensor_matrix2's over these
+ *  bundles, and the blocks of A and B are packed straight
+ *  from block_scatter_matrix2's into the microkernel
+ *  panels, so the tensors are never permuted into
+ *  matrices. Each tensor may have up to
+ *  JBLIS_CONTRACT_MAX_DIM dimensions.
+ *
+ *  Labels found in all three tensors, or in only one of
+ *  them, are not supported. With beta == 0, C is not read.
+ *
+ * alpha -> scalar for A.B
+ * A     -> first tensor
+ * idxA  -> index labels of A
+ * B     -> second tensor
+ * idxB  -> index labels of B
+ * beta  -> scalar for C
+ * C     -> result tensor
+ * idxC  -> index labels of C
+---------------------------------------------------------*/
+template <typename T>
+void contract(const T alpha, const libj::tensor<T>& A, const std::string& idxA,
+              const libj::tensor<T>& B, const std::string& idxB,
+              const T beta, libj::tensor<T>& C, const std::string& idxC);
+
+/*---------------------------------------------------------
+ * contract (compile time labels)
+ *
+ *  The same contraction, with the labels as libj::idx
+ *  character packs (index_labels.hpp),
+ *
+ *    libj::contract(1.0,A,libj::idx<'a','b','c','d'>(),
+ *                   B,libj::idx<'c','d','e','f'>(),
+ *                   0.0,C,libj::idx<'a','b','e','f'>());
+ *
+ *  The labels are checked and sorted into the bundles by
+ *  the compiler (idx_contract), so bad labels are a build
+ *  error, and at run time only the ranks and lengths of
+ *  the tensors are checked (contract_bundled), before the
+ *  driver is picked as for the string labels.
+ *
+ * BUN   -> bundle strings AM,AK,BK,BN,CM,CN, as in
+ *          tensor_matrix2 ('a' for the first dim)
+ * IDX   -> labels of A, B, C, for the error messages
+---------------------------------------------------------*/
+template <typename T>
+void contract_bundled(const T alpha, const libj::tensor<T>& A, const libj::tensor<T>& B,
+                      const T beta, libj::tensor<T>& C, const char* const BUN[6],
+                      const char* const IDX[3]);
+
+template <typename T, char... LA, char... LB, char... LC>
+inline void contract(const T alpha, const libj::tensor<T>& A, libj::idx<LA...>,
+                     const libj::tensor<T>& B, libj::idx<LB...>,
+                     const T beta, libj::tensor<T>& C, libj::idx<LC...>)
+{
+  typedef libj::idx<LA...> IA;
+  typedef libj::idx<LB...> IB;
+  typedef libj::idx<LC...> IC;
+  typedef libj::idx_contract<IA,IB,IC> X;
+  static_assert(IA::size() >= 1 && IA::size() <= JBLIS_CONTRACT_MAX_DIM &&
+                IB::size() >= 1 && IB::size() <= JBLIS_CONTRACT_MAX_DIM &&
+                IC::size() >= 1 && IC::size() <= JBLIS_CONTRACT_MAX_DIM,
+                "libj::contract : 1 to JBLIS_CONTRACT_MAX_DIM labels per tensor");
+  const char* const BUN[6] = {X::AM,X::AK,X::BK,X::BN,X::CM,X::CN};
+  const char* const IDX[3] = {IA::str,IB::str,IC::str};
+  libj::contract_bundled<T>(alpha,A,B,beta,C,BUN,IDX);
+}
+
+/*---------------------------------------------------------
+ * plan_contract
+ *
+ *  The same contraction, planned once for tensors of these
+ *  lengths and strides and then run on any of them,
+ *
+ *    libj::contract_plan<double> P = 
+ *      libj::plan_contract(A,"abcd",B,"cdef",C,"abef");
+ *    P.execute(A,B,C);                  //C = A.B
+ *    P.execute(alpha,A2,B2,beta,C2);    //same shapes
+ *
+ *  The labels are parsed, the bundles and their offset 
+ *  tables made, and the block sizes and packing buffer 
+ *  set up when planning, so an execute only checks the
+ *  shapes and runs the blocked loops. Copies of a plan 
+ *  share its buffer, so a plan runs one execute at a time.
+---------------------------------------------------------*/
+template <typename T> struct contract_plan_base;
+
+template <typename T>
+class contract_plan
+{
+  private:
+  std::string M_IDXA,M_IDXB,M_IDXC;
+  size_t      M_NDIM[3];                                  //dims of A, B, C
+  size_t      M_LENGTHS[3][JBLIS_CONTRACT_MAX_DIM];       //lengths of A, B, C
+  size_t      M_STRIDES[3][JBLIS_CONTRACT_MAX_DIM];       //strides of A, B, C
+  std::shared_ptr<contract_plan_base<T> > M_DRV;          //planned driver
+
+  void m_check(const size_t t, const libj::tensor<T>& X) const;
+
+  public:
+  contract_plan() {}
+  contract_plan(const libj::tensor<T>& A, const std::string& idxA,
+                const libj::tensor<T>& B, const std::string& idxB,
+                libj::tensor<T>& C, const std::string& idxC);
+
+  bool is_set() const {return (bool) M_DRV;}
+
+  void execute(const T alpha, const libj::tensor<T>& A, const libj::tensor<T>& B,
+               const T beta, libj::tensor<T>& C);
+  void execute(const libj::tensor<T>& A, const libj::tensor<T>& B, libj::tensor<T>& C)
+  {
+    execute((T) 1,A,B,(T) 0,C);
+  }
+};
+
+template <typename T>
+contract_plan<T> plan_contract(const libj::tensor<T>& A, const std::string& idxA,
+                               const libj::tensor<T>& B, const std::string& idxB,
+                               libj::tensor<T>& C, const std::string& idxC);
+
+/*---------------------------------------------------------
+ * contract (block_tensor)
+ *
+ *  The same contraction for symmetry blocked tensors,
+ *  done block by block with the dense contract. Pairs
+ *  of blocks of A and B that are zero by symmetry are
+ *  skipped, so the cost is about 1/NIRREP^2 of the
+ *  dense contraction for NIRREP irreps. The irrep of C
+ *  must be the product of those of A and B, and the
+ *  shared labels must have the same lengths in each
+ *  irrep. Same labels as the dense contract.
+---------------------------------------------------------*/
+template <typename T>
+void contract(const T alpha, const libj::block_tensor<T>& A, const std::string& idxA,
+              const libj::block_tensor<T>& B, const std::string& idxB,
+              const T beta, libj::block_tensor<T>& C, const std::string& idxC);
+
+/*---------------------------------------------------------
+ * contract (packed_tensor)
+ *
+ *  The same contraction with A and/or B stored as
+ *  packed_tensors with permutational symmetry. The
+ *  elements are unpacked with their signs while the
+ *  panels of A and B are packed, so the full tensors
+ *  are never formed. C is dense, and can be packed
+ *  afterwards with packed_tensor::pack.
+---------------------------------------------------------*/
+template <typename T>
+void contract(const T alpha, const libj::packed_tensor<T>& A, const std::string& idxA,
+              const libj::packed_tensor<T>& B, const std::string& idxB,
+              const T beta, libj::tensor<T>& C, const std::string& idxC);
+
+template <typename T>
+void contract(const T alpha, const libj::packed_tensor<T>& A, const std::string& idxA,
+              const libj::tensor<T>& B, const std::string& idxB,
+              const T beta, libj::tensor<T>& C, const std::string& idxC);
+
+template <typename T>
+void contract(const T alpha, const libj::tensor<T>& A, const std::string& idxA,
+              const libj::packed_tensor<T>& B, const std::string& idxB,
+              const T beta, libj::tensor<T>& C, const std::string& idxC);
+
+/*---------------------------------------------------------
+ * contract (sparse_tensor)
+ *
+ *  The same contraction with A or B element sparse, 
+ *  stored as a sparse_tensor (CSF), and the others dense. 
+ *  Each leaf fiber (the nonzeros along dimension 0) is 
+ *  done with the gather kernels, or with the dense ones
+ *  on a scattered line if it is mostly filled. The root 
+ *  nodes (or the labels of C that are not in the sparse 
+ *  tensor) are split over the threads. Double and float.
+ *
+ *    libj::sparse_tensor<double> S(V,1.0e-10);
+ *    libj::contract(1.0,S,"ijkl",T,"klab",0.0,C,"ijab");
+---------------------------------------------------------*/
+template <typename T>
+void contract(const T alpha, const libj::sparse_tensor<T>& A, const std::string& idxA,
+              const libj::tensor<T>& B, const std::string& idxB,
+              const T beta, libj::tensor<T>& C, const std::string& idxC);
+
+template <typename T>
+void contract(const T alpha, const libj::tensor<T>& A, const std::string& idxA,
+              const libj::sparse_tensor<T>& B, const std::string& idxB,
+              const T beta, libj::tensor<T>& C, const std::string& idxC);
+
+/*---------------------------------------------------------
+ * contract (screened)
+ *
+ *  The same contraction, a tile at a time, with the tiles
+ *  of the tensor_norms NA and NB of A and B. Tile products
+ *  with |alpha|*|A_mk|*|B_kn| < tol (Frobenius norms) are
+ *  skipped. Returns the sum of the skipped bounds, which
+ *  bounds the Frobenius norm of the error in C. The K 
+ *  labels must have the same tiles in NA and NB. Keep 
+ *  NA and NB with A and B, they only need to be updated
+ *  when A and B change. For double and float.
+ *
+ *    libj::tensor_norms<double> NA(A,16), NB(B,16);
+ *    double err = libj::contract(1.0,A,"abcd",NA,B,"cdef",NB,
+ *                                0.0,C,"abef",1.0e-10);
+---------------------------------------------------------*/
+template <typename T>
+double contract(const T alpha, const libj::tensor<T>& A, const std::string& idxA,
+                const libj::tensor_norms<T>& NA,
+                const libj::tensor<T>& B, const std::string& idxB,
+                const libj::tensor_norms<T>& NB,
+                const T beta, libj::tensor<T>& C, const std::string& idxC, const double tol);
+
+/*---------------------------------------------------------
+ * einsum
+ *
+ *  Contraction of several tensors, in einstein notation 
+ *  with an explicit output,
+ *
+ *    libj::einsum("ijab,ijmn,mnef->abef",{&T,&V,&T},W);
+ *
+ *  is W = alpha * sum_ijmn T(ijab) V(ijmn) T(mnef) + beta * W.
+ *  Each label must be in exactly two of the inputs and the 
+ *  output. The pairs are done with libj::contract, in the 
+ *  order from einsum_optimize, which searches every order 
+ *  for up to 8 inputs and is greedy beyond that, by
+ *
+ *    EINSUM_FLOPS  : fewest flops, then the smallest peak
+ *    EINSUM_MEMORY : smallest peak, then the fewest flops
+ *
+ *  The peak is in elements of the intermediates, and orders
+ *  with a peak over max_elements (if not 0) are not taken.
+ *  The intermediates are checked out of the core_arena, or
+ *  one of einsum_arena(path,sizeof(T)) elements if NULL. 
+ *  Returns the path, which can be kept and given to einsum
+ *  again for tensors of the same shapes. Double and float.
+ *
+ *    libj::einsum_path P = libj::einsum_optimize(
+ *      "ijab,ijmn,mnef->abef",{{o,o,v,v},{o,o,o,o},{o,o,v,v}});
+ *    P.print();
+ *    libj::einsum(P,{&T,&V,&T},W);
+---------------------------------------------------------*/
+enum einsum_cost {EINSUM_FLOPS = 0, EINSUM_MEMORY = 1};
+
+struct einsum_path
+{
+  std::string              expr;   //the expression
+  std::string              chars;  //every label
+  std::vector<size_t>      len;    //length of each label in chars
+  std::vector<std::string> labels; //labels of the inputs, then of each step
+  std::vector<size_t>      left;   //first tensor of each step
+  std::vector<size_t>      right;  //second tensor of each step
+  double                   flops;  //flops of all the steps
+  size_t                   peak;   //elements of intermediates alive at once
+
+  void print() const;
+};
+
+einsum_path einsum_optimize(const std::string& expr, const std::vector<std::vector<size_t> >& lengths,
+                            const einsum_cost cost=EINSUM_FLOPS, const size_t max_elements=0);
+
+size_t einsum_arena(const einsum_path& path, const size_t type_size);
+
+template <typename T>
+einsum_path einsum(const std::string& expr, const std::vector<const libj::tensor<T>*>& X,
+                   libj::tensor<T>& C, const T alpha=(T) 1, const T beta=(T) 0,
+                   libj::core_arena<T>* arena=NULL, const einsum_cost cost=EINSUM_FLOPS);
+
+template <typename T>
+void einsum(const einsum_path& path, const std::vector<const libj::tensor<T>*>& X,
+            libj::tensor<T>& C, const T alpha=(T) 1, const T beta=(T) 0,
+            libj::core_arena<T>* arena=NULL);
+
+/*---------------------------------------------------------
+ * tucker_compress
+ *
+ *  Compress A into the Tucker format (see tucker.hpp),
+ *  with the sequentially truncated higher order SVD. The
+ *  rank of each dimension is the smallest that keeps
+ *  |A - T| <= tol*|A| (Frobenius norms), and at most 
+ *  max_rank if it is not 0, in which case the SVDs are 
+ *  the randomized linal_drsvd. Returns the bound on 
+ *  |A - T|. T is (re)allocated. Double only.
+ *
+ *    libj::tucker<double> T;
+ *    double err = libj::tucker_compress(A,1.0e-6,T);
+---------------------------------------------------------*/
+double tucker_compress(const libj::tensor<double>& A, const double tol,
+                       libj::tucker<double>& T, const size_t max_rank=0);
+
+/*---------------------------------------------------------
+ * tucker_expand
+ *
+ *  A = alpha * T + beta * A, with T expanded from its core
+ *  and factors. With beta == 0, A is not read.
+---------------------------------------------------------*/
+void tucker_expand(const double alpha, const libj::tucker<double>& T,
+                   const double beta, libj::tensor<double>& A);
+
+/*---------------------------------------------------------
+ * tucker_contract
+ *
+ *  The contraction of two Tucker tensors, with the same
+ *  labels as the dense contract,
+ *
+ *    C = alpha * A . B + beta * C
+ *
+ *  done on the cores. The factors of each K label are
+ *  reduced to their r_A x r_B overlap, so the cost is 
+ *  that of contracting the cores, plus expanding the 
+ *  result if C is dense. With a tucker C, the result is
+ *  kept compressed (its factors are those of A and B),
+ *  and C is (re)allocated, so it cannot be A or B.
+ *  Each tensor may have up to JBLIS_CONTRACT_MAX_DIM
+ *  dimensions.
+---------------------------------------------------------*/
+void tucker_contract(const double alpha, const libj::tucker<double>& A, const std::string& idxA,
+                     const libj::tucker<double>& B, const std::string& idxB,
+                     const double beta, libj::tensor<double>& C, const std::string& idxC);
+
+void tucker_contract(const double alpha, const libj::tucker<double>& A, const std::string& idxA,
+                     const libj::tucker<double>& B, const std::string& idxB,
+                     libj::tucker<double>& C, const std::string& idxC);
+
+}//end libj
+#endif
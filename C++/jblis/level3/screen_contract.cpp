@@ -0,0 +1,185 @@
+/*----------------------------------------------------------------------
+  screen_contract.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for the screened contract function, which performs the
+  tensor contraction
+
+    C = alpha * A . B + beta * C
+
+  a tile at a time, skipping the tile products that are too small.
+  The tiles are those of the tensor_norms of A and B. The tiles of C
+  are those of A for its M labels and of B for its N labels, and for
+  each, every K tile gives one tile of A and one of B. Since
+
+    |A_mk . B_kn| <= |A_mk| |B_kn|
+
+  (Frobenius norms), a pair with |alpha| |A_mk| |B_kn| < tol is
+  skipped, and its bound added to the returned error bound. The
+  others are done with the dense libj::contract on views of the
+  tiles, with beta on the first and 1 afterwards, as in
+  block_contract.cpp. Tiles of C with no pairs are only scaled by
+  beta.
+
+----------------------------------------------------------------------*/
+#include <stdio.h>
+#include <math.h>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include "jblis_level3.hpp"
+#include "jblis_level1.hpp"
+
+namespace libj
+{
+
+/*----------------------------------------------------------------------
+  screen_contract_error
+----------------------------------------------------------------------*/
+inline void screen_contract_error(const std::string& idxA, const std::string& idxB,
+                                  const std::string& idxC, const char* msg)
+{
+  printf("ERROR libj::contract (screened) \n");
+  printf("%s \n",msg);
+  printf("A = %s, B = %s, C = %s \n",idxA.c_str(),idxB.c_str(),idxC.c_str());
+  exit(1);
+}
+
+/*----------------------------------------------------------------------
+  screen_contract_view
+	V = the tile of X with first indices START and lengths LEN
+----------------------------------------------------------------------*/
+template <typename T>
+inline void screen_contract_view(const libj::tensor<T>& X, const std::vector<size_t>& START,
+                                 const std::vector<size_t>& LEN, libj::tensor<T>& V)
+{
+  std::vector<size_t> stride(X.dim());
+  size_t off = 0;
+  for (size_t d=0;d<X.dim();d++)
+  {
+    stride[d] = X.stride(d);
+    off += START[d]*stride[d];
+  }
+  V.assign(const_cast<T*>(X.data()) + off,LEN,stride);
+}
+
+/*----------------------------------------------------------------------
+  General code
+----------------------------------------------------------------------*/
+template <typename T>
+double contract(const T alpha, const libj::tensor<T>& A, const std::string& idxA,
+                const libj::tensor_norms<T>& NA,
+                const libj::tensor<T>& B, const std::string& idxB,
+                const libj::tensor_norms<T>& NB,
+                const T beta, libj::tensor<T>& C, const std::string& idxC, const double tol)
+{
+  if (idxA.length() != A.dim() || idxB.length() != B.dim() || idxC.length() != C.dim())
+  {
+    screen_contract_error(idxA,idxB,idxC,"The number of labels does not match the tensor dimensions");
+  }
+  if (!NA.matches(A) || !NB.matches(B))
+  {
+    screen_contract_error(idxA,idxB,idxC,"The tensor_norms are not those of A and B, see update()");
+  }
+
+  //tile extents of each label of C and the K labels, and where they come from
+  std::vector<long> CA(C.dim(),-1), CB(C.dim(),-1);
+  std::vector<size_t> KA, KB, CTILE(C.dim()), CNT(C.dim());
+  for (size_t c=0;c<idxC.length();c++)
+  {
+    const size_t a = idxA.find(idxC[c]);
+    const size_t b = idxB.find(idxC[c]);
+    if (a != std::string::npos && b == std::string::npos)
+    {
+      CA[c] = (long) a;
+      CTILE[c] = NA.tile(a);
+      CNT[c] = NA.ntiles(a);
+    } else if (b != std::string::npos && a == std::string::npos) {
+      CB[c] = (long) b;
+      CTILE[c] = NB.tile(b);
+      CNT[c] = NB.ntiles(b);
+    } else {
+      screen_contract_error(idxA,idxB,idxC,"Each label of C must be in one of A or B");
+    }
+  }
+  for (size_t a=0;a<idxA.length();a++)
+  {
+    if (idxC.find(idxA[a]) != std::string::npos) continue;
+    const size_t b = idxB.find(idxA[a]);
+    if (b == std::string::npos) {screen_contract_error(idxA,idxB,idxC,"Label of A is not in B or C");}
+    if (A.size(a) != B.size(b) || NA.tile(a) != NB.tile(b))
+    {
+      screen_contract_error(idxA,idxB,idxC,"Lengths or tiles of the K labels of A and B do not match");
+    }
+    KA.push_back(a);
+    KB.push_back(b);
+  }
+
+  size_t NTC = 1, NTK = 1;
+  for (size_t c=0;c<C.dim();c++) NTC *= CNT[c];
+  for (size_t k=0;k<KA.size();k++) NTK *= NA.ntiles(KA[k]);
+
+  const double aalpha = (double) std::abs(alpha);
+  double skipped = 0;
+  std::vector<size_t> tA(A.dim()), tB(B.dim()), tC(C.dim(),0), tK(KA.size());
+  std::vector<size_t> sA(A.dim()), lA(A.dim()), sB(B.dim()), lB(B.dim());
+  std::vector<size_t> sC(C.dim()), lC(C.dim());
+  libj::tensor<T> AV, BV, CV;
+  for (size_t ic=0;ic<NTC;ic++)
+  {
+    size_t r = ic;
+    for (size_t c=0;c<C.dim();c++)
+    {
+      tC[c] = r%CNT[c];
+      r /= CNT[c];
+      sC[c] = tC[c]*CTILE[c];
+      lC[c] = std::min(CTILE[c],C.size(c)-sC[c]);
+      if (CA[c] >= 0) tA[CA[c]] = tC[c];
+      else tB[CB[c]] = tC[c];
+    }
+    screen_contract_view(C,sC,lC,CV);
+    bool first = true;
+
+    for (size_t ik=0;ik<NTK;ik++)
+    {
+      r = ik;
+      for (size_t k=0;k<KA.size();k++)
+      {
+        tK[k] = r%NA.ntiles(KA[k]);
+        r /= NA.ntiles(KA[k]);
+        tA[KA[k]] = tK[k];
+        tB[KB[k]] = tK[k];
+      }
+      const double bound = aalpha*NA.norm(tA)*NB.norm(tB);
+      if (bound < tol) {skipped += bound; continue;}
+
+      for (size_t a=0;a<A.dim();a++) {sA[a] = NA.start(a,tA[a]); lA[a] = NA.length(a,tA[a]);}
+      for (size_t b=0;b<B.dim();b++) {sB[b] = NB.start(b,tB[b]); lB[b] = NB.length(b,tB[b]);}
+      screen_contract_view(A,sA,lA,AV);
+      screen_contract_view(B,sB,lB,BV);
+      libj::contract<T>(alpha,AV,idxA,BV,idxB,first ? beta : (T) 1,CV,idxC);
+      first = false;
+    }
+
+    //no pairs, C = beta*C
+    if (first)
+    {
+      if (beta == (T) 0) {libj::zero<T>(CV);}
+      else if (beta != (T) 1) {libj::scal<T>(beta,CV);}
+    }
+  }
+  return skipped;
+}
+template double libj::contract<double>(const double alpha, const libj::tensor<double>& A,
+                                       const std::string& idxA, const libj::tensor_norms<double>& NA,
+                                       const libj::tensor<double>& B, const std::string& idxB,
+                                       const libj::tensor_norms<double>& NB, const double beta,
+                                       libj::tensor<double>& C, const std::string& idxC, const double tol);
+template double libj::contract<float>(const float alpha, const libj::tensor<float>& A,
+                                      const std::string& idxA, const libj::tensor_norms<float>& NA,
+                                      const libj::tensor<float>& B, const std::string& idxB,
+                                      const libj::tensor_norms<float>& NB, const float beta,
+                                      libj::tensor<float>& C, const std::string& idxC, const double tol);
+
+}//end of namespace
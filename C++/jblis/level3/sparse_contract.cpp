@@ -0,0 +1,302 @@
+/*----------------------------------------------------------------------
+  sparse_contract.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for the contract function of a sparse_tensor (CSF, see
+  sparse_tensor.hpp) with a dense tensor, which performs
+
+    C = alpha * S . D + beta * C
+
+  with a dense C. Each nonzero of S gives its offsets in C (from the
+  M labels, shared with C) and in D (from the K labels, shared with
+  D), and the N labels (shared by D and C) are done as one flattened
+  bundle with a table of offsets in D and C. The tree of S is walked
+  down to its leaf fibers, the nonzeros along dimension 0 of S, and
+  each fiber is done at once:
+
+    dimension 0 is a K label : C(n) += alpha * sum_j S_j * D(k_j,n),
+                               a simd_gather_dot for each n
+    dimension 0 is an M label: C(m_j,n) += alpha * S_j * D(n), a
+                               simd_axpy over n for each nonzero
+
+  A fiber with at least 1/SPARSE_CONTRACT_DENSE of its line filled is
+  scattered into a dense line first, and done with the dense
+  simd_auto_dot and simd_auto_axpy over the whole line.
+
+  If the root level (the last dimension of S) is an M label, the root
+  nodes write to different parts of C, and are split over the OpenMP
+  threads. Otherwise, the N bundle is split over the threads, each of
+  which walks the whole tree.
+
+----------------------------------------------------------------------*/
+#include <stdio.h>
+#include <vector>
+#include <string>
+#include "jblis_level3.hpp"
+#include "jblis_level1.hpp"
+#include "simd.hpp"
+
+//a fiber with nnz*SPARSE_CONTRACT_DENSE >= length is done as a dense line
+#define SPARSE_CONTRACT_DENSE 4
+
+namespace libj
+{
+
+/*----------------------------------------------------------------------
+  sparse_contract_error
+----------------------------------------------------------------------*/
+inline void sparse_contract_error(const std::string& idxA, const std::string& idxB,
+                                  const std::string& idxC, const char* msg)
+{
+  printf("ERROR libj::contract (sparse_tensor) \n");
+  printf("%s \n",msg);
+  printf("A = %s, B = %s, C = %s \n",idxA.c_str(),idxB.c_str(),idxC.c_str());
+  exit(1);
+}
+
+/*----------------------------------------------------------------------
+  sparse_contract_walk
+	the labels of S, the N bundle, and the buffers of one thread
+----------------------------------------------------------------------*/
+template <typename T>
+struct sparse_contract_walk
+{
+  const libj::sparse_tensor<T>* S;
+  const T*            D;
+  T*                  C;
+  T                   alpha;
+  std::vector<size_t> SC;      //stride in C of each dimension of S, 0 for K labels
+  std::vector<size_t> SD;      //stride in D of each dimension of S, 0 for M labels
+  std::vector<size_t> NC;      //offset in C of each element of the N bundle
+  std::vector<size_t> ND;      //offset in D of each element of the N bundle
+  bool                K0;      //dimension 0 of S is a K label
+  bool                NSEQ;    //the N bundle is sequential in C and D
+  size_t              N0;      //first element of the N bundle to do
+  size_t              N1;      //one past the last
+  std::vector<T>      line;    //dense line, kept zero between fibers
+  std::vector<long>   sidx;    //indices of a fiber, times the stride
+
+  //fiber of the nonzeros P to Q-1, with the offsets of the upper levels
+  void fiber(const size_t P, const size_t Q, const size_t oc, const size_t od)
+  {
+    const size_t L    = S->dim()-1;
+    const long   nnz  = (long) (Q-P);
+    const long*  idx  = S->idx(L) + P;
+    const T*     val  = S->val() + P;
+    const long   len  = (long) S->size(0);
+    const bool   dense = nnz*SPARSE_CONTRACT_DENSE >= len && (K0 ? SD[0] : SC[0]) == 1;
+
+    if (K0)
+    {
+      //C(n) += alpha * S . D(:,n)
+      const long* ix = idx;
+      if (SD[0] != 1)
+      {
+        for (long j=0;j<nnz;j++) sidx[j] = idx[j]*(long) SD[0];
+        ix = sidx.data();
+      }
+      if (dense)
+      {
+        for (long j=0;j<nnz;j++) line[idx[j]] = val[j];
+        for (size_t n=N0;n<N1;n++) C[oc+NC[n]] += alpha*simd_auto_dot<T>(len,line.data(),D+od+ND[n]);
+        for (long j=0;j<nnz;j++) line[idx[j]] = (T) 0;
+      } else {
+        for (size_t n=N0;n<N1;n++) C[oc+NC[n]] += alpha*simd_gather_dot<T>(nnz,D+od+ND[n],ix,val);
+      }
+    } else {
+      //C(m,n) += alpha * S(m) * D(n)
+      if (dense)
+      {
+        for (long j=0;j<nnz;j++) line[idx[j]] = val[j];
+        for (size_t n=N0;n<N1;n++) simd_auto_axpy<T>(len,alpha*D[od+ND[n]],line.data(),C+oc+NC[n]);
+        for (long j=0;j<nnz;j++) line[idx[j]] = (T) 0;
+      } else if (NSEQ) {
+        for (long j=0;j<nnz;j++)
+        {
+          simd_axpy<T>((long) (N1-N0),alpha*val[j],D+od+N0,C+oc+idx[j]*SC[0]+N0);
+        }
+      } else {
+        for (long j=0;j<nnz;j++)
+        {
+          const T a = alpha*val[j];
+          T* cc = C + oc + idx[j]*SC[0];
+          const T* dd = D + od;
+          for (size_t n=N0;n<N1;n++) cc[NC[n]] += a*dd[ND[n]];
+        }
+      }
+    }
+  }
+
+  //node I of level l, with the offsets of the levels above
+  void node(const size_t l, const size_t I, size_t oc, size_t od)
+  {
+    const size_t d = S->level_dim(l);
+    oc += S->idx(l)[I]*SC[d];
+    od += S->idx(l)[I]*SD[d];
+    const size_t p = S->ptr(l)[I];
+    const size_t q = S->ptr(l)[I+1];
+    if (l+2 == S->dim())
+    {
+      fiber(p,q,oc,od);
+    } else {
+      for (size_t c=p;c<q;c++) node(l+1,c,oc,od);
+    }
+  }
+
+  //all nodes of the root level from R0 to R1-1
+  void roots(const size_t R0, const size_t R1)
+  {
+    if (S->dim() == 1)
+    {
+      if (R0 < R1) fiber(0,S->nnz(),0,0);
+      return;
+    }
+    for (size_t r=R0;r<R1;r++) node(0,r,0,0);
+  }
+};
+
+/*----------------------------------------------------------------------
+  General code
+----------------------------------------------------------------------*/
+template <typename T>
+void contract(const T alpha, const libj::sparse_tensor<T>& A, const std::string& idxA,
+              const libj::tensor<T>& B, const std::string& idxB,
+              const T beta, libj::tensor<T>& C, const std::string& idxC)
+{
+  if (idxA.length() != A.dim() || idxB.length() != B.dim() || idxC.length() != C.dim())
+  {
+    sparse_contract_error(idxA,idxB,idxC,"The number of labels does not match the tensor dimensions");
+  }
+
+  sparse_contract_walk<T> W;
+  W.S = &A;
+  W.D = B.data();
+  W.C = C.data();
+  W.alpha = alpha;
+  W.SC.assign(A.dim(),0);
+  W.SD.assign(A.dim(),0);
+
+  //each label of A is in one of B and C
+  for (size_t a=0;a<idxA.length();a++)
+  {
+    const size_t b = idxB.find(idxA[a]);
+    const size_t c = idxC.find(idxA[a]);
+    if (idxA.find(idxA[a]) != a) sparse_contract_error(idxA,idxB,idxC,"Repeated label in A");
+    if ((b == std::string::npos) == (c == std::string::npos))
+    {
+      sparse_contract_error(idxA,idxB,idxC,"A label of A must be in exactly one of B and C");
+    }
+    if (b != std::string::npos)
+    {
+      if (B.size(b) != A.size(a)) sparse_contract_error(idxA,idxB,idxC,"Lengths of A and B do not match");
+      W.SD[a] = B.stride(b);
+    } else {
+      if (C.size(c) != A.size(a)) sparse_contract_error(idxA,idxB,idxC,"Lengths of A and C do not match");
+      W.SC[a] = C.stride(c);
+    }
+  }
+
+  //the N bundle, in the order of C
+  std::vector<size_t> nlen, nsb, nsc;
+  for (size_t c=0;c<idxC.length();c++)
+  {
+    if (idxC.find(idxC[c]) != c) sparse_contract_error(idxA,idxB,idxC,"Repeated label in C");
+    const size_t a = idxA.find(idxC[c]);
+    const size_t b = idxB.find(idxC[c]);
+    if ((a == std::string::npos) == (b == std::string::npos))
+    {
+      sparse_contract_error(idxA,idxB,idxC,"A label of C must be in exactly one of A and B");
+    }
+    if (b == std::string::npos) continue;
+    if (B.size(b) != C.size(c)) sparse_contract_error(idxA,idxB,idxC,"Lengths of B and C do not match");
+    nlen.push_back(C.size(c));
+    nsb.push_back(B.stride(b));
+    nsc.push_back(C.stride(c));
+  }
+  for (size_t b=0;b<idxB.length();b++)
+  {
+    if (idxB.find(idxB[b]) != b) sparse_contract_error(idxA,idxB,idxC,"Repeated label in B");
+    if (idxA.find(idxB[b]) == std::string::npos && idxC.find(idxB[b]) == std::string::npos)
+    {
+      sparse_contract_error(idxA,idxB,idxC,"A label of B must be in one of A and C");
+    }
+  }
+
+  size_t NN = 1;
+  for (size_t n=0;n<nlen.size();n++) NN *= nlen[n];
+  W.NC.assign(NN,0);
+  W.ND.assign(NN,0);
+  W.NSEQ = true;
+  for (size_t I=0;I<NN;I++)
+  {
+    size_t r = I;
+    for (size_t n=0;n<nlen.size();n++)
+    {
+      const size_t i = r%nlen[n];
+      r /= nlen[n];
+      W.NC[I] += i*nsc[n];
+      W.ND[I] += i*nsb[n];
+    }
+    if (W.NC[I] != I || W.ND[I] != I) W.NSEQ = false;
+  }
+  W.K0 = idxB.find(idxA[0]) != std::string::npos;
+
+  //C = beta*C
+  if (beta == (T) 0) {libj::zero<T>(C);}
+  else if (beta != (T) 1) {libj::scal<T>(beta,C);}
+  if (A.nnz() == 0 || NN == 0) return;
+
+  const size_t NR    = (A.dim() > 1) ? A.nodes(0) : 1;
+  const bool   rootM = A.dim() > 1 && idxC.find(idxA[A.dim()-1]) != std::string::npos;
+
+  #pragma omp parallel firstprivate(W)
+  {
+    W.line.assign(A.size(0),(T) 0);
+    W.sidx.assign(A.size(0),0);
+    #if defined (_OPENMP)
+      const size_t tid  = (size_t) omp_get_thread_num();
+      const size_t nthr = (size_t) omp_get_num_threads();
+    #else
+      const size_t tid  = 0;
+      const size_t nthr = 1;
+    #endif
+    if (rootM)
+    {
+      W.N0 = 0;
+      W.N1 = NN;
+      #pragma omp for schedule(dynamic,1)
+      for (long r=0;r<(long) NR;r++) W.roots((size_t) r,(size_t) r+1);
+    } else {
+      W.N0 = (NN*tid)/nthr;
+      W.N1 = (NN*(tid+1))/nthr;
+      if (W.N0 < W.N1) W.roots(0,NR);
+    }
+  }
+}
+
+template <typename T>
+void contract(const T alpha, const libj::tensor<T>& A, const std::string& idxA,
+              const libj::sparse_tensor<T>& B, const std::string& idxB,
+              const T beta, libj::tensor<T>& C, const std::string& idxC)
+{
+  libj::contract<T>(alpha,B,idxB,A,idxA,beta,C,idxC);
+}
+
+template void libj::contract<double>(const double alpha, const libj::sparse_tensor<double>& A,
+                                     const std::string& idxA, const libj::tensor<double>& B,
+                                     const std::string& idxB, const double beta,
+                                     libj::tensor<double>& C, const std::string& idxC);
+template void libj::contract<float>(const float alpha, const libj::sparse_tensor<float>& A,
+                                    const std::string& idxA, const libj::tensor<float>& B,
+                                    const std::string& idxB, const float beta,
+                                    libj::tensor<float>& C, const std::string& idxC);
+template void libj::contract<double>(const double alpha, const libj::tensor<double>& A,
+                                     const std::string& idxA, const libj::sparse_tensor<double>& B,
+                                     const std::string& idxB, const double beta,
+                                     libj::tensor<double>& C, const std::string& idxC);
+template void libj::contract<float>(const float alpha, const libj::tensor<float>& A,
+                                    const std::string& idxA, const libj::sparse_tensor<float>& B,
+                                    const std::string& idxB, const float beta,
+                                    libj::tensor<float>& C, const std::string& idxC);
+
+}//end of namespace
@@ -0,0 +1,384 @@
+/*----------------------------------------------------------------------
+  tucker.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for the Tucker compression of a libj::tensor, and the
+  contraction of compressed tensors (see tucker.hpp)
+
+  tucker_compress is the sequentially truncated higher order SVD
+  (Vannieuwenhoven, Vandebril and Meerbergen, SIAM J. Sci. Comput. 34,
+  A1027 (2012)). For each dimension d in turn, the current core X is
+  unfolded into the n_d x (rest) matrix X_(d) with libj::permute, and
+
+    X_(d) = U . S . V^T
+
+  with linal_dgesdd, or linal_drsvd if the rank is capped. The first
+  r_d columns of U are the factor, and the new core is S_r . V_r^T,
+  folded back, so the dimensions after d are done on a smaller core.
+  The discarded part of mode d is sum_{i>=r} s_i^2, and r_d is
+  the smallest rank with this below tol^2 |A|^2 / ND, so that
+
+    |A - T| <= sqrt(sum_d discarded_d) <= tol |A|
+
+  tucker_contract does C = alpha * A . B + beta * C without expanding A
+  or B. For each K label, the factors are reduced to the r_A x r_B
+  overlap W = U_A^T . U_B, which is applied to the core of A, the cores
+  are contracted into a core of C, and this is expanded by the factors
+  of the M and N labels. Everything but the last expansion is on the
+  cores, and all of it is done with the dense libj::contract.
+
+----------------------------------------------------------------------*/
+#include <stdio.h>
+#include <math.h>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include "jblis_level3.hpp"
+#include "jblis_level1.hpp"
+#include "linal_decomp.hpp"
+#include "core.hpp"
+
+namespace libj
+{
+
+/*----------------------------------------------------------------------
+  tucker_error
+----------------------------------------------------------------------*/
+inline void tucker_error(const char* fn, const char* msg)
+{
+  printf("ERROR libj::%s \n",fn);
+  printf("%s \n",msg);
+  exit(1);
+}
+
+/*----------------------------------------------------------------------
+  tucker_labels
+	"abc..." for ND dimensions
+----------------------------------------------------------------------*/
+inline std::string tucker_labels(const size_t ND)
+{
+  std::string idx(ND,'a');
+  for (size_t d=0;d<ND;d++) idx[d] = (char) ('a' + d);
+  return idx;
+}
+
+/*----------------------------------------------------------------------
+  tucker_free_label
+	a lowercase label that is in none of the strings
+----------------------------------------------------------------------*/
+inline char tucker_free_label(const std::string& a, const std::string& b,
+                              const std::string& c)
+{
+  for (char l='a';l<='z';l++)
+  {
+    if (a.find(l) == std::string::npos && b.find(l) == std::string::npos &&
+        c.find(l) == std::string::npos) return l;
+  }
+  tucker_error("tucker_contract","No free labels are left");
+  return 'z';
+}
+
+/*----------------------------------------------------------------------
+  tucker_mode_product
+	Y = X x_d U, that is, Y(..i..) = sum_r U(i,r) X(..r..), with the
+	labels idx of X and Y, and a label l for i that is not in idx
+----------------------------------------------------------------------*/
+inline void tucker_mode_product(const double alpha, const libj::tensor<double>& U,
+                                const libj::tensor<double>& X, const std::string& idx,
+                                const size_t d, const char l, const double beta,
+                                libj::tensor<double>& Y)
+{
+  std::string idxY = idx;
+  idxY[d] = l;
+  const std::string idxU = {l,idx[d]};
+  libj::contract<double>(alpha,U,idxU,X,idx,beta,Y,idxY);
+}
+
+/*----------------------------------------------------------------------
+  tucker_compress
+----------------------------------------------------------------------*/
+double tucker_compress(const libj::tensor<double>& A, const double tol,
+                       libj::tucker<double>& T, const size_t max_rank)
+{
+  const size_t ND = A.dim();
+  if (ND < 1 || ND > 26) {tucker_error("tucker_compress","A must have 1 to 26 dimensions");}
+  if (tol < 0) {tucker_error("tucker_compress","tol must not be negative");}
+  const std::string idx = tucker_labels(ND);
+
+  //X is the current core, P its unfolding
+  std::vector<size_t> L(ND);
+  for (size_t d=0;d<ND;d++) L[d] = A.size(d);
+  std::vector<double> XBUF(A.size()), PBUF(A.size());
+  libj::tensor<double> X, P;
+  X.assign(XBUF.data(),L);
+  libj::permute<double>(A,idx,X,idx);
+
+  double norm2 = 0;
+  for (size_t i=0;i<X.size();i++) norm2 += XBUF[i]*XBUF[i];
+  const double eps2 = tol*tol*norm2/ND;
+
+  std::vector<std::vector<double> > FAC(ND);
+  std::vector<size_t> R(ND);
+  double discarded = 0;
+  double cur2 = norm2;
+  for (size_t d=0;d<ND;d++)
+  {
+    //unfold X into P, dimension d first
+    std::string idxP(1,idx[d]);
+    std::vector<size_t> LP(1,L[d]);
+    for (size_t e=0;e<ND;e++) {if (e != d) {idxP += idx[e]; LP.push_back(L[e]);}}
+    P.assign(PBUF.data(),LP);
+    libj::permute<double>(X,idx,P,idxP);
+
+    const long M = (long) L[d];
+    const long N = (long) (X.size()/L[d]);
+    const bool capped = (max_rank > 0 && (long) max_rank < std::min(M,N));
+    const long K = capped ? (long) max_rank : std::min(M,N);
+    std::vector<double> S(K), U(M*K), VT(K*N);
+    int INFO = 0;
+    if (capped)
+    {
+      Core<double> CORE(linal_drsvd_NWORK(M,N,K));
+      linal_drsvd(M,N,K,PBUF.data(),S.data(),U.data(),VT.data(),CORE,INFO);
+    } else {
+      Core<double> CORE(linal_dgesdd_NWORK(M,N));
+      linal_dgesdd(M,N,PBUF.data(),S.data(),U.data(),VT.data(),CORE,INFO);
+    }
+    if (INFO != 0) {tucker_error("tucker_compress","SVD of an unfolding failed");}
+
+    //smallest rank with the discarded part below eps2. With all the
+    //  singular values, the tail is summed from the smallest, as the
+    //  difference would lose tol^2 below the machine precision
+    std::vector<double> tail(K+1,0.0);
+    for (long i=K-1;i>=0;i--) tail[i] = tail[i+1] + S[i]*S[i];
+    const double rest = capped ? std::max(cur2 - tail[0],0.0) : 0.0;
+    long r = 1;
+    while (r < K && rest + tail[r] > eps2) r++;
+    discarded += rest + tail[r];
+    cur2 = tail[0] - tail[r];
+
+    FAC[d].assign(U.begin(),U.begin()+M*r);
+    R[d] = (size_t) r;
+
+    //new core S_r . V_r^T, r x (rest), then fold it back into X
+    for (long j=0;j<N;j++)
+    {
+      for (long i=0;i<r;i++) PBUF[i+j*r] = S[i]*VT[i+j*K];
+    }
+    LP[0] = (size_t) r;
+    L[d]  = (size_t) r;
+    P.assign(PBUF.data(),LP);
+    X.assign(XBUF.data(),L);
+    libj::permute<double>(P,idxP,X,idx);
+  }
+
+  std::vector<size_t> lengths(ND);
+  for (size_t d=0;d<ND;d++) lengths[d] = A.size(d);
+  T.allocate(lengths,R);
+  libj::copy<double>(X,T.core());
+  for (size_t d=0;d<ND;d++)
+  {
+    std::copy(FAC[d].begin(),FAC[d].end(),T.factor(d).data());
+  }
+  return sqrt(discarded);
+}
+
+/*----------------------------------------------------------------------
+  tucker_expand
+	A = alpha * G x_0 U_0 x_1 U_1 ... + beta * A
+----------------------------------------------------------------------*/
+void tucker_expand(const double alpha, const libj::tucker<double>& T,
+                   const double beta, libj::tensor<double>& A)
+{
+  const size_t ND = T.dim();
+  if (A.dim() != ND) {tucker_error("tucker_expand","A and T have different dimensions");}
+  for (size_t d=0;d<ND;d++)
+  {
+    if (A.size(d) != T.size(d)) {tucker_error("tucker_expand","A and T have different lengths");}
+  }
+  const std::string idx = tucker_labels(ND);
+  const char l = (char) ('a' + ND);
+
+  //ping-pong through two buffers, the last product into A
+  std::vector<size_t> L = T.ranks();
+  size_t nmax = 1;
+  for (size_t d=0;d+1<ND;d++)
+  {
+    L[d] = T.size(d);
+    size_t n = 1;
+    for (size_t e=0;e<ND;e++) n *= L[e];
+    nmax = std::max(nmax,n);
+  }
+  std::vector<double> BUF0(nmax), BUF1(nmax);
+  L = T.ranks();
+  libj::tensor<double> X = T.core(), Y;
+  for (size_t d=0;d<ND;d++)
+  {
+    if (d+1 == ND)
+    {
+      tucker_mode_product(alpha,T.factor(d),X,idx,d,l,beta,A);
+    } else {
+      L[d] = T.size(d);
+      Y.assign((d%2 == 0) ? BUF0.data() : BUF1.data(),L);
+      tucker_mode_product(1.0,T.factor(d),X,idx,d,l,0.0,Y);
+      X.assign(Y.data(),L);
+    }
+  }
+}
+
+/*----------------------------------------------------------------------
+  tucker_contract_core
+	the core H of the contraction, with the labels of C, as well as the
+	factor of each label of C. H is assigned to HBUF
+----------------------------------------------------------------------*/
+static void tucker_contract_core(const double alpha, const libj::tucker<double>& A,
+                                 const std::string& idxA, const libj::tucker<double>& B,
+                                 const std::string& idxB, const std::string& idxC,
+                                 std::vector<double>& HBUF, libj::tensor<double>& H,
+                                 std::vector<const libj::tensor<double>*>& FC)
+{
+  if (idxA.length() != A.dim() || idxB.length() != B.dim())
+  {
+    tucker_error("tucker_contract","The number of labels does not match the tensor dimensions");
+  }
+
+  //factors and ranks of C
+  FC.resize(idxC.length());
+  std::vector<size_t> RC(idxC.length());
+  for (size_t c=0;c<idxC.length();c++)
+  {
+    const size_t a = idxA.find(idxC[c]);
+    const size_t b = idxB.find(idxC[c]);
+    if (a != std::string::npos && b == std::string::npos)
+    {
+      FC[c] = &A.factor(a);
+      RC[c] = A.rank(a);
+    } else if (b != std::string::npos && a == std::string::npos) {
+      FC[c] = &B.factor(b);
+      RC[c] = B.rank(b);
+    } else {
+      tucker_error("tucker_contract","Each label of C must be in one of A or B");
+    }
+  }
+
+  //the K labels, the core of A with W = U_A^T . U_B on each
+  std::vector<size_t> LA = A.ranks();
+  size_t ncur = A.core().size();
+  size_t nmax = ncur;
+  for (size_t a=0;a<idxA.length();a++)
+  {
+    if (idxC.find(idxA[a]) != std::string::npos) continue;
+    const size_t b = idxB.find(idxA[a]);
+    if (b == std::string::npos) {tucker_error("tucker_contract","Label of A is not in B or C");}
+    if (A.size(a) != B.size(b)) {tucker_error("tucker_contract","Lengths of the K labels do not match");}
+    ncur = (ncur/LA[a])*B.rank(b);
+    nmax = std::max(nmax,ncur);
+    LA[a] = B.rank(b);
+  }
+  std::vector<double> BUF0(nmax), BUF1(nmax), WBUF;
+  libj::tensor<double> G = A.core(), Y, W;
+  LA = A.ranks();
+  const char l = tucker_free_label(idxA,idxB,idxC);
+  size_t nk = 0;
+  for (size_t a=0;a<idxA.length();a++)
+  {
+    if (idxC.find(idxA[a]) != std::string::npos) continue;
+    const size_t b = idxB.find(idxA[a]);
+    WBUF.resize(A.rank(a)*B.rank(b));
+    W.assign(WBUF.data(),std::vector<size_t>{A.rank(a),B.rank(b)});
+    libj::contract<double>(1.0,A.factor(a),"ab",B.factor(b),"ac",0.0,W,"bc");
+
+    //G(..s..) = sum_r W(r,s) G(..r..)
+    LA[a] = B.rank(b);
+    Y.assign((nk%2 == 0) ? BUF0.data() : BUF1.data(),LA);
+    std::string idxY = idxA;
+    idxY[a] = l;
+    libj::contract<double>(1.0,W,std::string{idxA[a],l},G,idxA,0.0,Y,idxY);
+    G.assign(Y.data(),LA);
+    nk++;
+  }
+
+  //H = alpha * G . core(B)
+  size_t nh = 1;
+  for (size_t c=0;c<RC.size();c++) nh *= RC[c];
+  HBUF.resize(nh);
+  H.assign(HBUF.data(),RC);
+  libj::contract<double>(alpha,G,idxA,B.core(),idxB,0.0,H,idxC);
+}
+
+/*----------------------------------------------------------------------
+  tucker_contract (dense C)
+----------------------------------------------------------------------*/
+void tucker_contract(const double alpha, const libj::tucker<double>& A, const std::string& idxA,
+                     const libj::tucker<double>& B, const std::string& idxB,
+                     const double beta, libj::tensor<double>& C, const std::string& idxC)
+{
+  if (idxC.length() != C.dim() || C.dim() < 1)
+  {
+    tucker_error("tucker_contract","The number of labels does not match the dimensions of C");
+  }
+  std::vector<double> HBUF;
+  libj::tensor<double> H;
+  std::vector<const libj::tensor<double>*> FC;
+  tucker_contract_core(alpha,A,idxA,B,idxB,idxC,HBUF,H,FC);
+
+  const size_t ND = C.dim();
+  for (size_t c=0;c<ND;c++)
+  {
+    if (FC[c]->size(0) != C.size(c)) {tucker_error("tucker_contract","Lengths of C do not match A and B");}
+  }
+
+  //expand H by the factors, as in tucker_expand
+  const std::string idx = tucker_labels(ND);
+  const char l = (char) ('a' + ND);
+  std::vector<size_t> L(ND);
+  for (size_t c=0;c<ND;c++) L[c] = H.size(c);
+  size_t nmax = 1;
+  for (size_t c=0;c+1<ND;c++)
+  {
+    L[c] = C.size(c);
+    size_t n = 1;
+    for (size_t e=0;e<ND;e++) n *= L[e];
+    nmax = std::max(nmax,n);
+  }
+  for (size_t c=0;c<ND;c++) L[c] = H.size(c);
+  std::vector<double> BUF0(nmax), BUF1(nmax);
+  libj::tensor<double> X = H, Y;
+  for (size_t c=0;c<ND;c++)
+  {
+    if (c+1 == ND)
+    {
+      tucker_mode_product(1.0,*FC[c],X,idx,c,l,beta,C);
+    } else {
+      L[c] = C.size(c);
+      Y.assign((c%2 == 0) ? BUF0.data() : BUF1.data(),L);
+      tucker_mode_product(1.0,*FC[c],X,idx,c,l,0.0,Y);
+      X.assign(Y.data(),L);
+    }
+  }
+}
+
+/*----------------------------------------------------------------------
+  tucker_contract (tucker C)
+----------------------------------------------------------------------*/
+void tucker_contract(const double alpha, const libj::tucker<double>& A, const std::string& idxA,
+                     const libj::tucker<double>& B, const std::string& idxB,
+                     libj::tucker<double>& C, const std::string& idxC)
+{
+  std::vector<double> HBUF;
+  libj::tensor<double> H;
+  std::vector<const libj::tensor<double>*> FC;
+  tucker_contract_core(alpha,A,idxA,B,idxB,idxC,HBUF,H,FC);
+
+  std::vector<size_t> lengths(idxC.length()), ranks(idxC.length());
+  for (size_t c=0;c<idxC.length();c++)
+  {
+    lengths[c] = FC[c]->size(0);
+    ranks[c]   = FC[c]->size(1);
+  }
+  C.allocate(lengths,ranks);
+  libj::copy<double>(H,C.core());
+  for (size_t c=0;c<idxC.length();c++) libj::copy<double>(*FC[c],C.factor(c));
+}
+
+}//end of namespace
@@ -15,9 +15,11 @@
 #include "usymat.hpp"
 #include "geten3.hpp"
 #include "geten4.hpp"
+#include "batch.hpp"
 #include "fsys.hpp"
 #include "timer.hpp"
 #include "linal.hpp"
 #include "simd.hpp"
+#include "simd_dispatch.hpp"
 
 #endif
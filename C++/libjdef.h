@@ -8,6 +8,9 @@
 #define L1_BYTES 32768
 #define L2_BYTES 262144
 #define LINE_BYTES 64
+#define LIBJ_L1_BYTES L1_BYTES
+#define LIBJ_L2_BYTES L2_BYTES
+#define LIBJ_LINE_BYTES LINE_BYTES
 
 //ALIGNMENT DEFINITIONS
 #define DOUBLE_ALIGN 32
@@ -15,6 +18,14 @@
 #define LONG_ALIGN 32
 #define INT_ALIGN 32
 #define MAX_ALIGN DOUBLE_ALIGN
+#define LIBJ_MAX_ALIGN MAX_ALIGN
 
 //compiler specific definitions
 #define LIBJ_RESTRICT __restrict__
+
+//tells the compiler p is aligned to a BYTES, where it can
+#if defined (__GNUC__)
+  #define LIBJ_ASSUME_ALIGNED(p,a) __builtin_assume_aligned((p),(a))
+#else
+  #define LIBJ_ASSUME_ALIGNED(p,a) (p)
+#endif
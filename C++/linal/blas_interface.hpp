@@ -28,10 +28,21 @@ extern "C" {
                      double* ALPHA, double* A, int* LDA,
                      double* B,int* LDB,
                      double* BETA, double* C, int* LDC);
-  extern void dsymm_(char* TRANSA, char* TRANSB, int* M, int* N, int* K,
+  extern void dsymm_(char* SIDE, char* UPLO, int* M, int* N,
+                     double* ALPHA, double* A, int* LDA,
+                     double* B, int* LDB,
+                     double* BETA, double* C, int* LDC);
+  extern void dsyrk_(char* UPLO, char* TRANS, int* N, int* K,
                      double* ALPHA, double* A, int* LDA,
-                     double* B,int* LDB,
                      double* BETA, double* C, int* LDC);
+  extern void sgemm_(char* TRANSA, char* TRANSB, int* M, int* N, int* K,
+                     float* ALPHA, float* A, int* LDA,
+                     float* B,int* LDB,
+                     float* BETA, float* C, int* LDC);
+  extern void ssymm_(char* SIDE, char* UPLO, int* M, int* N,
+                     float* ALPHA, float* A, int* LDA,
+                     float* B, int* LDB,
+                     float* BETA, float* C, int* LDC);
 
 #ifdef __cplusplus
 }
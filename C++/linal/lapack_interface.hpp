@@ -33,6 +33,47 @@ extern "C" {
                       int* LDU, double* VT, int* LDVT, double* WORK,
                       int* LWORK, int* INFO);
 
+  extern void dgesdd_(char* JOBZ, int* M, int* N, double* A, int* LDA,
+                      double* S, double* U, int* LDU, double* VT, 
+                      int* LDVT, double* WORK, int* LWORK, int* IWORK,
+                      int* INFO);
+
+  extern void dsyevd_(char* JOBZ, char* UPLO, int* N, double* A, 
+                      int* LDA, double* W, double* WORK, int* LWORK,
+                      int* IWORK, int* LIWORK, int* INFO);
+
+  extern void dgetrf_(int* M, int* N, double* A, int* LDA, int* IPIV, 
+                      int* INFO);
+
+  extern void dgetrs_(char* TRANS, int* N, int* NRHS, double* A, int* LDA,
+                      int* IPIV, double* B, int* LDB, int* INFO);
+
+  extern void dpotrf_(char* UPLO, int* N, double* A, int* LDA, int* INFO);
+
+  extern void dpotrs_(char* UPLO, int* N, int* NRHS, double* A, int* LDA,
+                      double* B, int* LDB, int* INFO);
+
+  extern void sgetrf_(int* M, int* N, float* A, int* LDA, int* IPIV, 
+                      int* INFO);
+
+  extern void sgetrs_(char* TRANS, int* N, int* NRHS, float* A, int* LDA,
+                      int* IPIV, float* B, int* LDB, int* INFO);
+
+  extern void spotrf_(char* UPLO, int* N, float* A, int* LDA, int* INFO);
+
+  extern void spotrs_(char* UPLO, int* N, int* NRHS, float* A, int* LDA,
+                      float* B, int* LDB, int* INFO);
+
+  extern void dgeqrf_(int* M, int* N, double* A, int* LDA, double* TAU,
+                      double* WORK, int* LWORK, int* INFO);
+
+  extern void dorgqr_(int* M, int* N, int* K, double* A, int* LDA, 
+                      double* TAU, double* WORK, int* LWORK, int* INFO);
+
+  extern void dormqr_(char* SIDE, char* TRANS, int* M, int* N, int* K, 
+                      double* A, int* LDA, double* TAU, double* C, int* LDC,
+                      double* WORK, int* LWORK, int* INFO);
+
 
 #ifdef __cplusplus
 }
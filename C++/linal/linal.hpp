@@ -8,6 +8,7 @@
 
     General naming scheme:
     D,X,Y	is a diagonal matrix
+    S		is a sparse (CSR or BSR) matrix
     A,B,C	are rectangular matrices
     U,L		are upper,lower symmetric matrices
     T		indicates a transpose applied to the matrix before
@@ -35,6 +36,8 @@
 #include "linal_AUBpY.hpp"
 #include "linal_ATpB.hpp"
 #include "linal_AUxpy.hpp"
+#include "linal_Uxpy.hpp"
+#include "linal_ATApU.hpp"
 #include "linal_ATUxpy.hpp"
 #include "linal_ATBpU.hpp"
 #include "linal_ATDAeU.hpp"
@@ -45,15 +48,28 @@
 #include "linal_DATpB.hpp"
 #include "linal_ATBpC.hpp"
 #include "linal_ABpC.hpp"
+#include "linal_gemm.hpp"
+#include "linal_strassen.hpp"
+#include "linal_blas.hpp"
 #include "linal_DApB.hpp"
+#include "linal_par.hpp"
+#include "linal_sparse.hpp"
 
 //these are not named correctly
 #include "linal_usym2v.hpp"
 #include "linal_geprint.hpp"
 #include "linal_svd.hpp"
+#include "linal_decomp.hpp"
+#include "linal_solve.hpp"
+#include "linal_pchol.hpp"
+#include "linal_tsqr.hpp"
+#include "linal_usym_chol.hpp"
+#include "linal_usym_pow.hpp"
 #include "linal_usym3_invrt.hpp"
 #include "linal_usym3_usym3_MM.hpp"
 #include "linal_usym3_sqm3_MM_UP.hpp"
+#include "linal_usym3_eig.hpp"
+#include "linal_batch.hpp"
 
 //some things that are probably not needed
 //And are named incorrecly
@@ -61,5 +77,6 @@
 #include "linal_MTM_UP_small.hpp"
 #include "linal_vxv_small.hpp"
 #include "linal_vxM_small.hpp"
+#include "linal_fixed.hpp"
 
 #endif
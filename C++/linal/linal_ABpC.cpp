@@ -1,16 +1,21 @@
 /*------------------------------------------------
   linal_ABpC.cpp
         JHT, December 8, 2021 : created 
+        JHT, October 14, 2026 : leading dimensions
+        JHT, October 14, 2026 : Strassen-Winograd, opt-in
 
     C = ALPHA*A.B + BETA*C  
 
     It is assumed that C,A,and B are all 
     continous in memory, and stored column 
-    major (logical dimension == physical dimension) 
+    major (logical dimension == physical dimension),
+    unless LDA, LDB, and LDC are given 
 
     Currently this is implemented using 
     one vector of A at a time to distribute 
-    along the cols of C
+    along the cols of C. After linal_strassen_set,
+    the double and float products with M, N, and
+    K all large enough go to linal_strassen
 ------------------------------------------------*/
 
 /* Variables
@@ -23,32 +28,41 @@ A	T*	pointer to A
 B	T*	pointer to B
 BETA	T	constant to scale C by
 C	T*	pointer to C 
+LDA	int	leading dimension of A, >= M
+LDB	int	leading dimension of B, >= K
+LDC	int	leading dimension of C, >= M
 
 */
 #include "linal_ABpC.hpp"
+#include "linal_strassen.hpp"
+#include "simd_inline.hpp"
+#include <algorithm>
 
-//unaligned code
+//unaligned code, one column (dot) at a time. The column 
+//kernels are inlined, as this is used for the small products
+//(the larger go to linal_gemm), where the call dominates
 template <typename T>
-void linal_ABpC(const int M, const int N, const int K, const T ALPHA, T* A, T* B, const T BETA, T* C)
+static void linal_ABpC_cols(const int M, const int N, const int K, const T ALPHA, T* A, const long LDA, 
+                            T* B, const long LDB, const T BETA, T* C, const long LDC)
 {
   T* cc;
   //BETA is zero, ALPHA is one (a common case)
-  if (fabs((double)ALPHA - (double) 1) < DZTOL
-   && fabs((double) BETA) < DZTOL)
+  if (std::abs(ALPHA - (T) 1) < DZTOL
+   && std::abs(BETA) < DZTOL)
   {
     //loop over cols of C
     for (auto J=0;J<N;J++)
     {
 
-      cc = C+M*J; //column of C we're working on
+      cc = C+LDC*J; //column of C we're working on
 
       //zero the column
-      simd_zero<T>(M,cc); 
+      simd_inline_zero<T>(M,cc); 
       
       //loop through the other cols of A and down col of B 
       for (auto I=0;I<K;I++)
       {
-        simd_axpy<T>(M,*(B+K*J+I),(A+M*I),cc); 
+        simd_inline_axpy<T>(M,*(B+LDB*J+I),(A+LDA*I),cc); 
       }
     } 
 
@@ -59,29 +73,188 @@ void linal_ABpC(const int M, const int N, const int K, const T ALPHA, T* A, T* B
     for (auto J=0;J<N;J++)
     {
 
-      cc = C+M*J; //column of C we're working on
+      cc = C+LDC*J; //column of C we're working on
 
-      //+BETA*C for this column
-      simd_axpy<T>(M,BETA,cc,cc); 
+      //BETA*C for this column
+      simd_inline_scal_mul<T>(M,BETA,cc); 
       
       //loop through the other cols of A and down col of B 
       for (auto I=0;I<K;I++)
       {
-        simd_axpy<T>(M,ALPHA**(B+K*J+I),(A+M*I),cc); 
+        simd_inline_axpy<T>(M,ALPHA**(B+LDB*J+I),(A+LDA*I),cc); 
       }
     } 
 
   }//end if statements 
 }
 
-template void linal_ABpC<double>(const int M,const int N,const int K,const double ALPHA, double* A, 
-                                double* B,const double BETA, double* C);
-template void linal_ABpC<float>(const int M,const int N,const int K,const float ALPHA, float* A, 
-                                float* B,const float BETA, float* C);
+template <typename T>
+void linal_ABpC(const int M, const int N, const int K, const T ALPHA, T* A, T* B, const T BETA, T* C)
+{
+  linal_ABpC_cols<T>(M,N,K,ALPHA,A,M,B,K,BETA,C,M);
+}
+
+//doubles and floats use the blocked code for the larger matrices
+template <>
+void linal_ABpC<double>(const int M, const int N, const int K, const double ALPHA, double* A, double* B, 
+                    const double BETA, double* C)
+{
+  if (linal_strassen_depth(M,N,K,linal_strassen_min(),linal_strassen_levels()) > 0)
+  {
+    linal_strassen<double>(M,N,K,ALPHA,A,M,B,K,BETA,C,M,linal_strassen_min(),linal_strassen_levels());
+  } else if ((long) M*N*K >= LINAL_GEMM_MNK) {linal_gemm<double>(false,M,N,K,ALPHA,A,B,BETA,C);}
+  else {linal_ABpC_cols<double>(M,N,K,ALPHA,A,M,B,K,BETA,C,M);}
+}
+
+template <>
+void linal_ABpC<float>(const int M, const int N, const int K, const float ALPHA, float* A, float* B, 
+                   const float BETA, float* C)
+{
+  if (linal_strassen_depth(M,N,K,linal_strassen_min(),linal_strassen_levels()) > 0)
+  {
+    linal_strassen<float>(M,N,K,ALPHA,A,M,B,K,BETA,C,M,linal_strassen_min(),linal_strassen_levels());
+  } else if ((long) M*N*K >= LINAL_GEMM_MNK) {linal_gemm<float>(false,M,N,K,ALPHA,A,B,BETA,C);}
+  else {linal_ABpC_cols<float>(M,N,K,ALPHA,A,M,B,K,BETA,C,M);}
+}
+
 template void linal_ABpC<long>(const int M,const int N,const int K,const long ALPHA, long* A, 
                                 long* B,const long BETA, long* C);
 template void linal_ABpC<int>(const int M,const int N,const int K,const int ALPHA, int* A, 
                                 int* B,const int BETA, int* C);
+template void linal_ABpC<std::complex<double> >(const int M,const int N,const int K,const std::complex<double> ALPHA, 
+                                std::complex<double>* A, std::complex<double>* B,const std::complex<double> BETA, 
+                                std::complex<double>* C);
+template void linal_ABpC<std::complex<float> >(const int M,const int N,const int K,const std::complex<float> ALPHA, 
+                                std::complex<float>* A, std::complex<float>* B,const std::complex<float> BETA, 
+                                std::complex<float>* C);
+
+//with leading dimensions
+template <typename T>
+void linal_ABpC(const int M, const int N, const int K, const T ALPHA, T* A, const int LDA,
+                T* B, const int LDB, const T BETA, T* C, const int LDC)
+{
+  linal_ABpC_cols<T>(M,N,K,ALPHA,A,LDA,B,LDB,BETA,C,LDC);
+}
+
+template <>
+void linal_ABpC<double>(const int M, const int N, const int K, const double ALPHA, double* A, const int LDA,
+                        double* B, const int LDB, const double BETA, double* C, const int LDC)
+{
+  if (linal_strassen_depth(M,N,K,linal_strassen_min(),linal_strassen_levels()) > 0)
+  {
+    linal_strassen<double>(M,N,K,ALPHA,A,LDA,B,LDB,BETA,C,LDC,linal_strassen_min(),linal_strassen_levels());
+  } else if ((long) M*N*K >= LINAL_GEMM_MNK) {linal_gemm<double>(false,M,N,K,ALPHA,A,LDA,B,LDB,BETA,C,LDC);}
+  else {linal_ABpC_cols<double>(M,N,K,ALPHA,A,LDA,B,LDB,BETA,C,LDC);}
+}
+
+template <>
+void linal_ABpC<float>(const int M, const int N, const int K, const float ALPHA, float* A, const int LDA,
+                       float* B, const int LDB, const float BETA, float* C, const int LDC)
+{
+  if (linal_strassen_depth(M,N,K,linal_strassen_min(),linal_strassen_levels()) > 0)
+  {
+    linal_strassen<float>(M,N,K,ALPHA,A,LDA,B,LDB,BETA,C,LDC,linal_strassen_min(),linal_strassen_levels());
+  } else if ((long) M*N*K >= LINAL_GEMM_MNK) {linal_gemm<float>(false,M,N,K,ALPHA,A,LDA,B,LDB,BETA,C,LDC);}
+  else {linal_ABpC_cols<float>(M,N,K,ALPHA,A,LDA,B,LDB,BETA,C,LDC);}
+}
+
+template void linal_ABpC<long>(const int M,const int N,const int K,const long ALPHA, long* A, const int LDA,
+                                long* B, const int LDB, const long BETA, long* C, const int LDC);
+template void linal_ABpC<int>(const int M,const int N,const int K,const int ALPHA, int* A, const int LDA,
+                                int* B, const int LDB, const int BETA, int* C, const int LDC);
+template void linal_ABpC<std::complex<double> >(const int M,const int N,const int K,const std::complex<double> ALPHA, std::complex<double>* A, const int LDA,
+                                std::complex<double>* B, const int LDB, const std::complex<double> BETA, std::complex<double>* C, const int LDC);
+template void linal_ABpC<std::complex<float> >(const int M,const int N,const int K,const std::complex<float> ALPHA, std::complex<float>* A, const int LDA,
+                                std::complex<float>* B, const int LDB, const std::complex<float> BETA, std::complex<float>* C, const int LDC);
+
+//Frobenius norms of the TILE x TILE tiles of A
+template <typename T>
+void linal_tile_norms(const int M, const int N, const int TILE, const T* A, const int LDA, double* NORMS)
+{
+  const int MT = (M + TILE - 1)/TILE;
+  const int NT = (N + TILE - 1)/TILE;
+  for (long t=0;t<(long) MT*NT;t++) NORMS[t] = 0;
+  for (int j=0;j<N;j++)
+  {
+    double* nrm = NORMS + (long) MT*(j/TILE);
+    const T* a = A + (long) LDA*j;
+    for (int it=0;it<MT;it++)
+    {
+      const int i1 = std::min(M,(it+1)*TILE);
+      double sum = 0;
+      for (int i=it*TILE;i<i1;i++) sum += (double) std::norm(a[i]);
+      nrm[it] += sum;
+    }
+  }
+  for (long t=0;t<(long) MT*NT;t++) NORMS[t] = sqrt(NORMS[t]);
+}
+template void linal_tile_norms<double>(const int M, const int N, const int TILE, const double* A,
+                                       const int LDA, double* NORMS);
+template void linal_tile_norms<float>(const int M, const int N, const int TILE, const float* A,
+                                      const int LDA, double* NORMS);
+template void linal_tile_norms<std::complex<double> >(const int M, const int N, const int TILE,
+                                       const std::complex<double>* A, const int LDA, double* NORMS);
+template void linal_tile_norms<std::complex<float> >(const int M, const int N, const int TILE,
+                                      const std::complex<float>* A, const int LDA, double* NORMS);
+
+//screened : the products of tiles with |ALPHA|*|A_ik|*|B_kj| < TOL are skipped
+template <typename T>
+double linal_ABpC_screen(const int M, const int N, const int K, const T ALPHA, T* A, const int LDA,
+                         T* B, const int LDB, const T BETA, T* C, const int LDC,
+                         const int TILE, const double* ANORM, const double* BNORM, const double TOL)
+{
+  const int MT = (M + TILE - 1)/TILE;
+  const int KT = (K + TILE - 1)/TILE;
+  const double alpha = (double) std::abs(ALPHA);
+  double skipped = 0;
+  for (int j0=0;j0<N;j0+=TILE)
+  {
+    const int nj = std::min(TILE,N-j0);
+    for (int i0=0;i0<M;i0+=TILE)
+    {
+      const int mi = std::min(TILE,M-i0);
+      T* CT = C + i0 + (long) LDC*j0;
+      bool first = true;
+      for (int k0=0;k0<K;k0+=TILE)
+      {
+        const double bound = alpha*ANORM[i0/TILE + (long) MT*(k0/TILE)]*BNORM[k0/TILE + (long) KT*(j0/TILE)];
+        if (bound < TOL) {skipped += bound; continue;}
+        linal_ABpC<T>(mi,nj,std::min(TILE,K-k0),ALPHA,A + i0 + (long) LDA*k0,LDA,
+                      B + k0 + (long) LDB*j0,LDB,first ? BETA : (T) 1,CT,LDC);
+        first = false;
+      }
+
+      //every product skipped, C = BETA*C
+      if (first)
+      {
+        for (int j=0;j<nj;j++)
+        {
+          if (BETA == (T) 0) {simd_inline_scal_set<T>(mi,(T) 0,CT + (long) LDC*j);}
+          else if (BETA != (T) 1) {simd_inline_scal_mul<T>(mi,BETA,CT + (long) LDC*j);}
+        }
+      }
+    }
+  }
+  return skipped;
+}
+template double linal_ABpC_screen<double>(const int M, const int N, const int K, const double ALPHA,
+                         double* A, const int LDA, double* B, const int LDB, const double BETA,
+                         double* C, const int LDC, const int TILE, const double* ANORM,
+                         const double* BNORM, const double TOL);
+template double linal_ABpC_screen<float>(const int M, const int N, const int K, const float ALPHA,
+                         float* A, const int LDA, float* B, const int LDB, const float BETA,
+                         float* C, const int LDC, const int TILE, const double* ANORM,
+                         const double* BNORM, const double TOL);
+template double linal_ABpC_screen<std::complex<double> >(const int M, const int N, const int K,
+                         const std::complex<double> ALPHA, std::complex<double>* A, const int LDA,
+                         std::complex<double>* B, const int LDB, const std::complex<double> BETA,
+                         std::complex<double>* C, const int LDC, const int TILE, const double* ANORM,
+                         const double* BNORM, const double TOL);
+template double linal_ABpC_screen<std::complex<float> >(const int M, const int N, const int K,
+                         const std::complex<float> ALPHA, std::complex<float>* A, const int LDA,
+                         std::complex<float>* B, const int LDB, const std::complex<float> BETA,
+                         std::complex<float>* C, const int LDC, const int TILE, const double* ANORM,
+                         const double* BNORM, const double TOL);
 /*
 template <typename T, const int ALIGN>
 void linal_ABpC(const int M,const int N,const int K,const T ALPHA, T* A, T* B,const T BETA, T* C)
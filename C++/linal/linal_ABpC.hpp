@@ -1,19 +1,49 @@
 /*------------------------------------------------
   linal_ABpC.hpp
         JHT, December 8, 2021 : created 
+        JHT, October 14, 2026 : leading dimensions
+        JHT, October 14, 2026 : block-norm screening
+        JHT, October 14, 2026 : Strassen-Winograd, opt-in
 
     C = ALPHA*A.B + BETA*C 
 
     It is assumed that C,A,and B are all 
     continous in memory and coloumn major. 
-    Logical dimension == physical dimension 
+    Logical dimension == physical dimension,
+    unless the leading dimensions LDA, LDB, and
+    LDC are given, as in BLAS (A is MxK, LDA >= M)
+
+    Also instantiated for std::complex<double>
+    and std::complex<float>
+
+    For double and float, linal_strassen_set(MIN)
+    makes the products with M, N, and K all at
+    least MIN use the Strassen-Winograd recursion
+    of linal_strassen.hpp (off by default)
+
+    Screened products
+      linal_tile_norms(M,N,TILE,A,LDA,NORMS)
+        NORMS(it,jt) = Frobenius norm of the
+        TILE x TILE tile (it,jt) of the MxN A,
+        NORMS is ceil(M/TILE) x ceil(N/TILE)
+      linal_ABpC_screen(M,N,K,...,LDC,TILE,
+                        ANORM,BNORM,TOL)
+        C = ALPHA*A.B + BETA*C a tile at a time,
+        skipping the tile products with
+        |ALPHA|*ANORM(i,k)*BNORM(k,j) < TOL.
+        Returns the sum of the skipped bounds,
+        which bounds the Frobenius norm of the
+        error in C. Keep the norms with A and B,
+        they only change when A and B do
 ------------------------------------------------*/
 #ifndef LINAL_ABPC_HPP
 #define LINAL_ABPC_HPP
 
 #include "simd.hpp"
 #include "linal_def.hpp"
+#include "linal_gemm.hpp"
 #include <math.h>
+#include <complex>
 
 template <typename T>
 void linal_ABpC(const int M, const int N, const int K,  
@@ -21,6 +51,20 @@ void linal_ABpC(const int M, const int N, const int K,
                 T* B,  const T BETA, 
                 T* C );
 
+template <typename T>
+void linal_ABpC(const int M, const int N, const int K,  
+                const T ALPHA, T* A, const int LDA,
+                T* B, const int LDB, const T BETA, 
+                T* C, const int LDC);
+
+template <typename T>
+void linal_tile_norms(const int M, const int N, const int TILE, const T* A, const int LDA, double* NORMS);
+
+template <typename T>
+double linal_ABpC_screen(const int M, const int N, const int K, const T ALPHA, T* A, const int LDA,
+                         T* B, const int LDB, const T BETA, T* C, const int LDC,
+                         const int TILE, const double* ANORM, const double* BNORM, const double TOL);
+
 /*
 template <typename T, const int ALIGN>
 void linal_ABpC(const int M, const int N, const int K,  
@@ -0,0 +1,97 @@
+/*-------------------------------------------------------------------------
+  linal_ATApU.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for ATApU, U = alpha*A^T.A + beta*U, where U is NxN upper
+  symmetric and stored packed, and A is KxN. See linal_ATApU.hpp
+
+  The blocked code does the columns of U in panels of width 
+  LINAL_ATAPU_NB. For the panel of cols j0:j1, only rows 0:j1 of U
+  are needed, so that
+
+    W(0:j1,0:nb) = alpha*A(:,0:j1)^T.A(:,j0:j1) 
+
+  is one linal_gemm call, of which the upper triangle is added into
+  the packed U. Only the diagonal blocks are done in full, which is
+  NB/N extra work. 
+-------------------------------------------------------------------------*/
+#include "linal_ATApU.hpp"
+#include <vector>
+#include <algorithm>
+
+#define LINAL_ATAPU_NB 64
+
+//unblocked code
+template <typename T>
+static void linal_ATApU_loops(const long N, const long K, const T ALPHA, const T* A,
+                              const T BETA, T* U)
+{
+  long uu = 0;
+  for (long j=0;j<N;j++)
+  {
+    const T* AJ = A + K*j;
+    for (long i=0;i<=j;i++)
+    {
+      const T TMP = ALPHA*simd_dot<T>(K,A+K*i,AJ);
+      *(U+uu) = (BETA == (T) 0) ? TMP : TMP + BETA * *(U+uu);
+      uu++;
+    }
+  }
+}
+
+//blocked code
+template <typename T>
+static void linal_ATApU_blocked(const long N, const long K, const T ALPHA, const T* A,
+                                const T BETA, T* U)
+{
+  const long NB = std::min((long) LINAL_ATAPU_NB,N);
+  std::vector<T> W(N*NB);
+
+  for (long j0=0;j0<N;j0+=NB)
+  {
+    const long nb = std::min(NB,N-j0);
+    const long j1 = j0 + nb;
+    linal_gemm<T>(true,j1,nb,K,ALPHA,A,A+K*j0,(T) 0,W.data());
+
+    for (long j=j0;j<j1;j++)
+    {
+      T* UJ = U + (j*(j+1))/2;
+      const T* WJ = W.data() + j1*(j-j0);
+      if (BETA == (T) 0)
+      {
+        simd_copy<T>(j+1,WJ,UJ);
+      } else {
+        simd_axpby<T>(j+1,(T) 1,WJ,BETA,UJ);
+      }
+    }
+  }
+}
+
+template <typename T>
+void linal_ATApU(const long N, const long K, const T ALPHA, const T* A,
+                 const T BETA, T* U)
+{
+  linal_ATApU_loops<T>(N,K,ALPHA,A,BETA,U);
+}
+
+//doubles and floats use the blocked code for the larger matrices
+template <>
+void linal_ATApU<double>(const long N, const long K, const double ALPHA, const double* A,
+                         const double BETA, double* U)
+{
+  if (N*N*K >= LINAL_GEMM_MNK) {linal_ATApU_blocked<double>(N,K,ALPHA,A,BETA,U);}
+  else {linal_ATApU_loops<double>(N,K,ALPHA,A,BETA,U);}
+}
+
+template <>
+void linal_ATApU<float>(const long N, const long K, const float ALPHA, const float* A,
+                        const float BETA, float* U)
+{
+  if (N*N*K >= LINAL_GEMM_MNK) {linal_ATApU_blocked<float>(N,K,ALPHA,A,BETA,U);}
+  else {linal_ATApU_loops<float>(N,K,ALPHA,A,BETA,U);}
+}
+
+template void linal_ATApU<long>(const long N, const long K, const long ALPHA, const long* A,
+                                const long BETA, long* U);
+template void linal_ATApU<int>(const long N, const long K, const int ALPHA, const int* A,
+                               const int BETA, int* U);
@@ -0,0 +1,42 @@
+/*-------------------------------------------------------------------------
+  linal_ATApU.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for ATApU, the symmetric rank-K update (SYRK) of a 
+  scaled, upper symmetric matrix U of size NxN by the product
+  of a KxN matrix A with its transpose
+
+     U = alpha*A^T.A + beta*U 
+
+  Only the upper triangle of U is stored (packed, by columns), and
+  only the upper triangle is computed, so this is half the work of
+  linal_ATBpC with B = A, and U is never expanded to a square matrix.
+
+  It is assumed that A and U are stored continously in memory, and
+  that A is stored column major.
+
+  For doubles and floats with N*N*K >= LINAL_GEMM_MNK, the upper
+  triangle is done in panels of columns of U through the blocked 
+  linal_gemm.
+
+Parameters
+name         type           size         description
+N            const long     1            rows and cols of U, cols of A
+K            const long     1            rows of A
+ALPHA        const T        1            constant to scale A^T.A by
+A            const T*       K*N          pointer to matrix A
+BETA         const T        1            constant to scale U by
+U            T*             (N*(N+1))/2  pointer to matrix U    
+-------------------------------------------------------------------------*/
+#ifndef LINAL_ATAPU_HPP
+#define LINAL_ATAPU_HPP
+
+#include "linal_def.hpp"
+#include "linal_gemm.hpp"
+#include "simd.hpp"
+
+template <typename T>
+void linal_ATApU(const long N, const long K, const T ALPHA, const T* A,
+                 const T BETA, T* U);
+
+#endif
@@ -1,12 +1,14 @@
 /*------------------------------------------------
   linal_ATBpC.cpp
         JHT, December 8, 2021 : created 
+        JHT, October 14, 2026 : leading dimensions
 
     C = alpha*A^T.B + beta*C  
 
     It is assumed that C,A,and B are all 
     continous in memory, and stored column 
-    major (logical dimension == physical dimension) 
+    major (logical dimension == physical dimension),
+    unless LDA, LDB, and LDC are given 
 ------------------------------------------------*/
 
 /* Variables
@@ -19,26 +21,29 @@ A	T*	pointer to A
 B	T*	pointer to B
 BETA	T	constant to scale C by
 C	T*	pointer to C 
+LDA	int	leading dimension of A, >= K
+LDB	int	leading dimension of B, >= K
+LDC	int	leading dimension of C, >= M
 
 */
 #include "linal_ATBpC.hpp"
 
-//unaligned code
+//unaligned code, one column (dot) at a time
 template <typename T>
-void linal_ATBpC(const int M, const int N, const int K, const T ALPHA, T* A, T* B, const T BETA, T* C)
+static void linal_ATBpC_cols(const int M, const int N, const int K, const T ALPHA, T* A, const long LDA, 
+                             T* B, const long LDB, const T BETA, T* C, const long LDC)
 {
-  long cc = 0;
   //BETA is zero, ALPHA is one (a common case)
-  if (fabs((double)ALPHA - (double) 1) < DZTOL
-   && fabs((double) BETA) < DZTOL)
+  if (std::abs(ALPHA - (T) 1) < DZTOL
+   && std::abs(BETA) < DZTOL)
   {
     for (auto J=0;J<N;J++)
     {
       for (auto I=0;I<M;I++)
       {
+        const long cc = I+LDC*J;
 
-        *(C+cc) = simd_dot<T>(K,(A+K*I),(B+K*J));
-        cc++; 
+        *(C+cc) = simd_dot<T>(K,(A+LDA*I),(B+LDB*J));
 
       } //loop over I
     } //loop over J
@@ -48,9 +53,9 @@ void linal_ATBpC(const int M, const int N, const int K, const T ALPHA, T* A, T*
     {
       for (auto I=0;I<M;I++)
       {
+        const long cc = I+LDC*J;
 
-        *(C+cc) = BETA * *(C+cc) + ALPHA*simd_dot<T>(K,(A+K*I),(B+K*J)); 
-        cc++; 
+        *(C+cc) = BETA * *(C+cc) + ALPHA*simd_dot<T>(K,(A+LDA*I),(B+LDB*J)); 
 
       } //loop over I
     } //loop over J
@@ -58,14 +63,72 @@ void linal_ATBpC(const int M, const int N, const int K, const T ALPHA, T* A, T*
   }//end if statements 
 }
 
-template void linal_ATBpC<double>(const int M,const int N,const int K,const double ALPHA, double* A, 
-                                double* B,const double BETA, double* C);
-template void linal_ATBpC<float>(const int M,const int N,const int K,const float ALPHA, float* A, 
-                                float* B,const float BETA, float* C);
+template <typename T>
+void linal_ATBpC(const int M, const int N, const int K, const T ALPHA, T* A, T* B, const T BETA, T* C)
+{
+  linal_ATBpC_cols<T>(M,N,K,ALPHA,A,K,B,K,BETA,C,M);
+}
+
+//doubles and floats use the blocked code for the larger matrices
+template <>
+void linal_ATBpC<double>(const int M, const int N, const int K, const double ALPHA, double* A, double* B, 
+                    const double BETA, double* C)
+{
+  if ((long) M*N*K >= LINAL_GEMM_MNK) {linal_gemm<double>(true,M,N,K,ALPHA,A,B,BETA,C);}
+  else {linal_ATBpC_cols<double>(M,N,K,ALPHA,A,K,B,K,BETA,C,M);}
+}
+
+template <>
+void linal_ATBpC<float>(const int M, const int N, const int K, const float ALPHA, float* A, float* B, 
+                   const float BETA, float* C)
+{
+  if ((long) M*N*K >= LINAL_GEMM_MNK) {linal_gemm<float>(true,M,N,K,ALPHA,A,B,BETA,C);}
+  else {linal_ATBpC_cols<float>(M,N,K,ALPHA,A,K,B,K,BETA,C,M);}
+}
+
 template void linal_ATBpC<long>(const int M,const int N,const int K,const long ALPHA, long* A, 
                                 long* B,const long BETA, long* C);
 template void linal_ATBpC<int>(const int M,const int N,const int K,const int ALPHA, int* A, 
                                 int* B,const int BETA, int* C);
+template void linal_ATBpC<std::complex<double> >(const int M,const int N,const int K,const std::complex<double> ALPHA, 
+                                std::complex<double>* A, std::complex<double>* B,const std::complex<double> BETA, 
+                                std::complex<double>* C);
+template void linal_ATBpC<std::complex<float> >(const int M,const int N,const int K,const std::complex<float> ALPHA, 
+                                std::complex<float>* A, std::complex<float>* B,const std::complex<float> BETA, 
+                                std::complex<float>* C);
+
+//with leading dimensions
+template <typename T>
+void linal_ATBpC(const int M, const int N, const int K, const T ALPHA, T* A, const int LDA,
+                 T* B, const int LDB, const T BETA, T* C, const int LDC)
+{
+  linal_ATBpC_cols<T>(M,N,K,ALPHA,A,LDA,B,LDB,BETA,C,LDC);
+}
+
+template <>
+void linal_ATBpC<double>(const int M, const int N, const int K, const double ALPHA, double* A, const int LDA,
+                         double* B, const int LDB, const double BETA, double* C, const int LDC)
+{
+  if ((long) M*N*K >= LINAL_GEMM_MNK) {linal_gemm<double>(true,M,N,K,ALPHA,A,LDA,B,LDB,BETA,C,LDC);}
+  else {linal_ATBpC_cols<double>(M,N,K,ALPHA,A,LDA,B,LDB,BETA,C,LDC);}
+}
+
+template <>
+void linal_ATBpC<float>(const int M, const int N, const int K, const float ALPHA, float* A, const int LDA,
+                        float* B, const int LDB, const float BETA, float* C, const int LDC)
+{
+  if ((long) M*N*K >= LINAL_GEMM_MNK) {linal_gemm<float>(true,M,N,K,ALPHA,A,LDA,B,LDB,BETA,C,LDC);}
+  else {linal_ATBpC_cols<float>(M,N,K,ALPHA,A,LDA,B,LDB,BETA,C,LDC);}
+}
+
+template void linal_ATBpC<long>(const int M,const int N,const int K,const long ALPHA, long* A, const int LDA,
+                                long* B, const int LDB, const long BETA, long* C, const int LDC);
+template void linal_ATBpC<int>(const int M,const int N,const int K,const int ALPHA, int* A, const int LDA,
+                                int* B, const int LDB, const int BETA, int* C, const int LDC);
+template void linal_ATBpC<std::complex<double> >(const int M,const int N,const int K,const std::complex<double> ALPHA, std::complex<double>* A, const int LDA,
+                                std::complex<double>* B, const int LDB, const std::complex<double> BETA, std::complex<double>* C, const int LDC);
+template void linal_ATBpC<std::complex<float> >(const int M,const int N,const int K,const std::complex<float> ALPHA, std::complex<float>* A, const int LDA,
+                                std::complex<float>* B, const int LDB, const std::complex<float> BETA, std::complex<float>* C, const int LDC);
 
 /*
 template <typename T, const int ALIGN>
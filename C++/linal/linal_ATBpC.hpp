@@ -1,25 +1,41 @@
 /*------------------------------------------------
   linal_ATBpC.hpp
         JHT, December 8, 2021 : created 
+        JHT, October 14, 2026 : leading dimensions
 
     C = ALPHA*A^T.B + BETA*C 
 
     It is assumed that C,A,and B are all 
     continous in memory and coloumn major. 
-    Logical dimension == physical dimension 
+    Logical dimension == physical dimension,
+    unless the leading dimensions LDA, LDB, and
+    LDC are given, as in BLAS (A^T is KxM, LDA >= K)
+
+    Also instantiated for std::complex<double>
+    and std::complex<float> (A^T is not
+    conjugated)
 ------------------------------------------------*/
 #ifndef LINAL_ATBPC_HPP
 #define LINAL_ATBPC_HPP
 
 #include "simd.hpp"
 #include "linal_def.hpp"
+#include "linal_gemm.hpp"
 #include <math.h>
+#include <complex>
 
 template <typename T>
 void linal_ATBpC(const int M, const int N, const int K,  
                  const T ALPHA, T* A, T* B, const T BETA, 
                  T* C);
 
+
+template <typename T>
+void linal_ATBpC(const int M, const int N, const int K,  
+                 const T ALPHA, T* A, const int LDA,
+                 T* B, const int LDB, const T BETA, 
+                 T* C, const int LDC);
+
 /*
 template <typename T, const int ALIGN>
 void linal_ATBpC(const int M, const int N, const int K,  
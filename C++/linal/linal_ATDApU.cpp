@@ -24,12 +24,26 @@ D       const T*        D diagonal elements (N)
 BETA    const T         beta constant to multiply U
 U       T*              U upper triangular elements (M*(M+1)/2) 
 
+  For doubles and floats with M*M*N >= LINAL_GEMM_MNK, U is done in
+  panels of LINAL_ATDAPU_NB columns. For the panel of cols j0:j1
+
+    W(0:j1,0:nb) = alpha*A(:,0:j1)^T.D.A(:,j0:j1) 
+
+  is one linal_gemm_diag call, which scales A^T by D as it is packed,
+  and only the upper triangle of W is added into U. 
+
 
 ------------------------------------------------------------*/
 #include "linal_ATDApU.hpp"
+#include "linal_gemm.hpp"
+#include <vector>
+#include <algorithm>
+
+#define LINAL_ATDAPU_NB 64
 
+//unblocked code
 template<typename T>
-void linal_ATDApU(const long M, const long N, const T* A, const T ALPHA, const T* D, const T BETA, T* U)
+static void linal_ATDApU_loops(const long M, const long N, const T* A, const T ALPHA, const T* D, const T BETA, T* U)
 {
   const T* AP;
   T* UP;
@@ -70,14 +84,61 @@ void linal_ATDApU(const long M, const long N, const T* A, const T ALPHA, const T
       UP = U+(j*(j+1))/2;
       for (long i=0;i<=j;i++)
       {
-        *(UP+i) = simd_dotwxy<T>(N,A+N*i,D,AP) + BETA**(UP+i); 
+        *(UP+i) = ALPHA*simd_dotwxy<T>(N,A+N*i,D,AP) + BETA**(UP+i); 
       }
     }
   }
 
 }
-template void linal_ATDApU<double>(const long M, const long N, const double* A, const double ALPHA, const double* D, const double BETA, double* U);
-template void linal_ATDApU<float>(const long M, const long N, const float* A, const float ALPHA, const float* D, const float BETA, float* U);
+
+//blocked code
+template<typename T>
+static void linal_ATDApU_blocked(const long M, const long N, const T* A, const T ALPHA, const T* D, const T BETA, T* U)
+{
+  const long NB = std::min((long) LINAL_ATDAPU_NB,M);
+  std::vector<T> W(M*NB);
+
+  for (long j0=0;j0<M;j0+=NB)
+  {
+    const long nb = std::min(NB,M-j0);
+    const long j1 = j0 + nb;
+    linal_gemm_diag<T>(true,j1,nb,N,ALPHA,A,D,A+N*j0,(T) 0,W.data());
+
+    for (long j=j0;j<j1;j++)
+    {
+      T* UJ = U + (j*(j+1))/2;
+      const T* WJ = W.data() + j1*(j-j0);
+      if (BETA == (T) 0)
+      {
+        simd_copy<T>(j+1,WJ,UJ);
+      } else {
+        simd_axpby<T>(j+1,(T) 1,WJ,BETA,UJ);
+      }
+    }
+  }
+}
+
+template<typename T>
+void linal_ATDApU(const long M, const long N, const T* A, const T ALPHA, const T* D, const T BETA, T* U)
+{
+  linal_ATDApU_loops<T>(M,N,A,ALPHA,D,BETA,U);
+}
+
+//doubles and floats use the blocked code for the larger matrices
+template<>
+void linal_ATDApU<double>(const long M, const long N, const double* A, const double ALPHA, const double* D, const double BETA, double* U)
+{
+  if (M*M*N >= LINAL_GEMM_MNK) {linal_ATDApU_blocked<double>(M,N,A,ALPHA,D,BETA,U);}
+  else {linal_ATDApU_loops<double>(M,N,A,ALPHA,D,BETA,U);}
+}
+
+template<>
+void linal_ATDApU<float>(const long M, const long N, const float* A, const float ALPHA, const float* D, const float BETA, float* U)
+{
+  if (M*M*N >= LINAL_GEMM_MNK) {linal_ATDApU_blocked<float>(M,N,A,ALPHA,D,BETA,U);}
+  else {linal_ATDApU_loops<float>(M,N,A,ALPHA,D,BETA,U);}
+}
+
 template void linal_ATDApU<long>(const long M, const long N, const long* A, const long ALPHA, const long* D, const long BETA, long* U);
 template void linal_ATDApU<int>(const long M, const long N, const int* A, const int ALPHA, const int* D, const int BETA, int* U);
 
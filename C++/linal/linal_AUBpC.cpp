@@ -28,8 +28,9 @@ This algorithm proceeds by constructing the intermediate elements of U.B,
   C(i,j) = sum_k A(i,k)*I(k,j)
   I(k,j) = sum_l U(k,l)*B(l,j)
 
-This could be improved by blocking, but we will do this at
-a later date
+For doubles and floats with L*L*(cols of B) >= LINAL_GEMM_MNK,
+I = U.B is instead built with the blocked linal_gemm_usym, and
+A is applied with linal_gemm
 
 Parameters:
 M       const long      rows of A,C
@@ -45,10 +46,12 @@ C*      T*              pointer to C
 
 -----------------------------------------------------------*/
 #include "linal_AUBpC.hpp"
+#include <vector>
 #include <stdio.h>
 
+//unblocked code
 template <typename T>
-void linal_AUBpC(const long M, const long N, const long L, const T ALPHA, 
+static void linal_AUBpC_loops(const long M, const long N, const long L, const T ALPHA, 
                   const T* A, const T* U, const T* B,
                   const T BETA, T* C)
 {
@@ -168,8 +171,38 @@ void linal_AUBpC(const long M, const long N, const long L, const T ALPHA,
 
 }
 
-template void linal_AUBpC<double>(const long M, const long N, const long L, const double ALPHA, const double* A, const double* U, const double* B, const double BETA, double* C);
-template void linal_AUBpC<float>(const long M, const long N, const long L, const float ALPHA, const float* A, const float* U, const float* B, const float BETA, float* C);
+//blocked code, I = U.B then C = ALPHA*A.I + BETA*C
+template <typename T>
+static void linal_AUBpC_blocked(const long M, const long N, const long L, const T ALPHA, 
+                                const T* A, const T* U, const T* B,
+                                const T BETA, T* C)
+{
+  std::vector<T> I(L*N);
+  linal_gemm_usym<T>(L,N,(T) 1,U,B,(T) 0,I.data());
+  linal_gemm<T>(false,(int) M,(int) N,(int) L,ALPHA,A,I.data(),BETA,C);
+}
+
+template <typename T>
+void linal_AUBpC(const long M, const long N, const long L, const T ALPHA, const T* A, const T* U, const T* B, const T BETA, T* C)
+{
+  linal_AUBpC_loops<T>(M,N,L,ALPHA,A,U,B,BETA,C);
+}
+
+//doubles and floats use the blocked code for the larger matrices
+template <>
+void linal_AUBpC<double>(const long M, const long N, const long L, const double ALPHA, const double* A, const double* U, const double* B, const double BETA, double* C)
+{
+  if (L*L*N >= LINAL_GEMM_MNK) {linal_AUBpC_blocked<double>(M,N,L,ALPHA,A,U,B,BETA,C);}
+  else {linal_AUBpC_loops<double>(M,N,L,ALPHA,A,U,B,BETA,C);}
+}
+
+template <>
+void linal_AUBpC<float>(const long M, const long N, const long L, const float ALPHA, const float* A, const float* U, const float* B, const float BETA, float* C)
+{
+  if (L*L*N >= LINAL_GEMM_MNK) {linal_AUBpC_blocked<float>(M,N,L,ALPHA,A,U,B,BETA,C);}
+  else {linal_AUBpC_loops<float>(M,N,L,ALPHA,A,U,B,BETA,C);}
+}
+
 template void linal_AUBpC<long>(const long M, const long N, const long L, const long ALPHA, const long* A, const long* U, const long* B, const long BETA, long* C);
 template void linal_AUBpC<int>(const long M, const long N, const long L, const int ALPHA, const int* A, const int* U, const int* B, const int BETA, int* C);
 
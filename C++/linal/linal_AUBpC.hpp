@@ -43,6 +43,7 @@ C*	T*		pointer to C
 
 #include "simd.hpp"
 #include "linal_def.hpp"
+#include "linal_gemm.hpp"
 #include <math.h>
 
 template <typename T>
@@ -35,8 +35,9 @@ This algorithm proceeds by constructing the intermediate elements of U.B,
   D(j,j) = sum_k A(i,k)*I(k,j)
   I(k,j) = sum_l U(k,l)*B(l,j)
 
-This could be improved by blocking, but we will do this at
-a later date
+For doubles and floats with L*L*(cols of B) >= LINAL_GEMM_MNK,
+I = U.B is instead built with the blocked linal_gemm_usym, and
+A is applied with linal_gemm
 
 Parameters:
 M       const long      rows of A,D, cols of B
@@ -51,10 +52,12 @@ D*      T*              pointer to D
 
 -----------------------------------------------------------*/
 #include "linal_AUBpD.hpp"
+#include <vector>
 #include <stdio.h>
 
+//unblocked code
 template <typename T>
-void linal_AUBpD(const long M, const long L, const T ALPHA, 
+static void linal_AUBpD_loops(const long M, const long L, const T ALPHA, 
                   const T* A, const T* U, const T* B,
                   const T BETA, T* D)
 {
@@ -174,8 +177,42 @@ void linal_AUBpD(const long M, const long L, const T ALPHA,
 
 }
 
-template void linal_AUBpD<double>(const long M, const long L, const double ALPHA, const double* A, const double* U, const double* B, const double BETA, double* D);
-template void linal_AUBpD<float>(const long M, const long L, const float ALPHA, const float* A, const float* U, const float* B, const float BETA, float* D);
+//blocked code, I = U.B then D(j) = ALPHA*A(j,:).I(:,j) + BETA*D(j)
+template <typename T>
+static void linal_AUBpD_blocked(const long M, const long L, const T ALPHA, 
+                                const T* A, const T* U, const T* B,
+                                const T BETA, T* D)
+{
+  std::vector<T> I(L*M);
+  linal_gemm_usym<T>(L,M,(T) 1,U,B,(T) 0,I.data());
+  for (long j=0;j<M;j++)
+  {
+    const T TMP = ALPHA*simd_dot_strided<T>(L,A+j,M,I.data()+L*j,1);
+    *(D+j) = (BETA == (T) 0) ? TMP : TMP + BETA * *(D+j);
+  }
+}
+
+template <typename T>
+void linal_AUBpD(const long M, const long L, const T ALPHA, const T* A, const T* U, const T* B, const T BETA, T* D)
+{
+  linal_AUBpD_loops<T>(M,L,ALPHA,A,U,B,BETA,D);
+}
+
+//doubles and floats use the blocked code for the larger matrices
+template <>
+void linal_AUBpD<double>(const long M, const long L, const double ALPHA, const double* A, const double* U, const double* B, const double BETA, double* D)
+{
+  if (L*L*M >= LINAL_GEMM_MNK) {linal_AUBpD_blocked<double>(M,L,ALPHA,A,U,B,BETA,D);}
+  else {linal_AUBpD_loops<double>(M,L,ALPHA,A,U,B,BETA,D);}
+}
+
+template <>
+void linal_AUBpD<float>(const long M, const long L, const float ALPHA, const float* A, const float* U, const float* B, const float BETA, float* D)
+{
+  if (L*L*M >= LINAL_GEMM_MNK) {linal_AUBpD_blocked<float>(M,L,ALPHA,A,U,B,BETA,D);}
+  else {linal_AUBpD_loops<float>(M,L,ALPHA,A,U,B,BETA,D);}
+}
+
 template void linal_AUBpD<long>(const long M, const long L, const long ALPHA, const long* A, const long* U, const long* B, const long BETA, long* D);
 template void linal_AUBpD<int>(const long M, const long L, const int ALPHA, const int* A, const int* U, const int* B, const int BETA, int* D);
 
@@ -51,6 +51,7 @@ D*      T*              pointer to D
 
 -----------------------------------------------------------*/
 #include "linal_def.hpp"
+#include "linal_gemm.hpp"
 #include "simd.hpp"
 #include <math.h>
 
@@ -29,8 +29,9 @@ This algorithm proceeds by constructing the intermediate elements of U.B,
   Y(i,j) = sum_k A(i,k)*I(k,j)
   I(k,j) = sum_l U(k,l)*B(l,j)
 
-This could be improved by blocking, but we will do this at
-a later date
+For doubles and floats with L*L*(cols of B) >= LINAL_GEMM_MNK,
+I = U.B is instead built with the blocked linal_gemm_usym, and
+A is applied with linal_gemm
 
 Parameters:
 M       const long      rows of A,Y, cols of B
@@ -45,10 +46,12 @@ Y*      T*              pointer to Y
 
 -----------------------------------------------------------*/
 #include "linal_AUBpY.hpp"
+#include <vector>
 #include <stdio.h>
 
+//unblocked code
 template <typename T>
-void linal_AUBpY(const long M, const long L, const T ALPHA, 
+static void linal_AUBpY_loops(const long M, const long L, const T ALPHA, 
                   const T* A, const T* U, const T* B,
                   const T BETA, T* Y)
 {
@@ -168,8 +171,47 @@ void linal_AUBpY(const long M, const long L, const T ALPHA,
 
 }
 
-template void linal_AUBpY<double>(const long M, const long L, const double ALPHA, const double* A, const double* U, const double* B, const double BETA, double* Y);
-template void linal_AUBpY<float>(const long M, const long L, const float ALPHA, const float* A, const float* U, const float* B, const float BETA, float* Y);
+//blocked code, I = U.B, W = ALPHA*A.I, then the upper triangle 
+// of W is added to Y. This does the full MxM W, but at GEMM speed
+template <typename T>
+static void linal_AUBpY_blocked(const long M, const long L, const T ALPHA, 
+                                const T* A, const T* U, const T* B,
+                                const T BETA, T* Y)
+{
+  std::vector<T> I(L*M);
+  std::vector<T> W(M*M);
+  linal_gemm_usym<T>(L,M,(T) 1,U,B,(T) 0,I.data());
+  linal_gemm<T>(false,(int) M,(int) M,(int) L,ALPHA,A,I.data(),(T) 0,W.data());
+  for (long j=0;j<M;j++)
+  {
+    T* YP = Y + (j*(j+1))/2;
+    const T* WP = W.data() + M*j;
+    if (BETA == (T) 0) {simd_copy<T>(j+1,WP,YP);}
+    else {simd_axpby<T>(j+1,(T) 1,WP,BETA,YP);}
+  }
+}
+
+template <typename T>
+void linal_AUBpY(const long M, const long L, const T ALPHA, const T* A, const T* U, const T* B, const T BETA, T* Y)
+{
+  linal_AUBpY_loops<T>(M,L,ALPHA,A,U,B,BETA,Y);
+}
+
+//doubles and floats use the blocked code for the larger matrices
+template <>
+void linal_AUBpY<double>(const long M, const long L, const double ALPHA, const double* A, const double* U, const double* B, const double BETA, double* Y)
+{
+  if (L*L*M >= LINAL_GEMM_MNK) {linal_AUBpY_blocked<double>(M,L,ALPHA,A,U,B,BETA,Y);}
+  else {linal_AUBpY_loops<double>(M,L,ALPHA,A,U,B,BETA,Y);}
+}
+
+template <>
+void linal_AUBpY<float>(const long M, const long L, const float ALPHA, const float* A, const float* U, const float* B, const float BETA, float* Y)
+{
+  if (L*L*M >= LINAL_GEMM_MNK) {linal_AUBpY_blocked<float>(M,L,ALPHA,A,U,B,BETA,Y);}
+  else {linal_AUBpY_loops<float>(M,L,ALPHA,A,U,B,BETA,Y);}
+}
+
 template void linal_AUBpY<long>(const long M, const long L, const long ALPHA, const long* A, const long* U, const long* B, const long BETA, long* Y);
 template void linal_AUBpY<int>(const long M, const long L, const int ALPHA, const int* A, const int* U, const int* B, const int BETA, int* Y);
 
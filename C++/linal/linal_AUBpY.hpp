@@ -47,6 +47,7 @@ Y*      T*              pointer to Y
 
 #include "simd.hpp"
 #include "linal_def.hpp"
+#include "linal_gemm.hpp"
 #include <math.h>
 
 template <typename T>
@@ -36,14 +36,17 @@ void linal_DApB(const long M, const long N, const T ALPHA, const T* D, const T*
       B+=M;
     }
 
-  //D and B need to be scaled
+  //D and B need to be scaled, a column at a time so B stays in cache
   } else {
     for (long j=0;j<N;j++)
     {
-      //this should probably be put in SIMD form...
-      for (long i=0;i<M;i++)
+      if (BETA == (T) 0)
       {
-        *(B+i) = ALPHA**(D+i)**(A+i) + BETA**(B+i);
+        simd_elemwise_mul<T>(M,D,A,B);
+        simd_scal_mul<T>(M,ALPHA,B);
+      } else {
+        if (BETA != (T) 1) simd_scal_mul<T>(M,BETA,B);
+        simd_awxpy<T>(M,ALPHA,D,A,B);
       }
       A+=M;
       B+=M;
@@ -9,6 +9,9 @@
   It is assumes that U,A, and B are stored continously in memory, and
   that only the upper symmetric parts of U are stored
 
+  For doubles and floats with M*M*N >= LINAL_GEMM_MNK, this calls
+  the blocked linal_gemm_usym
+
      B = (a*U).B + (b*B) 
                   M                N                      N
    (           _______   )       _____        (         _____  )
@@ -29,8 +32,9 @@ B            T*             M*N          pointer to matrix B
 -------------------------------------------------------------------------*/
 #include "linal_UApB.hpp"
 
+//unblocked code
 template <typename T>
-void linal_UApB(const long M, const long N, const T ALPHA, const T* U, 
+static void linal_UApB_loops(const long M, const long N, const T ALPHA, const T* U, 
                 const T* A,const T BETA, T* B)
 {
   T TMP;
@@ -129,8 +133,27 @@ void linal_UApB(const long M, const long N, const T ALPHA, const T* U,
 
 
 }
-template void linal_UApB<double>(const long M, const long N, const double ALPHA, const double* U, const double* A, const double BETA, double* B);
-template void linal_UApB<float>(const long M, const long N, const float ALPHA, const float* U, const float* A, const float BETA, float* B);
+template <typename T>
+void linal_UApB(const long M, const long N, const T ALPHA, const T* U, const T* A, const T BETA, T* B)
+{
+  linal_UApB_loops<T>(M,N,ALPHA,U,A,BETA,B);
+}
+
+//doubles and floats use the blocked code for the larger matrices
+template <>
+void linal_UApB<double>(const long M, const long N, const double ALPHA, const double* U, const double* A, const double BETA, double* B)
+{
+  if (M*M*N >= LINAL_GEMM_MNK) {linal_gemm_usym<double>(M,N,ALPHA,U,A,BETA,B);}
+  else {linal_UApB_loops<double>(M,N,ALPHA,U,A,BETA,B);}
+}
+
+template <>
+void linal_UApB<float>(const long M, const long N, const float ALPHA, const float* U, const float* A, const float BETA, float* B)
+{
+  if (M*M*N >= LINAL_GEMM_MNK) {linal_gemm_usym<float>(M,N,ALPHA,U,A,BETA,B);}
+  else {linal_UApB_loops<float>(M,N,ALPHA,U,A,BETA,B);}
+}
+
 template void linal_UApB<long>(const long M, const long N, const long ALPHA, const long* U, const long* A, const long BETA, long* B);
 template void linal_UApB<int>(const long M, const long N, const int ALPHA, const int* U, const int* A, const int BETA, int* B);
 
@@ -31,6 +31,7 @@ B            T*             M*N          pointer to matrix B
 #define LINAL_UAPB_HPP
 
 #include "linal_def.hpp"
+#include "linal_gemm.hpp"
 #include "simd.hpp"
 #include <math.h>
 
@@ -0,0 +1,44 @@
+/*-----------------------------------------------------------
+  linal_Uxpy.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for Uxpy, y = alpha*U.x + beta*y, where U is
+  NxN upper symmetric and stored packed (upper triangle
+  only). See linal_Uxpy.hpp
+
+  Column j of U holds U(0:j,j), which is both the upper
+  part of col j and (by symmetry) the lower part of row j,
+  so that one pass over U gives
+
+    y(0:j-1) += alpha*x(j)*U(0:j-1,j)	(axpy)
+    y(j)     += alpha*U(0:j,j).x(0:j)	(dot)
+-----------------------------------------------------------*/
+#include "linal_Uxpy.hpp"
+
+template <typename T>
+void linal_Uxpy(const long N, const T ALPHA, const T* U, const T* x,
+                const T BETA, T* y)
+{
+  if (BETA == (T) 0)
+  {
+    simd_zero<T>(N,y);
+  } else if (BETA != (T) 1) {
+    simd_scal_mul<T>(N,BETA,y);
+  }
+
+  for (long j=0;j<N;j++)
+  {
+    const T* UU = U + (j*(j+1))/2;
+    simd_axpy<T>(j,ALPHA * *(x+j),UU,y);
+    *(y+j) += ALPHA*simd_dot<T>(j+1,UU,x);
+  }
+}
+
+template void linal_Uxpy<double>(const long N, const double ALPHA, const double* U,
+                                 const double* x, const double BETA, double* y);
+template void linal_Uxpy<float>(const long N, const float ALPHA, const float* U,
+                                const float* x, const float BETA, float* y);
+template void linal_Uxpy<long>(const long N, const long ALPHA, const long* U,
+                               const long* x, const long BETA, long* y);
+template void linal_Uxpy<int>(const long N, const int ALPHA, const int* U,
+                              const int* x, const int BETA, int* y);
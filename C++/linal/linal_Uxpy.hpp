@@ -0,0 +1,43 @@
+/*-----------------------------------------------------------
+  linal_Uxpy.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for Uxpy, which multiplies an NxN upper 
+  symmetric matrix U (which may be scaled) by an N vector
+  x, and adds the result to a (scaled) N vector y 
+  **IN PLACE** 
+
+  y = alpha*U.x + beta*y
+
+  Only the upper triangle of U is stored (packed, by
+  columns, as in linal_AUxpy), and it is used as is,
+  without expanding it to the full square with
+  linal_usym2v. Each column of U is read once, for both
+  the part above the diagonal and its transpose.
+  
+            U         x                y
+         ________    ___              ___
+        \ 0 1 3 |   | 0 |            | 0 |
+alpha*    \ 2 4 |   | . |  += beta * | . |
+            \ 5 |   | . |            | . |
+             ---  .  ---              ---
+
+Parameters:
+N	const long	rows and cols of U, length of x,y
+ALPHA	const T		value to scale U with
+U*	const T*   	pointer to U
+x*	const T*	pointer to x
+BETA	const T		value to scale y with
+y*	T*		pointer to y
+-----------------------------------------------------------*/
+#ifndef LINAL_UXPY_HPP
+#define LINAL_UXPY_HPP
+
+#include "simd.hpp"
+#include "linal_def.hpp"
+
+template <typename T>
+void linal_Uxpy(const long N, const T ALPHA, const T* U, const T* x,
+                const T BETA, T* y);
+
+#endif
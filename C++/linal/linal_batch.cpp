@@ -0,0 +1,319 @@
+/*----------------------------------------------------------------
+  linal_batch.cpp
+	JHT, October 14, 2026 : created
+
+  Batched versions of the small matrix routines, see
+  linal_batch.hpp
+
+  Each routine is written once as a "lane" kernel on the
+  register type S, which is done on W matrices at once.
+  linal_batch_vec<T> is the widest register available
+  (__m512d/__m512 with AVX-512, __m256d/__m256 with AVX2), and
+  linal_batch_sca<T> is a single matrix, which is used for the
+  leftover NB % W matrices and for the integer types.
+
+  The loads and stores are unaligned, so NB need not be a
+  multiple of W, but if NB is a multiple of W and the arrays
+  are aligned, every access is aligned.
+-----------------------------------------------------------------*/
+#include "linal_batch.hpp"
+
+#if defined (__AVX2__)
+#include <immintrin.h>
+#endif
+
+//------------------------------------------------
+// one matrix at a time
+template <typename T>
+struct linal_batch_sca
+{
+  typedef T V;
+  static const long W = 1;
+  static inline V loadu(const T* p) {return *p;}
+  static inline void storeu(T* p, const V a) {*p = a;}
+  static inline V set1(const T a) {return a;}
+  static inline V add(const V a, const V b) {return a + b;}
+  static inline V sub(const V a, const V b) {return a - b;}
+  static inline V mul(const V a, const V b) {return a * b;}
+  static inline V div(const V a, const V b) {return a / b;}
+  static inline V fmadd(const V a, const V b, const V c) {return a * b + c;}
+};
+
+//------------------------------------------------
+// W matrices at a time. The integer types stay scalar
+template <typename T>
+struct linal_batch_vec : linal_batch_sca<T> {};
+
+#if defined (__AVX512F__)
+template <>
+struct linal_batch_vec<double>
+{
+  typedef __m512d V;
+  static const long W = 8;
+  static inline V loadu(const double* p) {return _mm512_loadu_pd(p);}
+  static inline void storeu(double* p, const V a) {_mm512_storeu_pd(p,a);}
+  static inline V set1(const double a) {return _mm512_set1_pd(a);}
+  static inline V add(const V a, const V b) {return _mm512_add_pd(a,b);}
+  static inline V sub(const V a, const V b) {return _mm512_sub_pd(a,b);}
+  static inline V mul(const V a, const V b) {return _mm512_mul_pd(a,b);}
+  static inline V div(const V a, const V b) {return _mm512_div_pd(a,b);}
+  static inline V fmadd(const V a, const V b, const V c) {return _mm512_fmadd_pd(a,b,c);}
+};
+
+template <>
+struct linal_batch_vec<float>
+{
+  typedef __m512 V;
+  static const long W = 16;
+  static inline V loadu(const float* p) {return _mm512_loadu_ps(p);}
+  static inline void storeu(float* p, const V a) {_mm512_storeu_ps(p,a);}
+  static inline V set1(const float a) {return _mm512_set1_ps(a);}
+  static inline V add(const V a, const V b) {return _mm512_add_ps(a,b);}
+  static inline V sub(const V a, const V b) {return _mm512_sub_ps(a,b);}
+  static inline V mul(const V a, const V b) {return _mm512_mul_ps(a,b);}
+  static inline V div(const V a, const V b) {return _mm512_div_ps(a,b);}
+  static inline V fmadd(const V a, const V b, const V c) {return _mm512_fmadd_ps(a,b,c);}
+};
+#elif defined (__AVX2__)
+template <>
+struct linal_batch_vec<double>
+{
+  typedef __m256d V;
+  static const long W = 4;
+  static inline V loadu(const double* p) {return _mm256_loadu_pd(p);}
+  static inline void storeu(double* p, const V a) {_mm256_storeu_pd(p,a);}
+  static inline V set1(const double a) {return _mm256_set1_pd(a);}
+  static inline V add(const V a, const V b) {return _mm256_add_pd(a,b);}
+  static inline V sub(const V a, const V b) {return _mm256_sub_pd(a,b);}
+  static inline V mul(const V a, const V b) {return _mm256_mul_pd(a,b);}
+  static inline V div(const V a, const V b) {return _mm256_div_pd(a,b);}
+  static inline V fmadd(const V a, const V b, const V c)
+  {
+    #if defined (__FMA__)
+      return _mm256_fmadd_pd(a,b,c);
+    #else
+      return _mm256_add_pd(_mm256_mul_pd(a,b),c);
+    #endif
+  }
+};
+
+template <>
+struct linal_batch_vec<float>
+{
+  typedef __m256 V;
+  static const long W = 8;
+  static inline V loadu(const float* p) {return _mm256_loadu_ps(p);}
+  static inline void storeu(float* p, const V a) {_mm256_storeu_ps(p,a);}
+  static inline V set1(const float a) {return _mm256_set1_ps(a);}
+  static inline V add(const V a, const V b) {return _mm256_add_ps(a,b);}
+  static inline V sub(const V a, const V b) {return _mm256_sub_ps(a,b);}
+  static inline V mul(const V a, const V b) {return _mm256_mul_ps(a,b);}
+  static inline V div(const V a, const V b) {return _mm256_div_ps(a,b);}
+  static inline V fmadd(const V a, const V b, const V c)
+  {
+    #if defined (__FMA__)
+      return _mm256_fmadd_ps(a,b,c);
+    #else
+      return _mm256_add_ps(_mm256_mul_ps(a,b),c);
+    #endif
+  }
+};
+#endif
+
+/*------------------------------------------------
+  usym3 inversion, as linal_usym3_invrt
+------------------------------------------------*/
+template <typename S, typename T>
+static inline void linal_usym3_invrt_lane(const long NB, T* A)
+{
+  typedef typename S::V V;
+  const V a0 = S::loadu(A+0*NB);
+  const V a1 = S::loadu(A+1*NB);
+  const V a2 = S::loadu(A+2*NB);
+  const V a3 = S::loadu(A+3*NB);
+  const V a4 = S::loadu(A+4*NB);
+  const V a5 = S::loadu(A+5*NB);
+
+  const V A0 = S::sub(S::mul(a2,a5),S::mul(a4,a4));
+  const V A1 = S::sub(S::mul(a3,a4),S::mul(a1,a5));
+  const V A2 = S::sub(S::mul(a0,a5),S::mul(a3,a3));
+  const V A3 = S::sub(S::mul(a1,a4),S::mul(a2,a3));
+  const V A4 = S::sub(S::mul(a1,a3),S::mul(a0,a4));
+  const V A5 = S::sub(S::mul(a0,a2),S::mul(a1,a1));
+  //Yes, the plus is correct. A1 is the minus of the det needed
+  const V ADET = S::div(S::set1((T) 1),S::fmadd(a0,A0,S::fmadd(a1,A1,S::mul(a3,A3))));
+
+  S::storeu(A+0*NB,S::mul(ADET,A0));
+  S::storeu(A+1*NB,S::mul(ADET,A1));
+  S::storeu(A+2*NB,S::mul(ADET,A2));
+  S::storeu(A+3*NB,S::mul(ADET,A3));
+  S::storeu(A+4*NB,S::mul(ADET,A4));
+  S::storeu(A+5*NB,S::mul(ADET,A5));
+}
+
+template <typename T>
+void linal_usym3_invrt_batch(const long NB, T* A)
+{
+  typedef linal_batch_vec<T> S;
+  long b=0;
+  for (b=0;b+S::W<=NB;b+=S::W) linal_usym3_invrt_lane<S,T>(NB,A+b);
+  for (b=b;b<NB;b++) linal_usym3_invrt_lane<linal_batch_sca<T>,T>(NB,A+b);
+}
+
+template void linal_usym3_invrt_batch<double>(const long NB, double* A);
+template void linal_usym3_invrt_batch<float>(const long NB, float* A);
+template void linal_usym3_invrt_batch<int>(const long NB, int* A);
+template void linal_usym3_invrt_batch<long>(const long NB, long* A);
+
+/*------------------------------------------------
+  usym3.usym3, as linal_usym3_usym3_MM
+------------------------------------------------*/
+template <typename S, typename T>
+static inline void linal_usym3_usym3_MM_lane(const long NB, const T* A, const T* B, T* C)
+{
+  typedef typename S::V V;
+  const V a0 = S::loadu(A+0*NB);
+  const V a1 = S::loadu(A+1*NB);
+  const V a2 = S::loadu(A+2*NB);
+  const V a3 = S::loadu(A+3*NB);
+  const V a4 = S::loadu(A+4*NB);
+  const V a5 = S::loadu(A+5*NB);
+  const V b0 = S::loadu(B+0*NB);
+  const V b1 = S::loadu(B+1*NB);
+  const V b2 = S::loadu(B+2*NB);
+  const V b3 = S::loadu(B+3*NB);
+  const V b4 = S::loadu(B+4*NB);
+  const V b5 = S::loadu(B+5*NB);
+
+  S::storeu(C+0*NB,S::fmadd(a0,b0,S::fmadd(a1,b1,S::mul(a3,b3))));
+  S::storeu(C+1*NB,S::fmadd(a1,b0,S::fmadd(a2,b1,S::mul(a4,b3))));
+  S::storeu(C+2*NB,S::fmadd(a3,b0,S::fmadd(a4,b1,S::mul(a5,b3))));
+  S::storeu(C+3*NB,S::fmadd(a0,b1,S::fmadd(a1,b2,S::mul(a3,b4))));
+  S::storeu(C+4*NB,S::fmadd(a1,b1,S::fmadd(a2,b2,S::mul(a4,b4))));
+  S::storeu(C+5*NB,S::fmadd(a3,b1,S::fmadd(a4,b2,S::mul(a5,b4))));
+  S::storeu(C+6*NB,S::fmadd(a0,b3,S::fmadd(a1,b4,S::mul(a3,b5))));
+  S::storeu(C+7*NB,S::fmadd(a1,b3,S::fmadd(a2,b4,S::mul(a4,b5))));
+  S::storeu(C+8*NB,S::fmadd(a3,b3,S::fmadd(a4,b4,S::mul(a5,b5))));
+}
+
+template <typename T>
+void linal_usym3_usym3_MM_batch(const long NB, const T* A, const T* B, T* C)
+{
+  typedef linal_batch_vec<T> S;
+  long b=0;
+  for (b=0;b+S::W<=NB;b+=S::W) linal_usym3_usym3_MM_lane<S,T>(NB,A+b,B+b,C+b);
+  for (b=b;b<NB;b++) linal_usym3_usym3_MM_lane<linal_batch_sca<T>,T>(NB,A+b,B+b,C+b);
+}
+
+template void linal_usym3_usym3_MM_batch<double>(const long NB, const double* A, const double* B, double* C);
+template void linal_usym3_usym3_MM_batch<float>(const long NB, const float* A, const float* B, float* C);
+template void linal_usym3_usym3_MM_batch<int>(const long NB, const int* A, const int* B, int* C);
+template void linal_usym3_usym3_MM_batch<long>(const long NB, const long* A, const long* B, long* C);
+
+/*------------------------------------------------
+  usym3.sqm3, upper triangle, as
+  linal_usym3_sqm3_MM_UP
+------------------------------------------------*/
+template <typename S, typename T>
+static inline void linal_usym3_sqm3_MM_UP_lane(const long NB, const T* A, const T* B, T* C)
+{
+  typedef typename S::V V;
+  const V a0 = S::loadu(A+0*NB);
+  const V a1 = S::loadu(A+1*NB);
+  const V a2 = S::loadu(A+2*NB);
+  const V a3 = S::loadu(A+3*NB);
+  const V a4 = S::loadu(A+4*NB);
+  const V a5 = S::loadu(A+5*NB);
+  V b0,b1,b2;
+
+  b0 = S::loadu(B+0*NB);
+  b1 = S::loadu(B+1*NB);
+  b2 = S::loadu(B+2*NB);
+  S::storeu(C+0*NB,S::fmadd(a0,b0,S::fmadd(a1,b1,S::mul(a3,b2))));
+
+  b0 = S::loadu(B+3*NB);
+  b1 = S::loadu(B+4*NB);
+  b2 = S::loadu(B+5*NB);
+  S::storeu(C+1*NB,S::fmadd(a0,b0,S::fmadd(a1,b1,S::mul(a3,b2))));
+  S::storeu(C+2*NB,S::fmadd(a1,b0,S::fmadd(a2,b1,S::mul(a4,b2))));
+
+  b0 = S::loadu(B+6*NB);
+  b1 = S::loadu(B+7*NB);
+  b2 = S::loadu(B+8*NB);
+  S::storeu(C+3*NB,S::fmadd(a0,b0,S::fmadd(a1,b1,S::mul(a3,b2))));
+  S::storeu(C+4*NB,S::fmadd(a1,b0,S::fmadd(a2,b1,S::mul(a4,b2))));
+  S::storeu(C+5*NB,S::fmadd(a3,b0,S::fmadd(a4,b1,S::mul(a5,b2))));
+}
+
+template <typename T>
+void linal_usym3_sqm3_MM_UP_batch(const long NB, const T* A, const T* B, T* C)
+{
+  typedef linal_batch_vec<T> S;
+  long b=0;
+  for (b=0;b+S::W<=NB;b+=S::W) linal_usym3_sqm3_MM_UP_lane<S,T>(NB,A+b,B+b,C+b);
+  for (b=b;b<NB;b++) linal_usym3_sqm3_MM_UP_lane<linal_batch_sca<T>,T>(NB,A+b,B+b,C+b);
+}
+
+template void linal_usym3_sqm3_MM_UP_batch<double>(const long NB, const double* A, const double* B, double* C);
+template void linal_usym3_sqm3_MM_UP_batch<float>(const long NB, const float* A, const float* B, float* C);
+template void linal_usym3_sqm3_MM_UP_batch<int>(const long NB, const int* A, const int* B, int* C);
+template void linal_usym3_sqm3_MM_UP_batch<long>(const long NB, const long* A, const long* B, long* C);
+
+/*------------------------------------------------
+  A^T.B, upper triangle, as linal_MTM_UP_small
+    A is KxN, B is KxN, and C holds the
+    N(N+1)/2 upper triangular elements.
+    If BETA == 0, C is not read
+------------------------------------------------*/
+template <typename S, typename T>
+static inline void linal_MTM_UP_lane(const long NB, const int N, const int K,
+                                     const T ALPHA, const T* A, const T* B, const T BETA, T* C)
+{
+  typedef typename S::V V;
+  const V alpha = S::set1(ALPHA);
+  const V beta  = S::set1(BETA);
+  long cc=0;
+  for (long J=0;J<N;J++)
+  {
+    for (long I=0;I<=J;I++)
+    {
+      const T* AA = A + K*I*NB;
+      const T* BB = B + K*J*NB;
+      V dot = S::set1((T) 0);
+      for (long k=0;k<K;k++)
+      {
+        dot = S::fmadd(S::loadu(AA+k*NB),S::loadu(BB+k*NB),dot);
+      }
+      if (BETA == (T) 0)
+      {
+        S::storeu(C+cc*NB,S::mul(alpha,dot));
+      } else {
+        S::storeu(C+cc*NB,S::fmadd(alpha,dot,S::mul(beta,S::loadu(C+cc*NB))));
+      }
+      cc++;
+    }
+  }
+}
+
+template <typename T>
+void linal_MTM_UP_batch(const long NB, const int M, const int N, const int K,
+                        const T ALPHA, const T* A, const T* B, const T BETA, T* C)
+{
+  typedef linal_batch_vec<T> S;
+  long b=0;
+  for (b=0;b+S::W<=NB;b+=S::W) linal_MTM_UP_lane<S,T>(NB,N,K,ALPHA,A+b,B+b,BETA,C+b);
+  for (b=b;b<NB;b++) linal_MTM_UP_lane<linal_batch_sca<T>,T>(NB,N,K,ALPHA,A+b,B+b,BETA,C+b);
+}
+
+template void linal_MTM_UP_batch<double>(const long NB, const int M, const int N, const int K,
+                                         const double ALPHA, const double* A, const double* B,
+                                         const double BETA, double* C);
+template void linal_MTM_UP_batch<float>(const long NB, const int M, const int N, const int K,
+                                        const float ALPHA, const float* A, const float* B,
+                                        const float BETA, float* C);
+template void linal_MTM_UP_batch<int>(const long NB, const int M, const int N, const int K,
+                                      const int ALPHA, const int* A, const int* B,
+                                      const int BETA, int* C);
+template void linal_MTM_UP_batch<long>(const long NB, const int M, const int N, const int K,
+                                       const long ALPHA, const long* A, const long* B,
+                                       const long BETA, long* C);
@@ -0,0 +1,45 @@
+/*----------------------------------------------------------------
+  linal_batch.hpp
+	JHT, October 14, 2026 : created
+
+  Batched versions of the small matrix routines, which do NB
+  independent problems per call.
+
+  The batch is stored "structure of arrays" : element k of
+  matrix b is at X[k*NB + b]. That is, all the (0) elements are
+  contiguous, then all the (1) elements, and so on. Each matrix
+  is then one simd lane, and one AVX-512 instruction advances 8
+  (double) or 16 (float) matrices at once. The element numbering
+  within each matrix is the same as the unbatched routine.
+
+  linal_usym3_invrt_batch      : A = A^-1
+  linal_usym3_usym3_MM_batch   : C = A.B
+  linal_usym3_sqm3_MM_UP_batch : C = A.B, upper triangle only
+  linal_MTM_UP_batch           : C = ALPHA*A^T.B + BETA*C,
+                                 upper triangle only
+
+  see linal_usym3_invrt.hpp, linal_usym3_usym3_MM.hpp,
+  linal_usym3_sqm3_MM_UP.hpp, and linal_MTM_UP_small.hpp for
+  the unbatched layouts.
+
+  The element wise linal_vxv_small, linal_vxM_small, and
+  linal_scal_small need no batched version, as they can be
+  called once on all NB*N elements.
+-----------------------------------------------------------------*/
+#ifndef LINAL_BATCH_HPP
+#define LINAL_BATCH_HPP
+
+template <typename T>
+void linal_usym3_invrt_batch(const long NB, T* A);
+
+template <typename T>
+void linal_usym3_usym3_MM_batch(const long NB, const T* A, const T* B, T* C);
+
+template <typename T>
+void linal_usym3_sqm3_MM_UP_batch(const long NB, const T* A, const T* B, T* C);
+
+template <typename T>
+void linal_MTM_UP_batch(const long NB, const int M, const int N, const int K,
+                        const T ALPHA, const T* A, const T* B, const T BETA, T* C);
+
+#endif
@@ -0,0 +1,235 @@
+/*------------------------------------------------
+  linal_blas.cpp
+        JHT, October 14, 2026 : created
+        JHT, October 14, 2026 : leading dimensions
+
+    Dispatch of the larger linal_* products to
+    the F77 BLAS, see linal_blas.hpp
+
+    The linal_* routines are column major, and
+    LDA, LDB, and LDC are the row counts unless
+    they are given (linal_gemm with LDA, etc.)
+
+    C = ALPHA*A.B   + BETA*C -> ?gemm_('N','N')
+    C = ALPHA*A^T.B + BETA*C -> ?gemm_('T','N'),
+                                dsyrk_ if A == B
+    C = ALPHA*U.B   + BETA*C -> ?symm_('L','U'),
+                                after unpacking U
+
+    BLAS ?symm_ needs the full square U, so the
+    packed upper triangle is copied into a
+    temporary MxM array (only the upper half
+    is referenced)
+------------------------------------------------*/
+#include "linal_blas.hpp"
+#include "linal_gemm.hpp"
+#include "blas_interface.hpp"
+#include <vector>
+#include <chrono>
+#include <algorithm>
+
+static long LINAL_BLAS_CROSSOVER = LINAL_BLAS_MNK;
+
+void linal_blas_set_mnk(const long MNK) {LINAL_BLAS_CROSSOVER = MNK;}
+long linal_blas_mnk() {return LINAL_BLAS_CROSSOVER;}
+
+#if defined (LINAL_BLAS)
+//------------------------------------------------
+// F77 wrappers that drop the const
+static inline void linal_blas_xgemm(char TA, int M, int N, int K, double ALPHA, const double* A,
+                                    int LDA, const double* B, int LDB, double BETA, double* C,
+                                    int LDC)
+{
+  char TB = 'N';
+  dgemm_(&TA,&TB,&M,&N,&K,&ALPHA,(double*) A,&LDA,(double*) B,&LDB,&BETA,C,&LDC);
+}
+
+static inline void linal_blas_xgemm(char TA, int M, int N, int K, float ALPHA, const float* A,
+                                    int LDA, const float* B, int LDB, float BETA, float* C,
+                                    int LDC)
+{
+  char TB = 'N';
+  sgemm_(&TA,&TB,&M,&N,&K,&ALPHA,(float*) A,&LDA,(float*) B,&LDB,&BETA,C,&LDC);
+}
+
+static inline void linal_blas_xsymm(int M, int N, double ALPHA, const double* U,
+                                    const double* B, double BETA, double* C)
+{
+  char SIDE = 'L';
+  char UPLO = 'U';
+  dsymm_(&SIDE,&UPLO,&M,&N,&ALPHA,(double*) U,&M,(double*) B,&M,&BETA,C,&M);
+}
+
+static inline void linal_blas_xsymm(int M, int N, float ALPHA, const float* U,
+                                    const float* B, float BETA, float* C)
+{
+  char SIDE = 'L';
+  char UPLO = 'U';
+  ssymm_(&SIDE,&UPLO,&M,&N,&ALPHA,(float*) U,&M,(float*) B,&M,&BETA,C,&M);
+}
+
+//------------------------------------------------
+// C = ALPHA*A^T.A with dsyrk_, which only sets the
+// upper triangle, copied to the lower. Only used
+// for BETA == 0, as C need not be symmetric
+static inline bool linal_blas_syrk(int N, int K, double ALPHA, const double* A, int LDA,
+                                   double BETA, double* C, int LDC)
+{
+  char UPLO  = 'U';
+  char TRANS = 'T';
+  dsyrk_(&UPLO,&TRANS,&N,&K,&ALPHA,(double*) A,&LDA,&BETA,C,&LDC);
+  for (long j=0;j<N;j++)
+  {
+    for (long i=j+1;i<N;i++) *(C+i+(long) LDC*j) = *(C+j+(long) LDC*i);
+  }
+  return true;
+}
+
+static inline bool linal_blas_syrk(int N, int K, float ALPHA, const float* A, int LDA,
+                                   float BETA, float* C, int LDC)
+{
+  return false;
+}
+#endif
+
+/*------------------------------------------------
+  gemm
+------------------------------------------------*/
+template <typename T>
+static inline bool linal_blas_gemm_t(const bool TRANSA, const int M, const int N, const int K,
+                                     const T ALPHA, const T* A, const int LDA, const T* B,
+                                     const int LDB, const T BETA, T* C, const int LDC)
+{
+  #if defined (LINAL_BLAS)
+    if ((long) M*N*K < LINAL_BLAS_CROSSOVER || M <= 0 || N <= 0 || K <= 0) return false;
+
+    if (TRANSA)
+    {
+      if (A == B && LDA == LDB && M == N && BETA == (T) 0 
+          && linal_blas_syrk(N,K,ALPHA,A,LDA,BETA,C,LDC)) return true;
+      linal_blas_xgemm('T',M,N,K,ALPHA,A,LDA,B,LDB,BETA,C,LDC);
+    } else {
+      linal_blas_xgemm('N',M,N,K,ALPHA,A,LDA,B,LDB,BETA,C,LDC);
+    }
+    return true;
+  #else
+    return false;
+  #endif
+}
+
+bool linal_blas_gemm(const bool TRANSA, const int M, const int N, const int K,
+                     const double ALPHA, const double* A, const double* B,
+                     const double BETA, double* C)
+{
+  return linal_blas_gemm_t<double>(TRANSA,M,N,K,ALPHA,A,TRANSA ? K : M,B,K,BETA,C,M);
+}
+
+bool linal_blas_gemm(const bool TRANSA, const int M, const int N, const int K,
+                     const double ALPHA, const double* A, const int LDA,
+                     const double* B, const int LDB, const double BETA,
+                     double* C, const int LDC)
+{
+  return linal_blas_gemm_t<double>(TRANSA,M,N,K,ALPHA,A,LDA,B,LDB,BETA,C,LDC);
+}
+
+bool linal_blas_gemm(const bool TRANSA, const int M, const int N, const int K,
+                     const float ALPHA, const float* A, const float* B,
+                     const float BETA, float* C)
+{
+  return linal_blas_gemm_t<float>(TRANSA,M,N,K,ALPHA,A,TRANSA ? K : M,B,K,BETA,C,M);
+}
+
+bool linal_blas_gemm(const bool TRANSA, const int M, const int N, const int K,
+                     const float ALPHA, const float* A, const int LDA,
+                     const float* B, const int LDB, const float BETA,
+                     float* C, const int LDC)
+{
+  return linal_blas_gemm_t<float>(TRANSA,M,N,K,ALPHA,A,LDA,B,LDB,BETA,C,LDC);
+}
+
+/*------------------------------------------------
+  symm, from the packed upper triangle of U
+------------------------------------------------*/
+template <typename T>
+static inline bool linal_blas_usym_t(const long M, const long N, const T ALPHA, const T* U,
+                                     const T* B, const T BETA, T* C)
+{
+  #if defined (LINAL_BLAS)
+    if (M*M*N < LINAL_BLAS_CROSSOVER || M <= 0 || N <= 0) return false;
+
+    std::vector<T> UF(M*M);
+    for (long j=0;j<M;j++)
+    {
+      const T* UP = U + (j*(j+1))/2;
+      for (long i=0;i<=j;i++) UF[i+M*j] = *(UP+i);
+    }
+    linal_blas_xsymm((int) M,(int) N,ALPHA,UF.data(),B,BETA,C);
+    return true;
+  #else
+    return false;
+  #endif
+}
+
+bool linal_blas_usym(const long M, const long N, const double ALPHA, const double* U,
+                     const double* B, const double BETA, double* C)
+{
+  return linal_blas_usym_t<double>(M,N,ALPHA,U,B,BETA,C);
+}
+
+bool linal_blas_usym(const long M, const long N, const float ALPHA, const float* U,
+                     const float* B, const float BETA, float* C)
+{
+  return linal_blas_usym_t<float>(M,N,ALPHA,U,B,BETA,C);
+}
+
+/*------------------------------------------------
+  calibration
+    times C = A.B for N = 8,16,32,... up to NMAX,
+    natively and with BLAS, for double. The
+    crossover is set to N^3 of the first N for
+    which BLAS is faster at N and 2N
+------------------------------------------------*/
+#if defined (LINAL_BLAS)
+static double linal_blas_time(const int N, const double* A, const double* B, double* C)
+{
+  const long FLOPS = 2L*N*N*N;
+  const int  NREP  = (int) std::max(1L,(1L << 27)/FLOPS);
+  const auto t0 = std::chrono::steady_clock::now();
+  for (int r=0;r<NREP;r++) linal_gemm<double>(false,N,N,N,1.0,A,B,0.0,C);
+  const auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(t1-t0).count()/NREP;
+}
+#endif
+
+long linal_blas_calibrate(const int NMAX)
+{
+  #if defined (LINAL_BLAS)
+    const long SAVE = LINAL_BLAS_CROSSOVER;
+    std::vector<double> A((long) NMAX*NMAX,0.5);
+    std::vector<double> B((long) NMAX*NMAX,0.25);
+    std::vector<double> C((long) NMAX*NMAX,0.0);
+
+    long cross = -1;
+    bool last  = false;
+    long lastN = 0;
+    for (long N=8;N<=NMAX;N*=2)
+    {
+      LINAL_BLAS_CROSSOVER = 1L << 62;
+      const double tn = linal_blas_time((int) N,A.data(),B.data(),C.data());
+      LINAL_BLAS_CROSSOVER = 0;
+      const double tb = linal_blas_time((int) N,A.data(),B.data(),C.data());
+
+      const bool blas = (tb < tn);
+      if (blas && last) {cross = lastN*lastN*lastN; break;}
+      last  = blas;
+      lastN = N;
+    }
+    //BLAS never won twice in a row, keep it for the very large
+    if (cross < 0) cross = last ? lastN*lastN*lastN : SAVE;
+
+    LINAL_BLAS_CROSSOVER = cross;
+    return cross;
+  #else
+    return -1;
+  #endif
+}
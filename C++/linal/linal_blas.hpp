@@ -0,0 +1,60 @@
+/*------------------------------------------------
+  linal_blas.hpp
+        JHT, October 14, 2026 : created
+
+    Dispatch of the larger linal_* products to
+    the F77 BLAS (e.g., MKL)
+
+    If compiled with -DLINAL_BLAS, linal_gemm and
+    linal_gemm_usym (and so linal_ABpC, linal_ATBpC,
+    linal_UApB, and the linal_AUBp* routines) call
+    ?gemm_, ?symm_, or dsyrk_ (A^T.A, BETA == 0)
+    when M*N*K is at least the crossover, which
+    starts at LINAL_BLAS_MNK.
+    Below it, the native blocked code is used.
+    Without LINAL_BLAS, everything stays native.
+
+    linal_blas_set_mnk   sets the crossover
+    linal_blas_mnk       returns the crossover
+    linal_blas_calibrate times native vs BLAS for
+                         square matrices up to NMAX,
+                         sets the crossover to where
+                         BLAS starts winning, and
+                         returns it (-1 without BLAS)
+
+    linal_blas_gemm and linal_blas_usym return true
+    if the product was done by BLAS, false if the
+    caller should do it
+------------------------------------------------*/
+#ifndef LINAL_BLAS_HPP
+#define LINAL_BLAS_HPP
+
+#include "linal_def.hpp"
+
+void linal_blas_set_mnk(const long MNK);
+long linal_blas_mnk();
+long linal_blas_calibrate(const int NMAX=512);
+
+bool linal_blas_gemm(const bool TRANSA, const int M, const int N, const int K,
+                     const double ALPHA, const double* A, const double* B,
+                     const double BETA, double* C);
+bool linal_blas_gemm(const bool TRANSA, const int M, const int N, const int K,
+                     const float ALPHA, const float* A, const float* B,
+                     const float BETA, float* C);
+
+//with the leading dimensions of A, B, and C
+bool linal_blas_gemm(const bool TRANSA, const int M, const int N, const int K,
+                     const double ALPHA, const double* A, const int LDA,
+                     const double* B, const int LDB, const double BETA,
+                     double* C, const int LDC);
+bool linal_blas_gemm(const bool TRANSA, const int M, const int N, const int K,
+                     const float ALPHA, const float* A, const int LDA,
+                     const float* B, const int LDB, const float BETA,
+                     float* C, const int LDC);
+
+bool linal_blas_usym(const long M, const long N, const double ALPHA, const double* U,
+                     const double* B, const double BETA, double* C);
+bool linal_blas_usym(const long M, const long N, const float ALPHA, const float* U,
+                     const float* B, const float BETA, float* C);
+
+#endif
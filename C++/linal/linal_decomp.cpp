@@ -0,0 +1,266 @@
+/*-------------------------------------------------
+  linal_decomp.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for the partial and truncated matrix
+  decompositions, see linal_decomp.hpp
+
+  The LAPACK workspace sizes are found with the
+  usual LWORK = -1 queries, and the integer
+  workspaces are checked out of the Core<double>
+  as enough doubles to hold them.
+
+  Everything checked out is removed from the Core
+  again in reverse order (or with a core_scope), so
+  the Core can be used as a stack by the caller.
+-------------------------------------------------*/
+#include "linal_decomp.hpp"
+#include "linal_gemm.hpp"
+#include <random>
+#include <algorithm>
+
+//number of doubles that hold n ints
+static inline long linal_decomp_ints(const long n)
+{
+  return (n*(long)sizeof(int) + (long)sizeof(double) - 1)/(long)sizeof(double);
+}
+
+/*-------------------------------------------------
+  workspace queries
+-------------------------------------------------*/
+static long linal_dgesvd_LWORK(const long M, const long N)
+{
+  char JOBU  = 'S';
+  char JOBVT = 'S';
+  int  MM    = M;
+  int  NN    = N;
+  int  LDA   = MM;
+  int  LDU   = MM;
+  int  LDVT  = std::min(M,N);
+  int  LWORK = -1;
+  int  INFO;
+  double D;
+
+  dgesvd_(&JOBU,&JOBVT,&MM,&NN,&D,&LDA,&D,&D,&LDU,&D,&LDVT,&D,&LWORK,&INFO);
+  return (long) D;
+}
+
+static long linal_dgesdd_LWORK(const long M, const long N)
+{
+  char JOBZ  = 'S';
+  int  MM    = M;
+  int  NN    = N;
+  int  LDA   = MM;
+  int  LDU   = MM;
+  int  LDVT  = std::min(M,N);
+  int  LWORK = -1;
+  int  IWORK;
+  int  INFO;
+  double D;
+
+  dgesdd_(&JOBZ,&MM,&NN,&D,&LDA,&D,&D,&LDU,&D,&LDVT,&D,&LWORK,&IWORK,&INFO);
+  return (long) D;
+}
+
+static void linal_dsyevd_LWORK(const long N, long& LWORK, long& LIWORK)
+{
+  char JOBZ   = 'V';
+  char UPLO   = 'U';
+  int  NN     = N;
+  int  LDA    = NN;
+  int  LW     = -1;
+  int  LIW    = -1;
+  int  IWORK;
+  int  INFO;
+  double D;
+
+  dsyevd_(&JOBZ,&UPLO,&NN,&D,&LDA,&D,&D,&LW,&IWORK,&LIW,&INFO);
+  LWORK  = (long) D;
+  LIWORK = (long) IWORK;
+}
+
+//dgeqrf + dorgqr of an MxN matrix
+static long linal_dqr_LWORK(const long M, const long N)
+{
+  int  MM    = M;
+  int  NN    = N;
+  int  LDA   = MM;
+  int  LWORK = -1;
+  int  INFO;
+  double D1,D2;
+
+  dgeqrf_(&MM,&NN,&D1,&LDA,&D1,&D1,&LWORK,&INFO);
+  dorgqr_(&MM,&NN,&NN,&D2,&LDA,&D2,&D2,&LWORK,&INFO);
+  return std::max((long) D1,(long) D2);
+}
+
+/*-------------------------------------------------
+  thin SVD, dgesvd
+-------------------------------------------------*/
+void linal_dsvd_thin(const long M, const long N, double* A, double* S, double* U,
+                     double* VT, Core<double>& CORE, int& INFO)
+{
+  char JOBU  = 'S';
+  char JOBVT = 'S';
+  int  MM    = M;
+  int  NN    = N;
+  int  LDA   = MM;
+  int  LDU   = MM;
+  int  LDVT  = std::min(M,N);
+  const long NWORK = linal_dgesvd_LWORK(M,N);
+  int  LWORK = NWORK;
+
+  double* WORK = CORE.checkout(NWORK);
+  dgesvd_(&JOBU,&JOBVT,&MM,&NN,A,&LDA,S,U,&LDU,VT,&LDVT,WORK,&LWORK,&INFO);
+  CORE.remove(NWORK);
+}
+
+long linal_dsvd_thin_NWORK(const long M, const long N)
+{
+  return linal_dgesvd_LWORK(M,N);
+}
+
+/*-------------------------------------------------
+  thin SVD, dgesdd
+-------------------------------------------------*/
+void linal_dgesdd(const long M, const long N, double* A, double* S, double* U,
+                  double* VT, Core<double>& CORE, int& INFO)
+{
+  char JOBZ  = 'S';
+  int  MM    = M;
+  int  NN    = N;
+  int  LDA   = MM;
+  int  LDU   = MM;
+  int  LDVT  = std::min(M,N);
+  const long NWORK  = linal_dgesdd_LWORK(M,N);
+  const long NIWORK = linal_decomp_ints(8*std::min(M,N));
+  int  LWORK = NWORK;
+
+  double* WORK  = CORE.checkout(NWORK);
+  int*    IWORK = (int*) CORE.checkout(NIWORK);
+  dgesdd_(&JOBZ,&MM,&NN,A,&LDA,S,U,&LDU,VT,&LDVT,WORK,&LWORK,IWORK,&INFO);
+  CORE.remove(NIWORK);
+  CORE.remove(NWORK);
+}
+
+long linal_dgesdd_NWORK(const long M, const long N)
+{
+  return linal_dgesdd_LWORK(M,N) + linal_decomp_ints(8*std::min(M,N));
+}
+
+/*-------------------------------------------------
+  symmetric eigensolver, dsyevd
+-------------------------------------------------*/
+void linal_dsyevd(const long N, double* A, double* W, Core<double>& CORE, int& INFO)
+{
+  char JOBZ = 'V';
+  char UPLO = 'U';
+  int  NN   = N;
+  int  LDA  = NN;
+  long NWORK,NIWORK;
+  linal_dsyevd_LWORK(N,NWORK,NIWORK);
+  int  LWORK  = NWORK;
+  int  LIWORK = NIWORK;
+  const long NIW = linal_decomp_ints(NIWORK);
+
+  double* WORK  = CORE.checkout(NWORK);
+  int*    IWORK = (int*) CORE.checkout(NIW);
+  dsyevd_(&JOBZ,&UPLO,&NN,A,&LDA,W,WORK,&LWORK,IWORK,&LIWORK,&INFO);
+  CORE.remove(NIW);
+  CORE.remove(NWORK);
+}
+
+long linal_dsyevd_NWORK(const long N)
+{
+  long NWORK,NIWORK;
+  linal_dsyevd_LWORK(N,NWORK,NIWORK);
+  return NWORK + linal_decomp_ints(NIWORK);
+}
+
+/*-------------------------------------------------
+  randomized truncated SVD
+-------------------------------------------------*/
+//Y = orthonormal basis of the columns of Y (MxL)
+static void linal_dorth(const long M, const long L, double* Y, double* TAU,
+                        double* WORK, const long NWORK, int& INFO)
+{
+  int MM    = M;
+  int LL    = L;
+  int LDA   = MM;
+  int LWORK = NWORK;
+  dgeqrf_(&MM,&LL,Y,&LDA,TAU,WORK,&LWORK,&INFO);
+  if (INFO != 0) return;
+  dorgqr_(&MM,&LL,&LL,Y,&LDA,TAU,WORK,&LWORK,&INFO);
+}
+
+//size of the scratch used by the LAPACK calls
+static long linal_drsvd_LWORK(const long M, const long N, const long L)
+{
+  return std::max(std::max(linal_dqr_LWORK(M,L),linal_dqr_LWORK(N,L)),
+                  linal_dgesdd_NWORK(L,N));
+}
+
+long linal_drsvd_NWORK(const long M, const long N, const long K, const int P)
+{
+  const long L = std::min(K+P,std::min(M,N));
+  return N*L + M*L + L + L*N + L*L + L + L*N + linal_drsvd_LWORK(M,N,L);
+}
+
+void linal_drsvd(const long M, const long N, const long K, const double* A,
+                 double* S, double* U, double* VT, Core<double>& CORE, int& INFO,
+                 const int P, const int Q, const unsigned long SEED)
+{
+  const long L = std::min(K+P,std::min(M,N));
+  if (K < 1 || K > L)
+  {
+    printf("linal_drsvd : rank %ld is not in [1,min(M,N)] \n",K);
+    exit(1);
+  }
+
+  const long NWORK = linal_drsvd_LWORK(M,N,L);
+  core_scope<double> SCOPE(CORE); //gives everything back on return
+  double* Z    = CORE.checkout(N*L);
+  double* Y    = CORE.checkout(M*L);
+  double* TAU  = CORE.checkout(L);
+  double* B    = CORE.checkout(L*N);
+  double* UB   = CORE.checkout(L*L);
+  double* SB   = CORE.checkout(L);
+  double* VTB  = CORE.checkout(L*N);
+  double* WORK = CORE.checkout(NWORK);
+
+  //Y = A.Omega, with Omega gaussian
+  std::mt19937_64 gen(SEED);
+  std::normal_distribution<double> dist(0.0,1.0);
+  for (long i=0;i<N*L;i++) *(Z+i) = dist(gen);
+  linal_gemm<double>(false,M,L,N,1.0,A,Z,0.0,Y);
+  linal_dorth(M,L,Y,TAU,WORK,NWORK,INFO);
+
+  //power iterations, Y = A.A^T.Y, reorthonormalized each half step
+  for (int q=0;q<Q && INFO == 0;q++)
+  {
+    linal_gemm<double>(true,N,L,M,1.0,A,Y,0.0,Z);
+    linal_dorth(N,L,Z,TAU,WORK,NWORK,INFO);
+    if (INFO != 0) break;
+    linal_gemm<double>(false,M,L,N,1.0,A,Z,0.0,Y);
+    linal_dorth(M,L,Y,TAU,WORK,NWORK,INFO);
+  }
+
+  if (INFO == 0)
+  {
+    //B = Y^T.A, LxN, and its SVD
+    linal_gemm<double>(true,L,N,M,1.0,Y,A,0.0,B);
+    Core<double> SCRATCH(NWORK,WORK);
+    linal_dgesdd(L,N,B,SB,UB,VTB,SCRATCH,INFO);
+  }
+
+  if (INFO == 0)
+  {
+    //U = Y.UB, for the first K columns of UB
+    linal_gemm<double>(false,M,K,L,1.0,Y,UB,0.0,U);
+    for (long i=0;i<K;i++) *(S+i) = *(SB+i);
+    for (long j=0;j<N;j++)
+    {
+      for (long i=0;i<K;i++) *(VT+i+K*j) = *(VTB+i+L*j);
+    }
+  }
+}
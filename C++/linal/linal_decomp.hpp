@@ -0,0 +1,76 @@
+/*-------------------------------------------------
+  linal_decomp.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for the partial and truncated matrix
+  decompositions. Unlike linal_dsvd, the workspace
+  is checked out of a Core, and returned to it
+  before exiting, so the caller need only make sure
+  the Core has at least *_NWORK free elements.
+
+  With K = min(M,N)...
+
+  linal_dsvd_thin : thin SVD, dgesvd (JOBU='S')
+    A = U . S . V^T
+    U is MxK, S is K, VT is KxN
+
+  linal_dgesdd    : thin SVD, divide and conquer
+    same as linal_dsvd_thin, but with dgesdd, which
+    is much faster for the larger matrices
+
+  linal_dsyevd    : symmetric eigensolver, divide
+    and conquer (dsyevd, upper triangle of A).
+    The eigenvalues are in W (ascending), and the
+    eigenvectors overwrite A
+
+  linal_drsvd     : randomized truncated SVD, rank K
+    A ~ U . S . V^T
+    U is MxK, S is K, VT is KxN
+
+    The range of A is sampled with K+P gaussian
+    vectors, refined with Q power iterations,
+    and the SVD is done on the small (K+P)xN
+    projection of A (Halko, Martinsson and Tropp,
+    SIAM Rev. 53, 217 (2011)). P ~ 10 and Q ~ 2 is
+    usually plenty. A is not changed.
+
+  In all but linal_drsvd, A is destroyed.
+  INFO is the LAPACK job status.
+
+Parameters
+M	long		#rows of A
+N	long		#cols of A
+K	long		rank of the truncated SVD
+A	double*		matrix to decompose
+S	double*		singular values
+U	double*		left singular vectors
+VT	double*		right singular vectors
+W	double*		eigenvalues
+CORE	Core<double>&	workspace
+INFO	int&		job status
+P	int		oversampling
+Q	int		number of power iterations
+SEED	unsigned long	seed of the random vectors
+-------------------------------------------------*/
+#ifndef LINAL_DECOMP_HPP
+#define LINAL_DECOMP_HPP
+#include "lapack_interface.hpp"
+#include "core.hpp"
+
+void linal_dsvd_thin(const long M, const long N, double* A, double* S, double* U,
+                     double* VT, Core<double>& CORE, int& INFO);
+long linal_dsvd_thin_NWORK(const long M, const long N);
+
+void linal_dgesdd(const long M, const long N, double* A, double* S, double* U,
+                  double* VT, Core<double>& CORE, int& INFO);
+long linal_dgesdd_NWORK(const long M, const long N);
+
+void linal_dsyevd(const long N, double* A, double* W, Core<double>& CORE, int& INFO);
+long linal_dsyevd_NWORK(const long N);
+
+void linal_drsvd(const long M, const long N, const long K, const double* A,
+                 double* S, double* U, double* VT, Core<double>& CORE, int& INFO,
+                 const int P=10, const int Q=2, const unsigned long SEED=1);
+long linal_drsvd_NWORK(const long M, const long N, const long K, const int P=10);
+
+#endif
@@ -2,3 +2,29 @@
 #define FZTOL 1E-7
 #define LZTOL 0
 #define IZTOL 0
+
+//linal_ABpC and linal_ATBpC use the blocked linal_gemm
+// for double and float when M*N*K is at least this
+#if !defined (LINAL_GEMM_MNK)
+  #define LINAL_GEMM_MNK 32768
+#endif
+
+//with -DLINAL_BLAS, linal_gemm and linal_gemm_usym call 
+// the BLAS when M*N*K is at least this, see linal_blas.hpp
+#if !defined (LINAL_BLAS_MNK)
+  #define LINAL_BLAS_MNK 2097152
+#endif
+
+//the linal_par_* routines only start an OpenMP team when 
+// there are at least this many flops, if the cutoff has not
+// been measured (simd_machine.hpp), see linal_par.hpp
+#if !defined (LINAL_PAR_MIN_FLOPS)
+  #define LINAL_PAR_MIN_FLOPS 262144
+#endif
+
+//linal_strassen_set(MIN) without LEVELS does at most this
+// many levels of the Strassen-Winograd recursion, see 
+// linal_strassen.hpp
+#if !defined (LINAL_STRASSEN_LEVELS)
+  #define LINAL_STRASSEN_LEVELS 2
+#endif
@@ -0,0 +1,130 @@
+/*------------------------------------------------
+  linal_fixed.hpp
+	JHT, October 14, 2026 : created
+	JHT, October 14, 2026 : the packing of MTM_UP is documented
+
+  .hpp file for the fixed size versions of the
+  small matrix routines. The dimensions are
+  template parameters, and every loop is unrolled
+  at compile time with linal_fixed_unroll, so
+  that the whole operation is kept in registers.
+  These are header only, and meant for M,N,K <= 8
+  (LINAL_FIXED_MAX). For larger or run-time
+  sizes use the *_small routines, or linal_ABpC.
+
+  All matrices are continuous in memory and
+  column major, as in the *_small routines
+
+  linal_vxM_fixed<M,N>(x,A,B)
+    B(i,j) = x(i) * A(i,j)
+    x is M, A and B are MxN
+
+  linal_MTM_UP_fixed<M,N,K>(ALPHA,A,B,BETA,C)
+    C = ALPHA * A^T.B + BETA * C
+    A is KxM, B is KxN, and only the upper
+    triangle of the MxN C (i <= j) is computed,
+    packed by columns, with column j holding
+    rows 0..min(j,M-1). For N <= M this is the
+    packed triangle of linal_MTM_UP_small, N(N+1)/2
+    elements. For N > M the columns j >= M are
+    full, so C has M(M+1)/2 + M(N-M) elements
+    (linal_MTM_UP_small has no N > M layout)
+
+  linal_ABpC_fixed<M,N,K>(ALPHA,A,B,BETA,C)
+    C = ALPHA * A.B + BETA * C
+    A is MxK, B is KxN, C is MxN
+
+  With BETA == 0, C is not read.
+
+  Example
+    double A[9],B[9],C[9];
+    linal_ABpC_fixed<3,3,3>(1.0,A,B,0.0,C);
+------------------------------------------------*/
+#ifndef LINAL_FIXED_HPP
+#define LINAL_FIXED_HPP
+
+#define LINAL_FIXED_MAX 8
+
+//compile time loop, calls f(I), f(I+1), ..., f(N-1)
+template <int I, int N>
+struct linal_fixed_unroll
+{
+  template <typename F>
+  static inline void run(const F& f) {f(I); linal_fixed_unroll<I+1,N>::run(f);}
+};
+
+template <int N>
+struct linal_fixed_unroll<N,N>
+{
+  template <typename F>
+  static inline void run(const F& f) {}
+};
+
+//B = x*A
+template <int M, int N, typename T>
+inline void linal_vxM_fixed(const T* x, const T* A, T* B)
+{
+  static_assert(M > 0 && N > 0 && M <= LINAL_FIXED_MAX && N <= LINAL_FIXED_MAX,
+                "linal_vxM_fixed : dimensions must be in [1,LINAL_FIXED_MAX]");
+  linal_fixed_unroll<0,N>::run([&](const int j)
+  {
+    linal_fixed_unroll<0,M>::run([&](const int i)
+    {
+      *(B+i+M*j) = *(x+i) * *(A+i+M*j);
+    });
+  });
+}
+
+//C = alpha*A^T.B + beta*C, upper triangle of C only
+template <int M, int N, int K, typename T>
+inline void linal_MTM_UP_fixed(const T ALPHA, const T* A, const T* B, const T BETA, T* C)
+{
+  static_assert(M > 0 && N > 0 && K > 0 && M <= LINAL_FIXED_MAX &&
+                N <= LINAL_FIXED_MAX && K <= LINAL_FIXED_MAX,
+                "linal_MTM_UP_fixed : dimensions must be in [1,LINAL_FIXED_MAX]");
+  linal_fixed_unroll<0,N>::run([&](const int j)
+  {
+    //the upper triangle of cols 0..j-1 of C has this many elements
+    T* CJ = C + (j < M ? (j*(j+1))/2 : (M*(M+1))/2 + M*(j-M));
+    linal_fixed_unroll<0,M>::run([&](const int i)
+    {
+      if (i > j) return;
+      T dtmp = 0;
+      linal_fixed_unroll<0,K>::run([&](const int k)
+      {
+        dtmp += *(A+k+K*i) * *(B+k+K*j);
+      });
+      *(CJ+i) = (BETA == (T) 0) ? ALPHA*dtmp : ALPHA*dtmp + BETA * *(CJ+i);
+    });
+  });
+}
+
+//C = alpha*A.B + beta*C
+template <int M, int N, int K, typename T>
+inline void linal_ABpC_fixed(const T ALPHA, const T* A, const T* B, const T BETA, T* C)
+{
+  static_assert(M > 0 && N > 0 && K > 0 && M <= LINAL_FIXED_MAX &&
+                N <= LINAL_FIXED_MAX && K <= LINAL_FIXED_MAX,
+                "linal_ABpC_fixed : dimensions must be in [1,LINAL_FIXED_MAX]");
+  linal_fixed_unroll<0,N>::run([&](const int j)
+  {
+    //column j of A.B, in registers
+    T c[M];
+    linal_fixed_unroll<0,M>::run([&](const int i) {c[i] = 0;});
+    linal_fixed_unroll<0,K>::run([&](const int k)
+    {
+      const T b = *(B+k+K*j);
+      linal_fixed_unroll<0,M>::run([&](const int i) {c[i] += *(A+i+M*k) * b;});
+    });
+
+    T* CJ = C+M*j;
+    if (BETA == (T) 0)
+    {
+      linal_fixed_unroll<0,M>::run([&](const int i) {*(CJ+i) = ALPHA*c[i];});
+    } else {
+      linal_fixed_unroll<0,M>::run([&](const int i) {*(CJ+i) = ALPHA*c[i] + BETA * *(CJ+i);});
+    }
+  });
+}
+
+#endif
@@ -0,0 +1,493 @@
+/*------------------------------------------------
+  linal_gemm.cpp
+        JHT, October 14, 2026 : created
+        JHT, October 14, 2026 : alias and NaN checks with -DLIBJ_CHECKED
+        JHT, October 14, 2026 : leading dimensions LDA, LDB, LDC
+
+    C = ALPHA*op(A).B + BETA*C
+    C = ALPHA*U.B + BETA*C     (linal_gemm_usym)
+    C = ALPHA*op(A).D.B + BETA*C (linal_gemm_diag)
+
+    Blocked and packed matrix multiply, in the
+    style of GotoBLAS/BLIS. The loops are
+
+    for KC block of K (pc)
+      for MC block of M (ic)
+        pack op(A)[ic:ic+MC,pc:pc+KC] -> L2 buffer,
+          in micro-panels of MR rows
+        for NR cols of C (jr)
+          pack B[pc:pc+KC,jr:jr+NR] -> L1 buffer
+          for MR rows of the MC block (ir)
+            MRxNR microkernel over KC
+
+    The micro-panels are zero padded, so the
+    microkernel always works on a full MRxNR tile,
+    which is then added to C with the edges
+    trimmed. MC is set from the L2 found at run
+    time (libj::CacheInfo), and the packed A block
+    is a cache_buffer of MC*KC elements. The B
+    panel is in the L1 buffer of the thread's
+    libj::Cache (libj::CachePool).
+
+    For linal_gemm_diag, the K elements of the
+    diagonal D scale the columns of op(A) as they
+    are packed, so D.B is never formed and the
+    product is still one pass over A and B.
+
+    With -DLINAL_BLAS, the larger products are
+    sent to the BLAS instead (linal_blas.hpp)
+
+    If compiled with AVX2 (AVX-512F), the micro-
+    kernel keeps the MRxNR tile of C in YMM (ZMM)
+    registers and does one FMA per register per
+    element of K
+------------------------------------------------*/
+
+/* Variables
+
+TRANSA	bool	if true, A is stored KxM and A^T is used
+M	int	rows of op(A), rows of C
+N	int	cols of B, cols of C
+K	int	cols of op(A), rows of B, "internal" dimension
+ALPHA	T	constant to scale A by
+A	T*	pointer to A
+B	T*	pointer to B
+BETA	T	constant to scale C by
+C	T*	pointer to C
+LDA	int	leading dimension of A, >= rows of A (M, or K if TRANSA)
+LDB	int	leading dimension of B, >= K
+LDC	int	leading dimension of C, >= M
+
+*/
+#include "linal_gemm.hpp"
+#include "linal_blas.hpp"
+#include "libjdef.h"
+#include "cache.hpp"
+#include "cache_pool.hpp"
+#include "debug.hpp"
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined (__AVX2__)
+  #include <immintrin.h>
+#endif
+
+/*------------------------------------------------
+  block sizes
+    MR x NR      tile of C in registers
+    KC*(MR+NR)   micro-panels of A and B, in L1
+    MC*KC        packed block of A, in L2. This
+                 MC is for a 256 KB L2, the one used
+                 is from linal_gemm_mc
+------------------------------------------------*/
+template <typename T>
+struct linal_gemm_blk;
+
+#if defined (__AVX512F__)
+template <> struct linal_gemm_blk<double> {static const long MR=16, NR=8, KC=128, MC=192;};
+template <> struct linal_gemm_blk<float>  {static const long MR=32, NR=8, KC=128, MC=384;};
+#elif defined (__AVX2__)
+template <> struct linal_gemm_blk<double> {static const long MR=8,  NR=6, KC=192, MC=128;};
+template <> struct linal_gemm_blk<float>  {static const long MR=16, NR=6, KC=256, MC=192;};
+#else
+template <> struct linal_gemm_blk<double> {static const long MR=4,  NR=4, KC=256, MC=96;};
+template <> struct linal_gemm_blk<float>  {static const long MR=8,  NR=4, KC=256, MC=192;};
+#endif
+
+/*------------------------------------------------
+  linal_gemm_mc
+    rows of the packed block of A, so that it
+    takes about 3/4 of the L2 of this machine
+------------------------------------------------*/
+template <typename T>
+static inline long linal_gemm_mc()
+{
+  typedef linal_gemm_blk<T> BLK;
+  const long L2 = (long) libj::CacheInfo::get().L2_elements<T>();
+  const long mc = (((3*L2/4)/BLK::KC)/BLK::MR)*BLK::MR;
+  const long MR = BLK::MR;
+  return std::max(mc,MR);
+}
+
+/*------------------------------------------------
+  register wrappers for the microkernel
+------------------------------------------------*/
+#if defined (__AVX2__)
+template <typename T>
+struct linal_gemm_vec;
+
+#if defined (__AVX512F__)
+template <>
+struct linal_gemm_vec<double>
+{
+  typedef __m512d V;
+  static const long W = 8;
+  static inline V zero() {return _mm512_setzero_pd();}
+  static inline V loadu(const double* p) {return _mm512_loadu_pd(p);}
+  static inline void storeu(double* p, const V a) {_mm512_storeu_pd(p,a);}
+  static inline V set1(const double* p) {return _mm512_set1_pd(*p);}
+  static inline V fmadd(const V a, const V b, const V c) {return _mm512_fmadd_pd(a,b,c);}
+};
+
+template <>
+struct linal_gemm_vec<float>
+{
+  typedef __m512 V;
+  static const long W = 16;
+  static inline V zero() {return _mm512_setzero_ps();}
+  static inline V loadu(const float* p) {return _mm512_loadu_ps(p);}
+  static inline void storeu(float* p, const V a) {_mm512_storeu_ps(p,a);}
+  static inline V set1(const float* p) {return _mm512_set1_ps(*p);}
+  static inline V fmadd(const V a, const V b, const V c) {return _mm512_fmadd_ps(a,b,c);}
+};
+#else
+template <>
+struct linal_gemm_vec<double>
+{
+  typedef __m256d V;
+  static const long W = 4;
+  static inline V zero() {return _mm256_setzero_pd();}
+  static inline V loadu(const double* p) {return _mm256_loadu_pd(p);}
+  static inline void storeu(double* p, const V a) {_mm256_storeu_pd(p,a);}
+  static inline V set1(const double* p) {return _mm256_broadcast_sd(p);}
+  static inline V fmadd(const V a, const V b, const V c)
+  {
+    #if defined (__FMA__)
+      return _mm256_fmadd_pd(a,b,c);
+    #else
+      return _mm256_add_pd(_mm256_mul_pd(a,b),c);
+    #endif
+  }
+};
+
+template <>
+struct linal_gemm_vec<float>
+{
+  typedef __m256 V;
+  static const long W = 8;
+  static inline V zero() {return _mm256_setzero_ps();}
+  static inline V loadu(const float* p) {return _mm256_loadu_ps(p);}
+  static inline void storeu(float* p, const V a) {_mm256_storeu_ps(p,a);}
+  static inline V set1(const float* p) {return _mm256_broadcast_ss(p);}
+  static inline V fmadd(const V a, const V b, const V c)
+  {
+    #if defined (__FMA__)
+      return _mm256_fmadd_ps(a,b,c);
+    #else
+      return _mm256_add_ps(_mm256_mul_ps(a,b),c);
+    #endif
+  }
+};
+#endif
+#endif
+
+/*------------------------------------------------
+  microkernel
+    AB(MRxNR) = Ap(MRxKB).Bp(KBxNR)
+------------------------------------------------*/
+template <typename T>
+static inline void linal_gemm_kernel(const long KB, const T* Ap, const T* Bp, T* AB)
+{
+  typedef linal_gemm_blk<T> BLK;
+
+  #if defined (__AVX2__)
+    typedef linal_gemm_vec<T> S;
+    const long MV = BLK::MR/S::W;
+    typename S::V c[MV*BLK::NR];
+    typename S::V a[MV];
+
+    for (long j=0;j<MV*BLK::NR;j++) c[j] = S::zero();
+
+    for (long k=0;k<KB;k++)
+    {
+      for (long v=0;v<MV;v++) a[v] = S::loadu(Ap+v*S::W);
+      for (long j=0;j<BLK::NR;j++)
+      {
+        const typename S::V b = S::set1(Bp+j);
+        for (long v=0;v<MV;v++) c[v+MV*j] = S::fmadd(a[v],b,c[v+MV*j]);
+      }
+      Ap += BLK::MR;
+      Bp += BLK::NR;
+    }
+
+    for (long j=0;j<BLK::NR;j++)
+    {
+      for (long v=0;v<MV;v++) S::storeu(AB+v*S::W+BLK::MR*j,c[v+MV*j]);
+    }
+
+  #else
+    for (long j=0;j<BLK::MR*BLK::NR;j++) *(AB+j) = (T) 0;
+
+    for (long k=0;k<KB;k++)
+    {
+      for (long j=0;j<BLK::NR;j++)
+      {
+        const T b = *(Bp+j);
+        for (long r=0;r<BLK::MR;r++) *(AB+r+BLK::MR*j) += *(Ap+r) * b;
+      }
+      Ap += BLK::MR;
+      Bp += BLK::NR;
+    }
+  #endif
+}
+
+/*------------------------------------------------
+  storage of op(A)
+    N    : A is MxK
+    T    : A is KxM, A^T is used
+    USYM : A is MxM upper symmetric, only the
+           upper triangle is stored (packed)
+------------------------------------------------*/
+#define LINAL_GEMM_OPA_N    0
+#define LINAL_GEMM_OPA_T    1
+#define LINAL_GEMM_OPA_USYM 2
+
+/*------------------------------------------------
+  pack op(A)[I0:I0+MB,K0:K0+KB] into micro-panels
+  of MR rows, Ap[k*MR+r], zero padded past MB.
+  If D is not NULL, column k of op(A) is scaled
+  by D[k] (not for USYM)
+
+  For USYM, the triangular tile is unpacked into
+  the square micro-panels, so the microkernel
+  never sees the packed storage
+------------------------------------------------*/
+template <typename T>
+static inline void linal_gemm_packA(const int OPA, const long LDA, const T* A,
+                                    const T* D, const long I0, const long MB, const long K0,
+                                    const long KB, T* Ap)
+{
+  const long MR = linal_gemm_blk<T>::MR;
+  for (long ir=0;ir<MB;ir+=MR)
+  {
+    const long mr = std::min(MR,MB-ir);
+    if (OPA == LINAL_GEMM_OPA_T)
+    {
+      for (long r=0;r<mr;r++)
+      {
+        const T* aa = A + K0 + LDA*(I0+ir+r);
+        if (D == NULL)
+        {
+          for (long k=0;k<KB;k++) *(Ap+k*MR+r) = *(aa+k);
+        } else {
+          for (long k=0;k<KB;k++) *(Ap+k*MR+r) = *(aa+k) * *(D+K0+k);
+        }
+      }
+    } else if (OPA == LINAL_GEMM_OPA_USYM) {
+      for (long k=0;k<KB;k++)
+      {
+        const long kk = K0+k;
+        for (long r=0;r<mr;r++)
+        {
+          const long i = I0+ir+r;
+          *(Ap+k*MR+r) = (i <= kk) ? *(A+(kk*(kk+1))/2+i) : *(A+(i*(i+1))/2+kk);
+        }
+      }
+    } else {
+      for (long k=0;k<KB;k++)
+      {
+        const T* aa = A + I0 + ir + LDA*(K0+k);
+        if (D == NULL)
+        {
+          for (long r=0;r<mr;r++) *(Ap+k*MR+r) = *(aa+r);
+        } else {
+          const T dk = *(D+K0+k);
+          for (long r=0;r<mr;r++) *(Ap+k*MR+r) = *(aa+r) * dk;
+        }
+      }
+    }
+    for (long r=mr;r<MR;r++)
+    {
+      for (long k=0;k<KB;k++) *(Ap+k*MR+r) = (T) 0;
+    }
+    Ap += MR*KB;
+  }
+}
+
+/*------------------------------------------------
+  pack B[K0:K0+KB,J0:J0+NB] into one micro-panel
+  of NR cols, Bp[k*NR+c], zero padded past NB
+------------------------------------------------*/
+template <typename T>
+static inline void linal_gemm_packB(const long LDB, const T* B,
+                                    const long K0, const long KB, const long J0, const long NB,
+                                    T* Bp)
+{
+  const long NR = linal_gemm_blk<T>::NR;
+  for (long c=0;c<NB;c++)
+  {
+    const T* bb = B + K0 + LDB*(J0+c);
+    for (long k=0;k<KB;k++) *(Bp+k*NR+c) = *(bb+k);
+  }
+  for (long c=NB;c<NR;c++)
+  {
+    for (long k=0;k<KB;k++) *(Bp+k*NR+c) = (T) 0;
+  }
+}
+
+/*------------------------------------------------
+  driver
+------------------------------------------------*/
+template <typename T>
+static void linal_gemm_drv(const int OPA, const int M, const int N, const int K,
+                           const T ALPHA, const T* A, const long LDA, const T* D,
+                           const T* B, const long LDB, const T BETA, T* C, const long LDC)
+{
+  typedef linal_gemm_blk<T> BLK;
+  static_assert(BLK::KC*BLK::NR <= (long) libj::Cache::L1_elements<T>(),
+                "linal_gemm : packed B panel does not fit in the L1 buffer");
+  static_assert(BLK::MC%BLK::MR == 0,"linal_gemm : MC must be a multiple of MR");
+
+  if (M <= 0 || N <= 0) return;
+
+  //nothing to multiply, just scale C
+  if (K <= 0)
+  {
+    for (long j=0;j<N;j++)
+    {
+      T* cc = C + LDC*j;
+      for (long i=0;i<M;i++) *(cc+i) = (BETA == (T) 0) ? (T) 0 : BETA * *(cc+i);
+    }
+    return;
+  }
+
+  const long MR = BLK::MR;
+  const long NR = BLK::NR;
+  const long KC = BLK::KC;
+  const long MC = linal_gemm_mc<T>();
+
+  libj::cache_buffer<T> A_BUFFER(MC*KC);
+  T* Ap = A_BUFFER.data();
+  T* Bp = libj::CachePool::local().L1_pointer<T>();
+  T AB[BLK::MR*BLK::NR];
+
+  for (long pc=0;pc<K;pc+=KC)
+  {
+    const long kb   = std::min(KC,(long) K-pc);
+    const T    beta = (pc == 0) ? BETA : (T) 1;
+
+    for (long ic=0;ic<M;ic+=MC)
+    {
+      const long mb = std::min(MC,(long) M-ic);
+      linal_gemm_packA<T>(OPA,LDA,A,D,ic,mb,pc,kb,Ap);
+
+      for (long jr=0;jr<N;jr+=NR)
+      {
+        const long nr = std::min(NR,(long) N-jr);
+        linal_gemm_packB<T>(LDB,B,pc,kb,jr,nr,Bp);
+
+        for (long ir=0;ir<mb;ir+=MR)
+        {
+          const long mr = std::min(MR,mb-ir);
+          linal_gemm_kernel<T>(kb,Ap+ir*kb,Bp,AB);
+
+          //C tile += AB, trimmed to the edges of C
+          for (long c=0;c<nr;c++)
+          {
+            T* cc = C + ic + ir + LDC*(jr+c);
+            const T* ab = AB + MR*c;
+            if (beta == (T) 0)
+            {
+              for (long r=0;r<mr;r++) *(cc+r) = ALPHA * *(ab+r);
+            } else {
+              for (long r=0;r<mr;r++) *(cc+r) = ALPHA * *(ab+r) + beta * *(cc+r);
+            }
+          }
+        } //loop over ir
+      } //loop over jr
+    } //loop over ic
+  } //loop over pc
+}
+
+//elements spanned by a column major R x C matrix with leading dimension LD
+static inline long linal_gemm_span(const long R, const long C, const long LD)
+{
+  return (R <= 0 || C <= 0) ? 0 : LD*(C-1) + R;
+}
+
+template <typename T>
+void linal_gemm(const bool TRANSA, const int M, const int N, const int K,
+                const T ALPHA, const T* A, const int LDA, const T* B, const int LDB, 
+                const T BETA, T* C, const int LDC)
+{
+  if (LDA < std::max(1,TRANSA ? K : M) || LDB < std::max(1,K) || LDC < std::max(1,M))
+  {
+    printf("ERROR linal_gemm bad leading dimension, LDA %d LDB %d LDC %d for M %d N %d K %d\n",
+           LDA,LDB,LDC,M,N,K);
+    exit(1);
+  }
+  #if defined (LIBJ_CHECKED)
+  const long SA = TRANSA ? linal_gemm_span(K,M,LDA) : linal_gemm_span(M,K,LDA);
+  const long SB = linal_gemm_span(K,N,LDB);
+  const long SC = linal_gemm_span(M,N,LDC);
+  LIBJ_CHECK_NOALIAS(A,SA,C,SC);
+  LIBJ_CHECK_NOALIAS(B,SB,C,SC);
+  #endif
+  if (!linal_blas_gemm(TRANSA,M,N,K,ALPHA,A,LDA,B,LDB,BETA,C,LDC))
+  {
+    linal_gemm_drv<T>(TRANSA ? LINAL_GEMM_OPA_T : LINAL_GEMM_OPA_N,M,N,K,ALPHA,A,LDA,NULL,
+                      B,LDB,BETA,C,LDC);
+  }
+  #if defined (LIBJ_CHECKED)
+  for (long j=0;j<N;j++) {LIBJ_CHECK_FINITE(C+(long) LDC*j,M);}
+  #endif
+}
+
+template <typename T>
+void linal_gemm(const bool TRANSA, const int M, const int N, const int K,
+                const T ALPHA, const T* A, const T* B, const T BETA, T* C)
+{
+  linal_gemm<T>(TRANSA,M,N,K,ALPHA,A,std::max(1,TRANSA ? K : M),B,std::max(1,K),
+                BETA,C,std::max(1,M));
+}
+
+template <typename T>
+void linal_gemm_diag(const bool TRANSA, const int M, const int N, const int K,
+                     const T ALPHA, const T* A, const T* D, const T* B, const T BETA, T* C)
+{
+  LIBJ_CHECK_NOALIAS(A,(long) M*K,C,(long) M*N);
+  LIBJ_CHECK_NOALIAS(D,K,C,(long) M*N);
+  LIBJ_CHECK_NOALIAS(B,(long) K*N,C,(long) M*N);
+  linal_gemm_drv<T>(TRANSA ? LINAL_GEMM_OPA_T : LINAL_GEMM_OPA_N,M,N,K,ALPHA,A,
+                    TRANSA ? K : M,D,B,K,BETA,C,M);
+  LIBJ_CHECK_FINITE(C,(long) M*N);
+}
+
+template <typename T>
+void linal_gemm_usym(const long M, const long N, const T ALPHA, const T* U,
+                     const T* B, const T BETA, T* C)
+{
+  LIBJ_CHECK_NOALIAS(U,M*(M+1)/2,C,M*N);
+  LIBJ_CHECK_NOALIAS(B,M*N,C,M*N);
+  if (!linal_blas_usym(M,N,ALPHA,U,B,BETA,C))
+  {
+    linal_gemm_drv<T>(LINAL_GEMM_OPA_USYM,(int) M,(int) N,(int) M,ALPHA,U,M,NULL,B,M,BETA,C,M);
+  }
+  LIBJ_CHECK_FINITE(C,M*N);
+}
+
+template void linal_gemm<double>(const bool TRANSA, const int M, const int N, const int K,
+                                 const double ALPHA, const double* A, const double* B,
+                                 const double BETA, double* C);
+template void linal_gemm<float>(const bool TRANSA, const int M, const int N, const int K,
+                                const float ALPHA, const float* A, const float* B,
+                                const float BETA, float* C);
+template void linal_gemm<double>(const bool TRANSA, const int M, const int N, const int K,
+                                 const double ALPHA, const double* A, const int LDA,
+                                 const double* B, const int LDB, const double BETA,
+                                 double* C, const int LDC);
+template void linal_gemm<float>(const bool TRANSA, const int M, const int N, const int K,
+                                const float ALPHA, const float* A, const int LDA,
+                                const float* B, const int LDB, const float BETA,
+                                float* C, const int LDC);
+template void linal_gemm_usym<double>(const long M, const long N, const double ALPHA, const double* U,
+                                      const double* B, const double BETA, double* C);
+template void linal_gemm_usym<float>(const long M, const long N, const float ALPHA, const float* U,
+                                     const float* B, const float BETA, float* C);
+template void linal_gemm_diag<double>(const bool TRANSA, const int M, const int N, const int K,
+                                      const double ALPHA, const double* A, const double* D,
+                                      const double* B, const double BETA, double* C);
+template void linal_gemm_diag<float>(const bool TRANSA, const int M, const int N, const int K,
+                                     const float ALPHA, const float* A, const float* D,
+                                     const float* B, const float BETA, float* C);
@@ -0,0 +1,59 @@
+/*------------------------------------------------
+  linal_gemm.hpp
+        JHT, October 14, 2026 : created
+        JHT, October 14, 2026 : leading dimensions
+
+    C = ALPHA*op(A).B + BETA*C
+
+    op(A) = A   (TRANSA == false), A is MxK
+    op(A) = A^T (TRANSA == true),  A is KxM
+
+    linal_gemm_usym : C = ALPHA*U.B + BETA*C
+    U is MxM upper symmetric, with only the upper
+    triangle stored (packed), B and C are MxN
+
+    linal_gemm_diag : C = ALPHA*op(A).D.B + BETA*C
+    D is a KxK diagonal matrix, stored as its K
+    diagonal elements. D is applied while op(A)
+    is packed, and is always done natively
+
+    Blocked, packed matrix multiply for double
+    and float, used by linal_ABpC, linal_ATBpC,
+    and the linal_*U* routines for the larger
+    matrices.
+
+    It is assumed that C,A,and B are all
+    continous in memory and coloumn major.
+    Logical dimension == physical dimension,
+    except for the linal_gemm with LDA, LDB, and
+    LDC, the BLAS leading dimensions, which can
+    work in place on sub-matrices (panels) of
+    larger matrices (see gemat::view)
+------------------------------------------------*/
+#ifndef LINAL_GEMM_HPP
+#define LINAL_GEMM_HPP
+
+#include "linal_def.hpp"
+
+template <typename T>
+void linal_gemm(const bool TRANSA, const int M, const int N, const int K,
+                const T ALPHA, const T* A,
+                const T* B, const T BETA,
+                T* C);
+
+template <typename T>
+void linal_gemm(const bool TRANSA, const int M, const int N, const int K,
+                const T ALPHA, const T* A, const int LDA,
+                const T* B, const int LDB, const T BETA,
+                T* C, const int LDC);
+
+template <typename T>
+void linal_gemm_usym(const long M, const long N, const T ALPHA, const T* U,
+                     const T* B, const T BETA, T* C);
+
+template <typename T>
+void linal_gemm_diag(const bool TRANSA, const int M, const int N, const int K,
+                     const T ALPHA, const T* A, const T* D,
+                     const T* B, const T BETA, T* C);
+
+#endif
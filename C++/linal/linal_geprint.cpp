@@ -1,21 +1,43 @@
 /*--------------------------------------------------------
   linal_geprint.cpp
 	JHT, December 30, 2021 : created
+	JHT, October 14, 2026 : buffered, and linal_dgedump
 
   .cpp file for printing general matrices that are 
   stored column major
 --------------------------------------------------------*/
+#include <vector>
 #include "linal_geprint.hpp"
+#include "array_print.hpp"
+#include "tensor_file.hpp"
 void linal_dgeprint(const long M, const long N, const double* A, const long LDA)
 {
+  array_print out;
   for (long i=0;i<M;i++) 
   {
     for (long j=0;j<N;j++)
     {
-      printf("%18.15E  ",*(A+LDA*j));
+      out.num(*(A+LDA*j));
+      out.put("  ");
     } 
-    printf("\n");
+    out.put('\n');
     A++;
   }
 }
 
+void linal_dgedump(const char* name, const long M, const long N, const double* A, const long LDA)
+{
+  std::vector<size_t> LEN(2), STR(2);
+  LEN[0] = M;
+  LEN[1] = N;
+  STR[0] = 1;
+  STR[1] = LDA;
+  libj::tensor<double> T;
+  T.assign(const_cast<double*>(A),LEN,STR);
+  libj::tensor_file<double>::save(name,T,(size_t) LDA);
+}
+
+void linal_dgedump(const char* name, const gemat<double>& A)
+{
+  linal_dgedump(name,A.rows(),A.cols(),A.data(),A.ld());
+}
@@ -1,12 +1,24 @@
 /*--------------------------------------------------------
   linal_geprint.hpp
 	JHT, December 30, 2021 : created
+	JHT, October 14, 2026 : buffered, and linal_dgedump
 
   .hpp file for printing general matrices that are 
   stored column major
+
+  linal_dgeprint : the MxN matrix A, one row per line,
+    formatted into a large buffer (array_print.hpp)
+    and written in big chunks
+  linal_dgedump  : A to the binary file name, as a
+    libj::tensor_file of lengths {M,N} and strides
+    {1,LDA}, one block per column, so it can be
+    mapped back with tensor_file::open and view()
 --------------------------------------------------------*/
 #ifndef LINAL_GEPRINT_HPP
 #define LINAL_GEPRINT_HPP
 #include <stdio.h>
+#include "gemat.hpp"
 void linal_dgeprint(const long M, const long N, const double* A, const long LDA);
+void linal_dgedump(const char* name, const long M, const long N, const double* A, const long LDA);
+void linal_dgedump(const char* name, const gemat<double>& A);
 #endif
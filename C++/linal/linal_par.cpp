@@ -0,0 +1,361 @@
+/*------------------------------------------------
+  linal_par.cpp
+        JHT, October 14, 2026 : created
+
+    OpenMP threaded versions of the linal_*
+    routines, see linal_par.hpp
+
+    Each thread gets one static block of columns
+    of the output. For C(:,j0:j1) = op(A).B(:,j0:j1)
+    the serial routine is just called on the
+    sub-matrices, as B and C are column major.
+------------------------------------------------*/
+#include "linal_par.hpp"
+#include "linal_ABpC.hpp"
+#include "linal_ATBpC.hpp"
+#include "linal_DApB.hpp"
+#include "linal_DATpB.hpp"
+#include "linal_ATDApU.hpp"
+#include "linal_ATApU.hpp"
+#include "linal_gemm.hpp"
+#include "libjdef.h"
+#include "simd_machine.hpp"
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+/*------------------------------------------------
+  fewest flops to use threads for, measured for 
+  this machine if it has been
+------------------------------------------------*/
+static inline double linal_par_min_flops()
+{
+  const double flops = libj::MachineProfile::get().par_min_flops;
+  return (flops > 0.0) ? flops : (double) LINAL_PAR_MIN_FLOPS;
+}
+
+/*------------------------------------------------
+  number of threads to use for FLOPS of work
+------------------------------------------------*/
+static inline int linal_par_nthr(const int NTHR, const double FLOPS)
+{
+  #if defined (_OPENMP)
+    if (omp_in_parallel() || FLOPS < linal_par_min_flops()) return 1;
+    return (NTHR > 0) ? NTHR : omp_get_max_threads();
+  #else
+    return 1;
+  #endif
+}
+
+/*------------------------------------------------
+  columns J0:J1 of an MxN matrix for thread TID,
+  in units of G columns so that each block starts
+  on a cache line
+------------------------------------------------*/
+template <typename T>
+static inline void linal_par_cols(const long M, const long N, const int TID, const int NTHR,
+                                  long& J0, long& J1)
+{
+  long a = M*(long) sizeof(T);
+  long b = LIBJ_LINE_BYTES;
+  while (b != 0) {const long r = a%b; a = b; b = r;}
+  const long G      = (a > 0) ? LIBJ_LINE_BYTES/a : 1;
+  const long NUNITS = (N + G - 1)/G;
+  const long PER    = NUNITS/NTHR;
+  const long REM    = NUNITS%NTHR;
+  const long U0     = TID*PER + ((TID < REM) ? TID : REM);
+  const long NU     = PER + ((TID < REM) ? 1 : 0);
+  J0 = std::min(U0*G,N);
+  J1 = std::min((U0+NU)*G,N);
+}
+
+/*------------------------------------------------
+  columns of a packed NxN upper triangle for
+  thread TID, with equal work (col j has j+1
+  elements), moved forward to a cache line
+------------------------------------------------*/
+template <typename T>
+static inline long linal_par_uedge(const long N, const int T_, const int NTHR)
+{
+  if (T_ <= 0) return 0;
+  if (T_ >= NTHR) return N;
+  long j = (long) std::floor((double) N*std::sqrt((double) T_/(double) NTHR) + 0.5);
+  const long WLINE = (LIBJ_LINE_BYTES >= (long) sizeof(T)) ? LIBJ_LINE_BYTES/sizeof(T) : 1;
+  for (long s=0;s<2*WLINE && j<N;s++)
+  {
+    if (((j*(j+1))/2)%WLINE == 0) break;
+    j++;
+  }
+  return std::min(j,N);
+}
+
+template <typename T>
+static inline void linal_par_ucols(const long N, const int TID, const int NTHR,
+                                   long& J0, long& J1)
+{
+  J0 = linal_par_uedge<T>(N,TID,NTHR);
+  J1 = linal_par_uedge<T>(N,TID+1,NTHR);
+  if (J1 < J0) J1 = J0;
+}
+
+/*------------------------------------------------
+  ABpC
+------------------------------------------------*/
+template <typename T>
+void linal_par_ABpC(const int M, const int N, const int K, const T ALPHA, T* A,
+                    T* B, const T BETA, T* C, const int NTHR)
+{
+  const int nthr = linal_par_nthr(NTHR,2.0*M*N*K);
+  #if defined (_OPENMP)
+  if (nthr > 1)
+  {
+    #pragma omp parallel num_threads(nthr)
+    {
+      long j0,j1;
+      linal_par_cols<T>(M,N,omp_get_thread_num(),omp_get_num_threads(),j0,j1);
+      if (j1 > j0) linal_ABpC<T>(M,(int) (j1-j0),K,ALPHA,A,B+(long)K*j0,BETA,C+(long)M*j0);
+    }
+    return;
+  }
+  #endif
+  linal_ABpC<T>(M,N,K,ALPHA,A,B,BETA,C);
+}
+template void linal_par_ABpC<double>(const int M, const int N, const int K, const double ALPHA,
+                                     double* A, double* B, const double BETA, double* C, const int NTHR);
+template void linal_par_ABpC<float>(const int M, const int N, const int K, const float ALPHA,
+                                    float* A, float* B, const float BETA, float* C, const int NTHR);
+template void linal_par_ABpC<long>(const int M, const int N, const int K, const long ALPHA,
+                                   long* A, long* B, const long BETA, long* C, const int NTHR);
+template void linal_par_ABpC<int>(const int M, const int N, const int K, const int ALPHA,
+                                  int* A, int* B, const int BETA, int* C, const int NTHR);
+
+/*------------------------------------------------
+  ATBpC
+------------------------------------------------*/
+template <typename T>
+void linal_par_ATBpC(const int M, const int N, const int K, const T ALPHA, T* A,
+                     T* B, const T BETA, T* C, const int NTHR)
+{
+  const int nthr = linal_par_nthr(NTHR,2.0*M*N*K);
+  #if defined (_OPENMP)
+  if (nthr > 1)
+  {
+    #pragma omp parallel num_threads(nthr)
+    {
+      long j0,j1;
+      linal_par_cols<T>(M,N,omp_get_thread_num(),omp_get_num_threads(),j0,j1);
+      if (j1 > j0) linal_ATBpC<T>(M,(int) (j1-j0),K,ALPHA,A,B+(long)K*j0,BETA,C+(long)M*j0);
+    }
+    return;
+  }
+  #endif
+  linal_ATBpC<T>(M,N,K,ALPHA,A,B,BETA,C);
+}
+template void linal_par_ATBpC<double>(const int M, const int N, const int K, const double ALPHA,
+                                      double* A, double* B, const double BETA, double* C, const int NTHR);
+template void linal_par_ATBpC<float>(const int M, const int N, const int K, const float ALPHA,
+                                     float* A, float* B, const float BETA, float* C, const int NTHR);
+template void linal_par_ATBpC<long>(const int M, const int N, const int K, const long ALPHA,
+                                    long* A, long* B, const long BETA, long* C, const int NTHR);
+template void linal_par_ATBpC<int>(const int M, const int N, const int K, const int ALPHA,
+                                   int* A, int* B, const int BETA, int* C, const int NTHR);
+
+/*------------------------------------------------
+  DApB
+------------------------------------------------*/
+template <typename T>
+void linal_par_DApB(const long M, const long N, const T ALPHA, const T* D,
+                    const T* A, const T BETA, T* B, const int NTHR)
+{
+  const int nthr = linal_par_nthr(NTHR,2.0*M*N);
+  #if defined (_OPENMP)
+  if (nthr > 1)
+  {
+    #pragma omp parallel num_threads(nthr)
+    {
+      long j0,j1;
+      linal_par_cols<T>(M,N,omp_get_thread_num(),omp_get_num_threads(),j0,j1);
+      if (j1 > j0) linal_DApB<T>(M,j1-j0,ALPHA,D,A+M*j0,BETA,B+M*j0);
+    }
+    return;
+  }
+  #endif
+  linal_DApB<T>(M,N,ALPHA,D,A,BETA,B);
+}
+template void linal_par_DApB<double>(const long M, const long N, const double ALPHA, const double* D,
+                                     const double* A, const double BETA, double* B, const int NTHR);
+template void linal_par_DApB<float>(const long M, const long N, const float ALPHA, const float* D,
+                                    const float* A, const float BETA, float* B, const int NTHR);
+template void linal_par_DApB<long>(const long M, const long N, const long ALPHA, const long* D,
+                                   const long* A, const long BETA, long* B, const int NTHR);
+template void linal_par_DApB<int>(const long M, const long N, const int ALPHA, const int* D,
+                                  const int* A, const int BETA, int* B, const int NTHR);
+
+/*------------------------------------------------
+  DATpB
+    A is NxM, so column j of B is row j of A,
+    and the serial routine can not be called on
+    a block of columns directly
+------------------------------------------------*/
+template <typename T>
+static void linal_par_DATpB_cols(const long M, const long N, const long J0, const long J1,
+                                 const T ALPHA, const T* D, const T* A, const T BETA, T* B)
+{
+  for (long j=J0;j<J1;j++)
+  {
+    const T* AP = A+j;
+    T* BP = B+M*j;
+    if (BETA == (T) 0)
+    {
+      for (long i=0;i<M;i++) *(BP+i) = ALPHA * *(D+i) * *(AP+N*i);
+    } else {
+      for (long i=0;i<M;i++) *(BP+i) = ALPHA * *(D+i) * *(AP+N*i) + BETA * *(BP+i);
+    }
+  }
+}
+
+template <typename T>
+void linal_par_DATpB(const long M, const long N, const T ALPHA, const T* D,
+                     const T* A, const T BETA, T* B, const int NTHR)
+{
+  const int nthr = linal_par_nthr(NTHR,2.0*M*N);
+  #if defined (_OPENMP)
+  if (nthr > 1)
+  {
+    #pragma omp parallel num_threads(nthr)
+    {
+      long j0,j1;
+      linal_par_cols<T>(M,N,omp_get_thread_num(),omp_get_num_threads(),j0,j1);
+      linal_par_DATpB_cols<T>(M,N,j0,j1,ALPHA,D,A,BETA,B);
+    }
+    return;
+  }
+  #endif
+  linal_DATpB<T>(M,N,ALPHA,D,A,BETA,B);
+}
+template void linal_par_DATpB<double>(const long M, const long N, const double ALPHA, const double* D,
+                                      const double* A, const double BETA, double* B, const int NTHR);
+template void linal_par_DATpB<float>(const long M, const long N, const float ALPHA, const float* D,
+                                     const float* A, const float BETA, float* B, const int NTHR);
+template void linal_par_DATpB<long>(const long M, const long N, const long ALPHA, const long* D,
+                                    const long* A, const long BETA, long* B, const int NTHR);
+template void linal_par_DATpB<int>(const long M, const long N, const int ALPHA, const int* D,
+                                   const int* A, const int BETA, int* B, const int NTHR);
+
+/*------------------------------------------------
+  ATApU and ATDApU
+    cols J0:J1 of U, in panels of up to 64 cols.
+    W(0:p1,:) = ALPHA*A(:,0:p1)^T.[D].A(:,p0:p1)
+    is done with linal_gemm(_diag) for doubles 
+    and floats. D is NULL for ATApU
+------------------------------------------------*/
+template <typename T>
+static inline void linal_par_ATA_panel(const long P1, const long NB, const long K, const T ALPHA,
+                                       const T* A, const T* D, const T* AJ, T* W)
+{
+  for (long j=0;j<NB;j++)
+  {
+    for (long i=0;i<P1;i++)
+    {
+      *(W+P1*j+i) = (D == NULL) ? ALPHA*simd_dot<T>(K,A+K*i,AJ+K*j)
+                                : ALPHA*simd_dotwxy<T>(K,A+K*i,D,AJ+K*j);
+    }
+  }
+}
+
+static inline void linal_par_ATA_panel(const long P1, const long NB, const long K, const double ALPHA,
+                                       const double* A, const double* D, const double* AJ, double* W)
+{
+  if (D == NULL) {linal_gemm<double>(true,P1,NB,K,ALPHA,A,AJ,0.0,W);}
+  else {linal_gemm_diag<double>(true,P1,NB,K,ALPHA,A,D,AJ,0.0,W);}
+}
+
+static inline void linal_par_ATA_panel(const long P1, const long NB, const long K, const float ALPHA,
+                                       const float* A, const float* D, const float* AJ, float* W)
+{
+  if (D == NULL) {linal_gemm<float>(true,P1,NB,K,ALPHA,A,AJ,0.0f,W);}
+  else {linal_gemm_diag<float>(true,P1,NB,K,ALPHA,A,D,AJ,0.0f,W);}
+}
+
+template <typename T>
+static void linal_par_ATA_cols(const long K, const long J0, const long J1, const T ALPHA,
+                               const T* A, const T* D, const T BETA, T* U)
+{
+  const long NB = 64;
+  std::vector<T> W(J1*NB);
+  for (long p0=J0;p0<J1;p0+=NB)
+  {
+    const long nb = std::min(NB,J1-p0);
+    const long p1 = p0 + nb;
+    linal_par_ATA_panel(p1,nb,K,ALPHA,A,D,A+K*p0,W.data());
+    for (long j=p0;j<p1;j++)
+    {
+      T* UJ = U + (j*(j+1))/2;
+      const T* WJ = W.data() + p1*(j-p0);
+      if (BETA == (T) 0) {simd_copy<T>(j+1,WJ,UJ);}
+      else {simd_axpby<T>(j+1,(T) 1,WJ,BETA,UJ);}
+    }
+  }
+}
+
+/*------------------------------------------------
+  ATDApU
+------------------------------------------------*/
+template <typename T>
+void linal_par_ATDApU(const long M, const long N, const T* A, const T ALPHA,
+                      const T* D, const T BETA, T* U, const int NTHR)
+{
+  const int nthr = linal_par_nthr(NTHR,1.5*M*M*N);
+  #if defined (_OPENMP)
+  if (nthr > 1)
+  {
+    #pragma omp parallel num_threads(nthr)
+    {
+      long j0,j1;
+      linal_par_ucols<T>(M,omp_get_thread_num(),omp_get_num_threads(),j0,j1);
+      if (j1 > j0) linal_par_ATA_cols<T>(N,j0,j1,ALPHA,A,D,BETA,U);
+    }
+    return;
+  }
+  #endif
+  linal_ATDApU<T>(M,N,A,ALPHA,D,BETA,U);
+}
+template void linal_par_ATDApU<double>(const long M, const long N, const double* A, const double ALPHA,
+                                       const double* D, const double BETA, double* U, const int NTHR);
+template void linal_par_ATDApU<float>(const long M, const long N, const float* A, const float ALPHA,
+                                      const float* D, const float BETA, float* U, const int NTHR);
+template void linal_par_ATDApU<long>(const long M, const long N, const long* A, const long ALPHA,
+                                     const long* D, const long BETA, long* U, const int NTHR);
+template void linal_par_ATDApU<int>(const long M, const long N, const int* A, const int ALPHA,
+                                    const int* D, const int BETA, int* U, const int NTHR);
+
+/*------------------------------------------------
+  ATApU
+------------------------------------------------*/
+template <typename T>
+void linal_par_ATApU(const long N, const long K, const T ALPHA, const T* A,
+                     const T BETA, T* U, const int NTHR)
+{
+  const int nthr = linal_par_nthr(NTHR,1.0*N*N*K);
+  #if defined (_OPENMP)
+  if (nthr > 1)
+  {
+    #pragma omp parallel num_threads(nthr)
+    {
+      long j0,j1;
+      linal_par_ucols<T>(N,omp_get_thread_num(),omp_get_num_threads(),j0,j1);
+      if (j1 > j0) linal_par_ATA_cols<T>(K,j0,j1,ALPHA,A,(const T*) NULL,BETA,U);
+    }
+    return;
+  }
+  #endif
+  linal_ATApU<T>(N,K,ALPHA,A,BETA,U);
+}
+template void linal_par_ATApU<double>(const long N, const long K, const double ALPHA, const double* A,
+                                      const double BETA, double* U, const int NTHR);
+template void linal_par_ATApU<float>(const long N, const long K, const float ALPHA, const float* A,
+                                     const float BETA, float* U, const int NTHR);
+template void linal_par_ATApU<long>(const long N, const long K, const long ALPHA, const long* A,
+                                    const long BETA, long* U, const int NTHR);
+template void linal_par_ATApU<int>(const long N, const long K, const int ALPHA, const int* A,
+                                   const int BETA, int* U, const int NTHR);
@@ -0,0 +1,71 @@
+/*------------------------------------------------
+  linal_par.hpp
+        JHT, October 14, 2026 : created
+
+    OpenMP threaded versions of the linal_* 
+    routines, for the larger matrices
+
+    The output matrix is split into one block of
+    contiguous columns per thread, and each thread
+    calls the serial routine (or its loops) on its
+    block, so the results are the same as the
+    serial routine.
+
+    For the rectangular outputs, the block edges
+    are placed so that each block starts on a new
+    cache line (if M*sizeof(T) allows it), and so 
+    threads do not share lines of C. For the packed
+    upper triangular outputs, where column j has 
+    j+1 elements, the blocks are chosen to have
+    equal work, and then moved to the next column
+    that starts a cache line.
+
+    NTHR is the number of threads to use. If 
+    NTHR <= 0, omp_get_max_threads() is used. If
+    compiled without OpenMP, called from inside a
+    parallel region, or if there are fewer than
+    libj::MachineProfile::get().par_min_flops (see 
+    simd_machine.hpp, LINAL_PAR_MIN_FLOPS if not
+    measured), the serial code is used.
+
+    linal_par_ABpC    : see linal_ABpC.hpp
+    linal_par_ATBpC   : see linal_ATBpC.hpp
+    linal_par_DApB    : see linal_DApB.hpp
+    linal_par_DATpB   : see linal_DATpB.hpp
+    linal_par_ATDApU  : see linal_ATDApU.hpp
+    linal_par_ATApU   : see linal_ATApU.hpp
+------------------------------------------------*/
+#ifndef LINAL_PAR_HPP
+#define LINAL_PAR_HPP
+
+#include "linal_def.hpp"
+
+#if defined (_OPENMP)
+  #include <omp.h>
+#endif
+
+template <typename T>
+void linal_par_ABpC(const int M, const int N, const int K, const T ALPHA, T* A,
+                    T* B, const T BETA, T* C, const int NTHR=0);
+
+template <typename T>
+void linal_par_ATBpC(const int M, const int N, const int K, const T ALPHA, T* A,
+                     T* B, const T BETA, T* C, const int NTHR=0);
+
+template <typename T>
+void linal_par_DApB(const long M, const long N, const T ALPHA, const T* D,
+                    const T* A, const T BETA, T* B, const int NTHR=0);
+
+template <typename T>
+void linal_par_DATpB(const long M, const long N, const T ALPHA, const T* D,
+                     const T* A, const T BETA, T* B, const int NTHR=0);
+
+template <typename T>
+void linal_par_ATDApU(const long M, const long N, const T* A, const T ALPHA,
+                      const T* D, const T BETA, T* U, const int NTHR=0);
+
+template <typename T>
+void linal_par_ATApU(const long N, const long K, const T ALPHA, const T* A,
+                     const T BETA, T* U, const int NTHR=0);
+
+#endif
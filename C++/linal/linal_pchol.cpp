@@ -0,0 +1,156 @@
+/*-------------------------------------------------
+  linal_pchol.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for the pivoted Cholesky decomposition,
+  see linal_pchol.hpp
+-------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <algorithm>
+#include "linal_pchol.hpp"
+#include "linal_par.hpp"
+
+/*-------------------------------------------------
+  number of threads to use for FLOPS of work
+-------------------------------------------------*/
+static inline int linal_pchol_nthr(const double FLOPS)
+{
+  #if defined (_OPENMP)
+    if (omp_in_parallel() || FLOPS < (double) LINAL_PAR_MIN_FLOPS) return 1;
+    return omp_get_max_threads();
+  #else
+    return 1;
+  #endif
+}
+
+/*-------------------------------------------------
+  linal_dpchol (columns on demand)
+	- D is the residual diagonal, and L the
+	  vectors so far, NxK column major, which
+	  grows by a column for each pivot
+-------------------------------------------------*/
+long linal_dpchol(const long N, const double* DIAG,
+                  const std::function<void(const long J, double* COL)>& COLUMN,
+                  const double TOL, gemat<double>& L, std::vector<long>& PIV,
+                  const long MAXRANK)
+{
+  if (N < 0 || TOL < 0)
+  {
+    printf("linal_dpchol : bad input, N = %ld, TOL = %e \n",N,TOL);
+    exit(1);
+  }
+  const long KMAX = (MAXRANK > 0) ? std::min(MAXRANK,N) : N;
+  std::vector<double> D(DIAG,DIAG+N);
+  std::vector<double> LBUF, Q, GT;
+  std::vector<char> used(N,0), done;
+  std::vector<long> cand;
+  PIV.clear();
+  long K = 0;
+
+  while (K < KMAX)
+  {
+    double dmax = 0;
+    for (long i=0;i<N;i++) {if (!used[i] && D[i] > dmax) dmax = D[i];}
+    if (dmax <= TOL) break;
+
+    //candidates, the largest diagonals in the span
+    const double dmin = std::max(TOL,LINAL_PCHOL_SPAN*dmax);
+    cand.clear();
+    for (long i=0;i<N;i++) {if (!used[i] && D[i] > dmin) cand.push_back(i);}
+    const long NQ = std::min((long) cand.size(),std::min((long) LINAL_PCHOL_NB,KMAX-K));
+    std::partial_sort(cand.begin(),cand.begin()+NQ,cand.end(),
+                      [&D](const long a, const long b) {return D[a] > D[b];});
+    cand.resize(NQ);
+
+    //their columns, less the vectors so far
+    Q.resize(N*NQ);
+    for (long c=0;c<NQ;c++) COLUMN(cand[c],Q.data()+c*N);
+    if (K > 0)
+    {
+      GT.resize(K*NQ);
+      for (long c=0;c<NQ;c++)
+      {
+        for (long k=0;k<K;k++) GT[k+c*K] = LBUF[cand[c]+k*N];
+      }
+      linal_par_ABpC<double>(N,NQ,K,-1.0,LBUF.data(),GT.data(),1.0,Q.data());
+    }
+    for (long c=0;c<NQ;c++) D[cand[c]] = Q[cand[c]+c*N];
+
+    //pivots from the candidates, while they stay in the span
+    done.assign(NQ,0);
+    const int nthr = linal_pchol_nthr(2.0*N*NQ);
+    while (K < KMAX)
+    {
+      long p = -1;
+      double dp = dmin;
+      for (long c=0;c<NQ;c++) {if (!done[c] && D[cand[c]] > dp) {p = c; dp = D[cand[c]];}}
+      if (p < 0) break;
+
+      const long J = cand[p];
+      const double s = 1.0/sqrt(dp);
+      done[p] = 1;
+      LBUF.resize(N*(K+1));
+      double* LK = LBUF.data() + K*N;
+      const double* QP = Q.data() + p*N;
+      for (long i=0;i<N;i++) LK[i] = used[i] ? 0.0 : QP[i]*s;
+      LK[J] = sqrt(dp);
+      used[J] = 1;
+      for (long i=0;i<N;i++) D[i] -= LK[i]*LK[i];
+      D[J] = 0;
+
+      //the rest of the candidates
+      #pragma omp parallel for schedule(static) num_threads(nthr) if(nthr > 1)
+      for (long c=0;c<NQ;c++)
+      {
+        if (done[c]) continue;
+        double* QC = Q.data() + c*N;
+        const double lc = LK[cand[c]];
+        #pragma omp simd
+        for (long i=0;i<N;i++) QC[i] -= lc*LK[i];
+      }
+      PIV.push_back(J);
+      K++;
+    }
+  }
+
+  if (L.is_allocated()) L.deallocate();
+  L.allocate(N,K);
+  std::copy(LBUF.begin(),LBUF.begin()+N*K,L.data());
+  return K;
+}
+
+/*-------------------------------------------------
+  linal_dpchol (dense)
+-------------------------------------------------*/
+long linal_dpchol(const long N, const double* A, const long LDA, const double TOL,
+                  gemat<double>& L, std::vector<long>& PIV, const long MAXRANK)
+{
+  std::vector<double> DIAG(N);
+  for (long i=0;i<N;i++) DIAG[i] = A[i+i*LDA];
+  return linal_dpchol(N,DIAG.data(),
+                      [&](const long J, double* COL) {std::copy(A+J*LDA,A+J*LDA+N,COL);},
+                      TOL,L,PIV,MAXRANK);
+}
+
+/*-------------------------------------------------
+  linal_dpchol (usymat)
+	- column J is the packed column J down to the
+	  diagonal, and row J of the upper triangle
+	  after it
+-------------------------------------------------*/
+long linal_dpchol(const usymat<double>& A, const double TOL, gemat<double>& L,
+                  std::vector<long>& PIV, const long MAXRANK)
+{
+  const long N = A.rows();
+  std::vector<double> DIAG(N);
+  for (long i=0;i<N;i++) DIAG[i] = A(i,i);
+  return linal_dpchol(N,DIAG.data(),
+                      [&](const long J, double* COL)
+                      {
+                        for (long i=0;i<=J;i++) COL[i] = A(i,J);
+                        for (long i=J+1;i<N;i++) COL[i] = A(J,i);
+                      },
+                      TOL,L,PIV,MAXRANK);
+}
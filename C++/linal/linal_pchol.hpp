@@ -0,0 +1,86 @@
+/*-------------------------------------------------
+  linal_pchol.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for the pivoted (incomplete) Cholesky
+  decomposition of a positive semidefinite matrix
+
+  A ~ L . L^T
+
+  A is NxN, and L is NxRANK. The pivots are taken
+  largest residual diagonal first, and it stops
+  once every residual diagonal is <= TOL, so
+
+    max |A - L.L^T| <= TOL
+
+  or at MAXRANK vectors, if MAXRANK > 0. Column
+  k of L is the Cholesky vector of pivot PIV[k].
+  On exit L is (re)allocated, and RANK returned.
+
+  The decomposition is blocked. Each step takes
+  up to LINAL_PCHOL_NB of the largest residual
+  diagonals that are at least LINAL_PCHOL_SPAN
+  times the largest, gets their columns of A,
+  and subtracts the vectors so far from them
+  with one (threaded) linal_par_ABpC. The pivots
+  are then taken from these columns, one by one,
+  while their residual diagonals stay in the
+  span. Only the columns of these candidates
+  are ever needed, so A does not have to be
+  stored at all:
+
+  linal_dpchol(N,A,LDA,...)   : dense A
+  linal_dpchol(A,...)         : packed usymat A
+  linal_dpchol(N,DIAG,COLUMN,...) : the diagonal
+    of A, and a function
+
+      COLUMN(J,COL)  // COL[0:N] = A(:,J)
+
+    which is called once for each candidate, e.g.,
+    to make the columns of the two-electron
+    integrals (ij|kl) as they are needed
+
+  The work is O(N RANK^2) and the memory O(N RANK),
+  in place of the O(N^2) of A.
+
+Parameters
+N	long		rows and cols of A
+A	const double*	matrix A, or usymat<double>
+LDA	long		leading dimension of A
+DIAG	const double*	diagonal of A (N)
+COLUMN	function	returns column J of A
+TOL	double		largest residual diagonal
+L	gemat<double>&	Cholesky vectors (NxRANK)
+PIV	vector<long>&	pivot of each vector (RANK)
+MAXRANK	long		most vectors, 0 for N
+-------------------------------------------------*/
+#ifndef LINAL_PCHOL_HPP
+#define LINAL_PCHOL_HPP
+#include <vector>
+#include <functional>
+#include "linal_def.hpp"
+#include "gemat.hpp"
+#include "usymat.hpp"
+
+//candidate pivots per block
+#if !defined (LINAL_PCHOL_NB)
+  #define LINAL_PCHOL_NB 64
+#endif
+
+//smallest candidate diagonal, relative to the largest
+#if !defined (LINAL_PCHOL_SPAN)
+  #define LINAL_PCHOL_SPAN 1.0e-2
+#endif
+
+long linal_dpchol(const long N, const double* DIAG,
+                  const std::function<void(const long J, double* COL)>& COLUMN,
+                  const double TOL, gemat<double>& L, std::vector<long>& PIV,
+                  const long MAXRANK=0);
+
+long linal_dpchol(const long N, const double* A, const long LDA, const double TOL,
+                  gemat<double>& L, std::vector<long>& PIV, const long MAXRANK=0);
+
+long linal_dpchol(const usymat<double>& A, const double TOL, gemat<double>& L,
+                  std::vector<long>& PIV, const long MAXRANK=0);
+
+#endif
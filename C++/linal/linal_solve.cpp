@@ -0,0 +1,191 @@
+/*-------------------------------------------------
+  linal_solve.cpp
+	JHT, October 14, 2026 : created
+	JHT, October 14, 2026 : check the conversions to float
+
+  .cpp file for the mixed precision solution of
+  A.X = B, see linal_solve.hpp
+
+  The float factors (N*N) and the float right
+  hand sides (N*NRHS) are held in the Core<double>
+  two per element, and the pivots as ints. 
+
+  Workspace (in doubles)
+    AS     N*N/2         float factors of A
+    RS     N*NRHS/2      float residuals
+    IPIV   N/2           pivots
+    R      N*NRHS        double residuals
+    AD     N*N           double factors, only if 
+                         the refinement fails
+-------------------------------------------------*/
+#include "linal_solve.hpp"
+#include "linal_ABpC.hpp"
+#include "simd.hpp"
+#include <cmath>
+#include <cfloat>
+
+//number of doubles that hold n elements of size BYTES
+static inline long linal_solve_nd(const long n, const long BYTES)
+{
+  return (n*BYTES + (long) sizeof(double) - 1)/(long) sizeof(double);
+}
+
+long linal_dsolve_NWORK(const long N, const long NRHS)
+{
+  return linal_solve_nd(N*N,sizeof(float)) + linal_solve_nd(N*NRHS,sizeof(float))
+       + linal_solve_nd(N,sizeof(int)) + N*NRHS + N*N;
+}
+
+//infinity norm of A (NxN), max row sum
+static double linal_solve_anrm(const long N, const double* A, double* WORK)
+{
+  simd_zero<double>(N,WORK);
+  for (long j=0;j<N;j++)
+  {
+    const double* AJ = A+N*j;
+    for (long i=0;i<N;i++) *(WORK+i) += fabs(*(AJ+i));
+  }
+  double anrm = 0;
+  for (long i=0;i<N;i++) anrm = (*(WORK+i) > anrm) ? *(WORK+i) : anrm;
+  return anrm;
+}
+
+static inline double linal_solve_amax(const long N, const double* X)
+{
+  const long i = simd_iamax<double>(N,X);
+  return (i < 0) ? 0 : fabs(*(X+i));
+}
+
+//XS = float(X), false if an element of X is not finite or is
+//  out of the range of float (as dlag2s in dsgesv)
+static inline bool linal_solve_tofloat(const long n, const double* X, float* XS)
+{
+  simd_convert<double,float>(n,X,XS);
+  bool ok = true;
+  for (long i=0;i<n;i++) ok &= (fabs(*(X+i)) <= (double) FLT_MAX);
+  return ok;
+}
+
+//solve with the float factors, in place on RS
+static inline void linal_solve_sfac(const bool SPD, int N, int NRHS, float* AS, int* IPIV,
+                                    float* RS, int& INFO)
+{
+  int LD = N;
+  if (SPD)
+  {
+    char UPLO = 'U';
+    spotrs_(&UPLO,&N,&NRHS,AS,&LD,RS,&LD,&INFO);
+  } else {
+    char TRANS = 'N';
+    sgetrs_(&TRANS,&N,&NRHS,AS,&LD,IPIV,RS,&LD,&INFO);
+  }
+}
+
+//factor and solve in double, X = A^-1.B
+static void linal_solve_double(const bool SPD, const long N, const long NRHS, const double* A,
+                               const double* B, double* X, double* AD, int* IPIV, int& INFO)
+{
+  int NN  = N;
+  int NR  = NRHS;
+  int LD  = NN;
+  simd_copy<double>(N*N,A,AD);
+  simd_copy<double>(N*NRHS,B,X);
+  if (SPD)
+  {
+    char UPLO = 'U';
+    dpotrf_(&UPLO,&NN,AD,&LD,&INFO);
+    if (INFO == 0) dpotrs_(&UPLO,&NN,&NR,AD,&LD,X,&LD,&INFO);
+  } else {
+    char TRANS = 'N';
+    dgetrf_(&NN,&NN,AD,&LD,IPIV,&INFO);
+    if (INFO == 0) dgetrs_(&TRANS,&NN,&NR,AD,&LD,IPIV,X,&LD,&INFO);
+  }
+}
+
+void linal_dsolve(const long N, const long NRHS, const double* A, const double* B,
+                  double* X, Core<double>& CORE, int& ITER, int& INFO,
+                  const bool SPD)
+{
+  const long NAS = linal_solve_nd(N*N,sizeof(float));
+  const long NRS = linal_solve_nd(N*NRHS,sizeof(float));
+  const long NIP = linal_solve_nd(N,sizeof(int));
+  float*  AS   = (float*) CORE.checkout(NAS);
+  float*  RS   = (float*) CORE.checkout(NRS);
+  int*    IPIV = (int*) CORE.checkout(NIP);
+  double* R    = CORE.checkout(N*NRHS);
+
+  int NN = N;
+  int LD = NN;
+  ITER = 0;
+  INFO = 0;
+
+  //factorize in float
+  if (!linal_solve_tofloat(N*N,A,AS)) ITER = -4;
+  if (ITER == 0)
+  {
+    if (SPD)
+    {
+      char UPLO = 'U';
+      spotrf_(&UPLO,&NN,AS,&LD,&INFO);
+    } else {
+      sgetrf_(&NN,&NN,AS,&LD,IPIV,&INFO);
+    }
+    if (INFO != 0) ITER = -1;
+  }
+
+  //initial solution, X = A^-1.B
+  if (ITER == 0 && !linal_solve_tofloat(N*NRHS,B,RS)) ITER = -4;
+  if (ITER == 0)
+  {
+    linal_solve_sfac(SPD,NN,NRHS,AS,IPIV,RS,INFO);
+    simd_convert<float,double>(N*NRHS,RS,X);
+    if (INFO != 0) ITER = -1;
+  }
+
+  //refine
+  if (ITER == 0)
+  {
+    const double CTE  = linal_solve_anrm(N,A,R)*(0.5*DBL_EPSILON)*sqrt((double) N);
+    double last = -1;
+    for (int iter=0;iter<=LINAL_SOLVE_ITMAX;iter++)
+    {
+      //R = B - A.X
+      simd_copy<double>(N*NRHS,B,R);
+      linal_ABpC<double>(N,NRHS,N,-1.0,(double*) A,X,1.0,R);
+
+      //check each column
+      bool   done = true;
+      double rmax = 0;
+      for (long j=0;j<NRHS;j++)
+      {
+        const double rnrm = linal_solve_amax(N,R+N*j);
+        const double xnrm = linal_solve_amax(N,X+N*j);
+        if (rnrm > xnrm*CTE) done = false;
+        rmax = (rnrm > rmax) ? rnrm : rmax;
+      }
+      if (done) {ITER = iter; break;}
+      if (iter == LINAL_SOLVE_ITMAX) {ITER = -3; break;}
+      if (last >= 0 && rmax > 0.5*last) {ITER = -2; break;}
+      last = rmax;
+
+      //X = X + A^-1.R
+      if (!linal_solve_tofloat(N*NRHS,R,RS)) {ITER = -4; break;}
+      linal_solve_sfac(SPD,NN,NRHS,AS,IPIV,RS,INFO);
+      if (INFO != 0) {ITER = -2; break;}
+      for (long i=0;i<N*NRHS;i++) *(X+i) += (double) *(RS+i);
+    }
+  }
+
+  //fall back to double
+  if (ITER < 0)
+  {
+    double* AD = CORE.checkout(N*N);
+    linal_solve_double(SPD,N,NRHS,A,B,X,AD,IPIV,INFO);
+    CORE.remove(N*N);
+  }
+
+  CORE.remove(N*NRHS);
+  CORE.remove(NIP);
+  CORE.remove(NRS);
+  CORE.remove(NAS);
+}
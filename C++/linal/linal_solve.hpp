@@ -0,0 +1,76 @@
+/*-------------------------------------------------
+  linal_solve.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for the mixed precision solution of
+  the dense linear equations
+
+  A . X = B
+
+  A is NxN, and B and X are NxNRHS. A and B are
+  not changed.
+
+  A is converted to float and factorized in
+  float, with sgetrf (LU), or with spotrf 
+  (Cholesky, upper) if SPD is true, and A 
+  is symmetric positive definite. The solution 
+  is then refined in double,
+
+    R = B - A.X        (linal_ABpC)
+    X = X + A^-1.R     (with the float factors)
+
+  until, for each column,
+
+    max|R| < max|X| * ||A||_inf * eps * sqrt(N)
+
+  as in LAPACK's dsgesv. If A, B or a residual
+  does not fit in float (an element above
+  FLT_MAX, Inf or NaN), the float factorization
+  fails, or the refinement stalls or does not
+  converge within LINAL_SOLVE_ITMAX steps, A is
+  factorized again in double and solved
+  directly. 
+
+  The workspace is checked out of the Core, 
+  and returned to it before exiting. The Core 
+  must have linal_dsolve_NWORK(N,NRHS) free 
+  elements, which includes the double 
+  factorization in case it is needed.
+
+  ITER on exit is
+    >= 0  number of refinement steps, in float
+    -1    the float factorization failed
+    -2    the refinement stalled
+    -3    no convergence in LINAL_SOLVE_ITMAX
+    -4    A, B or a residual is out of the
+          range of float
+  and INFO is the LAPACK status of the last
+  factorization or solve
+    
+Parameters
+N	long		rows and cols of A
+NRHS	long		cols of B and X 
+A	const double*	matrix A (NxN)
+B	const double*	matrix B (NxNRHS)
+X	double*		solution X (NxNRHS)
+CORE	Core<double>&	workspace
+ITER	int&		refinement steps (see above)
+INFO	int&		job status
+SPD	bool		A is symmetric positive definite
+-------------------------------------------------*/
+#ifndef LINAL_SOLVE_HPP
+#define LINAL_SOLVE_HPP
+#include "lapack_interface.hpp"
+#include "linal_def.hpp"
+#include "core.hpp"
+
+#if !defined (LINAL_SOLVE_ITMAX)
+  #define LINAL_SOLVE_ITMAX 30
+#endif
+
+void linal_dsolve(const long N, const long NRHS, const double* A, const double* B,
+                  double* X, Core<double>& CORE, int& ITER, int& INFO,
+                  const bool SPD=false);
+long linal_dsolve_NWORK(const long N, const long NRHS);
+
+#endif
@@ -0,0 +1,392 @@
+/*------------------------------------------------
+  linal_sparse.cpp
+        JHT, October 14, 2026 : created
+
+    .cpp file for the sparse matrices, see
+    linal_sparse.hpp
+------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <algorithm>
+#include "linal_sparse.hpp"
+#include "simd_inline.hpp"
+
+//rows of B per block in linal_ASpB
+#define LINAL_SPARSE_MB 256
+
+/*------------------------------------------------
+  number of threads to use for FLOPS of work
+------------------------------------------------*/
+static inline int linal_sparse_nthr(const double FLOPS)
+{
+  #if defined (_OPENMP)
+    if (omp_in_parallel() || FLOPS < (double) LINAL_PAR_MIN_FLOPS) return 1;
+    return omp_get_max_threads();
+  #else
+    return 1;
+  #endif
+}
+
+/*------------------------------------------------
+  linal_csr_from_dense
+	- two passes over the columns of A, so the
+	  columns of each row come in order
+------------------------------------------------*/
+template <typename T>
+void linal_csr_from_dense(const long M, const long N, const T* A, const long LDA,
+                          const double TOL, linal_csr<T>& S)
+{
+  S.nrow = M;
+  S.ncol = N;
+  S.ptr.assign(M+1,0);
+  for (long j=0;j<N;j++)
+  {
+    for (long i=0;i<M;i++) {if (fabs((double) A[i+j*LDA]) > TOL) S.ptr[i+1]++;}
+  }
+  for (long i=0;i<M;i++) S.ptr[i+1] += S.ptr[i];
+  S.col.resize(S.ptr[M]);
+  S.val.resize(S.ptr[M]);
+  std::vector<long> next(S.ptr.begin(),S.ptr.end()-1);
+  for (long j=0;j<N;j++)
+  {
+    for (long i=0;i<M;i++)
+    {
+      const T a = A[i+j*LDA];
+      if (fabs((double) a) > TOL)
+      {
+        S.col[next[i]] = j;
+        S.val[next[i]] = a;
+        next[i]++;
+      }
+    }
+  }
+}
+template void linal_csr_from_dense<double>(const long M, const long N, const double* A, const long LDA,
+                                           const double TOL, linal_csr<double>& S);
+template void linal_csr_from_dense<float>(const long M, const long N, const float* A, const long LDA,
+                                          const double TOL, linal_csr<float>& S);
+template void linal_csr_from_dense<long>(const long M, const long N, const long* A, const long LDA,
+                                         const double TOL, linal_csr<long>& S);
+template void linal_csr_from_dense<int>(const long M, const long N, const int* A, const long LDA,
+                                        const double TOL, linal_csr<int>& S);
+
+/*------------------------------------------------
+  linal_csr_from_coo
+	- bucket the triplets by row, sort each row
+	  by column, and add the repeated elements
+------------------------------------------------*/
+template <typename T>
+void linal_csr_from_coo(const long M, const long N, const long NNZ,
+                        const long* I, const long* J, const T* V, linal_csr<T>& S)
+{
+  S.nrow = M;
+  S.ncol = N;
+  S.ptr.assign(M+1,0);
+  for (long n=0;n<NNZ;n++)
+  {
+    if (I[n] < 0 || I[n] >= M || J[n] < 0 || J[n] >= N)
+    {
+      printf("linal_csr_from_coo : element %ld at (%ld,%ld) is outside %ld x %ld \n",
+             n,I[n],J[n],M,N);
+      exit(1);
+    }
+    S.ptr[I[n]+1]++;
+  }
+  for (long i=0;i<M;i++) S.ptr[i+1] += S.ptr[i];
+
+  std::vector<long> next(S.ptr.begin(),S.ptr.end()-1);
+  std::vector<long> perm(NNZ);
+  for (long n=0;n<NNZ;n++) perm[next[I[n]]++] = n;
+
+  //sort and add within each row, then pack
+  S.col.resize(NNZ);
+  S.val.resize(NNZ);
+  long nnz = 0;
+  for (long i=0;i<M;i++)
+  {
+    const long p0 = S.ptr[i], p1 = S.ptr[i+1];
+    std::stable_sort(perm.begin()+p0,perm.begin()+p1,
+                     [J](const long a, const long b) {return J[a] < J[b];});
+    S.ptr[i] = nnz;
+    for (long p=p0;p<p1;p++)
+    {
+      const long n = perm[p];
+      if (nnz > S.ptr[i] && S.col[nnz-1] == J[n]) {S.val[nnz-1] += V[n];}
+      else {S.col[nnz] = J[n]; S.val[nnz] = V[n]; nnz++;}
+    }
+  }
+  S.ptr[M] = nnz;
+  S.col.resize(nnz);
+  S.val.resize(nnz);
+}
+template void linal_csr_from_coo<double>(const long M, const long N, const long NNZ,
+                                         const long* I, const long* J, const double* V, linal_csr<double>& S);
+template void linal_csr_from_coo<float>(const long M, const long N, const long NNZ,
+                                        const long* I, const long* J, const float* V, linal_csr<float>& S);
+template void linal_csr_from_coo<long>(const long M, const long N, const long NNZ,
+                                       const long* I, const long* J, const long* V, linal_csr<long>& S);
+template void linal_csr_from_coo<int>(const long M, const long N, const long NNZ,
+                                      const long* I, const long* J, const int* V, linal_csr<int>& S);
+
+/*------------------------------------------------
+  linal_bsr_from_dense
+	- keeps the blocks with an element above TOL,
+	  zero padded at the edges
+------------------------------------------------*/
+template <typename T>
+void linal_bsr_from_dense(const long M, const long N, const long R, const long C,
+                          const T* A, const long LDA, const double TOL, linal_bsr<T>& S)
+{
+  if (R < 1 || C < 1)
+  {
+    printf("linal_bsr_from_dense : blocks of %ld x %ld \n",R,C);
+    exit(1);
+  }
+  S.nrow  = M;
+  S.ncol  = N;
+  S.R     = R;
+  S.C     = C;
+  S.nbrow = (M + R - 1)/R;
+  S.nbcol = (N + C - 1)/C;
+  S.ptr.assign(S.nbrow+1,0);
+  S.col.clear();
+  S.val.clear();
+  for (long ib=0;ib<S.nbrow;ib++)
+  {
+    const long i0 = ib*R, nr = std::min(R,M-i0);
+    for (long jb=0;jb<S.nbcol;jb++)
+    {
+      const long j0 = jb*C, nc = std::min(C,N-j0);
+      double amax = 0;
+      for (long c=0;c<nc;c++)
+      {
+        for (long r=0;r<nr;r++) amax = std::max(amax,fabs((double) A[i0+r+(j0+c)*LDA]));
+      }
+      if (amax <= TOL) continue;
+      S.col.push_back(jb);
+      const long b = (long) S.val.size();
+      S.val.resize(b + R*C,(T) 0);
+      for (long c=0;c<nc;c++)
+      {
+        for (long r=0;r<nr;r++) S.val[b+r+c*R] = A[i0+r+(j0+c)*LDA];
+      }
+    }
+    S.ptr[ib+1] = (long) S.col.size();
+  }
+}
+template void linal_bsr_from_dense<double>(const long M, const long N, const long R, const long C,
+                                           const double* A, const long LDA, const double TOL, linal_bsr<double>& S);
+template void linal_bsr_from_dense<float>(const long M, const long N, const long R, const long C,
+                                          const float* A, const long LDA, const double TOL, linal_bsr<float>& S);
+template void linal_bsr_from_dense<long>(const long M, const long N, const long R, const long C,
+                                         const long* A, const long LDA, const double TOL, linal_bsr<long>& S);
+template void linal_bsr_from_dense<int>(const long M, const long N, const long R, const long C,
+                                        const int* A, const long LDA, const double TOL, linal_bsr<int>& S);
+
+/*------------------------------------------------
+  linal_Sxpy, CSR
+	- a gather dot product for each row
+------------------------------------------------*/
+template <typename T>
+void linal_Sxpy(const linal_csr<T>& S, const T ALPHA, const T* X, const T BETA, T* Y)
+{
+  const long M = S.nrow;
+  const long* ptr = S.ptr.data();
+  const long* col = S.col.data();
+  const T*    val = S.val.data();
+  #if defined (_OPENMP)
+  const int nthr = linal_sparse_nthr(2.0*S.nnz());
+  #pragma omp parallel for schedule(dynamic,LINAL_SPARSE_CHUNK) num_threads(nthr) if(nthr > 1)
+  #endif
+  for (long i=0;i<M;i++)
+  {
+    T sum = (T) 0;
+    #if defined (_OPENMP)
+    #pragma omp simd reduction(+:sum)
+    #endif
+    for (long p=ptr[i];p<ptr[i+1];p++) sum += val[p]*X[col[p]];
+    Y[i] = (BETA == (T) 0) ? ALPHA*sum : ALPHA*sum + BETA*Y[i];
+  }
+}
+template void linal_Sxpy<double>(const linal_csr<double>& S, const double ALPHA, const double* X,
+                                 const double BETA, double* Y);
+template void linal_Sxpy<float>(const linal_csr<float>& S, const float ALPHA, const float* X,
+                                const float BETA, float* Y);
+template void linal_Sxpy<long>(const linal_csr<long>& S, const long ALPHA, const long* X,
+                               const long BETA, long* Y);
+template void linal_Sxpy<int>(const linal_csr<int>& S, const int ALPHA, const int* X,
+                              const int BETA, int* Y);
+
+/*------------------------------------------------
+  linal_bsr_row
+	- block row IB of Y = ALPHA*S.X + BETA*Y,
+	  ACC holds R elements. The blocks are done
+	  a column at a time, in SIMD over the rows
+------------------------------------------------*/
+template <typename T>
+static inline void linal_bsr_row(const linal_bsr<T>& S, const long IB, const T ALPHA,
+                                 const T* X, const T BETA, T* Y, T* ACC)
+{
+  const long R = S.R, C = S.C;
+  const long i0 = IB*R, nr = std::min(R,S.nrow-i0);
+  simd_inline_zero<T>(R,ACC);
+  for (long b=S.ptr[IB];b<S.ptr[IB+1];b++)
+  {
+    const long j0 = S.col[b]*C, nc = std::min(C,S.ncol-j0);
+    const T* blk = S.val.data() + b*R*C;
+    for (long c=0;c<nc;c++) simd_inline_axpy<T>(R,X[j0+c],blk+c*R,ACC);
+  }
+  if (BETA == (T) 0) {for (long r=0;r<nr;r++) Y[i0+r] = ALPHA*ACC[r];}
+  else {for (long r=0;r<nr;r++) Y[i0+r] = ALPHA*ACC[r] + BETA*Y[i0+r];}
+}
+
+/*------------------------------------------------
+  linal_Sxpy, BSR
+------------------------------------------------*/
+template <typename T>
+void linal_Sxpy(const linal_bsr<T>& S, const T ALPHA, const T* X, const T BETA, T* Y)
+{
+  #if defined (_OPENMP)
+  const int nthr = linal_sparse_nthr(2.0*S.val.size());
+  #pragma omp parallel num_threads(nthr) if(nthr > 1)
+  #endif
+  {
+    std::vector<T> acc(S.R);
+    #if defined (_OPENMP)
+    #pragma omp for schedule(dynamic,1+LINAL_SPARSE_CHUNK/S.R)
+    #endif
+    for (long ib=0;ib<S.nbrow;ib++) linal_bsr_row<T>(S,ib,ALPHA,X,BETA,Y,acc.data());
+  }
+}
+template void linal_Sxpy<double>(const linal_bsr<double>& S, const double ALPHA, const double* X,
+                                 const double BETA, double* Y);
+template void linal_Sxpy<float>(const linal_bsr<float>& S, const float ALPHA, const float* X,
+                                const float BETA, float* Y);
+template void linal_Sxpy<long>(const linal_bsr<long>& S, const long ALPHA, const long* X,
+                               const long BETA, long* Y);
+template void linal_Sxpy<int>(const linal_bsr<int>& S, const int ALPHA, const int* X,
+                              const int BETA, int* Y);
+
+/*------------------------------------------------
+  linal_SApB, CSR
+	- each row of S is read once for every
+	  LINAL_SPARSE_NB columns of A
+------------------------------------------------*/
+template <typename T>
+void linal_SApB(const long N, const linal_csr<T>& S, const T ALPHA, const T* A, const long LDA,
+                const T BETA, T* B, const long LDB)
+{
+  const long M = S.nrow;
+  const long* ptr = S.ptr.data();
+  const long* col = S.col.data();
+  const T*    val = S.val.data();
+  #if defined (_OPENMP)
+  const int nthr = linal_sparse_nthr(2.0*S.nnz()*N);
+  #pragma omp parallel for schedule(dynamic,LINAL_SPARSE_CHUNK) num_threads(nthr) if(nthr > 1)
+  #endif
+  for (long i=0;i<M;i++)
+  {
+    for (long j0=0;j0<N;j0+=LINAL_SPARSE_NB)
+    {
+      const long nb = std::min((long) LINAL_SPARSE_NB,N-j0);
+      T acc[LINAL_SPARSE_NB];
+      simd_inline_zero<T,LINAL_SPARSE_NB>(acc);
+      for (long p=ptr[i];p<ptr[i+1];p++)
+      {
+        const T v = val[p];
+        const T* a = A + col[p] + j0*LDA;
+        for (long jj=0;jj<nb;jj++) acc[jj] += v*a[jj*LDA];
+      }
+      T* b = B + i + j0*LDB;
+      if (BETA == (T) 0) {for (long jj=0;jj<nb;jj++) b[jj*LDB] = ALPHA*acc[jj];}
+      else {for (long jj=0;jj<nb;jj++) b[jj*LDB] = ALPHA*acc[jj] + BETA*b[jj*LDB];}
+    }
+  }
+}
+template void linal_SApB<double>(const long N, const linal_csr<double>& S, const double ALPHA,
+                                 const double* A, const long LDA, const double BETA, double* B, const long LDB);
+template void linal_SApB<float>(const long N, const linal_csr<float>& S, const float ALPHA,
+                                const float* A, const long LDA, const float BETA, float* B, const long LDB);
+template void linal_SApB<long>(const long N, const linal_csr<long>& S, const long ALPHA,
+                               const long* A, const long LDA, const long BETA, long* B, const long LDB);
+template void linal_SApB<int>(const long N, const linal_csr<int>& S, const int ALPHA,
+                              const int* A, const long LDA, const int BETA, int* B, const long LDB);
+
+/*------------------------------------------------
+  linal_SApB, BSR
+	- a block row of S is applied to every
+	  column of A before moving on
+------------------------------------------------*/
+template <typename T>
+void linal_SApB(const long N, const linal_bsr<T>& S, const T ALPHA, const T* A, const long LDA,
+                const T BETA, T* B, const long LDB)
+{
+  #if defined (_OPENMP)
+  const int nthr = linal_sparse_nthr(2.0*S.val.size()*N);
+  #pragma omp parallel num_threads(nthr) if(nthr > 1)
+  #endif
+  {
+    std::vector<T> acc(S.R);
+    #if defined (_OPENMP)
+    #pragma omp for schedule(dynamic,1+LINAL_SPARSE_CHUNK/S.R)
+    #endif
+    for (long ib=0;ib<S.nbrow;ib++)
+    {
+      for (long j=0;j<N;j++) linal_bsr_row<T>(S,ib,ALPHA,A+j*LDA,BETA,B+j*LDB,acc.data());
+    }
+  }
+}
+template void linal_SApB<double>(const long N, const linal_bsr<double>& S, const double ALPHA,
+                                 const double* A, const long LDA, const double BETA, double* B, const long LDB);
+template void linal_SApB<float>(const long N, const linal_bsr<float>& S, const float ALPHA,
+                                const float* A, const long LDA, const float BETA, float* B, const long LDB);
+template void linal_SApB<long>(const long N, const linal_bsr<long>& S, const long ALPHA,
+                               const long* A, const long LDA, const long BETA, long* B, const long LDB);
+template void linal_SApB<int>(const long N, const linal_bsr<int>& S, const int ALPHA,
+                              const int* A, const long LDA, const int BETA, int* B, const long LDB);
+
+/*------------------------------------------------
+  linal_ASpB, CSR
+	- B(:,j) += ALPHA*S(k,j)*A(:,k) for each
+	  element of S, as contiguous axpys over a
+	  block of LINAL_SPARSE_MB rows. Each thread
+	  has its own rows of B
+------------------------------------------------*/
+template <typename T>
+void linal_ASpB(const long M, const linal_csr<T>& S, const T ALPHA, const T* A, const long LDA,
+                const T BETA, T* B, const long LDB)
+{
+  const long K = S.nrow, N = S.ncol;
+  const long NBLK = (M + LINAL_SPARSE_MB - 1)/LINAL_SPARSE_MB;
+  const long* ptr = S.ptr.data();
+  const long* col = S.col.data();
+  const T*    val = S.val.data();
+  #if defined (_OPENMP)
+  const int nthr = linal_sparse_nthr(2.0*S.nnz()*M);
+  #pragma omp parallel for schedule(static) num_threads(nthr) if(nthr > 1)
+  #endif
+  for (long blk=0;blk<NBLK;blk++)
+  {
+    const long i0 = blk*LINAL_SPARSE_MB;
+    const long len = std::min((long) LINAL_SPARSE_MB,M-i0);
+    for (long j=0;j<N;j++)
+    {
+      if (BETA == (T) 0) {simd_inline_zero<T>(len,B+i0+j*LDB);}
+      else if (BETA != (T) 1) {simd_inline_scal_mul<T>(len,BETA,B+i0+j*LDB);}
+    }
+    for (long k=0;k<K;k++)
+    {
+      const T* a = A + i0 + k*LDA;
+      for (long p=ptr[k];p<ptr[k+1];p++) simd_inline_axpy<T>(len,ALPHA*val[p],a,B+i0+col[p]*LDB);
+    }
+  }
+}
+template void linal_ASpB<double>(const long M, const linal_csr<double>& S, const double ALPHA,
+                                 const double* A, const long LDA, const double BETA, double* B, const long LDB);
+template void linal_ASpB<float>(const long M, const linal_csr<float>& S, const float ALPHA,
+                                const float* A, const long LDA, const float BETA, float* B, const long LDB);
+template void linal_ASpB<long>(const long M, const linal_csr<long>& S, const long ALPHA,
+                               const long* A, const long LDA, const long BETA, long* B, const long LDB);
+template void linal_ASpB<int>(const long M, const linal_csr<int>& S, const int ALPHA,
+                              const int* A, const long LDA, const int BETA, int* B, const long LDB);
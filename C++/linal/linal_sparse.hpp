@@ -0,0 +1,122 @@
+/*------------------------------------------------
+  linal_sparse.hpp
+        JHT, October 14, 2026 : created
+
+    Sparse matrices, and their products with
+    vectors and with dense (column major) matrices,
+    such as gemat<T>::data(). S is the sparse matrix
+    in the names, as D is a diagonal one.
+
+    linal_csr<T> : compressed sparse rows
+      row i is val[ptr[i]:ptr[i+1]], in columns
+      col[ptr[i]:ptr[i+1]], in increasing order
+
+    linal_bsr<T> : block compressed sparse rows,
+      of R x C dense blocks (column major)
+      block row ib is blocks ptr[ib]:ptr[ib+1],
+      block b is in block column col[b], and its
+      elements are val[b*R*C : (b+1)*R*C]. The last
+      block row/column is padded with zeros if R,C
+      do not divide M,N
+
+    Building
+      linal_csr_from_dense(M,N,A,LDA,TOL,S)
+        S = elements of A with |a| > TOL
+      linal_csr_from_coo(M,N,NNZ,I,J,V,S)
+        S from (I,J,V) triplets in any order,
+        repeated (i,j) are added
+      linal_bsr_from_dense(M,N,R,C,A,LDA,TOL,S)
+        S = RxC blocks of A with max |a| > TOL
+
+    Products
+      linal_Sxpy(S,ALPHA,X,BETA,Y)
+        Y = ALPHA*S.X + BETA*Y           (SpMV)
+      linal_SApB(N,S,ALPHA,A,LDA,BETA,B,LDB)
+        B = ALPHA*S.A + BETA*B           (SpMM)
+        S is MxK, A is KxN, B is MxN
+      linal_ASpB(M,S,ALPHA,A,LDA,BETA,B,LDB)
+        B = ALPHA*A.S + BETA*B, CSR only
+        A is MxK, S is KxN, B is MxN
+
+    They are OpenMP threaded over rows of the
+    output (block rows for BSR, blocks of rows of
+    B for ASpB), once the work is more than
+    LINAL_PAR_MIN_FLOPS. If BETA == 0, Y and B are
+    not read.
+
+    Instantiated for double, float, long and int
+------------------------------------------------*/
+#ifndef LINAL_SPARSE_HPP
+#define LINAL_SPARSE_HPP
+
+#include <vector>
+#include "simd.hpp"
+#include "linal_def.hpp"
+
+//columns of A done together in linal_SApB (CSR)
+#define LINAL_SPARSE_NB 8
+
+//rows of the output per OpenMP chunk
+#define LINAL_SPARSE_CHUNK 64
+
+template <typename T>
+struct linal_csr
+{
+  long nrow;			//rows, M
+  long ncol;			//cols, N
+  std::vector<long> ptr;	//start of each row, nrow+1
+  std::vector<long> col;	//column of each element
+  std::vector<T>    val;	//the nonzero elements
+
+  linal_csr() : nrow(0), ncol(0), ptr(1,0) {}
+  long nnz() const {return (long) val.size();}
+};
+
+template <typename T>
+struct linal_bsr
+{
+  long nrow;			//rows, M
+  long ncol;			//cols, N
+  long R;			//rows of each block
+  long C;			//cols of each block
+  long nbrow;			//block rows, ceil(M/R)
+  long nbcol;			//block cols, ceil(N/C)
+  std::vector<long> ptr;	//start of each block row, nbrow+1
+  std::vector<long> col;	//block column of each block
+  std::vector<T>    val;	//the blocks, R*C each
+
+  linal_bsr() : nrow(0), ncol(0), R(1), C(1), nbrow(0), nbcol(0), ptr(1,0) {}
+  long nblocks() const {return (long) col.size();}
+};
+
+template <typename T>
+void linal_csr_from_dense(const long M, const long N, const T* A, const long LDA,
+                          const double TOL, linal_csr<T>& S);
+
+template <typename T>
+void linal_csr_from_coo(const long M, const long N, const long NNZ,
+                        const long* I, const long* J, const T* V, linal_csr<T>& S);
+
+template <typename T>
+void linal_bsr_from_dense(const long M, const long N, const long R, const long C,
+                          const T* A, const long LDA, const double TOL, linal_bsr<T>& S);
+
+template <typename T>
+void linal_Sxpy(const linal_csr<T>& S, const T ALPHA, const T* X, const T BETA, T* Y);
+
+template <typename T>
+void linal_Sxpy(const linal_bsr<T>& S, const T ALPHA, const T* X, const T BETA, T* Y);
+
+template <typename T>
+void linal_SApB(const long N, const linal_csr<T>& S, const T ALPHA, const T* A, const long LDA,
+                const T BETA, T* B, const long LDB);
+
+template <typename T>
+void linal_SApB(const long N, const linal_bsr<T>& S, const T ALPHA, const T* A, const long LDA,
+                const T BETA, T* B, const long LDB);
+
+template <typename T>
+void linal_ASpB(const long M, const linal_csr<T>& S, const T ALPHA, const T* A, const long LDA,
+                const T BETA, T* B, const long LDB);
+
+#endif
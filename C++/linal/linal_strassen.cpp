@@ -0,0 +1,274 @@
+/*------------------------------------------------
+  linal_strassen.cpp
+        JHT, October 14, 2026 : created
+
+    C = ALPHA*A.B + BETA*C, Strassen-Winograd
+
+    With A, B, C split in 2x2 blocks (A11 is the
+    top left, A21 the bottom left)
+
+      S1 = A21 + A22    T1 = B12 - B11
+      S2 = S1 - A11     T2 = B22 - T1
+      S3 = A11 - A21    T3 = B22 - B12
+      S4 = A12 - S2     T4 = T2 - B21
+
+      P1 = A11.B11  P2 = A12.B21  P3 = S4.B22
+      P4 = A22.T4   P5 = S1.T1    P6 = S2.T2
+      P7 = S3.T3
+
+      C11 = P1 + P2      C12 = P1 + P6 + P5 + P3
+      C21 = P1 + P6 + P7 - P4
+      C22 = P1 + P6 + P7 + P5
+
+    C is scaled by BETA first, and the products
+    are then added into C, so P2, P3, and P4 go
+    straight into their block of C (the recursive
+    call with BETA = 1), and U = P1 + P6 (and P,
+    the other products) are kept in the workspace,
+    with one S and one T, four blocks a level.
+    The S and T are made from A and B each time
+    they are needed, so none are kept.
+------------------------------------------------*/
+#include "linal_strassen.hpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <algorithm>
+
+//alignment of the blocks of the workspace, in bytes
+#define LINAL_STRASSEN_ALIGN 64
+
+static int linal_strassen_MIN    = 0;
+static int linal_strassen_LEVELS = LINAL_STRASSEN_LEVELS;
+
+void linal_strassen_set(const int MIN, const int LEVELS)
+{
+  linal_strassen_MIN    = std::max(MIN,0);
+  linal_strassen_LEVELS = std::max(LEVELS,0);
+}
+
+int linal_strassen_min() {return linal_strassen_MIN;}
+int linal_strassen_levels() {return linal_strassen_LEVELS;}
+
+//true if M,N,K get one more level
+static inline bool linal_strassen_split(const long M, const long N, const long K, const int MIN, const int L)
+{
+  return MIN > 0 && L > 0 && std::min(M,std::min(N,K)) >= std::max(MIN,2);
+}
+
+int linal_strassen_depth(const int M, const int N, const int K, const int MIN, const int LEVELS)
+{
+  long m = M, n = N, k = K;
+  int L = 0;
+  while (linal_strassen_split(m,n,k,MIN,LEVELS-L)) {m /= 2; n /= 2; k /= 2; L++;}
+  return L;
+}
+
+template <typename T>
+long linal_strassen_work(const int M, const int N, const int K, const int MIN, const int LEVELS)
+{
+  const long pad = LINAL_STRASSEN_ALIGN/sizeof(T);
+  long m = M, n = N, k = K, work = 0;
+  for (int L=LEVELS;linal_strassen_split(m,n,k,MIN,L);L--)
+  {
+    m /= 2; n /= 2; k /= 2;
+    work += m*k + k*n + 2*m*n + 4*pad;
+  }
+  return work;
+}
+template long linal_strassen_work<double>(const int M, const int N, const int K, const int MIN, const int LEVELS);
+template long linal_strassen_work<float>(const int M, const int N, const int K, const int MIN, const int LEVELS);
+
+double linal_strassen_bound(const int N, const int L)
+{
+  const double n = (double) N/pow(2.0,L);
+  return pow(N/n,log2(18.0))*(n*n + 6.0*n) - 6.0*N;
+}
+
+//C = BETA*C
+template <typename T>
+static void linal_strassen_scal(const long M, const long N, const T BETA, T* C, const long LDC)
+{
+  for (long j=0;j<N;j++)
+  {
+    T* cc = C + LDC*j;
+    if (BETA == (T) 0) {for (long i=0;i<M;i++) cc[i] = (T) 0;}
+    else {for (long i=0;i<M;i++) cc[i] *= BETA;}
+  }
+}
+
+//X = sum of the NT terms CY[t]*Y[t], all MxN
+template <typename T>
+static void linal_strassen_sum(const long M, const long N, T* X, const long LDX, const int NT,
+                               const T* const* Y, const long* LDY, const T* CY)
+{
+  for (long j=0;j<N;j++)
+  {
+    T* xx = X + LDX*j;
+    const T* y0 = Y[0] + LDY[0]*j;
+    for (long i=0;i<M;i++) xx[i] = CY[0]*y0[i];
+    for (int t=1;t<NT;t++)
+    {
+      const T* yy = Y[t] + LDY[t]*j;
+      const T  cy = CY[t];
+      for (long i=0;i<M;i++) xx[i] += cy*yy[i];
+    }
+  }
+}
+
+//C += P, both MxN
+template <typename T>
+static void linal_strassen_acc(const long M, const long N, const T* P, const long LDP, T* C, const long LDC)
+{
+  for (long j=0;j<N;j++)
+  {
+    const T* pp = P + LDP*j;
+    T* cc = C + LDC*j;
+    for (long i=0;i<M;i++) cc[i] += pp[i];
+  }
+}
+
+template <typename T>
+static void linal_strassen_rec(const long M, const long N, const long K, const T ALPHA, const T* A, const long LDA,
+                               const T* B, const long LDB, const T BETA, T* C, const long LDC,
+                               libj::core_arena<T>& W, const int MIN, const int L)
+{
+  if (!linal_strassen_split(M,N,K,MIN,L))
+  {
+    linal_gemm<T>(false,(int) M,(int) N,(int) K,ALPHA,A,(int) LDA,B,(int) LDB,BETA,C,(int) LDC);
+    return;
+  }
+  if (BETA != (T) 1) linal_strassen_scal<T>(M,N,BETA,C,LDC);
+
+  const long m = M/2, n = N/2, k = K/2;
+  const T* A11 = A;       const T* A12 = A + LDA*k;
+  const T* A21 = A + m;   const T* A22 = A + m + LDA*k;
+  const T* B11 = B;       const T* B12 = B + LDB*n;
+  const T* B21 = B + k;   const T* B22 = B + k + LDB*n;
+  T* C11 = C;             T* C12 = C + LDC*n;
+  T* C21 = C + m;         T* C22 = C + m + LDC*n;
+
+  T* S = W.allocate(LINAL_STRASSEN_ALIGN,m*k);
+  T* Z = W.allocate(LINAL_STRASSEN_ALIGN,k*n);	//the T's
+  T* U = W.allocate(LINAL_STRASSEN_ALIGN,m*n);
+  T* P = W.allocate(LINAL_STRASSEN_ALIGN,m*n);
+
+  const T one = (T) 1, zero = (T) 0;
+  const T c3[3] = {one,one,-one};
+  const T c4[4] = {one,-one,-one,one};
+  const T cp[2] = {one,-one};
+  long la[4] = {LDA,LDA,LDA,LDA};
+  long lb[4] = {LDB,LDB,LDB,LDB};
+
+  //U = P1, C11 = P1 + P2
+  linal_strassen_rec<T>(m,n,k,ALPHA,A11,LDA,B11,LDB,zero,U,m,W,MIN,L-1);
+  linal_strassen_acc<T>(m,n,U,m,C11,LDC);
+  linal_strassen_rec<T>(m,n,k,ALPHA,A12,LDA,B21,LDB,one,C11,LDC,W,MIN,L-1);
+
+  //U = P1 + P6, into C12, C21, and C22
+  {
+    const T* ya[3] = {A21,A22,A11};
+    const T* yb[3] = {B22,B12,B11};
+    const T  cb[3] = {one,-one,one};
+    linal_strassen_sum<T>(m,k,S,m,3,ya,la,c3);
+    linal_strassen_sum<T>(k,n,Z,k,3,yb,lb,cb);
+  }
+  linal_strassen_rec<T>(m,n,k,ALPHA,S,m,Z,k,zero,P,m,W,MIN,L-1);
+  linal_strassen_acc<T>(m,n,P,m,U,m);
+  linal_strassen_acc<T>(m,n,U,m,C12,LDC);
+  linal_strassen_acc<T>(m,n,U,m,C21,LDC);
+  linal_strassen_acc<T>(m,n,U,m,C22,LDC);
+
+  //P7, into C21 and C22
+  {
+    const T* ya[2] = {A11,A21};
+    const T* yb[2] = {B22,B12};
+    linal_strassen_sum<T>(m,k,S,m,2,ya,la,cp);
+    linal_strassen_sum<T>(k,n,Z,k,2,yb,lb,cp);
+  }
+  linal_strassen_rec<T>(m,n,k,ALPHA,S,m,Z,k,zero,P,m,W,MIN,L-1);
+  linal_strassen_acc<T>(m,n,P,m,C21,LDC);
+  linal_strassen_acc<T>(m,n,P,m,C22,LDC);
+
+  //P5, into C12 and C22
+  {
+    const T* ya[2] = {A21,A22};
+    const T* yb[2] = {B12,B11};
+    const T  ca[2] = {one,one};
+    linal_strassen_sum<T>(m,k,S,m,2,ya,la,ca);
+    linal_strassen_sum<T>(k,n,Z,k,2,yb,lb,cp);
+  }
+  linal_strassen_rec<T>(m,n,k,ALPHA,S,m,Z,k,zero,P,m,W,MIN,L-1);
+  linal_strassen_acc<T>(m,n,P,m,C12,LDC);
+  linal_strassen_acc<T>(m,n,P,m,C22,LDC);
+
+  //P3 into C12, and -P4 into C21
+  {
+    const T* ya[4] = {A12,A21,A22,A11};
+    const T* yb[4] = {B22,B12,B11,B21};
+    const T  cb[4] = {one,-one,one,-one};
+    linal_strassen_sum<T>(m,k,S,m,4,ya,la,c4);
+    linal_strassen_sum<T>(k,n,Z,k,4,yb,lb,cb);
+  }
+  linal_strassen_rec<T>(m,n,k,ALPHA,S,m,B22,LDB,one,C12,LDC,W,MIN,L-1);
+  linal_strassen_rec<T>(m,n,k,-ALPHA,A22,LDA,Z,k,one,C21,LDC,W,MIN,L-1);
+
+  W.deallocate(P,m*n);
+  W.deallocate(U,m*n);
+  W.deallocate(Z,k*n);
+  W.deallocate(S,m*k);
+
+  //the odd row, col, and inner index
+  const long mm = 2*m, nn = 2*n, kk = 2*k;
+  if (K > kk) linal_gemm<T>(false,(int) mm,(int) nn,1,ALPHA,A+LDA*kk,(int) LDA,B+kk,(int) LDB,one,C,(int) LDC);
+  if (M > mm) linal_gemm<T>(false,1,(int) N,(int) K,ALPHA,A+mm,(int) LDA,B,(int) LDB,one,C+mm,(int) LDC);
+  if (N > nn) linal_gemm<T>(false,(int) mm,1,(int) K,ALPHA,A,(int) LDA,B+LDB*nn,(int) LDB,one,C+LDC*nn,(int) LDC);
+}
+
+template <typename T>
+void linal_strassen(const int M, const int N, const int K, const T ALPHA, const T* A, const int LDA,
+                    const T* B, const int LDB, const T BETA, T* C, const int LDC,
+                    libj::core_arena<T>& W, const int MIN, const int LEVELS)
+{
+  if (LDA < std::max(1,M) || LDB < std::max(1,K) || LDC < std::max(1,M))
+  {
+    printf("ERROR linal_strassen bad leading dimension, LDA %d LDB %d LDC %d for M %d N %d K %d\n",
+           LDA,LDB,LDC,M,N,K);
+    exit(1);
+  }
+  const long work = linal_strassen_work<T>(M,N,K,MIN,LEVELS);
+  if (W.nfree() < work)
+  {
+    printf("ERROR linal_strassen workspace has %ld free elements, %ld are needed\n",W.nfree(),work);
+    exit(1);
+  }
+  linal_strassen_rec<T>(M,N,K,ALPHA,A,LDA,B,LDB,BETA,C,LDC,W,MIN,LEVELS);
+}
+
+template <typename T>
+void linal_strassen(const int M, const int N, const int K, const T ALPHA, const T* A, const int LDA,
+                    const T* B, const int LDB, const T BETA, T* C, const int LDC,
+                    const int MIN, const int LEVELS)
+{
+  const long work = linal_strassen_work<T>(M,N,K,MIN,LEVELS);
+  if (work == 0)
+  {
+    linal_gemm<T>(false,M,N,K,ALPHA,A,LDA,B,LDB,BETA,C,LDC);
+    return;
+  }
+  libj::core_arena<T> W(work);
+  linal_strassen<T>(M,N,K,ALPHA,A,LDA,B,LDB,BETA,C,LDC,W,MIN,LEVELS);
+}
+
+template void linal_strassen<double>(const int M, const int N, const int K, const double ALPHA, const double* A,
+                    const int LDA, const double* B, const int LDB, const double BETA, double* C, const int LDC,
+                    libj::core_arena<double>& W, const int MIN, const int LEVELS);
+template void linal_strassen<float>(const int M, const int N, const int K, const float ALPHA, const float* A,
+                    const int LDA, const float* B, const int LDB, const float BETA, float* C, const int LDC,
+                    libj::core_arena<float>& W, const int MIN, const int LEVELS);
+template void linal_strassen<double>(const int M, const int N, const int K, const double ALPHA, const double* A,
+                    const int LDA, const double* B, const int LDB, const double BETA, double* C, const int LDC,
+                    const int MIN, const int LEVELS);
+template void linal_strassen<float>(const int M, const int N, const int K, const float ALPHA, const float* A,
+                    const int LDA, const float* B, const int LDB, const float BETA, float* C, const int LDC,
+                    const int MIN, const int LEVELS);
@@ -0,0 +1,96 @@
+/*------------------------------------------------
+  linal_strassen.hpp
+        JHT, October 14, 2026 : created
+
+    C = ALPHA*A.B + BETA*C
+
+    with a few levels of the Strassen-Winograd
+    recursion over linal_gemm (or the BLAS with
+    -DLINAL_BLAS), for double and float. Each
+    level splits A, B, and C in 2x2 blocks and
+    does 7 half sized products in place of 8, so
+    L levels do (7/8)^L of the flops of the plain
+    product (-12.5%, -23%, -33% for 1, 2, 3),
+    at the cost of O(N^2) additions, and an error
+    that grows with the levels a little faster
+    than that of the plain product (see below).
+
+    A level is done while all of M, N, and K are
+    at least MIN, up to LEVELS levels. An odd
+    dimension is peeled off (the last row or col
+    is done with linal_gemm), so any M, N, K work.
+
+    This is opt-in. linal_ABpC (for double and
+    float) only uses it after
+
+      linal_strassen_set(MIN,LEVELS);
+
+    which applies to every later call, MIN <= 0
+    turns it off (the default). The workspace is
+    then taken from a libj::core_arena made for
+    the call. To give the workspace (e.g., an
+    arena kept over many calls), call
+
+      linal_strassen<T>(M,N,K,ALPHA,A,LDA,B,LDB,
+                        BETA,C,LDC,W,MIN,LEVELS);
+
+    where W has at least linal_strassen_work<T>
+    (M,N,K,MIN,LEVELS) free elements. All the
+    workspace is given back to W on return.
+
+    Error : with n = N/2^L the base dimension, a
+    square product has (Higham, "Accuracy and
+    Stability of Numerical Algorithms", 23.2.2)
+
+      max|C - fl(C)| <= [(N/n)^log2(18) (n^2+6n)
+                         - 6N] u max|A| max|B|
+
+    for |ALPHA| = 1, in place of the N^2 u
+    max|A| max|B| of the plain product.
+    This is a norm wise, not an element wise
+    bound, so Strassen is for products of dense
+    matrices of similar sized elements, not for
+    those where small elements matter.
+    linal_strassen_bound gives the bound.
+
+    Variables
+    M,N,K	int	as in linal_ABpC
+    LDA,LDB,LDC	int	leading dimensions
+    W		core_arena<T>&	workspace
+    MIN		int	smallest M,N,K of a level
+    LEVELS	int	most levels of recursion
+------------------------------------------------*/
+#ifndef LINAL_STRASSEN_HPP
+#define LINAL_STRASSEN_HPP
+
+#include "linal_def.hpp"
+#include "linal_gemm.hpp"
+#include "core_arena.hpp"
+
+//opt in for linal_ABpC, MIN <= 0 turns it off
+void linal_strassen_set(const int MIN, const int LEVELS=LINAL_STRASSEN_LEVELS);
+int linal_strassen_min();
+int linal_strassen_levels();
+
+//elements of workspace needed
+template <typename T>
+long linal_strassen_work(const int M, const int N, const int K, const int MIN, const int LEVELS);
+
+//levels done for M,N,K
+int linal_strassen_depth(const int M, const int N, const int K, const int MIN, const int LEVELS);
+
+//the bound on max|C - fl(C)|/(u max|A| max|B|) for an NxN product done with L levels
+double linal_strassen_bound(const int N, const int L);
+
+template <typename T>
+void linal_strassen(const int M, const int N, const int K, const T ALPHA, const T* A, const int LDA,
+                    const T* B, const int LDB, const T BETA, T* C, const int LDC,
+                    libj::core_arena<T>& W, const int MIN, const int LEVELS=LINAL_STRASSEN_LEVELS);
+
+//workspace from an arena made for the call
+template <typename T>
+void linal_strassen(const int M, const int N, const int K, const T ALPHA, const T* A, const int LDA,
+                    const T* B, const int LDB, const T BETA, T* C, const int LDC,
+                    const int MIN, const int LEVELS=LINAL_STRASSEN_LEVELS);
+
+#endif
@@ -0,0 +1,294 @@
+/*-------------------------------------------------
+  linal_tsqr.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for the tall skinny QR, see
+  linal_tsqr.hpp
+
+  The chunks are factored by one thread each, with
+  its own LAPACK workspace. Each level of the tree
+  is one parallel loop over its pairs, and the R of
+  a pair is kept in the chunk of its top R, so the
+  root is chunk 0. The tree is undone from the root
+  down, so C of each chunk is the NxN block of Q of
+  the R's that belongs to it, and the Q of a chunk
+  is its Householder Q (dorgqr, in place) times C,
+  LINAL_TSQR_ROWS rows at a time.
+-------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <algorithm>
+#include "linal_tsqr.hpp"
+#include "linal_ABpC.hpp"
+
+#if defined (_OPENMP)
+  #include <omp.h>
+#endif
+
+/*-------------------------------------------------
+  workspace queries
+-------------------------------------------------*/
+static long linal_tsqr_geqrf_LWORK(const long M, const long N)
+{
+  int MM    = M;
+  int NN    = N;
+  int LDA   = MM;
+  int LWORK = -1;
+  int INFO;
+  double D;
+
+  dgeqrf_(&MM,&NN,&D,&LDA,&D,&D,&LWORK,&INFO);
+  return std::max((long) D,N);
+}
+
+static long linal_tsqr_orgqr_LWORK(const long M, const long N)
+{
+  int MM    = M;
+  int NN    = N;
+  int LDA   = MM;
+  int LWORK = -1;
+  int INFO;
+  double D;
+
+  dorgqr_(&MM,&NN,&NN,&D,&LDA,&D,&D,&LWORK,&INFO);
+  return std::max((long) D,N);
+}
+
+static long linal_tsqr_ormqr_LWORK(const long N)
+{
+  char SIDE  = 'L';
+  char TRANS = 'N';
+  int  MM    = 2*N;
+  int  NN    = N;
+  int  LDA   = MM;
+  int  LWORK = -1;
+  int  INFO;
+  double D;
+
+  dormqr_(&SIDE,&TRANS,&MM,&NN,&NN,&D,&LDA,&D,&D,&LDA,&D,&LWORK,&INFO);
+  return std::max((long) D,N);
+}
+
+/*-------------------------------------------------
+  linal_tsqr_upper
+	B = the upper triangle of the NxN A, with
+	zeros below
+-------------------------------------------------*/
+static inline void linal_tsqr_upper(const long N, const double* A, const long LDA,
+                                    double* B, const long LDB)
+{
+  for (long j=0;j<N;j++)
+  {
+    for (long i=0;i<=j;i++) B[i+j*LDB] = A[i+j*LDA];
+    for (long i=j+1;i<N;i++) B[i+j*LDB] = 0;
+  }
+}
+
+static inline void linal_tsqr_error(const char* NAME, const int INFO)
+{
+  printf("%s : LAPACK failed with INFO = %d \n",NAME,INFO);
+  exit(1);
+}
+
+/*-------------------------------------------------
+  linal_dtsqr_factor
+-------------------------------------------------*/
+void linal_dtsqr_factor(const long M, const long N, double* A, const long LDA,
+                        double* R, const long LDR, linal_tsqr_q& QF)
+{
+  if (N < 0 || M < N || LDA < M || LDR < N)
+  {
+    printf("linal_dtsqr_factor : bad input, M = %ld, N = %ld, LDA = %ld, LDR = %ld \n",
+           M,N,LDA,LDR);
+    exit(1);
+  }
+  QF.M = M;
+  QF.N = N;
+  QF.row.assign(2,0);
+  QF.row[1] = M;
+  QF.tau.clear();
+  QF.top.clear();
+  QF.bot.clear();
+  QF.V.clear();
+  QF.vtau.clear();
+  if (N == 0) return;
+
+  //chunks of at least N rows, one per thread
+  long P = 1;
+  #if defined (_OPENMP)
+    if (!omp_in_parallel()) P = omp_get_max_threads();
+  #endif
+  P = std::max(std::min(P,M/N),(M + (long) INT_MAX - 1)/(long) INT_MAX);
+  QF.row.resize(P+1);
+  for (long p=0;p<=P;p++) QF.row[p] = (long) ((double) M*p/P);
+  QF.tau.assign(P*N,0);
+
+  //the tree, pairs of chunks step apart
+  for (long step=1;step<P;step*=2)
+  {
+    for (long p=0;p+step<P;p+=2*step)
+    {
+      QF.top.push_back(p);
+      QF.bot.push_back(p+step);
+    }
+  }
+  const long NN = N*N;
+  const long NODE = (long) QF.top.size();
+  QF.V.assign(NODE*2*NN,0);
+  QF.vtau.assign(NODE*N,0);
+  std::vector<double> RS(P*NN,0);
+
+  //the chunks
+  long MMAX = 0;
+  for (long p=0;p<P;p++) MMAX = std::max(MMAX,QF.row[p+1]-QF.row[p]);
+  const long LWORK = std::max(linal_tsqr_geqrf_LWORK(MMAX,N),linal_tsqr_geqrf_LWORK(2*N,N));
+  int ERR = 0;
+  #pragma omp parallel if (P > 1) num_threads((int) std::min(P,(long) INT_MAX))
+  {
+    std::vector<double> WORK(LWORK);
+    #pragma omp for schedule(static) reduction(|:ERR)
+    for (long p=0;p<P;p++)
+    {
+      int MM = QF.row[p+1]-QF.row[p];
+      int NC = N;
+      int LD = LDA;
+      int LW = LWORK;
+      int INFO;
+      double* AP = A+QF.row[p];
+      dgeqrf_(&MM,&NC,AP,&LD,QF.tau.data()+p*N,WORK.data(),&LW,&INFO);
+      if (INFO != 0) ERR |= 1;
+      linal_tsqr_upper(N,AP,LDA,RS.data()+p*NN,N);
+    }
+
+    //up the tree, a level at a time
+    long node = 0;
+    for (long step=1;step<P;step*=2)
+    {
+      const long NP = (P - step + 2*step - 1)/(2*step);
+      #pragma omp for schedule(static) reduction(|:ERR)
+      for (long n=node;n<node+NP;n++)
+      {
+        double* W  = QF.V.data()+n*2*NN;
+        double* RT = RS.data()+QF.top[n]*NN;
+        double* RB = RS.data()+QF.bot[n]*NN;
+        for (long j=0;j<N;j++)
+        {
+          std::copy(RT+j*N,RT+(j+1)*N,W+j*2*N);
+          std::copy(RB+j*N,RB+(j+1)*N,W+j*2*N+N);
+        }
+        int MM = 2*N;
+        int NC = N;
+        int LW = LWORK;
+        int INFO;
+        dgeqrf_(&MM,&NC,W,&MM,QF.vtau.data()+n*N,WORK.data(),&LW,&INFO);
+        if (INFO != 0) ERR |= 1;
+        linal_tsqr_upper(N,W,2*N,RT,N);
+      }
+      node += NP;
+    }
+  }
+  if (ERR != 0) linal_tsqr_error("linal_dtsqr_factor",ERR);
+
+  linal_tsqr_upper(N,RS.data(),N,R,LDR);
+}
+
+/*-------------------------------------------------
+  linal_dtsqr_formq
+-------------------------------------------------*/
+void linal_dtsqr_formq(const linal_tsqr_q& QF, double* A, const long LDA,
+                       const double* C, const long LDC)
+{
+  const long N  = QF.N;
+  const long NN = N*N;
+  const long P  = (long) QF.row.size() - 1;
+  if (N == 0) return;
+
+  //C of the root, then down the tree
+  std::vector<double> CS(P*NN,0);
+  for (long j=0;j<N;j++)
+  {
+    for (long i=0;i<N;i++) CS[i+j*N] = (C != NULL) ? C[i+j*LDC] : (double) (i == j);
+  }
+  if (QF.top.size() > 0)
+  {
+    const long LWORK = linal_tsqr_ormqr_LWORK(N);
+    std::vector<double> WORK(LWORK), T(2*NN);
+    for (long n=(long) QF.top.size()-1;n>=0;n--)
+    {
+      double* CT = CS.data()+QF.top[n]*NN;
+      double* CB = CS.data()+QF.bot[n]*NN;
+      std::fill(T.begin(),T.end(),0.0);
+      for (long j=0;j<N;j++) std::copy(CT+j*N,CT+(j+1)*N,T.data()+j*2*N);
+
+      char SIDE  = 'L';
+      char TRANS = 'N';
+      int  MM    = 2*N;
+      int  NC    = N;
+      int  LW    = LWORK;
+      int  INFO;
+      dormqr_(&SIDE,&TRANS,&MM,&NC,&NC,const_cast<double*>(QF.V.data())+n*2*NN,&MM,
+              const_cast<double*>(QF.vtau.data())+n*N,T.data(),&MM,WORK.data(),&LW,&INFO);
+      if (INFO != 0) linal_tsqr_error("linal_dtsqr_formq",INFO);
+      for (long j=0;j<N;j++)
+      {
+        std::copy(T.data()+j*2*N,T.data()+j*2*N+N,CT+j*N);
+        std::copy(T.data()+j*2*N+N,T.data()+(j+1)*2*N,CB+j*N);
+      }
+    }
+  }
+
+  //Q of each chunk, times its C
+  long MMAX = 0;
+  for (long p=0;p<P;p++) MMAX = std::max(MMAX,QF.row[p+1]-QF.row[p]);
+  const long LWORK = linal_tsqr_orgqr_LWORK(MMAX,N);
+  int ERR = 0;
+  #pragma omp parallel if (P > 1) num_threads((int) std::min(P,(long) INT_MAX))
+  {
+    std::vector<double> WORK(LWORK), TMP(LINAL_TSQR_ROWS*N,0);
+    #pragma omp for schedule(static) reduction(|:ERR)
+    for (long p=0;p<P;p++)
+    {
+      const long MP = QF.row[p+1]-QF.row[p];
+      double* AP = A+QF.row[p];
+      int MM = MP;
+      int NC = N;
+      int LD = LDA;
+      int LW = LWORK;
+      int INFO;
+      dorgqr_(&MM,&NC,&NC,AP,&LD,const_cast<double*>(QF.tau.data())+p*N,WORK.data(),&LW,&INFO);
+      if (INFO != 0) ERR |= 1;
+
+      double* CP = CS.data()+p*NN;
+      for (long i0=0;i0<MP;i0+=LINAL_TSQR_ROWS)
+      {
+        const int NR = (int) std::min((long) LINAL_TSQR_ROWS,MP-i0);
+        linal_ABpC<double>(NR,N,N,1.0,AP+i0,LDA,CP,N,0.0,TMP.data(),NR);
+        for (long j=0;j<N;j++) std::copy(TMP.data()+j*NR,TMP.data()+(j+1)*NR,AP+i0+j*LDA);
+      }
+    }
+  }
+  if (ERR != 0) linal_tsqr_error("linal_dtsqr_formq",ERR);
+}
+
+/*-------------------------------------------------
+  linal_dtsqr
+-------------------------------------------------*/
+void linal_dtsqr(const long M, const long N, double* A, const long LDA,
+                 double* R, const long LDR)
+{
+  linal_tsqr_q QF;
+  linal_dtsqr_factor(M,N,A,LDA,R,LDR,QF);
+  linal_dtsqr_formq(QF,A,LDA);
+}
+
+void linal_dtsqr(gemat<double>& A, gemat<double>& R)
+{
+  const long N = A.cols();
+  if (R.rows() != N || R.cols() != N)
+  {
+    if (R.is_allocated()) R.deallocate();
+    R.allocate(N,N);
+  }
+  linal_dtsqr(A.rows(),N,A.data(),A.ld(),R.data(),R.ld());
+}
@@ -0,0 +1,88 @@
+/*-------------------------------------------------
+  linal_tsqr.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for the tall skinny QR (TSQR) of an MxN
+  matrix with M >> N, e.g., a block of Davidson or
+  Krylov vectors
+
+  A = Q . R
+
+  Q is MxN with orthonormal columns, R is NxN upper
+  triangular. The rows of A are cut into a chunk
+  for each thread, each chunk is factored with the
+  blocked Householder QR of LAPACK (dgeqrf), and the
+  NxN R's of the chunks are then combined pairwise
+  up a binary tree, each pair with the QR of the
+  2NxN stack of the two. Q is never formed on the
+  way up, and only the small R's move, so this is
+  one pass over A in place of the N^2/2 dot
+  products (and N passes) of Gram-Schmidt, and is
+  as stable as Householder QR (Demmel et al., SIAM
+  J. Sci. Comput. 34, A206 (2012)).
+
+  linal_dtsqr_factor : R, and Q implicitly. A is
+    overwritten with the reflectors of the chunks,
+    and QF keeps those of the tree
+  linal_dtsqr_formq  : A = Q (or Q.C for an NxN C),
+    from the output of linal_dtsqr_factor
+  linal_dtsqr        : both, A is overwritten by Q
+
+  For A distributed by rows over MPI tasks, see
+  Ptsqr (ptsqr.hpp), which combines the R of each
+  task in one more step, with linal_dtsqr_formq(C).
+
+  Within an OpenMP parallel region this is one
+  chunk (the LAPACK QR) on the calling thread.
+
+Parameters
+M	long		#rows of A
+N	long		#cols of A, M >= N
+A	double*		matrix to factor, or gemat<double>
+LDA	long		leading dimension of A
+R	double*		upper triangle, or gemat<double>
+LDR	long		leading dimension of R
+QF	linal_tsqr_q&	implicit Q
+C	const double*	NxN matrix, NULL for the identity
+LDC	long		leading dimension of C
+-------------------------------------------------*/
+#ifndef LINAL_TSQR_HPP
+#define LINAL_TSQR_HPP
+#include <vector>
+#include "lapack_interface.hpp"
+#include "linal_def.hpp"
+#include "gemat.hpp"
+
+//rows of the product with C at a time, in linal_dtsqr_formq
+#if !defined (LINAL_TSQR_ROWS)
+  #define LINAL_TSQR_ROWS 512
+#endif
+
+/*-------------------------------------------------
+  linal_tsqr_q
+	the implicit Q of linal_dtsqr_factor, less
+	the reflectors of the chunks, which stay in A
+-------------------------------------------------*/
+struct linal_tsqr_q
+{
+  long M, N;
+  std::vector<long>   row;	//first row of each chunk, and M
+  std::vector<double> tau;	//N for each chunk
+  std::vector<long>   top;	//chunks of the two R's of each tree node,
+  std::vector<long>   bot;	//  in the order they were made
+  std::vector<double> V;	//2NxN reflectors of each tree node
+  std::vector<double> vtau;	//N for each tree node
+};
+
+void linal_dtsqr_factor(const long M, const long N, double* A, const long LDA,
+                        double* R, const long LDR, linal_tsqr_q& QF);
+
+void linal_dtsqr_formq(const linal_tsqr_q& QF, double* A, const long LDA,
+                       const double* C=NULL, const long LDC=0);
+
+void linal_dtsqr(const long M, const long N, double* A, const long LDA,
+                 double* R, const long LDR);
+
+void linal_dtsqr(gemat<double>& A, gemat<double>& R);
+
+#endif
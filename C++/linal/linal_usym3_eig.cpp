@@ -0,0 +1,152 @@
+/*----------------------------------------------------------------
+  linal_usym3_eig.cpp
+	JHT, October 14, 2026 : created
+
+  - eigenvalues and eigenvectors of an upper symmetric 3x3
+    matrix A, in closed form, see linal_usym3_eig.hpp
+
+        A              V
+  | 0  1  3 |    | 0  3  6 |
+  |    2  4 |    | 1  4  7 |
+  |       5 |    | 2  5  8 |
+
+    The kernel has no loops, and only selects where the roots
+    or vectors are chosen, so the batched version vectorizes
+    across the matrices.
+-----------------------------------------------------------------*/
+#include <cmath>
+#include "linal_usym3_eig.hpp"
+
+/*----------------------------------------------------------------
+  usym3_eig_kernel
+	A, W, V as for one matrix
+-----------------------------------------------------------------*/
+template <typename T>
+static inline void usym3_eig_kernel(const T* A, T* W, T* V)
+{
+  const T ZERO = (T) 0;
+  const T ONE  = (T) 1;
+
+  //scale by the largest element
+  T s = std::fabs(A[0]);
+  s = std::fabs(A[1]) > s ? std::fabs(A[1]) : s;
+  s = std::fabs(A[2]) > s ? std::fabs(A[2]) : s;
+  s = std::fabs(A[3]) > s ? std::fabs(A[3]) : s;
+  s = std::fabs(A[4]) > s ? std::fabs(A[4]) : s;
+  s = std::fabs(A[5]) > s ? std::fabs(A[5]) : s;
+  const T is = s > ZERO ? ONE/s : ZERO;
+  const T b00 = A[0]*is, b01 = A[1]*is, b11 = A[2]*is;
+  const T b02 = A[3]*is, b12 = A[4]*is, b22 = A[5]*is;
+
+  //eigenvalues, w = q + 2 p cos(phi + 2 pi k/3)
+  const T q   = (b00 + b11 + b22)/((T) 3);
+  const T c00 = b00 - q, c11 = b11 - q, c22 = b22 - q;
+  const T p1  = b01*b01 + b02*b02 + b12*b12;
+  const T p2  = c00*c00 + c11*c11 + c22*c22 + ((T) 2)*p1;
+  const T p   = std::sqrt(p2/((T) 6));
+  const T ip  = p > ZERO ? ONE/p : ZERO;
+  const T det = c00*(c11*c22 - b12*b12) - b01*(b01*c22 - b12*b02) + b02*(b01*b12 - c11*b02);
+  T r = ((T) 0.5)*det*ip*ip*ip;
+  r = r < -ONE ? -ONE : r;
+  r = r >  ONE ?  ONE : r;
+  const T phi = std::acos(r)/((T) 3);
+  const T w2  = q + ((T) 2)*p*std::cos(phi);
+  const T w0  = q + ((T) 2)*p*std::cos(phi + (T) 2.0943951023931954923);
+  const T w1  = ((T) 3)*q - w0 - w2;
+
+  //the most separated root first
+  const bool top = (w2 - w1) >= (w1 - w0);
+  const T wi = top ? w2 : w0;
+
+  //its vector is the largest cross product of the rows of B - wi I
+  const T r00 = b00 - wi, r11 = b11 - wi, r22 = b22 - wi;
+  const T x0 = b01*b12 - b02*r11, x1 = b02*b01 - r00*b12, x2 = r00*r11 - b01*b01; //r0 x r1
+  const T y0 = b01*r22 - b02*b12, y1 = b02*b02 - r00*r22, y2 = r00*b12 - b01*b02; //r0 x r2
+  const T z0 = r11*r22 - b12*b12, z1 = b12*b02 - b01*r22, z2 = b01*b12 - r11*b02; //r1 x r2
+  const T nx = x0*x0 + x1*x1 + x2*x2;
+  const T ny = y0*y0 + y1*y1 + y2*y2;
+  const T nz = z0*z0 + z1*z1 + z2*z2;
+  T u0 = x0, u1 = x1, u2 = x2, nu = nx;
+  u0 = ny > nu ? y0 : u0; u1 = ny > nu ? y1 : u1; u2 = ny > nu ? y2 : u2; nu = ny > nu ? ny : nu;
+  u0 = nz > nu ? z0 : u0; u1 = nz > nu ? z1 : u1; u2 = nz > nu ? z2 : u2; nu = nz > nu ? nz : nu;
+  const T iu = nu > ZERO ? ONE/std::sqrt(nu) : ZERO;
+  u0 *= iu; u1 *= iu; u2 *= iu;
+
+  //an orthonormal basis e,f of the plane orthogonal to u
+  const bool ex = std::fabs(u0) > std::fabs(u1);
+  T e0 = ex ? -u2 : ZERO;
+  T e1 = ex ? ZERO : u2;
+  T e2 = ex ? u0 : -u1;
+  const T ne = e0*e0 + e1*e1 + e2*e2;
+  const T ie = ne > ZERO ? ONE/std::sqrt(ne) : ZERO;
+  e0 *= ie; e1 *= ie; e2 *= ie;
+  const T f0 = u1*e2 - u2*e1, f1 = u2*e0 - u0*e2, f2 = u0*e1 - u1*e0;
+
+  //the other two roots are those of the 2x2 e,f block of B, which keeps
+  //them accurate when they are close
+  const T be0 = b00*e0 + b01*e1 + b02*e2, be1 = b01*e0 + b11*e1 + b12*e2, be2 = b02*e0 + b12*e1 + b22*e2;
+  const T bf0 = b00*f0 + b01*f1 + b02*f2, bf1 = b01*f0 + b11*f1 + b12*f2, bf2 = b02*f0 + b12*f1 + b22*f2;
+  const T m00 = e0*be0 + e1*be1 + e2*be2;
+  const T m01 = e0*bf0 + e1*bf1 + e2*bf2;
+  const T m11 = f0*bf0 + f1*bf1 + f2*bf2;
+  const T h   = ((T) 0.5)*(m00 - m11);
+  const T g   = std::sqrt(h*h + m01*m01);
+  const T ml  = ((T) 0.5)*(m00 + m11) - g;
+  const T mh  = ((T) 0.5)*(m00 + m11) + g;
+  const bool hp = h >= ZERO;
+  const T g0 = hp ? h + g : m01;
+  const T g1 = hp ? m01 : g - h;
+  const T ng = g0*g0 + g1*g1;
+  const T ig = ng > ZERO ? ONE/std::sqrt(ng) : ZERO;
+  const T ce = ng > ZERO ? g0*ig : ONE;
+  const T cf = ng > ZERO ? g1*ig : ZERO;
+  const T h0 = ce*e0 + cf*f0, h1 = ce*e1 + cf*f1, h2 = ce*e2 + cf*f2;   //of mh
+  const T l0 = cf*e0 - ce*f0, l1 = cf*e1 - ce*f1, l2 = cf*e2 - ce*f2;   //of ml
+
+  //a multiple of the identity has p = 0
+  const bool iden = !(p > ZERO);
+  const T wa = top ? ml : wi;
+  const T wb = top ? mh : ml;
+  const T wc = top ? wi : mh;
+  const T a0 = iden ? ONE  : (top ? l0 : u0);
+  const T a1 = iden ? ZERO : (top ? l1 : u1);
+  const T a2 = iden ? ZERO : (top ? l2 : u2);
+  const T c0 = iden ? ZERO : (top ? u0 : h0);
+  const T c1 = iden ? ZERO : (top ? u1 : h1);
+  const T c2 = iden ? ONE  : (top ? u2 : h2);
+  const T d0 = iden ? ZERO : (top ? h0 : l0);
+  const T d1 = iden ? ONE  : (top ? h1 : l1);
+  const T d2 = iden ? ZERO : (top ? h2 : l2);
+
+  W[0] = (iden ? q : wa)*s;
+  W[1] = (iden ? q : wb)*s;
+  W[2] = (iden ? q : wc)*s;
+  V[0] = a0; V[1] = a1; V[2] = a2;
+  V[3] = d0; V[4] = d1; V[5] = d2;
+  V[6] = c0; V[7] = c1; V[8] = c2;
+}
+
+template <typename T>
+void linal_usym3_eig(const T* A, T* W, T* V)
+{
+  usym3_eig_kernel<T>(A,W,V);
+}
+
+template <typename T>
+void linal_usym3_eig_batch(const long NA, const T* A, T* W, T* V)
+{
+  #pragma omp simd
+  for (long n=0;n<NA;n++)
+  {
+    T a[6], w[3], v[9];
+    for (int k=0;k<6;k++) a[k] = A[k*NA+n];
+    usym3_eig_kernel<T>(a,w,v);
+    for (int k=0;k<3;k++) W[k*NA+n] = w[k];
+    for (int k=0;k<9;k++) V[k*NA+n] = v[k];
+  }
+}
+
+template void linal_usym3_eig<double>(const double* A, double* W, double* V);
+template void linal_usym3_eig<float>(const float* A, float* W, float* V);
+template void linal_usym3_eig_batch<double>(const long NA, const double* A, double* W, double* V);
+template void linal_usym3_eig_batch<float>(const long NA, const float* A, float* W, float* V);
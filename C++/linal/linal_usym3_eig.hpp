@@ -0,0 +1,37 @@
+/*----------------------------------------------------------------
+  linal_usym3_eig.hpp
+	JHT, October 14, 2026 : created
+
+  Eigenvalues and eigenvectors of a symmetric 3x3 matrix, which
+  is assumed to be stored upper triangular
+
+        A
+  | 0  1  3 |
+  |    2  4 |
+  |       5 |
+
+  in closed form, without LAPACK. The most separated eigenvalue
+  is a root of the characteristic cubic, from the trigonometric
+  solution, and its eigenvector the largest cross product of the
+  rows of A - w I. The other two pairs are those of the 2x2 block
+  of A in the plane orthogonal to it, as in Eberly's robust solver,
+  so close or repeated roots stay accurate and their vectors
+  orthonormal. A is scaled by its largest element first.
+
+  W gets the 3 eigenvalues in ascending order, and V the
+  eigenvectors as columns (column major, 3x3).
+
+  linal_usym3_eig_batch does NA matrices, in struct-of-arrays
+  order, and the loop over the matrices is an omp simd loop
+    A[k*NA + n]  element k of matrix n, k < 6
+    W[k*NA + n]  eigenvalue k of matrix n, k < 3
+    V[k*NA + n]  element k of the eigenvectors of matrix n, k < 9
+-----------------------------------------------------------------*/
+#ifndef LINAL_USYM3_EIG_HPP
+#define LINAL_USYM3_EIG_HPP
+template <typename T>
+void linal_usym3_eig(const T* A, T* W, T* V);
+
+template <typename T>
+void linal_usym3_eig_batch(const long NA, const T* A, T* W, T* V);
+#endif
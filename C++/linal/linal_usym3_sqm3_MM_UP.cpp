@@ -23,8 +23,8 @@ template <typename T>
   *(C+1) = *(A+0)**(B+3) + *(A+1)**(B+4)+ *(A+3)**(B+5);
   *(C+2) = *(A+1)**(B+3) + *(A+2)**(B+4)+ *(A+4)**(B+5);
   *(C+3) = *(A+0)**(B+6) + *(A+1)**(B+7)+ *(A+3)**(B+8);
-  *(C+4) = *(A+1)**(B+7) + *(A+2)**(B+7)+ *(A+4)**(B+8);
-  *(C+5) = *(A+3)**(B+7) + *(A+4)**(B+7)+ *(A+5)**(B+8);
+  *(C+4) = *(A+1)**(B+6) + *(A+2)**(B+7)+ *(A+4)**(B+8);
+  *(C+5) = *(A+3)**(B+6) + *(A+4)**(B+7)+ *(A+5)**(B+8);
 }
 
 template  void linal_usym3_sqm3_MM_UP<double>(const double* A, const double* B, double* C);
@@ -0,0 +1,176 @@
+/*-------------------------------------------------
+  linal_usym_chol.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for the packed Cholesky factorization,
+  solve, and inverse, see linal_usym_chol.hpp
+
+  Column j of the packed upper triangle starts at
+  j*(j+1)/2, and holds rows 0 to j
+-------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <algorithm>
+#include "linal_usym_chol.hpp"
+#include "linal_par.hpp"
+#include "simd.hpp"
+
+/*-------------------------------------------------
+  number of threads to use for FLOPS of work
+-------------------------------------------------*/
+static inline int linal_usym_chol_nthr(const double FLOPS)
+{
+  #if defined (_OPENMP)
+    if (omp_in_parallel() || FLOPS < (double) LINAL_PAR_MIN_FLOPS) return 1;
+    return omp_get_max_threads();
+  #else
+    return 1;
+  #endif
+}
+
+/*-------------------------------------------------
+  linal_usym_pptrf
+	- each block of columns jb:je is first solved
+	  against columns 0:jb of U, in chunks of NB,
+	  threaded over the columns of the block, and
+	  then the diagonal block is factored
+-------------------------------------------------*/
+template <typename T>
+long linal_usym_pptrf(usymat<T>& A)
+{
+  const long N  = A.cols();
+  const long NB = LINAL_USYM_CHOL_NB;
+  if (N == 0) return 0;
+  T* AP = &A[0];
+
+  for (long jb=0;jb<N;jb+=NB)
+  {
+    const long je  = std::min(N,jb+NB);
+    const int nthr = linal_usym_chol_nthr((double) jb*jb*(je-jb));
+
+    //rows 0:jb of the block
+    #pragma omp parallel num_threads(nthr) if(nthr > 1)
+    {
+      for (long ib=0;ib<jb;ib+=NB)
+      {
+        const long ie = std::min(jb,ib+NB);
+        #pragma omp for schedule(static)
+        for (long j=jb;j<je;j++)
+        {
+          T* x = AP + j*(j+1)/2;
+          for (long i=ib;i<ie;i++)
+          {
+            const T* u = AP + i*(i+1)/2;
+            x[i] = (x[i] - simd_dot<T>(i,u,x))/u[i];
+          }
+        }
+      }
+    }
+
+    //the diagonal block
+    for (long j=jb;j<je;j++)
+    {
+      T* x = AP + j*(j+1)/2;
+      for (long i=jb;i<j;i++)
+      {
+        const T* u = AP + i*(i+1)/2;
+        x[i] = (x[i] - simd_dot<T>(i,u,x))/u[i];
+      }
+      const T d = x[j] - simd_dot<T>(j,x,x);
+      if (!(d > (T) 0)) return j+1;
+      x[j] = (T) sqrt((double) d);
+    }
+  }
+  return 0;
+}
+template long linal_usym_pptrf<double>(usymat<double>& A);
+template long linal_usym_pptrf<float>(usymat<float>& A);
+
+/*-------------------------------------------------
+  linal_usym_pptrs
+	- U^T y = b with dots, then U x = y with
+	  axpys, for each column of B
+-------------------------------------------------*/
+template <typename T>
+void linal_usym_pptrs(const usymat<T>& U, gemat<T>& B)
+{
+  const long N    = U.cols();
+  const long NRHS = B.cols();
+  if (B.rows() != N)
+  {
+    printf("linal_usym_pptrs : B has %ld rows, U is %ld x %ld \n",B.rows(),N,N);
+    exit(1);
+  }
+  if (N == 0 || NRHS == 0) return;
+  const T* UP   = &U[0];
+  T* BP         = B.data();
+  const long LD = B.ld();
+  const int nthr = linal_usym_chol_nthr(2.0*N*N*NRHS);
+
+  #pragma omp parallel for schedule(static) num_threads(nthr) if(nthr > 1)
+  for (long k=0;k<NRHS;k++)
+  {
+    T* y = BP + k*LD;
+    for (long i=0;i<N;i++)
+    {
+      const T* u = UP + i*(i+1)/2;
+      y[i] = (y[i] - simd_dot<T>(i,u,y))/u[i];
+    }
+    for (long i=N-1;i>=0;i--)
+    {
+      const T* u = UP + i*(i+1)/2;
+      y[i] = y[i]/u[i];
+      simd_axpy<T>(i,-y[i],u,y);
+    }
+  }
+}
+template void linal_usym_pptrs<double>(const usymat<double>& U, gemat<double>& B);
+template void linal_usym_pptrs<float>(const usymat<float>& U, gemat<float>& B);
+
+/*-------------------------------------------------
+  linal_usym_pptri
+	- U is inverted in place, column by column as
+	  tptri, and then A^-1 = U^-1 U^-T is built as
+	  pptri, a rank-1 update of the leading block
+	  per column, threaded over its columns
+-------------------------------------------------*/
+template <typename T>
+long linal_usym_pptri(usymat<T>& U)
+{
+  const long N = U.cols();
+  if (N == 0) return 0;
+  T* UP = &U[0];
+
+  //U^-1
+  for (long j=0;j<N;j++)
+  {
+    T* x = UP + j*(j+1)/2;
+    if (x[j] == (T) 0) return j+1;
+    x[j] = ((T) 1)/x[j];
+    const T ajj = -x[j];
+    for (long k=0;k<j;k++)
+    {
+      const T* u = UP + k*(k+1)/2;
+      simd_axpy<T>(k,x[k],u,x);
+      x[k] *= u[k];
+    }
+    simd_scal_mul<T>(j,ajj,x);
+  }
+
+  //U^-1 U^-T
+  for (long j=0;j<N;j++)
+  {
+    T* x = UP + j*(j+1)/2;
+    const int nthr = linal_usym_chol_nthr((double) j*j);
+    #pragma omp parallel for schedule(static) num_threads(nthr) if(nthr > 1)
+    for (long c=0;c<j;c++)
+    {
+      simd_axpy<T>(c+1,x[c],x,UP + c*(c+1)/2);
+    }
+    simd_scal_mul<T>(j+1,x[j],x);
+  }
+  return 0;
+}
+template long linal_usym_pptri<double>(usymat<double>& U);
+template long linal_usym_pptri<float>(usymat<float>& U);
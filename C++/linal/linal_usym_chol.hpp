@@ -0,0 +1,58 @@
+/*-------------------------------------------------
+  linal_usym_chol.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for the Cholesky factorization, solve,
+  and inverse of a positive definite matrix, in the
+  packed storage of a usymat, as LAPACK's pptrf,
+  pptrs and pptri, but without the unpacking to a
+  square matrix
+
+  A = U^T . U
+
+  linal_usym_pptrf(A)     : A is replaced by U, and
+                            the return is 0, or
+                            k+1 if the leading
+                            (k+1)x(k+1) block is not
+                            positive definite
+  linal_usym_pptrs(U,B)   : B is replaced by A^-1 B,
+                            for the gemat B (n x nrhs)
+  linal_usym_pptri(U)     : U is replaced by A^-1,
+                            the return as pptrf
+
+  Columns of the packed upper triangle are contiguous,
+  so everything goes through simd_dot and simd_axpy
+  on columns. The factorization is left looking, as
+  pptrf, but in blocks of LINAL_USYM_CHOL_NB columns,
+  which are solved against LINAL_USYM_CHOL_NB columns
+  of U at a time, so that these stay in cache, and
+  the columns of a block are threaded. The solve
+  threads over the columns of B, and the inverse
+  over the columns of the rank-1 updates.
+
+Parameters
+A	usymat<T>&	matrix, factor on exit
+U	usymat<T>&	factor from pptrf
+B	gemat<T>&	right hand sides, n x nrhs
+-------------------------------------------------*/
+#ifndef LINAL_USYM_CHOL_HPP
+#define LINAL_USYM_CHOL_HPP
+#include "linal_def.hpp"
+#include "gemat.hpp"
+#include "usymat.hpp"
+
+//columns per block of the factorization
+#if !defined (LINAL_USYM_CHOL_NB)
+  #define LINAL_USYM_CHOL_NB 64
+#endif
+
+template <typename T>
+long linal_usym_pptrf(usymat<T>& A);
+
+template <typename T>
+void linal_usym_pptrs(const usymat<T>& U, gemat<T>& B);
+
+template <typename T>
+long linal_usym_pptri(usymat<T>& U);
+
+#endif
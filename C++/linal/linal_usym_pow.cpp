@@ -0,0 +1,259 @@
+/*-------------------------------------------------
+  linal_usym_pow.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for the powers of a packed symmetric
+  matrix, see linal_usym_pow.hpp
+
+  Column j of the packed upper triangle starts at
+  j*(j+1)/2, and holds rows 0 to j
+-------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <float.h>
+#include <vector>
+#include <algorithm>
+#include "linal_usym_pow.hpp"
+#include "linal_decomp.hpp"
+#include "linal_gemm.hpp"
+#include "linal_par.hpp"
+
+/*-------------------------------------------------
+  number of threads to use for FLOPS of work
+-------------------------------------------------*/
+static inline int linal_usym_pow_nthr(const double FLOPS)
+{
+  #if defined (_OPENMP)
+    if (omp_in_parallel() || FLOPS < (double) LINAL_PAR_MIN_FLOPS) return 1;
+    return omp_get_max_threads();
+  #else
+    return 1;
+  #endif
+}
+
+//the packed upper triangle to the square NxN A
+template <typename T>
+static void linal_usym_pow_unpack(const long N, const T* UP, T* A)
+{
+  for (long j=0;j<N;j++)
+  {
+    const T* x = UP + j*(j+1)/2;
+    for (long i=0;i<=j;i++) {A[j*N+i] = x[i]; A[i*N+j] = x[i];}
+  }
+}
+
+/*-------------------------------------------------
+  linal_usym_pow
+	- V^T (KxN) and D.V^T (KxN) of the K kept
+	  eigenvalues, then tile (it,jt) of the upper
+	  triangle is V(ib,:).D.V(jb,:)^T, an A^T.B
+	  linal_gemm of columns ib and jb of these,
+	  copied to the packed columns
+-------------------------------------------------*/
+long linal_usym_pow(usymat<double>& U, const double P, Core<double>& CORE, int& INFO,
+                    const double TOL)
+{
+  const long N  = U.cols();
+  const long NB = LINAL_USYM_POW_NB;
+  INFO = 0;
+  if (N == 0) return 0;
+  double* UP = &U[0];
+
+  double* A = CORE.checkout(N*N);
+  double* W = CORE.checkout(N);
+  for (long j=0;j<N;j++) {for (long i=0;i<=j;i++) A[j*N+i] = UP[j*(j+1)/2+i];}
+  linal_dsyevd(N,A,W,CORE,INFO);
+  if (INFO != 0)
+  {
+    CORE.remove(N);
+    CORE.remove(N*N);
+    return 0;
+  }
+
+  //the kept eigenvalues
+  const bool pint = (P == floor(P));
+  double wmax = 0;
+  for (long k=0;k<N;k++) wmax = std::max(wmax,fabs(W[k]));
+  std::vector<long> kept;
+  for (long k=0;k<N;k++)
+  {
+    bool keep = true;
+    if (pint && P < 0) keep = (fabs(W[k]) > TOL*wmax);
+    else if (!pint)    keep = (W[k] > TOL*wmax);
+    if (keep) kept.push_back(k);
+  }
+  const long K = (long) kept.size();
+  if (K == 0)
+  {
+    for (long i=0;i<N*(N+1)/2;i++) UP[i] = 0;
+    CORE.remove(N);
+    CORE.remove(N*N);
+    return N;
+  }
+
+  //V^T and D.V^T, K x N
+  double* VT = CORE.checkout(K*N);
+  double* DV = CORE.checkout(K*N);
+  for (long k=0;k<K;k++)
+  {
+    const double  d = pow(W[kept[k]],P);
+    const double* v = A + kept[k]*N;
+    for (long i=0;i<N;i++)
+    {
+      VT[i*K+k] = v[i];
+      DV[i*K+k] = d*v[i];
+    }
+  }
+
+  //the upper tiles, it <= jt
+  const long nt   = (N + NB - 1)/NB;
+  const long np   = nt*(nt+1)/2;
+  const int  nthr = linal_usym_pow_nthr((double) N*N*K);
+  #pragma omp parallel num_threads(nthr) if(nthr > 1)
+  {
+    std::vector<double> C(NB*NB);
+    #pragma omp for schedule(dynamic)
+    for (long p=0;p<np;p++)
+    {
+      long jt = (long) ((sqrt(8.0*p+1.0)-1.0)/2.0);
+      while (jt*(jt+1)/2 > p) jt--;
+      while ((jt+1)*(jt+2)/2 <= p) jt++;
+      const long it = p - jt*(jt+1)/2;
+      const long ib = it*NB, ni = std::min(NB,N-ib);
+      const long jb = jt*NB, nj = std::min(NB,N-jb);
+      linal_gemm<double>(true,ni,nj,K,1.0,VT+ib*K,K,DV+jb*K,K,0.0,&C[0],ni);
+      for (long j=jb;j<jb+nj;j++)
+      {
+        double* x = UP + j*(j+1)/2;
+        const double* c = &C[(j-jb)*ni];
+        const long ie = std::min(ib+ni,j+1);
+        for (long i=ib;i<ie;i++) x[i] = c[i-ib];
+      }
+    }
+  }
+
+  CORE.remove(K*N);
+  CORE.remove(K*N);
+  CORE.remove(N);
+  CORE.remove(N*N);
+  return N - K;
+}
+
+long linal_usym_pow_NWORK(const long N)
+{
+  return N*N + N + std::max(linal_dsyevd_NWORK(N),2*N*N);
+}
+
+/*-------------------------------------------------
+  linal_usym_ns
+	- the coupled Newton-Schulz iteration, with
+	  X = Z.Y giving both the residual I - X and
+	  the T of the step
+-------------------------------------------------*/
+template <typename T>
+static int linal_usym_ns(usymat<T>& U, const bool INV, Core<T>& CORE, const T TOL,
+                         const int MAXIT, void (*GEMM)(const int, const int, const int, const T, T*,
+                                                       T*, const T, T*))
+{
+  const long N  = U.cols();
+  const long NN = N*N;
+  if (N == 0) return 0;
+  T* UP = &U[0];
+
+  double c = 0;
+  for (long j=0;j<N;j++)
+  {
+    const T* x = UP + j*(j+1)/2;
+    for (long i=0;i<j;i++) c += 2.0*(double) x[i]*(double) x[i];
+    c += (double) x[j]*(double) x[j];
+  }
+  c = sqrt(c);
+  if (!(c > 0.0) || c > DBL_MAX) return -1;
+  const double tol = (TOL > 0) ? (double) TOL
+                               : 100.0*N*((sizeof(T) == sizeof(float)) ? FLT_EPSILON : DBL_EPSILON);
+
+  T* Y  = CORE.checkout(NN);
+  T* Z  = CORE.checkout(NN);
+  T* TT = CORE.checkout(NN);
+  T* X  = CORE.checkout(NN);
+  linal_usym_pow_unpack<T>(N,UP,Y);
+  for (long i=0;i<NN;i++) {Y[i] = (T) (Y[i]/c); Z[i] = 0;}
+  for (long i=0;i<N;i++) Z[i*N+i] = 1;
+
+  int iter = -1;
+  for (int it=0;it<=MAXIT;it++)
+  {
+    GEMM(N,N,N,(T) 1,Z,Y,(T) 0,X);
+    double res = 0;
+    for (long j=0;j<N;j++)
+    {
+      for (long i=0;i<N;i++)
+      {
+        const double r = ((i == j) ? 1.0 : 0.0) - (double) X[j*N+i];
+        res += r*r;
+      }
+    }
+    res = sqrt(res);
+    if (res < tol) {iter = it; break;}
+    if (it == MAXIT || !(res < 1.0E10)) break;
+
+    for (long i=0;i<NN;i++) TT[i] = (T) (-0.5)*X[i];
+    for (long i=0;i<N;i++) TT[i*N+i] += (T) 1.5;
+    GEMM(N,N,N,(T) 1,Y,TT,(T) 0,X);
+    std::swap(Y,X);
+    GEMM(N,N,N,(T) 1,TT,Z,(T) 0,X);
+    std::swap(Z,X);
+  }
+
+  const double s = INV ? 1.0/sqrt(c) : sqrt(c);
+  const T* R = INV ? Z : Y;
+  for (long j=0;j<N;j++)
+  {
+    T* x = UP + j*(j+1)/2;
+    for (long i=0;i<=j;i++) x[i] = (T) (0.5*s*((double) R[j*N+i] + (double) R[i*N+j]));
+  }
+
+  CORE.remove(NN);
+  CORE.remove(NN);
+  CORE.remove(NN);
+  CORE.remove(NN);
+  return iter;
+}
+
+template <typename T>
+int linal_usym_invsqrt_ns(usymat<T>& U, Core<T>& CORE, const T TOL, const int MAXIT,
+                          void (*GEMM)(const int, const int, const int, const T, T*,
+                                       T*, const T, T*))
+{
+  return linal_usym_ns<T>(U,true,CORE,TOL,MAXIT,GEMM);
+}
+template int linal_usym_invsqrt_ns<double>(usymat<double>& U, Core<double>& CORE, const double TOL,
+                                           const int MAXIT,
+                                           void (*GEMM)(const int, const int, const int, const double,
+                                                        double*, double*, const double, double*));
+template int linal_usym_invsqrt_ns<float>(usymat<float>& U, Core<float>& CORE, const float TOL,
+                                          const int MAXIT,
+                                          void (*GEMM)(const int, const int, const int, const float,
+                                                       float*, float*, const float, float*));
+
+template <typename T>
+int linal_usym_sqrt_ns(usymat<T>& U, Core<T>& CORE, const T TOL, const int MAXIT,
+                       void (*GEMM)(const int, const int, const int, const T, T*,
+                                    T*, const T, T*))
+{
+  return linal_usym_ns<T>(U,false,CORE,TOL,MAXIT,GEMM);
+}
+template int linal_usym_sqrt_ns<double>(usymat<double>& U, Core<double>& CORE, const double TOL,
+                                        const int MAXIT,
+                                        void (*GEMM)(const int, const int, const int, const double,
+                                                     double*, double*, const double, double*));
+template int linal_usym_sqrt_ns<float>(usymat<float>& U, Core<float>& CORE, const float TOL,
+                                       const int MAXIT,
+                                       void (*GEMM)(const int, const int, const int, const float,
+                                                    float*, float*, const float, float*));
+
+long linal_usym_ns_NWORK(const long N)
+{
+  return 4*N*N;
+}
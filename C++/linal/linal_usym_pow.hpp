@@ -0,0 +1,104 @@
+/*-------------------------------------------------
+  linal_usym_pow.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for the powers of a symmetric matrix in
+  the packed storage of a usymat, e.g. the inverse
+  square root S^-1/2 of an overlap matrix
+
+  linal_usym_pow(U,P,CORE,INFO,TOL) : U is replaced
+    by U^P = V . diag(w^P) . V^T, from the eigen-
+    decomposition of U (linal_dsyevd). The product
+    is done in one pass, in NB x NB tiles of the
+    packed upper triangle only, each tile one
+    linal_gemm (A^T.B) of the eigenvectors with the
+    scaled eigenvectors, threaded over the tiles.
+    This is half the flops of the full product,
+    and there is no square output to pack.
+
+    For P a non-negative integer all eigenvalues
+    are used. For a negative integer P those with
+    |w| <= TOL*max|w| are dropped, and for a non-
+    integer P those with w <= TOL*max|w| (zero, or
+    negative), as in canonical orthogonalization,
+    so the result is the power of the positive
+    part of U. The return is the number of
+    dropped eigenvalues. INFO is the status of
+    dsyevd, U is unchanged if it is not 0.
+    double only (the LAPACK interface has dsyevd).
+    CORE needs linal_usym_pow_NWORK(N) elements.
+
+  linal_usym_invsqrt_ns(U,CORE,TOL,MAXIT,GEMM) : U
+  linal_usym_sqrt_ns(U,CORE,TOL,MAXIT,GEMM)    : is
+    replaced by U^-1/2 (U^1/2), with the coupled
+    Newton-Schulz iteration (Higham, "Functions of
+    Matrices", 6.3), for a positive definite U,
+
+      A = U/c, Y = A, Z = I, c = ||U||_F
+      T = (3I - Z.Y)/2, Y = Y.T, Z = T.Z
+
+    Y -> A^1/2, Z -> A^-1/2, quadratically once
+    ||I - Z.Y|| < 1. There is no eigensolver, only
+    three NxN products per iteration, all through
+    GEMM, which has the signature of linal_ABpC and
+    defaults to it. With linal_ABpC_gpu (see
+    linal_gpu.hpp, linal_usym_invsqrt_ns_gpu) the
+    iteration runs on the GPUs. The number of
+    iterations grows with log(cond(U)), so this is
+    for well conditioned U. The return is the
+    number of iterations, or -1 if ||I - Z.Y||_F
+    was still above TOL after MAXIT (U is then the
+    last iterate). TOL <= 0 is 100*N*eps. CORE
+    needs linal_usym_ns_NWORK(N) elements.
+
+Parameters
+U	usymat<T>&	matrix, U^P on exit
+P	double		power
+CORE	Core<T>&	workspace
+INFO	int&		dsyevd job status
+TOL	T		relative eigenvalue cutoff, or
+			tolerance of the iteration
+MAXIT	int		most iterations
+GEMM	void(*)		C = ALPHA*A.B + BETA*C
+-------------------------------------------------*/
+#ifndef LINAL_USYM_POW_HPP
+#define LINAL_USYM_POW_HPP
+#include "linal_def.hpp"
+#include "linal_ABpC.hpp"
+#include "usymat.hpp"
+#include "core.hpp"
+
+//tile of the packed product
+#if !defined (LINAL_USYM_POW_NB)
+  #define LINAL_USYM_POW_NB 128
+#endif
+
+//relative cutoff of the eigenvalues
+#if !defined (LINAL_USYM_POW_TOL)
+  #define LINAL_USYM_POW_TOL 1.0E-12
+#endif
+
+//most Newton-Schulz iterations
+#if !defined (LINAL_USYM_NS_MAXIT)
+  #define LINAL_USYM_NS_MAXIT 100
+#endif
+
+long linal_usym_pow(usymat<double>& U, const double P, Core<double>& CORE, int& INFO,
+                    const double TOL=LINAL_USYM_POW_TOL);
+long linal_usym_pow_NWORK(const long N);
+
+template <typename T>
+int linal_usym_invsqrt_ns(usymat<T>& U, Core<T>& CORE, const T TOL=0,
+                          const int MAXIT=LINAL_USYM_NS_MAXIT,
+                          void (*GEMM)(const int, const int, const int, const T, T*,
+                                       T*, const T, T*)=&linal_ABpC<T>);
+
+template <typename T>
+int linal_usym_sqrt_ns(usymat<T>& U, Core<T>& CORE, const T TOL=0,
+                       const int MAXIT=LINAL_USYM_NS_MAXIT,
+                       void (*GEMM)(const int, const int, const int, const T, T*,
+                                    T*, const T, T*)=&linal_ABpC<T>);
+
+long linal_usym_ns_NWORK(const long N);
+
+#endif
@@ -1,6 +1,11 @@
 /*--------------------------------------------------------------------------- 
   para.hpp
 	JHT, Febuary 21, 2022 : created
+	JHT, October 14, 2026 : added checkpoint and restart
+	JHT, October 14, 2026 : file calls are synchronised over comm_io
+	JHT, October 14, 2026 : the event trace is written at destroy
+	JHT, October 14, 2026 : added file_read_broadcast
+	JHT, October 14, 2026 : added init_team
 
   .cpp file for the para class object, which is the interaface to the other
   para classes and routines
@@ -10,10 +15,30 @@
 //---------------------------------------------------------------------------
 // Para() -- initialization
 //---------------------------------------------------------------------------
-int Para::init()
+int Para::init(const int thread_level, const int io_per_node)
 {
-  if (pworld.init() != 0) {error(-1);}
+  if (pworld.init(thread_level,io_per_node) != 0) {error(-1);}
   if (pprint.init(pworld) != 0) {error(-1);}
+  if (pcounter.init(pworld) != 0) {error(-1);}
+  if (pworld.mpi_doesIO) {
+    if (pfile.init(pworld) != 0) {error(-1);}
+  }
+  #if defined (LIBJ_TRACE)
+  Ptrace::sync(pworld);
+  #endif
+  return 0;
+}
+
+//---------------------------------------------------------------------------
+// init_team -- a Para on one of num_teams teams of the tasks of world
+//	collective over world's comm_world. The trace is that of the world, 
+//	so it is not synced or written by the team
+//---------------------------------------------------------------------------
+int Para::init_team(const Para& world, const int num_teams, const int io_per_node)
+{
+  if (world.pworld.split_teams(num_teams,pworld,io_per_node) != 0) {error(-1);}
+  if (pprint.init(pworld) != 0) {error(-1);}
+  if (pcounter.init(pworld) != 0) {error(-1);}
   if (pworld.mpi_doesIO) {
     if (pfile.init(pworld) != 0) {error(-1);}
   }
@@ -25,7 +50,12 @@ int Para::init()
 //---------------------------------------------------------------------------
 int Para::destroy()
 {
+  if (pckpt.wait(pworld) != 0) {error(1);}
+  #if defined (LIBJ_TRACE)
+  if (!pworld.mpi_is_team) {Ptrace::write(pworld);}
+  #endif
   if (pprint.destroy(pworld) != 0) {error(1);}
+  if (pcounter.destroy(pworld) != 0) {error(1);}
   if (pworld.destroy() != 0) {error(1);}
   return 0;
 }
@@ -55,6 +85,19 @@ int Para::print_add(const char* fstring,...)
   return stat;
 }
 
+//---------------------------------------------------------------------------
+// print_thread_add
+//	can be called inside a parallel region
+//---------------------------------------------------------------------------
+int Para::print_thread_add(const char* fstring,...)
+{
+  va_list arg;
+  va_start(arg,fstring);
+  int stat = pprint.vtadd(fstring,arg); 
+  va_end(arg);
+  return stat;
+}
+
 //---------------------------------------------------------------------------
 // print_store
 //---------------------------------------------------------------------------
@@ -119,6 +162,15 @@ int Para::print_all()
   return 0;
 }
 
+//---------------------------------------------------------------------------
+// print_node_log
+//	messages to a log of each node, or back to the master with NULL
+//---------------------------------------------------------------------------
+int Para::print_node_log(const char* prefix)
+{
+  return pprint.node_log(pworld,prefix);
+}
+
 //---------------------------------------------------------------------------
 // print_master_add
 //---------------------------------------------------------------------------
@@ -173,19 +225,19 @@ int Para::print_master_now(const char* fstring,...)
 
 //---------------------------------------------------------------------------
 // file_add
-//	add a file to the filesystem, synchronise across tasks on shared
-//	memory
+//	add a file to the filesystem, synchronise across the tasks of the
+//	io group
 //---------------------------------------------------------------------------
-int Para::file_add(const char* fname)
+int Para::file_add(const char* fname, const long bytes)
 {
   int file_id = -1;
   //add the file
-  if (pworld.mpi_doesIO) {file_id = pfile.sadd(pworld,fname);}
+  if (pworld.mpi_doesIO) {file_id = pfile.sadd(pworld,fname,bytes);}
 
   //Bcast 
   #ifdef LIBJ_MPI
-  MPI_Barrier(pworld.comm_shared);
-  MPI_Bcast(&file_id,1,MPI_INT,pworld.mpi_shared_root,pworld.comm_shared);
+  MPI_Barrier(pworld.comm_io);
+  MPI_Bcast(&file_id,1,MPI_INT,pworld.mpi_io_root,pworld.comm_io);
   #endif
 
   //return
@@ -193,6 +245,31 @@ int Para::file_add(const char* fname)
 }
 
 
+//---------------------------------------------------------------------------
+// file_add_scratch
+//	add a scratch directory, for the files added after it. Every task 
+//	must give the same directories, which must exist on every node
+//---------------------------------------------------------------------------
+int Para::file_add_scratch(const char* dir)
+{
+  int stat = 0; 
+  if (pworld.mpi_doesIO) {stat = (pfile.add_scratch(dir) < 0) ? 1 : 0;}
+
+  #ifdef LIBJ_MPI
+  MPI_Allreduce(MPI_IN_PLACE,&stat,1,MPI_INT,MPI_MAX,pworld.comm_world);
+  #endif
+  return stat;
+}
+
+//---------------------------------------------------------------------------
+// file_placement
+//	placement policy of the files added after it
+//---------------------------------------------------------------------------
+int Para::file_placement(const int policy, const long stripe, const long min_bytes)
+{
+  return pfile.set_placement(policy,stripe,min_bytes);
+}
+
 //---------------------------------------------------------------------------
 // file_open
 //	opens file associated with file_id, with args 
@@ -203,8 +280,8 @@ int Para::file_open(const int file_id, const char* arg)
   if (pworld.mpi_doesIO) {stat = pfile.xopen(file_id,arg);} 
 
   #ifdef LIBJ_MPI
-  MPI_Barrier(pworld.comm_shared);
-  MPI_Bcast(&stat,1,MPI_INT,pworld.mpi_shared_root,pworld.comm_shared);
+  MPI_Barrier(pworld.comm_io);
+  MPI_Bcast(&stat,1,MPI_INT,pworld.mpi_io_root,pworld.comm_io);
   #endif
 
   return stat;
@@ -220,8 +297,8 @@ int Para::file_close(const int file_id)
   if (pworld.mpi_doesIO) {stat = pfile.xclose(file_id);} 
 
   #ifdef LIBJ_MPI
-  MPI_Barrier(pworld.comm_shared);
-  MPI_Bcast(&stat,1,MPI_INT,pworld.mpi_shared_root,pworld.comm_shared);
+  MPI_Barrier(pworld.comm_io);
+  MPI_Bcast(&stat,1,MPI_INT,pworld.mpi_io_root,pworld.comm_io);
   #endif
   
   return stat;
@@ -239,8 +316,8 @@ bool Para::file_isopen(const int file_id)
   stat = (tf) ? 0 : 1;
 
   #ifdef LIBJ_MPI
-  MPI_Barrier(pworld.comm_shared);
-  MPI_Bcast(&stat,1,MPI_INT,pworld.mpi_shared_root,pworld.comm_shared);
+  MPI_Barrier(pworld.comm_io);
+  MPI_Bcast(&stat,1,MPI_INT,pworld.mpi_io_root,pworld.comm_io);
   #endif
 
   return (stat == 0) ? true : false;
@@ -282,9 +359,212 @@ int Para::file_getid(const char* fname)
   if (pworld.mpi_doesIO) {fid = pfile.sget_fid(pworld,fname);}
 
   #ifdef LIBJ_MPI
-  MPI_Barrier(pworld.comm_shared);
-  MPI_Bcast(&fid,1,MPI_INT,pworld.mpi_shared_root,pworld.comm_shared);
+  MPI_Barrier(pworld.comm_io);
+  MPI_Bcast(&fid,1,MPI_INT,pworld.mpi_io_root,pworld.comm_io);
   #endif
 
   return fid;
 }
+
+//---------------------------------------------------------------------------
+// para_fread
+//	bytes of fp into data, 0 if all were read
+//---------------------------------------------------------------------------
+static int para_fread(FILE* fp, char* data, const long bytes)
+{
+  long done = 0;
+  while (done < bytes)
+  {
+    const size_t num = fread(data+done,1,(size_t) (bytes-done),fp);
+    if (num == 0) return 1;
+    done += (long) num;
+  }
+  return 0;
+}
+
+//---------------------------------------------------------------------------
+// file_read_broadcast
+//	the reader (the world master, or each shared root) reads fname into
+//	a window of comm_shared, which the shared roots then fill from the
+//	world master with MPI_Bcast on comm_nodes, PARA_BCAST_BYTES at a 
+//	time. Each task copies it out of its node's window 
+//---------------------------------------------------------------------------
+long Para::file_read_broadcast(const char* fname, std::vector<char>& buffer, 
+                               const bool per_node)
+{
+  LIBJ_TRACE_SCOPE("file_read_broadcast","io");
+  const bool reader = pworld.mpi_shared_ismaster && (per_node || pworld.mpi_world_ismaster);
+  long  bytes = -1;
+  FILE* fp = NULL;
+  if (reader)
+  {
+    fp = fopen(fname,"rb");
+    if (fp != NULL && fseek(fp,0,SEEK_END) == 0) 
+    {
+      bytes = ftell(fp);
+      rewind(fp);
+    }
+  }
+
+  #if defined LIBJ_MPI
+  if (!per_node && pworld.mpi_shared_ismaster) 
+  {
+    MPI_Bcast(&bytes,1,MPI_LONG,0,pworld.comm_nodes);
+  }
+  MPI_Bcast(&bytes,1,MPI_LONG,pworld.mpi_shared_root,pworld.comm_shared);
+  int bad = (bytes < 0) ? 1 : 0;
+  MPI_Allreduce(MPI_IN_PLACE,&bad,1,MPI_INT,MPI_MAX,pworld.comm_world);
+  if (bad != 0)
+  {
+    if (fp != NULL) fclose(fp);
+    if (pworld.mpi_world_ismaster) 
+    {
+      printf("\nERROR ERROR ERROR\n");
+      printf("Para::file_read_broadcast could not read %s\n",fname);
+    }
+    return -1;
+  }
+
+  MPI_Win win;
+  char* base = NULL;
+  const MPI_Aint mybytes = pworld.mpi_shared_ismaster ? (MPI_Aint) bytes : 0;
+  MPI_Win_allocate_shared(mybytes,1,MPI_INFO_NULL,pworld.comm_shared,&base,&win);
+  MPI_Aint size;
+  int disp;
+  MPI_Win_shared_query(win,pworld.mpi_shared_root,&size,&disp,&base);
+  MPI_Win_lock_all(MPI_MODE_NOCHECK,win);
+
+  if (fp != NULL)
+  {
+    bad = para_fread(fp,base,bytes);
+    fclose(fp);
+  }
+  MPI_Allreduce(MPI_IN_PLACE,&bad,1,MPI_INT,MPI_MAX,pworld.comm_world);
+  if (bad == 0 && !per_node && pworld.mpi_shared_ismaster)
+  {
+    for (long pos=0;pos<bytes;pos+=PARA_BCAST_BYTES)
+    {
+      const int num = (int) std::min((long) PARA_BCAST_BYTES,bytes-pos);
+      MPI_Bcast(base+pos,num,MPI_BYTE,0,pworld.comm_nodes);
+    }
+  }
+  MPI_Win_sync(win);
+  MPI_Barrier(pworld.comm_shared);
+  MPI_Win_sync(win);
+  if (bad == 0) buffer.assign(base,base+bytes);
+  MPI_Win_unlock_all(win);
+  MPI_Win_free(&win);
+  #else
+  int bad = (bytes < 0) ? 1 : 0;
+  if (bad == 0)
+  {
+    buffer.resize(bytes);
+    bad = para_fread(fp,buffer.data(),bytes);
+  }
+  if (fp != NULL) fclose(fp);
+  #endif
+
+  if (bad != 0)
+  {
+    if (pworld.mpi_world_ismaster) 
+    {
+      printf("\nERROR ERROR ERROR\n");
+      printf("Para::file_read_broadcast could not read %s\n",fname);
+    }
+    return -1;
+  }
+  return bytes;
+}
+
+//---------------------------------------------------------------------------
+// checkpoint_windows
+//	the window regions of this task, only the shared root has the 
+//	memory of a shared window
+//---------------------------------------------------------------------------
+static void checkpoint_windows(const Pworld& pworld, const Pdata& pdata,
+                               std::vector<Pckpt_region>& regions)
+{
+  for (long list=0;list<(long) pdata.num_lists();list++)
+  {
+    const int kind = pdata.window_kind(list);
+    if (kind == 0 || (kind == 2 && !pworld.mpi_shared_ismaster)) continue;
+    Pckpt_region reg;
+    memset(reg.m_name,0,PCKPT_NAMELEN);
+    snprintf(reg.m_name,PCKPT_NAMELEN,"pdata.window.%ld",list);
+    reg.m_data = pdata.window_data(list);
+    reg.m_bytes = pdata.window_bytes(list);
+    regions.push_back(reg);
+  }
+}
+
+//---------------------------------------------------------------------------
+// checkpoint
+//	returns once the blocks are copied, the files are written by the
+//	Pckpt thread
+//---------------------------------------------------------------------------
+int Para::checkpoint(const char* dir, const bool incremental)
+{
+  int stat = 0;
+  if (pworld.mpi_doesIO)
+  {
+    stat += pdata.flush_cache(pfile);
+    stat += pfile.save(pworld);
+  }
+
+  std::vector<char> meta;
+  pdata.pack(meta);
+  std::vector<Pckpt_region> regions = pckpt.regions();
+  checkpoint_windows(pworld,pdata,regions);
+
+  #if defined LIBJ_MPI
+  MPI_Allreduce(MPI_IN_PLACE,&stat,1,MPI_INT,MPI_MAX,pworld.comm_world);
+  #endif
+  if (stat != 0)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Para::checkpoint could not flush the cache or save the files\n");
+    return 1;
+  }
+  return pckpt.write(pworld,dir,meta,regions,incremental);
+}
+
+//---------------------------------------------------------------------------
+// restart
+//---------------------------------------------------------------------------
+int Para::restart(const char* dir)
+{
+  std::vector<char> meta;
+  if (pckpt.open(pworld,dir,meta) != 0) {return 1;}
+
+  std::vector<int> windows;
+  int stat = pdata.unpack(meta.data(),(long) meta.size(),windows);
+  #if defined LIBJ_MPI
+  MPI_Allreduce(MPI_IN_PLACE,&stat,1,MPI_INT,MPI_MAX,pworld.comm_world);
+  #endif
+  if (stat != 0) {pckpt.close(); return 1;}
+
+  //the windows are remade in list order on every task
+  for (long list=0;list<(long) windows.size();list++)
+  {
+    if (windows[list] == 1) stat += pdata.make_window(pworld,list);
+    if (windows[list] == 2) stat += pdata.make_shared_window(pworld,list);
+  }
+
+  std::vector<Pckpt_region> regions = pckpt.regions();
+  checkpoint_windows(pworld,pdata,regions);
+  for (size_t r=0;r<regions.size() && stat == 0;r++)
+  {
+    stat = pckpt.read(regions[r].m_name,regions[r].m_data,regions[r].m_bytes);
+  }
+  pckpt.close();
+  for (long list=0;list<(long) windows.size();list++)
+  {
+    if (windows[list] == 2) pdata.sync_window(pworld,list);
+  }
+
+  if (pworld.mpi_doesIO && stat == 0) {stat = pfile.recover(pworld);}
+  #if defined LIBJ_MPI
+  MPI_Allreduce(MPI_IN_PLACE,&stat,1,MPI_INT,MPI_MAX,pworld.comm_world);
+  #endif
+  return (stat == 0) ? 0 : 1;
+}
@@ -1,6 +1,20 @@
 /*--------------------------------------------------------------------
   para.hpp
 	JHT, Febuary 21, 2022 : created
+	JHT, October 14, 2026 : added task_loop
+	JHT, October 14, 2026 : added the tensor collectives
+	JHT, October 14, 2026 : added checkpoint and restart
+	JHT, October 14, 2026 : file calls go to the io aggregator
+	JHT, October 14, 2026 : added the scratch directories
+	JHT, October 14, 2026 : added profile_report
+	JHT, October 14, 2026 : added the event trace
+	JHT, October 14, 2026 : added mem_report
+	JHT, October 14, 2026 : added the distributed tensors
+	JHT, October 14, 2026 : added the reproducible sums
+	JHT, October 14, 2026 : added redistribution
+	JHT, October 14, 2026 : added file_read_broadcast
+	JHT, October 14, 2026 : added print_node_log
+	JHT, October 14, 2026 : added init_team
 
   .hpp for the para class, which is the interface to the other para
   classes and routines.
@@ -18,9 +32,34 @@
     - error can be called to terminate the program
   Para para;
   para.init();
+  para.init(PWORLD_THREAD_MULTIPLE);   //for MPI calls from any thread
+  para.init(PWORLD_THREAD_FUNNELED,4); //4 io aggregators per node
+  para.pworld.start_progress();        //after init(PWORLD_THREAD_MULTIPLE), moves
+                                       //  the async RMA and io along, see pworld.hpp
   para.destroy();
   para.error(1);
 
+  ----------------------------------
+  TEAMS
+    - init_team splits the tasks of an initialized Para into num_teams
+      teams (Pworld::split_teams), and makes a Para on this task's team. 
+      Everything "collective over comm_world" on the team Para (printing,
+      task_loop, the collectives, file io, checkpoints, the dist_tensors)
+      is collective over the team only, so the teams run independent 
+      work without the barriers of one team waiting on the others. It is
+      collective over the comm_world of the world Para. The team files 
+      are named with the team (see pfile.hpp), and each team should 
+      checkpoint to its own directory. The team Para is destroyed before
+      the world Para, which ends MPI
+
+   Usage example:
+   Para team;
+   team.init_team(para,2);
+   if (team.pworld.mpi_team_id == 0) {...} else {...}
+   team.print_all();  //only waits on the team
+   team.destroy();
+   para.destroy();
+
   ----------------------------------
   PRINTING TO STDIO 
     -  messages are "added" by concatination to a string buffer. When a 
@@ -36,6 +75,27 @@
     para.print_addstore(" world! 42 = %d \n",42);
     para.print_all();
     para.print_master_now("master prints this right away\n");
+
+    - inside an OpenMP parallel region, print_thread_add and print_log
+      add to a buffer of each thread, with no lock. They are printed by
+      print_all, after the stored messages, in (task, thread, order)
+      order. print_log only keeps the arguments, and formats at print_all
+    #pragma omp parallel
+    {
+      para.print_thread_add("thread %d of task %d\n",omp_get_thread_num(),id);
+      para.print_log("block %ld took %f s\n",blk,dt);
+    }
+    para.print_all();
+
+    - for verbose runs, print_node_log sends the messages of each node to
+      a log of its own, prefix.node<n>.log, written by a thread of the 
+      shared root, so nothing goes through the master but its own (the 
+      print_master_* messages), see pprint.hpp. NULL goes back to the 
+      master. It is collective over comm_world
+    para.print_node_log("debug");
+    para.print_addstore("task %d : block %ld\n",id,blk);
+    para.print_all();				//to debug.node<n>.log
+    para.print_node_log(NULL);
   
 
   ----------------------------------
@@ -44,19 +104,170 @@
       own, either via a dictionary or by initializing in the same order
       each time. These can be recovered via the file_getid function, if
       needed
-    - fileIO is performed by the shared_root task for each set of tasks on
-      a shared memory machine. 
+    - fileIO is performed by the io aggregator of each group of tasks on
+      a shared memory machine, the shared root by default. More than one 
+      aggregator per node, spread over the sockets, can be asked for in 
+      init or with LIBJ_IO_PER_NODE (see pworld.hpp)
    
    Usage example:
    const int fid = para.file_add("data");
    para.file_open(fid,"w+b");
   
    para.file_close();
+
+    - files can be placed on several scratch directories (e.g., one per 
+      local SSD), round-robin or striped, see pfile.hpp. The placement is
+      picked when the file is added, and file_add takes an optional size
+      hint for PFILE_PLACE_SIZE
+   
+   Usage example:
+   para.file_add_scratch("/nvme0/scr");
+   para.file_add_scratch("/nvme1/scr");
+   para.file_placement(PFILE_PLACE_SIZE,1048576,1L<<30);
+   const int fid = para.file_add("t2",t2_bytes);
+
+    - file_read_broadcast reads a file that every task needs (input, 
+      integrals) on one task, and gives every task a copy in buffer, so
+      the file system sees one open and one read in place of one per 
+      task. The world master reads it, sends it to the other shared 
+      roots with MPI_Bcast on comm_nodes, straight into a node-shared 
+      window (comm_shared), from which each task of the node copies it.
+      With per_node, each shared root reads it (for node local files) 
+      and nothing goes between the nodes. fname is a path, not a Pfile
+      file, since those are the scratch files of each task. Returns the
+      bytes, or -1 on every task if any reader failed. It is collective
+      over comm_world
+
+   Usage example:
+   std::vector<char> input;
+   const long bytes = para.file_read_broadcast("input.dat",input);
      
   
   ----------------------------------
   DATASYSTEM 
 
+  ----------------------------------
+  TASK LOOPS
+    - task_loop calls fn(index) once for every index of a list, over all
+      tasks, like an "omp for schedule(dynamic,chunk)". Blocks of chunk
+      indexes are handed out by a global counter (Pcounter), so a task 
+      that finishes early just takes the next block
+    - the indexes are handed out largest (m_size) first, so the big blocks
+      do not end up last
+    - task_loop is collective over comm_world, and ends with a barrier
+
+   Usage example:
+   para.task_loop(list_id,[&](const long index){contract(index);});
+
+  ----------------------------------
+  COLLECTIVES
+    - in place collectives over comm_world on sequential libj::tensors, 
+      see pcoll.hpp. allreduce is chunked and pipelined, and two-level
+      (node, then between nodes) for multi-node runs
+
+   Usage example:
+   Prequest req = para.iallreduce(T2,PCOLL_SUM);
+   ... compute ...
+   para.wait(req);
+   para.allreduce(E,PCOLL_SUM);
+   para.wait(para.ibcast(A,0));
+
+    - repro_sum and repro_dot are the sum (dot) of the elements of a
+      tensor (two tensors) over all the tasks, each with its own part, 
+      to the same bits for any number of tasks and threads, and any 
+      split of the elements over them (simd_repro_* of simd.hpp, with
+      three small allreduces). allreduce_repro is a sum whose result 
+      does not depend on the order the tasks are added in (see 
+      Pcoll::allreduce_repro). These are collective over comm_world
+
+   Usage example:
+   const double e2 = para.repro_dot(T2loc,Wloc);
+   para.allreduce_repro(E);
+
+  ----------------------------------
+  CHECKPOINT AND RESTART
+    - checkpoint writes the Pdata lists and indexes, the memory of the 
+      Pdata windows, and the registered tensors, with one file per task
+      in dir (see pckpt.hpp). The cache is flushed and the Pfile names 
+      saved first. The data in the Pfile files is not copied
+    - the files are written by a thread while the compute goes on, and
+      checkpoint_wait (or the next checkpoint) finishes them. The tensors
+      can be changed as soon as checkpoint returns
+    - incremental checkpoints into the same dir only write the blocks 
+      that changed since the last one
+    - restart needs the same number of tasks, and the same tensors 
+      registered (allocated to the same sizes), and an empty Pdata cache
+      with no windows. It remakes the windows of the checkpoint, and 
+      fills them and the tensors
+    - these are collective over comm_world
+
+   Usage example:
+   para.checkpoint_add("t2",T2);
+   para.checkpoint("ckpt_a");
+   ... compute ...
+   para.checkpoint_wait();
+   para.restart("ckpt_a");
+
+  ----------------------------------
+  PROFILING
+    - profile_report merges the LIBJ_PROFILE_SCOPE regions of all threads
+      and tasks, and prints them on the master with the min/avg/max 
+      over the tasks (see pprofile.hpp). It is collective over comm_world
+
+   Usage example:
+   para.profile_report();
+
+    - with -DLIBJ_TRACE, the LIBJ_TRACE_SCOPE events of all threads and
+      tasks (including the io, print, collective, and task_loop events) 
+      are written as a chrome trace json file at destroy (see ptrace.hpp)
+      to LIBJ_TRACE_FILE, or libj_trace.json. Time 0 is the end of init
+
+  ----------------------------------
+  MEMORY
+    - mem_report prints the libj memory (live, peak, allocations) of 
+      each task, and of each libj::mem_tag, on the master (see pmem.hpp
+      and mem_registry.hpp). It is collective over comm_world
+
+   Usage example:
+   {
+     libj::mem_tag tag("T2");
+     T2.allocate(no,no,nv,nv);
+   }
+   para.mem_report();
+
+  ----------------------------------
+  DISTRIBUTED TENSORS
+    - a libj::dist_tensor is block cyclic over a Pgrid, a 2D grid of
+      the tasks of comm_world, and dist_gemm and dist_contract are
+      SUMMA over the grid, with the local linal kernels (see pdist.hpp).
+      These are collective over comm_world
+
+   Usage example:
+   Pgrid grid;
+   grid.init(para.pworld);
+   C.init(grid,{no,no,nv,nv},2,64,64);
+   libj::dist_contract(1.0,A,"ijcd",B,"cdab",0.0,C,"ijab");
+   grid.destroy();
+
+    - Ptsqr is the QR of a tall skinny matrix distributed by rows, e.g., 
+      a block of Davidson vectors, with one MPI_Allgather of the small R
+      of each task (see ptsqr.hpp). It is collective over comm_world
+
+   Usage example:
+   Ptsqr(para.pworld,Mloc,N,A,Mloc,R,N);
+
+    - Predist moves data between two layouts (Pdata lists after 
+      make_window, and dist_tensors) with MPI_Ialltoallv, in rounds 
+      within a memory budget (see predist.hpp). execute is collective 
+      over comm_world
+
+   Usage example:
+   Predist redist;
+   Playout_pdata from(para.pdata,list_occ);
+   Playout_dist to(C);
+   redist.plan(para.pworld,from,to);
+   redist.execute(para.pworld,para.pdata.window_data(list_occ),C.data());
+
 --------------------------------------------------------------------*/
 #ifndef LIBJ_PARA_HPP
 #define LIBJ_PARA_HPP
@@ -66,6 +277,24 @@
 #include "pprint.hpp"
 #include "pfile.hpp"
 #include "pdata.hpp"
+#include "pcounter.hpp"
+#include "pcoll.hpp"
+#include "pckpt.hpp"
+#include "pprofile.hpp"
+#include "ptrace.hpp"
+#include "pmem.hpp"
+#include "pdist.hpp"
+#include "ptsqr.hpp"
+#include "predist.hpp"
+#include "tensor.hpp"
+#include "simd.hpp"
+#include <vector>
+#include <algorithm>
+
+//bytes of one MPI_Bcast of file_read_broadcast
+#if !defined (PARA_BCAST_BYTES)
+  #define PARA_BCAST_BYTES (1L << 30)
+#endif
 
 class Para
 {
@@ -75,9 +304,12 @@ class Para
   Pprint pprint;
   Pfile  pfile;
   Pdata  pdata;
+  Pcounter pcounter;
+  Pckpt  pckpt;
 
   //init, destory, and error functions
-  int init();
+  int init(const int thread_level = PWORLD_THREAD_FUNNELED, const int io_per_node = 0);
+  int init_team(const Para& world, const int num_teams, const int io_per_node = 0);
   int destroy();
   void error(const int stat);
 
@@ -93,9 +325,16 @@ class Para
   int print_all_noreset();
   int print_now(const char* fstring,...);
   int print_master_now(const char* fstring,...);
+  int print_thread_add(const char* fstring,...);
+  template <class...Args>
+  int print_log(const char* fstring, const Args...args) {return pprint.tlog(fstring,args...);}
+  int print_node_log(const char* prefix);
 
   //FILESYSTEM
-  int file_add(const char* fname);
+  int file_add(const char* fname, const long bytes = 0);
+  int file_add_scratch(const char* dir);
+  int file_placement(const int policy, const long stripe = PFILE_STRIPE,
+                     const long min_bytes = 0);
   int file_getid(const char* fname);
   int file_open(const int file_id, const char* arg);
   int file_close(const int file_id);
@@ -103,8 +342,197 @@ class Para
   void file_print_info();
   int file_save();
   int file_recover();
+  long file_read_broadcast(const char* fname, std::vector<char>& buffer, 
+                           const bool per_node = false);
+
+  //TASK LOOPS
+  template <class F>
+  int task_loop(const long list_id, const F& fn, const long chunk = 1);
+
+  //COLLECTIVES
+  template <typename T>
+  Prequest iallreduce(libj::tensor<T>& A, const int op = PCOLL_SUM);
+  template <typename T>
+  Prequest ibcast(libj::tensor<T>& A, const int root = 0);
+  template <typename T>
+  int allreduce(libj::tensor<T>& A, const int op = PCOLL_SUM);
+  template <typename T>
+  int allreduce_repro(libj::tensor<T>& A);
+  template <typename T>
+  double repro_sum(const libj::tensor<T>& X);
+  template <typename T>
+  double repro_dot(const libj::tensor<T>& X, const libj::tensor<T>& Y);
+  int wait(Prequest req) {return Pcoll::wait(req);}
+
+  //CHECKPOINT AND RESTART
+  template <typename T>
+  int checkpoint_add(const char* name, libj::tensor<T>& A);
+  int checkpoint_remove(const char* name) {return pckpt.remove(name);}
+  int checkpoint(const char* dir, const bool incremental = true);
+  int checkpoint_wait() {return pckpt.wait(pworld);}
+  int restart(const char* dir);
+
+  //PROFILING
+  int profile_report(FILE* fp = stdout) {return Pprofile::report(pworld,fp);}
 
+  //MEMORY
+  int mem_report(FILE* fp = stdout) {return Pmem::report(pworld,fp);}
+
+  private:
+  template <typename T>
+  void check_sequential(const char* name, const libj::tensor<T>& A);
   
 };
 
+//---------------------------------------------------------------------------
+// task_loop
+//	every task sorts the indexes the same way, so the counter value 
+//	means the same thing everywhere
+//---------------------------------------------------------------------------
+template <class F>
+int Para::task_loop(const long list_id, const F& fn, const long chunk)
+{
+  const long num = pdata.num_index(list_id);
+  std::vector<long> order(num);
+  for (long index=0;index<num;index++) {order[index] = index;}
+  std::stable_sort(order.begin(),order.end(),[&](const long a, const long b)
+  {
+    return pdata.index_size(list_id,a) > pdata.index_size(list_id,b);
+  });
+
+  const long inc = (chunk > 0) ? chunk : 1;
+  pcounter.reset(pworld);
+  for (long start=pcounter.next(inc);start<num;start=pcounter.next(inc))
+  {
+    const long end = std::min(start+inc,num);
+    for (long i=start;i<end;i++)
+    {
+      LIBJ_TRACE_SCOPE_ARG("task","pdata",order[i]);
+      fn(order[i]);
+    }
+  }
+
+  #if defined LIBJ_MPI
+  MPI_Barrier(pworld.comm_world);
+  #endif
+  return 0;
+}
+
+//---------------------------------------------------------------------------
+// check_sequential
+//	the collectives work on the buffer as one vector
+//---------------------------------------------------------------------------
+template <typename T>
+void Para::check_sequential(const char* name, const libj::tensor<T>& A)
+{
+  if (!A.is_sequential())
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("%s tensor is not sequential\n",name);
+    error(1);
+  }
+}
+
+//---------------------------------------------------------------------------
+// iallreduce
+//---------------------------------------------------------------------------
+template <typename T>
+Prequest Para::iallreduce(libj::tensor<T>& A, const int op)
+{
+  check_sequential("Para::iallreduce",A);
+  Prequest req;
+  if (Pcoll::iallreduce(pworld,A.data(),(long) A.size(),op,req) != 0) {error(1);}
+  return req;
+}
+
+//---------------------------------------------------------------------------
+// ibcast
+//---------------------------------------------------------------------------
+template <typename T>
+Prequest Para::ibcast(libj::tensor<T>& A, const int root)
+{
+  check_sequential("Para::ibcast",A);
+  Prequest req;
+  if (Pcoll::ibcast(pworld,A.data(),(long) A.size(),root,req) != 0) {error(1);}
+  return req;
+}
+
+//---------------------------------------------------------------------------
+// allreduce
+//---------------------------------------------------------------------------
+template <typename T>
+int Para::allreduce(libj::tensor<T>& A, const int op)
+{
+  check_sequential("Para::allreduce",A);
+  return Pcoll::allreduce(pworld,A.data(),(long) A.size(),op);
+}
+
+//---------------------------------------------------------------------------
+// allreduce_repro
+//---------------------------------------------------------------------------
+template <typename T>
+int Para::allreduce_repro(libj::tensor<T>& A)
+{
+  check_sequential("Para::allreduce_repro",A);
+  return Pcoll::allreduce_repro(pworld,A.data(),(long) A.size());
+}
+
+//---------------------------------------------------------------------------
+// repro_sum
+//	the largest |x| and the number of elements of all the tasks, then
+//	the folds of each task, which are added exactly
+//---------------------------------------------------------------------------
+template <typename T>
+double Para::repro_sum(const libj::tensor<T>& X)
+{
+  check_sequential("Para::repro_sum",X);
+  long   ntot = (long) X.size();
+  double amax = simd_par_repro_amax<T>((long) X.size(),X.data());
+  Pcoll::allreduce(pworld,&ntot,1,PCOLL_SUM);
+  Pcoll::allreduce(pworld,&amax,1,PCOLL_MAX);
+
+  double S[SIMD_REPRO_FOLDS];
+  for (int k=0;k<SIMD_REPRO_FOLDS;k++) S[k] = 0;
+  simd_par_repro_fold<T>((long) X.size(),X.data(),amax,ntot,S);
+  Pcoll::allreduce(pworld,S,SIMD_REPRO_FOLDS,PCOLL_SUM);
+  return libj::simd_repro_result(S);
+}
+
+//---------------------------------------------------------------------------
+// repro_dot
+//---------------------------------------------------------------------------
+template <typename T>
+double Para::repro_dot(const libj::tensor<T>& X, const libj::tensor<T>& Y)
+{
+  check_sequential("Para::repro_dot",X);
+  check_sequential("Para::repro_dot",Y);
+  if (X.size() != Y.size())
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Para::repro_dot tensors of %ld and %ld elements\n",(long) X.size(),(long) Y.size());
+    error(1);
+  }
+  long   ntot = (long) X.size();
+  double amax = simd_par_repro_amax<T>((long) X.size(),X.data(),Y.data());
+  Pcoll::allreduce(pworld,&ntot,1,PCOLL_SUM);
+  Pcoll::allreduce(pworld,&amax,1,PCOLL_MAX);
+
+  double S[SIMD_REPRO_FOLDS];
+  for (int k=0;k<SIMD_REPRO_FOLDS;k++) S[k] = 0;
+  simd_par_repro_fold<T>((long) X.size(),X.data(),Y.data(),amax,ntot,S);
+  Pcoll::allreduce(pworld,S,SIMD_REPRO_FOLDS,PCOLL_SUM);
+  return libj::simd_repro_result(S);
+}
+
+//---------------------------------------------------------------------------
+// checkpoint_add
+//	registers the memory of A under name
+//---------------------------------------------------------------------------
+template <typename T>
+int Para::checkpoint_add(const char* name, libj::tensor<T>& A)
+{
+  check_sequential("Para::checkpoint_add",A);
+  return pckpt.add(name,A.data(),(long) (sizeof(T)*A.size()));
+}
+
 #endif
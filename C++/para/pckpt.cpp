@@ -0,0 +1,478 @@
+/*----------------------------------------------------------------------------
+  pckpt.cpp
+	JHT, October 14, 2026 : created
+	JHT, October 14, 2026 : XXH64 block checksums
+
+  .cpp file for Pckpt
+----------------------------------------------------------------------------*/
+#include "pckpt.hpp"
+#include "simd.hpp"
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <algorithm>
+
+#define PCKPT_HEAD 8	//words of the fixed header
+#define PCKPT_VALID 4	//word of the valid flag
+
+//----------------------------------------------------------------------------
+// pwrite and pread of all bytes, returns 0 on success
+//----------------------------------------------------------------------------
+static int pckpt_pwrite(const int fd, const char* buf, const long bytes, const long pos)
+{
+  long done = 0;
+  while (done < bytes)
+  {
+    const ssize_t num = pwrite(fd,buf+done,(size_t) (bytes-done),(off_t) (pos+done));
+    if (num < 0 && errno == EINTR) continue;
+    if (num <= 0) return 1;
+    done += (long) num;
+  }
+  return 0;
+}
+
+static int pckpt_pread(const int fd, char* buf, const long bytes, const long pos)
+{
+  long done = 0;
+  while (done < bytes)
+  {
+    const ssize_t num = pread(fd,buf+done,(size_t) (bytes-done),(off_t) (pos+done));
+    if (num < 0 && errno == EINTR) continue;
+    if (num <= 0) return 1;
+    done += (long) num;
+  }
+  return 0;
+}
+
+static long pckpt_round(const long bytes, const long align)
+{
+  return ((bytes + align - 1)/align)*align;
+}
+
+static long pckpt_nblock(const long bytes)
+{
+  return (bytes + PCKPT_BLOCK - 1)/PCKPT_BLOCK;
+}
+
+//----------------------------------------------------------------------------
+// all tasks agree on the worst status
+//----------------------------------------------------------------------------
+static int pckpt_agree(const Pworld& pworld, const int stat)
+{
+  int all = stat;
+  #if defined LIBJ_MPI
+  MPI_Allreduce(&stat,&all,1,MPI_INT,MPI_MAX,pworld.comm_world);
+  #endif
+  return all;
+}
+
+//----------------------------------------------------------------------------
+// ~Pckpt
+//----------------------------------------------------------------------------
+Pckpt::~Pckpt()
+{
+  if (m_running) m_thread.join();
+  if (m_fd >= 0) ::close(m_fd);
+}
+
+//----------------------------------------------------------------------------
+// path of the file of a task
+//----------------------------------------------------------------------------
+std::string Pckpt::path(const char* dir, const int task)
+{
+  char name[32];
+  snprintf(name,sizeof(name),"/ckpt.%d",task);
+  return std::string(dir) + name;
+}
+
+//----------------------------------------------------------------------------
+// checksum
+//	XXH64 of the block (simd_hash64)
+//----------------------------------------------------------------------------
+uint64_t Pckpt::checksum(const char* data, const long bytes)
+{
+  return simd_hash64(bytes,data);
+}
+
+//----------------------------------------------------------------------------
+// add
+//----------------------------------------------------------------------------
+int Pckpt::add(const char* name, void* data, const long bytes)
+{
+  if (strlen(name) >= PCKPT_NAMELEN || bytes < 0 || (data == NULL && bytes > 0))
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pckpt::add region %s is too long a name, or has no memory\n",name);
+    return 1;
+  }
+  for (size_t r=0;r<m_reg.size();r++)
+  {
+    if (strcmp(m_reg[r].m_name,name) == 0)
+    {
+      m_reg[r].m_data = (char*) data;
+      m_reg[r].m_bytes = bytes;
+      return 0;
+    }
+  }
+  Pckpt_region reg;
+  memset(reg.m_name,0,PCKPT_NAMELEN);
+  strcpy(reg.m_name,name);
+  reg.m_data = (char*) data;
+  reg.m_bytes = bytes;
+  m_reg.push_back(reg);
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// remove
+//----------------------------------------------------------------------------
+int Pckpt::remove(const char* name)
+{
+  for (size_t r=0;r<m_reg.size();r++)
+  {
+    if (strcmp(m_reg[r].m_name,name) == 0)
+    {
+      m_reg.erase(m_reg.begin()+r);
+      return 0;
+    }
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+// write
+//	the layout and checksums are found here, and only the blocks that
+//	changed are copied into m_stage for the thread
+//----------------------------------------------------------------------------
+int Pckpt::write(const Pworld& pworld, const char* dir, const std::vector<char>& meta,
+                 const std::vector<Pckpt_region>& regions, const bool incremental)
+{
+  if (wait(pworld) != 0) {return 1;}
+
+  //the world master makes the dir
+  int stat = 0;
+  if (pworld.mpi_world_ismaster && mkdir(dir,0755) != 0 && errno != EEXIST)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pckpt::write could not make dir %s\n",dir);
+    stat = 1;
+  }
+  if (pckpt_agree(pworld,stat) != 0) {return 1;}
+
+  //layout
+  const long nreg = (long) regions.size();
+  long table = 0;
+  for (long r=0;r<nreg;r++)
+  {
+    table += PCKPT_NAMELEN + 3*sizeof(long) + sizeof(uint64_t)*pckpt_nblock(regions[r].m_bytes);
+  }
+  const long meta_bytes = (long) meta.size();
+  const long head = sizeof(uint64_t)*PCKPT_HEAD + pckpt_round(meta_bytes,8) + table;
+
+  m_pending = Pckpt_state();
+  long offset = pckpt_round(head,PCKPT_PAGE);
+  std::vector<long> first(nreg+1,0);
+  for (long r=0;r<nreg;r++)
+  {
+    m_pending.m_names.push_back(regions[r].m_name);
+    m_pending.m_bytes.push_back(regions[r].m_bytes);
+    m_pending.m_offset.push_back(offset);
+    offset = pckpt_round(offset + regions[r].m_bytes,PCKPT_PAGE);
+    first[r+1] = first[r] + pckpt_nblock(regions[r].m_bytes);
+  }
+  const long total = offset;
+
+  //checksums of all blocks, in parallel
+  const long nblock = first[nreg];
+  std::vector<long> breg(nblock);
+  std::vector<uint64_t> sums(nblock);
+  for (long r=0;r<nreg;r++)
+  {
+    for (long b=first[r];b<first[r+1];b++) {breg[b] = r;}
+  }
+  #pragma omp parallel for schedule(dynamic)
+  for (long b=0;b<nblock;b++)
+  {
+    const Pckpt_region& reg = regions[breg[b]];
+    const long pos = (b - first[breg[b]])*PCKPT_BLOCK;
+    const long len = std::min((long) PCKPT_BLOCK,reg.m_bytes - pos);
+    sums[b] = checksum(reg.m_data + pos,len);
+  }
+  for (long r=0;r<nreg;r++)
+  {
+    m_pending.m_sums.push_back(std::vector<uint64_t>(sums.begin()+first[r],
+                                                     sums.begin()+first[r+1]));
+  }
+
+  //incremental if the layout is the same as last time, and the file is there
+  m_path = path(dir,pworld.mpi_world_task_id);
+  std::map<std::string,Pckpt_state>::const_iterator last = m_state.find(dir);
+  struct stat st;
+  bool same = incremental && last != m_state.end() &&
+              last->second.m_names == m_pending.m_names &&
+              last->second.m_bytes == m_pending.m_bytes &&
+              last->second.m_offset == m_pending.m_offset &&
+              ::stat(m_path.c_str(),&st) == 0 && (long) st.st_size >= total;
+
+  //stage the blocks to write
+  std::vector<long> todo;
+  for (long b=0;b<nblock;b++)
+  {
+    const long r = breg[b];
+    if (!same || last->second.m_sums[r][b-first[r]] != sums[b]) {todo.push_back(b);}
+  }
+  m_pos.resize(todo.size());
+  m_len.resize(todo.size());
+  std::vector<long> spos(todo.size()+1,0);
+  for (size_t t=0;t<todo.size();t++)
+  {
+    const long b = todo[t];
+    const long r = breg[b];
+    const long pos = (b - first[r])*PCKPT_BLOCK;
+    m_pos[t] = m_pending.m_offset[r] + pos;
+    m_len[t] = std::min((long) PCKPT_BLOCK,regions[r].m_bytes - pos);
+    spos[t+1] = spos[t] + m_len[t];
+  }
+  m_stage.resize(spos[todo.size()]);
+  #pragma omp parallel for schedule(dynamic)
+  for (long t=0;t<(long) todo.size();t++)
+  {
+    const long r = breg[todo[t]];
+    memcpy(m_stage.data()+spos[t],
+           regions[r].m_data + (m_pos[t] - m_pending.m_offset[r]),(size_t) m_len[t]);
+  }
+
+  //header, not valid until the blocks are written
+  m_head.assign(head,0);
+  uint64_t H[PCKPT_HEAD];
+  memcpy(&H[0],"LIBJCKPT",sizeof(uint64_t));
+  H[1] = PCKPT_VERSION;
+  H[2] = (uint64_t) pworld.mpi_world_num_tasks;
+  H[3] = (uint64_t) pworld.mpi_world_task_id;
+  H[PCKPT_VALID] = 0;
+  H[5] = (uint64_t) meta_bytes;
+  H[6] = (uint64_t) nreg;
+  H[7] = (uint64_t) total;
+  long pos = 0;
+  memcpy(m_head.data(),H,sizeof(H)); pos += sizeof(H);
+  if (meta_bytes > 0) memcpy(m_head.data()+pos,meta.data(),meta_bytes);
+  pos += pckpt_round(meta_bytes,8);
+  for (long r=0;r<nreg;r++)
+  {
+    const long nb = first[r+1] - first[r];
+    memcpy(m_head.data()+pos,regions[r].m_name,PCKPT_NAMELEN); pos += PCKPT_NAMELEN;
+    memcpy(m_head.data()+pos,&regions[r].m_bytes,sizeof(long)); pos += sizeof(long);
+    memcpy(m_head.data()+pos,&nb,sizeof(long)); pos += sizeof(long);
+    memcpy(m_head.data()+pos,&m_pending.m_offset[r],sizeof(long)); pos += sizeof(long);
+    memcpy(m_head.data()+pos,sums.data()+first[r],sizeof(uint64_t)*nb);
+    pos += sizeof(uint64_t)*nb;
+  }
+
+  m_dir = dir;
+  m_truncate = !same;
+  m_stat = 0;
+  m_running = true;
+  m_thread = std::thread(&Pckpt::write_loop,this);
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// write_loop -- the checkpoint thread
+//----------------------------------------------------------------------------
+void Pckpt::write_loop()
+{
+  const int flags = O_WRONLY | O_CREAT | (m_truncate ? O_TRUNC : 0);
+  const int fd = ::open(m_path.c_str(),flags,0644);
+  if (fd < 0) {m_stat = 1; return;}
+
+  int stat = pckpt_pwrite(fd,m_head.data(),(long) m_head.size(),0);
+  if (stat == 0) stat = fdatasync(fd);
+  long spos = 0;
+  for (size_t t=0;t<m_pos.size() && stat == 0;t++)
+  {
+    stat = pckpt_pwrite(fd,m_stage.data()+spos,m_len[t],m_pos[t]);
+    spos += m_len[t];
+  }
+
+  //the last region may end before its page, so set the size
+  uint64_t total;
+  memcpy(&total,m_head.data()+sizeof(uint64_t)*7,sizeof(uint64_t));
+  if (stat == 0) stat = ftruncate(fd,(off_t) total);
+  if (stat == 0) stat = fdatasync(fd);
+
+  const uint64_t valid = 1;
+  if (stat == 0) stat = pckpt_pwrite(fd,(const char*) &valid,sizeof(uint64_t),
+                                     sizeof(uint64_t)*PCKPT_VALID);
+  if (stat == 0) stat = fdatasync(fd);
+  if (::close(fd) != 0) stat = 1;
+  m_stat = (stat == 0) ? 0 : 1;
+}
+
+//----------------------------------------------------------------------------
+// wait
+//	a checkpoint that failed on any task is forgotten, so the next one
+//	into that dir is written in full
+//----------------------------------------------------------------------------
+int Pckpt::wait(const Pworld& pworld)
+{
+  int stat = 0;
+  const bool had = m_running;
+  if (m_running)
+  {
+    m_thread.join();
+    m_running = false;
+    stat = m_stat;
+    if (stat != 0)
+    {
+      printf("\nERROR ERROR ERROR\n");
+      printf("Pckpt::wait could not write %s\n",m_path.c_str());
+    }
+    std::vector<char>().swap(m_stage);
+    std::vector<char>().swap(m_head);
+  }
+  stat = pckpt_agree(pworld,stat);
+  if (had)
+  {
+    if (stat == 0) {m_state[m_dir] = m_pending;}
+    else           {m_state.erase(m_dir);}
+  }
+  return stat;
+}
+
+//----------------------------------------------------------------------------
+// open
+//	checks the header, reads meta and the region table
+//----------------------------------------------------------------------------
+int Pckpt::open(const Pworld& pworld, const char* dir, std::vector<char>& meta)
+{
+  if (wait(pworld) != 0) {return 1;}
+  if (m_fd >= 0) close();
+
+  const std::string name = path(dir,pworld.mpi_world_task_id);
+  int stat = 0;
+  uint64_t H[PCKPT_HEAD];
+  m_fd = ::open(name.c_str(),O_RDONLY);
+  if (m_fd < 0 || pckpt_pread(m_fd,(char*) H,sizeof(H),0) != 0 ||
+      memcmp(&H[0],"LIBJCKPT",sizeof(uint64_t)) != 0 || H[1] != PCKPT_VERSION)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pckpt::open %s is not a checkpoint\n",name.c_str());
+    stat = 1;
+  } else if (H[2] != (uint64_t) pworld.mpi_world_num_tasks ||
+             H[3] != (uint64_t) pworld.mpi_world_task_id || H[PCKPT_VALID] != 1) {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pckpt::open %s is of %ld tasks, or was not finished\n",
+           name.c_str(),(long) H[2]);
+    stat = 1;
+  }
+
+  m_read = Pckpt_state();
+  if (stat == 0)
+  {
+    const long meta_bytes = (long) H[5];
+    const long nreg = (long) H[6];
+    meta.resize(meta_bytes);
+    long pos = sizeof(H);
+    if (meta_bytes > 0) stat = pckpt_pread(m_fd,meta.data(),meta_bytes,pos);
+    pos += pckpt_round(meta_bytes,8);
+    for (long r=0;r<nreg && stat == 0;r++)
+    {
+      char rname[PCKPT_NAMELEN];
+      long word[3];
+      stat += pckpt_pread(m_fd,rname,PCKPT_NAMELEN,pos); pos += PCKPT_NAMELEN;
+      stat += pckpt_pread(m_fd,(char*) word,sizeof(word),pos); pos += sizeof(word);
+      if (stat != 0 || word[1] != pckpt_nblock(word[0])) {stat = 1; break;}
+      std::vector<uint64_t> sums(word[1]);
+      stat = pckpt_pread(m_fd,(char*) sums.data(),sizeof(uint64_t)*word[1],pos);
+      pos += sizeof(uint64_t)*word[1];
+      rname[PCKPT_NAMELEN-1] = (char) 0;
+      m_read.m_names.push_back(rname);
+      m_read.m_bytes.push_back(word[0]);
+      m_read.m_offset.push_back(word[2]);
+      m_read.m_sums.push_back(sums);
+    }
+    if (stat != 0)
+    {
+      printf("\nERROR ERROR ERROR\n");
+      printf("Pckpt::open could not read the table of %s\n",name.c_str());
+    }
+  }
+
+  stat = pckpt_agree(pworld,stat);
+  if (stat != 0) {close(); return 1;}
+
+  //the next incremental checkpoint into dir starts from this one
+  m_state[dir] = m_read;
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// has
+//----------------------------------------------------------------------------
+bool Pckpt::has(const char* name) const
+{
+  for (size_t r=0;r<m_read.m_names.size();r++)
+  {
+    if (m_read.m_names[r] == name) return true;
+  }
+  return false;
+}
+
+//----------------------------------------------------------------------------
+// read
+//	the checksums of the blocks are checked
+//----------------------------------------------------------------------------
+int Pckpt::read(const char* name, void* data, const long bytes) const
+{
+  long r = -1;
+  for (size_t i=0;i<m_read.m_names.size();i++)
+  {
+    if (m_read.m_names[i] == name) {r = (long) i; break;}
+  }
+  if (m_fd < 0 || r < 0 || m_read.m_bytes[r] != bytes)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pckpt::read region %s of %ld bytes is not in the checkpoint\n",name,bytes);
+    return 1;
+  }
+
+  char* buf = (char*) data;
+  if (pckpt_pread(m_fd,buf,bytes,m_read.m_offset[r]) != 0)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pckpt::read could not read region %s\n",name);
+    return 1;
+  }
+
+  const long nblock = pckpt_nblock(bytes);
+  long bad = 0;
+  #pragma omp parallel for schedule(dynamic) reduction(+:bad)
+  for (long b=0;b<nblock;b++)
+  {
+    const long pos = b*PCKPT_BLOCK;
+    const long len = std::min((long) PCKPT_BLOCK,bytes-pos);
+    if (checksum(buf+pos,len) != m_read.m_sums[r][b]) bad++;
+  }
+  if (bad != 0)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pckpt::read %ld blocks of region %s are corrupt\n",bad,name);
+    return 1;
+  }
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// close
+//----------------------------------------------------------------------------
+int Pckpt::close()
+{
+  if (m_fd >= 0) ::close(m_fd);
+  m_fd = -1;
+  m_read = Pckpt_state();
+  return 0;
+}
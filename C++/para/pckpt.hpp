@@ -0,0 +1,147 @@
+/*----------------------------------------------------------------------------
+  pckpt.hpp
+	JHT, October 14, 2026 : created
+	JHT, October 14, 2026 : XXH64 block checksums
+
+  .hpp file for Pckpt, which writes checkpoints of named memory regions
+  (and a metadata buffer) with one file per task, dir/ckpt.<task>, in the
+  background, and reads them back. Para::checkpoint and Para::restart use
+  it for the Pdata tables, the Pdata windows, and the registered tensors.
+
+  Each region is split into blocks of PCKPT_BLOCK bytes with a 64 bit
+  checksum (XXH64, simd_hash64 of simd.hpp, at about the speed of 
+  memory). An incremental checkpoint into a dir only writes the blocks
+  whose checksum changed since the last checkpoint into (or restart from)
+  that dir, if the regions are still the same. Otherwise all is written.
+
+  write copies the blocks to be written, so the regions can be changed as
+  soon as it returns, and starts a thread that writes them. The header is
+  first written as not valid, then the blocks, then the header as valid,
+  with an fdatasync in between, so a failure during a checkpoint is found
+  by open. To always have one good checkpoint, alternate between two dirs.
+
+  File
+  ---------------------
+    [magic][version][num_tasks][task][valid][meta_bytes][nreg][file bytes]
+    [meta, padded to 8 bytes]
+    per region : [name][bytes][nblock][file offset][checksums]
+    data, each region on a page boundary
+
+  NOTE : write, wait, open are collective over comm_world
+
+//Usage
+ckpt.add("t2",T2.data(),bytes);       //register a region
+ckpt.write(pworld,"ckpt_a",meta,regions,true);
+... compute ...
+ckpt.wait(pworld);                     //done on all tasks, or an error
+ckpt.open(pworld,"ckpt_a",meta);       //restart
+ckpt.read("t2",T2.data(),bytes);
+ckpt.close();
+----------------------------------------------------------------------------*/
+#ifndef LIBJ_PCKPT_HPP
+#define LIBJ_PCKPT_HPP
+#include <stdio.h>
+#include <stdint.h>
+#include <vector>
+#include <string>
+#include <map>
+#include <thread>
+
+#include "libjdef.h"
+#include "pworld.hpp"
+
+#if defined LIBJ_MPI
+  #include <mpi.h>
+#endif
+
+#define PCKPT_NAMELEN 64	//characters of a region name
+#define PCKPT_BLOCK 1048576	//bytes of a checksum block
+#define PCKPT_PAGE 4096		//alignment of the data of a region
+#define PCKPT_VERSION 2
+
+//----------------------------------------------------------------------------
+// Pckpt_region
+//	a named block of memory to checkpoint
+//----------------------------------------------------------------------------
+struct Pckpt_region
+{
+  char  m_name[PCKPT_NAMELEN];
+  char* m_data;
+  long  m_bytes;
+};
+
+//----------------------------------------------------------------------------
+// Pckpt_state
+//	layout and checksums of the last checkpoint in a dir
+//----------------------------------------------------------------------------
+struct Pckpt_state
+{
+  std::vector<std::string>           m_names;
+  std::vector<long>                  m_bytes;
+  std::vector<long>                  m_offset;
+  std::vector<std::vector<uint64_t>> m_sums;
+};
+
+class Pckpt
+{
+  private:
+  std::vector<Pckpt_region>          m_reg;     //registered regions
+  std::map<std::string,Pckpt_state>  m_state;   //last checkpoint of each dir
+
+  //checkpoint being written
+  std::thread                        m_thread;
+  bool                               m_running;
+  bool                               m_truncate; //full checkpoint
+  int                                m_stat;
+  std::string                        m_dir;
+  std::string                        m_path;
+  Pckpt_state                        m_pending;
+  std::vector<char>                  m_head;    //header, meta, and table
+  std::vector<char>                  m_stage;   //blocks to write
+  std::vector<long>                  m_pos;     //file offset of each staged block
+  std::vector<long>                  m_len;     //bytes of each staged block
+
+  //checkpoint being read
+  int                                m_fd;
+  Pckpt_state                        m_read;
+
+  void write_loop();
+  static std::string path(const char* dir, const int task);
+
+  public:
+  Pckpt() {m_running = false; m_truncate = false; m_stat = 0; m_fd = -1;}
+  ~Pckpt();
+
+  //register a region, or change the memory of a registered one
+  int add(const char* name, void* data, const long bytes);
+
+  //remove a registered region
+  int remove(const char* name);
+
+  //registered regions
+  const std::vector<Pckpt_region>& regions() const {return m_reg;}
+
+  //checksum of bytes of data
+  static uint64_t checksum(const char* data, const long bytes);
+
+  //start writing meta and regions to dir, collective
+  int write(const Pworld& pworld, const char* dir, const std::vector<char>& meta,
+            const std::vector<Pckpt_region>& regions, const bool incremental);
+
+  //finish the checkpoint being written, collective
+  int wait(const Pworld& pworld);
+
+  //open the checkpoint of this task in dir and read meta, collective
+  int open(const Pworld& pworld, const char* dir, std::vector<char>& meta);
+
+  //read a region of the open checkpoint
+  int read(const char* name, void* data, const long bytes) const;
+
+  //true if the open checkpoint has a region
+  bool has(const char* name) const;
+
+  //close the open checkpoint
+  int close();
+};
+
+#endif
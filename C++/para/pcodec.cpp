@@ -0,0 +1,236 @@
+/*----------------------------------------------------------------------------
+  pcodec.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for the Pcodec routines
+
+  The ZRLE and TRUNC chunks are a list of runs
+
+    [uint32 zeros][uint32 literals][literals]
+
+  where the literals are words (ZRLE) or floats (TRUNC)
+----------------------------------------------------------------------------*/
+#include "pcodec.hpp"
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <algorithm>
+
+#if defined LIBJ_ZSTD
+  #include <zstd.h>
+#endif
+
+//----------------------------------------------------------------------------
+// word size of a block, and the codec that is really used for it
+//----------------------------------------------------------------------------
+static int pcodec_word(const long bytes)
+{
+  return (bytes % 8 == 0) ? 8 : (bytes % 4 == 0) ? 4 : 1;
+}
+
+static int pcodec_used(const int codec, const long bytes)
+{
+  #if !defined LIBJ_ZSTD
+  if (codec == PCODEC_ZSTD) return PCODEC_ZRLE;
+  #endif
+  if (codec == PCODEC_TRUNC && pcodec_word(bytes) != 8) return PCODEC_ZRLE;
+  return codec;
+}
+
+//----------------------------------------------------------------------------
+// is_zero
+//----------------------------------------------------------------------------
+static inline bool pcodec_zero(const char* w, const int W, const bool trunc,
+                               const double tol)
+{
+  if (trunc)
+  {
+    double x;
+    memcpy(&x,w,sizeof(double));
+    return (fabs(x) < tol) || (x == 0.0);
+  }
+  for (int b=0;b<W;b++) {if (w[b] != (char) 0) return false;}
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// runs, returns the bytes written to out
+//----------------------------------------------------------------------------
+static long pcodec_runs_compress(const char* in, const long nword, const int W,
+                                 const bool trunc, const double tol, char* out)
+{
+  long pos = 0;
+  long w = 0;
+  while (w < nword)
+  {
+    uint32_t nzero = 0, nlit = 0;
+    while (w < nword && nzero < UINT32_MAX && pcodec_zero(in+w*W,W,trunc,tol)) {nzero++; w++;}
+    const long lit0 = w;
+    while (w < nword && nlit < UINT32_MAX && !pcodec_zero(in+w*W,W,trunc,tol)) {nlit++; w++;}
+    memcpy(out+pos,&nzero,sizeof(uint32_t)); pos += sizeof(uint32_t);
+    memcpy(out+pos,&nlit,sizeof(uint32_t)); pos += sizeof(uint32_t);
+    if (trunc)
+    {
+      for (long i=0;i<(long) nlit;i++)
+      {
+        double x;
+        memcpy(&x,in+(lit0+i)*W,sizeof(double));
+        const float f = (float) x;
+        memcpy(out+pos,&f,sizeof(float)); pos += sizeof(float);
+      }
+    } else {
+      memcpy(out+pos,in+lit0*W,(size_t) nlit*W); pos += (long) nlit*W;
+    }
+  }
+  return pos;
+}
+
+static int pcodec_runs_decompress(const char* in, const long cbytes, const int W,
+                                  const bool trunc, char* out, const long nword)
+{
+  long pos = 0;
+  long w = 0;
+  while (pos < cbytes)
+  {
+    uint32_t nzero, nlit;
+    memcpy(&nzero,in+pos,sizeof(uint32_t)); pos += sizeof(uint32_t);
+    memcpy(&nlit,in+pos,sizeof(uint32_t)); pos += sizeof(uint32_t);
+    if (w + (long) nzero + (long) nlit > nword) return 1;
+    memset(out+w*W,0,(size_t) nzero*W); w += nzero;
+    if (trunc)
+    {
+      for (long i=0;i<(long) nlit;i++)
+      {
+        float f;
+        memcpy(&f,in+pos,sizeof(float)); pos += sizeof(float);
+        const double x = (double) f;
+        memcpy(out+(w+i)*W,&x,sizeof(double));
+      }
+    } else {
+      memcpy(out+w*W,in+pos,(size_t) nlit*W); pos += (long) nlit*W;
+    }
+    w += nlit;
+  }
+  return (w == nword) ? 0 : 1;
+}
+
+//----------------------------------------------------------------------------
+// bytes a compressed chunk of cbytes could take
+//----------------------------------------------------------------------------
+static long pcodec_bound(const int codec, const long cbytes, const int W)
+{
+  #if defined LIBJ_ZSTD
+  if (codec == PCODEC_ZSTD) return (long) ZSTD_compressBound((size_t) cbytes);
+  #endif
+  return cbytes + 2*sizeof(uint32_t)*(cbytes/W + 1);
+}
+
+//----------------------------------------------------------------------------
+// pcodec_compress
+//----------------------------------------------------------------------------
+long pcodec_compress(const int codec, const double tol, const char* in,
+                     const long bytes, char* out, std::vector<char>& work)
+{
+  const int used = pcodec_used(codec,bytes);
+  if (used == PCODEC_NONE || bytes == 0) return -1;
+
+  const int  W = pcodec_word(bytes);
+  const long nword = bytes/W;
+  const long nchunk = (nword + PCODEC_CHUNK - 1)/PCODEC_CHUNK;
+  const long head = sizeof(long)*(1+nchunk);
+  if (head >= bytes) return -1;
+
+  const long cap = pcodec_bound(used,(long) PCODEC_CHUNK*W,W);
+  if ((long) work.size() < nchunk*cap) work.resize(nchunk*cap);
+  std::vector<long> csize(nchunk);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (long c=0;c<nchunk;c++)
+  {
+    const long w0 = c*PCODEC_CHUNK;
+    const long nw = std::min((long) PCODEC_CHUNK,nword-w0);
+    char* dst = work.data()+c*cap;
+    #if defined LIBJ_ZSTD
+    if (used == PCODEC_ZSTD)
+    {
+      const size_t num = ZSTD_compress(dst,(size_t) cap,in+w0*W,(size_t) nw*W,1);
+      csize[c] = ZSTD_isError(num) ? cap+1 : (long) num;
+      continue;
+    }
+    #endif
+    csize[c] = pcodec_runs_compress(in+w0*W,nw,W,used == PCODEC_TRUNC,tol,dst);
+  }
+
+  long total = head;
+  for (long c=0;c<nchunk;c++) {total += csize[c];}
+  if (total >= bytes) return -1;
+
+  memcpy(out,&nchunk,sizeof(long));
+  memcpy(out+sizeof(long),csize.data(),sizeof(long)*nchunk);
+  long pos = head;
+  for (long c=0;c<nchunk;c++)
+  {
+    memcpy(out+pos,work.data()+c*cap,(size_t) csize[c]);
+    pos += csize[c];
+  }
+  return total;
+}
+
+//----------------------------------------------------------------------------
+// pcodec_decompress
+//----------------------------------------------------------------------------
+int pcodec_decompress(const int codec, const char* in, const long cbytes,
+                      char* out, const long bytes)
+{
+  const int used = pcodec_used(codec,bytes);
+  const int  W = pcodec_word(bytes);
+  const long nword = bytes/W;
+  const long nchunk = (nword + PCODEC_CHUNK - 1)/PCODEC_CHUNK;
+
+  long stored;
+  memcpy(&stored,in,sizeof(long));
+  if (stored != nchunk || cbytes < (long) sizeof(long)*(1+nchunk))
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("pcodec_decompress block does not have %ld chunks\n",nchunk);
+    return 1;
+  }
+
+  //offsets of the chunks
+  std::vector<long> off(nchunk+1);
+  off[0] = sizeof(long)*(1+nchunk);
+  for (long c=0;c<nchunk;c++)
+  {
+    long csize;
+    memcpy(&csize,in+sizeof(long)*(1+c),sizeof(long));
+    off[c+1] = off[c] + csize;
+  }
+  if (off[nchunk] != cbytes) return 1;
+
+  int stat = 0;
+  #pragma omp parallel for schedule(dynamic) reduction(+:stat)
+  for (long c=0;c<nchunk;c++)
+  {
+    const long w0 = c*PCODEC_CHUNK;
+    const long nw = std::min((long) PCODEC_CHUNK,nword-w0);
+    #if defined LIBJ_ZSTD
+    if (used == PCODEC_ZSTD)
+    {
+      const size_t num = ZSTD_decompress(out+w0*W,(size_t) nw*W,in+off[c],
+                                         (size_t) (off[c+1]-off[c]));
+      stat += (ZSTD_isError(num) || (long) num != nw*W) ? 1 : 0;
+      continue;
+    }
+    #endif
+    stat += pcodec_runs_decompress(in+off[c],off[c+1]-off[c],W,
+                                   used == PCODEC_TRUNC,out+w0*W,nw);
+  }
+  if (stat != 0)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("pcodec_decompress block is corrupt\n");
+    return 1;
+  }
+  return 0;
+}
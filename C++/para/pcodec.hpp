@@ -0,0 +1,46 @@
+/*----------------------------------------------------------------------------
+  pcodec.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for the Pcodec routines, which compress the blocks of a Pdata
+  list before they are written to disk, and undo it after they are read.
+
+  Codecs
+  ---------------------
+  PCODEC_NONE	: no compression
+  PCODEC_ZRLE	: lossless, runs of zero words (8 or 4 bytes) are stored as a
+		  count, which is most of the gain for near-zero blocks
+  PCODEC_TRUNC	: lossy, for doubles. |x| < tol is zero, and the rest are
+		  stored as floats, in the same runs as ZRLE
+  PCODEC_ZSTD	: lossless zstd (level 1), only with -DLIBJ_ZSTD and -lzstd,
+		  otherwise it is ZRLE
+
+  A block is split into chunks of PCODEC_CHUNK words, which are done in
+  parallel over the OpenMP threads, and stored as
+
+    [nchunk][bytes of each chunk][chunk 0][chunk 1]...
+
+  pcodec_compress returns the compressed bytes, or -1 if that would not
+  be smaller than the block, in which case the block should be stored as
+  it is. work is resized as needed, so it can be kept between calls.
+----------------------------------------------------------------------------*/
+#ifndef LIBJ_PCODEC_HPP
+#define LIBJ_PCODEC_HPP
+#include <vector>
+
+#define PCODEC_NONE 0
+#define PCODEC_ZRLE 1
+#define PCODEC_TRUNC 2
+#define PCODEC_ZSTD 3
+
+#define PCODEC_CHUNK 16384	//words per chunk
+
+//compress bytes of in into out, which has room for bytes
+long pcodec_compress(const int codec, const double tol, const char* in,
+                     const long bytes, char* out, std::vector<char>& work);
+
+//decompress cbytes of in into the bytes of out, returns 0 on success
+int pcodec_decompress(const int codec, const char* in, const long cbytes,
+                      char* out, const long bytes);
+
+#endif
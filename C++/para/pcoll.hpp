@@ -0,0 +1,237 @@
+/*----------------------------------------------------------------------------
+  pcoll.hpp
+	JHT, October 14, 2026 : created
+	JHT, October 14, 2026 : the blocking calls and wait are traced
+	JHT, October 14, 2026 : added allreduce_repro
+
+  .hpp file for Pcoll, collective operations on (contiguous) buffers of
+  double, float, long, or int over comm_world. Para wraps these for
+  libj::tensors.
+
+  All are in place, and collective over comm_world.
+
+//Non-blocking
+Prequest req;
+Pcoll::iallreduce(pworld,data,n,PCOLL_SUM,req);   //MPI_Iallreduce
+Pcoll::ibcast(pworld,data,n,root,req);	          //MPI_Ibcast
+... compute ...
+Pcoll::wait(req);
+
+//Blocking
+Pcoll::allreduce(pworld,data,n,PCOLL_SUM);        //picks one of the below
+Pcoll::allreduce_pipelined(pworld,data,n,op,chunk);
+Pcoll::allreduce_nodes(pworld,data,n,op);
+Pcoll::allreduce_repro(pworld,data,n);            //reproducible sum
+
+  allreduce_pipelined splits the buffer into chunks, and keeps up to
+  PCOLL_PIPE_DEPTH MPI_Iallreduces of them in flight, so the reduction of
+  chunk k overlaps the transfer of chunk k+1. This also handles buffers
+  of more than INT_MAX elements.
+
+  allreduce_nodes is two-level: a reduce on comm_shared to the shared
+  root, an allreduce of the shared roots on comm_nodes, and a bcast on
+  comm_shared. Only one copy per node goes over the network.
+
+  allreduce uses allreduce_nodes when there are several nodes with more
+  than one task each, and allreduce_pipelined otherwise.
+
+  allreduce_repro is a sum (of double or float) whose result does not
+  depend on the order the tasks are added in, so it is the same for
+  flat and two-level reductions, any MPI reduction tree, and any
+  placement of the tasks. Each element is cut into SIMD_REPRO_FOLDS
+  folds (simd_repro.hpp), after an allreduce of the largest |x|, and
+  the folds are summed exactly. This is 1+SIMD_REPRO_FOLDS times the
+  traffic of allreduce. What each task adds in is still up to it, for
+  a sum over data split over the tasks see Para::repro_sum.
+
+  The non-blocking calls need n <= INT_MAX. Without MPI, these do nothing.
+----------------------------------------------------------------------------*/
+#ifndef LIBJ_PCOLL_HPP
+#define LIBJ_PCOLL_HPP
+#include <stdio.h>
+#include <limits.h>
+#include <algorithm>
+#include <vector>
+#include <math.h>
+
+#include "libjdef.h"
+#include "pworld.hpp"
+#include "trace.hpp"
+#include "simd_repro.hpp"
+
+#if defined LIBJ_MPI
+  #include <mpi.h>
+#endif
+
+//reduction ops
+#define PCOLL_SUM 0
+#define PCOLL_PROD 1
+#define PCOLL_MAX 2
+#define PCOLL_MIN 3
+
+#define PCOLL_PIPE_DEPTH 2	//chunks in flight in allreduce_pipelined
+#define PCOLL_CHUNK 1048576	//default elements of a chunk
+
+#if defined LIBJ_MPI
+  typedef MPI_Request Prequest;
+#else
+  typedef int Prequest;
+#endif
+
+struct Pcoll
+{
+  #if defined LIBJ_MPI
+  //MPI op of a PCOLL op
+  static MPI_Op op(const int pop)
+  {
+    switch (pop)
+    {
+      case PCOLL_PROD : return MPI_PROD;
+      case PCOLL_MAX  : return MPI_MAX;
+      case PCOLL_MIN  : return MPI_MIN;
+      default         : return MPI_SUM;
+    }
+  }
+  #endif
+
+  //checks that n fits in an MPI count
+  static int check_count(const char* name, const long n)
+  {
+    if (n <= (long) INT_MAX) return 0;
+    printf("\nERROR ERROR ERROR\n");
+    printf("%s %ld elements is more than INT_MAX, use allreduce_pipelined\n",name,n);
+    return 1;
+  }
+
+  //start an in place allreduce
+  template <typename T>
+  static int iallreduce(const Pworld& pworld, T* data, const long n, const int pop,
+                        Prequest& req)
+  {
+    if (check_count("Pcoll::iallreduce",n) != 0) return 1;
+    #if defined LIBJ_MPI
+    MPI_Iallreduce(MPI_IN_PLACE,data,(int) n,Pmpi_type<T>::get(),op(pop),
+                   pworld.comm_world,&req);
+    #else
+    req = 0;
+    #endif
+    return 0;
+  }
+
+  //start a bcast from root
+  template <typename T>
+  static int ibcast(const Pworld& pworld, T* data, const long n, const int root,
+                    Prequest& req)
+  {
+    if (check_count("Pcoll::ibcast",n) != 0) return 1;
+    #if defined LIBJ_MPI
+    MPI_Ibcast(data,(int) n,Pmpi_type<T>::get(),root,pworld.comm_world,&req);
+    #else
+    req = 0;
+    #endif
+    return 0;
+  }
+
+  //wait for a non-blocking call
+  static int wait(Prequest& req)
+  {
+    LIBJ_TRACE_SCOPE("wait","comm");
+    #if defined LIBJ_MPI
+    MPI_Wait(&req,MPI_STATUS_IGNORE);
+    #endif
+    return 0;
+  }
+
+  //chunked allreduce, with PCOLL_PIPE_DEPTH chunks in flight
+  template <typename T>
+  static int allreduce_pipelined(const Pworld& pworld, T* data, const long n,
+                                 const int pop, const long chunk = PCOLL_CHUNK)
+  {
+    LIBJ_TRACE_SCOPE_ARG("allreduce","comm",n*(long) sizeof(T));
+    #if defined LIBJ_MPI
+    const long len = std::min(std::max(chunk,1L),(long) INT_MAX);
+    Prequest req[PCOLL_PIPE_DEPTH];
+    long nchunk = 0;
+    for (long start=0;start<n;start+=len,nchunk++)
+    {
+      const int slot = (int) (nchunk % PCOLL_PIPE_DEPTH);
+      if (nchunk >= PCOLL_PIPE_DEPTH) MPI_Wait(&req[slot],MPI_STATUS_IGNORE);
+      MPI_Iallreduce(MPI_IN_PLACE,data+start,(int) std::min(len,n-start),
+                     Pmpi_type<T>::get(),op(pop),pworld.comm_world,&req[slot]);
+    }
+    const long nwait = std::min(nchunk,(long) PCOLL_PIPE_DEPTH);
+    for (long i=0;i<nwait;i++)
+    {
+      MPI_Wait(&req[(nchunk-nwait+i) % PCOLL_PIPE_DEPTH],MPI_STATUS_IGNORE);
+    }
+    #endif
+    return 0;
+  }
+
+  //two-level allreduce, through the shared roots
+  template <typename T>
+  static int allreduce_nodes(const Pworld& pworld, T* data, const long n,
+                             const int pop, const long chunk = PCOLL_CHUNK)
+  {
+    LIBJ_TRACE_SCOPE_ARG("allreduce_nodes","comm",n*(long) sizeof(T));
+    #if defined LIBJ_MPI
+    const long len = std::min(std::max(chunk,1L),(long) INT_MAX);
+    const MPI_Datatype type = Pmpi_type<T>::get();
+    for (long start=0;start<n;start+=len)
+    {
+      const int num = (int) std::min(len,n-start);
+      if (pworld.mpi_shared_ismaster) {
+        MPI_Reduce(MPI_IN_PLACE,data+start,num,type,op(pop),
+                   pworld.mpi_shared_root,pworld.comm_shared);
+        MPI_Allreduce(MPI_IN_PLACE,data+start,num,type,op(pop),pworld.comm_nodes);
+      } else {
+        MPI_Reduce(data+start,NULL,num,type,op(pop),
+                   pworld.mpi_shared_root,pworld.comm_shared);
+      }
+      MPI_Bcast(data+start,num,type,pworld.mpi_shared_root,pworld.comm_shared);
+    }
+    #endif
+    return 0;
+  }
+
+  //blocking allreduce
+  template <typename T>
+  static int allreduce(const Pworld& pworld, T* data, const long n, const int pop)
+  {
+    if (pworld.mpi_num_nodes > 1 && pworld.mpi_world_num_tasks > pworld.mpi_num_nodes)
+    {
+      return allreduce_nodes(pworld,data,n,pop);
+    }
+    return allreduce_pipelined(pworld,data,n,pop);
+  }
+
+  //blocking sum, the same for any order of the tasks
+  template <typename T>
+  static int allreduce_repro(const Pworld& pworld, T* data, const long n)
+  {
+    LIBJ_TRACE_SCOPE_ARG("allreduce_repro","comm",n*(long) sizeof(T));
+    #if defined LIBJ_MPI
+    const int K = SIMD_REPRO_FOLDS;
+    std::vector<double> amax(n);
+    for (long i=0;i<n;i++) amax[i] = fabs((double) data[i]);
+    allreduce(pworld,amax.data(),n,PCOLL_MAX);
+
+    std::vector<double> fold(K*n,0.0);
+    double sigma[SIMD_REPRO_FOLDS];
+    for (long i=0;i<n;i++)
+    {
+      if (libj::simd_repro_sigma(amax[i],pworld.mpi_world_num_tasks,sigma))
+      {
+        libj::simd_repro_deposit((double) data[i],sigma,fold.data()+K*i);
+      } else {
+        fold[K*i] = (amax[i] != 0.0) ? (double) data[i] : 0.0;
+      }
+    }
+    allreduce(pworld,fold.data(),K*n,PCOLL_SUM);
+    for (long i=0;i<n;i++) data[i] = (T) libj::simd_repro_result(fold.data()+K*i);
+    #endif
+    return 0;
+  }
+};
+
+#endif
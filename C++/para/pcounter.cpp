@@ -0,0 +1,84 @@
+/*----------------------------------------------------------------------------
+  pcounter.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for Pcounter
+----------------------------------------------------------------------------*/
+#include "pcounter.hpp"
+
+//----------------------------------------------------------------------------
+// init
+//	the window is in a passive-target lock_all epoch until destroy
+//----------------------------------------------------------------------------
+int Pcounter::init(const Pworld& pworld)
+{
+  if (m_active) return 0;
+  #if defined LIBJ_MPI
+  const MPI_Aint bytes = pworld.mpi_world_ismaster ? (MPI_Aint) sizeof(long) : 0;
+  if (MPI_Win_allocate(bytes,sizeof(long),MPI_INFO_NULL,pworld.comm_world,
+                       &m_base,&m_win) != MPI_SUCCESS)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pcounter::init could not allocate the counter window\n");
+    return 1;
+  }
+  if (pworld.mpi_world_ismaster) {*m_base = 0;} else {m_base = NULL;}
+  MPI_Win_lock_all(MPI_MODE_NOCHECK,m_win);
+  MPI_Barrier(pworld.comm_world);
+  #endif
+  m_val = 0;
+  m_active = true;
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// destroy
+//----------------------------------------------------------------------------
+int Pcounter::destroy(const Pworld& pworld)
+{
+  if (!m_active) return 0;
+  #if defined LIBJ_MPI
+  MPI_Win_unlock_all(m_win);
+  MPI_Win_free(&m_win);
+  #endif
+  m_base = NULL;
+  m_active = false;
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// reset
+//	the barriers make sure no task is still using the old value
+//----------------------------------------------------------------------------
+int Pcounter::reset(const Pworld& pworld)
+{
+  #if defined LIBJ_MPI
+  const long zero = 0;
+  MPI_Barrier(pworld.comm_world);
+  if (pworld.mpi_world_ismaster)
+  {
+    MPI_Accumulate(&zero,1,MPI_LONG,0,0,1,MPI_LONG,MPI_REPLACE,m_win);
+    MPI_Win_flush(0,m_win);
+  }
+  MPI_Barrier(pworld.comm_world);
+  #endif
+  m_val = 0;
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// next
+//----------------------------------------------------------------------------
+long Pcounter::next(const long inc)
+{
+  #if defined LIBJ_MPI
+  long val;
+  MPI_Fetch_and_op(&inc,&val,MPI_LONG,0,0,MPI_SUM,m_win);
+  MPI_Win_flush(0,m_win);
+  return val;
+  #else
+  const long val = m_val;
+  m_val += inc;
+  return val;
+  #endif
+}
@@ -0,0 +1,55 @@
+/*----------------------------------------------------------------------------
+  pcounter.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for Pcounter, a global shared counter (NXTVAL) for dynamic 
+  load balancing. The counter lives in a one long MPI window on the world
+  master, and next() is an atomic MPI_Fetch_and_op on it, so a task can
+  take the next block of work without any other task taking part.
+
+  NOTE : init, reset, and destroy are collective over comm_world
+
+//Usage
+cnt.init(pworld);
+cnt.reset(pworld);              //counter is 0 on all tasks
+long i = cnt.next(chunk);       //returns the counter, and adds chunk to it 
+cnt.destroy(pworld);
+
+  Without MPI, the counter is a plain long.
+----------------------------------------------------------------------------*/
+#ifndef LIBJ_PCOUNTER_HPP
+#define LIBJ_PCOUNTER_HPP
+#include <stdio.h>
+
+#include "libjdef.h"
+#include "pworld.hpp"
+
+#if defined LIBJ_MPI
+  #include <mpi.h>
+#endif
+
+struct Pcounter
+{
+  #if defined LIBJ_MPI
+    MPI_Win m_win;   //window of the counter
+  #endif
+  long*   m_base;    //the counter on the master, NULL elsewhere 
+  long    m_val;     //the counter without MPI
+  bool    m_active;  //init has been called
+
+  Pcounter() {m_base = NULL; m_val = 0; m_active = false;}
+
+  //allocate the counter
+  int init(const Pworld& pworld);
+
+  //free the counter
+  int destroy(const Pworld& pworld);
+
+  //set the counter to zero
+  int reset(const Pworld& pworld);
+
+  //fetch the counter and add inc to it
+  long next(const long inc);
+};
+
+#endif
@@ -1,10 +1,23 @@
 /*----------------------------------------------------------------------------
   pdata.cpp
 	JHT, Febuary 14, 2022 : created
+	JHT, October 14, 2026 : added the one-sided windows
+	JHT, October 14, 2026 : added distribute
+	JHT, October 14, 2026 : find_list uses a Phash
+	JHT, October 14, 2026 : added the block cache
+	JHT, October 14, 2026 : added prefetch
+	JHT, October 14, 2026 : added the block compression
+	JHT, October 14, 2026 : added pack and unpack
+	JHT, October 14, 2026 : added the memory tier
+	JHT, October 14, 2026 : added the remote block cache
+	JHT, October 14, 2026 : added the block checksums
 
   .cpp file for Pdata class
 ----------------------------------------------------------------------------*/
 #include "pdata.hpp"
+#include "simd.hpp"
+#include <stdlib.h>
+#include <algorithm>
 
 //----------------------------------------------------------------------------
 // Pdata() constructor
@@ -12,6 +25,23 @@
 Pdata::Pdata()
 {
   m_num_lists=0;
+  m_cache_max = 0;
+  m_cache_bytes = 0;
+  m_cache_hand = 0;
+  m_spill_bytes = 0;
+}
+
+//----------------------------------------------------------------------------
+// ~Pdata() destructor
+//	frees the block cache, without writing it back
+//----------------------------------------------------------------------------
+Pdata::~Pdata()
+{
+  for (size_t i=0;i<m_cache.size();i++) 
+  {
+    free(m_cache[i].m_data);
+    free(m_cache[i].m_stage);
+  }
 }
 //----------------------------------------------------------------------------
 // list_size
@@ -33,7 +63,7 @@ void Pdata::add_index(const long list_id, const int task_id,
                      const long file_pos, const long index_size)
 {
   m_list_size[list_id]++;
-  m_index[list_id].push_back({task_id,file_pos,index_size});
+  m_index[list_id].push_back({task_id,file_pos,index_size,0,-1,0,false,0});
 }
 
 //----------------------------------------------------------------------------
@@ -90,11 +120,8 @@ void Pdata::print_lists(const Pworld& pworld, Pprint& pprint) const
 //----------------------------------------------------------------------------
 long Pdata::find_list(const long list_tag) const
 {
-  for (long i=0;i<m_num_lists;i++)
-  {
-    if (m_list_tags[i] == list_tag) {return i;}
-  }
-  return -1;
+  return m_tag_hash.find(Phash::hash(list_tag),[&](const long list_id)
+                         {return m_list_tags[list_id] == list_tag;});
 }
 
 //----------------------------------------------------------------------------
@@ -113,9 +140,12 @@ long Pdata::add_list(const long list_tag, const int file_id,
   { 
     m_num_lists++;
     m_list_tags.push_back(list_tag);
+    m_tag_hash.insert(Phash::hash(list_tag),m_num_lists-1);
     m_list_size.push_back(0);
-    m_list_info.push_back({file_id,bytes});
+    m_list_info.push_back({file_id,bytes,PCODEC_NONE,0.0,PDATA_TIER_FILE,false});
     m_index.resize(m_num_lists);
+    m_win.resize(m_num_lists);
+    m_rcache.resize(m_num_lists);
     return m_num_lists-1;
   //list does exist, and is the same
   } else if (list_id >= 0 
@@ -130,3 +160,1136 @@ long Pdata::add_list(const long list_tag, const int file_id,
   return 0;
 }
 
+
+//----------------------------------------------------------------------------
+// Pdata::make_window
+//	each task allocates the indexes of list_id it stores, in order, and 
+//	every task computes the same m_mem_pos for all of the indexes
+//----------------------------------------------------------------------------
+int Pdata::make_window(const Pworld& pworld, const long list_id)
+{
+  if (list_id < 0 || list_id >= m_num_lists || m_win[list_id].m_active)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pdata::make_window list %ld does not exist or has a window\n",list_id);
+    return 1;
+  }
+
+  const long bytes = m_list_info[list_id].m_bytes;
+  std::vector<long> task_bytes(pworld.mpi_world_num_tasks,0);
+  for (long index=0;index<m_list_size[list_id];index++)
+  {
+    Pindex_info& info = m_index[list_id][index];
+    info.m_mem_pos = task_bytes[info.m_storage_task];
+    task_bytes[info.m_storage_task] += bytes*info.m_size;
+  }
+
+  Pwin& win = m_win[list_id];
+  win.m_bytes = task_bytes[pworld.mpi_world_task_id];
+
+  #if defined LIBJ_MPI
+  if (MPI_Win_allocate((MPI_Aint) win.m_bytes,1,MPI_INFO_NULL,pworld.comm_world,
+                       &win.m_base,&win.m_win) != MPI_SUCCESS)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pdata::make_window could not allocate %ld bytes\n",win.m_bytes);
+    return 1;
+  }
+  MPI_Type_contiguous((int) bytes,MPI_BYTE,&win.m_type);
+  MPI_Type_commit(&win.m_type);
+  MPI_Win_lock_all(MPI_MODE_NOCHECK,win.m_win);
+  #else
+  win.m_base = (char*) malloc(sizeof(char)*win.m_bytes);
+  if (win.m_base == NULL && win.m_bytes > 0)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pdata::make_window could not malloc %ld bytes\n",win.m_bytes);
+    return 1;
+  }
+  #endif
+
+  win.m_active = true;
+  win.m_shared = false;
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// Pdata::make_shared_window
+//	the shared root allocates all of the indexes of list_id, in order, and
+//	the other tasks of the node map its memory 
+//----------------------------------------------------------------------------
+int Pdata::make_shared_window(const Pworld& pworld, const long list_id)
+{
+  if (list_id < 0 || list_id >= m_num_lists || m_win[list_id].m_active)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pdata::make_shared_window list %ld does not exist or has a window\n",
+           list_id);
+    return 1;
+  }
+
+  const long bytes = m_list_info[list_id].m_bytes;
+  long total = 0;
+  for (long index=0;index<m_list_size[list_id];index++)
+  {
+    Pindex_info& info = m_index[list_id][index];
+    info.m_mem_pos = total;
+    total += bytes*info.m_size;
+  }
+
+  Pwin& win = m_win[list_id];
+  win.m_bytes = total;
+
+  #if defined LIBJ_MPI
+  const MPI_Aint mybytes = pworld.mpi_shared_ismaster ? (MPI_Aint) total : 0;
+  if (MPI_Win_allocate_shared(mybytes,1,MPI_INFO_NULL,pworld.comm_shared,
+                              &win.m_base,&win.m_win) != MPI_SUCCESS)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pdata::make_shared_window could not allocate %ld bytes\n",total);
+    return 1;
+  }
+  MPI_Aint size;
+  int disp;
+  MPI_Win_shared_query(win.m_win,pworld.mpi_shared_root,&size,&disp,&win.m_base);
+  MPI_Type_contiguous((int) bytes,MPI_BYTE,&win.m_type);
+  MPI_Type_commit(&win.m_type);
+  MPI_Win_lock_all(MPI_MODE_NOCHECK,win.m_win);
+  #else
+  win.m_base = (char*) malloc(sizeof(char)*total);
+  if (win.m_base == NULL && total > 0)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pdata::make_shared_window could not malloc %ld bytes\n",total);
+    return 1;
+  }
+  #endif
+
+  win.m_active = true;
+  win.m_shared = true;
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// Pdata::sync_window
+//	makes the stores of all tasks on the node visible
+//----------------------------------------------------------------------------
+int Pdata::sync_window(const Pworld& pworld, const long list_id) const
+{
+  if (list_id < 0 || list_id >= m_num_lists || !m_win[list_id].m_active) {return 1;}
+  #if defined LIBJ_MPI
+  const Pwin& win = m_win[list_id];
+  MPI_Win_sync(win.m_win);
+  MPI_Barrier(win.m_shared ? pworld.comm_shared : pworld.comm_world);
+  MPI_Win_sync(win.m_win);
+  #endif
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// Pdata::free_window
+//----------------------------------------------------------------------------
+int Pdata::free_window(const Pworld& pworld, const long list_id)
+{
+  if (list_id < 0 || list_id >= m_num_lists || !m_win[list_id].m_active) {return 1;}
+  Pwin& win = m_win[list_id];
+  if (m_rcache[list_id].m_active) {free_remote_cache(pworld,list_id);}
+  #if defined LIBJ_MPI
+  MPI_Win_unlock_all(win.m_win);
+  MPI_Win_free(&win.m_win);
+  MPI_Type_free(&win.m_type);
+  #else
+  if (win.m_base != NULL) free(win.m_base);
+  #endif
+  win.m_base = NULL;
+  win.m_bytes = 0;
+  win.m_active = false;
+  win.m_shared = false;
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// Pdata::make_remote_cache
+//	the shared root allocates the state words and the slots, which start
+//	empty. The nodes are found as in distribute
+//----------------------------------------------------------------------------
+int Pdata::make_remote_cache(const Pworld& pworld, const long list_id, const long bytes)
+{
+  if (list_id < 0 || list_id >= m_num_lists || !m_win[list_id].m_active 
+      || m_win[list_id].m_shared || m_rcache[list_id].m_active)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pdata::make_remote_cache list %ld has no window of its own, or has a cache\n",
+           list_id);
+    return 1;
+  }
+
+  long largest = 0;
+  for (long index=0;index<m_list_size[list_id];index++)
+  {
+    largest = std::max(largest,m_index[list_id][index].m_size);
+  }
+  Prcache& rc = m_rcache[list_id];
+  rc.m_slot_bytes = ((largest*(long) m_list_info[list_id].m_bytes + 63)/64)*64;
+  rc.m_nslot = (rc.m_slot_bytes > 0) ? bytes/(rc.m_slot_bytes + (long) sizeof(long)) : 0;
+  if (rc.m_nslot < 1)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pdata::make_remote_cache %ld bytes do not hold an index of list %ld\n",
+           bytes,list_id);
+    return 1;
+  }
+  rc.m_version = 1;
+  rc.m_hits = 0;
+  rc.m_misses = 0;
+  rc.m_task = pworld.mpi_world_task_id;
+  rc.m_root = pworld.mpi_shared_root;
+  rc.m_node.assign(pworld.mpi_world_num_tasks,0);
+
+  #if defined LIBJ_MPI
+  int root = pworld.mpi_world_task_id;
+  MPI_Bcast(&root,1,MPI_INT,pworld.mpi_shared_root,pworld.comm_shared);
+  MPI_Allgather(&root,1,MPI_INT,rc.m_node.data(),1,MPI_INT,pworld.comm_world);
+
+  const long head = ((rc.m_nslot*(long) sizeof(long) + 63)/64)*64;
+  const long total = head + rc.m_nslot*rc.m_slot_bytes;
+  const MPI_Aint mybytes = pworld.mpi_shared_ismaster ? (MPI_Aint) total : 0;
+  char* base = NULL;
+  if (MPI_Win_allocate_shared(mybytes,1,MPI_INFO_NULL,pworld.comm_shared,
+                              &base,&rc.m_win) != MPI_SUCCESS)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pdata::make_remote_cache could not allocate %ld bytes\n",total);
+    return 1;
+  }
+  MPI_Aint size;
+  int disp;
+  MPI_Win_shared_query(rc.m_win,pworld.mpi_shared_root,&size,&disp,&base);
+  rc.m_state = (long*) base;
+  rc.m_data = base + head;
+  if (pworld.mpi_shared_ismaster) {memset(rc.m_state,0,sizeof(long)*rc.m_nslot);}
+  MPI_Win_lock_all(MPI_MODE_NOCHECK,rc.m_win);
+  MPI_Win_sync(rc.m_win);
+  MPI_Barrier(pworld.comm_shared);
+  MPI_Win_sync(rc.m_win);
+  #else
+  rc.m_state = NULL;
+  rc.m_data = NULL;
+  #endif
+
+  rc.m_active = true;
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// Pdata::free_remote_cache
+//----------------------------------------------------------------------------
+int Pdata::free_remote_cache(const Pworld& pworld, const long list_id)
+{
+  if (list_id < 0 || list_id >= m_num_lists || !m_rcache[list_id].m_active) {return 1;}
+  Prcache& rc = m_rcache[list_id];
+  #if defined LIBJ_MPI
+  MPI_Win_unlock_all(rc.m_win);
+  MPI_Win_free(&rc.m_win);
+  #endif
+  rc.m_state = NULL;
+  rc.m_data = NULL;
+  rc.m_nslot = 0;
+  rc.m_node.clear();
+  rc.m_active = false;
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// Pdata::remote_cache_invalidate
+//	the older keys no longer match, and their slots are taken over by
+//	the next stores
+//----------------------------------------------------------------------------
+int Pdata::remote_cache_invalidate(const long list_id)
+{
+  if (list_id < 0 || list_id >= m_num_lists || !m_rcache[list_id].m_active) {return 1;}
+  Prcache& rc = m_rcache[list_id];
+  rc.m_version = (rc.m_version < PDATA_RCACHE_VERSIONS) ? rc.m_version + 1 : 1;
+  return 0;
+}
+
+#if defined LIBJ_MPI
+//----------------------------------------------------------------------------
+// pdata_rcache_key
+//	state of a slot that holds index, stored in version. 0 is empty, and
+//	PDATA_RCACHE_BUSY a store in progress
+//----------------------------------------------------------------------------
+static inline long pdata_rcache_key(const long version, const long index)
+{
+  return (version << 32) | (index + 1);
+}
+
+//----------------------------------------------------------------------------
+// Pdata::rcache_get
+//	the state read before and after the copy must be the key, or a store
+//	took the slot in between and the copy is thrown away
+//----------------------------------------------------------------------------
+int Pdata::rcache_get(const long list_id, const long index, void* buffer) const
+{
+  const Prcache& rc = m_rcache[list_id];
+  const Pindex_info& info = m_index[list_id][index];
+  if (rc.m_node[info.m_storage_task] == rc.m_node[rc.m_task] || index >= PDATA_RCACHE_INDEXES)
+  {
+    return 1;
+  }
+  const long slot = index % rc.m_nslot;
+  const long key = pdata_rcache_key(rc.m_version,index);
+  const MPI_Aint disp = (MPI_Aint) (slot*sizeof(long));
+  long state = 0;
+  MPI_Fetch_and_op(NULL,&state,MPI_LONG,rc.m_root,disp,MPI_NO_OP,rc.m_win);
+  MPI_Win_flush(rc.m_root,rc.m_win);
+  if (state != key) {rc.m_misses++; return 1;}
+
+  MPI_Win_sync(rc.m_win);
+  memcpy(buffer,rc.m_data+slot*rc.m_slot_bytes,m_list_info[list_id].m_bytes*info.m_size);
+  MPI_Win_sync(rc.m_win);
+
+  MPI_Fetch_and_op(NULL,&state,MPI_LONG,rc.m_root,disp,MPI_NO_OP,rc.m_win);
+  MPI_Win_flush(rc.m_root,rc.m_win);
+  if (state != key) {rc.m_misses++; return 1;}
+  rc.m_hits++;
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// Pdata::rcache_store
+//	takes the slot only if no other store has it, and gives up if one
+//	does, since the index is only a copy
+//----------------------------------------------------------------------------
+void Pdata::rcache_store(const long list_id, const long index, const void* buffer) const
+{
+  const Prcache& rc = m_rcache[list_id];
+  const Pindex_info& info = m_index[list_id][index];
+  if (rc.m_node[info.m_storage_task] == rc.m_node[rc.m_task] || index >= PDATA_RCACHE_INDEXES)
+  {
+    return;
+  }
+  const long slot = index % rc.m_nslot;
+  const long key = pdata_rcache_key(rc.m_version,index);
+  const MPI_Aint disp = (MPI_Aint) (slot*sizeof(long));
+  long state = 0;
+  MPI_Fetch_and_op(NULL,&state,MPI_LONG,rc.m_root,disp,MPI_NO_OP,rc.m_win);
+  MPI_Win_flush(rc.m_root,rc.m_win);
+  if (state == key || state == PDATA_RCACHE_BUSY) {return;}
+
+  long busy = PDATA_RCACHE_BUSY;
+  long old = 0;
+  MPI_Compare_and_swap(&busy,&state,&old,MPI_LONG,rc.m_root,disp,rc.m_win);
+  MPI_Win_flush(rc.m_root,rc.m_win);
+  if (old != state) {return;}
+
+  MPI_Win_sync(rc.m_win);
+  memcpy(rc.m_data+slot*rc.m_slot_bytes,buffer,m_list_info[list_id].m_bytes*info.m_size);
+  MPI_Win_sync(rc.m_win);
+  long newkey = key;
+  MPI_Fetch_and_op(&newkey,&old,MPI_LONG,rc.m_root,disp,MPI_REPLACE,rc.m_win);
+  MPI_Win_flush(rc.m_root,rc.m_win);
+}
+#else
+int Pdata::rcache_get(const long list_id, const long index, void* buffer) const {return 1;}
+void Pdata::rcache_store(const long list_id, const long index, const void* buffer) const {}
+#endif
+
+//----------------------------------------------------------------------------
+// Pdata::check_window
+//----------------------------------------------------------------------------
+int Pdata::check_window(const char* name, const long list_id, const long index) const
+{
+  if (list_id < 0 || list_id >= m_num_lists || !m_win[list_id].m_active
+      || index < 0 || index >= m_list_size[list_id])
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("%s list %ld index %ld does not exist or has no window\n",
+           name,list_id,index);
+    return 1;
+  }
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// Pdata::get
+//----------------------------------------------------------------------------
+int Pdata::get(const long list_id, const long index, void* buffer) const
+{
+  if (check_window("Pdata::get",list_id,index) != 0) {return 1;}
+  const Pindex_info& info = m_index[list_id][index];
+  const Pwin& win = m_win[list_id];
+  #if defined LIBJ_MPI
+  if (win.m_shared)
+  {
+    memcpy(buffer,win.m_base+info.m_mem_pos,m_list_info[list_id].m_bytes*info.m_size);
+    return 0;
+  }
+  const bool cached = m_rcache[list_id].m_active;
+  if (cached && rcache_get(list_id,index,buffer) == 0) {return 0;}
+  MPI_Get(buffer,(int) info.m_size,win.m_type,
+          info.m_storage_task,(MPI_Aint) info.m_mem_pos,
+          (int) info.m_size,win.m_type,win.m_win);
+  MPI_Win_flush(info.m_storage_task,win.m_win);
+  if (cached) {rcache_store(list_id,index,buffer);}
+  #else
+  memcpy(buffer,win.m_base+info.m_mem_pos,m_list_info[list_id].m_bytes*info.m_size);
+  #endif
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// Pdata::put
+//----------------------------------------------------------------------------
+int Pdata::put(const long list_id, const long index, const void* buffer) const
+{
+  if (check_window("Pdata::put",list_id,index) != 0) {return 1;}
+  const Pindex_info& info = m_index[list_id][index];
+  const Pwin& win = m_win[list_id];
+  #if defined LIBJ_MPI
+  if (win.m_shared)
+  {
+    memcpy(win.m_base+info.m_mem_pos,buffer,m_list_info[list_id].m_bytes*info.m_size);
+    return 0;
+  }
+  MPI_Put(buffer,(int) info.m_size,win.m_type,
+          info.m_storage_task,(MPI_Aint) info.m_mem_pos,
+          (int) info.m_size,win.m_type,win.m_win);
+  MPI_Win_flush(info.m_storage_task,win.m_win);
+  #else
+  memcpy(win.m_base+info.m_mem_pos,buffer,m_list_info[list_id].m_bytes*info.m_size);
+  #endif
+  return 0;
+}
+
+#if defined LIBJ_MPI
+//----------------------------------------------------------------------------
+// Pdata::check_type
+//	TYPE must hold the bytes of the index
+//----------------------------------------------------------------------------
+static int pdata_check_type(const char* name, const MPI_Datatype type, const long bytes)
+{
+  int tsize = 0;
+  MPI_Type_size(type,&tsize);
+  if ((long) tsize != bytes)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("%s datatype holds %d bytes, the index %ld\n",name,tsize,bytes);
+    return 1;
+  }
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// Pdata::get (datatype)
+//	local copies of node-shared windows go through MPI_COMM_SELF, which
+//	unpacks into the datatype
+//----------------------------------------------------------------------------
+int Pdata::get(const long list_id, const long index, void* buffer, const MPI_Datatype type) const
+{
+  if (check_window("Pdata::get",list_id,index) != 0) {return 1;}
+  const Pindex_info& info = m_index[list_id][index];
+  const Pwin& win = m_win[list_id];
+  if (pdata_check_type("Pdata::get",type,m_list_info[list_id].m_bytes*info.m_size) != 0) {return 1;}
+  if (win.m_shared)
+  {
+    MPI_Sendrecv(win.m_base+info.m_mem_pos,(int) info.m_size,win.m_type,0,0,
+                 buffer,1,type,0,0,MPI_COMM_SELF,MPI_STATUS_IGNORE);
+    return 0;
+  }
+  MPI_Get(buffer,1,type,
+          info.m_storage_task,(MPI_Aint) info.m_mem_pos,
+          (int) info.m_size,win.m_type,win.m_win);
+  MPI_Win_flush(info.m_storage_task,win.m_win);
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// Pdata::put (datatype)
+//----------------------------------------------------------------------------
+int Pdata::put(const long list_id, const long index, const void* buffer, const MPI_Datatype type) const
+{
+  if (check_window("Pdata::put",list_id,index) != 0) {return 1;}
+  const Pindex_info& info = m_index[list_id][index];
+  const Pwin& win = m_win[list_id];
+  if (pdata_check_type("Pdata::put",type,m_list_info[list_id].m_bytes*info.m_size) != 0) {return 1;}
+  if (win.m_shared)
+  {
+    MPI_Sendrecv(buffer,1,type,0,0,
+                 win.m_base+info.m_mem_pos,(int) info.m_size,win.m_type,0,0,
+                 MPI_COMM_SELF,MPI_STATUS_IGNORE);
+    return 0;
+  }
+  MPI_Put(buffer,1,type,
+          info.m_storage_task,(MPI_Aint) info.m_mem_pos,
+          (int) info.m_size,win.m_type,win.m_win);
+  MPI_Win_flush(info.m_storage_task,win.m_win);
+  return 0;
+}
+#endif
+
+//----------------------------------------------------------------------------
+// Pdata::local
+//	any index of a node-shared window is local
+//----------------------------------------------------------------------------
+void* Pdata::local(const Pworld& pworld, const long list_id, const long index) const
+{
+  if (check_window("Pdata::local",list_id,index) != 0) {return NULL;}
+  const Pindex_info& info = m_index[list_id][index];
+  if (!m_win[list_id].m_shared && info.m_storage_task != pworld.mpi_world_task_id)
+  {
+    return NULL;
+  }
+  return (void*) (m_win[list_id].m_base + info.m_mem_pos);
+}
+
+//----------------------------------------------------------------------------
+// Pdata::distribute
+//	longest-processing-time over nodes, then tasks. The node of a task is
+//	the world id of its shared root. Ties go to the lowest id, so that 
+//	every task makes the same choices
+//----------------------------------------------------------------------------
+int Pdata::distribute(const Pworld& pworld, const long list_id, const double* cost)
+{
+  if (list_id < 0 || list_id >= m_num_lists || m_win[list_id].m_active)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pdata::distribute list %ld does not exist or has a window\n",list_id);
+    return 1;
+  }
+
+  //node of each task
+  const int ntasks = pworld.mpi_world_num_tasks;
+  std::vector<int> task_node(ntasks,0);
+  #if defined LIBJ_MPI
+  int root = pworld.mpi_world_task_id;
+  MPI_Bcast(&root,1,MPI_INT,pworld.mpi_shared_root,pworld.comm_shared);
+  MPI_Allgather(&root,1,MPI_INT,task_node.data(),1,MPI_INT,pworld.comm_world);
+  #endif
+  std::vector<int> nodes(task_node);
+  std::sort(nodes.begin(),nodes.end());
+  nodes.erase(std::unique(nodes.begin(),nodes.end()),nodes.end());
+  for (int task=0;task<ntasks;task++)
+  {
+    task_node[task] = (int) (std::lower_bound(nodes.begin(),nodes.end(),task_node[task])
+                             - nodes.begin());
+  }
+  const int nnodes = (int) nodes.size();
+
+  //indexes from the largest cost down
+  const long num = m_list_size[list_id];
+  const double bytes = (double) m_list_info[list_id].m_bytes;
+  std::vector<double> icost(num);
+  std::vector<long> order(num);
+  for (long index=0;index<num;index++)
+  {
+    icost[index] = (cost != NULL) ? cost[index] : bytes*m_index[list_id][index].m_size;
+    order[index] = index;
+  }
+  std::stable_sort(order.begin(),order.end(),[&](const long a, const long b)
+  {
+    return icost[a] > icost[b];
+  });
+
+  std::vector<double> node_load(nnodes,0);
+  std::vector<double> task_load(ntasks,0);
+  for (long i=0;i<num;i++)
+  {
+    const long index = order[i];
+    int node = 0;
+    for (int n=1;n<nnodes;n++) {if (node_load[n] < node_load[node]) node = n;}
+    int task = -1;
+    for (int t=0;t<ntasks;t++) 
+    {
+      if (task_node[t] == node && (task == -1 || task_load[t] < task_load[task])) task = t;
+    }
+    node_load[node] += icost[index];
+    task_load[task] += icost[index];
+    m_index[list_id][index].m_storage_task = task;
+  }
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// Pdata::cache_init
+//----------------------------------------------------------------------------
+int Pdata::cache_init(const Pworld& pworld, const long bytes, const bool per_task)
+{
+  m_cache_max = per_task ? bytes : bytes/pworld.mpi_shared_num_tasks;
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// Pdata::set_tier
+//----------------------------------------------------------------------------
+int Pdata::set_tier(const long list_id, const int tier)
+{
+  if (list_id < 0 || list_id >= m_num_lists 
+      || (tier != PDATA_TIER_FILE && tier != PDATA_TIER_MEMORY)) {return 1;}
+  m_list_info[list_id].m_tier = tier;
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// Pdata::pin
+//	a cached block is just marked referenced (after its prefetch is 
+//	done), otherwise it is added to the cache and read from the file. A
+//	block of the memory tier that was never spilled is zeroed instead
+//----------------------------------------------------------------------------
+void* Pdata::pin(Pfile& pfile, const long list_id, const long index, const bool read)
+{
+  if (list_id < 0 || list_id >= m_num_lists || index < 0 || index >= m_list_size[list_id])
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pdata::pin list %ld index %ld does not exist\n",list_id,index);
+    return NULL;
+  }
+
+  Pindex_info& info = m_index[list_id][index];
+  if (info.m_cache != -1)
+  {
+    Pcache_entry& entry = m_cache[info.m_cache];
+    if (cache_wait(pfile,entry) != 0) 
+    {
+      if (entry.m_pins == 0) cache_drop(entry);
+      return NULL;
+    }
+    entry.m_pins++;
+    entry.m_ref = true;
+    return (void*) entry.m_data;
+  }
+
+  const long bytes = (long) m_list_info[list_id].m_bytes*info.m_size;
+  const long slot = cache_add(pfile,list_id,index,bytes);
+  if (slot == -1)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pdata::pin could not fit %ld bytes in the cache\n",bytes);
+    return NULL;
+  }
+  Pcache_entry& entry = m_cache[slot];
+  if (read && m_list_info[list_id].m_tier == PDATA_TIER_MEMORY && !info.m_on_disk) {
+    memset(entry.m_data,0,bytes);
+  } else if (read && read_index(pfile,list_id,index,entry.m_data) != 0) {
+    cache_drop(entry);
+    return NULL;
+  }
+  entry.m_pins = 1;
+  return (void*) entry.m_data;
+}
+
+//----------------------------------------------------------------------------
+// Pdata::prefetch
+//	hints, so a full cache is not an error
+//----------------------------------------------------------------------------
+int Pdata::prefetch(Pfile& pfile, const long list_id, const long* indexes, 
+                    const long num)
+{
+  if (list_id < 0 || list_id >= m_num_lists) {return 1;}
+  for (long i=0;i<num;i++)
+  {
+    const long index = indexes[i];
+    if (index < 0 || index >= m_list_size[list_id]) {continue;}
+    Pindex_info& info = m_index[list_id][index];
+    if (info.m_cache != -1) {m_cache[info.m_cache].m_ref = true; continue;}
+    if (m_list_info[list_id].m_tier == PDATA_TIER_MEMORY && !info.m_on_disk) {continue;}
+
+    const long bytes = (long) m_list_info[list_id].m_bytes*info.m_size;
+    if (bytes > m_cache_max) {continue;}
+    const long slot = cache_add(pfile,list_id,index,bytes);
+    if (slot == -1) {break;}
+    Pcache_entry& entry = m_cache[slot];
+    char* dest = entry.m_data;
+    long  num = bytes;
+    if (info.m_comp_bytes > 0)
+    {
+      entry.m_stage = (char*) malloc(sizeof(char)*info.m_comp_bytes);
+      if (entry.m_stage == NULL) {break;}
+      dest = entry.m_stage;
+      num = info.m_comp_bytes;
+    }
+    entry.m_ticket = pfile.aread(m_list_info[list_id].m_file_id,info.m_file_pos,
+                                 dest,(size_t) num);
+    if (entry.m_ticket < 0) {entry.m_ticket = 0;}
+  }
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// Pdata::cache_add
+//	evicts blocks until bytes fit, and puts an unpinned entry for the index
+//	in a free slot
+//----------------------------------------------------------------------------
+long Pdata::cache_add(Pfile& pfile, const long list_id, const long index, 
+                      const long bytes)
+{
+  while (m_cache_bytes + bytes > m_cache_max)
+  {
+    if (cache_evict(pfile) != 0) {return -1;}
+  }
+
+  char* data = (char*) malloc(sizeof(char)*bytes);
+  if (data == NULL)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pdata::cache_add could not malloc %ld bytes\n",bytes);
+    return -1;
+  }
+
+  //reuse a free entry if there is one
+  long slot = -1;
+  for (long i=0;i<(long) m_cache.size();i++) {if (m_cache[i].m_list_id == -1) {slot = i; break;}}
+  if (slot == -1) {slot = (long) m_cache.size(); m_cache.push_back(Pcache_entry());}
+
+  Pcache_entry& entry = m_cache[slot];
+  entry.m_list_id = list_id;
+  entry.m_index = index;
+  entry.m_data = data;
+  entry.m_bytes = bytes;
+  entry.m_pins = 0;
+  entry.m_ref = true;
+  entry.m_dirty = false;
+  entry.m_ticket = 0;
+  entry.m_stage = NULL;
+  m_index[list_id][index].m_cache = slot;
+  m_cache_bytes += bytes;
+  return slot;
+}
+
+//----------------------------------------------------------------------------
+// Pdata::cache_drop
+//	frees an entry without writing it back, e.g. one whose read failed
+//----------------------------------------------------------------------------
+void Pdata::cache_drop(Pcache_entry& entry)
+{
+  m_index[entry.m_list_id][entry.m_index].m_cache = -1;
+  free(entry.m_data);
+  m_cache_bytes -= entry.m_bytes;
+  entry.m_list_id = -1;
+  entry.m_index = -1;
+  entry.m_data = NULL;
+  entry.m_bytes = 0;
+}
+
+//----------------------------------------------------------------------------
+// Pdata::unpin
+//----------------------------------------------------------------------------
+int Pdata::unpin(Pfile& pfile, const long list_id, const long index, const bool dirty)
+{
+  if (list_id < 0 || list_id >= m_num_lists || index < 0 || index >= m_list_size[list_id]
+      || m_index[list_id][index].m_cache == -1)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pdata::unpin list %ld index %ld is not cached\n",list_id,index);
+    return 1;
+  }
+  Pcache_entry& entry = m_cache[m_index[list_id][index].m_cache];
+  if (entry.m_pins > 0) entry.m_pins--;
+  entry.m_dirty = entry.m_dirty || dirty;
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// Pdata::cache_write
+//----------------------------------------------------------------------------
+int Pdata::cache_write(Pfile& pfile, Pcache_entry& entry)
+{
+  if (entry.m_list_id == -1 || !entry.m_dirty) return 0;
+  write_index(pfile,entry.m_list_id,entry.m_index,entry.m_data);
+  entry.m_dirty = false;
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// Pdata::cache_evict
+//	CLOCK, the hand clears the referenced bits of the blocks it passes,
+//	and evicts the first unpinned block that was not referenced. Two
+//	turns are enough to find one, if there is one. Writing it back is a
+//	spill
+//----------------------------------------------------------------------------
+int Pdata::cache_evict(Pfile& pfile)
+{
+  const long num = (long) m_cache.size();
+  for (long step=0;step<2*num;step++)
+  {
+    Pcache_entry& entry = m_cache[m_cache_hand];
+    m_cache_hand = (m_cache_hand+1) % num;
+    if (entry.m_list_id == -1 || entry.m_pins > 0) continue;
+    if (entry.m_ref) {entry.m_ref = false; continue;}
+
+    cache_wait(pfile,entry);
+    if (entry.m_dirty) {m_spill_bytes += entry.m_bytes;}
+    cache_write(pfile,entry);
+    m_index[entry.m_list_id][entry.m_index].m_cache = -1;
+    free(entry.m_data);
+    m_cache_bytes -= entry.m_bytes;
+    entry.m_list_id = -1;
+    entry.m_index = -1;
+    entry.m_data = NULL;
+    entry.m_bytes = 0;
+    return 0;
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+// Pdata::flush_cache
+//	the dirty blocks of each list in one write_many
+//----------------------------------------------------------------------------
+int Pdata::flush_cache(Pfile& pfile)
+{
+  std::vector<std::vector<long>> dirty(m_num_lists);
+  for (size_t i=0;i<m_cache.size();i++)
+  {
+    const Pcache_entry& entry = m_cache[i];
+    if (entry.m_list_id != -1 && entry.m_dirty) dirty[entry.m_list_id].push_back((long) i);
+  }
+  int stat = 0;
+  std::vector<long> indexes;
+  std::vector<const void*> data;
+  for (long list=0;list<m_num_lists;list++)
+  {
+    if (dirty[list].empty()) continue;
+    indexes.clear();
+    data.clear();
+    for (size_t k=0;k<dirty[list].size();k++)
+    {
+      Pcache_entry& entry = m_cache[dirty[list][k]];
+      indexes.push_back(entry.m_index);
+      data.push_back(entry.m_data);
+      entry.m_dirty = false;
+    }
+    stat += write_many(pfile,list,indexes,data);
+  }
+  return stat;
+}
+
+//----------------------------------------------------------------------------
+// Pdata::clear_cache
+//----------------------------------------------------------------------------
+int Pdata::clear_cache(Pfile& pfile)
+{
+  for (size_t i=0;i<m_cache.size();i++) 
+  {
+    Pcache_entry& entry = m_cache[i];
+    if (entry.m_list_id == -1 || entry.m_pins > 0) continue;
+    cache_wait(pfile,entry);
+    cache_write(pfile,entry);
+    m_index[entry.m_list_id][entry.m_index].m_cache = -1;
+    free(entry.m_data);
+    m_cache_bytes -= entry.m_bytes;
+    entry.m_list_id = -1;
+    entry.m_index = -1;
+    entry.m_data = NULL;
+    entry.m_bytes = 0;
+  }
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// Pdata::cache_wait
+//	waits for the prefetch of an entry, and decompresses it if it was
+//	staged
+//----------------------------------------------------------------------------
+int Pdata::cache_wait(Pfile& pfile, Pcache_entry& entry)
+{
+  if (entry.m_ticket <= 0 && entry.m_stage == NULL) return 0;
+  if (entry.m_ticket > 0) {pfile.wait(entry.m_ticket); entry.m_ticket = 0;}
+  const Plist_info& list = m_list_info[entry.m_list_id];
+  const Pindex_info& info = m_index[entry.m_list_id][entry.m_index];
+  if (entry.m_stage == NULL)
+  {
+    return check_crc("Pdata::prefetch",entry.m_list_id,entry.m_index,
+                     entry.m_data,entry.m_bytes);
+  }
+  int stat = check_crc("Pdata::prefetch",entry.m_list_id,entry.m_index,
+                       entry.m_stage,info.m_comp_bytes);
+  if (stat == 0)
+  {
+    stat = pcodec_decompress(list.m_codec,entry.m_stage,info.m_comp_bytes,
+                             entry.m_data,entry.m_bytes);
+  }
+  free(entry.m_stage);
+  entry.m_stage = NULL;
+  return stat;
+}
+
+//----------------------------------------------------------------------------
+// Pdata::set_codec
+//----------------------------------------------------------------------------
+int Pdata::set_codec(const long list_id, const int codec, const double tol)
+{
+  if (list_id < 0 || list_id >= m_num_lists) {return 1;}
+  m_list_info[list_id].m_codec = codec;
+  m_list_info[list_id].m_tol = tol;
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// Pdata::write_index
+//	writes the compressed block if it is smaller, otherwise the block
+//----------------------------------------------------------------------------
+int Pdata::write_index(Pfile& pfile, const long list_id, const long index, 
+                       const void* data)
+{
+  if (list_id < 0 || list_id >= m_num_lists || index < 0 || index >= m_list_size[list_id])
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pdata::write_index list %ld index %ld does not exist\n",list_id,index);
+    return 1;
+  }
+  const Plist_info& list = m_list_info[list_id];
+  Pindex_info& info = m_index[list_id][index];
+  const long bytes = (long) list.m_bytes*info.m_size;
+
+  long cbytes = -1;
+  if (list.m_codec != PCODEC_NONE)
+  {
+    if ((long) m_codec_buf.size() < bytes) m_codec_buf.resize(bytes);
+    cbytes = pcodec_compress(list.m_codec,list.m_tol,(const char*) data,bytes,
+                             m_codec_buf.data(),m_codec_work);
+  }
+
+  if (cbytes > 0) {
+    pfile.write(list.m_file_id,info.m_file_pos,m_codec_buf.data(),sizeof(char),cbytes);
+    info.m_comp_bytes = cbytes;
+    info.m_crc = simd_par_crc32c(cbytes,m_codec_buf.data());
+  } else {
+    pfile.write(list.m_file_id,info.m_file_pos,data,sizeof(char),bytes);
+    info.m_comp_bytes = 0;
+    info.m_crc = simd_par_crc32c(bytes,data);
+  }
+  info.m_on_disk = true;
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// Pdata::read_index
+//----------------------------------------------------------------------------
+int Pdata::read_index(Pfile& pfile, const long list_id, const long index, void* data)
+{
+  if (list_id < 0 || list_id >= m_num_lists || index < 0 || index >= m_list_size[list_id])
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pdata::read_index list %ld index %ld does not exist\n",list_id,index);
+    return 1;
+  }
+  const Plist_info& list = m_list_info[list_id];
+  const Pindex_info& info = m_index[list_id][index];
+  const long bytes = (long) list.m_bytes*info.m_size;
+
+  if (info.m_comp_bytes > 0)
+  {
+    if ((long) m_codec_buf.size() < info.m_comp_bytes) m_codec_buf.resize(info.m_comp_bytes);
+    pfile.read(list.m_file_id,info.m_file_pos,m_codec_buf.data(),sizeof(char),
+               info.m_comp_bytes);
+    if (check_crc("Pdata::read_index",list_id,index,m_codec_buf.data(),info.m_comp_bytes) != 0) {return 1;}
+    return pcodec_decompress(list.m_codec,m_codec_buf.data(),info.m_comp_bytes,
+                             (char*) data,bytes);
+  }
+  pfile.read(list.m_file_id,info.m_file_pos,data,sizeof(char),bytes);
+  return check_crc("Pdata::read_index",list_id,index,data,bytes);
+}
+
+//----------------------------------------------------------------------------
+// Pdata::check_crc
+//	only for the lists with m_check, and the blocks this task wrote
+//----------------------------------------------------------------------------
+int Pdata::check_crc(const char* name, const long list_id, const long index, 
+                     const void* data, const long bytes) const
+{
+  const Pindex_info& info = m_index[list_id][index];
+  if (!m_list_info[list_id].m_check || !info.m_on_disk) return 0;
+  const uint32_t crc = simd_par_crc32c(bytes,data);
+  if (crc == info.m_crc) return 0;
+  printf("\nERROR ERROR ERROR\n");
+  printf("%s list %ld index %ld has CRC32C %08x in its file, not %08x\n",
+         name,list_id,index,crc,info.m_crc);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+// Pdata::set_check
+//----------------------------------------------------------------------------
+int Pdata::set_check(const long list_id, const bool check)
+{
+  if (list_id < 0 || list_id >= m_num_lists) {return 1;}
+  m_list_info[list_id].m_check = check;
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// Pdata::read_many
+//	the blocks stored as they are in one readv, then the compressed ones
+//----------------------------------------------------------------------------
+int Pdata::read_many(Pfile& pfile, const long list_id, const long* indexes, 
+                     const long num, void* const* data)
+{
+  if (list_id < 0 || list_id >= m_num_lists) 
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pdata::read_many list %ld does not exist\n",list_id);
+    return 1;
+  }
+  const Plist_info& list = m_list_info[list_id];
+  std::vector<Piovec> reqs;
+  reqs.reserve(num);
+  for (long k=0;k<num;k++)
+  {
+    const long index = indexes[k];
+    if (index < 0 || index >= m_list_size[list_id])
+    {
+      printf("\nERROR ERROR ERROR\n");
+      printf("Pdata::read_many list %ld index %ld does not exist\n",list_id,index);
+      return 1;
+    }
+    const Pindex_info& info = m_index[list_id][index];
+    if (info.m_comp_bytes > 0) continue;
+    reqs.push_back({info.m_file_pos,data[k],(size_t) list.m_bytes*info.m_size});
+  }
+  if (pfile.readv(list.m_file_id,reqs) != 0) {return 1;}
+
+  for (long k=0;k<num;k++)
+  {
+    const Pindex_info& info = m_index[list_id][indexes[k]];
+    if (info.m_comp_bytes > 0) continue;
+    if (check_crc("Pdata::read_many",list_id,indexes[k],data[k],
+                  (long) list.m_bytes*info.m_size) != 0) {return 1;}
+  }
+
+  for (long k=0;k<num;k++)
+  {
+    if (m_index[list_id][indexes[k]].m_comp_bytes == 0) continue;
+    if (read_index(pfile,list_id,indexes[k],data[k]) != 0) {return 1;}
+  }
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// Pdata::write_many
+//	one writev, unless the blocks are compressed
+//----------------------------------------------------------------------------
+int Pdata::write_many(Pfile& pfile, const long list_id, const long* indexes, 
+                      const long num, const void* const* data)
+{
+  if (list_id < 0 || list_id >= m_num_lists) 
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pdata::write_many list %ld does not exist\n",list_id);
+    return 1;
+  }
+  const Plist_info& list = m_list_info[list_id];
+  for (long k=0;k<num;k++)
+  {
+    if (indexes[k] < 0 || indexes[k] >= m_list_size[list_id])
+    {
+      printf("\nERROR ERROR ERROR\n");
+      printf("Pdata::write_many list %ld index %ld does not exist\n",list_id,indexes[k]);
+      return 1;
+    }
+  }
+  if (list.m_codec != PCODEC_NONE)
+  {
+    for (long k=0;k<num;k++)
+    {
+      if (write_index(pfile,list_id,indexes[k],data[k]) != 0) {return 1;}
+    }
+    return 0;
+  }
+
+  std::vector<Piovec> reqs;
+  reqs.reserve(num);
+  for (long k=0;k<num;k++)
+  {
+    Pindex_info& info = m_index[list_id][indexes[k]];
+    reqs.push_back({info.m_file_pos,(void*) data[k],(size_t) list.m_bytes*info.m_size});
+    info.m_comp_bytes = 0;
+    info.m_on_disk = true;
+    info.m_crc = simd_par_crc32c((long) list.m_bytes*info.m_size,data[k]);
+  }
+  return (pfile.writev(list.m_file_id,reqs) != 0) ? 1 : 0;
+}
+
+//----------------------------------------------------------------------------
+// Pdata::pack
+//	[num_lists] then, for each list, [tag][size][Plist_info][window kind]
+//	and its Pindex_info
+//----------------------------------------------------------------------------
+static void pdata_push(std::vector<char>& buf, const void* data, const size_t bytes)
+{
+  const char* ptr = (const char*) data;
+  buf.insert(buf.end(),ptr,ptr+bytes);
+}
+
+void Pdata::pack(std::vector<char>& buf) const
+{
+  pdata_push(buf,&m_num_lists,sizeof(long));
+  for (long list=0;list<m_num_lists;list++)
+  {
+    const int kind = window_kind(list);
+    pdata_push(buf,&m_list_tags[list],sizeof(long));
+    pdata_push(buf,&m_list_size[list],sizeof(long));
+    pdata_push(buf,&m_list_info[list],sizeof(Plist_info));
+    pdata_push(buf,&kind,sizeof(int));
+    pdata_push(buf,m_index[list].data(),sizeof(Pindex_info)*m_list_size[list]);
+  }
+}
+
+//----------------------------------------------------------------------------
+// Pdata::unpack
+//----------------------------------------------------------------------------
+int Pdata::unpack(const char* buf, const long bytes, std::vector<int>& windows)
+{
+  bool busy = (m_cache_bytes != 0);
+  for (long list=0;list<m_num_lists;list++) {busy = busy || m_win[list].m_active;}
+  if (busy)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pdata::unpack the cache is not empty, or a list has a window\n");
+    return 1;
+  }
+
+  long pos = 0;
+  long num = 0;
+  bool bad = (bytes < (long) sizeof(long));
+  if (!bad) {memcpy(&num,buf,sizeof(long)); pos += sizeof(long);}
+
+  m_list_tags.assign(num,0);
+  m_list_size.assign(num,0);
+  m_list_info.resize(num);
+  m_index.assign(num,std::vector<Pindex_info>());
+  m_win.assign(num,Pwin());
+  m_rcache.assign(num,Prcache());
+  windows.assign(num,0);
+  m_tag_hash.clear();
+  const long head = 2*sizeof(long) + sizeof(Plist_info) + sizeof(int);
+  for (long list=0;list<num && !bad;list++)
+  {
+    if (pos + head > bytes) {bad = true; break;}
+    memcpy(&m_list_tags[list],buf+pos,sizeof(long)); pos += sizeof(long);
+    memcpy(&m_list_size[list],buf+pos,sizeof(long)); pos += sizeof(long);
+    memcpy(&m_list_info[list],buf+pos,sizeof(Plist_info)); pos += sizeof(Plist_info);
+    memcpy(&windows[list],buf+pos,sizeof(int)); pos += sizeof(int);
+    const long ibytes = sizeof(Pindex_info)*m_list_size[list];
+    if (m_list_size[list] < 0 || pos + ibytes > bytes) {bad = true; break;}
+    m_index[list].resize(m_list_size[list]);
+    memcpy(m_index[list].data(),buf+pos,ibytes); pos += ibytes;
+    for (long index=0;index<m_list_size[list];index++) {m_index[list][index].m_cache = -1;}
+    m_tag_hash.insert(Phash::hash(m_list_tags[list]),list);
+    m_win[list].m_base = NULL;
+    m_win[list].m_bytes = 0;
+    m_win[list].m_active = false;
+    m_win[list].m_shared = false;
+  }
+  if (bad || pos != bytes)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pdata::unpack buffer of %ld bytes is not a packed Pdata\n",bytes);
+    m_num_lists = 0;
+    m_list_tags.clear(); m_list_size.clear(); m_list_info.clear();
+    m_index.clear(); m_win.clear(); m_tag_hash.clear(); windows.clear();
+    return 1;
+  }
+  m_num_lists = num;
+  return 0;
+}
@@ -1,6 +1,20 @@
 /*----------------------------------------------------------------------------
   pdata.hpp
 	JHT, Febuary 13, 2022 : created
+	JHT, October 14, 2026 : added the one-sided windows, get/put/accumulate
+	JHT, October 14, 2026 : added the node-shared windows
+	JHT, October 14, 2026 : added distribute
+	JHT, October 14, 2026 : find_list uses a Phash
+	JHT, October 14, 2026 : added the block cache
+	JHT, October 14, 2026 : added prefetch
+	JHT, October 14, 2026 : added the block compression
+	JHT, October 14, 2026 : added pack and unpack
+	JHT, October 14, 2026 : pin without the read
+	JHT, October 14, 2026 : get and put with an MPI datatype
+	JHT, October 14, 2026 : added the memory tier
+	JHT, October 14, 2026 : added the remote block cache
+	JHT, October 14, 2026 : added read_many and write_many
+	JHT, October 14, 2026 : added the block checksums
 
   .hpp file for pdata class, which manages lists of data
 
@@ -15,26 +29,237 @@
     responsible for which index. We assume that the list structure isn't going
     to be changing during compute heavy routines, so that the memory and synch
     overhead between threads isn't so much of an issue
+
+  Block cache
+  ---------------------
+  - pin returns a pointer to an index in memory, read from its file 
+    (m_file_pos of the list's file) only if it is not already cached. 
+    unpin releases it, and marks it dirty if it was changed. 
+  - the cache holds at most the bytes given to cache_init (per node, 
+    split over the tasks of the node). When it is full, unpinned blocks 
+    are evicted with the CLOCK algorithm, and dirty blocks are written 
+    back to their file first
+  - flush_cache writes back all dirty blocks, and clear_cache also frees 
+    all of the unpinned ones. Call clear_cache before the end, so that
+    no prefetch is still reading into the cache
+  - prefetch starts reading indexes that will be pinned soon into the 
+    cache with Pfile::aread, and returns. pin then only waits for the 
+    read, if it is not done yet. Prefetched blocks are not pinned, and 
+    prefetch stops (without an error) when the cache is full of pinned
+    and prefetched blocks
+  - pin with read false is for an index that is about to be overwritten,
+    so it is not read from the file if it is not cached (its elements are
+    then undefined). Unpin it as dirty
+  - like the Pfile "x" functions, these are for the task that does the IO
+
+    pdata.cache_init(pworld,8000000000);
+    pdata.prefetch(pfile,list_id,{index+1,index+2});
+    double* T2 = (double*) pdata.pin(pfile,list_id,index);
+    ...
+    pdata.unpin(pfile,list_id,index,true);
+    pdata.flush_cache(pfile);
+
+  Memory tier
+  ---------------------
+  - by default (PDATA_TIER_FILE) the file of a list is where its indexes
+    live, and the cache holds copies. set_tier(list_id,PDATA_TIER_MEMORY)
+    makes the cache their home instead, and the file only where they are
+    spilled : an index that was never written to the file is not read 
+    from it, and pin gives it zeroed, so nothing touches the disk while 
+    the list fits in the cache. When the cache is full, the coldest 
+    unpinned blocks (CLOCK) are written to the file (spilled), and read
+    back when next pinned
+  - so a run whose lists fit in the budget of cache_init is in-core, and
+    a larger one spills only what does not fit. The budget is per node 
+    (split over its tasks), or per task with per_task
+  - flush_cache and clear_cache still write every dirty block, as does 
+    Para::checkpoint, so call them only to keep the data on disk.
+    spill_bytes gives the bytes written by evictions, on_disk whether an
+    index is in its file
+
+    pdata.cache_init(pworld,32000000000);
+    pdata.set_tier(list_id,PDATA_TIER_MEMORY);
+    double* T2 = (double*) pdata.pin(pfile,list_id,index,false);
+    ...
+    pdata.unpin(pfile,list_id,index,true);
+
+  Block compression
+  ---------------------
+  - set_codec picks a PCODEC_* codec (see pcodec.hpp) for the blocks of a
+    list. write_index compresses a block and writes it at its m_file_pos,
+    and read_index reads and decompresses it. The cache uses these. 
+  - m_comp_bytes is the compressed bytes of a block on disk, or 0 if it is
+    stored as it is (never written, or it did not compress). Since a 
+    block never takes more than its own bytes, it always fits in place, 
+    and the rest of it is a hole in the file
+  - these are for the task that does the IO, which is the one that knows 
+    m_comp_bytes
+
+    pdata.set_codec(list_id,PCODEC_TRUNC,1.e-12);
+    pdata.write_index(pfile,list_id,index,T2);
+    pdata.read_index(pfile,list_id,index,T2);
+
+  Many blocks
+  ---------------------
+  - read_many and write_many do a list of indexes (each into, or from, 
+    its own buffer) with one Pfile::readv or writev, so the indexes that
+    are next to each other in the file are one large read, not a seek and
+    fread each. Compressed blocks are still read one by one (read_index),
+    and the lists with a codec are written with write_index
+  - flush_cache writes the dirty blocks of each list with write_many
+
+    std::vector<void*> bufs(num);
+    for (long k=0;k<num;k++) bufs[k] = tiles[k].data();
+    pdata.read_many(pfile,list_id,indexes,bufs);
+
+  Block checksums
+  ---------------------
+  - write_index, write_many, and the cache write backs keep the CRC32C 
+    (simd_crc32c, see simd.hpp) of each block as it is on disk (after 
+    the compression), in m_crc. It runs at about the speed of memory, 
+    so it is always on
+  - set_check(list_id,true) makes read_index, read_many, pin, and
+    prefetch check the blocks they read against it, and return an error
+    (pin, NULL) on a mismatch, for silent corruption of the files. The 
+    block is then not kept in the cache. Only the blocks written by this
+    task (on_disk) can be checked
+  - index_crc gives the CRC32C of a block, e.g. to tell which blocks 
+    changed since the last incremental checkpoint
+
+    pdata.set_check(list_id,true);
+    if (pdata.read_index(pfile,list_id,index,T2) != 0) error
+
+  Distribution
+  ---------------------
+  - distribute sets the m_storage_task of all indexes of a list, with the
+    longest-processing-time heuristic: the indexes are taken from the 
+    largest cost down, and each goes to the least loaded node, and then
+    to the least loaded task on that node
+  - the cost of an index is its bytes, unless a cost (e.g., flops) is 
+    given for each index
+  - distribute is collective over comm_world, and every task gets the 
+    same result
+
+    pdata.distribute(pworld,list_id);
+    pdata.distribute(pworld,list_id,flops);
+
+  Distributed data
+  ---------------------
+  - make_window allocates the indexes of a list on the tasks that store 
+    them (m_storage_task), as one MPI window per list, and sets m_mem_pos,
+    the offset of each index in the window memory of its task. 
+  - any task can then get, put, or accumulate a whole index, without a 
+    matching call on the owner. The windows are in a passive-target 
+    lock_all epoch from make_window to free_window, and each call is 
+    flushed, so it is complete (locally and at the owner) on return
+  - local gives a pointer to an index stored on this task, or NULL. Stores
+    through it must be followed by a barrier before other tasks get them
+  - make_window and free_window are collective over comm_world, and all
+    windows must be freed before Pworld::destroy
+
+    pdata.make_window(pworld,list_id);
+    pdata.get(list_id,index,buffer);
+    pdata.get(list_id,index,V.data(),Ptype_tensor(V));	//into a strided view
+    pdata.accumulate<double>(list_id,index,buffer);
+    pdata.free_window(pworld,list_id);
+
+  Node-shared data
+  ---------------------
+  - make_shared_window instead allocates *all* of the indexes of a list 
+    once per node, with MPI_Win_allocate_shared on comm_shared (it is all
+    on the shared root). This is for read-only data like integrals, where
+    each task would otherwise keep its own copy
+  - local gives a pointer to any index, which every task on the node can
+    load and store through directly, and get/put/accumulate are copies
+  - fill the indexes (e.g., each task those it stores), then sync_window,
+    which is a barrier on comm_shared, before reading them
+  - make_shared_window and free_window are collective over comm_shared
+
+    pdata.make_shared_window(pworld,list_id);
+    if (pworld.mpi_shared_ismaster) read_integrals(pdata.local(pworld,list_id,0));
+    pdata.sync_window(pworld,list_id);
+
+  Remote block cache
+  ---------------------
+  - make_remote_cache gives the window of a list (make_window) a cache
+    of the indexes fetched from other nodes, of bytes per node, in one
+    MPI_Win_allocate_shared on comm_shared. get of an index stored off
+    the node first looks in it, and a hit is a memcpy from the node's
+    memory. A miss is the MPI_Get, and the index is then stored in the
+    cache for the other tasks of the node (and for this one, later)
+  - the cache is direct mapped, a slot for each index % num slots, of
+    the bytes of the largest index. Each slot has a state word, updated
+    with MPI atomics: 0 empty, -1 being stored, or the key of the index
+    and the version of the list it was stored in. A reader copies the 
+    slot and checks that the state did not change while it did, so it
+    never waits for the tasks storing into the cache
+  - the indexes must not change while they are cached. Once they do 
+    (puts or accumulates, then a barrier), remote_cache_invalidate on 
+    every task of the node bumps the version of the list, and all of the
+    slots of the old version are misses from then on. Every task of the
+    node must call it before it gets again
+  - on node owners are not cached (their MPI_Get is already a copy 
+    through shared memory at most), nor is get with an MPI datatype
+  - make_remote_cache and free_remote_cache are collective over 
+    comm_shared, and free_window frees the cache of its list as well
+
+    pdata.make_window(pworld,list_id);
+    pdata.make_remote_cache(pworld,list_id,4000000000);
+    pdata.get(list_id,index,buffer);    //cached
+    ...puts, barrier...
+    pdata.remote_cache_invalidate(list_id);
+
+  Without MPI, the windows are plain memory.
+
+  Checkpointing
+  ---------------------
+  - pack appends the lists and index tables to a buffer, and unpack 
+    replaces them with those of a buffer, for Para::checkpoint/restart. 
+    unpack needs an empty cache and no windows, and gives the window of
+    each list when it was packed (0 none, 1 make_window, 2 shared), which
+    the caller makes again, since they are collective
+  - window_data and window_bytes give the window memory of this task
 ----------------------------------------------------------------------------*/
 #ifndef LIBJ_PDATA_HPP
 #define LIBJ_PDATA_HPP
 
 #include <vector>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
 #include "libjdef.h"
 
 #include "pworld.hpp"
 #include "pfile.hpp"
 #include "pprint.hpp"
+#include "phash.hpp"
+#include "pcodec.hpp"
+
+//where the indexes of a list live
+#define PDATA_TIER_FILE 0	//in the file, the cache holds copies
+#define PDATA_TIER_MEMORY 1	//in the cache, spilled to the file when full
+
+//state words of the remote cache, see rcache_get
+#define PDATA_RCACHE_BUSY -1L			//a store is in progress
+#define PDATA_RCACHE_INDEXES 0xFFFFFFFFL	//indexes that can be cached
+#define PDATA_RCACHE_VERSIONS 0x7FFFFFFFL	//versions before they wrap
 
 //----------------------------------------------------------------------------
 // Plist_info
 //	file_id is the Pfile internal id which holds the task
  //	bytes is the number of bytes of one element of an index of the list 
+//	codec is the PCODEC_* of the blocks, and tol the TRUNC tolerance
+//	tier is the PDATA_TIER_* of the list
+//	check is true if the blocks read are checked against their CRC32C
 //----------------------------------------------------------------------------
 struct Plist_info
 {
   int        m_file_id;
   std::size_t m_bytes;
+  int        m_codec;
+  double     m_tol;
+  int        m_tier;
+  bool       m_check;
 };
 
 //----------------------------------------------------------------------------
@@ -42,12 +267,99 @@ struct Plist_info
 //	m_storage_task	which task is in charge of storing this index
 //	m_file_pos	location of this index in the relevant file	
 //	m_size		number of elements
+//	m_mem_pos	location of this index in the window of its task
+//	m_cache		entry of this index in the block cache, or -1
+//	m_comp_bytes	compressed bytes on disk, 0 if not compressed
+//	m_on_disk	written to the file by this task
+//	m_crc		CRC32C of the block on disk, if m_on_disk
 //----------------------------------------------------------------------------
 struct Pindex_info
 {
-  int  m_storage_task;
-  long m_file_pos;
-  long m_size;
+  int      m_storage_task;
+  long     m_file_pos;
+  long     m_size;
+  long     m_mem_pos;
+  long     m_cache;
+  long     m_comp_bytes;
+  bool     m_on_disk;
+  uint32_t m_crc;
+};
+
+//----------------------------------------------------------------------------
+// Pcache_entry
+//	m_list_id, m_index	the cached index, or -1 if the entry is free
+//	m_data			the block
+//	m_bytes			bytes of the block
+//	m_pins			number of unreleased pins
+//	m_ref			referenced since the clock hand last passed
+//	m_dirty			changed since it was read
+//	m_ticket		Pfile ticket of a prefetch read, 0 once done
+//	m_stage			compressed block of a prefetch read, or NULL
+//----------------------------------------------------------------------------
+struct Pcache_entry
+{
+  long  m_list_id;
+  long  m_index;
+  char* m_data;
+  long  m_bytes;
+  int   m_pins;
+  bool  m_ref;
+  bool  m_dirty;
+  long  m_ticket;
+  char* m_stage;
+};
+
+//----------------------------------------------------------------------------
+// Pwin
+//	m_win		MPI window of a list
+//	m_type		MPI type of one element of the list
+//	m_base		memory of the window on this task
+//	m_bytes		bytes of the window on this task
+//	m_active	window has been made
+//	m_shared	window is one copy per node, on comm_shared
+//----------------------------------------------------------------------------
+struct Pwin
+{
+  #if defined LIBJ_MPI
+    MPI_Win      m_win;
+    MPI_Datatype m_type;
+  #endif
+  char* m_base;
+  long  m_bytes;
+  bool  m_active;
+  bool  m_shared;
+};
+
+//----------------------------------------------------------------------------
+// Prcache
+//	m_win		node-shared window of the cache of a list
+//	m_state		state word of each slot, in the window
+//	m_data		first slot, in the window
+//	m_nslot		number of slots
+//	m_slot_bytes	bytes of a slot (the largest index, padded)
+//	m_version	version of the list, part of the key of a slot
+//	m_node		node of each world task
+//	m_task		world id of this task
+//	m_root		rank of the shared root on comm_shared, which holds it
+//	m_active	the cache has been made
+//	m_hits/m_misses	gets of this task served by the cache, or not
+//----------------------------------------------------------------------------
+struct Prcache
+{
+  #if defined LIBJ_MPI
+    MPI_Win      m_win;
+  #endif
+  long*        m_state;
+  char*        m_data;
+  long         m_nslot;
+  long         m_slot_bytes;
+  long         m_version;
+  std::vector<int> m_node;
+  int          m_task;
+  int          m_root;
+  bool         m_active;
+  mutable long m_hits;
+  mutable long m_misses;
 };
 
 //----------------------------------------------------------------------------
@@ -62,14 +374,58 @@ class Pdata
   private:
   long                    m_num_lists;
   std::vector<long>       m_list_tags;
+  Phash                   m_tag_hash;   //list_tag -> list_id
   std::vector<long>       m_list_size; 
   std::vector<Plist_info> m_list_info;
 
   std::vector<std::vector<Pindex_info>> m_index;
+  std::vector<Pwin>       m_win;
+  std::vector<Prcache>    m_rcache;
+
+  //block cache
+  std::vector<Pcache_entry> m_cache;
+  long                    m_cache_max;   //bytes allowed in the cache
+  long                    m_cache_bytes; //bytes in the cache
+  long                    m_cache_hand;  //clock hand
+  long                    m_spill_bytes; //bytes evicted to the files
+
+  //compression buffers
+  std::vector<char>       m_codec_work;
+  std::vector<char>       m_codec_buf;
+
+  //finish a prefetch of an entry
+  int cache_wait(Pfile& pfile, Pcache_entry& entry);
+
+  //evict one unpinned block, returns 1 if there is none
+  int cache_evict(Pfile& pfile);
+
+  //make room for bytes and add an entry for an index, returns it or -1 
+  long cache_add(Pfile& pfile, const long list_id, const long index, 
+                 const long bytes);
+
+  //write back an entry if it is dirty
+  int cache_write(Pfile& pfile, Pcache_entry& entry);
+
+  //free an entry without writing it back
+  void cache_drop(Pcache_entry& entry);
+
+  //checks the bytes of a block read from its file against its CRC32C
+  int check_crc(const char* name, const long list_id, const long index, 
+                const void* data, const long bytes) const;
+
+  //copy an index out of the remote cache, returns 1 on a miss
+  int rcache_get(const long list_id, const long index, void* buffer) const;
+
+  //store a fetched index in the remote cache
+  void rcache_store(const long list_id, const long index, const void* buffer) const;
+
+  //checks that list_id has a window
+  int check_window(const char* name, const long list_id, const long index) const;
 
   public:
 
   Pdata();
+  ~Pdata();
   
   //adds a new list, returns the list_id
   long add_list(const long list_tag, const int file_id, const std::size_t bytes);
@@ -88,6 +444,189 @@ class Pdata
                  const long file_pos, const long index_size);
 
   long list_bytes(const long list_id) const;
+
+  //number of lists
+  long num_lists() const {return m_num_lists;}
+
+  //number of indexes of a list
+  long num_index(const long list_id) const {return m_list_size[list_id];}
+
+  //number of elements of an index
+  long index_size(const long list_id, const long index) const 
+    {return m_index[list_id][index].m_size;}
+
+  //task that stores an index
+  int index_task(const long list_id, const long index) const 
+    {return m_index[list_id][index].m_storage_task;}
+
+  //bytes of one element of a list
+  long elem_bytes(const long list_id) const {return (long) m_list_info[list_id].m_bytes;}
+
+  //offset of an index in the window of its task, after make_window
+  long index_mem_pos(const long list_id, const long index) const
+    {return m_index[list_id][index].m_mem_pos;}
+
+  //set m_storage_task of the indexes of a list, collective
+  int distribute(const Pworld& pworld, const long list_id, 
+                 const double* cost = NULL);
+
+  //allocate the window of a list, collective
+  int make_window(const Pworld& pworld, const long list_id);
+
+  //allocate the window of a list once per node, collective on comm_shared
+  int make_shared_window(const Pworld& pworld, const long list_id);
+
+  //finish the stores into a node-shared window, collective on comm_shared
+  int sync_window(const Pworld& pworld, const long list_id) const;
+
+  //free the window of a list, collective
+  int free_window(const Pworld& pworld, const long list_id);
+
+  //add a node-shared cache of the remote indexes of a window, collective on 
+  //  comm_shared
+  int make_remote_cache(const Pworld& pworld, const long list_id, const long bytes);
+
+  //free the remote cache of a list, collective on comm_shared
+  int free_remote_cache(const Pworld& pworld, const long list_id);
+
+  //the cached indexes of a list are out of date
+  int remote_cache_invalidate(const long list_id);
+
+  //gets of this task served by the remote cache of a list, and not
+  long remote_cache_hits(const long list_id) const {return m_rcache[list_id].m_hits;}
+  long remote_cache_misses(const long list_id) const {return m_rcache[list_id].m_misses;}
+
+  //copy an index from its task into buffer
+  int get(const long list_id, const long index, void* buffer) const;
+
+  //copy buffer into an index on its task
+  int put(const long list_id, const long index, const void* buffer) const;
+
+  #if defined LIBJ_MPI
+  //as get and put, but buffer is one element of TYPE, e.g. a strided 
+  //  tensor view with Ptype_tensor(V) (see ptype.hpp), with no packing
+  int get(const long list_id, const long index, void* buffer, const MPI_Datatype type) const;
+  int put(const long list_id, const long index, const void* buffer, const MPI_Datatype type) const;
+  #endif
+
+  //add buffer to an index on its task, T is the element type
+  template <typename T>
+  int accumulate(const long list_id, const long index, const T* buffer) const;
+
+  //pointer to an index stored on this task, or NULL
+  void* local(const Pworld& pworld, const long list_id, const long index) const;
+
+  //append the lists and indexes to buf
+  void pack(std::vector<char>& buf) const;
+
+  //replace the lists and indexes with those of buf
+  int unpack(const char* buf, const long bytes, std::vector<int>& windows);
+
+  //window of a list : 0 none, 1 make_window, 2 make_shared_window
+  int window_kind(const long list_id) const 
+    {return !m_win[list_id].m_active ? 0 : (m_win[list_id].m_shared ? 2 : 1);}
+  char* window_data(const long list_id) const {return m_win[list_id].m_base;}
+  long window_bytes(const long list_id) const {return m_win[list_id].m_bytes;}
+
+  //set the codec of a list
+  int set_codec(const long list_id, const int codec, const double tol = 0.0);
+
+  //compress and write an index
+  int write_index(Pfile& pfile, const long list_id, const long index, 
+                  const void* data);
+
+  //read and decompress an index
+  int read_index(Pfile& pfile, const long list_id, const long index, void* data);
+
+  //check the blocks read of a list against their CRC32C
+  int set_check(const long list_id, const bool check);
+
+  //CRC32C of an index on disk, 0 if it was not written by this task
+  uint32_t index_crc(const long list_id, const long index) const
+    {return m_index[list_id][index].m_on_disk ? m_index[list_id][index].m_crc : 0;}
+
+  //read num indexes into data[k], adjacent blocks in one read
+  int read_many(Pfile& pfile, const long list_id, const long* indexes, 
+                const long num, void* const* data);
+  int read_many(Pfile& pfile, const long list_id, const std::vector<long>& indexes,
+                const std::vector<void*>& data)
+    {return read_many(pfile,list_id,indexes.data(),(long) indexes.size(),data.data());}
+
+  //write num indexes from data[k], adjacent blocks in one write
+  int write_many(Pfile& pfile, const long list_id, const long* indexes, 
+                 const long num, const void* const* data);
+  int write_many(Pfile& pfile, const long list_id, const std::vector<long>& indexes,
+                 const std::vector<const void*>& data)
+    {return write_many(pfile,list_id,indexes.data(),(long) indexes.size(),data.data());}
+
+  //set the bytes of the block cache, per node (or per task)
+  int cache_init(const Pworld& pworld, const long bytes, const bool per_task = false);
+
+  //set the PDATA_TIER_* of a list
+  int set_tier(const long list_id, const int tier);
+
+  //index has been written to its file
+  bool on_disk(const long list_id, const long index) const
+    {return m_index[list_id][index].m_on_disk;}
+
+  //bytes written to the files by evictions
+  long spill_bytes() const {return m_spill_bytes;}
+
+  //pointer to an index in the cache, reads it if needed (and read)
+  void* pin(Pfile& pfile, const long list_id, const long index, 
+            const bool read = true);
+
+  //start reading indexes into the cache
+  int prefetch(Pfile& pfile, const long list_id, const long* indexes, 
+               const long num);
+  int prefetch(Pfile& pfile, const long list_id, const std::vector<long>& indexes)
+    {return prefetch(pfile,list_id,indexes.data(),(long) indexes.size());}
+
+  //release a pinned index, dirty if it was changed
+  int unpin(Pfile& pfile, const long list_id, const long index, 
+            const bool dirty = false);
+
+  //write back all dirty blocks
+  int flush_cache(Pfile& pfile);
+
+  //write back and free all unpinned blocks
+  int clear_cache(Pfile& pfile);
 };
 
+//----------------------------------------------------------------------------
+// accumulate
+//	the elements of the list must be T
+//----------------------------------------------------------------------------
+template <typename T>
+int Pdata::accumulate(const long list_id, const long index, const T* buffer) const
+{
+  if (check_window("Pdata::accumulate",list_id,index) != 0) {return 1;}
+  if (m_list_info[list_id].m_bytes % sizeof(T) != 0) 
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pdata::accumulate elements of list %ld are not of this type\n",list_id);
+    return 1;
+  }
+  const Pindex_info& info = m_index[list_id][index];
+  const long num = info.m_size*(m_list_info[list_id].m_bytes/sizeof(T));
+
+  #if defined LIBJ_MPI
+  const Pwin& win = m_win[list_id];
+  if (win.m_shared)
+  {
+    T* data = (T*) (win.m_base + info.m_mem_pos);
+    for (long i=0;i<num;i++) {data[i] += buffer[i];}
+    return 0;
+  }
+  MPI_Accumulate(buffer,(int) num,Pmpi_type<T>::get(),
+                 info.m_storage_task,(MPI_Aint) info.m_mem_pos,
+                 (int) num,Pmpi_type<T>::get(),MPI_SUM,win.m_win);
+  MPI_Win_flush(info.m_storage_task,win.m_win);
+  #else
+  T* data = (T*) (m_win[list_id].m_base + info.m_mem_pos);
+  for (long i=0;i<num;i++) {data[i] += buffer[i];}
+  #endif
+  return 0;
+}
+
 #endif
@@ -0,0 +1,401 @@
+/*----------------------------------------------------------------------------
+  pdist.cpp
+	JHT, October 14, 2026 : created
+	JHT, October 14, 2026 : node tiled grids
+
+  .cpp file for Pgrid and libj::dist_tensor, see pdist.hpp
+----------------------------------------------------------------------------*/
+#include "pdist.hpp"
+#include "pcoll.hpp"
+#include "linal_ABpC.hpp"
+#include <limits.h>
+#include <stdlib.h>
+#include <algorithm>
+
+//----------------------------------------------------------------------------
+// pgrid_tile
+//	the grid position of this task with one tile per node, false if 
+//	the nodes differ in size or no tile fits
+//----------------------------------------------------------------------------
+static bool pgrid_tile(const Pworld& world, const int nprow, const int npcol,
+                       int& myrow, int& mycol)
+{
+  #if defined LIBJ_MPI
+  const int n = world.mpi_shared_num_tasks;
+  int range[2] = {-n,n};
+  MPI_Allreduce(MPI_IN_PLACE,range,2,MPI_INT,MPI_MIN,world.comm_world);
+  if (-range[0] != range[1]) return false;
+
+  int tr = 0, tc = 0;
+  for (int r=1;r<=n;r++)
+  {
+    if (n % r != 0 || nprow % r != 0 || npcol % (n/r) != 0) continue;
+    if (tr == 0 || abs(r - n/r) < abs(tr - tc)) {tr = r; tc = n/r;}
+  }
+  if (tr == 0) return false;
+
+  //this task's place in its node, by (socket, NUMA, id)
+  std::vector<int> mates;
+  for (int task=0;task<world.mpi_world_num_tasks;task++)
+  {
+    if (world.mpi_task_node[task] == world.mpi_node) mates.push_back(task);
+  }
+  std::stable_sort(mates.begin(),mates.end(),[&](const int a, const int b)
+  {
+    if (world.mpi_task_socket[a] != world.mpi_task_socket[b])
+      return world.mpi_task_socket[a] < world.mpi_task_socket[b];
+    return world.mpi_task_numa[a] < world.mpi_task_numa[b];
+  });
+  const int q = (int) (std::find(mates.begin(),mates.end(),world.mpi_world_task_id) - mates.begin());
+
+  const int tiles_per_row = npcol/tc;
+  myrow = (world.mpi_node / tiles_per_row)*tr + q / tc;
+  mycol = (world.mpi_node % tiles_per_row)*tc + q % tc;
+  return true;
+  #else
+  return false;
+  #endif
+}
+
+//----------------------------------------------------------------------------
+// Pgrid::init
+//----------------------------------------------------------------------------
+int Pgrid::init(const Pworld& world, const int rows, const int cols, const bool node_tiles)
+{
+  if (active) return 0;
+  pworld = &world;
+  nprow = 1; npcol = 1; myrow = 0; mycol = 0;
+
+  #if defined LIBJ_MPI
+  int dims[2] = {rows,cols};
+  if (rows <= 0 || cols <= 0)
+  {
+    if (rows > 0 && world.mpi_world_num_tasks % rows == 0) dims[1] = world.mpi_world_num_tasks/rows;
+    if (cols > 0 && world.mpi_world_num_tasks % cols == 0) dims[0] = world.mpi_world_num_tasks/cols;
+    if (dims[0] <= 0 || dims[1] <= 0) {dims[0] = 0; dims[1] = 0;}
+    MPI_Dims_create(world.mpi_world_num_tasks,2,dims);
+  }
+  if (dims[0]*dims[1] != world.mpi_world_num_tasks)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pgrid::init grid of %d x %d does not match the %d tasks\n",
+           dims[0],dims[1],world.mpi_world_num_tasks);
+    return 1;
+  }
+  nprow = dims[0];
+  npcol = dims[1];
+  if (!node_tiles || !pgrid_tile(world,nprow,npcol,myrow,mycol))
+  {
+    myrow = world.mpi_world_task_id / npcol;
+    mycol = world.mpi_world_task_id % npcol;
+  }
+  MPI_Comm_split(world.comm_world,myrow,mycol,&comm_row);
+  MPI_Comm_split(world.comm_world,mycol,myrow,&comm_col);
+
+  int mine = myrow*npcol + mycol;
+  grid_pos.assign(world.mpi_world_num_tasks,0);
+  MPI_Allgather(&mine,1,MPI_INT,grid_pos.data(),1,MPI_INT,world.comm_world);
+  #else
+  grid_pos.assign(1,0);
+  #endif
+  grid_task.assign(grid_pos.size(),0);
+  for (size_t t=0;t<grid_pos.size();t++) {grid_task[grid_pos[t]] = (int) t;}
+
+  active = true;
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// Pgrid::destroy
+//----------------------------------------------------------------------------
+int Pgrid::destroy()
+{
+  if (!active) return 0;
+  #if defined LIBJ_MPI
+  MPI_Comm_free(&comm_row);
+  MPI_Comm_free(&comm_col);
+  #endif
+  active = false;
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// Pgrid::numroc
+//	as the ScaLAPACK NUMROC, with the first block on grid row/col 0
+//----------------------------------------------------------------------------
+long Pgrid::numroc(const long n, const long nb, const int iproc, const int nprocs)
+{
+  const long nblocks = n/nb;
+  long num = (nblocks/nprocs)*nb;
+  const long extra = nblocks % nprocs;
+  if (iproc < extra) {
+    num += nb;
+  } else if (iproc == extra) {
+    num += n % nb;
+  }
+  return num;
+}
+
+namespace libj
+{
+
+//----------------------------------------------------------------------------
+// init
+//----------------------------------------------------------------------------
+template <typename T>
+int dist_tensor<T>::init(const Pgrid& grid, const std::vector<size_t>& dims,
+                         const size_t split, const long mb, const long nb)
+{
+  if (!grid.active || split > dims.size() || mb <= 0 || nb <= 0)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("dist_tensor::init needs an active grid, split <= dim, and blocks > 0\n");
+    return 1;
+  }
+  m_grid  = &grid;
+  m_dims  = dims;
+  m_split = split;
+  m_M = 1; m_N = 1;
+  for (size_t d=0;d<split;d++) m_M *= (long) dims[d];
+  for (size_t d=split;d<dims.size();d++) m_N *= (long) dims[d];
+  m_mb = mb;
+  m_nb = nb;
+  m_mloc = Pgrid::numroc(m_M,m_mb,grid.myrow,grid.nprow);
+  m_nloc = Pgrid::numroc(m_N,m_nb,grid.mycol,grid.npcol);
+  m_local.assign((size_t) (ld()*m_nloc),(T) 0);
+  return 0;
+}
+
+template <typename T>
+void dist_tensor<T>::zero()
+{
+  std::fill(m_local.begin(),m_local.end(),(T) 0);
+}
+
+template <typename T>
+void dist_tensor<T>::scale(const T a)
+{
+  if (a == (T) 0) {zero(); return;}
+  if (a == (T) 1) return;
+  for (size_t i=0;i<m_local.size();i++) m_local[i] *= a;
+}
+
+//----------------------------------------------------------------------------
+// fill
+//	G is the whole, sequential, tensor, on this task
+//----------------------------------------------------------------------------
+template <typename T>
+int dist_tensor<T>::fill(const libj::tensor<T>& G)
+{
+  if (!G.is_sequential() || (long) G.size() != m_M*m_N)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("dist_tensor::fill needs a sequential tensor of %ld elements\n",m_M*m_N);
+    return 1;
+  }
+  const T* g = G.data();
+  for (long lj=0;lj<m_nloc;lj++)
+  {
+    const long j = global_col(lj);
+    for (long li=0;li<m_mloc;li++) local(li,lj) = g[global_row(li) + m_M*j];
+  }
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// gather
+//	each task writes its blocks into a zeroed G, which is then summed
+//	over comm_world. For checks and small tensors, G is the whole tensor
+//----------------------------------------------------------------------------
+template <typename T>
+int dist_tensor<T>::gather(libj::tensor<T>& G) const
+{
+  if (!G.is_sequential() || (long) G.size() != m_M*m_N)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("dist_tensor::gather needs a sequential tensor of %ld elements\n",m_M*m_N);
+    return 1;
+  }
+  T* g = G.data();
+  std::fill(g,g+G.size(),(T) 0);
+  for (long lj=0;lj<m_nloc;lj++)
+  {
+    const long j = global_col(lj);
+    for (long li=0;li<m_mloc;li++) g[global_row(li) + m_M*j] = local(li,lj);
+  }
+  if (m_grid->nprow*m_grid->npcol > 1)
+  {
+    return Pcoll::allreduce(*m_grid->pworld,g,(long) G.size(),PCOLL_SUM);
+  }
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// dist_gemm
+//	SUMMA, with the broadcasts of the next panel started before the
+//	product of this one. The panel of A is a run of whole local cols, so
+//	its owners send it in place. That of B is a run of local rows, which
+//	its owners pack. A grid of one row (col) needs no broadcast of B (A)
+//----------------------------------------------------------------------------
+template <typename T>
+int dist_gemm(const T alpha, const dist_tensor<T>& A, const dist_tensor<T>& B,
+              const T beta, dist_tensor<T>& C)
+{
+  if (A.grid() == NULL || A.grid() != B.grid() || A.grid() != C.grid())
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("dist_gemm needs A, B, and C on the same grid\n");
+    return 1;
+  }
+  if (A.rows() != C.rows() || B.cols() != C.cols() || A.cols() != B.rows())
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("dist_gemm (%ld x %ld) . (%ld x %ld) does not fit C (%ld x %ld)\n",
+           A.rows(),A.cols(),B.rows(),B.cols(),C.rows(),C.cols());
+    return 1;
+  }
+  if (A.row_block() != C.row_block() || B.col_block() != C.col_block() ||
+      A.col_block() != B.row_block())
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("dist_gemm needs the blocks of A's cols as B's rows, and those of C as A's rows and B's cols\n");
+    return 1;
+  }
+
+  const Pgrid& grid = *C.grid();
+  const long K     = A.cols();
+  const long kb    = A.col_block();
+  const long mloc  = C.local_rows();
+  const long nloc  = C.local_cols();
+  const long nblk  = (K + kb - 1)/kb;
+  if (mloc*kb > (long) INT_MAX || kb*nloc > (long) INT_MAX)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("dist_gemm panels of %ld x %ld and %ld x %ld are more than INT_MAX, use smaller blocks\n",
+           mloc,kb,kb,nloc);
+    return 1;
+  }
+
+  //a task with no part of C still joins the broadcasts
+  C.scale(beta);
+  if (nblk == 0) return 0;
+
+  std::vector<T> Abuf[2], Bbuf[2];
+  T* Ap[2];
+  T* Bp[2];
+  long ldb[2];
+  #if defined LIBJ_MPI
+  MPI_Request reqA[2], reqB[2];
+  const MPI_Datatype type = Pmpi_type<T>::get();
+  #endif
+
+  //start the broadcasts of panel kk into slot s
+  auto post = [&](const long kk, const int s)
+  {
+    const long w = std::min(kb,K - kk*kb);
+    const int pc = (int) (kk % grid.npcol);
+    const int pr = (int) (kk % grid.nprow);
+
+    if (grid.mycol == pc) {
+      Ap[s] = const_cast<T*>(A.data()) + A.ld()*((kk/grid.npcol)*kb);
+    } else {
+      Abuf[s].resize((size_t) (mloc*kb));
+      Ap[s] = Abuf[s].data();
+    }
+
+    if (grid.nprow == 1) {
+      Bp[s]  = const_cast<T*>(B.data()) + (kk/grid.nprow)*kb;
+      ldb[s] = B.ld();
+    } else {
+      Bbuf[s].resize((size_t) (kb*nloc));
+      Bp[s]  = Bbuf[s].data();
+      ldb[s] = w;
+      if (grid.myrow == pr)
+      {
+        const T* b = B.data() + (kk/grid.nprow)*kb;
+        for (long j=0;j<nloc;j++)
+        {
+          std::copy(b + B.ld()*j,b + B.ld()*j + w,Bp[s] + w*j);
+        }
+      }
+    }
+
+    #if defined LIBJ_MPI
+    reqA[s] = MPI_REQUEST_NULL;
+    reqB[s] = MPI_REQUEST_NULL;
+    if (grid.npcol > 1) MPI_Ibcast(Ap[s],(int) (mloc*w),type,pc,grid.comm_row,&reqA[s]);
+    if (grid.nprow > 1) MPI_Ibcast(Bp[s],(int) (w*nloc),type,pr,grid.comm_col,&reqB[s]);
+    #endif
+  };
+
+  post(0,0);
+  for (long kk=0;kk<nblk;kk++)
+  {
+    const int s = (int) (kk % 2);
+    if (kk+1 < nblk) post(kk+1,1-s);
+    {
+      LIBJ_TRACE_SCOPE("dist_gemm wait","comm");
+      #if defined LIBJ_MPI
+      MPI_Wait(&reqA[s],MPI_STATUS_IGNORE);
+      MPI_Wait(&reqB[s],MPI_STATUS_IGNORE);
+      #endif
+    }
+    const long w = std::min(kb,K - kk*kb);
+    if (mloc > 0 && nloc > 0)
+    {
+      linal_ABpC<T>((int) mloc,(int) nloc,(int) w,alpha,Ap[s],(int) std::max(mloc,1L),
+                    Bp[s],(int) ldb[s],(T) 1,C.data(),(int) C.ld());
+    }
+  }
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// dist_contract
+//----------------------------------------------------------------------------
+template <typename T>
+int dist_contract(const T alpha, const dist_tensor<T>& A, const std::string& idxA,
+                  const dist_tensor<T>& B, const std::string& idxB,
+                  const T beta, dist_tensor<T>& C, const std::string& idxC)
+{
+  if (idxA.size() != A.dim() || idxB.size() != B.dim() || idxC.size() != C.dim())
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("dist_contract labels %s, %s, %s do not match the dimensions\n",
+           idxA.c_str(),idxB.c_str(),idxC.c_str());
+    return 1;
+  }
+  const std::string arow = idxA.substr(0,A.split()), acol = idxA.substr(A.split());
+  const std::string brow = idxB.substr(0,B.split()), bcol = idxB.substr(B.split());
+  const std::string crow = idxC.substr(0,C.split()), ccol = idxC.substr(C.split());
+  if (arow != crow || acol != brow || bcol != ccol)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("dist_contract %s.%s -> %s is not a gemm of the distributed matrices, ",
+           idxA.c_str(),idxB.c_str(),idxC.c_str());
+    printf("the rows of A must be those of C, its cols the rows of B, and the cols of B those of C\n");
+    return 1;
+  }
+  return dist_gemm(alpha,A,B,beta,C);
+}
+
+template class dist_tensor<double>;
+template class dist_tensor<float>;
+
+template int dist_gemm<double>(const double alpha, const dist_tensor<double>& A,
+                               const dist_tensor<double>& B, const double beta,
+                               dist_tensor<double>& C);
+template int dist_gemm<float>(const float alpha, const dist_tensor<float>& A,
+                              const dist_tensor<float>& B, const float beta,
+                              dist_tensor<float>& C);
+
+template int dist_contract<double>(const double alpha, const dist_tensor<double>& A,
+                                   const std::string& idxA, const dist_tensor<double>& B,
+                                   const std::string& idxB, const double beta,
+                                   dist_tensor<double>& C, const std::string& idxC);
+template int dist_contract<float>(const float alpha, const dist_tensor<float>& A,
+                                  const std::string& idxA, const dist_tensor<float>& B,
+                                  const std::string& idxB, const float beta,
+                                  dist_tensor<float>& C, const std::string& idxC);
+
+}//end of namespace
@@ -0,0 +1,183 @@
+/*----------------------------------------------------------------------------
+  pdist.hpp
+	JHT, October 14, 2026 : created
+	JHT, October 14, 2026 : node tiled grids
+
+  .hpp file for Pgrid, a 2D process grid over comm_world, and
+  libj::dist_tensor, a dense tensor distributed over it in the 2D block
+  cyclic layout of ScaLAPACK. Pdata gives whole indexes to tasks; this is
+  for the single large matrices and contractions that do not fit (or are
+  too slow) on one node.
+
+  The tensor is seen as a column major matrix of dimensions [0,split) by
+  [split,dim()), as tensor::as_matrix. Its rows are cut into blocks of mb,
+  and its cols into blocks of nb, and block (I,J) is on the task at grid
+  position (I % nprow, J % npcol). Each task keeps its blocks as one
+  column major local matrix of local_rows() x local_cols(), with ld().
+
+  Grid position (r,c) is world task r*npcol + c, or with node_tiles the
+  grid is cut into tiles of tr x tc positions, one tile per node (with
+  tr*tc the tasks of a node, tr dividing nprow and tc npcol, as square as
+  possible), so that most of a SUMMA broadcast stays in the node. Within
+  a tile, the tasks of a node fill the rows in socket order. Without such
+  a tile (nodes of different sizes), it is the plain order. task(r,c)
+  and the grid_task / grid_pos maps give the world task of a position,
+  and the reverse. comm_row holds the tasks of one grid row (ranked by
+  c), comm_col those of one grid col (ranked by r).
+
+//Usage
+Pgrid grid;
+grid.init(pworld);			//nprow x npcol from MPI_Dims_create
+grid.init(pworld,4,8);			//or given, 4*8 must be the world size
+grid.init(pworld,0,0,true);		//one tile of the grid per node
+
+libj::dist_tensor<double> T;
+T.init(grid,{no,no,nv,nv},2,64,64);	//(ij) x (ab), 64 x 64 blocks
+T.fill(G);				//from G, the whole tensor, on every task
+T.gather(G);				//to G on every task, collective
+
+libj::dist_gemm(1.0,A,B,0.0,C);		//C = alpha*A.B + beta*C, collective
+libj::dist_contract(1.0,A,"ijcd",B,"cdab",0.0,C,"ijab");
+
+grid.destroy();
+
+//Distributed gemm
+  dist_gemm is SUMMA (van de Geijn and Watts, 1997). For each block col k
+  of A (and block row k of B), the tasks of the grid col that own it
+  broadcast their panel of A along comm_row, the tasks of the grid row
+  that own that of B broadcast theirs along comm_col, and each task adds
+  the product of the two panels to its part of C with linal_ABpC. The
+  broadcasts of panel k+1 are started before the product of panel k, so
+  the communication overlaps the compute. Each task holds two panels of A
+  and of B, not the whole of either. A, B, and C must be on the same grid,
+  with the blocks of A's cols those of B's rows, A's rows those of C's,
+  and B's cols those of C's.
+
+  dist_contract is dist_gemm of the tensors as matrices, so the labels must
+  be in the order of a gemm: the row labels (before split) of A those of C,
+  the col labels of A the row labels of B, and the col labels of B those of
+  C. Other orders would need the tensors redistributed first, and are an
+  error.
+
+  These return 0, or 1 after printing the error. Without MPI, the grid is
+  1 x 1, and these are the local kernels.
+----------------------------------------------------------------------------*/
+#ifndef LIBJ_PDIST_HPP
+#define LIBJ_PDIST_HPP
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "libjdef.h"
+#include "pworld.hpp"
+#include "tensor.hpp"
+
+#if defined LIBJ_MPI
+  #include <mpi.h>
+#endif
+
+struct Pgrid
+{
+  const Pworld* pworld;		//world of the grid
+  int nprow;			//grid rows
+  int npcol;			//grid cols
+  int myrow;			//grid row of this task
+  int mycol;			//grid col of this task
+  bool active;			//init has been called
+  std::vector<int> grid_task;	//world task of each position, r*npcol + c
+  std::vector<int> grid_pos;	//position of each world task
+
+  #if defined LIBJ_MPI
+    MPI_Comm comm_row;		//tasks of this grid row
+    MPI_Comm comm_col;		//tasks of this grid col
+  #endif
+
+  Pgrid() {pworld = NULL; nprow = npcol = 1; myrow = mycol = 0; active = false;}
+
+  //make the grid, collective
+  int init(const Pworld& world, const int rows = 0, const int cols = 0,
+           const bool node_tiles = false);
+
+  //world task of grid position (r,c)
+  int task(const int r, const int c) const {return grid_task[r*npcol + c];}
+
+  //free the communicators, collective
+  int destroy();
+
+  //elements of n in blocks of nb held by grid row/col iproc of nprocs
+  static long numroc(const long n, const long nb, const int iproc, const int nprocs);
+};
+
+namespace libj
+{
+
+template <typename T>
+class dist_tensor
+{
+  private:
+  const Pgrid*        m_grid;
+  std::vector<size_t> m_dims;	//global lengths
+  size_t              m_split;	//dimensions of the rows
+  long                m_M, m_N;	//global rows and cols
+  long                m_mb, m_nb;	//block rows and cols
+  long                m_mloc, m_nloc;	//local rows and cols
+  std::vector<T>      m_local;	//local matrix, column major
+
+  public:
+  dist_tensor() : m_grid(NULL), m_split(0), m_M(0), m_N(0), m_mb(1), m_nb(1),
+                  m_mloc(0), m_nloc(0) {}
+
+  //allocate this task's blocks, zeroed
+  int init(const Pgrid& grid, const std::vector<size_t>& dims, const size_t split,
+           const long mb, const long nb);
+
+  const Pgrid* grid() const {return m_grid;}
+  const std::vector<size_t>& dims() const {return m_dims;}
+  size_t dim() const {return m_dims.size();}
+  size_t split() const {return m_split;}
+  long rows() const {return m_M;}
+  long cols() const {return m_N;}
+  long row_block() const {return m_mb;}
+  long col_block() const {return m_nb;}
+  long local_rows() const {return m_mloc;}
+  long local_cols() const {return m_nloc;}
+  long ld() const {return (m_mloc > 0) ? m_mloc : 1;}
+  T* data() {return m_local.data();}
+  const T* data() const {return m_local.data();}
+  T& local(const long li, const long lj) {return m_local[li + ld()*lj];}
+  const T& local(const long li, const long lj) const {return m_local[li + ld()*lj];}
+
+  //global row (col) of local row li (col lj)
+  long global_row(const long li) const
+  {
+    return ((li/m_mb)*m_grid->nprow + m_grid->myrow)*m_mb + li % m_mb;
+  }
+  long global_col(const long lj) const
+  {
+    return ((lj/m_nb)*m_grid->npcol + m_grid->mycol)*m_nb + lj % m_nb;
+  }
+
+  //grid row (col) that holds global row i (col j)
+  int owner_row(const long i) const {return (int) ((i/m_mb) % m_grid->nprow);}
+  int owner_col(const long j) const {return (int) ((j/m_nb) % m_grid->npcol);}
+
+  void zero();
+  void scale(const T a);
+
+  //copy this task's blocks from, or all blocks to, the whole tensor G
+  int fill(const libj::tensor<T>& G);
+  int gather(libj::tensor<T>& G) const;
+};
+
+template <typename T>
+int dist_gemm(const T alpha, const dist_tensor<T>& A, const dist_tensor<T>& B,
+              const T beta, dist_tensor<T>& C);
+
+template <typename T>
+int dist_contract(const T alpha, const dist_tensor<T>& A, const std::string& idxA,
+                  const dist_tensor<T>& B, const std::string& idxB,
+                  const T beta, dist_tensor<T>& C, const std::string& idxC);
+
+}//end of namespace
+
+#endif
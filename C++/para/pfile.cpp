@@ -1,10 +1,109 @@
 /*------------------------------------------------------------------------
  * pfile.cpp
  *  JHT, Febuary 8, 2022 : created
+ *  JHT, October 14, 2026 : added the asynchronous io thread
+ *  JHT, October 14, 2026 : added the positional io
+ *  JHT, October 14, 2026 : added the collective shared files
+ *  JHT, October 14, 2026 : file_loc uses the hashed Strvec::find_index
+ *  JHT, October 14, 2026 : added the scratch devices and striping
+ *  JHT, October 14, 2026 : io calls are traced
+ *  JHT, October 14, 2026 : added readv and writev
+ *  JHT, October 14, 2026 : the names of a team's files have the team
  *
  *  .hpp file for Pfile, which handles a (possibly parallel) filesystem
 ------------------------------------------------------------------------*/
 #include "pfile.hpp"
+#include "trace.hpp"
+#include <unistd.h>
+#include <sys/uio.h>
+#include <errno.h>
+#include <limits.h>
+#include <algorithm>
+
+//-----------------------------------------------------------------------
+// stripe_piece -- device, device file position, and bytes to the 
+//   end of the stripe of logical position pos
+//-----------------------------------------------------------------------
+static void stripe_piece(const int ndev, const long stripe, const long pos,
+                         int& dev, long& dpos, long& len)
+{
+  const long blk = pos/stripe;
+  const long off = pos - blk*stripe;
+  dev  = (int) (blk % ndev);
+  dpos = (blk/ndev)*stripe + off;
+  len  = stripe - off;
+}
+
+//-----------------------------------------------------------------------
+// stripe_io -- buffered io of a striped file, returns the bytes done
+//-----------------------------------------------------------------------
+static size_t stripe_io(const Pfio* sfio, const int ndev, const long stripe,
+                        const long pos, char* buf, const size_t bytes, 
+                        const bool isread)
+{
+  size_t done = 0;
+  while (done < bytes)
+  {
+    int dev; long dpos, len;
+    stripe_piece(ndev,stripe,pos+(long) done,dev,dpos,len);
+    const size_t num = std::min((size_t) len,bytes-done);
+    FILE* fptr = sfio[dev].fptr;
+    if (fseek(fptr,dpos,SEEK_SET) != 0) break;
+    const size_t got = isread ? fread(buf+done,1,num,fptr) : fwrite(buf+done,1,num,fptr);
+    done += got;
+    if (got != num) break;
+  }
+  return done;
+}
+
+//-----------------------------------------------------------------------
+// stripe_pio -- positional io of a striped file, returns 0 or 
+//   PFILE_ERR_PIO
+//-----------------------------------------------------------------------
+static int stripe_pio(const Pfio* sfio, const int ndev, const long stripe,
+                      const long pos, char* buf, const size_t bytes, 
+                      const bool isread)
+{
+  size_t done = 0;
+  while (done < bytes)
+  {
+    int dev; long dpos, len;
+    stripe_piece(ndev,stripe,pos+(long) done,dev,dpos,len);
+    const size_t want = std::min((size_t) len,bytes-done);
+    const ssize_t num = isread ? ::pread(sfio[dev].fd,buf+done,want,(off_t) dpos)
+                               : ::pwrite(sfio[dev].fd,buf+done,want,(off_t) dpos);
+    if (num < 0 && errno == EINTR) continue;
+    if (num <= 0) return PFILE_ERR_PIO;
+    done += (size_t) num;
+  }
+  return 0;
+}
+
+//-----------------------------------------------------------------------
+// vector_pio -- preadv/pwritev of num pieces at pos, until all of them 
+//   are done (the pieces are moved along by a short call), returns 0 or
+//   PFILE_ERR_PIO
+//-----------------------------------------------------------------------
+static int vector_pio(const int fd, struct iovec* iov, int num, long pos,
+                      const bool isread)
+{
+  while (num > 0)
+  {
+    const ssize_t got = isread ? ::preadv(fd,iov,num,(off_t) pos)
+                               : ::pwritev(fd,iov,num,(off_t) pos);
+    if (got < 0 && errno == EINTR) continue;
+    if (got <= 0) return PFILE_ERR_PIO; //error or end of file
+    pos += (long) got;
+    size_t left = (size_t) got;
+    while (num > 0 && left >= iov[0].iov_len) {left -= iov[0].iov_len; iov++; num--;}
+    if (num > 0)
+    {
+      iov[0].iov_base = (char*) iov[0].iov_base + left;
+      iov[0].iov_len -= left;
+    }
+  }
+  return 0;
+}
 
 //-----------------------------------------------------------------------
 // Constructor
@@ -15,8 +114,21 @@ Pfile::Pfile()
   m_isopen.reserve(PFILE_RES);
   m_fname.reserve(PFILE_RES);
   m_fstat.reserve(PFILE_RES);
+  m_dev.reserve(PFILE_RES);
+  m_sfio.reserve(PFILE_RES);
+  m_fstripe.reserve(PFILE_RES);
+  m_place = PFILE_PLACE_RR;
+  m_stripe = PFILE_STRIPE;
+  m_stripe_min = 0;
+  m_next_dev = 0;
   m_nfiles = 0;
   memset(m_buf,(char)0,sizeof(char)*PFILE_LEN);
+  memset(m_aio,0,sizeof(Paio)*PFILE_AIO_SLOTS);
+  m_aio_issued = 0;
+  m_aio_done = 0;
+  m_aio_err = 0;
+  m_aio_stop = false;
+  m_aio_running = false;
 }
 
 //-----------------------------------------------------------------------
@@ -25,18 +137,88 @@ Pfile::Pfile()
 Pfile::~Pfile()
 {
   //close all in the future
+  aio_stop();
   xclose_all();
+  #if !defined LIBJ_MPI
+  for (size_t cid=0;cid<m_cfile.size();cid++)
+  {
+    if (m_cfile[cid].isopen) fclose(m_cfile[cid].fptr);
+  }
+  #endif
+  for (int slot=0;slot<PFILE_AIO_SLOTS;slot++) 
+  {
+    if (m_aio[slot].buf != NULL) free(m_aio[slot].buf);
+  }
 }
 
 //-----------------------------------------------------------------------
-// Init -- initialize 0-file, the file for this class
+// Init -- initialize 0-file, the file for this class, which is always
+//   in the working directory. The round-robin starts at the world id, so
+//   that the aggregators of a node start on different devices
 //-----------------------------------------------------------------------
 int Pfile::init(const Pworld& pworld)
 {
-  if (pworld.mpi_doesIO) {m_rootid = sadd(pworld,"pfile");}
+  if (pworld.mpi_doesIO) 
+  {
+    m_rootid = sadd(pworld,"pfile");
+    if (m_rootid >= 0)
+    {
+      m_dev[m_rootid] = PFILE_DEV_CWD;
+      m_sfio[m_rootid].clear();
+      m_fstripe[m_rootid] = 0;
+    }
+    m_next_dev = pworld.mpi_world_task_id;
+  }
   return 0;
 }
 
+//-----------------------------------------------------------------------
+// add_scratch -- add a scratch directory, returns its device id
+//-----------------------------------------------------------------------
+int Pfile::add_scratch(const char* dir)
+{
+  if (dir == NULL || strlen(dir) == 0 || access(dir,W_OK) != 0)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pfile::add_scratch %s is not a writable directory\n",
+           (dir == NULL) ? "(null)" : dir);
+    return PFILE_ERR_OPEN;
+  }
+  m_scratch.push_back(std::string(dir));
+  return (int) m_scratch.size() - 1;
+}
+
+//-----------------------------------------------------------------------
+// set_placement -- placement of the files added after it 
+//-----------------------------------------------------------------------
+int Pfile::set_placement(const int policy, const long stripe, const long min_bytes)
+{
+  if (policy < PFILE_PLACE_RR || policy > PFILE_PLACE_SIZE || stripe <= 0)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pfile::set_placement bad policy %d or stripe %ld\n",policy,stripe);
+    return 1;
+  }
+  m_place = policy;
+  m_stripe = stripe;
+  m_stripe_min = min_bytes;
+  return 0;
+}
+
+//-----------------------------------------------------------------------
+// path -- path of a file, or of device dev of a striped file
+//-----------------------------------------------------------------------
+std::string Pfile::path(const int fid, const int dev) const
+{
+  const int d = m_dev[fid];
+  if (d == PFILE_DEV_CWD) {return std::string(m_fname[fid]);}
+  if (d == PFILE_DEV_STRIPE) 
+  {
+    return m_scratch[dev] + "/" + m_fname[fid] + ".s" + std::to_string(dev);
+  }
+  return m_scratch[d] + "/" + m_fname[fid];
+}
+
 //-----------------------------------------------------------------------
 // issopen -- check if file is open given external name 
 //-----------------------------------------------------------------------
@@ -136,7 +318,7 @@ void Pfile::info(const Pworld& pworld, Pprint& pprint) const
 //-----------------------------------------------------------------------
 // Add -- add a string to the filesystem 
 //-----------------------------------------------------------------------
-int Pfile::sadd(const Pworld& pworld, const char* fname)
+int Pfile::sadd(const Pworld& pworld, const char* fname, const long bytes)
 {
   if (pworld.mpi_doesIO)
   {
@@ -144,7 +326,7 @@ int Pfile::sadd(const Pworld& pworld, const char* fname)
     if (make_name(pworld,fname) == 0)
     {
       int loc = xfile_loc(m_buf);
-      if (loc == -1) {loc = xadd(m_buf);} 
+      if (loc == -1) {loc = xadd(m_buf,bytes);} 
       return loc;
     } else {
       return PFILE_ERR_SLEN;
@@ -156,23 +338,37 @@ int Pfile::sadd(const Pworld& pworld, const char* fname)
 //-----------------------------------------------------------------------
 // add -- add file, given we already have name and checked if it exists 
 //-----------------------------------------------------------------------
-int Pfile::add(const Pworld& pworld, const char* fname)
+int Pfile::add(const Pworld& pworld, const char* fname, const long bytes)
 {
-  if (pworld.mpi_doesIO) {return xadd(fname);}
+  if (pworld.mpi_doesIO) {return xadd(fname,bytes);}
   return -1;
 }
 
 //-----------------------------------------------------------------------
 // xadd -- add file, given we already have name and checked if it exists 
-// no pworld check
+// no pworld check. The device is picked by the placement policy
 //-----------------------------------------------------------------------
-int Pfile::xadd(const char* fname)
+int Pfile::xadd(const char* fname, const long bytes)
 {
+    const int ndev = (int) m_scratch.size();
+    int dev = PFILE_DEV_CWD;
+    if (ndev > 1 && (m_place == PFILE_PLACE_STRIPE || 
+                    (m_place == PFILE_PLACE_SIZE && bytes >= m_stripe_min)))
+    {
+      dev = PFILE_DEV_STRIPE;
+    } else if (ndev > 0) {
+      dev = m_next_dev % ndev;
+      m_next_dev++;
+    }
+
     m_nfiles++;
     m_isopen.push_back({false});  
-    m_fio.push_back({NULL,0});
+    m_fio.push_back({NULL,0,-1});
     m_fname.push_back(fname);
     m_fstat.push_back("c");
+    m_dev.push_back(dev);
+    m_sfio.push_back(std::vector<Pfio>((dev == PFILE_DEV_STRIPE) ? ndev : 0,{NULL,0,-1}));
+    m_fstripe.push_back((dev == PFILE_DEV_STRIPE) ? m_stripe : 0);
     return m_nfiles-1; 
 }
 
@@ -229,8 +425,11 @@ int Pfile::remove(const Pworld& pworld, const int fid)
 //-----------------------------------------------------------------------
 int Pfile::xremove(const int fid)
 {
-  if (m_fio[fid].fptr != NULL) {fclose(m_fio[fid].fptr);}
+  if (xisopen(fid)) {xclose(fid);}
   m_fio.erase(m_fio.begin()+fid);
+  m_dev.erase(m_dev.begin()+fid);
+  m_sfio.erase(m_sfio.begin()+fid);
+  m_fstripe.erase(m_fstripe.begin()+fid);
   m_isopen.erase(m_isopen.begin()+fid);
   m_fname.erase(fid);
   m_fstat.erase(fid);
@@ -322,12 +521,37 @@ int Pfile::xopen(const int fid, const char* fstat)
       if (!xisopen(fid))
       {
         strncpy(m_fstat[fid],fstat,PFILE_LEN);
-        m_fio[fid].fptr = fopen(m_fname[fid],m_fstat[fid]);
+        if (striped(fid))
+        {
+          //open every device, or none
+          std::vector<Pfio>& sfio = m_sfio[fid];
+          bool good = true;
+          for (size_t dev=0;dev<sfio.size();dev++)
+          {
+            sfio[dev].fptr = fopen(path(fid,(int) dev).c_str(),m_fstat[fid]);
+            sfio[dev].fpos = 0;
+            sfio[dev].fd = (sfio[dev].fptr != NULL) ? fileno(sfio[dev].fptr) : -1;
+            if (sfio[dev].fptr == NULL) good = false;
+          }
+          if (!good)
+          {
+            for (size_t dev=0;dev<sfio.size();dev++)
+            {
+              if (sfio[dev].fptr != NULL) fclose(sfio[dev].fptr);
+              sfio[dev].fptr = NULL;
+              sfio[dev].fd = -1;
+            }
+          }
+          m_fio[fid].fptr = good ? sfio[0].fptr : NULL;
+        } else {
+          m_fio[fid].fptr = fopen(path(fid,0).c_str(),m_fstat[fid]);
+        }
 
         //check for successful open
         if (m_fio[fid].fptr != NULL)
         {
           m_fio[fid].fpos = 0;
+          m_fio[fid].fd = fileno(m_fio[fid].fptr);
           m_isopen[fid].val = true;
 
         //bad open
@@ -415,9 +639,22 @@ int Pfile::xclose(const int fid)
   //if file is open 
   if (xisopen(fid))
   {
-    stat = fclose(m_fio[fid].fptr);
+    if (m_aio_issued != m_aio_done) wait_all();
+    if (striped(fid))
+    {
+      std::vector<Pfio>& sfio = m_sfio[fid];
+      for (size_t dev=0;dev<sfio.size();dev++)
+      {
+        stat += fclose(sfio[dev].fptr);
+        sfio[dev].fptr = NULL;
+        sfio[dev].fd = -1;
+      }
+    } else {
+      stat = fclose(m_fio[fid].fptr);
+    }
     m_fio[fid].fptr = NULL;
     m_fio[fid].fpos = 0;
+    m_fio[fid].fd = -1;
     m_isopen[fid].val = false;
     strncpy(m_fstat[fid],"c",PFILE_LEN);
   
@@ -475,7 +712,15 @@ int Pfile::xerase(const int fid)
 {
   int stat = xclose(fid);   
   //if (stat != 0) {return stat;}
-  stat += remove(m_fname[fid]); //C remove function
+  if (striped(fid))
+  {
+    for (size_t dev=0;dev<m_sfio[fid].size();dev++) 
+    {
+      stat += remove(path(fid,(int) dev).c_str()); //C remove function
+    }
+  } else {
+    stat += remove(path(fid,0).c_str()); //C remove function
+  }
   //if (stat != 0) {return PFILE_ERR_ERASE;}
   stat += xremove(fid); //internal remove function
   return (stat == 0) ? 0 : PFILE_ERR_ERASE; 
@@ -509,7 +754,12 @@ int Pfile::make_name(const Pworld& pworld, const char* fname)
     if (len < PFILE_LEN) 
     {
       memset(m_buf,(char)0,sizeof(char)*PFILE_LEN);
-      snprintf(m_buf,PFILE_LEN,"%s%d",fname,pworld.mpi_world_task_id); 
+      if (pworld.mpi_num_teams > 1)
+      {
+        snprintf(m_buf,PFILE_LEN,"%s.team%d.%d",fname,pworld.mpi_team_id,pworld.mpi_world_task_id); 
+      } else {
+        snprintf(m_buf,PFILE_LEN,"%s%d",fname,pworld.mpi_world_task_id); 
+      }
       return 0; 
     } else {
       return 1;
@@ -532,12 +782,7 @@ int Pfile::file_loc(const Pworld& pworld, const char* fname) const
 //-----------------------------------------------------------------------
 int Pfile::xfile_loc(const char* fname) const
 {
-  int loc = -1;
-  for (int file=0;file<m_nfiles;file++)
-  {
-    if (strcmp(fname,m_fname[file]) == 0) {return file;}
-  }
-  return loc;
+  return (int) m_fname.find_index(fname);
 }
 
 //-----------------------------------------------------------------------
@@ -546,6 +791,15 @@ int Pfile::xfile_loc(const char* fname) const
 void Pfile::write(const int file, const long pos, const void* data, 
                   const size_t size, const size_t num)
 {
+  LIBJ_TRACE_SCOPE_ARG("write","io",size*num);
+  if (m_aio_issued != m_aio_done) wait_all();
+  if (striped(file))
+  {
+    stripe_io(m_sfio[file].data(),(int) m_sfio[file].size(),m_fstripe[file],pos,
+              (char*) data,size*num,false);
+    m_fio[file].fpos = pos + (long) size*num;
+    return;
+  }
   seek(file,pos); //this updates m_fio[file].fpos
   fwrite(data,size,num,m_fio[file].fptr);
   m_fio[file].fpos += (long) size*num;
@@ -557,6 +811,15 @@ void Pfile::write(const int file, const long pos, const void* data,
 void Pfile::read(const int file, const long pos, void* data, 
                   const size_t size, const size_t num)
 {
+  LIBJ_TRACE_SCOPE_ARG("read","io",size*num);
+  if (m_aio_issued != m_aio_done) wait_all();
+  if (striped(file))
+  {
+    stripe_io(m_sfio[file].data(),(int) m_sfio[file].size(),m_fstripe[file],pos,
+              (char*) data,size*num,true);
+    m_fio[file].fpos = pos + (long) size*num;
+    return;
+  }
   seek(file,pos);
   fread(data,size,num,m_fio[file].fptr);
   m_fio[file].fpos += (long) size*num;
@@ -564,10 +827,12 @@ void Pfile::read(const int file, const long pos, void* data,
 
 //-----------------------------------------------------------------------
 // seek -- go to some position in a file, but check we are not already
-//  there first
+//  there first. Striped files seek with each request
 //-----------------------------------------------------------------------
 void Pfile::seek(const int file, const long pos)
 {
+  if (m_aio_issued != m_aio_done) wait_all();
+  if (striped(file)) {m_fio[file].fpos = pos; return;}
   if (pos != m_fio[file].fpos)
   {
     fseek(m_fio[file].fptr,pos,SEEK_SET); 
@@ -590,7 +855,7 @@ int Pfile::sflush(const Pworld& pworld, const char* fname)
   
       if (loc != -1)
       {
-        fflush(m_fio[loc].fptr);
+        flush(pworld,loc);
         stat = loc;
       } else {
         stat = PFILE_ERR_FLUSH; 
@@ -611,7 +876,12 @@ int Pfile::flush(const Pworld& pworld, const int fid) const
   if (pworld.mpi_doesIO)
   {
     int stat = 0;
-    fflush(m_fio[fid].fptr);
+    if (striped(fid))
+    {
+      for (size_t dev=0;dev<m_sfio[fid].size();dev++) fflush(m_sfio[fid][dev].fptr);
+    } else {
+      fflush(m_fio[fid].fptr);
+    }
     return stat;
   }
   return 0;
@@ -657,6 +927,16 @@ int Pfile::save(const Pworld& pworld)
     write(m_rootid,get_pos(m_rootid),m_fname[0],
           sizeof(char)*m_fname.maxlen(),m_nfiles); 
 
+    //Write placement, [device][number of devices][stripe] per file
+    std::vector<long> place(3*m_nfiles);
+    for (int file=0;file<m_nfiles;file++)
+    {
+      place[3*file]   = m_dev[file];
+      place[3*file+1] = (long) m_sfio[file].size();
+      place[3*file+2] = m_fstripe[file];
+    }
+    write(m_rootid,get_pos(m_rootid),place.data(),sizeof(long),place.size());
+
     //Close file
     if (xclose(m_rootid) != 0) {return PFILE_ERR_CLOSE;}
   }
@@ -686,13 +966,453 @@ int Pfile::recover(const Pworld& pworld)
     m_isopen.resize(m_nfiles);
     m_fname.resize(m_nfiles);
     m_fstat.resize(m_nfiles);
+    m_dev.assign(m_nfiles,PFILE_DEV_CWD);
+    m_sfio.assign(m_nfiles,std::vector<Pfio>());
+    m_fstripe.assign(m_nfiles,0);
 
     //read the vector data
     read(m_rootid,get_pos(m_rootid),m_fname[0],
          sizeof(char)*m_fname.maxlen(),m_nfiles); 
+    m_fname.rehash();
+
+    //read the placement, files saved without it are in the working dir  
+    std::vector<long> place(3*m_nfiles);
+    if (fread(place.data(),sizeof(long),place.size(),m_fio[m_rootid].fptr) == place.size())
+    {
+      for (int file=0;file<m_nfiles;file++)
+      {
+        const long dev = place[3*file];
+        const long ndev = place[3*file+1];
+        if ((dev >= 0 && dev >= num_scratch()) || ndev > num_scratch())
+        {
+          printf("\nERROR ERROR ERROR\n");
+          printf("Pfile::recover file %s needs %ld scratch directories, but there are %d\n",
+                 m_fname[file],std::max(dev+1,ndev),num_scratch());
+          xclose(m_rootid);
+          return PFILE_ERR_OPEN;
+        }
+        m_dev[file] = (int) dev;
+        m_sfio[file].assign(ndev,{NULL,0,-1});
+        m_fstripe[file] = place[3*file+2];
+      }
+    }
 
     //Close file
     if (xclose(m_rootid) != 0) {return PFILE_ERR_CLOSE;}
   }
   return stat;
 }
+
+//-----------------------------------------------------------------------
+// awrite -- queue an asynchronous write, the data is copied  
+//-----------------------------------------------------------------------
+long Pfile::awrite(const int file, const long pos, const void* data, 
+                   const size_t bytes)
+{
+  return aio_issue(file,pos,data,NULL,bytes,false);
+}
+
+//-----------------------------------------------------------------------
+// aread -- queue an asynchronous read into data
+//-----------------------------------------------------------------------
+long Pfile::aread(const int file, const long pos, void* data, 
+                  const size_t bytes)
+{
+  return aio_issue(file,pos,NULL,data,bytes,true);
+}
+
+//-----------------------------------------------------------------------
+// wait -- wait until ticket is finished, returns the error of any 
+//   request finished since the last wait 
+//-----------------------------------------------------------------------
+int Pfile::wait(const long ticket)
+{
+  LIBJ_TRACE_SCOPE("aio_wait","io");
+  std::unique_lock<std::mutex> lock(m_aio_mutex);
+  m_aio_free.wait(lock,[&]{return m_aio_done >= ticket;});
+  const int stat = m_aio_err;
+  m_aio_err = 0;
+  return stat;
+}
+
+//-----------------------------------------------------------------------
+// aio_issue -- fill the next slot and hand it to the io thread. The 
+//   file position is updated as if the request was already done 
+//-----------------------------------------------------------------------
+long Pfile::aio_issue(const int file, const long pos, const void* data, 
+                      void* dest, const size_t bytes, const bool isread)
+{
+  if (!m_aio_running)
+  {
+    m_aio_stop = false;
+    m_aio_thread = std::thread(&Pfile::aio_loop,this);
+    m_aio_running = true;
+  }
+
+  //wait for a free slot. Only this thread fills slots, so the slot
+  // can be filled without the lock
+  const long ticket = m_aio_issued + 1;
+  {
+    std::unique_lock<std::mutex> lock(m_aio_mutex);
+    m_aio_free.wait(lock,[&]{return ticket - m_aio_done <= PFILE_AIO_SLOTS;});
+  }
+
+  Paio& req = m_aio[ticket % PFILE_AIO_SLOTS];
+  if (!isread && bytes > req.cap)
+  {
+    char* newbuf = (char*) realloc(req.buf,sizeof(char)*bytes);
+    if (newbuf == NULL)
+    {
+      printf("\nERROR ERROR ERROR\n");
+      printf("Pfile::awrite could not realloc %ld bytes\n",(long) bytes);
+      return -1;
+    }
+    req.buf = newbuf;
+    req.cap = bytes;
+  }
+  if (!isread) memcpy(req.buf,data,bytes);
+  req.fptr   = m_fio[file].fptr;
+  req.sfio   = striped(file) ? m_sfio[file].data() : NULL;
+  req.ndev   = (int) m_sfio[file].size();
+  req.stripe = m_fstripe[file];
+  req.pos    = pos;
+  req.dest   = dest;
+  req.bytes  = bytes; 
+  req.isread = isread;
+  m_fio[file].fpos = pos + (long) bytes;
+
+  {
+    std::lock_guard<std::mutex> lock(m_aio_mutex);
+    m_aio_issued = ticket;
+  }
+  m_aio_work.notify_one();
+  return ticket;
+}
+
+//-----------------------------------------------------------------------
+// aio_loop -- the io thread, does the requests in ticket order
+//-----------------------------------------------------------------------
+void Pfile::aio_loop()
+{
+  while (true)
+  {
+    long ticket;
+    {
+      std::unique_lock<std::mutex> lock(m_aio_mutex);
+      m_aio_work.wait(lock,[&]{return m_aio_stop || m_aio_done < m_aio_issued;});
+      if (m_aio_done == m_aio_issued) return; //stopped, nothing left
+      ticket = m_aio_done + 1;
+    }
+
+    const Paio& req = m_aio[ticket % PFILE_AIO_SLOTS];
+    LIBJ_TRACE_SCOPE_ARG(req.isread ? "aio_read" : "aio_write","io",req.bytes);
+    size_t num = 0;
+    if (req.sfio != NULL)
+    {
+      num = stripe_io(req.sfio,req.ndev,req.stripe,req.pos,
+                      req.isread ? (char*) req.dest : req.buf,req.bytes,req.isread);
+    } else if (fseek(req.fptr,req.pos,SEEK_SET) == 0)
+    {
+      num = req.isread ? fread(req.dest,1,req.bytes,req.fptr)
+                       : fwrite(req.buf,1,req.bytes,req.fptr);
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_aio_mutex);
+      if (num != req.bytes) m_aio_err = PFILE_ERR_AIO;
+      m_aio_done = ticket;
+    }
+    m_aio_free.notify_all();
+  }
+}
+
+//-----------------------------------------------------------------------
+// aio_stop -- finish the pending requests and join the io thread 
+//-----------------------------------------------------------------------
+void Pfile::aio_stop()
+{
+  if (!m_aio_running) return;
+  {
+    std::lock_guard<std::mutex> lock(m_aio_mutex);
+    m_aio_stop = true;
+  }
+  m_aio_work.notify_one();
+  m_aio_thread.join();
+  m_aio_running = false;
+}
+
+//-----------------------------------------------------------------------
+// write_at -- pwrite bytes at pos, does not touch the file position
+//-----------------------------------------------------------------------
+int Pfile::write_at(const int file, const long pos, const void* data, 
+                    const size_t bytes) const
+{
+  LIBJ_TRACE_SCOPE_ARG("write_at","io",bytes);
+  if (striped(file))
+  {
+    return stripe_pio(m_sfio[file].data(),(int) m_sfio[file].size(),m_fstripe[file],
+                      pos,(char*) data,bytes,false);
+  }
+  const char* ptr = (const char*) data;
+  size_t done = 0;
+  while (done < bytes)
+  {
+    const ssize_t num = ::pwrite(m_fio[file].fd,ptr+done,bytes-done,
+                                 (off_t) (pos+done));
+    if (num < 0 && errno == EINTR) continue;
+    if (num <= 0) return PFILE_ERR_PIO;
+    done += (size_t) num;
+  }
+  return 0;
+}
+
+//-----------------------------------------------------------------------
+// read_at -- pread bytes at pos, does not touch the file position
+//-----------------------------------------------------------------------
+int Pfile::read_at(const int file, const long pos, void* data, 
+                   const size_t bytes) const
+{
+  LIBJ_TRACE_SCOPE_ARG("read_at","io",bytes);
+  if (striped(file))
+  {
+    return stripe_pio(m_sfio[file].data(),(int) m_sfio[file].size(),m_fstripe[file],
+                      pos,(char*) data,bytes,true);
+  }
+  char* ptr = (char*) data;
+  size_t done = 0;
+  while (done < bytes)
+  {
+    const ssize_t num = ::pread(m_fio[file].fd,ptr+done,bytes-done,
+                                (off_t) (pos+done));
+    if (num < 0 && errno == EINTR) continue;
+    if (num <= 0) return PFILE_ERR_PIO; //error or end of file 
+    done += (size_t) num;
+  }
+  return 0;
+}
+
+//-----------------------------------------------------------------------
+// readv -- vectored read, see vio
+//-----------------------------------------------------------------------
+int Pfile::readv(const int file, const Piovec* reqs, const long num)
+{
+  return vio(file,reqs,num,true);
+}
+
+//-----------------------------------------------------------------------
+// writev -- vectored write, see vio
+//-----------------------------------------------------------------------
+int Pfile::writev(const int file, const Piovec* reqs, const long num)
+{
+  return vio(file,reqs,num,false);
+}
+
+//-----------------------------------------------------------------------
+// vio -- the requests sorted by position, and each run of adjacent 
+//   requests one preadv/pwritev. The FILE* buffer is flushed first, and
+//   the FILE* is sought back to its position after, which drops what it
+//   had read ahead of the new data
+//-----------------------------------------------------------------------
+int Pfile::vio(const int file, const Piovec* reqs, const long num, const bool isread)
+{
+  if (num <= 0) return 0;
+  size_t total = 0;
+  for (long r=0;r<num;r++) {total += reqs[r].bytes;}
+  LIBJ_TRACE_SCOPE_ARG(isread ? "readv" : "writev","io",total);
+  if (m_aio_issued != m_aio_done) wait_all();
+
+  std::vector<long> order(num);
+  for (long r=0;r<num;r++) {order[r] = r;}
+  std::stable_sort(order.begin(),order.end(),[&](const long a, const long b)
+  {
+    return reqs[a].pos < reqs[b].pos;
+  });
+
+  if (striped(file))
+  {
+    for (size_t dev=0;dev<m_sfio[file].size();dev++) fflush(m_sfio[file][dev].fptr);
+    for (long r=0;r<num;r++)
+    {
+      const Piovec& req = reqs[order[r]];
+      const int stat = stripe_pio(m_sfio[file].data(),(int) m_sfio[file].size(),
+                                  m_fstripe[file],req.pos,(char*) req.data,req.bytes,isread);
+      if (stat != 0) return stat;
+    }
+    return 0;
+  }
+
+  fflush(m_fio[file].fptr);
+  const int fd = m_fio[file].fd;
+  const int max_iov = (IOV_MAX > 0) ? IOV_MAX : 1024;
+  std::vector<struct iovec> iov;
+  iov.reserve(std::min((long) max_iov,num));
+  int stat = 0;
+  long r = 0;
+  while (r < num && stat == 0)
+  {
+    const long start = reqs[order[r]].pos;
+    long end = start;
+    iov.clear();
+    while (r < num && (int) iov.size() < max_iov && reqs[order[r]].pos == end)
+    {
+      const Piovec& req = reqs[order[r]];
+      if (req.bytes > 0)
+      {
+        struct iovec v;
+        v.iov_base = req.data;
+        v.iov_len  = req.bytes;
+        iov.push_back(v);
+      }
+      end += (long) req.bytes;
+      r++;
+    }
+    stat = vector_pio(fd,iov.data(),(int) iov.size(),start,isread);
+  }
+  fseek(m_fio[file].fptr,m_fio[file].fpos,SEEK_SET);
+  return stat;
+}
+
+//-----------------------------------------------------------------------
+// copen -- collective open of a shared file, fstat as in fopen 
+//-----------------------------------------------------------------------
+int Pfile::copen(const Pworld& pworld, const char* fname, const char* fstat)
+{
+  Pcfile cfile;
+  cfile.isopen = false;
+
+  #if defined LIBJ_MPI
+  const bool plus = (strchr(fstat,'+') != NULL);
+  int amode = 0;
+  bool trunc = false;
+  switch (fstat[0])
+  {
+    case 'r' : amode = plus ? MPI_MODE_RDWR : MPI_MODE_RDONLY; break;
+    case 'w' : amode = (plus ? MPI_MODE_RDWR : MPI_MODE_WRONLY) | MPI_MODE_CREATE;
+               trunc = true; break;
+    case 'a' : amode = (plus ? MPI_MODE_RDWR : MPI_MODE_WRONLY) | MPI_MODE_CREATE;
+               break;
+    default  : return PFILE_ERR_OPEN;
+  }
+
+  //collective buffering hints for the write_at_all and read_at_all
+  MPI_Info_set(pworld.mpi_info,"romio_cb_write","enable");
+  MPI_Info_set(pworld.mpi_info,"romio_cb_read","enable");
+
+  if (MPI_File_open(pworld.comm_world,fname,amode,pworld.mpi_info,&cfile.fh) 
+      != MPI_SUCCESS) {return PFILE_ERR_NULL;}
+  if (trunc && MPI_File_set_size(cfile.fh,0) != MPI_SUCCESS) 
+  {
+    MPI_File_close(&cfile.fh);
+    return PFILE_ERR_MPIIO;
+  }
+
+  #else
+  cfile.fptr = fopen(fname,fstat);
+  if (cfile.fptr == NULL) {return PFILE_ERR_NULL;}
+  #endif
+
+  cfile.isopen = true;
+  m_cfile.push_back(cfile);
+  return (int) m_cfile.size() - 1;
+}
+
+//-----------------------------------------------------------------------
+// cclose -- collective close of a shared file
+//-----------------------------------------------------------------------
+int Pfile::cclose(const Pworld& pworld, const int cid)
+{
+  if (cid < 0 || cid >= (int) m_cfile.size() || !m_cfile[cid].isopen) 
+  {
+    return PFILE_ERR_CLOSE;
+  }
+  m_cfile[cid].isopen = false;
+  #if defined LIBJ_MPI
+  return (MPI_File_close(&m_cfile[cid].fh) == MPI_SUCCESS) ? 0 : PFILE_ERR_CLOSE;
+  #else
+  return (fclose(m_cfile[cid].fptr) == 0) ? 0 : PFILE_ERR_CLOSE;
+  #endif
+}
+
+//-----------------------------------------------------------------------
+// cwrite -- collective write. MPI counts are ints, so larger writes are
+//   done in rounds of at most INT_MAX bytes, and every task does the 
+//   same number of rounds (with 0 bytes once it is done)
+//-----------------------------------------------------------------------
+int Pfile::cwrite(const Pworld& pworld, const int cid, const long pos, 
+                  const void* data, const size_t bytes)
+{
+  LIBJ_TRACE_SCOPE_ARG("cwrite","io",bytes);
+  #if defined LIBJ_MPI
+  const long chunk = INT_MAX;
+  long nround = ((long) bytes + chunk - 1)/chunk;
+  MPI_Allreduce(MPI_IN_PLACE,&nround,1,MPI_LONG,MPI_MAX,pworld.comm_world);
+
+  int stat = 0;
+  const char* ptr = (const char*) data;
+  for (long round=0;round<nround;round++)
+  {
+    const long off = round*chunk;
+    const int num = (off < (long) bytes) ? (int) std::min(chunk,(long) bytes-off) : 0;
+    if (MPI_File_write_at_all(m_cfile[cid].fh,(MPI_Offset) (pos+off),ptr+off,
+                              num,MPI_BYTE,MPI_STATUS_IGNORE) != MPI_SUCCESS)
+    {
+      stat = PFILE_ERR_MPIIO;
+    }
+  }
+  return stat;
+
+  #else
+  const int fd = fileno(m_cfile[cid].fptr);
+  const char* ptr = (const char*) data;
+  size_t done = 0;
+  while (done < bytes)
+  {
+    const ssize_t num = ::pwrite(fd,ptr+done,bytes-done,(off_t) (pos+done));
+    if (num < 0 && errno == EINTR) continue;
+    if (num <= 0) return PFILE_ERR_PIO;
+    done += (size_t) num;
+  }
+  return 0;
+  #endif
+}
+
+//-----------------------------------------------------------------------
+// cread -- collective read, in rounds as in cwrite
+//-----------------------------------------------------------------------
+int Pfile::cread(const Pworld& pworld, const int cid, const long pos, 
+                 void* data, const size_t bytes)
+{
+  LIBJ_TRACE_SCOPE_ARG("cread","io",bytes);
+  #if defined LIBJ_MPI
+  const long chunk = INT_MAX;
+  long nround = ((long) bytes + chunk - 1)/chunk;
+  MPI_Allreduce(MPI_IN_PLACE,&nround,1,MPI_LONG,MPI_MAX,pworld.comm_world);
+
+  int stat = 0;
+  char* ptr = (char*) data;
+  for (long round=0;round<nround;round++)
+  {
+    const long off = round*chunk;
+    const int num = (off < (long) bytes) ? (int) std::min(chunk,(long) bytes-off) : 0;
+    if (MPI_File_read_at_all(m_cfile[cid].fh,(MPI_Offset) (pos+off),ptr+off,
+                             num,MPI_BYTE,MPI_STATUS_IGNORE) != MPI_SUCCESS)
+    {
+      stat = PFILE_ERR_MPIIO;
+    }
+  }
+  return stat;
+
+  #else
+  const int fd = fileno(m_cfile[cid].fptr);
+  char* ptr = (char*) data;
+  size_t done = 0;
+  while (done < bytes)
+  {
+    const ssize_t num = ::pread(fd,ptr+done,bytes-done,(off_t) (pos+done));
+    if (num < 0 && errno == EINTR) continue;
+    if (num <= 0) return PFILE_ERR_PIO;
+    done += (size_t) num;
+  }
+  return 0;
+  #endif
+}
@@ -1,6 +1,13 @@
 /*------------------------------------------------------------------------
  * pfile.hpp
  *  JHT, Febuary 8, 2022: created
+ *  JHT, October 14, 2026: added awrite, aread, and wait 
+ *  JHT, October 14, 2026: added write_at and read_at 
+ *  JHT, October 14, 2026: added the collective shared files
+ *  JHT, October 14, 2026: noted the io aggregators
+ *  JHT, October 14, 2026: added the scratch devices and striping
+ *  JHT, October 14, 2026: added readv and writev
+ *  JHT, October 14, 2026: noted the team file names
  *
    .hpp file for Pfile, which handles a (possibly parallel) filesystem
    Also contains the PFIO struct, which 
@@ -18,6 +25,37 @@
  
   Init must be called after construction
 
+  The tasks "in charge of IO" are those with pworld.mpi_doesIO, the io
+    aggregators (see pworld.hpp). Each has its own files and file ids 
+    (the names get its world task id), and does the io for the tasks of
+    its comm_io, so with several aggregators per node the files of a 
+    node are spread over them, and the devices they use. On a team 
+    Pworld (pworld.split_teams) with more than one team, the names get
+    .team<team id>.<task id>, so the teams do not share files.
+
+  Scratch devices
+
+  add_scratch registers a scratch directory (e.g., one per local SSD), 
+    and files added after it are placed on the devices by the policy of
+    set_placement:
+      PFILE_PLACE_RR     : whole files round-robin over the devices
+      PFILE_PLACE_STRIPE : every file is striped, block k of stripe bytes
+                           on device k % num_scratch, as name.s<device> 
+      PFILE_PLACE_SIZE   : files with a size hint (sadd) of at least
+                           min_bytes are striped, the others round-robin
+    A striped file is still one file id and one logical file, and all of
+    the io calls (including aread/awrite and read_at/write_at) split the
+    requests over the devices. With no scratch directories, the files are
+    in the working directory, as before. Files added before any scratch
+    directory (e.g., the pfile root file) stay in the working directory.
+  The placement of each file is saved by save, but the scratch table is 
+    not, so add the same directories in the same order before recover.
+
+    pfile.add_scratch("/nvme0/scr"); 
+    pfile.add_scratch("/nvme1/scr");
+    pfile.set_placement(PFILE_PLACE_SIZE,1048576,1L<<30);
+    const int fid = pfile.sadd(pworld,"t2",t2_bytes); //striped if >= 1 GB
+
   General usage
 
   The external name subroutines, those that begin with "s", are safest.
@@ -25,6 +63,70 @@
     called by any MPI task (as can the "s" subroutines).
   The "unsafe" subroutines, those that begin with "x", and write,read,
     seek, get_pos, should only be called by a task which does the IO. 
+
+  Asynchronous IO
+
+  awrite and aread queue a request for a dedicated IO thread, which is
+    started on the first call, and return a ticket. wait(ticket) blocks 
+    until that request (and all those before it) is done. The queue has
+    PFILE_AIO_SLOTS requests, and awrite/aread block if it is full. 
+  awrite copies the data into the buffer of its slot, so the data can be
+    reused as soon as awrite returns (with 2 slots, one buffer is being
+    written while the next is filled). aread reads directly into data, 
+    which must not be touched until the ticket is waited on.
+  write, read, seek, and xclose wait for all pending requests first, so
+    they see the file as if the requests were done in order. 
+
+    const long t = pfile.awrite(fid,pos,amps,bytes);
+    ... next contraction ... 
+    if (pfile.wait(t) != 0) error  
+
+  Positional IO
+
+  write_at and read_at use pwrite/pread on the file descriptor, so they 
+    do not use or change the file position, and are const. Several
+    OpenMP threads can read (or write disjoint blocks of) the same file 
+    at once, without a lock. They bypass the FILE* buffer, so call flush
+    after write before read_at sees that data, and do not mix them with
+    buffered reads of the same blocks. 
+
+    #pragma omp parallel for
+    for (long i=0;i<n;i++) pfile.read_at(fid,info[i].m_file_pos,buf[i],bytes);
+
+  Vectored IO
+
+  readv and writev do a list of (pos, data, bytes) requests of one file in
+    a few calls. The requests are sorted by pos, runs of them that are 
+    adjacent in the file are merged, and each run is one preadv/pwritev 
+    (of at most IOV_MAX pieces), so 500 small blocks that were written 
+    one after the other are one read. Requests that are not adjacent are
+    still one pread each, but in file order. Striped files do each request
+    with the positional io of its devices. Like read and write, they wait
+    for the asynchronous requests first, and they flush the FILE* buffer, 
+    so they see (and are seen by) the buffered io. Returns 0 or 
+    PFILE_ERR_PIO.
+
+    std::vector<Piovec> reqs;
+    for (long k=0;k<n;k++) reqs.push_back({pos[k],buf[k],bytes[k]});
+    if (pfile.readv(fid,reqs) != 0) error
+
+  Collective shared files
+
+  copen, cclose, cwrite, and cread work on one file shared by all tasks 
+    of comm_world (the name does not get the task id, so teams should
+    give their own names), and must be called
+    by *every* task, not just those with mpi_doesIO. They use MPI-IO, with
+    MPI_File_write_at_all and MPI_File_read_at_all, so the writes of all
+    tasks are aggregated by the collective buffering. Each task gives its
+    own offset, and may write 0 bytes. The collective buffering hints are
+    set in pworld.mpi_info at copen, and more (e.g., the Lustre 
+    "striping_factor" and "striping_unit") can be set there before it.
+  They have their own file ids, and without MPI they are plain files.
+
+    const int cid = pfile.copen(pworld,"amps","w+b");
+    pfile.cwrite(pworld,cid,offset_of_this_task,amps,bytes);
+    pfile.cclose(pworld,cid);
+ 
  
 ------------------------------------------------------------------------*/
 #ifndef LIBJ_PFILE_HPP
@@ -33,7 +135,12 @@
 #include "pprint.hpp"
 #include "pworld.hpp"
 #include <vector>
+#include <string>
 #include <stdio.h>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
 /*
  * Plain old data for file pointer and position
 */
@@ -43,6 +150,7 @@ struct Pfio
 {
   FILE* fptr; //file pointer
   long  fpos; //file 
+  int   fd;   //file descriptor of fptr, for the positional io
 };
 #endif
 
@@ -57,6 +165,55 @@ struct Pbool
 };
 #endif 
 
+/*
+ * Paio plain old data for an asynchronous IO request
+*/
+#ifndef PAIO_HPP
+#define PAIO_HPP
+struct Paio
+{
+  FILE*  fptr;   //file pointer
+  const Pfio* sfio; //device files of a striped file, NULL if not
+  int    ndev;   //number of devices of a striped file
+  long   stripe; //stripe bytes of a striped file
+  long   pos;    //file position 
+  char*  buf;    //copy of the data to write
+  size_t cap;    //bytes allocated in buf
+  void*  dest;   //destination of a read
+  size_t bytes;  //bytes to read or write
+  bool   isread; //read or write
+};
+#endif
+
+/*
+ * Piovec plain old data for one request of readv and writev
+*/
+#ifndef PIOVEC_HPP
+#define PIOVEC_HPP
+struct Piovec
+{
+  long   pos;   //file position
+  void*  data;  //memory to read into, or write from
+  size_t bytes; //bytes to read or write
+};
+#endif
+
+/*
+ * Pcfile plain old data for a collective shared file
+*/
+#ifndef PCFILE_HPP
+#define PCFILE_HPP
+struct Pcfile
+{
+  #if defined LIBJ_MPI
+    MPI_File fh;   //MPI file handle
+  #else
+    FILE*    fptr; //file pointer
+  #endif
+  bool     isopen; //file is open
+};
+#endif
+
 #include "libjdef.h"
 
 //Error message integers
@@ -66,8 +223,22 @@ struct Pbool
 #define PFILE_ERR_ERASE -4 //for if file erase failed
 #define PFILE_ERR_FLUSH -5 //could not flush file io buffer
 #define PFILE_ERR_SLEN -6 //input string is too long
+#define PFILE_ERR_AIO -7 //asynchronous read or write failed
+#define PFILE_ERR_PIO -8 //positional read or write failed
+#define PFILE_ERR_MPIIO -9 //collective MPI-IO call failed
 #define PFILE_RES 50
 #define PFILE_LEN 32 //pfile max length of strvec
+#define PFILE_AIO_SLOTS 2 //queued async requests, 2 is double buffering
+#define PFILE_STRIPE 1048576 //default stripe bytes
+
+//Placement policies
+#define PFILE_PLACE_RR 0     //whole files round-robin over the devices
+#define PFILE_PLACE_STRIPE 1 //every file striped over the devices
+#define PFILE_PLACE_SIZE 2   //striped if the size hint is large enough
+
+//Device of a file
+#define PFILE_DEV_CWD -2     //working directory
+#define PFILE_DEV_STRIPE -1  //striped over all devices
 
 class Pfile
 {
@@ -81,6 +252,50 @@ class Pfile
   int                      m_nfiles;  //number of files
   int                      m_rootid;  //root file id
 
+  //Scratch devices
+  std::vector<std::string> m_scratch;    //scratch directories
+  std::vector<int>         m_dev;        //device of each file, PFILE_DEV_*
+  std::vector<std::vector<Pfio>> m_sfio; //device files of striped files
+  std::vector<long>        m_fstripe;    //stripe bytes of each file, 0 if not striped
+  int                      m_place;      //placement policy
+  long                     m_stripe;     //stripe bytes of new striped files
+  long                     m_stripe_min; //size hint to stripe, PFILE_PLACE_SIZE
+  int                      m_next_dev;   //next device for round-robin
+
+  //Collective shared files
+  std::vector<Pcfile>      m_cfile;   //shared file list
+
+  //Asynchronous IO, request t is in slot t % PFILE_AIO_SLOTS
+  Paio                     m_aio[PFILE_AIO_SLOTS]; //queued requests
+  long                     m_aio_issued;  //last issued ticket
+  std::atomic<long>        m_aio_done;    //last finished ticket
+  int                      m_aio_err;     //error of any finished request
+  bool                     m_aio_stop;    //tells the io thread to stop
+  bool                     m_aio_running; //io thread was started
+  std::thread              m_aio_thread;  //io thread
+  std::mutex               m_aio_mutex;   //guards the queue
+  std::condition_variable  m_aio_work;    //a request was issued
+  std::condition_variable  m_aio_free;    //a request was finished
+
+  //queue a request, returns the ticket or -1
+  long aio_issue(const int fid, const long pos, const void* data, 
+                 void* dest, const size_t bytes, const bool isread);
+
+  //io thread loop
+  void aio_loop();
+
+  //path of file fid on device dev (for a striped file)
+  std::string path(const int fid, const int dev) const;
+
+  //true if file fid is striped
+  bool striped(const int fid) const {return m_dev[fid] == PFILE_DEV_STRIPE;}
+
+  //stop and join the io thread
+  void aio_stop();
+
+  //readv and writev
+  int vio(const int fid, const Piovec* reqs, const long num, const bool isread);
+
   public:
   //Constructor/destructor
   Pfile();
@@ -92,9 +307,17 @@ class Pfile
   //Add a file
   // Note that both sadd and add return the file id (or -val on error)
   // add needs the *internal* file name
-  int sadd(const Pworld& pworld, const char* fname);
-  int add(const Pworld& pworld, const char* fname); 
-  int xadd(const char* fname); 
+  // the optional bytes is the expected size, for PFILE_PLACE_SIZE
+  int sadd(const Pworld& pworld, const char* fname, const long bytes = 0);
+  int add(const Pworld& pworld, const char* fname, const long bytes = 0); 
+  int xadd(const char* fname, const long bytes = 0); 
+
+  //Scratch devices
+  int add_scratch(const char* dir);
+  int num_scratch() const {return (int) m_scratch.size();}
+  int set_placement(const int policy, const long stripe = PFILE_STRIPE, 
+                    const long min_bytes = 0);
+  int device(const int fid) const {return m_dev[fid];}
 
   //Remove a file
   // Note that sadd returns the file id (or -val on error)
@@ -155,6 +378,51 @@ class Pfile
   //seek : needs internal file id!!
   void seek(const int fid, const long pos);
 
+  //awrite : asynchronous write, returns ticket, needs internal file id!! 
+  long awrite(const int fid, const long pos, const void* data, 
+              const size_t bytes);
+
+  //aread : asynchronous read, returns ticket, needs internal file id!! 
+  long aread(const int fid, const long pos, void* data, const size_t bytes);
+
+  //wait : wait for a ticket, returns 0 or PFILE_ERR_AIO
+  int wait(const long ticket);
+
+  //wait_all : wait for all issued tickets
+  int wait_all() {return wait(m_aio_issued);}
+
+  //write_at : positional write, thread safe, needs internal file id!! 
+  int write_at(const int fid, const long pos, const void* data, 
+               const size_t bytes) const;
+
+  //read_at : positional read, thread safe, needs internal file id!! 
+  int read_at(const int fid, const long pos, void* data, 
+              const size_t bytes) const;
+
+  //readv : vectored read of the requests, merged by position, needs internal file id!!
+  int readv(const int fid, const Piovec* reqs, const long num);
+  int readv(const int fid, const std::vector<Piovec>& reqs)
+    {return readv(fid,reqs.data(),(long) reqs.size());}
+
+  //writev : vectored write of the requests, merged by position, needs internal file id!!
+  int writev(const int fid, const Piovec* reqs, const long num);
+  int writev(const int fid, const std::vector<Piovec>& reqs)
+    {return writev(fid,reqs.data(),(long) reqs.size());}
+
+  //copen : collective open of a shared file, returns its id or -val on error
+  int copen(const Pworld& pworld, const char* fname, const char* fstat);
+
+  //cclose : collective close of a shared file
+  int cclose(const Pworld& pworld, const int cid);
+
+  //cwrite : collective write of bytes at this task's pos 
+  int cwrite(const Pworld& pworld, const int cid, const long pos, 
+             const void* data, const size_t bytes);
+
+  //cread : collective read of bytes at this task's pos
+  int cread(const Pworld& pworld, const int cid, const long pos, 
+            void* data, const size_t bytes);
+
   //get_pos : get file position
   long get_pos(const int fid) const {return m_fio[fid].fpos;}
 
@@ -0,0 +1,126 @@
+/*----------------------------------------------------------------------------
+  phash.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for Phash, an open-addressing (linear probing) hash table of
+  ids, used for the name and tag lookups in Strvec, Pfile, and Pdata.
+
+  Phash only stores the hash and the id of each entry. The caller says
+  whether an id really matches with an eq(id) function, so the names or
+  tags are not copied. Entries are never removed, the owner clears and
+  inserts them all again instead. The capacity is a power of two, and is
+  doubled when the table is half full, so lookups do not allocate.
+
+//Usage
+Phash h;
+h.insert(Phash::hash(name,STRLEN),id);
+long id = h.find(Phash::hash(name,STRLEN),[&](const long id){return ...;});
+h.clear();
+----------------------------------------------------------------------------*/
+#ifndef LIBJ_PHASH_HPP
+#define LIBJ_PHASH_HPP
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+struct Phash
+{
+  unsigned long* m_key;  //hash of each slot
+  long*          m_id;   //id of each slot, -1 if empty
+  long           m_cap;  //number of slots
+  long           m_num;  //number of entries
+
+  Phash() {m_key = NULL; m_id = NULL; m_cap = 0; m_num = 0;}
+  ~Phash() {free(m_key); free(m_id);}
+
+  //FNV-1a of a string of at most maxlen characters
+  static unsigned long hash(const char* str, const int maxlen)
+  {
+    unsigned long h = 14695981039346656037UL;
+    for (int i=0;i<maxlen && str[i] != (char) 0;i++)
+    {
+      h ^= (unsigned char) str[i];
+      h *= 1099511628211UL;
+    }
+    return h;
+  }
+
+  //mix of an integer key
+  static unsigned long hash(const long key)
+  {
+    unsigned long h = (unsigned long) key;
+    h ^= h >> 33; h *= 0xff51afd7ed558ccdUL;
+    h ^= h >> 33; h *= 0xc4ceb9fe1a85ec53UL;
+    h ^= h >> 33;
+    return h;
+  }
+
+  //remove all entries, keeps the memory
+  void clear()
+  {
+    if (m_id != NULL) memset(m_id,-1,sizeof(long)*m_cap);
+    m_num = 0;
+  }
+
+  //add id with hash h
+  int insert(const unsigned long h, const long id)
+  {
+    if (2*(m_num+1) > m_cap && grow() != 0) {return 1;}
+    long slot = (long) (h & (unsigned long) (m_cap-1));
+    while (m_id[slot] != -1) {slot = (slot+1) & (m_cap-1);}
+    m_key[slot] = h;
+    m_id[slot] = id;
+    m_num++;
+    return 0;
+  }
+
+  //first inserted id with hash h for which eq(id) is true, or -1
+  template <class EQ>
+  long find(const unsigned long h, const EQ& eq) const
+  {
+    if (m_num == 0) return -1;
+    long slot = (long) (h & (unsigned long) (m_cap-1));
+    while (m_id[slot] != -1)
+    {
+      if (m_key[slot] == h && eq(m_id[slot])) {return m_id[slot];}
+      slot = (slot+1) & (m_cap-1);
+    }
+    return -1;
+  }
+
+  //double the capacity, and put the old entries back in order
+  int grow()
+  {
+    const long newcap = (m_cap == 0) ? 16 : 2*m_cap;
+    unsigned long* newkey = (unsigned long*) malloc(sizeof(unsigned long)*newcap);
+    long* newid = (long*) malloc(sizeof(long)*newcap);
+    if (newkey == NULL || newid == NULL)
+    {
+      printf("\nERROR ERROR ERROR\n");
+      printf("Phash::grow could not malloc %ld slots\n",newcap);
+      free(newkey); free(newid);
+      return 1;
+    }
+    memset(newid,-1,sizeof(long)*newcap);
+
+    //walk from an empty slot, so that each probe chain is in insert order
+    long start = 0;
+    while (start < m_cap && m_id[start] != -1) {start++;}
+    for (long i=0;i<m_cap;i++)
+    {
+      const long old = (start+i) & (m_cap-1);
+      if (m_id[old] == -1) continue;
+      long slot = (long) (m_key[old] & (unsigned long) (newcap-1));
+      while (newid[slot] != -1) {slot = (slot+1) & (newcap-1);}
+      newkey[slot] = m_key[old];
+      newid[slot] = m_id[old];
+    }
+    free(m_key); free(m_id);
+    m_key = newkey;
+    m_id = newid;
+    m_cap = newcap;
+    return 0;
+  }
+};
+
+#endif
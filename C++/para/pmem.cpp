@@ -0,0 +1,128 @@
+/*----------------------------------------------------------------------------
+  pmem.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for Pmem
+----------------------------------------------------------------------------*/
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "pmem.hpp"
+
+#define PMEM_NVAL 3   //live, peak, nalloc
+
+//----------------------------------------------------------------------------
+// report
+//	the totals of each task are gathered to the master. The tag names are
+//	gathered too, and their union sent back, so each task fills the 
+//	values of every tag and they are reduced with MAX (bytes) and SUM 
+//	(allocations)
+//----------------------------------------------------------------------------
+int Pmem::report(const Pworld& pworld, FILE* fp)
+{
+  #if defined LIBJ_MPI
+  const double GB = 1.0/(1024.0*1024.0*1024.0);
+  const libj::mem_stats S = libj::mem_total();
+  const std::vector<libj::mem_tag_entry> tags = libj::mem_tags();
+  const int ntasks = pworld.mpi_world_num_tasks;
+  const bool master = pworld.mpi_world_ismaster;
+
+  //totals of each task
+  const double mine[PMEM_NVAL] = {(double) S.live,(double) S.peak,(double) S.nalloc};
+  std::vector<double> all(master ? PMEM_NVAL*ntasks : 1);
+  if (MPI_Gather(mine,PMEM_NVAL,MPI_DOUBLE,all.data(),PMEM_NVAL,MPI_DOUBLE,0,
+                 pworld.comm_world) != MPI_SUCCESS)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pmem::report could not gather the totals\n");
+    return 1;
+  }
+
+  //the union of the tag names
+  std::string packed;
+  for (size_t t=0;t<tags.size();t++) {packed += tags[t].tag; packed += '\0';}
+  int bytes = (int) packed.size();
+  std::vector<int> counts(master ? ntasks : 1,0), displs(master ? ntasks : 1,0);
+  MPI_Gather(&bytes,1,MPI_INT,counts.data(),1,MPI_INT,0,pworld.comm_world);
+  long total = 0;
+  if (master)
+  {
+    for (int t=0;t<ntasks;t++) {displs[t] = (int) total; total += counts[t];}
+  }
+  std::vector<char> names(total+1);
+  if (MPI_Gatherv(packed.data(),bytes,MPI_CHAR,names.data(),counts.data(),displs.data(),
+                  MPI_CHAR,0,pworld.comm_world) != MPI_SUCCESS)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pmem::report could not gather the tags\n");
+    return 1;
+  }
+  std::vector<std::string> tag;
+  packed.clear();
+  if (master)
+  {
+    for (long beg=0,end=0;end<total;end++)
+    {
+      if (names[end] != '\0') continue;
+      tag.push_back(std::string(names.data()+beg,end-beg));
+      beg = end+1;
+    }
+    std::sort(tag.begin(),tag.end());
+    tag.erase(std::unique(tag.begin(),tag.end()),tag.end());
+    for (size_t t=0;t<tag.size();t++) {packed += tag[t]; packed += '\0';}
+  }
+  bytes = (int) packed.size();
+  MPI_Bcast(&bytes,1,MPI_INT,0,pworld.comm_world);
+  packed.resize(bytes);
+  MPI_Bcast(&packed[0],bytes,MPI_CHAR,0,pworld.comm_world);
+  if (!master)
+  {
+    for (size_t beg=0,end=0;end<packed.size();end++)
+    {
+      if (packed[end] != '\0') continue;
+      tag.push_back(packed.substr(beg,end-beg));
+      beg = end+1;
+    }
+  }
+
+  //both lists are sorted by name
+  const long ntag = (long) tag.size();
+  std::vector<double> val(PMEM_NVAL*ntag,0.0), vmax(PMEM_NVAL*ntag), vsum(PMEM_NVAL*ntag);
+  for (size_t t=0,m=0;t<tag.size();t++)
+  {
+    while (m < tags.size() && tags[m].tag < tag[t]) m++;
+    if (m == tags.size() || tags[m].tag != tag[t]) continue;
+    val[PMEM_NVAL*t+0] = (double) tags[m].stats.live;
+    val[PMEM_NVAL*t+1] = (double) tags[m].stats.peak;
+    val[PMEM_NVAL*t+2] = (double) tags[m].stats.nalloc;
+  }
+  if (MPI_Reduce(val.data(),vmax.data(),(int) val.size(),MPI_DOUBLE,MPI_MAX,0,pworld.comm_world) != MPI_SUCCESS ||
+      MPI_Reduce(val.data(),vsum.data(),(int) val.size(),MPI_DOUBLE,MPI_SUM,0,pworld.comm_world) != MPI_SUCCESS)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pmem::report could not reduce the tags\n");
+    return 1;
+  }
+  if (!master) return 0;
+
+  fprintf(fp,"\nlibj::mem : %d task(s)\n",ntasks);
+  fprintf(fp,"%-24s %12s %12s %10s\n","task","live GB","peak GB","nalloc");
+  double peak = 0.0;
+  for (int t=0;t<ntasks;t++)
+  {
+    const double* A = all.data() + PMEM_NVAL*t;
+    fprintf(fp,"%-24d %12.4f %12.4f %10.0f\n",t,GB*A[0],GB*A[1],A[2]);
+    peak = std::max(peak,A[1]);
+  }
+  fprintf(fp,"largest peak of a task : %.4f GB\n",GB*peak);
+  fprintf(fp,"%-24s %12s %12s %10s\n","tag","max live GB","max peak GB","nalloc");
+  for (long t=0;t<ntag;t++)
+  {
+    fprintf(fp,"%-24s %12.4f %12.4f %10.0f\n",tag[t].c_str(),GB*vmax[PMEM_NVAL*t+0],
+            GB*vmax[PMEM_NVAL*t+1],vsum[PMEM_NVAL*t+2]);
+  }
+  #else
+  libj::mem_print(fp);
+  #endif
+  return 0;
+}
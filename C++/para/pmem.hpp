@@ -0,0 +1,38 @@
+/*----------------------------------------------------------------------------
+  pmem.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for Pmem, which prints the libj memory accounting of every
+  task (see core/mem_registry.hpp) on the master : the live bytes, peak,
+  and allocations of each task, and for each tag the max over the tasks
+  of its live and peak bytes, and its total allocations.
+
+  NOTE : report is collective over comm_world
+
+//Usage
+libj::mem_tag tag("T2");
+...
+Pmem::report(pworld);           //prints on the master
+Pmem::report(pworld,fp);
+
+  Without MPI, report prints the accounting of this task.
+----------------------------------------------------------------------------*/
+#ifndef LIBJ_PMEM_HPP
+#define LIBJ_PMEM_HPP
+#include <stdio.h>
+
+#include "libjdef.h"
+#include "pworld.hpp"
+#include "mem_registry.hpp"
+
+#if defined LIBJ_MPI
+  #include <mpi.h>
+#endif
+
+struct Pmem
+{
+  //gather the accounting of all tasks, and print it on the master
+  static int report(const Pworld& pworld, FILE* fp = stdout);
+};
+
+#endif
@@ -1,12 +1,19 @@
 /*--------------------------------------------------------
   pprint.cpp
 	JHT, Febuary 7, 2022 : created
+	JHT, October 14, 2026 : print_all is one MPI_Gatherv, added
+	                        iprint_all and wait_all
+	JHT, October 14, 2026 : added the per-thread messages
+	JHT, October 14, 2026 : messages are kept in a packed Stringvec
+	JHT, October 14, 2026 : print_all and gather are traced
+	JHT, October 14, 2026 : added the node logs
 
 
   .cpp file for pprint, which stores (potentially parallel)
   print buffers
 --------------------------------------------------------*/
 #include "pprint.hpp"
+#include "trace.hpp"
 //--------------------------------------------------------
 // Pprint initializer 
 //--------------------------------------------------------
@@ -16,6 +23,19 @@ Pprint::Pprint()
   memset(buffer,(char)0,sizeof(char)*PPRINT_LEN);
   memset(stemp,(char)0,sizeof(char)*PPRINT_LEN);
   pbuffer = NULL;
+  sbuffer = NULL;
+  scap = 0;
+  gbuffer = NULL;
+  gcap = 0;
+  gcounts = NULL;
+  gdispls = NULL;
+  pending = false;
+  nmode = false;
+  memset(nprefix,(char)0,sizeof(char)*PPRINT_LEN);
+  nlog = NULL;
+  nmsgs = 0;
+  nbytes = 0;
+  nstop = false;
 }
 
 //--------------------------------------------------------
@@ -23,7 +43,21 @@ Pprint::Pprint()
 //--------------------------------------------------------
 Pprint::~Pprint()
 {
+  if (nthread.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> lock(nmutex);
+      nstop = true;
+    }
+    nwork.notify_one();
+    nthread.join();
+  }
+  if (nlog != NULL) fclose(nlog);
   if (pbuffer != NULL) free(pbuffer);
+  if (sbuffer != NULL) free(sbuffer);
+  if (gbuffer != NULL) free(gbuffer);
+  if (gcounts != NULL) free(gcounts);
+  if (gdispls != NULL) free(gdispls);
 }
 
 //--------------------------------------------------------
@@ -44,6 +78,16 @@ int Pprint::init(const Pworld& pworld)
              sizeof(char)*PPRINT_LEN*pworld.mpi_world_num_tasks);
       stat = 1;
     } 
+
+    gcounts = (int*) malloc(sizeof(int)*pworld.mpi_world_num_tasks);
+    gdispls = (int*) malloc(sizeof(int)*pworld.mpi_world_num_tasks);
+    if (gcounts == NULL || gdispls == NULL)
+    {
+      printf("\nERROR ERROR ERORR\n");
+      printf("Pprint::init could not malloc %ld bytes\n",
+             2*sizeof(int)*pworld.mpi_world_num_tasks);
+      stat = 1;
+    }
   }          
   return stat;
 }
@@ -54,11 +98,19 @@ int Pprint::init(const Pworld& pworld)
 int Pprint::destroy(const Pworld& pworld)
 {
   int stat = 0;
-  if (pworld.mpi_world_ismaster)
-  {
-    if (pbuffer != NULL) free(pbuffer);
-    pbuffer = NULL;
-  } 
+  if (nmode) stat = node_close(pworld);
+  if (pbuffer != NULL) free(pbuffer);
+  if (gbuffer != NULL) free(gbuffer);
+  if (gcounts != NULL) free(gcounts);
+  if (gdispls != NULL) free(gdispls);
+  pbuffer = NULL;
+  gbuffer = NULL;
+  gcounts = NULL;
+  gdispls = NULL;
+  gcap = 0;
+  if (sbuffer != NULL) free(sbuffer);
+  sbuffer = NULL;
+  scap = 0;
   return stat;
 }
 
@@ -127,12 +179,25 @@ int Pprint::vadd(const char* fstring, va_list arg)
   return stat;
 }
 
+//--------------------------------------------------------
+// Pprint tadd
+//	into the buffer of this thread, no lock
+//--------------------------------------------------------
+int Pprint::tadd(const char* fstring,...)
+{
+  va_list arg;
+  va_start(arg,fstring);
+  const int stat = ring.vtadd(fstring,arg);
+  va_end(arg);
+  return stat;
+}
+
 //--------------------------------------------------------
 // Pprint store
 //--------------------------------------------------------
 void Pprint::store()
 {
-  vec.push_back(buffer);
+  vec.push_back(buffer,idx);
   clear();
 }
 
@@ -163,51 +228,360 @@ void Pprint::clear()
 void Pprint::reset()
 {
   vec.clear();
+  ring.clear();
   clear();
 }
 
 //--------------------------------------------------------
 // print_all 
+//	all messages of a task are gathered at once, and
+//	printed in the same order as print(message) 
+//	would for each message
 //--------------------------------------------------------
 void Pprint::print_all(const Pworld& pworld) const
 {
+  LIBJ_TRACE_SCOPE("print_all","comm");
   //MPI code
   #if defined LIBJ_MPI
-  for (int message=0;message<vec.size;message++)
+  if (pending) wait_all(pworld);
+  if (gather(pworld,true) != 0) return;
+  if (nmode ? pworld.mpi_shared_ismaster : pworld.mpi_world_ismaster) print_gathered(pworld);
+
+  //Non-MPI code
+  #else
+  for (long message=0;message<vec.size;message++)
   {
-    //gather messages
-    MPI_Barrier(pworld.comm_world);
+    fwrite(vec[message],sizeof(char),vec.len(message),stdout);
+  }
+  fflush(stdout);
+  ring.print_all();
+  #endif
 
-    MPI_Gather(vec[message],
-               PPRINT_LEN,MPI_CHAR,
-               pbuffer+PPRINT_LEN*pworld.mpi_world_task_id,
-               PPRINT_LEN,MPI_CHAR,
-               0,
-               pworld.comm_world);
+}
 
-    //Print each message
-    if (pworld.mpi_world_ismaster)
+//--------------------------------------------------------
+// iprint_all
+//	starts gathering all messages, returns without
+//	waiting for them. The byte counts are still 
+//	gathered with a (small) blocking MPI_Gather
+//--------------------------------------------------------
+int Pprint::iprint_all(const Pworld& pworld) const
+{
+  //MPI code
+  #if defined LIBJ_MPI
+  if (pending) wait_all(pworld);
+  return gather(pworld,false);
+
+  //Non-MPI code
+  #else
+  print_all(pworld);
+  return 0;
+  #endif
+}
+
+//--------------------------------------------------------
+// wait_all
+//	finishes the pending iprint_all, and the master
+//	prints the messages
+//--------------------------------------------------------
+int Pprint::wait_all(const Pworld& pworld) const
+{
+  #if defined LIBJ_MPI
+  if (!pending) return 0;
+  MPI_Wait(&request,MPI_STATUS_IGNORE);
+  pending = false;
+  if (nmode ? pworld.mpi_shared_ismaster : pworld.mpi_world_ismaster) print_gathered(pworld);
+  #endif
+  return 0;
+}
+
+//--------------------------------------------------------
+// pack
+//	packs the messages as [nmsg][len_0...len_n-1][text]
+//	and the thread messages as [len][text], with no 
+//	padding, returns the number of bytes or -1
+//--------------------------------------------------------
+int Pprint::pack() const
+{
+  std::vector<char> threads;
+  ring.flush(threads);
+  const int tlen = (int) threads.size();
+
+  const int nmsg = (int) vec.size;
+  long bytes = sizeof(int)*(2+nmsg) + tlen;
+  for (int message=0;message<nmsg;message++) bytes += vec.len(message);
+  if (reserve(&sbuffer,&scap,bytes) != 0) return -1;
+
+  memcpy(sbuffer,&nmsg,sizeof(int));
+  char* text = sbuffer + sizeof(int)*(1+nmsg);
+  for (int message=0;message<nmsg;message++)
+  {
+    const int len = (int) vec.len(message);
+    memcpy(sbuffer+sizeof(int)*(1+message),&len,sizeof(int));
+    memcpy(text,vec[message],sizeof(char)*len);
+    text += len;
+  }
+  memcpy(text,&tlen,sizeof(int));
+  if (tlen > 0) memcpy(text+sizeof(int),threads.data(),sizeof(char)*tlen);
+  return (int) bytes;
+}
+
+//--------------------------------------------------------
+// gather
+//	gathers the byte counts to the master, then the
+//	packed messages with one MPI_Gatherv (or Igatherv).
+//	With the node logs, to the shared root of each node
+//--------------------------------------------------------
+int Pprint::gather(const Pworld& pworld, const bool blocking) const
+{
+  LIBJ_TRACE_SCOPE("print_gather","comm");
+  int stat = 0;
+  #if defined LIBJ_MPI
+  int bytes = pack();
+  if (bytes < 0) {bytes = 0; stat = 1;}
+
+  const MPI_Comm comm = nmode ? pworld.comm_shared : pworld.comm_world;
+  const bool     root = nmode ? pworld.mpi_shared_ismaster : pworld.mpi_world_ismaster;
+  const int    ntasks = nmode ? pworld.mpi_shared_num_tasks : pworld.mpi_world_num_tasks;
+  MPI_Gather(&bytes,1,MPI_INT,gcounts,1,MPI_INT,0,comm);
+
+  if (root)
+  {
+    long total = 0;
+    for (int task=0;task<ntasks;task++)
     {
-      for (int task=0;task<pworld.mpi_world_num_tasks;task++)
-      {
-        printf("%s",pbuffer+PPRINT_LEN*task);
-      }
+      gdispls[task] = (int) total;
+      total += gcounts[task];
+    }
+    if (reserve(&gbuffer,&gcap,total) != 0) {MPI_Abort(pworld.comm_world,1);}
+  }
 
-      //clean the message buffer
-      memset(pbuffer,(char)0,sizeof(char)*PPRINT_LEN*pworld.mpi_world_num_tasks);
+  if (blocking)
+  {
+    MPI_Gatherv(sbuffer,bytes,MPI_CHAR,
+                gbuffer,gcounts,gdispls,MPI_CHAR,
+                0,comm);
+  } else {
+    MPI_Igatherv(sbuffer,bytes,MPI_CHAR,
+                 gbuffer,gcounts,gdispls,MPI_CHAR,
+                 0,comm,&request);
+    pending = true;
+  }
+  #endif
+  return stat;
+}
+
+//--------------------------------------------------------
+// print_gathered
+//	to stdout, or to the writer of the node log. The 
+//	master is task 0 of its node, and its own messages
+//	still go to stdout
+//--------------------------------------------------------
+void Pprint::print_gathered(const Pworld& pworld) const
+{
+  std::vector<char> out;
+  if (!nmode)
+  {
+    unpack(gbuffer,gcounts,gdispls,pworld.mpi_world_num_tasks,out);
+    if (!out.empty()) fwrite(out.data(),sizeof(char),out.size(),stdout);
+    return;
+  }
+
+  if (pworld.mpi_world_ismaster)
+  {
+    unpack(gbuffer,gcounts,gdispls,1,out);
+    if (!out.empty()) fwrite(out.data(),sizeof(char),out.size(),stdout);
+    out.clear();
+  }
+  nmsgs += unpack(gbuffer,gcounts,gdispls,pworld.mpi_shared_num_tasks,out);
+  nbytes += (long) out.size();
+  if (out.empty()) return;
+  {
+    std::lock_guard<std::mutex> lock(nmutex);
+    nqueue.push_back(std::vector<char>());
+    nqueue.back().swap(out);
+  }
+  nwork.notify_one();
+}
+
+//--------------------------------------------------------
+// unpack
+//	message 0 of each task, then message 1, etc, then
+//	the thread messages of each task. off is the offset
+//	of the next message text of each task
+//--------------------------------------------------------
+long Pprint::unpack(const char* gbuf, const int* counts, const int* displs,
+                    const int ntasks, std::vector<char>& out)
+{
+  std::vector<int> off(ntasks);
+  int maxmsg = 0;
+  for (int task=0;task<ntasks;task++)
+  {
+    int nmsg = 0;
+    if (counts[task] > 0) memcpy(&nmsg,gbuf+displs[task],sizeof(int));
+    if (nmsg > maxmsg) maxmsg = nmsg;
+    off[task] = (counts[task] > 0) ? (int) sizeof(int)*(1+nmsg) : 0;
+  }
+
+  long num = 0;
+  for (int message=0;message<maxmsg;message++)
+  {
+    for (int task=0;task<ntasks;task++)
+    {
+      if (off[task] == 0) continue;
+      const char* base = gbuf+displs[task];
+      int nmsg, len;
+      memcpy(&nmsg,base,sizeof(int));
+      if (message >= nmsg) continue;
+      memcpy(&len,base+sizeof(int)*(1+message),sizeof(int));
+      out.insert(out.end(),base+off[task],base+off[task]+len);
+      off[task] += len;
+      if (len > 0) num++;
     }
+  }
 
-  } 
+  for (int task=0;task<ntasks;task++)
+  {
+    if (off[task] == 0) continue;
+    const char* base = gbuf+displs[task]+off[task];
+    int tlen;
+    memcpy(&tlen,base,sizeof(int));
+    if (tlen > 0) {out.insert(out.end(),base+sizeof(int),base+sizeof(int)+tlen); num++;}
+  }
+  return num;
+}
 
-  //Non-MPI code
-  #else
-  for (int message=0;message<vec.size;message++)
+//--------------------------------------------------------
+// node_log
+//	the shared roots open prefix.node<n>.log and start
+//	their writer, and the gather buffers of a node are 
+//	made on them. NULL closes the logs
+//--------------------------------------------------------
+int Pprint::node_log(const Pworld& pworld, const char* prefix)
+{
+  int stat = 0;
+  #if defined LIBJ_MPI
+  if (pending) wait_all(pworld);
+  if (nmode) stat = node_close(pworld);
+  if (prefix == NULL) return stat;
+  if (strlen(prefix) + 32 > PPRINT_LEN)
   {
-    printf("%s",vec[message]);
-    memset(pbuffer,(char)0,sizeof(char)*PPRINT_LEN*pworld.mpi_world_num_tasks);
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pprint::node_log prefix is too long\n");
+    return 1;
+  }
+  strcpy(nprefix,prefix);
+
+  if (pworld.mpi_shared_ismaster)
+  {
+    if (gcounts == NULL)
+    {
+      gcounts = (int*) malloc(sizeof(int)*pworld.mpi_shared_num_tasks);
+      gdispls = (int*) malloc(sizeof(int)*pworld.mpi_shared_num_tasks);
+      if (gcounts == NULL || gdispls == NULL) stat = 1;
+    }
+    char name[PPRINT_LEN];
+    snprintf(name,PPRINT_LEN,"%s.node%d.log",nprefix,pworld.mpi_node);
+    nlog = fopen(name,"w");
+    if (nlog == NULL)
+    {
+      printf("\nERROR ERROR ERROR\n");
+      printf("Pprint::node_log could not open %s\n",name);
+      stat = 1;
+    } else {
+      nmsgs = 0;
+      nbytes = 0;
+      nstop = false;
+      nthread = std::thread(&Pprint::node_loop,this);
+    }
+  }
+  MPI_Allreduce(MPI_IN_PLACE,&stat,1,MPI_INT,MPI_MAX,pworld.comm_world);
+  if (stat != 0)
+  {
+    nmode = true;
+    node_close(pworld);
+    return stat;
   }
+  nmode = true;
   #endif
+  return stat;
+}
 
+//--------------------------------------------------------
+// node_loop
+//	writes the queued buffers, until told to stop and
+//	the queue is empty
+//--------------------------------------------------------
+void Pprint::node_loop()
+{
+  std::unique_lock<std::mutex> lock(nmutex);
+  while (true)
+  {
+    nwork.wait(lock,[&]{return nstop || !nqueue.empty();});
+    if (nqueue.empty()) break;
+    std::vector<char> buf;
+    buf.swap(nqueue.front());
+    nqueue.pop_front();
+    lock.unlock();
+    LIBJ_TRACE_SCOPE_ARG("node_log","io",(long) buf.size());
+    fwrite(buf.data(),sizeof(char),buf.size(),nlog);
+    fflush(nlog);
+    lock.lock();
+  }
+}
+
+//--------------------------------------------------------
+// node_close
+//	waits for the writers, and the master prints the 
+//	messages and bytes of all of the logs
+//--------------------------------------------------------
+int Pprint::node_close(const Pworld& pworld)
+{
+  #if defined LIBJ_MPI
+  if (pending) wait_all(pworld);
+  if (nthread.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> lock(nmutex);
+      nstop = true;
+    }
+    nwork.notify_one();
+    nthread.join();
+  }
+  if (nlog != NULL) {fclose(nlog); nlog = NULL;}
+  nmode = false;
+
+  long sums[2] = {nmsgs,nbytes};
+  MPI_Reduce(pworld.mpi_world_ismaster ? MPI_IN_PLACE : sums,sums,2,MPI_LONG,MPI_SUM,
+             0,pworld.comm_world);
+  if (pworld.mpi_world_ismaster)
+  {
+    printf("Pprint wrote %ld messages, %ld bytes, to %s.node*.log\n",sums[0],sums[1],nprefix);
+    fflush(stdout);
+  }
+  nmsgs = 0;
+  nbytes = 0;
+  #endif
+  return 0;
+}
+
+//--------------------------------------------------------
+// reserve
+//--------------------------------------------------------
+int Pprint::reserve(char** buf, long* cap, const long bytes)
+{
+  if (bytes <= *cap) return 0;
+  const long newcap = (bytes > 2*(*cap)) ? bytes : 2*(*cap);
+  char* newbuf = (char*) realloc(*buf,sizeof(char)*newcap);
+  if (newbuf == NULL)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pprint::reserve could not realloc %ld bytes\n",newcap);
+    return 1;
+  }
+  *buf = newbuf;
+  *cap = newcap;
+  return 0;
 }
 
 //-------------------------------------------------------------------
@@ -217,9 +591,12 @@ void Pprint::print(const Pworld& pworld, const int message) const
 
   //MPI code
   #if defined LIBJ_MPI
-  //gather messages
+  //gather messages, each in a PPRINT_LEN slot
+  char slot[PPRINT_LEN];
+  memset(slot,(char)0,sizeof(char)*PPRINT_LEN);
+  if (message < vec.size) memcpy(slot,vec[message],sizeof(char)*vec.len(message));
   MPI_Barrier(pworld.comm_world);
-  MPI_Gather(vec[message],
+  MPI_Gather(slot,
              PPRINT_LEN,MPI_CHAR,
              pbuffer+PPRINT_LEN*pworld.mpi_world_task_id,
              PPRINT_LEN,MPI_CHAR,
@@ -1,6 +1,11 @@
 /*------------------------------------------------------------------------
   pprint.h
 	JHT, Feburary 4, 2022 : created
+	JHT, October 14, 2026 : print_all is one variable-length gather,
+	                        added iprint_all and wait_all
+	JHT, October 14, 2026 : added the per-thread messages
+	JHT, October 14, 2026 : messages are kept in a packed Stringvec
+	JHT, October 14, 2026 : added the node logs
 
   .h file for Prprint and Stringvec
 
@@ -27,12 +32,51 @@ buf.addstore("testing testing"); //add and store buffer in one step
 
 //Printing
 buf.print_all();		 //print all messages
+buf.iprint_all();		 //start gathering all messages, non-blocking
+buf.wait_all();			 //finish iprint_all and print
 buf.print(2);                    //prints the n'th message, index from zero
 
+//Threads, inside an OpenMP parallel region (see Printring in aprint.hpp)
+buf.tadd("thread %d done\n",omp_get_thread_num()); //formatted now
+buf.tlog("block %ld %f\n",blk,dt);                 //formatted at print_all
+
 //Clearing
 buf.clear();			 //clears an unstored buffer
 buf.reset();			 //reset buffer and stored messages
 
+//Node logs
+buf.node_log(pworld,"run");	 //messages to run.node<n>.log, collective
+buf.node_log(pworld,NULL);	 //back to the master, collective
+
+  NOTE : print_all packs all of a task's messages into one buffer of their
+	 actual lengths, [nmsg][len_0...len_n-1][text], and gathers them to
+	 the master with a single MPI_Gatherv. The master prints message 0
+	 of every task, then message 1 of every task, etc, as before. Tasks
+	 may have different numbers of messages.
+
+  NOTE : iprint_all does the same with MPI_Igatherv, so compute can go on
+	 while the messages are gathered. The messages are packed when it is
+	 called, so the buffer can be reset and reused before wait_all. Only
+	 one iprint_all can be pending at a time.
+
+  NOTE : with node_log, print_all (and iprint_all) gather the messages of
+	 each node to its shared root only (comm_shared), which hands them
+	 to a writer thread that appends them to prefix.node<mpi_node>.log,
+	 in the order the master would print them, and returns. Nothing is
+	 sent between the nodes, so verbose output costs what it costs on
+	 one node. The master (the shared root of node 0) still prints its
+	 own messages to stdout, which are the summary : the print_master_* 
+	 messages are only stored on the master. node_log(pworld,NULL), or
+	 destroy, waits for the writers, closes the logs, and the master 
+	 prints one line of the messages and bytes written to them.
+	 Without MPI there is only the master, and node_log does nothing.
+
+  NOTE : the thread messages of a task are packed after its messages, as
+	 [len][text] in (thread, sequence) order, and the master prints
+	 them after all of the stored messages, in (task, thread, 
+	 sequence) order. tadd and tlog do not lock, so each thread only
+	 touches its own buffer. reset drops them.
+
 -------------------------------------------------------------------------*/
 #ifndef PPRINT_HPP
 #define PPRINT_HPP
@@ -40,10 +84,16 @@ buf.reset();			 //reset buffer and stored messages
 #include <string.h>
 #include <stdlib.h>
 #include <stdarg.h>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 #include "libjdef.h"
 #include "pworld.hpp"
 #include "strvec.hpp"
+#include "aprint.hpp"
 
 #define PPRINT_RES 10
 #define PPRINT_LEN 1024 
@@ -67,7 +117,32 @@ struct Pprint
   char               stemp[PPRINT_LEN];
   char               buffer[PPRINT_LEN];
   char*              pbuffer;
-  Strvec<PPRINT_LEN> vec;
+  Stringvec          vec;		//stored messages, packed
+  Printring          ring;		//messages of the threads
+
+  //gather buffers for print_all
+  mutable char*      sbuffer;		//packed messages of this task
+  mutable long       scap;		//bytes allocated in sbuffer
+  mutable char*      gbuffer;		//gathered messages, master only
+  mutable long       gcap;		//bytes allocated in gbuffer
+  int*               gcounts;		//bytes from each task, master only
+  int*               gdispls;		//displacements of each task, master only
+  mutable bool       pending;		//an iprint_all has not been waited on
+  #if defined LIBJ_MPI
+    mutable MPI_Request request;	//request of the pending iprint_all
+  #endif
+
+  //node logs, the file and writer thread are on the shared roots
+  bool               nmode;		//messages go to the node logs
+  char               nprefix[PPRINT_LEN];	//prefix of the log names
+  FILE*              nlog;		//log of this node
+  mutable long       nmsgs;		//messages given to the log
+  mutable long       nbytes;		//bytes given to the log
+  std::thread        nthread;		//writer thread
+  mutable std::mutex nmutex;		//guards nqueue and nstop
+  mutable std::condition_variable nwork;	//a buffer was queued
+  mutable std::deque<std::vector<char>> nqueue;	//buffers to write
+  bool               nstop;		//tells the writer to stop
 
   //Initializer
   Pprint();
@@ -87,6 +162,14 @@ struct Pprint
   //Add a formatted string with variable input data
   int vadd(const char* fstring,va_list arg);
 
+  //Add a message of this thread, formatted now
+  int tadd(const char* fstring,...);
+  int vtadd(const char* fstring,va_list arg) {return ring.vtadd(fstring,arg);}
+
+  //Add a message of this thread, formatted at print_all
+  template <class...Args>
+  int tlog(const char* fstring, const Args...args) {return ring.tlog(fstring,args...);}
+
   //Store buffer into vec, clear buffer
   void store();
 
@@ -102,11 +185,45 @@ struct Pprint
   //print all messages
   void print_all(const Pworld& pworld) const;
 
+  //start gathering all messages, non-blocking
+  int iprint_all(const Pworld& pworld) const;
+
+  //finish the pending iprint_all and print 
+  int wait_all(const Pworld& pworld) const;
+
   //print specific messages
   void print(const Pworld& pworld, const int message) const;
 
+  //messages to a log of each node (prefix not NULL), or to the master
+  int node_log(const Pworld& pworld, const char* prefix);
+
   //get size
-  int size() const {return vec.size;}
+  int size() const {return (int) vec.size;}
+
+  private:
+
+  //pack the messages into sbuffer, returns the number of bytes
+  int pack() const;
+
+  //gather the byte counts and start the gather of the messages
+  int gather(const Pworld& pworld, const bool blocking) const;
+
+  //print the gathered messages, master only, or queue them for the 
+  //node log, shared roots only
+  void print_gathered(const Pworld& pworld) const;
+
+  //the gathered messages of ntasks in print order, returns the number
+  static long unpack(const char* gbuf, const int* counts, const int* displs,
+                     const int ntasks, std::vector<char>& out);
+
+  //writer thread of the node log
+  void node_loop();
+
+  //stop the writer and close the node log, collective
+  int node_close(const Pworld& pworld);
+
+  //grow a buffer to at least bytes
+  static int reserve(char** buf, long* cap, const long bytes);
 
 };
 
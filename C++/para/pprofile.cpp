@@ -0,0 +1,145 @@
+/*----------------------------------------------------------------------------
+  pprofile.cpp
+	JHT, October 14, 2026 : created
+	JHT, October 14, 2026 : added the hardware counters
+
+  .cpp file for Pprofile
+----------------------------------------------------------------------------*/
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "pprofile.hpp"
+
+#define PPROFILE_NVAL (4+libj::PROFILE_NCOUNT)  //calls, incl, excl, bytes, counts
+
+//----------------------------------------------------------------------------
+// pprofile_less
+//----------------------------------------------------------------------------
+static bool pprofile_less(const libj::profile_entry& a, const std::string& b)
+{
+  return libj::profile_path_less(a.path,b);
+}
+
+//----------------------------------------------------------------------------
+// report
+//	the master gathers the paths of all tasks, and sends back their
+//	union. Each task then fills the values of the union, and they are
+//	reduced to the master with MIN, MAX, and SUM
+//----------------------------------------------------------------------------
+int Pprofile::report(const Pworld& pworld, FILE* fp)
+{
+  const std::vector<libj::profile_entry> local = libj::profile_merge();
+
+  #if defined LIBJ_MPI
+  const int ntasks = pworld.mpi_world_num_tasks;
+  const bool master = pworld.mpi_world_ismaster;
+
+  //paths of this task, each ended by a '\0'
+  std::string packed;
+  for (size_t i=0;i<local.size();i++) {packed += local[i].path; packed += '\0';}
+
+  int bytes = (int) packed.size();
+  std::vector<int> counts(master ? ntasks : 1,0), displs(master ? ntasks : 1,0);
+  if (MPI_Gather(&bytes,1,MPI_INT,counts.data(),1,MPI_INT,0,pworld.comm_world) != MPI_SUCCESS)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pprofile::report could not gather the path lengths\n");
+    return 1;
+  }
+  long total = 0;
+  if (master)
+  {
+    for (int t=0;t<ntasks;t++) {displs[t] = (int) total; total += counts[t];}
+  }
+  std::vector<char> all(total+1);
+  if (MPI_Gatherv(packed.data(),bytes,MPI_CHAR,all.data(),counts.data(),displs.data(),
+                  MPI_CHAR,0,pworld.comm_world) != MPI_SUCCESS)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pprofile::report could not gather the paths\n");
+    return 1;
+  }
+
+  //the union of the paths, in the order of profile_merge
+  std::vector<std::string> paths;
+  packed.clear();
+  if (master)
+  {
+    for (long beg=0,end=0;end<total;end++)
+    {
+      if (all[end] != '\0') continue;
+      paths.push_back(std::string(all.data()+beg,end-beg));
+      beg = end+1;
+    }
+    std::sort(paths.begin(),paths.end(),libj::profile_path_less);
+    paths.erase(std::unique(paths.begin(),paths.end()),paths.end());
+    for (size_t i=0;i<paths.size();i++) {packed += paths[i]; packed += '\0';}
+  }
+  bytes = (int) packed.size();
+  MPI_Bcast(&bytes,1,MPI_INT,0,pworld.comm_world);
+  packed.resize(bytes);
+  if (MPI_Bcast(&packed[0],bytes,MPI_CHAR,0,pworld.comm_world) != MPI_SUCCESS)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pprofile::report could not broadcast the paths\n");
+    return 1;
+  }
+  if (!master)
+  {
+    for (size_t beg=0,end=0;end<packed.size();end++)
+    {
+      if (packed[end] != '\0') continue;
+      paths.push_back(packed.substr(beg,end-beg));
+      beg = end+1;
+    }
+  }
+
+  //values of this task on the union, 0 if it has not been entered
+  const long nval = PPROFILE_NVAL*(long) paths.size();
+  std::vector<double> val(nval,0.0), vmin(nval), vmax(nval), vsum(nval);
+  for (size_t i=0;i<paths.size();i++)
+  {
+    std::vector<libj::profile_entry>::const_iterator it =
+      std::lower_bound(local.begin(),local.end(),paths[i],pprofile_less);
+    if (it == local.end() || it->path != paths[i]) continue;
+    val[PPROFILE_NVAL*i+0] = it->calls;
+    val[PPROFILE_NVAL*i+1] = it->incl;
+    val[PPROFILE_NVAL*i+2] = it->excl;
+    val[PPROFILE_NVAL*i+3] = it->bytes;
+    for (int c=0;c<libj::PROFILE_NCOUNT;c++) {val[PPROFILE_NVAL*i+4+c] = it->counts[c];}
+  }
+  if (MPI_Reduce(val.data(),vmin.data(),(int) nval,MPI_DOUBLE,MPI_MIN,0,pworld.comm_world) != MPI_SUCCESS ||
+      MPI_Reduce(val.data(),vmax.data(),(int) nval,MPI_DOUBLE,MPI_MAX,0,pworld.comm_world) != MPI_SUCCESS ||
+      MPI_Reduce(val.data(),vsum.data(),(int) nval,MPI_DOUBLE,MPI_SUM,0,pworld.comm_world) != MPI_SUCCESS)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pprofile::report could not reduce the regions\n");
+    return 1;
+  }
+  if (!master) return 0;
+
+  std::vector<libj::profile_entry> emin(paths.size()), eavg(paths.size()), emax(paths.size());
+  for (size_t i=0;i<paths.size();i++)
+  {
+    const double* m = vmin.data() + PPROFILE_NVAL*i;
+    const double* M = vmax.data() + PPROFILE_NVAL*i;
+    const double* s = vsum.data() + PPROFILE_NVAL*i;
+    libj::profile_entry a = {paths[i],m[0],m[1],m[2],m[3],{0}};
+    libj::profile_entry b = {paths[i],s[0]/ntasks,s[1]/ntasks,s[2]/ntasks,s[3]/ntasks,{0}};
+    libj::profile_entry c = {paths[i],M[0],M[1],M[2],M[3],{0}};
+    for (int k=0;k<libj::PROFILE_NCOUNT;k++)
+    {
+      a.counts[k] = m[4+k];
+      b.counts[k] = s[4+k]/ntasks;
+      c.counts[k] = M[4+k];
+    }
+    emin[i] = a;
+    eavg[i] = b;
+    emax[i] = c;
+  }
+  libj::profile_print(fp,ntasks,emin,eavg,emax);
+  #else
+  libj::profile_print(fp,1,local,local,local);
+  #endif
+  return 0;
+}
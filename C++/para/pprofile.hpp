@@ -0,0 +1,39 @@
+/*----------------------------------------------------------------------------
+  pprofile.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for Pprofile, which merges the profile regions of all tasks
+  (see timer/profile.hpp) and prints them on the master, with the min, avg,
+  and max over the tasks of the time of each region. A region that a task
+  did not enter counts as 0 calls and 0 seconds on that task.
+
+  NOTE : report is collective over comm_world, and must be called outside
+         of any region and OpenMP parallel region
+
+//Usage
+LIBJ_PROFILE_SCOPE("ccsd");
+...
+Pprofile::report(pworld);         //prints on the master
+Pprofile::report(pworld,fp);
+
+  Without MPI, report prints the regions of this task.
+----------------------------------------------------------------------------*/
+#ifndef LIBJ_PPROFILE_HPP
+#define LIBJ_PPROFILE_HPP
+#include <stdio.h>
+
+#include "libjdef.h"
+#include "pworld.hpp"
+#include "profile.hpp"
+
+#if defined LIBJ_MPI
+  #include <mpi.h>
+#endif
+
+struct Pprofile
+{
+  //merge the regions over the tasks, and print them on the master
+  static int report(const Pworld& pworld, FILE* fp = stdout);
+};
+
+#endif
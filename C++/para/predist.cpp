@@ -0,0 +1,337 @@
+/*----------------------------------------------------------------------------
+  predist.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for Predist and the layouts, see predist.hpp
+----------------------------------------------------------------------------*/
+#include "predist.hpp"
+#include "trace.hpp"
+#include <string.h>
+#include <limits.h>
+#include <algorithm>
+
+//----------------------------------------------------------------------------
+// Playout_pdata
+//----------------------------------------------------------------------------
+Playout_pdata::Playout_pdata(const Pdata& pdata, const long list_id)
+  : m_pdata(&pdata), m_list_id(list_id)
+{
+  const long num = pdata.num_index(list_id);
+  const long elem = pdata.elem_bytes(list_id);
+  m_start.assign(num+1,0);
+  for (long index=0;index<num;index++)
+  {
+    m_start[index+1] = m_start[index] + elem*pdata.index_size(list_id,index);
+  }
+}
+
+void Playout_pdata::mine(const int task, std::vector<Ppiece>& pieces) const
+{
+  const long num = (long) m_start.size() - 1;
+  for (long index=0;index<num;index++)
+  {
+    if (m_pdata->index_task(m_list_id,index) != task) continue;
+    if (m_start[index+1] == m_start[index]) continue;
+    Ppiece piece = {m_start[index],m_start[index+1] - m_start[index],task,
+                    m_pdata->index_mem_pos(m_list_id,index)};
+    pieces.push_back(piece);
+  }
+}
+
+void Playout_pdata::split(const long global, const long bytes, std::vector<Ppiece>& pieces) const
+{
+  const long end = global + bytes;
+  long index = (long) (std::upper_bound(m_start.begin(),m_start.end(),global) - m_start.begin()) - 1;
+  for (long g=global;g<end;index++)
+  {
+    const long stop = std::min(end,m_start[index+1]);
+    if (stop <= g) continue;
+    Ppiece piece = {g,stop - g,m_pdata->index_task(m_list_id,index),
+                    m_pdata->index_mem_pos(m_list_id,index) + (g - m_start[index])};
+    pieces.push_back(piece);
+    g = stop;
+  }
+}
+
+//----------------------------------------------------------------------------
+// Playout_dist
+//	a piece is the part of one row block in one col
+//----------------------------------------------------------------------------
+void Playout_dist::mine(const int task, std::vector<Ppiece>& pieces) const
+{
+  const int pos = m_pos.empty() ? task : m_pos[task];
+  const int r = pos / m_npcol, c = pos % m_npcol;
+  if (r >= m_nprow) return;
+  const long mloc = Pgrid::numroc(m_M,m_mb,r,m_nprow);
+  const long nloc = Pgrid::numroc(m_N,m_nb,c,m_npcol);
+  const long ld = std::max(mloc,1L);
+  for (long lj=0;lj<nloc;lj++)
+  {
+    const long j = ((lj/m_nb)*m_npcol + c)*m_nb + lj % m_nb;
+    for (long li=0;li<mloc;li+=m_mb)
+    {
+      const long i = ((li/m_mb)*m_nprow + r)*m_mb;
+      const long len = std::min(m_mb,m_M - i);
+      Ppiece piece = {(i + m_M*j)*m_elem,len*m_elem,task,(li + ld*lj)*m_elem};
+      pieces.push_back(piece);
+    }
+  }
+}
+
+void Playout_dist::split(const long global, const long bytes, std::vector<Ppiece>& pieces) const
+{
+  const long e1 = (global + bytes)/m_elem;
+  for (long e=global/m_elem;e<e1;)
+  {
+    const long j = e / m_M, i = e % m_M;
+    const long ib = i / m_mb, jb = j / m_nb;
+    const long len = std::min(std::min((ib+1)*m_mb,m_M) - i,e1 - e);
+    const int r = (int) (ib % m_nprow), c = (int) (jb % m_npcol);
+    const long li = (ib/m_nprow)*m_mb + i % m_mb;
+    const long lj = (jb/m_npcol)*m_nb + j % m_nb;
+    const long ld = std::max(Pgrid::numroc(m_M,m_mb,r,m_nprow),1L);
+    const int task = m_task.empty() ? r*m_npcol + c : m_task[r*m_npcol + c];
+    Ppiece piece = {e*m_elem,len*m_elem,task,(li + ld*lj)*m_elem};
+    pieces.push_back(piece);
+    e += len;
+  }
+}
+
+//----------------------------------------------------------------------------
+// Predist::plan
+//	the sends are the pieces of dst covering this task's pieces of src,
+//	and the receives those of src covering its pieces of dst. Both are in
+//	stream order, so the two ends of each message agree on it
+//----------------------------------------------------------------------------
+int Predist::plan(const Pworld& pworld, const Playout& src, const Playout& dst)
+{
+  if (src.bytes() != dst.bytes())
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Predist::plan layouts of %ld and %ld bytes\n",src.bytes(),dst.bytes());
+    return 1;
+  }
+  const int me = pworld.mpi_world_task_id;
+  const int ntask = pworld.mpi_world_num_tasks;
+  m_send.assign(ntask,std::vector<run>());
+  m_recv.assign(ntask,std::vector<run>());
+  m_send_bytes.assign(ntask,0);
+  m_recv_bytes.assign(ntask,0);
+  m_self.clear();
+
+  std::vector<Ppiece> own, other;
+  src.mine(me,own);
+  for (size_t k=0;k<own.size();k++)
+  {
+    other.clear();
+    dst.split(own[k].m_global,own[k].m_bytes,other);
+    for (size_t l=0;l<other.size();l++)
+    {
+      const Ppiece& o = other[l];
+      const long from = own[k].m_local + (o.m_global - own[k].m_global);
+      if (o.m_task == me)
+      {
+        if (!m_self.empty() && m_self.back().m_from + m_self.back().m_bytes == from
+                            && m_self.back().m_to + m_self.back().m_bytes == o.m_local)
+        {
+          m_self.back().m_bytes += o.m_bytes;
+        } else {
+          copy c = {from,o.m_local,o.m_bytes};
+          m_self.push_back(c);
+        }
+        continue;
+      }
+      std::vector<run>& runs = m_send[o.m_task];
+      if (!runs.empty() && runs.back().m_local + runs.back().m_bytes == from)
+      {
+        runs.back().m_bytes += o.m_bytes;
+      } else {
+        run r = {from,o.m_bytes};
+        runs.push_back(r);
+      }
+      m_send_bytes[o.m_task] += o.m_bytes;
+    }
+  }
+
+  own.clear();
+  dst.mine(me,own);
+  for (size_t k=0;k<own.size();k++)
+  {
+    other.clear();
+    src.split(own[k].m_global,own[k].m_bytes,other);
+    for (size_t l=0;l<other.size();l++)
+    {
+      const Ppiece& o = other[l];
+      if (o.m_task == me) continue;
+      const long to = own[k].m_local + (o.m_global - own[k].m_global);
+      std::vector<run>& runs = m_recv[o.m_task];
+      if (!runs.empty() && runs.back().m_local + runs.back().m_bytes == to)
+      {
+        runs.back().m_bytes += o.m_bytes;
+      } else {
+        run r = {to,o.m_bytes};
+        runs.push_back(r);
+      }
+      m_recv_bytes[o.m_task] += o.m_bytes;
+    }
+  }
+
+  m_planned = true;
+  return 0;
+}
+
+long Predist::send_bytes() const
+{
+  long bytes = 0;
+  for (size_t p=0;p<m_send_bytes.size();p++) bytes += m_send_bytes[p];
+  return bytes;
+}
+
+long Predist::recv_bytes() const
+{
+  long bytes = 0;
+  for (size_t p=0;p<m_recv_bytes.size();p++) bytes += m_recv_bytes[p];
+  return bytes;
+}
+
+//----------------------------------------------------------------------------
+// predist_cursor
+//	position in the runs of one task, copies the next n bytes between
+//	the memory and a buffer
+//----------------------------------------------------------------------------
+struct predist_cursor
+{
+  size_t m_run;
+  long   m_off;
+};
+
+template <typename R>
+static void predist_move(const std::vector<R>& runs, predist_cursor& cur, long n,
+                         char* mem, char* buf, const bool pack)
+{
+  while (n > 0)
+  {
+    const R& r = runs[cur.m_run];
+    const long len = std::min(n,r.m_bytes - cur.m_off);
+    if (pack) {
+      memcpy(buf,mem + r.m_local + cur.m_off,len);
+    } else {
+      memcpy(mem + r.m_local + cur.m_off,buf,len);
+    }
+    buf += len;
+    n -= len;
+    cur.m_off += len;
+    if (cur.m_off == r.m_bytes) {cur.m_run++; cur.m_off = 0;}
+  }
+}
+
+//----------------------------------------------------------------------------
+// Predist::execute
+//	the message to each task is cut into the same number of rounds on
+//	every task (ceil of its bytes over the rounds), so both ends cut it
+//	the same way
+//----------------------------------------------------------------------------
+int Predist::execute(const Pworld& pworld, const void* src, void* dst, const long budget) const
+{
+  if (!m_planned)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Predist::execute called before plan\n");
+    return 1;
+  }
+  LIBJ_TRACE_SCOPE_ARG("redistribute","comm",send_bytes());
+  const char* from = (const char*) src;
+  char* to = (char*) dst;
+
+  #if defined LIBJ_MPI
+  const int ntask = pworld.mpi_world_num_tasks;
+  const long cap = std::max(std::min(budget/4,(long) INT_MAX - ntask),1L);
+  long rounds = (std::max(send_bytes(),recv_bytes()) + cap - 1)/cap;
+  MPI_Allreduce(MPI_IN_PLACE,&rounds,1,MPI_LONG,MPI_MAX,pworld.comm_world);
+
+  //bytes of each message in each round, and the buffer of a round
+  std::vector<long> schunk(ntask), rchunk(ntask);
+  long sbytes = 0, rbytes = 0;
+  for (int p=0;p<ntask && rounds > 0;p++)
+  {
+    schunk[p] = (m_send_bytes[p] + rounds - 1)/rounds;
+    rchunk[p] = (m_recv_bytes[p] + rounds - 1)/rounds;
+    sbytes += schunk[p];
+    rbytes += rchunk[p];
+  }
+  std::vector<char> sbuf[2], rbuf[2];
+  std::vector<int> scount[2], sdispl[2], rcount[2], rdispl[2];
+  MPI_Request req[2];
+  for (int s=0;s<2 && rounds > 0;s++)
+  {
+    sbuf[s].resize(std::max(sbytes,1L));
+    rbuf[s].resize(std::max(rbytes,1L));
+    scount[s].assign(ntask,0); sdispl[s].assign(ntask,0);
+    rcount[s].assign(ntask,0); rdispl[s].assign(ntask,0);
+  }
+  std::vector<predist_cursor> scur(ntask), rcur(ntask);
+  for (int p=0;p<ntask;p++) {scur[p].m_run = 0; scur[p].m_off = 0; rcur[p] = scur[p];}
+
+  //round rd into slot s
+  auto pack = [&](const long rd, const int s)
+  {
+    int displ = 0;
+    for (int p=0;p<ntask;p++)
+    {
+      const long n = std::max(std::min(schunk[p],m_send_bytes[p] - rd*schunk[p]),0L);
+      scount[s][p] = (int) n;
+      sdispl[s][p] = displ;
+      predist_move(m_send[p],scur[p],n,const_cast<char*>(from),sbuf[s].data() + displ,true);
+      displ += (int) n;
+    }
+    displ = 0;
+    for (int p=0;p<ntask;p++)
+    {
+      const long n = std::max(std::min(rchunk[p],m_recv_bytes[p] - rd*rchunk[p]),0L);
+      rcount[s][p] = (int) n;
+      rdispl[s][p] = displ;
+      displ += (int) n;
+    }
+  };
+  auto start = [&](const int s)
+  {
+    MPI_Ialltoallv(sbuf[s].data(),scount[s].data(),sdispl[s].data(),MPI_BYTE,
+                   rbuf[s].data(),rcount[s].data(),rdispl[s].data(),MPI_BYTE,
+                   pworld.comm_world,&req[s]);
+  };
+  auto unpack = [&](const int s)
+  {
+    for (int p=0;p<ntask;p++)
+    {
+      predist_move(m_recv[p],rcur[p],(long) rcount[s][p],to,rbuf[s].data() + rdispl[s][p],false);
+    }
+  };
+
+  if (rounds > 0)
+  {
+    pack(0,0);
+    start(0);
+  }
+  #endif
+
+  //the local pieces, while the first round is in flight
+  for (size_t k=0;k<m_self.size();k++)
+  {
+    memmove(to + m_self[k].m_to,from + m_self[k].m_from,m_self[k].m_bytes);
+  }
+
+  #if defined LIBJ_MPI
+  for (long rd=0;rd<rounds;rd++)
+  {
+    const int s = (int) (rd % 2);
+    if (rd+1 < rounds) pack(rd+1,1-s);
+    {
+      LIBJ_TRACE_SCOPE("redistribute wait","comm");
+      MPI_Wait(&req[s],MPI_STATUS_IGNORE);
+    }
+    if (rd+1 < rounds) start(1-s);
+    unpack(s);
+  }
+  #endif
+  return 0;
+}
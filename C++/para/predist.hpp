@@ -0,0 +1,175 @@
+/*----------------------------------------------------------------------------
+  predist.hpp
+	JHT, October 14, 2026 : created
+	JHT, October 14, 2026 : grids with node tiles
+
+  .hpp file for Predist, the redistribution of data between two layouts
+  over comm_world, e.g. from a Pdata list stored by occupied pair to one
+  stored by virtual pair, or between a Pdata list and a dist_tensor, or
+  between dist_tensors with different grids or blocks.
+
+  A layout (Playout) places a global byte stream on the tasks: piece
+  [global, global+bytes) of the stream is at byte local of the memory of
+  task. Both layouts must hold the same stream.
+    Playout_pdata(pdata,list_id) : the indexes of the list, in order, at
+                                   their m_storage_task and m_mem_pos, so
+                                   after make_window (window_data)
+    Playout_dist(A)              : a dist_tensor, the stream is its matrix
+                                   column major (the tensor's own order),
+                                   in the local matrices (data())
+
+  plan computes, from the two ownership maps, what this task sends to and
+  receives from each other task, as runs of its source and target memory
+  in the order of the stream. Every task only looks at its own pieces, and
+  the pieces of the other layout that cover them. It is not collective,
+  and the plan can be kept and executed many times.
+
+  execute moves the data with MPI_Ialltoallv, in rounds that keep the
+  send and receive buffers within budget bytes (PREDIST_BUDGET), two of
+  each, so that the pack of round r+1, and the unpack of round r-1, are
+  done while round r is on the network. The pieces that stay on this task
+  are copied directly, during the first round. execute is collective over
+  comm_world.
+
+//Usage
+Predist redist;
+Playout_pdata from(pdata,list_occ), to(pdata,list_vir);
+redist.plan(pworld,from,to);
+redist.execute(pworld,pdata.window_data(list_occ),pdata.window_data(list_vir));
+
+Playout_dist to_dist(C);
+redist.plan(pworld,from,to_dist);
+redist.execute(pworld,pdata.window_data(list_occ),C.data(),budget);
+
+  Functions return 0, or 1 after printing the error. Without MPI, execute
+  is a copy.
+----------------------------------------------------------------------------*/
+#ifndef LIBJ_PREDIST_HPP
+#define LIBJ_PREDIST_HPP
+#include <stdio.h>
+#include <vector>
+
+#include "libjdef.h"
+#include "pworld.hpp"
+#include "pdata.hpp"
+#include "pdist.hpp"
+
+#if defined LIBJ_MPI
+  #include <mpi.h>
+#endif
+
+//bytes of the round buffers of execute, per task
+#if !defined (PREDIST_BUDGET)
+  #define PREDIST_BUDGET 268435456
+#endif
+
+//----------------------------------------------------------------------------
+// Ppiece
+//	m_global	start in the stream
+//	m_bytes		bytes
+//	m_task		task that holds it
+//	m_local		start in the memory of that task
+//----------------------------------------------------------------------------
+struct Ppiece
+{
+  long m_global;
+  long m_bytes;
+  int  m_task;
+  long m_local;
+};
+
+//----------------------------------------------------------------------------
+// Playout
+//	bytes		bytes of the stream
+//	mine		appends the pieces held by task, in stream order
+//	split		appends the pieces covering [global,global+bytes), in
+//			order, cut to that range
+//----------------------------------------------------------------------------
+struct Playout
+{
+  virtual ~Playout() {}
+  virtual long bytes() const = 0;
+  virtual void mine(const int task, std::vector<Ppiece>& pieces) const = 0;
+  virtual void split(const long global, const long bytes, std::vector<Ppiece>& pieces) const = 0;
+};
+
+struct Playout_pdata : public Playout
+{
+  const Pdata*      m_pdata;
+  long              m_list_id;
+  std::vector<long> m_start;	//stream start of each index, and the end
+
+  Playout_pdata(const Pdata& pdata, const long list_id);
+  long bytes() const {return m_start.back();}
+  void mine(const int task, std::vector<Ppiece>& pieces) const;
+  void split(const long global, const long bytes, std::vector<Ppiece>& pieces) const;
+};
+
+struct Playout_dist : public Playout
+{
+  long m_M, m_N;		//global rows and cols
+  long m_mb, m_nb;		//block rows and cols
+  int  m_nprow, m_npcol;	//grid
+  long m_elem;			//bytes of an element
+  std::vector<int> m_task;	//Pgrid::grid_task, empty for r*npcol + c
+  std::vector<int> m_pos;	//Pgrid::grid_pos
+
+  Playout_dist(const long M, const long N, const long mb, const long nb,
+               const int nprow, const int npcol, const long elem)
+    : m_M(M), m_N(N), m_mb(mb), m_nb(nb), m_nprow(nprow), m_npcol(npcol), m_elem(elem) {}
+
+  template <typename T>
+  explicit Playout_dist(const libj::dist_tensor<T>& A)
+    : m_M(A.rows()), m_N(A.cols()), m_mb(A.row_block()), m_nb(A.col_block()),
+      m_nprow(A.grid()->nprow), m_npcol(A.grid()->npcol), m_elem((long) sizeof(T)),
+      m_task(A.grid()->grid_task), m_pos(A.grid()->grid_pos) {}
+
+  long bytes() const {return m_M*m_N*m_elem;}
+  void mine(const int task, std::vector<Ppiece>& pieces) const;
+  void split(const long global, const long bytes, std::vector<Ppiece>& pieces) const;
+};
+
+//----------------------------------------------------------------------------
+// Predist
+//	m_send[p], m_recv[p]	runs (local, bytes) of the source (target)
+//				memory sent to (received from) task p
+//	m_self			runs (source, target, bytes) kept on this task
+//----------------------------------------------------------------------------
+class Predist
+{
+  private:
+  struct run
+  {
+    long m_local;
+    long m_bytes;
+  };
+  struct copy
+  {
+    long m_from;
+    long m_to;
+    long m_bytes;
+  };
+
+  std::vector<std::vector<run>> m_send;
+  std::vector<std::vector<run>> m_recv;
+  std::vector<long>             m_send_bytes;
+  std::vector<long>             m_recv_bytes;
+  std::vector<copy>             m_self;
+  bool                          m_planned;
+
+  public:
+  Predist() : m_planned(false) {}
+
+  //compute the plan from src to dst
+  int plan(const Pworld& pworld, const Playout& src, const Playout& dst);
+
+  //move src (this task's source memory) into dst, collective
+  int execute(const Pworld& pworld, const void* src, void* dst,
+              const long budget = PREDIST_BUDGET) const;
+
+  //bytes this task sends to, and receives from, the other tasks
+  long send_bytes() const;
+  long recv_bytes() const;
+};
+
+#endif
@@ -0,0 +1,87 @@
+/*----------------------------------------------------------------------------
+  ptrace.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for Ptrace
+----------------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <vector>
+#include "ptrace.hpp"
+
+#define PTRACE_TAG 7001
+
+//----------------------------------------------------------------------------
+// sync
+//----------------------------------------------------------------------------
+int Ptrace::sync(const Pworld& pworld)
+{
+  #if defined LIBJ_MPI
+  MPI_Barrier(pworld.comm_world);
+  #endif
+  libj::trace_set_epoch();
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+// write
+//	the master asks each task for its buffer in turn. A task whose buffer
+//	is too large for one message sends 0 bytes, and is left out
+//----------------------------------------------------------------------------
+int Ptrace::write(const Pworld& pworld, const char* fname)
+{
+  if (fname == NULL) {fname = getenv("LIBJ_TRACE_FILE");}
+  if (fname == NULL) {fname = PTRACE_FILE;}
+
+  std::vector<char> buf;
+  libj::trace_pack(buf);
+
+  #if defined LIBJ_MPI
+  if (!pworld.mpi_world_ismaster)
+  {
+    int bytes = (buf.size() < (size_t) 2147483647) ? (int) buf.size() : 0;
+    MPI_Recv(NULL,0,MPI_CHAR,0,PTRACE_TAG,pworld.comm_world,MPI_STATUS_IGNORE);
+    MPI_Send(&bytes,1,MPI_INT,0,PTRACE_TAG,pworld.comm_world);
+    MPI_Send(buf.data(),bytes,MPI_CHAR,0,PTRACE_TAG,pworld.comm_world);
+    return 0;
+  }
+  #endif
+
+  FILE* fp = fopen(fname,"w");
+  if (fp == NULL)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Ptrace::write could not open %s\n",fname);
+  }
+  int stat = (fp == NULL) ? 1 : 0;
+  if (fp != NULL)
+  {
+    fprintf(fp,"{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    stat = libj::trace_json(fp,buf.data(),(long) buf.size(),0,true);
+  }
+
+  #if defined LIBJ_MPI
+  //every task is still received, so none is left waiting
+  for (int task=1;task<pworld.mpi_world_num_tasks;task++)
+  {
+    int bytes = 0;
+    MPI_Send(NULL,0,MPI_CHAR,task,PTRACE_TAG,pworld.comm_world);
+    MPI_Recv(&bytes,1,MPI_INT,task,PTRACE_TAG,pworld.comm_world,MPI_STATUS_IGNORE);
+    buf.resize(bytes);
+    MPI_Recv(buf.data(),bytes,MPI_CHAR,task,PTRACE_TAG,pworld.comm_world,MPI_STATUS_IGNORE);
+    if (fp == NULL) continue;
+    if (bytes == 0)
+    {
+      printf("WARNING Ptrace::write the events of task %d are too large, and are left out\n",task);
+      continue;
+    }
+    if (libj::trace_json(fp,buf.data(),(long) bytes,task,false) != 0) {stat = 1;}
+  }
+  #endif
+
+  if (fp != NULL)
+  {
+    fprintf(fp,"\n]}\n");
+    fclose(fp);
+  }
+  return stat;
+}
@@ -0,0 +1,44 @@
+/*----------------------------------------------------------------------------
+  ptrace.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for Ptrace, which writes the LIBJ_TRACE_SCOPE events of all 
+  tasks (see timer/trace.hpp) as one chrome trace json file, with one 
+  process per task and one track per thread. Each task packs its events
+  into one binary buffer, which the master receives one task at a time, 
+  so only one buffer is in its memory at once.
+
+  NOTE : sync and write are collective over comm_world. Para calls sync
+         in init and write in destroy when built with -DLIBJ_TRACE
+
+//Usage
+Ptrace::sync(pworld);              //time 0 of all tasks, after a barrier
+Ptrace::write(pworld);             //to LIBJ_TRACE_FILE, or libj_trace.json
+Ptrace::write(pworld,"run.json");
+
+  Without MPI, write writes the events of this task.
+----------------------------------------------------------------------------*/
+#ifndef LIBJ_PTRACE_HPP
+#define LIBJ_PTRACE_HPP
+#include <stdio.h>
+
+#include "libjdef.h"
+#include "pworld.hpp"
+#include "trace.hpp"
+
+#if defined LIBJ_MPI
+  #include <mpi.h>
+#endif
+
+#define PTRACE_FILE "libj_trace.json"
+
+struct Ptrace
+{
+  //set time 0 of all tasks at a barrier
+  static int sync(const Pworld& pworld);
+
+  //write the events of all tasks to fname, on the master
+  static int write(const Pworld& pworld, const char* fname = NULL);
+};
+
+#endif
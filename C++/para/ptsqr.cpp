@@ -0,0 +1,87 @@
+/*----------------------------------------------------------------------------
+  ptsqr.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for Ptsqr, see ptsqr.hpp
+
+  The stack of R's is factored by every task, with the same input and the
+  same LAPACK, so R and the Q of the stack are the same on all of them.
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <algorithm>
+#include <vector>
+#include "ptsqr.hpp"
+#include "lapack_interface.hpp"
+
+#if defined LIBJ_MPI
+  #include <mpi.h>
+#endif
+
+int Ptsqr(const Pworld& pworld, const long Mloc, const long N, double* A,
+          const long LDA, double* R, const long LDR)
+{
+  if (N < 0 || Mloc < N || LDA < Mloc || LDR < N)
+  {
+    printf("ERROR Ptsqr bad input, Mloc = %ld, N = %ld, LDA = %ld, LDR = %ld \n",
+           Mloc,N,LDA,LDR);
+    return 1;
+  }
+
+  linal_tsqr_q QF;
+  linal_dtsqr_factor(Mloc,N,A,LDA,R,LDR,QF);
+
+  #if defined LIBJ_MPI
+  const int ntask = pworld.mpi_world_num_tasks;
+  if (ntask > 1 && N > 0)
+  {
+    const long NN = N*N;
+    std::vector<double> mine(NN), all(ntask*NN);
+    for (long j=0;j<N;j++) std::copy(R+j*LDR,R+j*LDR+N,mine.data()+j*N);
+    if (MPI_Allgather(mine.data(),(int) NN,MPI_DOUBLE,all.data(),(int) NN,MPI_DOUBLE,
+                      pworld.comm_world) != MPI_SUCCESS)
+    {
+      printf("ERROR Ptsqr MPI_Allgather failed \n");
+      return 1;
+    }
+
+    //the stack of R's, task t in rows [t*N,(t+1)*N)
+    const long MS = ntask*N;
+    std::vector<double> S(MS*N), TAU(N);
+    for (int t=0;t<ntask;t++)
+    {
+      for (long j=0;j<N;j++)
+      {
+        std::copy(all.data()+t*NN+j*N,all.data()+t*NN+(j+1)*N,S.data()+t*N+j*MS);
+      }
+    }
+
+    int MM = MS;
+    int NC = N;
+    int LW = -1;
+    int INFO;
+    double D;
+    dgeqrf_(&MM,&NC,S.data(),&MM,TAU.data(),&D,&LW,&INFO);
+    LW = std::max((int) D,NC);
+    std::vector<double> WORK(LW);
+    dgeqrf_(&MM,&NC,S.data(),&MM,TAU.data(),WORK.data(),&LW,&INFO);
+    if (INFO != 0) {printf("ERROR Ptsqr dgeqrf failed with INFO = %d \n",INFO); return 1;}
+    for (long j=0;j<N;j++)
+    {
+      for (long i=0;i<N;i++) R[i+j*LDR] = (i <= j) ? S[i+j*MS] : 0;
+    }
+
+    LW = -1;
+    dorgqr_(&MM,&NC,&NC,S.data(),&MM,TAU.data(),&D,&LW,&INFO);
+    LW = std::max((int) D,NC);
+    WORK.resize(LW);
+    dorgqr_(&MM,&NC,&NC,S.data(),&MM,TAU.data(),WORK.data(),&LW,&INFO);
+    if (INFO != 0) {printf("ERROR Ptsqr dorgqr failed with INFO = %d \n",INFO); return 1;}
+
+    linal_dtsqr_formq(QF,A,LDA,S.data()+pworld.mpi_world_task_id*N,MS);
+    return 0;
+  }
+  #endif
+
+  linal_dtsqr_formq(QF,A,LDA);
+  return 0;
+}
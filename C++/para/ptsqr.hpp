@@ -0,0 +1,35 @@
+/*----------------------------------------------------------------------------
+  ptsqr.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for Ptsqr, the tall skinny QR of an MxN matrix whose rows are
+  distributed over the tasks of comm_world, each with a block of Mloc >= N
+  rows (in task order), e.g., the parts of a block of Davidson vectors
+
+  A = Q . R
+
+  Each task does the threaded TSQR of its rows (linal_dtsqr_factor, see
+  linal_tsqr.hpp), the NxN R's of the tasks are gathered on every task with
+  one MPI_Allgather, and every task does the QR of their (ntask*N)xN stack,
+  so all have R. The N rows of the Q of the stack that belong to a task are
+  the C of its linal_dtsqr_formq, so its rows of Q are made without more
+  communication. This is one collective of N^2 doubles per task, in place
+  of the N^2/2 allreduces of a distributed Gram-Schmidt.
+
+//Usage
+Ptsqr(pworld,Mloc,N,A,LDA,R,LDR);	//A = this task's rows of Q, collective
+
+  Returns 0, or 1 after printing the error. Without MPI, this is
+  linal_dtsqr.
+----------------------------------------------------------------------------*/
+#ifndef LIBJ_PTSQR_HPP
+#define LIBJ_PTSQR_HPP
+
+#include "libjdef.h"
+#include "pworld.hpp"
+#include "linal_tsqr.hpp"
+
+int Ptsqr(const Pworld& pworld, const long Mloc, const long N, double* A,
+          const long LDA, double* R, const long LDR);
+
+#endif
@@ -0,0 +1,176 @@
+/*-----------------------------------------------------------------
+  ptype.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for the cached MPI datatypes of strided views, see
+  ptype.hpp
+-----------------------------------------------------------------*/
+#include "ptype.hpp"
+
+#if defined LIBJ_MPI
+
+#include <stdio.h>
+#include <stdint.h>
+#include <limits.h>
+#include <map>
+#include <mutex>
+
+//-----------------------------------------------------------------
+// the cache, keyed by the kind, base type and offsets
+//-----------------------------------------------------------------
+static std::mutex                                 ptype_mutex;
+static std::map<std::vector<long>,MPI_Datatype>   ptype_cache;
+
+static bool ptype_find(const std::vector<long>& key, MPI_Datatype& type)
+{
+  std::lock_guard<std::mutex> lock(ptype_mutex);
+  std::map<std::vector<long>,MPI_Datatype>::const_iterator it = ptype_cache.find(key);
+  if (it == ptype_cache.end()) {return false;}
+  type = it->second;
+  return true;
+}
+
+//keeps the first type made for key, in case two threads made one
+static MPI_Datatype ptype_store(const std::vector<long>& key, MPI_Datatype type)
+{
+  std::lock_guard<std::mutex> lock(ptype_mutex);
+  std::map<std::vector<long>,MPI_Datatype>::const_iterator it = ptype_cache.find(key);
+  if (it != ptype_cache.end())
+  {
+    MPI_Type_free(&type);
+    return it->second;
+  }
+  ptype_cache[key] = type;
+  return type;
+}
+
+static bool ptype_int(const long n, const char* name)
+{
+  if (n >= 0 && n <= (long) INT_MAX) {return true;}
+  printf("\nERROR ERROR ERROR\n");
+  printf("%s count %ld does not fit in an int\n",name,n);
+  return false;
+}
+
+//-----------------------------------------------------------------
+// ptype_line
+//	n elements of old, step elements apart, from offset off. The
+//	regular cases are hvectors, the rest an hindexed_block
+//-----------------------------------------------------------------
+static MPI_Datatype ptype_line(const MPI_Datatype old, const long bytes,
+                               const std::vector<long>& off, const bool base)
+{
+  const long n = (long) off.size();
+  bool regular = (n > 0 && off[0] == 0);
+  const long step = (n > 1) ? off[1] - off[0] : 1;
+  for (long i=2;i<n && regular;i++) {regular = (off[i] - off[i-1] == step);}
+
+  MPI_Datatype type;
+  if (regular && step == 1 && base)
+  {
+    MPI_Type_contiguous((int) n,old,&type);
+  } else if (regular) {
+    MPI_Type_create_hvector((int) n,1,(MPI_Aint) (step*bytes),old,&type);
+  } else {
+    std::vector<MPI_Aint> displ(n);
+    for (long i=0;i<n;i++) {displ[i] = (MPI_Aint) (off[i]*bytes);}
+    MPI_Type_create_hindexed_block((int) n,1,displ.data(),old,&type);
+  }
+  return type;
+}
+
+//-----------------------------------------------------------------
+// Ptype_strided
+//	dimensions of length 1 are dropped, and those contiguous with
+//	the one below merged into it
+//-----------------------------------------------------------------
+MPI_Datatype Ptype_strided(const MPI_Datatype base, const long bytes, const int ndim,
+                           const size_t* lengths, const size_t* strides)
+{
+  std::vector<long> len, str;
+  long nelm = 1;
+  for (int d=0;d<ndim;d++)
+  {
+    nelm *= (long) lengths[d];
+    if (lengths[d] == 1) {continue;}
+    if (!len.empty() && (long) strides[d] == len.back()*str.back())
+    {
+      len.back() *= (long) lengths[d];
+    } else {
+      len.push_back((long) lengths[d]);
+      str.push_back((long) strides[d]);
+    }
+  }
+  if (nelm == 0) {len.assign(1,0); str.assign(1,1);}
+  if (len.empty()) {len.assign(1,1); str.assign(1,1);}
+
+  std::vector<long> key;
+  key.push_back(1);
+  key.push_back((long) (intptr_t) base);
+  key.push_back(bytes);
+  for (size_t d=0;d<len.size();d++) {key.push_back(len[d]); key.push_back(str[d]);}
+  MPI_Datatype type;
+  if (ptype_find(key,type)) {return type;}
+
+  type = base;
+  for (size_t d=0;d<len.size();d++)
+  {
+    if (!ptype_int(len[d],"Ptype_strided")) {return MPI_DATATYPE_NULL;}
+    MPI_Datatype next;
+    if (d == 0 && str[d] == 1)
+    {
+      MPI_Type_contiguous((int) len[d],type,&next);
+    } else {
+      MPI_Type_create_hvector((int) len[d],1,(MPI_Aint) (str[d]*bytes),type,&next);
+    }
+    if (d > 0) {MPI_Type_free(&type);}
+    type = next;
+  }
+  MPI_Type_commit(&type);
+  return ptype_store(key,type);
+}
+
+//-----------------------------------------------------------------
+// Ptype_offsets
+//-----------------------------------------------------------------
+MPI_Datatype Ptype_offsets(const MPI_Datatype base, const long bytes,
+                           const std::vector<long>& row_off,
+                           const std::vector<long>& col_off)
+{
+  if (!ptype_int((long) row_off.size(),"Ptype_offsets") ||
+      !ptype_int((long) col_off.size(),"Ptype_offsets")) {return MPI_DATATYPE_NULL;}
+
+  std::vector<long> key;
+  key.reserve(5 + row_off.size() + col_off.size());
+  key.push_back(2);
+  key.push_back((long) (intptr_t) base);
+  key.push_back(bytes);
+  key.push_back((long) row_off.size());
+  key.push_back((long) col_off.size());
+  key.insert(key.end(),row_off.begin(),row_off.end());
+  key.insert(key.end(),col_off.begin(),col_off.end());
+  MPI_Datatype type;
+  if (ptype_find(key,type)) {return type;}
+
+  MPI_Datatype rows = ptype_line(base,bytes,row_off,true);
+  type = ptype_line(rows,bytes,col_off,false);
+  MPI_Type_free(&rows);
+  MPI_Type_commit(&type);
+  return ptype_store(key,type);
+}
+
+//-----------------------------------------------------------------
+// Ptype_free_all
+//-----------------------------------------------------------------
+void Ptype_free_all()
+{
+  std::lock_guard<std::mutex> lock(ptype_mutex);
+  for (std::map<std::vector<long>,MPI_Datatype>::iterator it = ptype_cache.begin();
+       it != ptype_cache.end(); ++it)
+  {
+    MPI_Type_free(&it->second);
+  }
+  ptype_cache.clear();
+}
+
+#endif
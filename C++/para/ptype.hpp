@@ -0,0 +1,83 @@
+/*-----------------------------------------------------------------
+  ptype.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for the MPI datatypes of strided tensor views, so that
+  a slice of a libj::tensor, or a block of a tensor_matrix2, can be
+  sent, received, or got with RMA straight from its memory, in place
+  of being packed into a contiguous buffer first. The type is rooted
+  at V.data(), and holds the elements in the tensor's own order
+  (dimension 0 fastest), so a contiguous buffer or tensor of the same
+  size on the other side sees them in that order.
+
+    MPI_Datatype type = Ptype_tensor(V);
+    MPI_Send(V.data(),1,type,dest,tag,pworld.comm_world);
+    pdata.get(list_id,index,V.data(),type);	//see pdata.hpp
+
+  The tensor types are nested MPI_Type_create_hvector, one level per
+  dimension, with dimensions that are contiguous with the one below
+  merged, and a contiguous base when stride(0) is 1. A tensor_matrix2
+  block has the rows and columns of its bundles, whose offsets need
+  not be regular, so it is two MPI_Type_create_hindexed_block, or
+  hvectors where the offsets are regular.
+
+  The types are made once per shape and committed, and kept in a
+  cache (thread safe), so they must not be freed by the caller.
+  Pworld::destroy frees them all (Ptype_free_all, in pworld.hpp) before
+  MPI_Finalize.
+
+  Ptype_strided(base,bytes,ndim,lengths,strides) : the same, for any
+  array of ndim dimensions of elements of MPI type base, of bytes
+  each, with strides in elements.
+
+  These only exist with LIBJ_MPI.
+-----------------------------------------------------------------*/
+#ifndef LIBJ_PTYPE_HPP
+#define LIBJ_PTYPE_HPP
+
+#include "libjdef.h"
+#include "pworld.hpp"
+#include "tensor.hpp"
+#include "tensor_matrix2.hpp"
+#include <vector>
+
+#if defined LIBJ_MPI
+
+//strided array of ndim dimensions, cached
+MPI_Datatype Ptype_strided(const MPI_Datatype base, const long bytes, const int ndim,
+                           const size_t* lengths, const size_t* strides);
+
+//rows x cols elements at row_off[i] + col_off[j], in elements, cached
+MPI_Datatype Ptype_offsets(const MPI_Datatype base, const long bytes,
+                           const std::vector<long>& row_off,
+                           const std::vector<long>& col_off);
+
+//the elements of the view V
+template <typename T>
+MPI_Datatype Ptype_tensor(const libj::tensor<T>& V)
+{
+  size_t lengths[LIBJ_TENSOR_MAX_DIM], strides[LIBJ_TENSOR_MAX_DIM];
+  for (size_t d=0;d<V.dim();d++)
+  {
+    lengths[d] = V.size(d);
+    strides[d] = V.stride(d);
+  }
+  return Ptype_strided(Pmpi_type<T>::get(),(long) sizeof(T),(int) V.dim(),lengths,strides);
+}
+
+//the elements of the (block of a) tensor_matrix2 A, column major, from A.data()
+template <typename T, size_t NLHS, size_t NRHS>
+MPI_Datatype Ptype_matrix(const libj::tensor_matrix2<T,NLHS,NRHS>& A)
+{
+  //the offsets are from the tensor, data() is that of element 0,0
+  const size_t NR = A.size(0), NC = A.size(1);
+  const long O = (NR > 0 && NC > 0) ? (long) A.offset(0,0) : 0;
+  std::vector<long> row_off(NR), col_off(NC);
+  for (size_t i=0;i<NR;i++) row_off[i] = (long) A.offset(i,0) - O;
+  for (size_t j=0;j<NC;j++) col_off[j] = (long) A.offset(0,j) - O;
+  return Ptype_offsets(Pmpi_type<T>::get(),(long) sizeof(T),row_off,col_off);
+}
+
+#endif
+
+#endif
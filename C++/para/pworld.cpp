@@ -1,21 +1,95 @@
 /*-----------------------------------------------------------------
   pworld.cpp
 	JHT, Febuary 9, 2022 : created
+	JHT, October 14, 2026 : added MPI_Init_thread and the thread comms
+	JHT, October 14, 2026 : added the io aggregators
+	JHT, October 14, 2026 : added the progress thread
+	JHT, October 14, 2026 : added the topology and reorder_map
+	JHT, October 14, 2026 : added split_teams
 
   .cpp file for pworld
 -----------------------------------------------------------------*/
 #include "pworld.hpp"
+#include <stdlib.h>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#if defined __linux__
+  #include <sched.h>
+  #include <dirent.h>
+#endif
+
+//-----------------------------------------------------------------
+// cpu_socket
+//	physical package of a cpu, 0 if unknown
+//-----------------------------------------------------------------
+static int cpu_socket(const int cpu)
+{
+  int socket = 0;
+  #if defined __linux__
+  if (cpu < 0) {return 0;}
+  char path[128];
+  snprintf(path,128,"/sys/devices/system/cpu/cpu%d/topology/physical_package_id",cpu);
+  FILE* fptr = fopen(path,"r");
+  if (fptr == NULL) {return 0;}
+  if (fscanf(fptr,"%d",&socket) != 1 || socket < 0) {socket = 0;}
+  fclose(fptr);
+  #endif
+  return socket;
+}
+
+//-----------------------------------------------------------------
+// cpu_numa
+//	NUMA node of a cpu, the nodeN entry of its sysfs directory, 0 
+//	if unknown
+//-----------------------------------------------------------------
+static int cpu_numa(const int cpu)
+{
+  int numa = 0;
+  #if defined __linux__
+  if (cpu < 0) {return 0;}
+  char path[128];
+  snprintf(path,128,"/sys/devices/system/cpu/cpu%d",cpu);
+  DIR* dir = opendir(path);
+  if (dir == NULL) {return 0;}
+  struct dirent* ent;
+  while ((ent = readdir(dir)) != NULL)
+  {
+    int node;
+    if (sscanf(ent->d_name,"node%d",&node) == 1 && node >= 0) {numa = node; break;}
+  }
+  closedir(dir);
+  #endif
+  return numa;
+}
 
 //-----------------------------------------------------------------
 // initialize
 //-----------------------------------------------------------------
-int Pworld::init()
+int Pworld::init(const int thread_level, const int io_per_node)
 {
+  num_thread_comms = 0;
+  mpi_num_teams = 1;
+  mpi_team_id = 0;
+  mpi_is_team = false;
+  mpi_progress = NULL;
+  mpi_task_node = NULL;
+  mpi_task_socket = NULL;
+  mpi_task_numa = NULL;
   #if defined LIBJ_MPI
     ismpi = true;
+    comm_thread = NULL;
 
     //initial setup
-    MPI_Init(NULL,NULL);
+    const int levels[4] = {MPI_THREAD_SINGLE,MPI_THREAD_FUNNELED,
+                           MPI_THREAD_SERIALIZED,MPI_THREAD_MULTIPLE};
+    const int level = (thread_level < 0) ? 0 : (thread_level > 3) ? 3 : thread_level;
+    int provided;
+    MPI_Init_thread(NULL,NULL,levels[level],&provided);
+    mpi_thread_level = 0;
+    for (int l=0;l<4;l++) {if (provided == levels[l]) mpi_thread_level = l;}
     MPI_Info_create(&mpi_info);
 
     //MPI world setup
@@ -31,7 +105,18 @@ int Pworld::init()
     MPI_Comm_rank(comm_shared,&mpi_shared_task_id);
     mpi_shared_root = 0;
     mpi_shared_ismaster = (mpi_shared_task_id != 0) ? false : true; 
-    mpi_doesIO = (!mpi_shared_ismaster) ? false : true;
+
+    //MPI node (shared roots) setup
+    MPI_Comm_split(comm_world,mpi_shared_ismaster ? 0 : MPI_UNDEFINED,
+                   mpi_world_task_id,&comm_nodes);
+    if (mpi_shared_ismaster) {MPI_Comm_size(comm_nodes,&mpi_num_nodes);}
+    MPI_Bcast(&mpi_num_nodes,1,MPI_INT,mpi_shared_root,comm_shared);
+
+    //MPI io groups
+    if (make_io_comms(io_per_node) != 0) {return 1;}
+
+    //node, socket, NUMA of every task
+    if (make_topology() != 0) {return 1;}
     
   #else
     ismpi = false;
@@ -44,34 +129,433 @@ int Pworld::init()
     mpi_shared_task_id=0;
     mpi_shared_root = 0;
     mpi_shared_ismaster=true;
+    mpi_num_nodes = 1;
     mpi_doesIO = true;
+    mpi_thread_level = PWORLD_THREAD_MULTIPLE;
+
+    mpi_io_per_node = 1;
+    mpi_io_num_tasks = 1;
+    mpi_io_task_id = 0;
+    mpi_io_root = 0;
+    mpi_io_aggregator = 0;
+    #if defined __linux__
+      mpi_socket = cpu_socket(sched_getcpu());
+    #else
+      mpi_socket = 0;
+    #endif
+    if (make_topology() != 0) {return 1;}
   #endif
 
   #if defined LIBJ_OMP
     isomp = true;
-    #pragma omp parallel 
+    omp_num_threads = omp_get_max_threads();
+    omp_proc_bind = (int) omp_get_proc_bind();
+  #else
+    isomp = false;
+    omp_num_threads=1;
+    omp_proc_bind = 0;
+  #endif
+
+  //cpu of each thread, which only means something if they are pinned
+  omp_thread_cpu = (int*) malloc(sizeof(int)*omp_num_threads);
+  if (omp_thread_cpu == NULL) {return 1;}
+  #pragma omp parallel num_threads(omp_num_threads)
+  {
+    #if defined LIBJ_OMP
+      const int thread = omp_get_thread_num();
+    #else
+      const int thread = 0;
+    #endif
+    #if defined __linux__
+      omp_thread_cpu[thread] = sched_getcpu();
+    #else
+      omp_thread_cpu[thread] = -1;
+    #endif
+  }
+
+  //warn if the thread level is less than asked for 
+  if (mpi_world_ismaster && mpi_thread_level < thread_level)
+  {
+    printf("\nWARNING WARNING WARNING\n");
+    printf("Pworld::init asked for thread level %d, but MPI gave %d\n",
+           thread_level,mpi_thread_level);
+  }
+  return 0;
+}
+
+//-----------------------------------------------------------------
+// make_io_comms
+//	sorts the tasks of the node by (socket, shared id), and splits 
+//	them into io_per_node contiguous groups. The first task of a 
+//	group is rank 0 of comm_io, and does its io. With one group, 
+//	that is the shared root
+//-----------------------------------------------------------------
+int Pworld::make_io_comms(const int io_per_node)
+{
+  #if defined LIBJ_MPI
+    int nio = io_per_node;
+    if (nio <= 0)
     {
-      #pragma omp single
+      const char* s = getenv("LIBJ_IO_PER_NODE");
+      nio = (s != NULL) ? atoi(s) : 1;
+    }
+    if (nio < 1) {nio = 1;}
+    if (nio > mpi_shared_num_tasks) {nio = mpi_shared_num_tasks;}
+    mpi_io_per_node = nio;
+
+    #if defined __linux__
+      mpi_socket = cpu_socket(sched_getcpu());
+    #else
+      mpi_socket = 0;
+    #endif
+    std::vector<int> sockets(mpi_shared_num_tasks);
+    MPI_Allgather(&mpi_socket,1,MPI_INT,sockets.data(),1,MPI_INT,comm_shared);
+    std::vector<int> order(mpi_shared_num_tasks);
+    for (int task=0;task<mpi_shared_num_tasks;task++) {order[task] = task;}
+    if (nio > 1)
+    {
+      std::stable_sort(order.begin(),order.end(),[&](const int a, const int b)
       {
-        omp_num_threads = omp_get_num_threads();
-      }
+        return sockets[a] < sockets[b];
+      });
+    }
+    int pos = 0;
+    for (int p=0;p<mpi_shared_num_tasks;p++) {if (order[p] == mpi_shared_task_id) pos = p;}
+    const int group = (int) (((long) pos*nio)/mpi_shared_num_tasks);
+
+    if (MPI_Comm_split(comm_shared,group,pos,&comm_io) != MPI_SUCCESS)
+    {
+      printf("\nERROR ERROR ERROR\n");
+      printf("Pworld::make_io_comms could not split comm_shared\n");
+      return 1;
+    }
+    MPI_Comm_size(comm_io,&mpi_io_num_tasks);
+    MPI_Comm_rank(comm_io,&mpi_io_task_id);
+    mpi_io_root = 0;
+    mpi_doesIO = (mpi_io_task_id == mpi_io_root) ? true : false;
+    mpi_io_aggregator = mpi_world_task_id;
+    MPI_Bcast(&mpi_io_aggregator,1,MPI_INT,mpi_io_root,comm_io);
+  #endif
+  return 0;
+}
+
+//-----------------------------------------------------------------
+// make_topology
+//	after make_io_comms, which sets mpi_socket
+//-----------------------------------------------------------------
+int Pworld::make_topology()
+{
+  mpi_numa = 0;
+  mpi_num_cores = 1;
+  #if defined __linux__
+    mpi_numa = cpu_numa(sched_getcpu());
+    #if defined CPU_COUNT
+      cpu_set_t mask;
+      CPU_ZERO(&mask);
+      if (sched_getaffinity(0,sizeof(mask),&mask) == 0) {mpi_num_cores = CPU_COUNT(&mask);}
+    #endif
+  #endif
+
+  const int num = mpi_world_num_tasks;
+  mpi_task_node = (int*) malloc(sizeof(int)*num);
+  mpi_task_socket = (int*) malloc(sizeof(int)*num);
+  mpi_task_numa = (int*) malloc(sizeof(int)*num);
+  if (mpi_task_node == NULL || mpi_task_socket == NULL || mpi_task_numa == NULL)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pworld::make_topology could not malloc the task topology\n");
+    return 1;
+  }
+
+  mpi_node = 0;
+  #if defined LIBJ_MPI
+    if (mpi_shared_ismaster) {MPI_Comm_rank(comm_nodes,&mpi_node);}
+    MPI_Bcast(&mpi_node,1,MPI_INT,mpi_shared_root,comm_shared);
+    int mine[3] = {mpi_node,mpi_socket,mpi_numa};
+    std::vector<int> all(3*(size_t) num);
+    MPI_Allgather(mine,3,MPI_INT,all.data(),3,MPI_INT,comm_world);
+    for (int task=0;task<num;task++)
+    {
+      mpi_task_node[task] = all[3*task];
+      mpi_task_socket[task] = all[3*task+1];
+      mpi_task_numa[task] = all[3*task+2];
     }
   #else
-    isomp = false;
-    omp_num_threads=1;
+    mpi_task_node[0] = mpi_node;
+    mpi_task_socket[0] = mpi_socket;
+    mpi_task_numa[0] = mpi_numa;
+  #endif
+  return 0;
+}
+
+//-----------------------------------------------------------------
+// reorder_map
+//	the slots are the world tasks, by node, and in a node by 
+//	(socket, NUMA, id). Each node is seeded with the free logical
+//	task of the largest traffic to the other free ones, and then
+//	filled by the free task of the largest traffic to those placed 
+//	on the node, so the first (same socket) slots get the tasks 
+//	that talk most. Ties go to the lowest logical task
+//-----------------------------------------------------------------
+int Pworld::reorder_map(const double* traffic, int* map) const
+{
+  if (traffic == NULL || map == NULL || mpi_task_node == NULL)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Pworld::reorder_map needs the traffic, the map, and init\n");
+    return 1;
+  }
+  const int num = mpi_world_num_tasks;
+  std::vector<int> slots(num);
+  for (int task=0;task<num;task++) {slots[task] = task;}
+  std::stable_sort(slots.begin(),slots.end(),[&](const int a, const int b)
+  {
+    if (mpi_task_node[a] != mpi_task_node[b]) return mpi_task_node[a] < mpi_task_node[b];
+    if (mpi_task_socket[a] != mpi_task_socket[b]) return mpi_task_socket[a] < mpi_task_socket[b];
+    return mpi_task_numa[a] < mpi_task_numa[b];
+  });
+
+  std::vector<bool> placed(num,false);
+  std::vector<double> total(num,0.0), gain(num,0.0);
+  for (int i=0;i<num;i++)
+  {
+    for (int j=0;j<num;j++) {if (j != i) total[i] += traffic[(size_t) i*num + j];}
+  }
+
+  for (int s=0;s<num;s++)
+  {
+    const bool seed = (s == 0 || mpi_task_node[slots[s]] != mpi_task_node[slots[s-1]]);
+    if (seed) {std::fill(gain.begin(),gain.end(),0.0);}
+    const std::vector<double>& score = seed ? total : gain;
+    int best = -1;
+    for (int i=0;i<num;i++)
+    {
+      if (placed[i]) continue;
+      if (best == -1 || score[i] > score[best]) best = i;
+    }
+    placed[best] = true;
+    map[best] = slots[s];
+    for (int i=0;i<num;i++)
+    {
+      if (placed[i]) continue;
+      const double t = traffic[(size_t) best*num + i];
+      gain[i] += t;
+      total[i] -= t;
+    }
+  }
+  return 0;
+}
+
+//-----------------------------------------------------------------
+// make_thread_comms
+//	one duplicate of comm_world per OpenMP thread, so that threads 
+//	can communicate without their messages matching each other's. 
+//	Every task makes the largest number of threads of any task
+//-----------------------------------------------------------------
+int Pworld::make_thread_comms()
+{
+  #if defined LIBJ_MPI
+    if (mpi_thread_level < PWORLD_THREAD_MULTIPLE)
+    {
+      printf("\nERROR ERROR ERROR\n");
+      printf("Pworld::make_thread_comms needs PWORLD_THREAD_MULTIPLE\n");
+      return 1;
+    }
+    if (comm_thread != NULL) {return 0;}
+    int num = omp_num_threads;
+    MPI_Allreduce(MPI_IN_PLACE,&num,1,MPI_INT,MPI_MAX,comm_world);
+    comm_thread = (MPI_Comm*) malloc(sizeof(MPI_Comm)*num);
+    if (comm_thread == NULL) {return 1;}
+    for (int thread=0;thread<num;thread++) 
+    {
+      MPI_Comm_dup(comm_world,&comm_thread[thread]);
+    }
+    num_thread_comms = num;
   #endif
   return 0;
 }
 
+//-----------------------------------------------------------------
+// split_teams
+//	the world tasks in (node, id) order are cut into num_teams 
+//	contiguous blocks, and team is set up on its block as init 
+//	sets up the world, with the thread fields of this Pworld. 
+//	The team has no thread comms or progress thread of its own
+//-----------------------------------------------------------------
+int Pworld::split_teams(const int num_teams, Pworld& team, const int io_per_node) const
+{
+  const int num = mpi_world_num_tasks;
+  const int nteams = (num_teams < 1) ? 1 : (num_teams > num) ? num : num_teams;
+  std::vector<int> order(num);
+  for (int task=0;task<num;task++) {order[task] = task;}
+  if (mpi_task_node != NULL)
+  {
+    std::stable_sort(order.begin(),order.end(),[&](const int a, const int b)
+    {
+      return mpi_task_node[a] < mpi_task_node[b];
+    });
+  }
+  int pos = 0;
+  for (int p=0;p<num;p++) {if (order[p] == mpi_world_task_id) pos = p;}
+
+  team = *this;
+  team.mpi_num_teams = nteams;
+  team.mpi_team_id = (int) (((long) pos*nteams)/num);
+  team.mpi_is_team = true;
+  team.num_thread_comms = 0;
+  team.mpi_progress = NULL;
+  team.mpi_task_node = NULL;
+  team.mpi_task_socket = NULL;
+  team.mpi_task_numa = NULL;
+  team.omp_thread_cpu = (int*) malloc(sizeof(int)*omp_num_threads);
+  if (team.omp_thread_cpu == NULL) {return 1;}
+  for (int thread=0;thread<omp_num_threads;thread++) {team.omp_thread_cpu[thread] = omp_thread_cpu[thread];}
+
+  #if defined LIBJ_MPI
+    team.comm_thread = NULL;
+    MPI_Info_dup(mpi_info,&team.mpi_info);
+
+    //MPI team setup
+    if (MPI_Comm_split(comm_world,team.mpi_team_id,pos,&team.comm_world) != MPI_SUCCESS)
+    {
+      printf("\nERROR ERROR ERROR\n");
+      printf("Pworld::split_teams could not split comm_world\n");
+      return 1;
+    }
+    MPI_Comm_size(team.comm_world,&team.mpi_world_num_tasks);
+    MPI_Comm_rank(team.comm_world,&team.mpi_world_task_id);
+    team.mpi_world_ismaster = (team.mpi_world_task_id != 0) ? false : true; 
+
+    //MPI shared setup
+    MPI_Comm_split_type(team.comm_world,MPI_COMM_TYPE_SHARED,
+                        team.mpi_world_task_id,team.mpi_info,&team.comm_shared);
+    MPI_Comm_size(team.comm_shared,&team.mpi_shared_num_tasks);
+    MPI_Comm_rank(team.comm_shared,&team.mpi_shared_task_id);
+    team.mpi_shared_root = 0;
+    team.mpi_shared_ismaster = (team.mpi_shared_task_id != 0) ? false : true; 
+
+    //MPI node (shared roots) setup
+    MPI_Comm_split(team.comm_world,team.mpi_shared_ismaster ? 0 : MPI_UNDEFINED,
+                   team.mpi_world_task_id,&team.comm_nodes);
+    if (team.mpi_shared_ismaster) {MPI_Comm_size(team.comm_nodes,&team.mpi_num_nodes);}
+    MPI_Bcast(&team.mpi_num_nodes,1,MPI_INT,team.mpi_shared_root,team.comm_shared);
+
+    //MPI io groups
+    if (team.make_io_comms(io_per_node) != 0) {return 1;}
+  #endif
+
+  //node, socket, NUMA of every team task
+  if (team.make_topology() != 0) {return 1;}
+  return 0;
+}
 
 //-----------------------------------------------------------------
 // Destroy
+//	a team only frees its own communicators, MPI is left to the
+//	world Pworld
 //-----------------------------------------------------------------
 int Pworld::destroy()
+{
+  stop_progress();
+  #if defined LIBJ_MPI
+    if (comm_thread != NULL)
+    {
+      for (int thread=0;thread<num_thread_comms;thread++) 
+      {
+        MPI_Comm_free(&comm_thread[thread]);
+      }
+      free(comm_thread);
+      comm_thread = NULL;
+    }
+    if (comm_nodes != MPI_COMM_NULL) {MPI_Comm_free(&comm_nodes);}
+    if (comm_io != MPI_COMM_NULL) {MPI_Comm_free(&comm_io);}
+    if (mpi_is_team)
+    {
+      if (comm_shared != MPI_COMM_NULL) {MPI_Comm_free(&comm_shared);}
+      if (comm_world != MPI_COMM_NULL) {MPI_Comm_free(&comm_world);}
+      MPI_Info_free(&mpi_info);
+    }
+    else
+    {
+      Ptype_free_all();
+      MPI_Finalize(); 
+    }
+  #endif
+  if (omp_thread_cpu != NULL) free(omp_thread_cpu);
+  omp_thread_cpu = NULL;
+  free(mpi_task_node); mpi_task_node = NULL;
+  free(mpi_task_socket); mpi_task_socket = NULL;
+  free(mpi_task_numa); mpi_task_numa = NULL;
+  num_thread_comms = 0;
+  return 0;
+}
+
+
+//-----------------------------------------------------------------
+// Pprogress
+//	the progress thread, and when to stop it
+//-----------------------------------------------------------------
+struct Pprogress
+{
+  std::thread       thread;
+  std::atomic<bool> stop;
+  int               us;
+};
+
+//-----------------------------------------------------------------
+// progress
+//	one trip into the MPI progress engine
+//-----------------------------------------------------------------
+void Pworld::progress() const
 {
   #if defined LIBJ_MPI
-    MPI_Finalize(); 
+    int flag = 0;
+    MPI_Iprobe(MPI_ANY_SOURCE,MPI_ANY_TAG,MPI_COMM_SELF,&flag,MPI_STATUS_IGNORE);
+  #endif
+}
+
+//-----------------------------------------------------------------
+// start_progress
+//	the thread calls MPI, so MPI must allow every thread to
+//-----------------------------------------------------------------
+int Pworld::start_progress(const int interval_us)
+{
+  if (mpi_progress != NULL) {return 0;}
+  #if defined LIBJ_MPI
+    if (mpi_thread_level < PWORLD_THREAD_MULTIPLE)
+    {
+      if (mpi_world_ismaster)
+      {
+        printf("Pworld::start_progress needs thread level %d, but MPI gave %d\n",
+               PWORLD_THREAD_MULTIPLE,mpi_thread_level);
+      }
+      return 1;
+    }
+    Pprogress* prog = new Pprogress;
+    prog->stop.store(false);
+    prog->us = (interval_us > 0) ? interval_us : 1;
+    const Pworld* self = this;
+    prog->thread = std::thread([prog,self]()
+    {
+      while (!prog->stop.load(std::memory_order_acquire))
+      {
+        self->progress();
+        std::this_thread::sleep_for(std::chrono::microseconds(prog->us));
+      }
+    });
+    mpi_progress = prog;
   #endif
   return 0;
 }
 
+//-----------------------------------------------------------------
+// stop_progress
+//-----------------------------------------------------------------
+void Pworld::stop_progress()
+{
+  if (mpi_progress == NULL) {return;}
+  mpi_progress->stop.store(true,std::memory_order_release);
+  mpi_progress->thread.join();
+  delete mpi_progress;
+  mpi_progress = NULL;
+}
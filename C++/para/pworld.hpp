@@ -1,18 +1,102 @@
 /*-----------------------------------------------------------------
   pworld.hpp
 	JHT, Febuary 7, 2022 : created
+	JHT, October 14, 2026 : added the thread levels, thread comms, and 
+	                        thread cpus
+	JHT, October 14, 2026 : added comm_nodes and Pmpi_type
+	JHT, October 14, 2026 : added the io aggregators and comm_io
+	JHT, October 14, 2026 : added the progress thread
+	JHT, October 14, 2026 : added the topology and reorder_map
+	JHT, October 14, 2026 : added split_teams
 
   .hpp file for Pworld, which manages the initialization and 
   finalization of MPI parameters if they are required. This struct
   also carries most of the general MPI information
 
 //Usage
-init()		: initializes variables and structures
+init()		: initializes variables and structures, with MPI_THREAD_FUNNELED
+init(level)	: initializes with a PWORLD_THREAD_* level  
+init(level,nio)	: ... with nio io aggregators per node
 destroy()	: finalizes variables and structures
+make_thread_comms() : duplicates comm_world for each OpenMP thread,
+		      collective, and needs PWORLD_THREAD_MULTIPLE
+
+//Threads
+mpi_thread_level : thread level MPI provided, which may be less than asked
+omp_thread_cpu   : cpu each OpenMP thread was on at init (-1 if unknown)
+omp_proc_bind	 : omp_get_proc_bind(), 0 if threads are not pinned
 
 //Communicators
 comm_world 	: MPI_COMM_WORLD
 comm_shared	: MPI_COMM_TYPE_SHARED
+comm_thread[t]	: comm_world for thread t only, after make_thread_comms
+comm_nodes	: the shared roots, one task per node (MPI_COMM_NULL elsewhere)
+
+//IO aggregators
+  The tasks of a node are sorted by socket (physical package of the cpu
+  they were on at init), and split into nio groups of contiguous tasks, 
+  so that with nio a multiple of the sockets, each group is on one socket. 
+  The first task of each group is its aggregator, which has mpi_doesIO, 
+  and does the Pfile io of the group (the Para file_* calls go to it 
+  over comm_io). Use more than one per node if the node has several 
+  NVMe devices or NICs. nio is the init argument, else the environment 
+  variable LIBJ_IO_PER_NODE, else 1 (the shared root, as before).
+comm_io		: the tasks of this io group, the aggregator is mpi_io_root
+mpi_io_aggregator : world id of the aggregator of this task
+mpi_socket	: socket of this task (0 if unknown)
+
+//Topology
+  Found at init, from MPI_COMM_TYPE_SHARED (nodes) and sysfs (sockets and
+  NUMA domains, of the cpu each task was on at init), for every task
+mpi_node	 : node of this task, its shared root's rank in comm_nodes
+mpi_numa	 : NUMA domain of this task (0 if unknown)
+mpi_num_cores	 : cpus this task may run on (its affinity mask)
+mpi_task_node[t], mpi_task_socket[t], mpi_task_numa[t] : of world task t
+reorder_map(traffic,map) : places logical tasks on world tasks, so that
+		   the pairs that communicate most are on the same node, 
+		   and then socket. traffic is the symmetric num_tasks x 
+		   num_tasks matrix of bytes (or any weight) between logical 
+		   tasks, and map[logical] is its world task. It is greedy
+		   (each node's slots, in socket order, are filled with the 
+		   task that talks most to those already there) and not 
+		   collective, and gives the same map on every task. Use it 
+		   for the m_storage_task of Pdata indexes, e.g.
+		     pdata.add_index(list_id,map[owner],file_pos,size);
+		   and see Pgrid (pdist.hpp) for node tiled process grids
+
+//Teams
+split_teams(G,team) : splits comm_world into G teams, and makes team a
+		   Pworld of this task's team, whose comm_world, comm_shared,
+		   comm_nodes, comm_io, and topology are those of the team
+		   alone. Every para class takes its Pworld, so a Para made
+		   on it (Para::init_team) prints, counts, and does file io
+		   and collectives within the team, without waiting on the
+		   other teams. The teams are contiguous blocks of tasks in
+		   (node, id) order, so they are whole nodes when G divides
+		   the nodes, and within a node otherwise. Collective over 
+		   comm_world. team.destroy() frees the team communicators,
+		   and leaves MPI to the world Pworld
+mpi_num_teams	 : G (1 for the world)
+mpi_team_id	 : team of this task (0 for the world)
+mpi_is_team	 : this Pworld is a team of another
+
+//Progress
+  Most MPI libraries only move non-blocking communication (the Pcounter
+  and Pfile RMA, Igatherv, ...) forward inside MPI calls, so it stalls
+  while the task is in a long kernel. Either
+start_progress(us) : start a thread that calls MPI every us microseconds
+		     (PWORLD_PROGRESS_US), returns 1 if MPI did not give
+		     PWORLD_THREAD_MULTIPLE, and starts nothing
+stop_progress()	   : stop it, also done by destroy()
+progress()	   : one call into MPI, to put in long loops by hand. It
+		     must be called from a thread that may call MPI
+  The calls are an MPI_Iprobe on MPI_COMM_SELF, which matches nothing,
+  so they are not collective, and take no messages from anyone.
+has_progress()	   : the thread is running
+
+//Types
+Pmpi_type<T>::get() : MPI type of T, for double, float, long, and int
+  and of strided tensor views, see ptype.hpp
 
 -----------------------------------------------------------------*/
 #ifndef LIBJ_PWORLD_HPP
@@ -29,6 +113,19 @@ comm_shared	: MPI_COMM_TYPE_SHARED
   #include <omp.h>
 #endif
 
+//microseconds between the MPI calls of the progress thread
+#if !defined (PWORLD_PROGRESS_US)
+  #define PWORLD_PROGRESS_US 50
+#endif
+
+struct Pprogress;
+
+//thread levels, as the MPI_THREAD_* levels
+#define PWORLD_THREAD_SINGLE 0
+#define PWORLD_THREAD_FUNNELED 1
+#define PWORLD_THREAD_SERIALIZED 2
+#define PWORLD_THREAD_MULTIPLE 3
+
 struct Pworld
 {
   public:
@@ -40,7 +137,27 @@ struct Pworld
   int mpi_shared_num_tasks;	//shared task size
   int mpi_shared_task_id;	//shared task id
   int mpi_shared_root;		//shared root id
+  int mpi_num_nodes;		//number of shared memory nodes
   int omp_num_threads;		//number of OMP threads
+  int omp_proc_bind;		//OMP proc bind policy 
+  int* omp_thread_cpu;		//cpu of each OMP thread
+  int mpi_thread_level;		//provided PWORLD_THREAD_* level
+  int mpi_io_per_node;		//io aggregators per node
+  int mpi_io_num_tasks;		//io group task size
+  int mpi_io_task_id;		//io group task id
+  int mpi_io_root;		//io group root id, the aggregator
+  int mpi_io_aggregator;	//world id of the aggregator
+  int mpi_socket;		//socket of this task
+  int mpi_node;			//node of this task
+  int mpi_numa;			//NUMA domain of this task
+  int mpi_num_cores;		//cpus this task may run on
+  int* mpi_task_node;		//node of each world task
+  int* mpi_task_socket;		//socket of each world task
+  int* mpi_task_numa;		//NUMA domain of each world task
+  int num_thread_comms;		//number of thread communicators
+  int mpi_num_teams;		//number of teams
+  int mpi_team_id;		//team of this task
+  bool mpi_is_team;		//is a team of another Pworld
   bool ismpi;			//has mpi
   bool isomp;			//has omp
   bool mpi_world_ismaster;	//is world master 
@@ -51,15 +168,54 @@ struct Pworld
   #if defined LIBJ_MPI
     MPI_Comm comm_world; 	//world communicator
     MPI_Comm comm_shared;	//shared communicator
+    MPI_Comm comm_nodes;	//shared roots communicator
+    MPI_Comm comm_io;		//io group communicator
     MPI_Info mpi_info;		//info
+    MPI_Comm* comm_thread;	//per thread communicators
   #endif
 
+  Pprogress* mpi_progress;	//progress thread, NULL if none
+
   //Initialize
-  int init();
+  int init(const int thread_level = PWORLD_THREAD_FUNNELED, const int io_per_node = 0);
+
+  //Per thread communicators
+  int make_thread_comms();
+
+  //Teams of tasks, with their own communicators
+  int split_teams(const int num_teams, Pworld& team, const int io_per_node = 0) const;
   
+  //Progress of non-blocking communication
+  int start_progress(const int interval_us = PWORLD_PROGRESS_US);
+  void stop_progress();
+  void progress() const;
+  bool has_progress() const {return mpi_progress != NULL;}
+
+  //Logical to world tasks, with the most traffic on a node
+  int reorder_map(const double* traffic, int* map) const;
+
   //Destruction
   int destroy();
 
+  private:
+  //io groups of the node
+  int make_io_comms(const int io_per_node);
+
+  //node, socket, and NUMA domain of every task
+  int make_topology();
+
 };
 
+//MPI type of T
+#if defined LIBJ_MPI
+template <typename T> struct Pmpi_type {};
+template <> struct Pmpi_type<double> {static MPI_Datatype get() {return MPI_DOUBLE;}};
+template <> struct Pmpi_type<float>  {static MPI_Datatype get() {return MPI_FLOAT;}};
+template <> struct Pmpi_type<long>   {static MPI_Datatype get() {return MPI_LONG;}};
+template <> struct Pmpi_type<int>    {static MPI_Datatype get() {return MPI_INT;}};
+
+//frees the cached datatypes of strided views, see ptype.hpp
+void Ptype_free_all();
+#endif
+
 #endif
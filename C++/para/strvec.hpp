@@ -1,6 +1,8 @@
 /*-------------------------------------------------------------
   Strvec.hpp
 	JHT, Febuary 10, 2022 : created
+	JHT, October 14, 2026 : find_index uses a Phash
+	JHT, October 14, 2026 : grow with realloc, added moves
 
   .hpp file for Strvec, a C++ vector-style impementation of 
   C-like char arrays
@@ -9,6 +11,18 @@
   string lengths needed by para. To add a new string length,
   it must be added to the template declarations at the end of
   this .hpp file and the end of the relevant .cpp file 
+
+  find_index looks names up in a hash table, which is only
+  built on the first find_index, and which catches up with
+  any push_backs on the next one. erase, resize, and clear
+  mark it to be rebuilt. If the names are written through
+  operator[], call rehash() before the next find_index.
+
+  The elements are STRLEN slots, since Pfile writes them to 
+  disk as they are. For many short strings (e.g., messages), 
+  use the packed Stringvec of aprint.hpp instead. Growing uses
+  realloc, which can often extend the buffer in place, and a 
+  Strvec can be moved, but not copied.
 -------------------------------------------------------------*/
 #ifndef STRVEC_HPP
 #define STRVEC_HPP
@@ -16,6 +30,8 @@
 #include <string.h>
 #include <stdio.h>
 
+#include "phash.hpp"
+
 template<const int STRLEN>
 struct Strvec
 {
@@ -23,6 +39,8 @@ struct Strvec
   int           size;           //number of elements
   int           capacity;       //number of reserved elements
   char*         buffer;         //buffer
+  mutable Phash hash;           //name -> index
+  mutable long  nhashed;        //elements in hash, -1 to rebuild
 
   //Initializer
   Strvec();
@@ -30,6 +48,10 @@ struct Strvec
   //destructor
   ~Strvec();
 
+  //move
+  Strvec(Strvec&& other);
+  Strvec& operator= (Strvec&& other);
+
   //accessing vector elements
   char* operator[] (const long elem) {return (buffer+STRLEN*elem);}
   const char* operator[] (const long elem) const {return (buffer+STRLEN*elem);}
@@ -64,6 +86,16 @@ struct Strvec
   //compare
   int compare(const long elm, const char* name) const; 
 
+  //rebuild the hash table on the next find_index
+  void rehash() {nhashed = -1;}
+
+  private:
+  Strvec(const Strvec& other);
+  Strvec& operator= (const Strvec& other);
+
+  //realloc to len elements, zeroing the new ones
+  int realloc_to(const long len);
+
 };
 
 //--------------------------------------------------------
@@ -73,6 +105,7 @@ template<const int STRLEN>
 Strvec<STRLEN>::Strvec() 
 {
   buffer = (char*) malloc(sizeof(char)*STRLEN); 
+  nhashed = 0;
   if (buffer != NULL)
   {
     size = 0;
@@ -94,18 +127,70 @@ Strvec<STRLEN>::~Strvec()
   if (buffer != NULL) {free(buffer);}
 }
 
+//--------------------------------------------------------
+// Strvec move 
+//	the hash is rebuilt on the next find_index
+//--------------------------------------------------------
+template<const int STRLEN>
+Strvec<STRLEN>::Strvec(Strvec<STRLEN>&& other) 
+{
+  size = other.size;
+  capacity = other.capacity;
+  buffer = other.buffer;
+  nhashed = -1;
+  other.size = 0;
+  other.capacity = 0;
+  other.buffer = NULL;
+  other.nhashed = -1;
+}
+
+template<const int STRLEN>
+Strvec<STRLEN>& Strvec<STRLEN>::operator= (Strvec<STRLEN>&& other) 
+{
+  if (this != &other)
+  {
+    if (buffer != NULL) {free(buffer);}
+    size = other.size;
+    capacity = other.capacity;
+    buffer = other.buffer;
+    nhashed = -1;
+    other.size = 0;
+    other.capacity = 0;
+    other.buffer = NULL;
+    other.nhashed = -1;
+  }
+  return *this;
+}
+
+//--------------------------------------------------------
+// realloc_to
+//--------------------------------------------------------
+template<const int STRLEN>
+int Strvec<STRLEN>::realloc_to(const long len)
+{
+  char* newbuf = (char*) realloc(buffer,sizeof(char)*STRLEN*(len > 0 ? len : 1));
+  if (newbuf == NULL) {return 1;}
+  if (len > capacity) 
+  {
+    memset(newbuf+STRLEN*capacity,(char)0,sizeof(char)*STRLEN*(len-capacity));
+  }
+  buffer = newbuf;
+  capacity = len;
+  return 0;
+}
+
 //--------------------------------------------------------
 // Grow 
 //--------------------------------------------------------
 template<const int STRLEN>
 void Strvec<STRLEN>::grow()
 {
-  char* newbuf = (char*) malloc(sizeof(char)*capacity*2*STRLEN);
-  memmove(newbuf,buffer,sizeof(char)*capacity*STRLEN);
-  memset(newbuf+size*STRLEN,(char)0,sizeof(char)*capacity*STRLEN);
-  capacity *= 2;
-  free(buffer);
-  buffer = newbuf;
+  if (realloc_to(capacity > 0 ? 2*capacity : 1) != 0)
+  {
+    printf("\nERROR ERROR ERROR\n");
+    printf("Strvec<STRLEN>::grow could not realloc %d elements\n",2*capacity);
+    exit(1);
+  }
 }
 
 //--------------------------------------------------------
@@ -127,6 +212,7 @@ void Strvec<STRLEN>::clear()
 {
   memset(buffer,(char)0,sizeof(char)*size*STRLEN);
   size = 0;
+  rehash();
 }
 
 //--------------------------------------------------------
@@ -136,6 +222,10 @@ template<const int STRLEN>
 void Strvec<STRLEN>::destroy()
 {
   free(buffer);
+  buffer = NULL;
+  size = 0;
+  capacity = 0;
+  rehash();
 }
 
 //--------------------------------------------------------
@@ -144,21 +234,7 @@ void Strvec<STRLEN>::destroy()
 template<const int STRLEN>
 int Strvec<STRLEN>::reserve(const long len)
 {
-  if (capacity < len)
-  {
-    char* newbuf = (char*) malloc(sizeof(char)*STRLEN*len); 
-    if (newbuf != NULL)
-    {
-      memmove(newbuf,buffer,sizeof(char)*size*STRLEN);
-      memset(newbuf+size*STRLEN,(char)0,sizeof(char)*(len-size));
-      capacity = len;
-      free(buffer);
-      buffer = newbuf; 
-      return 0;
-    } else {
-      return 1; 
-    } 
-  }
+  if (capacity < len) {return realloc_to(len);}
   return 0;  
 }
 
@@ -171,6 +247,7 @@ int Strvec<STRLEN>::erase(const long elm)
   memmove(buffer+STRLEN*elm,buffer+STRLEN*(elm+1),sizeof(char)*STRLEN*(size-elm-1));
   memset(buffer+STRLEN*(size-1),(char)0,sizeof(char)*STRLEN);
   size--;
+  rehash();
   return 0;
 }
 
@@ -180,35 +257,39 @@ int Strvec<STRLEN>::erase(const long elm)
 template<const int STRLEN>
 int Strvec<STRLEN>::resize(const long len)
 {
-  char* newbuf = (char*) malloc(sizeof(char)*STRLEN*len); 
-  if (newbuf != NULL)
+  if (len < size) 
   {
-    memmove(newbuf,buffer,sizeof(char)*size*STRLEN);
-    memset(newbuf+size*STRLEN,(char)0,sizeof(char)*(len-size));
-    capacity = len;
-    size = capacity;
-    free(buffer);
-    buffer = newbuf; 
-    return 0;
-  } else {
-    return 1; 
-  } 
+    memset(buffer+STRLEN*len,(char)0,sizeof(char)*STRLEN*(size-len));
+  }
+  if (len > capacity && realloc_to(len) != 0) {return 1;}
+  size = len;
+  rehash();
   return 0;  
 }
 
 //--------------------------------------------------------
 // find_index 
-//	finds the index of a match of some string in
-//	the list
+//	finds the index of the first match of some string
+//	in the list
 //--------------------------------------------------------
 template<const int STRLEN>
 long Strvec<STRLEN>::find_index(const char* name) const
 {
-  for (long index=0;index<size;index++)
+  if (nhashed < 0 || nhashed > size) {hash.clear(); nhashed = 0;}
+  for (;nhashed<size;nhashed++)
   {
-    if (compare(index,name) == 0) {return index;} 
+    if (hash.insert(Phash::hash(buffer+STRLEN*nhashed,STRLEN),nhashed) != 0)
+    {
+      nhashed = -1;
+      for (long index=0;index<size;index++)
+      {
+        if (compare(index,name) == 0) {return index;} 
+      }
+      return -1;
+    }
   }
-  return -1;
+  return hash.find(Phash::hash(name,STRLEN),[&](const long index)
+                   {return compare(index,name) == 0;});
 }
 
 //--------------------------------------------------------
@@ -1,6 +1,12 @@
 /*----------------------------------------------------------
  simd.hpp
     JHT, October 22, 2021 : created
+    JHT, October 14, 2026 : LIBJ_CHECKED alias and alignment checks
+    JHT, October 14, 2026 : norms and extrema
+    JHT, October 14, 2026 : stream compaction
+    JHT, October 14, 2026 : fp16 and bf16 storage in the mixed precision
+    JHT, October 14, 2026 : reproducible sums and dots
+    JHT, October 14, 2026 : block checksums
 
   .hpp file to help compilers vectorize commonly used 
   SIMD style functions. 
@@ -11,7 +17,17 @@
   NOTE : if targetting the YMM registers with something like
          AVX256 instructions, it is best to align your arrays
          to the appropriate BYTES, and use the specialized
-         alignment functions 
+         alignment functions
+
+  NOTE : if compiled with AVX2 (and FMA), the aligned functions
+         for double and float with alignment >= 32 BYTES use
+         hand-coded intrinsic kernels (see simd_avx.hpp). With
+         AVX-512F, alignment >= 64 BYTES uses the ZMM registers
+
+  NOTE : with -DLIBJ_CHECKED (see debug.hpp), the kernels check
+         that their outputs do not partly overlap their inputs
+         (the same array is fine, except for copy), and the 
+         aligned functions check the alignment of the arrays
 
   CURRENTLY SUPPORTED TPYES
   ------------------------------
@@ -25,12 +41,29 @@
   dot           simd_dot<type[,alignment]>
   copy		simd_copy<type[,alignment]>
   zero		simd_zero<type[,alignment]>
+  streaming     simd_zero_stream, simd_scal_set_stream, simd_copy_stream
   loc		simd_loc<type[alignment]>
+  iamax,iamin   simd_iamax<type>, simd_iamin<type>
+  norms         simd_norm2, simd_sumsq, simd_amax, simd_max, simd_min
+  compaction    simd_compress<type>, simd_count_above<type>
   scalar op.    simd_scal_opr<type[,alignmet]>
   wxy		simd_wxz_opr<type[,alignment]>
   awxpy		simd_awxpy<type [,alignment]>
   raxmy		simd_raxmy<type[,alignment]>
   axpby         simd_axpby<type[,alignment]>
+  fused         simd_axpy_dot, simd_scal_copy, simd_elemwise_mul_reduce
+  pairwise      simd_reduction_add_pairwise<type>, simd_dot_pairwise<type>
+  kahan         simd_reduction_add_kahan<type>, simd_dot_kahan<type>
+  reproducible  simd_repro_reduction_add<type>, simd_repro_dot<type>
+  checksums     simd_crc32c, simd_par_crc32c, simd_hash64
+  threaded      simd_par_opr<type>
+  peeled        simd_auto_opr<type>, aligned kernels for unaligned arrays
+  machine       libj::MachineProfile, bandwidth and cutoffs
+  mixed prec.   simd_dot_acc, simd_reduction_add_acc, simd_axpy_acc, simd_convert
+  complex       simd_dot, simd_dotc, simd_axpy, simd_scal_mul, simd_zero, simd_copy
+  strided       simd_opr_strided<type>
+  gather        simd_gather_opr<type>, simd_scatter_opr<type>
+  inline        simd_inline_opr<type[,N]>, in simd_inline.hpp, for short vectors
 
   COMMING SOON
   ---------------
@@ -48,6 +81,11 @@
   #include <immintrin.h>
 #endif
 
+#include <complex>
+#include <stdint.h>
+#include "simd_half.hpp"
+#include "simd_repro.hpp"
+
 /*---------------------------------------------------------
  * reductions
  *
@@ -148,6 +186,249 @@ T simd_dot(const long N, const T* X, const T* Y);
 template <typename T, const int ALIGNMENT>
 T simd_dot(const long N, const T* X, const T* Y);
 
+/*---------------------------------------------------------
+ * fused operations 
+ *
+ * Replace two calls that stream the same data twice with one
+ * pass over memory
+ *
+ *  simd_axpy_dot<type [,align]>(const long N, const type A, const type* X,
+ *                               type* Y, const type* Z)
+ *    Y = Y + A*X, returns Y.Z 
+ *
+ *  simd_scal_copy<type [,align]>(const long N, const type A, const type* X,
+ *                                type* Y)
+ *    Y = A*X
+ *
+ *  simd_elemwise_mul_reduce<type [,align]>(const long N, const type* X,
+ *                                          const type* Y, type* Z)
+ *    Z = X*Y (element-wise), returns sum(Z)
+ *
+ *  type   -> type of the data (int, long, float, double)
+ *  align  -> optional, int, alignment of data in BYTES of all pointers
+ *  N      -> number of elements to act on	
+ * -------------------------------------------------------*/
+template <typename T>
+T simd_axpy_dot(const long N, const T A, const T* X, T* Y, const T* Z);
+template <typename T>
+void simd_scal_copy(const long N, const T A, const T* X, T* Y);
+template <typename T>
+T simd_elemwise_mul_reduce(const long N, const T* X, const T* Y, T* Z);
+
+template <typename T, const int ALIGNMENT>
+T simd_axpy_dot(const long N, const T A, const T* X, T* Y, const T* Z);
+template <typename T, const int ALIGNMENT>
+void simd_scal_copy(const long N, const T A, const T* X, T* Y);
+template <typename T, const int ALIGNMENT>
+T simd_elemwise_mul_reduce(const long N, const T* X, const T* Y, T* Z);
+
+/*---------------------------------------------------------
+ * accurate reductions and dots
+ *
+ *  simd_reduction_add_pairwise<type>(const long N, const type* X)
+ *  simd_dot_pairwise<type>(const long N, const type* X, const type* Y)
+ *    pairwise summation over sections of at most
+ *    SIMD_PAIRWISE_BLOCK elements, each taken with eight
+ *    independent accumulators. Error grows like log(N), and
+ *    the order of additions only depends on N (reproducible)
+ *    type -> int, long, float, double
+ *
+ *  simd_reduction_add_kahan<type>(const long N, const type* X)
+ *  simd_dot_kahan<type>(const long N, const type* X, const type* Y)
+ *    Kahan compensated summation, with four independent
+ *    lanes. Error does not grow with N. Do not compile with
+ *    -ffast-math
+ *    type -> float, double
+ * -------------------------------------------------------*/
+#define SIMD_PAIRWISE_BLOCK 256
+
+template <typename T>
+T simd_reduction_add_pairwise(const long N, const T* X);
+template <typename T>
+T simd_dot_pairwise(const long N, const T* X, const T* Y);
+
+template <typename T>
+T simd_reduction_add_kahan(const long N, const T* X);
+template <typename T>
+T simd_dot_kahan(const long N, const T* X, const T* Y);
+
+/*---------------------------------------------------------
+ * reproducible reductions and dots
+ *
+ *  simd_repro_reduction_add<type>(const long N, const type* X)
+ *  simd_repro_dot<type>(const long N, const type* X, const type* Y)
+ *  simd_par_repro_reduction_add<type>, simd_par_repro_dot<type>
+ *    the same bits for any number of OpenMP threads, any
+ *    alignment, and any split of X over MPI tasks (see
+ *    Para::repro_sum), from an exact sum of folds of each
+ *    element (simd_repro.hpp). Two passes over the data, and
+ *    about twice the flops of simd_dot. The error is below
+ *    the rounding of the result, unless N is very large.
+ *    type -> float, double (done in double)
+ *
+ *  the pieces, for a sum over several arrays or tasks. AMAX
+ *  (the largest |x| or |x*y| of all of them) and NTOT (the
+ *  number of all the elements) must be the same for all, the
+ *  folds S (SIMD_REPRO_FOLDS doubles) are added to, and can be
+ *  added in any order, and simd_repro_result(S) is the sum
+ *  simd_repro_amax<type>(N,X) and (N,X,Y), largest |x|, |x*y|
+ *  simd_repro_fold<type>(N,X,AMAX,NTOT,S) and (N,X,Y,...)
+ *  simd_par_repro_amax, simd_par_repro_fold, threaded
+ *
+ *  Do not compile with -ffast-math
+ * -------------------------------------------------------*/
+template <typename T>
+T simd_repro_reduction_add(const long N, const T* X);
+template <typename T>
+T simd_repro_dot(const long N, const T* X, const T* Y);
+template <typename T>
+T simd_par_repro_reduction_add(const long N, const T* X);
+template <typename T>
+T simd_par_repro_dot(const long N, const T* X, const T* Y);
+
+template <typename T>
+double simd_repro_amax(const long N, const T* X);
+template <typename T>
+double simd_repro_amax(const long N, const T* X, const T* Y);
+template <typename T>
+double simd_par_repro_amax(const long N, const T* X);
+template <typename T>
+double simd_par_repro_amax(const long N, const T* X, const T* Y);
+template <typename T>
+void simd_repro_fold(const long N, const T* X, const double AMAX, const long NTOT, double* S);
+template <typename T>
+void simd_repro_fold(const long N, const T* X, const T* Y, const double AMAX, const long NTOT, double* S);
+template <typename T>
+void simd_par_repro_fold(const long N, const T* X, const double AMAX, const long NTOT, double* S);
+template <typename T>
+void simd_par_repro_fold(const long N, const T* X, const T* Y, const double AMAX, const long NTOT, double* S);
+
+/*---------------------------------------------------------
+ * block checksums, of BYTES bytes at X (any alignment)
+ *
+ *  simd_crc32c(const long BYTES, const void* X, const uint32_t CRC=0)
+ *    CRC32C (Castagnoli), with the SSE4.2 crc32 instruction on
+ *    three streams (e.g., -march=native), or slicing-by-8
+ *    tables otherwise. CRC is the CRC32C of the data before,
+ *    to continue it, so simd_crc32c(n2,X+n1,simd_crc32c(n1,X))
+ *    is simd_crc32c(n1+n2,X). This detects all bursts of
+ *    errors of at most 32 bits, for checks of corruption
+ *  simd_par_crc32c(BYTES,X,CRC), threaded over blocks, the
+ *    same result
+ *  simd_crc32c_combine(CRC1,CRC2,BYTES2)
+ *    the CRC32C of A followed by B, from those of A (CRC1) and
+ *    B (CRC2, of BYTES2 bytes), e.g. over tasks or blocks
+ *  simd_hash64(const long BYTES, const void* X, const uint64_t SEED=0)
+ *    XXH64, a 64 bit hash at about the same speed, for telling
+ *    changed blocks from unchanged ones (2^-64 collisions)
+ * -------------------------------------------------------*/
+uint32_t simd_crc32c(const long BYTES, const void* X, const uint32_t CRC=0);
+uint32_t simd_par_crc32c(const long BYTES, const void* X, const uint32_t CRC=0);
+uint32_t simd_crc32c_combine(const uint32_t CRC1, const uint32_t CRC2, const long BYTES2);
+uint64_t simd_hash64(const long BYTES, const void* X, const uint64_t SEED=0);
+
+/*---------------------------------------------------------
+ * threaded (OpenMP) level-1 routines
+ *
+ *  simd_par_opr<type>(...) 
+ *    same arguments as simd_opr<type>, but N is split into
+ *    one chunk per OpenMP thread. Chunks start on multiples of
+ *    SIMD_PAR_LINE_BYTES, and reductions are added in thread
+ *    order. Falls back to the serial routine if
+ *    N < libj::simd_par_min_n() (see simd_machine.hpp, 
+ *    SIMD_PAR_MIN_N if not measured), if called from inside a parallel
+ *    region, or if compiled without OpenMP
+ *
+ *  type   -> type of the data (int, long, float, double)
+ *
+ *  Currently supported operations (_opr):
+ *  _dot, _reduction_add, _axpy, _axpby, _copy, _zero,
+ *  _scal_mul, _scal_set, _sumsq, _norm2, _amax, _max, _min,
+ *  _compress
+ *
+ *  simd_par_norm2 scales the norms of the chunks by the 
+ *  largest of them before they are put together, so it does 
+ *  not overflow either
+ * -------------------------------------------------------*/
+#define SIMD_PAR_MIN_N      65536
+#define SIMD_PAR_LINE_BYTES 64
+
+#include "simd_machine.hpp"
+
+template <typename T>
+T simd_par_dot(const long N, const T* X, const T* Y);
+template <typename T>
+T simd_par_reduction_add(const long N, const T* X);
+template <typename T>
+void simd_par_axpy(const long N, const T A, const T* X, T* Y);
+template <typename T>
+void simd_par_axpby(const long N, const T A, const T* X, const T B, T* Y);
+template <typename T>
+void simd_par_copy(const long N, const T* X, T* Y);
+template <typename T>
+void simd_par_zero(const long N, T* X);
+template <typename T>
+void simd_par_scal_mul(const long N, const T A, T* X);
+template <typename T>
+void simd_par_scal_set(const long N, const T A, T* X);
+template <typename T>
+T simd_par_sumsq(const long N, const T* X);
+template <typename T>
+T simd_par_norm2(const long N, const T* X);
+template <typename T>
+T simd_par_amax(const long N, const T* X);
+template <typename T>
+T simd_par_max(const long N, const T* X);
+template <typename T>
+T simd_par_min(const long N, const T* X);
+template <typename T>
+long simd_par_compress(const long N, const T* X, const T tol, long* IDX, T* VAL);
+
+/*---------------------------------------------------------
+ * run-time alignment peeling
+ *
+ *  simd_auto_opr<type>(...)
+ *    same arguments as simd_opr<type>, for arrays of unknown
+ *    alignment (views into tensors, arrays offset by a row).
+ *    The first elements are done with scalars, up to the 
+ *    first SIMD_AUTO_ALIGN BYTE boundary of the output (X for 
+ *    the reductions). If the other arrays are then aligned 
+ *    too, the rest is simd_opr<type,SIMD_AUTO_ALIGN>, else a
+ *    SIMD loop with only the output known to be aligned.
+ *    Arrays not aligned to sizeof(type), and short arrays,
+ *    go to simd_opr<type>
+ *
+ *  type   -> type of the data (int, long, float, double)
+ *
+ *  Currently supported operations (_opr):
+ *  _dot, _reduction_add, _axpy, _axpby, _copy, _zero,
+ *  _scal_mul, _scal_set
+ * -------------------------------------------------------*/
+#if defined (__AVX512F__)
+  #define SIMD_AUTO_ALIGN 64
+#elif defined (__AVX__)
+  #define SIMD_AUTO_ALIGN 32
+#else
+  #define SIMD_AUTO_ALIGN 16
+#endif
+
+template <typename T>
+T simd_auto_dot(const long N, const T* X, const T* Y);
+template <typename T>
+T simd_auto_reduction_add(const long N, const T* X);
+template <typename T>
+void simd_auto_axpy(const long N, const T A, const T* X, T* Y);
+template <typename T>
+void simd_auto_axpby(const long N, const T A, const T* X, const T B, T* Y);
+template <typename T>
+void simd_auto_copy(const long N, const T* X, T* Y);
+template <typename T>
+void simd_auto_zero(const long N, T* X);
+template <typename T>
+void simd_auto_scal_mul(const long N, const T A, T* X);
+template <typename T>
+void simd_auto_scal_set(const long N, const T A, T* X);
+
 /*---------------------------------------------------------
  * scal
  * scales the values of sequential memory
@@ -196,12 +477,101 @@ void simd_zero(const long N, T* X);
 template <typename T, const int ALIGNMENT>
 void simd_zero(const long N, T* X);
 
+/*---------------------------------------------------------
+ * streaming (non-temporal) stores
+ *
+ *  simd_zero_stream<type>(const long N, type* X)
+ *  simd_scal_set_stream<type>(const long N, const type A, type* X)
+ *  simd_copy_stream<type>(const long N, const type* X, type* Y)
+ *
+ *  Same as simd_zero, simd_scal_set, and simd_copy, but the
+ *  stores bypass the cache. Only worth it for buffers much
+ *  larger than the last level cache, which are not read again 
+ *  soon. No alignment is needed
+ *
+ *  The aligned AVX2 simd_zero and simd_scal_set switch to these
+ *  on their own above SIMD_STREAM_BYTES, which may be set at 
+ *  compile time (default 8 MB, about the LLC of one socket)
+ *
+ *  type   -> type of the data (int, long, float, double)
+ * -------------------------------------------------------*/
+#if !defined (SIMD_STREAM_BYTES)
+  #define SIMD_STREAM_BYTES (8L*1024L*1024L)
+#endif
+
+template <typename T>
+void simd_zero_stream(const long N, T* X);
+template <typename T>
+void simd_scal_set_stream(const long N, const T A, T* X);
+template <typename T>
+void simd_copy_stream(const long N, const T* X, T* Y);
+
+/*---------------------------------------------------------
+ * strided
+ *
+ *  simd_dot_strided<type>(const long N, const type* X, const long INCX,
+ *                         const type* Y, const long INCY)
+ *  simd_axpy_strided<type>(const long N, const type A, const type* X,
+ *                          const long INCX, type* Y, const long INCY)
+ *  simd_copy_strided<type>(const long N, const type* X, const long INCX,
+ *                          type* Y, const long INCY)
+ *  simd_scal_mul_strided<type>(const long N, const type A, type* X,
+ *                              const long INCX)
+ *  simd_zero_strided<type>(const long N, type* X, const long INCX)
+ *
+ *  Same as the contiguous routines, but element i of X is
+ *  *(X+i*INCX), e.g., INCX = LDA walks along a row of a column
+ *  major matrix. Negative strides walk backwards from X. Unit 
+ *  strides call the contiguous routines
+ *
+ *  type   -> type of the data (int, long, float, double)
+ *  INCX   -> long, stride between elements of X
+ *  INCY   -> long, stride between elements of Y
+ * -------------------------------------------------------*/
+template <typename T>
+T simd_dot_strided(const long N, const T* X, const long INCX, const T* Y, const long INCY);
+template <typename T>
+void simd_axpy_strided(const long N, const T A, const T* X, const long INCX, T* Y, const long INCY);
+template <typename T>
+void simd_copy_strided(const long N, const T* X, const long INCX, T* Y, const long INCY);
+template <typename T>
+void simd_scal_mul_strided(const long N, const T A, T* X, const long INCX);
+template <typename T>
+void simd_zero_strided(const long N, T* X, const long INCX);
+
+/*---------------------------------------------------------
+ * gather/scatter
+ *
+ *  simd_gather_axpy<type>(N, A, X, IDX, Y)  : Y[i] += A*X[IDX[i]]
+ *  simd_gather_dot<type>(N, X, IDX, Y)      : sum_i X[IDX[i]]*Y[i]
+ *  simd_gather_copy<type>(N, X, IDX, Y)     : Y[i] = X[IDX[i]]
+ *  simd_scatter_copy<type>(N, X, Y, IDX)    : Y[IDX[i]] = X[i]
+ *  simd_scatter_axpy<type>(N, A, X, Y, IDX) : Y[IDX[i]] += A*X[i]
+ *
+ *  The index list is always the argument after the array it
+ *  indexes. Y and X are contiguous otherwise. The indices of 
+ *  simd_scatter_axpy must not repeat
+ *
+ *  type   -> type of the data (int, long, float, double)
+ *  IDX*   -> const long*, N offsets into the indexed array 
+ * -------------------------------------------------------*/
+template <typename T>
+void simd_gather_axpy(const long N, const T A, const T* X, const long* IDX, T* Y);
+template <typename T>
+T simd_gather_dot(const long N, const T* X, const long* IDX, const T* Y);
+template <typename T>
+void simd_gather_copy(const long N, const T* X, const long* IDX, T* Y);
+template <typename T>
+void simd_scatter_copy(const long N, const T* X, T* Y, const long* IDX);
+template <typename T>
+void simd_scatter_axpy(const long N, const T A, const T* X, T* Y, const long* IDX);
+
 /*---------------------------------------------------------
  * loc 
  *  finds the first entry of a value in array X. If no entry
  *  matches, returns -1 
  *
- *  NOTE: this currently only works with int,long types
+ *  NOTE: floating point values are compared exactly
  *
  *  simd_loc<type[,align]>(const long N, const type A, const type* X)
  *
@@ -217,6 +587,80 @@ long simd_loc(const long N, const T A, const T* X);
 template <typename T, const int ALIGNMENT>
 long simd_loc(const long N, const T A, const T* X);
 
+/*---------------------------------------------------------
+ * iamax, iamin
+ *  returns the location of the first element with the largest
+ *  (iamax) or smallest (iamin) absolute value, starting at 0.
+ *  Returns -1 if N < 1. If X has a NaN, the location of the
+ *  first NaN is returned, wherever it is
+ *
+ *  simd_iamax<type>(const long N, const type* X)
+ *  simd_iamin<type>(const long N, const type* X)
+ *
+ *  type   -> type of the data (int, long, float, double)
+ *  N      -> long, Number of elements to act on
+ *  X*     -> address of first element of X to act on 
+ * -------------------------------------------------------*/
+template <typename T>
+long simd_iamax(const long N, const T* X);
+
+template <typename T>
+long simd_iamin(const long N, const T* X);
+
+/*---------------------------------------------------------
+ * norms and extrema
+ *
+ *  simd_sumsq<type>(const long N, const type* X) : sum of X[i]^2
+ *  simd_norm2<type>(const long N, const type* X) : sqrt(sum of X[i]^2)
+ *  simd_amax<type>(const long N, const type* X)  : max |X[i]|
+ *  simd_max<type>(const long N, const type* X)   : max X[i]
+ *  simd_min<type>(const long N, const type* X)   : min X[i]
+ *
+ *  simd_norm2 scales the squares (in one pass), so it does not
+ *  overflow or underflow where sqrt(simd_sumsq) would, and a NaN 
+ *  in X gives a NaN. For float, simd_sumsq and simd_norm2 sum
+ *  the squares in double. All return 0 if N < 1
+ *
+ *  type   -> type of the data (int, long, float, double), 
+ *            float and double for simd_norm2
+ * -------------------------------------------------------*/
+template <typename T>
+T simd_sumsq(const long N, const T* X);
+template <typename T>
+T simd_norm2(const long N, const T* X);
+template <typename T>
+T simd_amax(const long N, const T* X);
+template <typename T>
+T simd_max(const long N, const T* X);
+template <typename T>
+T simd_min(const long N, const T* X);
+
+/*---------------------------------------------------------
+ * compaction
+ *
+ *  simd_compress<type>(const long N, const type* X, const type tol,
+ *                      long* IDX, type* VAL)
+ *    writes the indices and the values of all X[i] with
+ *    |X[i]| > tol, in order, and returns how many. Nothing is
+ *    written past the last one, so IDX and VAL need room for
+ *    simd_count_above(N,X,tol) elements (N is always enough).
+ *    A NaN is never selected
+ *
+ *  simd_count_above<type>(const long N, const type* X, const type tol)
+ *    returns the number of |X[i]| > tol
+ *
+ *  type   -> type of the data (int, long, float, double)
+ *  N      -> long, Number of elements to act on
+ *  X*     -> address of first element of X to act on 
+ *  tol    -> threshold, tol < 0 selects every element
+ *  IDX*   -> indices of the selected elements
+ *  VAL*   -> values of the selected elements
+ * -------------------------------------------------------*/
+template <typename T>
+long simd_compress(const long N, const T* X, const T tol, long* IDX, T* VAL);
+template <typename T>
+long simd_count_above(const long N, const T* X, const T tol);
+
 /*---------------------------------------------------------
  * scal_opr
  *   performs a scalar operation of value A on array X. 
@@ -362,4 +806,91 @@ void simd_axpby(const long N, const T A, const T* X, const T B, T* Y);
 template <typename T, const int ALIGNMENT>
 void simd_axpby(const long N, const T A, const T* X, const T B, T* Y);
 
+/*---------------------------------------------------------
+ * mixed precision
+ *
+ * Data stored in type T, arithmetic done in the wider type TACC
+ * (or the type of A), e.g., float amplitudes with double 
+ * accumulation
+ *
+ *  simd_dot_acc<type,acc>(const long N, const type* X, const type* Y)
+ *  simd_reduction_add_acc<type,acc>(const long N, const type* X)
+ *  simd_axpy_acc<type,acc>(const long N, const acc A, const type* X, type* Y)
+ *  simd_convert<tx,ty>(const long N, const tx* X, ty* Y)
+ *
+ *  <type,acc> -> <float,double>, or <int,long> for the reductions
+ *  <tx,ty>    -> <double,float>, <float,double>, <int,double>, 
+ *                <long,double>
+ *
+ *  and for the 16 bit storage types libj::fp16 and libj::bf16
+ *  (simd_half.hpp, converted as they are loaded, simd_half.cpp)
+ *
+ *  <type,acc> -> <fp16,float>, <fp16,double>, <bf16,float>,
+ *                <bf16,double>
+ *  <tx,ty>    -> fp16 or bf16, to and from float or double
+ *
+ *  simd_axpy_acc rounds the result to type once per element
+ * -------------------------------------------------------*/
+template <typename T, typename TACC>
+TACC simd_dot_acc(const long N, const T* X, const T* Y);
+template <typename T, typename TACC>
+TACC simd_reduction_add_acc(const long N, const T* X);
+template <typename T, typename TA>
+void simd_axpy_acc(const long N, const TA A, const T* X, T* Y);
+template <typename TX, typename TY>
+void simd_convert(const long N, const TX* X, TY* Y);
+
+/*---------------------------------------------------------
+ * complex
+ *
+ * Interleaved (re,im) std::complex<double> and 
+ * std::complex<float> versions of the unaligned simd_dot,
+ * simd_axpy, simd_scal_mul, simd_zero, and simd_copy
+ *
+ * simd_dotc conjugates X, sum_i conj(X[i])*Y[i]. For real 
+ * types it is simd_dot
+ *
+ *  simd_dotc<type>(const long N, const type* X, const type* Y)
+ *
+ *  type   -> type of the data (double, float, std::complex<double>,
+ *            std::complex<float>)
+ * -------------------------------------------------------*/
+template <typename T>
+T simd_dotc(const long N, const T* X, const T* Y);
+
+template <>
+std::complex<double> simd_dot<std::complex<double> >(const long N, const std::complex<double>* X, 
+                                                     const std::complex<double>* Y);
+template <>
+std::complex<float> simd_dot<std::complex<float> >(const long N, const std::complex<float>* X, 
+                                                   const std::complex<float>* Y);
+template <>
+std::complex<double> simd_dotc<std::complex<double> >(const long N, const std::complex<double>* X, 
+                                                      const std::complex<double>* Y);
+template <>
+std::complex<float> simd_dotc<std::complex<float> >(const long N, const std::complex<float>* X, 
+                                                    const std::complex<float>* Y);
+template <>
+void simd_axpy<std::complex<double> >(const long N, const std::complex<double> A, 
+                                      const std::complex<double>* X, std::complex<double>* Y);
+template <>
+void simd_axpy<std::complex<float> >(const long N, const std::complex<float> A, 
+                                     const std::complex<float>* X, std::complex<float>* Y);
+template <>
+void simd_scal_mul<std::complex<double> >(const long N, const std::complex<double> A, 
+                                          std::complex<double>* X);
+template <>
+void simd_scal_mul<std::complex<float> >(const long N, const std::complex<float> A, 
+                                         std::complex<float>* X);
+template <>
+void simd_zero<std::complex<double> >(const long N, std::complex<double>* X);
+template <>
+void simd_zero<std::complex<float> >(const long N, std::complex<float>* X);
+template <>
+void simd_copy<std::complex<double> >(const long N, const std::complex<double>* X, 
+                                      std::complex<double>* Y);
+template <>
+void simd_copy<std::complex<float> >(const long N, const std::complex<float>* X, 
+                                     std::complex<float>* Y);
+
 #endif
@@ -0,0 +1,204 @@
+/* simd_auto.cpp
+ * JHT, October 14, 2026 : created
+ *
+ * .cpp file that implements the level-1 simd routines for arrays
+ * of unknown alignment, by peeling at run time
+ *
+ * 1) prologue : scalar elements, up to the first SIMD_AUTO_ALIGN
+ *    BYTE boundary of the output (of X for the reductions)
+ * 2) body     : if every array is then aligned (their offsets from
+ *    the boundary agree), the aligned simd_opr<T,SIMD_AUTO_ALIGN>,
+ *    which are the hand-coded AVX kernels for double and float.
+ *    Otherwise an OpenMP SIMD loop with the output assumed aligned,
+ *    so only the loads are unaligned
+ * 3) epilogue : the last N%W elements, left to the kernel's
+ *    cleanup (masked, when the compiler targets AVX-512)
+ *
+ * Arrays shorter than SIMD_AUTO_MIN_BYTES, or not aligned to
+ * sizeof(T), go to the unaligned simd_opr<T>
+ *
+ */
+
+#include <stdint.h>
+#include "simd.hpp"
+#include "libjdef.h"
+
+//shorter arrays are not worth the peel
+#define SIMD_AUTO_MIN_BYTES (4*SIMD_AUTO_ALIGN)
+
+/*---------------------------------------------------------------------
+ * number of elements of P to peel, before it is aligned
+ * to SIMD_AUTO_ALIGN. -1 if it cannot be, or N is short
+ *---------------------------------------------------------------------*/
+template <typename T>
+static inline long simd_auto_peel(const long N, const T* P)
+{
+  const uintptr_t off = (uintptr_t) P%SIMD_AUTO_ALIGN;
+  if (N*(long) sizeof(T) < SIMD_AUTO_MIN_BYTES || off%sizeof(T) != 0) return -1;
+  return (off == 0) ? 0 : (long) ((SIMD_AUTO_ALIGN - off)/sizeof(T));
+}
+
+//true if P is aligned to SIMD_AUTO_ALIGN
+template <typename T>
+static inline bool simd_auto_aligned(const T* P)
+{
+  return (uintptr_t) P%SIMD_AUTO_ALIGN == 0;
+}
+
+/*---------------------------------------------------------------------
+ * dot
+ *---------------------------------------------------------------------*/
+template <typename T>
+T simd_auto_dot(const long N, const T* X, const T* Y)
+{
+  const long P = simd_auto_peel<T>(N,X);
+  if (P < 0) return simd_dot<T>(N,X,Y);
+  T dot = (T) 0;
+  for (long i=0;i<P;i++) dot += X[i]*Y[i];
+  if (simd_auto_aligned<T>(Y+P)) return dot + simd_dot<T,SIMD_AUTO_ALIGN>(N-P,X+P,Y+P);
+  const T* x = (const T*) LIBJ_ASSUME_ALIGNED(X+P,SIMD_AUTO_ALIGN);
+  const T* y = Y+P;
+  T sum = (T) 0;
+  #if defined (_OPENMP)
+  #pragma omp simd reduction(+:sum)
+  #endif
+  for (long i=0;i<N-P;i++) sum += x[i]*y[i];
+  return dot + sum;
+}
+template double simd_auto_dot<double>(const long N, const double* X, const double* Y);
+template float simd_auto_dot<float>(const long N, const float* X, const float* Y);
+template long simd_auto_dot<long>(const long N, const long* X, const long* Y);
+template int simd_auto_dot<int>(const long N, const int* X, const int* Y);
+
+/*---------------------------------------------------------------------
+ * reduction add
+ *---------------------------------------------------------------------*/
+template <typename T>
+T simd_auto_reduction_add(const long N, const T* X)
+{
+  const long P = simd_auto_peel<T>(N,X);
+  if (P < 0) return simd_reduction_add<T>(N,X);
+  T sum = (T) 0;
+  for (long i=0;i<P;i++) sum += X[i];
+  return sum + simd_reduction_add<T,SIMD_AUTO_ALIGN>(N-P,X+P);
+}
+template double simd_auto_reduction_add<double>(const long N, const double* X);
+template float simd_auto_reduction_add<float>(const long N, const float* X);
+template long simd_auto_reduction_add<long>(const long N, const long* X);
+template int simd_auto_reduction_add<int>(const long N, const int* X);
+
+/*---------------------------------------------------------------------
+ * axpy
+ *   the restrict loop is only reached for X != Y, as the same
+ *   array is always aligned after the peel
+ *---------------------------------------------------------------------*/
+template <typename T>
+void simd_auto_axpy(const long N, const T A, const T* X, T* Y)
+{
+  const long P = simd_auto_peel<T>(N,Y);
+  if (P < 0) {simd_axpy<T>(N,A,X,Y); return;}
+  for (long i=0;i<P;i++) Y[i] += A*X[i];
+  if (simd_auto_aligned<T>(X+P)) {simd_axpy<T,SIMD_AUTO_ALIGN>(N-P,A,X+P,Y+P); return;}
+  T* LIBJ_RESTRICT y = (T*) LIBJ_ASSUME_ALIGNED(Y+P,SIMD_AUTO_ALIGN);
+  const T* LIBJ_RESTRICT x = X+P;
+  #if defined (_OPENMP)
+  #pragma omp simd
+  #endif
+  for (long i=0;i<N-P;i++) y[i] += A*x[i];
+}
+template void simd_auto_axpy<double>(const long N, const double A, const double* X, double* Y);
+template void simd_auto_axpy<float>(const long N, const float A, const float* X, float* Y);
+template void simd_auto_axpy<long>(const long N, const long A, const long* X, long* Y);
+template void simd_auto_axpy<int>(const long N, const int A, const int* X, int* Y);
+
+/*---------------------------------------------------------------------
+ * axpby
+ *---------------------------------------------------------------------*/
+template <typename T>
+void simd_auto_axpby(const long N, const T A, const T* X, const T B, T* Y)
+{
+  const long P = simd_auto_peel<T>(N,Y);
+  if (P < 0) {simd_axpby<T>(N,A,X,B,Y); return;}
+  for (long i=0;i<P;i++) Y[i] = A*X[i] + B*Y[i];
+  if (simd_auto_aligned<T>(X+P)) {simd_axpby<T,SIMD_AUTO_ALIGN>(N-P,A,X+P,B,Y+P); return;}
+  T* LIBJ_RESTRICT y = (T*) LIBJ_ASSUME_ALIGNED(Y+P,SIMD_AUTO_ALIGN);
+  const T* LIBJ_RESTRICT x = X+P;
+  #if defined (_OPENMP)
+  #pragma omp simd
+  #endif
+  for (long i=0;i<N-P;i++) y[i] = A*x[i] + B*y[i];
+}
+template void simd_auto_axpby<double>(const long N, const double A, const double* X, const double B, double* Y);
+template void simd_auto_axpby<float>(const long N, const float A, const float* X, const float B, float* Y);
+template void simd_auto_axpby<long>(const long N, const long A, const long* X, const long B, long* Y);
+template void simd_auto_axpby<int>(const long N, const int A, const int* X, const int B, int* Y);
+
+/*---------------------------------------------------------------------
+ * copy
+ *---------------------------------------------------------------------*/
+template <typename T>
+void simd_auto_copy(const long N, const T* X, T* Y)
+{
+  const long P = simd_auto_peel<T>(N,Y);
+  if (P < 0) {simd_copy<T>(N,X,Y); return;}
+  for (long i=0;i<P;i++) Y[i] = X[i];
+  if (simd_auto_aligned<T>(X+P)) {simd_copy<T,SIMD_AUTO_ALIGN>(N-P,X+P,Y+P); return;}
+  T* LIBJ_RESTRICT y = (T*) LIBJ_ASSUME_ALIGNED(Y+P,SIMD_AUTO_ALIGN);
+  const T* LIBJ_RESTRICT x = X+P;
+  #if defined (_OPENMP)
+  #pragma omp simd
+  #endif
+  for (long i=0;i<N-P;i++) y[i] = x[i];
+}
+template void simd_auto_copy<double>(const long N, const double* X, double* Y);
+template void simd_auto_copy<float>(const long N, const float* X, float* Y);
+template void simd_auto_copy<long>(const long N, const long* X, long* Y);
+template void simd_auto_copy<int>(const long N, const int* X, int* Y);
+
+/*---------------------------------------------------------------------
+ * zero
+ *---------------------------------------------------------------------*/
+template <typename T>
+void simd_auto_zero(const long N, T* X)
+{
+  const long P = simd_auto_peel<T>(N,X);
+  if (P < 0) {simd_zero<T>(N,X); return;}
+  for (long i=0;i<P;i++) X[i] = (T) 0;
+  simd_zero<T,SIMD_AUTO_ALIGN>(N-P,X+P);
+}
+template void simd_auto_zero<double>(const long N, double* X);
+template void simd_auto_zero<float>(const long N, float* X);
+template void simd_auto_zero<long>(const long N, long* X);
+template void simd_auto_zero<int>(const long N, int* X);
+
+/*---------------------------------------------------------------------
+ * scal mul
+ *---------------------------------------------------------------------*/
+template <typename T>
+void simd_auto_scal_mul(const long N, const T A, T* X)
+{
+  const long P = simd_auto_peel<T>(N,X);
+  if (P < 0) {simd_scal_mul<T>(N,A,X); return;}
+  for (long i=0;i<P;i++) X[i] *= A;
+  simd_scal_mul<T,SIMD_AUTO_ALIGN>(N-P,A,X+P);
+}
+template void simd_auto_scal_mul<double>(const long N, const double A, double* X);
+template void simd_auto_scal_mul<float>(const long N, const float A, float* X);
+template void simd_auto_scal_mul<long>(const long N, const long A, long* X);
+template void simd_auto_scal_mul<int>(const long N, const int A, int* X);
+
+/*---------------------------------------------------------------------
+ * scal set
+ *---------------------------------------------------------------------*/
+template <typename T>
+void simd_auto_scal_set(const long N, const T A, T* X)
+{
+  const long P = simd_auto_peel<T>(N,X);
+  if (P < 0) {simd_scal_set<T>(N,A,X); return;}
+  for (long i=0;i<P;i++) X[i] = A;
+  simd_scal_set<T,SIMD_AUTO_ALIGN>(N-P,A,X+P);
+}
+template void simd_auto_scal_set<double>(const long N, const double A, double* X);
+template void simd_auto_scal_set<float>(const long N, const float A, float* X);
+template void simd_auto_scal_set<long>(const long N, const long A, long* X);
+template void simd_auto_scal_set<int>(const long N, const int A, int* X);
@@ -0,0 +1,236 @@
+/*----------------------------------------------------------
+ simd_avx.hpp
+    JHT, October 14, 2026 : created
+
+  .hpp file with thin wrappers around the SSE2, AVX2 and
+  AVX-512 intrinsics, used by the hand-coded aligned kernels
+  of the simd_* routines and the runtime dispatched kernels.
+
+  simd_vec<type,bytes> provides the register type, the
+  aligned (load/store) and unaligned (loadu/storeu) memory
+  operations, and arithmetic for one register width:
+
+    simd_vec<double,16>  -> __m128d (SSE2)
+    simd_vec<float,16>   -> __m128  (SSE2)
+    simd_vec<double,32>  -> __m256d (AVX2)
+    simd_vec<float,32>   -> __m256  (AVX2)
+    simd_vec<double,64>  -> __m512d (AVX-512F)
+    simd_vec<float,64>   -> __m512  (AVX-512F)
+
+  W is the number of elements per register. If FMA is
+  available, fmadd(a,b,c) = a*b+c is a single fused instruction
+
+  Everything is in an anonymous namespace. The dispatch .cpp
+  files include this with other -m flags than the rest of the
+  library, and inline members with external linkage would be
+  merged by the linker across the two, so an AVX2 kernel could
+  end up calling an AVX-512 encoded copy.
+
+  NOTE : this file is only used internally by the simd
+         .cpp files, and is not part of the public interface
+----------------------------------------------------------*/
+#ifndef SIMD_AVX_HPP
+#define SIMD_AVX_HPP
+
+#if defined (__SSE2__)
+#include <immintrin.h>
+
+namespace
+{
+
+template <typename T, const int BYTES>
+struct simd_vec;
+
+//------------------------------------------------------
+// SSE2, doubles
+template <>
+struct simd_vec<double,16>
+{
+  typedef __m128d V;
+  static const long W = 2;
+  static inline V load(const double* p) {return _mm_load_pd(p);}
+  static inline V loadu(const double* p) {return _mm_loadu_pd(p);}
+  static inline void store(double* p, const V a) {_mm_store_pd(p,a);}
+  static inline void storeu(double* p, const V a) {_mm_storeu_pd(p,a);}
+  static inline V set1(const double a) {return _mm_set1_pd(a);}
+  static inline V zero() {return _mm_setzero_pd();}
+  static inline V add(const V a, const V b) {return _mm_add_pd(a,b);}
+  static inline V sub(const V a, const V b) {return _mm_sub_pd(a,b);}
+  static inline V mul(const V a, const V b) {return _mm_mul_pd(a,b);}
+  static inline V div(const V a, const V b) {return _mm_div_pd(a,b);}
+  static inline V fmadd(const V a, const V b, const V c)
+  {
+    #if defined (__FMA__)
+      return _mm_fmadd_pd(a,b,c);
+    #else
+      return _mm_add_pd(_mm_mul_pd(a,b),c);
+    #endif
+  }
+  static inline double hsum(const V a)
+  {
+    return _mm_cvtsd_f64(_mm_add_sd(a,_mm_unpackhi_pd(a,a)));
+  }
+};
+
+//------------------------------------------------------
+// SSE2, floats
+template <>
+struct simd_vec<float,16>
+{
+  typedef __m128 V;
+  static const long W = 4;
+  static inline V load(const float* p) {return _mm_load_ps(p);}
+  static inline V loadu(const float* p) {return _mm_loadu_ps(p);}
+  static inline void store(float* p, const V a) {_mm_store_ps(p,a);}
+  static inline void storeu(float* p, const V a) {_mm_storeu_ps(p,a);}
+  static inline V set1(const float a) {return _mm_set1_ps(a);}
+  static inline V zero() {return _mm_setzero_ps();}
+  static inline V add(const V a, const V b) {return _mm_add_ps(a,b);}
+  static inline V sub(const V a, const V b) {return _mm_sub_ps(a,b);}
+  static inline V mul(const V a, const V b) {return _mm_mul_ps(a,b);}
+  static inline V div(const V a, const V b) {return _mm_div_ps(a,b);}
+  static inline V fmadd(const V a, const V b, const V c)
+  {
+    #if defined (__FMA__)
+      return _mm_fmadd_ps(a,b,c);
+    #else
+      return _mm_add_ps(_mm_mul_ps(a,b),c);
+    #endif
+  }
+  static inline float hsum(const V a)
+  {
+    __m128 hi = _mm_movehl_ps(a,a);
+    __m128 lo = _mm_add_ps(a,hi);
+    hi = _mm_shuffle_ps(lo,lo,0x1);
+    return _mm_cvtss_f32(_mm_add_ss(lo,hi));
+  }
+};
+
+#if defined (__AVX2__)
+
+//------------------------------------------------------
+// AVX2, doubles
+template <>
+struct simd_vec<double,32>
+{
+  typedef __m256d V;
+  static const long W = 4;
+  static inline V load(const double* p) {return _mm256_load_pd(p);}
+  static inline V loadu(const double* p) {return _mm256_loadu_pd(p);}
+  static inline void store(double* p, const V a) {_mm256_store_pd(p,a);}
+  static inline void storeu(double* p, const V a) {_mm256_storeu_pd(p,a);}
+  static inline V set1(const double a) {return _mm256_set1_pd(a);}
+  static inline V zero() {return _mm256_setzero_pd();}
+  static inline V add(const V a, const V b) {return _mm256_add_pd(a,b);}
+  static inline V sub(const V a, const V b) {return _mm256_sub_pd(a,b);}
+  static inline V mul(const V a, const V b) {return _mm256_mul_pd(a,b);}
+  static inline V div(const V a, const V b) {return _mm256_div_pd(a,b);}
+  static inline V fmadd(const V a, const V b, const V c)
+  {
+    #if defined (__FMA__)
+      return _mm256_fmadd_pd(a,b,c);
+    #else
+      return _mm256_add_pd(_mm256_mul_pd(a,b),c);
+    #endif
+  }
+  static inline double hsum(const V a)
+  {
+    __m128d lo = _mm256_castpd256_pd128(a);
+    __m128d hi = _mm256_extractf128_pd(a,1);
+    lo = _mm_add_pd(lo,hi);
+    hi = _mm_unpackhi_pd(lo,lo);
+    return _mm_cvtsd_f64(_mm_add_sd(lo,hi));
+  }
+};
+
+//------------------------------------------------------
+// AVX2, floats
+template <>
+struct simd_vec<float,32>
+{
+  typedef __m256 V;
+  static const long W = 8;
+  static inline V load(const float* p) {return _mm256_load_ps(p);}
+  static inline V loadu(const float* p) {return _mm256_loadu_ps(p);}
+  static inline void store(float* p, const V a) {_mm256_store_ps(p,a);}
+  static inline void storeu(float* p, const V a) {_mm256_storeu_ps(p,a);}
+  static inline V set1(const float a) {return _mm256_set1_ps(a);}
+  static inline V zero() {return _mm256_setzero_ps();}
+  static inline V add(const V a, const V b) {return _mm256_add_ps(a,b);}
+  static inline V sub(const V a, const V b) {return _mm256_sub_ps(a,b);}
+  static inline V mul(const V a, const V b) {return _mm256_mul_ps(a,b);}
+  static inline V div(const V a, const V b) {return _mm256_div_ps(a,b);}
+  static inline V fmadd(const V a, const V b, const V c)
+  {
+    #if defined (__FMA__)
+      return _mm256_fmadd_ps(a,b,c);
+    #else
+      return _mm256_add_ps(_mm256_mul_ps(a,b),c);
+    #endif
+  }
+  static inline float hsum(const V a)
+  {
+    __m128 lo = _mm256_castps256_ps128(a);
+    __m128 hi = _mm256_extractf128_ps(a,1);
+    lo = _mm_add_ps(lo,hi);
+    hi = _mm_movehl_ps(hi,lo);
+    lo = _mm_add_ps(lo,hi);
+    hi = _mm_shuffle_ps(lo,lo,0x1);
+    return _mm_cvtss_f32(_mm_add_ss(lo,hi));
+  }
+};
+
+#if defined (__AVX512F__)
+//------------------------------------------------------
+// AVX-512, doubles
+template <>
+struct simd_vec<double,64>
+{
+  typedef __m512d V;
+  static const long W = 8;
+  static inline V load(const double* p) {return _mm512_load_pd(p);}
+  static inline V loadu(const double* p) {return _mm512_loadu_pd(p);}
+  static inline void store(double* p, const V a) {_mm512_store_pd(p,a);}
+  static inline void storeu(double* p, const V a) {_mm512_storeu_pd(p,a);}
+  static inline V set1(const double a) {return _mm512_set1_pd(a);}
+  static inline V zero() {return _mm512_setzero_pd();}
+  static inline V add(const V a, const V b) {return _mm512_add_pd(a,b);}
+  static inline V sub(const V a, const V b) {return _mm512_sub_pd(a,b);}
+  static inline V mul(const V a, const V b) {return _mm512_mul_pd(a,b);}
+  static inline V div(const V a, const V b) {return _mm512_div_pd(a,b);}
+  static inline V fmadd(const V a, const V b, const V c) {return _mm512_fmadd_pd(a,b,c);}
+  static inline double hsum(const V a) {return _mm512_reduce_add_pd(a);}
+};
+
+//------------------------------------------------------
+// AVX-512, floats
+template <>
+struct simd_vec<float,64>
+{
+  typedef __m512 V;
+  static const long W = 16;
+  static inline V load(const float* p) {return _mm512_load_ps(p);}
+  static inline V loadu(const float* p) {return _mm512_loadu_ps(p);}
+  static inline void store(float* p, const V a) {_mm512_store_ps(p,a);}
+  static inline void storeu(float* p, const V a) {_mm512_storeu_ps(p,a);}
+  static inline V set1(const float a) {return _mm512_set1_ps(a);}
+  static inline V zero() {return _mm512_setzero_ps();}
+  static inline V add(const V a, const V b) {return _mm512_add_ps(a,b);}
+  static inline V sub(const V a, const V b) {return _mm512_sub_ps(a,b);}
+  static inline V mul(const V a, const V b) {return _mm512_mul_ps(a,b);}
+  static inline V div(const V a, const V b) {return _mm512_div_ps(a,b);}
+  static inline V fmadd(const V a, const V b, const V c) {return _mm512_fmadd_ps(a,b,c);}
+  static inline float hsum(const V a) {return _mm512_reduce_add_ps(a);}
+};
+
+//widest register that a 64 BYTE alignment claim allows
+#define SIMD_AVX_WIDE 64
+#else
+#define SIMD_AVX_WIDE 32
+#endif
+
+#endif
+
+}
+#endif
+#endif
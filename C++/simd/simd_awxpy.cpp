@@ -13,10 +13,16 @@ nst type* X, type* Y)
  *  W*     -> Address of first element of W to act on
  *  X*     -> Address of first element of X to act on
  *  Y*     -> Address of first element of Y to act on
+ *
+ * Hand-coded AVX2/AVX-512 routines are used for doubles and floats
+ * claimed to be aligned to 32 or 64 BYTE boundaries
+ *
  * -------------------------------------------------------*/
 
 
 #include "simd.hpp"
+#include "debug.hpp"
+#include "simd_avx.hpp"
 
 /*---------------------------------------------------------------------
  * awxpy without (known) alignment
@@ -25,6 +31,8 @@ nst type* X, type* Y)
 template <typename T>
 void simd_awxpy(const long N, const T A, const T* W, const T* X, T* Y)
 {
+  LIBJ_CHECK_INPLACE(W,N,Y,N);
+  LIBJ_CHECK_INPLACE(X,N,Y,N);
   #if defined (_OPENMP)
     T TMP;
     #pragma omp simd  
@@ -71,6 +79,11 @@ template void simd_awxpy<int>(const long N, const int A, const int* W, const int
 template <typename T, const int ALIGNMENT>
 void simd_awxpy(const long N, const T A, const T* W, const T* X, T* Y)
 {
+  LIBJ_CHECK_ALIGNED(W,ALIGNMENT);
+  LIBJ_CHECK_ALIGNED(X,ALIGNMENT);
+  LIBJ_CHECK_ALIGNED(Y,ALIGNMENT);
+  LIBJ_CHECK_INPLACE(W,N,Y,N);
+  LIBJ_CHECK_INPLACE(X,N,Y,N);
   #if defined (_OPENMP)
     T TMP;
     #pragma omp simd  aligned(W,X,Y:ALIGNMENT) 
@@ -105,13 +118,17 @@ void simd_awxpy(const long N, const T A, const T* W, const T* X, T* Y)
   #endif
 }
 
+#if !defined (__AVX2__) //special instructions below
 template void simd_awxpy<double,64>(const long N, const double A, const double* W, const double* X, double* Y);
 template void simd_awxpy<double,32>(const long N, const double A, const double* W, const double* X, double* Y);
+#endif
 template void simd_awxpy<double,16>(const long N, const double A, const double* W, const double* X, double* Y);
 template void simd_awxpy<double,8>(const long N, const double A, const double* W, const double* X, double* Y);
 
+#if !defined (__AVX2__) //special instructions below
 template void simd_awxpy<float,64>(const long N, const float A, const float* W, const float* X, float* Y);
 template void simd_awxpy<float,32>(const long N, const float A, const float* W, const float* X, float* Y);
+#endif
 template void simd_awxpy<float,16>(const long N, const float A, const float* W, const float* X, float* Y);
 template void simd_awxpy<float,8>(const long N, const float A, const float* W, const float* X, float* Y);
 template void simd_awxpy<float,4>(const long N, const float A, const float* W, const float* X, float* Y);
@@ -126,3 +143,58 @@ template void simd_awxpy<int,32>(const long N, const int A, const int* W, const
 template void simd_awxpy<int,16>(const long N, const int A, const int* W, const int* X, int* Y);
 template void simd_awxpy<int,8>(const long N, const int A, const int* W, const int* X, int* Y);
 template void simd_awxpy<int,4>(const long N, const int A, const int* W, const int* X, int* Y);
+
+//------------------------------------------------------------------------------
+//  Hand-coded routines for doubles and floats claimed to be aligned to
+//  32 or 64 BYTE boundaries. 64 BYTE claims use AVX-512 if available,
+//  128 BYTE claims use the 64 BYTE code
+#if defined (__AVX2__)
+template <typename T, const int BYTES>
+static inline void simd_awxpy_avx(const long N, const T A, const T* W, const T* X, T* Y)
+{
+  typedef simd_vec<T,BYTES> S;
+  const long NW = S::W;
+  const typename S::V a = S::set1(A);
+  long i=0;
+
+  for (i=0;i+2*NW<=N;i+=2*NW)
+  {
+    S::store(Y+i,S::fmadd(a,S::mul(S::load(W+i),S::load(X+i)),S::load(Y+i)));
+    S::store(Y+i+NW,S::fmadd(a,S::mul(S::load(W+i+NW),S::load(X+i+NW)),S::load(Y+i+NW)));
+  }
+  for (i=i;i+NW<=N;i+=NW)
+  {
+    S::store(Y+i,S::fmadd(a,S::mul(S::load(W+i),S::load(X+i)),S::load(Y+i)));
+  }
+
+  //cleanup
+  for (i=i;i<N;i++)
+  {
+    *(Y+i) += A * *(W+i) * *(X+i);
+  }
+}
+
+template<>
+void simd_awxpy<double,32>(const long N, const double A, const double* W, const double* X, double* Y)
+{
+  simd_awxpy_avx<double,32>(N,A,W,X,Y);
+}
+
+template<>
+void simd_awxpy<double,64>(const long N, const double A, const double* W, const double* X, double* Y)
+{
+  simd_awxpy_avx<double,SIMD_AVX_WIDE>(N,A,W,X,Y);
+}
+
+template<>
+void simd_awxpy<float,32>(const long N, const float A, const float* W, const float* X, float* Y)
+{
+  simd_awxpy_avx<float,32>(N,A,W,X,Y);
+}
+
+template<>
+void simd_awxpy<float,64>(const long N, const float A, const float* W, const float* X, float* Y)
+{
+  simd_awxpy_avx<float,SIMD_AVX_WIDE>(N,A,W,X,Y);
+}
+#endif
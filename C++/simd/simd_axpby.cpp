@@ -7,9 +7,14 @@
  * If compiled with OpenMP, will use the OpenMP SIMD pragmas to 
  * provide hints to the compiler
  *
+ * Hand-coded AVX2/AVX-512 routines are used for doubles and floats
+ * claimed to be aligned to 32 or 64 BYTE boundaries
+ *
  */
 
 #include "simd.hpp"
+#include "debug.hpp"
+#include "simd_avx.hpp"
 
 /*---------------------------------------------------------------------
  * axpby without (known) alignment
@@ -18,6 +23,7 @@
 template <typename T>
 void simd_axpby(const long N, const T A, const T* X, const T B, T* Y)
 {
+  LIBJ_CHECK_INPLACE(X,N,Y,N);
   #if defined (_OPENMP)
     T TMP;
     #pragma omp simd  
@@ -70,6 +76,9 @@ template void simd_axpby<int>(const long N, const int A, const int* X, const int
 template <typename T, const int ALIGNMENT>
 void simd_axpby(const long N, const T A, const T* X, const T B, T* Y)
 {
+  LIBJ_CHECK_ALIGNED(X,ALIGNMENT);
+  LIBJ_CHECK_ALIGNED(Y,ALIGNMENT);
+  LIBJ_CHECK_INPLACE(X,N,Y,N);
   #if defined (_OPENMP)
     T TMP;
     #pragma omp simd  aligned(X,Y:ALIGNMENT) 
@@ -110,24 +119,100 @@ void simd_axpby(const long N, const T A, const T* X, const T B, T* Y)
   #endif
 }
 
+#if !defined (__AVX2__) //special instructions below
+template void simd_axpby<double,128>(const long N, const double A, const double* X, const double B, double* Y);
 template void simd_axpby<double,64>(const long N, const double A, const double* X, const double B, double* Y);
 template void simd_axpby<double,32>(const long N, const double A, const double* X, const double B, double* Y);
+#endif
 template void simd_axpby<double,16>(const long N, const double A, const double* X, const double B, double* Y);
 template void simd_axpby<double,8>(const long N, const double A, const double* X, const double B, double* Y);
 
+#if !defined (__AVX2__) //special instructions below
+template void simd_axpby<float,128>(const long N, const float A, const float* X, const float B, float* Y);
 template void simd_axpby<float,64>(const long N, const float A, const float* X, const float B, float* Y);
 template void simd_axpby<float,32>(const long N, const float A, const float* X, const float B, float* Y);
+#endif
 template void simd_axpby<float,16>(const long N, const float A, const float* X, const float B, float* Y);
 template void simd_axpby<float,8>(const long N, const float A, const float* X, const float B, float* Y);
 template void simd_axpby<float,4>(const long N, const float A, const float* X, const float B, float* Y);
 
+template void simd_axpby<long,128>(const long N, const long A, const long* X, const long B, long* Y);
 template void simd_axpby<long,64>(const long N, const long A, const long* X, const long B, long* Y);
 template void simd_axpby<long,32>(const long N, const long A, const long* X, const long B, long* Y);
 template void simd_axpby<long,16>(const long N, const long A, const long* X, const long B, long* Y);
 template void simd_axpby<long,8>(const long N, const long A, const long* X, const long B, long* Y);
 
+template void simd_axpby<int,128>(const long N, const int A, const int* X, const int B, int* Y);
 template void simd_axpby<int,64>(const long N, const int A, const int* X, const int B, int* Y);
 template void simd_axpby<int,32>(const long N, const int A, const int* X, const int B, int* Y);
 template void simd_axpby<int,16>(const long N, const int A, const int* X, const int B, int* Y);
 template void simd_axpby<int,8>(const long N, const int A, const int* X, const int B, int* Y);
 template void simd_axpby<int,4>(const long N, const int A, const int* X, const int B, int* Y);
+
+//------------------------------------------------------------------------------
+//  Hand-coded routines for doubles and floats claimed to be aligned to
+//  32 or 64 BYTE boundaries. 64 BYTE claims use AVX-512 if available,
+//  128 BYTE claims use the 64 BYTE code
+#if defined (__AVX2__)
+template <typename T, const int BYTES>
+static inline void simd_axpby_avx(const long N, const T A, const T* X, const T B, T* Y)
+{
+  typedef simd_vec<T,BYTES> S;
+  const long NW = S::W;
+  const typename S::V a = S::set1(A);
+  const typename S::V b = S::set1(B);
+  long i=0;
+
+  for (i=0;i+2*NW<=N;i+=2*NW)
+  {
+    S::store(Y+i,S::fmadd(a,S::load(X+i),S::mul(b,S::load(Y+i))));
+    S::store(Y+i+NW,S::fmadd(a,S::load(X+i+NW),S::mul(b,S::load(Y+i+NW))));
+  }
+  for (i=i;i+NW<=N;i+=NW)
+  {
+    S::store(Y+i,S::fmadd(a,S::load(X+i),S::mul(b,S::load(Y+i))));
+  }
+
+  //cleanup
+  for (i=i;i<N;i++)
+  {
+    *(Y+i) = A * *(X+i) + B * *(Y+i);
+  }
+}
+
+template<>
+void simd_axpby<double,32>(const long N, const double A, const double* X, const double B, double* Y)
+{
+  simd_axpby_avx<double,32>(N,A,X,B,Y);
+}
+
+template<>
+void simd_axpby<double,64>(const long N, const double A, const double* X, const double B, double* Y)
+{
+  simd_axpby_avx<double,SIMD_AVX_WIDE>(N,A,X,B,Y);
+}
+
+template<>
+void simd_axpby<double,128>(const long N, const double A, const double* X, const double B, double* Y)
+{
+  simd_axpby<double,64>(N,A,X,B,Y);
+}
+
+template<>
+void simd_axpby<float,32>(const long N, const float A, const float* X, const float B, float* Y)
+{
+  simd_axpby_avx<float,32>(N,A,X,B,Y);
+}
+
+template<>
+void simd_axpby<float,64>(const long N, const float A, const float* X, const float B, float* Y)
+{
+  simd_axpby_avx<float,SIMD_AVX_WIDE>(N,A,X,B,Y);
+}
+
+template<>
+void simd_axpby<float,128>(const long N, const float A, const float* X, const float B, float* Y)
+{
+  simd_axpby<float,64>(N,A,X,B,Y);
+}
+#endif
@@ -7,9 +7,18 @@
  * If compiled with OpenMP, will use the OpenMP SIMD pragmas to 
  * provide hints to the compiler
  *
+ * Hand-coded AVX2/AVX-512 routines are used for doubles and floats
+ * claimed to be aligned to 32 or 64 BYTE boundaries
+ *
+ * With SIMD_DISPATCH (see simd_dispatch.hpp) doubles and floats go
+ * through the runtime dispatched kernels instead
+ *
  */
 
 #include "simd.hpp"
+#include "debug.hpp"
+#include "simd_avx.hpp"
+#include "simd_dispatch_kernel.hpp"
 
 /*---------------------------------------------------------------------
  * axpy without (known) alignment
@@ -18,6 +27,11 @@
 template <typename T>
 void simd_axpy(const long N, const T A, const T* X, T* Y)
 {
+  LIBJ_CHECK_INPLACE(X,N,Y,N);
+  #if defined (SIMD_DISPATCH)
+    if (simd_dispatch_axpy_hook(N,A,X,Y)) return;
+  #endif
+
   #if defined (_OPENMP)
     #pragma omp simd  
     for (long i=0;i<N;i++)
@@ -53,6 +67,13 @@ template void simd_axpy<int>(const long N, const int A, const int* X, int* Y);
 template <typename T, const int ALIGNMENT>
 void simd_axpy(const long N, const T A, const T* X, T* Y)
 {
+  LIBJ_CHECK_ALIGNED(X,ALIGNMENT);
+  LIBJ_CHECK_ALIGNED(Y,ALIGNMENT);
+  LIBJ_CHECK_INPLACE(X,N,Y,N);
+  #if defined (SIMD_DISPATCH)
+    if (simd_dispatch_axpy_hook(N,A,X,Y)) return;
+  #endif
+
   #if defined (_OPENMP)
     #pragma omp simd  aligned(X,Y:ALIGNMENT) 
     for (long i=0;i<N;i++)
@@ -76,15 +97,19 @@ void simd_axpy(const long N, const T A, const T* X, T* Y)
   #endif
 }
 
+#if !defined (__AVX2__) //special instructions below
 template void simd_axpy<double,128>(const long N, const double A, const double* X, double* Y);
 template void simd_axpy<double,64>(const long N, const double A, const double* X, double* Y);
 template void simd_axpy<double,32>(const long N, const double A, const double* X, double* Y);
+#endif
 template void simd_axpy<double,16>(const long N, const double A, const double* X, double* Y);
 template void simd_axpy<double,8>(const long N, const double A, const double* X, double* Y);
 
+#if !defined (__AVX2__) //special instructions below
 template void simd_axpy<float,128>(const long N, const float A, const float* X, float* Y);
 template void simd_axpy<float,64>(const long N, const float A, const float* X, float* Y);
 template void simd_axpy<float,32>(const long N, const float A, const float* X, float* Y);
+#endif
 template void simd_axpy<float,16>(const long N, const float A, const float* X, float* Y);
 template void simd_axpy<float,8>(const long N, const float A, const float* X, float* Y);
 template void simd_axpy<float,4>(const long N, const float A, const float* X, float* Y);
@@ -101,3 +126,74 @@ template void simd_axpy<int,32>(const long N, const int A, const int* X, int* Y)
 template void simd_axpy<int,16>(const long N, const int A, const int* X, int* Y);
 template void simd_axpy<int,8>(const long N, const int A, const int* X, int* Y);
 template void simd_axpy<int,4>(const long N, const int A, const int* X, int* Y);
+
+//------------------------------------------------------------------------------
+//  Hand-coded routines for doubles and floats claimed to be aligned to
+//  32 or 64 BYTE boundaries. 64 BYTE claims use AVX-512 if available,
+//  128 BYTE claims use the 64 BYTE code
+#if defined (__AVX2__)
+template <typename T, const int BYTES>
+static inline void simd_axpy_avx(const long N, const T A, const T* X, T* Y)
+{
+  #if defined (SIMD_DISPATCH)
+    if (simd_dispatch_axpy_hook(N,A,X,Y)) return;
+  #endif
+
+  typedef simd_vec<T,BYTES> S;
+  const long NW = S::W;
+  const typename S::V a = S::set1(A);
+  long i=0;
+
+  for (i=0;i+2*NW<=N;i+=2*NW)
+  {
+    S::store(Y+i,S::fmadd(a,S::load(X+i),S::load(Y+i)));
+    S::store(Y+i+NW,S::fmadd(a,S::load(X+i+NW),S::load(Y+i+NW)));
+  }
+  for (i=i;i+NW<=N;i+=NW)
+  {
+    S::store(Y+i,S::fmadd(a,S::load(X+i),S::load(Y+i)));
+  }
+
+  //cleanup
+  for (i=i;i<N;i++)
+  {
+    *(Y+i) += A * *(X+i);
+  }
+}
+
+template<>
+void simd_axpy<double,32>(const long N, const double A, const double* X, double* Y)
+{
+  simd_axpy_avx<double,32>(N,A,X,Y);
+}
+
+template<>
+void simd_axpy<double,64>(const long N, const double A, const double* X, double* Y)
+{
+  simd_axpy_avx<double,SIMD_AVX_WIDE>(N,A,X,Y);
+}
+
+template<>
+void simd_axpy<double,128>(const long N, const double A, const double* X, double* Y)
+{
+  simd_axpy<double,64>(N,A,X,Y);
+}
+
+template<>
+void simd_axpy<float,32>(const long N, const float A, const float* X, float* Y)
+{
+  simd_axpy_avx<float,32>(N,A,X,Y);
+}
+
+template<>
+void simd_axpy<float,64>(const long N, const float A, const float* X, float* Y)
+{
+  simd_axpy_avx<float,SIMD_AVX_WIDE>(N,A,X,Y);
+}
+
+template<>
+void simd_axpy<float,128>(const long N, const float A, const float* X, float* Y)
+{
+  simd_axpy<float,64>(N,A,X,Y);
+}
+#endif
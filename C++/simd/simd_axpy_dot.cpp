@@ -0,0 +1,141 @@
+/* simd_axpy_dot.cpp
+ * JHT, October 14, 2026 : created
+ *
+ * .cpp file that implements the fused simd axpy and dot operation
+ *   Y = Y + A*X, returns Y.Z
+ * which reads X,Y, and Z only once, rather than streaming Y from 
+ * memory a second time for the dot
+ *
+ * If compiled with OpenMP, will use the OpenMP SIMD pragmas to 
+ * provide hints to the compiler
+ *
+ */
+
+#include "simd.hpp"
+#include "debug.hpp"
+
+/*---------------------------------------------------------------------
+ * axpy_dot without (known) alignment
+ *   - if OpenMP is defined, use the pragmas to request vectorization
+ *   - otherwise, use loop unrolling
+ *---------------------------------------------------------------------*/
+template <typename T>
+T simd_axpy_dot(const long N, const T A, const T* X, T* Y, const T* Z)
+{
+  LIBJ_CHECK_INPLACE(X,N,Y,N);
+  LIBJ_CHECK_INPLACE(Z,N,Y,N);
+  T dot = 0;
+  #if defined (_OPENMP)
+    #pragma omp simd reduction(+:dot)
+    for (long i=0;i<N;i++)
+    {
+      *(Y+i) += A * *(X+i);
+      dot    += *(Y+i) * *(Z+i);
+    }
+  #else
+    T dot0 = 0;
+    T dot1 = 0;
+    T dot2 = 0;
+    T dot3 = 0;
+    long i=0;
+    for (i=0;i<(N-4);i+=4)
+    {
+      *(Y+i+0) += A * *(X+i+0);
+      *(Y+i+1) += A * *(X+i+1);
+      *(Y+i+2) += A * *(X+i+2);
+      *(Y+i+3) += A * *(X+i+3);
+      dot0 += *(Y+i+0) * *(Z+i+0);
+      dot1 += *(Y+i+1) * *(Z+i+1);
+      dot2 += *(Y+i+2) * *(Z+i+2);
+      dot3 += *(Y+i+3) * *(Z+i+3);
+    }
+    
+    for (i=i;i<N;i++)
+    {
+      *(Y+i) += A * *(X+i);
+      dot0   += *(Y+i) * *(Z+i);
+    }
+    dot = (dot0 + dot1) + (dot2 + dot3);
+  #endif
+  return dot;
+}
+template double simd_axpy_dot<double>(const long N, const double A, const double* X, double* Y, const double* Z);
+template float simd_axpy_dot<float>(const long N, const float A, const float* X, float* Y, const float* Z);
+template long simd_axpy_dot<long>(const long N, const long A, const long* X, long* Y, const long* Z);
+template int simd_axpy_dot<int>(const long N, const int A, const int* X, int* Y, const int* Z);
+
+
+/*---------------------------------------------------------------------
+ * axpy_dot with known alignment
+ *   - if OpenMP is defined, use the pragmas to request vectorization
+ *   - otherwise, use loop unrolling
+ *---------------------------------------------------------------------*/
+template <typename T, const int ALIGNMENT>
+T simd_axpy_dot(const long N, const T A, const T* X, T* Y, const T* Z)
+{
+  LIBJ_CHECK_ALIGNED(X,ALIGNMENT);
+  LIBJ_CHECK_ALIGNED(Z,ALIGNMENT);
+  LIBJ_CHECK_ALIGNED(Y,ALIGNMENT);
+  LIBJ_CHECK_INPLACE(X,N,Y,N);
+  LIBJ_CHECK_INPLACE(Z,N,Y,N);
+  T dot = 0;
+  #if defined (_OPENMP)
+    #pragma omp simd aligned(X,Y,Z:ALIGNMENT) reduction(+:dot)
+    for (long i=0;i<N;i++)
+    {
+      *(Y+i) += A * *(X+i);
+      dot    += *(Y+i) * *(Z+i);
+    }
+  #else
+    T dot0 = 0;
+    T dot1 = 0;
+    T dot2 = 0;
+    T dot3 = 0;
+    long i=0;
+    for (i=0;i<(N-4);i+=4)
+    {
+      *(Y+i+0) += A * *(X+i+0);
+      *(Y+i+1) += A * *(X+i+1);
+      *(Y+i+2) += A * *(X+i+2);
+      *(Y+i+3) += A * *(X+i+3);
+      dot0 += *(Y+i+0) * *(Z+i+0);
+      dot1 += *(Y+i+1) * *(Z+i+1);
+      dot2 += *(Y+i+2) * *(Z+i+2);
+      dot3 += *(Y+i+3) * *(Z+i+3);
+    }
+    
+    for (i=i;i<N;i++)
+    {
+      *(Y+i) += A * *(X+i);
+      dot0   += *(Y+i) * *(Z+i);
+    }
+    dot = (dot0 + dot1) + (dot2 + dot3);
+  #endif
+  return dot;
+}
+
+template double simd_axpy_dot<double,128>(const long N, const double A, const double* X, double* Y, const double* Z);
+template double simd_axpy_dot<double,64>(const long N, const double A, const double* X, double* Y, const double* Z);
+template double simd_axpy_dot<double,32>(const long N, const double A, const double* X, double* Y, const double* Z);
+template double simd_axpy_dot<double,16>(const long N, const double A, const double* X, double* Y, const double* Z);
+template double simd_axpy_dot<double,8>(const long N, const double A, const double* X, double* Y, const double* Z);
+
+template float simd_axpy_dot<float,128>(const long N, const float A, const float* X, float* Y, const float* Z);
+template float simd_axpy_dot<float,64>(const long N, const float A, const float* X, float* Y, const float* Z);
+template float simd_axpy_dot<float,32>(const long N, const float A, const float* X, float* Y, const float* Z);
+template float simd_axpy_dot<float,16>(const long N, const float A, const float* X, float* Y, const float* Z);
+template float simd_axpy_dot<float,8>(const long N, const float A, const float* X, float* Y, const float* Z);
+template float simd_axpy_dot<float,4>(const long N, const float A, const float* X, float* Y, const float* Z);
+
+template long simd_axpy_dot<long,128>(const long N, const long A, const long* X, long* Y, const long* Z);
+template long simd_axpy_dot<long,64>(const long N, const long A, const long* X, long* Y, const long* Z);
+template long simd_axpy_dot<long,32>(const long N, const long A, const long* X, long* Y, const long* Z);
+template long simd_axpy_dot<long,16>(const long N, const long A, const long* X, long* Y, const long* Z);
+template long simd_axpy_dot<long,8>(const long N, const long A, const long* X, long* Y, const long* Z);
+
+template int simd_axpy_dot<int,128>(const long N, const int A, const int* X, int* Y, const int* Z);
+template int simd_axpy_dot<int,64>(const long N, const int A, const int* X, int* Y, const int* Z);
+template int simd_axpy_dot<int,32>(const long N, const int A, const int* X, int* Y, const int* Z);
+template int simd_axpy_dot<int,16>(const long N, const int A, const int* X, int* Y, const int* Z);
+template int simd_axpy_dot<int,8>(const long N, const int A, const int* X, int* Y, const int* Z);
+template int simd_axpy_dot<int,4>(const long N, const int A, const int* X, int* Y, const int* Z);
@@ -0,0 +1,303 @@
+/* simd_checksum.cpp
+ * JHT, October 14, 2026 : created
+ *
+ * .cpp file that implements the block checksums, simd_crc32c and
+ * simd_hash64 (see simd.hpp)
+ *
+ * CRC32C is the Castagnoli CRC (polynomial 0x1EDC6F41, reflected
+ * 0x82F63B78), as in iSCSI, ext4, and Btrfs. With SSE4.2 it is the crc32
+ * instruction, 8 bytes at a time, on three independent streams of
+ * SIMD_CRC_LANE bytes, since the instruction has a latency of three
+ * cycles and a throughput of one. The three are joined by multiplying
+ * the first two by x^(8*LANE) mod P, the shift of a CRC over LANE bytes
+ * of zeros. Without SSE4.2 it is slicing-by-8 with eight 256 entry tables.
+ *
+ * The CRC is linear, so the CRC of A followed by B is the CRC of A
+ * shifted over the length of B, plus that of B (simd_crc32c_combine,
+ * as zlib's crc32_combine). simd_par_crc32c hands out blocks of
+ * SIMD_CRC_BLOCK bytes to the threads, and joins them in order.
+ *
+ * simd_hash64 is XXH64 (Collet, xxHash), four lanes of multiply-rotate
+ * over 32 byte stripes, and then the avalanche.
+ *
+ */
+
+#include "simd.hpp"
+#include <string.h>
+#include <vector>
+#include <algorithm>
+
+#if defined (__SSE4_2__)
+  #include <nmmintrin.h>
+#endif
+
+#define SIMD_CRC_POLY 0x82F63B78u
+#define SIMD_CRC_LANE 8192
+#define SIMD_CRC_BLOCK 1048576
+
+/*---------------------------------------------------------------------
+ * a*b mod P, for the reflected polynomials (x^0 in bit 31)
+ *---------------------------------------------------------------------*/
+static uint32_t simd_crc_multmodp(uint32_t a, uint32_t b)
+{
+  uint32_t m = 1u << 31;
+  uint32_t p = 0;
+  for (;;)
+  {
+    if (a & m)
+    {
+      p ^= b;
+      if ((a & (m - 1)) == 0) break;
+    }
+    m >>= 1;
+    b = (b & 1) ? (b >> 1) ^ SIMD_CRC_POLY : b >> 1;
+  }
+  return p;
+}
+
+//x^(2^k) mod P
+struct simd_crc_x2n
+{
+  uint32_t m_p[64];
+  simd_crc_x2n()
+  {
+    uint32_t p = 1u << 30;                //x^1
+    m_p[0] = p;
+    for (int k=1;k<64;k++) m_p[k] = p = simd_crc_multmodp(p,p);
+  }
+};
+
+//x^(8*BYTES) mod P
+static uint32_t simd_crc_shift(const long BYTES)
+{
+  static const simd_crc_x2n x2n;
+  uint32_t p = 1u << 31;                  //x^0
+  unsigned long n = (unsigned long) BYTES;
+  int k = 3;
+  while (n)
+  {
+    if (n & 1) p = simd_crc_multmodp(x2n.m_p[k & 63],p);
+    n >>= 1;
+    k++;
+  }
+  return p;
+}
+
+/*---------------------------------------------------------------------
+ * the CRC register of N bytes from C (no pre or post inversion)
+ *---------------------------------------------------------------------*/
+#if defined (__SSE4_2__)
+static uint32_t simd_crc_raw(uint32_t C, const unsigned char* X, long N)
+{
+  //one stream up to 8 byte alignment
+  while (N > 0 && ((uintptr_t) X & 7) != 0) {C = _mm_crc32_u8(C,*X); X++; N--;}
+
+  //three streams of LANE bytes
+  if (N >= 3*SIMD_CRC_LANE)
+  {
+    static const uint32_t k1 = simd_crc_shift(SIMD_CRC_LANE);
+    static const uint32_t k2 = simd_crc_shift(2*SIMD_CRC_LANE);
+    while (N >= 3*SIMD_CRC_LANE)
+    {
+      uint64_t a = C, b = 0, c = 0;
+      const unsigned char* x0 = X;
+      const unsigned char* x1 = X + SIMD_CRC_LANE;
+      const unsigned char* x2 = X + 2*SIMD_CRC_LANE;
+      for (long i=0;i<SIMD_CRC_LANE;i+=8)
+      {
+        uint64_t w0,w1,w2;
+        memcpy(&w0,x0+i,8);
+        memcpy(&w1,x1+i,8);
+        memcpy(&w2,x2+i,8);
+        a = _mm_crc32_u64(a,w0);
+        b = _mm_crc32_u64(b,w1);
+        c = _mm_crc32_u64(c,w2);
+      }
+      C = simd_crc_multmodp(k2,(uint32_t) a) ^ simd_crc_multmodp(k1,(uint32_t) b) ^ (uint32_t) c;
+      X += 3*SIMD_CRC_LANE;
+      N -= 3*SIMD_CRC_LANE;
+    }
+  }
+
+  //one stream for the rest
+  uint64_t c64 = C;
+  for (;N>=8;N-=8,X+=8)
+  {
+    uint64_t w;
+    memcpy(&w,X,8);
+    c64 = _mm_crc32_u64(c64,w);
+  }
+  C = (uint32_t) c64;
+  for (;N>0;N--,X++) C = _mm_crc32_u8(C,*X);
+  return C;
+}
+#else
+//the slicing-by-8 tables, m_t[k][b] is the CRC of b followed by k zero bytes
+struct simd_crc_tables
+{
+  uint32_t m_t[8][256];
+  simd_crc_tables()
+  {
+    for (int b=0;b<256;b++)
+    {
+      uint32_t c = (uint32_t) b;
+      for (int j=0;j<8;j++) c = (c & 1) ? (c >> 1) ^ SIMD_CRC_POLY : c >> 1;
+      m_t[0][b] = c;
+    }
+    for (int b=0;b<256;b++)
+    {
+      for (int k=1;k<8;k++) m_t[k][b] = (m_t[k-1][b] >> 8) ^ m_t[0][m_t[k-1][b] & 0xFF];
+    }
+  }
+};
+
+static uint32_t simd_crc_raw(uint32_t C, const unsigned char* X, long N)
+{
+  static const simd_crc_tables tab;
+  const uint32_t* T = &tab.m_t[0][0];
+  for (;N>=8;N-=8,X+=8)
+  {
+    uint32_t lo,hi;
+    memcpy(&lo,X,4);
+    memcpy(&hi,X+4,4);
+    lo ^= C;
+    C = T[7*256 + (lo & 0xFF)] ^ T[6*256 + ((lo >> 8) & 0xFF)] ^
+        T[5*256 + ((lo >> 16) & 0xFF)] ^ T[4*256 + (lo >> 24)] ^
+        T[3*256 + (hi & 0xFF)] ^ T[2*256 + ((hi >> 8) & 0xFF)] ^
+        T[1*256 + ((hi >> 16) & 0xFF)] ^ T[0*256 + (hi >> 24)];
+  }
+  for (;N>0;N--,X++) C = (C >> 8) ^ T[(C ^ *X) & 0xFF];
+  return C;
+}
+#endif
+
+/*---------------------------------------------------------------------
+ * CRC32C
+ *---------------------------------------------------------------------*/
+uint32_t simd_crc32c(const long BYTES, const void* X, const uint32_t CRC)
+{
+  if (BYTES <= 0) return CRC;
+  return ~simd_crc_raw(~CRC,(const unsigned char*) X,BYTES);
+}
+
+uint32_t simd_crc32c_combine(const uint32_t CRC1, const uint32_t CRC2, const long BYTES2)
+{
+  if (BYTES2 <= 0) return CRC1;
+  return simd_crc_multmodp(simd_crc_shift(BYTES2),CRC1) ^ CRC2;
+}
+
+uint32_t simd_par_crc32c(const long BYTES, const void* X, const uint32_t CRC)
+{
+  #if defined (_OPENMP)
+  if (omp_get_max_threads() > 1 && !omp_in_parallel() && BYTES >= 2*SIMD_CRC_BLOCK
+      && BYTES >= (long) sizeof(double)*libj::simd_par_min_n())
+  {
+    const unsigned char* x = (const unsigned char*) X;
+    const long nblk = (BYTES + SIMD_CRC_BLOCK - 1)/SIMD_CRC_BLOCK;
+    std::vector<uint32_t> crc(nblk);
+    #pragma omp parallel for schedule(static)
+    for (long b=0;b<nblk;b++)
+    {
+      const long start = b*SIMD_CRC_BLOCK;
+      const long len   = std::min((long) SIMD_CRC_BLOCK,BYTES-start);
+      crc[b] = simd_crc32c(len,x+start,0);
+    }
+    //all but the last block are SIMD_CRC_BLOCK bytes, so one shift
+    const uint32_t k = simd_crc_shift(SIMD_CRC_BLOCK);
+    uint32_t c = CRC;
+    for (long b=0;b<nblk-1;b++) c = simd_crc_multmodp(k,c) ^ crc[b];
+    return simd_crc32c_combine(c,crc[nblk-1],BYTES-(nblk-1)*SIMD_CRC_BLOCK);
+  }
+  #endif
+  return simd_crc32c(BYTES,X,CRC);
+}
+
+/*---------------------------------------------------------------------
+ * XXH64
+ *---------------------------------------------------------------------*/
+static const uint64_t SIMD_XXH_P1 = 11400714785074694791ULL;
+static const uint64_t SIMD_XXH_P2 = 14029467366897019727ULL;
+static const uint64_t SIMD_XXH_P3 =  1609587929392839161ULL;
+static const uint64_t SIMD_XXH_P4 =  9650029242287828579ULL;
+static const uint64_t SIMD_XXH_P5 =  2870177450012600261ULL;
+
+static inline uint64_t simd_xxh_rotl(const uint64_t x, const int r)
+{
+  return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t simd_xxh_round(uint64_t acc, const uint64_t w)
+{
+  acc += w*SIMD_XXH_P2;
+  acc  = simd_xxh_rotl(acc,31);
+  return acc*SIMD_XXH_P1;
+}
+
+static inline uint64_t simd_xxh_merge(uint64_t h, const uint64_t v)
+{
+  h ^= simd_xxh_round(0,v);
+  return h*SIMD_XXH_P1 + SIMD_XXH_P4;
+}
+
+uint64_t simd_hash64(const long BYTES, const void* X, const uint64_t SEED)
+{
+  const unsigned char* x = (const unsigned char*) X;
+  const long N = (BYTES > 0) ? BYTES : 0;
+  long n = N;
+  uint64_t h;
+  if (n >= 32)
+  {
+    uint64_t v1 = SEED + SIMD_XXH_P1 + SIMD_XXH_P2;
+    uint64_t v2 = SEED + SIMD_XXH_P2;
+    uint64_t v3 = SEED;
+    uint64_t v4 = SEED - SIMD_XXH_P1;
+    for (;n>=32;n-=32,x+=32)
+    {
+      uint64_t w[4];
+      memcpy(w,x,32);
+      v1 = simd_xxh_round(v1,w[0]);
+      v2 = simd_xxh_round(v2,w[1]);
+      v3 = simd_xxh_round(v3,w[2]);
+      v4 = simd_xxh_round(v4,w[3]);
+    }
+    h = simd_xxh_rotl(v1,1) + simd_xxh_rotl(v2,7) + simd_xxh_rotl(v3,12) + simd_xxh_rotl(v4,18);
+    h = simd_xxh_merge(h,v1);
+    h = simd_xxh_merge(h,v2);
+    h = simd_xxh_merge(h,v3);
+    h = simd_xxh_merge(h,v4);
+  }
+  else
+  {
+    h = SEED + SIMD_XXH_P5;
+  }
+  h += (uint64_t) N;
+
+  for (;n>=8;n-=8,x+=8)
+  {
+    uint64_t w;
+    memcpy(&w,x,8);
+    h ^= simd_xxh_round(0,w);
+    h  = simd_xxh_rotl(h,27)*SIMD_XXH_P1 + SIMD_XXH_P4;
+  }
+  if (n >= 4)
+  {
+    uint32_t w;
+    memcpy(&w,x,4);
+    h ^= (uint64_t) w*SIMD_XXH_P1;
+    h  = simd_xxh_rotl(h,23)*SIMD_XXH_P2 + SIMD_XXH_P3;
+    n -= 4;
+    x += 4;
+  }
+  for (;n>0;n--,x++)
+  {
+    h ^= (uint64_t) (*x)*SIMD_XXH_P5;
+    h  = simd_xxh_rotl(h,11)*SIMD_XXH_P1;
+  }
+
+  h ^= h >> 33;
+  h *= SIMD_XXH_P2;
+  h ^= h >> 29;
+  h *= SIMD_XXH_P3;
+  h ^= h >> 32;
+  return h;
+}
@@ -0,0 +1,294 @@
+/* simd_complex.cpp
+ * JHT, October 14, 2026 : created
+ *
+ * .cpp file that implements the simd routines for interleaved
+ * complex data, std::complex<double> and std::complex<float>,
+ * stored as (re,im,re,im,...)
+ *
+ * If compiled with AVX2, the complex products are done a whole
+ * register at a time. For Z = A*X
+ *
+ *   t  = Im(A) * (im0,re0,im1,re1,...)  (pairs swapped)
+ *   Z  = Re(A) * (re0,im0,re1,im1,...) -/+ t   (fmaddsub)
+ *
+ * so even lanes get re*re - im*im and odd lanes re*im + im*re.
+ * Dot products keep two accumulators, X*Y and X*swap(Y), and
+ * combine the lanes at the end.
+ *
+ * Only the unaligned routines are provided
+ *
+ */
+
+#include "simd.hpp"
+
+#if defined (__AVX2__)
+/*---------------------------------------------------------------------
+ * register helpers, W is the number of complex elements per register
+ *---------------------------------------------------------------------*/
+template <typename T>
+struct simd_cvec;
+
+template <>
+struct simd_cvec<double>
+{
+  typedef __m256d V;
+  static const long W = 2;
+  static inline V loadu(const std::complex<double>* p) {return _mm256_loadu_pd((const double*) p);}
+  static inline void storeu(std::complex<double>* p, const V a) {_mm256_storeu_pd((double*) p,a);}
+  static inline V set1(const double a) {return _mm256_set1_pd(a);}
+  static inline V zero() {return _mm256_setzero_pd();}
+  static inline V swap(const V a) {return _mm256_permute_pd(a,0x5);}
+  static inline V add(const V a, const V b) {return _mm256_add_pd(a,b);}
+  static inline V fmadd(const V a, const V b, const V c)
+  {
+    #if defined (__FMA__)
+      return _mm256_fmadd_pd(a,b,c);
+    #else
+      return _mm256_add_pd(_mm256_mul_pd(a,b),c);
+    #endif
+  }
+  //a*b -/+ c in the even/odd lanes
+  static inline V fmaddsub(const V a, const V b, const V c)
+  {
+    #if defined (__FMA__)
+      return _mm256_fmaddsub_pd(a,b,c);
+    #else
+      return _mm256_addsub_pd(_mm256_mul_pd(a,b),c);
+    #endif
+  }
+  static inline V mul(const V a, const V b) {return _mm256_mul_pd(a,b);}
+  //sums of the even and odd lanes
+  static inline void hsum(const V a, double& even, double& odd)
+  {
+    double p[4];
+    _mm256_storeu_pd(p,a);
+    even = p[0] + p[2];
+    odd  = p[1] + p[3];
+  }
+};
+
+template <>
+struct simd_cvec<float>
+{
+  typedef __m256 V;
+  static const long W = 4;
+  static inline V loadu(const std::complex<float>* p) {return _mm256_loadu_ps((const float*) p);}
+  static inline void storeu(std::complex<float>* p, const V a) {_mm256_storeu_ps((float*) p,a);}
+  static inline V set1(const float a) {return _mm256_set1_ps(a);}
+  static inline V zero() {return _mm256_setzero_ps();}
+  static inline V swap(const V a) {return _mm256_permute_ps(a,0xB1);}
+  static inline V add(const V a, const V b) {return _mm256_add_ps(a,b);}
+  static inline V fmadd(const V a, const V b, const V c)
+  {
+    #if defined (__FMA__)
+      return _mm256_fmadd_ps(a,b,c);
+    #else
+      return _mm256_add_ps(_mm256_mul_ps(a,b),c);
+    #endif
+  }
+  static inline V fmaddsub(const V a, const V b, const V c)
+  {
+    #if defined (__FMA__)
+      return _mm256_fmaddsub_ps(a,b,c);
+    #else
+      return _mm256_addsub_ps(_mm256_mul_ps(a,b),c);
+    #endif
+  }
+  static inline V mul(const V a, const V b) {return _mm256_mul_ps(a,b);}
+  static inline void hsum(const V a, float& even, float& odd)
+  {
+    float p[8];
+    _mm256_storeu_ps(p,a);
+    even = (p[0] + p[2]) + (p[4] + p[6]);
+    odd  = (p[1] + p[3]) + (p[5] + p[7]);
+  }
+};
+#endif
+
+/*---------------------------------------------------------------------
+ * dot and dotc kernel
+ *   returns sum X*Y, or sum conj(X)*Y if CONJ
+ *---------------------------------------------------------------------*/
+template <typename T, const bool CONJ>
+static inline std::complex<T> simd_complex_dot(const long N, const std::complex<T>* X,
+                                               const std::complex<T>* Y)
+{
+  T rr = 0; //sum of re(x)*re(y)
+  T ii = 0; //sum of im(x)*im(y)
+  T ri = 0; //sum of re(x)*im(y)
+  T ir = 0; //sum of im(x)*re(y)
+  long i=0;
+
+  #if defined (__AVX2__)
+    typedef simd_cvec<T> S;
+    typename S::V a0 = S::zero(); //X*Y
+    typename S::V a1 = S::zero(); //X*swap(Y)
+    for (i=0;i+S::W<=N;i+=S::W)
+    {
+      const typename S::V x = S::loadu(X+i);
+      const typename S::V y = S::loadu(Y+i);
+      a0 = S::fmadd(x,y,a0);
+      a1 = S::fmadd(x,S::swap(y),a1);
+    }
+    S::hsum(a0,rr,ii);
+    S::hsum(a1,ri,ir);
+  #endif
+
+  //cleanup
+  for (i=i;i<N;i++)
+  {
+    const T xr = (X+i)->real();
+    const T xi = (X+i)->imag();
+    const T yr = (Y+i)->real();
+    const T yi = (Y+i)->imag();
+    rr += xr*yr;
+    ii += xi*yi;
+    ri += xr*yi;
+    ir += xi*yr;
+  }
+
+  if (CONJ) {return std::complex<T>(rr + ii, ri - ir);}
+  else      {return std::complex<T>(rr - ii, ri + ir);}
+}
+
+/*---------------------------------------------------------------------
+ * Z = A*X (+ Y) kernel, Z may be X or Y
+ *---------------------------------------------------------------------*/
+template <typename T, const bool ADD>
+static inline void simd_complex_axpy(const long N, const std::complex<T> A,
+                                     const std::complex<T>* X, const std::complex<T>* Y,
+                                     std::complex<T>* Z)
+{
+  const T ar = A.real();
+  const T ai = A.imag();
+  long i=0;
+
+  #if defined (__AVX2__)
+    typedef simd_cvec<T> S;
+    const typename S::V vr = S::set1(ar);
+    const typename S::V vi = S::set1(ai);
+    for (i=0;i+S::W<=N;i+=S::W)
+    {
+      const typename S::V x = S::loadu(X+i);
+      typename S::V z = S::fmaddsub(vr,x,S::mul(vi,S::swap(x)));
+      if (ADD) z = S::add(z,S::loadu(Y+i));
+      S::storeu(Z+i,z);
+    }
+  #endif
+
+  //cleanup
+  for (i=i;i<N;i++)
+  {
+    const T xr = (X+i)->real();
+    const T xi = (X+i)->imag();
+    T zr = ar*xr - ai*xi;
+    T zi = ar*xi + ai*xr;
+    if (ADD) {zr += (Y+i)->real(); zi += (Y+i)->imag();}
+    *(Z+i) = std::complex<T>(zr,zi);
+  }
+}
+
+/*---------------------------------------------------------------------
+ * dot
+ *---------------------------------------------------------------------*/
+template <>
+std::complex<double> simd_dot<std::complex<double> >(const long N, const std::complex<double>* X,
+                                                     const std::complex<double>* Y)
+{
+  return simd_complex_dot<double,false>(N,X,Y);
+}
+
+template <>
+std::complex<float> simd_dot<std::complex<float> >(const long N, const std::complex<float>* X,
+                                                   const std::complex<float>* Y)
+{
+  return simd_complex_dot<float,false>(N,X,Y);
+}
+
+/*---------------------------------------------------------------------
+ * dotc
+ *---------------------------------------------------------------------*/
+template <typename T>
+T simd_dotc(const long N, const T* X, const T* Y)
+{
+  return simd_dot<T>(N,X,Y);
+}
+template double simd_dotc<double>(const long N, const double* X, const double* Y);
+template float simd_dotc<float>(const long N, const float* X, const float* Y);
+
+template <>
+std::complex<double> simd_dotc<std::complex<double> >(const long N, const std::complex<double>* X,
+                                                      const std::complex<double>* Y)
+{
+  return simd_complex_dot<double,true>(N,X,Y);
+}
+
+template <>
+std::complex<float> simd_dotc<std::complex<float> >(const long N, const std::complex<float>* X,
+                                                    const std::complex<float>* Y)
+{
+  return simd_complex_dot<float,true>(N,X,Y);
+}
+
+/*---------------------------------------------------------------------
+ * axpy
+ *---------------------------------------------------------------------*/
+template <>
+void simd_axpy<std::complex<double> >(const long N, const std::complex<double> A,
+                                      const std::complex<double>* X, std::complex<double>* Y)
+{
+  simd_complex_axpy<double,true>(N,A,X,Y,Y);
+}
+
+template <>
+void simd_axpy<std::complex<float> >(const long N, const std::complex<float> A,
+                                     const std::complex<float>* X, std::complex<float>* Y)
+{
+  simd_complex_axpy<float,true>(N,A,X,Y,Y);
+}
+
+/*---------------------------------------------------------------------
+ * scal_mul
+ *---------------------------------------------------------------------*/
+template <>
+void simd_scal_mul<std::complex<double> >(const long N, const std::complex<double> A,
+                                          std::complex<double>* X)
+{
+  simd_complex_axpy<double,false>(N,A,X,X,X);
+}
+
+template <>
+void simd_scal_mul<std::complex<float> >(const long N, const std::complex<float> A,
+                                         std::complex<float>* X)
+{
+  simd_complex_axpy<float,false>(N,A,X,X,X);
+}
+
+/*---------------------------------------------------------------------
+ * zero and copy, as twice as many reals
+ *---------------------------------------------------------------------*/
+template <>
+void simd_zero<std::complex<double> >(const long N, std::complex<double>* X)
+{
+  simd_zero<double>(2*N,(double*) X);
+}
+
+template <>
+void simd_zero<std::complex<float> >(const long N, std::complex<float>* X)
+{
+  simd_zero<float>(2*N,(float*) X);
+}
+
+template <>
+void simd_copy<std::complex<double> >(const long N, const std::complex<double>* X,
+                                      std::complex<double>* Y)
+{
+  simd_copy<double>(2*N,(const double*) X,(double*) Y);
+}
+
+template <>
+void simd_copy<std::complex<float> >(const long N, const std::complex<float>* X,
+                                     std::complex<float>* Y)
+{
+  simd_copy<float>(2*N,(const float*) X,(float*) Y);
+}
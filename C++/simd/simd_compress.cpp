@@ -0,0 +1,212 @@
+/* simd_compress.cpp
+ * JHT, October 14, 2026 : created
+ *
+ * .cpp file that implements simd stream compaction, the indices and
+ * values of all elements of an array with |X[i]| > tol, in order
+ *
+ * If compiled with AVX-512F, doubles and floats are written with
+ * the compress stores (vcompresspd/ps, vpcompressq for the indices).
+ * If compiled with AVX2, the mask of a register (cmp + movemask)
+ * picks a row of a table of lane numbers, which packs the selected
+ * lanes to the front (permutevar8x32), and only the first popcount
+ * lanes are written (maskstore). Either way nothing is written past
+ * the last selected element, so IDX and VAL only need room for the
+ * count (simd_count_above). int and long are done in the plain loop
+ *
+ */
+
+#include "simd.hpp"
+#include <cmath>
+#include <cstdlib>
+
+/*---------------------------------------------------------------------
+ * absolute value of any of the types
+ *---------------------------------------------------------------------*/
+template <typename T>
+static inline T simd_compress_abs(const T x) {return (x < (T) 0) ? -x : x;}
+
+/*---------------------------------------------------------------------
+ * plain compaction, from element I of X, with the count so far in C
+ *---------------------------------------------------------------------*/
+template <typename T>
+static inline long simd_compress_tail(const long N, const T* X, const T tol,
+                                      long* IDX, T* VAL, long i, long c)
+{
+  for (i=i;i<N;i++)
+  {
+    if (simd_compress_abs(X[i]) > tol)
+    {
+      IDX[c] = i;
+      VAL[c] = X[i];
+      c++;
+    }
+  }
+  return c;
+}
+
+/*---------------------------------------------------------------------
+ * vector compaction, over whole registers only
+ *   returns the count, and i is the number of elements done
+ *---------------------------------------------------------------------*/
+template <typename T>
+static inline long simd_compress_vec(const long N, const T* X, const T tol,
+                                     long* IDX, T* VAL, long& i)
+{
+  i = 0;
+  return 0;
+}
+
+#if defined (__AVX512F__)
+static inline long simd_compress_vec(const long N, const double* X, const double tol,
+                                     long* IDX, double* VAL, long& i)
+{
+  const __m512d t    = _mm512_set1_pd(tol);
+  const __m512i iota = _mm512_set_epi64(7,6,5,4,3,2,1,0);
+  long c = 0;
+  for (i=0;i+8<=N;i+=8)
+  {
+    const __m512d x = _mm512_loadu_pd(X+i);
+    const __mmask8 m = _mm512_cmp_pd_mask(_mm512_abs_pd(x),t,_CMP_GT_OQ);
+    if (m == 0) continue;
+    _mm512_mask_compressstoreu_pd(VAL+c,m,x);
+    _mm512_mask_compressstoreu_epi64(IDX+c,m,_mm512_add_epi64(_mm512_set1_epi64(i),iota));
+    c += __builtin_popcount(m);
+  }
+  return c;
+}
+
+static inline long simd_compress_vec(const long N, const float* X, const float tol,
+                                     long* IDX, float* VAL, long& i)
+{
+  const __m512  t    = _mm512_set1_ps(tol);
+  const __m512i iota = _mm512_set_epi64(7,6,5,4,3,2,1,0);
+  long c = 0;
+  for (i=0;i+16<=N;i+=16)
+  {
+    const __m512 x = _mm512_loadu_ps(X+i);
+    const __mmask16 m = _mm512_cmp_ps_mask(_mm512_abs_ps(x),t,_CMP_GT_OQ);
+    if (m == 0) continue;
+    _mm512_mask_compressstoreu_ps(VAL+c,m,x);
+    const __mmask8 lo = (__mmask8) (m & 0xff);
+    const __mmask8 hi = (__mmask8) (m >> 8);
+    _mm512_mask_compressstoreu_epi64(IDX+c,lo,_mm512_add_epi64(_mm512_set1_epi64(i),iota));
+    const long clo = __builtin_popcount(lo);
+    _mm512_mask_compressstoreu_epi64(IDX+c+clo,hi,_mm512_add_epi64(_mm512_set1_epi64(i+8),iota));
+    c += clo + __builtin_popcount(hi);
+  }
+  return c;
+}
+
+#elif defined (__AVX2__)
+/*---------------------------------------------------------------------
+ * lanes of each 8 bit mask, the set bits first
+ *---------------------------------------------------------------------*/
+struct simd_compress_table
+{
+  int lanes[256][8];
+  simd_compress_table()
+  {
+    for (int m=0;m<256;m++)
+    {
+      int k = 0;
+      for (int l=0;l<8;l++) {if (m & (1 << l)) lanes[m][k++] = l;}
+      for (;k<8;k++) lanes[m][k] = 0;
+    }
+  }
+  static const simd_compress_table& get()
+  {
+    static const simd_compress_table table;
+    return table;
+  }
+};
+
+static inline long simd_compress_vec(const long N, const double* X, const double tol,
+                                     long* IDX, double* VAL, long& i)
+{
+  const simd_compress_table& tab = simd_compress_table::get();
+  const __m256d sign = _mm256_set1_pd(-0.0);
+  const __m256d t    = _mm256_set1_pd(tol);
+  const __m256i iota = _mm256_set_epi64x(3,2,1,0);
+  const __m256i one  = _mm256_set1_epi64x(1);
+  long c = 0;
+  for (i=0;i+4<=N;i+=4)
+  {
+    const __m256d x = _mm256_loadu_pd(X+i);
+    const int m = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_andnot_pd(sign,x),t,_CMP_GT_OQ));
+    if (m == 0) continue;
+    const int k = __builtin_popcount(m);
+
+    //lanes as 64 bit, and as the pairs of 32 bit halves
+    const __m256i L  = _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i*) tab.lanes[m]));
+    const __m256i L2 = _mm256_add_epi64(L,L);
+    const __m256i P  = _mm256_or_si256(L2,_mm256_slli_epi64(_mm256_add_epi64(L2,one),32));
+    const __m256i W  = _mm256_cmpgt_epi64(_mm256_set1_epi64x(k),iota);
+
+    const __m256d v = _mm256_castps_pd(_mm256_permutevar8x32_ps(_mm256_castpd_ps(x),P));
+    _mm256_maskstore_pd(VAL+c,W,v);
+    _mm256_maskstore_epi64((long long*) (IDX+c),W,_mm256_add_epi64(_mm256_set1_epi64x(i),L));
+    c += k;
+  }
+  return c;
+}
+
+static inline long simd_compress_vec(const long N, const float* X, const float tol,
+                                     long* IDX, float* VAL, long& i)
+{
+  const simd_compress_table& tab = simd_compress_table::get();
+  const __m256  sign = _mm256_set1_ps(-0.0f);
+  const __m256  t    = _mm256_set1_ps(tol);
+  const __m256i iota = _mm256_set_epi32(7,6,5,4,3,2,1,0);
+  long c = 0;
+  for (i=0;i+8<=N;i+=8)
+  {
+    const __m256 x = _mm256_loadu_ps(X+i);
+    const int m = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_andnot_ps(sign,x),t,_CMP_GT_OQ));
+    if (m == 0) continue;
+    const int k = __builtin_popcount(m);
+
+    const __m256i L = _mm256_loadu_si256((const __m256i*) tab.lanes[m]);
+    const __m256i W = _mm256_cmpgt_epi32(_mm256_set1_epi32(k),iota);
+    _mm256_maskstore_ps(VAL+c,W,_mm256_permutevar8x32_ps(x,L));
+
+    //indices in two halves of 4, with the halves of the write mask
+    const __m256i base = _mm256_set1_epi64x(i);
+    const __m256i I0 = _mm256_add_epi64(base,_mm256_cvtepi32_epi64(_mm256_castsi256_si128(L)));
+    const __m256i I1 = _mm256_add_epi64(base,_mm256_cvtepi32_epi64(_mm256_extracti128_si256(L,1)));
+    _mm256_maskstore_epi64((long long*) (IDX+c),_mm256_cvtepi32_epi64(_mm256_castsi256_si128(W)),I0);
+    _mm256_maskstore_epi64((long long*) (IDX+c+4),_mm256_cvtepi32_epi64(_mm256_extracti128_si256(W,1)),I1);
+    c += k;
+  }
+  return c;
+}
+#endif
+
+/*---------------------------------------------------------------------
+ * compress
+ *---------------------------------------------------------------------*/
+template <typename T>
+long simd_compress(const long N, const T* X, const T tol, long* IDX, T* VAL)
+{
+  long i=0;
+  const long c = simd_compress_vec(N,X,tol,IDX,VAL,i);
+  return simd_compress_tail<T>(N,X,tol,IDX,VAL,i,c);
+}
+template long simd_compress<double>(const long N, const double* X, const double tol, long* IDX, double* VAL);
+template long simd_compress<float>(const long N, const float* X, const float tol, long* IDX, float* VAL);
+template long simd_compress<long>(const long N, const long* X, const long tol, long* IDX, long* VAL);
+template long simd_compress<int>(const long N, const int* X, const int tol, long* IDX, int* VAL);
+
+/*---------------------------------------------------------------------
+ * count, the same test as compress
+ *---------------------------------------------------------------------*/
+template <typename T>
+long simd_count_above(const long N, const T* X, const T tol)
+{
+  long c = 0;
+  for (long i=0;i<N;i++) c += (simd_compress_abs(X[i]) > tol) ? 1 : 0;
+  return c;
+}
+template long simd_count_above<double>(const long N, const double* X, const double tol);
+template long simd_count_above<float>(const long N, const float* X, const float tol);
+template long simd_count_above<long>(const long N, const long* X, const long tol);
+template long simd_count_above<int>(const long N, const int* X, const int tol);
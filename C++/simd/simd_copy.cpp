@@ -10,6 +10,7 @@
  */
 
 #include "simd.hpp"
+#include "debug.hpp"
 #include <cstring>
 
 /*---------------------------------------------------------------------
@@ -19,6 +20,7 @@
 template <typename T>
 void simd_copy(const long N, const T* X, T* Y)
 {
+  LIBJ_CHECK_NOALIAS(X,N,Y,N);
   //After some testing, I've found that memcpy is just faster...
   std::memcpy(Y,X,N*sizeof(T));
 
@@ -59,6 +61,9 @@ template void simd_copy<int>(const long N, const int* X, int* Y);
 template <typename T, const int ALIGNMENT>
 void simd_copy(const long N, const T* X, T* Y)
 {
+  LIBJ_CHECK_ALIGNED(X,ALIGNMENT);
+  LIBJ_CHECK_ALIGNED(Y,ALIGNMENT);
+  LIBJ_CHECK_NOALIAS(X,N,Y,N);
   //After some testing, I've found that memcpy is just faster...
   std::memcpy(Y,X,N*sizeof(T));
 
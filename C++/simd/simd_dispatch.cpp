@@ -0,0 +1,255 @@
+/* simd_dispatch.cpp
+ * JHT, October 14, 2026 : created
+ *
+ * .cpp file that implements the runtime dispatch of the simd
+ * routines. The cpu is checked once, and a table of function
+ * pointers for each type is filled with the widest kernels
+ * the cpu (and OS) supports.
+ *
+ * The checks use the compiler's cpuid builtins, which also
+ * verify that the OS saves the YMM/ZMM state
+ *
+ * The generic tier is plain loops here, not the simd_* routines,
+ * since with SIMD_DISPATCH those call back into these tables
+ *
+ */
+#include "simd_dispatch.hpp"
+#include "simd_dispatch_kernel.hpp"
+#include <cstring>
+
+/*---------------------------------------------------------------------
+ * table of function pointers for one type
+ *---------------------------------------------------------------------*/
+template <typename T>
+struct simd_dispatch_table
+{
+  T    (*dot)(const long, const T*, const T*);
+  void (*axpy)(const long, const T, const T*, T*);
+  void (*zero)(const long, T*);
+  void (*scal_mul)(const long, const T, T*);
+  T    (*reduction_add)(const long, const T*);
+};
+
+static int simd_dispatch_level = -1;
+static simd_dispatch_table<double> simd_dispatch_double;
+static simd_dispatch_table<float>  simd_dispatch_float;
+
+template <typename T>
+static simd_dispatch_table<T>& simd_dispatch_get();
+
+template <>
+simd_dispatch_table<double>& simd_dispatch_get<double>() {return simd_dispatch_double;}
+
+template <>
+simd_dispatch_table<float>& simd_dispatch_get<float>() {return simd_dispatch_float;}
+
+/*---------------------------------------------------------------------
+ * generic kernels, independent accumulators so the adds do not wait
+ * on each other
+ *---------------------------------------------------------------------*/
+template <typename T>
+static T simd_dispatch_dot_generic(const long N, const T* X, const T* Y)
+{
+  T dot0 = 0;
+  T dot1 = 0;
+  T dot2 = 0;
+  T dot3 = 0;
+  long i=0;
+  for (i=0;i+4<=N;i+=4)
+  {
+    dot0 += *(X+i+0) * *(Y+i+0);
+    dot1 += *(X+i+1) * *(Y+i+1);
+    dot2 += *(X+i+2) * *(Y+i+2);
+    dot3 += *(X+i+3) * *(Y+i+3);
+  }
+  for (i=i;i<N;i++)
+  {
+    dot0 += *(X+i) * *(Y+i);
+  }
+  return (dot0 + dot1) + (dot2 + dot3);
+}
+
+template <typename T>
+static void simd_dispatch_axpy_generic(const long N, const T A, const T* X, T* Y)
+{
+  for (long i=0;i<N;i++)
+  {
+    *(Y+i) += A * *(X+i);
+  }
+}
+
+template <typename T>
+static void simd_dispatch_zero_generic(const long N, T* X)
+{
+  std::memset(X,0,N*sizeof(T));
+}
+
+template <typename T>
+static void simd_dispatch_scal_mul_generic(const long N, const T A, T* X)
+{
+  for (long i=0;i<N;i++)
+  {
+    *(X+i) *= A;
+  }
+}
+
+template <typename T>
+static T simd_dispatch_reduction_add_generic(const long N, const T* X)
+{
+  T sum0 = 0;
+  T sum1 = 0;
+  T sum2 = 0;
+  T sum3 = 0;
+  long i=0;
+  for (i=0;i+4<=N;i+=4)
+  {
+    sum0 += *(X+i+0);
+    sum1 += *(X+i+1);
+    sum2 += *(X+i+2);
+    sum3 += *(X+i+3);
+  }
+  for (i=i;i<N;i++)
+  {
+    sum0 += *(X+i);
+  }
+  return (sum0 + sum1) + (sum2 + sum3);
+}
+
+/*---------------------------------------------------------------------
+ * check the cpu for the widest supported instruction set
+ *---------------------------------------------------------------------*/
+static int simd_dispatch_detect()
+{
+  #if defined (__GNUC__) && (defined (__x86_64__) || defined (__i386__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SIMD_ISA_AVX512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return SIMD_ISA_AVX2;
+    if (__builtin_cpu_supports("sse2")) return SIMD_ISA_SSE2;
+  #endif
+  return SIMD_ISA_GENERIC;
+}
+
+/*---------------------------------------------------------------------
+ * fill the table for one type
+ *---------------------------------------------------------------------*/
+template <typename T>
+static void simd_dispatch_fill(const int ISA)
+{
+  simd_dispatch_table<T>& tab = simd_dispatch_get<T>();
+  if (ISA == SIMD_ISA_AVX512)
+  {
+    tab.dot           = simd_dispatch_dot_kernel<T,64>;
+    tab.axpy          = simd_dispatch_axpy_kernel<T,64>;
+    tab.zero          = simd_dispatch_zero_kernel<T,64>;
+    tab.scal_mul      = simd_dispatch_scal_mul_kernel<T,64>;
+    tab.reduction_add = simd_dispatch_reduction_add_kernel<T,64>;
+  } else if (ISA == SIMD_ISA_AVX2) {
+    tab.dot           = simd_dispatch_dot_kernel<T,32>;
+    tab.axpy          = simd_dispatch_axpy_kernel<T,32>;
+    tab.zero          = simd_dispatch_zero_kernel<T,32>;
+    tab.scal_mul      = simd_dispatch_scal_mul_kernel<T,32>;
+    tab.reduction_add = simd_dispatch_reduction_add_kernel<T,32>;
+  } else if (ISA == SIMD_ISA_SSE2) {
+    tab.dot           = simd_dispatch_dot_kernel<T,16>;
+    tab.axpy          = simd_dispatch_axpy_kernel<T,16>;
+    tab.zero          = simd_dispatch_zero_kernel<T,16>;
+    tab.scal_mul      = simd_dispatch_scal_mul_kernel<T,16>;
+    tab.reduction_add = simd_dispatch_reduction_add_kernel<T,16>;
+  } else {
+    tab.dot           = simd_dispatch_dot_generic<T>;
+    tab.axpy          = simd_dispatch_axpy_generic<T>;
+    tab.zero          = simd_dispatch_zero_generic<T>;
+    tab.scal_mul      = simd_dispatch_scal_mul_generic<T>;
+    tab.reduction_add = simd_dispatch_reduction_add_generic<T>;
+  }
+}
+
+/*---------------------------------------------------------------------
+ * init
+ *---------------------------------------------------------------------*/
+int simd_dispatch_init(const int ISA)
+{
+  const int best = simd_dispatch_detect();
+  int isa = (ISA < 0 || ISA > best) ? best : ISA;
+  simd_dispatch_fill<double>(isa);
+  simd_dispatch_fill<float>(isa);
+  simd_dispatch_level = isa;
+  return isa;
+}
+
+int simd_dispatch_isa()
+{
+  if (simd_dispatch_level < 0) simd_dispatch_init();
+  return simd_dispatch_level;
+}
+
+const char* simd_dispatch_isa_name(const int ISA)
+{
+  switch (ISA)
+  {
+    case SIMD_ISA_AVX512 : return "AVX-512";
+    case SIMD_ISA_AVX2   : return "AVX2";
+    case SIMD_ISA_SSE2   : return "SSE2";
+    case SIMD_ISA_GENERIC: return "generic";
+    default              : return "unknown";
+  }
+}
+
+//detect at startup, so the first call does not pay for it
+static const int simd_dispatch_startup = simd_dispatch_isa();
+
+/*---------------------------------------------------------------------
+ * dispatched routines
+ *---------------------------------------------------------------------*/
+template <typename T>
+T simd_dispatch_dot(const long N, const T* X, const T* Y)
+{
+  if (simd_dispatch_level < 0) simd_dispatch_init();
+  return simd_dispatch_get<T>().dot(N,X,Y);
+}
+template double simd_dispatch_dot<double>(const long N, const double* X, const double* Y);
+template float simd_dispatch_dot<float>(const long N, const float* X, const float* Y);
+
+template <typename T>
+void simd_dispatch_axpy(const long N, const T A, const T* X, T* Y)
+{
+  if (simd_dispatch_level < 0) simd_dispatch_init();
+  simd_dispatch_get<T>().axpy(N,A,X,Y);
+}
+template void simd_dispatch_axpy<double>(const long N, const double A, const double* X, double* Y);
+template void simd_dispatch_axpy<float>(const long N, const float A, const float* X, float* Y);
+
+template <typename T>
+void simd_dispatch_copy(const long N, const T* X, T* Y)
+{
+  std::memcpy(Y,X,N*sizeof(T));
+}
+template void simd_dispatch_copy<double>(const long N, const double* X, double* Y);
+template void simd_dispatch_copy<float>(const long N, const float* X, float* Y);
+
+template <typename T>
+void simd_dispatch_zero(const long N, T* X)
+{
+  if (simd_dispatch_level < 0) simd_dispatch_init();
+  simd_dispatch_get<T>().zero(N,X);
+}
+template void simd_dispatch_zero<double>(const long N, double* X);
+template void simd_dispatch_zero<float>(const long N, float* X);
+
+template <typename T>
+void simd_dispatch_scal_mul(const long N, const T A, T* X)
+{
+  if (simd_dispatch_level < 0) simd_dispatch_init();
+  simd_dispatch_get<T>().scal_mul(N,A,X);
+}
+template void simd_dispatch_scal_mul<double>(const long N, const double A, double* X);
+template void simd_dispatch_scal_mul<float>(const long N, const float A, float* X);
+
+template <typename T>
+T simd_dispatch_reduction_add(const long N, const T* X)
+{
+  if (simd_dispatch_level < 0) simd_dispatch_init();
+  return simd_dispatch_get<T>().reduction_add(N,X);
+}
+template double simd_dispatch_reduction_add<double>(const long N, const double* X);
+template float simd_dispatch_reduction_add<float>(const long N, const float* X);
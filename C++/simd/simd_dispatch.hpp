@@ -0,0 +1,109 @@
+/*----------------------------------------------------------
+ simd_dispatch.hpp
+    JHT, October 14, 2026 : created
+
+  .hpp file for the runtime dispatched versions of the most
+  used simd routines. The CPU is checked (cpuid) once, at
+  startup or the first time any of these are called, and each
+  call after that goes through a function pointer to the
+  widest kernel the node supports:
+
+    SIMD_ISA_GENERIC -> plain C++ loops
+    SIMD_ISA_SSE2    -> SSE2 kernels (XMM)
+    SIMD_ISA_AVX2    -> AVX2+FMA kernels (YMM)
+    SIMD_ISA_AVX512  -> AVX-512F kernels (ZMM)
+
+  The SSE2, AVX2 and AVX-512 kernels live in their own .cpp
+  files which are always compiled with the matching -m flags
+  (see SIMD_SSE2FLAGS, SIMD_AVX2FLAGS and SIMD_AVX512FLAGS in
+  make.config), so a single libj.a built for a generic x86-64
+  target still uses the full vector width of whatever node it
+  lands on.
+
+  SIMD_DISPATCH : unless the library is already built for
+  AVX-512 (-march=native on such a node), or SIMD_NO_DISPATCH
+  is defined, the double and float simd_dot, simd_axpy,
+  simd_zero, simd_scal_mul and simd_reduction_add of simd.hpp,
+  aligned or not, also go through these tables. So the linal,
+  jblis, and solver code that calls them picks its ISA at
+  runtime too, and simd_dispatch_init(ISA) moves all of them.
+
+  The pointers need not be aligned.
+
+  CURRENTLY SUPPORTED TYPES
+  ------------------------------
+  double,float
+
+  CURRENTLY SUPPORTED OPERATIONS
+  -------------------------------
+  dot           simd_dispatch_dot<type>
+  axpy          simd_dispatch_axpy<type>
+  copy          simd_dispatch_copy<type>
+  zero          simd_dispatch_zero<type>
+  scal_mul      simd_dispatch_scal_mul<type>
+  reduction_add simd_dispatch_reduction_add<type>
+
+  The arguments are the same as the simd_* routines in
+  simd.hpp.
+
+  NOTE : copy is always memcpy, which glibc already dispatches
+         at runtime
+----------------------------------------------------------*/
+#ifndef SIMD_DISPATCH_HPP
+#define SIMD_DISPATCH_HPP
+
+#define SIMD_ISA_GENERIC 0
+#define SIMD_ISA_SSE2    1
+#define SIMD_ISA_AVX2    2
+#define SIMD_ISA_AVX512  3
+
+#if !defined (SIMD_NO_DISPATCH) && !defined (__AVX512F__) && defined (__x86_64__)
+  #define SIMD_DISPATCH
+#endif
+
+/*---------------------------------------------------------
+ * simd_dispatch_init
+ *   sets up the function pointers. Called automatically on
+ *   first use, but may be called again to force a lower
+ *   instruction set (e.g., for testing).
+ *
+ *   ISA    -> requested SIMD_ISA_*, or -1 to use the best
+ *             supported by the cpu. Requests above what the
+ *             cpu supports are lowered
+ *
+ *   returns the SIMD_ISA_* actually in use
+ * -------------------------------------------------------*/
+int simd_dispatch_init(const int ISA=-1);
+
+/*---------------------------------------------------------
+ * simd_dispatch_isa
+ *   returns the SIMD_ISA_* in use, initializing if needed
+ *
+ * simd_dispatch_isa_name
+ *   returns a printable name of a SIMD_ISA_*
+ * -------------------------------------------------------*/
+int simd_dispatch_isa();
+const char* simd_dispatch_isa_name(const int ISA);
+
+/*---------------------------------------------------------
+ * dispatched routines
+ * -------------------------------------------------------*/
+template <typename T>
+T simd_dispatch_dot(const long N, const T* X, const T* Y);
+
+template <typename T>
+void simd_dispatch_axpy(const long N, const T A, const T* X, T* Y);
+
+template <typename T>
+void simd_dispatch_copy(const long N, const T* X, T* Y);
+
+template <typename T>
+void simd_dispatch_zero(const long N, T* X);
+
+template <typename T>
+void simd_dispatch_scal_mul(const long N, const T A, T* X);
+
+template <typename T>
+T simd_dispatch_reduction_add(const long N, const T* X);
+
+#endif
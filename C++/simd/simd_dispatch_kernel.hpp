@@ -0,0 +1,255 @@
+/*----------------------------------------------------------
+ simd_dispatch_kernel.hpp
+    JHT, October 14, 2026 : created
+
+  .hpp file with the unaligned vector kernels behind the
+  runtime dispatched simd routines (simd_dispatch.hpp), and
+  the hooks the simd_* routines use to reach them.
+
+  BYTES is the register width (16 for XMM, 32 for YMM, 64
+  for ZMM). The definitions are only visible to the .cpp
+  files that are compiled for that width
+  (SIMD_DISPATCH_KERNEL_DEFS), every other file only sees
+  the declarations.
+
+  NOTE : this file is only used internally
+----------------------------------------------------------*/
+#ifndef SIMD_DISPATCH_KERNEL_HPP
+#define SIMD_DISPATCH_KERNEL_HPP
+#include "simd_dispatch.hpp"
+
+template <typename T, const int BYTES>
+T simd_dispatch_dot_kernel(const long N, const T* X, const T* Y);
+
+template <typename T, const int BYTES>
+void simd_dispatch_axpy_kernel(const long N, const T A, const T* X, T* Y);
+
+template <typename T, const int BYTES>
+void simd_dispatch_zero_kernel(const long N, T* X);
+
+template <typename T, const int BYTES>
+void simd_dispatch_scal_mul_kernel(const long N, const T A, T* X);
+
+template <typename T, const int BYTES>
+T simd_dispatch_reduction_add_kernel(const long N, const T* X);
+
+/*---------------------------------------------------------
+ * hooks for the simd_* routines. With SIMD_DISPATCH the
+ * double and float simd_dot, simd_axpy, simd_zero,
+ * simd_scal_mul and simd_reduction_add (with or without an
+ * alignment claim) call these first. For double and float
+ * they go through the tables and return true, for the other
+ * types they return false and the compile-time code runs.
+ * -------------------------------------------------------*/
+template <typename T>
+static inline bool simd_dispatch_dot_hook(const long, const T*, const T*, T&) {return false;}
+static inline bool simd_dispatch_dot_hook(const long N, const double* X, const double* Y, double& R)
+{
+  R = simd_dispatch_dot<double>(N,X,Y);
+  return true;
+}
+static inline bool simd_dispatch_dot_hook(const long N, const float* X, const float* Y, float& R)
+{
+  R = simd_dispatch_dot<float>(N,X,Y);
+  return true;
+}
+
+template <typename T>
+static inline bool simd_dispatch_axpy_hook(const long, const T, const T*, T*) {return false;}
+static inline bool simd_dispatch_axpy_hook(const long N, const double A, const double* X, double* Y)
+{
+  simd_dispatch_axpy<double>(N,A,X,Y);
+  return true;
+}
+static inline bool simd_dispatch_axpy_hook(const long N, const float A, const float* X, float* Y)
+{
+  simd_dispatch_axpy<float>(N,A,X,Y);
+  return true;
+}
+
+template <typename T>
+static inline bool simd_dispatch_zero_hook(const long, T*) {return false;}
+static inline bool simd_dispatch_zero_hook(const long N, double* X)
+{
+  simd_dispatch_zero<double>(N,X);
+  return true;
+}
+static inline bool simd_dispatch_zero_hook(const long N, float* X)
+{
+  simd_dispatch_zero<float>(N,X);
+  return true;
+}
+
+template <typename T>
+static inline bool simd_dispatch_scal_mul_hook(const long, const T, T*) {return false;}
+static inline bool simd_dispatch_scal_mul_hook(const long N, const double A, double* X)
+{
+  simd_dispatch_scal_mul<double>(N,A,X);
+  return true;
+}
+static inline bool simd_dispatch_scal_mul_hook(const long N, const float A, float* X)
+{
+  simd_dispatch_scal_mul<float>(N,A,X);
+  return true;
+}
+
+template <typename T>
+static inline bool simd_dispatch_reduction_add_hook(const long, const T*, T&) {return false;}
+static inline bool simd_dispatch_reduction_add_hook(const long N, const double* X, double& R)
+{
+  R = simd_dispatch_reduction_add<double>(N,X);
+  return true;
+}
+static inline bool simd_dispatch_reduction_add_hook(const long N, const float* X, float& R)
+{
+  R = simd_dispatch_reduction_add<float>(N,X);
+  return true;
+}
+
+#if defined (SIMD_DISPATCH_KERNEL_DEFS) && defined (__SSE2__)
+#include "simd_avx.hpp"
+
+//------------------------------------------------------
+// dot
+template <typename T, const int BYTES>
+T simd_dispatch_dot_kernel(const long N, const T* X, const T* Y)
+{
+  typedef simd_vec<T,BYTES> S;
+  const long NW = S::W;
+  typename S::V a0 = S::zero();
+  typename S::V a1 = S::zero();
+  long i=0;
+
+  //two independent accumulators to hide the add latency
+  for (i=0;i+2*NW<=N;i+=2*NW)
+  {
+    a0 = S::fmadd(S::loadu(X+i),S::loadu(Y+i),a0);
+    a1 = S::fmadd(S::loadu(X+i+NW),S::loadu(Y+i+NW),a1);
+  }
+  for (i=i;i+NW<=N;i+=NW)
+  {
+    a0 = S::fmadd(S::loadu(X+i),S::loadu(Y+i),a0);
+  }
+  T sum = S::hsum(S::add(a0,a1));
+
+  //cleanup
+  for (i=i;i<N;i++)
+  {
+    sum += *(X+i) * *(Y+i);
+  }
+  return sum;
+}
+
+//------------------------------------------------------
+// axpy
+template <typename T, const int BYTES>
+void simd_dispatch_axpy_kernel(const long N, const T A, const T* X, T* Y)
+{
+  typedef simd_vec<T,BYTES> S;
+  const long NW = S::W;
+  const typename S::V a = S::set1(A);
+  long i=0;
+
+  for (i=0;i+2*NW<=N;i+=2*NW)
+  {
+    S::storeu(Y+i,S::fmadd(a,S::loadu(X+i),S::loadu(Y+i)));
+    S::storeu(Y+i+NW,S::fmadd(a,S::loadu(X+i+NW),S::loadu(Y+i+NW)));
+  }
+  for (i=i;i+NW<=N;i+=NW)
+  {
+    S::storeu(Y+i,S::fmadd(a,S::loadu(X+i),S::loadu(Y+i)));
+  }
+
+  //cleanup
+  for (i=i;i<N;i++)
+  {
+    *(Y+i) += A * *(X+i);
+  }
+}
+
+//------------------------------------------------------
+// zero
+template <typename T, const int BYTES>
+void simd_dispatch_zero_kernel(const long N, T* X)
+{
+  typedef simd_vec<T,BYTES> S;
+  const long NW = S::W;
+  const typename S::V z = S::zero();
+  long i=0;
+
+  for (i=0;i+2*NW<=N;i+=2*NW)
+  {
+    S::storeu(X+i,z);
+    S::storeu(X+i+NW,z);
+  }
+  for (i=i;i+NW<=N;i+=NW)
+  {
+    S::storeu(X+i,z);
+  }
+
+  //cleanup
+  for (i=i;i<N;i++)
+  {
+    *(X+i) = (T) 0;
+  }
+}
+
+//------------------------------------------------------
+// scal_mul
+template <typename T, const int BYTES>
+void simd_dispatch_scal_mul_kernel(const long N, const T A, T* X)
+{
+  typedef simd_vec<T,BYTES> S;
+  const long NW = S::W;
+  const typename S::V a = S::set1(A);
+  long i=0;
+
+  for (i=0;i+2*NW<=N;i+=2*NW)
+  {
+    S::storeu(X+i,S::mul(S::loadu(X+i),a));
+    S::storeu(X+i+NW,S::mul(S::loadu(X+i+NW),a));
+  }
+  for (i=i;i+NW<=N;i+=NW)
+  {
+    S::storeu(X+i,S::mul(S::loadu(X+i),a));
+  }
+
+  //cleanup
+  for (i=i;i<N;i++)
+  {
+    *(X+i) *= A;
+  }
+}
+
+//------------------------------------------------------
+// reduction_add
+template <typename T, const int BYTES>
+T simd_dispatch_reduction_add_kernel(const long N, const T* X)
+{
+  typedef simd_vec<T,BYTES> S;
+  const long NW = S::W;
+  typename S::V a0 = S::zero();
+  typename S::V a1 = S::zero();
+  long i=0;
+
+  for (i=0;i+2*NW<=N;i+=2*NW)
+  {
+    a0 = S::add(S::loadu(X+i),a0);
+    a1 = S::add(S::loadu(X+i+NW),a1);
+  }
+  for (i=i;i+NW<=N;i+=NW)
+  {
+    a0 = S::add(S::loadu(X+i),a0);
+  }
+  T sum = S::hsum(S::add(a0,a1));
+
+  //cleanup
+  for (i=i;i<N;i++)
+  {
+    sum += *(X+i);
+  }
+  return sum;
+}
+
+#endif
+#endif
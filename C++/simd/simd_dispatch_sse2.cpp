@@ -0,0 +1,30 @@
+/* simd_dispatch_sse2.cpp
+ * JHT, October 14, 2026 : created
+ *
+ * .cpp file that instantiates the 16 BYTE register kernels for
+ * the runtime dispatched simd routines. This file must be 
+ * compiled with -msse2 ($(SIMD_SSE2FLAGS) in make.config),
+ * regardless of the flags used for the rest of the library
+ *
+ */
+#define SIMD_DISPATCH_KERNEL_DEFS
+#include "simd_dispatch_kernel.hpp"
+
+#if !defined (__SSE2__)
+  #error "simd_dispatch_sse2.cpp must be compiled with $(SIMD_SSE2FLAGS)"
+#endif
+
+template double simd_dispatch_dot_kernel<double,16>(const long N, const double* X, const double* Y);
+template float simd_dispatch_dot_kernel<float,16>(const long N, const float* X, const float* Y);
+
+template void simd_dispatch_axpy_kernel<double,16>(const long N, const double A, const double* X, double* Y);
+template void simd_dispatch_axpy_kernel<float,16>(const long N, const float A, const float* X, float* Y);
+
+template void simd_dispatch_zero_kernel<double,16>(const long N, double* X);
+template void simd_dispatch_zero_kernel<float,16>(const long N, float* X);
+
+template void simd_dispatch_scal_mul_kernel<double,16>(const long N, const double A, double* X);
+template void simd_dispatch_scal_mul_kernel<float,16>(const long N, const float A, float* X);
+
+template double simd_dispatch_reduction_add_kernel<double,16>(const long N, const double* X);
+template float simd_dispatch_reduction_add_kernel<float,16>(const long N, const float* X);
@@ -7,9 +7,18 @@
  * If compiled with OpenMP, will use the OpenMP SIMD pragmas to 
  * provide hints to the compiler
  *
+ * Hand-coded AVX2/AVX-512 routines are used for doubles and floats
+ * claimed to be aligned to 32 or 64 BYTE boundaries
+ *
+ * With SIMD_DISPATCH (see simd_dispatch.hpp) doubles and floats go
+ * through the runtime dispatched kernels instead
+ *
  */
 
 #include "simd.hpp"
+#include "debug.hpp"
+#include "simd_avx.hpp"
+#include "simd_dispatch_kernel.hpp"
 
 /*---------------------------------------------------------------------
  * dot without (known) alignment
@@ -19,27 +28,38 @@
 template <typename T>
 T simd_dot(const long N, const T* X, const T* Y)
 {
+  #if defined (SIMD_DISPATCH)
+    T r;
+    if (simd_dispatch_dot_hook(N,X,Y,r)) return r;
+  #endif
+
   T dot = 0;
   #if defined (_OPENMP)
-    #pragma omp simd  
+    #pragma omp simd reduction(+:dot)
     for (long i=0;i<N;i++)
     {
       dot += *(X+i) * *(Y+i);
     }
   #else
+    //independent accumulators, so the adds do not wait on each other
+    T dot0 = 0;
+    T dot1 = 0;
+    T dot2 = 0;
+    T dot3 = 0;
     long i=0;
     for (i=0;i<(N-4);i+=4)
     {
-      dot += *(X+i+0) * *(Y+i+0);
-      dot += *(X+i+1) * *(Y+i+1);
-      dot += *(X+i+2) * *(Y+i+2);
-      dot += *(X+i+3) * *(Y+i+3);
+      dot0 += *(X+i+0) * *(Y+i+0);
+      dot1 += *(X+i+1) * *(Y+i+1);
+      dot2 += *(X+i+2) * *(Y+i+2);
+      dot3 += *(X+i+3) * *(Y+i+3);
     }
     
     for (i=i;i<N;i++)
     {
-      dot += *(X+i) * *(Y+i);
+      dot0 += *(X+i) * *(Y+i);
     }
+    dot = (dot0 + dot1) + (dot2 + dot3);
   #endif
   return dot;
 }
@@ -59,40 +79,57 @@ template int simd_dot<int>(const long N, const int* X, const int* Y);
 template <typename T, const int ALIGNMENT>
 T simd_dot(const long N, const T* X, const T* Y)
 {
+  LIBJ_CHECK_ALIGNED(X,ALIGNMENT);
+  LIBJ_CHECK_ALIGNED(Y,ALIGNMENT);
+  #if defined (SIMD_DISPATCH)
+    T r;
+    if (simd_dispatch_dot_hook(N,X,Y,r)) return r;
+  #endif
+
   T dot = 0;
   #if defined (_OPENMP)
-    #pragma omp simd  aligned(X,Y:ALIGNMENT) 
+    #pragma omp simd aligned(X,Y:ALIGNMENT) reduction(+:dot)
     for (long i=0;i<N;i++)
     {
       dot += *(X+i) * *(Y+i);
     }
   #else
+    //independent accumulators, so the adds do not wait on each other
+    T dot0 = 0;
+    T dot1 = 0;
+    T dot2 = 0;
+    T dot3 = 0;
     long i=0;
     for (i=0;i<(N-4);i+=4)
     {
-      dot += *(X+i+0) * *(Y+i+0);
-      dot += *(X+i+1) * *(Y+i+1);
-      dot += *(X+i+2) * *(Y+i+2);
-      dot += *(X+i+3) * *(Y+i+3);
+      dot0 += *(X+i+0) * *(Y+i+0);
+      dot1 += *(X+i+1) * *(Y+i+1);
+      dot2 += *(X+i+2) * *(Y+i+2);
+      dot3 += *(X+i+3) * *(Y+i+3);
     }
     
     for (i=i;i<N;i++)
     {
-      dot += *(X+i) * *(Y+i);
+      dot0 += *(X+i) * *(Y+i);
     }
+    dot = (dot0 + dot1) + (dot2 + dot3);
   #endif
   return dot;
 }
 
+#if !defined (__AVX2__) //special instructions below
 template double simd_dot<double,128>(const long N, const double* X, const double* Y);
 template double simd_dot<double,64>(const long N, const double* X, const double* Y);
 template double simd_dot<double,32>(const long N, const double* X, const double* Y);
+#endif
 template double simd_dot<double,16>(const long N, const double* X, const double* Y);
 template double simd_dot<double,8>(const long N, const double* X, const double* Y);
 
+#if !defined (__AVX2__) //special instructions below
 template float simd_dot<float,128>(const long N, const float* X, const float* Y);
 template float simd_dot<float,64>(const long N, const float* X, const float* Y);
 template float simd_dot<float,32>(const long N, const float* X, const float* Y);
+#endif
 template float simd_dot<float,16>(const long N, const float* X, const float* Y);
 template float simd_dot<float,8>(const long N, const float* X, const float* Y);
 template float simd_dot<float,4>(const long N, const float* X, const float* Y);
@@ -109,3 +146,79 @@ template int simd_dot<int,32>(const long N, const int* X, const int* Y);
 template int simd_dot<int,16>(const long N, const int* X, const int* Y);
 template int simd_dot<int,8>(const long N, const int* X, const int* Y);
 template int simd_dot<int,4>(const long N, const int* X, const int* Y);
+
+//------------------------------------------------------------------------------
+//  Hand-coded routines for doubles and floats claimed to be aligned to
+//  32 or 64 BYTE boundaries. 64 BYTE claims use AVX-512 if available,
+//  128 BYTE claims use the 64 BYTE code
+#if defined (__AVX2__)
+template <typename T, const int BYTES>
+static inline T simd_dot_avx(const long N, const T* X, const T* Y)
+{
+  #if defined (SIMD_DISPATCH)
+    T r;
+    if (simd_dispatch_dot_hook(N,X,Y,r)) return r;
+  #endif
+
+  typedef simd_vec<T,BYTES> S;
+  const long NW = S::W;
+  typename S::V a0 = S::zero();
+  typename S::V a1 = S::zero();
+  long i=0;
+
+  //two independent accumulators to hide the add latency
+  for (i=0;i+2*NW<=N;i+=2*NW)
+  {
+    a0 = S::fmadd(S::load(X+i),S::load(Y+i),a0);
+    a1 = S::fmadd(S::load(X+i+NW),S::load(Y+i+NW),a1);
+  }
+  for (i=i;i+NW<=N;i+=NW)
+  {
+    a0 = S::fmadd(S::load(X+i),S::load(Y+i),a0);
+  }
+  T sum = S::hsum(S::add(a0,a1));
+
+  //cleanup
+  for (i=i;i<N;i++)
+  {
+    sum += *(X+i) * *(Y+i);
+  }
+  return sum;
+}
+
+template<>
+double simd_dot<double,32>(const long N, const double* X, const double* Y)
+{
+  return simd_dot_avx<double,32>(N,X,Y);
+}
+
+template<>
+double simd_dot<double,64>(const long N, const double* X, const double* Y)
+{
+  return simd_dot_avx<double,SIMD_AVX_WIDE>(N,X,Y);
+}
+
+template<>
+double simd_dot<double,128>(const long N, const double* X, const double* Y)
+{
+  return simd_dot<double,64>(N,X,Y);
+}
+
+template<>
+float simd_dot<float,32>(const long N, const float* X, const float* Y)
+{
+  return simd_dot_avx<float,32>(N,X,Y);
+}
+
+template<>
+float simd_dot<float,64>(const long N, const float* X, const float* Y)
+{
+  return simd_dot_avx<float,SIMD_AVX_WIDE>(N,X,Y);
+}
+
+template<>
+float simd_dot<float,128>(const long N, const float* X, const float* Y)
+{
+  return simd_dot<float,64>(N,X,Y);
+}
+#endif
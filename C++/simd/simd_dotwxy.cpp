@@ -7,9 +7,14 @@
  * If compiled with OpenMP, will use the OpenMP SIMD pragmas to 
  * provide hints to the compiler
  *
+ * Hand-coded AVX2/AVX-512 routines are used for doubles and floats
+ * claimed to be aligned to 32 or 64 BYTE boundaries
+ *
  */
 
 #include "simd.hpp"
+#include "debug.hpp"
+#include "simd_avx.hpp"
 
 /*---------------------------------------------------------------------
  * dot without (known) alignment
@@ -22,7 +27,7 @@ T simd_dotwxy(const long N, const T* W, const T* X, const T* Y)
   T dot = 0;
   #if defined (_OPENMP)
     T tmp;
-    #pragma omp simd  
+    #pragma omp simd private(tmp) reduction(+:dot)
     for (long i=0;i<N;i++)
     {
       tmp  = *(W+i) * *(X+i);
@@ -72,10 +77,13 @@ template int simd_dotwxy<int>(const long N, const int* W, const int* X, const in
 template <typename T, const int ALIGNMENT>
 T simd_dotwxy(const long N, const T* W, const T* X, const T* Y)
 {
+  LIBJ_CHECK_ALIGNED(W,ALIGNMENT);
+  LIBJ_CHECK_ALIGNED(X,ALIGNMENT);
+  LIBJ_CHECK_ALIGNED(Y,ALIGNMENT);
   T dot = 0;
   #if defined (_OPENMP)
     T tmp;
-    #pragma omp simd  aligned(W,X,Y:ALIGNMENT) 
+    #pragma omp simd aligned(W,X,Y:ALIGNMENT) private(tmp) reduction(+:dot)
     for (long i=0;i<N;i++)
     {
       tmp  = *(W+i) * *(X+i);
@@ -109,15 +117,19 @@ T simd_dotwxy(const long N, const T* W, const T* X, const T* Y)
   return dot;
 }
 
+#if !defined (__AVX2__) //special instructions below
 template double simd_dotwxy<double,128>(const long N, const double* W, const double* X, const double* Y);
 template double simd_dotwxy<double,64>(const long N, const double* W, const double* X, const double* Y);
 template double simd_dotwxy<double,32>(const long N, const double* W, const double* X, const double* Y);
+#endif
 template double simd_dotwxy<double,16>(const long N, const double* W, const double* X, const double* Y);
 template double simd_dotwxy<double,8>(const long N, const double* W, const double* X, const double* Y);
 
+#if !defined (__AVX2__) //special instructions below
 template float simd_dotwxy<float,128>(const long N, const float* W, const float* X, const float* Y);
 template float simd_dotwxy<float,64>(const long N, const float* W, const float* X, const float* Y);
 template float simd_dotwxy<float,32>(const long N, const float* W, const float* X, const float* Y);
+#endif
 template float simd_dotwxy<float,16>(const long N, const float* W, const float* X, const float* Y);
 template float simd_dotwxy<float,8>(const long N, const float* W, const float* X, const float* Y);
 template float simd_dotwxy<float,4>(const long N, const float* W, const float* X, const float* Y);
@@ -134,3 +146,74 @@ template int simd_dotwxy<int,32>(const long N, const int* W, const int* X, const
 template int simd_dotwxy<int,16>(const long N, const int* W, const int* X, const int* Y);
 template int simd_dotwxy<int,8>(const long N, const int* W, const int* X, const int* Y);
 template int simd_dotwxy<int,4>(const long N, const int* W, const int* X, const int* Y);
+
+//------------------------------------------------------------------------------
+//  Hand-coded routines for doubles and floats claimed to be aligned to
+//  32 or 64 BYTE boundaries. 64 BYTE claims use AVX-512 if available,
+//  128 BYTE claims use the 64 BYTE code
+#if defined (__AVX2__)
+template <typename T, const int BYTES>
+static inline T simd_dotwxy_avx(const long N, const T* W, const T* X, const T* Y)
+{
+  typedef simd_vec<T,BYTES> S;
+  const long NW = S::W;
+  typename S::V a0 = S::zero();
+  typename S::V a1 = S::zero();
+  long i=0;
+
+  //two independent accumulators to hide the add latency
+  for (i=0;i+2*NW<=N;i+=2*NW)
+  {
+    a0 = S::fmadd(S::mul(S::load(W+i),S::load(X+i)),S::load(Y+i),a0);
+    a1 = S::fmadd(S::mul(S::load(W+i+NW),S::load(X+i+NW)),S::load(Y+i+NW),a1);
+  }
+  for (i=i;i+NW<=N;i+=NW)
+  {
+    a0 = S::fmadd(S::mul(S::load(W+i),S::load(X+i)),S::load(Y+i),a0);
+  }
+  T sum = S::hsum(S::add(a0,a1));
+
+  //cleanup
+  for (i=i;i<N;i++)
+  {
+    sum += *(W+i) * *(X+i) * *(Y+i);
+  }
+  return sum;
+}
+
+template<>
+double simd_dotwxy<double,32>(const long N, const double* W, const double* X, const double* Y)
+{
+  return simd_dotwxy_avx<double,32>(N,W,X,Y);
+}
+
+template<>
+double simd_dotwxy<double,64>(const long N, const double* W, const double* X, const double* Y)
+{
+  return simd_dotwxy_avx<double,SIMD_AVX_WIDE>(N,W,X,Y);
+}
+
+template<>
+double simd_dotwxy<double,128>(const long N, const double* W, const double* X, const double* Y)
+{
+  return simd_dotwxy<double,64>(N,W,X,Y);
+}
+
+template<>
+float simd_dotwxy<float,32>(const long N, const float* W, const float* X, const float* Y)
+{
+  return simd_dotwxy_avx<float,32>(N,W,X,Y);
+}
+
+template<>
+float simd_dotwxy<float,64>(const long N, const float* W, const float* X, const float* Y)
+{
+  return simd_dotwxy_avx<float,SIMD_AVX_WIDE>(N,W,X,Y);
+}
+
+template<>
+float simd_dotwxy<float,128>(const long N, const float* W, const float* X, const float* Y)
+{
+  return simd_dotwxy<float,64>(N,W,X,Y);
+}
+#endif
@@ -7,9 +7,14 @@
  * If compiled with OpenMP, will use the OpenMP SIMD pragmas to 
  * provide hints to the compiler
  *
+ * Hand-coded AVX2/AVX-512 routines are used for doubles and floats
+ * claimed to be aligned to 32 or 64 BYTE boundaries
+ *
  */
 
 #include "simd.hpp"
+#include "debug.hpp"
+#include "simd_avx.hpp"
 
 /*---------------------------------------------------------------------
  * Element wise multiplication without (known) alignment
@@ -18,6 +23,8 @@
 template <typename T>
 void simd_elemwise_mul(const long N, const T* X, const T* Y, T* Z)
 {
+  LIBJ_CHECK_INPLACE(X,N,Z,N);
+  LIBJ_CHECK_INPLACE(Y,N,Z,N);
   #if defined (_OPENMP)
     #pragma omp simd  
     for (long i=0;i<N;i++)
@@ -53,6 +60,11 @@ template void simd_elemwise_mul<int>(const long N, const int* X, const int* Y, i
 template <typename T, const int ALIGNMENT>
 void simd_elemwise_mul(const long N, const T* X, const T* Y, T* Z)
 {
+  LIBJ_CHECK_ALIGNED(X,ALIGNMENT);
+  LIBJ_CHECK_ALIGNED(Y,ALIGNMENT);
+  LIBJ_CHECK_ALIGNED(Z,ALIGNMENT);
+  LIBJ_CHECK_INPLACE(X,N,Z,N);
+  LIBJ_CHECK_INPLACE(Y,N,Z,N);
   #if defined (_OPENMP)
     #pragma omp simd  aligned(X,Y,Z:ALIGNMENT) 
     for (long i=0;i<N;i++)
@@ -76,24 +88,98 @@ void simd_elemwise_mul(const long N, const T* X, const T* Y, T* Z)
   #endif
 }
 
+#if !defined (__AVX2__) //special instructions below
+template void simd_elemwise_mul<double,128>(const long N, const double* X, const double* Y, double* Z);
 template void simd_elemwise_mul<double,64>(const long N, const double* X, const double* Y, double* Z);
 template void simd_elemwise_mul<double,32>(const long N, const double* X, const double* Y, double* Z);
+#endif
 template void simd_elemwise_mul<double,16>(const long N, const double* X, const double* Y, double* Z);
 template void simd_elemwise_mul<double,8>(const long N, const double* X, const double* Y, double* Z);
 
+#if !defined (__AVX2__) //special instructions below
+template void simd_elemwise_mul<float,128>(const long N, const float* X, const float* Y, float* Z);
 template void simd_elemwise_mul<float,64>(const long N, const float* X, const float* Y, float* Z);
 template void simd_elemwise_mul<float,32>(const long N, const float* X, const float* Y, float* Z);
+#endif
 template void simd_elemwise_mul<float,16>(const long N, const float* X, const float* Y, float* Z);
 template void simd_elemwise_mul<float,8>(const long N, const float* X, const float* Y, float* Z);
 template void simd_elemwise_mul<float,4>(const long N, const float* X, const float* Y, float* Z);
 
+template void simd_elemwise_mul<long,128>(const long N, const long* X, const long* Y, long* Z);
 template void simd_elemwise_mul<long,64>(const long N, const long* X, const long* Y, long* Z);
 template void simd_elemwise_mul<long,32>(const long N, const long* X, const long* Y, long* Z);
 template void simd_elemwise_mul<long,16>(const long N, const long* X, const long* Y, long* Z);
 template void simd_elemwise_mul<long,8>(const long N, const long* X, const long* Y, long* Z);
 
+template void simd_elemwise_mul<int,128>(const long N, const int* X, const int* Y, int* Z);
 template void simd_elemwise_mul<int,64>(const long N, const int* X, const int* Y, int* Z);
 template void simd_elemwise_mul<int,32>(const long N, const int* X, const int* Y, int* Z);
 template void simd_elemwise_mul<int,16>(const long N, const int* X, const int* Y, int* Z);
 template void simd_elemwise_mul<int,8>(const long N, const int* X, const int* Y, int* Z);
 template void simd_elemwise_mul<int,4>(const long N, const int* X, const int* Y, int* Z);
+
+//------------------------------------------------------------------------------
+//  Hand-coded routines for doubles and floats claimed to be aligned to
+//  32 or 64 BYTE boundaries. 64 BYTE claims use AVX-512 if available,
+//  128 BYTE claims use the 64 BYTE code
+#if defined (__AVX2__)
+template <typename T, const int BYTES>
+static inline void simd_elemwise_mul_avx(const long N, const T* X, const T* Y, T* Z)
+{
+  typedef simd_vec<T,BYTES> S;
+  const long NW = S::W;
+  long i=0;
+
+  for (i=0;i+2*NW<=N;i+=2*NW)
+  {
+    S::store(Z+i,S::mul(S::load(X+i),S::load(Y+i)));
+    S::store(Z+i+NW,S::mul(S::load(X+i+NW),S::load(Y+i+NW)));
+  }
+  for (i=i;i+NW<=N;i+=NW)
+  {
+    S::store(Z+i,S::mul(S::load(X+i),S::load(Y+i)));
+  }
+
+  //cleanup
+  for (i=i;i<N;i++)
+  {
+    *(Z+i) = *(X+i) * *(Y+i);
+  }
+}
+
+template<>
+void simd_elemwise_mul<double,32>(const long N, const double* X, const double* Y, double* Z)
+{
+  simd_elemwise_mul_avx<double,32>(N,X,Y,Z);
+}
+
+template<>
+void simd_elemwise_mul<double,64>(const long N, const double* X, const double* Y, double* Z)
+{
+  simd_elemwise_mul_avx<double,SIMD_AVX_WIDE>(N,X,Y,Z);
+}
+
+template<>
+void simd_elemwise_mul<double,128>(const long N, const double* X, const double* Y, double* Z)
+{
+  simd_elemwise_mul<double,64>(N,X,Y,Z);
+}
+
+template<>
+void simd_elemwise_mul<float,32>(const long N, const float* X, const float* Y, float* Z)
+{
+  simd_elemwise_mul_avx<float,32>(N,X,Y,Z);
+}
+
+template<>
+void simd_elemwise_mul<float,64>(const long N, const float* X, const float* Y, float* Z)
+{
+  simd_elemwise_mul_avx<float,SIMD_AVX_WIDE>(N,X,Y,Z);
+}
+
+template<>
+void simd_elemwise_mul<float,128>(const long N, const float* X, const float* Y, float* Z)
+{
+  simd_elemwise_mul<float,64>(N,X,Y,Z);
+}
+#endif
@@ -0,0 +1,142 @@
+/* simd_elemwise_mul_reduce.cpp
+ * JHT, October 14, 2026 : created
+ *
+ * .cpp file that implements the fused simd element-wise multiply
+ * and reduction
+ *   Z = X*Y, returns sum(Z)
+ * which replaces a simd_elemwise_mul followed by a 
+ * simd_reduction_add on Z. If Z is not needed, use simd_dot
+ *
+ * If compiled with OpenMP, will use the OpenMP SIMD pragmas to 
+ * provide hints to the compiler
+ *
+ */
+
+#include "simd.hpp"
+#include "debug.hpp"
+
+/*---------------------------------------------------------------------
+ * elemwise_mul_reduce without (known) alignment
+ *   - if OpenMP is defined, use the pragmas to request vectorization
+ *   - otherwise, use loop unrolling
+ *---------------------------------------------------------------------*/
+template <typename T>
+T simd_elemwise_mul_reduce(const long N, const T* X, const T* Y, T* Z)
+{
+  LIBJ_CHECK_INPLACE(X,N,Z,N);
+  LIBJ_CHECK_INPLACE(Y,N,Z,N);
+  T sum = 0;
+  #if defined (_OPENMP)
+    #pragma omp simd reduction(+:sum)
+    for (long i=0;i<N;i++)
+    {
+      *(Z+i) = *(X+i) * *(Y+i);
+      sum   += *(Z+i);
+    }
+  #else
+    T sum0 = 0;
+    T sum1 = 0;
+    T sum2 = 0;
+    T sum3 = 0;
+    long i=0;
+    for (i=0;i<(N-4);i+=4)
+    {
+      *(Z+i+0) = *(X+i+0) * *(Y+i+0);
+      *(Z+i+1) = *(X+i+1) * *(Y+i+1);
+      *(Z+i+2) = *(X+i+2) * *(Y+i+2);
+      *(Z+i+3) = *(X+i+3) * *(Y+i+3);
+      sum0 += *(Z+i+0);
+      sum1 += *(Z+i+1);
+      sum2 += *(Z+i+2);
+      sum3 += *(Z+i+3);
+    }
+    
+    for (i=i;i<N;i++)
+    {
+      *(Z+i) = *(X+i) * *(Y+i);
+      sum0  += *(Z+i);
+    }
+    sum = (sum0 + sum1) + (sum2 + sum3);
+  #endif
+  return sum;
+}
+template double simd_elemwise_mul_reduce<double>(const long N, const double* X, const double* Y, double* Z);
+template float simd_elemwise_mul_reduce<float>(const long N, const float* X, const float* Y, float* Z);
+template long simd_elemwise_mul_reduce<long>(const long N, const long* X, const long* Y, long* Z);
+template int simd_elemwise_mul_reduce<int>(const long N, const int* X, const int* Y, int* Z);
+
+
+/*---------------------------------------------------------------------
+ * elemwise_mul_reduce with known alignment
+ *   - if OpenMP is defined, use the pragmas to request vectorization
+ *   - otherwise, use loop unrolling
+ *---------------------------------------------------------------------*/
+template <typename T, const int ALIGNMENT>
+T simd_elemwise_mul_reduce(const long N, const T* X, const T* Y, T* Z)
+{
+  LIBJ_CHECK_ALIGNED(X,ALIGNMENT);
+  LIBJ_CHECK_ALIGNED(Y,ALIGNMENT);
+  LIBJ_CHECK_ALIGNED(Z,ALIGNMENT);
+  LIBJ_CHECK_INPLACE(X,N,Z,N);
+  LIBJ_CHECK_INPLACE(Y,N,Z,N);
+  T sum = 0;
+  #if defined (_OPENMP)
+    #pragma omp simd aligned(X,Y,Z:ALIGNMENT) reduction(+:sum)
+    for (long i=0;i<N;i++)
+    {
+      *(Z+i) = *(X+i) * *(Y+i);
+      sum   += *(Z+i);
+    }
+  #else
+    T sum0 = 0;
+    T sum1 = 0;
+    T sum2 = 0;
+    T sum3 = 0;
+    long i=0;
+    for (i=0;i<(N-4);i+=4)
+    {
+      *(Z+i+0) = *(X+i+0) * *(Y+i+0);
+      *(Z+i+1) = *(X+i+1) * *(Y+i+1);
+      *(Z+i+2) = *(X+i+2) * *(Y+i+2);
+      *(Z+i+3) = *(X+i+3) * *(Y+i+3);
+      sum0 += *(Z+i+0);
+      sum1 += *(Z+i+1);
+      sum2 += *(Z+i+2);
+      sum3 += *(Z+i+3);
+    }
+    
+    for (i=i;i<N;i++)
+    {
+      *(Z+i) = *(X+i) * *(Y+i);
+      sum0  += *(Z+i);
+    }
+    sum = (sum0 + sum1) + (sum2 + sum3);
+  #endif
+  return sum;
+}
+
+template double simd_elemwise_mul_reduce<double,128>(const long N, const double* X, const double* Y, double* Z);
+template double simd_elemwise_mul_reduce<double,64>(const long N, const double* X, const double* Y, double* Z);
+template double simd_elemwise_mul_reduce<double,32>(const long N, const double* X, const double* Y, double* Z);
+template double simd_elemwise_mul_reduce<double,16>(const long N, const double* X, const double* Y, double* Z);
+template double simd_elemwise_mul_reduce<double,8>(const long N, const double* X, const double* Y, double* Z);
+
+template float simd_elemwise_mul_reduce<float,128>(const long N, const float* X, const float* Y, float* Z);
+template float simd_elemwise_mul_reduce<float,64>(const long N, const float* X, const float* Y, float* Z);
+template float simd_elemwise_mul_reduce<float,32>(const long N, const float* X, const float* Y, float* Z);
+template float simd_elemwise_mul_reduce<float,16>(const long N, const float* X, const float* Y, float* Z);
+template float simd_elemwise_mul_reduce<float,8>(const long N, const float* X, const float* Y, float* Z);
+template float simd_elemwise_mul_reduce<float,4>(const long N, const float* X, const float* Y, float* Z);
+
+template long simd_elemwise_mul_reduce<long,128>(const long N, const long* X, const long* Y, long* Z);
+template long simd_elemwise_mul_reduce<long,64>(const long N, const long* X, const long* Y, long* Z);
+template long simd_elemwise_mul_reduce<long,32>(const long N, const long* X, const long* Y, long* Z);
+template long simd_elemwise_mul_reduce<long,16>(const long N, const long* X, const long* Y, long* Z);
+template long simd_elemwise_mul_reduce<long,8>(const long N, const long* X, const long* Y, long* Z);
+
+template int simd_elemwise_mul_reduce<int,128>(const long N, const int* X, const int* Y, int* Z);
+template int simd_elemwise_mul_reduce<int,64>(const long N, const int* X, const int* Y, int* Z);
+template int simd_elemwise_mul_reduce<int,32>(const long N, const int* X, const int* Y, int* Z);
+template int simd_elemwise_mul_reduce<int,16>(const long N, const int* X, const int* Y, int* Z);
+template int simd_elemwise_mul_reduce<int,8>(const long N, const int* X, const int* Y, int* Z);
+template int simd_elemwise_mul_reduce<int,4>(const long N, const int* X, const int* Y, int* Z);
@@ -0,0 +1,245 @@
+/* simd_gather.cpp
+ * JHT, October 14, 2026 : created
+ *
+ * .cpp file that implements the level-1 simd routines through an
+ * index vector, as used by the scatter matrices:
+ *
+ *   gather  : reads  *(X+IDX[i])
+ *   scatter : writes *(Y+IDX[i])
+ *
+ * If compiled with AVX2, gathers of doubles use _mm256_i64gather_pd.
+ * If compiled with AVX-512F, scatters of doubles use
+ * _mm512_i64scatter_pd. Repeated indices in a scatter are written
+ * in order, so the last one wins, as in the scalar loop
+ *
+ */
+
+#include "simd.hpp"
+
+/*---------------------------------------------------------------------
+ * gather axpy, Y[i] += A*X[IDX[i]]
+ *---------------------------------------------------------------------*/
+template <typename T>
+void simd_gather_axpy(const long N, const T A, const T* X, const long* IDX, T* Y)
+{
+  long i=0;
+  for (i=0;i<(N-4);i+=4)
+  {
+    *(Y+i+0) += A * *(X+*(IDX+i+0));
+    *(Y+i+1) += A * *(X+*(IDX+i+1));
+    *(Y+i+2) += A * *(X+*(IDX+i+2));
+    *(Y+i+3) += A * *(X+*(IDX+i+3));
+  }
+
+  for (i=i;i<N;i++)
+  {
+    *(Y+i) += A * *(X+*(IDX+i));
+  }
+}
+
+#if defined (__AVX2__)
+template <>
+void simd_gather_axpy<double>(const long N, const double A, const double* X, const long* IDX, double* Y)
+{
+  const __m256d a = _mm256_set1_pd(A);
+  long i=0;
+  for (i=0;i+4<=N;i+=4)
+  {
+    const __m256i idx = _mm256_loadu_si256((const __m256i*)(IDX+i));
+    const __m256d x   = _mm256_i64gather_pd(X,idx,8);
+    #if defined (__FMA__)
+      _mm256_storeu_pd(Y+i,_mm256_fmadd_pd(a,x,_mm256_loadu_pd(Y+i)));
+    #else
+      _mm256_storeu_pd(Y+i,_mm256_add_pd(_mm256_mul_pd(a,x),_mm256_loadu_pd(Y+i)));
+    #endif
+  }
+
+  //cleanup
+  for (i=i;i<N;i++)
+  {
+    *(Y+i) += A * *(X+*(IDX+i));
+  }
+}
+#else
+template void simd_gather_axpy<double>(const long N, const double A, const double* X, const long* IDX, double* Y);
+#endif
+template void simd_gather_axpy<float>(const long N, const float A, const float* X, const long* IDX, float* Y);
+template void simd_gather_axpy<long>(const long N, const long A, const long* X, const long* IDX, long* Y);
+template void simd_gather_axpy<int>(const long N, const int A, const int* X, const long* IDX, int* Y);
+
+/*---------------------------------------------------------------------
+ * gather dot, returns sum_i X[IDX[i]]*Y[i]
+ *---------------------------------------------------------------------*/
+template <typename T>
+T simd_gather_dot(const long N, const T* X, const long* IDX, const T* Y)
+{
+  T dot0 = 0;
+  T dot1 = 0;
+  T dot2 = 0;
+  T dot3 = 0;
+  long i=0;
+  for (i=0;i<(N-4);i+=4)
+  {
+    dot0 += *(X+*(IDX+i+0)) * *(Y+i+0);
+    dot1 += *(X+*(IDX+i+1)) * *(Y+i+1);
+    dot2 += *(X+*(IDX+i+2)) * *(Y+i+2);
+    dot3 += *(X+*(IDX+i+3)) * *(Y+i+3);
+  }
+
+  for (i=i;i<N;i++)
+  {
+    dot0 += *(X+*(IDX+i)) * *(Y+i);
+  }
+  return (dot0 + dot1) + (dot2 + dot3);
+}
+
+#if defined (__AVX2__)
+template <>
+double simd_gather_dot<double>(const long N, const double* X, const long* IDX, const double* Y)
+{
+  __m256d a = _mm256_setzero_pd();
+  long i=0;
+  for (i=0;i+4<=N;i+=4)
+  {
+    const __m256i idx = _mm256_loadu_si256((const __m256i*)(IDX+i));
+    const __m256d x   = _mm256_i64gather_pd(X,idx,8);
+    #if defined (__FMA__)
+      a = _mm256_fmadd_pd(x,_mm256_loadu_pd(Y+i),a);
+    #else
+      a = _mm256_add_pd(_mm256_mul_pd(x,_mm256_loadu_pd(Y+i)),a);
+    #endif
+  }
+
+  double part[4];
+  _mm256_storeu_pd(part,a);
+  double dot = (part[0] + part[1]) + (part[2] + part[3]);
+
+  //cleanup
+  for (i=i;i<N;i++)
+  {
+    dot += *(X+*(IDX+i)) * *(Y+i);
+  }
+  return dot;
+}
+#else
+template double simd_gather_dot<double>(const long N, const double* X, const long* IDX, const double* Y);
+#endif
+template float simd_gather_dot<float>(const long N, const float* X, const long* IDX, const float* Y);
+template long simd_gather_dot<long>(const long N, const long* X, const long* IDX, const long* Y);
+template int simd_gather_dot<int>(const long N, const int* X, const long* IDX, const int* Y);
+
+/*---------------------------------------------------------------------
+ * gather copy, Y[i] = X[IDX[i]]
+ *---------------------------------------------------------------------*/
+template <typename T>
+void simd_gather_copy(const long N, const T* X, const long* IDX, T* Y)
+{
+  long i=0;
+  for (i=0;i<(N-4);i+=4)
+  {
+    *(Y+i+0) = *(X+*(IDX+i+0));
+    *(Y+i+1) = *(X+*(IDX+i+1));
+    *(Y+i+2) = *(X+*(IDX+i+2));
+    *(Y+i+3) = *(X+*(IDX+i+3));
+  }
+
+  for (i=i;i<N;i++)
+  {
+    *(Y+i) = *(X+*(IDX+i));
+  }
+}
+
+#if defined (__AVX2__)
+template <>
+void simd_gather_copy<double>(const long N, const double* X, const long* IDX, double* Y)
+{
+  long i=0;
+  for (i=0;i+4<=N;i+=4)
+  {
+    const __m256i idx = _mm256_loadu_si256((const __m256i*)(IDX+i));
+    _mm256_storeu_pd(Y+i,_mm256_i64gather_pd(X,idx,8));
+  }
+
+  //cleanup
+  for (i=i;i<N;i++)
+  {
+    *(Y+i) = *(X+*(IDX+i));
+  }
+}
+#else
+template void simd_gather_copy<double>(const long N, const double* X, const long* IDX, double* Y);
+#endif
+template void simd_gather_copy<float>(const long N, const float* X, const long* IDX, float* Y);
+template void simd_gather_copy<long>(const long N, const long* X, const long* IDX, long* Y);
+template void simd_gather_copy<int>(const long N, const int* X, const long* IDX, int* Y);
+
+/*---------------------------------------------------------------------
+ * scatter copy, Y[IDX[i]] = X[i]
+ *---------------------------------------------------------------------*/
+template <typename T>
+void simd_scatter_copy(const long N, const T* X, T* Y, const long* IDX)
+{
+  long i=0;
+  for (i=0;i<(N-4);i+=4)
+  {
+    *(Y+*(IDX+i+0)) = *(X+i+0);
+    *(Y+*(IDX+i+1)) = *(X+i+1);
+    *(Y+*(IDX+i+2)) = *(X+i+2);
+    *(Y+*(IDX+i+3)) = *(X+i+3);
+  }
+
+  for (i=i;i<N;i++)
+  {
+    *(Y+*(IDX+i)) = *(X+i);
+  }
+}
+
+#if defined (__AVX512F__)
+template <>
+void simd_scatter_copy<double>(const long N, const double* X, double* Y, const long* IDX)
+{
+  long i=0;
+  for (i=0;i+8<=N;i+=8)
+  {
+    const __m512i idx = _mm512_loadu_si512((const void*)(IDX+i));
+    _mm512_i64scatter_pd(Y,idx,_mm512_loadu_pd(X+i),8);
+  }
+
+  //cleanup
+  for (i=i;i<N;i++)
+  {
+    *(Y+*(IDX+i)) = *(X+i);
+  }
+}
+#else
+template void simd_scatter_copy<double>(const long N, const double* X, double* Y, const long* IDX);
+#endif
+template void simd_scatter_copy<float>(const long N, const float* X, float* Y, const long* IDX);
+template void simd_scatter_copy<long>(const long N, const long* X, long* Y, const long* IDX);
+template void simd_scatter_copy<int>(const long N, const int* X, int* Y, const long* IDX);
+
+/*---------------------------------------------------------------------
+ * scatter axpy, Y[IDX[i]] += A*X[i]
+ *   the indices must not repeat
+ *---------------------------------------------------------------------*/
+template <typename T>
+void simd_scatter_axpy(const long N, const T A, const T* X, T* Y, const long* IDX)
+{
+  long i=0;
+  for (i=0;i<(N-4);i+=4)
+  {
+    *(Y+*(IDX+i+0)) += A * *(X+i+0);
+    *(Y+*(IDX+i+1)) += A * *(X+i+1);
+    *(Y+*(IDX+i+2)) += A * *(X+i+2);
+    *(Y+*(IDX+i+3)) += A * *(X+i+3);
+  }
+
+  for (i=i;i<N;i++)
+  {
+    *(Y+*(IDX+i)) += A * *(X+i);
+  }
+}
+template void simd_scatter_axpy<double>(const long N, const double A, const double* X, double* Y, const long* IDX);
+template void simd_scatter_axpy<float>(const long N, const float A, const float* X, float* Y, const long* IDX);
+template void simd_scatter_axpy<long>(const long N, const long A, const long* X, long* Y, const long* IDX);
+template void simd_scatter_axpy<int>(const long N, const int A, const int* X, int* Y, const long* IDX);
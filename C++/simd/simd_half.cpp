@@ -0,0 +1,339 @@
+/* simd_half.cpp
+ * JHT, October 14, 2026 : created
+ *
+ * .cpp file that implements the mixed precision simd routines for
+ * the 16 bit storage types libj::fp16 and libj::bf16 (simd_half.hpp),
+ * with the arithmetic in float or double. Each 16 bit value is
+ * converted as it is loaded, so the memory traffic is a quarter of
+ * that of double.
+ *
+ * If compiled with AVX2 and F16C, eight values at a time are
+ * converted in a YMM register, fp16 with _mm256_cvtph_ps and
+ * _mm256_cvtps_ph, bf16 with 16 bit shifts (and round to nearest
+ * even in integers). With AVX-512 BF16 (and VL), float -> bf16 is
+ * vcvtneps2bf16, and the bf16 dot in float is vdpbf16ps on 32 values
+ * at a time. The rest (and other machines) use the scalar
+ * conversions of simd_half.hpp
+ *
+ */
+
+#include "simd.hpp"
+
+#if defined (__AVX2__) && defined (__F16C__)
+  #define SIMD_HALF_AVX 1
+#endif
+
+#if defined (__AVX512BF16__) && defined (__AVX512VL__)
+  #define SIMD_HALF_AVX512BF16 1
+#endif
+
+using libj::fp16;
+using libj::bf16;
+
+/*---------------------------------------------------------------------
+ * eight values to/from a float register
+ *---------------------------------------------------------------------*/
+#if defined (SIMD_HALF_AVX)
+static inline __m256 half_load8(const fp16* X)
+{
+  return _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*) X));
+}
+
+static inline void half_store8(fp16* Y, const __m256 x)
+{
+  _mm_storeu_si128((__m128i*) Y,_mm256_cvtps_ph(x,_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+}
+
+static inline __m256 half_load8(const bf16* X)
+{
+  const __m256i x = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*) X));
+  return _mm256_castsi256_ps(_mm256_slli_epi32(x,16));
+}
+
+static inline void half_store8(bf16* Y, const __m256 x)
+{
+#if defined (SIMD_HALF_AVX512BF16)
+  _mm_storeu_si128((__m128i*) Y,(__m128i) _mm256_cvtneps_pbh(x));
+#else
+  //x + 0x7FFF + lsb, the top 16 bits, and quiet nans
+  const __m256i xi  = _mm256_castps_si256(x);
+  const __m256i top = _mm256_srli_epi32(xi,16);
+  const __m256i lsb = _mm256_and_si256(top,_mm256_set1_epi32(1));
+  __m256i r = _mm256_add_epi32(xi,_mm256_add_epi32(_mm256_set1_epi32(0x7FFF),lsb));
+  r = _mm256_srli_epi32(r,16);
+  const __m256i nan = _mm256_castps_si256(_mm256_cmp_ps(x,x,_CMP_UNORD_Q));
+  r = _mm256_blendv_epi8(r,_mm256_or_si256(top,_mm256_set1_epi32(0x0040)),nan);
+  r = _mm256_permute4x64_epi64(_mm256_packus_epi32(r,r),0x08);
+  _mm_storeu_si128((__m128i*) Y,_mm256_castsi256_si128(r));
+#endif
+}
+#endif
+
+/*---------------------------------------------------------------------
+ * convert, Y = (TY) X
+ *---------------------------------------------------------------------*/
+template <typename H>
+static inline void half_to_float(const long N, const H* X, float* Y)
+{
+  long i=0;
+#if defined (SIMD_HALF_AVX)
+  for (i=0;i+8<=N;i+=8) _mm256_storeu_ps(Y+i,half_load8(X+i));
+#endif
+  for (i=i;i<N;i++) *(Y+i) = (float) *(X+i);
+}
+
+template <typename H>
+static inline void half_to_double(const long N, const H* X, double* Y)
+{
+  long i=0;
+#if defined (SIMD_HALF_AVX)
+  for (i=0;i+8<=N;i+=8)
+  {
+    const __m256 x = half_load8(X+i);
+    _mm256_storeu_pd(Y+i,_mm256_cvtps_pd(_mm256_castps256_ps128(x)));
+    _mm256_storeu_pd(Y+i+4,_mm256_cvtps_pd(_mm256_extractf128_ps(x,1)));
+  }
+#endif
+  for (i=i;i<N;i++) *(Y+i) = (double) (float) *(X+i);
+}
+
+template <typename H>
+static inline void half_from_float(const long N, const float* X, H* Y)
+{
+  long i=0;
+#if defined (SIMD_HALF_AVX)
+  for (i=0;i+8<=N;i+=8) half_store8(Y+i,_mm256_loadu_ps(X+i));
+#endif
+  for (i=i;i<N;i++) *(Y+i) = H(*(X+i));
+}
+
+template <typename H>
+static inline void half_from_double(const long N, const double* X, H* Y)
+{
+  long i=0;
+#if defined (SIMD_HALF_AVX)
+  for (i=0;i+8<=N;i+=8)
+  {
+    const __m128 x0 = _mm256_cvtpd_ps(_mm256_loadu_pd(X+i));
+    const __m128 x1 = _mm256_cvtpd_ps(_mm256_loadu_pd(X+i+4));
+    half_store8(Y+i,_mm256_insertf128_ps(_mm256_castps128_ps256(x0),x1,1));
+  }
+#endif
+  for (i=i;i<N;i++) *(Y+i) = H(*(X+i));
+}
+
+template <>
+void simd_convert<fp16,float>(const long N, const fp16* X, float* Y) {half_to_float<fp16>(N,X,Y);}
+template <>
+void simd_convert<bf16,float>(const long N, const bf16* X, float* Y) {half_to_float<bf16>(N,X,Y);}
+template <>
+void simd_convert<fp16,double>(const long N, const fp16* X, double* Y) {half_to_double<fp16>(N,X,Y);}
+template <>
+void simd_convert<bf16,double>(const long N, const bf16* X, double* Y) {half_to_double<bf16>(N,X,Y);}
+template <>
+void simd_convert<float,fp16>(const long N, const float* X, fp16* Y) {half_from_float<fp16>(N,X,Y);}
+template <>
+void simd_convert<float,bf16>(const long N, const float* X, bf16* Y) {half_from_float<bf16>(N,X,Y);}
+template <>
+void simd_convert<double,fp16>(const long N, const double* X, fp16* Y) {half_from_double<fp16>(N,X,Y);}
+template <>
+void simd_convert<double,bf16>(const long N, const double* X, bf16* Y) {half_from_double<bf16>(N,X,Y);}
+
+/*---------------------------------------------------------------------
+ * dot, accumulated in float or double
+ *---------------------------------------------------------------------*/
+template <typename H>
+static inline float half_dot_float(const long N, const H* X, const H* Y)
+{
+  long i=0;
+  float dot = 0;
+#if defined (SIMD_HALF_AVX)
+  __m256 a0 = _mm256_setzero_ps();
+  __m256 a1 = _mm256_setzero_ps();
+  for (i=0;i+16<=N;i+=16)
+  {
+    #if defined (__FMA__)
+      a0 = _mm256_fmadd_ps(half_load8(X+i),half_load8(Y+i),a0);
+      a1 = _mm256_fmadd_ps(half_load8(X+i+8),half_load8(Y+i+8),a1);
+    #else
+      a0 = _mm256_add_ps(_mm256_mul_ps(half_load8(X+i),half_load8(Y+i)),a0);
+      a1 = _mm256_add_ps(_mm256_mul_ps(half_load8(X+i+8),half_load8(Y+i+8)),a1);
+    #endif
+  }
+  float part[8];
+  _mm256_storeu_ps(part,_mm256_add_ps(a0,a1));
+  dot = ((part[0] + part[1]) + (part[2] + part[3])) + ((part[4] + part[5]) + (part[6] + part[7]));
+#endif
+  for (i=i;i<N;i++) dot += (float) *(X+i) * (float) *(Y+i);
+  return dot;
+}
+
+template <typename H>
+static inline double half_dot_double(const long N, const H* X, const H* Y)
+{
+  long i=0;
+  double dot = 0;
+#if defined (SIMD_HALF_AVX)
+  __m256d a0 = _mm256_setzero_pd();
+  __m256d a1 = _mm256_setzero_pd();
+  for (i=0;i+8<=N;i+=8)
+  {
+    const __m256 x = half_load8(X+i);
+    const __m256 y = half_load8(Y+i);
+    const __m256d xl = _mm256_cvtps_pd(_mm256_castps256_ps128(x));
+    const __m256d xh = _mm256_cvtps_pd(_mm256_extractf128_ps(x,1));
+    const __m256d yl = _mm256_cvtps_pd(_mm256_castps256_ps128(y));
+    const __m256d yh = _mm256_cvtps_pd(_mm256_extractf128_ps(y,1));
+    #if defined (__FMA__)
+      a0 = _mm256_fmadd_pd(xl,yl,a0);
+      a1 = _mm256_fmadd_pd(xh,yh,a1);
+    #else
+      a0 = _mm256_add_pd(_mm256_mul_pd(xl,yl),a0);
+      a1 = _mm256_add_pd(_mm256_mul_pd(xh,yh),a1);
+    #endif
+  }
+  double part[4];
+  _mm256_storeu_pd(part,_mm256_add_pd(a0,a1));
+  dot = (part[0] + part[1]) + (part[2] + part[3]);
+#endif
+  for (i=i;i<N;i++) dot += (double) (float) *(X+i) * (double) (float) *(Y+i);
+  return dot;
+}
+
+template <>
+float simd_dot_acc<fp16,float>(const long N, const fp16* X, const fp16* Y) {return half_dot_float<fp16>(N,X,Y);}
+template <>
+double simd_dot_acc<fp16,double>(const long N, const fp16* X, const fp16* Y) {return half_dot_double<fp16>(N,X,Y);}
+template <>
+double simd_dot_acc<bf16,double>(const long N, const bf16* X, const bf16* Y) {return half_dot_double<bf16>(N,X,Y);}
+
+#if defined (SIMD_HALF_AVX512BF16)
+template <>
+float simd_dot_acc<bf16,float>(const long N, const bf16* X, const bf16* Y)
+{
+  __m512 a0 = _mm512_setzero_ps();
+  long i=0;
+  for (i=0;i+32<=N;i+=32)
+  {
+    const __m512i x = _mm512_loadu_si512((const void*) (X+i));
+    const __m512i y = _mm512_loadu_si512((const void*) (Y+i));
+    a0 = _mm512_dpbf16_ps(a0,(__m512bh) x,(__m512bh) y);
+  }
+  return _mm512_reduce_add_ps(a0) + half_dot_float<bf16>(N-i,X+i,Y+i);
+}
+#else
+template <>
+float simd_dot_acc<bf16,float>(const long N, const bf16* X, const bf16* Y) {return half_dot_float<bf16>(N,X,Y);}
+#endif
+
+/*---------------------------------------------------------------------
+ * reduction add, accumulated in float or double
+ *---------------------------------------------------------------------*/
+template <typename H>
+static inline float half_sum_float(const long N, const H* X)
+{
+  long i=0;
+  float sum = 0;
+#if defined (SIMD_HALF_AVX)
+  __m256 a0 = _mm256_setzero_ps();
+  __m256 a1 = _mm256_setzero_ps();
+  for (i=0;i+16<=N;i+=16)
+  {
+    a0 = _mm256_add_ps(half_load8(X+i),a0);
+    a1 = _mm256_add_ps(half_load8(X+i+8),a1);
+  }
+  float part[8];
+  _mm256_storeu_ps(part,_mm256_add_ps(a0,a1));
+  sum = ((part[0] + part[1]) + (part[2] + part[3])) + ((part[4] + part[5]) + (part[6] + part[7]));
+#endif
+  for (i=i;i<N;i++) sum += (float) *(X+i);
+  return sum;
+}
+
+template <typename H>
+static inline double half_sum_double(const long N, const H* X)
+{
+  long i=0;
+  double sum = 0;
+#if defined (SIMD_HALF_AVX)
+  __m256d a0 = _mm256_setzero_pd();
+  __m256d a1 = _mm256_setzero_pd();
+  for (i=0;i+8<=N;i+=8)
+  {
+    const __m256 x = half_load8(X+i);
+    a0 = _mm256_add_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(x)),a0);
+    a1 = _mm256_add_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(x,1)),a1);
+  }
+  double part[4];
+  _mm256_storeu_pd(part,_mm256_add_pd(a0,a1));
+  sum = (part[0] + part[1]) + (part[2] + part[3]);
+#endif
+  for (i=i;i<N;i++) sum += (double) (float) *(X+i);
+  return sum;
+}
+
+template <>
+float simd_reduction_add_acc<fp16,float>(const long N, const fp16* X) {return half_sum_float<fp16>(N,X);}
+template <>
+float simd_reduction_add_acc<bf16,float>(const long N, const bf16* X) {return half_sum_float<bf16>(N,X);}
+template <>
+double simd_reduction_add_acc<fp16,double>(const long N, const fp16* X) {return half_sum_double<fp16>(N,X);}
+template <>
+double simd_reduction_add_acc<bf16,double>(const long N, const bf16* X) {return half_sum_double<bf16>(N,X);}
+
+/*---------------------------------------------------------------------
+ * axpy, Y = A*X + Y computed in float (or double) and rounded once
+ *---------------------------------------------------------------------*/
+template <typename H>
+static inline void half_axpy_float(const long N, const float A, const H* X, H* Y)
+{
+  long i=0;
+#if defined (SIMD_HALF_AVX)
+  const __m256 a = _mm256_set1_ps(A);
+  for (i=0;i+8<=N;i+=8)
+  {
+    #if defined (__FMA__)
+      half_store8(Y+i,_mm256_fmadd_ps(a,half_load8(X+i),half_load8(Y+i)));
+    #else
+      half_store8(Y+i,_mm256_add_ps(_mm256_mul_ps(a,half_load8(X+i)),half_load8(Y+i)));
+    #endif
+  }
+#endif
+  for (i=i;i<N;i++) *(Y+i) = H(A * (float) *(X+i) + (float) *(Y+i));
+}
+
+template <typename H>
+static inline void half_axpy_double(const long N, const double A, const H* X, H* Y)
+{
+  long i=0;
+#if defined (SIMD_HALF_AVX)
+  const __m256d a = _mm256_set1_pd(A);
+  for (i=0;i+8<=N;i+=8)
+  {
+    const __m256 x = half_load8(X+i);
+    const __m256 y = half_load8(Y+i);
+    const __m256d xl = _mm256_cvtps_pd(_mm256_castps256_ps128(x));
+    const __m256d xh = _mm256_cvtps_pd(_mm256_extractf128_ps(x,1));
+    const __m256d yl = _mm256_cvtps_pd(_mm256_castps256_ps128(y));
+    const __m256d yh = _mm256_cvtps_pd(_mm256_extractf128_ps(y,1));
+    #if defined (__FMA__)
+      const __m128 rl = _mm256_cvtpd_ps(_mm256_fmadd_pd(a,xl,yl));
+      const __m128 rh = _mm256_cvtpd_ps(_mm256_fmadd_pd(a,xh,yh));
+    #else
+      const __m128 rl = _mm256_cvtpd_ps(_mm256_add_pd(_mm256_mul_pd(a,xl),yl));
+      const __m128 rh = _mm256_cvtpd_ps(_mm256_add_pd(_mm256_mul_pd(a,xh),yh));
+    #endif
+    half_store8(Y+i,_mm256_insertf128_ps(_mm256_castps128_ps256(rl),rh,1));
+  }
+#endif
+  for (i=i;i<N;i++) *(Y+i) = H(A * (double) (float) *(X+i) + (double) (float) *(Y+i));
+}
+
+template <>
+void simd_axpy_acc<fp16,float>(const long N, const float A, const fp16* X, fp16* Y) {half_axpy_float<fp16>(N,A,X,Y);}
+template <>
+void simd_axpy_acc<bf16,float>(const long N, const float A, const bf16* X, bf16* Y) {half_axpy_float<bf16>(N,A,X,Y);}
+template <>
+void simd_axpy_acc<fp16,double>(const long N, const double A, const fp16* X, fp16* Y) {half_axpy_double<fp16>(N,A,X,Y);}
+template <>
+void simd_axpy_acc<bf16,double>(const long N, const double A, const bf16* X, bf16* Y) {half_axpy_double<bf16>(N,A,X,Y);}
@@ -0,0 +1,145 @@
+/*----------------------------------------------------------
+ simd_half.hpp
+    JHT, October 14, 2026 : created
+
+  .hpp file for the 16 bit storage types libj::fp16 (IEEE
+  half, 1+5+10 bits) and libj::bf16 (bfloat16, the top 16
+  bits of a float, 1+8+7 bits). These are for storage only,
+  e.g., libj::tensor<libj::bf16> for large amplitudes or
+  integrals, at a quarter of the memory (and bandwidth) of
+  double. There is no arithmetic on them: a value is a
+  float when read, and is rounded (to nearest, even) when
+  a float or double is written to it
+
+    libj::bf16 x = 1.5;
+    float      y = x;
+
+  fp16 keeps 11 bits of mantissa over |x| in [6.1E-5,65504]
+  (larger values are inf), bf16 keeps 8 bits over the range
+  of float. A double is rounded through float.
+
+  The simd kernels convert while they load, a register at
+  a time, into float (or double) registers, see the mixed
+  precision section of simd.hpp, and simd_half.cpp
+
+    simd_convert<fp16,float>(N,X,Y), and the reverse, for
+    float and double, fp16 and bf16
+    simd_dot_acc<bf16,float>(N,X,Y), and <.,double>
+    simd_reduction_add_acc<fp16,double>(N,X)
+    simd_axpy_acc<bf16,float>(N,A,X,Y)
+
+  which use F16C (_mm256_cvtph_ps, _mm256_cvtps_ph) for fp16,
+  AVX2 integer shifts for bf16, and the AVX-512 BF16
+  instructions (vcvtneps2bf16, vdpbf16ps) when compiled with
+  them. The latter flush float denormals (< 1.2E-38) to zero.
+----------------------------------------------------------*/
+#ifndef SIMD_HALF_HPP
+#define SIMD_HALF_HPP
+
+#include <stdint.h>
+#include <string.h>
+
+namespace libj
+{
+
+/*---------------------------------------------------------
+ * scalar conversions, round to nearest, ties to even
+ * -------------------------------------------------------*/
+inline uint16_t fp16_from_float(const float f)
+{
+  uint32_t x;
+  memcpy(&x,&f,sizeof(x));
+  const uint16_t sign = (uint16_t) ((x >> 16) & 0x8000);
+  const uint32_t a    = x & 0x7FFFFFFF;
+
+  if (a >= 0x7F800000) return sign | 0x7C00 | ((a > 0x7F800000) ? 0x0200 : 0); //inf, nan
+  if (a >= 0x477FF000) return sign | 0x7C00;                                  //rounds to inf
+  if (a < 0x38800000)                                                         //subnormal
+  {
+    if (a < 0x33000000) return sign;
+    const uint32_t m     = (a & 0x007FFFFF) | 0x00800000;
+    const uint32_t shift = 126 - (a >> 23);
+    const uint32_t rem   = m & ((1u << shift) - 1);
+    const uint32_t half  = 1u << (shift - 1);
+    uint32_t r = m >> shift;
+    if (rem > half || (rem == half && (r & 1))) r++;
+    return sign | (uint16_t) r;
+  }
+  uint32_t h = (a - (112u << 23)) >> 13;
+  const uint32_t rem = a & 0x1FFF;
+  if (rem > 0x1000 || (rem == 0x1000 && (h & 1))) h++;
+  return sign | (uint16_t) h;
+}
+
+inline float fp16_to_float(const uint16_t h)
+{
+  const uint32_t sign = (uint32_t) (h & 0x8000) << 16;
+  uint32_t e = (h >> 10) & 0x1F;
+  uint32_t m = h & 0x03FF;
+  uint32_t x;
+  if (e == 0)
+  {
+    if (m == 0)
+    {
+      x = sign;
+    } else {
+      e = 113;
+      while (!(m & 0x0400)) {m <<= 1; e--;}
+      x = sign | (e << 23) | ((m & 0x03FF) << 13);
+    }
+  } else if (e == 31) {
+    x = sign | 0x7F800000 | (m << 13) | (m ? 0x00400000 : 0);                //inf, quiet nan
+  } else {
+    x = sign | ((e + 112) << 23) | (m << 13);
+  }
+  float f;
+  memcpy(&f,&x,sizeof(f));
+  return f;
+}
+
+inline uint16_t bf16_from_float(const float f)
+{
+  uint32_t x;
+  memcpy(&x,&f,sizeof(x));
+  if ((x & 0x7FFFFFFF) > 0x7F800000) return (uint16_t) ((x >> 16) | 0x0040);  //quiet nan
+  return (uint16_t) ((x + 0x7FFF + ((x >> 16) & 1)) >> 16);
+}
+
+inline float bf16_to_float(const uint16_t h)
+{
+  const uint32_t x = (uint32_t) h << 16;
+  float f;
+  memcpy(&f,&x,sizeof(f));
+  return f;
+}
+
+/*---------------------------------------------------------
+ * storage types
+ * -------------------------------------------------------*/
+struct fp16
+{
+  uint16_t bits;
+
+  fp16() = default;
+  fp16(const float x) : bits(fp16_from_float(x)) {}
+  fp16(const double x) : bits(fp16_from_float((float) x)) {}
+  fp16(const int x) : bits(fp16_from_float((float) x)) {}
+  operator float() const {return fp16_to_float(bits);}
+};
+
+struct bf16
+{
+  uint16_t bits;
+
+  bf16() = default;
+  bf16(const float x) : bits(bf16_from_float(x)) {}
+  bf16(const double x) : bits(bf16_from_float((float) x)) {}
+  bf16(const int x) : bits(bf16_from_float((float) x)) {}
+  operator float() const {return bf16_to_float(bits);}
+};
+
+static_assert(sizeof(fp16) == 2 && sizeof(bf16) == 2,"libj::fp16 and libj::bf16 must be 2 BYTES");
+
+}//end of namespace
+
+#endif
@@ -0,0 +1,199 @@
+/* simd_iamax.cpp
+ * JHT, October 14, 2026 : created
+ * JHT, October 14, 2026 : the first NaN is returned
+ *
+ * .cpp file that implements simd identification of the element
+ * with the largest (iamax) or smallest (iamin) absolute value
+ *
+ * This is done in two passes. The first finds the largest
+ * (smallest) absolute value with independent accumulators, which
+ * the compiler vectorizes. The second finds the first element
+ * with that absolute value, which, if compiled with AVX2,
+ * compares a whole register at once.
+ *
+ * Like BLAS i?amax, ties go to the first element, but the
+ * returned location starts at 0. Returns -1 if N < 1
+ *
+ * NaN compares false, so a NaN would stick if it were X[0], and be
+ * skipped anywhere else. The first pass also notes if it saw a NaN,
+ * and then the location of the first NaN is returned, for iamax and
+ * iamin alike
+ *
+ */
+
+#include "simd.hpp"
+#include <stdlib.h>
+#include <math.h>
+
+/*---------------------------------------------------------------------
+ * absolute values
+ *---------------------------------------------------------------------*/
+static inline double simd_iamax_abs(const double a) {return fabs(a);}
+static inline float simd_iamax_abs(const float a) {return fabsf(a);}
+static inline long simd_iamax_abs(const long a) {return labs(a);}
+static inline int simd_iamax_abs(const int a) {return abs(a);}
+
+/*---------------------------------------------------------------------
+ * first NaN, where the first pass saw one
+ *---------------------------------------------------------------------*/
+template <typename T>
+static inline long simd_iamax_find_nan(const long N, const T* X)
+{
+  for (long i=0;i<N;i++)
+  {
+    if (*(X+i) != *(X+i)) {return i;}
+  }
+  return -1;
+}
+
+/*---------------------------------------------------------------------
+ * first location with |X| == M, over whole registers
+ *   returns the location, or -1, in which case i is the number
+ *   of elements searched so far
+ *---------------------------------------------------------------------*/
+template <typename T>
+static inline long simd_iamax_find_vec(const long N, const T M, const T* X, long& i)
+{
+  i = 0;
+  return -1;
+}
+
+#if defined (__AVX2__)
+static inline long simd_iamax_find_vec(const long N, const double M, const double* X, long& i)
+{
+  const __m256d m    = _mm256_set1_pd(M);
+  const __m256d sign = _mm256_set1_pd(-0.0);
+  for (i=0;i+4<=N;i+=4)
+  {
+    const __m256d x = _mm256_andnot_pd(sign,_mm256_loadu_pd(X+i));
+    const int k = _mm256_movemask_pd(_mm256_cmp_pd(x,m,_CMP_EQ_OQ));
+    if (k) {return i + __builtin_ctz(k);}
+  }
+  return -1;
+}
+
+static inline long simd_iamax_find_vec(const long N, const float M, const float* X, long& i)
+{
+  const __m256 m    = _mm256_set1_ps(M);
+  const __m256 sign = _mm256_set1_ps(-0.0f);
+  for (i=0;i+8<=N;i+=8)
+  {
+    const __m256 x = _mm256_andnot_ps(sign,_mm256_loadu_ps(X+i));
+    const int k = _mm256_movemask_ps(_mm256_cmp_ps(x,m,_CMP_EQ_OQ));
+    if (k) {return i + __builtin_ctz(k);}
+  }
+  return -1;
+}
+#endif
+
+template <typename T>
+static inline long simd_iamax_find(const long N, const T M, const T* X)
+{
+  long i=0;
+  const long loc = simd_iamax_find_vec(N,M,X,i);
+  if (loc >= 0) {return loc;}
+
+  for (i=i;i<N;i++)
+  {
+    if (simd_iamax_abs(*(X+i)) == M) {return i;}
+  }
+  return -1;
+}
+
+/*---------------------------------------------------------------------
+ * iamax
+ *---------------------------------------------------------------------*/
+template <typename T>
+long simd_iamax(const long N, const T* X)
+{
+  if (N < 1) {return -1;}
+
+  T m0 = simd_iamax_abs(*X);
+  T m1 = m0;
+  T m2 = m0;
+  T m3 = m0;
+  T a0,a1,a2,a3;
+  bool n0=false,n1=false,n2=false,n3=false;
+  long i=0;
+  for (i=0;i+4<=N;i+=4)
+  {
+    a0 = simd_iamax_abs(*(X+i+0));
+    a1 = simd_iamax_abs(*(X+i+1));
+    a2 = simd_iamax_abs(*(X+i+2));
+    a3 = simd_iamax_abs(*(X+i+3));
+    m0 = (a0 > m0) ? a0 : m0;
+    m1 = (a1 > m1) ? a1 : m1;
+    m2 = (a2 > m2) ? a2 : m2;
+    m3 = (a3 > m3) ? a3 : m3;
+    n0 |= (a0 != a0);
+    n1 |= (a1 != a1);
+    n2 |= (a2 != a2);
+    n3 |= (a3 != a3);
+  }
+
+  for (i=i;i<N;i++)
+  {
+    a0 = simd_iamax_abs(*(X+i));
+    m0 = (a0 > m0) ? a0 : m0;
+    n0 |= (a0 != a0);
+  }
+  if (n0 || n1 || n2 || n3) {return simd_iamax_find_nan<T>(N,X);}
+  m0 = (m1 > m0) ? m1 : m0;
+  m2 = (m3 > m2) ? m3 : m2;
+  m0 = (m2 > m0) ? m2 : m0;
+
+  return simd_iamax_find<T>(N,m0,X);
+}
+template long simd_iamax<double>(const long N, const double* X);
+template long simd_iamax<float>(const long N, const float* X);
+template long simd_iamax<long>(const long N, const long* X);
+template long simd_iamax<int>(const long N, const int* X);
+
+/*---------------------------------------------------------------------
+ * iamin
+ *---------------------------------------------------------------------*/
+template <typename T>
+long simd_iamin(const long N, const T* X)
+{
+  if (N < 1) {return -1;}
+
+  T m0 = simd_iamax_abs(*X);
+  T m1 = m0;
+  T m2 = m0;
+  T m3 = m0;
+  T a0,a1,a2,a3;
+  bool n0=false,n1=false,n2=false,n3=false;
+  long i=0;
+  for (i=0;i+4<=N;i+=4)
+  {
+    a0 = simd_iamax_abs(*(X+i+0));
+    a1 = simd_iamax_abs(*(X+i+1));
+    a2 = simd_iamax_abs(*(X+i+2));
+    a3 = simd_iamax_abs(*(X+i+3));
+    m0 = (a0 < m0) ? a0 : m0;
+    m1 = (a1 < m1) ? a1 : m1;
+    m2 = (a2 < m2) ? a2 : m2;
+    m3 = (a3 < m3) ? a3 : m3;
+    n0 |= (a0 != a0);
+    n1 |= (a1 != a1);
+    n2 |= (a2 != a2);
+    n3 |= (a3 != a3);
+  }
+
+  for (i=i;i<N;i++)
+  {
+    a0 = simd_iamax_abs(*(X+i));
+    m0 = (a0 < m0) ? a0 : m0;
+    n0 |= (a0 != a0);
+  }
+  if (n0 || n1 || n2 || n3) {return simd_iamax_find_nan<T>(N,X);}
+  m0 = (m1 < m0) ? m1 : m0;
+  m2 = (m3 < m2) ? m3 : m2;
+  m0 = (m2 < m0) ? m2 : m0;
+
+  return simd_iamax_find<T>(N,m0,X);
+}
+template long simd_iamin<double>(const long N, const double* X);
+template long simd_iamin<float>(const long N, const float* X);
+template long simd_iamin<long>(const long N, const long* X);
+template long simd_iamin<int>(const long N, const int* X);
@@ -0,0 +1,206 @@
+/*----------------------------------------------------------
+ simd_inline.hpp
+    JHT, October 14, 2026 : created
+
+  Header (inline) versions of the common simd kernels, for
+  short vectors in inner loops, where the call into the
+  compiled simd_opr<T> costs more than the loop. They can
+  be inlined and, with a known N, unrolled, without -flto.
+  The compiled simd_opr<T> (simd.hpp) are still the ones to
+  use for long vectors, as they have the aligned, threaded
+  and hand-coded AVX paths.
+
+  Any T with +,* works (double, float, long, int, complex).
+  As in the .cpp files, the loops are OpenMP SIMD loops
+  when compiled with OpenMP.
+
+  RUN TIME LENGTH
+  ------------------------------
+  simd_inline_dot<T>(N,X,Y)		//returns X.Y
+  simd_inline_reduction_add<T>(N,X)	//returns sum of X
+  simd_inline_axpy<T>(N,A,X,Y)		//Y = Y + A*X
+  simd_inline_axpby<T>(N,A,X,B,Y)	//Y = A*X + B*Y
+  simd_inline_scal_mul<T>(N,A,X)	//X = A*X
+  simd_inline_scal_set<T>(N,A,X)	//X = A
+  simd_inline_copy<T>(N,X,Y)		//Y = X
+  simd_inline_zero<T>(N,X)		//X = 0
+  simd_inline_elemwise_mul<T>(N,X,Y,Z)	//Z = X*Y
+
+  COMPILE TIME LENGTH
+  ------------------------------
+  The same, with N as a template parameter, e.g.,
+  simd_inline_dot<double,3>(X,Y)
+  simd_inline_axpy<double,8>(A,X,Y)
+----------------------------------------------------------*/
+#ifndef SIMD_INLINE_HPP
+#define SIMD_INLINE_HPP
+
+#include <type_traits>
+#include "debug.hpp"
+
+#if defined (_OPENMP)
+  #define SIMD_INLINE_PRAGMA _Pragma("omp simd")
+  #define SIMD_INLINE_PRAGMA_SUM _Pragma("omp simd reduction(+:sum)")
+#else
+  #define SIMD_INLINE_PRAGMA
+  #define SIMD_INLINE_PRAGMA_SUM
+#endif
+
+/*---------------------------------------------------------
+ * run time length
+ * -------------------------------------------------------*/
+//the reductions are OpenMP SIMD reductions for the arithmetic
+//types only, OpenMP has no + reduction of std::complex
+template <typename T>
+inline T simd_inline_dot(const long N, const T* X, const T* Y, std::true_type)
+{
+  T sum = (T) 0;
+  SIMD_INLINE_PRAGMA_SUM
+  for (long i=0;i<N;i++) {sum += X[i]*Y[i];}
+  return sum;
+}
+template <typename T>
+inline T simd_inline_dot(const long N, const T* X, const T* Y, std::false_type)
+{
+  T sum = (T) 0;
+  for (long i=0;i<N;i++) {sum += X[i]*Y[i];}
+  return sum;
+}
+template <typename T>
+inline T simd_inline_dot(const long N, const T* X, const T* Y)
+{
+  return simd_inline_dot<T>(N,X,Y,std::is_arithmetic<T>());
+}
+
+template <typename T>
+inline T simd_inline_reduction_add(const long N, const T* X, std::true_type)
+{
+  T sum = (T) 0;
+  SIMD_INLINE_PRAGMA_SUM
+  for (long i=0;i<N;i++) {sum += X[i];}
+  return sum;
+}
+template <typename T>
+inline T simd_inline_reduction_add(const long N, const T* X, std::false_type)
+{
+  T sum = (T) 0;
+  for (long i=0;i<N;i++) {sum += X[i];}
+  return sum;
+}
+template <typename T>
+inline T simd_inline_reduction_add(const long N, const T* X)
+{
+  return simd_inline_reduction_add<T>(N,X,std::is_arithmetic<T>());
+}
+
+template <typename T>
+inline void simd_inline_axpy(const long N, const T A, const T* X, T* Y)
+{
+  LIBJ_CHECK_INPLACE(X,N,Y,N);
+  SIMD_INLINE_PRAGMA
+  for (long i=0;i<N;i++) {Y[i] += A*X[i];}
+}
+
+template <typename T>
+inline void simd_inline_axpby(const long N, const T A, const T* X, const T B, T* Y)
+{
+  LIBJ_CHECK_INPLACE(X,N,Y,N);
+  SIMD_INLINE_PRAGMA
+  for (long i=0;i<N;i++) {Y[i] = A*X[i] + B*Y[i];}
+}
+
+template <typename T>
+inline void simd_inline_scal_mul(const long N, const T A, T* X)
+{
+  SIMD_INLINE_PRAGMA
+  for (long i=0;i<N;i++) {X[i] *= A;}
+}
+
+template <typename T>
+inline void simd_inline_scal_set(const long N, const T A, T* X)
+{
+  SIMD_INLINE_PRAGMA
+  for (long i=0;i<N;i++) {X[i] = A;}
+}
+
+template <typename T>
+inline void simd_inline_copy(const long N, const T* X, T* Y)
+{
+  SIMD_INLINE_PRAGMA
+  for (long i=0;i<N;i++) {Y[i] = X[i];}
+}
+
+template <typename T>
+inline void simd_inline_zero(const long N, T* X)
+{
+  SIMD_INLINE_PRAGMA
+  for (long i=0;i<N;i++) {X[i] = (T) 0;}
+}
+
+template <typename T>
+inline void simd_inline_elemwise_mul(const long N, const T* X, const T* Y, T* Z)
+{
+  LIBJ_CHECK_INPLACE(X,N,Z,N);
+  LIBJ_CHECK_INPLACE(Y,N,Z,N);
+  SIMD_INLINE_PRAGMA
+  for (long i=0;i<N;i++) {Z[i] = X[i]*Y[i];}
+}
+
+/*---------------------------------------------------------
+ * compile time length
+ * -------------------------------------------------------*/
+template <typename T, const long N>
+inline T simd_inline_dot(const T* X, const T* Y)
+{
+  return simd_inline_dot<T>(N,X,Y);
+}
+
+template <typename T, const long N>
+inline T simd_inline_reduction_add(const T* X)
+{
+  return simd_inline_reduction_add<T>(N,X);
+}
+
+template <typename T, const long N>
+inline void simd_inline_axpy(const T A, const T* X, T* Y)
+{
+  simd_inline_axpy<T>(N,A,X,Y);
+}
+
+template <typename T, const long N>
+inline void simd_inline_axpby(const T A, const T* X, const T B, T* Y)
+{
+  simd_inline_axpby<T>(N,A,X,B,Y);
+}
+
+template <typename T, const long N>
+inline void simd_inline_scal_mul(const T A, T* X)
+{
+  simd_inline_scal_mul<T>(N,A,X);
+}
+
+template <typename T, const long N>
+inline void simd_inline_scal_set(const T A, T* X)
+{
+  simd_inline_scal_set<T>(N,A,X);
+}
+
+template <typename T, const long N>
+inline void simd_inline_copy(const T* X, T* Y)
+{
+  simd_inline_copy<T>(N,X,Y);
+}
+
+template <typename T, const long N>
+inline void simd_inline_zero(T* X)
+{
+  simd_inline_zero<T>(N,X);
+}
+
+template <typename T, const long N>
+inline void simd_inline_elemwise_mul(const T* X, const T* Y, T* Z)
+{
+  simd_inline_elemwise_mul<T>(N,X,Y,Z);
+}
+
+#endif
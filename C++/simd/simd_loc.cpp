@@ -4,23 +4,88 @@
  * .cpp file that implements simd identification of the 
  * first element in an array that matches an input value 
  *
- * If compiled with OpenMP, will use the OpenMP SIMD pragmas to 
- * provide hints to the compiler
+ * If compiled with AVX2, a whole register is compared at once 
+ * (cmp + movemask), and only the matching register is searched
+ * for the lane 
  *
  */
 
 #include "simd.hpp"
+#include "debug.hpp"
+
+/*---------------------------------------------------------------------
+ * vector search, over whole registers only
+ *   returns the location of the first match, or -1, in which case
+ *   i is the number of elements searched so far
+ *---------------------------------------------------------------------*/
+template <typename T>
+static inline long simd_loc_vec(const long N, const T A, const T* X, long& i)
+{
+  i = 0;
+  return -1;
+}
+
+#if defined (__AVX2__)
+static inline long simd_loc_vec(const long N, const double A, const double* X, long& i)
+{
+  const __m256d a = _mm256_set1_pd(A);
+  for (i=0;i+4<=N;i+=4)
+  {
+    const int m = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(X+i),a,_CMP_EQ_OQ));
+    if (m) {return i + __builtin_ctz(m);}
+  }
+  return -1;
+}
+
+static inline long simd_loc_vec(const long N, const float A, const float* X, long& i)
+{
+  const __m256 a = _mm256_set1_ps(A);
+  for (i=0;i+8<=N;i+=8)
+  {
+    const int m = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(X+i),a,_CMP_EQ_OQ));
+    if (m) {return i + __builtin_ctz(m);}
+  }
+  return -1;
+}
+
+static inline long simd_loc_vec(const long N, const long A, const long* X, long& i)
+{
+  const __m256i a = _mm256_set1_epi64x(A);
+  for (i=0;i+4<=N;i+=4)
+  {
+    const __m256i x = _mm256_loadu_si256((const __m256i*)(X+i));
+    const int m = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(x,a)));
+    if (m) {return i + __builtin_ctz(m);}
+  }
+  return -1;
+}
+
+static inline long simd_loc_vec(const long N, const int A, const int* X, long& i)
+{
+  const __m256i a = _mm256_set1_epi32(A);
+  for (i=0;i+8<=N;i+=8)
+  {
+    const __m256i x = _mm256_loadu_si256((const __m256i*)(X+i));
+    const int m = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(x,a)));
+    if (m) {return i + __builtin_ctz(m);}
+  }
+  return -1;
+}
+#endif
 
 /*---------------------------------------------------------------------
  * loc without (known) alignment
- *   - if OpenMP is defined, use the pragmas to request vectorization
- *   - otherwise, use loop unrolling
+ *   - if AVX2 is available, search whole registers first
+ *   - finish with an unrolled loop
  *---------------------------------------------------------------------*/
 template <typename T>
 long simd_loc(const long N, const T A, const T* X)
 {
   long i=0;
-  for (i=0;i<(N-4);i+=4)
+  const long loc = simd_loc_vec(N,A,X,i);
+  if (loc >= 0) {return loc;}
+
+  for (i=i;i<(N-4);i+=4)
   {
     if (*(X+i) == A)   {return i;}
     if (*(X+i+1) == A) {return i+1;}
@@ -34,22 +99,26 @@ long simd_loc(const long N, const T A, const T* X)
   }
   return -1;
 }
+template long simd_loc<double>(const long N, const double A, const double* X);
+template long simd_loc<float>(const long N, const float A, const float* X);
 template long simd_loc<long>(const long N, const long A, const long* X);
 template long simd_loc<int>(const long N, const int A, const int* X);
 
 
 /*---------------------------------------------------------------------
  * loc with known alignment
- *   - if OpenMP is defined, use the pragmas to request vectorization
- *   - otherwise, use loop unrolling
- *
- * Future versions will use specifically vectorized code
+ *   - same as above, unaligned loads are as fast as aligned
+ *     ones on aligned data
  *---------------------------------------------------------------------*/
 template <typename T, const int ALIGNMENT>
 long simd_loc(const long N, const T A, const T* X)
 {
+  LIBJ_CHECK_ALIGNED(X,ALIGNMENT);
   long i=0;
-  for (i=0;i<(N-4);i+=4)
+  const long loc = simd_loc_vec(N,A,X,i);
+  if (loc >= 0) {return loc;}
+
+  for (i=i;i<(N-4);i+=4)
   {
     if (*(X+i) == A)   {return i;}
     if (*(X+i+1) == A) {return i+1;}
@@ -64,6 +133,19 @@ long simd_loc(const long N, const T A, const T* X)
   return -1;
 }
 
+template long simd_loc<double,128>(const long N, const double A, const double* X);
+template long simd_loc<double,64>(const long N, const double A, const double* X);
+template long simd_loc<double,32>(const long N, const double A, const double* X);
+template long simd_loc<double,16>(const long N, const double A, const double* X);
+template long simd_loc<double,8>(const long N, const double A, const double* X);
+
+template long simd_loc<float,128>(const long N, const float A, const float* X);
+template long simd_loc<float,64>(const long N, const float A, const float* X);
+template long simd_loc<float,32>(const long N, const float A, const float* X);
+template long simd_loc<float,16>(const long N, const float A, const float* X);
+template long simd_loc<float,8>(const long N, const float A, const float* X);
+template long simd_loc<float,4>(const long N, const float A, const float* X);
+
 template long simd_loc<long,128>(const long N, const long A, const long* X);
 template long simd_loc<long,64>(const long N, const long A, const long* X);
 template long simd_loc<long,32>(const long N, const long A, const long* X);
@@ -0,0 +1,391 @@
+/*----------------------------------------------------------
+ simd_machine.cpp
+    JHT, October 14, 2026 : created
+
+  .cpp file for libj::MachineProfile, see simd_machine.hpp
+
+  Cache file layout, one "key value" per line
+  ---------------
+  libj_machine_profile  SIMD_MACHINE_VERSION
+  host                  hostname
+  nthreads              OpenMP threads
+  bw_core ... par_min_flops
+----------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "simd.hpp"
+#include "simd_machine.hpp"
+#include "cache_info.hpp"
+
+#define SIMD_MACHINE_VERSION 1
+#define SIMD_MACHINE_DRAM_BYTES (64L*1024*1024)  //least bytes of the DRAM arrays
+#define SIMD_MACHINE_L1_FLOPS 2.0e7               //flops of one L1 sample
+#define SIMD_MACHINE_SAMPLES 3
+#define SIMD_MACHINE_FORKS 1000
+#define SIMD_MACHINE_MIN_N 4096
+#define SIMD_MACHINE_MIN_FLOPS 16384.0
+#define SIMD_MACHINE_NEVER 1.0e15                 //threads never win
+
+namespace libj
+{
+
+//----------------------------------------------------------
+// local
+//----------------------------------------------------------
+static double machine_now()
+{
+  return std::chrono::duration<double>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static int machine_threads()
+{
+  #if defined (_OPENMP)
+  return omp_get_max_threads();
+  #else
+  return 1;
+  #endif
+}
+
+static void machine_host(char* host, const size_t len)
+{
+  if (gethostname(host,len) != 0) {strncpy(host,"unknown",len);}
+  host[len-1] = '\0';
+  for (char* c=host;*c!='\0';c++) {if (*c == ' ' || *c == '\n') *c = '_';}
+}
+
+//range of thread tid out of nthr over n elements
+static void machine_range(const long n, const int tid, const int nthr, long& beg, long& len)
+{
+  const long per = n/nthr, rem = n%nthr;
+  beg = tid*per + ((tid < rem) ? tid : rem);
+  len = per + ((tid < rem) ? 1 : 0);
+}
+
+//----------------------------------------------------------
+// machine_stream
+//	fastest seconds of one pass of kernel (0 copy, 1 axpy)
+//	over n elements of X and Y, on nthr threads
+//----------------------------------------------------------
+static double machine_stream(const int kernel, const long n, double* X, double* Y,
+                             const int nthr)
+{
+  const double a = 1.0e-9;
+  double best = -1.0;
+  #if defined (_OPENMP)
+  #pragma omp parallel num_threads(nthr)
+  #endif
+  {
+    int tid = 0, num = 1;
+    #if defined (_OPENMP)
+    tid = omp_get_thread_num();
+    num = omp_get_num_threads();
+    #endif
+    long beg,len;
+    machine_range(n,tid,num,beg,len);
+    //first touch by the thread that streams it
+    for (long i=beg;i<beg+len;i++) {X[i] = 1.0; Y[i] = 0.0;}
+    for (int s=0;s<=SIMD_MACHINE_SAMPLES;s++)
+    {
+      double t0 = 0.0;
+      #if defined (_OPENMP)
+      #pragma omp barrier
+      #pragma omp master
+      #endif
+      {t0 = machine_now();}
+      if (kernel == 0) {simd_copy<double>(len,X+beg,Y+beg);}
+      else {simd_axpy<double>(len,a,X+beg,Y+beg);}
+      #if defined (_OPENMP)
+      #pragma omp barrier
+      #pragma omp master
+      #endif
+      {
+        const double t = machine_now() - t0;
+        if (s > 0 && (best < 0.0 || t < best)) best = t;
+      }
+    }
+  }
+  return best;
+}
+
+//----------------------------------------------------------
+// machine_l1
+//	flop/s of simd_axpy on arrays in L1, of each thread
+//	summed over nthr threads. The last elements are added
+//	to sink
+//----------------------------------------------------------
+static double machine_l1(const long m, const int nthr, double& sink)
+{
+  const long reps = (long) (SIMD_MACHINE_L1_FLOPS/(2.0*m)) + 1;
+  double best = -1.0;
+  #if defined (_OPENMP)
+  #pragma omp parallel num_threads(nthr)
+  #endif
+  {
+    std::vector<double> X(m,1.0), Y(m,0.0);
+    const double a = 1.0e-9;
+    for (int s=0;s<=SIMD_MACHINE_SAMPLES;s++)
+    {
+      double t0 = 0.0;
+      #if defined (_OPENMP)
+      #pragma omp barrier
+      #pragma omp master
+      #endif
+      {t0 = machine_now();}
+      for (long r=0;r<reps;r++) {simd_axpy<double>(m,a,X.data(),Y.data());}
+      #if defined (_OPENMP)
+      #pragma omp barrier
+      #pragma omp master
+      #endif
+      {
+        const double t = machine_now() - t0;
+        if (s > 0 && (best < 0.0 || t < best)) best = t;
+      }
+    }
+    #if defined (_OPENMP)
+    #pragma omp atomic
+    #endif
+    sink += Y[m-1];
+  }
+  return (best > 0.0) ? nthr*2.0*m*reps/best : 0.0;
+}
+
+//----------------------------------------------------------
+// machine_fork
+//	seconds of a parallel region that does next to nothing
+//----------------------------------------------------------
+static double machine_fork(const int nthr, double& sink)
+{
+  double best = 0.0;
+  #if defined (_OPENMP)
+  if (nthr < 2) return 0.0;
+  best = -1.0;
+  for (int s=0;s<=SIMD_MACHINE_SAMPLES;s++)
+  {
+    const double t0 = machine_now();
+    for (int f=0;f<SIMD_MACHINE_FORKS;f++)
+    {
+      int tids = 0;
+      #pragma omp parallel num_threads(nthr) reduction(+:tids)
+      {tids += omp_get_thread_num();}
+      sink += tids;
+    }
+    const double t = (machine_now() - t0)/SIMD_MACHINE_FORKS;
+    if (s > 0 && (best < 0.0 || t < best)) best = t;
+  }
+  #endif
+  return best;
+}
+
+//----------------------------------------------------------
+// defaults
+//----------------------------------------------------------
+MachineProfile MachineProfile::defaults()
+{
+  MachineProfile mp;
+  mp.bw_core       = 0.0;
+  mp.bw_socket     = 0.0;
+  mp.copy_core     = 0.0;
+  mp.copy_socket   = 0.0;
+  mp.fma_core      = 0.0;
+  mp.fma_socket    = 0.0;
+  mp.fork_s        = 0.0;
+  mp.par_min_n     = 0;
+  mp.par_min_flops = 0.0;
+  mp.nthreads      = machine_threads();
+  mp.source        = "default";
+  machine_host(mp.host,sizeof(mp.host));
+  return mp;
+}
+
+//----------------------------------------------------------
+// measure
+//	the cutoffs are where the threaded time, fork_s plus
+//	the work at the socket rate, is below the one thread
+//	time
+//----------------------------------------------------------
+MachineProfile MachineProfile::measure()
+{
+  MachineProfile mp = defaults();
+  mp.source = "measured";
+  const int nthr = mp.nthreads;
+  const CacheInfo& info = CacheInfo::get();
+
+  long bytes = 4L*(long) (info.L3_bytes > info.L2_bytes ? info.L3_bytes : info.L2_bytes);
+  if (bytes < SIMD_MACHINE_DRAM_BYTES) bytes = SIMD_MACHINE_DRAM_BYTES;
+  const long n = bytes/(2*sizeof(double));
+  {
+    //not touched here, so the threaded passes (first) spread the pages
+    double* X = new double[n];
+    double* Y = new double[n];
+    const double tcp = machine_stream(0,n,X,Y,nthr);
+    const double tap = machine_stream(1,n,X,Y,nthr);
+    const double tc1 = machine_stream(0,n,X,Y,1);
+    const double ta1 = machine_stream(1,n,X,Y,1);
+    delete[] X;
+    delete[] Y;
+    mp.copy_core   = (tc1 > 0.0) ? 16.0*n/tc1 : 0.0;
+    mp.bw_core     = (ta1 > 0.0) ? 24.0*n/ta1 : 0.0;
+    mp.copy_socket = (tcp > 0.0) ? 16.0*n/tcp : 0.0;
+    mp.bw_socket   = (tap > 0.0) ? 24.0*n/tap : 0.0;
+  }
+
+  const long m = (long) (info.L1_bytes/(4*sizeof(double)));
+  double sink = 0.0;
+  mp.fma_core   = machine_l1(m,1,sink);
+  mp.fma_socket = machine_l1(m,nthr,sink);
+  mp.fork_s     = machine_fork(nthr,sink);
+  if (sink < 0.0) mp.fork_s += sink;   //keeps the kernels
+
+  //16 bytes per element of a copy
+  const double dn = 16.0/mp.copy_core - 16.0/mp.copy_socket;
+  double nmin = (mp.copy_core > 0.0 && mp.copy_socket > 0.0 && dn > 0.0) ? mp.fork_s/dn
+                                                                         : SIMD_MACHINE_NEVER;
+  if (nmin < SIMD_MACHINE_MIN_N) nmin = SIMD_MACHINE_MIN_N;
+  if (nmin > SIMD_MACHINE_NEVER) nmin = SIMD_MACHINE_NEVER;
+  mp.par_min_n = (long) nmin;
+
+  const double df = 1.0/mp.fma_core - 1.0/mp.fma_socket;
+  double fmin = (mp.fma_core > 0.0 && mp.fma_socket > 0.0 && df > 0.0) ? mp.fork_s/df
+                                                                       : SIMD_MACHINE_NEVER;
+  if (fmin < SIMD_MACHINE_MIN_FLOPS) fmin = SIMD_MACHINE_MIN_FLOPS;
+  if (fmin > SIMD_MACHINE_NEVER) fmin = SIMD_MACHINE_NEVER;
+  mp.par_min_flops = fmin;
+  return mp;
+}
+
+//----------------------------------------------------------
+// read
+//----------------------------------------------------------
+bool MachineProfile::read(const char* path)
+{
+  FILE* fp = fopen(path,"r");
+  if (fp == NULL) return false;
+  MachineProfile mp = defaults();
+  char key[64], host[64];
+  int version = 0, nread = 0;
+  if (fscanf(fp,"%63s %d",key,&version) != 2 || strcmp(key,"libj_machine_profile") != 0 ||
+      version != SIMD_MACHINE_VERSION || fscanf(fp," host %63s nthreads %d",host,&mp.nthreads) != 2)
+  {
+    fclose(fp);
+    return false;
+  }
+  const char* names[9] = {"bw_core","bw_socket","copy_core","copy_socket","fma_core",
+                          "fma_socket","fork_s","par_min_n","par_min_flops"};
+  double* vals[9] = {&mp.bw_core,&mp.bw_socket,&mp.copy_core,&mp.copy_socket,&mp.fma_core,
+                     &mp.fma_socket,&mp.fork_s,NULL,&mp.par_min_flops};
+  double par_min_n = 0.0;
+  vals[7] = &par_min_n;
+  double val;
+  while (fscanf(fp,"%63s %lf",key,&val) == 2)
+  {
+    for (int k=0;k<9;k++)
+    {
+      if (strcmp(key,names[k]) == 0) {*vals[k] = val; nread++;}
+    }
+  }
+  fclose(fp);
+  if (nread != 9 || strcmp(host,mp.host) != 0 || mp.nthreads != machine_threads()) return false;
+  mp.par_min_n = (long) par_min_n;
+  mp.source = "file";
+  *this = mp;
+  return true;
+}
+
+//----------------------------------------------------------
+// write
+//	to a temporary file that is then renamed, so readers
+//	never see half a file
+//----------------------------------------------------------
+int MachineProfile::write(const char* path) const
+{
+  const std::string tmp = std::string(path) + ".tmp." + std::to_string((long) getpid());
+  FILE* fp = fopen(tmp.c_str(),"w");
+  if (fp == NULL)
+  {
+    printf("ERROR libj::MachineProfile::write could not open %s\n",tmp.c_str());
+    return 1;
+  }
+  fprintf(fp,"libj_machine_profile %d\n",SIMD_MACHINE_VERSION);
+  fprintf(fp,"host %s\n",host);
+  fprintf(fp,"nthreads %d\n",nthreads);
+  fprintf(fp,"bw_core %.6e\n",bw_core);
+  fprintf(fp,"bw_socket %.6e\n",bw_socket);
+  fprintf(fp,"copy_core %.6e\n",copy_core);
+  fprintf(fp,"copy_socket %.6e\n",copy_socket);
+  fprintf(fp,"fma_core %.6e\n",fma_core);
+  fprintf(fp,"fma_socket %.6e\n",fma_socket);
+  fprintf(fp,"fork_s %.6e\n",fork_s);
+  fprintf(fp,"par_min_n %ld\n",par_min_n);
+  fprintf(fp,"par_min_flops %.6e\n",par_min_flops);
+  if (fclose(fp) != 0 || rename(tmp.c_str(),path) != 0)
+  {
+    printf("ERROR libj::MachineProfile::write could not write %s\n",path);
+    remove(tmp.c_str());
+    return 1;
+  }
+  return 0;
+}
+
+//----------------------------------------------------------
+// print
+//----------------------------------------------------------
+void MachineProfile::print(FILE* fp) const
+{
+  fprintf(fp,"libj::MachineProfile (%s) : %s, %d threads\n",source,host,nthreads);
+  fprintf(fp,"  axpy  %8.2f GB/s core %8.2f GB/s socket\n",1.0e-9*bw_core,1.0e-9*bw_socket);
+  fprintf(fp,"  copy  %8.2f GB/s core %8.2f GB/s socket\n",1.0e-9*copy_core,1.0e-9*copy_socket);
+  fprintf(fp,"  L1    %8.2f GFLOP/s core %8.2f GFLOP/s socket\n",1.0e-9*fma_core,1.0e-9*fma_socket);
+  fprintf(fp,"  fork  %8.2f us\n",1.0e6*fork_s);
+  fprintf(fp,"  threads from %ld elements, %.3e flops\n",
+          (par_min_n > 0) ? par_min_n : (long) SIMD_PAR_MIN_N,par_min_flops);
+}
+
+//----------------------------------------------------------
+// machine_load
+//----------------------------------------------------------
+static MachineProfile machine_load()
+{
+  const char* use = getenv("LIBJ_MACHINE_PROFILE");
+  if (use != NULL && atoi(use) == 0) return MachineProfile::defaults();
+  #if defined (_OPENMP)
+  if (omp_in_parallel()) return MachineProfile::defaults();
+  #endif
+
+  std::string path;
+  const char* file = getenv("LIBJ_MACHINE_FILE");
+  const char* home = getenv("HOME");
+  if (file != NULL) {path = file;}
+  else if (home != NULL) {path = std::string(home) + "/.libj_machine_profile";}
+
+  MachineProfile mp = MachineProfile::defaults();
+  if (!path.empty() && mp.read(path.c_str())) return mp;
+  mp = MachineProfile::measure();
+  if (!path.empty()) {mp.write(path.c_str());}
+  return mp;
+}
+
+//----------------------------------------------------------
+// get
+//----------------------------------------------------------
+const MachineProfile& MachineProfile::get()
+{
+  static const MachineProfile mp = machine_load();
+  return mp;
+}
+
+//----------------------------------------------------------
+// simd_par_min_n
+//----------------------------------------------------------
+long simd_par_min_n()
+{
+  const long n = MachineProfile::get().par_min_n;
+  return (n > 0) ? n : (long) SIMD_PAR_MIN_N;
+}
+
+}//end of namespace
@@ -0,0 +1,96 @@
+/*----------------------------------------------------------
+ simd_machine.hpp
+    JHT, October 14, 2026 : created
+
+  .hpp file for libj::MachineProfile, the memory bandwidth
+  and flop rate of this machine, measured once with the
+  library's own simd_copy and simd_axpy (STREAM style) and
+  cached to a file. The threading cutoffs of simd_par_*,
+  linal_par_* and the jblis level-1 routines are set from
+  it, instead of the fixed SIMD_PAR_MIN_N and
+  LINAL_PAR_MIN_FLOPS, which are now the fallback.
+
+  Measured
+  ---------------
+  bw_core, bw_socket      bytes/s of simd_axpy over arrays
+                          well past the last level cache,
+                          one and all OpenMP threads
+  copy_core, copy_socket  the same, for simd_copy
+  fma_core, fma_socket    flop/s of simd_axpy in L1
+  fork_s                  seconds of a near empty OpenMP
+                          parallel region
+
+  "socket" is all OpenMP threads, so the node if they
+  span sockets. The cutoffs are the sizes at which the
+  threaded copy (par_min_n, elements) or flops
+  (par_min_flops) win back the fork_s of the parallel
+  region.
+
+  Cache file
+  ---------------
+  LIBJ_MACHINE_FILE, or $HOME/.libj_machine_profile. The
+  profile is measured again (a second or so) if there is no
+  file, or if it was written on another host or for
+  another number of threads. LIBJ_MACHINE_PROFILE=0 skips
+  all of this and uses the fallbacks.
+
+  The first get() should be outside of any parallel region
+  (the first simd_par_* call usually is), else the
+  fallbacks are used for the run. The first run on a node
+  should be a single task, as MPI tasks measuring at the
+  same time share the bandwidth.
+
+  USAGE
+  ---------------
+  const libj::MachineProfile& mp = libj::MachineProfile::get();
+  mp.bw_socket; mp.par_min_n; mp.source;
+  mp.print();
+  libj::simd_par_min_n();	//cutoff of the simd_par_*
+----------------------------------------------------------*/
+#ifndef SIMD_MACHINE_HPP
+#define SIMD_MACHINE_HPP
+
+#include <stdio.h>
+
+namespace libj
+{
+
+struct MachineProfile
+{
+  double      bw_core;        //bytes/s, simd_axpy, one thread
+  double      bw_socket;      //bytes/s, simd_axpy, all threads
+  double      copy_core;      //bytes/s, simd_copy, one thread
+  double      copy_socket;    //bytes/s, simd_copy, all threads
+  double      fma_core;       //flop/s, simd_axpy in L1, one thread
+  double      fma_socket;     //flop/s, simd_axpy in L1, all threads
+  double      fork_s;         //seconds of a near empty parallel region
+  long        par_min_n;      //elements, 0 to use SIMD_PAR_MIN_N
+  double      par_min_flops;  //flops, 0 to use LINAL_PAR_MIN_FLOPS
+  int         nthreads;       //OpenMP threads it was measured with
+  char        host[64];
+  const char* source;         //"file", "measured", or "default"
+
+  //the profile, read or measured on the first call
+  static const MachineProfile& get();
+
+  //measure this machine now
+  static MachineProfile measure();
+
+  //the fallbacks, with nothing measured
+  static MachineProfile defaults();
+
+  //read path, true if it holds a profile of this host and threads
+  bool read(const char* path);
+
+  //write to path, returns 0 on success
+  int write(const char* path) const;
+
+  void print(FILE* fp = stdout) const;
+};
+
+//the size at which simd_par_* use threads
+long simd_par_min_n();
+
+}//end of namespace
+
+#endif
@@ -0,0 +1,221 @@
+/* simd_mixed.cpp
+ * JHT, October 14, 2026 : created
+ *
+ * .cpp file that implements mixed precision simd routines, where
+ * the data is stored in one type (e.g., float) but the arithmetic
+ * is done in a wider type (e.g., double). This keeps the memory
+ * traffic of the narrow type with the accuracy of the wide one.
+ *
+ * If compiled with AVX2, the float<->double conversions are done
+ * a register at a time with _mm256_cvtps_pd and _mm256_cvtpd_ps
+ *
+ */
+
+#include "simd.hpp"
+
+/*---------------------------------------------------------------------
+ * dot, accumulated in TACC
+ *---------------------------------------------------------------------*/
+template <typename T, typename TACC>
+TACC simd_dot_acc(const long N, const T* X, const T* Y)
+{
+  TACC dot0 = 0;
+  TACC dot1 = 0;
+  TACC dot2 = 0;
+  TACC dot3 = 0;
+  long i=0;
+  for (i=0;i<(N-4);i+=4)
+  {
+    dot0 += (TACC) *(X+i+0) * (TACC) *(Y+i+0);
+    dot1 += (TACC) *(X+i+1) * (TACC) *(Y+i+1);
+    dot2 += (TACC) *(X+i+2) * (TACC) *(Y+i+2);
+    dot3 += (TACC) *(X+i+3) * (TACC) *(Y+i+3);
+  }
+
+  for (i=i;i<N;i++)
+  {
+    dot0 += (TACC) *(X+i) * (TACC) *(Y+i);
+  }
+  return (dot0 + dot1) + (dot2 + dot3);
+}
+
+#if defined (__AVX2__)
+template <>
+double simd_dot_acc<float,double>(const long N, const float* X, const float* Y)
+{
+  __m256d a0 = _mm256_setzero_pd();
+  __m256d a1 = _mm256_setzero_pd();
+  long i=0;
+  for (i=0;i+8<=N;i+=8)
+  {
+    const __m256 x = _mm256_loadu_ps(X+i);
+    const __m256 y = _mm256_loadu_ps(Y+i);
+    const __m256d xl = _mm256_cvtps_pd(_mm256_castps256_ps128(x));
+    const __m256d xh = _mm256_cvtps_pd(_mm256_extractf128_ps(x,1));
+    const __m256d yl = _mm256_cvtps_pd(_mm256_castps256_ps128(y));
+    const __m256d yh = _mm256_cvtps_pd(_mm256_extractf128_ps(y,1));
+    #if defined (__FMA__)
+      a0 = _mm256_fmadd_pd(xl,yl,a0);
+      a1 = _mm256_fmadd_pd(xh,yh,a1);
+    #else
+      a0 = _mm256_add_pd(_mm256_mul_pd(xl,yl),a0);
+      a1 = _mm256_add_pd(_mm256_mul_pd(xh,yh),a1);
+    #endif
+  }
+
+  double part[4];
+  _mm256_storeu_pd(part,_mm256_add_pd(a0,a1));
+  double dot = (part[0] + part[1]) + (part[2] + part[3]);
+
+  //cleanup
+  for (i=i;i<N;i++)
+  {
+    dot += (double) *(X+i) * (double) *(Y+i);
+  }
+  return dot;
+}
+#else
+template double simd_dot_acc<float,double>(const long N, const float* X, const float* Y);
+#endif
+template long simd_dot_acc<int,long>(const long N, const int* X, const int* Y);
+
+/*---------------------------------------------------------------------
+ * reduction add, accumulated in TACC
+ *---------------------------------------------------------------------*/
+template <typename T, typename TACC>
+TACC simd_reduction_add_acc(const long N, const T* X)
+{
+  TACC sum0 = 0;
+  TACC sum1 = 0;
+  TACC sum2 = 0;
+  TACC sum3 = 0;
+  long i=0;
+  for (i=0;i<(N-4);i+=4)
+  {
+    sum0 += (TACC) *(X+i+0);
+    sum1 += (TACC) *(X+i+1);
+    sum2 += (TACC) *(X+i+2);
+    sum3 += (TACC) *(X+i+3);
+  }
+
+  for (i=i;i<N;i++)
+  {
+    sum0 += (TACC) *(X+i);
+  }
+  return (sum0 + sum1) + (sum2 + sum3);
+}
+template double simd_reduction_add_acc<float,double>(const long N, const float* X);
+template long simd_reduction_add_acc<int,long>(const long N, const int* X);
+
+/*---------------------------------------------------------------------
+ * axpy, Y = A*X + Y computed in the type of A and stored as T
+ *---------------------------------------------------------------------*/
+template <typename T, typename TA>
+void simd_axpy_acc(const long N, const TA A, const T* X, T* Y)
+{
+  long i=0;
+  for (i=0;i<(N-4);i+=4)
+  {
+    *(Y+i+0) = (T) (A * (TA) *(X+i+0) + (TA) *(Y+i+0));
+    *(Y+i+1) = (T) (A * (TA) *(X+i+1) + (TA) *(Y+i+1));
+    *(Y+i+2) = (T) (A * (TA) *(X+i+2) + (TA) *(Y+i+2));
+    *(Y+i+3) = (T) (A * (TA) *(X+i+3) + (TA) *(Y+i+3));
+  }
+
+  for (i=i;i<N;i++)
+  {
+    *(Y+i) = (T) (A * (TA) *(X+i) + (TA) *(Y+i));
+  }
+}
+
+#if defined (__AVX2__)
+template <>
+void simd_axpy_acc<float,double>(const long N, const double A, const float* X, float* Y)
+{
+  const __m256d a = _mm256_set1_pd(A);
+  long i=0;
+  for (i=0;i+4<=N;i+=4)
+  {
+    const __m256d x = _mm256_cvtps_pd(_mm_loadu_ps(X+i));
+    const __m256d y = _mm256_cvtps_pd(_mm_loadu_ps(Y+i));
+    #if defined (__FMA__)
+      _mm_storeu_ps(Y+i,_mm256_cvtpd_ps(_mm256_fmadd_pd(a,x,y)));
+    #else
+      _mm_storeu_ps(Y+i,_mm256_cvtpd_ps(_mm256_add_pd(_mm256_mul_pd(a,x),y)));
+    #endif
+  }
+
+  //cleanup
+  for (i=i;i<N;i++)
+  {
+    *(Y+i) = (float) (A * (double) *(X+i) + (double) *(Y+i));
+  }
+}
+#else
+template void simd_axpy_acc<float,double>(const long N, const double A, const float* X, float* Y);
+#endif
+
+/*---------------------------------------------------------------------
+ * convert, Y = (TY) X
+ *---------------------------------------------------------------------*/
+template <typename TX, typename TY>
+void simd_convert(const long N, const TX* X, TY* Y)
+{
+  long i=0;
+  for (i=0;i<(N-4);i+=4)
+  {
+    *(Y+i+0) = (TY) *(X+i+0);
+    *(Y+i+1) = (TY) *(X+i+1);
+    *(Y+i+2) = (TY) *(X+i+2);
+    *(Y+i+3) = (TY) *(X+i+3);
+  }
+
+  for (i=i;i<N;i++)
+  {
+    *(Y+i) = (TY) *(X+i);
+  }
+}
+
+#if defined (__AVX2__)
+template <>
+void simd_convert<double,float>(const long N, const double* X, float* Y)
+{
+  long i=0;
+  for (i=0;i+8<=N;i+=8)
+  {
+    const __m128 y0 = _mm256_cvtpd_ps(_mm256_loadu_pd(X+i));
+    const __m128 y1 = _mm256_cvtpd_ps(_mm256_loadu_pd(X+i+4));
+    _mm_storeu_ps(Y+i,y0);
+    _mm_storeu_ps(Y+i+4,y1);
+  }
+
+  //cleanup
+  for (i=i;i<N;i++)
+  {
+    *(Y+i) = (float) *(X+i);
+  }
+}
+
+template <>
+void simd_convert<float,double>(const long N, const float* X, double* Y)
+{
+  long i=0;
+  for (i=0;i+8<=N;i+=8)
+  {
+    const __m256 x = _mm256_loadu_ps(X+i);
+    _mm256_storeu_pd(Y+i,_mm256_cvtps_pd(_mm256_castps256_ps128(x)));
+    _mm256_storeu_pd(Y+i+4,_mm256_cvtps_pd(_mm256_extractf128_ps(x,1)));
+  }
+
+  //cleanup
+  for (i=i;i<N;i++)
+  {
+    *(Y+i) = (double) *(X+i);
+  }
+}
+#else
+template void simd_convert<double,float>(const long N, const double* X, float* Y);
+template void simd_convert<float,double>(const long N, const float* X, double* Y);
+#endif
+template void simd_convert<int,double>(const long N, const int* X, double* Y);
+template void simd_convert<long,double>(const long N, const long* X, double* Y);
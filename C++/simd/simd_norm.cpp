@@ -0,0 +1,348 @@
+/* simd_norm.cpp
+ * JHT, October 14, 2026 : created
+ * JHT, October 14, 2026 : float sumsq and norm2 sum in double
+ *
+ * .cpp file that implements the simd norms and extrema of one
+ * array: sumsq (sum of squares), norm2 (Euclidean norm), amax
+ * (largest absolute value), max and min
+ *
+ * sumsq, amax, max, and min keep independent accumulators (or
+ * use the OpenMP SIMD reductions), and, if compiled with AVX2,
+ * amax, max, and min of doubles and floats compare whole
+ * registers at once.
+ *
+ * norm2 does not overflow or underflow in the squares. It is
+ * Blue's algorithm, as the LAPACK 3.10 dnrm2 (Anderson, 2017):
+ * each |x| is added to one of three sums of squares, of the
+ * large values scaled down, of the small values scaled up, and
+ * of the rest unscaled, so it is one pass over X, and the three
+ * are put together at the end. The branches are selects, so the
+ * loop still vectorizes
+ *
+ * The float sumsq and norm2 sum the squares in double. A float
+ * sum of 1e6 squares can be off by up to 1e-3, and the square of a
+ * float can neither overflow nor underflow in double, so norm2 of
+ * floats needs no scaling, it is the square root of that sum
+ *
+ */
+
+#include "simd.hpp"
+#include <stdlib.h>
+#include <math.h>
+#include <limits>
+
+/*---------------------------------------------------------------------
+ * absolute values
+ *---------------------------------------------------------------------*/
+static inline double simd_norm_abs(const double a) {return fabs(a);}
+static inline float simd_norm_abs(const float a) {return fabsf(a);}
+static inline long simd_norm_abs(const long a) {return labs(a);}
+static inline int simd_norm_abs(const int a) {return abs(a);}
+
+/*---------------------------------------------------------------------
+ * type the squares are summed in, double for float
+ *---------------------------------------------------------------------*/
+template <typename T> struct simd_norm_acc {typedef T type;};
+template <> struct simd_norm_acc<float> {typedef double type;};
+
+/*---------------------------------------------------------------------
+ * sumsq
+ *---------------------------------------------------------------------*/
+template <typename T>
+static inline typename simd_norm_acc<T>::type simd_norm_sumsq(const long N, const T* X)
+{
+  typedef typename simd_norm_acc<T>::type A;
+  A sum = 0;
+  #if defined (_OPENMP)
+    #pragma omp simd reduction(+:sum)
+    for (long i=0;i<N;i++)
+    {
+      sum += (A) *(X+i) * (A) *(X+i);
+    }
+  #else
+    A sum0 = 0;
+    A sum1 = 0;
+    A sum2 = 0;
+    A sum3 = 0;
+    long i=0;
+    for (i=0;i+4<=N;i+=4)
+    {
+      sum0 += (A) *(X+i+0) * (A) *(X+i+0);
+      sum1 += (A) *(X+i+1) * (A) *(X+i+1);
+      sum2 += (A) *(X+i+2) * (A) *(X+i+2);
+      sum3 += (A) *(X+i+3) * (A) *(X+i+3);
+    }
+
+    for (i=i;i<N;i++)
+    {
+      sum0 += (A) *(X+i) * (A) *(X+i);
+    }
+    sum = (sum0 + sum1) + (sum2 + sum3);
+  #endif
+  return sum;
+}
+
+template <typename T>
+T simd_sumsq(const long N, const T* X)
+{
+  return (T) simd_norm_sumsq<T>(N,X);
+}
+template double simd_sumsq<double>(const long N, const double* X);
+template float simd_sumsq<float>(const long N, const float* X);
+template long simd_sumsq<long>(const long N, const long* X);
+template int simd_sumsq<int>(const long N, const int* X);
+
+/*---------------------------------------------------------------------
+ * extrema of whole registers
+ *   OP 0 is amax, 1 is max, 2 is min. Sets M to the extremum of
+ *   the first i elements, and returns false if nothing was done
+ *---------------------------------------------------------------------*/
+template <int OP, typename T>
+static inline bool simd_norm_ext_vec(const long N, const T* X, T& M, long& i)
+{
+  i = 0;
+  return false;
+}
+
+#if defined (__AVX2__)
+template <int OP>
+static inline bool simd_norm_ext_vec(const long N, const double* X, double& M, long& i)
+{
+  i = 0;
+  if (N < 8) {return false;}
+  const __m256d sign = _mm256_set1_pd(-0.0);
+  __m256d m0 = _mm256_loadu_pd(X);
+  if (OP == 0) {m0 = _mm256_andnot_pd(sign,m0);}
+  __m256d m1 = m0;
+  for (i=0;i+8<=N;i+=8)
+  {
+    __m256d x0 = _mm256_loadu_pd(X+i);
+    __m256d x1 = _mm256_loadu_pd(X+i+4);
+    if (OP == 0) {x0 = _mm256_andnot_pd(sign,x0); x1 = _mm256_andnot_pd(sign,x1);}
+    if (OP == 2) {m0 = _mm256_min_pd(x0,m0); m1 = _mm256_min_pd(x1,m1);}
+    else         {m0 = _mm256_max_pd(x0,m0); m1 = _mm256_max_pd(x1,m1);}
+  }
+  m0 = (OP == 2) ? _mm256_min_pd(m1,m0) : _mm256_max_pd(m1,m0);
+  double v[4];
+  _mm256_storeu_pd(v,m0);
+  M = v[0];
+  for (int k=1;k<4;k++) {M = (OP == 2) ? ((v[k] < M) ? v[k] : M) : ((v[k] > M) ? v[k] : M);}
+  return true;
+}
+
+template <int OP>
+static inline bool simd_norm_ext_vec(const long N, const float* X, float& M, long& i)
+{
+  i = 0;
+  if (N < 16) {return false;}
+  const __m256 sign = _mm256_set1_ps(-0.0f);
+  __m256 m0 = _mm256_loadu_ps(X);
+  if (OP == 0) {m0 = _mm256_andnot_ps(sign,m0);}
+  __m256 m1 = m0;
+  for (i=0;i+16<=N;i+=16)
+  {
+    __m256 x0 = _mm256_loadu_ps(X+i);
+    __m256 x1 = _mm256_loadu_ps(X+i+8);
+    if (OP == 0) {x0 = _mm256_andnot_ps(sign,x0); x1 = _mm256_andnot_ps(sign,x1);}
+    if (OP == 2) {m0 = _mm256_min_ps(x0,m0); m1 = _mm256_min_ps(x1,m1);}
+    else         {m0 = _mm256_max_ps(x0,m0); m1 = _mm256_max_ps(x1,m1);}
+  }
+  m0 = (OP == 2) ? _mm256_min_ps(m1,m0) : _mm256_max_ps(m1,m0);
+  float v[8];
+  _mm256_storeu_ps(v,m0);
+  M = v[0];
+  for (int k=1;k<8;k++) {M = (OP == 2) ? ((v[k] < M) ? v[k] : M) : ((v[k] > M) ? v[k] : M);}
+  return true;
+}
+#endif
+
+/*---------------------------------------------------------------------
+ * extremum, with four independent accumulators after the registers
+ *---------------------------------------------------------------------*/
+template <int OP, typename T>
+static inline T simd_norm_ext(const long N, const T* X)
+{
+  if (N < 1) {return (T) 0;}
+
+  long i=0;
+  T m0 = (OP == 0) ? simd_norm_abs(*X) : *X;
+  simd_norm_ext_vec<OP>(N,X,m0,i);
+  T m1 = m0;
+  T m2 = m0;
+  T m3 = m0;
+  T a0,a1,a2,a3;
+  for (i=i;i+4<=N;i+=4)
+  {
+    a0 = (OP == 0) ? simd_norm_abs(*(X+i+0)) : *(X+i+0);
+    a1 = (OP == 0) ? simd_norm_abs(*(X+i+1)) : *(X+i+1);
+    a2 = (OP == 0) ? simd_norm_abs(*(X+i+2)) : *(X+i+2);
+    a3 = (OP == 0) ? simd_norm_abs(*(X+i+3)) : *(X+i+3);
+    if (OP == 2)
+    {
+      m0 = (a0 < m0) ? a0 : m0;
+      m1 = (a1 < m1) ? a1 : m1;
+      m2 = (a2 < m2) ? a2 : m2;
+      m3 = (a3 < m3) ? a3 : m3;
+    }
+    else
+    {
+      m0 = (a0 > m0) ? a0 : m0;
+      m1 = (a1 > m1) ? a1 : m1;
+      m2 = (a2 > m2) ? a2 : m2;
+      m3 = (a3 > m3) ? a3 : m3;
+    }
+  }
+
+  for (i=i;i<N;i++)
+  {
+    a0 = (OP == 0) ? simd_norm_abs(*(X+i)) : *(X+i);
+    m0 = (OP == 2) ? ((a0 < m0) ? a0 : m0) : ((a0 > m0) ? a0 : m0);
+  }
+  if (OP == 2)
+  {
+    m0 = (m1 < m0) ? m1 : m0;
+    m2 = (m3 < m2) ? m3 : m2;
+    m0 = (m2 < m0) ? m2 : m0;
+  }
+  else
+  {
+    m0 = (m1 > m0) ? m1 : m0;
+    m2 = (m3 > m2) ? m3 : m2;
+    m0 = (m2 > m0) ? m2 : m0;
+  }
+  return m0;
+}
+
+/*---------------------------------------------------------------------
+ * amax, max, min
+ *---------------------------------------------------------------------*/
+template <typename T>
+T simd_amax(const long N, const T* X)
+{
+  return simd_norm_ext<0,T>(N,X);
+}
+template double simd_amax<double>(const long N, const double* X);
+template float simd_amax<float>(const long N, const float* X);
+template long simd_amax<long>(const long N, const long* X);
+template int simd_amax<int>(const long N, const int* X);
+
+template <typename T>
+T simd_max(const long N, const T* X)
+{
+  return simd_norm_ext<1,T>(N,X);
+}
+template double simd_max<double>(const long N, const double* X);
+template float simd_max<float>(const long N, const float* X);
+template long simd_max<long>(const long N, const long* X);
+template int simd_max<int>(const long N, const int* X);
+
+template <typename T>
+T simd_min(const long N, const T* X)
+{
+  return simd_norm_ext<2,T>(N,X);
+}
+template double simd_min<double>(const long N, const double* X);
+template float simd_min<float>(const long N, const float* X);
+template long simd_min<long>(const long N, const long* X);
+template int simd_min<int>(const long N, const int* X);
+
+/*---------------------------------------------------------------------
+ * adds |x| = AX to the sum of its class
+ *---------------------------------------------------------------------*/
+template <typename T>
+static inline void simd_norm2_add(const T AX, const T tsml, const T tbig, 
+                                  const T ssml, const T sbig, T& asml, T& amed, 
+                                  T& abig)
+{
+  const bool big = AX > tbig;
+  const bool sml = AX < tsml;
+  const T xb = big ? AX*sbig : (T) 0;
+  const T xs = sml ? AX*ssml : (T) 0;
+  const T xm = (big || sml) ? (T) 0 : AX;
+  abig += xb*xb;
+  asml += xs*xs;
+  amed += xm*xm;
+}
+
+/*---------------------------------------------------------------------
+ * norm2
+ *   tsml, tbig : |x| below (above) these are small (big)
+ *   ssml, sbig : scales of the small and big values, so their
+ *                squares neither underflow nor overflow
+ *---------------------------------------------------------------------*/
+template <typename T>
+T simd_norm2(const long N, const T* X)
+{
+  typedef std::numeric_limits<T> lim;
+  const T tsml = ldexp((T) 1,(int) ceil((lim::min_exponent - 1)*0.5));
+  const T tbig = ldexp((T) 1,(int) floor((lim::max_exponent - lim::digits + 1)*0.5));
+  const T ssml = ldexp((T) 1,-(int) floor((lim::min_exponent - lim::digits)*0.5));
+  const T sbig = ldexp((T) 1,-(int) ceil((lim::max_exponent + lim::digits - 1)*0.5));
+
+  T asml = 0;
+  T amed = 0;
+  T abig = 0;
+  #if defined (_OPENMP)
+    #pragma omp simd reduction(+:asml,amed,abig)
+    for (long i=0;i<N;i++)
+    {
+      simd_norm2_add(simd_norm_abs(*(X+i)),tsml,tbig,ssml,sbig,asml,amed,abig);
+    }
+  #else
+    //four independent lanes of each sum
+    T sml[4] = {0,0,0,0};
+    T med[4] = {0,0,0,0};
+    T big[4] = {0,0,0,0};
+    long i=0;
+    for (i=0;i+4<=N;i+=4)
+    {
+      for (int l=0;l<4;l++)
+      {
+        simd_norm2_add(simd_norm_abs(*(X+i+l)),tsml,tbig,ssml,sbig,sml[l],med[l],big[l]);
+      }
+    }
+    for (i=i;i<N;i++)
+    {
+      simd_norm2_add(simd_norm_abs(*(X+i)),tsml,tbig,ssml,sbig,sml[0],med[0],big[0]);
+    }
+    asml = (sml[0] + sml[1]) + (sml[2] + sml[3]);
+    amed = (med[0] + med[1]) + (med[2] + med[3]);
+    abig = (big[0] + big[1]) + (big[2] + big[3]);
+  #endif
+
+  //put the sums together
+  T scl = 1;
+  T sumsq = amed;
+  if (abig > 0)
+  {
+    if (amed > 0 || amed != amed) {abig += (amed*sbig)*sbig;}
+    scl = 1/sbig;
+    sumsq = abig;
+  }
+  else if (asml > 0)
+  {
+    if (amed > 0 || amed != amed)
+    {
+      const T ymed = sqrt(amed);
+      const T ysml = sqrt(asml)/ssml;
+      const T ymin = (ysml > ymed) ? ymed : ysml;
+      const T ymax = (ysml > ymed) ? ysml : ymed;
+      const T r = ymin/ymax;
+      sumsq = ymax*ymax*(1 + r*r);
+    }
+    else
+    {
+      scl = 1/ssml;
+      sumsq = asml;
+    }
+  }
+  return scl*sqrt(sumsq);
+}
+template double simd_norm2<double>(const long N, const double* X);
+
+//the squares of floats are in the range of double, so no scaling
+template <>
+float simd_norm2<float>(const long N, const float* X)
+{
+  return (float) sqrt(simd_norm_sumsq<float>(N,X));
+}
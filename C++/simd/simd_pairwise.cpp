@@ -0,0 +1,108 @@
+/* simd_pairwise.cpp
+ * JHT, October 14, 2026 : created
+ *
+ * .cpp file that implements pairwise summed reductions and dot
+ * products over continuous sections of data
+ *
+ * The data is halved recursively until a section is at most
+ * SIMD_PAIRWISE_BLOCK elements long. Each section is summed with
+ * eight independent accumulators (which the compiler keeps in
+ * vector registers), and these are merged with a pairwise tree.
+ *
+ * The rounding error grows like log(N) rather than N, and the
+ * order of the additions depends only on N, so the result is
+ * reproducible from run to run
+ *
+ */
+
+#include "simd.hpp"
+
+/*---------------------------------------------------------------------
+ * sum of a short section with eight accumulators
+ *---------------------------------------------------------------------*/
+template <typename T>
+static inline T simd_pairwise_block_add(const long N, const T* X)
+{
+  T a0=0,a1=0,a2=0,a3=0,a4=0,a5=0,a6=0,a7=0;
+  long i=0;
+  for (i=0;i+8<=N;i+=8)
+  {
+    a0 += *(X+i+0);
+    a1 += *(X+i+1);
+    a2 += *(X+i+2);
+    a3 += *(X+i+3);
+    a4 += *(X+i+4);
+    a5 += *(X+i+5);
+    a6 += *(X+i+6);
+    a7 += *(X+i+7);
+  }
+
+  for (i=i;i<N;i++)
+  {
+    a0 += *(X+i);
+  }
+  return ((a0 + a1) + (a2 + a3)) + ((a4 + a5) + (a6 + a7));
+}
+
+/*---------------------------------------------------------------------
+ * dot of a short section with eight accumulators
+ *---------------------------------------------------------------------*/
+template <typename T>
+static inline T simd_pairwise_block_dot(const long N, const T* X, const T* Y)
+{
+  T a0=0,a1=0,a2=0,a3=0,a4=0,a5=0,a6=0,a7=0;
+  long i=0;
+  for (i=0;i+8<=N;i+=8)
+  {
+    a0 += *(X+i+0) * *(Y+i+0);
+    a1 += *(X+i+1) * *(Y+i+1);
+    a2 += *(X+i+2) * *(Y+i+2);
+    a3 += *(X+i+3) * *(Y+i+3);
+    a4 += *(X+i+4) * *(Y+i+4);
+    a5 += *(X+i+5) * *(Y+i+5);
+    a6 += *(X+i+6) * *(Y+i+6);
+    a7 += *(X+i+7) * *(Y+i+7);
+  }
+
+  for (i=i;i<N;i++)
+  {
+    a0 += *(X+i) * *(Y+i);
+  }
+  return ((a0 + a1) + (a2 + a3)) + ((a4 + a5) + (a6 + a7));
+}
+
+/*---------------------------------------------------------------------
+ * pairwise reduction add
+ *   the split point is kept on a multiple of 8 elements, so the
+ *   sections stay aligned if X is
+ *---------------------------------------------------------------------*/
+template <typename T>
+T simd_reduction_add_pairwise(const long N, const T* X)
+{
+  if (N <= SIMD_PAIRWISE_BLOCK) return simd_pairwise_block_add<T>(N,X);
+
+  const long H = ((N/2) + 7) & ~7L;
+  return simd_reduction_add_pairwise<T>(H,X)
+       + simd_reduction_add_pairwise<T>(N-H,X+H);
+}
+template double simd_reduction_add_pairwise<double>(const long N, const double* X);
+template float simd_reduction_add_pairwise<float>(const long N, const float* X);
+template long simd_reduction_add_pairwise<long>(const long N, const long* X);
+template int simd_reduction_add_pairwise<int>(const long N, const int* X);
+
+/*---------------------------------------------------------------------
+ * pairwise dot
+ *---------------------------------------------------------------------*/
+template <typename T>
+T simd_dot_pairwise(const long N, const T* X, const T* Y)
+{
+  if (N <= SIMD_PAIRWISE_BLOCK) return simd_pairwise_block_dot<T>(N,X,Y);
+
+  const long H = ((N/2) + 7) & ~7L;
+  return simd_dot_pairwise<T>(H,X,Y)
+       + simd_dot_pairwise<T>(N-H,X+H,Y+H);
+}
+template double simd_dot_pairwise<double>(const long N, const double* X, const double* Y);
+template float simd_dot_pairwise<float>(const long N, const float* X, const float* Y);
+template long simd_dot_pairwise<long>(const long N, const long* X, const long* Y);
+template int simd_dot_pairwise<int>(const long N, const int* X, const int* Y);
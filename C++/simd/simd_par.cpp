@@ -0,0 +1,433 @@
+/* simd_par.cpp
+ * JHT, October 14, 2026 : created
+ * JHT, October 14, 2026 : norms and extrema
+ *
+ * .cpp file that implements OpenMP threaded versions of the
+ * level-1 simd routines, for long vectors that are limited by
+ * memory bandwidth rather than by one core
+ *
+ * N is split into one contiguous chunk per thread. The chunk
+ * boundaries are placed on multiples of SIMD_PAR_LINE_BYTES
+ * (from the start of the data), so that threads do not write to
+ * the same cache line. Each thread calls the peeling simd_auto_*
+ * routine (simd_auto.cpp) on its chunk, so arrays that do not start
+ * on a vector boundary still get the aligned kernels.
+ *
+ * Reductions keep one partial result per thread, which are added
+ * in thread order, so the result only depends on N and the number
+ * of threads. The norms and extrema of the chunks (simd_norm.cpp)
+ * are put together from the chunks that are not empty
+ *
+ * If N < libj::simd_par_min_n() (measured for this machine, see
+ * simd_machine.hpp, else SIMD_PAR_MIN_N), or if compiled without 
+ * OpenMP, these just call the simd_auto_* routine
+ *
+ */
+
+#include "simd.hpp"
+#include <vector>
+#include <cmath>
+#include <limits>
+
+/*---------------------------------------------------------------------
+ * range of thread TID out of NTHR, in whole cache lines
+ *---------------------------------------------------------------------*/
+template <typename T>
+static inline void simd_par_range(const long N, const int TID, const int NTHR,
+                                  long& START, long& LEN)
+{
+  const long LINE   = (SIMD_PAR_LINE_BYTES >= (long) sizeof(T))
+                    ? SIMD_PAR_LINE_BYTES/sizeof(T) : 1;
+  const long NLINES = (N + LINE - 1)/LINE;
+  const long PER    = NLINES/NTHR;
+  const long REM    = NLINES%NTHR;
+  const long L0     = TID*PER + ((TID < REM) ? TID : REM);
+  const long NL     = PER + ((TID < REM) ? 1 : 0);
+  long end = (L0+NL)*LINE;
+  START = L0*LINE;
+  if (end > N) end = N;
+  LEN = (end > START) ? end - START : 0;
+}
+
+/*---------------------------------------------------------------------
+ * dot
+ *---------------------------------------------------------------------*/
+template <typename T>
+T simd_par_dot(const long N, const T* X, const T* Y)
+{
+  #if defined (_OPENMP)
+  if (omp_get_max_threads() > 1 && !omp_in_parallel() && N >= libj::simd_par_min_n())
+  {
+    std::vector<T> part(omp_get_max_threads(),(T) 0);
+    int nthr = 1;
+    #pragma omp parallel
+    {
+      const int tid = omp_get_thread_num();
+      long start,len;
+      #pragma omp single
+      nthr = omp_get_num_threads();
+      simd_par_range<T>(N,tid,nthr,start,len);
+      part[tid] = simd_auto_dot<T>(len,X+start,Y+start);
+    }
+    T dot = (T) 0;
+    for (int t=0;t<nthr;t++) dot += part[t];
+    return dot;
+  }
+  #endif
+  return simd_auto_dot<T>(N,X,Y);
+}
+template double simd_par_dot<double>(const long N, const double* X, const double* Y);
+template float simd_par_dot<float>(const long N, const float* X, const float* Y);
+template long simd_par_dot<long>(const long N, const long* X, const long* Y);
+template int simd_par_dot<int>(const long N, const int* X, const int* Y);
+
+/*---------------------------------------------------------------------
+ * reduction add
+ *---------------------------------------------------------------------*/
+template <typename T>
+T simd_par_reduction_add(const long N, const T* X)
+{
+  #if defined (_OPENMP)
+  if (omp_get_max_threads() > 1 && !omp_in_parallel() && N >= libj::simd_par_min_n())
+  {
+    std::vector<T> part(omp_get_max_threads(),(T) 0);
+    int nthr = 1;
+    #pragma omp parallel
+    {
+      const int tid = omp_get_thread_num();
+      long start,len;
+      #pragma omp single
+      nthr = omp_get_num_threads();
+      simd_par_range<T>(N,tid,nthr,start,len);
+      part[tid] = simd_auto_reduction_add<T>(len,X+start);
+    }
+    T sum = (T) 0;
+    for (int t=0;t<nthr;t++) sum += part[t];
+    return sum;
+  }
+  #endif
+  return simd_auto_reduction_add<T>(N,X);
+}
+template double simd_par_reduction_add<double>(const long N, const double* X);
+template float simd_par_reduction_add<float>(const long N, const float* X);
+template long simd_par_reduction_add<long>(const long N, const long* X);
+template int simd_par_reduction_add<int>(const long N, const int* X);
+
+/*---------------------------------------------------------------------
+ * axpy
+ *---------------------------------------------------------------------*/
+template <typename T>
+void simd_par_axpy(const long N, const T A, const T* X, T* Y)
+{
+  #if defined (_OPENMP)
+  if (omp_get_max_threads() > 1 && !omp_in_parallel() && N >= libj::simd_par_min_n())
+  {
+    #pragma omp parallel
+    {
+      long start,len;
+      simd_par_range<T>(N,omp_get_thread_num(),omp_get_num_threads(),start,len);
+      simd_auto_axpy<T>(len,A,X+start,Y+start);
+    }
+    return;
+  }
+  #endif
+  simd_auto_axpy<T>(N,A,X,Y);
+}
+template void simd_par_axpy<double>(const long N, const double A, const double* X, double* Y);
+template void simd_par_axpy<float>(const long N, const float A, const float* X, float* Y);
+template void simd_par_axpy<long>(const long N, const long A, const long* X, long* Y);
+template void simd_par_axpy<int>(const long N, const int A, const int* X, int* Y);
+
+/*---------------------------------------------------------------------
+ * axpby
+ *---------------------------------------------------------------------*/
+template <typename T>
+void simd_par_axpby(const long N, const T A, const T* X, const T B, T* Y)
+{
+  #if defined (_OPENMP)
+  if (omp_get_max_threads() > 1 && !omp_in_parallel() && N >= libj::simd_par_min_n())
+  {
+    #pragma omp parallel
+    {
+      long start,len;
+      simd_par_range<T>(N,omp_get_thread_num(),omp_get_num_threads(),start,len);
+      simd_auto_axpby<T>(len,A,X+start,B,Y+start);
+    }
+    return;
+  }
+  #endif
+  simd_auto_axpby<T>(N,A,X,B,Y);
+}
+template void simd_par_axpby<double>(const long N, const double A, const double* X, const double B, double* Y);
+template void simd_par_axpby<float>(const long N, const float A, const float* X, const float B, float* Y);
+template void simd_par_axpby<long>(const long N, const long A, const long* X, const long B, long* Y);
+template void simd_par_axpby<int>(const long N, const int A, const int* X, const int B, int* Y);
+
+/*---------------------------------------------------------------------
+ * copy
+ *---------------------------------------------------------------------*/
+template <typename T>
+void simd_par_copy(const long N, const T* X, T* Y)
+{
+  #if defined (_OPENMP)
+  if (omp_get_max_threads() > 1 && !omp_in_parallel() && N >= libj::simd_par_min_n())
+  {
+    #pragma omp parallel
+    {
+      long start,len;
+      simd_par_range<T>(N,omp_get_thread_num(),omp_get_num_threads(),start,len);
+      simd_auto_copy<T>(len,X+start,Y+start);
+    }
+    return;
+  }
+  #endif
+  simd_auto_copy<T>(N,X,Y);
+}
+template void simd_par_copy<double>(const long N, const double* X, double* Y);
+template void simd_par_copy<float>(const long N, const float* X, float* Y);
+template void simd_par_copy<long>(const long N, const long* X, long* Y);
+template void simd_par_copy<int>(const long N, const int* X, int* Y);
+
+/*---------------------------------------------------------------------
+ * zero
+ *---------------------------------------------------------------------*/
+template <typename T>
+void simd_par_zero(const long N, T* X)
+{
+  #if defined (_OPENMP)
+  if (omp_get_max_threads() > 1 && !omp_in_parallel() && N >= libj::simd_par_min_n())
+  {
+    #pragma omp parallel
+    {
+      long start,len;
+      simd_par_range<T>(N,omp_get_thread_num(),omp_get_num_threads(),start,len);
+      simd_auto_zero<T>(len,X+start);
+    }
+    return;
+  }
+  #endif
+  simd_auto_zero<T>(N,X);
+}
+template void simd_par_zero<double>(const long N, double* X);
+template void simd_par_zero<float>(const long N, float* X);
+template void simd_par_zero<long>(const long N, long* X);
+template void simd_par_zero<int>(const long N, int* X);
+
+/*---------------------------------------------------------------------
+ * scal_mul
+ *---------------------------------------------------------------------*/
+template <typename T>
+void simd_par_scal_mul(const long N, const T A, T* X)
+{
+  #if defined (_OPENMP)
+  if (omp_get_max_threads() > 1 && !omp_in_parallel() && N >= libj::simd_par_min_n())
+  {
+    #pragma omp parallel
+    {
+      long start,len;
+      simd_par_range<T>(N,omp_get_thread_num(),omp_get_num_threads(),start,len);
+      simd_auto_scal_mul<T>(len,A,X+start);
+    }
+    return;
+  }
+  #endif
+  simd_auto_scal_mul<T>(N,A,X);
+}
+template void simd_par_scal_mul<double>(const long N, const double A, double* X);
+template void simd_par_scal_mul<float>(const long N, const float A, float* X);
+template void simd_par_scal_mul<long>(const long N, const long A, long* X);
+template void simd_par_scal_mul<int>(const long N, const int A, int* X);
+
+/*---------------------------------------------------------------------
+ * scal_set
+ *---------------------------------------------------------------------*/
+template <typename T>
+void simd_par_scal_set(const long N, const T A, T* X)
+{
+  #if defined (_OPENMP)
+  if (omp_get_max_threads() > 1 && !omp_in_parallel() && N >= libj::simd_par_min_n())
+  {
+    #pragma omp parallel
+    {
+      long start,len;
+      simd_par_range<T>(N,omp_get_thread_num(),omp_get_num_threads(),start,len);
+      simd_auto_scal_set<T>(len,A,X+start);
+    }
+    return;
+  }
+  #endif
+  simd_auto_scal_set<T>(N,A,X);
+}
+template void simd_par_scal_set<double>(const long N, const double A, double* X);
+template void simd_par_scal_set<float>(const long N, const float A, float* X);
+template void simd_par_scal_set<long>(const long N, const long A, long* X);
+template void simd_par_scal_set<int>(const long N, const int A, int* X);
+
+/*---------------------------------------------------------------------
+ * one F of each chunk, in thread order, returns the number of chunks
+ * that are not empty, or 0 if not threaded
+ *---------------------------------------------------------------------*/
+template <typename T>
+static inline int simd_par_parts(const long N, const T* X, T (*F)(const long, const T*),
+                                 std::vector<T>& part)
+{
+  #if defined (_OPENMP)
+  if (omp_get_max_threads() > 1 && !omp_in_parallel() && N >= libj::simd_par_min_n())
+  {
+    part.assign(omp_get_max_threads(),(T) 0);
+    std::vector<long> lens(omp_get_max_threads(),0);
+    int nthr = 1;
+    #pragma omp parallel
+    {
+      const int tid = omp_get_thread_num();
+      long start,len;
+      #pragma omp single
+      nthr = omp_get_num_threads();
+      simd_par_range<T>(N,tid,nthr,start,len);
+      lens[tid] = len;
+      if (len > 0) part[tid] = F(len,X+start);
+    }
+    int num = 0;
+    for (int t=0;t<nthr;t++)
+    {
+      if (lens[t] > 0) part[num++] = part[t];
+    }
+    return num;
+  }
+  #endif
+  return 0;
+}
+
+/*---------------------------------------------------------------------
+ * sumsq
+ *---------------------------------------------------------------------*/
+template <typename T>
+T simd_par_sumsq(const long N, const T* X)
+{
+  std::vector<T> part;
+  const int num = simd_par_parts<T>(N,X,simd_sumsq<T>,part);
+  if (num == 0) return simd_sumsq<T>(N,X);
+  T sum = (T) 0;
+  for (int t=0;t<num;t++) sum += part[t];
+  return sum;
+}
+template double simd_par_sumsq<double>(const long N, const double* X);
+template float simd_par_sumsq<float>(const long N, const float* X);
+template long simd_par_sumsq<long>(const long N, const long* X);
+template int simd_par_sumsq<int>(const long N, const int* X);
+
+/*---------------------------------------------------------------------
+ * norm2
+ *   the norms of the chunks, scaled by the largest
+ *---------------------------------------------------------------------*/
+template <typename T>
+T simd_par_norm2(const long N, const T* X)
+{
+  std::vector<T> part;
+  const int num = simd_par_parts<T>(N,X,simd_norm2<T>,part);
+  if (num == 0) return simd_norm2<T>(N,X);
+  T scl = (T) 0;
+  for (int t=0;t<num;t++) 
+  {
+    if (part[t] != part[t]) return part[t];
+    scl = (part[t] > scl) ? part[t] : scl;
+  }
+  if (scl == (T) 0 || scl > std::numeric_limits<T>::max()) return scl;
+  T sum = (T) 0;
+  for (int t=0;t<num;t++) sum += (part[t]/scl)*(part[t]/scl);
+  return scl*std::sqrt(sum);
+}
+template double simd_par_norm2<double>(const long N, const double* X);
+template float simd_par_norm2<float>(const long N, const float* X);
+
+/*---------------------------------------------------------------------
+ * amax, max, min
+ *---------------------------------------------------------------------*/
+template <typename T>
+T simd_par_amax(const long N, const T* X)
+{
+  std::vector<T> part;
+  const int num = simd_par_parts<T>(N,X,simd_amax<T>,part);
+  if (num == 0) return simd_amax<T>(N,X);
+  T m = part[0];
+  for (int t=1;t<num;t++) m = (part[t] > m) ? part[t] : m;
+  return m;
+}
+template double simd_par_amax<double>(const long N, const double* X);
+template float simd_par_amax<float>(const long N, const float* X);
+template long simd_par_amax<long>(const long N, const long* X);
+template int simd_par_amax<int>(const long N, const int* X);
+
+template <typename T>
+T simd_par_max(const long N, const T* X)
+{
+  std::vector<T> part;
+  const int num = simd_par_parts<T>(N,X,simd_max<T>,part);
+  if (num == 0) return simd_max<T>(N,X);
+  T m = part[0];
+  for (int t=1;t<num;t++) m = (part[t] > m) ? part[t] : m;
+  return m;
+}
+template double simd_par_max<double>(const long N, const double* X);
+template float simd_par_max<float>(const long N, const float* X);
+template long simd_par_max<long>(const long N, const long* X);
+template int simd_par_max<int>(const long N, const int* X);
+
+template <typename T>
+T simd_par_min(const long N, const T* X)
+{
+  std::vector<T> part;
+  const int num = simd_par_parts<T>(N,X,simd_min<T>,part);
+  if (num == 0) return simd_min<T>(N,X);
+  T m = part[0];
+  for (int t=1;t<num;t++) m = (part[t] < m) ? part[t] : m;
+  return m;
+}
+template double simd_par_min<double>(const long N, const double* X);
+template float simd_par_min<float>(const long N, const float* X);
+template long simd_par_min<long>(const long N, const long* X);
+template int simd_par_min<int>(const long N, const int* X);
+
+/*---------------------------------------------------------------------
+ * compress
+ *   each thread counts its chunk, the counts are summed in thread
+ *   order into the offsets of the chunks in IDX and VAL, and each
+ *   thread then compresses its chunk at its offset
+ *---------------------------------------------------------------------*/
+template <typename T>
+long simd_par_compress(const long N, const T* X, const T tol, long* IDX, T* VAL)
+{
+  #if defined (_OPENMP)
+  if (omp_get_max_threads() > 1 && !omp_in_parallel() && N >= libj::simd_par_min_n())
+  {
+    std::vector<long> off(omp_get_max_threads()+1,0);
+    int nthr = 1;
+    #pragma omp parallel
+    {
+      const int tid = omp_get_thread_num();
+      long start,len;
+      #pragma omp single
+      nthr = omp_get_num_threads();
+      simd_par_range<T>(N,tid,nthr,start,len);
+      if (len > 0) off[tid+1] = simd_count_above<T>(len,X+start,tol);
+      #pragma omp barrier
+      #pragma omp single
+      {
+        for (int t=0;t<nthr;t++) off[t+1] += off[t];
+      }
+      if (len > 0)
+      {
+        long* ii = IDX + off[tid];
+        const long c = simd_compress<T>(len,X+start,tol,ii,VAL+off[tid]);
+        for (long k=0;k<c;k++) ii[k] += start;
+      }
+    }
+    return off[nthr];
+  }
+  #endif
+  return simd_compress<T>(N,X,tol,IDX,VAL);
+}
+template long simd_par_compress<double>(const long N, const double* X, const double tol, long* IDX, double* VAL);
+template long simd_par_compress<float>(const long N, const float* X, const float tol, long* IDX, float* VAL);
+template long simd_par_compress<long>(const long N, const long* X, const long tol, long* IDX, long* VAL);
+template long simd_par_compress<int>(const long N, const int* X, const int tol, long* IDX, int* VAL);
@@ -14,10 +14,16 @@ pe* Y)
  *  A      -> scalar to multiply w*x by 
  *  X*     -> Address of first element of X to act on
  *  Y*     -> Address of first element of Y to act on
+ *
+ * Hand-coded AVX2/AVX-512 routines are used for doubles and floats
+ * claimed to be aligned to 32 or 64 BYTE boundaries
+ *
  * -------------------------------------------------------*/
 
 
 #include "simd.hpp"
+#include "debug.hpp"
+#include "simd_avx.hpp"
 
 /*---------------------------------------------------------------------
  * raxmy without (known) alignment
@@ -26,6 +32,7 @@ pe* Y)
 template <typename T>
 void simd_raxmy(const long N, const T A, const T* X, T* Y)
 {
+  LIBJ_CHECK_INPLACE(X,N,Y,N);
   const T ONE = (T) 1;
   #if defined (_OPENMP)
     T TMP;
@@ -73,6 +80,9 @@ template void simd_raxmy<int>(const long N, const int A, const int* X, int* Y);
 template <typename T, const int ALIGNMENT>
 void simd_raxmy(const long N, const T A, const T* X, T* Y)
 {
+  LIBJ_CHECK_ALIGNED(X,ALIGNMENT);
+  LIBJ_CHECK_ALIGNED(Y,ALIGNMENT);
+  LIBJ_CHECK_INPLACE(X,N,Y,N);
   const T ONE = (T) 1;
   #if defined (_OPENMP)
     T TMP;
@@ -108,13 +118,17 @@ void simd_raxmy(const long N, const T A, const T* X, T* Y)
   #endif
 }
 
+#if !defined (__AVX2__) //special instructions below
 template void simd_raxmy<double,64>(const long N, const double A, const double* X, double* Y);
 template void simd_raxmy<double,32>(const long N, const double A, const double* X, double* Y);
+#endif
 template void simd_raxmy<double,16>(const long N, const double A, const double* X, double* Y);
 template void simd_raxmy<double,8>(const long N, const double A, const double* X, double* Y);
 
+#if !defined (__AVX2__) //special instructions below
 template void simd_raxmy<float,64>(const long N, const float A, const float* X, float* Y);
 template void simd_raxmy<float,32>(const long N, const float A, const float* X, float* Y);
+#endif
 template void simd_raxmy<float,16>(const long N, const float A, const float* X, float* Y);
 template void simd_raxmy<float,8>(const long N, const float A, const float* X, float* Y);
 template void simd_raxmy<float,4>(const long N, const float A, const float* X, float* Y);
@@ -129,3 +143,59 @@ template void simd_raxmy<int,32>(const long N, const int A, const int* X, int* Y
 template void simd_raxmy<int,16>(const long N, const int A, const int* X, int* Y);
 template void simd_raxmy<int,8>(const long N, const int A, const int* X, int* Y);
 template void simd_raxmy<int,4>(const long N, const int A, const int* X, int* Y);
+
+//------------------------------------------------------------------------------
+//  Hand-coded routines for doubles and floats claimed to be aligned to
+//  32 or 64 BYTE boundaries. 64 BYTE claims use AVX-512 if available,
+//  128 BYTE claims use the 64 BYTE code
+#if defined (__AVX2__)
+template <typename T, const int BYTES>
+static inline void simd_raxmy_avx(const long N, const T A, const T* X, T* Y)
+{
+  typedef simd_vec<T,BYTES> S;
+  const long NW = S::W;
+  const typename S::V a   = S::set1(A);
+  const typename S::V one = S::set1((T) 1);
+  long i=0;
+
+  for (i=0;i+2*NW<=N;i+=2*NW)
+  {
+    S::store(Y+i,S::mul(S::load(Y+i),S::mul(a,S::div(one,S::load(X+i)))));
+    S::store(Y+i+NW,S::mul(S::load(Y+i+NW),S::mul(a,S::div(one,S::load(X+i+NW)))));
+  }
+  for (i=i;i+NW<=N;i+=NW)
+  {
+    S::store(Y+i,S::mul(S::load(Y+i),S::mul(a,S::div(one,S::load(X+i)))));
+  }
+
+  //cleanup
+  for (i=i;i<N;i++)
+  {
+    *(Y+i) *= A * ((T) 1 / *(X+i));
+  }
+}
+
+template<>
+void simd_raxmy<double,32>(const long N, const double A, const double* X, double* Y)
+{
+  simd_raxmy_avx<double,32>(N,A,X,Y);
+}
+
+template<>
+void simd_raxmy<double,64>(const long N, const double A, const double* X, double* Y)
+{
+  simd_raxmy_avx<double,SIMD_AVX_WIDE>(N,A,X,Y);
+}
+
+template<>
+void simd_raxmy<float,32>(const long N, const float A, const float* X, float* Y)
+{
+  simd_raxmy_avx<float,32>(N,A,X,Y);
+}
+
+template<>
+void simd_raxmy<float,64>(const long N, const float A, const float* X, float* Y)
+{
+  simd_raxmy_avx<float,SIMD_AVX_WIDE>(N,A,X,Y);
+}
+#endif
@@ -9,15 +9,25 @@
  * are available in the case of an Xay of doubles claimed to 
  * be aligned to 32 or 64 BYTE boundaries 
  *
+ * With SIMD_DISPATCH (see simd_dispatch.hpp) doubles and floats go
+ * through the runtime dispatched kernels instead
+ *
  */
 
 #include "simd.hpp"
+#include "debug.hpp"
+#include "simd_avx.hpp"
+#include "simd_dispatch_kernel.hpp"
 
 //------------------------------------------------------
 //For unaligned templates
 template <typename T>
 T simd_reduction_add(const long N, const T* X)
 {
+  #if defined (SIMD_DISPATCH)
+    T r;
+    if (simd_dispatch_reduction_add_hook(N,X,r)) return r;
+  #endif
 
   //OpenMP Code
   #if defined (_OPENMP)
@@ -72,6 +82,11 @@ template int simd_reduction_add<int>(const long N, const int* X);
 template <typename T, const int ALIGNMENT>
 T simd_reduction_add(const long N, const T* X)
 {
+  LIBJ_CHECK_ALIGNED(X,ALIGNMENT);
+  #if defined (SIMD_DISPATCH)
+    T r;
+    if (simd_dispatch_reduction_add_hook(N,X,r)) return r;
+  #endif
 
   #if defined (_OPENMP)
     T sum=0;
@@ -114,7 +129,7 @@ T simd_reduction_add(const long N, const T* X)
 //template defintion for aligned simd 
 template double simd_reduction_add<double,8>(const long N, const double* X);
 template double simd_reduction_add<double,16>(const long N, const double* X);
-#if !defined (__AVX2__) //Special instructions below
+#if !defined (__AVX2__) //special instructions below
 template double simd_reduction_add<double,32>(const long N, const double* X);
 template double simd_reduction_add<double,64>(const long N, const double* X);
 template double simd_reduction_add<double,128>(const long N, const double* X);
@@ -123,9 +138,11 @@ template double simd_reduction_add<double,128>(const long N, const double* X);
 template float simd_reduction_add<float,4>(const long N, const float* X);
 template float simd_reduction_add<float,8>(const long N, const float* X);
 template float simd_reduction_add<float,16>(const long N, const float* X);
+#if !defined (__AVX2__) //special instructions below
 template float simd_reduction_add<float,32>(const long N, const float* X);
 template float simd_reduction_add<float,64>(const long N, const float* X);
 template float simd_reduction_add<float,128>(const long N, const float* X);
+#endif
 
 template long simd_reduction_add<long,8>(const long N, const long* X);
 template long simd_reduction_add<long,16>(const long N, const long* X);
@@ -141,64 +158,77 @@ template int simd_reduction_add<int,64>(const long N, const int* X);
 template int simd_reduction_add<int,128>(const long N, const int* X);
 
 //------------------------------------------------------------------------------
-//  Hand-coded routines for claimed 32 BYTE boundaries on double Xays
+//  Hand-coded routines for doubles and floats claimed to be aligned to
+//  32 or 64 BYTE boundaries. 64 BYTE claims use AVX-512 if available,
+//  128 BYTE claims use the 64 BYTE code
 #if defined (__AVX2__)
-#include <stdio.h>
-template<>
-double simd_reduction_add<double,32>(const long N, const double* X)
+template <typename T, const int BYTES>
+static inline T simd_reduction_add_avx(const long N, const T* X)
 {
-  //using horizonal add
-  double local_sum[4];
-  local_sum[0] = (double) 0;
-  local_sum[1] = (double) 0;
-  local_sum[2] = (double) 0;
-  local_sum[3] = (double) 0;
+  #if defined (SIMD_DISPATCH)
+    T r;
+    if (simd_dispatch_reduction_add_hook(N,X,r)) return r;
+  #endif
 
+  typedef simd_vec<T,BYTES> S;
+  const long NW = S::W;
+  typename S::V a0 = S::zero();
+  typename S::V a1 = S::zero();
   long i=0;
 
-  if (N >= 8) //code below only valid if N is >=8
+  //two independent accumulators to hide the add latency
+  for (i=0;i+2*NW<=N;i+=2*NW)
   {
-    const double* p0 = X;
-    const double* p1 = X+4;
-    //first iteration
-    __m256d v0 = _mm256_load_pd(p0);
-    __m256d v1 = _mm256_load_pd(p1);    
-    __m256d a  = _mm256_hadd_pd(v0,v1); //accumulator
-    p0+=8;
-    p1+=8;
-
-    //SIMD loops
-    for (i=8;i<(N-8);i+=8)
-    {
-      v0  = _mm256_load_pd(p0);
-      v1  = _mm256_load_pd(p1);
-      a  += _mm256_hadd_pd(v0,v1);
-      p0+=8;
-      p1+=8;
-    }
-
-    _mm256_storeu_pd(&local_sum[0],a);
+    a0 = S::add(S::load(X+i),a0);
+    a1 = S::add(S::load(X+i+NW),a1);
+  }
+  for (i=i;i+NW<=N;i+=NW)
+  {
+    a0 = S::add(S::load(X+i),a0);
   }
+  T sum = S::hsum(S::add(a0,a1));
 
   //cleanup
   for (i=i;i<N;i++)
   {
-    local_sum[0] += *(X+i);
+    sum += *(X+i);
   }
+  return sum;
+}
 
-  return (local_sum[0] + local_sum[1] + local_sum[2] + local_sum[3]);
+template<>
+double simd_reduction_add<double,32>(const long N, const double* X)
+{
+  return simd_reduction_add_avx<double,32>(N,X);
 }
-//------------------------------------------------------------------------------
-//  Hand-coded routines for claimed 64 BYTE boundaries on double Xays
-//  Same as code for 32 byte boundaries, for now
+
 template<>
 double simd_reduction_add<double,64>(const long N, const double* X)
 {
-  return simd_reduction_add<double,32>(N,X);
+  return simd_reduction_add_avx<double,SIMD_AVX_WIDE>(N,X);
 }
+
 template<>
 double simd_reduction_add<double,128>(const long N, const double* X)
 {
-  return simd_reduction_add<double,32>(N,X);
+  return simd_reduction_add<double,64>(N,X);
+}
+
+template<>
+float simd_reduction_add<float,32>(const long N, const float* X)
+{
+  return simd_reduction_add_avx<float,32>(N,X);
+}
+
+template<>
+float simd_reduction_add<float,64>(const long N, const float* X)
+{
+  return simd_reduction_add_avx<float,SIMD_AVX_WIDE>(N,X);
+}
+
+template<>
+float simd_reduction_add<float,128>(const long N, const float* X)
+{
+  return simd_reduction_add<float,64>(N,X);
 }
 #endif
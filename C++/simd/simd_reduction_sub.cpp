@@ -13,6 +13,8 @@
 
 
 #include "simd.hpp"
+#include "debug.hpp"
+#include "simd_avx.hpp"
 
 //For unaligned templates
 template <typename T>
@@ -62,6 +64,7 @@ T simd_reduction_sub(const long N, const T* X)
 template <typename T, const int ALIGNMENT>
 T simd_reduction_sub(const long N, const T* X)
 {
+  LIBJ_CHECK_ALIGNED(X,ALIGNMENT);
   #if defined (_OPENMP)
     T sum=0;
     #pragma omp simd aligned(X:ALIGNMENT) reduction(-:sum) 
@@ -109,83 +112,101 @@ template int simd_reduction_sub<int>(const long N, const int* X);
 //template defintion for aligned simd 
 template double simd_reduction_sub<double,8>(const long N, const double* X);
 template double simd_reduction_sub<double,16>(const long N, const double* X);
-#if !defined (__AVX2__)
+#if !defined (__AVX2__) //special instructions below
 template double simd_reduction_sub<double,32>(const long N, const double* X);
+template double simd_reduction_sub<double,128>(const long N, const double* X);
 template double simd_reduction_sub<double,64>(const long N, const double* X);
 #endif
 
 template float simd_reduction_sub<float,4>(const long N, const float* X);
 template float simd_reduction_sub<float,8>(const long N, const float* X);
 template float simd_reduction_sub<float,16>(const long N, const float* X);
+#if !defined (__AVX2__) //special instructions below
 template float simd_reduction_sub<float,32>(const long N, const float* X);
+template float simd_reduction_sub<float,128>(const long N, const float* X);
 template float simd_reduction_sub<float,64>(const long N, const float* X);
+#endif
 
 template long simd_reduction_sub<long,8>(const long N, const long* X);
 template long simd_reduction_sub<long,16>(const long N, const long* X);
 template long simd_reduction_sub<long,32>(const long N, const long* X);
+template long simd_reduction_sub<long,128>(const long N, const long* X);
 template long simd_reduction_sub<long,64>(const long N, const long* X);
 
 template int simd_reduction_sub<int,4>(const long N, const int* X);
 template int simd_reduction_sub<int,8>(const long N, const int* X);
 template int simd_reduction_sub<int,16>(const long N, const int* X);
 template int simd_reduction_sub<int,32>(const long N, const int* X);
+template int simd_reduction_sub<int,128>(const long N, const int* X);
 template int simd_reduction_sub<int,64>(const long N, const int* X);
 
 //------------------------------------------------------------------------------
-//  Hand-coded routines for claimed 32 BYTE boundaries on double Xays
+//  Hand-coded routines for doubles and floats claimed to be aligned to
+//  32 or 64 BYTE boundaries. 64 BYTE claims use AVX-512 if available,
+//  128 BYTE claims use the 64 BYTE code
 #if defined (__AVX2__)
-#include <stdio.h>
-template<>
-double simd_reduction_sub<double,32>(const long N, const double* X)
+template <typename T, const int BYTES>
+static inline T simd_reduction_sub_avx(const long N, const T* X)
 {
-  //using horizonal add
-  double local_sub[4];
-  local_sub[0] = (double) 0;
-  local_sub[1] = (double) 0;
-  local_sub[2] = (double) 0;
-  local_sub[3] = (double) 0;
-
+  typedef simd_vec<T,BYTES> S;
+  const long NW = S::W;
+  typename S::V a0 = S::zero();
+  typename S::V a1 = S::zero();
   long i=0;
 
-  if (N >= 8) //code below only valid if N is >=8
+  //two independent accumulators to hide the add latency
+  for (i=0;i+2*NW<=N;i+=2*NW)
   {
-    const double* p0 = X;
-    const double* p1 = X+4;
-    //first iteration
-    __m256d v0 = _mm256_load_pd(p0);
-    __m256d v1 = _mm256_load_pd(p1);
-    __m256d a  = _mm256_hadd_pd(v0,v1); //accumulator
-    p0+=8;
-    p1+=8;
-
-    //SIMD loops
-    for (i=8;i<(N-8);i+=8)
-    {
-      v0  = _mm256_load_pd(p0);
-      v1  = _mm256_load_pd(p1);
-      a  += _mm256_hadd_pd(v0,v1);
-      p0+=8;
-      p1+=8;
-    }
-
-    _mm256_storeu_pd(&local_sub[0],a);
+    a0 = S::add(S::load(X+i),a0);
+    a1 = S::add(S::load(X+i+NW),a1);
+  }
+  for (i=i;i+NW<=N;i+=NW)
+  {
+    a0 = S::add(S::load(X+i),a0);
   }
+  T sum = S::hsum(S::add(a0,a1));
 
   //cleanup
   for (i=i;i<N;i++)
   {
-    local_sub[0] += *(X+i);
+    sum += *(X+i);
   }
+  return (T)(-1)*sum;
+}
 
-  return (double)(-1)*(local_sub[0] + local_sub[1] + local_sub[2] + local_sub[3]);
+template<>
+double simd_reduction_sub<double,32>(const long N, const double* X)
+{
+  return simd_reduction_sub_avx<double,32>(N,X);
 }
-//------------------------------------------------------------------------------
-//  Hand-coded routines for claimed 64 BYTE boundaries on double Xays
-//  Same as code for 32 byte boundaries, for now
+
 template<>
 double simd_reduction_sub<double,64>(const long N, const double* X)
 {
-  return simd_reduction_sub<double,32>(N,X);
+  return simd_reduction_sub_avx<double,SIMD_AVX_WIDE>(N,X);
 }
-#endif
 
+template<>
+double simd_reduction_sub<double,128>(const long N, const double* X)
+{
+  return simd_reduction_sub<double,64>(N,X);
+}
+
+template<>
+float simd_reduction_sub<float,32>(const long N, const float* X)
+{
+  return simd_reduction_sub_avx<float,32>(N,X);
+}
+
+template<>
+float simd_reduction_sub<float,64>(const long N, const float* X)
+{
+  return simd_reduction_sub_avx<float,SIMD_AVX_WIDE>(N,X);
+}
+
+template<>
+float simd_reduction_sub<float,128>(const long N, const float* X)
+{
+  return simd_reduction_sub<float,64>(N,X);
+}
+#endif
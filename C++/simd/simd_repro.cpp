@@ -0,0 +1,270 @@
+/* simd_repro.cpp
+ * JHT, October 14, 2026 : created
+ *
+ * .cpp file that implements the reproducible sums and dots, whose
+ * result is the same to the bit for any number of threads or MPI
+ * tasks, and any alignment of the data (see simd_repro.hpp)
+ *
+ * Two passes over the data: the largest |x| (or |x*y|), which is the
+ * same in any order, then the folds with the SIGMA of that and of N.
+ * The folds are summed exactly, so the eight lanes, the tail, and the
+ * threads all add into them in any order. float is done in double,
+ * where x*y is exact.
+ *
+ * The threaded versions split N in SIMD_REPRO_BLOCK element blocks,
+ * handed out by an OpenMP static schedule, so most of the speed of
+ * simd_par_dot is kept, at about twice its flops per element and a
+ * second pass over the data
+ *
+ */
+
+#include "simd.hpp"
+#include "simd_repro.hpp"
+#include <math.h>
+#include <vector>
+#include <algorithm>
+
+#define SIMD_REPRO_BLOCK 8192
+
+/*---------------------------------------------------------------------
+ * x, or x*y (exact for float), of element i
+ *---------------------------------------------------------------------*/
+template <typename T, bool DOT>
+static inline double simd_repro_x(const T* X, const T* Y, const long i)
+{
+  return DOT ? (double) X[i] * (double) Y[i] : (double) X[i];
+}
+
+/*---------------------------------------------------------------------
+ * largest |x|, or |x*y|, of a section, with eight lanes
+ *---------------------------------------------------------------------*/
+template <typename T, bool DOT>
+static double simd_repro_amax_blk(const long N, const T* X, const T* Y)
+{
+  double m[8] = {0,0,0,0,0,0,0,0};
+  long i=0;
+  for (i=0;i+8<=N;i+=8)
+  {
+    for (int j=0;j<8;j++)
+    {
+      const double a = fabs(simd_repro_x<T,DOT>(X,Y,i+j));
+      m[j] = (a > m[j]) ? a : m[j];
+    }
+  }
+  for (i=i;i<N;i++)
+  {
+    const double a = fabs(simd_repro_x<T,DOT>(X,Y,i));
+    m[0] = (a > m[0]) ? a : m[0];
+  }
+  return std::max(std::max(std::max(m[0],m[1]),std::max(m[2],m[3])),
+                  std::max(std::max(m[4],m[5]),std::max(m[6],m[7])));
+}
+
+/*---------------------------------------------------------------------
+ * x (or x*y) of a section into the folds S, with eight lanes
+ *---------------------------------------------------------------------*/
+template <typename T, bool DOT>
+static void simd_repro_fold_blk(const long N, const T* X, const T* Y, const double* SIGMA, double* S)
+{
+  double acc[SIMD_REPRO_FOLDS][8];
+  for (int k=0;k<SIMD_REPRO_FOLDS;k++) {for (int j=0;j<8;j++) acc[k][j] = 0;}
+  long i=0;
+  for (i=0;i+8<=N;i+=8)
+  {
+    double x[8];
+    for (int j=0;j<8;j++) x[j] = simd_repro_x<T,DOT>(X,Y,i+j);
+    for (int k=0;k<SIMD_REPRO_FOLDS;k++)
+    {
+      const double sig = SIGMA[k];
+      for (int j=0;j<8;j++)
+      {
+        const double q = (sig + x[j]) - sig;
+        acc[k][j] += q;
+        x[j] -= q;
+      }
+    }
+  }
+  double tail[SIMD_REPRO_FOLDS];
+  for (int k=0;k<SIMD_REPRO_FOLDS;k++) tail[k] = 0;
+  for (i=i;i<N;i++)
+  {
+    libj::simd_repro_deposit(simd_repro_x<T,DOT>(X,Y,i),SIGMA,tail);
+  }
+  for (int k=0;k<SIMD_REPRO_FOLDS;k++)
+  {
+    double sum = tail[k];
+    for (int j=0;j<8;j++) sum += acc[k][j];
+    S[k] += sum;
+  }
+}
+
+//the plain sum that falls back when there are no folds
+template <typename T, bool DOT>
+static double simd_repro_plain(const long N, const T* X, const T* Y)
+{
+  double sum = 0;
+  for (long i=0;i<N;i++) sum += simd_repro_x<T,DOT>(X,Y,i);
+  return sum;
+}
+
+//the sum (Y is NULL) or the dot
+template <typename T>
+static inline double simd_repro_amax_sec(const long N, const T* X, const T* Y)
+{
+  return (Y == NULL) ? simd_repro_amax_blk<T,false>(N,X,Y) : simd_repro_amax_blk<T,true>(N,X,Y);
+}
+
+template <typename T>
+static inline void simd_repro_fold_sec(const long N, const T* X, const T* Y, const double* SIGMA, double* S)
+{
+  if (Y == NULL) {simd_repro_fold_blk<T,false>(N,X,Y,SIGMA,S);}
+  else {simd_repro_fold_blk<T,true>(N,X,Y,SIGMA,S);}
+}
+
+/*---------------------------------------------------------------------
+ * the serial and threaded drivers
+ *---------------------------------------------------------------------*/
+template <typename T>
+static double simd_repro_amax_drv(const bool PAR, const long N, const T* X, const T* Y)
+{
+  #if defined (_OPENMP)
+  if (PAR && omp_get_max_threads() > 1 && !omp_in_parallel() && N >= libj::simd_par_min_n())
+  {
+    const long nblk = (N + SIMD_REPRO_BLOCK - 1)/SIMD_REPRO_BLOCK;
+    double amax = 0;
+    #pragma omp parallel for schedule(static) reduction(max:amax)
+    for (long b=0;b<nblk;b++)
+    {
+      const long start = b*SIMD_REPRO_BLOCK;
+      const long len   = std::min((long) SIMD_REPRO_BLOCK,N-start);
+      amax = std::max(amax,simd_repro_amax_sec<T>(len,X+start,(Y == NULL) ? NULL : Y+start));
+    }
+    return amax;
+  }
+  #endif
+  return simd_repro_amax_sec<T>(N,X,Y);
+}
+
+template <typename T>
+static void simd_repro_fold_drv(const bool PAR, const long N, const T* X, const T* Y,
+                                const double AMAX, const long NTOT, double* S)
+{
+  double SIGMA[SIMD_REPRO_FOLDS];
+  if (!libj::simd_repro_sigma(AMAX,NTOT,SIGMA))
+  {
+    if (AMAX != 0.0) S[0] += (Y == NULL) ? simd_repro_plain<T,false>(N,X,Y) : simd_repro_plain<T,true>(N,X,Y);
+    return;
+  }
+  #if defined (_OPENMP)
+  if (PAR && omp_get_max_threads() > 1 && !omp_in_parallel() && N >= libj::simd_par_min_n())
+  {
+    const long nblk = (N + SIMD_REPRO_BLOCK - 1)/SIMD_REPRO_BLOCK;
+    std::vector<double> part(SIMD_REPRO_FOLDS*omp_get_max_threads(),0.0);
+    int nthr = 1;
+    #pragma omp parallel
+    {
+      double* ps = part.data() + SIMD_REPRO_FOLDS*omp_get_thread_num();
+      #pragma omp single
+      nthr = omp_get_num_threads();
+      #pragma omp for schedule(static)
+      for (long b=0;b<nblk;b++)
+      {
+        const long start = b*SIMD_REPRO_BLOCK;
+        const long len   = std::min((long) SIMD_REPRO_BLOCK,N-start);
+        simd_repro_fold_sec<T>(len,X+start,(Y == NULL) ? NULL : Y+start,SIGMA,ps);
+      }
+    }
+    for (int t=0;t<nthr;t++)
+    {
+      for (int k=0;k<SIMD_REPRO_FOLDS;k++) S[k] += part[SIMD_REPRO_FOLDS*t+k];
+    }
+    return;
+  }
+  #endif
+  simd_repro_fold_sec<T>(N,X,Y,SIGMA,S);
+}
+
+template <typename T>
+static T simd_repro_drv(const bool PAR, const long N, const T* X, const T* Y)
+{
+  double S[SIMD_REPRO_FOLDS];
+  for (int k=0;k<SIMD_REPRO_FOLDS;k++) S[k] = 0;
+  const double amax = simd_repro_amax_drv<T>(PAR,N,X,Y);
+  simd_repro_fold_drv<T>(PAR,N,X,Y,amax,N,S);
+  return (T) libj::simd_repro_result(S);
+}
+
+/*---------------------------------------------------------------------
+ * the pieces
+ *---------------------------------------------------------------------*/
+template <typename T>
+double simd_repro_amax(const long N, const T* X) {return simd_repro_amax_drv<T>(false,N,X,NULL);}
+template <typename T>
+double simd_repro_amax(const long N, const T* X, const T* Y) {return simd_repro_amax_drv<T>(false,N,X,Y);}
+template <typename T>
+double simd_par_repro_amax(const long N, const T* X) {return simd_repro_amax_drv<T>(true,N,X,NULL);}
+template <typename T>
+double simd_par_repro_amax(const long N, const T* X, const T* Y) {return simd_repro_amax_drv<T>(true,N,X,Y);}
+
+template <typename T>
+void simd_repro_fold(const long N, const T* X, const double AMAX, const long NTOT, double* S)
+{
+  simd_repro_fold_drv<T>(false,N,X,NULL,AMAX,NTOT,S);
+}
+template <typename T>
+void simd_repro_fold(const long N, const T* X, const T* Y, const double AMAX, const long NTOT, double* S)
+{
+  simd_repro_fold_drv<T>(false,N,X,Y,AMAX,NTOT,S);
+}
+template <typename T>
+void simd_par_repro_fold(const long N, const T* X, const double AMAX, const long NTOT, double* S)
+{
+  simd_repro_fold_drv<T>(true,N,X,NULL,AMAX,NTOT,S);
+}
+template <typename T>
+void simd_par_repro_fold(const long N, const T* X, const T* Y, const double AMAX, const long NTOT, double* S)
+{
+  simd_repro_fold_drv<T>(true,N,X,Y,AMAX,NTOT,S);
+}
+
+template double simd_repro_amax<double>(const long N, const double* X);
+template double simd_repro_amax<float>(const long N, const float* X);
+template double simd_repro_amax<double>(const long N, const double* X, const double* Y);
+template double simd_repro_amax<float>(const long N, const float* X, const float* Y);
+template double simd_par_repro_amax<double>(const long N, const double* X);
+template double simd_par_repro_amax<float>(const long N, const float* X);
+template double simd_par_repro_amax<double>(const long N, const double* X, const double* Y);
+template double simd_par_repro_amax<float>(const long N, const float* X, const float* Y);
+template void simd_repro_fold<double>(const long N, const double* X, const double AMAX, const long NTOT, double* S);
+template void simd_repro_fold<float>(const long N, const float* X, const double AMAX, const long NTOT, double* S);
+template void simd_repro_fold<double>(const long N, const double* X, const double* Y, const double AMAX,
+                                      const long NTOT, double* S);
+template void simd_repro_fold<float>(const long N, const float* X, const float* Y, const double AMAX,
+                                     const long NTOT, double* S);
+template void simd_par_repro_fold<double>(const long N, const double* X, const double AMAX, const long NTOT, double* S);
+template void simd_par_repro_fold<float>(const long N, const float* X, const double AMAX, const long NTOT, double* S);
+template void simd_par_repro_fold<double>(const long N, const double* X, const double* Y, const double AMAX,
+                                          const long NTOT, double* S);
+template void simd_par_repro_fold<float>(const long N, const float* X, const float* Y, const double AMAX,
+                                         const long NTOT, double* S);
+
+/*---------------------------------------------------------------------
+ * reduction add and dot
+ *---------------------------------------------------------------------*/
+template <typename T>
+T simd_repro_reduction_add(const long N, const T* X) {return simd_repro_drv<T>(false,N,X,NULL);}
+template <typename T>
+T simd_repro_dot(const long N, const T* X, const T* Y) {return simd_repro_drv<T>(false,N,X,Y);}
+template <typename T>
+T simd_par_repro_reduction_add(const long N, const T* X) {return simd_repro_drv<T>(true,N,X,NULL);}
+template <typename T>
+T simd_par_repro_dot(const long N, const T* X, const T* Y) {return simd_repro_drv<T>(true,N,X,Y);}
+
+template double simd_repro_reduction_add<double>(const long N, const double* X);
+template float simd_repro_reduction_add<float>(const long N, const float* X);
+template double simd_repro_dot<double>(const long N, const double* X, const double* Y);
+template float simd_repro_dot<float>(const long N, const float* X, const float* Y);
+template double simd_par_repro_reduction_add<double>(const long N, const double* X);
+template float simd_par_repro_reduction_add<float>(const long N, const float* X);
+template double simd_par_repro_dot<double>(const long N, const double* X, const double* Y);
+template float simd_par_repro_dot<float>(const long N, const float* X, const float* Y);
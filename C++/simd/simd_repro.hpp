@@ -0,0 +1,88 @@
+/*----------------------------------------------------------
+ simd_repro.hpp
+    JHT, October 14, 2026 : created
+
+  .hpp file for the scalar pieces of the reproducible sums
+  (simd_repro_* in simd.hpp, simd_repro.cpp, Pcoll::
+  allreduce_repro, and Para::repro_sum)
+
+  The sum of NTOT numbers with |x| <= AMAX is cut into
+  SIMD_REPRO_FOLDS folds (Demmel and Nguyen, "Fast
+  reproducible floating-point summation", ARITH 21, 2013).
+  Fold k has a power of two SIGMA[k], with SIGMA[0] >=
+  2*NTOT*AMAX, and takes
+
+    q = (SIGMA[k] + x) - SIGMA[k],   x -= q
+
+  which is x rounded to a multiple of 2^-53 SIGMA[k]. The q
+  of a fold are all on that grid, and their sum stays below
+  SIGMA[k], so it is exact in any order, and the folds
+  S[k] are the same for any split of the data over lanes,
+  threads, or tasks. The result, simd_repro_result(S),
+  only depends on the S[k]. Each fold keeps 52-log2(NTOT)
+  bits of NTOT*AMAX, and what is below the last fold is
+  lost, so with F folds the error is at most about
+  NTOT*AMAX*2^(-F*(52-log2(NTOT))), which is below the
+  rounding of the result for most sums (F = 3 keeps 96
+  bits for NTOT = 2^20).
+
+  simd_repro_sigma fails (returns false) if AMAX is 0, inf,
+  or nan, or the folds would overflow, or underflow (|x|
+  above about 2^(1000-log2(NTOT)), or all below about
+  1E-270). The routines then fall back to a plain sum in
+  S[0], which is not reproducible (except for AMAX = 0).
+
+  Do not compile with -ffast-math, which drops the q
+----------------------------------------------------------*/
+#ifndef SIMD_REPRO_HPP
+#define SIMD_REPRO_HPP
+
+#include <math.h>
+#include <float.h>
+
+//folds of the reproducible sums
+#if !defined (SIMD_REPRO_FOLDS)
+  #define SIMD_REPRO_FOLDS 3
+#endif
+
+namespace libj
+{
+
+//SIGMA of the folds of NTOT numbers of at most AMAX, false if there are none
+inline bool simd_repro_sigma(const double AMAX, const long NTOT, double* SIGMA)
+{
+  if (!(AMAX > 0.0) || AMAX > DBL_MAX) return false;
+  int e;
+  frexp(AMAX,&e);
+  int L = 0;
+  while (L < 62 && (1L << L) < NTOT) L++;
+  const int top  = e + 1 + L;
+  const int step = 52 - L;
+  if (step < 2 || top > DBL_MAX_EXP - 2) return false;
+  if (top - (SIMD_REPRO_FOLDS-1)*step < DBL_MIN_EXP + 53) return false;
+  for (int k=0;k<SIMD_REPRO_FOLDS;k++) SIGMA[k] = ldexp(1.0,top - k*step);
+  return true;
+}
+
+//x into the folds S
+inline void simd_repro_deposit(double x, const double* SIGMA, double* S)
+{
+  for (int k=0;k<SIMD_REPRO_FOLDS;k++)
+  {
+    const double q = (SIGMA[k] + x) - SIGMA[k];
+    S[k] += q;
+    x -= q;
+  }
+}
+
+//the sum, from the folds
+inline double simd_repro_result(const double* S)
+{
+  double sum = S[SIMD_REPRO_FOLDS-1];
+  for (int k=SIMD_REPRO_FOLDS-2;k>=0;k--) sum += S[k];
+  return sum;
+}
+
+}//end of namespace
+
+#endif
@@ -7,9 +7,14 @@
  * If compiled with OpenMP, will use the OpenMP SIMD pragmas to 
  * provide hints to the compiler
  *
+ * Hand-coded AVX2/AVX-512 routines are used for doubles and floats
+ * claimed to be aligned to 32 or 64 BYTE boundaries
+ *
  */
 
 #include "simd.hpp"
+#include "debug.hpp"
+#include "simd_avx.hpp"
 
 /*---------------------------------------------------------------------
  * scal without (known) alignment
@@ -57,6 +62,7 @@ template void simd_scal_add<int>(const long N, const int A, int* X);
 template <typename T, const int ALIGNMENT>
 void simd_scal_add(const long N, const T A, T* X)
 {
+  LIBJ_CHECK_ALIGNED(X,ALIGNMENT);
   #if defined (_OPENMP)
     #pragma omp simd  aligned(X:ALIGNMENT) 
     for (long i=0;i<N;i++)
@@ -80,15 +86,19 @@ void simd_scal_add(const long N, const T A, T* X)
   #endif
 }
 
+#if !defined (__AVX2__) //special instructions below
 template void simd_scal_add<double,128>(const long N, const double A, double* X);
 template void simd_scal_add<double,64>(const long N, const double A, double* X);
 template void simd_scal_add<double,32>(const long N, const double A, double* X);
+#endif
 template void simd_scal_add<double,16>(const long N, const double A, double* X);
 template void simd_scal_add<double,8>(const long N, const double A, double* X);
 
+#if !defined (__AVX2__) //special instructions below
 template void simd_scal_add<float,128>(const long N, const float A, float* X);
 template void simd_scal_add<float,64>(const long N, const float A, float* X);
 template void simd_scal_add<float,32>(const long N, const float A, float* X);
+#endif
 template void simd_scal_add<float,16>(const long N, const float A, float* X);
 template void simd_scal_add<float,8>(const long N, const float A, float* X);
 template void simd_scal_add<float,4>(const long N, const float A, float* X);
@@ -105,3 +115,70 @@ template void simd_scal_add<int,32>(const long N, const int A, int* X);
 template void simd_scal_add<int,16>(const long N, const int A, int* X);
 template void simd_scal_add<int,8>(const long N, const int A, int* X);
 template void simd_scal_add<int,4>(const long N, const int A, int* X);
+
+//------------------------------------------------------------------------------
+//  Hand-coded routines for doubles and floats claimed to be aligned to
+//  32 or 64 BYTE boundaries. 64 BYTE claims use AVX-512 if available,
+//  128 BYTE claims use the 64 BYTE code
+#if defined (__AVX2__)
+template <typename T, const int BYTES>
+static inline void simd_scal_add_avx(const long N, const T A, T* X)
+{
+  typedef simd_vec<T,BYTES> S;
+  const long NW = S::W;
+  const typename S::V a = S::set1(A);
+  long i=0;
+
+  for (i=0;i+2*NW<=N;i+=2*NW)
+  {
+    S::store(X+i,S::add(S::load(X+i),a));
+    S::store(X+i+NW,S::add(S::load(X+i+NW),a));
+  }
+  for (i=i;i+NW<=N;i+=NW)
+  {
+    S::store(X+i,S::add(S::load(X+i),a));
+  }
+
+  //cleanup
+  for (i=i;i<N;i++)
+  {
+    *(X+i) += A;
+  }
+}
+
+template<>
+void simd_scal_add<double,32>(const long N, const double A, double* X)
+{
+  simd_scal_add_avx<double,32>(N,A,X);
+}
+
+template<>
+void simd_scal_add<double,64>(const long N, const double A, double* X)
+{
+  simd_scal_add_avx<double,SIMD_AVX_WIDE>(N,A,X);
+}
+
+template<>
+void simd_scal_add<double,128>(const long N, const double A, double* X)
+{
+  simd_scal_add<double,64>(N,A,X);
+}
+
+template<>
+void simd_scal_add<float,32>(const long N, const float A, float* X)
+{
+  simd_scal_add_avx<float,32>(N,A,X);
+}
+
+template<>
+void simd_scal_add<float,64>(const long N, const float A, float* X)
+{
+  simd_scal_add_avx<float,SIMD_AVX_WIDE>(N,A,X);
+}
+
+template<>
+void simd_scal_add<float,128>(const long N, const float A, float* X)
+{
+  simd_scal_add<float,64>(N,A,X);
+}
+#endif
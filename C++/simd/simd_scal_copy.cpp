@@ -0,0 +1,111 @@
+/* simd_scal_copy.cpp
+ * JHT, October 14, 2026 : created
+ *
+ * .cpp file that implements the fused simd scale and copy operation
+ *   Y = A*X
+ * which replaces a simd_copy followed by a simd_scal_mul on Y
+ *
+ * If compiled with OpenMP, will use the OpenMP SIMD pragmas to 
+ * provide hints to the compiler
+ *
+ */
+
+#include "simd.hpp"
+#include "debug.hpp"
+
+/*---------------------------------------------------------------------
+ * scal_copy without (known) alignment
+ *   - if OpenMP is defined, use the pragmas to request vectorization
+ *   - otherwise, use loop unrolling
+ *---------------------------------------------------------------------*/
+template <typename T>
+void simd_scal_copy(const long N, const T A, const T* X, T* Y)
+{
+  LIBJ_CHECK_INPLACE(X,N,Y,N);
+  #if defined (_OPENMP)
+    #pragma omp simd
+    for (long i=0;i<N;i++)
+    {
+      *(Y+i) = A * *(X+i);
+    }
+  #else
+    long i=0;
+    for (i=0;i<(N-4);i+=4)
+    {
+      *(Y+i+0) = A * *(X+i+0);
+      *(Y+i+1) = A * *(X+i+1);
+      *(Y+i+2) = A * *(X+i+2);
+      *(Y+i+3) = A * *(X+i+3);
+    }
+    
+    for (i=i;i<N;i++)
+    {
+      *(Y+i) = A * *(X+i);
+    }
+  #endif
+}
+template void simd_scal_copy<double>(const long N, const double A, const double* X, double* Y);
+template void simd_scal_copy<float>(const long N, const float A, const float* X, float* Y);
+template void simd_scal_copy<long>(const long N, const long A, const long* X, long* Y);
+template void simd_scal_copy<int>(const long N, const int A, const int* X, int* Y);
+
+
+/*---------------------------------------------------------------------
+ * scal_copy with known alignment
+ *   - if OpenMP is defined, use the pragmas to request vectorization
+ *   - otherwise, use loop unrolling
+ *---------------------------------------------------------------------*/
+template <typename T, const int ALIGNMENT>
+void simd_scal_copy(const long N, const T A, const T* X, T* Y)
+{
+  LIBJ_CHECK_ALIGNED(X,ALIGNMENT);
+  LIBJ_CHECK_ALIGNED(Y,ALIGNMENT);
+  LIBJ_CHECK_INPLACE(X,N,Y,N);
+  #if defined (_OPENMP)
+    #pragma omp simd aligned(X,Y:ALIGNMENT)
+    for (long i=0;i<N;i++)
+    {
+      *(Y+i) = A * *(X+i);
+    }
+  #else
+    long i=0;
+    for (i=0;i<(N-4);i+=4)
+    {
+      *(Y+i+0) = A * *(X+i+0);
+      *(Y+i+1) = A * *(X+i+1);
+      *(Y+i+2) = A * *(X+i+2);
+      *(Y+i+3) = A * *(X+i+3);
+    }
+    
+    for (i=i;i<N;i++)
+    {
+      *(Y+i) = A * *(X+i);
+    }
+  #endif
+}
+
+template void simd_scal_copy<double,128>(const long N, const double A, const double* X, double* Y);
+template void simd_scal_copy<double,64>(const long N, const double A, const double* X, double* Y);
+template void simd_scal_copy<double,32>(const long N, const double A, const double* X, double* Y);
+template void simd_scal_copy<double,16>(const long N, const double A, const double* X, double* Y);
+template void simd_scal_copy<double,8>(const long N, const double A, const double* X, double* Y);
+
+template void simd_scal_copy<float,128>(const long N, const float A, const float* X, float* Y);
+template void simd_scal_copy<float,64>(const long N, const float A, const float* X, float* Y);
+template void simd_scal_copy<float,32>(const long N, const float A, const float* X, float* Y);
+template void simd_scal_copy<float,16>(const long N, const float A, const float* X, float* Y);
+template void simd_scal_copy<float,8>(const long N, const float A, const float* X, float* Y);
+template void simd_scal_copy<float,4>(const long N, const float A, const float* X, float* Y);
+
+template void simd_scal_copy<long,128>(const long N, const long A, const long* X, long* Y);
+template void simd_scal_copy<long,64>(const long N, const long A, const long* X, long* Y);
+template void simd_scal_copy<long,32>(const long N, const long A, const long* X, long* Y);
+template void simd_scal_copy<long,16>(const long N, const long A, const long* X, long* Y);
+template void simd_scal_copy<long,8>(const long N, const long A, const long* X, long* Y);
+
+template void simd_scal_copy<int,128>(const long N, const int A, const int* X, int* Y);
+template void simd_scal_copy<int,64>(const long N, const int A, const int* X, int* Y);
+template void simd_scal_copy<int,32>(const long N, const int A, const int* X, int* Y);
+template void simd_scal_copy<int,16>(const long N, const int A, const int* X, int* Y);
+template void simd_scal_copy<int,8>(const long N, const int A, const int* X, int* Y);
+template void simd_scal_copy<int,4>(const long N, const int A, const int* X, int* Y);
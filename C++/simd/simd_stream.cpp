@@ -0,0 +1,157 @@
+/* simd_stream.cpp
+ * JHT, October 14, 2026 : created
+ *
+ * .cpp file that implements zero, copy, and scal_set with
+ * non-temporal (streaming) stores, for buffers much larger than
+ * the last level cache.
+ *
+ * Normal stores first read each cache line from memory (read for
+ * ownership) and then push useful data out of the cache. Streaming
+ * stores write whole lines straight to memory instead.
+ *
+ * The destination is stored with scalar stores up to the first
+ * 32 BYTE boundary, then two YMM registers (one cache line) at a
+ * time, and the ragged end with scalar stores. A fence at the end
+ * makes the data visible to the other cores before returning.
+ *
+ * Without AVX2 these are just the normal routines
+ *
+ */
+
+#include "simd.hpp"
+#include <stdint.h>
+#include <cstring>
+
+#if defined (__AVX2__)
+/*---------------------------------------------------------------------
+ * broadcast of one value into a YMM register
+ *---------------------------------------------------------------------*/
+static inline __m256i simd_stream_set1(const double A) {return _mm256_castpd_si256(_mm256_set1_pd(A));}
+static inline __m256i simd_stream_set1(const float A) {return _mm256_castps_si256(_mm256_set1_ps(A));}
+static inline __m256i simd_stream_set1(const long A) {return _mm256_set1_epi64x(A);}
+static inline __m256i simd_stream_set1(const int A) {return _mm256_set1_epi32(A);}
+
+/*---------------------------------------------------------------------
+ * number of elements before X reaches a 32 BYTE boundary
+ *---------------------------------------------------------------------*/
+template <typename T>
+static inline long simd_stream_head(const long N, const T* X)
+{
+  const long off  = (long) (((uintptr_t) X) & 31);
+  const long head = (off == 0) ? 0 : (32 - off)/((long) sizeof(T));
+  return (head < N) ? head : N;
+}
+
+/*---------------------------------------------------------------------
+ * streams one register value over X
+ *---------------------------------------------------------------------*/
+template <typename T>
+static inline void simd_stream_fill(const long N, const T A, T* X)
+{
+  const long NW   = 32/sizeof(T);
+  const long head = simd_stream_head<T>(N,X);
+  const __m256i a = simd_stream_set1(A);
+  long i=0;
+
+  for (i=0;i<head;i++)
+  {
+    *(X+i) = A;
+  }
+
+  for (i=i;i+2*NW<=N;i+=2*NW)
+  {
+    _mm256_stream_si256((__m256i*)(X+i),a);
+    _mm256_stream_si256((__m256i*)(X+i+NW),a);
+  }
+  for (i=i;i+NW<=N;i+=NW)
+  {
+    _mm256_stream_si256((__m256i*)(X+i),a);
+  }
+  _mm_sfence();
+
+  //cleanup
+  for (i=i;i<N;i++)
+  {
+    *(X+i) = A;
+  }
+}
+#endif
+
+/*---------------------------------------------------------------------
+ * zero
+ *---------------------------------------------------------------------*/
+template <typename T>
+void simd_zero_stream(const long N, T* X)
+{
+  #if defined (__AVX2__)
+    simd_stream_fill<T>(N,(T) 0,X);
+  #else
+    simd_zero<T>(N,X);
+  #endif
+}
+template void simd_zero_stream<double>(const long N, double* X);
+template void simd_zero_stream<float>(const long N, float* X);
+template void simd_zero_stream<long>(const long N, long* X);
+template void simd_zero_stream<int>(const long N, int* X);
+
+/*---------------------------------------------------------------------
+ * scal_set
+ *---------------------------------------------------------------------*/
+template <typename T>
+void simd_scal_set_stream(const long N, const T A, T* X)
+{
+  #if defined (__AVX2__)
+    simd_stream_fill<T>(N,A,X);
+  #else
+    simd_scal_set<T>(N,A,X);
+  #endif
+}
+template void simd_scal_set_stream<double>(const long N, const double A, double* X);
+template void simd_scal_set_stream<float>(const long N, const float A, float* X);
+template void simd_scal_set_stream<long>(const long N, const long A, long* X);
+template void simd_scal_set_stream<int>(const long N, const int A, int* X);
+
+/*---------------------------------------------------------------------
+ * copy
+ *   the source is read with unaligned loads, only Y needs to
+ *   reach the 32 BYTE boundary
+ *---------------------------------------------------------------------*/
+template <typename T>
+void simd_copy_stream(const long N, const T* X, T* Y)
+{
+  #if defined (__AVX2__)
+    const long NW   = 32/sizeof(T);
+    const long head = simd_stream_head<T>(N,Y);
+    long i=0;
+
+    for (i=0;i<head;i++)
+    {
+      *(Y+i) = *(X+i);
+    }
+
+    for (i=i;i+2*NW<=N;i+=2*NW)
+    {
+      const __m256i x0 = _mm256_loadu_si256((const __m256i*)(X+i));
+      const __m256i x1 = _mm256_loadu_si256((const __m256i*)(X+i+NW));
+      _mm256_stream_si256((__m256i*)(Y+i),x0);
+      _mm256_stream_si256((__m256i*)(Y+i+NW),x1);
+    }
+    for (i=i;i+NW<=N;i+=NW)
+    {
+      _mm256_stream_si256((__m256i*)(Y+i),_mm256_loadu_si256((const __m256i*)(X+i)));
+    }
+    _mm_sfence();
+
+    //cleanup
+    for (i=i;i<N;i++)
+    {
+      *(Y+i) = *(X+i);
+    }
+  #else
+    std::memcpy(Y,X,N*sizeof(T));
+  #endif
+}
+template void simd_copy_stream<double>(const long N, const double* X, double* Y);
+template void simd_copy_stream<float>(const long N, const float* X, float* Y);
+template void simd_copy_stream<long>(const long N, const long* X, long* Y);
+template void simd_copy_stream<int>(const long N, const int* X, int* Y);
@@ -0,0 +1,191 @@
+/* simd_strided.cpp
+ * JHT, October 14, 2026 : created
+ *
+ * .cpp file that implements the level-1 simd routines over data
+ * with a constant, non-unit stride, e.g., a row of a column
+ * major matrix. Element i of X is *(X+i*INCX)
+ *
+ * If both strides are 1, the contiguous routine is called. If
+ * compiled with AVX2, strided loads of doubles use the hardware
+ * gather (there is no AVX2 scatter, so strided stores are
+ * always scalar)
+ *
+ */
+
+#include "simd.hpp"
+
+/*---------------------------------------------------------------------
+ * dot
+ *---------------------------------------------------------------------*/
+template <typename T>
+T simd_dot_strided(const long N, const T* X, const long INCX, const T* Y, const long INCY)
+{
+  if (INCX == 1 && INCY == 1) {return simd_dot<T>(N,X,Y);}
+
+  T dot0 = 0;
+  T dot1 = 0;
+  T dot2 = 0;
+  T dot3 = 0;
+  long i=0;
+  for (i=0;i<(N-4);i+=4)
+  {
+    dot0 += *(X+(i+0)*INCX) * *(Y+(i+0)*INCY);
+    dot1 += *(X+(i+1)*INCX) * *(Y+(i+1)*INCY);
+    dot2 += *(X+(i+2)*INCX) * *(Y+(i+2)*INCY);
+    dot3 += *(X+(i+3)*INCX) * *(Y+(i+3)*INCY);
+  }
+
+  for (i=i;i<N;i++)
+  {
+    dot0 += *(X+i*INCX) * *(Y+i*INCY);
+  }
+  return (dot0 + dot1) + (dot2 + dot3);
+}
+
+#if defined (__AVX2__)
+template <>
+double simd_dot_strided<double>(const long N, const double* X, const long INCX,
+                                const double* Y, const long INCY)
+{
+  if (INCX == 1 && INCY == 1) {return simd_dot<double>(N,X,Y);}
+
+  const __m256i ix  = _mm256_set_epi64x(3*INCX,2*INCX,INCX,0);
+  const __m256i iy  = _mm256_set_epi64x(3*INCY,2*INCY,INCY,0);
+  __m256d a = _mm256_setzero_pd();
+  long i=0;
+  for (i=0;i+4<=N;i+=4)
+  {
+    const __m256d x = _mm256_i64gather_pd(X+i*INCX,ix,8);
+    const __m256d y = _mm256_i64gather_pd(Y+i*INCY,iy,8);
+    #if defined (__FMA__)
+      a = _mm256_fmadd_pd(x,y,a);
+    #else
+      a = _mm256_add_pd(_mm256_mul_pd(x,y),a);
+    #endif
+  }
+
+  double part[4];
+  _mm256_storeu_pd(part,a);
+  double dot = (part[0] + part[1]) + (part[2] + part[3]);
+
+  //cleanup
+  for (i=i;i<N;i++)
+  {
+    dot += *(X+i*INCX) * *(Y+i*INCY);
+  }
+  return dot;
+}
+#else
+template double simd_dot_strided<double>(const long N, const double* X, const long INCX, const double* Y, const long INCY);
+#endif
+template float simd_dot_strided<float>(const long N, const float* X, const long INCX, const float* Y, const long INCY);
+template long simd_dot_strided<long>(const long N, const long* X, const long INCX, const long* Y, const long INCY);
+template int simd_dot_strided<int>(const long N, const int* X, const long INCX, const int* Y, const long INCY);
+
+/*---------------------------------------------------------------------
+ * axpy
+ *---------------------------------------------------------------------*/
+template <typename T>
+void simd_axpy_strided(const long N, const T A, const T* X, const long INCX, T* Y, const long INCY)
+{
+  if (INCX == 1 && INCY == 1) {simd_axpy<T>(N,A,X,Y); return;}
+
+  long i=0;
+  for (i=0;i<(N-4);i+=4)
+  {
+    *(Y+(i+0)*INCY) += A * *(X+(i+0)*INCX);
+    *(Y+(i+1)*INCY) += A * *(X+(i+1)*INCX);
+    *(Y+(i+2)*INCY) += A * *(X+(i+2)*INCX);
+    *(Y+(i+3)*INCY) += A * *(X+(i+3)*INCX);
+  }
+
+  for (i=i;i<N;i++)
+  {
+    *(Y+i*INCY) += A * *(X+i*INCX);
+  }
+}
+template void simd_axpy_strided<double>(const long N, const double A, const double* X, const long INCX, double* Y, const long INCY);
+template void simd_axpy_strided<float>(const long N, const float A, const float* X, const long INCX, float* Y, const long INCY);
+template void simd_axpy_strided<long>(const long N, const long A, const long* X, const long INCX, long* Y, const long INCY);
+template void simd_axpy_strided<int>(const long N, const int A, const int* X, const long INCX, int* Y, const long INCY);
+
+/*---------------------------------------------------------------------
+ * copy
+ *---------------------------------------------------------------------*/
+template <typename T>
+void simd_copy_strided(const long N, const T* X, const long INCX, T* Y, const long INCY)
+{
+  if (INCX == 1 && INCY == 1) {simd_copy<T>(N,X,Y); return;}
+
+  long i=0;
+  for (i=0;i<(N-4);i+=4)
+  {
+    *(Y+(i+0)*INCY) = *(X+(i+0)*INCX);
+    *(Y+(i+1)*INCY) = *(X+(i+1)*INCX);
+    *(Y+(i+2)*INCY) = *(X+(i+2)*INCX);
+    *(Y+(i+3)*INCY) = *(X+(i+3)*INCX);
+  }
+
+  for (i=i;i<N;i++)
+  {
+    *(Y+i*INCY) = *(X+i*INCX);
+  }
+}
+template void simd_copy_strided<double>(const long N, const double* X, const long INCX, double* Y, const long INCY);
+template void simd_copy_strided<float>(const long N, const float* X, const long INCX, float* Y, const long INCY);
+template void simd_copy_strided<long>(const long N, const long* X, const long INCX, long* Y, const long INCY);
+template void simd_copy_strided<int>(const long N, const int* X, const long INCX, int* Y, const long INCY);
+
+/*---------------------------------------------------------------------
+ * scal_mul
+ *---------------------------------------------------------------------*/
+template <typename T>
+void simd_scal_mul_strided(const long N, const T A, T* X, const long INCX)
+{
+  if (INCX == 1) {simd_scal_mul<T>(N,A,X); return;}
+
+  long i=0;
+  for (i=0;i<(N-4);i+=4)
+  {
+    *(X+(i+0)*INCX) *= A;
+    *(X+(i+1)*INCX) *= A;
+    *(X+(i+2)*INCX) *= A;
+    *(X+(i+3)*INCX) *= A;
+  }
+
+  for (i=i;i<N;i++)
+  {
+    *(X+i*INCX) *= A;
+  }
+}
+template void simd_scal_mul_strided<double>(const long N, const double A, double* X, const long INCX);
+template void simd_scal_mul_strided<float>(const long N, const float A, float* X, const long INCX);
+template void simd_scal_mul_strided<long>(const long N, const long A, long* X, const long INCX);
+template void simd_scal_mul_strided<int>(const long N, const int A, int* X, const long INCX);
+
+/*---------------------------------------------------------------------
+ * zero
+ *---------------------------------------------------------------------*/
+template <typename T>
+void simd_zero_strided(const long N, T* X, const long INCX)
+{
+  if (INCX == 1) {simd_zero<T>(N,X); return;}
+
+  long i=0;
+  for (i=0;i<(N-4);i+=4)
+  {
+    *(X+(i+0)*INCX) = (T) 0;
+    *(X+(i+1)*INCX) = (T) 0;
+    *(X+(i+2)*INCX) = (T) 0;
+    *(X+(i+3)*INCX) = (T) 0;
+  }
+
+  for (i=i;i<N;i++)
+  {
+    *(X+i*INCX) = (T) 0;
+  }
+}
+template void simd_zero_strided<double>(const long N, double* X, const long INCX);
+template void simd_zero_strided<float>(const long N, float* X, const long INCX);
+template void simd_zero_strided<long>(const long N, long* X, const long INCX);
+template void simd_zero_strided<int>(const long N, int* X, const long INCX);
@@ -7,9 +7,18 @@
  * If compiled with OpenMP, will use the OpenMP SIMD pragmas to 
  * provide hints to the compiler
  *
+ * Hand-coded AVX2/AVX-512 routines are used for doubles and floats
+ * claimed to be aligned to 32 or 64 BYTE boundaries
+ *
+ * With SIMD_DISPATCH (see simd_dispatch.hpp) doubles and floats go
+ * through the runtime dispatched kernels instead
+ *
  */
 
 #include "simd.hpp"
+#include "debug.hpp"
+#include "simd_avx.hpp"
+#include "simd_dispatch_kernel.hpp"
 
 /*---------------------------------------------------------------------
  * zero without (known) alignment
@@ -19,6 +28,10 @@
 template <typename T>
 void simd_zero(const long N, T* X)
 {
+  #if defined (SIMD_DISPATCH)
+    if (simd_dispatch_zero_hook(N,X)) return;
+  #endif
+
   #if defined (_OPENMP)
     #pragma omp simd  
     for (long i=0;i<N;i++)
@@ -57,6 +70,11 @@ template void simd_zero<int>(const long N, int* X);
 template <typename T, const int ALIGNMENT>
 void simd_zero(const long N, T* X)
 {
+  LIBJ_CHECK_ALIGNED(X,ALIGNMENT);
+  #if defined (SIMD_DISPATCH)
+    if (simd_dispatch_zero_hook(N,X)) return;
+  #endif
+
   #if defined (_OPENMP)
     #pragma omp simd  aligned(X:ALIGNMENT) 
     for (long i=0;i<N;i++)
@@ -80,15 +98,19 @@ void simd_zero(const long N, T* X)
   #endif
 }
 
+#if !defined (__AVX2__) //special instructions below
 template void simd_zero<double,128>(const long N, double* X);
 template void simd_zero<double,64>(const long N, double* X);
 template void simd_zero<double,32>(const long N, double* X);
+#endif
 template void simd_zero<double,16>(const long N, double* X);
 template void simd_zero<double,8>(const long N, double* X);
 
+#if !defined (__AVX2__) //special instructions below
 template void simd_zero<float,128>(const long N, float* X);
 template void simd_zero<float,64>(const long N, float* X);
 template void simd_zero<float,32>(const long N, float* X);
+#endif
 template void simd_zero<float,16>(const long N, float* X);
 template void simd_zero<float,8>(const long N, float* X);
 template void simd_zero<float,4>(const long N, float* X);
@@ -105,3 +127,82 @@ template void simd_zero<int,32>(const long N, int* X);
 template void simd_zero<int,16>(const long N, int* X);
 template void simd_zero<int,8>(const long N, int* X);
 template void simd_zero<int,4>(const long N, int* X);
+
+//------------------------------------------------------------------------------
+//  Hand-coded routines for doubles and floats claimed to be aligned to
+//  32 or 64 BYTE boundaries. 64 BYTE claims use AVX-512 if available,
+//  128 BYTE claims use the 64 BYTE code
+//  Above SIMD_STREAM_BYTES, streaming stores are used
+#if defined (__AVX2__)
+template <typename T, const int BYTES>
+static inline void simd_zero_avx(const long N, T* X)
+{
+  //far larger than the cache, do not pull the lines in
+  if (N*(long) sizeof(T) >= SIMD_STREAM_BYTES)
+  {
+    simd_zero_stream<T>(N,X);
+    return;
+  }
+
+  #if defined (SIMD_DISPATCH)
+    if (simd_dispatch_zero_hook(N,X)) return;
+  #endif
+
+  typedef simd_vec<T,BYTES> S;
+  const long NW = S::W;
+  const typename S::V z = S::zero();
+  long i=0;
+
+  for (i=0;i+2*NW<=N;i+=2*NW)
+  {
+    S::store(X+i,z);
+    S::store(X+i+NW,z);
+  }
+  for (i=i;i+NW<=N;i+=NW)
+  {
+    S::store(X+i,z);
+  }
+
+  //cleanup
+  for (i=i;i<N;i++)
+  {
+    *(X+i) = (T) 0;
+  }
+}
+
+template<>
+void simd_zero<double,32>(const long N, double* X)
+{
+  simd_zero_avx<double,32>(N,X);
+}
+
+template<>
+void simd_zero<double,64>(const long N, double* X)
+{
+  simd_zero_avx<double,SIMD_AVX_WIDE>(N,X);
+}
+
+template<>
+void simd_zero<double,128>(const long N, double* X)
+{
+  simd_zero<double,64>(N,X);
+}
+
+template<>
+void simd_zero<float,32>(const long N, float* X)
+{
+  simd_zero_avx<float,32>(N,X);
+}
+
+template<>
+void simd_zero<float,64>(const long N, float* X)
+{
+  simd_zero_avx<float,SIMD_AVX_WIDE>(N,X);
+}
+
+template<>
+void simd_zero<float,128>(const long N, float* X)
+{
+  simd_zero<float,64>(N,X);
+}
+#endif
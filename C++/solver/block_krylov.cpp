@@ -0,0 +1,384 @@
+/*----------------------------------------------------------------------------
+  block_krylov.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for the block CG and block GMRES solvers, see block_krylov.hpp
+
+  The working blocks hold only the RHS left, in order (act maps them to
+  the columns of B and X), so deflating one is moving the later columns
+  of the block down by one.
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <algorithm>
+#include <vector>
+#include "block_krylov.hpp"
+#include "simd.hpp"
+#include "linal_ABpC.hpp"
+#include "linal_ATBpC.hpp"
+#include "linal_decomp.hpp"
+#include "linal_tsqr.hpp"
+#include "lapack_interface.hpp"
+#include "core.hpp"
+
+#if defined (_OPENMP)
+  #include <omp.h>
+#endif
+
+namespace libj
+{
+
+/*----------------------------------------------------------------------------
+  krylov_error
+----------------------------------------------------------------------------*/
+static void krylov_error(const char* NAME, const char* msg)
+{
+  printf("ERROR libj::%s \n",NAME);
+  printf("%s \n",msg);
+  exit(1);
+}
+
+/*----------------------------------------------------------------------------
+  krylov_chunks
+	number of chunks of rows of a tall block of N rows, one per thread,
+	of at least LIBJ_KRYLOV_ROWS each
+----------------------------------------------------------------------------*/
+static long krylov_chunks(const long N)
+{
+  long P = 1;
+  #if defined (_OPENMP)
+    if (!omp_in_parallel()) P = omp_get_max_threads();
+  #endif
+  return std::max(1L,std::min(P,N/LIBJ_KRYLOV_ROWS));
+}
+
+/*----------------------------------------------------------------------------
+  krylov_AtB
+	C (MxS) = A^T.B, for A (NxM) and B (NxS), LDC = M. Each chunk of
+	rows makes its own C, and they are summed
+----------------------------------------------------------------------------*/
+static void krylov_AtB(const long N, const long M, const long S, const double* A,
+                       const double* B, double* C)
+{
+  if (M == 0 || S == 0) return;
+  const long P = krylov_chunks(N);
+  if (P == 1)
+  {
+    linal_ATBpC<double>(M,S,N,1.0,const_cast<double*>(A),N,const_cast<double*>(B),N,0.0,C,M);
+    return;
+  }
+  std::vector<double> CP(P*M*S);
+  #pragma omp parallel for schedule(static) num_threads(P)
+  for (long p=0;p<P;p++)
+  {
+    const long i0 = (N*p)/P;
+    const long i1 = (N*(p+1))/P;
+    linal_ATBpC<double>(M,S,i1-i0,1.0,const_cast<double*>(A)+i0,N,
+                        const_cast<double*>(B)+i0,N,0.0,CP.data()+p*M*S,M);
+  }
+  std::copy(CP.data(),CP.data()+M*S,C);
+  for (long p=1;p<P;p++) simd_axpy<double>(M*S,1.0,CP.data()+p*M*S,C);
+}
+
+/*----------------------------------------------------------------------------
+  krylov_AB
+	C (NxS) = ALPHA*A.B + BETA*C, for A (NxM) and B (MxS), LDC = N
+----------------------------------------------------------------------------*/
+static void krylov_AB(const long N, const long S, const long M, const double ALPHA,
+                      const double* A, const double* B, const double BETA, double* C)
+{
+  if (S == 0) return;
+  if (M == 0)
+  {
+    for (long j=0;j<S;j++)
+    {
+      if (BETA == 0.0) std::fill(C+j*N,C+(j+1)*N,0.0);
+      else simd_scal_mul<double>(N,BETA,C+j*N);
+    }
+    return;
+  }
+  const long P = krylov_chunks(N);
+  #pragma omp parallel for schedule(static) num_threads(P) if (P > 1)
+  for (long p=0;p<P;p++)
+  {
+    const long i0 = (N*p)/P;
+    const long i1 = (N*(p+1))/P;
+    linal_ABpC<double>(i1-i0,S,M,ALPHA,const_cast<double*>(A)+i0,N,
+                       const_cast<double*>(B),M,BETA,C+i0,N);
+  }
+}
+
+/*----------------------------------------------------------------------------
+  krylov_precond
+	Z = PRECOND(R), or R if there is none
+----------------------------------------------------------------------------*/
+static inline void krylov_precond(const long N, const long NV, const krylov_op& PRECOND,
+                                  const double* R, double* Z)
+{
+  if (PRECOND) PRECOND(NV,R,Z);
+  else std::copy(R,R+N*NV,Z);
+}
+
+/*----------------------------------------------------------------------------
+  krylov_residual
+	R = B - A.X for the RHS in act, and their norms relative to B. Those
+	with B = 0 are solved by X = 0
+----------------------------------------------------------------------------*/
+static void krylov_residual(const long N, const krylov_op& OP, const double* B, double* X,
+                            const std::vector<long>& act, const std::vector<double>& bnorm,
+                            double* R, double* TMP, std::vector<double>& rnorm)
+{
+  const long NA = (long) act.size();
+  for (long j=0;j<NA;j++) std::copy(X+act[j]*N,X+(act[j]+1)*N,TMP+j*N);
+  OP(NA,TMP,R);
+  for (long j=0;j<NA;j++)
+  {
+    const long k = act[j];
+    double* r = R+j*N;
+    for (long i=0;i<N;i++) r[i] = B[i+k*N] - r[i];
+    if (bnorm[k] == 0.0)
+    {
+      std::fill(X+k*N,X+(k+1)*N,0.0);
+      rnorm[k] = 0.0;
+    } else {
+      rnorm[k] = sqrt(simd_dot<double>(N,r,r))/bnorm[k];
+    }
+  }
+}
+
+/*----------------------------------------------------------------------------
+  krylov_deflate
+	drop the converged RHS from act, and their columns from R (NxNA)
+----------------------------------------------------------------------------*/
+static void krylov_deflate(const long N, std::vector<long>& act, const std::vector<double>& rnorm,
+                           const double TOL, double* R)
+{
+  long na = 0;
+  for (long j=0;j<(long) act.size();j++)
+  {
+    if (rnorm[act[j]] <= TOL) continue;
+    if (na != j) std::copy(R+j*N,R+(j+1)*N,R+na*N);
+    act[na++] = act[j];
+  }
+  act.resize(na);
+}
+
+/*----------------------------------------------------------------------------
+  krylov_orth
+	orthonormalize the NP vectors of P, twice, from the eigenvectors of
+	P^T.P: P = P.V.W^-1/2, less those with norms (sqrt(W)) under
+	LIBJ_KRYLOV_DROP of the largest. Returns the number kept
+----------------------------------------------------------------------------*/
+static long krylov_orth(const long N, double* P, long NP, double* TMP)
+{
+  for (int pass=0;pass<2 && NP>0;pass++)
+  {
+    std::vector<double> G(NP*NP), W(NP);
+    Core<double> CORE(linal_dsyevd_NWORK(NP));
+    krylov_AtB(N,NP,NP,P,P,G.data());
+    int INFO = 0;
+    linal_dsyevd(NP,G.data(),W.data(),CORE,INFO);
+    if (INFO != 0) krylov_error("block_cg","linal_dsyevd of the Gram matrix failed");
+
+    //W ascending, keep the top
+    const double wmax = W[NP-1];
+    long k0 = 0;
+    while (k0 < NP && !(W[k0] > LIBJ_KRYLOV_DROP*LIBJ_KRYLOV_DROP*wmax && W[k0] > 0.0)) k0++;
+    const long NK = NP - k0;
+    for (long k=k0;k<NP;k++) simd_scal_mul<double>(NP,1.0/sqrt(W[k]),G.data()+k*NP);
+    krylov_AB(N,NK,NP,1.0,P,G.data()+k0*NP,0.0,TMP);
+    std::copy(TMP,TMP+N*NK,P);
+    NP = NK;
+  }
+  return NP;
+}
+
+/*----------------------------------------------------------------------------
+  block_cg
+	P and Q are NxNP, R and Z NxNA, with NP <= NA. PQ is the Cholesky
+	factor of P^T.Q, used for both alpha and beta
+----------------------------------------------------------------------------*/
+int block_cg(const long N, const long NRHS, const krylov_op& OP, const double* B,
+             double* X, const double TOL, const int MAXIT,
+             const krylov_op& PRECOND, double* RNORM)
+{
+  if (N < 1 || NRHS < 1) {krylov_error("block_cg","bad N or NRHS");}
+  std::vector<double> R(N*NRHS), Z(N*NRHS), P(N*NRHS), Q(N*NRHS), TMP(N*NRHS);
+  std::vector<double> PQ(NRHS*NRHS), AB(NRHS*NRHS);
+  std::vector<double> bnorm(NRHS), rnorm(NRHS,0.0);
+  std::vector<long> act(NRHS);
+  for (long k=0;k<NRHS;k++)
+  {
+    bnorm[k] = sqrt(simd_dot<double>(N,B+k*N,B+k*N));
+    act[k] = k;
+  }
+
+  krylov_residual(N,OP,B,X,act,bnorm,R.data(),TMP.data(),rnorm);
+  krylov_deflate(N,act,rnorm,TOL,R.data());
+  long na = (long) act.size();
+  long np = 0;
+  if (na > 0)
+  {
+    krylov_precond(N,na,PRECOND,R.data(),P.data());
+    np = krylov_orth(N,P.data(),na,TMP.data());
+  }
+
+  int it = 0;
+  while (na > 0 && np > 0 && it < MAXIT)
+  {
+    OP(np,P.data(),Q.data());
+    it++;
+
+    //alpha = (P^T.Q)^-1 P^T.R
+    char UPLO = 'U';
+    int  NN   = np;
+    int  NR   = na;
+    int  INFO = 0;
+    krylov_AtB(N,np,np,P.data(),Q.data(),PQ.data());
+    for (long j=0;j<np;j++)
+    {
+      for (long i=0;i<j;i++) PQ[i+j*np] = 0.5*(PQ[i+j*np] + PQ[j+i*np]);
+    }
+    dpotrf_(&UPLO,&NN,PQ.data(),&NN,&INFO);
+    if (INFO != 0) break;
+    krylov_AtB(N,np,na,P.data(),R.data(),AB.data());
+    dpotrs_(&UPLO,&NN,&NR,PQ.data(),&NN,AB.data(),&NN,&INFO);
+
+    //X += P.alpha, R -= Q.alpha
+    krylov_AB(N,na,np,1.0,P.data(),AB.data(),0.0,TMP.data());
+    for (long j=0;j<na;j++) simd_axpy<double>(N,1.0,TMP.data()+j*N,X+act[j]*N);
+    krylov_AB(N,na,np,-1.0,Q.data(),AB.data(),1.0,R.data());
+    for (long j=0;j<na;j++)
+    {
+      const double* r = R.data()+j*N;
+      rnorm[act[j]] = sqrt(simd_dot<double>(N,r,r))/bnorm[act[j]];
+    }
+    krylov_deflate(N,act,rnorm,TOL,R.data());
+    na = (long) act.size();
+    if (na == 0) break;
+
+    //P = orth(Z - P.(P^T.Q)^-1 Q^T.Z)
+    NR = na;
+    krylov_precond(N,na,PRECOND,R.data(),Z.data());
+    krylov_AtB(N,np,na,Q.data(),Z.data(),AB.data());
+    dpotrs_(&UPLO,&NN,&NR,PQ.data(),&NN,AB.data(),&NN,&INFO);
+    krylov_AB(N,na,np,-1.0,P.data(),AB.data(),1.0,Z.data());
+    std::swap(P,Z);
+    np = krylov_orth(N,P.data(),na,TMP.data());
+  }
+
+  if (RNORM != NULL) std::copy(rnorm.begin(),rnorm.end(),RNORM);
+  return (na == 0) ? it : -1;
+}
+
+/*----------------------------------------------------------------------------
+  block_gmres
+	V is the basis of the cycle, N x (M+1)*S for the S RHS left, and H
+	the (M+1)*S x M*S block Hessenberg matrix, A.PRECOND(V_j) =
+	sum_i V_i H_ij. After J blocks the least squares problem is
+
+	  min | E_0 S - H(0:(J+1)*S,0:J*S) Y |
+
+	with R = V_0 S, whose residual is the last S rows of the dgels
+	solution, one column for each RHS
+----------------------------------------------------------------------------*/
+int block_gmres(const long N, const long NRHS, const krylov_op& OP, const double* B,
+                double* X, const double TOL, const int MAXIT, const int RESTART,
+                const krylov_op& PRECOND, double* RNORM)
+{
+  if (N < 1 || NRHS < 1) {krylov_error("block_gmres","bad N or NRHS");}
+  if (RESTART < 1) {krylov_error("block_gmres","RESTART must be at least 1");}
+  std::vector<double> R(N*NRHS), TMP(N*NRHS);
+  std::vector<double> bnorm(NRHS), rnorm(NRHS,0.0);
+  std::vector<long> act(NRHS);
+  for (long k=0;k<NRHS;k++)
+  {
+    bnorm[k] = sqrt(simd_dot<double>(N,B+k*N,B+k*N));
+    act[k] = k;
+  }
+
+  int it = 0;
+  std::vector<double> V, H, HH, E, Y, HC, WORK;
+  while (true)
+  {
+    krylov_residual(N,OP,B,X,act,bnorm,R.data(),TMP.data(),rnorm);
+    krylov_deflate(N,act,rnorm,TOL,R.data());
+    const long S = (long) act.size();
+    if (S == 0 || it >= MAXIT) break;
+
+    //blocks of the cycle, no more than fit in N
+    const long M   = std::max(1L,std::min((long) RESTART,N/S - 1));
+    const long LDH = (M+1)*S;
+    V.assign(N*LDH,0.0);
+    H.assign(LDH*M*S,0.0);
+    HH.resize(LDH*M*S);
+    E.resize(LDH*S);
+    Y.assign(M*S*S,0.0);
+    HC.resize(LDH*S);
+    std::vector<double> S0(S*S);
+    std::copy(R.data(),R.data()+N*S,V.data());
+    linal_dtsqr(N,S,V.data(),N,S0.data(),S);
+
+    char TRANS = 'N';
+    int  LWORK = -1;
+    int  INFO  = 0;
+    {
+      int MM = LDH, NN = M*S, NR = S;
+      double D;
+      dgels_(&TRANS,&MM,&NN,&NR,HH.data(),&MM,E.data(),&MM,&D,&LWORK,&INFO);
+      LWORK = std::max((int) D,1);
+      WORK.resize(LWORK);
+    }
+
+    long J = 0;
+    for (long j=0;j<M && it<MAXIT;j++)
+    {
+      //W = A.PRECOND(V_j), in V_j+1
+      const long K = (j+1)*S;
+      double* W = V.data()+K*N;
+      krylov_precond(N,S,PRECOND,V.data()+j*S*N,TMP.data());
+      OP(S,TMP.data(),W);
+      it++;
+
+      //two passes of block Gram-Schmidt against V_0..V_j, then W = V_j+1 H_j+1,j
+      double* HJ = H.data()+j*S*LDH;
+      for (int pass=0;pass<2;pass++)
+      {
+        krylov_AtB(N,K,S,V.data(),W,HC.data());
+        krylov_AB(N,S,K,-1.0,V.data(),HC.data(),1.0,W);
+        for (long l=0;l<S;l++) simd_axpy<double>(K,1.0,HC.data()+l*K,HJ+l*LDH);
+      }
+      linal_dtsqr(N,S,W,N,HJ+K,LDH);
+
+      //the least squares problem of the j+1 blocks
+      int MM = K+S, NN = K, NR = S;
+      for (long l=0;l<K;l++) std::copy(H.data()+l*LDH,H.data()+l*LDH+MM,HH.data()+l*MM);
+      std::fill(E.begin(),E.end(),0.0);
+      for (long l=0;l<S;l++) std::copy(S0.data()+l*S,S0.data()+(l+1)*S,E.data()+l*MM);
+      dgels_(&TRANS,&MM,&NN,&NR,HH.data(),&MM,E.data(),&MM,WORK.data(),&LWORK,&INFO);
+      if (INFO != 0) break;
+      J = j+1;
+      bool done = true;
+      for (long l=0;l<S;l++)
+      {
+        std::copy(E.data()+l*MM,E.data()+l*MM+K,Y.data()+l*K);
+        const double* e = E.data()+l*MM+K;
+        const double res = sqrt(simd_dot<double>(S,e,e))/bnorm[act[l]];
+        if (res > TOL) done = false;
+      }
+      if (done) break;
+    }
+    if (J == 0) break;
+
+    //X += PRECOND(V.Y)
+    krylov_AB(N,S,J*S,1.0,V.data(),Y.data(),0.0,R.data());
+    krylov_precond(N,S,PRECOND,R.data(),TMP.data());
+    for (long l=0;l<S;l++) simd_axpy<double>(N,1.0,TMP.data()+l*N,X+act[l]*N);
+  }
+
+  if (RNORM != NULL) std::copy(rnorm.begin(),rnorm.end(),RNORM);
+  return act.empty() ? it : -1;
+}
+
+}//end of namespace
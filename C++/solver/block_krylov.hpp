@@ -0,0 +1,87 @@
+/*----------------------------------------------------------------------------
+  block_krylov.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for the block Krylov solvers of the linear equations
+
+    A . X = B
+
+  for NRHS right hand sides at once, with A only known through its
+  products with blocks of vectors,
+
+    OP(NV,X,Y)        //Y = A.X, with X and Y N x NV (column major)
+
+  which is called with every vector of the block at once, so each pass
+  over A (or its integrals) does NV products, as a gemm. The optional
+  preconditioner has the same form, PRECOND(NV,R,Z) for Z ~ A^-1.R.
+  X is the guess on entry (e.g., zero), and the solution on exit.
+
+  block_cg    : A symmetric positive definite (and PRECOND, if given).
+    The breakdown free block CG (Ji and Li, arXiv:1502.04180), which is
+    O'Leary's block CG with the search directions orthonormalized at
+    every step, and the dependent ones dropped, so the block can lose
+    directions (RHS that are, or become, linearly dependent) without
+    breaking down
+
+      Q     = A.P
+      alpha = (P^T.Q)^-1 P^T.R,     X += P.alpha,  R -= Q.alpha
+      Z     = PRECOND(R)
+      beta  = -(P^T.Q)^-1 Q^T.Z,    P  = orth(Z + P.beta)
+
+  block_gmres : any A. Block GMRES(RESTART), right preconditioned. Each
+    cycle builds a block Arnoldi basis V of RESTART blocks (orthogonalized
+    with two passes of block Gram-Schmidt, as two gemms against all of V,
+    and then the TSQR of linal_tsqr.hpp), and solves the small least
+    squares problem (dgels) after each block, which gives the residual of
+    every RHS without forming it. The cycle stops once all are converged,
+    and X += PRECOND(V.Y). The basis is (RESTART+1)*NRHS vectors of N in
+    memory.
+
+  Each RHS is converged when |B_j - A.X_j| <= TOL*|B_j|, and is then
+  deflated: its column of X is kept, and it is dropped from the block,
+  so the block shrinks as the RHS converge (in block_gmres, at the next
+  restart). The products of the tall blocks are linal_ABpC and
+  linal_ATBpC over chunks of rows, in parallel.
+
+  The return is the number of iterations, i.e., calls of OP on a block
+  of directions (not counting those for the residuals B - A.X, at the
+  start and at each restart), or -1 if not every RHS converged within
+  MAXIT (or the block broke down). RNORM (if not NULL) gets the relative
+  residual of each RHS.
+
+    auto op = [&](const long NV, const double* X, double* Y) {...};
+    int it = libj::block_cg(N,NRHS,op,B,X,1.e-8,200,precond);
+    int it = libj::block_gmres(N,NRHS,op,B,X,1.e-8,400,20);
+----------------------------------------------------------------------------*/
+#ifndef LIBJ_BLOCK_KRYLOV_HPP
+#define LIBJ_BLOCK_KRYLOV_HPP
+
+#include <cstddef>
+#include <functional>
+
+//smallest norm of a direction, relative to the largest, in block_cg
+#if !defined (LIBJ_KRYLOV_DROP)
+  #define LIBJ_KRYLOV_DROP 1.0e-6
+#endif
+
+//rows of the tall blocks per thread, at least, in the products
+#if !defined (LIBJ_KRYLOV_ROWS)
+  #define LIBJ_KRYLOV_ROWS 4096
+#endif
+
+namespace libj
+{
+
+typedef std::function<void(const long NV, const double* X, double* Y)> krylov_op;
+
+int block_cg(const long N, const long NRHS, const krylov_op& OP, const double* B,
+             double* X, const double TOL, const int MAXIT,
+             const krylov_op& PRECOND = krylov_op(), double* RNORM = NULL);
+
+int block_gmres(const long N, const long NRHS, const krylov_op& OP, const double* B,
+                double* X, const double TOL, const int MAXIT, const int RESTART = 20,
+                const krylov_op& PRECOND = krylov_op(), double* RNORM = NULL);
+
+}//end of namespace
+
+#endif
@@ -0,0 +1,219 @@
+/*----------------------------------------------------------------------------
+  davidson.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for the block Davidson solver, see davidson.hpp
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+#include "davidson.hpp"
+#include "simd.hpp"
+#include "linal_ATBpC.hpp"
+#include "linal_decomp.hpp"
+#include "core.hpp"
+
+namespace libj
+{
+
+/*----------------------------------------------------------------------------
+  davidson_error
+----------------------------------------------------------------------------*/
+static void davidson_error(const char* msg)
+{
+  printf("ERROR libj::davidson \n");
+  printf("%s \n",msg);
+  exit(1);
+}
+
+/*----------------------------------------------------------------------------
+  davidson_ortho
+	orthonormalize the NT vectors of T against the first M of B, and
+	each other, twice (classical Gram-Schmidt for B, which is streamed
+	once per pass, modified within T). Vectors with less than
+	LIBJ_DAVIDSON_DROP of their norm left are dropped, and the rest
+	moved to the front. Returns the number kept
+----------------------------------------------------------------------------*/
+static long davidson_ortho(const long N, double* T, const long NT, libj::vec_store& B,
+                           const long M)
+{
+  std::vector<double> nrm0(NT);
+  std::vector<char> keep(NT,1);
+  for (long j=0;j<NT;j++) nrm0[j] = sqrt(simd_dot<double>(N,T+j*N,T+j*N));
+
+  for (int pass=0;pass<2;pass++)
+  {
+    for (long i=0;i<M;i++)
+    {
+      const double* b = B.pin(i);
+      for (long j=0;j<NT;j++)
+      {
+        if (!keep[j]) continue;
+        const double c = simd_dot<double>(N,b,T+j*N);
+        simd_axpy<double>(N,-c,b,T+j*N);
+      }
+      B.unpin(i);
+    }
+    for (long j=0;j<NT;j++)
+    {
+      if (!keep[j]) continue;
+      double* t = T+j*N;
+      for (long l=0;l<j;l++)
+      {
+        if (!keep[l]) continue;
+        const double c = simd_dot<double>(N,T+l*N,t);
+        simd_axpy<double>(N,-c,T+l*N,t);
+      }
+      const double nrm = sqrt(simd_dot<double>(N,t,t));
+      if (nrm <= LIBJ_DAVIDSON_DROP*nrm0[j] || nrm == 0.0) {keep[j] = 0; continue;}
+      simd_scal_mul<double>(N,1.0/nrm,t);
+    }
+  }
+
+  long nk = 0;
+  for (long j=0;j<NT;j++)
+  {
+    if (!keep[j]) continue;
+    if (nk != j) std::copy(T+j*N,T+(j+1)*N,T+nk*N);
+    nk++;
+  }
+  return nk;
+}
+
+/*----------------------------------------------------------------------------
+  davidson
+	G is the projected matrix, MMAX x MMAX, of which the first M x M
+	are used. The Ritz vectors are built in EVEC, and their sigma
+	vectors in SX
+----------------------------------------------------------------------------*/
+int davidson(const long N, const long NROOT, const davidson_sigma& SIGMA,
+             const double* DIAG, libj::vec_store& B, libj::vec_store& S,
+             double* EVAL, double* EVEC, const double TOL, const int MAXIT,
+             const bool GUESS, double* RNORM)
+{
+  if (N < 1 || NROOT < 1 || NROOT > N) {davidson_error("bad N or NROOT");}
+  if (B.size() != N || S.size() != N) {davidson_error("B and S do not hold vectors of N");}
+  const long MMAX = std::min(std::min(B.num(),S.num()),N);
+  if (MMAX < std::min(2*NROOT,N)) {davidson_error("B and S must hold at least 2*NROOT vectors");}
+
+  std::vector<double> T(N*NROOT), ST(N*NROOT), SX(N*NROOT), R(N*NROOT);
+  std::vector<double> G(MMAX*MMAX,0.0), Y(MMAX*MMAX), W(MMAX), TT(NROOT*NROOT);
+  std::vector<double> rnorm(NROOT,0.0);
+  Core<double> CORE(linal_dsyevd_NWORK(MMAX));
+
+  //the guess, or the unit vectors of the smallest diagonals
+  if (GUESS)
+  {
+    std::copy(EVEC,EVEC+N*NROOT,T.data());
+  } else {
+    std::vector<long> order(N);
+    std::iota(order.begin(),order.end(),0);
+    std::partial_sort(order.begin(),order.begin()+NROOT,order.end(),
+                      [DIAG](const long a, const long b) {return DIAG[a] < DIAG[b];});
+    for (long k=0;k<NROOT;k++) T[order[k]+k*N] = 1.0;
+  }
+
+  long nt = NROOT;
+  long m  = 0;
+  for (int it=0;it<MAXIT;it++)
+  {
+    //1) new vectors
+    nt = davidson_ortho(N,T.data(),nt,B,m);
+    if (nt == 0) break;
+
+    //2) their sigma vectors, and the new rows of G
+    SIGMA(nt,T.data(),ST.data());
+    for (long j=0;j<nt;j++)
+    {
+      B.put(m+j,T.data()+j*N);
+      S.put(m+j,ST.data()+j*N);
+    }
+    for (long i=0;i<m;i++)
+    {
+      const double* b = B.pin(i);
+      for (long j=0;j<nt;j++)
+      {
+        const double g = simd_dot<double>(N,b,ST.data()+j*N);
+        G[i+(m+j)*MMAX] = g;
+        G[(m+j)+i*MMAX] = g;
+      }
+      B.unpin(i);
+    }
+    linal_ATBpC<double>(nt,nt,N,1.0,T.data(),ST.data(),0.0,TT.data());
+    for (long j=0;j<nt;j++)
+    {
+      for (long l=0;l<nt;l++) G[(m+l)+(m+j)*MMAX] = 0.5*(TT[l+j*nt] + TT[j+l*nt]);
+    }
+    m += nt;
+
+    //3) the Ritz pairs and residuals
+    for (long j=0;j<m;j++) std::copy(G.data()+j*MMAX,G.data()+j*MMAX+m,Y.data()+j*m);
+    int INFO = 0;
+    linal_dsyevd(m,Y.data(),W.data(),CORE,INFO);
+    if (INFO != 0) {davidson_error("linal_dsyevd of the projected matrix failed");}
+    const long nr = std::min(NROOT,m);
+
+    std::fill(EVEC,EVEC+N*NROOT,0.0);
+    std::fill(SX.begin(),SX.end(),0.0);
+    for (long i=0;i<m;i++)
+    {
+      const double* b = B.pin(i);
+      const double* s = S.pin(i);
+      for (long k=0;k<nr;k++)
+      {
+        simd_axpy<double>(N,Y[i+k*m],b,EVEC+k*N);
+        simd_axpy<double>(N,Y[i+k*m],s,SX.data()+k*N);
+      }
+      S.unpin(i);
+      B.unpin(i);
+    }
+
+    bool done = (nr == NROOT);
+    for (long k=0;k<nr;k++)
+    {
+      double* r = R.data()+k*N;
+      std::copy(SX.data()+k*N,SX.data()+(k+1)*N,r);
+      simd_axpy<double>(N,-W[k],EVEC+k*N,r);
+      rnorm[k] = sqrt(simd_dot<double>(N,r,r));
+      EVAL[k] = W[k];
+      if (rnorm[k] > TOL) done = false;
+    }
+    if (RNORM != NULL) std::copy(rnorm.begin(),rnorm.end(),RNORM);
+    if (done) return it+1;
+
+    //4) the preconditioned residuals of the roots left
+    nt = 0;
+    for (long k=0;k<nr;k++)
+    {
+      if (rnorm[k] <= TOL) continue;
+      const double* r = R.data()+k*N;
+      double* t = T.data()+nt*N;
+      for (long i=0;i<N;i++)
+      {
+        double d = W[k] - DIAG[i];
+        if (fabs(d) < LIBJ_DAVIDSON_SHIFT) d = (d < 0) ? -LIBJ_DAVIDSON_SHIFT : LIBJ_DAVIDSON_SHIFT;
+        t[i] = r[i]/d;
+      }
+      nt++;
+    }
+
+    //collapse onto the Ritz vectors
+    if (m + nt > MMAX)
+    {
+      for (long k=0;k<nr;k++)
+      {
+        B.put(k,EVEC+k*N);
+        S.put(k,SX.data()+k*N);
+      }
+      std::fill(G.begin(),G.end(),0.0);
+      for (long k=0;k<nr;k++) G[k+k*MMAX] = W[k];
+      m = nr;
+    }
+  }
+  return -1;
+}
+
+}//end of namespace
@@ -0,0 +1,71 @@
+/*----------------------------------------------------------------------------
+  davidson.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for the block Davidson solver, for the lowest NROOT
+  eigenpairs of a large symmetric matrix H that is only known through
+  its products with vectors, the sigma vectors
+
+    SIGMA(NV,X,S)  //S = H.X, with X and S N x NV (column major)
+
+  which is called once per iteration, with the block of new vectors.
+  The subspace vectors b_i and their sigma vectors s_i are stored in two
+  vec_stores (see vec_store.hpp), in memory or through Pdata/Pfile, and
+  only O(N NROOT) more is kept in memory. Each iteration :
+
+    1) the new vectors are orthonormalized against the b_i (twice), and
+       those with nothing left are dropped
+    2) their sigma vectors are made and stored, and the new rows of the
+       projected matrix G(i,j) = b_i.s_j added (simd_dot, linal_ATBpC)
+    3) G is diagonalized (linal_dsyevd), and the Ritz vectors and
+       residuals made in one pass over the b_i and s_i (simd_axpy)
+
+         x_k = sum_i y_ik b_i,  r_k = sum_i y_ik s_i - l_k x_k
+
+    4) the roots with |r_k| > TOL get the new vector
+       (l_k - DIAG)^-1 r_k, as in Davidson's preconditioner
+
+  When the subspace would be larger than the stores, it is collapsed
+  onto the Ritz vectors (and their sigma vectors), which keeps the
+  vectors of the lowest roots. B and S must hold at least 2*NROOT.
+
+  EVEC (N x NROOT) is, on entry, the guess if GUESS is true (else the
+  unit vectors of the smallest DIAG are used), and on exit the Ritz
+  vectors, with their values in EVAL. The return is the number of
+  iterations, or -1 if not all of the roots converged in MAXIT, or if
+  the subspace stopped growing. RNORM (if not NULL) gets the |r_k|.
+
+    libj::vec_store B, S;
+    B.init(pworld,pdata,pfile,fid,100,N,40);
+    S.init(pworld,pdata,pfile,fid,101,N,40);
+    int it = libj::davidson(N,4,sigma,diag,B,S,eval,evec,1.e-6,100);
+----------------------------------------------------------------------------*/
+#ifndef LIBJ_DAVIDSON_HPP
+#define LIBJ_DAVIDSON_HPP
+
+#include <functional>
+#include "vec_store.hpp"
+
+//smallest norm of a new vector, after it is orthogonalized
+#if !defined (LIBJ_DAVIDSON_DROP)
+  #define LIBJ_DAVIDSON_DROP 1.0e-8
+#endif
+
+//smallest |l_k - DIAG| in the preconditioner
+#if !defined (LIBJ_DAVIDSON_SHIFT)
+  #define LIBJ_DAVIDSON_SHIFT 1.0e-6
+#endif
+
+namespace libj
+{
+
+typedef std::function<void(const long NV, const double* X, double* S)> davidson_sigma;
+
+int davidson(const long N, const long NROOT, const davidson_sigma& SIGMA,
+             const double* DIAG, libj::vec_store& B, libj::vec_store& S,
+             double* EVAL, double* EVEC, const double TOL, const int MAXIT,
+             const bool GUESS = false, double* RNORM = NULL);
+
+}//end of namespace
+
+#endif
@@ -0,0 +1,153 @@
+/*----------------------------------------------------------------------------
+  diis.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for diis, see diis.hpp
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include "diis.hpp"
+#include "simd.hpp"
+#include "linal_solve.hpp"
+#include "core.hpp"
+
+namespace libj
+{
+
+/*----------------------------------------------------------------------------
+  constructor
+----------------------------------------------------------------------------*/
+diis::diis(libj::vec_store& AMP, libj::vec_store& ERR)
+{
+  M_AMP = &AMP;
+  M_ERR = &ERR;
+  M_MAX = std::min(AMP.num(),ERR.num());
+  if (M_MAX < 1)
+  {
+    printf("ERROR libj::diis::diis \n");
+    printf("the stores have no vectors \n");
+    exit(1);
+  }
+  reset();
+}
+
+/*----------------------------------------------------------------------------
+  reset
+----------------------------------------------------------------------------*/
+void diis::reset()
+{
+  M_NVEC  = 0;
+  M_COUNT = 0;
+  M_B.assign(M_MAX*M_MAX,0.0);
+  M_AGE.assign(M_MAX,-1);
+  M_COEF.clear();
+}
+
+/*----------------------------------------------------------------------------
+  m_slots
+----------------------------------------------------------------------------*/
+std::vector<long> diis::m_slots() const
+{
+  std::vector<long> slots;
+  for (long s=0;s<M_MAX;s++) {if (M_AGE[s] >= 0) slots.push_back(s);}
+  std::sort(slots.begin(),slots.end(),
+            [this](const long a, const long b) {return M_AGE[a] < M_AGE[b];});
+  return slots;
+}
+
+/*----------------------------------------------------------------------------
+  extrapolate
+	the new vectors go in an empty slot, or that of the oldest, and
+	their row of B is the dots of E with the stored errors
+----------------------------------------------------------------------------*/
+long diis::extrapolate(double* T, const double* E)
+{
+  const long NT = M_AMP->size();
+  const long NE = M_ERR->size();
+
+  long s = -1;
+  for (long i=0;i<M_MAX;i++) {if (M_AGE[i] < 0) {s = i; break;}}
+  if (s < 0)
+  {
+    s = 0;
+    for (long i=1;i<M_MAX;i++) {if (M_AGE[i] < M_AGE[s]) s = i;}
+    M_AGE[s] = -1;
+    M_NVEC--;
+  }
+  M_AMP->put(s,T);
+  M_ERR->put(s,E);
+
+  for (long i=0;i<M_MAX;i++)
+  {
+    if (M_AGE[i] < 0 || i == s) continue;
+    const double* e = M_ERR->pin(i);
+    const double b = simd_dot<double>(NE,E,e);
+    M_ERR->unpin(i);
+    M_B[i+s*M_MAX] = b;
+    M_B[s+i*M_MAX] = b;
+  }
+  M_B[s+s*M_MAX] = simd_dot<double>(NE,E,E);
+  M_AGE[s] = M_COUNT++;
+  M_NVEC++;
+
+  //solve, dropping the oldest vectors while it is singular
+  std::vector<long> slots = m_slots();
+  std::vector<double> coef;
+  while (true)
+  {
+    const long m = (long) slots.size();
+    double scale = 0;
+    for (long i=0;i<m;i++) scale = std::max(scale,M_B[slots[i]+slots[i]*M_MAX]);
+    if (m == 1 || scale <= 0.0)
+    {
+      coef.assign(m,0.0);
+      coef[m-1] = 1.0;
+      break;
+    }
+
+    const long M1 = m+1;
+    std::vector<double> A(M1*M1,0.0), RHS(M1,0.0), X(M1,0.0);
+    for (long j=0;j<m;j++)
+    {
+      for (long i=0;i<m;i++) A[i+j*M1] = M_B[slots[i]+slots[j]*M_MAX]/scale;
+      A[m+j*M1] = 1.0;
+      A[j+m*M1] = 1.0;
+    }
+    RHS[m] = 1.0;
+    Core<double> CORE(linal_dsolve_NWORK(M1,1));
+    int ITER = 0, INFO = 0;
+    linal_dsolve(M1,1,A.data(),RHS.data(),X.data(),CORE,ITER,INFO);
+
+    bool ok = (INFO == 0);
+    for (long i=0;i<m && ok;i++) ok = std::isfinite(X[i]);
+    if (ok)
+    {
+      coef.assign(X.begin(),X.begin()+m);
+      break;
+    }
+    M_AGE[slots[0]] = -1;
+    M_NVEC--;
+    slots.erase(slots.begin());
+  }
+
+  //T = sum_i c_i t_i
+  const long m = (long) slots.size();
+  if (m > 1)
+  {
+    std::fill(T,T+NT,0.0);
+    for (long i=0;i<m;i++)
+    {
+      const double* t = M_AMP->pin(slots[i]);
+      simd_axpy<double>(NT,coef[i],t,T);
+      M_AMP->unpin(slots[i]);
+    }
+  }
+  M_COEF = coef;
+  return m;
+}
+
+}//end of namespace
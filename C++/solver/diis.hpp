@@ -0,0 +1,79 @@
+/*----------------------------------------------------------------------------
+  diis.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for diis, Pulay's direct inversion in the iterative subspace
+  (Chem. Phys. Lett. 73, 393 (1980)), for the amplitude equations. Each
+  iteration gives the new amplitudes t_i and their error e_i (e.g., the
+  residual, or t_i - t_{i-1}), and gets back the extrapolation
+
+    t = sum_i c_i t_i,  sum_i c_i = 1
+
+  with c minimizing |sum_i c_i e_i|, from
+
+    | B  1 | | c |   | 0 |
+    | 1  0 | | l | = | 1 |,  B_ij = e_i.e_j
+
+  The histories are two vec_stores (see vec_store.hpp), in memory or
+  through Pdata/Pfile, so only the current t and e are kept in memory.
+  B is kept between iterations, and a new vector only needs its own row,
+  one pass over the stored errors with simd_dot. Once the stores are
+  full, the oldest vector is replaced. The system is solved with
+  linal_dsolve, with B scaled by its largest diagonal, and if it is
+  singular the oldest vectors are dropped until it is not.
+
+    libj::vec_store T, E;
+    T.init(pworld,pdata,pfile,fid,200,NT,8);
+    E.init(pworld,pdata,pfile,fid,201,NE,8);
+    libj::diis D(T,E);
+    for (...) { update t, e ; D.extrapolate(t,e); }
+
+    D.extrapolate(t,e);		//add t,e and replace t by the extrapolation
+    D.size();			//vectors in the history
+    D.coefficients();		//c_i of the last extrapolation, oldest first
+    D.reset();			//forget the history
+----------------------------------------------------------------------------*/
+#ifndef LIBJ_DIIS_HPP
+#define LIBJ_DIIS_HPP
+
+#include <vector>
+#include "vec_store.hpp"
+
+namespace libj
+{
+
+class diis
+{
+  private:
+  libj::vec_store*    M_AMP;   //amplitudes t_i
+  libj::vec_store*    M_ERR;   //errors e_i
+  long                M_MAX;   //slots in the history
+  long                M_NVEC;  //vectors in the history
+  long                M_COUNT; //vectors added since reset
+  std::vector<double> M_B;     //e_i.e_j of the slots, M_MAX x M_MAX
+  std::vector<long>   M_AGE;   //when each slot was added, -1 if empty
+  std::vector<double> M_COEF;  //last coefficients, oldest first
+
+  //slots in the history, oldest first
+  std::vector<long> m_slots() const;
+
+  public:
+  diis(libj::vec_store& AMP, libj::vec_store& ERR);
+
+  //no copies, the stores are shared
+  diis(const diis& other) = delete;
+  diis& operator= (const diis& other) = delete;
+
+  void reset();
+
+  //add T and E to the history, and replace T by the extrapolation.
+  //  Returns the number of vectors used
+  long extrapolate(double* T, const double* E);
+
+  long size() const {return M_NVEC;}
+  const std::vector<double>& coefficients() const {return M_COEF;}
+};
+
+}//end of namespace
+
+#endif
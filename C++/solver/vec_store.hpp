@@ -0,0 +1,142 @@
+/*----------------------------------------------------------------------------
+  vec_store.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for vec_store, a numbered set of vectors of N doubles, for the
+  subspaces and histories of the iterative solvers (davidson.hpp and
+  diis.hpp). The vectors are either plain memory, or the indexes of a Pdata
+  list in a Pfile, pinned in the Pdata block cache as they are used. Those
+  stay in memory while the cache has room, and are written to the file and
+  read back when it does not, so the solvers are the same either way.
+
+  The Pdata vectors are for the task that does the IO (see pdata.hpp),
+  and the cache must be set with Pdata::cache_init. Vector k is at
+  file_pos + k*N*sizeof(double) of file_id.
+
+  Initialization
+  -------------------
+    libj::vec_store B;
+    B.init(N,NVEC);                                   //in memory
+    B.init(pworld,pdata,pfile,fid,tag,N,NVEC);        //through Pdata
+
+  Access
+  -------------------
+  Every pin must be matched by an unpin
+    const double* b = B.pin(k);		//read vector k
+    double* b = B.pin_new(k);		//vector k, to be overwritten
+    double* b = B.pin_update(k);	//vector k, to be changed
+    B.unpin(k);				//done with a pin
+    B.unpin(k,true);			//done, and it was changed
+    B.put(k,x); B.get(k,x);		//copies
+    B.size(); B.num();			//N, NVEC
+    B.flush();				//write back the changed vectors
+----------------------------------------------------------------------------*/
+#ifndef LIBJ_VEC_STORE_HPP
+#define LIBJ_VEC_STORE_HPP
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <vector>
+#include "pworld.hpp"
+#include "pfile.hpp"
+#include "pdata.hpp"
+
+namespace libj
+{
+
+class vec_store
+{
+  private:
+  long                M_N;      //elements of a vector
+  long                M_NVEC;   //number of vectors
+  std::vector<double> M_MEM;    //the vectors, in memory
+  Pdata*              M_PDATA;  //the list, or NULL for memory
+  Pfile*              M_PFILE;  //file of the list
+  long                M_LIST;   //list id
+
+  void m_error(const char* fn, const char* msg, const long k) const
+  {
+    printf("ERROR libj::vec_store::%s \n",fn);
+    printf("%s, vector %ld of %ld \n",msg,k,M_NVEC);
+    exit(1);
+  }
+
+  double* m_pin(const long k, const bool read)
+  {
+    if (k < 0 || k >= M_NVEC) m_error("pin","vector does not exist",k);
+    if (M_PDATA == NULL) return M_MEM.data() + k*M_N;
+    double* x = (double*) M_PDATA->pin(*M_PFILE,M_LIST,k,read);
+    if (x == NULL) m_error("pin","could not pin the vector",k);
+    return x;
+  }
+
+  public:
+  vec_store() : M_N(0), M_NVEC(0), M_PDATA(NULL), M_PFILE(NULL), M_LIST(-1) {}
+
+  //no copies, the Pdata list is not
+  vec_store(const vec_store& other) = delete;
+  vec_store& operator= (const vec_store& other) = delete;
+
+  void init(const long N, const long NVEC)
+  {
+    M_N     = N;
+    M_NVEC  = NVEC;
+    M_PDATA = NULL;
+    M_PFILE = NULL;
+    M_LIST  = -1;
+    M_MEM.assign(N*NVEC,0.0);
+  }
+
+  void init(const Pworld& pworld, Pdata& pdata, Pfile& pfile, const int file_id,
+            const long list_tag, const long N, const long NVEC, const long file_pos = 0)
+  {
+    M_N     = N;
+    M_NVEC  = NVEC;
+    M_PDATA = &pdata;
+    M_PFILE = &pfile;
+    M_MEM.clear();
+    M_LIST  = pdata.add_list(list_tag,file_id,sizeof(double));
+    for (long k=0;k<NVEC;k++)
+    {
+      pdata.add_index(M_LIST,pworld.mpi_world_task_id,file_pos + k*N*(long) sizeof(double),N);
+    }
+  }
+
+  long size() const {return M_N;}
+  long num() const {return M_NVEC;}
+  bool in_memory() const {return M_PDATA == NULL;}
+
+  const double* pin(const long k) {return m_pin(k,true);}
+  double* pin_new(const long k) {return m_pin(k,false);}
+  double* pin_update(const long k) {return m_pin(k,true);}
+
+  void unpin(const long k, const bool dirty = false)
+  {
+    if (M_PDATA == NULL) return;
+    if (M_PDATA->unpin(*M_PFILE,M_LIST,k,dirty) != 0) m_error("unpin","could not unpin the vector",k);
+  }
+
+  void put(const long k, const double* x)
+  {
+    double* y = pin_new(k);
+    std::copy(x,x+M_N,y);
+    unpin(k,true);
+  }
+
+  void get(const long k, double* x)
+  {
+    const double* y = pin(k);
+    std::copy(y,y+M_N,x);
+    unpin(k);
+  }
+
+  void flush()
+  {
+    if (M_PDATA != NULL && M_PDATA->flush_cache(*M_PFILE) != 0) m_error("flush","could not write back",0);
+  }
+};
+
+}//end of namespace
+
+#endif
@@ -2,6 +2,7 @@
   block_scatter_matrix2.hpp
 	JHT, April 29, 2022 : created
     JHt, May 17, 2022   : changed to std::array
+	JHT, October 14, 2026 : added pack_rows and pack_cols
 
   .hpp file for the block_scatter_matrix2 class, which is used to access a 
   tensor_matrix2 in an out-of-order fashion.
@@ -24,6 +25,22 @@
   T.block_stride(dim,block);	//stride of block "block" in dimension "dim"
   T.next_block_index(dim,index);//returns the starting index of the next block
 
+  The block strides are over the rows and cols of the block that are in the
+  tensor_matrix2, so a block cut short by the end of the matrix still has
+  the stride of its rows.
+
+  Packing:
+  T.pack_rows(block,MB,NC,P);	//P[j*RBL+r] = T(block*RBL+r,j), r < MB, 
+				//  j < NC, zero for MB <= r < RBL
+  T.pack_cols(block,NR,NC,P);	//P[i*CBL+c] = T(i,block*CBL+c), i < NR, 
+				//  c < NC, zero for NC <= c < CBL
+
+  Each is picked per block from its strides: a block of stride 1 is copied 
+  as lines (vector loads), a block of constant stride is read with that 
+  stride, and only an irregular block is gathered through the scatter 
+  vectors. pack_rows gives the micro-panels of A of a gemm-like kernel with 
+  MR = RBL, and pack_cols those of B with NR = CBL.
+
 ----------------------------------------------------------------------------*/
 #ifndef BLOCK_SCATTER_MATRIX2_HPP
 #define BLOCK_SCATTER_MATRIX2_HPP
@@ -58,6 +75,8 @@ class block_scatter_matrix2
   std::array<size_t,NCOL>    M_CSCAT;   //col scatter vector
   std::array<size_t,M_NRB>   M_RBS;		//row block scatter vector
   std::array<size_t,M_NCB>   M_CBS;     //column block scatter vector
+  size_t                     M_NRV;     //rows in the tensor_matrix2
+  size_t                     M_NCV;     //cols in the tensor_matrix2
   bool                       M_SEQ;     //bool tracking if is sequential
 
   //internal functions
@@ -130,6 +149,10 @@ class block_scatter_matrix2
   T* data() {return M_BUFFER;}
   const T* data() const {return M_BUFFER;}
 
+  //packing
+  void pack_rows(const size_t block, const size_t MB, const size_t NC, T* P) const;
+  void pack_cols(const size_t block, const size_t NR, const size_t NC, T* P) const;
+
 };//end of class
 
 //------------------------------------------------------------------------
@@ -186,6 +209,9 @@ void block_scatter_matrix2<T,NROW,NCOL,RBL,CBL>::m_set_scatter(
                             const libj::tensor_matrix2<T,NLHS,NRHS>& TMAT) 
 {
   
+  M_NRV = std::min(NROW,TMAT.size(0));
+  M_NCV = std::min(NCOL,TMAT.size(1));
+
   //set the row scatter vector
   const size_t off00 = TMAT.offset(0,0);
   for (size_t I=0;I<NROW;I++)
@@ -206,7 +232,8 @@ void block_scatter_matrix2<T,NROW,NCOL,RBL,CBL>::m_set_scatter(
 
 //------------------------------------------------------------------------
 // m_set_block
-//	sets the blocking sizes based on the scatter vectors
+//	sets the blocking sizes based on the scatter vectors, over the rows
+//	and cols in the tensor_matrix2
 //------------------------------------------------------------------------
 template <typename T, size_t NROW, size_t NCOL, size_t RBL, size_t CBL>
 inline void block_scatter_matrix2<T,NROW,NCOL,RBL,CBL>::m_set_block()
@@ -216,10 +243,10 @@ inline void block_scatter_matrix2<T,NROW,NCOL,RBL,CBL>::m_set_block()
   for (size_t block=0; block < M_NRB; block++)
   {
     //determine row strides
-    const size_t end = std::min(NROW,(block+1)*RBL);
+    const size_t end = std::min(M_NRV,(block+1)*RBL);
     const size_t start = block*RBL;
     size_t stride;
-    if (end - start > 1)
+    if (end > start + 1)
     {
       stride = M_RSCAT[start+1] - M_RSCAT[start];
       for (size_t I = start + 2; I < end ; I++)
@@ -245,9 +272,9 @@ inline void block_scatter_matrix2<T,NROW,NCOL,RBL,CBL>::m_set_block()
   {
     //determine col strides
     size_t stride;
-    const size_t end = std::min(NCOL,(block+1)*CBL);
+    const size_t end = std::min(M_NCV,(block+1)*CBL);
     const size_t start = block*CBL;
-    if (end - start > 1)
+    if (end > start + 1)
     {
       stride = M_CSCAT[start+1] - M_CSCAT[start];
       for (size_t J = start + 2; J < end ; J++)
@@ -284,6 +311,9 @@ inline void block_scatter_matrix2<T, NROW, NCOL, RBL, CBL>::assign_to_block(
   //assign the buffer
   M_BUFFER = const_cast<T*>(&TMAT(ROW,COL)); 
 
+  M_NRV = (ROW < TMAT.size(0)) ? std::min(NROW,TMAT.size(0)-ROW) : 0;
+  M_NCV = (COL < TMAT.size(1)) ? std::min(NCOL,TMAT.size(1)-COL) : 0;
+
   //now, set the scatter vectors
   const size_t off00 = TMAT.offset(ROW,COL);
   M_RSCAT[0] = 0;
@@ -295,6 +325,91 @@ inline void block_scatter_matrix2<T, NROW, NCOL, RBL, CBL>::assign_to_block(
   m_set_block();
 }
 
+//------------------------------------------------------------------------
+// pack_rows
+//   packs rows 0:MB of row block "block" and cols 0:NC into P[j*RBL+r],
+//   zero padded for MB <= r < RBL. MB <= RBL
+//------------------------------------------------------------------------
+template <typename T,size_t NROW, size_t NCOL, size_t RBL, size_t CBL>
+inline void block_scatter_matrix2<T, NROW, NCOL, RBL, CBL>::pack_rows(
+                  const size_t block, const size_t MB, const size_t NC, T* P) const
+{
+  const size_t  row    = block*RBL;
+  const size_t  stride = M_RBS[block];
+  const T*      A      = M_BUFFER + M_RSCAT[row];
+  if (MB == RBL && stride == 1)
+  {
+    for (size_t j=0;j<NC;j++)
+    {
+      const T* a = A + M_CSCAT[j];
+      for (size_t r=0;r<RBL;r++) P[j*RBL+r] = a[r];
+    }
+    return;
+  } 
+  for (size_t j=0;j<NC;j++)
+  {
+    const T* a = A + M_CSCAT[j];
+    T*       p = P + j*RBL;
+    if (stride == 1) {
+      for (size_t r=0;r<MB;r++) p[r] = a[r];
+    } else if (stride > 0) {
+      for (size_t r=0;r<MB;r++) p[r] = a[r*stride];
+    } else {
+      const T* b = M_BUFFER + M_CSCAT[j];
+      for (size_t r=0;r<MB;r++) p[r] = b[M_RSCAT[row+r]];
+    }
+    for (size_t r=MB;r<RBL;r++) p[r] = (T) 0;
+  }
+}
+
+//------------------------------------------------------------------------
+// pack_cols
+//   packs rows 0:NR and cols 0:NC of col block "block" into P[i*CBL+c],
+//   zero padded for NC <= c < CBL. NC <= CBL
+//
+//   cols of stride 1 are copied a row at a time, otherwise rows of one
+//   constant stride are read a col at a time
+//------------------------------------------------------------------------
+template <typename T,size_t NROW, size_t NCOL, size_t RBL, size_t CBL>
+inline void block_scatter_matrix2<T, NROW, NCOL, RBL, CBL>::pack_cols(
+                  const size_t block, const size_t NR, const size_t NC, T* P) const
+{
+  const size_t col     = block*CBL;
+  const size_t cstride = M_CBS[block];
+  const size_t rstride = (NR <= RBL) ? M_RBS[0] : 0;
+  const T*     B       = M_BUFFER + M_CSCAT[col];
+
+  if (cstride == 1 || (cstride > 0 && rstride == 0))
+  {
+    for (size_t i=0;i<NR;i++)
+    {
+      const T* b = B + M_RSCAT[i];
+      T*       p = P + i*CBL;
+      if (NC == CBL && cstride == 1) {
+        for (size_t c=0;c<CBL;c++) p[c] = b[c];
+      } else {
+        for (size_t c=0;c<NC;c++) p[c] = b[c*cstride];
+        for (size_t c=NC;c<CBL;c++) p[c] = (T) 0;
+      }
+    }
+    return;
+  }
+
+  for (size_t c=0;c<NC;c++)
+  {
+    const T* b = M_BUFFER + M_CSCAT[col+c];
+    if (rstride > 0) {
+      for (size_t i=0;i<NR;i++) P[i*CBL+c] = b[i*rstride];
+    } else {
+      for (size_t i=0;i<NR;i++) P[i*CBL+c] = b[M_RSCAT[i]];
+    }
+  }
+  for (size_t c=NC;c<CBL;c++)
+  {
+    for (size_t i=0;i<NR;i++) P[i*CBL+c] = (T) 0;
+  }
+}
+
 }//end of namespace
 
 #endif
@@ -0,0 +1,213 @@
+/*----------------------------------------------------------------------------
+  block_tensor.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for the block_tensor class, which stores a tensor that is
+  blocked by the irreducible representations (irreps) of an abelian point
+  group, as in a DPD. Each dimension is split into NIRREP irrep blocks, and a
+  block with irreps (h0,h1,...) is only nonzero if
+
+    h0 ^ h1 ^ ... == SYM
+
+  where ^ is the direct product, which is the XOR of the irrep numbers for
+  D2h and all of its subgroups (the irreps must be numbered that way). Only
+  these blocks are stored, each as a libj::tensor assigned into one aligned
+  arena, so the memory is 1/NIRREP of the full tensor. Blocks where some
+  dimension has zero length in that irrep are not stored either.
+
+  Initialization
+  -------------------
+  DIMS[d][h] is the length of dimension d in irrep h
+    std::vector<std::vector<size_t> > DIMS = {{4,2,1,3},{4,2,1,3}};
+    libj::block_tensor<double> F(4,0,DIMS);   //4 irreps, totally symmetric
+
+  Access
+  -------------------
+    F.num_blocks();		//number of stored blocks
+    F.block(b);			//libj::tensor of stored block b
+    F.irreps(b);		//irreps of stored block b
+    F.block_index({1,1});	//stored block with these irreps, -1 if zero
+    F.block({1,1});		//libj::tensor of the block with these irreps
+    F.size();			//number of stored elements, with padding
+    F.data();			//start of the arena
+
+  The contraction of two block_tensors is libj::contract, in jblis_level3
+----------------------------------------------------------------------------*/
+#ifndef BLOCK_TENSOR_HPP
+#define BLOCK_TENSOR_HPP
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <vector>
+#include "libjdef.h"
+#include "tensor.hpp"
+
+namespace libj
+{
+
+template <typename T>
+class block_tensor
+{
+  private:
+  size_t                            M_NIRREP;  //number of irreps
+  size_t                            M_SYM;     //irrep of the tensor
+  size_t                            M_NDIM;    //number of dimensions
+  size_t                            M_NELM;    //number of stored elements
+  std::vector<std::vector<size_t> > M_DIMS;    //length of each dimension and irrep
+  libj::tensor<T>                   M_ARENA;   //memory of all the blocks
+  std::vector<libj::tensor<T> >     M_BLOCKS;  //stored blocks
+  std::vector<std::vector<size_t> > M_IRREPS;  //irreps of the stored blocks
+  std::vector<long>                 M_INDEX;   //stored block of each irrep key, or -1
+
+  //key of the irreps of all but the last dimension, which is fixed by M_SYM
+  size_t m_key(const std::vector<size_t>& irreps) const
+  {
+    size_t key = 0;
+    for (size_t d=M_NDIM-1;d>0;d--) key = key*M_NIRREP + irreps[d-1];
+    return key;
+  }
+
+  //no copies, as the blocks point into the arena
+  block_tensor(const block_tensor<T>& other);
+  block_tensor<T>& operator= (const block_tensor<T>& other);
+
+  public:
+  block_tensor() : M_NIRREP(0), M_SYM(0), M_NDIM(0), M_NELM(0) {}
+  block_tensor(const size_t NIRREP, const size_t SYM,
+               const std::vector<std::vector<size_t> >& DIMS)
+  {
+    M_NDIM = 0;
+    allocate(NIRREP,SYM,DIMS);
+  }
+  void allocate(const size_t NIRREP, const size_t SYM,
+                const std::vector<std::vector<size_t> >& DIMS);
+
+  //getters
+  size_t nirrep() const {return M_NIRREP;}
+  size_t sym() const {return M_SYM;}
+  size_t dim() const {return M_NDIM;}
+  size_t size() const {return M_NELM;}
+  size_t size(const size_t d, const size_t h) const {return M_DIMS[d][h];}
+  size_t num_blocks() const {return M_BLOCKS.size();}
+  T* data() {return M_ARENA.data();}
+  const T* data() const {return M_ARENA.data();}
+
+  //blocks
+  long block_index(const std::vector<size_t>& irreps) const
+  {
+    if (irreps.size() != M_NDIM) return -1;
+    size_t h = 0;
+    for (size_t d=0;d<M_NDIM;d++)
+    {
+      if (irreps[d] >= M_NIRREP) return -1;
+      h ^= irreps[d];
+    }
+    if (h != M_SYM) return -1;
+    return M_INDEX[m_key(irreps)];
+  }
+  bool has_block(const std::vector<size_t>& irreps) const {return block_index(irreps) >= 0;}
+
+  libj::tensor<T>& block(const size_t b) {return M_BLOCKS[b];}
+  const libj::tensor<T>& block(const size_t b) const {return M_BLOCKS[b];}
+  const std::vector<size_t>& irreps(const size_t b) const {return M_IRREPS[b];}
+
+  libj::tensor<T>& block(const std::vector<size_t>& irreps)
+  {
+    const long b = block_index(irreps);
+    if (b < 0)
+    {
+      printf("ERROR libj::block_tensor::block \n");
+      printf("requested block is zero by symmetry \n");
+      exit(1);
+    }
+    return M_BLOCKS[b];
+  }
+  const libj::tensor<T>& block(const std::vector<size_t>& irreps) const
+  {
+    return const_cast<block_tensor<T>*>(this)->block(irreps);
+  }
+
+}; //end of class
+
+//-----------------------------------------------------------------------
+// allocate
+//	find the allowed blocks, and assign each into the arena. Each block
+//	starts on a LIBJ_MAX_ALIGN byte boundary
+//-----------------------------------------------------------------------
+template <typename T>
+void block_tensor<T>::allocate(const size_t NIRREP, const size_t SYM,
+                               const std::vector<std::vector<size_t> >& DIMS)
+{
+  if (M_NDIM != 0)
+  {
+    printf("ERROR libj::block_tensor::allocate \n");
+    printf("block_tensor is already allocated \n");
+    exit(1);
+  }
+  if (DIMS.size() < 1 || NIRREP < 1 || SYM >= NIRREP || (NIRREP & (NIRREP-1)) != 0)
+  {
+    printf("ERROR libj::block_tensor::allocate \n");
+    printf("bad input : ndim = %zu, nirrep = %zu, sym = %zu \n",DIMS.size(),NIRREP,SYM);
+    exit(1);
+  }
+  for (size_t d=0;d<DIMS.size();d++)
+  {
+    if (DIMS[d].size() != NIRREP)
+    {
+      printf("ERROR libj::block_tensor::allocate \n");
+      printf("dimension %zu does not have a length for each irrep \n",d);
+      exit(1);
+    }
+  }
+
+  M_NIRREP = NIRREP;
+  M_SYM    = SYM;
+  M_NDIM   = DIMS.size();
+  M_DIMS   = DIMS;
+  M_NELM   = 0;
+
+  //go through the keys, and find the allowed nonzero blocks
+  size_t NKEY = 1;
+  for (size_t d=1;d<M_NDIM;d++) NKEY *= M_NIRREP;
+  M_INDEX.assign(NKEY,-1);
+
+  const size_t PAD = (LIBJ_MAX_ALIGN >= sizeof(T)) ? LIBJ_MAX_ALIGN/sizeof(T) : 1;
+  std::vector<size_t> START;
+  std::vector<size_t> irr(M_NDIM);
+  for (size_t key=0;key<NKEY;key++)
+  {
+    size_t k = key;
+    size_t h = M_SYM;
+    size_t nelm = 1;
+    for (size_t d=0;d+1<M_NDIM;d++)
+    {
+      irr[d] = k%M_NIRREP;
+      k /= M_NIRREP;
+      h ^= irr[d];
+    }
+    irr[M_NDIM-1] = h;
+    for (size_t d=0;d<M_NDIM;d++) nelm *= M_DIMS[d][irr[d]];
+    if (nelm == 0) continue;
+
+    M_INDEX[key] = (long) M_IRREPS.size();
+    M_IRREPS.push_back(irr);
+    START.push_back(M_NELM);
+    M_NELM += ((nelm + PAD - 1)/PAD)*PAD;
+  }
+
+  //one arena for all the blocks
+  M_BLOCKS.clear();
+  M_BLOCKS.resize(M_IRREPS.size());
+  if (M_NELM == 0) return;
+  M_ARENA.aligned_allocate(LIBJ_MAX_ALIGN,M_NELM);
+  std::vector<size_t> lengths(M_NDIM);
+  for (size_t b=0;b<M_IRREPS.size();b++)
+  {
+    for (size_t d=0;d<M_NDIM;d++) lengths[d] = M_DIMS[d][M_IRREPS[b][d]];
+    M_BLOCKS[b].assign(M_ARENA.data()+START[b],lengths);
+  }
+}
+
+}//end of namespace
+
+#endif
@@ -0,0 +1,70 @@
+/*----------------------------------------------------------------------------
+  dim_vector.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for the dim_vector class, a vector of at most
+  LIBJ_TENSOR_MAX_DIM size_t's (one per dimension of a tensor) that is kept
+  inside the object, as the lengths and strides of libj::tensor are. It is
+  for the per-call dimension lists of the jblis routines (strided_dims), so
+  that making one never touches the heap.
+
+  USAGE
+  ------------------
+  libj::dim_vector D;
+  D.push_back(4);		//error past LIBJ_TENSOR_MAX_DIM
+  D.size(); D[0]; D.back(); D.clear();
+  for (const size_t* d = D.begin(); d != D.end(); d++) ...
+
+----------------------------------------------------------------------------*/
+#ifndef DIM_VECTOR_HPP
+#define DIM_VECTOR_HPP
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "tensor.hpp"
+
+namespace libj
+{
+
+class dim_vector
+{
+  private:
+  size_t M_DATA[LIBJ_TENSOR_MAX_DIM];
+  size_t M_SIZE;
+
+  public:
+  dim_vector() : M_SIZE(0) {}
+  dim_vector(const size_t n, const size_t val) : M_SIZE(0)
+  {
+    for (size_t i=0;i<n;i++) push_back(val);
+  }
+
+  size_t size() const {return M_SIZE;}
+  bool   empty() const {return M_SIZE == 0;}
+  void   clear() {M_SIZE = 0;}
+
+  void push_back(const size_t val)
+  {
+    if (M_SIZE >= LIBJ_TENSOR_MAX_DIM)
+    {
+      printf("ERROR libj::dim_vector::push_back \n");
+      printf("More than LIBJ_TENSOR_MAX_DIM = %d dimensions \n",LIBJ_TENSOR_MAX_DIM);
+      exit(1);
+    }
+    M_DATA[M_SIZE++] = val;
+  }
+
+  size_t& operator[] (const size_t i) {return M_DATA[i];}
+  const size_t& operator[] (const size_t i) const {return M_DATA[i];}
+  size_t& back() {return M_DATA[M_SIZE-1];}
+  const size_t& back() const {return M_DATA[M_SIZE-1];}
+
+  size_t* begin() {return M_DATA;}
+  size_t* end() {return M_DATA+M_SIZE;}
+  const size_t* begin() const {return M_DATA;}
+  const size_t* end() const {return M_DATA+M_SIZE;}
+};
+
+}//end of namespace
+
+#endif
@@ -1,14 +1,19 @@
 /*---------------------------------------------------------------------------------------
   index_bundle2.hpp
 	JHT, April 27, 2022 : created
+	JHT, October 14, 2026 : bundles from dimension lists
 
   class which contains information about index bundles
 
-  This one has been optimized for performance
-
   Functionality
   ------------------
   bunde.offset(index);  //returns the offset of this element in the original tensor
+  bundle.offsets(I,N,off); //offsets of N indices from I, one division per dimension
+  bundle.make_table();  //caches the offsets of every bundled index, so that 
+                        //  offset() is one lookup. Blocks share the table
+
+  Bundles of a tensor_tiled use its per-dimension offset tables (OFF) in
+  place of the strides (LDA), see tensor_tiled.hpp
 ---------------------------------------------------------------------------------------*/
 
 #ifndef INDEX_BUNDLE2_HPP
@@ -18,53 +23,87 @@
 #include <vector>
 #include <string>
 #include <algorithm> 
+#include <memory>
 #include <stdlib.h>
-#include "tensor.hpp"
-
-#define INDEX_UNROLL 4
 
 namespace libj
 {
+template <typename T> class tensor;
+template <typename T> class tensor_tiled;
+
 //------------------------------------------------------------------------
-// index struct for fast access
+// index struct 
 //------------------------------------------------------------------------
-struct index
+struct index2
 {
-  size_t STRIDE;
   size_t LENGTH;
+  size_t STRIDE;
   size_t LDA;
+  const size_t* OFF; //offset of each index, NULL if it is LDA*index
 };
-
 //------------------------------------------------------------------------
 // index bundle class
 //------------------------------------------------------------------------
-template <typename T, size_t NDIM>
+template <size_t NDIM>
 struct index_bundle2
 {
-  size_t                   NELM;   //number of elements
-  size_t                   START;  //starting index (for blocking)
-  std::array<size_t,NDIM>  DIM;    //dimension list that maps between bundle and original
-  std::array<index,NDIM>   IDX;    //index list
+  size_t                  NELM;   //number of elements
+  size_t                  START;  //starting index (for blocking)
+  std::array<size_t,NDIM> DIM;    //dimension list that maps between bundle and original
+  std::array<index2,NDIM>  IDX;    //vector of structs to help with locality  
+  std::shared_ptr<const std::vector<size_t> > TABLE; //cached offsets, if made
+  const size_t*           TAB;    //start of the cached offsets, NULL if none
+
+  //blank constructor
+  index_bundle2()
+  {
+    clear();
+  };
 
   //copy constructor
-  index_bundle2(const index_bundle2& other)
+  index_bundle2(const index_bundle2<NDIM>& other)
   {
-    NELM  = other.NELM;
+    NELM = other.NELM;
     START = other.START;
-    DIM   = other.DIM;
-    IDX   = other.IDX;
+    DIM = other.DIM;
+    IDX = other.IDX;
+    TABLE = other.TABLE;
+    TAB = other.TAB;
   }
 
   //copy assignment
-  index_bundle2& operator= (const index_bundle2& other)
+  index_bundle2& operator= (const index_bundle2<NDIM>& other)
   {
-    NELM  = other.NELM;
+    NELM = other.NELM;
     START = other.START;
-    DIM   = other.DIM;
-    IDX   = other.IDX;
+    DIM = other.DIM;
+    IDX = other.IDX;
+    TABLE = other.TABLE;
+    TAB = other.TAB;
     return *this;
   }
 
+  //assignment from tensor
+  template<typename T>
+  index_bundle2(const libj::tensor<T>& tens, 
+                const std::string& str)
+  {
+    clear();
+    make_bundle(tens,str);
+  } 
+
+  //clear the data in the bundle
+  void clear()
+  {
+    NELM = 0;
+    START = 0;
+    TABLE.reset();
+    TAB = NULL;
+  }
+
+  constexpr size_t dim() const {return NDIM;}
+  size_t dim(const size_t idx) const {return DIM[idx];}
+
   size_t size() const {return NELM;}
 
   //given cumulative index I, return the value for sub-index idx
@@ -79,24 +118,54 @@ struct index_bundle2
     return (size_t) (std::tolower(c) - (int) 'a');
   }
 
-  //make the bundle
-  void make_bundle(const libj::tensor<T>& tens, const std::string& str)
+  //stride and offset table of dimension d of a tensor
+  template<typename T>
+  static size_t m_lda(const libj::tensor<T>& tens, const size_t d) {return tens.stride(d);}
+  template<typename T>
+  static const size_t* m_off(const libj::tensor<T>& tens, const size_t d) {return NULL;}
+  template<typename T>
+  static size_t m_lda(const libj::tensor_tiled<T>& tens, const size_t d) {return 0;}
+  template<typename T>
+  static const size_t* m_off(const libj::tensor_tiled<T>& tens, const size_t d) {return tens.offsets(d);}
+
+  //make the bundle, from a libj::tensor or libj::tensor_tiled
+  template<class TT>
+  void make_bundle(const TT& tens, const std::string& str)
+  {
+    std::array<size_t,NDIM> dims;
+    for (size_t idx=0;idx<NDIM;idx++) dims[idx] = c2dim(str[idx]);
+    make_bundle(tens,dims.data());
+  }
+
+  //make the bundle from the dimension of each bundled index, e.g. the
+  //  dims of a compile time libj::idx (index_labels.hpp)
+  template<class TT>
+  void make_bundle(const TT& tens, const size_t* dims)
   {
-    const size_t dim = c2dim(str[0]);
-    DIM[0] = dim;
-    IDX[0].LENGTH = tens.size(dim);
-    IDX[0].STRIDE = 1;
-    IDX[0].LDA = tens.stride(dim);
-    NELM = IDX[0].LENGTH;
-
-    for (size_t idx=1;idx<NDIM;idx++)
+    NELM = 1; //key for "empty" bundles
+    START = 0;
+    TABLE.reset();
+    TAB = NULL;
+    if (NDIM > 0)
     {
-      const size_t dd = c2dim(str[idx]);
-      DIM[idx] = dd;
-      IDX[idx].LENGTH = tens.size(dd);
-      IDX[idx].STRIDE = IDX[idx-1].STRIDE*IDX[idx-1].LENGTH;
-      IDX[idx].LDA = tens.stride(dd);
-      NELM *= IDX[idx].LENGTH; 
+      const size_t d = dims[0];
+      DIM[0] = d;
+      IDX[0].LENGTH = tens.size(d); 
+      IDX[0].STRIDE = 1;
+      IDX[0].LDA = m_lda(tens,d);
+      IDX[0].OFF = m_off(tens,d);
+      NELM *= IDX[0].LENGTH;
+
+      for (size_t idx=1;idx<NDIM;idx++)
+      {
+        const size_t dim = dims[idx];
+        DIM[idx] = dim;
+        IDX[idx].LENGTH = tens.size(dim); 
+        IDX[idx].STRIDE = IDX[idx-1].STRIDE * IDX[idx-1].LENGTH;
+        IDX[idx].LDA = m_lda(tens,dim);
+        IDX[idx].OFF = m_off(tens,dim);
+        NELM *= IDX[idx].LENGTH;
+      }
     }
   }
 
@@ -104,26 +173,98 @@ struct index_bundle2
   //  starting at bundled index I and going to bundled index I+(MIN:MAX - I,LEN)
   index_bundle2 block(const size_t I, const size_t LEN) const
   {
-    index_bundle2<T,NDIM> block;
-    block.START = I; //here is the big trick
+    index_bundle2 block;
+    block.START = START + I; //here is the big trick
     block.NELM = std::min(LEN,NELM - I);
     block.DIM = DIM;
     block.IDX = IDX;
+    block.TABLE = TABLE;
+    block.TAB = TAB;
     return block;
   }
 
+  //cache the offsets of all the bundled indices of the original bundle.
+  //  The offsets are generated in order, with no divisions
+  void make_table()
+  {
+    if (TAB != NULL) return;
+    size_t NTOT = 1;
+    for (size_t dim=0;dim<NDIM;dim++) NTOT *= IDX[dim].LENGTH;
+
+    std::shared_ptr<std::vector<size_t> > table = std::make_shared<std::vector<size_t> >(NTOT);
+    std::array<size_t,NDIM> cnt;
+    for (size_t dim=0;dim<NDIM;dim++) cnt[dim] = 0;
+    size_t off = 0;
+    for (size_t I=0;I<NTOT;I++)
+    {
+      (*table)[I] = off;
+      for (size_t dim=0;dim<NDIM;dim++)
+      {
+        const size_t* OFF = IDX[dim].OFF;
+        if (++cnt[dim] < IDX[dim].LENGTH)
+        {
+          off += (OFF == NULL) ? IDX[dim].LDA : OFF[cnt[dim]] - OFF[cnt[dim]-1];
+          break;
+        }
+        off -= (OFF == NULL) ? IDX[dim].LDA*(IDX[dim].LENGTH-1) : OFF[IDX[dim].LENGTH-1] - OFF[0];
+        cnt[dim] = 0;
+      }
+    }
+    TABLE = table;
+    TAB = table->data();
+  }
+
+  bool has_table() const {return TAB != NULL;}
+
   //returns the offset of an index of this particular bundle in the 
   //  original tensor
   size_t offset(const size_t I) const
   {
+    if (TAB != NULL) return TAB[I+START];
     size_t off=0;
     for (size_t dim=0;dim<NDIM;dim++)
     {
-      off += IDX[dim].LDA*get_index(I,dim); 
+      const size_t i = get_index(I,dim);
+      off += (IDX[dim].OFF == NULL) ? IDX[dim].LDA*i : IDX[dim].OFF[i];
     }  
     return off;
   }
 
+  //offsets of the bundled indices I to I+N-1, as in offset(), but counted 
+  //  up from the first as in make_table, so there are no divisions after it
+  void offsets(const size_t I, const size_t N, size_t* off) const
+  {
+    if (TAB != NULL)
+    {
+      //a block may ask for more than are left, past the end repeat the last
+      const size_t last = TABLE->size() - 1;
+      for (size_t i=0;i<N;i++) off[i] = TAB[std::min(I+START+i,last)];
+      return;
+    }
+    std::array<size_t,NDIM> cnt;
+    size_t cur = 0;
+    for (size_t dim=0;dim<NDIM;dim++)
+    {
+      cnt[dim] = get_index(I,dim);
+      cur += (IDX[dim].OFF == NULL) ? IDX[dim].LDA*cnt[dim] : IDX[dim].OFF[cnt[dim]];
+    }
+    for (size_t i=0;i<N;i++)
+    {
+      off[i] = cur;
+      for (size_t dim=0;dim<NDIM;dim++)
+      {
+        const size_t* OFF = IDX[dim].OFF;
+        if (++cnt[dim] < IDX[dim].LENGTH)
+        {
+          cur += (OFF == NULL) ? IDX[dim].LDA : OFF[cnt[dim]] - OFF[cnt[dim]-1];
+          break;
+        }
+        cur -= (OFF == NULL) ? IDX[dim].LDA*(IDX[dim].LENGTH-1) : OFF[IDX[dim].LENGTH-1] - OFF[0];
+        cnt[dim] = 0;
+      }
+    }
+  }
+
 }; //end class
 
 }//end namespace
@@ -0,0 +1,238 @@
+/*---------------------------------------------------------------------------------------
+  index_labels.hpp
+	JHT, October 14, 2026 : created
+
+  compile time index labels, for the tensor_matrix2 bundles and the contractions.
+  The labels are a character pack, so the checks of the labels (repeats, labels
+  that are not in the other tensors, bundle letters out of range) are
+  static_asserts, and the bundles are resolved by the compiler, in place of
+  the std::string parsing at run time
+
+    libj::idx<'i','j','a','b'>()		//the labels "ijab"
+
+  tensor_matrix2 bundles, 'a' for the first dimension of the tensor, etc
+    libj::tensor_matrix2<double,2,1> M(A,libj::idx<'a','c'>(),libj::idx<'b'>());
+
+  contraction, see jblis_level3.hpp
+    libj::contract(1.0,A,libj::idx<'a','b','c','d'>(),B,libj::idx<'c','d','e','f'>(),
+                   0.0,C,libj::idx<'a','b','e','f'>());
+
+  Only the lengths (and the rank of the tensor) are left to check at run time.
+  The string forms are unchanged. This is C++11, so the labels are a character
+  pack rather than a string literal template argument.
+
+  Functionality
+  ------------------
+  idx<C...>::size()		//number of labels
+  idx<C...>::str		//the labels as a nul terminated string
+  idx<C...>::dims		//the bundle letters as dimensions, C - 'a'
+  idx_contract<LA,LB,LC>	//the M, K, N bundles of C(LC) = A(LA) . B(LB)
+---------------------------------------------------------------------------------------*/
+#ifndef INDEX_LABELS_HPP
+#define INDEX_LABELS_HPP
+
+#include <stddef.h>
+
+namespace libj
+{
+
+#define LIBJ_IDX_NONE ((size_t) -1)
+
+//------------------------------------------------------------------------
+// idx, a list of labels
+//------------------------------------------------------------------------
+template <char... C>
+struct idx
+{
+  static constexpr size_t size() {return sizeof...(C);}
+  static constexpr char   str[sizeof...(C)+1]  = {C...,'\0'};
+  static constexpr size_t dims[sizeof...(C)+1] = {(size_t) (C - 'a')...,0};
+};
+template <char... C> constexpr char   idx<C...>::str[sizeof...(C)+1];
+template <char... C> constexpr size_t idx<C...>::dims[sizeof...(C)+1];
+
+//------------------------------------------------------------------------
+// constexpr label checks, on (string,length) pairs. Recursive, for C++11
+//------------------------------------------------------------------------
+//position of c in s, or LIBJ_IDX_NONE
+constexpr size_t idx_find(const char* s, const size_t n, const char c, const size_t i=0)
+{
+  return (i == n) ? LIBJ_IDX_NONE : ((s[i] == c) ? i : idx_find(s,n,c,i+1));
+}
+
+constexpr bool idx_has(const char* s, const size_t n, const char c)
+{
+  return idx_find(s,n,c) != LIBJ_IDX_NONE;
+}
+
+//no label of s is repeated
+constexpr bool idx_unique(const char* s, const size_t n, const size_t i=0)
+{
+  return (i == n) || (idx_find(s,n,s[i]) == i && idx_unique(s,n,i+1));
+}
+
+//every label of s is in t or u
+constexpr bool idx_all_in(const char* s, const size_t n, const char* t, const size_t m,
+                          const char* u, const size_t l, const size_t i=0)
+{
+  return (i == n) || ((idx_has(t,m,s[i]) || idx_has(u,l,s[i])) && idx_all_in(s,n,t,m,u,l,i+1));
+}
+
+//no label of s is in both t and u
+constexpr bool idx_none_in_both(const char* s, const size_t n, const char* t, const size_t m,
+                                const char* u, const size_t l, const size_t i=0)
+{
+  return (i == n) || (!(idx_has(t,m,s[i]) && idx_has(u,l,s[i])) && idx_none_in_both(s,n,t,m,u,l,i+1));
+}
+
+//no label of s is in t
+constexpr bool idx_none_in(const char* s, const size_t n, const char* t, const size_t m,
+                           const size_t i=0)
+{
+  return (i == n) || (!idx_has(t,m,s[i]) && idx_none_in(s,n,t,m,i+1));
+}
+
+//every label of s is a bundle letter, 'a' to 'a'+ndim-1
+constexpr bool idx_in_range(const char* s, const size_t n, const size_t ndim, const size_t i=0)
+{
+  return (i == n) || (s[i] >= 'a' && (size_t) (s[i] - 'a') < ndim && idx_in_range(s,n,ndim,i+1));
+}
+
+//number of labels of s that are (IN) or are not in t
+constexpr size_t idx_count_in(const char* s, const size_t n, const char* t, const size_t m,
+                              const bool IN, const size_t i=0)
+{
+  return (i == n) ? 0 : ((idx_has(t,m,s[i]) == IN) + idx_count_in(s,n,t,m,IN,i+1));
+}
+
+//position in s of the k'th label of s that is (IN) or is not in t
+constexpr size_t idx_nth_in(const char* s, const size_t n, const char* t, const size_t m,
+                            const bool IN, const size_t k, const size_t i=0)
+{
+  return (i == n) ? LIBJ_IDX_NONE :
+         ((idx_has(t,m,s[i]) == IN) ? ((k == 0) ? i : idx_nth_in(s,n,t,m,IN,k-1,i+1))
+                                    : idx_nth_in(s,n,t,m,IN,k,i+1));
+}
+
+//------------------------------------------------------------------------
+// index sequences, for the bundle strings
+//------------------------------------------------------------------------
+template <size_t... I> struct idx_seq {};
+template <size_t N, size_t... I> struct idx_make_seq : idx_make_seq<N-1,N-1,I...> {};
+template <size_t... I> struct idx_make_seq<0,I...> {typedef idx_seq<I...> type;};
+
+//------------------------------------------------------------------------
+// idx_bundles
+//	the tensor_matrix2 bundles L and R of NLHS and NRHS letters
+//------------------------------------------------------------------------
+template <class L, class R, size_t NLHS, size_t NRHS>
+struct idx_bundles
+{
+  static_assert(L::size() == NLHS,"libj::idx : the LHS bundle does not have NLHS labels");
+  static_assert(R::size() == NRHS,"libj::idx : the RHS bundle does not have NRHS labels");
+  static_assert(idx_in_range(L::str,L::size(),NLHS+NRHS) && idx_in_range(R::str,R::size(),NLHS+NRHS),
+                "libj::idx : a bundle letter is not a dimension of the tensor ('a' to 'a'+NLHS+NRHS-1)");
+  static_assert(idx_unique(L::str,L::size()) && idx_unique(R::str,R::size()) &&
+                idx_none_in(L::str,L::size(),R::str,R::size()),
+                "libj::idx : a dimension is in the bundles more than once");
+  static constexpr bool value = true;
+};
+
+//------------------------------------------------------------------------
+// idx_contract
+//	the M (A and C), K (A and B), and N (B and C) bundles of a contraction
+//	C(LC) = A(LA) . B(LB), as tensor_matrix2 bundle strings of each tensor,
+//	M and N in the order of C, K in the order of A, as in contract_labels
+//------------------------------------------------------------------------
+template <class LA, class LB, class LC>
+struct idx_contract_count
+{
+  static_assert(idx_unique(LA::str,LA::size()),"libj::contract : repeated label in A");
+  static_assert(idx_unique(LB::str,LB::size()),"libj::contract : repeated label in B");
+  static_assert(idx_unique(LC::str,LC::size()),"libj::contract : repeated label in C");
+  static_assert(idx_none_in_both(LC::str,LC::size(),LA::str,LA::size(),LB::str,LB::size()),
+                "libj::contract : labels in A, B, and C are not supported");
+  static_assert(idx_all_in(LC::str,LC::size(),LA::str,LA::size(),LB::str,LB::size()),
+                "libj::contract : label of C is not in A or B");
+  static_assert(idx_all_in(LA::str,LA::size(),LB::str,LB::size(),LC::str,LC::size()),
+                "libj::contract : label of A is not in B or C");
+  static_assert(idx_all_in(LB::str,LB::size(),LA::str,LA::size(),LC::str,LC::size()),
+                "libj::contract : label of B is not in A or C");
+
+  static constexpr size_t NM = idx_count_in(LC::str,LC::size(),LA::str,LA::size(),true);
+  static constexpr size_t NN = idx_count_in(LC::str,LC::size(),LB::str,LB::size(),true);
+  static constexpr size_t NK = idx_count_in(LA::str,LA::size(),LC::str,LC::size(),false);
+};
+
+template <class LA, class LB, class LC>
+constexpr char idx_cm(const size_t k)
+{
+  return (char) ('a' + idx_nth_in(LC::str,LC::size(),LA::str,LA::size(),true,k));
+}
+template <class LA, class LB, class LC>
+constexpr char idx_am(const size_t k)
+{
+  return (char) ('a' + idx_find(LA::str,LA::size(),
+                                LC::str[idx_nth_in(LC::str,LC::size(),LA::str,LA::size(),true,k)]));
+}
+template <class LA, class LB, class LC>
+constexpr char idx_cn(const size_t k)
+{
+  return (char) ('a' + idx_nth_in(LC::str,LC::size(),LB::str,LB::size(),true,k));
+}
+template <class LA, class LB, class LC>
+constexpr char idx_bn(const size_t k)
+{
+  return (char) ('a' + idx_find(LB::str,LB::size(),
+                                LC::str[idx_nth_in(LC::str,LC::size(),LB::str,LB::size(),true,k)]));
+}
+template <class LA, class LB, class LC>
+constexpr char idx_ak(const size_t k)
+{
+  return (char) ('a' + idx_nth_in(LA::str,LA::size(),LC::str,LC::size(),false,k));
+}
+template <class LA, class LB, class LC>
+constexpr char idx_bk(const size_t k)
+{
+  return (char) ('a' + idx_find(LB::str,LB::size(),
+                                LA::str[idx_nth_in(LA::str,LA::size(),LC::str,LC::size(),false,k)]));
+}
+
+template <class LA, class LB, class LC, class SM, class SK, class SN>
+struct idx_contract_str;
+
+template <class LA, class LB, class LC, size_t... M, size_t... K, size_t... N>
+struct idx_contract_str<LA,LB,LC,idx_seq<M...>,idx_seq<K...>,idx_seq<N...> >
+{
+  static constexpr char AM[sizeof...(M)+1] = {idx_am<LA,LB,LC>(M)...,'\0'};
+  static constexpr char CM[sizeof...(M)+1] = {idx_cm<LA,LB,LC>(M)...,'\0'};
+  static constexpr char AK[sizeof...(K)+1] = {idx_ak<LA,LB,LC>(K)...,'\0'};
+  static constexpr char BK[sizeof...(K)+1] = {idx_bk<LA,LB,LC>(K)...,'\0'};
+  static constexpr char BN[sizeof...(N)+1] = {idx_bn<LA,LB,LC>(N)...,'\0'};
+  static constexpr char CN[sizeof...(N)+1] = {idx_cn<LA,LB,LC>(N)...,'\0'};
+};
+template <class LA, class LB, class LC, size_t... M, size_t... K, size_t... N>
+constexpr char idx_contract_str<LA,LB,LC,idx_seq<M...>,idx_seq<K...>,idx_seq<N...> >::AM[sizeof...(M)+1];
+template <class LA, class LB, class LC, size_t... M, size_t... K, size_t... N>
+constexpr char idx_contract_str<LA,LB,LC,idx_seq<M...>,idx_seq<K...>,idx_seq<N...> >::CM[sizeof...(M)+1];
+template <class LA, class LB, class LC, size_t... M, size_t... K, size_t... N>
+constexpr char idx_contract_str<LA,LB,LC,idx_seq<M...>,idx_seq<K...>,idx_seq<N...> >::AK[sizeof...(K)+1];
+template <class LA, class LB, class LC, size_t... M, size_t... K, size_t... N>
+constexpr char idx_contract_str<LA,LB,LC,idx_seq<M...>,idx_seq<K...>,idx_seq<N...> >::BK[sizeof...(K)+1];
+template <class LA, class LB, class LC, size_t... M, size_t... K, size_t... N>
+constexpr char idx_contract_str<LA,LB,LC,idx_seq<M...>,idx_seq<K...>,idx_seq<N...> >::BN[sizeof...(N)+1];
+template <class LA, class LB, class LC, size_t... M, size_t... K, size_t... N>
+constexpr char idx_contract_str<LA,LB,LC,idx_seq<M...>,idx_seq<K...>,idx_seq<N...> >::CN[sizeof...(N)+1];
+
+template <class LA, class LB, class LC>
+struct idx_contract : public idx_contract_count<LA,LB,LC>,
+                      public idx_contract_str<LA,LB,LC,
+                               typename idx_make_seq<idx_contract_count<LA,LB,LC>::NM>::type,
+                               typename idx_make_seq<idx_contract_count<LA,LB,LC>::NK>::type,
+                               typename idx_make_seq<idx_contract_count<LA,LB,LC>::NN>::type>
+{
+};
+
+}//end of namespace
+
+#endif
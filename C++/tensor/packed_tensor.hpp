@@ -0,0 +1,471 @@
+/*----------------------------------------------------------------------------
+  packed_tensor.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for the packed_tensor class, which stores a tensor with
+  permutational symmetries between some of its indices, keeping only the
+  unique elements (this generalizes usymat to any number of dimensions).
+
+  The symmetry is given as a string with one character per dimension.
+  Dimensions with the same letter form a group, which must all have the
+  same length, and
+    uppercase letters are antisymmetric groups, stored for i < j < ...
+    lowercase letters are symmetric groups, stored for i <= j <= ...
+    '.' is a dimension with no symmetry
+
+  For example, T(i,j,a,b) antisymmetric in ij and ab is "AABB", and a
+  symmetric matrix in the same order as usymat is "aa". Each group is
+  packed in the usual combinatorial order, so a pair (i,j) is at
+    j*(j-1)/2 + i  (antisymmetric, i < j)
+    j*(j+1)/2 + i  (symmetric, i <= j)
+  and the groups are stored in column-major order, ordered by their first
+  dimension. For each group a table of the packed offset and sign of every
+  full combination of its indices is kept, so this is meant for the pairs
+  and triples of indices in amplitudes, not for large groups.
+
+  A packed_tensor can also be assigned to a libj::tensor, which makes a
+  view of the dense tensor with no symmetry, so that both can be used in
+  the same routines.
+
+  Initialization
+  -------------------
+    libj::packed_tensor<double> T({no,no,nv,nv},"AABB");
+    libj::packed_tensor<double> D;
+    D.assign(dense);        //view of a libj::tensor, no symmetry
+
+  Access
+  -------------------
+    T(i,j,a,b);             //value of the element, including sign (or zero)
+    T.offset(idx,sign);     //packed offset and sign of the indices in idx
+    T.data();               //start of the unique elements
+    T.size();               //number of unique elements
+    T.size(d);              //length of dimension d
+
+  Conversion
+  -------------------
+    T.pack(F);              //copy the unique elements of the full tensor F
+    T.unpack(F);            //write every element of the full tensor F
+
+  The contraction of packed tensors is libj::contract, in jblis_level3
+----------------------------------------------------------------------------*/
+#ifndef PACKED_TENSOR_HPP
+#define PACKED_TENSOR_HPP
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "libjdef.h"
+#include "tensor.hpp"
+
+namespace libj
+{
+
+//------------------------------------------------------------------------
+// packed_group
+//	one group of dimensions with a permutational symmetry
+//------------------------------------------------------------------------
+struct packed_group
+{
+  size_t              LENGTH;  //length of each dimension in the group
+  size_t              NDIM;    //number of dimensions in the group
+  bool                ANTI;    //antisymmetric
+  size_t              NELM;    //number of unique elements of the group
+  size_t              STRIDE;  //stride of the group in the packed data
+  std::vector<long>   CODE;    //(offset+1)*sign of each full index, 0 if zero
+  std::vector<size_t> CANON;   //full index of each unique element
+};
+
+template <typename T>
+class packed_tensor
+{
+  private:
+  size_t                     M_NDIM;     //number of dimensions
+  size_t                     M_NELM;     //number of unique elements
+  T*                         M_BUFFER;   //start of the unique elements
+  std::string                M_SYM;      //symmetry string
+  std::vector<size_t>        M_LENGTHS;  //length of each dimension
+  std::vector<size_t>        M_GROUP;    //group of each dimension
+  std::vector<size_t>        M_FSTRIDE;  //stride of each dimension in its group's full index
+  std::vector<packed_group>  M_GROUPS;   //the groups
+  libj::tensor<T>            M_DATA;     //memory, if allocated
+
+  void m_make_group(packed_group& G);
+
+  //no copies, as the buffer may point into M_DATA
+  packed_tensor(const packed_tensor<T>& other);
+  packed_tensor<T>& operator= (const packed_tensor<T>& other);
+
+  public:
+  packed_tensor() : M_NDIM(0), M_NELM(0), M_BUFFER(NULL) {}
+  packed_tensor(const std::vector<size_t>& lengths, const std::string& sym)
+  : M_NDIM(0), M_NELM(0), M_BUFFER(NULL)
+  {
+    allocate(lengths,sym);
+  }
+
+  void allocate(const std::vector<size_t>& lengths, const std::string& sym);
+  void assign(const libj::tensor<T>& dense);
+
+  //getters
+  size_t dim() const {return M_NDIM;}
+  size_t size() const {return M_NELM;}
+  size_t size(const size_t d) const {return M_LENGTHS[d];}
+  const std::string& sym() const {return M_SYM;}
+  T* data() {return M_BUFFER;}
+  const T* data() const {return M_BUFFER;}
+
+  //groups
+  size_t num_groups() const {return M_GROUPS.size();}
+  size_t group(const size_t d) const {return M_GROUP[d];}
+  size_t group_stride(const size_t d) const {return M_FSTRIDE[d];}
+  const packed_group& group_info(const size_t g) const {return M_GROUPS[g];}
+
+  //packed offset and sign of a set of indices, returns -1 and sign 0 if
+  //  the element is zero by symmetry
+  long offset(const size_t* idx, int& sign) const
+  {
+    std::vector<size_t> full(M_GROUPS.size(),0);
+    for (size_t d=0;d<M_NDIM;d++) full[M_GROUP[d]] += idx[d]*M_FSTRIDE[d];
+    long off = 0;
+    sign = 1;
+    for (size_t g=0;g<M_GROUPS.size();g++)
+    {
+      const long code = M_GROUPS[g].CODE[full[g]];
+      if (code == 0) {sign = 0; return -1;}
+      if (code < 0) {sign = -sign; off += (-code-1)*(long) M_GROUPS[g].STRIDE;}
+      else          {off += (code-1)*(long) M_GROUPS[g].STRIDE;}
+    }
+    return off;
+  }
+  long offset(const std::vector<size_t>& idx, int& sign) const {return offset(idx.data(),sign);}
+
+  //value of an element
+  template<class...Args> T operator() (const Args... args) const
+  {
+    const size_t idx[] = {(size_t) args...};
+    int sign;
+    const long off = offset(idx,sign);
+    if (sign == 0) return (T) 0;
+    return (sign > 0) ? M_BUFFER[off] : -M_BUFFER[off];
+  }
+
+  //set the unique elements to zero
+  void zero() {for (size_t i=0;i<M_NELM;i++) M_BUFFER[i] = (T) 0;}
+
+  //conversion to and from full tensors
+  void pack(const libj::tensor<T>& F);
+  void unpack(libj::tensor<T>& F) const;
+
+}; //end of class
+
+//-----------------------------------------------------------------------
+// packed_binomial
+//	n choose k, for the packed offsets
+//-----------------------------------------------------------------------
+inline size_t packed_binomial(const size_t n, const size_t k)
+{
+  if (k > n) return 0;
+  size_t r = 1;
+  for (size_t i=1;i<=k;i++) r = (r*(n-k+i))/i;
+  return r;
+}
+
+//-----------------------------------------------------------------------
+// m_make_group
+//	make the code and canonical tables of a group. The full index is
+//	i0 + N*i1 + N*N*i2 ..., which is sorted (counting the sign of the
+//	permutation) and packed in combinatorial order
+//-----------------------------------------------------------------------
+template <typename T>
+void packed_tensor<T>::m_make_group(packed_group& G)
+{
+  const size_t N = G.LENGTH;
+  const size_t n = G.NDIM;
+  G.NELM = G.ANTI ? packed_binomial(N,n) : packed_binomial(N+n-1,n);
+  size_t NFULL = 1;
+  for (size_t p=0;p<n;p++) NFULL *= N;
+  G.CODE.assign(NFULL,0);
+  G.CANON.assign(G.NELM,0);
+
+  std::vector<size_t> s(n);
+  for (size_t f=0;f<NFULL;f++)
+  {
+    size_t r = f;
+    for (size_t p=0;p<n;p++) {s[p] = r%N; r /= N;}
+
+    //insertion sort, counting the swaps
+    bool canon = true;
+    long sign  = 1;
+    for (size_t p=1;p<n;p++)
+    {
+      for (size_t q=p;q>0 && s[q-1] > s[q];q--)
+      {
+        std::swap(s[q-1],s[q]);
+        sign  = -sign;
+        canon = false;
+      }
+    }
+
+    bool zero = false;
+    size_t off = 0;
+    for (size_t p=0;p<n;p++)
+    {
+      if (G.ANTI && p > 0 && s[p] == s[p-1]) zero = true;
+      off += G.ANTI ? packed_binomial(s[p],p+1) : packed_binomial(s[p]+p,p+1);
+    }
+    if (zero) continue;
+    if (!G.ANTI) sign = 1;
+    G.CODE[f] = sign*(long) (off+1);
+    if (canon) G.CANON[off] = f;
+  }
+}
+
+//-----------------------------------------------------------------------
+// allocate
+//	make the groups from the symmetry string, and allocate the unique
+//	elements
+//-----------------------------------------------------------------------
+template <typename T>
+void packed_tensor<T>::allocate(const std::vector<size_t>& lengths, const std::string& sym)
+{
+  if (M_NDIM != 0)
+  {
+    printf("ERROR libj::packed_tensor::allocate \n");
+    printf("packed_tensor is already set \n");
+    exit(1);
+  }
+  if (lengths.size() < 1 || lengths.size() != sym.length())
+  {
+    printf("ERROR libj::packed_tensor::allocate \n");
+    printf("bad input : ndim = %zu, sym = %s \n",lengths.size(),sym.c_str());
+    exit(1);
+  }
+
+  M_NDIM    = lengths.size();
+  M_SYM     = sym;
+  M_LENGTHS = lengths;
+  M_GROUP.assign(M_NDIM,0);
+  M_FSTRIDE.assign(M_NDIM,1);
+  M_GROUPS.clear();
+
+  //groups, in order of their first dimension
+  std::vector<char> labels;
+  for (size_t d=0;d<M_NDIM;d++)
+  {
+    const char c = sym[d];
+    size_t g = labels.size();
+    if (c != '.')
+    {
+      for (size_t h=0;h<labels.size();h++) {if (labels[h] == c) g = h;}
+    }
+    if (g == labels.size())
+    {
+      packed_group G;
+      G.LENGTH = lengths[d];
+      G.NDIM   = 0;
+      G.ANTI   = (c >= 'A' && c <= 'Z');
+      labels.push_back(c);
+      M_GROUPS.push_back(G);
+    }
+    packed_group& G = M_GROUPS[g];
+    if (G.LENGTH != lengths[d])
+    {
+      printf("ERROR libj::packed_tensor::allocate \n");
+      printf("dimensions of group %c have different lengths \n",c);
+      exit(1);
+    }
+    M_GROUP[d]   = g;
+    M_FSTRIDE[d] = 1;
+    for (size_t p=0;p<G.NDIM;p++) M_FSTRIDE[d] *= G.LENGTH;
+    G.NDIM++;
+  }
+
+  M_NELM = 1;
+  for (size_t g=0;g<M_GROUPS.size();g++)
+  {
+    m_make_group(M_GROUPS[g]);
+    M_GROUPS[g].STRIDE = M_NELM;
+    M_NELM *= M_GROUPS[g].NELM;
+  }
+
+  M_DATA.aligned_allocate(LIBJ_MAX_ALIGN,M_NELM > 0 ? M_NELM : 1);
+  M_BUFFER = M_DATA.data();
+}
+
+//-----------------------------------------------------------------------
+// assign
+//	view of a dense tensor, where each dimension is its own group with
+//	the stride of the tensor
+//-----------------------------------------------------------------------
+template <typename T>
+void packed_tensor<T>::assign(const libj::tensor<T>& dense)
+{
+  if (M_NDIM != 0)
+  {
+    printf("ERROR libj::packed_tensor::assign \n");
+    printf("packed_tensor is already set \n");
+    exit(1);
+  }
+  M_NDIM   = dense.dim();
+  M_NELM   = dense.size();
+  M_BUFFER = const_cast<T*>(dense.data());
+  M_SYM    = std::string(M_NDIM,'.');
+  M_LENGTHS.assign(M_NDIM,0);
+  M_GROUP.assign(M_NDIM,0);
+  M_FSTRIDE.assign(M_NDIM,1);
+  M_GROUPS.assign(M_NDIM,packed_group());
+  for (size_t d=0;d<M_NDIM;d++)
+  {
+    M_LENGTHS[d] = dense.size(d);
+    M_GROUP[d]   = d;
+    packed_group& G = M_GROUPS[d];
+    G.LENGTH = dense.size(d);
+    G.NDIM   = 1;
+    G.ANTI   = false;
+    m_make_group(G);
+    G.STRIDE = dense.stride(d);
+  }
+}
+
+//-----------------------------------------------------------------------
+// pack
+//	copy the unique elements of the full tensor F, which is assumed to
+//	have the symmetry of this tensor. The first group is the inner loop
+//-----------------------------------------------------------------------
+template <typename T>
+void packed_tensor<T>::pack(const libj::tensor<T>& F)
+{
+  if (F.dim() != M_NDIM)
+  {
+    printf("ERROR libj::packed_tensor::pack \n");
+    printf("full tensor has %zu dimensions, not %zu \n",F.dim(),M_NDIM);
+    exit(1);
+  }
+  for (size_t d=0;d<M_NDIM;d++)
+  {
+    if (F.size(d) != M_LENGTHS[d])
+    {
+      printf("ERROR libj::packed_tensor::pack \n");
+      printf("length of dimension %zu does not match \n",d);
+      exit(1);
+    }
+  }
+
+  //offset in F of each unique element of each group
+  const size_t NG = M_GROUPS.size();
+  std::vector<std::vector<size_t> > FOFF(NG);
+  for (size_t g=0;g<NG;g++)
+  {
+    const packed_group& G = M_GROUPS[g];
+    FOFF[g].assign(G.NELM,0);
+    for (size_t i=0;i<G.NELM;i++)
+    {
+      for (size_t d=0;d<M_NDIM;d++)
+      {
+        if (M_GROUP[d] != g) continue;
+        FOFF[g][i] += ((G.CANON[i]/M_FSTRIDE[d])%G.LENGTH)*F.stride(d);
+      }
+    }
+  }
+
+  const size_t N0   = M_GROUPS[0].NELM;
+  const long   NOUT = (long) (M_NELM/(N0 > 0 ? N0 : 1));
+  const T* fp = F.data();
+  T* pp = M_BUFFER;
+  #pragma omp parallel for schedule(static) if (M_NELM > 32768)
+  for (long I=0;I<NOUT;I++)
+  {
+    size_t r = (size_t) I, fo = 0, po = 0;
+    for (size_t g=1;g<NG;g++)
+    {
+      const size_t i = r%M_GROUPS[g].NELM;
+      r /= M_GROUPS[g].NELM;
+      fo += FOFF[g][i];
+      po += i*M_GROUPS[g].STRIDE;
+    }
+    const size_t  S0 = M_GROUPS[0].STRIDE;
+    const size_t* f0 = FOFF[0].data();
+    for (size_t i=0;i<N0;i++) pp[po+i*S0] = fp[fo+f0[i]];
+  }
+}
+
+//-----------------------------------------------------------------------
+// unpack
+//	write every element of the full tensor F, with the signs, and zero
+//	where the element is zero by symmetry. The first group is the inner
+//	loop
+//-----------------------------------------------------------------------
+template <typename T>
+void packed_tensor<T>::unpack(libj::tensor<T>& F) const
+{
+  if (F.dim() != M_NDIM)
+  {
+    printf("ERROR libj::packed_tensor::unpack \n");
+    printf("full tensor has %zu dimensions, not %zu \n",F.dim(),M_NDIM);
+    exit(1);
+  }
+  for (size_t d=0;d<M_NDIM;d++)
+  {
+    if (F.size(d) != M_LENGTHS[d])
+    {
+      printf("ERROR libj::packed_tensor::unpack \n");
+      printf("length of dimension %zu does not match \n",d);
+      exit(1);
+    }
+  }
+
+  //offset in F of each full index of each group
+  const size_t NG = M_GROUPS.size();
+  std::vector<std::vector<size_t> > FOFF(NG);
+  size_t NFULL = 1;
+  for (size_t g=0;g<NG;g++)
+  {
+    const packed_group& G = M_GROUPS[g];
+    FOFF[g].assign(G.CODE.size(),0);
+    for (size_t f=0;f<G.CODE.size();f++)
+    {
+      for (size_t d=0;d<M_NDIM;d++)
+      {
+        if (M_GROUP[d] != g) continue;
+        FOFF[g][f] += ((f/M_FSTRIDE[d])%G.LENGTH)*F.stride(d);
+      }
+    }
+    NFULL *= G.CODE.size();
+  }
+
+  const size_t N0   = M_GROUPS[0].CODE.size();
+  const long   NOUT = (long) (NFULL/(N0 > 0 ? N0 : 1));
+  const T* pp = M_BUFFER;
+  T* fp = F.data();
+  #pragma omp parallel for schedule(static) if (NFULL > 32768)
+  for (long I=0;I<NOUT;I++)
+  {
+    size_t r = (size_t) I, fo = 0;
+    long po = 0, sign = 1;
+    for (size_t g=1;g<NG;g++)
+    {
+      const packed_group& G = M_GROUPS[g];
+      const size_t f = r%G.CODE.size();
+      r /= G.CODE.size();
+      fo += FOFF[g][f];
+      const long code = G.CODE[f];
+      if (code == 0) {sign = 0;}
+      else if (code < 0) {sign = -sign; po += (-code-1)*(long) G.STRIDE;}
+      else {po += (code-1)*(long) G.STRIDE;}
+    }
+    const packed_group& G0 = M_GROUPS[0];
+    const size_t* f0 = FOFF[0].data();
+    for (size_t f=0;f<N0;f++)
+    {
+      const long code = G0.CODE[f];
+      if (sign == 0 || code == 0) {fp[fo+f0[f]] = (T) 0; continue;}
+      const T val = pp[po + ((code > 0 ? code : -code)-1)*(long) G0.STRIDE];
+      fp[fo+f0[f]] = ((code > 0) == (sign > 0)) ? val : -val;
+    }
+  }
+}
+
+}//end of namespace
+
+#endif
@@ -0,0 +1,259 @@
+/*----------------------------------------------------------------------------
+  sparse_tensor.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for the sparse_tensor class, which stores the nonzeros of an
+  element sparse tensor in the compressed sparse fiber (CSF) format, for
+  tensors that are sparse element by element (screened integrals, local
+  correlation) rather than by blocks (block_tensor).
+
+  The nonzeros are a tree with one level per dimension. Level 0 is the
+  last (slowest) dimension, and the last level is dimension 0, so the
+  nonzeros are in the column major order of the dense tensor, and a leaf
+  fiber (the children of a node of level ND-2) is the nonzeros of one
+  line along dimension 0. Level l has nodes(l) nodes, each with its index
+  idx(l)[n], and for l < ND-1 its children at level l+1 are
+
+    ptr(l)[n], ..., ptr(l)[n+1]-1
+
+  The last level has one node per nonzero, with its value val()[n]. Only
+  nodes with nonzeros below them are kept.
+
+  Initialization
+  -------------------
+    libj::sparse_tensor<double> S(A,1.0e-10);   //|A(...)| > tol
+    S.compress(A,tol);                          //again, from any A
+
+  Access
+  -------------------
+    S.dim();		//number of dimensions
+    S.size(d);		//length of dimension d
+    S.nnz();		//number of nonzeros
+    S.level_dim(l);	//dimension of level l, ND-1-l
+    S.nodes(l);		//number of nodes of level l
+    S.idx(l);		//index of each node of level l
+    S.ptr(l);		//first child of each node of level l, l < ND-1
+    S.val();		//value of each nonzero
+    S.expand(A);	//write the dense tensor, zeros included
+
+  The contraction of a sparse_tensor with a dense tensor is
+  libj::contract, in jblis_level3
+----------------------------------------------------------------------------*/
+#ifndef SPARSE_TENSOR_HPP
+#define SPARSE_TENSOR_HPP
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <vector>
+#include "libjdef.h"
+#include "tensor.hpp"
+#include "simd.hpp"
+
+namespace libj
+{
+
+template <typename T>
+class sparse_tensor
+{
+  private:
+  size_t                           M_NDIM;     //number of dimensions
+  std::vector<size_t>              M_LENGTHS;  //length of each dimension
+  std::vector<std::vector<long> >  M_IDX;      //index of the nodes of each level
+  std::vector<std::vector<size_t> > M_PTR;     //first child of the nodes of each level
+  std::vector<T>                   M_VAL;      //values of the nonzeros
+
+  void m_check(const char* NAME, const libj::tensor<T>& A) const
+  {
+    if (A.dim() != M_NDIM)
+    {
+      printf("ERROR libj::sparse_tensor::%s \n",NAME);
+      printf("dense tensor has %zu dimensions, not %zu \n",A.dim(),M_NDIM);
+      exit(1);
+    }
+    for (size_t d=0;d<M_NDIM;d++)
+    {
+      if (A.size(d) != M_LENGTHS[d])
+      {
+        printf("ERROR libj::sparse_tensor::%s \n",NAME);
+        printf("length of dimension %zu does not match \n",d);
+        exit(1);
+      }
+    }
+  }
+
+  //offset in A of line L along dimension 0
+  size_t m_line(const libj::tensor<T>& A, size_t L) const
+  {
+    size_t off = 0;
+    for (size_t d=1;d<M_NDIM;d++) {off += (L%M_LENGTHS[d])*A.stride(d); L /= M_LENGTHS[d];}
+    return off;
+  }
+
+  public:
+  sparse_tensor() : M_NDIM(0) {}
+  sparse_tensor(const libj::tensor<T>& A, const T tol) : M_NDIM(0) {compress(A,tol);}
+
+  void compress(const libj::tensor<T>& A, const T tol);
+  void expand(libj::tensor<T>& A) const;
+
+  //getters
+  size_t dim() const {return M_NDIM;}
+  size_t size(const size_t d) const {return M_LENGTHS[d];}
+  size_t nnz() const {return M_VAL.size();}
+  size_t level_dim(const size_t l) const {return M_NDIM-1-l;}
+  size_t nodes(const size_t l) const {return M_IDX[l].size();}
+  const long* idx(const size_t l) const {return M_IDX[l].data();}
+  const size_t* ptr(const size_t l) const {return M_PTR[l].data();}
+  const T* val() const {return M_VAL.data();}
+  T* val() {return M_VAL.data();}
+
+}; //end of class
+
+//-----------------------------------------------------------------------
+// compress
+//	each line along dimension 0 is counted and then compressed with
+//	simd_compress into its place (both in parallel over the lines), and
+//	the upper levels are built from the lines with nonzeros
+//-----------------------------------------------------------------------
+template <typename T>
+void sparse_tensor<T>::compress(const libj::tensor<T>& A, const T tol)
+{
+  M_NDIM = A.dim();
+  if (M_NDIM == 0)
+  {
+    printf("ERROR libj::sparse_tensor::compress \n");
+    printf("tensor has no dimensions \n");
+    exit(1);
+  }
+  M_LENGTHS.resize(M_NDIM);
+  for (size_t d=0;d<M_NDIM;d++) M_LENGTHS[d] = A.size(d);
+  M_IDX.assign(M_NDIM,std::vector<long>());
+  M_PTR.assign(M_NDIM-1,std::vector<size_t>());
+  M_VAL.clear();
+
+  const size_t N0 = A.size(0);
+  const size_t S0 = A.stride(0);
+  const long   NL = (long) ((N0 > 0) ? A.size()/N0 : 0);
+  const T*     X  = A.data();
+  std::vector<size_t> start(NL+1,0);
+
+  #pragma omp parallel for schedule(static) if (A.size() > 32768)
+  for (long L=0;L<NL;L++)
+  {
+    const size_t off = m_line(A,(size_t) L);
+    if (S0 == 1)
+    {
+      start[L+1] = (size_t) simd_count_above<T>((long) N0,X+off,tol);
+    } else {
+      size_t c = 0;
+      for (size_t i=0;i<N0;i++) {const T x = X[off+i*S0]; c += ((x < (T) 0 ? -x : x) > tol) ? 1 : 0;}
+      start[L+1] = c;
+    }
+  }
+  for (long L=0;L<NL;L++) start[L+1] += start[L];
+
+  const size_t NNZ = start[NL];
+  M_VAL.resize(NNZ);
+  M_IDX[M_NDIM-1].resize(NNZ);
+  long* li = M_IDX[M_NDIM-1].data();
+  T*    lv = M_VAL.data();
+
+  #pragma omp parallel for schedule(static) if (A.size() > 32768)
+  for (long L=0;L<NL;L++)
+  {
+    if (start[L+1] == start[L]) continue;
+    const size_t off = m_line(A,(size_t) L);
+    if (S0 == 1)
+    {
+      simd_compress<T>((long) N0,X+off,tol,li+start[L],lv+start[L]);
+    } else {
+      size_t c = start[L];
+      for (size_t i=0;i<N0;i++)
+      {
+        const T x = X[off+i*S0];
+        if ((x < (T) 0 ? -x : x) > tol) {li[c] = (long) i; lv[c] = x; c++;}
+      }
+    }
+  }
+
+  //upper levels, from the first level where a line differs from the last one kept
+  if (M_NDIM > 1)
+  {
+    std::vector<size_t> cur(M_NDIM,0), last(M_NDIM,0);
+    bool first = true;
+    for (long L=0;L<NL;L++)
+    {
+      if (start[L+1] > start[L])
+      {
+        size_t l0 = 0;
+        if (!first) {while (l0 < M_NDIM-1 && cur[M_NDIM-1-l0] == last[M_NDIM-1-l0]) l0++;}
+        for (size_t l=l0;l<M_NDIM-1;l++)
+        {
+          M_IDX[l].push_back((long) cur[M_NDIM-1-l]);
+          M_PTR[l].push_back((l+1 < M_NDIM-1) ? M_IDX[l+1].size() : start[L]);
+        }
+        last = cur;
+        first = false;
+      }
+      for (size_t d=1;d<M_NDIM;d++)
+      {
+        if (++cur[d] < M_LENGTHS[d]) break;
+        cur[d] = 0;
+      }
+    }
+    for (size_t l=0;l<M_NDIM-1;l++) M_PTR[l].push_back(M_IDX[l+1].size());
+  }
+}
+
+//-----------------------------------------------------------------------
+// expand
+//	A = the dense tensor, A must have the same lengths
+//-----------------------------------------------------------------------
+template <typename T>
+void sparse_tensor<T>::expand(libj::tensor<T>& A) const
+{
+  m_check("expand",A);
+  T* X = A.data();
+  const size_t NL = (M_LENGTHS[0] > 0) ? A.size()/M_LENGTHS[0] : 0;
+  for (size_t L=0;L<NL;L++)
+  {
+    const size_t off = m_line(A,L);
+    for (size_t i=0;i<M_LENGTHS[0];i++) X[off+i*A.stride(0)] = (T) 0;
+  }
+
+  //walk down the tree, with the offset of each level
+  const size_t NN = M_NDIM;
+  std::vector<size_t> node(NN,0), end(NN,0), off(NN+1,0);
+  if (NN == 1)
+  {
+    for (size_t n=0;n<M_VAL.size();n++) X[M_IDX[0][n]*A.stride(0)] = M_VAL[n];
+    return;
+  }
+  for (size_t r=0;r<nodes(0);r++)
+  {
+    off[1] = M_IDX[0][r]*A.stride(NN-1);
+    node[1] = M_PTR[0][r];
+    end[1]  = M_PTR[0][r+1];
+    size_t l = 1;
+    while (l > 0)
+    {
+      if (node[l] == end[l]) {l--; if (l > 0) node[l]++; continue;}
+      const size_t d = NN-1-l;
+      const size_t o = off[l] + M_IDX[l][node[l]]*A.stride(d);
+      if (l == NN-1)
+      {
+        X[o] = M_VAL[node[l]];
+        node[l]++;
+      } else {
+        off[l+1]  = o;
+        node[l+1] = M_PTR[l][node[l]];
+        end[l+1]  = M_PTR[l][node[l]+1];
+        l++;
+      }
+    }
+  }
+}
+
+}//end of namespace
+
+#endif
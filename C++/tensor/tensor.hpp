@@ -1,6 +1,10 @@
 /*----------------------------------------------------------------------------
   tensor.hpp
 	JHT, April 10, 2022 : created
+	JHT, October 14, 2026 : malloc memory is counted in mem_registry
+	JHT, October 14, 2026 : bounds checks on () with -DLIBJ_CHECKED
+	JHT, October 14, 2026 : reshape and permuted views, as_matrix
+	JHT, October 14, 2026 : relength
 
   .hpp file for the general tensor class. This behaves similarly to 
   std::array in that it cannot be grown dynamically, though it can be 
@@ -13,6 +17,11 @@
   displacement from the buffer pointer, is the most efficient provided you are
   certain you are using it correctly! 
 
+  The lengths and strides are kept in fixed arrays of LIBJ_TENSOR_MAX_DIM 
+  elements inside the tensor, so creating or copying a tensor (e.g., a view
+  assigned to existing memory) never touches the heap. Define 
+  LIBJ_TENSOR_MAX_DIM before including this file for more dimensions.
+
 
   INITIALIZATION
   -------------------
@@ -34,8 +43,46 @@
     T.deallocate();
     T.unassign();
 
+  Allocate from an allocator handle (see allocator.hpp and core_arena.hpp)
+  instead of malloc. This is kept until the tensor is unassigned or
+  assigned to another. It is set before allocating, changing it on an
+  allocated tensor is an error
+    T.set_allocator(&arena);
+    T.aligned_allocate(64,1,4,3);
+
+  Huge pages (see huge_pages.hpp), for this tensor or, via the global mode,
+  for every tensor of at least LIBJ_HUGE_PAGE_MIN bytes that has no allocator
+    T.set_allocator(&libj::huge_allocator<double>::shared(libj::LIBJ_PAGES_2M));
+    libj::set_huge_pages(libj::LIBJ_PAGES_2M);
+
   Reassignment (including reshaping)
     T.assign(pointer, 2,5,1);
+    T.assign(pointer, lengths);   //std::vector of lengths, for run-time ranks
+    T.assign(pointer, lengths, strides); //and strides, e.g., from a tensor_file
+
+  Strided views (see tensor_range.hpp), which share the memory of T
+    libj::tensor<double> V = T.slice(libj::range(0,2),3,libj::range(1,5,2));
+
+  Reshaped views of a sequential tensor, and views with permuted strides,
+  which also share the memory of T
+    libj::tensor<double> R = T.reshape(4,15);
+    libj::tensor<double> P = T.permuted({2,0,1});	//P(k,i,j) = T(i,j,k)
+
+  New lengths for a sequential tensor itself, which keeps its memory (and
+  whether it is allocated or assigned), e.g. after libj::permute_inplace
+    T.relength({5,3,4});
+
+  A tensor (or view) as a column major matrix with a leading dimension, of
+  dimensions [0,split) by [split,dim()), to give linal_* with LDs a block of
+  a tensor without a copy. Returns false if the strides do not allow it
+    size_t rows, cols, ld;
+    if (V.as_matrix(2,rows,cols,ld)) linal_gemm('N',rows,n,cols,...,V.data(),ld,...);
+
+  Contiguous runs of a strided tensor (see tensor_runs.hpp), for simd kernels
+    libj::for_each_run(V,[](double* p, size_t n){simd_zero(n,p);});
+
+  Element-wise expressions (see tensor_expr.hpp), evaluated in one loop
+    C = 2.0*A + B*D;
   
   ELEMENT ACCESS
   ------------------
@@ -73,9 +120,20 @@
 #include <stdarg.h>
 #include <vector>
 
+//largest number of dimensions of a tensor
+#if !defined (LIBJ_TENSOR_MAX_DIM)
+  #define LIBJ_TENSOR_MAX_DIM 8
+#endif
+
 //This defines alignments
 #include "libjdef.h"
 #include "alignment.hpp"
+#include "allocator.hpp"
+#include "huge_pages.hpp"
+#include "mem_registry.hpp"
+#include "debug.hpp"
+#include "tensor_range.hpp"
+#include "tensor_expr.hpp"
 
 namespace libj 
 {
@@ -87,8 +145,9 @@ class tensor
   private:
   T*                  M_BUFFER;        //start of data
   T*                  M_POINTER;       //pointer to malloc	
-  std::vector<size_t> M_LENGTHS;       //vector of lengths 
-  std::vector<size_t> M_STRIDE;        //pointer to strides
+  libj::allocator<T>* M_ALLOCATOR;     //allocator, NULL for malloc
+  size_t              M_LENGTHS[LIBJ_TENSOR_MAX_DIM]; //lengths 
+  size_t              M_STRIDE[LIBJ_TENSOR_MAX_DIM];  //strides
   size_t	          M_NDIM;          //number of dimensions
   size_t              M_NELM;          //total number of elements
   size_t              M_ALIGNMENT;     //alignment in bytes
@@ -103,6 +162,7 @@ class tensor
   void m_assign(T* pointer);
   void m_assign(const T* pointer);
   void m_sequential();
+  void m_global_allocator();
 
   //internal varadic templates for data access
   template<class...Rest>
@@ -115,12 +175,38 @@ class tensor
     return first*M_STRIDE[level];
   }
   size_t m_index(const size_t level) const {return 0;}
+
+  //internal varadic templates for the checked build bounds checks
+  template<class...Rest>
+  void m_check(const size_t level, const size_t first, const Rest...rest) const
+  {
+    LIBJ_CHECK(level < M_NDIM,"more than the %ld indices of the tensor",(long) M_NDIM);
+    LIBJ_CHECK(first < M_LENGTHS[level],"index %ld of dimension %ld is not in [0,%ld)",
+               (long) first,(long) level,(long) M_LENGTHS[level]);
+    m_check(level+1,rest...);
+  }
+  void m_check(const size_t level) const
+  {
+    LIBJ_CHECK(level == M_NDIM,"%ld indices for a tensor of %ld",(long) level,(long) M_NDIM);
+  }
   
 
   //internal varadic templates for initialization
+  void m_push(const size_t first)
+  {
+    if (M_NDIM >= LIBJ_TENSOR_MAX_DIM)
+    {
+      printf("ERROR libj::tensor::m_init\n");
+      printf("More than LIBJ_TENSOR_MAX_DIM = %d dimensions \n",LIBJ_TENSOR_MAX_DIM);
+      exit(1);
+    }
+    M_STRIDE[M_NDIM] = M_NELM;
+    M_LENGTHS[M_NDIM] = first;
+    M_NELM *= first;
+    M_NDIM++;
+  }
   void m_init()
   {
-    M_NDIM = M_LENGTHS.size();
     for (size_t i=0;i<M_NDIM;i++)
     {
       if (M_LENGTHS[i] <= 0)
@@ -133,28 +219,52 @@ class tensor
   }
   void m_init(const size_t first)
   {
-    M_STRIDE.push_back(M_NELM);
-    M_LENGTHS.push_back(first);
-    M_NELM *= first;
+    m_push(first);
     m_init();
   }
   template <class...Rest> void m_init(const size_t first, const Rest...rest)
   {
-    M_STRIDE.push_back(M_NELM);
-    M_LENGTHS.push_back(first);
-    M_NELM *= first;
+    m_push(first);
     m_init(rest...);
   }
 
-  //Internal varadic templates for block
-/*
+  //internal varadic templates for slice
+  void m_slice(const size_t level, tensor<T>& V, size_t& offset) const {}
+  template<class...Rest> 
+  void m_slice(const size_t level, tensor<T>& V, size_t& offset, 
+               const libj::range& first, const Rest...rest) const
+  {
+    const size_t s = first.all ? 0 : first.start;
+    const size_t e = first.all ? M_LENGTHS[level] : first.end;
+    if (first.step < 1 || s >= e || e > M_LENGTHS[level])
+    {
+      printf("ERROR libj::tensor::slice\n");
+      printf("Bad range [%zu,%zu,%zu) for dimension %zu of length %zu \n",
+             s,e,first.step,level,M_LENGTHS[level]);
+      exit(1);
+    }
+    const size_t n = (e - s + first.step - 1)/first.step;
+    V.M_LENGTHS[V.M_NDIM] = n;
+    V.M_STRIDE[V.M_NDIM] = M_STRIDE[level]*first.step;
+    V.M_NELM *= n;
+    V.M_NDIM++;
+    offset += s*M_STRIDE[level];
+    m_slice(level+1,V,offset,rest...);
+  }
   template<class...Rest> 
-  void m_block(const size_t level, std::vector<size_t>& start,
-               std::vector<size_t>& length, const size_t first,
-               const Rest...rest) const;
-  void m_block(const size_t level, std::vector<size_t>& start,
-               std::vector<size_t>& length, const size_t last) const;
-*/
+  void m_slice(const size_t level, tensor<T>& V, size_t& offset, 
+               const size_t first, const Rest...rest) const
+  {
+    if (first >= M_LENGTHS[level])
+    {
+      printf("ERROR libj::tensor::slice\n");
+      printf("Index %zu is out of dimension %zu of length %zu \n",
+             first,level,M_LENGTHS[level]);
+      exit(1);
+    }
+    offset += first*M_STRIDE[level];
+    m_slice(level+1,V,offset,rest...);
+  }
   
   public:
 
@@ -178,12 +288,34 @@ class tensor
                                                const Rest...rest);
   template<class...Rest> void assign(T* pointer, const size_t first,const Rest...rest);
   template<class...Rest> void assign(const T* pointer, const size_t first,const Rest...rest);
+  void assign(T* pointer, const std::vector<size_t>& lengths);
+  void assign(T* pointer, const std::vector<size_t>& lengths,
+              const std::vector<size_t>& strides);
   void deallocate();
   void unassign();
+  void set_allocator(libj::allocator<T>* alloc)
+  {
+    //the storage is freed through the allocator that made it
+    if (M_IS_ALLOCATED && alloc != M_ALLOCATOR)
+    {
+      printf("ERROR libj::tensor::set_allocator\n");
+      printf("Attempted to change the allocator of an allocated tensor \n");
+      exit(1);
+    }
+    M_ALLOCATOR = alloc;
+  }
+  libj::allocator<T>* get_allocator() const {return M_ALLOCATOR;}
 
   //equals assign
   tensor<T>& operator= (const tensor<T>& other);
 
+  //evaluate an expression into this tensor
+  template <class E> tensor<T>& operator= (const libj::tensor_node<E>& expr)
+  {
+    libj::tensor_eval(*this,expr);
+    return *this;
+  }
+
   //Getters
   size_t size() const {return M_NELM;}
   size_t size(const size_t dim) const {return M_LENGTHS[dim];}
@@ -201,29 +333,45 @@ class tensor
 
   template<class...Rest> T& operator() (const size_t i0,const Rest...rest)
   {
+    #if defined (LIBJ_CHECKED)
+    m_check(0,i0,rest...);
+    #endif
     return *(M_BUFFER + i0*M_STRIDE[0] + m_index(1,rest...));
   }
 
   template<class...Rest> const T& operator() (const size_t i0,const Rest...rest) const
   {
+    #if defined (LIBJ_CHECKED)
+    m_check(0,i0,rest...);
+    #endif
     return *(M_BUFFER + i0*M_STRIDE[0] + m_index(1,rest...));
   }
 
-  T& operator() (const std::vector<size_t> vec)
+  T& operator() (const std::vector<size_t>& vec)
   {
     size_t offset = 0;
-    for (size_t dim=0;dim<M_NDIM;dim++) {offset += M_STRIDE[dim]*vec[dim];}
+    LIBJ_CHECK(vec.size() == M_NDIM,"%ld indices for a tensor of %ld",(long) vec.size(),(long) M_NDIM);
+    for (size_t dim=0;dim<M_NDIM;dim++)
+    {
+      LIBJ_CHECK_BOUNDS(vec[dim],M_LENGTHS[dim]);
+      offset += M_STRIDE[dim]*vec[dim];
+    }
     return *(M_BUFFER+offset);
   }
-  const T& operator() (const std::vector<size_t> vec) const
+  const T& operator() (const std::vector<size_t>& vec) const
   {
     size_t offset = 0;
-    for (size_t dim=0;dim<M_NDIM;dim++) {offset += M_STRIDE[dim]*vec[dim];}
+    LIBJ_CHECK(vec.size() == M_NDIM,"%ld indices for a tensor of %ld",(long) vec.size(),(long) M_NDIM);
+    for (size_t dim=0;dim<M_NDIM;dim++)
+    {
+      LIBJ_CHECK_BOUNDS(vec[dim],M_LENGTHS[dim]);
+      offset += M_STRIDE[dim]*vec[dim];
+    }
     return *(M_BUFFER+offset);
   }
 
   //Offset function
-  size_t offset(const std::vector<size_t> vec) const
+  size_t offset(const std::vector<size_t>& vec) const
   {
     size_t offset = 0;
     for (size_t dim=0;dim<M_NDIM;dim++) {offset += M_STRIDE[dim]*vec[dim];}
@@ -235,15 +383,34 @@ class tensor
   const T* data() const {return M_BUFFER;}
 
 
-  //Create a block
-/*
-  template<class...Rest> tensor<T> block(const size_t first, const Rest...rest) const;
-*/
+  //Create a strided view
+  template<class...Rest> tensor<T> slice(const Rest...rest) const;
+
+  //Create a view with new lengths, of a sequential tensor
+  template<class...Rest> tensor<T> reshape(const size_t first, const Rest...rest) const;
+
+  //New lengths for this sequential tensor, in place
+  void relength(const std::vector<size_t>& lengths);
+
+  //Create a view with the dimensions in order, V.size(d) = size(order[d])
+  tensor<T> permuted(const std::vector<size_t>& order) const;
+
+  //rows, cols, and ld of the tensor as a column major matrix
+  bool as_matrix(const size_t split, size_t& rows, size_t& cols, size_t& ld) const;
 
   template<typename T1, typename T2> friend bool can_alias(const tensor<T1>& A, 
                                                            const tensor<T2>& B);
 }; //end of normal tensor
 
+//-----------------------------------------------------------------------
+// tensors are leaves of expressions 
+//-----------------------------------------------------------------------
+template <typename T> struct tensor_arg<tensor<T> >
+{
+  typedef tensor_leaf<T> type;
+  static type make(const tensor<T>& x) {return type(x);}
+};
+
 //-----------------------------------------------------------------------
 // returns true if the tensors are the same shape
 //-----------------------------------------------------------------------
@@ -287,14 +454,13 @@ void tensor<T>::m_set_default()
 { 
   M_BUFFER = NULL;
   M_POINTER = NULL;
+  M_ALLOCATOR = NULL;
   M_NELM = 0; 
   M_ALIGNMENT = 0; 
   M_IS_ALLOCATED = false;
   M_IS_ASSIGNED = false;
   M_IS_SEQUENTIAL = false;
-  M_LENGTHS.clear();
-  M_STRIDE.clear();
-  
+  M_NDIM = 0;
 }
 
 //-----------------------------------------------------------------------
@@ -325,10 +491,9 @@ tensor<T>::tensor(const size_t first,const Rest...rest)
   m_set_default();
 
   //initialize
-  M_LENGTHS.push_back(first);
-  M_STRIDE.push_back(1);
-  M_NELM = first; 
-  m_init(rest...);//performs rest of varadic initialization
+  M_NDIM = 0;
+  M_NELM = 1; 
+  m_init(first,rest...);//performs varadic initialization
 
   //call the internal allocate function
   m_allocate();
@@ -345,10 +510,9 @@ tensor<T>::tensor(T* pointer, const size_t first,const Rest...rest)
   m_set_default();
 
   //Initialize
-  M_LENGTHS.push_back(first);
-  M_STRIDE.push_back(1);
-  M_NELM = first; 
-  m_init(rest...);//performs rest of varadic initialization
+  M_NDIM = 0;
+  M_NELM = 1; 
+  m_init(first,rest...);//performs varadic initialization
 
   //call the internal allocate function
   m_assign(pointer);
@@ -364,10 +528,9 @@ tensor<T>::tensor(const T* pointer, const size_t first,const Rest...rest)
   m_set_default();
 
   //Initialize
-  M_LENGTHS.push_back(first);
-  M_STRIDE.push_back(1);
-  M_NELM = first; 
-  m_init(rest...);//performs rest of varadic initialization
+  M_NDIM = 0;
+  M_NELM = 1; 
+  m_init(first,rest...);//performs varadic initialization
 
   //call the internal allocate function
   m_assign(pointer);
@@ -381,7 +544,10 @@ void tensor<T>::m_allocate()
 {
   if (!M_IS_ALLOCATED && !M_IS_ASSIGNED)
   {
-    M_POINTER = (T*) malloc(sizeof(T)*M_NELM);
+    m_global_allocator();
+    M_POINTER = (M_ALLOCATOR != NULL) ? M_ALLOCATOR->allocate(sizeof(T),M_NELM)
+                                      : (T*) malloc(sizeof(T)*M_NELM);
+    if (M_ALLOCATOR == NULL) {libj::mem_track(M_POINTER,sizeof(T)*M_NELM);}
     M_BUFFER = M_POINTER;
     if (M_BUFFER == NULL || M_POINTER == NULL)
     {
@@ -457,8 +623,11 @@ void libj::tensor<T>::m_aligned_allocate(const size_t ALIGN)
       exit(1);
     }
 
-    //align the buffer pointer  
-    M_POINTER = (T*) malloc(ALIGN+M_NELM*sizeof(T));
+    //align the buffer pointer, the allocator returns aligned memory
+    m_global_allocator();
+    M_POINTER = (M_ALLOCATOR != NULL) ? M_ALLOCATOR->allocate(ALIGN,M_NELM)
+                                      : (T*) malloc(ALIGN+M_NELM*sizeof(T));
+    if (M_ALLOCATOR == NULL) {libj::mem_track(M_POINTER,ALIGN+M_NELM*sizeof(T));}
     if (M_POINTER != NULL)
     {
       long M = (long)M_POINTER%(long)ALIGN; //number of bytes off
@@ -496,6 +665,20 @@ void libj::tensor<T>::m_aligned_allocate(const size_t ALIGN)
   }
 }
 
+//-----------------------------------------------------------------------
+// large tensors without an allocator use the global huge page mode 
+//-----------------------------------------------------------------------
+template <typename T> 
+void tensor<T>::m_global_allocator()
+{
+  const libj::huge_page_mode mode = libj::huge_pages();
+  if (M_ALLOCATOR == NULL && mode != libj::LIBJ_PAGES_NONE && 
+      M_NELM*sizeof(T) >= LIBJ_HUGE_PAGE_MIN)
+  {
+    M_ALLOCATOR = &libj::huge_allocator<T>::shared(mode);
+  }
+}
+
 //-----------------------------------------------------------------------
 // determine if data is sequential 
 //-----------------------------------------------------------------------
@@ -521,10 +704,9 @@ void tensor<T>::allocate(const size_t first,const Rest...rest)
 {
   if (!M_IS_ALLOCATED && !M_IS_ASSIGNED)
   {
-    M_LENGTHS.push_back(first);
-    M_STRIDE.push_back(1);
-    M_NELM = first;
-    m_init(rest...);
+    M_NDIM = 0;
+    M_NELM = 1;
+    m_init(first,rest...);
     m_allocate();
   } else {
     printf("ERROR libj::tensor::allocate\n");
@@ -542,10 +724,9 @@ void tensor<T>::aligned_allocate(const size_t BYTES, const size_t first,
 {
   if (!M_IS_ALLOCATED && !M_IS_ASSIGNED)
   {
-    M_LENGTHS.push_back(first);
-    M_STRIDE.push_back(1);
-    M_NELM = first;
-    m_init(rest...);
+    M_NDIM = 0;
+    M_NELM = 1;
+    m_init(first,rest...);
     m_aligned_allocate(BYTES);
   } else {
     printf("ERROR libj::tensor::aligned_allocate\n");
@@ -562,10 +743,29 @@ void tensor<T>::assign(T* pointer, const size_t first,const Rest...rest)
 {
   if (!M_IS_ALLOCATED)
   {
-    M_LENGTHS.push_back(first);
-    M_STRIDE.push_back(1);
-    M_NELM = first;
-    m_init(rest...);
+    M_NDIM = 0;
+    M_NELM = 1;
+    m_init(first,rest...);
+    m_assign(pointer);
+  } else {
+    printf("ERROR libj::tensor::assign\n");
+    printf("attempted to assign an already allocated tensor\n");
+    exit(1);
+  }
+}
+
+//-----------------------------------------------------------------------
+// assign with the lengths in a vector 
+//-----------------------------------------------------------------------
+template <typename T>
+void tensor<T>::assign(T* pointer, const std::vector<size_t>& lengths)
+{
+  if (!M_IS_ALLOCATED)
+  {
+    M_NDIM = 0;
+    M_NELM = 1;
+    for (size_t d=0;d<lengths.size();d++) m_push(lengths[d]);
+    m_init();
     m_assign(pointer);
   } else {
     printf("ERROR libj::tensor::assign\n");
@@ -575,15 +775,48 @@ void tensor<T>::assign(T* pointer, const size_t first,const Rest...rest)
 }
 
 //-----------------------------------------------------------------------
-// deallocate via free 
+// assign with the lengths and strides in vectors 
+//-----------------------------------------------------------------------
+template <typename T>
+void tensor<T>::assign(T* pointer, const std::vector<size_t>& lengths,
+                       const std::vector<size_t>& strides)
+{
+  if (M_IS_ALLOCATED)
+  {
+    printf("ERROR libj::tensor::assign\n");
+    printf("attempted to assign an already allocated tensor\n");
+    exit(1);
+  }
+  if (strides.size() != lengths.size())
+  {
+    printf("ERROR libj::tensor::assign\n");
+    printf("%zu strides given for %zu lengths\n",strides.size(),lengths.size());
+    exit(1);
+  }
+  M_NDIM = 0;
+  M_NELM = 1;
+  for (size_t d=0;d<lengths.size();d++) m_push(lengths[d]);
+  for (size_t d=0;d<strides.size();d++) M_STRIDE[d] = strides[d];
+  m_init();
+  m_assign(pointer);
+}
+
+//-----------------------------------------------------------------------
+// deallocate via free, or the allocator 
 //-----------------------------------------------------------------------
 template<typename T>
 void tensor<T>::deallocate()
 {
   if (M_IS_ALLOCATED)
   {
-    if (M_POINTER != NULL) {free(M_POINTER);}
+    if (M_POINTER != NULL) 
+    {
+      if (M_ALLOCATOR != NULL) {M_ALLOCATOR->deallocate(M_POINTER,M_NELM);}
+      else                     {libj::mem_untrack(M_POINTER); free(M_POINTER);}
+    }
+    M_POINTER = NULL;
     M_BUFFER = NULL;
+    M_IS_ALLOCATED = false;
   } else {
     printf("ERROR libj::tensor::deallocate \n");
     printf("attempted to deallocate an unallocated tensor \n");
@@ -636,8 +869,8 @@ tensor<T>& tensor<T>::operator= (const tensor<T>& other)
   M_NELM = other.M_NELM;
   for (size_t dim=0;dim<M_NDIM;dim++)
   {
-    M_LENGTHS.push_back(other.M_LENGTHS[dim]); 
-    M_STRIDE.push_back(other.M_STRIDE[dim]); 
+    M_LENGTHS[dim] = other.M_LENGTHS[dim]; 
+    M_STRIDE[dim] = other.M_STRIDE[dim]; 
   }
    
   //assign to the buffer of the other
@@ -667,8 +900,8 @@ tensor<T>::tensor(const tensor<T>& other)
   M_NELM = other.M_NELM;
   for (size_t dim=0;dim<M_NDIM;dim++)
   {
-    M_LENGTHS.push_back(other.M_LENGTHS[dim]); 
-    M_STRIDE.push_back(other.M_STRIDE[dim]); 
+    M_LENGTHS[dim] = other.M_LENGTHS[dim]; 
+    M_STRIDE[dim] = other.M_STRIDE[dim]; 
   }
    
   //assign to the buffer of the other
@@ -677,73 +910,163 @@ tensor<T>::tensor(const tensor<T>& other)
 }
 
 //-----------------------------------------------------------------------
-// block
+// slice
 //	varadic template for creating a new tensor that points to a 
-//	block of this tensor
-//
-// 	The first NDIM elements are the starting indices
-//	  the next NDIM elements are the lengths of the blocks
+//	strided block of this tensor. There is one argument per dimension,
+//	either a libj::range, or a fixed index which drops the dimension. 
+//	The new tensor is assigned, so no memory is allocated 
 //-----------------------------------------------------------------------
-/*
 template <typename T> template<class...Rest>
-tensor<T> tensor<T>::block(const size_t first, const Rest...rest) const
+tensor<T> tensor<T>::slice(const Rest...rest) const
 {
-  //initialize the new tensor
-  tensor<T> TNEW; 
-  TNEW.M_NDIM = M_NDIM;
-  TNEW.M_LENGTHS.reserve(M_NDIM);
-  TNEW.M_STRIDE.reserve(M_NDIM);
-  std::vector<size_t> start(M_NDIM);
-  std::vector<size_t> length(M_NDIM);
-
-  //initialize the start and length vectors
-  start[0] = first;
-  m_block(1,start,length,rest...);
-
-  //Set the new tensor's shape -- make sure we don't go out of bounds!!
-  TNEW.M_NELM = 1;
-  T* pointer=M_BUFFER; 
-  for (size_t dim=0;dim<M_NDIM;dim++)
+  if (!is_set())
   {
-    TNEW.M_LENGTHS.push_back(std::min(length[dim],M_LENGTHS[dim] - start[dim]));  
-    TNEW.M_STRIDE.push_back(M_STRIDE[dim]);
-    TNEW.M_NELM *= TNEW.M_LENGTHS[dim];
-    pointer += M_STRIDE[dim]*start[dim];
+    printf("ERROR libj::tensor::slice \n");
+    printf("tensor is not set \n");
+    exit(1);
   }
-  if (TNEW.M_NELM <= 0) 
+  if (sizeof...(rest) != M_NDIM)
+  {
+    printf("ERROR libj::tensor::slice \n");
+    printf("%zu indices given for a tensor of %zu dimensions \n",sizeof...(rest),M_NDIM);
+    exit(1);
+  }
+
+  tensor<T> V;
+  V.M_NELM = 1;
+  size_t offset = 0;
+  m_slice(0,V,offset,rest...);
+  V.m_assign(M_BUFFER+offset);
+  return V;
+}
+
+//-----------------------------------------------------------------------
+// reshape
+//	new tensor with the lengths given, that points to the memory of 
+//	this one. The tensor must be sequential, and the number of 
+//	elements the same. The new tensor is assigned, so no memory is
+//	allocated or copied
+//-----------------------------------------------------------------------
+template <typename T> template<class...Rest>
+tensor<T> tensor<T>::reshape(const size_t first, const Rest...rest) const
+{
+  if (!is_set() || !M_IS_SEQUENTIAL)
   {
-    printf("ERROR libj::tensor::block \n");
-    printf("Tensor block had <= 0 elements \n");
+    printf("ERROR libj::tensor::reshape \n");
+    printf("tensor is not set, or not sequential \n");
     exit(1);
   }
-  TNEW.m_assign(pointer);
 
-  return TNEW;
+  tensor<T> V;
+  V.M_NDIM = 0;
+  V.M_NELM = 1;
+  V.m_init(first,rest...);
+  if (V.M_NELM != M_NELM)
+  {
+    printf("ERROR libj::tensor::reshape \n");
+    printf("%zu elements can not be reshaped to %zu \n",M_NELM,V.M_NELM);
+    exit(1);
+  }
+  V.m_assign(M_BUFFER);
+  return V;
+}
 
+//-----------------------------------------------------------------------
+// relength
+//	gives this tensor new lengths, with the same number of 
+//	elements. The tensor must be sequential, and keeps its memory,
+//	so an allocated tensor stays allocated
+//-----------------------------------------------------------------------
+template <typename T>
+void tensor<T>::relength(const std::vector<size_t>& lengths)
+{
+  size_t nelm = 1;
+  for (size_t d=0;d<lengths.size();d++) nelm *= lengths[d];
+  if (!is_set() || !M_IS_SEQUENTIAL || nelm != M_NELM)
+  {
+    printf("ERROR libj::tensor::relength \n");
+    printf("tensor is not set or not sequential, or %zu elements can not be relengthed to %zu \n",
+           M_NELM,nelm);
+    exit(1);
+  }
+  M_NDIM = 0;
+  M_NELM = 1;
+  for (size_t d=0;d<lengths.size();d++) m_push(lengths[d]);
+  m_init();
 }
-*/
 
 //-----------------------------------------------------------------------
-// m_block
-//	internal function to construct block of matrix
+// permuted
+//	new tensor whose dimension d is dimension order[d] of this one, 
+//	so P(k,i,j) = T(i,j,k) for order {2,0,1}. Only the lengths and
+//	strides are permuted, the memory is shared
 //-----------------------------------------------------------------------
-/*
-template<typename T>
-void tensor<T>::m_block(const size_t level, std::vector<size_t>& start,
-                        std::vector<size_t>& length, const size_t last) const
+template <typename T>
+tensor<T> tensor<T>::permuted(const std::vector<size_t>& order) const
 {
-  length[level-M_NDIM] = last;
+  bool good = is_set() && (order.size() == M_NDIM);
+  bool seen[LIBJ_TENSOR_MAX_DIM] = {false};
+  for (size_t d=0;good && d<order.size();d++)
+  {
+    good = (order[d] < M_NDIM && !seen[order[d]]);
+    if (good) seen[order[d]] = true;
+  }
+  if (!good)
+  {
+    printf("ERROR libj::tensor::permuted \n");
+    printf("tensor is not set, or the order is not a permutation of %zu dimensions \n",M_NDIM);
+    exit(1);
+  }
+
+  tensor<T> V;
+  V.M_NDIM = M_NDIM;
+  V.M_NELM = M_NELM;
+  for (size_t d=0;d<M_NDIM;d++)
+  {
+    V.M_LENGTHS[d] = M_LENGTHS[order[d]];
+    V.M_STRIDE[d] = M_STRIDE[order[d]];
+  }
+  V.m_assign(M_BUFFER);
+  return V;
 }
 
-template <typename T> template<class...Rest>
-void tensor<T>::m_block(const size_t level, std::vector<size_t>& start,
-                        std::vector<size_t>& length, const size_t first,
-                        const Rest...rest) const
+//-----------------------------------------------------------------------
+// as_matrix
+//	the tensor as a column major matrix, with the dimensions 
+//	[0,split) as the rows, and [split,dim()) as the columns. This 
+//	needs the row dimensions to be sequential, and the column 
+//	dimensions to be sequential in the column stride, which is ld. 
+//	Dimensions of length 1 do not matter. Returns false otherwise 
+//-----------------------------------------------------------------------
+template <typename T>
+bool tensor<T>::as_matrix(const size_t split, size_t& rows, size_t& cols, size_t& ld) const
 {
-  level < M_NDIM ? start[level] = first : length[level-M_NDIM] = first;
-  m_block(level+1,start,length,rest...);
+  if (!is_set() || split > M_NDIM) return false;
+  rows = 1;
+  for (size_t d=0;d<split;d++)
+  {
+    if (M_LENGTHS[d] == 1) continue;
+    if (M_STRIDE[d] != rows) return false;
+    rows *= M_LENGTHS[d];
+  }
+  cols = 1;
+  ld = rows;
+  bool first = true;
+  for (size_t d=split;d<M_NDIM;d++)
+  {
+    if (M_LENGTHS[d] == 1) continue;
+    if (first)
+    {
+      if (M_STRIDE[d] < rows) return false;
+      ld = M_STRIDE[d];
+      first = false;
+    } else if (M_STRIDE[d] != ld*cols) {
+      return false;
+    }
+    cols *= M_LENGTHS[d];
+  }
+  return true;
 }
-*/
 
 }//end of namespace
 
@@ -0,0 +1,319 @@
+/*----------------------------------------------------------------------------
+  tensor_expr.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for the element-wise tensor expressions, which are lazy 
+  (expression templates). An expression of tensors and scalars, e.g.
+
+    auto e = 2.0*A + B*D;
+    C = e;
+
+  builds a small tree of nodes that only hold views of A, B and D, and the
+  assignment to C evaluates the whole tree in one fused loop over C, with no
+  temporary tensors and one pass over memory. The operators are +, -, *
+  and /, all element-wise, between tensors, expressions and scalars.
+
+  This is included by tensor.hpp and tensor_fixed.hpp, which define the
+  tensor_arg specialization that turns their tensors into leaves, and the
+  operator= that calls tensor_eval.
+
+  Evaluation
+  -------------------
+  All tensors must have the same dimensions. If C and every leaf are 
+  sequential, the loop is over the flat index. Otherwise, the loop is over 
+  the lines of the first dimension, and any strides (e.g., slices) are 
+  allowed. Loops of at least LIBJ_TENSOR_EXPR_PAR elements are split over 
+  OpenMP threads.
+
+  A leaf that is C itself (same memory and strides) is fine, e.g. C = C + A.
+  A leaf that overlaps C in any other way would be overwritten while it is 
+  read, so the expression is evaluated into a temporary, and then copied.
+  The overlap test is the address range test of can_alias, taken over the 
+  strided extent of the tensors.
+----------------------------------------------------------------------------*/
+#ifndef TENSOR_EXPR_HPP
+#define TENSOR_EXPR_HPP
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <vector>
+
+//largest number of dimensions of a leaf 
+#if !defined (LIBJ_TENSOR_MAX_DIM)
+  #define LIBJ_TENSOR_MAX_DIM 8
+#endif
+
+//smallest number of elements for OpenMP threads
+#if !defined (LIBJ_TENSOR_EXPR_PAR)
+  #define LIBJ_TENSOR_EXPR_PAR 32768
+#endif
+
+namespace libj
+{
+
+//base of all the nodes
+template <class E>
+struct tensor_node
+{
+  const E& self() const {return *static_cast<const E*>(this);}
+};
+
+//-----------------------------------------------------------------------
+// tensor_leaf
+//	view of a tensor in an expression
+//-----------------------------------------------------------------------
+template <typename T>
+struct tensor_leaf : public tensor_node<tensor_leaf<T> >
+{
+  typedef T value_type;
+  const T* P;                        //start of data
+  const T* B;                        //start of the current line
+  size_t   ND;                       //number of dimensions
+  size_t   NELM;                     //number of elements
+  size_t   LEN[LIBJ_TENSOR_MAX_DIM]; //lengths
+  size_t   S[LIBJ_TENSOR_MAX_DIM];   //strides
+
+  template <class TT>
+  tensor_leaf(const TT& X)
+  {
+    if (!X.is_set() || X.dim() > LIBJ_TENSOR_MAX_DIM)
+    {
+      printf("ERROR libj::tensor_leaf \n");
+      printf("tensor is not set, or has more than LIBJ_TENSOR_MAX_DIM dimensions\n");
+      exit(1);
+    }
+    P = X.data();
+    B = P;
+    ND = X.dim();
+    NELM = 1;
+    for (size_t d=0;d<ND;d++) {LEN[d] = X.size(d); S[d] = X.stride(d); NELM *= LEN[d];}
+  }
+
+  //flat and line access
+  T operator[] (const size_t i) const {return P[i];}
+  T line(const size_t i) const {return B[i*S[0]];}
+  void seek(const size_t* idx) 
+  {
+    B = P; 
+    for (size_t d=1;d<ND;d++) B += idx[d]*S[d];
+  }
+
+  //true if the elements are in order
+  bool sequential() const
+  {
+    size_t NN = 1;
+    for (size_t d=0;d<ND;d++) 
+    {
+      if (LEN[d] != 1 && S[d] != NN) return false;
+      NN *= LEN[d];
+    }
+    return true;
+  }
+
+  //true if this has the same dimensions as C
+  bool check(const tensor_leaf<T>& C) const
+  {
+    if (ND != C.ND) return false;
+    for (size_t d=0;d<ND;d++) {if (LEN[d] != C.LEN[d]) return false;}
+    return true;
+  }
+
+  //last element of the strided extent 
+  const T* last() const
+  {
+    const T* L = P;
+    for (size_t d=0;d<ND;d++) L += (LEN[d]-1)*S[d];
+    return L;
+  }
+
+  //true if writing C while reading this is unsafe
+  bool unsafe(const tensor_leaf<T>& C) const
+  {
+    const size_t a = (size_t) P;
+    const size_t b = (size_t) last(); 
+    const size_t x = (size_t) C.P;
+    const size_t y = (size_t) C.last(); 
+    if (b < x || y < a) return false;
+    if (P != C.P) return true;
+    for (size_t d=0;d<ND;d++) {if (LEN[d] != 1 && S[d] != C.S[d]) return true;}
+    return false;
+  }
+};
+
+//-----------------------------------------------------------------------
+// tensor_scalar
+//	constant in an expression
+//-----------------------------------------------------------------------
+template <typename T>
+struct tensor_scalar : public tensor_node<tensor_scalar<T> >
+{
+  typedef T value_type;
+  T V;
+
+  tensor_scalar(const T val) : V(val) {}
+  T operator[] (const size_t i) const {return V;}
+  T line(const size_t i) const {return V;}
+  void seek(const size_t* idx) {}
+  bool sequential() const {return true;}
+  bool check(const tensor_leaf<T>& C) const {return true;}
+  bool unsafe(const tensor_leaf<T>& C) const {return false;}
+};
+
+//-----------------------------------------------------------------------
+// tensor_binary
+//	element-wise operation of two nodes
+//-----------------------------------------------------------------------
+struct tensor_op_add {template <typename T> static T apply(const T a, const T b) {return a + b;}};
+struct tensor_op_sub {template <typename T> static T apply(const T a, const T b) {return a - b;}};
+struct tensor_op_mul {template <typename T> static T apply(const T a, const T b) {return a * b;}};
+struct tensor_op_div {template <typename T> static T apply(const T a, const T b) {return a / b;}};
+
+template <class OP, class L, class R>
+struct tensor_binary : public tensor_node<tensor_binary<OP,L,R> >
+{
+  typedef typename L::value_type value_type;
+  L l;
+  R r;
+
+  tensor_binary(const L& left, const R& right) : l(left), r(right) {}
+  value_type operator[] (const size_t i) const {return OP::apply(l[i],r[i]);}
+  value_type line(const size_t i) const {return OP::apply(l.line(i),r.line(i));}
+  void seek(const size_t* idx) {l.seek(idx); r.seek(idx);}
+  bool sequential() const {return l.sequential() && r.sequential();}
+  bool check(const tensor_leaf<value_type>& C) const {return l.check(C) && r.check(C);}
+  bool unsafe(const tensor_leaf<value_type>& C) const {return l.unsafe(C) || r.unsafe(C);}
+};
+
+//-----------------------------------------------------------------------
+// tensor_arg
+//	maps the arguments of the operators to nodes. Types without a 
+//	specialization are not arguments, so the operators do not exist 
+//	for them
+//-----------------------------------------------------------------------
+template <class X> struct tensor_arg {};
+
+template <typename T> struct tensor_arg<tensor_leaf<T> >
+{
+  typedef tensor_leaf<T> type;
+  static type make(const type& x) {return x;}
+};
+
+template <typename T> struct tensor_arg<tensor_scalar<T> >
+{
+  typedef tensor_scalar<T> type;
+  static type make(const type& x) {return x;}
+};
+
+template <class OP, class L, class R> struct tensor_arg<tensor_binary<OP,L,R> >
+{
+  typedef tensor_binary<OP,L,R> type;
+  static type make(const type& x) {return x;}
+};
+
+//operator expressions and scalars
+#define LIBJ_TENSOR_EXPR_OP(OPER,OPTYPE) \
+template <class X, class Y> \
+tensor_binary<OPTYPE,typename tensor_arg<X>::type,typename tensor_arg<Y>::type> \
+operator OPER (const X& x, const Y& y) \
+{ \
+  return tensor_binary<OPTYPE,typename tensor_arg<X>::type,typename tensor_arg<Y>::type> \
+         (tensor_arg<X>::make(x),tensor_arg<Y>::make(y)); \
+} \
+template <class X> \
+tensor_binary<OPTYPE,typename tensor_arg<X>::type,tensor_scalar<typename tensor_arg<X>::type::value_type> > \
+operator OPER (const X& x, const typename tensor_arg<X>::type::value_type s) \
+{ \
+  typedef tensor_scalar<typename tensor_arg<X>::type::value_type> S; \
+  return tensor_binary<OPTYPE,typename tensor_arg<X>::type,S>(tensor_arg<X>::make(x),S(s)); \
+} \
+template <class Y> \
+tensor_binary<OPTYPE,tensor_scalar<typename tensor_arg<Y>::type::value_type>,typename tensor_arg<Y>::type> \
+operator OPER (const typename tensor_arg<Y>::type::value_type s, const Y& y) \
+{ \
+  typedef tensor_scalar<typename tensor_arg<Y>::type::value_type> S; \
+  return tensor_binary<OPTYPE,S,typename tensor_arg<Y>::type>(S(s),tensor_arg<Y>::make(y)); \
+}
+
+LIBJ_TENSOR_EXPR_OP(+,tensor_op_add)
+LIBJ_TENSOR_EXPR_OP(-,tensor_op_sub)
+LIBJ_TENSOR_EXPR_OP(*,tensor_op_mul)
+LIBJ_TENSOR_EXPR_OP(/,tensor_op_div)
+
+#undef LIBJ_TENSOR_EXPR_OP
+
+//-----------------------------------------------------------------------
+// tensor_eval_into
+//	C = expr, where CP is the data of C and CL is its leaf
+//-----------------------------------------------------------------------
+template <typename T, class E>
+void tensor_eval_into(T* CP, const tensor_leaf<T>& CL, const E& expr)
+{
+  const long N = (long) CL.NELM;
+  if (CL.sequential() && expr.sequential())
+  {
+    #pragma omp parallel for schedule(static) if (N >= LIBJ_TENSOR_EXPR_PAR)
+    for (long i=0;i<N;i++) CP[i] = expr[i];
+    return;
+  }
+
+  //lines of the first dimension
+  const size_t N0   = CL.LEN[0];
+  const size_t S0   = CL.S[0];
+  const long   NOUT = N/(long) N0;
+  #pragma omp parallel if (N >= LIBJ_TENSOR_EXPR_PAR)
+  {
+    E e = expr;
+    size_t idx[LIBJ_TENSOR_MAX_DIM];
+    #pragma omp for schedule(static)
+    for (long o=0;o<NOUT;o++)
+    {
+      size_t r = (size_t) o;
+      T* c = CP;
+      for (size_t d=1;d<CL.ND;d++) 
+      {
+        idx[d] = r%CL.LEN[d]; 
+        r /= CL.LEN[d];
+        c += idx[d]*CL.S[d];
+      }
+      e.seek(idx);
+      for (size_t i=0;i<N0;i++) c[i*S0] = e.line(i);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------
+// tensor_eval
+//	C = expr, for any tensor C 
+//-----------------------------------------------------------------------
+template <class TT, class E>
+void tensor_eval(TT& C, const tensor_node<E>& node)
+{
+  typedef typename E::value_type T;
+  const E& expr = node.self();
+  const tensor_leaf<T> CL(C);
+  if (!expr.check(CL))
+  {
+    printf("ERROR libj::tensor_eval \n");
+    printf("tensors in the expression do not have the same dimensions \n");
+    exit(1);
+  }
+  if (CL.NELM == 0) return;
+
+  if (expr.unsafe(CL))
+  {
+    //evaluate into a sequential temporary, and copy that to C
+    std::vector<T> tmp(CL.NELM);
+    tensor_leaf<T> TL = CL;
+    size_t NN = 1;
+    for (size_t d=0;d<TL.ND;d++) {TL.S[d] = NN; NN *= TL.LEN[d];}
+    TL.P = TL.B = tmp.data();
+    tensor_eval_into(tmp.data(),TL,expr);
+    tensor_eval_into(C.data(),CL,TL);
+  } else {
+    tensor_eval_into(C.data(),CL,expr);
+  }
+}
+
+}//end of namespace
+
+#endif
@@ -0,0 +1,447 @@
+/*----------------------------------------------------------------------------
+  tensor_file.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for tensor_file, a self-describing binary file of one tensor.
+  The header has everything needed to rebuild the libj::tensor (type,
+  lengths, strides) and the offsets of its blocks, and the data starts on
+  a page boundary, so open() maps the file and the view() points straight
+  into the mapping. There is no read or copy on restart, the pages are
+  brought in as they are used (see tensor_map.hpp for the same idea
+  without a header).
+
+  FORMAT (all fields are uint64_t)
+  -------------------
+    magic            "LIBJTNSR"
+    endian           0x0102030405060708, as written
+    version          TENSOR_FILE_VERSION
+    dtype            tensor_file_dtype<T>::code, 0 for other types
+    elem_bytes       sizeof(T)
+    ndim, nelm       number of dimensions and of elements
+    span             elements stored, 1 + sum (length-1)*stride
+    alignment        of the data, a multiple of the page size
+    data_offset      bytes from the start of the file to element 0
+    nblock           number of blocks
+    lengths[ndim], strides[ndim]
+    blocks[nblock]   element offset, elements, and file offset of each
+
+  The stored data is the span of the tensor from data(), with its strides
+  as they are, so padded or tiled layouts come back the same. For slices
+  of a larger tensor this includes the elements in between.
+
+  The blocks are contiguous ranges of the span, e.g., the blocks of a
+  block_tensor or of a Pdata list, which can be read ahead or dropped
+  one at a time.
+
+  USAGE
+  -------------------
+    libj::tensor_file<double>::save("t2.ten",T);          //one block
+    libj::tensor_file<double>::save("t2.ten",T,blk);      //blocks of blk elements
+    libj::tensor_file<double>::save("t2.ten",T,sizes);    //given block sizes
+
+    libj::tensor_file<double> F;
+    F.open("t2.ten");                   //read only, F.open(name,false) to write
+    libj::tensor<double>& T = F.view();
+    F.num_blocks(); F.block_offset(b); F.block_size(b); F.block(b);
+    F.willneed(b); F.dontneed(b);       //madvise on block b
+    F.close();                          //also done by the destructor
+----------------------------------------------------------------------------*/
+#ifndef TENSOR_FILE_HPP
+#define TENSOR_FILE_HPP
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <complex>
+#include <vector>
+#include "tensor.hpp"
+
+#if defined (__unix__) || defined (__APPLE__)
+  #include <errno.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #define LIBJ_HAVE_MMAP 1
+#endif
+
+#define TENSOR_FILE_VERSION 1
+#define TENSOR_FILE_ENDIAN 0x0102030405060708UL
+#define TENSOR_FILE_HEAD 12	//fixed fields of the header
+
+namespace libj
+{
+
+//-----------------------------------------------------------------------
+// type codes of the header
+//-----------------------------------------------------------------------
+template <typename T> struct tensor_file_dtype {static const uint64_t code = 0;};
+template <> struct tensor_file_dtype<double> {static const uint64_t code = 1;};
+template <> struct tensor_file_dtype<float> {static const uint64_t code = 2;};
+template <> struct tensor_file_dtype<long> {static const uint64_t code = 3;};
+template <> struct tensor_file_dtype<int> {static const uint64_t code = 4;};
+template <> struct tensor_file_dtype<std::complex<double> > {static const uint64_t code = 5;};
+template <> struct tensor_file_dtype<std::complex<float> > {static const uint64_t code = 6;};
+
+template <typename T>
+class tensor_file
+{
+  private:
+  libj::tensor<T>       M_VIEW;      //tensor assigned to the mapping
+  void*                 M_MAP;       //start of the mapping
+  size_t                M_BYTES;     //bytes mapped
+  size_t                M_PAGE;      //page size
+  size_t                M_DATA;      //offset of the data in the file
+  std::vector<uint64_t> M_BLOCKS;    //element offset, elements, file offset
+  int                   M_FD;        //file descriptor
+  bool                  M_READONLY;  //mapped read only
+
+  //no copies, the view points into the mapping
+  tensor_file(const tensor_file<T>& other);
+  tensor_file<T>& operator= (const tensor_file<T>& other);
+
+  static size_t m_page();
+  static void m_write(const int fd, const char* name, const void* buf,
+                      const size_t bytes, const size_t pos);
+  void m_advise(const size_t b, const int advice);
+
+  public:
+  tensor_file() : M_MAP(NULL), M_BYTES(0), M_PAGE(4096), M_DATA(0), M_FD(-1),
+                  M_READONLY(true) {}
+  ~tensor_file() {if (is_open()) close();}
+
+  //write T to a new file
+  static void save(const char* name, const libj::tensor<T>& A,
+                   const std::vector<size_t>& block_sizes, const size_t align = 0);
+  static void save(const char* name, const libj::tensor<T>& A,
+                   const size_t block = 0, const size_t align = 0);
+
+  void open(const char* name, const bool readonly = true);
+  void close();
+  void sync();
+
+  bool   is_open() const {return M_MAP != NULL;}
+  bool   is_readonly() const {return M_READONLY;}
+  size_t bytes() const {return M_BYTES;}
+  size_t data_offset() const {return M_DATA;}
+  libj::tensor<T>& view() {return M_VIEW;}
+  const libj::tensor<T>& view() const {return M_VIEW;}
+
+  //blocks
+  size_t num_blocks() const {return M_BLOCKS.size()/3;}
+  size_t block_offset(const size_t b) const {return (size_t) M_BLOCKS[3*b];}
+  size_t block_size(const size_t b) const {return (size_t) M_BLOCKS[3*b+1];}
+  size_t block_file_offset(const size_t b) const {return (size_t) M_BLOCKS[3*b+2];}
+  T*     block(const size_t b) {return M_VIEW.data() + block_offset(b);}
+  void   willneed(const size_t b);
+  void   dontneed(const size_t b);
+};
+
+//-----------------------------------------------------------------------
+// page size
+//-----------------------------------------------------------------------
+template <typename T>
+size_t tensor_file<T>::m_page()
+{
+#if defined (LIBJ_HAVE_MMAP)
+  const long page = sysconf(_SC_PAGESIZE);
+  return (page > 0) ? (size_t) page : 4096;
+#else
+  return 4096;
+#endif
+}
+
+//-----------------------------------------------------------------------
+// pwrite all bytes at pos
+//-----------------------------------------------------------------------
+template <typename T>
+void tensor_file<T>::m_write(const int fd, const char* name, const void* buf,
+                             const size_t bytes, const size_t pos)
+{
+#if defined (LIBJ_HAVE_MMAP)
+  const char* ptr = (const char*) buf;
+  size_t done = 0;
+  while (done < bytes)
+  {
+    const ssize_t num = pwrite(fd,ptr+done,bytes-done,(off_t) (pos+done));
+    if (num < 0 && errno == EINTR) continue;
+    if (num <= 0)
+    {
+      printf("ERROR libj::tensor_file::save\n");
+      printf("could not write %zu bytes to %s\n",bytes,name);
+      exit(1);
+    }
+    done += (size_t) num;
+  }
+#endif
+}
+
+//-----------------------------------------------------------------------
+// save with the given block sizes, which must add up to the span
+//-----------------------------------------------------------------------
+template <typename T>
+void tensor_file<T>::save(const char* name, const libj::tensor<T>& A,
+                          const std::vector<size_t>& block_sizes, const size_t align)
+{
+#if defined (LIBJ_HAVE_MMAP)
+  if (!A.is_set())
+  {
+    printf("ERROR libj::tensor_file::save\n");
+    printf("attempted to save an unset tensor to %s\n",name);
+    exit(1);
+  }
+
+  size_t span = 1;
+  for (size_t d=0;d<A.dim();d++) span += (A.size(d)-1)*A.stride(d);
+
+  size_t total = 0;
+  for (size_t b=0;b<block_sizes.size();b++) total += block_sizes[b];
+  if (total != span)
+  {
+    printf("ERROR libj::tensor_file::save\n");
+    printf("blocks of %s hold %zu elements, the tensor spans %zu\n",name,total,span);
+    exit(1);
+  }
+
+  const size_t page = m_page();
+  const size_t alignment = (align > page) ? ((align + page - 1)/page)*page : page;
+  const size_t ndim = A.dim();
+  const size_t nblock = block_sizes.size();
+  const size_t head = sizeof(uint64_t)*(TENSOR_FILE_HEAD + 2*ndim + 3*nblock);
+  const size_t data = ((head + alignment - 1)/alignment)*alignment;
+
+  std::vector<uint64_t> H(TENSOR_FILE_HEAD + 2*ndim + 3*nblock);
+  memcpy(H.data(),"LIBJTNSR",sizeof(uint64_t));
+  H[1]  = TENSOR_FILE_ENDIAN;
+  H[2]  = TENSOR_FILE_VERSION;
+  H[3]  = tensor_file_dtype<T>::code;
+  H[4]  = sizeof(T);
+  H[5]  = ndim;
+  H[6]  = A.size();
+  H[7]  = span;
+  H[8]  = alignment;
+  H[9]  = data;
+  H[10] = data + span*sizeof(T);
+  H[11] = nblock;
+  for (size_t d=0;d<ndim;d++)
+  {
+    H[TENSOR_FILE_HEAD+d]      = A.size(d);
+    H[TENSOR_FILE_HEAD+ndim+d] = A.stride(d);
+  }
+  size_t first = 0;
+  for (size_t b=0;b<nblock;b++)
+  {
+    uint64_t* blk = H.data() + TENSOR_FILE_HEAD + 2*ndim + 3*b;
+    blk[0] = first;
+    blk[1] = block_sizes[b];
+    blk[2] = data + first*sizeof(T);
+    first += block_sizes[b];
+  }
+
+  const int fd = ::open(name,O_WRONLY | O_CREAT | O_TRUNC,0644);
+  if (fd < 0)
+  {
+    printf("ERROR libj::tensor_file::save\n");
+    printf("could not open %s\n",name);
+    exit(1);
+  }
+  if (ftruncate(fd,(off_t) H[10]) != 0)
+  {
+    printf("ERROR libj::tensor_file::save\n");
+    printf("could not make %s %zu bytes long\n",name,(size_t) H[10]);
+    exit(1);
+  }
+  m_write(fd,name,H.data(),head,0);
+  m_write(fd,name,A.data(),span*sizeof(T),data);
+  ::close(fd);
+#else
+  printf("ERROR libj::tensor_file::save\n");
+  printf("mmap is not available on this system\n");
+  exit(1);
+#endif
+}
+
+//-----------------------------------------------------------------------
+// save with blocks of block elements (the last may be shorter), or one
+// block if block is 0
+//-----------------------------------------------------------------------
+template <typename T>
+void tensor_file<T>::save(const char* name, const libj::tensor<T>& A,
+                          const size_t block, const size_t align)
+{
+  size_t span = 1;
+  for (size_t d=0;d<A.dim();d++) span += (A.size(d)-1)*A.stride(d);
+  const size_t len = (block == 0 || block > span) ? span : block;
+  std::vector<size_t> sizes;
+  for (size_t first=0;first<span;first+=len)
+  {
+    sizes.push_back((span-first < len) ? span-first : len);
+  }
+  save(name,A,sizes,align);
+}
+
+//-----------------------------------------------------------------------
+// map a saved file, and check its header
+//-----------------------------------------------------------------------
+template <typename T>
+void tensor_file<T>::open(const char* name, const bool readonly)
+{
+#if defined (LIBJ_HAVE_MMAP)
+  if (is_open())
+  {
+    printf("ERROR libj::tensor_file::open\n");
+    printf("attempted to open %s into an open tensor_file\n",name);
+    exit(1);
+  }
+
+  const int fd = ::open(name,readonly ? O_RDONLY : O_RDWR);
+  struct stat st;
+  if (fd < 0 || fstat(fd,&st) != 0)
+  {
+    printf("ERROR libj::tensor_file::open\n");
+    printf("could not open %s\n",name);
+    exit(1);
+  }
+  const size_t fbytes = (size_t) st.st_size;
+
+  uint64_t H[TENSOR_FILE_HEAD];
+  if (fbytes < sizeof(H) || pread(fd,H,sizeof(H),0) != (ssize_t) sizeof(H) ||
+      memcmp(H,"LIBJTNSR",sizeof(uint64_t)) != 0)
+  {
+    printf("ERROR libj::tensor_file::open\n");
+    printf("%s is not a tensor file\n",name);
+    exit(1);
+  }
+  if (H[1] != TENSOR_FILE_ENDIAN || H[2] != TENSOR_FILE_VERSION)
+  {
+    printf("ERROR libj::tensor_file::open\n");
+    printf("%s has another byte order or version (%lu)\n",name,(unsigned long) H[2]);
+    exit(1);
+  }
+  if (H[3] != tensor_file_dtype<T>::code || H[4] != sizeof(T))
+  {
+    printf("ERROR libj::tensor_file::open\n");
+    printf("%s holds type %lu of %lu bytes, not %lu of %zu bytes\n",name,
+           (unsigned long) H[3],(unsigned long) H[4],
+           (unsigned long) tensor_file_dtype<T>::code,sizeof(T));
+    exit(1);
+  }
+  if (H[10] > fbytes || H[5] > LIBJ_TENSOR_MAX_DIM)
+  {
+    printf("ERROR libj::tensor_file::open\n");
+    printf("%s is truncated, or has more than %d dimensions\n",name,LIBJ_TENSOR_MAX_DIM);
+    exit(1);
+  }
+
+  const int prot = readonly ? PROT_READ : (PROT_READ | PROT_WRITE);
+  void* map = mmap(NULL,(size_t) H[10],prot,MAP_SHARED,fd,0);
+  if (map == MAP_FAILED)
+  {
+    printf("ERROR libj::tensor_file::open\n");
+    printf("could not mmap %zu bytes of %s\n",(size_t) H[10],name);
+    exit(1);
+  }
+
+  //the rest of the header is read from the mapping
+  const size_t ndim = (size_t) H[5];
+  const uint64_t* R = (const uint64_t*) map + TENSOR_FILE_HEAD;
+  std::vector<size_t> lengths(ndim), strides(ndim);
+  for (size_t d=0;d<ndim;d++)
+  {
+    lengths[d] = (size_t) R[d];
+    strides[d] = (size_t) R[ndim+d];
+  }
+  M_BLOCKS.assign(R+2*ndim,R+2*ndim+3*H[11]);
+
+  M_PAGE     = m_page();
+  M_MAP      = map;
+  M_BYTES    = (size_t) H[10];
+  M_DATA     = (size_t) H[9];
+  M_FD       = fd;
+  M_READONLY = readonly;
+  M_VIEW.assign((T*) ((char*) map + M_DATA),lengths,strides);
+#else
+  printf("ERROR libj::tensor_file::open\n");
+  printf("mmap is not available on this system\n");
+  exit(1);
+#endif
+}
+
+//-----------------------------------------------------------------------
+// madvise on the pages of block b
+//-----------------------------------------------------------------------
+template <typename T>
+void tensor_file<T>::m_advise(const size_t b, const int advice)
+{
+#if defined (LIBJ_HAVE_MMAP)
+  if (!is_open() || b >= num_blocks()) return;
+  const size_t begin = (block_file_offset(b)/M_PAGE)*M_PAGE;
+  const size_t end = block_file_offset(b) + block_size(b)*sizeof(T);
+  if (advice == MADV_DONTNEED && !M_READONLY)
+  {
+    msync((char*) M_MAP + begin,end-begin,MS_ASYNC);
+  }
+  madvise((char*) M_MAP + begin,end-begin,advice);
+#endif
+}
+
+template <typename T>
+void tensor_file<T>::willneed(const size_t b)
+{
+#if defined (LIBJ_HAVE_MMAP)
+  m_advise(b,MADV_WILLNEED);
+#endif
+}
+
+template <typename T>
+void tensor_file<T>::dontneed(const size_t b)
+{
+#if defined (LIBJ_HAVE_MMAP)
+  m_advise(b,MADV_DONTNEED);
+#endif
+}
+
+//-----------------------------------------------------------------------
+// write dirty pages back to the file
+//-----------------------------------------------------------------------
+template <typename T>
+void tensor_file<T>::sync()
+{
+#if defined (LIBJ_HAVE_MMAP)
+  if (is_open() && !M_READONLY && msync(M_MAP,M_BYTES,MS_SYNC) != 0)
+  {
+    printf("ERROR libj::tensor_file::sync\n");
+    printf("msync of %zu bytes failed\n",M_BYTES);
+    exit(1);
+  }
+#endif
+}
+
+//-----------------------------------------------------------------------
+// unmap and close the file
+//-----------------------------------------------------------------------
+template <typename T>
+void tensor_file<T>::close()
+{
+#if defined (LIBJ_HAVE_MMAP)
+  if (!is_open())
+  {
+    printf("ERROR libj::tensor_file::close\n");
+    printf("attempted to close a tensor_file that is not open\n");
+    exit(1);
+  }
+  sync();
+  M_VIEW.unassign();
+  munmap(M_MAP,M_BYTES);
+  ::close(M_FD);
+  M_MAP   = NULL;
+  M_BYTES = 0;
+  M_FD    = -1;
+  M_BLOCKS.clear();
+#endif
+}
+
+}//end of namespace
+
+#endif
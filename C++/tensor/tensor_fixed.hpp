@@ -1,6 +1,7 @@
 /*----------------------------------------------------------------------------
   tensor.hpp
 	JHT, April 10, 2022 : created
+	JHT, October 14, 2026 : malloc memory is counted in mem_registry
 
   .hpp file for the general tensor class. This behaves similarly to 
   std::array in that it cannot be grown dynamically, though it can be 
@@ -32,8 +33,19 @@
     T.deallocate();
     T.unassign();
 
+  Allocate from an allocator handle (see allocator.hpp and core_arena.hpp)
+    T.set_allocator(&arena);
+    T.aligned_allocate(64,1,4,3);
+
   Reassignment (including reshaping)
     T.assign(2,5,1,new_pointer);
+
+  Strided views (see tensor_range.hpp), which share the memory of T. The
+  number of dimensions of the view is the number of ranges
+    libj::tensor<double,2> V = T.slice(libj::range(0,2),3,libj::range(1,5,2));
+
+  Element-wise expressions (see tensor_expr.hpp), evaluated in one loop
+    C = 2.0*A + B*D;
   
 
   ELEMENT ACCESS
@@ -58,6 +70,10 @@
 #include <stdio.h>
 #include <stdarg.h>
 #include "alignment.hpp"
+#include "allocator.hpp"
+#include "mem_registry.hpp"
+#include "tensor_range.hpp"
+#include "tensor_expr.hpp"
 
 //Standard alignment
 #define DEFAULT_ALIGN 16
@@ -78,6 +94,7 @@ class tensor
   private:
   T*       M_BUFFER;       //start of data
   T*       M_POINTER;	//pointer to malloc
+  libj::allocator<T>* M_ALLOCATOR; //allocator, NULL for malloc
   size_t   M_LENGTHS[N];   //list of dimension lengths
   size_t   M_OFFSETS[N];	//list of offsets for data access
   size_t   M_NUM_ELM;      //total number of elements
@@ -102,7 +119,47 @@ class tensor
   {
     return first*M_OFFSETS[level];
   }
-  
+  size_t m_index(const size_t level) const {return 0;}
+
+  //internal varadic templates for slice
+  template <size_t M>
+  void m_slice(const size_t level, size_t vdim, tensor<T,M>& V, size_t& offset) const {}
+  template <size_t M, class...Rest> 
+  void m_slice(const size_t level, size_t vdim, tensor<T,M>& V, size_t& offset, 
+               const libj::range& first, const Rest...rest) const
+  {
+    const size_t s = first.all ? 0 : first.start;
+    const size_t e = first.all ? M_LENGTHS[level] : first.end;
+    if (first.step < 1 || s >= e || e > M_LENGTHS[level])
+    {
+      printf("ERROR libj::tensor::slice\n");
+      printf("Bad range [%zu,%zu,%zu) for dimension %zu of length %zu \n",
+             s,e,first.step,level,M_LENGTHS[level]);
+      exit(1);
+    }
+    const size_t n = (e - s + first.step - 1)/first.step;
+    V.M_LENGTHS[vdim] = n;
+    V.M_OFFSETS[vdim] = M_OFFSETS[level]*first.step;
+    V.M_NUM_ELM *= n;
+    offset += s*M_OFFSETS[level];
+    m_slice(level+1,vdim+1,V,offset,rest...);
+  }
+  template <size_t M, class...Rest> 
+  void m_slice(const size_t level, size_t vdim, tensor<T,M>& V, size_t& offset, 
+               const size_t first, const Rest...rest) const
+  {
+    if (first >= M_LENGTHS[level])
+    {
+      printf("ERROR libj::tensor::slice\n");
+      printf("Index %zu is out of dimension %zu of length %zu \n",
+             first,level,M_LENGTHS[level]);
+      exit(1);
+    }
+    offset += first*M_OFFSETS[level];
+    m_slice(level+1,vdim,V,offset,rest...);
+  }
+
+  template <typename T2, const size_t N2> friend class tensor;
   
   public:
 
@@ -118,6 +175,18 @@ class tensor
   void aligned_allocate(const size_t BYTES, const size_t i0,...);
   void assign(T* pointer, const size_t i0,...);
   void unassign();
+  void set_allocator(libj::allocator<T>* alloc)
+  {
+    //the storage is freed through the allocator that made it
+    if (M_IS_ALLOCATED && alloc != M_ALLOCATOR)
+    {
+      printf("ERROR libj::tensor::set_allocator\n");
+      printf("Attempted to change the allocator of an allocated tensor \n");
+      exit(1);
+    }
+    M_ALLOCATOR = alloc;
+  }
+  libj::allocator<T>* get_allocator() const {return M_ALLOCATOR;}
 
   //Getters
   const size_t  size() const {return M_NUM_ELM;}
@@ -125,10 +194,22 @@ class tensor
   const size_t  dim() const {return N;}
   const size_t  alignment() const {return M_ALIGNMENT;}
   const size_t  offset(const size_t dim) const {return M_OFFSETS[dim];}
+  const size_t  stride(const size_t dim) const {return M_OFFSETS[dim];}
   const bool    is_allocated() const {return M_IS_ALLOCATED;}
   const bool    is_assigned() const {return M_IS_ASSIGNED;}
   const bool    is_set() const {return M_IS_ALLOCATED || M_IS_ASSIGNED;}
 
+  //Data function
+  T* data() {return M_BUFFER;}
+  const T* data() const {return M_BUFFER;}
+
+  //evaluate an expression into this tensor
+  template <class E> tensor<T,N>& operator= (const libj::tensor_node<E>& expr)
+  {
+    libj::tensor_eval(*this,expr);
+    return *this;
+  }
+
   //Access functions
   T& operator[] (const size_t offset) {return *(M_BUFFER+offset);}
   const T& operator[] (const size_t offset) const {return *(M_BUFFER+offset);}
@@ -136,17 +217,30 @@ class tensor
   template<class...Rest>
   T& operator() (const size_t i0,const Rest...rest)
   {
-    return *(M_BUFFER + m_index(1,rest...));
+    return *(M_BUFFER + i0*M_OFFSETS[0] + m_index(1,rest...));
   }
 
   template<class...Rest>
   const T& operator() (const size_t i0,const Rest...rest) const
   {
-    return *(M_BUFFER + m_index(1,rest...));
+    return *(M_BUFFER + i0*M_OFFSETS[0] + m_index(1,rest...));
   }
 
+  //Create a strided view
+  template<class...Rest>
+  tensor<T,libj::slice_rank<Rest...>::value> slice(const Rest...rest) const;
+
 }; //end of normal tensor
 
+//-----------------------------------------------------------------------
+// tensors are leaves of expressions 
+//-----------------------------------------------------------------------
+template <typename T, const size_t N> struct tensor_arg<tensor<T,N> >
+{
+  typedef tensor_leaf<T> type;
+  static type make(const tensor<T,N>& x) {return type(x);}
+};
+
 //-----------------------------------------------------------------------
 // returns true if the tensors are the same shape
 //-----------------------------------------------------------------------
@@ -169,6 +263,7 @@ void tensor<T,N>::m_set_default()
 { 
   M_BUFFER = NULL;
   M_POINTER = NULL;
+  M_ALLOCATOR = NULL;
   for (int i=0;i<N;i++) {M_LENGTHS[i] = 0; M_OFFSETS[i]=0;}
   M_NUM_ELM = 0; 
   M_ALIGNMENT = 0; 
@@ -184,7 +279,7 @@ template<typename T, const size_t N>
 void tensor<T,N>::m_set_dim(const size_t* dim)
 {
   //initialize the data
-  M_OFFSETS[0] = (size_t) 0;
+  M_OFFSETS[0] = (size_t) 1;
   M_LENGTHS[0] = dim[0];
   M_NUM_ELM    = (size_t) M_LENGTHS[0];
   if (M_LENGTHS[0] == 0)
@@ -275,7 +370,9 @@ void tensor<T,N>::m_allocate()
 {
   if (!M_IS_ALLOCATED && !M_IS_ASSIGNED)
   {
-    M_POINTER = (T*) malloc(sizeof(T)*M_NUM_ELM);
+    M_POINTER = (M_ALLOCATOR != NULL) ? M_ALLOCATOR->allocate(sizeof(T),M_NUM_ELM)
+                                      : (T*) malloc(sizeof(T)*M_NUM_ELM);
+    if (M_ALLOCATOR == NULL) {libj::mem_track(M_POINTER,sizeof(T)*M_NUM_ELM);}
     M_BUFFER = M_POINTER;
     if (M_BUFFER == NULL || M_POINTER == NULL)
     {
@@ -303,7 +400,7 @@ void tensor<T,N>::m_assign(T* pointer)
     M_BUFFER = pointer;
     M_POINTER = pointer;
     M_IS_ASSIGNED = true;
-    M_ALIGNMENT = calc_alignemnt(M_BUFFER);
+    M_ALIGNMENT = calc_alignment(M_BUFFER);
   } else {
     printf("ERROR libj::tensor::m_assign\n");
     printf("attempted to assign an already allocated vector\n");
@@ -328,8 +425,10 @@ void libj::tensor<T,N>::m_aligned_allocate(const size_t ALIGN)
       exit(1);
     }
 
-    //align the buffer pointer  
-    M_POINTER = (T*) malloc(ALIGN+M_NUM_ELM*sizeof(T));
+    //align the buffer pointer, the allocator returns aligned memory
+    M_POINTER = (M_ALLOCATOR != NULL) ? M_ALLOCATOR->allocate(ALIGN,M_NUM_ELM)
+                                      : (T*) malloc(ALIGN+M_NUM_ELM*sizeof(T));
+    if (M_ALLOCATOR == NULL) {libj::mem_track(M_POINTER,ALIGN+M_NUM_ELM*sizeof(T));}
     if (M_POINTER != NULL)
     {
       long M = (long)M_POINTER%(long)ALIGN; //number of bytes off
@@ -426,8 +525,14 @@ void tensor<T,N>::deallocate()
 {
   if (M_IS_ALLOCATED)
   {
-    if (M_POINTER != NULL) {free(M_POINTER);}
+    if (M_POINTER != NULL) 
+    {
+      if (M_ALLOCATOR != NULL) {M_ALLOCATOR->deallocate(M_POINTER,M_NUM_ELM);}
+      else                     {libj::mem_untrack(M_POINTER); free(M_POINTER);}
+    }
+    M_POINTER = NULL;
     M_BUFFER = NULL;
+    M_IS_ALLOCATED = false;
   } else {
     printf("ERROR libj::tensor::deallocate \n");
     printf("attempted to deallocate an unallocated tensor \n");
@@ -453,6 +558,34 @@ void tensor<T,N>::unassign()
   }
 } 
 
+//-----------------------------------------------------------------------
+// slice
+//	varadic template for creating a new tensor that points to a 
+//	strided block of this tensor. There is one argument per dimension,
+//	either a libj::range, or a fixed index which drops the dimension. 
+//	The new tensor is assigned, so no memory is allocated 
+//-----------------------------------------------------------------------
+template <typename T, const size_t N> template<class...Rest>
+tensor<T,libj::slice_rank<Rest...>::value> tensor<T,N>::slice(const Rest...rest) const
+{
+  const size_t M = libj::slice_rank<Rest...>::value;
+  static_assert(sizeof...(rest) == N, "libj::tensor::slice needs one argument per dimension");
+  static_assert(M > 0, "libj::tensor::slice needs at least one range");
+  if (!is_set())
+  {
+    printf("ERROR libj::tensor::slice \n");
+    printf("tensor is not set \n");
+    exit(1);
+  }
+
+  tensor<T,M> V;
+  V.M_NUM_ELM = 1;
+  size_t offset = 0;
+  m_slice(0,0,V,offset,rest...);
+  V.m_assign(M_BUFFER+offset);
+  return V;
+}
+
 }//end of namespace
 
 #endif
@@ -0,0 +1,270 @@
+/*----------------------------------------------------------------------------
+  tensor_map.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for tensor_map, a tensor whose memory is a file mapped with mmap,
+  for tensors that do not fit in core. The page cache reads and writes the
+  file as the tensor is used, so there are no explicit fread/fwrite copies,
+  and the view() is an ordinary libj::tensor (same shape, strides, and
+  access) that the jblis routines take as is.
+
+  The hints are madvise on the pages that hold [offset,offset+n) of the
+  tensor, so a loop over blocks can ask for the next block to be read ahead
+  while it works on this one, and drop the blocks it is done with.
+
+  INITIALIZATION
+  -------------------
+    libj::tensor_map<double> M;
+    M.create("t2.bin",no,no,nv,nv);             //new file of this shape
+    M.open("t2.bin",no,no,nv,nv);               //existing file, read/write
+    M.open("t2.bin",lengths,true);              //existing file, read only
+    M.close();                                  //also done by the destructor
+
+  USAGE
+  -------------------
+    libj::tensor<double>& T = M.view();         //the mapped tensor
+    M.advise(libj::TENSOR_MAP_SEQUENTIAL);      //whole tensor
+    M.willneed(offset,n);                       //read ahead these elements
+    M.dontneed(offset,n);                       //done with these elements
+    M.sync();                                   //write dirty pages to the file
+
+  Streaming over blocks of the last index
+    for (size_t b=0;b<nb;b++)
+    {
+      if (b+1 < nb) M.willneed((b+1)*blk,blk);
+      ... work on T[b*blk,(b+1)*blk) ...
+      M.dontneed(b*blk,blk);
+    }
+----------------------------------------------------------------------------*/
+#ifndef TENSOR_MAP_HPP
+#define TENSOR_MAP_HPP
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include "tensor.hpp"
+
+#if defined (__unix__) || defined (__APPLE__)
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #define LIBJ_HAVE_MMAP 1
+#endif
+
+namespace libj
+{
+
+enum tensor_map_hint {TENSOR_MAP_NORMAL = 0, TENSOR_MAP_SEQUENTIAL = 1,
+                      TENSOR_MAP_RANDOM = 2, TENSOR_MAP_WILLNEED = 3,
+                      TENSOR_MAP_DONTNEED = 4};
+
+template <typename T>
+class tensor_map
+{
+  private:
+  libj::tensor<T> M_VIEW;      //tensor assigned to the mapping
+  void*           M_MAP;       //start of the mapping
+  size_t          M_BYTES;     //bytes mapped
+  size_t          M_PAGE;      //page size
+  int             M_FD;        //file descriptor
+  bool            M_READONLY;  //mapped read only
+
+  //no copies, the view points into the mapping
+  tensor_map(const tensor_map<T>& other);
+  tensor_map<T>& operator= (const tensor_map<T>& other);
+
+  template<class...Rest>
+  static void m_push(std::vector<size_t>& lengths, const size_t first, const Rest...rest)
+  {
+    lengths.push_back(first);
+    m_push(lengths,rest...);
+  }
+  static void m_push(std::vector<size_t>& lengths) {}
+
+  void m_map(const char* name, const std::vector<size_t>& lengths,
+             const bool create, const bool readonly);
+  void m_advise(const size_t offset, const size_t n, const tensor_map_hint hint);
+
+  public:
+  tensor_map() : M_MAP(NULL), M_BYTES(0), M_PAGE(4096), M_FD(-1), M_READONLY(false) {}
+  ~tensor_map() {if (is_open()) close();}
+
+  template<class...Rest> void create(const char* name, const size_t first, const Rest...rest)
+  {
+    std::vector<size_t> lengths;
+    m_push(lengths,first,rest...);
+    m_map(name,lengths,true,false);
+  }
+  template<class...Rest> void open(const char* name, const size_t first, const Rest...rest)
+  {
+    std::vector<size_t> lengths;
+    m_push(lengths,first,rest...);
+    m_map(name,lengths,false,false);
+  }
+  void create(const char* name, const std::vector<size_t>& lengths)
+    {m_map(name,lengths,true,false);}
+  void open(const char* name, const std::vector<size_t>& lengths, const bool readonly = false)
+    {m_map(name,lengths,false,readonly);}
+  void close();
+  void sync();
+
+  bool is_open() const {return M_MAP != NULL;}
+  bool is_readonly() const {return M_READONLY;}
+  size_t bytes() const {return M_BYTES;}
+  libj::tensor<T>& view() {return M_VIEW;}
+  const libj::tensor<T>& view() const {return M_VIEW;}
+
+  //hints for the whole tensor, or n elements from offset
+  void advise(const tensor_map_hint hint) {m_advise(0,M_VIEW.size(),hint);}
+  void advise(const size_t offset, const size_t n, const tensor_map_hint hint)
+    {m_advise(offset,n,hint);}
+  void willneed(const size_t offset, const size_t n) {m_advise(offset,n,TENSOR_MAP_WILLNEED);}
+  void dontneed(const size_t offset, const size_t n) {m_advise(offset,n,TENSOR_MAP_DONTNEED);}
+};
+
+//-----------------------------------------------------------------------
+// map the file, created with the right size if asked
+//-----------------------------------------------------------------------
+template <typename T>
+void tensor_map<T>::m_map(const char* name, const std::vector<size_t>& lengths,
+                          const bool create, const bool readonly)
+{
+#if defined (LIBJ_HAVE_MMAP)
+  if (is_open())
+  {
+    printf("ERROR libj::tensor_map::open\n");
+    printf("attempted to map %s into an open tensor_map\n",name);
+    exit(1);
+  }
+
+  size_t nelm = 1;
+  for (size_t d=0;d<lengths.size();d++) nelm *= lengths[d];
+  const size_t bytes = nelm*sizeof(T);
+  if (bytes == 0)
+  {
+    printf("ERROR libj::tensor_map::open\n");
+    printf("attempted to map %s with zero elements\n",name);
+    exit(1);
+  }
+
+  const int flags = create ? (O_RDWR | O_CREAT | O_TRUNC) : (readonly ? O_RDONLY : O_RDWR);
+  const int fd = ::open(name,flags,0644);
+  if (fd < 0)
+  {
+    printf("ERROR libj::tensor_map::open\n");
+    printf("could not open %s\n",name);
+    exit(1);
+  }
+
+  if (create)
+  {
+    if (ftruncate(fd,(off_t) bytes) != 0)
+    {
+      printf("ERROR libj::tensor_map::create\n");
+      printf("could not make %s %zu bytes long\n",name,bytes);
+      exit(1);
+    }
+  } else {
+    struct stat st;
+    if (fstat(fd,&st) != 0 || (size_t) st.st_size < bytes)
+    {
+      printf("ERROR libj::tensor_map::open\n");
+      printf("%s is smaller than the %zu bytes of the tensor\n",name,bytes);
+      exit(1);
+    }
+  }
+
+  const int prot = readonly ? PROT_READ : (PROT_READ | PROT_WRITE);
+  void* map = mmap(NULL,bytes,prot,MAP_SHARED,fd,0);
+  if (map == MAP_FAILED)
+  {
+    printf("ERROR libj::tensor_map::open\n");
+    printf("could not mmap %zu bytes of %s\n",bytes,name);
+    exit(1);
+  }
+
+  const long page = sysconf(_SC_PAGESIZE);
+  M_PAGE     = (page > 0) ? (size_t) page : 4096;
+  M_MAP      = map;
+  M_BYTES    = bytes;
+  M_FD       = fd;
+  M_READONLY = readonly;
+  M_VIEW.assign((T*) map,lengths);
+#else
+  printf("ERROR libj::tensor_map::open\n");
+  printf("mmap is not available on this system\n");
+  exit(1);
+#endif
+}
+
+//-----------------------------------------------------------------------
+// madvise on the pages holding elements [offset,offset+n)
+//-----------------------------------------------------------------------
+template <typename T>
+void tensor_map<T>::m_advise(const size_t offset, const size_t n, const tensor_map_hint hint)
+{
+#if defined (LIBJ_HAVE_MMAP)
+  if (!is_open() || n == 0) return;
+  size_t begin = offset*sizeof(T);
+  size_t end   = (offset+n)*sizeof(T);
+  if (begin >= M_BYTES) return;
+  if (end > M_BYTES) end = M_BYTES;
+  begin = (begin/M_PAGE)*M_PAGE;
+
+  int advice = MADV_NORMAL;
+  if (hint == TENSOR_MAP_SEQUENTIAL) advice = MADV_SEQUENTIAL;
+  if (hint == TENSOR_MAP_RANDOM)     advice = MADV_RANDOM;
+  if (hint == TENSOR_MAP_WILLNEED)   advice = MADV_WILLNEED;
+  if (hint == TENSOR_MAP_DONTNEED)
+  {
+    //dirty pages of a shared mapping are written back first
+    if (!M_READONLY) msync((char*) M_MAP + begin,end-begin,MS_ASYNC);
+    advice = MADV_DONTNEED;
+  }
+  madvise((char*) M_MAP + begin,end-begin,advice);
+#endif
+}
+
+//-----------------------------------------------------------------------
+// write dirty pages back to the file
+//-----------------------------------------------------------------------
+template <typename T>
+void tensor_map<T>::sync()
+{
+#if defined (LIBJ_HAVE_MMAP)
+  if (is_open() && !M_READONLY && msync(M_MAP,M_BYTES,MS_SYNC) != 0)
+  {
+    printf("ERROR libj::tensor_map::sync\n");
+    printf("msync of %zu bytes failed\n",M_BYTES);
+    exit(1);
+  }
+#endif
+}
+
+//-----------------------------------------------------------------------
+// unmap and close the file
+//-----------------------------------------------------------------------
+template <typename T>
+void tensor_map<T>::close()
+{
+#if defined (LIBJ_HAVE_MMAP)
+  if (!is_open())
+  {
+    printf("ERROR libj::tensor_map::close\n");
+    printf("attempted to close a tensor_map that is not open\n");
+    exit(1);
+  }
+  sync();
+  M_VIEW.unassign();
+  munmap(M_MAP,M_BYTES);
+  ::close(M_FD);
+  M_MAP   = NULL;
+  M_BYTES = 0;
+  M_FD    = -1;
+#endif
+}
+
+}//end of namespace
+
+#endif
@@ -2,6 +2,8 @@
   tensor_matrix2.hpp
 	JHT, April 25, 2022 : created
 	JHT, April 25, 2022 : changed to array template
+	JHT, October 14, 2026 : added rebind
+	JHT, October 14, 2026 : compile time bundles (libj::idx)
 
   .hpp file for the tensor_matrix2 class, which is used to "matrixicize" 
   a tensor. This is purely used to represent an underlying tensor, and
@@ -23,6 +25,11 @@
   libj::tensor_matrix2<double> A;
   A.assign(tensor,"abc","d"); 			
   libj::tensor_matrix2<int> B(tensor,"","");	//yields a col-vector rep. of tensor
+  A.assign(tiled,"ab","cd");			//from a tensor_tiled, see tensor_tiled.hpp
+  A.assign(tensor,libj::idx<'a','b','c'>(),libj::idx<'d'>());
+						//compile time bundles, see index_labels.hpp.
+						//  Bad bundles are a build error, and only
+						//  the rank of tensor is checked at run time
  
   libj::tensor
 
@@ -39,6 +46,10 @@
   A.data();		//returns pointer to data buffer
   A.offset(I,J); 	//returns of offset from data buffer 
 				for bundled indicies
+  A.make_tables();	//caches the row and col offsets, so that offset(I,J)
+			//  is two lookups. Blocks of A share the tables
+  A.rebind(tensor2);	//same bundles and tables over tensor2, which has
+			//  the lengths and strides of tensor
 
 ----------------------------------------------------------------------------*/
 #ifndef TENSOR_MATRIX2_HPP
@@ -46,6 +57,8 @@
 
 #include "tensor.hpp"
 #include "index_bundle2.hpp"
+#include "index_labels.hpp"
+#include "tensor_tiled.hpp"
 #include "alignment.hpp"
 #include <stdlib.h>
 #include <string>
@@ -70,8 +83,9 @@ class tensor_matrix2
 
   //Internal functions
   void m_set_default(); //set the default values
-  void m_set_dimensions(const std::string& lhs, const std::string& rhs);
-  bool m_good_bundles();
+  template <class TT>
+  void m_set_dimensions(const TT& src, const std::string& lhs, const std::string& rhs);
+  bool m_good_bundles(const size_t ndim);
 
   public:
   //Constructors
@@ -86,6 +100,21 @@ class tensor_matrix2
               const std::string& lhs, const std::string& rhs);
   void assign(const libj::tensor<T>& tens, 
               const std::string& lhs, const std::string& rhs);
+  void assign(const libj::tensor_tiled<T>& tens, 
+              const std::string& lhs, const std::string& rhs);
+
+  //compile time bundles
+  template <char... L, char... R>
+  tensor_matrix2(const libj::tensor<T>& tens, libj::idx<L...> lhs, libj::idx<R...> rhs)
+  {
+    assign(tens,lhs,rhs);
+  }
+  template <char... L, char... R>
+  void assign(const libj::tensor<T>& tens, libj::idx<L...> lhs, libj::idx<R...> rhs);
+
+  //the same bundles (and tables) over another tensor, which must
+  //  have the same lengths and strides
+  void rebind(const libj::tensor<T>& tens);
 
   //getters
   size_t size() const {return M_LHS.NELM * M_RHS.NELM;} 
@@ -95,7 +124,7 @@ class tensor_matrix2
   }
   size_t bundle_size(const size_t side)
   {
-    return side == 0? M_LHS.NDIM : M_RHS.NDIM;
+    return side == 0? M_LHS.dim() : M_RHS.dim();
   }
 
   constexpr size_t dim() const {return NLHS*NRHS;}
@@ -108,6 +137,7 @@ class tensor_matrix2
   const T& operator() (const size_t I, const size_t J) const;
 
   //offset functions
+  void make_tables() {M_LHS.make_table(); M_RHS.make_table();}
   size_t offset(const size_t I, const size_t J) const;
   void offset_col(const size_t I, const size_t J,
                   const size_t NI, const size_t rel,
@@ -143,13 +173,11 @@ void tensor_matrix2<T,NLHS,NRHS>::m_set_default()
 //-----------------------------------------------------------------------------------------
 // empty constructor 
 //-----------------------------------------------------------------------------------------
-/*
 template <typename T, size_t NLHS, size_t NRHS>
 tensor_matrix2<T,NLHS,NRHS>::tensor_matrix2()
 {
   //m_set_default();
 }
-*/
 
 //-----------------------------------------------------------------------------------------
 // copy constructor 
@@ -167,8 +195,9 @@ tensor_matrix2<T,NLHS,NRHS>::tensor_matrix2(const libj::tensor<T>& tens,
 // m_set_dimensions
 //	sets the bundles and dimensions of the tensor_matrix2
 //-----------------------------------------------------------------------------------------
-template<typename T, size_t NLHS, size_t NRHS>
-void tensor_matrix2<T,NLHS,NRHS>::m_set_dimensions(const std::string& lhs, 
+template<typename T, size_t NLHS, size_t NRHS> template <class TT>
+void tensor_matrix2<T,NLHS,NRHS>::m_set_dimensions(const TT& src,
+                                                   const std::string& lhs, 
                                                    const std::string& rhs)
 {
 
@@ -176,25 +205,25 @@ void tensor_matrix2<T,NLHS,NRHS>::m_set_dimensions(const std::string& lhs,
   if (lhs.length() == 0 && rhs.length()==0)
   {
     std::string new_lhs;
-    new_lhs.reserve(M_TENSOR.dim());
-    for (size_t i=0;i<M_TENSOR.dim();i++)
+    new_lhs.reserve(src.dim());
+    for (size_t i=0;i<src.dim();i++)
     {
       new_lhs.push_back((char)((int) 'a' + (int)i));
     }
 //    M_LHS.make_bundle<T>(M_TENSOR,new_lhs);
 //    M_RHS.make_bundle<T>(M_TENSOR,"");
-    M_LHS.make_bundle(M_TENSOR,new_lhs);
-    M_RHS.make_bundle(M_TENSOR,"");
+    M_LHS.make_bundle(src,new_lhs);
+    M_RHS.make_bundle(src,"");
   } else {
     //go through each and make the bundles 
 //    M_LHS.make_bundle<T>(M_TENSOR,lhs);
 //    M_RHS.make_bundle<T>(M_TENSOR,rhs);
-    M_LHS.make_bundle(M_TENSOR,lhs);
-    M_RHS.make_bundle(M_TENSOR,rhs);
+    M_LHS.make_bundle(src,lhs);
+    M_RHS.make_bundle(src,rhs);
   }
 
   //check if the bundles were good
-  if (!m_good_bundles())
+  if (!m_good_bundles(src.dim()))
   { 
     printf("ERROR libj::tensor_matrix2::m_set_dimensions \n");
     printf("The input bundles are bad \n");
@@ -209,10 +238,10 @@ void tensor_matrix2<T,NLHS,NRHS>::m_set_dimensions(const std::string& lhs,
 // m_check_bundles
 //-----------------------------------------------------------------------------------------
 template <typename T, size_t NLHS, size_t NRHS>
-bool tensor_matrix2<T,NLHS,NRHS>::m_good_bundles()
+bool tensor_matrix2<T,NLHS,NRHS>::m_good_bundles(const size_t ndim)
 {
   //check that the number of dimensions in each sums to tensor dimensions
-  if (M_LHS.dim() + M_RHS.dim() != M_TENSOR.dim()) {return false;}
+  if (M_LHS.dim() + M_RHS.dim() != ndim) {return false;}
 
   //check that each dimension only appears once
   constexpr size_t TOT = NLHS+NRHS; 
@@ -241,7 +270,7 @@ void tensor_matrix2<T,NLHS,NRHS>::assign(libj::tensor<T>& tens,
   M_BUFFER = M_TENSOR.data(); 
 
   //set the dimensions
-  m_set_dimensions(lhs,rhs);
+  m_set_dimensions(M_TENSOR,lhs,rhs);
 }
 
 template<typename T, size_t NLHS, size_t NRHS>
@@ -257,55 +286,80 @@ void tensor_matrix2<T,NLHS,NRHS>::assign(const libj::tensor<T>& tens,
   M_BUFFER = M_TENSOR.data();
 
   //set the dimensions
-  m_set_dimensions(lhs,rhs);
+  m_set_dimensions(M_TENSOR,lhs,rhs);
 }
 
 //-----------------------------------------------------------------------------------------
-// Access operators
+// Assigment from a tiled tensor. M_TENSOR is a view of its storage, with the same 
+//   number of dimensions, and only its data is used. The offsets are from the bundles
 //-----------------------------------------------------------------------------------------
-template <typename T, size_t NLHS, size_t NRHS>
-T& tensor_matrix2<T,NLHS,NRHS>::operator() (const size_t I, const size_t J)
+template<typename T, size_t NLHS, size_t NRHS>
+void tensor_matrix2<T,NLHS,NRHS>::assign(const libj::tensor_tiled<T>& tens, 
+                                         const std::string& lhs, 
+                                         const std::string& rhs)
 {
-  //dummy array 
-  std::vector<size_t> DUMMY(M_LHS.NDIM + M_RHS.NDIM); 
+  m_set_default();
 
-  //LHS
-  for (size_t idx = 0; idx < M_LHS.NDIM; idx++)
-  {
-    const size_t dim = M_LHS.DIM[idx];
-    DUMMY[dim] = M_LHS.get_index(I,idx);
-  }
+  std::vector<size_t> lengths(tens.dim());
+  for (size_t d=0;d<tens.dim();d++) lengths[d] = tens.size(d);
+  M_TENSOR.assign(const_cast<T*>(tens.data()),lengths);
+  M_BUFFER = M_TENSOR.data();
+
+  m_set_dimensions(tens,lhs,rhs);
+}
 
-  //RHS
-  for (size_t idx = 0; idx < M_RHS.NDIM; idx++)
+//-----------------------------------------------------------------------------------------
+// Assigment with compile time bundles. The bundles are checked by idx_bundles, so
+//   only the rank of the tensor is left to check
+//-----------------------------------------------------------------------------------------
+template<typename T, size_t NLHS, size_t NRHS> template <char... L, char... R>
+void tensor_matrix2<T,NLHS,NRHS>::assign(const libj::tensor<T>& tens,
+                                         libj::idx<L...> lhs, libj::idx<R...> rhs)
+{
+  static_assert(libj::idx_bundles<libj::idx<L...>,libj::idx<R...>,NLHS,NRHS>::value,
+                "libj::tensor_matrix2 : bad bundles");
+  m_set_default();
+
+  M_TENSOR = tens;
+  M_BUFFER = M_TENSOR.data();
+  if (M_TENSOR.dim() != NLHS + NRHS)
   {
-    const size_t dim = M_RHS.DIM[idx];
-    DUMMY[dim] = M_RHS.get_index(J,idx);
+    printf("ERROR libj::tensor_matrix2::assign \n");
+    printf("The tensor has %zu dimensions, the bundles %zu \n",M_TENSOR.dim(),NLHS+NRHS);
+    printf("LHS = %s \n",libj::idx<L...>::str);
+    printf("RHS = %s \n",libj::idx<R...>::str);
+    exit(1);
   }
- 
-  return M_TENSOR(DUMMY);
+  M_LHS.make_bundle(M_TENSOR,libj::idx<L...>::dims);
+  M_RHS.make_bundle(M_TENSOR,libj::idx<R...>::dims);
+}
+
+//-----------------------------------------------------------------------------------------
+// rebind
+//	points the bundles at the data of tens, without remaking them. The offsets
+//	are only valid if tens has the lengths and strides of the assigned tensor
+//-----------------------------------------------------------------------------------------
+template<typename T, size_t NLHS, size_t NRHS>
+void tensor_matrix2<T,NLHS,NRHS>::rebind(const libj::tensor<T>& tens)
+{
+  M_TENSOR = tens;
+  M_BUFFER = (size() > 0) ? M_TENSOR.data() + offset(0,0) : M_TENSOR.data();
+}
+
+//-----------------------------------------------------------------------------------------
+// Access operators
+//-----------------------------------------------------------------------------------------
+template <typename T, size_t NLHS, size_t NRHS>
+T& tensor_matrix2<T,NLHS,NRHS>::operator() (const size_t I, const size_t J)
+{
+  return *(M_TENSOR.data() + M_LHS.offset(I) + M_RHS.offset(J));
 }
 
 template <typename T, size_t NLHS, size_t NRHS>
 const T& tensor_matrix2<T,NLHS,NRHS>::operator() (const size_t I, 
                                                   const size_t J) const
 {
-  std::vector<size_t> vec(M_LHS.dim() + M_RHS.dim());
-  //LHS
-  for (size_t idx = 0; idx < M_LHS.dim(); idx++)
-  {
-    const size_t dim = M_LHS.DIM[idx];
-    vec[dim] = M_LHS.get_index(I,idx);
-  }
-
-  //RHS
-  for (size_t idx = 0; idx < M_RHS.dim(); idx++)
-  {
-    const size_t dim = M_RHS.DIM[idx];
-    vec[dim] = M_RHS.get_index(J,idx);
-  }
-
-  return M_TENSOR(vec);
+  return *(M_TENSOR.data() + M_LHS.offset(I) + M_RHS.offset(J));
 }
 
 //-----------------------------------------------------------------------------------------
@@ -337,15 +391,8 @@ inline void tensor_matrix2<T,NLHS,NRHS>::offset_col(const size_t I,
                                                     size_t* off) const
 {
   const size_t JOFF = M_RHS.offset(J); 
-  size_t tmp = M_LHS.offset(I+0);
-  for (size_t i=1;i<NI;i++)
-  {
-    tmp += JOFF;
-    off[i-1] = tmp - rel;
-    tmp = M_LHS.offset(I+i);
-  } 
-  tmp += JOFF;
-  off[NI-1] = tmp - rel;
+  M_LHS.offsets(I,NI,off);
+  for (size_t i=0;i<NI;i++) off[i] += JOFF - rel;
 }
 
 //-----------------------------------------------------------------------------------------
@@ -361,15 +408,8 @@ inline void tensor_matrix2<T,NLHS,NRHS>::offset_row(const size_t I,
                                                     size_t* off) const
 {
   const size_t IOFF = M_LHS.offset(I); 
-  size_t tmp = M_RHS.offset(J+0);
-  for (size_t j=1;j<NJ;j++)
-  {
-    tmp += IOFF;
-    off[j-1] = tmp - rel;
-    tmp = M_RHS.offset(J+j);
-  } 
-  tmp += IOFF;
-  off[NJ-1] = tmp - rel;
+  M_RHS.offsets(J,NJ,off);
+  for (size_t j=0;j<NJ;j++) off[j] += IOFF - rel;
 }
 
 //-----------------------------------------------------------------------------------------
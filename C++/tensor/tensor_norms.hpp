@@ -0,0 +1,195 @@
+/*----------------------------------------------------------------------------
+  tensor_norms.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for tensor_norms, the Frobenius norms of the tiles of a
+  libj::tensor, for screening the contractions (see the screened
+  libj::contract in jblis_level3.hpp). Each dimension d is split into
+  tiles of TILE[d] elements (the last may be shorter), and the norm of
+  every tile is kept, in column major order of the tiles.
+
+  The norms are a cache of the tensor they were computed from. The
+  data pointer, lengths, and strides of that tensor are kept, so a
+  tensor_norms can tell if it is still the one for a tensor, and
+  update() only recomputes them when it is not. Call invalidate() after
+  changing the elements in place.
+
+  INITIALIZATION
+  -------------------
+    libj::tensor_norms<double> N(A,16);        //tiles of 16 in every dim
+    N.compute(A,{8,8,16,16});                  //tile extents of each dim
+    N.update(A);                               //recompute if A changed
+    N.invalidate();                            //elements of A changed
+
+  ACCESS
+  -------------------
+    N.norm({1,0,2,2});		//norm of tile (1,0,2,2)
+    N.norm(t);			//norm of tile number t
+    N.max();			//largest tile norm
+    N.matches(A);		//true if these are the norms of A
+    N.dim();			//number of dimensions
+    N.tile(d);			//tile extent of dimension d
+    N.ntiles(d);		//tiles in dimension d
+    N.ntiles();			//tiles in all
+    N.start(d,t);		//first index of tile t of dimension d
+    N.length(d,t);		//length of tile t of dimension d
+----------------------------------------------------------------------------*/
+#ifndef TENSOR_NORMS_HPP
+#define TENSOR_NORMS_HPP
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <complex>
+#include <vector>
+#include "tensor.hpp"
+
+namespace libj
+{
+
+template <typename T>
+class tensor_norms
+{
+  private:
+  std::vector<size_t> M_TILE;     //tile extent of each dimension
+  std::vector<size_t> M_NTILE;    //tiles in each dimension
+  std::vector<size_t> M_LENGTHS;  //lengths of the tensor
+  std::vector<size_t> M_STRIDE;   //strides of the tensor
+  std::vector<double> M_NORM;     //norm of each tile
+  const T*            M_DATA;     //data of the tensor, NULL if not set
+  double              M_MAX;      //largest norm
+
+  public:
+  tensor_norms() : M_DATA(NULL), M_MAX(0) {}
+  tensor_norms(const libj::tensor<T>& A, const size_t tile) : tensor_norms() {compute(A,tile);}
+  tensor_norms(const libj::tensor<T>& A, const std::vector<size_t>& tile) : tensor_norms()
+    {compute(A,tile);}
+
+  void compute(const libj::tensor<T>& A, const size_t tile)
+  {
+    compute(A,std::vector<size_t>(A.dim(),tile));
+  }
+
+  void compute(const libj::tensor<T>& A, const std::vector<size_t>& tile);
+
+  //recompute, with the same tile extents, if these are not the norms of A
+  void update(const libj::tensor<T>& A)
+  {
+    if (!matches(A))
+    {
+      const std::vector<size_t> tile = M_TILE;
+      if (tile.size() != A.dim())
+      {
+        printf("ERROR libj::tensor_norms::update \n");
+        printf("Tiles for %zu dimensions, tensor of %zu \n",tile.size(),A.dim());
+        exit(1);
+      }
+      compute(A,tile);
+    }
+  }
+
+  void invalidate() {M_DATA = NULL;}
+
+  bool matches(const libj::tensor<T>& A) const
+  {
+    if (M_DATA == NULL || M_DATA != A.data() || A.dim() != M_LENGTHS.size()) return false;
+    for (size_t d=0;d<A.dim();d++)
+    {
+      if (A.size(d) != M_LENGTHS[d] || A.stride(d) != M_STRIDE[d]) return false;
+    }
+    return true;
+  }
+
+  double norm(const size_t t) const {return M_NORM[t];}
+  double norm(const std::vector<size_t>& tidx) const
+  {
+    size_t t = 0, s = 1;
+    for (size_t d=0;d<tidx.size();d++) {t += s*tidx[d]; s *= M_NTILE[d];}
+    return M_NORM[t];
+  }
+  double max() const {return M_MAX;}
+
+  size_t dim() const {return M_TILE.size();}
+  size_t tile(const size_t d) const {return M_TILE[d];}
+  size_t ntiles(const size_t d) const {return M_NTILE[d];}
+  size_t ntiles() const {return M_NORM.size();}
+  size_t start(const size_t d, const size_t t) const {return t*M_TILE[d];}
+  size_t length(const size_t d, const size_t t) const
+  {
+    const size_t s = t*M_TILE[d];
+    return (s + M_TILE[d] <= M_LENGTHS[d]) ? M_TILE[d] : M_LENGTHS[d] - s;
+  }
+};
+
+/*----------------------------------------------------------------------------
+  compute
+	goes through the elements in column major order, with the tile of
+	each index of every dimension in a table
+----------------------------------------------------------------------------*/
+template <typename T>
+void tensor_norms<T>::compute(const libj::tensor<T>& A, const std::vector<size_t>& tile)
+{
+  const size_t ND = A.dim();
+  if (tile.size() != ND)
+  {
+    printf("ERROR libj::tensor_norms::compute \n");
+    printf("Tiles for %zu dimensions, tensor of %zu \n",tile.size(),ND);
+    exit(1);
+  }
+  M_TILE = tile;
+  M_NTILE.resize(ND);
+  M_LENGTHS.resize(ND);
+  M_STRIDE.resize(ND);
+  size_t NT = 1;
+  std::vector<std::vector<size_t> > TOFF(ND);
+  for (size_t d=0;d<ND;d++)
+  {
+    if (tile[d] == 0)
+    {
+      printf("ERROR libj::tensor_norms::compute \n");
+      printf("Tile extent of dimension %zu is 0 \n",d);
+      exit(1);
+    }
+    M_LENGTHS[d] = A.size(d);
+    M_STRIDE[d]  = A.stride(d);
+    M_NTILE[d]   = (A.size(d) + tile[d] - 1)/tile[d];
+    TOFF[d].resize(A.size(d));
+    for (size_t i=0;i<A.size(d);i++) TOFF[d][i] = NT*(i/tile[d]);
+    NT *= M_NTILE[d];
+  }
+  M_NORM.assign(NT,0.0);
+
+  //inner loop over dimension 0, the counter over the others
+  const T* X = A.data();
+  std::vector<size_t> idx(ND,0);
+  const size_t N0 = (ND > 0) ? A.size(0) : 1;
+  const size_t S0 = (ND > 0) ? A.stride(0) : 1;
+  const size_t NL = (ND > 0) ? A.size()/N0 : 1;
+  for (size_t l=0;l<NL;l++)
+  {
+    size_t off = 0, toff = 0;
+    for (size_t d=1;d<ND;d++) {off += idx[d]*M_STRIDE[d]; toff += TOFF[d][idx[d]];}
+    for (size_t i=0;i<N0;i++)
+    {
+      const double a = (double) std::norm(X[off + i*S0]);
+      M_NORM[toff + ((ND > 0) ? TOFF[0][i] : 0)] += a;
+    }
+    for (size_t d=1;d<ND;d++)
+    {
+      if (++idx[d] < M_LENGTHS[d]) break;
+      idx[d] = 0;
+    }
+  }
+
+  M_MAX = 0;
+  for (size_t t=0;t<NT;t++)
+  {
+    M_NORM[t] = sqrt(M_NORM[t]);
+    if (M_NORM[t] > M_MAX) M_MAX = M_NORM[t];
+  }
+  M_DATA = A.data();
+}
+
+}//end of namespace
+
+#endif
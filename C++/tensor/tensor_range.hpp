@@ -0,0 +1,55 @@
+/*----------------------------------------------------------------------------
+  tensor_range.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for the range struct, which is used to take strided slices of 
+  tensors (tensor.hpp and tensor_fixed.hpp) via T.slice(...)
+
+  Each argument of slice is one dimension of the tensor, and is either
+    libj::range()            //the whole dimension
+    libj::range(s,e)         //elements s,s+1,...,e-1
+    libj::range(s,e,step)    //elements s,s+step,... < e
+    i                        //a fixed index, which drops the dimension
+
+  e.g., for a tensor A(10,20,30)
+    libj::tensor<double> V = A.slice(libj::range(0,4),3,libj::range(0,30,2));
+  is the 4x15 view V(i,k) = A(i,3,2*k), which shares the memory of A.
+
+  slice_rank<Args...>::value is the number of range arguments, which is the 
+  number of dimensions of the slice
+----------------------------------------------------------------------------*/
+#ifndef TENSOR_RANGE_HPP
+#define TENSOR_RANGE_HPP
+
+#include <stdlib.h>
+
+namespace libj
+{
+
+struct range
+{
+  size_t start;   //first element
+  size_t end;     //one past the last element
+  size_t step;    //stride between elements
+  bool   all;     //true if this is the whole dimension
+
+  range() : start(0), end(0), step(1), all(true) {}
+  range(const size_t s, const size_t e, const size_t st=1) 
+    : start(s), end(e), step(st), all(false) {}
+};
+
+//number of range arguments
+template <class...Rest> struct slice_rank;
+template <> struct slice_rank<> {static const size_t value = 0;};
+template <class...Rest> struct slice_rank<libj::range,Rest...> 
+{
+  static const size_t value = 1 + slice_rank<Rest...>::value;
+};
+template <class First, class...Rest> struct slice_rank<First,Rest...> 
+{
+  static const size_t value = slice_rank<Rest...>::value;
+};
+
+}//end of namespace
+
+#endif
@@ -0,0 +1,222 @@
+/*----------------------------------------------------------------------------
+  tensor_runs.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for tensor_runs and for_each_run, which walk a (possibly strided)
+  libj::tensor as runs of contiguous elements, so that generic element-wise
+  code can hand each run to a simd_* kernel instead of using T(i,j,k) or
+  requiring is_sequential().
+
+  The dimensions of length 1 are dropped, and dimension d+1 is fused into d
+  when STRIDE[d+1] == STRIDE[d]*LENGTH[d], so the first (fused) dimension is
+  as long as it can be. That is the run, and the other fused dimensions are
+  walked with counters, with no divisions. A sequential tensor is one run.
+
+  If the stride of the runs (inc()) is not 1, the contiguous runs are single
+  elements. for_each_line gives the whole strided line (pointer, length,
+  stride) instead, for the simd_*_strided kernels.
+
+  For two tensors of the same lengths, a dimension is only fused if it can
+  be in both, so the runs line up.
+
+  USAGE
+  ------------------
+  libj::for_each_run(A,[](double* p, size_t n){simd_zero(n,p);});
+  libj::for_each_line(A,[](double* p, size_t n, size_t inc){...});
+  libj::for_each_run(X,Y,[](const double* x, double* y, size_t n){simd_copy(n,x,y);});
+
+  For parallel loops
+    libj::tensor_runs R(A);    //or R(X,Y)
+    R.run();                   //length of the runs
+    R.inc(0);                  //stride of the runs in A (inc(1) for Y)
+    R.num();                   //number of runs
+    R.offset(r);               //offset of run r from A.data() (offset(r,1) for Y)
+    R.walk(r0,r1,g);           //g(offA,offB) for runs r0 <= r < r1
+----------------------------------------------------------------------------*/
+#ifndef TENSOR_RUNS_HPP
+#define TENSOR_RUNS_HPP
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "tensor.hpp"
+
+namespace libj
+{
+
+struct tensor_runs
+{
+  size_t NDIM;                          //number of outer (fused) dimensions
+  size_t RUN;                           //length of the runs
+  size_t INC[2];                        //stride of the runs in A and B
+  size_t NRUN;                          //number of runs
+  size_t LEN[LIBJ_TENSOR_MAX_DIM];      //lengths of the outer dimensions
+  size_t STR[2][LIBJ_TENSOR_MAX_DIM];   //strides of the outer dimensions in A and B
+
+  template <typename T>
+  tensor_runs(const libj::tensor<T>& A) {make(A,A);}
+  template <typename T>
+  tensor_runs(const libj::tensor<T>& A, const libj::tensor<T>& B) {make(A,B);}
+
+  size_t run() const {return RUN;}
+  size_t inc(const size_t which = 0) const {return INC[which];}
+  size_t num() const {return NRUN;}
+  size_t dim() const {return NDIM;}
+
+  //fuse the dimensions of A and B
+  template <typename T>
+  void make(const libj::tensor<T>& A, const libj::tensor<T>& B)
+  {
+    bool same = (A.dim() == B.dim());
+    for (size_t d=0;same && d<A.dim();d++) {same = (A.size(d) == B.size(d));}
+    if (!same)
+    {
+      printf("ERROR libj::tensor_runs::make \n");
+      printf("the tensors do not have the same lengths \n");
+      exit(1);
+    }
+
+    NDIM = 0; RUN = 1; INC[0] = 1; INC[1] = 1; NRUN = (A.size() > 0) ? 1 : 0;
+    bool first = true;
+    for (size_t d=0;d<A.dim();d++)
+    {
+      const size_t len = A.size(d);
+      if (len == 1) continue;
+      const size_t sa = A.stride(d);
+      const size_t sb = B.stride(d);
+      if (first)
+      {
+        RUN = len; INC[0] = sa; INC[1] = sb;
+        first = false;
+      } else if (NDIM == 0 && sa == INC[0]*RUN && sb == INC[1]*RUN) {
+        RUN *= len;
+      } else if (NDIM > 0 && sa == STR[0][NDIM-1]*LEN[NDIM-1]
+                          && sb == STR[1][NDIM-1]*LEN[NDIM-1]) {
+        LEN[NDIM-1] *= len;
+      } else {
+        LEN[NDIM] = len; STR[0][NDIM] = sa; STR[1][NDIM] = sb;
+        NDIM++;
+      }
+    }
+    if (NRUN > 0) {for (size_t d=0;d<NDIM;d++) NRUN *= LEN[d];}
+  }
+
+  //offset of the start of run r, in A (which = 0) or B (which = 1)
+  size_t offset(size_t r, const size_t which = 0) const
+  {
+    size_t off = 0;
+    for (size_t d=0;d<NDIM;d++)
+    {
+      off += (r % LEN[d])*STR[which][d];
+      r /= LEN[d];
+    }
+    return off;
+  }
+
+  //g(offA,offB) for the runs r0 <= r < r1, in order
+  template <class G>
+  void walk(const size_t r0, const size_t r1, const G& g) const
+  {
+    if (r0 >= r1) return;
+    size_t cnt[LIBJ_TENSOR_MAX_DIM];
+    size_t oa = 0, ob = 0, r = r0;
+    for (size_t d=0;d<NDIM;d++)
+    {
+      cnt[d] = r % LEN[d];
+      r /= LEN[d];
+      oa += cnt[d]*STR[0][d];
+      ob += cnt[d]*STR[1][d];
+    }
+    for (size_t run=r0;run<r1;run++)
+    {
+      g(oa,ob);
+      for (size_t d=0;d<NDIM;d++)
+      {
+        if (++cnt[d] < LEN[d]) {oa += STR[0][d]; ob += STR[1][d]; break;}
+        oa -= (LEN[d]-1)*STR[0][d];
+        ob -= (LEN[d]-1)*STR[1][d];
+        cnt[d] = 0;
+      }
+    }
+  }
+  template <class G>
+  void walk(const G& g) const {walk(0,NRUN,g);}
+};
+
+/*----------------------------------------------------------------------------
+  for_each_line
+	f(pointer, length, stride) for each fused line of A
+----------------------------------------------------------------------------*/
+template <typename T, class F>
+void for_each_line(libj::tensor<T>& A, const F& f)
+{
+  const tensor_runs R(A);
+  T* a = A.data();
+  R.walk([&](const size_t oa, const size_t ob) {f(a+oa,R.RUN,R.INC[0]);});
+}
+
+template <typename T, class F>
+void for_each_line(const libj::tensor<T>& A, const F& f)
+{
+  const tensor_runs R(A);
+  const T* a = A.data();
+  R.walk([&](const size_t oa, const size_t ob) {f(a+oa,R.RUN,R.INC[0]);});
+}
+
+/*----------------------------------------------------------------------------
+  for_each_run
+	f(pointer, length) for each contiguous run of A
+----------------------------------------------------------------------------*/
+template <typename T, class F>
+void for_each_run(libj::tensor<T>& A, const F& f)
+{
+  const tensor_runs R(A);
+  T* a = A.data();
+  if (R.INC[0] == 1) {
+    R.walk([&](const size_t oa, const size_t ob) {f(a+oa,R.RUN);});
+  } else {
+    R.walk([&](const size_t oa, const size_t ob)
+    {
+      for (size_t i=0;i<R.RUN;i++) f(a+oa+i*R.INC[0],(size_t) 1);
+    });
+  }
+}
+
+template <typename T, class F>
+void for_each_run(const libj::tensor<T>& A, const F& f)
+{
+  const tensor_runs R(A);
+  const T* a = A.data();
+  if (R.INC[0] == 1) {
+    R.walk([&](const size_t oa, const size_t ob) {f(a+oa,R.RUN);});
+  } else {
+    R.walk([&](const size_t oa, const size_t ob)
+    {
+      for (size_t i=0;i<R.RUN;i++) f(a+oa+i*R.INC[0],(size_t) 1);
+    });
+  }
+}
+
+/*----------------------------------------------------------------------------
+  for_each_run
+	f(pointer X, pointer Y, length) for each run that is contiguous in
+	both X and Y, which have the same lengths
+----------------------------------------------------------------------------*/
+template <typename T, class F>
+void for_each_run(const libj::tensor<T>& X, libj::tensor<T>& Y, const F& f)
+{
+  const tensor_runs R(X,Y);
+  const T* x = X.data();
+  T* y = Y.data();
+  if (R.INC[0] == 1 && R.INC[1] == 1) {
+    R.walk([&](const size_t ox, const size_t oy) {f(x+ox,y+oy,R.RUN);});
+  } else {
+    R.walk([&](const size_t ox, const size_t oy)
+    {
+      for (size_t i=0;i<R.RUN;i++) f(x+ox+i*R.INC[0],y+oy+i*R.INC[1],(size_t) 1);
+    });
+  }
+}
+
+}//end of namespace
+
+#endif
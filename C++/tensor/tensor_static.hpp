@@ -0,0 +1,155 @@
+/*----------------------------------------------------------------------------
+  tensor_static.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for tensor_static, a tensor whose rank and lengths are template
+  parameters, for the small shapes of the integral code (3x3x3, 6x6, ...).
+  The strides are constexpr, so the offset of T(i,j,k) is a few multiplies
+  by constants (or a constant, for constant indices), and the elements live
+  inside the object, aligned to LIBJ_MAX_ALIGN, on the stack with no malloc.
+
+  The storage is column major
+
+  The lengths and strides are the same for every tensor of the type, so
+  there is no allocate, assign, or slice. It can be used wherever the
+  element-wise expressions of tensor_expr.hpp take a tensor.
+
+  INITIALIZATION
+  -------------------
+    libj::tensor_static<double,3,3,3> T;     //elements are not set
+    libj::tensor_static<double,6,6> A(0.0);  //every element is 0.0
+
+  ELEMENT ACCESS
+  ------------------
+    T[n];                       //n'th element
+    T(1,2,0);                   //index access, offset folded at compile time
+
+  USEFUL FUNCTIONS
+  --------------------
+    T.dim();                    //number of dimensions, constexpr
+    T.size();                   //number of elements, constexpr
+    T.size(d);                  //length of dimension d, constexpr
+    T.stride(d);                //stride of dimension d, constexpr
+    T.data();                   //pointer to the elements
+    T.fill(x);                  //set every element to x
+    libj::tensor_static<double,3,3,3>::SIZE;	//27, as a constant expression
+----------------------------------------------------------------------------*/
+#ifndef TENSOR_STATIC_HPP
+#define TENSOR_STATIC_HPP
+
+#include <stddef.h>
+#include "libjdef.h"
+#include "tensor_expr.hpp"
+
+namespace libj
+{
+
+//-----------------------------------------------------------------------
+// tensor_static_shape
+//	lengths, strides and offsets of a static shape, all constexpr
+//-----------------------------------------------------------------------
+template <size_t L0, size_t...Ls>
+struct tensor_static_shape
+{
+  typedef tensor_static_shape<Ls...> next;
+  static constexpr size_t NDIM = 1 + next::NDIM;
+  static constexpr size_t SIZE = L0*next::SIZE;
+
+  static constexpr size_t length(const size_t d) {return (d == 0) ? L0 : next::length(d-1);}
+  static constexpr size_t stride(const size_t d) {return (d == 0) ? 1 : L0*next::stride(d-1);}
+
+  template <class...Rest>
+  static constexpr size_t offset(const size_t i0, const Rest...rest)
+  {
+    return i0 + L0*next::offset(rest...);
+  }
+};
+
+template <size_t L0>
+struct tensor_static_shape<L0>
+{
+  static constexpr size_t NDIM = 1;
+  static constexpr size_t SIZE = L0;
+
+  static constexpr size_t length(const size_t d) {return L0;}
+  static constexpr size_t stride(const size_t d) {return 1;}
+  static constexpr size_t offset(const size_t i0) {return i0;}
+};
+
+template <size_t L0, size_t...Ls> constexpr size_t tensor_static_shape<L0,Ls...>::NDIM;
+template <size_t L0, size_t...Ls> constexpr size_t tensor_static_shape<L0,Ls...>::SIZE;
+template <size_t L0> constexpr size_t tensor_static_shape<L0>::NDIM;
+template <size_t L0> constexpr size_t tensor_static_shape<L0>::SIZE;
+
+//-----------------------------------------------------------------------
+// tensor_static
+//-----------------------------------------------------------------------
+template <typename T, size_t...L>
+class tensor_static
+{
+  private:
+  typedef tensor_static_shape<L...> shape;
+
+  public:
+  static constexpr size_t NDIM = shape::NDIM;
+  static constexpr size_t SIZE = shape::SIZE;
+
+  private:
+  alignas(LIBJ_MAX_ALIGN) T M_DATA[SIZE];
+
+  public:
+  tensor_static() {}
+  explicit tensor_static(const T val) {fill(val);}
+
+  //evaluate an expression into this tensor
+  template <class E> tensor_static<T,L...>& operator= (const libj::tensor_node<E>& expr)
+  {
+    libj::tensor_eval(*this,expr);
+    return *this;
+  }
+
+  //Getters, all known at compile time
+  static constexpr size_t size() {return SIZE;}
+  static constexpr size_t size(const size_t dim) {return shape::length(dim);}
+  static constexpr size_t dim() {return NDIM;}
+  static constexpr size_t stride(const size_t dim) {return shape::stride(dim);}
+  static constexpr size_t alignment() {return LIBJ_MAX_ALIGN;}
+  static constexpr bool   is_set() {return true;}
+  static constexpr bool   is_sequential() {return true;}
+
+  //Access functions
+  T& operator[] (const size_t n) {return M_DATA[n];}
+  const T& operator[] (const size_t n) const {return M_DATA[n];}
+
+  template<class...Rest> T& operator() (const size_t i0, const Rest...rest)
+  {
+    static_assert(1 + sizeof...(Rest) == NDIM,"libj::tensor_static : wrong number of indices");
+    return M_DATA[shape::offset(i0,rest...)];
+  }
+  template<class...Rest> const T& operator() (const size_t i0, const Rest...rest) const
+  {
+    static_assert(1 + sizeof...(Rest) == NDIM,"libj::tensor_static : wrong number of indices");
+    return M_DATA[shape::offset(i0,rest...)];
+  }
+
+  T* data() {return M_DATA;}
+  const T* data() const {return M_DATA;}
+
+  void fill(const T val) {for (size_t n=0;n<SIZE;n++) M_DATA[n] = val;}
+};
+
+template <typename T, size_t...L> constexpr size_t tensor_static<T,L...>::NDIM;
+template <typename T, size_t...L> constexpr size_t tensor_static<T,L...>::SIZE;
+
+//-----------------------------------------------------------------------
+// static tensors are leaves of expressions
+//-----------------------------------------------------------------------
+template <typename T, size_t...L> struct tensor_arg<tensor_static<T,L...> >
+{
+  typedef tensor_leaf<T> type;
+  static type make(const tensor_static<T,L...>& x) {return type(x);}
+};
+
+}//end of namespace
+
+#endif
@@ -0,0 +1,424 @@
+/*----------------------------------------------------------------------------
+  tensor_tiled.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for tensor_tiled, a tensor stored in tiles instead of column
+  major order, so that elements that are close in every index are close in
+  memory. Sweeping the last index of a column major tensor strides by the
+  product of all the other lengths; in a tiled tensor it stays inside a
+  tile for TILE(last) steps.
+
+  Two layouts are supported
+    TENSOR_TILED  : tiles of set extents, stored one after another in
+                    column major order of the tiles, each tile column major.
+                    Partial tiles at the edges are padded to full tiles
+    TENSOR_MORTON : Z-order, the bits of the indices are interleaved. Each
+                    length is padded to a power of two, and lengths that
+                    run out of bits drop out of the interleave
+
+  In both layouts the offset of an element is a sum of one term per
+  dimension, offset(i,j,k) = OFF[0][i] + OFF[1][j] + OFF[2][k], with the
+  tables OFF[d] kept in the tensor. This is what lets index_bundle2 and
+  tensor_matrix2 (and so block_scatter_matrix2) treat a tiled tensor like
+  any other, see make_bundle. Blocks that stay inside a tile are still
+  found to have a constant stride by block_scatter_matrix2.
+
+  INITIALIZATION
+  -------------------
+    libj::tensor_tiled<double> T;
+    T.allocate_tiled({no,no,nv,nv},{8,8,8,8});   //lengths, tile extents
+    T.allocate_morton({64,64,64});
+    T.deallocate();                              //also done by destructor
+
+  CONVERSION
+  -------------------
+    T.from_tensor(A);           //copy a libj::tensor of the same lengths in
+    T.to_tensor(A);             //copy out to a libj::tensor
+
+  ELEMENT ACCESS
+  ------------------
+    T(1,2,3,4);                 //index access
+    T.offset(d,i);              //offset contribution of index i of dim d
+    T.for_each(f);              //f(T& x, const size_t* idx) for every
+                                //  element, in tile order
+
+  USEFUL FUNCTIONS
+  --------------------
+    T.dim();                    //number of dimensions
+    T.size();                   //number of elements
+    T.size(d);                  //length of dimension d
+    T.tile(d);                  //tile extent of dimension d
+    T.storage();                //elements stored, including padding
+    T.layout();                 //TENSOR_TILED or TENSOR_MORTON
+    T.data();                   //pointer to the storage
+----------------------------------------------------------------------------*/
+#ifndef TENSOR_TILED_HPP
+#define TENSOR_TILED_HPP
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <vector>
+#include <algorithm>
+#include "libjdef.h"
+#include "tensor.hpp"
+
+namespace libj
+{
+
+enum tensor_layout {TENSOR_TILED = 0, TENSOR_MORTON = 1};
+
+template <typename T>
+class tensor_tiled
+{
+  private:
+  T*                  M_BUFFER;                       //storage
+  tensor_layout       M_LAYOUT;                       //layout
+  size_t              M_NDIM;                         //number of dimensions
+  size_t              M_NELM;                         //number of elements
+  size_t              M_NSTORE;                       //elements stored
+  size_t              M_LENGTHS[LIBJ_TENSOR_MAX_DIM]; //lengths
+  size_t              M_TILE[LIBJ_TENSOR_MAX_DIM];    //tile extents
+  std::vector<size_t> M_OFF[LIBJ_TENSOR_MAX_DIM];     //offset tables
+
+  //no copies, the tensor owns its storage
+  tensor_tiled(const tensor_tiled<T>& other);
+  tensor_tiled<T>& operator= (const tensor_tiled<T>& other);
+
+  void m_check(const std::vector<size_t>& lengths);
+  void m_allocate();
+
+  //visit every element in tile order, with f(tiled offset, strided offset)
+  template <class F> void m_walk(const size_t* S, F& f) const;
+
+  template<class...Rest>
+  size_t m_index(const size_t level, const size_t first, const Rest...rest) const
+  {
+    return M_OFF[level][first] + m_index(level+1,rest...);
+  }
+  size_t m_index(const size_t level) const {return 0;}
+
+  public:
+  tensor_tiled() : M_BUFFER(NULL), M_LAYOUT(TENSOR_TILED), M_NDIM(0), M_NELM(0), M_NSTORE(0) {}
+  ~tensor_tiled() {if (M_BUFFER != NULL) deallocate();}
+
+  void allocate_tiled(const std::vector<size_t>& lengths, const std::vector<size_t>& tiles);
+  void allocate_morton(const std::vector<size_t>& lengths);
+  void deallocate();
+
+  //getters
+  size_t dim() const {return M_NDIM;}
+  size_t size() const {return M_NELM;}
+  size_t size(const size_t d) const {return M_LENGTHS[d];}
+  size_t tile(const size_t d) const {return M_TILE[d];}
+  size_t storage() const {return M_NSTORE;}
+  tensor_layout layout() const {return M_LAYOUT;}
+  bool is_set() const {return M_BUFFER != NULL;}
+  T* data() {return M_BUFFER;}
+  const T* data() const {return M_BUFFER;}
+
+  //offsets
+  size_t offset(const size_t d, const size_t i) const {return M_OFF[d][i];}
+  const size_t* offsets(const size_t d) const {return M_OFF[d].data();}
+
+  //access
+  template<class...Rest> T& operator() (const size_t i0, const Rest...rest)
+  {
+    return *(M_BUFFER + m_index(0,i0,rest...));
+  }
+  template<class...Rest> const T& operator() (const size_t i0, const Rest...rest) const
+  {
+    return *(M_BUFFER + m_index(0,i0,rest...));
+  }
+
+  template <class F> void for_each(F f);
+
+  //conversion
+  void from_tensor(const libj::tensor<T>& A);
+  void to_tensor(libj::tensor<T>& A) const;
+};
+
+//-----------------------------------------------------------------------
+// check the lengths
+//-----------------------------------------------------------------------
+template <typename T>
+void tensor_tiled<T>::m_check(const std::vector<size_t>& lengths)
+{
+  if (M_BUFFER != NULL)
+  {
+    printf("ERROR libj::tensor_tiled::allocate\n");
+    printf("attempted to allocate an already allocated tensor\n");
+    exit(1);
+  }
+  if (lengths.size() < 1 || lengths.size() > LIBJ_TENSOR_MAX_DIM)
+  {
+    printf("ERROR libj::tensor_tiled::allocate\n");
+    printf("%zu dimensions is not in [1,LIBJ_TENSOR_MAX_DIM]\n",lengths.size());
+    exit(1);
+  }
+  M_NDIM = lengths.size();
+  M_NELM = 1;
+  for (size_t d=0;d<M_NDIM;d++)
+  {
+    if (lengths[d] < 1)
+    {
+      printf("ERROR libj::tensor_tiled::allocate\n");
+      printf("dimension %zu has zero length\n",d);
+      exit(1);
+    }
+    M_LENGTHS[d] = lengths[d];
+    M_NELM *= lengths[d];
+  }
+}
+
+//-----------------------------------------------------------------------
+// allocate the storage, with the padding set to zero
+//-----------------------------------------------------------------------
+template <typename T>
+void tensor_tiled<T>::m_allocate()
+{
+  void* p = NULL;
+  const size_t align = (LIBJ_MAX_ALIGN > sizeof(void*)) ? LIBJ_MAX_ALIGN : sizeof(void*);
+  if (posix_memalign(&p,align,M_NSTORE*sizeof(T)) != 0 || p == NULL)
+  {
+    printf("ERROR libj::tensor_tiled::allocate\n");
+    printf("could not allocate %zu elements\n",M_NSTORE);
+    exit(1);
+  }
+  libj::mem_track(p,M_NSTORE*sizeof(T));
+  M_BUFFER = (T*) p;
+  for (size_t n=0;n<M_NSTORE;n++) M_BUFFER[n] = (T) 0;
+}
+
+//-----------------------------------------------------------------------
+// tiles of extents tiles[d], column major within and between tiles
+//-----------------------------------------------------------------------
+template <typename T>
+void tensor_tiled<T>::allocate_tiled(const std::vector<size_t>& lengths,
+                                     const std::vector<size_t>& tiles)
+{
+  m_check(lengths);
+  if (tiles.size() != M_NDIM)
+  {
+    printf("ERROR libj::tensor_tiled::allocate_tiled\n");
+    printf("%zu tile extents for %zu dimensions\n",tiles.size(),M_NDIM);
+    exit(1);
+  }
+  M_LAYOUT = TENSOR_TILED;
+
+  size_t TSIZE = 1;
+  for (size_t d=0;d<M_NDIM;d++)
+  {
+    M_TILE[d] = std::min(std::max(tiles[d],(size_t) 1),M_LENGTHS[d]);
+    TSIZE *= M_TILE[d];
+  }
+
+  //OFF[d][i] = (i%b)*inner stride + (i/b)*tile stride
+  size_t IN = 1, OUT = TSIZE;
+  for (size_t d=0;d<M_NDIM;d++)
+  {
+    const size_t b  = M_TILE[d];
+    const size_t nt = (M_LENGTHS[d] + b - 1)/b;
+    M_OFF[d].resize(M_LENGTHS[d]);
+    for (size_t i=0;i<M_LENGTHS[d];i++) M_OFF[d][i] = (i%b)*IN + (i/b)*OUT;
+    IN  *= b;
+    OUT *= nt;
+  }
+  M_NSTORE = OUT;
+  m_allocate();
+}
+
+//-----------------------------------------------------------------------
+// Z-order, lengths padded to powers of two
+//-----------------------------------------------------------------------
+template <typename T>
+void tensor_tiled<T>::allocate_morton(const std::vector<size_t>& lengths)
+{
+  m_check(lengths);
+  M_LAYOUT = TENSOR_MORTON;
+
+  size_t BITS[LIBJ_TENSOR_MAX_DIM];
+  size_t MAXB = 0, TOTB = 0;
+  for (size_t d=0;d<M_NDIM;d++)
+  {
+    BITS[d] = 0;
+    while (((size_t) 1 << BITS[d]) < M_LENGTHS[d]) BITS[d]++;
+    MAXB = std::max(MAXB,BITS[d]);
+    TOTB += BITS[d];
+    M_OFF[d].assign(M_LENGTHS[d],0);
+  }
+  if (TOTB >= 8*sizeof(size_t) - 1)
+  {
+    printf("ERROR libj::tensor_tiled::allocate_morton\n");
+    printf("the padded tensor has more than 2^%zu elements\n",TOTB);
+    exit(1);
+  }
+
+  //bit k of dimension d goes to the next free bit of the offset
+  size_t pos = 0;
+  for (size_t k=0;k<MAXB;k++)
+  {
+    for (size_t d=0;d<M_NDIM;d++)
+    {
+      if (k >= BITS[d]) continue;
+      for (size_t i=0;i<M_LENGTHS[d];i++)
+      {
+        if ((i >> k) & 1) M_OFF[d][i] |= ((size_t) 1 << pos);
+      }
+      pos++;
+    }
+  }
+
+  //the walk uses 8 wide cubes, which are contiguous
+  for (size_t d=0;d<M_NDIM;d++) M_TILE[d] = std::min(M_LENGTHS[d],(size_t) 1 << std::min(BITS[d],(size_t) 3));
+  M_NSTORE = (size_t) 1 << TOTB;
+  m_allocate();
+}
+
+//-----------------------------------------------------------------------
+// deallocate
+//-----------------------------------------------------------------------
+template <typename T>
+void tensor_tiled<T>::deallocate()
+{
+  if (M_BUFFER == NULL)
+  {
+    printf("ERROR libj::tensor_tiled::deallocate\n");
+    printf("attempted to deallocate an unallocated tensor\n");
+    exit(1);
+  }
+  libj::mem_untrack(M_BUFFER);
+  free(M_BUFFER);
+  M_BUFFER = NULL;
+  M_NDIM = M_NELM = M_NSTORE = 0;
+}
+
+//-----------------------------------------------------------------------
+// walk the tiles in order, and each tile column major. For each line of
+//   the first dimension in a tile, the offsets of the other dimensions
+//   are summed once
+//-----------------------------------------------------------------------
+template <typename T> template <class F>
+void tensor_tiled<T>::m_walk(const size_t* S, F& f) const
+{
+  size_t NT[LIBJ_TENSOR_MAX_DIM], TI[LIBJ_TENSOR_MAX_DIM];
+  size_t LO[LIBJ_TENSOR_MAX_DIM], HI[LIBJ_TENSOR_MAX_DIM], I[LIBJ_TENSOR_MAX_DIM];
+  size_t NTILE = 1;
+  for (size_t d=0;d<M_NDIM;d++)
+  {
+    NT[d] = (M_LENGTHS[d] + M_TILE[d] - 1)/M_TILE[d];
+    TI[d] = 0;
+    NTILE *= NT[d];
+  }
+  const size_t* OFF0 = M_OFF[0].data();
+
+  for (size_t t=0;t<NTILE;t++)
+  {
+    for (size_t d=0;d<M_NDIM;d++)
+    {
+      LO[d] = TI[d]*M_TILE[d];
+      HI[d] = std::min(LO[d] + M_TILE[d],M_LENGTHS[d]);
+      I[d]  = LO[d];
+    }
+
+    //lines of the first dimension in this tile
+    bool more = true;
+    while (more)
+    {
+      size_t toff = 0, soff = 0;
+      for (size_t d=1;d<M_NDIM;d++) {toff += M_OFF[d][I[d]]; soff += S[d]*I[d];}
+      for (size_t i=LO[0];i<HI[0];i++) {I[0] = i; f(toff + OFF0[i],soff + i*S[0],I);}
+      more = false;
+      for (size_t d=1;d<M_NDIM;d++)
+      {
+        if (++I[d] < HI[d]) {more = true; break;}
+        I[d] = LO[d];
+      }
+    }
+
+    //next tile
+    for (size_t d=0;d<M_NDIM;d++)
+    {
+      if (++TI[d] < NT[d]) break;
+      TI[d] = 0;
+    }
+  }
+}
+
+//-----------------------------------------------------------------------
+// f(x,idx) for every element, in tile order
+//-----------------------------------------------------------------------
+template <typename T> template <class F>
+void tensor_tiled<T>::for_each(F f)
+{
+  struct visit
+  {
+    T* B; F& f;
+    visit(T* b, F& g) : B(b), f(g) {}
+    void operator() (const size_t toff, const size_t soff, const size_t* idx) {f(B[toff],idx);}
+  } v(M_BUFFER,f);
+  size_t S[LIBJ_TENSOR_MAX_DIM] = {0};
+  m_walk(S,v);
+}
+
+//-----------------------------------------------------------------------
+// copy a column major tensor in and out, tile by tile
+//-----------------------------------------------------------------------
+template <typename T>
+void tensor_tiled<T>::from_tensor(const libj::tensor<T>& A)
+{
+  if (A.dim() != M_NDIM)
+  {
+    printf("ERROR libj::tensor_tiled::from_tensor\n");
+    printf("tensor has %zu dimensions, not %zu\n",A.dim(),M_NDIM);
+    exit(1);
+  }
+  size_t S[LIBJ_TENSOR_MAX_DIM];
+  for (size_t d=0;d<M_NDIM;d++)
+  {
+    if (A.size(d) != M_LENGTHS[d])
+    {
+      printf("ERROR libj::tensor_tiled::from_tensor\n");
+      printf("dimension %zu has length %zu, not %zu\n",d,A.size(d),M_LENGTHS[d]);
+      exit(1);
+    }
+    S[d] = A.stride(d);
+  }
+  struct copy_in
+  {
+    T* B; const T* P;
+    void operator() (const size_t toff, const size_t soff, const size_t* idx) {B[toff] = P[soff];}
+  } c = {M_BUFFER,A.data()};
+  m_walk(S,c);
+}
+
+template <typename T>
+void tensor_tiled<T>::to_tensor(libj::tensor<T>& A) const
+{
+  if (A.dim() != M_NDIM)
+  {
+    printf("ERROR libj::tensor_tiled::to_tensor\n");
+    printf("tensor has %zu dimensions, not %zu\n",A.dim(),M_NDIM);
+    exit(1);
+  }
+  size_t S[LIBJ_TENSOR_MAX_DIM];
+  for (size_t d=0;d<M_NDIM;d++)
+  {
+    if (A.size(d) != M_LENGTHS[d])
+    {
+      printf("ERROR libj::tensor_tiled::to_tensor\n");
+      printf("dimension %zu has length %zu, not %zu\n",d,A.size(d),M_LENGTHS[d]);
+      exit(1);
+    }
+    S[d] = A.stride(d);
+  }
+  struct copy_out
+  {
+    const T* B; T* P;
+    void operator() (const size_t toff, const size_t soff, const size_t* idx) {P[soff] = B[toff];}
+  } c = {M_BUFFER,A.data()};
+  m_walk(S,c);
+}
+
+}//end of namespace
+
+#endif
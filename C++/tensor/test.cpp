@@ -6,8 +6,8 @@
 int main()
 {
   libj::tensor<double> A(2,2,2);
-  libj::tensor_matrix<double> M(A,"acb","");
-  libj::block_scatter_matrix<double> X;
+  libj::tensor_matrix<double,3,0> M(A,"acb","");
+  libj::block_scatter_matrix<double,8,1,2,1> X;
 
   size_t idx = 0;
   for (size_t k=0;k<A.size(2);k++)
@@ -25,7 +25,7 @@ int main()
  
   printf("sizes of M...%zu %zu\n",M.size(0),M.size(1));
   
-  X.assign_to_block(M,0,0,M.size(0),M.size(1),2,1);
+  X.assign_to_block(M,0,0);
   for (size_t J=0;J<X.size(1);J++)
   {
     for (size_t I=0;I<X.size(0);I++)
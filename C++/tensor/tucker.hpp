@@ -0,0 +1,148 @@
+/*----------------------------------------------------------------------------
+  tucker.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for the tucker class, which stores a tensor in the Tucker
+  format, as a small core tensor G and one factor matrix U_d per
+  dimension
+
+    A(i,j,k,l) ~ sum_pqrs G(p,q,r,s) U_0(i,p) U_1(j,q) U_2(k,r) U_3(l,s)
+
+  where U_d is n_d x r_d with orthonormal columns, and r_d is the rank of
+  dimension d. The core and the factors are libj::tensors assigned into
+  one aligned arena, so a tensor of ranks r << n takes r^4 + 4nr elements
+  in place of n^4.
+
+  A tucker is made from a dense tensor with libj::tucker_compress,
+  expanded with libj::tucker_expand, and contracted in the compressed form
+  with libj::tucker_contract, all in jblis_level3
+
+  Initialization
+  -------------------
+    libj::tucker<double> T;                       //empty
+    libj::tucker<double> T({40,40,40,40},{8,8,8,8}); //lengths and ranks
+    T.allocate(lengths,ranks);                    //(re)allocate
+
+  Access
+  -------------------
+    T.dim();			//number of dimensions
+    T.size(d);			//length of dimension d, n_d
+    T.rank(d);			//rank of dimension d, r_d
+    T.size();			//number of stored elements, with padding
+    T.elements();		//number of elements of the full tensor
+    T.core();			//libj::tensor of the core, r_0 x r_1 x ...
+    T.factor(d);		//libj::tensor of U_d, n_d x r_d
+----------------------------------------------------------------------------*/
+#ifndef TUCKER_HPP
+#define TUCKER_HPP
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <vector>
+#include "libjdef.h"
+#include "tensor.hpp"
+
+namespace libj
+{
+
+template <typename T>
+class tucker
+{
+  private:
+  size_t                        M_NDIM;    //number of dimensions
+  size_t                        M_NELM;    //number of stored elements
+  std::vector<size_t>           M_LENGTHS; //length of each dimension
+  std::vector<size_t>           M_RANKS;   //rank of each dimension
+  libj::tensor<T>               M_ARENA;   //memory of the core and factors
+  libj::tensor<T>               M_CORE;    //core tensor
+  std::vector<libj::tensor<T> > M_FACTORS; //factor matrices
+
+  public:
+  tucker() : M_NDIM(0), M_NELM(0) {}
+  tucker(const std::vector<size_t>& lengths, const std::vector<size_t>& ranks) : tucker()
+  {
+    allocate(lengths,ranks);
+  }
+  void allocate(const std::vector<size_t>& lengths, const std::vector<size_t>& ranks);
+
+  //the views all share the arena
+  tucker(const tucker<T>& other) = delete;
+  tucker<T>& operator= (const tucker<T>& other) = delete;
+
+  //getters
+  size_t dim() const {return M_NDIM;}
+  size_t size() const {return M_NELM;}
+  size_t size(const size_t d) const {return M_LENGTHS[d];}
+  size_t rank(const size_t d) const {return M_RANKS[d];}
+  const std::vector<size_t>& lengths() const {return M_LENGTHS;}
+  const std::vector<size_t>& ranks() const {return M_RANKS;}
+  size_t elements() const
+  {
+    size_t n = (M_NDIM > 0) ? 1 : 0;
+    for (size_t d=0;d<M_NDIM;d++) n *= M_LENGTHS[d];
+    return n;
+  }
+
+  libj::tensor<T>& core() {return M_CORE;}
+  const libj::tensor<T>& core() const {return M_CORE;}
+  libj::tensor<T>& factor(const size_t d) {return M_FACTORS[d];}
+  const libj::tensor<T>& factor(const size_t d) const {return M_FACTORS[d];}
+
+}; //end of class
+
+//-----------------------------------------------------------------------
+// allocate
+//	the core and then each factor, each starting on a LIBJ_MAX_ALIGN
+//	byte boundary. An allocated tucker is freed first
+//-----------------------------------------------------------------------
+template <typename T>
+void tucker<T>::allocate(const std::vector<size_t>& lengths, const std::vector<size_t>& ranks)
+{
+  if (lengths.size() < 1 || lengths.size() != ranks.size())
+  {
+    printf("ERROR libj::tucker::allocate \n");
+    printf("bad input : %zu lengths, %zu ranks \n",lengths.size(),ranks.size());
+    exit(1);
+  }
+  for (size_t d=0;d<lengths.size();d++)
+  {
+    if (ranks[d] < 1 || ranks[d] > lengths[d])
+    {
+      printf("ERROR libj::tucker::allocate \n");
+      printf("dimension %zu has length %zu and rank %zu \n",d,lengths[d],ranks[d]);
+      exit(1);
+    }
+  }
+
+  if (M_CORE.is_assigned()) M_CORE.unassign();
+  M_FACTORS.clear();
+  if (M_ARENA.is_allocated()) M_ARENA.deallocate();
+
+  M_NDIM    = lengths.size();
+  M_LENGTHS = lengths;
+  M_RANKS   = ranks;
+
+  const size_t PAD = (LIBJ_MAX_ALIGN >= sizeof(T)) ? LIBJ_MAX_ALIGN/sizeof(T) : 1;
+  std::vector<size_t> START(M_NDIM+1);
+  size_t nelm = 1;
+  for (size_t d=0;d<M_NDIM;d++) nelm *= M_RANKS[d];
+  START[0] = 0;
+  M_NELM = ((nelm + PAD - 1)/PAD)*PAD;
+  for (size_t d=0;d<M_NDIM;d++)
+  {
+    START[d+1] = M_NELM;
+    M_NELM += ((M_LENGTHS[d]*M_RANKS[d] + PAD - 1)/PAD)*PAD;
+  }
+
+  M_ARENA.aligned_allocate(LIBJ_MAX_ALIGN,M_NELM);
+  M_CORE.assign(M_ARENA.data(),M_RANKS);
+  M_FACTORS.resize(M_NDIM);
+  for (size_t d=0;d<M_NDIM;d++)
+  {
+    M_FACTORS[d].assign(M_ARENA.data()+START[d+1],std::vector<size_t>{M_LENGTHS[d],M_RANKS[d]});
+  }
+}
+
+}//end of namespace
+
+#endif
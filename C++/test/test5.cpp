@@ -0,0 +1,39 @@
+#include "tensor.hpp"
+#include "jblis.hpp"
+#include <stdio.h>
+#include <math.h>
+
+//partial traces whose summed labels have length 1
+int main()
+{
+  int nbad = 0;
+
+  //B(a,b) = sum_i A(i,i,a,b), with i of length 1
+  libj::tensor<double> A(1,1,2,3), B(2,3);
+  for (size_t i=0;i<A.size();i++) A[i] = (double) (i+1);
+  libj::trace<double>(A,"iiab",B,"ab");
+  for (size_t b=0;b<3;b++)
+  {
+    for (size_t a=0;a<2;a++)
+    {
+      if (B(a,b) != A(0,0,a,b)) {printf("iiab -> ab : B(%zu,%zu) is wrong\n",a,b); nbad++;}
+    }
+  }
+
+  //B(b,a) = sum_ij A(i,a,j,b,j), with i of length 1
+  libj::tensor<double> C(1,4,3,5,3), E(5,4);
+  for (size_t i=0;i<C.size();i++) C[i] = (double) (i%7) - 3.0;
+  libj::trace<double>(C,"iajbj",E,"ba",2.0,0.0);
+  for (size_t a=0;a<4;a++)
+  {
+    for (size_t b=0;b<5;b++)
+    {
+      double ref = 0;
+      for (size_t j=0;j<3;j++) ref += 2.0*C(0,a,j,b,j);
+      if (fabs(E(b,a) - ref) > 1.0E-12) {printf("iajbj -> ba : E(%zu,%zu) is wrong\n",b,a); nbad++;}
+    }
+  }
+
+  if (nbad == 0) printf("trace passed\n");
+  return nbad;
+}
@@ -0,0 +1,44 @@
+#include "simd.hpp"
+#include <stdio.h>
+#include <math.h>
+#include <vector>
+
+//iamax and iamin with a NaN at the start, in the middle, and in the tail
+template <typename T>
+int check(const long N, const long P, const char* NAME)
+{
+  std::vector<T> X(N);
+  for (long i=0;i<N;i++) X[i] = (T) ((i%5) - 2)*(T) (i+1);
+  X[(N-1)/2] = (T) (10*N);
+  X[P] = (T) NAN;
+  int nbad = 0;
+  const long lmax = simd_iamax<T>(N,&X[0]);
+  const long lmin = simd_iamin<T>(N,&X[0]);
+  if (lmax != P) {printf("%s iamax, N = %ld, NaN at %ld, got %ld\n",NAME,N,P,lmax); nbad++;}
+  if (lmin != P) {printf("%s iamin, N = %ld, NaN at %ld, got %ld\n",NAME,N,P,lmin); nbad++;}
+  return nbad;
+}
+
+int main()
+{
+  int nbad = 0;
+  const long NS[3] = {1,13,1001};
+  for (int n=0;n<3;n++)
+  {
+    const long N = NS[n];
+    nbad += check<double>(N,0,"double");
+    nbad += check<double>(N,N/2,"double");
+    nbad += check<double>(N,N-1,"double");
+    nbad += check<float>(N,0,"float");
+    nbad += check<float>(N,N/2,"float");
+    nbad += check<float>(N,N-1,"float");
+  }
+
+  //without a NaN, the first of the largest and smallest
+  double Y[6] = {1.0,-3.0,0.5,3.0,-0.5,2.0};
+  if (simd_iamax<double>(6,Y) != 1) {printf("double iamax without NaN\n"); nbad++;}
+  if (simd_iamin<double>(6,Y) != 2) {printf("double iamin without NaN\n"); nbad++;}
+
+  if (nbad == 0) printf("iamax passed\n");
+  return nbad;
+}
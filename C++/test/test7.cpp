@@ -0,0 +1,49 @@
+#include "linal_fixed.hpp"
+#include <stdio.h>
+#include <math.h>
+
+//linal_MTM_UP_fixed against loops, for M == N, M > N and M < N
+template <int M, int N, int K>
+int check()
+{
+  double A[K*M], B[K*N], C[M*N], R[M*N];
+  for (int i=0;i<K*M;i++) A[i] = 0.25*(i%7) - 0.5;
+  for (int i=0;i<K*N;i++) B[i] = 0.5*(i%5) - 1.0;
+  for (int i=0;i<M*N;i++) {C[i] = 1.0 + i; R[i] = 1.0 + i;}
+
+  //column j holds rows 0..min(j,M-1)
+  int nc = 0;
+  for (int j=0;j<N;j++)
+  {
+    for (int i=0;i<=j && i<M;i++)
+    {
+      double t = 0;
+      for (int k=0;k<K;k++) t += A[k+K*i]*B[k+K*j];
+      R[nc] = 2.0*t + 0.5*R[nc];
+      nc++;
+    }
+  }
+  linal_MTM_UP_fixed<M,N,K>(2.0,A,B,0.5,C);
+
+  int nbad = 0;
+  for (int i=0;i<M*N;i++)
+  {
+    if (fabs(C[i]-R[i]) > 1.0E-12) nbad++;
+  }
+  const int ne = (N <= M) ? N*(N+1)/2 : M*(M+1)/2 + M*(N-M);
+  if (nc != ne) nbad++;
+  if (nbad != 0) printf("MTM_UP_fixed<%d,%d,%d> failed\n",M,N,K);
+  return nbad;
+}
+
+int main()
+{
+  int nbad = 0;
+  nbad += check<4,4,3>();
+  nbad += check<6,3,5>();
+  nbad += check<3,6,5>();
+  nbad += check<1,8,2>();
+  nbad += check<8,1,8>();
+  if (nbad == 0) printf("MTM_UP_fixed passed\n");
+  return nbad;
+}
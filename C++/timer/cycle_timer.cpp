@@ -0,0 +1,60 @@
+/*--------------------------------------------------------------------------
+  cycle_timer.cpp
+	JHT, October 14, 2026 : created
+
+  .cpp file for libj::CycleTimer, see cycle_timer.hpp
+--------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <chrono>
+#include "cycle_timer.hpp"
+
+#if defined (LIBJ_HAVE_RDTSCP)
+  #include <cpuid.h>
+#endif
+
+#define CYCLE_TIMER_CALIBRATE_S 0.02
+#define CYCLE_TIMER_SAMPLES 3
+
+namespace libj
+{
+
+//--------------------------------------------------------------------------
+// calibrate
+//	ticks over a spin of the steady clock, the median of the samples
+//--------------------------------------------------------------------------
+double CycleTimer::calibrate()
+{
+  #if defined (LIBJ_HAVE_RDTSCP)
+  unsigned int eax, ebx, ecx, edx;
+  if (__get_cpuid(0x80000007,&eax,&ebx,&ecx,&edx) && !(edx & (1u << 8)))
+  {
+    printf("WARNING libj::CycleTimer the TSC is not invariant, times may be off\n");
+  }
+
+  typedef std::chrono::steady_clock clock;
+  double freq[CYCLE_TIMER_SAMPLES];
+  for (int s=0;s<CYCLE_TIMER_SAMPLES;s++)
+  {
+    const clock::time_point beg = clock::now();
+    const unsigned long long c0 = cycle_now();
+    double sec = 0.0;
+    while (sec < CYCLE_TIMER_CALIBRATE_S/CYCLE_TIMER_SAMPLES)
+    {
+      sec = std::chrono::duration<double>(clock::now() - beg).count();
+    }
+    freq[s] = (double) (cycle_now() - c0)/sec;
+  }
+  for (int i=1;i<CYCLE_TIMER_SAMPLES;i++)
+  {
+    for (int j=i;j>0 && freq[j] < freq[j-1];j--)
+    {
+      const double tmp = freq[j]; freq[j] = freq[j-1]; freq[j-1] = tmp;
+    }
+  }
+  return freq[CYCLE_TIMER_SAMPLES/2];
+  #else
+  return 1.0e9;
+  #endif
+}
+
+}//end libj namespace
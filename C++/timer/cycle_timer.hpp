@@ -0,0 +1,138 @@
+/*--------------------------------------------------------------------------
+  cycle_timer.hpp
+	JHT, October 14, 2026 : created
+
+  .hpp file for libj::CycleTimer, a timer on the time stamp counter (TSC)
+  for timing inner loops and microkernels, and libj::TimerStats, running
+  count, min, max and mean of a set of times.
+
+  A CycleTimer read is one rdtscp, around 10 ns on bare metal (more under
+  some hypervisors), with no call into libstdc++ or the vdso as Timer
+  (timer.hpp) has. The TSC frequency is calibrated once
+  against the steady clock (about 20 ms, on the first call of hz()), so
+  CycleTimer::elapsed is in seconds. This needs an invariant TSC (constant
+  rate, in step over the cores), which all x86 of the last decade have;
+  hz() warns once if cpuid says otherwise. Off x86, the steady clock is
+  read instead, in ns.
+
+  TimerStats is a plain struct, so one can be kept per thread with no
+  atomics, and merged after. They are aligned to a cache line, so an
+  array of them, one per thread, does not false share.
+
+  Usage
+  -------------------
+  libj::CycleTimer t;
+  libj::TimerStats stats[NTHREADS];	//or thread_local
+  for (...)
+  {
+    t.reset();
+    kernel();
+    stats[tid].add(t.elapsed());		//or t.lap(), which also resets
+  }
+  libj::TimerStats all;
+  for (int i=0;i<NTHREADS;i++) all.merge(stats[i]);
+  all.count; all.min; all.max; all.mean(); all.sum;
+
+  t.cycles();			//TSC ticks since the reset
+  libj::CycleTimer::hz();	//ticks per second
+--------------------------------------------------------------------------*/
+#ifndef LIBJ_CYCLE_TIMER_HPP
+#define LIBJ_CYCLE_TIMER_HPP
+
+#include <chrono>
+
+#if (defined (__x86_64__) || defined (__i386__)) && defined (__GNUC__)
+  #include <x86intrin.h>
+  #define LIBJ_HAVE_RDTSCP 1
+#endif
+
+namespace libj
+{
+
+//ticks of the TSC, or ns of the steady clock off x86
+inline unsigned long long cycle_now()
+{
+  #if defined (LIBJ_HAVE_RDTSCP)
+  unsigned int aux;
+  return __rdtscp(&aux);
+  #else
+  return (unsigned long long) std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+  #endif
+}
+
+//--------------------------------------------------------------------------
+// CycleTimer
+//--------------------------------------------------------------------------
+class CycleTimer
+{
+  private:
+  unsigned long long m_beg;
+
+  public:
+  CycleTimer() : m_beg(cycle_now()) {}
+
+  void reset() {m_beg = cycle_now();}
+
+  //ticks since the reset
+  unsigned long long cycles() const {return cycle_now() - m_beg;}
+
+  //seconds since the reset
+  double elapsed() const {return (double) cycles()/hz();}
+
+  //seconds since the reset, and reset
+  double lap()
+  {
+    const unsigned long long now = cycle_now();
+    const double sec = (double) (now - m_beg)/hz();
+    m_beg = now;
+    return sec;
+  }
+
+  //ticks per second, calibrated on the first call
+  static double hz()
+  {
+    static const double freq = calibrate();
+    return freq;
+  }
+
+  //measure the ticks per second
+  static double calibrate();
+};
+
+//--------------------------------------------------------------------------
+// TimerStats
+//--------------------------------------------------------------------------
+struct alignas(64) TimerStats
+{
+  long   count;
+  double sum;
+  double min;
+  double max;
+
+  TimerStats() : count(0), sum(0.0), min(0.0), max(0.0) {}
+
+  void add(const double t)
+  {
+    if (count == 0 || t < min) min = t;
+    if (count == 0 || t > max) max = t;
+    sum += t;
+    count++;
+  }
+
+  void merge(const TimerStats& other)
+  {
+    if (other.count == 0) return;
+    if (count == 0 || other.min < min) min = other.min;
+    if (count == 0 || other.max > max) max = other.max;
+    sum += other.sum;
+    count += other.count;
+  }
+
+  double mean() const {return (count > 0) ? sum/count : 0.0;}
+
+  void reset() {*this = TimerStats();}
+};
+
+}//end libj namespace
+#endif
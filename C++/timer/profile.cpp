@@ -0,0 +1,437 @@
+/*--------------------------------------------------------------------------
+  profile.cpp
+	JHT, October 14, 2026 : created
+	JHT, October 14, 2026 : added the hardware counters
+	JHT, October 14, 2026 : added profile_add
+
+  .cpp file for the libj profiler, see profile.hpp
+--------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "profile.hpp"
+
+#if defined (_OPENMP)
+  #include <omp.h>
+#endif
+
+#if defined (LIBJ_PROFILE_COUNTERS) && defined (__linux__)
+  #define LIBJ_PROFILE_PERF
+  #include <stdlib.h>
+  #include <unistd.h>
+  #include <atomic>
+  #include <sys/ioctl.h>
+  #include <sys/syscall.h>
+  #include <linux/perf_event.h>
+#endif
+
+namespace libj
+{
+
+//--------------------------------------------------------------------------
+// the tables of all threads. They are never freed, so the regions of
+// threads that have exited are still merged
+//--------------------------------------------------------------------------
+static std::mutex& profile_mutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+static std::vector<profile_table*>& profile_tables()
+{
+  static std::vector<profile_table*> tables;
+  return tables;
+}
+
+//--------------------------------------------------------------------------
+// the names of the regions open on the serial thread (the first with a
+// table), from the top. It only changes outside of parallel regions, so
+// the threads of a parallel region can all read it
+//--------------------------------------------------------------------------
+#if defined (_OPENMP)
+static std::vector<const char*> profile_serial_path;
+#endif
+static profile_table* profile_serial = NULL;
+
+//--------------------------------------------------------------------------
+// local
+//--------------------------------------------------------------------------
+profile_table& profile_table::local()
+{
+  static thread_local profile_table* table = NULL;
+  if (table == NULL)
+  {
+    table = new profile_table();
+    std::lock_guard<std::mutex> lock(profile_mutex());
+    if (profile_serial == NULL) {profile_serial = table;}
+    profile_tables().push_back(table);
+  }
+  return *table;
+}
+
+//--------------------------------------------------------------------------
+// child
+//	returns the child name of the open region, which is added if new.
+//	names are compared by pointer first, as they are usually the same
+//	literal
+//--------------------------------------------------------------------------
+static int profile_child(profile_table& table, const char* name)
+{
+  std::vector<profile_node>& nodes = table.nodes;
+  const int open = table.open;
+  int prev = -1;
+  int node = (open < 0) ? table.top : nodes[open].child;
+  while (node >= 0)
+  {
+    if (nodes[node].name == name || strcmp(nodes[node].name,name) == 0) break;
+    prev = node;
+    node = nodes[node].sibling;
+  }
+  if (node < 0)
+  {
+    const profile_node add = {name,open,-1,-1,0,0,0,0.0,{0}};
+    nodes.push_back(add);
+    node = (int) nodes.size() - 1;
+    if (prev >= 0) {nodes[prev].sibling = node;}
+    else if (open < 0) {table.top = node;}
+    else {nodes[open].child = node;}
+  }
+  return node;
+}
+
+//--------------------------------------------------------------------------
+// enter
+//	a thread at the top of its table inside a parallel region first
+//	walks down the path of the serial thread, so its regions go under
+//	the one the parallel region is in
+//--------------------------------------------------------------------------
+int profile_table::enter(const char* name)
+{
+  #if defined (_OPENMP)
+  if (omp_in_parallel())
+  {
+    if (open < 0 && !profile_serial_path.empty())
+    {
+      for (size_t i=0;i<profile_serial_path.size();i++)
+      {
+        open = profile_child(*this,profile_serial_path[i]);
+      }
+      base = open;
+    }
+  }
+  else if (this == profile_serial)
+  {
+    profile_serial_path.push_back(name);
+  }
+  #endif
+  open = profile_child(*this,name);
+  return open;
+}
+
+//--------------------------------------------------------------------------
+// leave
+//--------------------------------------------------------------------------
+void profile_table::leave(const int node, const long long ns, const long long* counts)
+{
+  profile_node& N = nodes[node];
+  N.calls++;
+  N.incl_ns += ns;
+  if (counts != NULL)
+  {
+    for (int c=0;c<PROFILE_NCOUNT;c++) {N.counts[c] += counts[c];}
+  }
+  #if defined (_OPENMP)
+  if (this == profile_serial && !omp_in_parallel() && !profile_serial_path.empty())
+  {
+    profile_serial_path.pop_back();
+  }
+  #endif
+  if (N.parent >= 0 && N.parent == base)
+  {
+    open = -1;
+    base = -1;
+    return;
+  }
+  if (N.parent >= 0) {nodes[N.parent].child_ns += ns;}
+  open = N.parent;
+}
+
+#if defined (LIBJ_PROFILE_PERF)
+//--------------------------------------------------------------------------
+// profile_perf_open
+//	one counter of this thread, in the group of leader (-1 for a new
+//	group, which starts disabled)
+//--------------------------------------------------------------------------
+static int profile_perf_open(const unsigned type, const unsigned long long config, const int leader)
+{
+  struct perf_event_attr attr;
+  memset(&attr,0,sizeof(attr));
+  attr.size           = sizeof(attr);
+  attr.type           = type;
+  attr.config         = config;
+  attr.disabled       = (leader < 0) ? 1 : 0;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv     = 1;
+  attr.read_format    = PERF_FORMAT_GROUP;
+  return (int) syscall(__NR_perf_event_open,&attr,0,-1,leader,0);
+}
+
+//--------------------------------------------------------------------------
+// profile_perf_group
+//	cycles, instructions, LLC misses, and the FP event if asked for. 
+//	Returns the leader, or -1 if the first three can not be opened
+//--------------------------------------------------------------------------
+static int profile_perf_group()
+{
+  static std::atomic<int> warned(0);
+  const int leader = profile_perf_open(PERF_TYPE_HARDWARE,PERF_COUNT_HW_CPU_CYCLES,-1);
+  int ins = -1, llc = -1;
+  if (leader >= 0)
+  {
+    ins = profile_perf_open(PERF_TYPE_HARDWARE,PERF_COUNT_HW_INSTRUCTIONS,leader);
+    llc = profile_perf_open(PERF_TYPE_HARDWARE,PERF_COUNT_HW_CACHE_MISSES,leader);
+  }
+  if (leader < 0 || ins < 0 || llc < 0)
+  {
+    if (leader >= 0) {close(leader);}
+    if (ins >= 0) {close(ins);}
+    if (llc >= 0) {close(llc);}
+    if (warned.exchange(1) == 0)
+    {
+      printf("WARNING libj::profile could not open the hardware counters, check perf_event_paranoid\n");
+    }
+    return -1;
+  }
+  const char* fp = getenv("LIBJ_PROFILE_FP_EVENT");
+  if (fp != NULL && profile_perf_open(PERF_TYPE_RAW,strtoull(fp,NULL,0),leader) < 0)
+  {
+    if (warned.exchange(1) == 0)
+    {
+      printf("WARNING libj::profile could not open LIBJ_PROFILE_FP_EVENT=%s\n",fp);
+    }
+  }
+  ioctl(leader,PERF_EVENT_IOC_RESET,PERF_IOC_FLAG_GROUP);
+  ioctl(leader,PERF_EVENT_IOC_ENABLE,PERF_IOC_FLAG_GROUP);
+  return leader;
+}
+#endif
+
+//--------------------------------------------------------------------------
+// read_counters
+//	the group is opened on first use, as it counts the calling thread
+//--------------------------------------------------------------------------
+void profile_table::read_counters(long long* counts)
+{
+  for (int c=0;c<PROFILE_NCOUNT;c++) {counts[c] = 0;}
+  #if defined (LIBJ_PROFILE_PERF)
+  if (perf_fd == -2) {perf_fd = profile_perf_group();}
+  if (perf_fd < 0) return;
+  unsigned long long buf[1+PROFILE_NCOUNT];
+  if (read(perf_fd,buf,sizeof(buf)) < (ssize_t) sizeof(buf[0])) return;
+  const int num = (buf[0] < PROFILE_NCOUNT) ? (int) buf[0] : PROFILE_NCOUNT;
+  for (int c=0;c<num;c++) {counts[c] = (long long) buf[1+c];}
+  #endif
+}
+
+//--------------------------------------------------------------------------
+// profile_bytes
+//--------------------------------------------------------------------------
+void profile_bytes(const double bytes)
+{
+  profile_table& table = profile_table::local();
+  if (table.open >= 0) {table.nodes[table.open].bytes += bytes;}
+}
+
+//--------------------------------------------------------------------------
+// profile_add
+//	the open region is kept, the group and name are found from the top
+//--------------------------------------------------------------------------
+void profile_add(const char* group, const char* name, const long calls,
+                 const long long ns, const double bytes)
+{
+  profile_table& table = profile_table::local();
+  const int open = table.open;
+  table.open = -1;
+  const int g = profile_child(table,group);
+  table.open = g;
+  const int node = profile_child(table,name);
+  table.open = open;
+
+  profile_node& G = table.nodes[g];
+  G.calls += calls;
+  G.incl_ns += ns;
+  G.child_ns += ns;
+  profile_node& N = table.nodes[node];
+  N.calls += calls;
+  N.incl_ns += ns;
+  N.bytes += bytes;
+}
+
+//--------------------------------------------------------------------------
+// profile_walk
+//	add node, its siblings, and their children to merged
+//--------------------------------------------------------------------------
+static void profile_walk(const profile_table& table, int node, const std::string& prefix,
+                         std::map<std::string,profile_entry>& merged)
+{
+  for (;node >= 0;node = table.nodes[node].sibling)
+  {
+    const profile_node& N = table.nodes[node];
+    const std::string path = prefix.empty() ? std::string(N.name) : prefix + "/" + N.name;
+    const double incl = 1.0e-9*N.incl_ns;
+    const double excl = 1.0e-9*(N.incl_ns - N.child_ns);
+    std::map<std::string,profile_entry>::iterator it = merged.find(path);
+    if (it == merged.end())
+    {
+      profile_entry add = {path,(double) N.calls,incl,excl,N.bytes,{0}};
+      for (int c=0;c<PROFILE_NCOUNT;c++) {add.counts[c] = (double) N.counts[c];}
+      merged[path] = add;
+    }
+    else
+    {
+      profile_entry& E = it->second;
+      E.calls += N.calls;
+      E.bytes += N.bytes;
+      E.incl = std::max(E.incl,incl);
+      E.excl = std::max(E.excl,excl);
+      for (int c=0;c<PROFILE_NCOUNT;c++) {E.counts[c] += (double) N.counts[c];}
+    }
+    profile_walk(table,N.child,path,merged);
+  }
+}
+
+//--------------------------------------------------------------------------
+// profile_merge
+//--------------------------------------------------------------------------
+std::vector<profile_entry> profile_merge()
+{
+  std::map<std::string,profile_entry> merged;
+  {
+    std::lock_guard<std::mutex> lock(profile_mutex());
+    const std::vector<profile_table*>& tables = profile_tables();
+    for (size_t t=0;t<tables.size();t++) {profile_walk(*tables[t],tables[t]->top,"",merged);}
+  }
+  std::vector<profile_entry> entries;
+  entries.reserve(merged.size());
+  for (std::map<std::string,profile_entry>::const_iterator it = merged.begin();
+       it != merged.end();it++)
+  {
+    entries.push_back(it->second);
+  }
+  std::sort(entries.begin(),entries.end(),
+            [](const profile_entry& a, const profile_entry& b) {return profile_path_less(a.path,b.path);});
+  return entries;
+}
+
+//--------------------------------------------------------------------------
+// profile_reset
+//--------------------------------------------------------------------------
+void profile_reset()
+{
+  std::lock_guard<std::mutex> lock(profile_mutex());
+  std::vector<profile_table*>& tables = profile_tables();
+  for (size_t t=0;t<tables.size();t++)
+  {
+    tables[t]->nodes.clear();
+    tables[t]->open = -1;
+    tables[t]->top = -1;
+    tables[t]->base = -1;
+  }
+  #if defined (_OPENMP)
+  profile_serial_path.clear();
+  #endif
+}
+
+//--------------------------------------------------------------------------
+// profile_path_less
+//	'/' sorts before any other character, so children follow their
+//	parent directly
+//--------------------------------------------------------------------------
+bool profile_path_less(const std::string& a, const std::string& b)
+{
+  const size_t n = std::min(a.size(),b.size());
+  for (size_t i=0;i<n;i++)
+  {
+    const int ca = (a[i] == '/') ? 0 : (unsigned char) a[i] + 1;
+    const int cb = (b[i] == '/') ? 0 : (unsigned char) b[i] + 1;
+    if (ca != cb) return ca < cb;
+  }
+  return a.size() < b.size();
+}
+
+//--------------------------------------------------------------------------
+// profile_has_counters
+//--------------------------------------------------------------------------
+bool profile_has_counters(const std::vector<profile_entry>& entries)
+{
+  for (size_t i=0;i<entries.size();i++)
+  {
+    if (entries[i].counts[PROFILE_CYCLES] > 0.0) return true;
+  }
+  return false;
+}
+
+//--------------------------------------------------------------------------
+// profile_print
+//--------------------------------------------------------------------------
+void profile_print(FILE* fp)
+{
+  const std::vector<profile_entry> entries = profile_merge();
+  profile_print(fp,1,entries,entries,entries);
+}
+
+//--------------------------------------------------------------------------
+// profile_name
+//	the last name of path, indented by its depth
+//--------------------------------------------------------------------------
+static std::string profile_name(const std::string& path)
+{
+  const size_t depth = std::count(path.begin(),path.end(),'/');
+  const size_t last = path.rfind('/');
+  return std::string(2*depth,' ') + ((last == std::string::npos) ? path : path.substr(last+1));
+}
+
+//--------------------------------------------------------------------------
+// profile_print
+//	regions are indented by depth, GB/s is the avg bytes over the avg
+//	inclusive time. The counters are the avg over tasks, and the rates
+//	are over the avg inclusive time
+//--------------------------------------------------------------------------
+void profile_print(FILE* fp, const int ntasks, const std::vector<profile_entry>& min,
+                   const std::vector<profile_entry>& avg, const std::vector<profile_entry>& max)
+{
+  fprintf(fp,"\nlibj::profile : %d task(s), seconds as min/avg/max over tasks\n",ntasks);
+  fprintf(fp,"%-40s %12s %11s %11s %11s %11s %9s\n","region","calls",
+          "incl min","incl avg","incl max","excl avg","GB/s");
+  for (size_t i=0;i<avg.size();i++)
+  {
+    const std::string name = profile_name(avg[i].path);
+    const double gbs = (avg[i].incl > 0.0) ? 1.0e-9*avg[i].bytes/avg[i].incl : 0.0;
+    fprintf(fp,"%-40s %12.6g %11.4e %11.4e %11.4e %11.4e %9.3f\n",name.c_str(),
+            avg[i].calls,min[i].incl,avg[i].incl,max[i].incl,avg[i].excl,gbs);
+  }
+
+  if (!profile_has_counters(avg)) return;
+  fprintf(fp,"\nlibj::profile : hardware counters, avg over tasks\n");
+  fprintf(fp,"%-40s %12s %12s %7s %11s %11s %11s\n","region","cycles","instructions",
+          "IPC","LLC/kinst","LLC GB/s","FP Gop/s");
+  for (size_t i=0;i<avg.size();i++)
+  {
+    const double* C = avg[i].counts;
+    const double t = avg[i].incl;
+    const double ipc = (C[PROFILE_CYCLES] > 0.0) ? C[PROFILE_INSTRUCTIONS]/C[PROFILE_CYCLES] : 0.0;
+    const double mpk = (C[PROFILE_INSTRUCTIONS] > 0.0) ?
+                       1.0e3*C[PROFILE_LLC_MISSES]/C[PROFILE_INSTRUCTIONS] : 0.0;
+    const double llc = (t > 0.0) ? 64.0e-9*C[PROFILE_LLC_MISSES]/t : 0.0;
+    const double fop = (t > 0.0) ? 1.0e-9*C[PROFILE_FP_OPS]/t : 0.0;
+    fprintf(fp,"%-40s %12.4e %12.4e %7.3f %11.4f %11.3f %11.3f\n",profile_name(avg[i].path).c_str(),
+            C[PROFILE_CYCLES],C[PROFILE_INSTRUCTIONS],ipc,mpk,llc,fop);
+  }
+}
+
+}//end libj namespace
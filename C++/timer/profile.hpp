@@ -0,0 +1,222 @@
+/*--------------------------------------------------------------------------
+  profile.hpp
+	JHT, October 14, 2026 : created
+	JHT, October 14, 2026 : added the hardware counters
+	JHT, October 14, 2026 : added profile_add
+
+  .hpp file for the libj profiler, scoped timers that keep, for each named
+  region, the number of calls, the inclusive and exclusive time, and the
+  bytes moved. Regions nest, so a region is known by its path of names,
+  e.g. "ccsd/contract_T2/permute".
+
+  Each thread keeps its own tree of regions, so a scope is two clock reads
+  and a short search of the children of the open region, with no locking.
+  The trees are merged over the threads at the end by profile_merge (and
+  over the MPI tasks by Pprofile, see para/pprofile.hpp).
+
+  The macros are empty unless libj is built with -DLIBJ_PROFILE (see
+  make.config), so they can be left in kernels at no cost.
+
+  Usage
+  -------------------
+  void contract(...)
+  {
+    LIBJ_PROFILE_SCOPE("contract_T2");  //until the end of the scope
+    LIBJ_PROFILE_BYTES(8*(nA+nB+nC));   //bytes of the open region
+    ...
+  }
+
+  libj::profile_print(stdout);          //this task, outside parallel regions
+  libj::profile_reset();
+
+  Names must live as long as the program, string literals are best.
+
+  Hardware counters
+  -------------------
+  With -DLIBJ_PROFILE_COUNTERS as well (Linux only), each thread opens a
+  perf_event_open group of cycles, instructions, and last level cache 
+  misses, and each region adds what its thread counted while it was open.
+  profile_print then adds IPC, LLC misses per 1000 instructions, and the
+  LLC miss bandwidth (64 bytes a miss), which is the DRAM traffic for 
+  reads. There is no generic FP event, so FP ops are counted only if
+  LIBJ_PROFILE_FP_EVENT is the raw event to count, e.g. on Intel
+  LIBJ_PROFILE_FP_EVENT=0x10c7 for FP_ARITH_INST_RETIRED.256B_PACKED_DOUBLE.
+  Counters are user space only, so perf_event_paranoid must be 2 or less.
+  If the group can not be opened, a warning is printed once and the
+  counters are 0. Each scope is then two read() calls more, so keep the
+  regions above ~10 us.
+
+  Regions timed elsewhere
+  -------------------
+  profile_add(group,name,calls,ns,bytes) adds a region group/name at the
+  top of the table of this thread, for time that is not of a scope of
+  the host, e.g. the device time of the commands of a GPU (see
+  gpu/gpu_prof.hpp, where group is "gpu<n>"). It is not in the time of
+  any open region.
+
+  Merging over threads
+  -------------------
+  A region opened by a thread of an OpenMP parallel region is a child of
+  the region that was open when the parallel region started, so
+  "contract_T2/omp_loop" is the same path on all threads.
+  calls and bytes are summed over the threads. Times are the max over the
+  threads, which is the wall time of a region run by all threads of a
+  parallel region, and the time of a region run by one. Counters are 
+  summed over the threads.
+--------------------------------------------------------------------------*/
+#ifndef LIBJ_PROFILE_HPP
+#define LIBJ_PROFILE_HPP
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#define LIBJ_PROFILE_CAT2(a,b) a##b
+#define LIBJ_PROFILE_CAT(a,b) LIBJ_PROFILE_CAT2(a,b)
+
+#if defined (LIBJ_PROFILE)
+  #define LIBJ_PROFILE_SCOPE(name) \
+    libj::profile_scope LIBJ_PROFILE_CAT(libj_profile_scope_,__LINE__)(name)
+  #define LIBJ_PROFILE_BYTES(bytes) libj::profile_bytes((double) (bytes))
+#else
+  #define LIBJ_PROFILE_SCOPE(name) do {} while (0)
+  #define LIBJ_PROFILE_BYTES(bytes) do {} while (0)
+#endif
+
+namespace libj
+{
+
+//the hardware counters of a region
+enum profile_counter
+{
+  PROFILE_CYCLES,
+  PROFILE_INSTRUCTIONS,
+  PROFILE_LLC_MISSES,
+  PROFILE_FP_OPS,
+  PROFILE_NCOUNT
+};
+
+//a region in the tree of a thread
+struct profile_node
+{
+  const char* name;
+  int         parent;       //-1 at the top
+  int         child;        //first child, -1 if none
+  int         sibling;      //next child of the parent, -1 if none
+  long        calls;
+  long long   incl_ns;
+  long long   child_ns;     //inclusive time of the children
+  double      bytes;
+  long long   counts[PROFILE_NCOUNT];
+};
+
+//the regions of one thread
+class profile_table
+{
+  public:
+  std::vector<profile_node> nodes;
+  int                       open;     //open region, -1 at the top
+  int                       top;      //first region at the top, -1 if none
+  int                       base;     //region of the serial thread this
+                                      //thread is in, -1 if none
+  int                       perf_fd;  //leader of the counter group, -1 if
+                                      //none, -2 before it is opened
+
+  profile_table() : open(-1), top(-1), base(-1), perf_fd(-2) {}
+
+  //open the child name of the open region, returns its node
+  int enter(const char* name);
+
+  //close node, after ns and counts (NULL if none)
+  void leave(const int node, const long long ns, const long long* counts = NULL);
+
+  //read the counters of this thread, 0 if there are none
+  void read_counters(long long* counts);
+
+  //the table of this thread
+  static profile_table& local();
+};
+
+//a region merged over threads, or tasks
+struct profile_entry
+{
+  std::string path;         //names from the top, joined by '/'
+  double      calls;
+  double      incl;         //seconds
+  double      excl;         //seconds
+  double      bytes;
+  double      counts[PROFILE_NCOUNT];
+};
+
+//--------------------------------------------------------------------------
+// profile_scope
+//	opens a region until it is destroyed
+//--------------------------------------------------------------------------
+class profile_scope
+{
+  private:
+  typedef std::chrono::steady_clock clock_t;
+  profile_table&                m_table;
+  int                           m_node;
+  std::chrono::time_point<clock_t> m_beg;
+  #if defined (LIBJ_PROFILE_COUNTERS)
+  long long                     m_counts[PROFILE_NCOUNT];
+  #endif
+
+  public:
+  explicit profile_scope(const char* name)
+    : m_table(profile_table::local()), m_node(m_table.enter(name))
+  {
+    #if defined (LIBJ_PROFILE_COUNTERS)
+    m_table.read_counters(m_counts);
+    #endif
+    m_beg = clock_t::now();
+  }
+
+  ~profile_scope()
+  {
+    const long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_t::now() - m_beg).count();
+    #if defined (LIBJ_PROFILE_COUNTERS)
+    long long counts[PROFILE_NCOUNT];
+    m_table.read_counters(counts);
+    for (int c=0;c<PROFILE_NCOUNT;c++) {counts[c] -= m_counts[c];}
+    m_table.leave(m_node,ns,counts);
+    #else
+    m_table.leave(m_node,ns);
+    #endif
+  }
+
+  profile_scope(const profile_scope&) = delete;
+  profile_scope& operator=(const profile_scope&) = delete;
+};
+
+//add bytes to the open region of this thread
+void profile_bytes(const double bytes);
+
+//add calls, ns, and bytes to the region group/name at the top of this thread
+void profile_add(const char* group, const char* name, const long calls,
+                 const long long ns, const double bytes);
+
+//the regions of all threads, merged, parents before their children
+std::vector<profile_entry> profile_merge();
+
+//clear the regions of all threads, outside of any region
+void profile_reset();
+
+//true if path a sorts before b, by their names from the top
+bool profile_path_less(const std::string& a, const std::string& b);
+
+//true if this task has counted any hardware counters
+bool profile_has_counters(const std::vector<profile_entry>& entries);
+
+//print the regions of this task
+void profile_print(FILE* fp);
+
+//print regions with their min, avg, and max over ntasks, which are in
+//the same order
+void profile_print(FILE* fp, const int ntasks, const std::vector<profile_entry>& min,
+                   const std::vector<profile_entry>& avg, const std::vector<profile_entry>& max);
+
+}//end libj namespace
+#endif
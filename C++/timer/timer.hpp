@@ -10,7 +10,9 @@ class Timer
 {
 private:
 	// Type aliases to make accessing nested type easier
-	using clock_t = std::chrono::high_resolution_clock;
+	// steady, as high_resolution_clock can be the system clock, 
+	// which jumps. For inner loops see libj::CycleTimer (cycle_timer.hpp)
+	using clock_t = std::chrono::steady_clock;
 	using second_t = std::chrono::duration<double, std::ratio<1> >;
 	
 	std::chrono::time_point<clock_t> m_beg;
@@ -0,0 +1,329 @@
+/*--------------------------------------------------------------------------
+  trace.cpp
+	JHT, October 14, 2026 : created
+	JHT, October 14, 2026 : added the named tracks
+
+  .cpp file for the libj event tracer, see trace.hpp
+
+  Packed buffer layout, all little endian as on the host
+  -------------------
+  int       magic     TRACE_MAGIC
+  int       nthreads
+  int       nnames
+  long long nevents
+  long long dropped
+  nnames names, each ended by a '\0'
+  nthreads labels of
+    int       label     index into the names, -1 for a thread
+  nevents events of
+    int       name      index into the names
+    int       cat       index into the names
+    int       tid
+    long long ts        ns from the epoch
+    long long dur       ns
+    long long arg
+--------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "trace.hpp"
+
+#define TRACE_MAGIC 0x4c4a5452
+#define TRACE_EVENTS 1048576
+#define TRACE_HEADER (3*sizeof(int) + 2*sizeof(long long))
+#define TRACE_RECORD (3*sizeof(int) + 3*sizeof(long long))
+
+namespace libj
+{
+
+//--------------------------------------------------------------------------
+// the buffers of all threads, never freed, so the events of threads that
+// have exited are still packed
+//--------------------------------------------------------------------------
+static std::mutex& trace_mutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+static std::vector<trace_buffer*>& trace_buffers()
+{
+  static std::vector<trace_buffer*> buffers;
+  return buffers;
+}
+
+static long      trace_events = -1;   //-1 until read from the environment
+static bool      trace_ring   = false;
+static long long trace_epoch  = 0;
+
+//--------------------------------------------------------------------------
+// trace_register
+//	a new buffer, with the trace mutex held
+//--------------------------------------------------------------------------
+static trace_buffer* trace_register(const char* label)
+{
+  trace_buffer* buf = new trace_buffer();
+  if (trace_events < 0)
+  {
+    const char* events = getenv("LIBJ_TRACE_EVENTS");
+    const char* ring = getenv("LIBJ_TRACE_RING");
+    trace_events = (events != NULL) ? atol(events) : TRACE_EVENTS;
+    trace_ring = (ring != NULL && atoi(ring) != 0);
+    if (trace_epoch == 0) {trace_epoch = trace_now();}
+  }
+  buf->capacity = (trace_events > 0) ? trace_events : 0;
+  buf->ring = trace_ring;
+  buf->tid = (int) trace_buffers().size();
+  buf->label = label;
+  trace_buffers().push_back(buf);
+  return buf;
+}
+
+//--------------------------------------------------------------------------
+// local
+//--------------------------------------------------------------------------
+trace_buffer& trace_buffer::local()
+{
+  static thread_local trace_buffer* buf = NULL;
+  if (buf == NULL)
+  {
+    std::lock_guard<std::mutex> lock(trace_mutex());
+    buf = trace_register(NULL);
+  }
+  return *buf;
+}
+
+//--------------------------------------------------------------------------
+// trace_track
+//--------------------------------------------------------------------------
+trace_buffer& trace_track(const char* label)
+{
+  std::lock_guard<std::mutex> lock(trace_mutex());
+  return *trace_register(label);
+}
+
+//--------------------------------------------------------------------------
+// trace_config
+//--------------------------------------------------------------------------
+void trace_config(const long events, const bool ring)
+{
+  std::lock_guard<std::mutex> lock(trace_mutex());
+  trace_events = (events > 0) ? events : 0;
+  trace_ring = ring;
+  if (trace_epoch == 0) {trace_epoch = trace_now();}
+}
+
+//--------------------------------------------------------------------------
+// trace_set_epoch
+//--------------------------------------------------------------------------
+void trace_set_epoch()
+{
+  std::lock_guard<std::mutex> lock(trace_mutex());
+  trace_epoch = trace_now();
+}
+
+//--------------------------------------------------------------------------
+// trace_put
+//	append bytes of val to buf
+//--------------------------------------------------------------------------
+template <typename T>
+static void trace_put(std::vector<char>& buf, const T val)
+{
+  const size_t pos = buf.size();
+  buf.resize(pos + sizeof(T));
+  memcpy(buf.data()+pos,&val,sizeof(T));
+}
+
+template <typename T>
+static T trace_get(const char* buf, long& pos)
+{
+  T val;
+  memcpy(&val,buf+pos,sizeof(T));
+  pos += (long) sizeof(T);
+  return val;
+}
+
+//--------------------------------------------------------------------------
+// trace_pack
+//	the events of a ring start at its oldest one
+//--------------------------------------------------------------------------
+void trace_pack(std::vector<char>& buf)
+{
+  std::lock_guard<std::mutex> lock(trace_mutex());
+  const std::vector<trace_buffer*>& buffers = trace_buffers();
+
+  std::map<std::string,int> index;
+  std::vector<const char*> names;
+  std::vector<int> labels(buffers.size(),-1);
+  long long nevents = 0, dropped = 0;
+  for (size_t b=0;b<buffers.size();b++)
+  {
+    if (buffers[b]->label != NULL)
+    {
+      const std::string label(buffers[b]->label);
+      if (index.insert(std::make_pair(label,(int) names.size())).second)
+      {
+        names.push_back(buffers[b]->label);
+      }
+      labels[b] = index[label];
+    }
+    const std::vector<trace_event>& events = buffers[b]->events;
+    for (size_t e=0;e<events.size();e++)
+    {
+      const char* both[2] = {events[e].name,events[e].cat};
+      for (int k=0;k<2;k++)
+      {
+        if (index.insert(std::make_pair(std::string(both[k]),(int) names.size())).second)
+        {
+          names.push_back(both[k]);
+        }
+      }
+    }
+    nevents += (long long) events.size();
+    dropped += buffers[b]->dropped;
+  }
+
+  buf.clear();
+  trace_put<int>(buf,TRACE_MAGIC);
+  trace_put<int>(buf,(int) buffers.size());
+  trace_put<int>(buf,(int) names.size());
+  trace_put<long long>(buf,nevents);
+  trace_put<long long>(buf,dropped);
+  for (size_t n=0;n<names.size();n++)
+  {
+    buf.insert(buf.end(),names[n],names[n]+strlen(names[n])+1);
+  }
+  for (size_t b=0;b<buffers.size();b++) {trace_put<int>(buf,labels[b]);}
+  buf.reserve(buf.size() + nevents*TRACE_RECORD);
+  for (size_t b=0;b<buffers.size();b++)
+  {
+    const trace_buffer& B = *buffers[b];
+    const long num = (long) B.events.size();
+    const long first = (B.ring && num == B.capacity) ? B.next : 0;
+    for (long i=0;i<num;i++)
+    {
+      const trace_event& E = B.events[(first + i) % num];
+      trace_put<int>(buf,index[E.name]);
+      trace_put<int>(buf,index[E.cat]);
+      trace_put<int>(buf,B.tid);
+      trace_put<long long>(buf,E.beg - trace_epoch);
+      trace_put<long long>(buf,E.end - E.beg);
+      trace_put<long long>(buf,E.arg);
+    }
+  }
+}
+
+//--------------------------------------------------------------------------
+// trace_escape
+//	name as a json string
+//--------------------------------------------------------------------------
+static std::string trace_escape(const char* name)
+{
+  std::string str;
+  for (const char* c=name;*c!='\0';c++)
+  {
+    if (*c == '"' || *c == '\\') {str += '\\'; str += *c;}
+    else if ((unsigned char) *c < 0x20) {str += ' ';}
+    else {str += *c;}
+  }
+  return str;
+}
+
+//--------------------------------------------------------------------------
+// trace_json
+//	complete ("X") events in us, with the tasks as processes
+//--------------------------------------------------------------------------
+int trace_json(FILE* fp, const char* buf, const long bytes, const int rank, const bool first)
+{
+  long pos = 0;
+  if (bytes < (long) TRACE_HEADER || trace_get<int>(buf,pos) != TRACE_MAGIC)
+  {
+    printf("ERROR libj::trace_json buffer of task %d is not a trace buffer\n",rank);
+    return 1;
+  }
+  const int nthreads = trace_get<int>(buf,pos);
+  const int nnames = trace_get<int>(buf,pos);
+  const long long nevents = trace_get<long long>(buf,pos);
+  const long long dropped = trace_get<long long>(buf,pos);
+
+  std::vector<std::string> names(nnames);
+  for (int n=0;n<nnames;n++)
+  {
+    const size_t len = strnlen(buf+pos,bytes-pos);
+    names[n] = trace_escape(buf+pos);
+    pos += (long) len + 1;
+  }
+  std::vector<int> labels(nthreads,-1);
+  if (pos + nthreads*(long) sizeof(int) > bytes)
+  {
+    printf("ERROR libj::trace_json buffer of task %d is truncated\n",rank);
+    return 1;
+  }
+  for (int t=0;t<nthreads;t++) 
+  {
+    labels[t] = trace_get<int>(buf,pos);
+    if (labels[t] >= nnames) {labels[t] = -1;}
+  }
+  if (pos + nevents*(long) TRACE_RECORD > bytes)
+  {
+    printf("ERROR libj::trace_json buffer of task %d is truncated\n",rank);
+    return 1;
+  }
+
+  fprintf(fp,"%s{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"task %d\"}}",
+          first ? "" : ",\n",rank,rank);
+  fprintf(fp,",\n{\"name\":\"process_sort_index\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"sort_index\":%d}}",
+          rank,rank);
+  for (int t=0;t<nthreads;t++)
+  {
+    if (labels[t] >= 0)
+    {
+      fprintf(fp,",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+              rank,t,names[labels[t]].c_str());
+    }
+    else
+    {
+      fprintf(fp,",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"thread %d\"}}",
+              rank,t,t);
+    }
+  }
+  if (dropped > 0)
+  {
+    fprintf(fp,",\n{\"name\":\"dropped %lld events\",\"ph\":\"i\",\"s\":\"p\",\"pid\":%d,\"tid\":0,\"ts\":0}",
+            dropped,rank);
+  }
+  for (long long e=0;e<nevents;e++)
+  {
+    const int name = trace_get<int>(buf,pos);
+    const int cat = trace_get<int>(buf,pos);
+    const int tid = trace_get<int>(buf,pos);
+    const long long ts = trace_get<long long>(buf,pos);
+    const long long dur = trace_get<long long>(buf,pos);
+    const long long arg = trace_get<long long>(buf,pos);
+    fprintf(fp,",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,"
+               "\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"n\":%lld}}",
+            names[name].c_str(),names[cat].c_str(),rank,tid,1.0e-3*ts,1.0e-3*dur,arg);
+  }
+  return 0;
+}
+
+//--------------------------------------------------------------------------
+// trace_reset
+//--------------------------------------------------------------------------
+void trace_reset()
+{
+  std::lock_guard<std::mutex> lock(trace_mutex());
+  std::vector<trace_buffer*>& buffers = trace_buffers();
+  for (size_t b=0;b<buffers.size();b++)
+  {
+    buffers[b]->events.clear();
+    buffers[b]->next = 0;
+    buffers[b]->dropped = 0;
+  }
+}
+
+}//end libj namespace
@@ -0,0 +1,160 @@
+/*--------------------------------------------------------------------------
+  trace.hpp
+	JHT, October 14, 2026 : created
+	JHT, October 14, 2026 : added the named tracks
+
+  .hpp file for the libj event tracer, which keeps the begin and end time
+  of each scoped event on each thread, to be looked at as a timeline in
+  chrome://tracing or ui.perfetto.dev. The para io (Pfile), printing
+  (Pprint), collectives (Pcoll) and task_loop tasks are traced as well.
+
+  Each thread has its own buffer of events, so an event is two clock reads
+  and a store, with no locking. trace_pack packs the buffers of a task
+  into one compact binary buffer, and trace_json writes a packed buffer as
+  chrome trace events. Ptrace (para/ptrace.hpp) does this for all tasks,
+  at Para::destroy.
+
+  The macros are empty unless libj is built with -DLIBJ_TRACE (see
+  make.config), so they can be left in kernels at no cost.
+
+  Usage
+  -------------------
+  {
+    LIBJ_TRACE_SCOPE("contract_T2","compute");    //until the end of the scope
+    LIBJ_TRACE_SCOPE_ARG("write","io",bytes);     //with a number shown as "n"
+    ...
+  }
+
+  Names and categories must live as long as the program, string literals
+  are best.
+
+  Tracks
+  -------------------
+  trace_track(label) makes a buffer that is not a thread's, for events
+  timed elsewhere, e.g. the commands of a GPU queue (see gpu/gpu_prof.hpp),
+  shown as its own row named label. The caller adds to it with
+  trace_buffer::add, from one thread at a time.
+
+  Buffers
+  -------------------
+  Each thread keeps up to LIBJ_TRACE_EVENTS events (default 1048576, 40
+  bytes each). After that new events are dropped, or, with
+  LIBJ_TRACE_RING=1, they overwrite the oldest ones, so a long job keeps
+  its last events. trace_config sets these from the code.
+--------------------------------------------------------------------------*/
+#ifndef LIBJ_TRACE_HPP
+#define LIBJ_TRACE_HPP
+
+#include <stdio.h>
+#include <vector>
+#include <chrono>
+
+#define LIBJ_TRACE_CAT2(a,b) a##b
+#define LIBJ_TRACE_CAT(a,b) LIBJ_TRACE_CAT2(a,b)
+
+#if defined (LIBJ_TRACE)
+  #define LIBJ_TRACE_SCOPE(name,cat) \
+    libj::trace_scope LIBJ_TRACE_CAT(libj_trace_scope_,__LINE__)(name,cat,0)
+  #define LIBJ_TRACE_SCOPE_ARG(name,cat,arg) \
+    libj::trace_scope LIBJ_TRACE_CAT(libj_trace_scope_,__LINE__)(name,cat,(long long) (arg))
+#else
+  #define LIBJ_TRACE_SCOPE(name,cat) do {} while (0)
+  #define LIBJ_TRACE_SCOPE_ARG(name,cat,arg) do {} while (0)
+#endif
+
+namespace libj
+{
+
+//one event of a thread, times in ns of the steady clock
+struct trace_event
+{
+  const char* name;
+  const char* cat;
+  long long   beg;
+  long long   end;
+  long long   arg;
+};
+
+//the events of one thread
+class trace_buffer
+{
+  public:
+  std::vector<trace_event> events;
+  long                     next;      //next slot once events is full
+  long                     capacity;
+  long long                dropped;   //events dropped or overwritten
+  bool                     ring;
+  int                      tid;       //order the thread first traced in
+  const char*              label;     //name of a track, NULL for a thread
+
+  trace_buffer() : next(0), capacity(0), dropped(0), ring(false), tid(0), label(NULL) {}
+
+  //keep an event
+  void add(const char* name, const char* cat, const long long beg,
+           const long long end, const long long arg)
+  {
+    const trace_event event = {name,cat,beg,end,arg};
+    if ((long) events.size() < capacity) {events.push_back(event); return;}
+    dropped++;
+    if (!ring || capacity == 0) return;
+    events[next] = event;
+    next = (next + 1 == capacity) ? 0 : next + 1;
+  }
+
+  //the buffer of this thread
+  static trace_buffer& local();
+};
+
+//ns of the steady clock
+inline long long trace_now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//--------------------------------------------------------------------------
+// trace_scope
+//	keeps an event from its construction to its destruction
+//--------------------------------------------------------------------------
+class trace_scope
+{
+  private:
+  trace_buffer& m_buf;
+  const char*   m_name;
+  const char*   m_cat;
+  long long     m_arg;
+  long long     m_beg;
+
+  public:
+  trace_scope(const char* name, const char* cat, const long long arg)
+    : m_buf(trace_buffer::local()), m_name(name), m_cat(cat), m_arg(arg), m_beg(trace_now()) {}
+
+  ~trace_scope() {m_buf.add(m_name,m_cat,m_beg,trace_now(),m_arg);}
+
+  trace_scope(const trace_scope&) = delete;
+  trace_scope& operator=(const trace_scope&) = delete;
+};
+
+//a new track named label (which must live as long as the program)
+trace_buffer& trace_track(const char* label);
+
+//events per thread, and if the buffers are rings, for the buffers made
+//after this call
+void trace_config(const long events, const bool ring);
+
+//set time 0 of the timeline to now
+void trace_set_epoch();
+
+//pack the events of all threads into buf, see trace.cpp for the layout
+void trace_pack(std::vector<char>& buf);
+
+//write the events of a packed buffer of task rank as chrome trace events,
+//first is true for the first buffer of the file. Returns 1 if the buffer
+//is not a packed buffer
+int trace_json(FILE* fp, const char* buf, const long bytes, const int rank, const bool first);
+
+//forget the events of all threads
+void trace_reset();
+
+}//end libj namespace
+#endif
@@ -0,0 +1,290 @@
+!--------------------------------------------------------
+! cbind
+!	- module of ISO_C_BINDING interfaces to the C++
+!	  simd, linal and jblis kernels and the Core arena
+!	  of libj, through the C entry points of
+!	  C++/fbind/fbind.hpp
+!
+!	- arrays are passed by address with no copy, so a
+!	  section of a dmem DBUF can go straight to the
+!	  kernels, e.g.,
+!
+!	    call dmem_checkout(N,I0,META)
+!	    call libj_simd_dzero(N,DBUF(I0))
+!	    x = libj_simd_ddot(N,DBUF(I0),DBUF(I1))
+!
+!	- link with libj.a (make fortran in C++) and the
+!	  C++ runtime, -lstdc++ -fopenmp
+!
+! Functions and subroutines (d for real*8, s for real*4)
+! libj_simd_ddot(N,X,Y)		 : X.Y
+! libj_simd_daxpy(N,A,X,Y)	 : Y = Y + A*X
+! libj_simd_dscal(N,A,X)	 : X = A*X
+! libj_simd_dcopy(N,X,Y)	 : Y = X
+! libj_simd_dzero(N,X)		 : X = 0
+! libj_linal_dABpC(M,N,K,ALPHA,  : C = ALPHA*A.B + BETA*C
+!	A,LDA,B,LDB,BETA,C,LDC)
+! libj_linal_dATBpC(...)	 : C = ALPHA*A^T.B + BETA*C
+! cbind_dcontract(ALPHA,LA,A,	 : C(idxC) = ALPHA*A(idxA).B(idxB)
+!	idxA,LB,B,idxB,BETA,	   + BETA*C(idxC), jblis contract
+!	LC,C,idxC)
+! cbind_dpermute(LA,A,idxA,	 : B(idxB) = ALPHA*A(idxA) + BETA*B
+!	LB,B,idxB,ALPHA,BETA)
+! libj_core_dcreate(N)		 : type(c_ptr) to a Core of N real*8
+! cbind_core_dcheckout(CORE,N,X) : X(1:N) => N elements of CORE,
+!				   aligned to 64 bytes
+! libj_core_dmark(CORE)		 : current end of the checkouts
+! libj_core_drewind(CORE,M)	 : gives back all since mark M
+! libj_core_dnfree(CORE)	 : free elements
+! libj_core_ddestroy(CORE)	 : frees CORE
+!
+!--------------------------------------------------------
+module cbind
+  use, intrinsic :: iso_c_binding
+  implicit none
+
+interface
+
+!--------------------------------------------------------
+! simd
+!--------------------------------------------------------
+real(c_double) function libj_simd_ddot(N,X,Y) bind(C,name='libj_simd_ddot')
+  import :: c_long, c_double
+  integer(c_long), value :: N
+  real(c_double), intent(in) :: X(*), Y(*)
+end function libj_simd_ddot
+
+subroutine libj_simd_daxpy(N,A,X,Y) bind(C,name='libj_simd_daxpy')
+  import :: c_long, c_double
+  integer(c_long), value :: N
+  real(c_double), value :: A
+  real(c_double), intent(in) :: X(*)
+  real(c_double), intent(inout) :: Y(*)
+end subroutine libj_simd_daxpy
+
+subroutine libj_simd_dscal(N,A,X) bind(C,name='libj_simd_dscal')
+  import :: c_long, c_double
+  integer(c_long), value :: N
+  real(c_double), value :: A
+  real(c_double), intent(inout) :: X(*)
+end subroutine libj_simd_dscal
+
+subroutine libj_simd_dcopy(N,X,Y) bind(C,name='libj_simd_dcopy')
+  import :: c_long, c_double
+  integer(c_long), value :: N
+  real(c_double), intent(in) :: X(*)
+  real(c_double), intent(inout) :: Y(*)
+end subroutine libj_simd_dcopy
+
+subroutine libj_simd_dzero(N,X) bind(C,name='libj_simd_dzero')
+  import :: c_long, c_double
+  integer(c_long), value :: N
+  real(c_double), intent(inout) :: X(*)
+end subroutine libj_simd_dzero
+
+real(c_float) function libj_simd_sdot(N,X,Y) bind(C,name='libj_simd_sdot')
+  import :: c_long, c_float
+  integer(c_long), value :: N
+  real(c_float), intent(in) :: X(*), Y(*)
+end function libj_simd_sdot
+
+subroutine libj_simd_saxpy(N,A,X,Y) bind(C,name='libj_simd_saxpy')
+  import :: c_long, c_float
+  integer(c_long), value :: N
+  real(c_float), value :: A
+  real(c_float), intent(in) :: X(*)
+  real(c_float), intent(inout) :: Y(*)
+end subroutine libj_simd_saxpy
+
+subroutine libj_simd_sscal(N,A,X) bind(C,name='libj_simd_sscal')
+  import :: c_long, c_float
+  integer(c_long), value :: N
+  real(c_float), value :: A
+  real(c_float), intent(inout) :: X(*)
+end subroutine libj_simd_sscal
+
+subroutine libj_simd_scopy(N,X,Y) bind(C,name='libj_simd_scopy')
+  import :: c_long, c_float
+  integer(c_long), value :: N
+  real(c_float), intent(in) :: X(*)
+  real(c_float), intent(inout) :: Y(*)
+end subroutine libj_simd_scopy
+
+subroutine libj_simd_szero(N,X) bind(C,name='libj_simd_szero')
+  import :: c_long, c_float
+  integer(c_long), value :: N
+  real(c_float), intent(inout) :: X(*)
+end subroutine libj_simd_szero
+
+!--------------------------------------------------------
+! linal
+!--------------------------------------------------------
+subroutine libj_linal_dABpC(M,N,K,ALPHA,A,LDA,B,LDB,BETA,C,LDC) &
+  bind(C,name='libj_linal_dABpC')
+  import :: c_int, c_double
+  integer(c_int), value :: M, N, K, LDA, LDB, LDC
+  real(c_double), value :: ALPHA, BETA
+  real(c_double), intent(in) :: A(*), B(*)
+  real(c_double), intent(inout) :: C(*)
+end subroutine libj_linal_dABpC
+
+subroutine libj_linal_dATBpC(M,N,K,ALPHA,A,LDA,B,LDB,BETA,C,LDC) &
+  bind(C,name='libj_linal_dATBpC')
+  import :: c_int, c_double
+  integer(c_int), value :: M, N, K, LDA, LDB, LDC
+  real(c_double), value :: ALPHA, BETA
+  real(c_double), intent(in) :: A(*), B(*)
+  real(c_double), intent(inout) :: C(*)
+end subroutine libj_linal_dATBpC
+
+subroutine libj_linal_sABpC(M,N,K,ALPHA,A,LDA,B,LDB,BETA,C,LDC) &
+  bind(C,name='libj_linal_sABpC')
+  import :: c_int, c_float
+  integer(c_int), value :: M, N, K, LDA, LDB, LDC
+  real(c_float), value :: ALPHA, BETA
+  real(c_float), intent(in) :: A(*), B(*)
+  real(c_float), intent(inout) :: C(*)
+end subroutine libj_linal_sABpC
+
+subroutine libj_linal_sATBpC(M,N,K,ALPHA,A,LDA,B,LDB,BETA,C,LDC) &
+  bind(C,name='libj_linal_sATBpC')
+  import :: c_int, c_float
+  integer(c_int), value :: M, N, K, LDA, LDB, LDC
+  real(c_float), value :: ALPHA, BETA
+  real(c_float), intent(in) :: A(*), B(*)
+  real(c_float), intent(inout) :: C(*)
+end subroutine libj_linal_sATBpC
+
+!--------------------------------------------------------
+! jblis, the index strings must end in c_null_char,
+!	see cbind_dcontract and cbind_dpermute
+!--------------------------------------------------------
+subroutine libj_jblis_dcontract(ALPHA,NA,LA,A,idxA,NB,LB,B,idxB, &
+                                BETA,NC,LC,C,idxC) &
+  bind(C,name='libj_jblis_dcontract')
+  import :: c_int, c_long, c_double, c_char
+  real(c_double), value :: ALPHA, BETA
+  integer(c_int), value :: NA, NB, NC
+  integer(c_long), intent(in) :: LA(*), LB(*), LC(*)
+  real(c_double), intent(in) :: A(*), B(*)
+  real(c_double), intent(inout) :: C(*)
+  character(kind=c_char), intent(in) :: idxA(*), idxB(*), idxC(*)
+end subroutine libj_jblis_dcontract
+
+subroutine libj_jblis_dpermute(NA,LA,A,idxA,NB,LB,B,idxB,ALPHA,BETA) &
+  bind(C,name='libj_jblis_dpermute')
+  import :: c_int, c_long, c_double, c_char
+  integer(c_int), value :: NA, NB
+  integer(c_long), intent(in) :: LA(*), LB(*)
+  real(c_double), intent(in) :: A(*)
+  real(c_double), intent(inout) :: B(*)
+  character(kind=c_char), intent(in) :: idxA(*), idxB(*)
+  real(c_double), value :: ALPHA, BETA
+end subroutine libj_jblis_dpermute
+
+!--------------------------------------------------------
+! core arena
+!--------------------------------------------------------
+type(c_ptr) function libj_core_dcreate(N) bind(C,name='libj_core_dcreate')
+  import :: c_ptr, c_long
+  integer(c_long), value :: N
+end function libj_core_dcreate
+
+subroutine libj_core_ddestroy(CORE) bind(C,name='libj_core_ddestroy')
+  import :: c_ptr
+  type(c_ptr), value :: CORE
+end subroutine libj_core_ddestroy
+
+type(c_ptr) function libj_core_dcheckout(CORE,N) bind(C,name='libj_core_dcheckout')
+  import :: c_ptr, c_long
+  type(c_ptr), value :: CORE
+  integer(c_long), value :: N
+end function libj_core_dcheckout
+
+integer(c_long) function libj_core_dmark(CORE) bind(C,name='libj_core_dmark')
+  import :: c_ptr, c_long
+  type(c_ptr), value :: CORE
+end function libj_core_dmark
+
+subroutine libj_core_drewind(CORE,M) bind(C,name='libj_core_drewind')
+  import :: c_ptr, c_long
+  type(c_ptr), value :: CORE
+  integer(c_long), value :: M
+end subroutine libj_core_drewind
+
+integer(c_long) function libj_core_dnfree(CORE) bind(C,name='libj_core_dnfree')
+  import :: c_ptr, c_long
+  type(c_ptr), value :: CORE
+end function libj_core_dnfree
+
+end interface
+
+contains
+
+!--------------------------------------------------------
+! cbind_dcontract
+!	- jblis contract of Fortran arrays, given their
+!	  lengths and index labels
+!--------------------------------------------------------
+! ALPHA		: real*8, scalar for A.B
+! LA,LB,LC	: int*8 arrays, lengths of A,B,C
+! A,B,C		: real*8 arrays
+! idxA,idxB,idxC: character, index labels of A,B,C
+! BETA		: real*8, scalar for C
+subroutine cbind_dcontract(ALPHA,LA,A,idxA,LB,B,idxB,BETA,LC,C,idxC)
+  implicit none
+  real(c_double), intent(in) :: ALPHA, BETA
+  integer(c_long), intent(in) :: LA(:), LB(:), LC(:)
+  real(c_double), intent(in) :: A(*), B(*)
+  real(c_double), intent(inout) :: C(*)
+  character(len=*), intent(in) :: idxA, idxB, idxC
+
+  call libj_jblis_dcontract(ALPHA,int(size(LA),c_int),LA,A,trim(idxA)//c_null_char, &
+                            int(size(LB),c_int),LB,B,trim(idxB)//c_null_char, &
+                            BETA,int(size(LC),c_int),LC,C,trim(idxC)//c_null_char)
+
+end subroutine cbind_dcontract
+
+!--------------------------------------------------------
+! cbind_dpermute
+!	- jblis permute of Fortran arrays,
+!	  B(idxB) = ALPHA*A(idxA) + BETA*B(idxB)
+!--------------------------------------------------------
+! LA,LB		: int*8 arrays, lengths of A,B
+! A,B		: real*8 arrays
+! idxA,idxB	: character, index labels of A,B
+! ALPHA,BETA	: real*8, scalars of A and B
+subroutine cbind_dpermute(LA,A,idxA,LB,B,idxB,ALPHA,BETA)
+  implicit none
+  integer(c_long), intent(in) :: LA(:), LB(:)
+  real(c_double), intent(in) :: A(*)
+  real(c_double), intent(inout) :: B(*)
+  character(len=*), intent(in) :: idxA, idxB
+  real(c_double), intent(in) :: ALPHA, BETA
+
+  call libj_jblis_dpermute(int(size(LA),c_int),LA,A,trim(idxA)//c_null_char, &
+                           int(size(LB),c_int),LB,B,trim(idxB)//c_null_char, &
+                           ALPHA,BETA)
+
+end subroutine cbind_dpermute
+
+!--------------------------------------------------------
+! cbind_core_dcheckout
+!	- checks out N elements of a Core, aligned to 64
+!	  bytes, as the Fortran pointer X(1:N)
+!--------------------------------------------------------
+! CORE		: type(c_ptr), from libj_core_dcreate
+! N		: int*8, number of elements
+! X		: real*8 pointer, the checked out elements
+subroutine cbind_core_dcheckout(CORE,N,X)
+  implicit none
+  type(c_ptr), intent(in) :: CORE
+  integer(c_long), intent(in) :: N
+  real(c_double), pointer, intent(out) :: X(:)
+
+  call c_f_pointer(libj_core_dcheckout(CORE,N),X,[N])
+
+end subroutine cbind_core_dcheckout
+
+end module cbind
+!--------------------------------------------------------
@@ -4,8 +4,21 @@
 !	  data types related to a double precsision
 !	  buffer 
 !
-!	- this is currently just a linear buffer, without
-!	  any named sections
+!	- dmem_type is just a linear buffer, without
+!	  any named sections, over a DBUF of the caller
+!
+!	- dpool_type is a pool that owns its buffer, 
+!	  POOL%DBUF, allocated in C (posix_memalign) and 
+!	  aligned to DMEM_ALIGN bytes. Each checkout starts
+!	  on a DMEM_ALIGN boundary, and may be named. Pools 
+!	  are independent, so each OpenMP thread can have
+!	  its own (dpool_init_threads). Loops over a 
+!	  checkout can then be vectorized as
+!
+!	    call dpool_checkout(N,I0,POOL)
+!	    X => POOL%DBUF(I0:I0+N-1)
+!	    !$omp simd aligned(X:64)
+!	    do i=1,N
 !
 ! Subroutines
 ! dmem_init(N,META)     : initializes memory structure
@@ -15,8 +28,33 @@
 ! dmem_checkout(N,I0,	: reserves a section of memory
 !		META)	  and returns it's loc in DBUF
 !
+! dpool_init(N,POOL)	: allocates a pool of N elements
+! dpool_destroy(POOL)	: frees a pool
+! dpool_info(POOL)	: prints info about a pool
+! dpool_checkout(N,I0,	: checks out N aligned elements, 
+!		POOL)	  at POOL%DBUF(I0)
+! dpool_section(NAME,N,	: checks out N aligned elements 
+!		I0,POOL)  named NAME
+! dpool_find(NAME,I0,N,	: I0 and N of section NAME, 
+!		POOL)	  I0 = 0 if there is none
+! dpool_rewind(I0,POOL)	: gives back all from I0 on, 
+!			  and the sections there
+! dpool_init_threads(	: one pool of N elements for each 
+!	N,POOLS)	  OpenMP thread, POOLS(tid+1)
+! dpool_destroy_threads	: frees the pools of each thread
+!	(POOLS)
+!
 !--------------------------------------------------------
 module dmem
+  use, intrinsic :: iso_c_binding
+  !$ use omp_lib
+  implicit none
+
+!alignment of the pools and their checkouts, in bytes
+integer(kind=8), parameter :: DMEM_ALIGN = 64
+
+!most named sections of a pool
+integer(kind=8), parameter :: DMEM_MAXSEC = 64
 
 !---------------------------------------------------
 ! dmem_type
@@ -33,6 +71,47 @@ type dmem_type
   integer(kind=8) :: next
 end type dmem_type
 
+!---------------------------------------------------
+! dpool_type
+!       - type of an aligned pool, which owns its 
+!	  double precision buffer
+!---------------------------------------------------
+! base            : c_ptr, the C allocation
+! DBUF(:)         : real*8 pointer, the buffer
+! ntot            : int*8,total number of elements  
+! nfree           : int*8,remaining free elements 
+! next            : int*8,index of next free element
+! nsec            : int*8,number of named sections
+! sec_name(:)     : chr*16, names of the sections
+! sec_i0(:)       : int*8, first element of each
+! sec_n(:)        : int*8, elements of each
+
+type dpool_type
+  type(c_ptr)                   :: base = c_null_ptr
+  real(kind=8), pointer         :: DBUF(:) => null()
+  integer(kind=8)               :: ntot = 0
+  integer(kind=8)               :: nfree = 0
+  integer(kind=8)               :: next = 1
+  integer(kind=8)               :: nsec = 0
+  character(len=16)             :: sec_name(DMEM_MAXSEC)
+  integer(kind=8)               :: sec_i0(DMEM_MAXSEC)
+  integer(kind=8)               :: sec_n(DMEM_MAXSEC)
+end type dpool_type
+
+interface
+  integer(c_int) function dmem_posix_memalign(ptr,align,bytes) &
+    bind(C,name='posix_memalign')
+    import :: c_int, c_ptr, c_size_t
+    type(c_ptr), intent(out) :: ptr
+    integer(c_size_t), value :: align, bytes
+  end function dmem_posix_memalign
+
+  subroutine dmem_c_free(ptr) bind(C,name='free')
+    import :: c_ptr
+    type(c_ptr), value :: ptr
+  end subroutine dmem_c_free
+end interface
+
   
 contains
 
@@ -143,5 +222,252 @@ subroutine dmem_checkout(N,I0,META)
 
 end subroutine dmem_checkout
 
+!--------------------------------------------------------
+! dpool_init
+!	- allocates a pool of N elements, aligned to
+!	  DMEM_ALIGN bytes
+!--------------------------------------------------------
+! N		: int*8, number of elements
+! POOL		: dpool_type, the pool
+subroutine dpool_init(N,POOL)
+  implicit none
+  integer(kind=8), intent(in) :: N
+  type(dpool_type), intent(inout) :: POOL
+  integer(c_int) :: stat
+
+  if (c_associated(POOL%base)) then
+    write(*,*) "JLIB : ERROR ERROR ERROR"
+    write(*,*) "Attempted to initialize a pool that is already allocated"
+    stop 1
+  end if
+  if (N .lt. 1) then
+    write(*,*) "JLIB : ERROR ERROR ERROR"
+    write(*,*) "Attempted to initialize a pool of",N,"elements"
+    stop 1
+  end if
+
+  stat = dmem_posix_memalign(POOL%base,int(DMEM_ALIGN,c_size_t), &
+                             int(8*N,c_size_t))
+  if (stat .ne. 0) then
+    write(*,*) "JLIB : ERROR ERROR ERROR"
+    write(*,*) "Could not allocate a pool of",N,"elements"
+    stop 1
+  end if
+  call c_f_pointer(POOL%base,POOL%DBUF,[N])
+
+  POOL%ntot  = N
+  POOL%nfree = N
+  POOL%next  = 1
+  POOL%nsec  = 0
+
+end subroutine dpool_init
+
+!--------------------------------------------------------
+! dpool_destroy
+!	- frees a pool
+!--------------------------------------------------------
+! POOL		: dpool_type, the pool
+subroutine dpool_destroy(POOL)
+  implicit none
+  type(dpool_type), intent(inout) :: POOL
+
+  if (c_associated(POOL%base)) call dmem_c_free(POOL%base)
+  POOL%base  = c_null_ptr
+  POOL%DBUF  => null()
+  POOL%ntot  = 0
+  POOL%nfree = 0
+  POOL%next  = 1
+  POOL%nsec  = 0
+
+end subroutine dpool_destroy
+
+!--------------------------------------------------------
+! dpool_info
+!	- prints info about a pool
+!--------------------------------------------------------
+! POOL		: dpool_type, the pool
+subroutine dpool_info(POOL)
+  implicit none
+  type(dpool_type), intent(in) :: POOL
+  integer(kind=8) :: i
+
+  write(*,'(1x,A)') "DP pool has "
+  write(*,'(1x,I20,A)') POOL%ntot," elements" 
+  write(*,'(1x,I20,A)') POOL%nfree," free elements"
+  write(*,'(1x,I20,A)') POOL%next," is next element"
+  do i=1,POOL%nsec
+    write(*,'(1x,A16,A,I20,A,I20)') POOL%sec_name(i)," at ",POOL%sec_i0(i), &
+                                    " elements ",POOL%sec_n(i)
+  end do
+
+end subroutine dpool_info
+
+!--------------------------------------------------------
+! dpool_checkout
+!	- checks out N elements of a pool, starting on a
+!	  DMEM_ALIGN boundary, at POOL%DBUF(I0)
+!--------------------------------------------------------
+! N		: int*8, number of elements to reserve
+! I0		: int*8, index in POOL%DBUF
+! POOL		: dpool_type, the pool
+subroutine dpool_checkout(N,I0,POOL)
+  implicit none
+  integer(kind=8), intent(in) :: N
+  integer(kind=8), intent(inout) :: I0
+  type(dpool_type), intent(inout) :: POOL
+  integer(kind=8) :: nalign, start
+
+  nalign = DMEM_ALIGN/8
+  start = 1 + nalign*((POOL%next - 1 + nalign - 1)/nalign)
+  if (POOL%ntot - start + 1 .lt. N) then
+    write(*,*) "JLIB : ERROR ERROR ERROR"
+    write(*,*) "Attempted to checkout more of a pool than was available"
+    stop 1
+  end if
+
+  I0 = start
+  POOL%next  = start + N
+  POOL%nfree = POOL%ntot - POOL%next + 1
+
+end subroutine dpool_checkout
+
+!--------------------------------------------------------
+! dpool_section
+!	- checks out N elements of a pool, as the named
+!	  section NAME
+!--------------------------------------------------------
+! NAME		: chr, name of the section, up to 16
+! N		: int*8, number of elements to reserve
+! I0		: int*8, index in POOL%DBUF
+! POOL		: dpool_type, the pool
+subroutine dpool_section(NAME,N,I0,POOL)
+  implicit none
+  character(len=*), intent(in) :: NAME
+  integer(kind=8), intent(in) :: N
+  integer(kind=8), intent(inout) :: I0
+  type(dpool_type), intent(inout) :: POOL
+  integer(kind=8) :: J0, NJ
+
+  call dpool_find(NAME,J0,NJ,POOL)
+  if (J0 .ne. 0) then
+    write(*,*) "JLIB : ERROR ERROR ERROR"
+    write(*,*) "Attempted to checkout section ",trim(NAME)," twice"
+    stop 1
+  end if
+  if (POOL%nsec .ge. DMEM_MAXSEC) then
+    write(*,*) "JLIB : ERROR ERROR ERROR"
+    write(*,*) "Attempted to checkout more than",DMEM_MAXSEC,"sections"
+    stop 1
+  end if
+
+  call dpool_checkout(N,I0,POOL)
+  POOL%nsec = POOL%nsec + 1
+  POOL%sec_name(POOL%nsec) = NAME
+  POOL%sec_i0(POOL%nsec) = I0
+  POOL%sec_n(POOL%nsec) = N
+
+end subroutine dpool_section
+
+!--------------------------------------------------------
+! dpool_find
+!	- finds the named section NAME of a pool
+!--------------------------------------------------------
+! NAME		: chr, name of the section
+! I0		: int*8, index in POOL%DBUF, 0 if none
+! N		: int*8, number of elements
+! POOL		: dpool_type, the pool
+subroutine dpool_find(NAME,I0,N,POOL)
+  implicit none
+  character(len=*), intent(in) :: NAME
+  integer(kind=8), intent(inout) :: I0, N
+  type(dpool_type), intent(in) :: POOL
+  integer(kind=8) :: i
+
+  I0 = 0
+  N  = 0
+  do i=1,POOL%nsec
+    if (POOL%sec_name(i) .eq. NAME) then
+      I0 = POOL%sec_i0(i)
+      N  = POOL%sec_n(i)
+      return
+    end if
+  end do
+
+end subroutine dpool_find
+
+!--------------------------------------------------------
+! dpool_rewind
+!	- gives back the elements of a pool from I0 on,
+!	  and the named sections that are there
+!--------------------------------------------------------
+! I0		: int*8, index in POOL%DBUF
+! POOL		: dpool_type, the pool
+subroutine dpool_rewind(I0,POOL)
+  implicit none
+  integer(kind=8), intent(in) :: I0
+  type(dpool_type), intent(inout) :: POOL
+
+  if (I0 .lt. 1 .or. I0 .gt. POOL%next) then
+    write(*,*) "JLIB : ERROR ERROR ERROR"
+    write(*,*) "Attempted to rewind a pool to",I0,"past its next",POOL%next
+    stop 1
+  end if
+
+  POOL%next  = I0
+  POOL%nfree = POOL%ntot - POOL%next + 1
+  do while (POOL%nsec .gt. 0)
+    if (POOL%sec_i0(POOL%nsec) + POOL%sec_n(POOL%nsec) .le. I0) exit
+    POOL%nsec = POOL%nsec - 1
+  end do
+
+end subroutine dpool_rewind
+
+!--------------------------------------------------------
+! dpool_init_threads
+!	- one pool of N elements for each OpenMP thread, 
+!	  thread tid uses POOLS(tid+1). Each pool is first
+!	  touched by its thread, so its pages are local
+!	  to it. Without OpenMP there is one pool
+!--------------------------------------------------------
+! N		: int*8, number of elements of each
+! POOLS(:)	: dpool_type, allocatable, the pools
+subroutine dpool_init_threads(N,POOLS)
+  implicit none
+  integer(kind=8), intent(in) :: N
+  type(dpool_type), allocatable, intent(inout) :: POOLS(:)
+  integer(kind=8) :: nthreads, tid
+
+  nthreads = 1
+  !$ nthreads = omp_get_max_threads()
+  if (allocated(POOLS)) call dpool_destroy_threads(POOLS)
+  allocate(POOLS(nthreads))
+
+  !$omp parallel private(tid) num_threads(nthreads)
+  tid = 0
+  !$ tid = omp_get_thread_num()
+  call dpool_init(N,POOLS(tid+1))
+  POOLS(tid+1)%DBUF = 0.d0
+  !$omp end parallel
+
+end subroutine dpool_init_threads
+
+!--------------------------------------------------------
+! dpool_destroy_threads
+!	- frees the pools of dpool_init_threads
+!--------------------------------------------------------
+! POOLS(:)	: dpool_type, allocatable, the pools
+subroutine dpool_destroy_threads(POOLS)
+  implicit none
+  type(dpool_type), allocatable, intent(inout) :: POOLS(:)
+  integer(kind=8) :: i
+
+  if (.not. allocated(POOLS)) return
+  do i=1,size(POOLS,kind=8)
+    call dpool_destroy(POOLS(i))
+  end do
+  deallocate(POOLS)
+
+end subroutine dpool_destroy_threads
+
 end module dmem
 !--------------------------------------------------------
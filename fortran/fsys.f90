@@ -58,6 +58,38 @@
 ! fsys_iread(sys,fid,sr, : reads a int*8 buffer from
 !             N,BUF)          file starting at rec sr
 !
+! fsys_set_async(sys,fid, : open file fid for asynchronous
+!             async)          io, before fsys_open
+!
+! fsys_dwrite_async(sys,  : starts the write of a real*8
+!        fid,sr,N,BUF,h)      buffer at rec sr, h is the 
+!                             handle to wait on
+!
+! fsys_dread_async(sys,   : starts the read of a real*8
+!        fid,sr,N,BUF,h)      buffer from rec sr
+!
+! fsys_wait(h)            : waits for the io of handle h
+!
+!	ASYNCHRONOUS IO
+!	  - for streaming fixed size records (e.g., batches
+!	    of integrals) while the next batch is computed:
+!	      call fsys_set_async(sys,fid,.true.)
+!	      call fsys_open(sys,fid,1)
+!	      call fsys_dwrite_async(sys,fid,sr,N,BUF,h)
+!	      ... compute into another buffer
+!	      call fsys_wait(h)
+!	  - BUF must be contiguous, and declared 
+!	    asynchronous (or target) by the caller, and not
+!	    be touched until fsys_wait
+!	  - each record of the buffer is its own request,
+!	    so for large transfers make the records large
+!	    (frlen of fsys_add)
+!	  - gfortran only overlaps the io when linked with
+!	    -pthread, otherwise it is done in the call
+!	  - an asynchronous file takes only the *_async
+!	    routines, fsys_dwrite, fsys_iwrite, fsys_dread
+!	    and fsys_iread stop on it
+!
 
 module fsys
   implicit none
@@ -82,6 +114,7 @@ module fsys
 ! file_recelm(100)	: int*8, number of dp values per rec
 ! file_reclen(100)	: int*8, reclength of file 
 ! file_isopen(100)	: bool,  true if file is open
+! file_async(100)	: bool,  true if opened asynchronous
 
 type jsys_type
   integer(kind=8)  :: file_nmax=100
@@ -94,8 +127,24 @@ type jsys_type
   integer(kind=8)  :: file_reclen(100)
   integer(kind=8)  :: file_(100)
   logical          :: file_isopen(100)
+  logical          :: file_async(100)
 end type jsys_type
 
+!--------------------------------------------------------
+! fsys_wait_type
+!	- handle of the asynchronous io of one buffer,
+!	  one id per record
+!--------------------------------------------------------
+! funit			: int*8, unit of the file
+! n			: int*8, number of requests
+! ids(:)		: int, ids of the requests
+
+type fsys_wait_type
+  integer(kind=8)      :: funit = -1
+  integer(kind=8)      :: n = 0
+  integer, allocatable :: ids(:)
+end type fsys_wait_type
+
 contains
 
 !--------------------------------------------------------
@@ -117,6 +166,7 @@ subroutine fsys_init(sys)
   sys%file_recelm(1:sys%file_nmax)  = 5 
   sys%file_reclen(1:sys%file_nmax)  = 5*dlen
   sys%file_isopen(1:sys%file_nmax)  = .false.
+  sys%file_async(1:sys%file_nmax)   = .false.
 
 end subroutine fsys_init
 
@@ -316,6 +366,7 @@ subroutine fsys_open(sys,fid,rdwr)
   integer(kind=8), intent(in)    :: fid,rdwr
 
   character(len=8) :: stat
+  character(len=3) :: async
 
   !check that fid is in filesystem
   if (fid .gt. sys%file_num) then
@@ -335,10 +386,13 @@ subroutine fsys_open(sys,fid,rdwr)
     STOP 1
   end if
 
+  async = 'no '
+  if (sys%file_async(fid)) async = 'yes'
+
   if (.not. sys%file_isopen(fid)) then 
     open(file=trim(sys%file_name(fid)),unit=sys%file_unit(fid), &
          status=trim(stat),form='unformatted',access='direct', &
-         recl=sys%file_reclen(fid))
+         recl=sys%file_reclen(fid),asynchronous=trim(async))
     sys%file_isopen(fid) = .true.
   end if
 
@@ -412,6 +466,8 @@ subroutine fsys_dwrite(sys,fid,sr,N,BUF)
   integer(kind=8) :: nn,ll,nl
 
 
+  if (sys%file_async(fid)) call fsys_sync_stop(sys,fid,'fsys_dwrite')
+
   funit=sys%file_unit(fid)
   ll = sys%file_recelm(fid) !num dp per rec
   nl = (N + ll - 1)/ll       !number of rec 
@@ -464,6 +520,8 @@ subroutine fsys_iwrite(sys,fid,sr,N,BUF)
   integer(kind=8) :: i0,i1,i2,funit
   integer(kind=8) :: nn,ll,nl
 
+  if (sys%file_async(fid)) call fsys_sync_stop(sys,fid,'fsys_iwrite')
+
   funit=sys%file_unit(fid)
   ll = sys%file_recelm(fid) !num dp per rec
   nl = (N + ll - 1)/ll       !number of rec 
@@ -516,6 +574,8 @@ subroutine fsys_dread(sys,fid,sr,N,BUF)
   integer(kind=8) :: i0,i1,i2,funit
   integer(kind=8) :: nn,ll,nl
 
+  if (sys%file_async(fid)) call fsys_sync_stop(sys,fid,'fsys_dread')
+
   funit = sys%file_unit(fid)
   ll = sys%file_recelm(fid)  !num dp per rec
   nl = (N + ll - 1)/ll       !number of rec 
@@ -568,6 +628,8 @@ subroutine fsys_iread(sys,fid,sr,N,BUF)
   integer(kind=8) :: i0,i1,i2,funit
   integer(kind=8) :: nn,ll,nl
 
+  if (sys%file_async(fid)) call fsys_sync_stop(sys,fid,'fsys_iread')
+
   funit=sys%file_unit(fid)
   ll = sys%file_recelm(fid) !num dp per rec
   nl = (N + ll - 1)/ll       !number of rec 
@@ -597,6 +659,184 @@ subroutine fsys_iread(sys,fid,sr,N,BUF)
 
 end subroutine fsys_iread
 !--------------------------------------------------------
+! fsys_sync_stop
+!	- stops on a synchronous io call to asynchronous
+!	  file fid, which takes only the *_async routines
+!--------------------------------------------------------
+! sys		: jsys_type, filesystem
+! fid		: int*8, id of file
+! opr		: chr, name of the routine
+subroutine fsys_sync_stop(sys,fid,opr)
+  implicit none
+  type(jsys_type), intent(in)    :: sys
+  integer(kind=8), intent(in)    :: fid
+  character(len=*), intent(in)   :: opr
+
+  write(*,'(A)') "fsys : ERROR ERROR ERROR"
+  write(*,'(A,A,A8,A)') opr," called on file ",sys%file_name(fid), &
+                        ", which is asynchronous, use the *_async routines"
+  STOP 1
+
+end subroutine fsys_sync_stop
+
+!--------------------------------------------------------
+! fsys_set_async
+!	- sets file fid to be opened for asynchronous io,
+!	  from the next fsys_open
+!--------------------------------------------------------
+! sys		: jsys_type, filesystem
+! fid		: int*8, id of file
+! async		: bool, true for asynchronous io
+subroutine fsys_set_async(sys,fid,async)
+  implicit none
+  type(jsys_type), intent(inout) :: sys
+  integer(kind=8), intent(in)    :: fid
+  logical, intent(in)            :: async
+
+  if (fid .gt. sys%file_num) then
+    write(*,'(A)') "fsys : ERROR ERROR ERROR"
+    write(*,'(A)') "Attempted to set async of file not in filesystem"
+    STOP 1
+  end if
+  if (sys%file_isopen(fid)) then
+    write(*,'(A)') "fsys : ERROR ERROR ERROR"
+    write(*,'(A)') "Attempted to set async of an open file"
+    STOP 1
+  end if
+
+  sys%file_async(fid) = async
+
+end subroutine fsys_set_async
+
+!--------------------------------------------------------
+! fsys_async_start
+!	- checks that file fid is open for asynchronous
+!	  io, and sets up the handle for nl requests
+!--------------------------------------------------------
+! sys		: jsys_type, filesystem
+! fid		: int*8, id of file
+! nl		: int*8, number of records
+! h		: fsys_wait_type, handle
+subroutine fsys_async_start(sys,fid,nl,h)
+  implicit none
+  type(jsys_type), intent(in)         :: sys
+  integer(kind=8), intent(in)         :: fid,nl
+  type(fsys_wait_type), intent(inout) :: h
+
+  if (fid .gt. sys%file_num) then
+    write(*,'(A)') "fsys : ERROR ERROR ERROR"
+    write(*,'(A)') "Attempted asynchronous io of file not in filesystem"
+    STOP 1
+  end if
+  if (.not. (sys%file_isopen(fid) .and. sys%file_async(fid))) then
+    write(*,'(A)') "fsys : ERROR ERROR ERROR"
+    write(*,'(A,A8,A)') "File ",sys%file_name(fid), &
+                        " is not open for asynchronous io"
+    STOP 1
+  end if
+  if (h%n .gt. 0) then
+    write(*,'(A)') "fsys : ERROR ERROR ERROR"
+    write(*,'(A)') "Attempted to reuse an fsys_wait_type before fsys_wait"
+    STOP 1
+  end if
+
+  if (allocated(h%ids)) then
+    if (size(h%ids,kind=8) .lt. nl) deallocate(h%ids)
+  end if
+  if (.not. allocated(h%ids)) allocate(h%ids(nl))
+  h%funit = sys%file_unit(fid)
+  h%n = nl
+
+end subroutine fsys_async_start
+
+!--------------------------------------------------------
+! fsys_dwrite_async
+!	- starts the asynchronous write of a dp buffer 
+!	  to file fid, from record sr, one request per
+!	  record. BUF must not change until fsys_wait(h)
+!--------------------------------------------------------
+! sys		: jsys_type, filesystem
+! fid		: int*8, id of file
+! sr		: int*8, starting rec
+! N		: int*8, length of buffer
+! BUF(N)	: real*8, buffer
+! h		: fsys_wait_type, handle to wait on
+subroutine fsys_dwrite_async(sys,fid,sr,N,BUF,h)
+  implicit none
+  type(jsys_type), intent(in)             :: sys
+  integer(kind=8), intent(in)             :: fid,sr,N
+  real(kind=8), intent(in), asynchronous  :: BUF(N)
+  type(fsys_wait_type), intent(inout)     :: h
+
+  integer(kind=8) :: k,i1,i2,ll,nl
+
+  ll = sys%file_recelm(fid)  !num dp per rec
+  nl = (N + ll - 1)/ll       !number of rec 
+  call fsys_async_start(sys,fid,nl,h)
+
+  do k=1,nl
+    i1 = 1 + (k-1)*ll
+    i2 = min(N,i1+ll-1)
+    write(h%funit,rec=sr+k-1,asynchronous='yes',id=h%ids(k)) BUF(i1:i2)
+  end do
+
+end subroutine fsys_dwrite_async
+
+!--------------------------------------------------------
+! fsys_dread_async
+!	- starts the asynchronous read of a dp buffer 
+!	  from file fid, from record sr, one request per
+!	  record. BUF is not set until fsys_wait(h)
+!--------------------------------------------------------
+! sys		: jsys_type, filesystem
+! fid		: int*8, id of file
+! sr		: int*8, starting rec
+! N		: int*8, length of buffer
+! BUF(N)	: real*8, buffer
+! h		: fsys_wait_type, handle to wait on
+subroutine fsys_dread_async(sys,fid,sr,N,BUF,h)
+  implicit none
+  type(jsys_type), intent(in)               :: sys
+  integer(kind=8), intent(in)               :: fid,sr,N
+  real(kind=8), intent(inout), asynchronous :: BUF(N)
+  type(fsys_wait_type), intent(inout)       :: h
+
+  integer(kind=8) :: k,i1,i2,ll,nl
+
+  ll = sys%file_recelm(fid)  !num dp per rec
+  nl = (N + ll - 1)/ll       !number of rec 
+  call fsys_async_start(sys,fid,nl,h)
+
+  do k=1,nl
+    i1 = 1 + (k-1)*ll
+    i2 = min(N,i1+ll-1)
+    read(h%funit,rec=sr+k-1,asynchronous='yes',id=h%ids(k)) BUF(i1:i2)
+  end do
+
+end subroutine fsys_dread_async
+
+!--------------------------------------------------------
+! fsys_wait
+!	- waits for the asynchronous io of handle h,
+!	  which can then be reused
+!--------------------------------------------------------
+! h		: fsys_wait_type, handle
+subroutine fsys_wait(h)
+  implicit none
+  type(fsys_wait_type), intent(inout) :: h
+  integer(kind=8) :: k
+
+  do k=1,h%n
+    wait(unit=h%funit,id=h%ids(k))
+  end do
+  !and the unit, as waiting on the ids alone can leave
+  !  the last record of a new file unwritten (gfortran 12)
+  if (h%n .gt. 0) wait(unit=h%funit)
+  h%n = 0
+
+end subroutine fsys_wait
+
+!--------------------------------------------------------
 
 
 end module fsys
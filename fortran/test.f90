@@ -13,6 +13,12 @@ program test
 
   character(len=8) :: bar
 
+  !for the asynchronous round trip
+  real(kind=8), asynchronous :: ABUF(1:1000),BBUF(1:1000)
+  type(fsys_wait_type) :: h
+  integer(kind=8) :: afid,an,k,j,nbad
+  integer(kind=8) :: alens(3) = (/211,409,607/)
+
   nelm = 1000
   !EXAMPLE FOR DBUF
   call dmem_init(nelm,dmeta)
@@ -51,6 +57,43 @@ program test
   call fsys_recover(sys)
   write(*,*) "fsys was recovered"
   call fsys_print(sys)
+
+  !EXAMPLE FOR ASYNCHRONOUS FSYS, write and read back 
+  !  buffers that do not fill their last record
+  call fsys_add(sys,'AFILE   ',100,afid)
+  !fsys is built without -fdefault-integer-8, so a default logical is kind 4
+  call fsys_set_async(sys,afid,.true._4)
+  nbad = 0
+  do k=1,3
+    an = alens(k)
+    do j=1,an
+      ABUF(j) = dble(k*10000 + j)
+    end do
+    BBUF = -1.d0
+    !read back on the same open, then after reopening it
+    call fsys_open(sys,afid,1)
+    call fsys_dwrite_async(sys,afid,1,an,ABUF(1:an),h)
+    call fsys_wait(h)
+    call fsys_dread_async(sys,afid,1,an,BBUF(1:an),h)
+    call fsys_wait(h)
+    if (any(ABUF(1:an) .ne. BBUF(1:an))) then
+      write(*,*) "async round trip FAILED for N =",an
+      nbad = nbad + 1
+    end if
+    call fsys_close(sys,afid)
+
+    BBUF = -1.d0
+    call fsys_open(sys,afid,0)
+    call fsys_dread_async(sys,afid,1,an,BBUF(1:an),h)
+    call fsys_wait(h)
+    call fsys_close(sys,afid)
+    if (any(ABUF(1:an) .ne. BBUF(1:an))) then
+      write(*,*) "async reopen round trip FAILED for N =",an
+      nbad = nbad + 1
+    end if
+  end do
+  if (nbad .ne. 0) STOP 1
+  write(*,*) "async round trip passed"
   
   
 end program test